@@ -23,3 +23,17 @@ MACRO(SUBDIRLIST result curdir)
   ENDFOREACH()
   SET(${result} ${dirlist})
 ENDMACRO()
+
+
+# Add a performance test with the label perf, which fails if the performance metrics
+# are worse than the baseline of this machine by more than the tolerance.
+# The baseline is recorded by the first run. Extra arguments are passed to the executable.
+function(ADD_PERFORMANCE_TEST TARGET)
+  IF(SPHINXSYS_PERFORMANCE_TESTS)
+    file(MAKE_DIRECTORY ${SPHINXSYS_PERFORMANCE_BASELINE_DIR})
+    add_test(NAME ${TARGET}_perf COMMAND ${TARGET} --state_recording=0
+        --performance_baseline=${SPHINXSYS_PERFORMANCE_BASELINE_DIR}/${TARGET} --performance_tolerance=0.1 ${ARGN}
+        WORKING_DIRECTORY ${EXECUTABLE_OUTPUT_PATH})
+    set_tests_properties(${TARGET}_perf PROPERTIES LABELS "perf" RUN_SERIAL TRUE)
+  ENDIF()
+endfunction()
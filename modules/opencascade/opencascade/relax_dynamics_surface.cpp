@@ -12,14 +12,14 @@ namespace relax_dynamics
 //=================================================================================================//
 ShapeSurfaceBounding2::ShapeSurfaceBounding2(RealBody &real_body_)
     : LocalDynamics(real_body_),
-      pos_(particles_->getVariableDataByName<Vecd>("Position"))
-{
-    shape_ = &real_body_.getInitialShape();
-}
+      pos_(particles_->getVariableDataByName<Vecd>("Position")),
+      surface_shape_(DynamicCast<SurfaceShape>(this, &real_body_.getInitialShape())),
+      surface_parameters_(particles_->registerStateVariable<Vec2d>(
+          "SurfaceParameters", SurfaceShape::UnknownParameters())) {}
 //=================================================================================================//
 void ShapeSurfaceBounding2::update(size_t index_i, Real dt)
 {
-    pos_[index_i] = shape_->findClosestPoint(pos_[index_i]);
+    pos_[index_i] = surface_shape_->findClosestPoint(pos_[index_i], surface_parameters_[index_i]);
 }
 //=================================================================================================//
 RelaxationStepInnerFirstHalf::
@@ -60,24 +60,9 @@ SurfaceNormalDirection::SurfaceNormalDirection(SPHBody &sph_body)
 //=================================================================================================//
 void SurfaceNormalDirection::update(size_t index_i, Real dt)
 {
-    Extrema_ExtAlgo Algo = Extrema_ExtAlgo_Tree;
-    gp_Vec tangent_u, tangent_v;
-    gp_Vec norm;
-    Vecd normal_direction_;
-
-    gp_Pnt point1 = EigenToOcct(pos_[index_i]);
-    GeomAPI_ProjectPointOnSurf pointonsurf(point1, surface_shape_->surface_, Algo);
-
-    Standard_Real u;
-    Standard_Real v;
-    gp_Pnt Point;
-
-    pointonsurf.Parameters(1, u, v);
-
-    surface_shape_->surface_->D1(u, v, Point, tangent_u, tangent_v);
-    norm = tangent_u.Crossed(tangent_v);
-    normal_direction_ = OcctVecToEigen(norm);
-    n_[index_i] = normal_direction_.normalized();
+    Vec2d parameters = SurfaceShape::UnknownParameters();
+    surface_shape_->findClosestPoint(pos_[index_i], parameters);
+    n_[index_i] = surface_shape_->getNormalDirection(parameters);
 }
 //=================================================================================================//
 } // namespace relax_dynamics
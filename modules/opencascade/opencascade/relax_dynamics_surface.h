@@ -50,7 +50,8 @@ class ShapeSurfaceBounding2 : public LocalDynamics
 
   protected:
     Vecd *pos_;
-    Shape *shape_;
+    SurfaceShape *surface_shape_;
+    Vec2d *surface_parameters_; /**< cached (u, v) of the last projection, the initial guess of the next one. */
 };
 
 class RelaxationStepInnerFirstHalf : public BaseDynamics<void>
@@ -6,22 +6,16 @@
 #include <opencascade/BRep_Builder.hxx>
 #include <opencascade/GeomAPI_ProjectPointOnSurf.hxx>
 #include <opencascade/gp_Pnt.hxx>
+#include <opencascade/gp_Vec.hxx>
+#include <opencascade/Precision.hxx>
 
 namespace SPH
 {
 	//=================================================================================================//
 Vecd SurfaceShape::findClosestPoint(const Vecd &input_pnt)
 {
-
-    Vecd closest_pnt;
-    gp_Pnt point1 = EigenToOcct(input_pnt);
-    Extrema_ExtAlgo Algo = Extrema_ExtAlgo_Tree;
-    gp_Pnt point2 = GeomAPI_ProjectPointOnSurf(point1, surface_, Algo);
-    closest_pnt[0] = point2.X();
-    closest_pnt[1] = point2.Y();
-    closest_pnt[2] = point2.Z();
-
-    return closest_pnt;
+    Vec2d parameters = UnknownParameters();
+    return findClosestPoint(input_pnt, parameters);
 }
 
 ////=================================================================================================//
@@ -39,6 +33,135 @@ Vecd SurfaceShape::getCartesianPoint(Standard_Real u, Standard_Real v)
     actual_pnt[2] = point.Z();
     return Vecd(actual_pnt[0], actual_pnt[1], actual_pnt[2]);
 }
+//=================================================================================================//
+Vecd SurfaceShape::findClosestPoint(const Vecd &input_pnt, Vec2d &parameters)
+{
+    GeomAdaptor_Surface &adaptor = getSurfaceAdaptor();
+    if (!isWithinBounds(parameters))
+        parameters = findInitialParameters(input_pnt);
+    if (!projectLocally(adaptor, input_pnt, parameters))
+        parameters = projectGlobally(input_pnt);
+    return OcctToEigen(adaptor.Value(parameters[0], parameters[1]));
+}
+//=================================================================================================//
+Vecd SurfaceShape::getNormalDirection(const Vec2d &parameters)
+{
+    gp_Pnt point;
+    gp_Vec tangent_u, tangent_v;
+    getSurfaceAdaptor().D1(parameters[0], parameters[1], point, tangent_u, tangent_v);
+    return OcctVecToEigen(tangent_u.Crossed(tangent_v)).normalized();
+}
+//=================================================================================================//
+void SurfaceShape::bakeParameterSamples(size_t resolution)
+{
+    Standard_Real u_min, u_max, v_min, v_max;
+    surface_->Bounds(u_min, u_max, v_min, v_max);
+    if (resolution < 2 || Precision::IsInfinite(u_min) || Precision::IsInfinite(u_max) ||
+        Precision::IsInfinite(v_min) || Precision::IsInfinite(v_max))
+    {
+        std::cout << "\n Error: the surface parameters can not be sampled with the given resolution or bounds!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    sample_points_.clear();
+    sample_parameters_.clear();
+    for (size_t i = 0; i != resolution; ++i)
+        for (size_t j = 0; j != resolution; ++j)
+        {
+            Vec2d parameters(u_min + (u_max - u_min) * Real(i) / Real(resolution - 1),
+                             v_min + (v_max - v_min) * Real(j) / Real(resolution - 1));
+            sample_parameters_.push_back(parameters);
+            sample_points_.push_back(getCartesianPoint(parameters[0], parameters[1]));
+        }
+}
+//=================================================================================================//
+GeomAdaptor_Surface &SurfaceShape::getSurfaceAdaptor()
+{
+    UniquePtr<GeomAdaptor_Surface> &adaptor = surface_adaptors_.local();
+    if (adaptor == nullptr)
+        adaptor = makeUnique<GeomAdaptor_Surface>(surface_);
+    return *adaptor;
+}
+//=================================================================================================//
+bool SurfaceShape::isWithinBounds(const Vec2d &parameters)
+{
+    Standard_Real u_min, u_max, v_min, v_max;
+    surface_->Bounds(u_min, u_max, v_min, v_max);
+    return parameters[0] >= u_min && parameters[0] <= u_max &&
+           parameters[1] >= v_min && parameters[1] <= v_max;
+}
+//=================================================================================================//
+Vec2d SurfaceShape::findInitialParameters(const Vecd &input_pnt)
+{
+    if (sample_points_.empty())
+        return projectGlobally(input_pnt);
+
+    size_t nearest = 0;
+    Real min_distance_square = MaxReal;
+    for (size_t n = 0; n != sample_points_.size(); ++n)
+    {
+        Real distance_square = (sample_points_[n] - input_pnt).squaredNorm();
+        if (distance_square < min_distance_square)
+        {
+            min_distance_square = distance_square;
+            nearest = n;
+        }
+    }
+    return sample_parameters_[nearest];
+}
+//=================================================================================================//
+Vec2d SurfaceShape::projectGlobally(const Vecd &input_pnt)
+{
+    GeomAPI_ProjectPointOnSurf projection(EigenToOcct(input_pnt), surface_, Extrema_ExtAlgo_Tree);
+    if (projection.NbPoints() == 0)
+    {
+        std::cout << "\n Error: the point can not be projected onto the surface!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    Standard_Real u, v;
+    projection.LowerDistanceParameters(u, v);
+    return Vec2d(u, v);
+}
+//=================================================================================================//
+bool SurfaceShape::projectLocally(GeomAdaptor_Surface &adaptor, const Vecd &input_pnt, Vec2d &parameters)
+{
+    gp_Pnt target = EigenToOcct(input_pnt);
+    Standard_Real u_min, u_max, v_min, v_max;
+    surface_->Bounds(u_min, u_max, v_min, v_max);
+
+    Real u = parameters[0], v = parameters[1];
+    for (int k = 0; k != max_newton_iterations_; ++k)
+    {
+        // Newton iteration minimizing the squared distance between the surface point and the target.
+        gp_Pnt point;
+        gp_Vec s_u, s_v, s_uu, s_vv, s_uv;
+        adaptor.D2(u, v, point, s_u, s_v, s_uu, s_vv, s_uv);
+        gp_Vec distance(target, point);
+        Real g_u = s_u.Dot(distance);
+        Real g_v = s_v.Dot(distance);
+        Real h_uu = s_u.Dot(s_u) + s_uu.Dot(distance);
+        Real h_vv = s_v.Dot(s_v) + s_vv.Dot(distance);
+        Real h_uv = s_u.Dot(s_v) + s_uv.Dot(distance);
+        Real determinant = h_uu * h_vv - h_uv * h_uv;
+        if (determinant <= TinyReal || h_uu <= 0.0)
+            return false;
+
+        Real u_new = SMIN(SMAX(u - (h_vv * g_u - h_uv * g_v) / determinant, u_min), u_max);
+        Real v_new = SMIN(SMAX(v - (h_uu * g_v - h_uv * g_u) / determinant, v_min), v_max);
+        Real step_square = (u_new - u) * (u_new - u) * s_u.SquareMagnitude() +
+                           (v_new - v) * (v_new - v) * s_v.SquareMagnitude();
+        u = u_new;
+        v = v_new;
+        if (step_square < Precision::SquareConfusion())
+        {
+            parameters = Vec2d(u, v);
+            return true;
+        }
+    }
+    return false;
+}
 
 //=================================================================================================//
 SurfaceShapeSTEP::
@@ -28,6 +28,8 @@
 
 #include <opencascade/Standard_TypeDef.hxx>
 #include <opencascade/Geom_Surface.hxx>
+#include <opencascade/GeomAdaptor_Surface.hxx>
+#include <tbb/enumerable_thread_specific.h>
 
 #include <iostream>
 #include <string>
@@ -44,11 +46,34 @@ namespace SPH
                     : Shape(shape_name){};
                 virtual bool checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED = true) override;
                 virtual Vecd findClosestPoint(const Vecd &input_pnt) override;
+                /** Find the closest point and its surface parameters (u, v).
+                 * The input parameters are used as the initial guess of a local Newton projection,
+                 * which is much cheaper than the global OpenCASCADE projection.
+                 * If the guess is out of the parameter bounds, e.g. UnknownParameters(),
+                 * or the local projection fails, the guess is found from the baked samples
+                 * or by the global projection. Thread safe. */
+                Vecd findClosestPoint(const Vecd &input_pnt, Vec2d &parameters);
                 Vecd getCartesianPoint(Standard_Real u, Standard_Real v);
-              
+                Vecd getNormalDirection(const Vec2d &parameters);
+                /** Sample the surface on a resolution x resolution grid of parameters,
+                 * whose nearest sample gives the coarse initial guess of a projection. */
+                void bakeParameterSamples(size_t resolution);
+                static Vec2d UnknownParameters() { return Vec2d(MaxReal, MaxReal); };
+
                 Handle_Geom_Surface surface_;
               protected:
-                virtual BoundingBox findBounds() override;   
+                /** One adaptor for each thread, as the adaptors cache the evaluations of B-spline surfaces. */
+                tbb::enumerable_thread_specific<UniquePtr<GeomAdaptor_Surface>> surface_adaptors_;
+                StdVec<Vecd> sample_points_;
+                StdVec<Vec2d> sample_parameters_;
+                int max_newton_iterations_ = 10;
+
+                virtual BoundingBox findBounds() override;
+                GeomAdaptor_Surface &getSurfaceAdaptor();
+                bool isWithinBounds(const Vec2d &parameters);
+                Vec2d findInitialParameters(const Vecd &input_pnt);
+                Vec2d projectGlobally(const Vecd &input_pnt);
+                bool projectLocally(GeomAdaptor_Surface &adaptor, const Vecd &input_pnt, Vec2d &parameters);
         };
 
         class SurfaceShapeSTEP : public SurfaceShape
@@ -8,6 +8,10 @@
 
 #include "structural_simulation_class.h"
 
+#include <atomic>
+#include <exception>
+#include <mutex>
+
 ////////////////////////////////////////////////////
 /* global functions in StructuralSimulation  */
 ////////////////////////////////////////////////////
@@ -38,14 +42,35 @@ SolidBodyForSimulation::SolidBodyForSimulation(
       inner_body_relation_(solid_body_from_mesh_),
       initial_normal_direction_(SimpleDynamics<NormalDirectionFromBodyShape>(solid_body_from_mesh_)),
       correct_configuration_(inner_body_relation_),
-      stress_relaxation_first_half_(inner_body_relation_),
-      stress_relaxation_second_half_(inner_body_relation_),
-      damping_random_(0.2, inner_body_relation_, "Velocity", physical_viscosity)
+      stress_relaxation_first_half_(makeUnique<Dynamics1Level<solid_dynamics::Integration1stHalfPK2>>(inner_body_relation_)),
+      stress_relaxation_second_half_(makeUnique<Dynamics1Level<solid_dynamics::Integration2ndHalf>>(inner_body_relation_)),
+      damping_random_(makeUnique<DampingWithRandomChoice<InteractionSplit<DampingPairwiseInner<Vec3d, FixedDampingRate>>>>(
+          0.2, inner_body_relation_, "Velocity", physical_viscosity))
 {
     initial_normal_direction_.exec();
     std::cout << "  normal initialization done" << std::endl;
 }
 
+void SolidBodyForSimulation::resetMaterialDynamics(Real physical_viscosity)
+{
+    // the reference density and mass follow the material
+    BaseParticles &particles = solid_body_from_mesh_.getBaseParticles();
+    Real rho0 = solid_body_from_mesh_.getBaseMaterial().ReferenceDensity();
+    Real *rho = particles.getVariableDataByName<Real>("Density");
+    Real *mass = particles.getVariableDataByName<Real>("Mass");
+    Real *Vol = particles.VolumetricMeasures();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        rho[i] = rho0;
+        mass[i] = rho0 * Vol[i];
+    }
+
+    stress_relaxation_first_half_ = makeUnique<Dynamics1Level<solid_dynamics::Integration1stHalfPK2>>(inner_body_relation_);
+    stress_relaxation_second_half_ = makeUnique<Dynamics1Level<solid_dynamics::Integration2ndHalf>>(inner_body_relation_);
+    damping_random_ = makeUnique<DampingWithRandomChoice<InteractionSplit<DampingPairwiseInner<Vec3d, FixedDampingRate>>>>(
+        0.2, inner_body_relation_, "Velocity", physical_viscosity);
+}
+
 void expandBoundingBox(BoundingBox *original, BoundingBox *additional)
 {
     for (int i = 0; i < original->first_.size(); i++)
@@ -174,12 +199,20 @@ StructuralSimulationInput::StructuralSimulationInput(
     position_scale_solid_body_tuple_ = {};
     translation_solid_body_tuple_ = {};
     translation_solid_body_part_tuple_ = {};
+    member_name_ = "";
 };
 
 ///////////////////////////////////////
 /* StructuralSimulation members */
 ///////////////////////////////////////
 
+static SPHSystem &setMemberName(SPHSystem &system, const std::string &member_name)
+{
+    // before the io environment is created with the output sub-folder
+    system.setMemberName(member_name);
+    return system;
+}
+
 StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &input)
     : // generic input
       relative_input_path_(input.relative_input_path_),
@@ -198,7 +231,7 @@ StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &inpu
       system_resolution_(0.0),
       system_(SPHSystem(BoundingBox(Vec3d::Zero(), Vec3d::Zero()), system_resolution_)),
       scale_system_boundaries_(input.scale_system_boundaries_),
-      io_environment_(system_),
+      io_environment_(setMemberName(system_, input.member_name_)),
       physical_time_(*system_.getSystemVariableDataByName<Real>("PhysicalTime")),
 
       // optional: boundary conditions
@@ -216,7 +249,8 @@ StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &inpu
       translation_solid_body_part_tuple_(input.translation_solid_body_part_tuple_),
 
       // iterators
-      iteration_(0)
+      iteration_(0),
+      state_snapshot_io_(system_)
 {
     // scaling of translation and resolution
     scaleTranslationAndResolution();
@@ -246,6 +280,7 @@ StructuralSimulation::StructuralSimulation(const StructuralSimulationInput &inpu
     initializeTranslateSolidBodyPart();
     // initialize simulation
     initializeSimulation();
+    initial_snapshot_ = state_snapshot_io_.takeSnapshot();
 }
 
 StructuralSimulation::~StructuralSimulation()
@@ -349,20 +384,11 @@ void StructuralSimulation::initializeContactBetweenTwoBodies(int first, int seco
 
     contact_list_.emplace_back(makeShared<SurfaceContactRelation>(*first_body, RealBodyVector({second_body})));
     contact_list_.emplace_back(makeShared<SurfaceContactRelation>(*second_body, RealBodyVector({first_body})));
-
-    int last = contact_list_.size() - 1;
-    contact_density_list_.push_back(makeShared<InteractionDynamics<solid_dynamics::ContactFactorSummation>>(*contact_list_[last - 1]));
-    contact_density_list_.push_back(makeShared<InteractionDynamics<solid_dynamics::ContactFactorSummation>>(*contact_list_[last]));
-
-    contact_force_list_.push_back(makeShared<InteractionWithUpdate<solid_dynamics::ContactForce>>(*contact_list_[last - 1]));
-    contact_force_list_.push_back(makeShared<InteractionWithUpdate<solid_dynamics::ContactForce>>(*contact_list_[last]));
 }
 
 void StructuralSimulation::initializeAllContacts()
 {
     contact_list_ = {};
-    contact_density_list_ = {};
-    contact_force_list_ = {};
     // first place all the regular contacts into the lists
     for (size_t i = 0; i < contacting_body_pairs_list_.size(); i++)
     {
@@ -375,9 +401,6 @@ void StructuralSimulation::initializeAllContacts()
         }
 
         contact_list_.emplace_back(makeShared<SurfaceContactRelation>(*contact_body, target_list));
-        int last = contact_list_.size() - 1;
-        contact_density_list_.emplace_back(makeShared<InteractionDynamics<solid_dynamics::ContactFactorSummation>>(*contact_list_[last]));
-        contact_force_list_.emplace_back(makeShared<InteractionWithUpdate<solid_dynamics::ContactForce>>(*contact_list_[last]));
     }
     // continue appending the lists with the time dependent contacts
     for (size_t i = 0; i < time_dep_contacting_body_pairs_list_.size(); i++)
@@ -386,6 +409,19 @@ void StructuralSimulation::initializeAllContacts()
         int body_2 = time_dep_contacting_body_pairs_list_[i].first[1];
         initializeContactBetweenTwoBodies(body_1, body_2); // vector with first element being array with indices
     }
+    initializeContactDynamics();
+}
+
+void StructuralSimulation::initializeContactDynamics()
+{
+    // one contact density and force for each contact relation, in the same order
+    contact_density_list_ = {};
+    contact_force_list_ = {};
+    for (size_t i = 0; i < contact_list_.size(); i++)
+    {
+        contact_density_list_.emplace_back(makeShared<InteractionDynamics<solid_dynamics::ContactFactorSummation>>(*contact_list_[i]));
+        contact_force_list_.emplace_back(makeShared<InteractionWithUpdate<solid_dynamics::ContactForce>>(*contact_list_[i]));
+    }
 }
 
 void StructuralSimulation::initializeGravity()
@@ -396,8 +432,10 @@ void StructuralSimulation::initializeGravity()
     {
         gravity_indices.push_back(non_zero_gravity_[i].first);
     }
-    // initialize gravity
+    // initialize gravity, the gravity list is not reallocated as the dynamics refer to its elements
     initialize_gravity_ = {};
+    gravity_list_ = {};
+    gravity_list_.reserve(non_zero_gravity_.size());
     size_t gravity_index_i = 0; // iterating through gravity_indices
     for (size_t i = 0; i < solid_body_list_.size(); i++)
     {
@@ -507,6 +545,7 @@ void StructuralSimulation::initializeConstrainSolidBody()
 void StructuralSimulation::initializeConstrainSolidBodyRegion()
 {
     fixed_constraint_region_ = {};
+    fixed_constraint_region_part_ = {};
     for (size_t i = 0; i < body_indices_fixed_constraint_region_.size(); i++)
     {
         int body_index = body_indices_fixed_constraint_region_[i].first;
@@ -525,6 +564,7 @@ void StructuralSimulation::initializeConstrainSolidBodyRegion()
         BodyPartFromMesh *bp = body_part_tri_mesh_ptr_keeper_.createPtr<BodyPartFromMesh>(
             *solid_body_list_[body_index]->getSolidBodyFromMesh(), makeShared<TriangleMeshShapeBrick>(halfsize_bbox, resolution, center, imported_stl_list_[body_index]));
         fixed_constraint_region_.emplace_back(makeShared<SimpleDynamics<FixBodyPartConstraint>>(*bp));
+        fixed_constraint_region_part_.push_back(bp);
     }
 }
 
@@ -587,6 +627,21 @@ void StructuralSimulation::initializeTranslateSolidBodyPart()
     }
 }
 
+void StructuralSimulation::initializeQuasiStaticEquilibrium()
+{
+    quasi_static_equilibrium_ = {};
+    for (size_t i = 0; i < solid_body_list_.size(); i++)
+    {
+        quasi_static_equilibrium_.emplace_back(makeShared<solid_dynamics::QuasiStaticEquilibrium>(
+            *solid_body_list_[i]->getInnerBodyRelation()));
+    }
+    for (size_t i = 0; i < fixed_constraint_region_part_.size(); i++)
+    {
+        int body_index = body_indices_fixed_constraint_region_[i].first;
+        quasi_static_equilibrium_[body_index]->fixBodyPart(*fixed_constraint_region_part_[i]);
+    }
+}
+
 void StructuralSimulation::executeInitialNormalDirection()
 {
     for (size_t i = 0; i < solid_body_list_.size(); i++)
@@ -816,6 +871,22 @@ void StructuralSimulation::executeContactUpdateConfiguration()
     }
 }
 
+void StructuralSimulation::executeQuasiStaticEquilibrium()
+{
+    for (size_t i = 0; i < quasi_static_equilibrium_.size(); i++)
+    {
+        // bodies fixed as a whole are not solved
+        if (std::find(body_indices_fixed_constraint_.begin(), body_indices_fixed_constraint_.end(), int(i)) !=
+            body_indices_fixed_constraint_.end())
+            continue;
+
+        quasi_static_equilibrium_[i]->exec();
+        std::cout << "  body " << i << ": Newton iterations: " << quasi_static_equilibrium_[i]->NewtonIterations()
+                  << "\tlinear iterations: " << quasi_static_equilibrium_[i]->LinearIterations()
+                  << "\trelative residual: " << quasi_static_equilibrium_[i]->RelativeResidual() << "\n";
+    }
+}
+
 void StructuralSimulation::initializeSimulation()
 {
     physical_time_ = 0.0;
@@ -828,6 +899,61 @@ void StructuralSimulation::initializeSimulation()
     executeCorrectConfiguration();
 }
 
+void StructuralSimulation::reset(const StructuralSimulationInput &input)
+{
+    if (input.material_model_list_.size() != solid_body_list_.size() ||
+        input.physical_viscosity_.size() != solid_body_list_.size() ||
+        input.time_dep_contacting_body_pairs_list_.size() != time_dep_contacting_body_pairs_list_.size())
+    {
+        std::cout << "\n Error: the input does not match the bodies and contacts of the simulation!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    state_snapshot_io_.restoreSnapshot(initial_snapshot_);
+    iteration_ = 0;
+
+    /** MATERIALS */
+    for (size_t i = 0; i < solid_body_list_.size(); i++)
+    {
+        *material_model_list_[i] = *input.material_model_list_[i];
+        physical_viscosity_[i] = input.physical_viscosity_[i];
+        solid_body_list_[i]->resetMaterialDynamics(physical_viscosity_[i]);
+    }
+    for (size_t i = 0; i < time_dep_contacting_body_pairs_list_.size(); i++)
+    {
+        time_dep_contacting_body_pairs_list_[i].second = input.time_dep_contacting_body_pairs_list_[i].second;
+    }
+    initializeContactDynamics();
+
+    /** BOUNDARY CONDITIONS */
+    non_zero_gravity_ = input.non_zero_gravity_;
+    force_bounding_box_tuple_ = input.force_bounding_box_tuple_;
+    force_in_body_region_tuple_ = input.force_in_body_region_tuple_;
+    surface_pressure_tuple_ = input.surface_pressure_tuple_;
+    spring_damper_tuple_ = input.spring_damper_tuple_;
+    surface_spring_tuple_ = input.surface_spring_tuple_;
+    body_indices_fixed_constraint_ = input.body_indices_fixed_constraint_;
+    body_indices_fixed_constraint_region_ = input.body_indices_fixed_constraint_region_;
+    position_solid_body_tuple_ = input.position_solid_body_tuple_;
+    position_scale_solid_body_tuple_ = input.position_scale_solid_body_tuple_;
+    translation_solid_body_tuple_ = input.translation_solid_body_tuple_;
+    translation_solid_body_part_tuple_ = input.translation_solid_body_part_tuple_;
+    initializeGravity();
+    initializeExternalForceInBoundingBox();
+    initializeForceInBodyRegion();
+    initializeSurfacePressure();
+    initializeSpringDamperConstraintParticleWise();
+    initializeSpringNormalOnSurfaceParticles();
+    initializeConstrainSolidBody();
+    initializeConstrainSolidBodyRegion();
+    initializePositionSolidBody();
+    initializePositionScaleSolidBody();
+    initializeTranslateSolidBody();
+    initializeTranslateSolidBodyPart();
+    quasi_static_equilibrium_ = {};
+}
+
 void StructuralSimulation::runSimulationStep(Real &dt, Real &integration_time)
 {
     if (iteration_ % 100 == 0)
@@ -915,6 +1041,46 @@ void StructuralSimulation::runSimulation(Real end_time)
     std::cout << "Total wall time for computation: " << tt.seconds() << " seconds." << std::endl;
 }
 
+void StructuralSimulation::runQuasiStaticSimulation(Real end_time, int load_steps)
+{
+    if (quasi_static_equilibrium_.empty())
+        initializeQuasiStaticEquilibrium();
+
+    BodyStatesRecordingToVtp write_states(system_);
+    write_states.writeToFile(0);
+    TickCount t1 = TickCount::now();
+    TimeInterval interval;
+    for (int step = 1; step <= load_steps; step++)
+    {
+        physical_time_ = end_time * Real(step) / Real(load_steps);
+        std::cout << "Load step: " << step << " Time: " << physical_time_ << "\n";
+
+        /** UPDATE NORMAL DIRECTIONS */
+        executeUpdateElasticNormalDirection();
+
+        /** LOADS AT THE PRESENT TIME, the spring forces are from the previous load step */
+        executeInitializeGravity();
+        executeExternalForceInBoundingBox();
+        executeForceInBodyRegion();
+        executeSurfacePressure();
+        executeSpringDamperConstraintParticleWise();
+        executeSpringNormalOnSurfaceParticles();
+
+        /** STATIC EQUILIBRIUM */
+        executeQuasiStaticEquilibrium();
+        iteration_++;
+
+        TickCount t2 = TickCount::now();
+        write_states.writeToFile();
+        TickCount t3 = TickCount::now();
+        interval += t3 - t2;
+    }
+    TickCount t4 = TickCount::now();
+    TimeInterval tt;
+    tt = t4 - t1 - interval;
+    std::cout << "Total wall time for computation: " << tt.seconds() << " seconds." << std::endl;
+}
+
 double StructuralSimulation::runSimulationFixedDurationJS(int number_of_steps)
 {
     BodyStatesRecordingToVtp write_states(system_);
@@ -962,9 +1128,69 @@ Real StructuralSimulation::getMaxDisplacement(int body_index)
     return displ_max;
 }
 
+void runParameterSweep(const StdVec<StructuralSimulationInput> &inputs,
+                       const std::function<void(StructuralSimulation &, size_t)> &sweep_point,
+                       size_t number_of_concurrent_points)
+{
+    size_t number_of_threads = SMAX(size_t(std::thread::hardware_concurrency()), size_t(1));
+    size_t number_of_drivers = number_of_concurrent_points == 0 ? number_of_threads : number_of_concurrent_points;
+    number_of_drivers = SMIN(number_of_drivers, SMAX(inputs.size(), size_t(1)));
+    size_t threads_per_driver = SMAX(number_of_threads / number_of_drivers, size_t(1));
+
+    std::atomic<size_t> next_point(0);
+    std::exception_ptr first_exception = nullptr;
+    std::mutex exception_mutex;
+    StdVec<std::thread> drivers;
+    for (size_t driver = 0; driver != number_of_drivers; ++driver)
+    {
+        drivers.emplace_back([&, driver]()
+                             {
+                                 UniquePtr<StructuralSimulation> simulation;
+                                 for (size_t point = next_point++; point < inputs.size(); point = next_point++)
+                                 {
+                                     try
+                                     {
+                                         if (simulation == nullptr)
+                                         {
+                                             StructuralSimulationInput input = inputs[point];
+                                             input.member_name_ = "sweep_driver_" + std::to_string(driver);
+                                             // own copies, as the materials are overwritten at the resets
+                                             for (auto &material_model : input.material_model_list_)
+                                             {
+                                                 material_model = makeShared<SaintVenantKirchhoffSolid>(*material_model);
+                                             }
+                                             simulation = makeUnique<StructuralSimulation>(input);
+                                             simulation->getSPHSystem().setThreadArena(int(threads_per_driver));
+                                         }
+                                         else
+                                         {
+                                             simulation->reset(inputs[point]);
+                                         }
+                                         sweep_point(*simulation, point);
+                                     }
+                                     catch (...)
+                                     {
+                                         std::lock_guard<std::mutex> lock(exception_mutex);
+                                         if (first_exception == nullptr)
+                                             first_exception = std::current_exception();
+                                     }
+                                 } });
+    }
+    for (auto &driver : drivers)
+    {
+        driver.join();
+    }
+
+    if (first_exception != nullptr)
+    {
+        std::rethrow_exception(first_exception);
+    }
+}
+
 StructuralSimulationJS::StructuralSimulationJS(const StructuralSimulationInput &input)
     : StructuralSimulation(input),
       write_states_(system_),
+      export_states_(system_),
       dt(0.0)
 {
     write_states_.writeToFile(0);
@@ -993,3 +1219,33 @@ VtuStringData StructuralSimulationJS::getVtuData()
     write_states_.clear();
     return vtuData;
 }
+
+size_t StructuralSimulationJS::getNumberOfParticles(size_t body_index)
+{
+    return solid_body_list_[body_index]->getElasticSolidParticles()->TotalRealParticles();
+}
+
+const BodyStatesBuffers &StructuralSimulationJS::getBodyStatesBuffers(size_t body_index)
+{
+    export_states_.writeToFile();
+    return export_states_.getBodyStatesBuffers(*solid_body_list_[body_index]->getSolidBodyFromMesh());
+}
+
+Real *StructuralSimulationJS::getParticleVariableData(size_t body_index, const std::string &variable_name, size_t &number_of_reals)
+{
+    BaseParticles *particles = solid_body_list_[body_index]->getElasticSolidParticles();
+    size_t total_real_particles = particles->TotalRealParticles();
+    if (DiscreteVariable<Real> *variable = findVariableByName<Real>(particles->AllDiscreteVariables(), variable_name))
+    {
+        number_of_reals = total_real_particles;
+        return variable->DataField();
+    }
+    if (DiscreteVariable<Vecd> *variable = findVariableByName<Vecd>(particles->AllDiscreteVariables(), variable_name))
+    {
+        number_of_reals = total_real_particles * Dimensions;
+        return variable->DataField()->data();
+    }
+    std::cout << "\n Error: the variable '" << variable_name << "' is not a registered Real or Vecd variable!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
@@ -92,9 +92,10 @@ class SolidBodyForSimulation
 
     SimpleDynamics<NormalDirectionFromBodyShape> initial_normal_direction_;
     InteractionWithUpdate<LinearGradientCorrectionMatrixInner> correct_configuration_;
-    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> stress_relaxation_first_half_;
-    Dynamics1Level<solid_dynamics::Integration2ndHalf> stress_relaxation_second_half_;
-    DampingWithRandomChoice<InteractionSplit<DampingPairwiseInner<Vec3d, FixedDampingRate>>> damping_random_;
+    // the dynamics depending on the material parameters are rebuilt at a reset
+    UniquePtr<Dynamics1Level<solid_dynamics::Integration1stHalfPK2>> stress_relaxation_first_half_;
+    UniquePtr<Dynamics1Level<solid_dynamics::Integration2ndHalf>> stress_relaxation_second_half_;
+    UniquePtr<DampingWithRandomChoice<InteractionSplit<DampingPairwiseInner<Vec3d, FixedDampingRate>>>> damping_random_;
 
   public:
     // no particle reload --> direct generator
@@ -109,9 +110,11 @@ class SolidBodyForSimulation
 
     SimpleDynamics<NormalDirectionFromBodyShape> *getInitialNormalDirection() { return &initial_normal_direction_; };
     InteractionWithUpdate<LinearGradientCorrectionMatrixInner> *getCorrectConfiguration() { return &correct_configuration_; };
-    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> *getStressRelaxationFirstHalf() { return &stress_relaxation_first_half_; };
-    Dynamics1Level<solid_dynamics::Integration2ndHalf> *getStressRelaxationSecondHalf() { return &stress_relaxation_second_half_; };
-    DampingWithRandomChoice<InteractionSplit<DampingPairwiseInner<Vec3d, FixedDampingRate>>> *getDampingWithRandomChoice() { return &damping_random_; };
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> *getStressRelaxationFirstHalf() { return stress_relaxation_first_half_.get(); };
+    Dynamics1Level<solid_dynamics::Integration2ndHalf> *getStressRelaxationSecondHalf() { return stress_relaxation_second_half_.get(); };
+    DampingWithRandomChoice<InteractionSplit<DampingPairwiseInner<Vec3d, FixedDampingRate>>> *getDampingWithRandomChoice() { return damping_random_.get(); };
+    /** rebuild the dynamics after the material parameters are changed */
+    void resetMaterialDynamics(Real physical_viscosity);
 };
 
 void expandBoundingBox(BoundingBox *original, BoundingBox *additional);
@@ -161,6 +164,8 @@ class StructuralSimulationInput
     StdVec<PositionScaleSolidBodyTuple> position_scale_solid_body_tuple_;
     StdVec<TranslateSolidBodyTuple> translation_solid_body_tuple_;
     StdVec<TranslateSolidBodyPartTuple> translation_solid_body_part_tuple_;
+    // output and restart in a sub-folder of this name if not empty
+    std::string member_name_;
 
     StructuralSimulationInput(
         std::string relative_input_path,
@@ -233,6 +238,7 @@ class StructuralSimulation
     StdVec<int> body_indices_fixed_constraint_;
     // for ConstrainSolidBodyRegion
     StdVec<SharedPtr<SimpleDynamics<FixBodyPartConstraint>>> fixed_constraint_region_;
+    StdVec<BodyPartFromMesh *> fixed_constraint_region_part_;
     StdVec<ConstrainedRegionPair> body_indices_fixed_constraint_region_;
     // for PositionSolidBody
     StdVec<SharedPtr<SimpleDynamics<solid_dynamics::PositionSolidBody>>> position_solid_body_;
@@ -246,10 +252,16 @@ class StructuralSimulation
     // for TranslateSolidBodyPart
     StdVec<SharedPtr<SimpleDynamics<solid_dynamics::TranslateSolidBodyPart>>> translation_solid_body_part_;
     StdVec<TranslateSolidBodyPartTuple> translation_solid_body_part_tuple_;
+    // for quasi-static solution, created at the first use
+    StdVec<SharedPtr<solid_dynamics::QuasiStaticEquilibrium>> quasi_static_equilibrium_;
 
     // iterators
     int iteration_;
 
+    // the state after initialization, restored at a reset
+    StateSnapshotIO state_snapshot_io_;
+    StateSnapshot initial_snapshot_;
+
     // for constructor, the order is important
     void scaleTranslationAndResolution();
     void setSystemResolutionMax();
@@ -258,6 +270,7 @@ class StructuralSimulation
     void initializeElasticSolidBodies();
     void initializeContactBetweenTwoBodies(int first, int second);
     void initializeAllContacts();
+    void initializeContactDynamics();
 
     // for initializeBoundaryConditions
     void initializeGravity();
@@ -272,6 +285,7 @@ class StructuralSimulation
     void initializePositionScaleSolidBody();
     void initializeTranslateSolidBody();
     void initializeTranslateSolidBodyPart();
+    void initializeQuasiStaticEquilibrium();
 
     // for runSimulation, the order is important
     void executeInitialNormalDirection();
@@ -296,6 +310,7 @@ class StructuralSimulation
     void executeStressRelaxationSecondHalf(Real dt);
     void executeUpdateCellLinkedList();
     void executeContactUpdateConfiguration();
+    void executeQuasiStaticEquilibrium();
 
     void initializeSimulation();
 
@@ -306,15 +321,33 @@ class StructuralSimulation
     ~StructuralSimulation();
 
     StdVec<SharedPtr<SolidBodyForSimulation>> get_solid_body_list_() { return solid_body_list_; };
+    SPHSystem &getSPHSystem() { return system_; };
+    /** Return to the state after initialization with the material parameters, physical viscosities,
+     *  time windows of the time dependent contacts, loads and constraints of the input,
+     *  while the bodies, particles and relations are kept. The other input is ignored.
+     *  Note that the material models are shared with the first input, whose parameters are overwritten. */
+    void reset(const StructuralSimulationInput &input);
     Real getMaxDisplacement(int body_index);
 
     // For c++
     void runSimulation(Real end_time);
+    // For c++, static equilibrium with the loads ramped up to those at end time in load steps
+    void runQuasiStaticSimulation(Real end_time, int load_steps);
 
     // For JS
     double runSimulationFixedDurationJS(int number_of_steps);
 };
 
+/**
+ * Runs the sweep points with a number of concurrent drivers, zero for one per hardware thread.
+ * Each driver builds one simulation from its first point, in the output sub-folder of the driver,
+ * and resets it to the following ones, so that the points should differ only in the input
+ * accepted by StructuralSimulation::reset. The sweep point function runs a given point.
+ */
+void runParameterSweep(const StdVec<StructuralSimulationInput> &inputs,
+                       const std::function<void(StructuralSimulation &, size_t)> &sweep_point,
+                       size_t number_of_concurrent_points = 0);
+
 class StructuralSimulationJS : public StructuralSimulation
 {
   public:
@@ -324,9 +357,17 @@ class StructuralSimulationJS : public StructuralSimulation
     void runSimulationFixedDuration(int number_of_steps);
 
     VtuStringData getVtuData();
+    /** the number of real particles of a body */
+    size_t getNumberOfParticles(size_t body_index);
+    /** the data of a Real or Vecd particle variable of a body, e.g. Position, as a flat array of reals,
+     *  which is viewed as a typed array in JS without serializing to VTP strings */
+    Real *getParticleVariableData(size_t body_index, const std::string &variable_name, size_t &number_of_reals);
+    /** the typed buffers of the positions and the variables to write of a body, exported without copy */
+    const BodyStatesBuffers &getBodyStatesBuffers(size_t body_index);
 
   private:
     BodyStatesRecordingToVtpString write_states_;
+    BodyStatesRecordingToMemory export_states_;
     Real dt;
 };
 
@@ -42,25 +42,14 @@ void MeshFileHelpers::numberOfNodes(std::ifstream &mesh_file, size_t &number_of_
 void MeshFileHelpers::nodeCoordinates(std::ifstream &mesh_file, StdLargeVec<Vecd> &node_coordinates_,
                                       std::string &text_line, size_t &dimension)
 {
+    StdVec<std::string> coordinate_lines;
     while (getline(mesh_file, text_line))
     {
         if (text_line.find("(", 0) == std::string::npos && text_line.find("))", 0) == std::string::npos)
         {
             if (text_line.find(" ", 0) != std::string::npos)
             {
-                size_t divide_position = text_line.find_first_of(" ");
-                std::string x_part = text_line;
-                std::string y_part = text_line;
-                std::string x_coordinate_string = x_part.erase(divide_position);
-                std::string y_coordinate_string = y_part.erase(0, divide_position);
-
-                Vec2d coordinate = Vec2d::Zero();
-                std::istringstream stream_x, stream_y;
-                stream_x.str(x_coordinate_string);
-                stream_y.str(y_coordinate_string);
-                stream_x >> coordinate[0];
-                stream_y >> coordinate[1];
-                node_coordinates_.push_back(coordinate);
+                coordinate_lines.push_back(text_line);
             }
         }
         if (text_line.find("))", 0) != std::string::npos)
@@ -68,6 +57,7 @@ void MeshFileHelpers::nodeCoordinates(std::ifstream &mesh_file, StdLargeVec<Vecd
             break;
         }
     }
+    parseNodeCoordinates(coordinate_lines, node_coordinates_);
 }
 //=================================================================================================//
 void MeshFileHelpers::numberOfElements(std::ifstream &mesh_file, size_t &number_of_elements, std::string &text_line)
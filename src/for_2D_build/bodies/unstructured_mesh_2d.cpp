@@ -6,11 +6,24 @@
 namespace SPH
 {
 //=================================================================================================//
-ANSYSMesh::ANSYSMesh(const std::string &full_path)
+ANSYSMesh::ANSYSMesh(const std::string &full_path, bool use_binary_cache)
 {
+    std::string cache_path = full_path + ".cache";
+    StdVec<UnsignedInt> mesh_file_key;
+    if (use_binary_cache)
+    {
+        mesh_file_key = meshFileKey(full_path);
+        if (readFromBinaryCache(cache_path, mesh_file_key))
+            return;
+    }
+
     getDataFromMeshFile(full_path);
     getElementCenterCoordinates();
+    reorderCells();
     getMinimumDistanceBetweenNodes();
+
+    if (use_binary_cache)
+        writeToBinaryCache(cache_path, mesh_file_key);
 }
 //=================================================================================================//
 void ANSYSMesh::getDataFromMeshFile(const std::string &full_path)
@@ -163,70 +176,36 @@ void NeighborBuilderInFVM::initializeRelation(Neighborhood &neighborhood, Real &
     neighborhood.e_ij_[current_size] = interface_normal_direction;
 }
 //=================================================================================================//
-InnerRelationInFVM::InnerRelationInFVM(RealBody &real_body, ANSYSMesh &ansys_mesh)
-    : BaseInnerRelationInFVM(real_body, ansys_mesh), get_inner_neighbor_(&real_body){};
-//=================================================================================================//
-template <typename GetParticleIndex, typename GetNeighborRelation>
-void InnerRelationInFVM::searchNeighborsByParticles(size_t total_particles, BaseParticles &source_particles,
-                                                    ParticleConfiguration &particle_configuration,
-                                                    GetParticleIndex &get_particle_index, GetNeighborRelation &get_neighbor_relation)
+void BaseInnerRelationInFVM::computeFaceGeometry(size_t index_i, const StdVec<size_t> &face_data,
+                                                 Real &area, Vecd &normal, Real &distance)
 {
-    parallel_for(
-        IndexRange(0, base_particles_.TotalRealParticles()),
-        [&](const IndexRange &r)
-        {
-            for (size_t num = r.begin(); num != r.end(); ++num)
-            {
-                size_t index_i = get_particle_index(num);
-                Vecd &particle_position = pos_[index_i];
-
-                Neighborhood &neighborhood = particle_configuration[index_i];
-                for (std::size_t neighbor = 0; neighbor != mesh_topology_[index_i].size(); ++neighbor)
-                {
-                    size_t index_j = mesh_topology_[index_i][neighbor][0] - 1;
-                    size_t boundary_type = mesh_topology_[index_i][neighbor][1];
-                    size_t interface_node1_index = mesh_topology_[index_i][neighbor][2];
-                    size_t interface_node2_index = mesh_topology_[index_i][neighbor][3];
-                    Vecd node1_position = Vecd(node_coordinates_[interface_node1_index][0], node_coordinates_[interface_node1_index][1]);
-                    Vecd node2_position = Vecd(node_coordinates_[interface_node2_index][0], node_coordinates_[interface_node2_index][1]);
-                    Vecd interface_area_StdVec = node1_position - node2_position;
-                    Real interface_area_size = interface_area_StdVec.norm();
-                    Vecd unit_StdVec = interface_area_StdVec / interface_area_size;
-                    // normal unit StdVec
-                    Vecd normal_StdVec = Vecd(unit_StdVec[1], -unit_StdVec[0]);
-                    // judge the direction
-                    Vecd node1_to_center_direction = particle_position - node1_position;
-                    if (node1_to_center_direction.dot(normal_StdVec) < 0)
-                    {
-                        normal_StdVec = -normal_StdVec;
-                    };
-                    Real r_ij = 0; // we need r_ij to calculate the viscous force
-                    // boundary_type == 2 means both of them are inside of fluid
-                    if (boundary_type == 2)
-                    {
-                        r_ij = (particle_position - pos_[index_j]).dot(normal_StdVec);
-                    }
-                    // this refer to the different types of wall boundary conditions
-                    if ((boundary_type == 3) | (boundary_type == 4) | (boundary_type == 5) |
-                        (boundary_type == 7) | (boundary_type == 9) | (boundary_type == 10) |
-                        (boundary_type == 36))
-                    {
-                        r_ij = node1_to_center_direction.dot(normal_StdVec) * 2.0;
-                    }
-                    Real dW_ij = -interface_area_size / (2.0 * Vol_[index_i] * Vol_[index_j]);
-                    get_neighbor_relation(neighborhood, r_ij, dW_ij, normal_StdVec, index_j);
-                }
-            }
-        },
-        ap);
+    size_t index_j = face_data[0] - 1;
+    size_t boundary_type = face_data[1];
+    Vecd node1_position = Vecd(node_coordinates_[face_data[2]][0], node_coordinates_[face_data[2]][1]);
+    Vecd node2_position = Vecd(node_coordinates_[face_data[3]][0], node_coordinates_[face_data[3]][1]);
+    Vecd interface_area_vector = node1_position - node2_position;
+    area = interface_area_vector.norm();
+    Vecd unit_vector = interface_area_vector / area;
+    normal = Vecd(unit_vector[1], -unit_vector[0]);
+    // judge the direction
+    Vecd node1_to_center_direction = pos_[index_i] - node1_position;
+    if (node1_to_center_direction.dot(normal) < 0)
+    {
+        normal = -normal;
+    };
+    distance = 0; // we need r_ij to calculate the viscous force
+    // boundary_type == 2 means both of them are inside of fluid
+    if (boundary_type == 2)
+    {
+        distance = (pos_[index_i] - pos_[index_j]).dot(normal);
+    }
+    // this refer to the different types of wall boundary conditions
+    if ((boundary_type == 3) | (boundary_type == 4) | (boundary_type == 5) |
+        (boundary_type == 7) | (boundary_type == 9) | (boundary_type == 10) |
+        (boundary_type == 36))
+    {
+        distance = node1_to_center_direction.dot(normal) * 2.0;
+    }
 }
 //=================================================================================================//
-void InnerRelationInFVM::updateConfiguration()
-{
-    resetNeighborhoodCurrentSize();
-    searchNeighborsByParticles(base_particles_.TotalRealParticles(),
-                               base_particles_, inner_configuration_,
-                               get_particle_index_, get_inner_neighbor_);
-}
-//=============================================================================================//
 } // namespace SPH
@@ -31,6 +31,11 @@ BoundingBox GeometricShapeBox::findBounds()
     return BoundingBox(-halfsize_, halfsize_);
 }
 //=================================================================================================//
+void GeometricShapeBox::appendContentKey(std::string &key)
+{
+    appendBinaryToKey(key, halfsize_);
+}
+//=================================================================================================//
 GeometricShapeBall::GeometricShapeBall(const Vec2d &center, Real radius,
                                        const std::string &shape_name)
     : Shape(shape_name), center_(center), radius_(radius) {}
@@ -55,4 +60,10 @@ BoundingBox GeometricShapeBall::findBounds()
     return BoundingBox(center_ - shift, center_ + shift);
 }
 //=================================================================================================//
+void GeometricShapeBall::appendContentKey(std::string &key)
+{
+    appendBinaryToKey(key, center_);
+    appendBinaryToKey(key, radius_);
+}
+//=================================================================================================//
 } // namespace SPH
\ No newline at end of file
@@ -284,4 +284,20 @@ BoundingBox MultiPolygonShape::findBounds()
     return multi_polygon_.findBounds();
 }
 //=================================================================================================//
+void MultiPolygonShape::appendContentKey(std::string &key)
+{
+    for (const boost_poly &polygon : multi_polygon_.getBoostMultiPoly())
+    {
+        appendBinaryToKey(key, uint64_t(polygon.outer().size()));
+        for (const auto &point : polygon.outer())
+            appendBinaryToKey(key, Vec2d(point.x(), point.y()));
+        for (const auto &inner_ring : polygon.inners())
+        {
+            appendBinaryToKey(key, uint64_t(inner_ring.size()));
+            for (const auto &point : inner_ring)
+                appendBinaryToKey(key, Vec2d(point.x(), point.y()));
+        }
+    }
+}
+//=================================================================================================//
 } // namespace SPH
\ No newline at end of file
@@ -10,79 +10,121 @@ void BodyStatesRecordingInMeshToVtp::writeWithFileName(const std::string &sequen
         if (body->checkNewlyUpdated() && state_recording_)
         {
             // TODO: we can short the file name by without using SPHBody
-            std::string filefullpath = io_environment_.output_folder_ + "/" + body->getName() + "_" + sequence + ".vtp";
+            std::string file_name = body->getName() + "_" + sequence + ".vtp";
+            std::string filefullpath = io_environment_.output_folder_ + "/" + file_name;
             if (fs::exists(filefullpath))
             {
                 fs::remove(filefullpath);
             }
-            std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
-            // begin of the XML file
-            out_file << "<?xml version=\"1.0\"?>\n";
-            out_file << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\">\n";
-            out_file << "<PolyData>\n";
-
-            // Write point data
-            out_file << "<Piece NumberOfPoints=\"" << node_coordinates_.size()
-                     << "\" NumberOfVerts=\"0\" NumberOfLines=\"0\" NumberOfStrips=\"0\" NumberOfPolys=\""
-                     << elements_nodes_connection_.size() << "\">\n";
-            out_file << "<Points>\n";
-            out_file << "<DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">\n";
-
-            size_t total_nodes = node_coordinates_.size();
-            for (size_t node = 0; node != total_nodes; ++node)
+            if (data_format_ != VtkDataFormat::ascii)
             {
-                Vec3d particle_position = upgradeToVec3d(node_coordinates_[node]);
-                out_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << "\n";
+                std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+                writeBinaryVtpInMesh(out_file, body->getBaseParticles());
+                out_file.close();
             }
+            else
+            {
+                std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+                // begin of the XML file
+                out_file << "<?xml version=\"1.0\"?>\n";
+                out_file << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\">\n";
+                out_file << "<PolyData>\n";
 
-            out_file << "</DataArray>\n";
-            out_file << "</Points>\n";
+                // Write point data
+                out_file << "<Piece NumberOfPoints=\"" << node_coordinates_.size()
+                         << "\" NumberOfVerts=\"0\" NumberOfLines=\"0\" NumberOfStrips=\"0\" NumberOfPolys=\""
+                         << elements_nodes_connection_.size() << "\">\n";
+                out_file << "<Points>\n";
+                out_file << "<DataArray type=\"Float64\" NumberOfComponents=\"3\" format=\"ascii\">\n";
 
-            // Write face data
-            out_file << "<Polys>\n";
-            out_file << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n";
+                size_t total_nodes = node_coordinates_.size();
+                for (size_t node = 0; node != total_nodes; ++node)
+                {
+                    Vec3d particle_position = upgradeToVec3d(node_coordinates_[node]);
+                    out_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << "\n";
+                }
 
-            for (const auto &element : elements_nodes_connection_)
-            {
-                for (const auto &vertex : element)
+                out_file << "</DataArray>\n";
+                out_file << "</Points>\n";
+
+                // Write face data
+                out_file << "<Polys>\n";
+                out_file << "<DataArray type=\"Int32\" Name=\"connectivity\" format=\"ascii\">\n";
+
+                for (const auto &element : elements_nodes_connection_)
                 {
-                    out_file << vertex << " ";
+                    for (const auto &vertex : element)
+                    {
+                        out_file << vertex << " ";
+                    }
+                    out_file << "\n";
                 }
-                out_file << "\n";
-            }
 
-            out_file << "</DataArray>\n";
-            out_file << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n";
+                out_file << "</DataArray>\n";
+                out_file << "<DataArray type=\"Int32\" Name=\"offsets\" format=\"ascii\">\n";
 
-            size_t offset = 0;
-            for (const auto &face : elements_nodes_connection_)
-            {
-                offset += face.size();
-                out_file << offset << " ";
-            }
+                size_t offset = 0;
+                for (const auto &face : elements_nodes_connection_)
+                {
+                    offset += face.size();
+                    out_file << offset << " ";
+                }
 
-            out_file << "\n</DataArray>\n";
-            out_file << "</Polys>\n";
+                out_file << "\n</DataArray>\n";
+                out_file << "</Polys>\n";
 
-            // Write face attribute data
-            out_file << "<CellData>\n";
+                // Write face attribute data
+                out_file << "<CellData>\n";
 
-            BaseParticles &particles = body->getBaseParticles();
-            writeParticlesToVtk(out_file, particles);
+                BaseParticles &particles = body->getBaseParticles();
+                writeParticlesToVtk(out_file, particles);
 
-            out_file << "</CellData>\n";
+                out_file << "</CellData>\n";
 
-            // Write file footer
-            out_file << "</Piece>\n";
-            out_file << "</PolyData>\n";
-            out_file << "</VTKFile>\n";
+                // Write file footer
+                out_file << "</Piece>\n";
+                out_file << "</PolyData>\n";
+                out_file << "</VTKFile>\n";
 
-            out_file.close();
+                out_file.close();
+            }
+            writePvdFile(body->getName(), file_name);
         }
         body->setNotNewlyUpdated();
     }
 }
 //=================================================================================================//
+void BodyStatesRecordingInMeshToVtp::writeBinaryVtpInMesh(std::ostream &output_stream, BaseParticles &particles)
+{
+    mesh_geometry_.prepare();
+    VtkBinaryWriter binary_writer(output_stream, data_format_);
+
+    output_stream << "<?xml version=\"1.0\"?>\n";
+    output_stream << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+    output_stream << " <PolyData>\n";
+    output_stream << "  <Piece NumberOfPoints=\"" << mesh_geometry_.NumberOfNodes()
+                  << "\" NumberOfVerts=\"0\" NumberOfLines=\"0\" NumberOfStrips=\"0\" NumberOfPolys=\""
+                  << mesh_geometry_.NumberOfCells() << "\">\n";
+
+    output_stream << "   <Points>\n";
+    binary_writer.writeDataArray("Points", mesh_geometry_.points_.data(), mesh_geometry_.NumberOfNodes(), 3);
+    output_stream << "   </Points>\n";
+
+    output_stream << "   <Polys>\n";
+    binary_writer.writeDataArray("connectivity", mesh_geometry_.connectivity_.data(), mesh_geometry_.connectivity_.size());
+    binary_writer.writeDataArray("offsets", mesh_geometry_.offsets_.data(), mesh_geometry_.NumberOfCells());
+    output_stream << "   </Polys>\n";
+
+    output_stream << "   <CellData>\n";
+    writeParticlesToVtk(binary_writer, particles, mesh_geometry_.cell_ids_.data());
+    output_stream << "   </CellData>\n";
+
+    output_stream << "  </Piece>\n";
+    output_stream << " </PolyData>\n";
+    binary_writer.writeAppendedData();
+    output_stream << "</VTKFile>\n";
+}
+//=================================================================================================//
 void BodyStatesRecordingInMeshToVtu::writeWithFileName(const std::string &sequence)
 {
     std::cout << "For 2D build:"
@@ -21,7 +21,7 @@ void CellLinkedList::
             Array2i cell = Array2i::Zero();
             cell[axis] = i;
             cell[second_axis] = j;
-            cell_data_lists[0].first.push_back(&getCellDataList(cell_index_lists_, cell));
+            cell_data_lists[0].first.push_back(&getCellDataList(cell_particles_.data(), cell));
             cell_data_lists[0].second.push_back(&getCellDataList(cell_data_lists_, cell));
         }
 
@@ -34,7 +34,7 @@ void CellLinkedList::
             Array2i cell = Array2i::Zero();
             cell[axis] = i;
             cell[second_axis] = j;
-            cell_data_lists[1].first.push_back(&getCellDataList(cell_index_lists_, cell));
+            cell_data_lists[1].first.push_back(&getCellDataList(cell_particles_.data(), cell));
             cell_data_lists[1].second.push_back(&getCellDataList(cell_data_lists_, cell));
         }
 }
@@ -78,7 +78,7 @@ void CellLinkedList::writeMeshFieldToPlt(std::ofstream &output_file)
     {
         for (int i = 0; i != number_of_operation[0]; ++i)
         {
-            output_file << getCellDataList(cell_index_lists_, Array2i(i, j)).size() << " ";
+            output_file << getCellDataList(cell_particles_.data(), Array2i(i, j)).size() << " ";
         }
         output_file << " \n";
     }
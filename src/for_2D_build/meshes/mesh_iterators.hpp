@@ -70,7 +70,7 @@ void mesh_for(const MeshRange &mesh_range, const LocalFunction &local_function,
 template <typename LocalFunction, typename... Args>
 void mesh_parallel_for(const MeshRange &mesh_range, const LocalFunction &local_function, Args &&...args)
 {
-    parallel_for(
+    arena_parallel_for(
         IndexRange2d((mesh_range.first)[0], (mesh_range.second)[0],
                      (mesh_range.first)[1], (mesh_range.second)[1]),
         [&](const IndexRange2d &r)
@@ -13,9 +13,9 @@
 namespace SPH
 {
 //=================================================================================================//
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType>
 template <typename DataType>
-DataType MeshWithGridDataPackages<PKG_SIZE>::
+DataType MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     DataValueFromGlobalIndex(MeshVariable<DataType> &mesh_variable,
                              const Arrayi &global_grid_index)
 {
@@ -32,21 +32,9 @@ DataType MeshWithGridDataPackages<PKG_SIZE>::
     return data[local_data_index[0]][local_data_index[1]];
 }
 //=================================================================================================//
-template <int PKG_SIZE>
-void MeshWithGridDataPackages<PKG_SIZE>::allocateIndexDataMatrix()
-{
-    Allocate2dArray(index_data_mesh_, all_cells_);
-}
-//=================================================================================================//
-template <int PKG_SIZE>
-void MeshWithGridDataPackages<PKG_SIZE>::deleteIndexDataMatrix()
-{
-    Delete2dArray(index_data_mesh_, all_cells_);
-}
-//=================================================================================================//
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType>
 template <class DataType>
-DataType MeshWithGridDataPackages<PKG_SIZE>::
+DataType MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     probeMesh(MeshVariable<DataType> &mesh_variable, const Vecd &position)
 {
     Arrayi cell_index = CellIndexFromPosition(position);
@@ -55,9 +43,9 @@ DataType MeshWithGridDataPackages<PKG_SIZE>::
                                           : mesh_variable.DataField()[package_index][0][0];
 }
 //=================================================================================================//
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType>
 template <typename FunctionOnData>
-void MeshWithGridDataPackages<PKG_SIZE>::
+void MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     for_each_cell_data(const FunctionOnData &function)
 {
     for (int i = 0; i != pkg_size; ++i)
@@ -67,36 +55,36 @@ void MeshWithGridDataPackages<PKG_SIZE>::
         }
 }
 //=================================================================================================//
-template <int PKG_SIZE>
-void MeshWithGridDataPackages<PKG_SIZE>::
+template <int PKG_SIZE, class PackageIndexMeshType>
+void MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     assignDataPackageIndex(const Arrayi &cell_index, const size_t package_index)
 {
-    index_data_mesh_[cell_index[0]][cell_index[1]] = package_index;
+    index_data_mesh_.set(cell_index, package_index);
 }
 //=================================================================================================//
-template <int PKG_SIZE>
-size_t MeshWithGridDataPackages<PKG_SIZE>::
+template <int PKG_SIZE, class PackageIndexMeshType>
+size_t MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     PackageIndexFromCellIndex(const Arrayi &cell_index)
 {
-    return index_data_mesh_[cell_index[0]][cell_index[1]];
+    return index_data_mesh_.get(cell_index);
 }
 //=================================================================================================//
-template <int PKG_SIZE>
-bool MeshWithGridDataPackages<PKG_SIZE>::
+template <int PKG_SIZE, class PackageIndexMeshType>
+bool MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     isSingularDataPackage(const Arrayi &cell_index)
 {
-    return index_data_mesh_[cell_index[0]][cell_index[1]] < 2;
+    return index_data_mesh_.get(cell_index) < 2;
 }
 //=================================================================================================//
-template <int PKG_SIZE>
-bool MeshWithGridDataPackages<PKG_SIZE>::
+template <int PKG_SIZE, class PackageIndexMeshType>
+bool MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     isInnerDataPackage(const Arrayi &cell_index)
 {
-    return index_data_mesh_[cell_index[0]][cell_index[1]] > 1;
+    return index_data_mesh_.get(cell_index) > 1;
 }
 //=================================================================================================//
-template <int PKG_SIZE>
-std::pair<size_t, Arrayi> MeshWithGridDataPackages<PKG_SIZE>::
+template <int PKG_SIZE, class PackageIndexMeshType>
+std::pair<size_t, Arrayi> MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     NeighbourIndexShift(const Arrayi shift_index, const CellNeighborhood &neighbour)
 {
     std::pair<size_t, Arrayi> result;
@@ -107,9 +95,9 @@ std::pair<size_t, Arrayi> MeshWithGridDataPackages<PKG_SIZE>::
     return result;
 }
 //=================================================================================================//
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType>
 template <typename DataType, typename FunctionByPosition>
-void MeshWithGridDataPackages<PKG_SIZE>::
+void MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     assignByPosition(MeshVariable<DataType> &mesh_variable,
                      const Arrayi &cell_index,
                      const FunctionByPosition &function_by_position)
@@ -124,9 +112,9 @@ void MeshWithGridDataPackages<PKG_SIZE>::
         }
 }
 //=================================================================================================//
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType>
 template <typename InDataType, typename OutDataType>
-void MeshWithGridDataPackages<PKG_SIZE>::
+void MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     computeGradient(MeshVariable<InDataType> &in_variable,
                     MeshVariable<OutDataType> &out_variable,
                     const size_t package_index)
@@ -153,9 +141,9 @@ void MeshWithGridDataPackages<PKG_SIZE>::
         });
 }
 //=================================================================================================//
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType>
 template <typename DataType>
-DataType MeshWithGridDataPackages<PKG_SIZE>::
+DataType MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     CornerAverage(MeshVariable<DataType> &mesh_variable, Arrayi addrs_index, Arrayi corner_direction, CellNeighborhood &neighborhood)
 {
     DataType average = ZeroData<DataType>::value;
@@ -171,9 +159,9 @@ DataType MeshWithGridDataPackages<PKG_SIZE>::
     return average * 0.25;
 }
 //=================================================================================================//
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType>
 template <class DataType>
-DataType MeshWithGridDataPackages<PKG_SIZE>::
+DataType MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
     probeDataPackage(MeshVariable<DataType> &mesh_variable, size_t package_index, const Arrayi &cell_index, const Vecd &position)
 {
     Arrayi data_index = DataIndexFromPosition(cell_index, position);
@@ -196,6 +184,132 @@ DataType MeshWithGridDataPackages<PKG_SIZE>::
     return bilinear;
 }
 //=================================================================================================//
+template <int PKG_SIZE, class PackageIndexMeshType>
+void MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::writeMeshToBinary(BinaryDataWriter &binary_writer, const std::string &prefix)
+{
+    Arrayi all_cells = all_cells_;
+    binary_writer.writeVariable<int>(prefix + "AllCells", all_cells.data(), Dimensions);
+    binary_writer.writeVariable<Real>(prefix + "DataSpacing", &data_spacing_, 1);
+    UnsignedInt num_grid_pkgs = num_grid_pkgs_;
+    binary_writer.writeVariable<UnsignedInt>(prefix + "NumberOfGridPackages", &num_grid_pkgs, 1);
+
+    StdVec<UnsignedInt> occupied_sort_index;
+    StdVec<int> occupied_type;
+    for (const std::pair<size_t, int> &occupied : occupied_data_pkgs_)
+    {
+        occupied_sort_index.push_back(occupied.first);
+        occupied_type.push_back(occupied.second);
+    }
+    binary_writer.writeVariable<UnsignedInt>(prefix + "OccupiedSortIndex", occupied_sort_index.data(), occupied_sort_index.size());
+    binary_writer.writeVariable<int>(prefix + "OccupiedType", occupied_type.data(), occupied_type.size());
+
+    StdVec<int> meta_data;
+    for (size_t i = 0; i != num_grid_pkgs_; ++i)
+    {
+        for (int n = 0; n != Dimensions; ++n)
+            meta_data.push_back(meta_data_cell_[i].first[n]);
+        meta_data.push_back(meta_data_cell_[i].second);
+    }
+    binary_writer.writeVariable<int>(prefix + "MetaDataCell", meta_data.data(), meta_data.size());
+    binary_writer.writeVariable<int>(prefix + "CellNeighborhood", reinterpret_cast<const int *>(cell_neighborhood_),
+                                     num_grid_pkgs_ * sizeof(CellNeighborhood) / sizeof(int));
+
+    StdVec<UnsignedInt> index_data;
+    mesh_for_each(Arrayi::Zero(), all_cells_, [&](const Arrayi &cell_index)
+                  { index_data.push_back(PackageIndexFromCellIndex(cell_index)); });
+    binary_writer.writeVariable<UnsignedInt>(prefix + "IndexDataMesh", index_data.data(), index_data.size());
+
+    write_mesh_variable_data_(binary_writer, prefix, num_grid_pkgs_);
+}
+//=================================================================================================//
+template <int PKG_SIZE, class PackageIndexMeshType>
+bool MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::readMeshFromBinary(BinaryDataReader &binary_reader, const std::string &prefix)
+{
+    Arrayi all_cells = Arrayi::Zero();
+    Real data_spacing = 0.0;
+    UnsignedInt num_grid_pkgs = 0;
+    if (!binary_reader.hasVariable<int>(prefix + "AllCells", Dimensions) ||
+        !binary_reader.hasVariable<Real>(prefix + "DataSpacing", 1) ||
+        !binary_reader.hasVariable<UnsignedInt>(prefix + "NumberOfGridPackages", 1))
+    {
+        return false;
+    }
+    binary_reader.readVariable<int>(prefix + "AllCells", all_cells.data(), Dimensions);
+    binary_reader.readVariable<Real>(prefix + "DataSpacing", &data_spacing, 1);
+    binary_reader.readVariable<UnsignedInt>(prefix + "NumberOfGridPackages", &num_grid_pkgs, 1);
+    if (num_grid_pkgs < 2 || all_cells.matrix() != all_cells_.matrix() || data_spacing != data_spacing_)
+    {
+        return false;
+    }
+
+    // all element counts are checked before the mesh is changed,
+    // so that a truncated or inconsistent file leads to a rebuild
+    size_t number_of_cells = all_cells_.prod();
+    if (!binary_reader.hasVariable<UnsignedInt>(prefix + "OccupiedSortIndex", num_grid_pkgs - 2) ||
+        !binary_reader.hasVariable<int>(prefix + "OccupiedType", num_grid_pkgs - 2) ||
+        !binary_reader.hasVariable<int>(prefix + "MetaDataCell", num_grid_pkgs * (Dimensions + 1)) ||
+        !binary_reader.hasVariable<int>(prefix + "CellNeighborhood", num_grid_pkgs * sizeof(CellNeighborhood) / sizeof(int)) ||
+        !binary_reader.hasVariable<UnsignedInt>(prefix + "IndexDataMesh", number_of_cells) ||
+        !checkMeshVariablesInBinary(binary_reader, prefix, num_grid_pkgs))
+    {
+        return false;
+    }
+
+    StdVec<UnsignedInt> occupied_sort_index(num_grid_pkgs - 2);
+    StdVec<int> occupied_type(num_grid_pkgs - 2);
+    binary_reader.readVariable<UnsignedInt>(prefix + "OccupiedSortIndex", occupied_sort_index.data(), occupied_sort_index.size());
+    binary_reader.readVariable<int>(prefix + "OccupiedType", occupied_type.data(), occupied_type.size());
+    occupied_data_pkgs_.clear();
+    for (size_t i = 0; i != occupied_sort_index.size(); ++i)
+    {
+        occupied_data_pkgs_.push_back(std::make_pair(size_t(occupied_sort_index[i]), occupied_type[i]));
+    }
+
+    delete[] cell_neighborhood_;
+    delete[] meta_data_cell_;
+    organizeOccupiedPackages();
+    resizeMeshVariableData();
+
+    StdVec<int> meta_data(num_grid_pkgs_ * (Dimensions + 1));
+    binary_reader.readVariable<int>(prefix + "MetaDataCell", meta_data.data(), meta_data.size());
+    for (size_t i = 0; i != num_grid_pkgs_; ++i)
+    {
+        for (int n = 0; n != Dimensions; ++n)
+            meta_data_cell_[i].first[n] = meta_data[i * (Dimensions + 1) + n];
+        meta_data_cell_[i].second = meta_data[i * (Dimensions + 1) + Dimensions];
+    }
+    binary_reader.readVariable<int>(prefix + "CellNeighborhood", reinterpret_cast<int *>(cell_neighborhood_),
+                                    num_grid_pkgs_ * sizeof(CellNeighborhood) / sizeof(int));
+
+    StdVec<UnsignedInt> index_data(number_of_cells);
+    binary_reader.readVariable<UnsignedInt>(prefix + "IndexDataMesh", index_data.data(), index_data.size());
+    size_t count = 0;
+    mesh_for_each(Arrayi::Zero(), all_cells_, [&](const Arrayi &cell_index)
+                  { assignDataPackageIndex(cell_index, index_data[count++]); });
+
+    return readMeshVariablesFromBinary(binary_reader, prefix);
+}
+//=================================================================================================//
+template <int PKG_SIZE, class PackageIndexMeshType>
+bool MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::readMeshVariablesFromBinary(BinaryDataReader &binary_reader, const std::string &prefix)
+{
+    if (!checkMeshVariablesInBinary(binary_reader, prefix, num_grid_pkgs_))
+    {
+        return false;
+    }
+    read_mesh_variable_data_(binary_reader, prefix, num_grid_pkgs_);
+    return true;
+}
+//=================================================================================================//
+template <int PKG_SIZE, class PackageIndexMeshType>
+bool MeshWithGridDataPackages<PKG_SIZE, PackageIndexMeshType>::
+    checkMeshVariablesInBinary(BinaryDataReader &binary_reader, const std::string &prefix, size_t num_grid_pkgs)
+{
+    bool is_complete = true;
+    check_mesh_variable_data_(binary_reader, prefix, num_grid_pkgs, is_complete);
+    return is_complete;
+}
+//=================================================================================================//
 } // namespace SPH
 //=================================================================================================//
 #endif // MESH_WITH_DATA_PACKAGES_2D_HPP
\ No newline at end of file
@@ -68,48 +68,4 @@ void GhostCreationFromMesh::addGhostParticleAndSetInConfiguration()
     }
 }
 //=================================================================================================//
-void BoundaryConditionSetupInFVM::resetBoundaryConditions()
-{
-    for (size_t boundary_type = 0; boundary_type < each_boundary_type_with_all_ghosts_index_.size(); ++boundary_type)
-    {
-        if (!each_boundary_type_with_all_ghosts_index_[boundary_type].empty())
-        {
-            for (size_t ghost_number = 0; ghost_number != each_boundary_type_with_all_ghosts_index_[boundary_type].size(); ++ghost_number)
-            {
-                size_t ghost_index = each_boundary_type_with_all_ghosts_index_[boundary_type][ghost_number];
-                size_t index_i = each_boundary_type_contact_real_index_[boundary_type][ghost_number];
-                Vecd e_ij = each_boundary_type_with_all_ghosts_eij_[boundary_type][ghost_number];
-
-                // Dispatch the appropriate boundary condition
-                switch (boundary_type)
-                {
-                case 3: // this refer to the different types of wall boundary conditions
-                    applyNonSlipWallBoundary(ghost_index, index_i);
-                    applyReflectiveWallBoundary(ghost_index, index_i, e_ij);
-                    break;
-                case 4:
-                    applyTopBoundary(ghost_index, index_i);
-                    break;
-                case 5:
-                    applyPressureOutletBC(ghost_index, index_i);
-                    break;
-                case 7:
-                    applySymmetryBoundary(ghost_index, index_i, e_ij);
-                    break;
-                case 9:
-                    applyFarFieldBoundary(ghost_index);
-                    break;
-                case 10:
-                    applyGivenValueInletFlow(ghost_index);
-                    applyVelocityInletFlow(ghost_index, index_i);
-                    break;
-                case 36:
-                    applyOutletBoundary(ghost_index, index_i);
-                    break;
-                }
-            }
-        }
-    }
-}
-//=================================================================================================//
 } // namespace SPH
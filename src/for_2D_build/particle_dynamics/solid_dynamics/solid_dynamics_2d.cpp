@@ -34,5 +34,29 @@ Vec2d UpdateElasticNormalDirection::getRotatedNormalDirection(const Mat2d &F, co
     return R * n0 / sqrt(pow(F00 + F11, 2) + pow(F01 - F10, 2));
 }
 //=================================================================================================//
+void UpdateElasticNormalDirectionBatched::exec(Real dt)
+{
+    // the 2D rotation is obtained in closed form, no batching is needed
+    particle_for(execution::par, IndexRange(0, particles_->TotalRealParticles()),
+                 [&](size_t index_i)
+                 { update(index_i, dt); });
+}
+//=================================================================================================//
+Real RigidBodyMotion::particleInertia(const Vecd &offset, Real mass)
+{
+    return mass * offset.squaredNorm();
+}
+//=================================================================================================//
+void RigidBodyMotion::integrateRotation(const SpatialVecd &total_force, Real dt)
+{
+    angular_velocity_ += total_force[2] / initial_inertia_ * dt;
+    rotation_ = Rotation2d(angular_velocity_ * dt).toRotationMatrix() * rotation_;
+}
+//=================================================================================================//
+Vecd RigidBodyMotion::rotationalVelocity(const Vecd &offset)
+{
+    return angular_velocity_ * Vec2d(-offset[1], offset[0]);
+}
+//=================================================================================================//
 } // namespace solid_dynamics
 } // namespace SPH
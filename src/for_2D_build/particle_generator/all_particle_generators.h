@@ -32,6 +32,7 @@
 #include "base_particle_generator.hpp"
 #include "particle_generator_lattice.h"
 #include "particle_generator_mesh.h"
+#include "particle_generator_split.h"
 #include "particle_generator_reserve.h"
 
 #endif // ALL_PARTICLE_GENERATORS_2D_H
\ No newline at end of file
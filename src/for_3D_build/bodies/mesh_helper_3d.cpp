@@ -43,34 +43,14 @@ void MeshFileHelpers::numberOfNodes(std::ifstream &mesh_file, size_t &number_of_
 
 void MeshFileHelpers::nodeCoordinates(std::ifstream &mesh_file, StdLargeVec<Vecd> &node_coordinates_, std::string &text_line, size_t &dimension)
 {
+    StdVec<std::string> coordinate_lines;
     while (getline(mesh_file, text_line))
     {
         if (text_line.find("(", 0) == std::string::npos && text_line.find("))", 0) == std::string::npos)
         {
-            if (text_line.find(" ", 0) != std::string::npos)
+            if (text_line.find(" ", 0) != std::string::npos && dimension == 3)
             {
-                if (dimension == 3)
-                {
-                    size_t first_devide_position = text_line.find_first_of(" ");
-                    size_t last_devide_position = text_line.find_last_of(" ");
-                    std::string x_part = text_line;
-                    std::string y_part = text_line;
-                    std::string z_part = text_line;
-                    std::string x_coordinate_string = x_part.erase(first_devide_position);
-                    std::string y_coordinate_string = y_part.erase(last_devide_position);
-                    y_coordinate_string = y_coordinate_string.erase(0, first_devide_position);
-                    std::string z_coordinate_string = z_part.erase(0, last_devide_position);
-                    std::istringstream streamx, streamy, streamz;
-                    Vecd Coords = Vecd::Zero();
-                    streamx.str(x_coordinate_string);
-                    streamy.str(y_coordinate_string);
-                    streamz.str(z_coordinate_string);
-                    streamx >> Coords[0];
-                    streamy >> Coords[1];
-                    streamz >> Coords[2];
-
-                    node_coordinates_.push_back(Coords);
-                }
+                coordinate_lines.push_back(text_line);
             }
         }
         if (text_line.find("))", 0) != std::string::npos)
@@ -78,6 +58,7 @@ void MeshFileHelpers::nodeCoordinates(std::ifstream &mesh_file, StdLargeVec<Vecd
             break;
         }
     }
+    parseNodeCoordinates(coordinate_lines, node_coordinates_);
 }
 
 void MeshFileHelpers::numberOfElements(std::ifstream &mesh_file, size_t &number_of_elements, std::string &text_line)
@@ -551,6 +532,7 @@ void MeshFileHelpers::numberOfElementsFluent(std::ifstream &mesh_file, size_t &n
 void MeshFileHelpers::nodeCoordinatesFluent(std::ifstream &mesh_file, StdLargeVec<Vecd> &node_coordinates_, std::string &text_line,
                                             size_t &dimension)
 {
+    StdVec<std::string> coordinate_lines;
     while (getline(mesh_file, text_line))
     {
         text_line.erase(0, 1);
@@ -562,24 +544,7 @@ void MeshFileHelpers::nodeCoordinatesFluent(std::ifstream &mesh_file, StdLargeVe
                 {
                     if (dimension == 3)
                     {
-                        size_t first_devide_position = text_line.find_first_of(" ");
-                        size_t last_devide_position = text_line.find_last_of(" ");
-                        std::string x_part = text_line;
-                        std::string y_part = text_line;
-                        std::string z_part = text_line;
-                        std::string x_coordinate_string = x_part.erase(first_devide_position);
-                        std::string y_coordinate_string = y_part.erase(last_devide_position);
-                        y_coordinate_string = y_coordinate_string.erase(0, first_devide_position);
-                        std::string z_coordinate_string = z_part.erase(0, last_devide_position);
-                        Vecd Coords = Vecd::Zero();
-                        std::istringstream streamx, streamy, streamz;
-                        streamx.str(x_coordinate_string);
-                        streamy.str(y_coordinate_string);
-                        streamz.str(z_coordinate_string);
-                        streamx >> Coords[0];
-                        streamy >> Coords[1];
-                        streamz >> Coords[2];
-                        node_coordinates_.push_back(Coords);
+                        coordinate_lines.push_back(text_line);
                     }
                 }
                 text_line.erase(0, 1);
@@ -593,6 +558,7 @@ void MeshFileHelpers::nodeCoordinatesFluent(std::ifstream &mesh_file, StdLargeVe
         if ((atoi(text_line.c_str()) == 11 && text_line.find(") (") != std::string::npos) || (atoi(text_line.c_str()) == 13 && text_line.find(") (") != std::string::npos) || (atoi(text_line.c_str()) == 12 && text_line.find(") (") != std::string::npos))
             break;
     }
+    parseNodeCoordinates(coordinate_lines, node_coordinates_);
 }
 
 void MeshFileHelpers::updateBoundaryCellListsFluent(StdVec<StdVec<StdVec<size_t>>> &mesh_topology_, StdLargeVec<StdVec<size_t>> &elements_nodes_connection_,
@@ -57,6 +57,11 @@ BoundingBox GeometricShapeBox::findBounds()
     return BoundingBox(-halfsize_, halfsize_);
 }
 //=================================================================================================//
+void GeometricShapeBox::appendContentKey(std::string &key)
+{
+    appendBinaryToKey(key, halfsize_);
+}
+//=================================================================================================//
 GeometricShapeBall::
     GeometricShapeBall(const Vecd &center, const Real &radius, const std::string &shape_name)
     : GeometricShape(shape_name), center_(center), sphere_(radius)
@@ -85,4 +90,10 @@ BoundingBox GeometricShapeBall::findBounds()
     return BoundingBox(center_ - shift, center_ + shift);
 }
 //=================================================================================================//
+void GeometricShapeBall::appendContentKey(std::string &key)
+{
+    appendBinaryToKey(key, center_);
+    appendBinaryToKey(key, Real(sphere_.getRadius()));
+}
+//=================================================================================================//
 } // namespace SPH
\ No newline at end of file
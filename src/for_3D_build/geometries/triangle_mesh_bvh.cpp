@@ -0,0 +1,563 @@
+#include "triangle_mesh_bvh.h"
+
+#include "tbb/parallel_invoke.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace SPH
+{
+//=================================================================================================//
+struct TriangleMeshBVH::BuildNode
+{
+    Vec3d lower_;
+    Vec3d upper_;
+    int begin_;
+    int end_;
+    UniquePtr<BuildNode> left_;
+    UniquePtr<BuildNode> right_;
+};
+//=================================================================================================//
+namespace
+{
+Real boxSurfaceArea(const Vec3d &lower, const Vec3d &upper)
+{
+    Vec3d extent = (upper - lower).cwiseMax(Vec3d::Zero());
+    return 2.0 * (extent[0] * extent[1] + extent[1] * extent[2] + extent[2] * extent[0]);
+}
+} // namespace
+//=================================================================================================//
+TriangleMeshBVH::TriangleMeshBVH(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &triangles)
+    : is_manifold_(false)
+{
+    build(vertices, triangles);
+}
+//=================================================================================================//
+void TriangleMeshBVH::build(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &triangles)
+{
+    if (triangles.empty())
+    {
+        std::cout << "\n Error: TriangleMeshBVH is built with an empty triangle list." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    vertices_ = vertices;
+    triangles_ = triangles;
+    size_t number_of_triangles = triangles_.size();
+
+    StdVec<Vec3d> lower(number_of_triangles);
+    StdVec<Vec3d> upper(number_of_triangles);
+    StdVec<Vec3d> centroids(number_of_triangles);
+    triangle_order_.resize(number_of_triangles);
+    parallel_for(
+        tbb::blocked_range<size_t>(0, number_of_triangles),
+        [&](const tbb::blocked_range<size_t> &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                const std::array<int, 3> &triangle = triangles_[i];
+                const Vec3d &a = vertices_[triangle[0]];
+                const Vec3d &b = vertices_[triangle[1]];
+                const Vec3d &c = vertices_[triangle[2]];
+                lower[i] = a.cwiseMin(b).cwiseMin(c);
+                upper[i] = a.cwiseMax(b).cwiseMax(c);
+                centroids[i] = (a + b + c) / 3.0;
+                triangle_order_[i] = int(i);
+            }
+        },
+        ap);
+
+    BuildNode root;
+    buildSubtree(root, lower, upper, centroids, 0, int(number_of_triangles));
+    nodes_.clear();
+    nodes_.reserve(2 * number_of_triangles / max_leaf_size_ + 1);
+    flattenSubtree(root);
+
+    computePseudoNormals();
+}
+//=================================================================================================//
+void TriangleMeshBVH::buildSubtree(BuildNode &build_node, const StdVec<Vec3d> &lower, const StdVec<Vec3d> &upper,
+                                   const StdVec<Vec3d> &centroids, int begin, int end)
+{
+    build_node.begin_ = begin;
+    build_node.end_ = end;
+    build_node.lower_ = MaxReal * Vec3d::Ones();
+    build_node.upper_ = -MaxReal * Vec3d::Ones();
+    Vec3d centroid_lower = MaxReal * Vec3d::Ones();
+    Vec3d centroid_upper = -MaxReal * Vec3d::Ones();
+    for (int i = begin; i != end; ++i)
+    {
+        int triangle = triangle_order_[i];
+        build_node.lower_ = build_node.lower_.cwiseMin(lower[triangle]);
+        build_node.upper_ = build_node.upper_.cwiseMax(upper[triangle]);
+        centroid_lower = centroid_lower.cwiseMin(centroids[triangle]);
+        centroid_upper = centroid_upper.cwiseMax(centroids[triangle]);
+    }
+
+    int number_of_triangles = end - begin;
+    if (number_of_triangles <= 1)
+        return;
+
+    int axis = 0;
+    Vec3d centroid_extent = centroid_upper - centroid_lower;
+    centroid_extent.maxCoeff(&axis);
+    Real extent = centroid_extent[axis];
+
+    int middle = begin;
+    if (extent > 0.0)
+    {
+        // binned surface area heuristic along the axis of the largest centroid extent
+        auto bin_index = [&](int triangle)
+        {
+            int bin = int(Real(number_of_bins_) * (centroids[triangle][axis] - centroid_lower[axis]) / extent);
+            return SMIN(bin, number_of_bins_ - 1);
+        };
+        std::array<int, number_of_bins_> bin_counts;
+        std::array<Vec3d, number_of_bins_> bin_lower, bin_upper;
+        bin_counts.fill(0);
+        bin_lower.fill(MaxReal * Vec3d::Ones());
+        bin_upper.fill(-MaxReal * Vec3d::Ones());
+        for (int i = begin; i != end; ++i)
+        {
+            int triangle = triangle_order_[i];
+            int bin = bin_index(triangle);
+            bin_counts[bin]++;
+            bin_lower[bin] = bin_lower[bin].cwiseMin(lower[triangle]);
+            bin_upper[bin] = bin_upper[bin].cwiseMax(upper[triangle]);
+        }
+
+        std::array<Real, number_of_bins_> right_costs;
+        Vec3d right_lower = MaxReal * Vec3d::Ones();
+        Vec3d right_upper = -MaxReal * Vec3d::Ones();
+        int right_count = 0;
+        for (int bin = number_of_bins_ - 1; bin > 0; --bin)
+        {
+            right_count += bin_counts[bin];
+            right_lower = right_lower.cwiseMin(bin_lower[bin]);
+            right_upper = right_upper.cwiseMax(bin_upper[bin]);
+            right_costs[bin] = right_count * boxSurfaceArea(right_lower, right_upper);
+        }
+
+        Real best_cost = MaxReal;
+        int best_split = 0;
+        Vec3d left_lower = MaxReal * Vec3d::Ones();
+        Vec3d left_upper = -MaxReal * Vec3d::Ones();
+        int left_count = 0;
+        for (int bin = 0; bin < number_of_bins_ - 1; ++bin)
+        {
+            left_count += bin_counts[bin];
+            left_lower = left_lower.cwiseMin(bin_lower[bin]);
+            left_upper = left_upper.cwiseMax(bin_upper[bin]);
+            Real cost = left_count * boxSurfaceArea(left_lower, left_upper) + right_costs[bin + 1];
+            if (left_count != 0 && left_count != number_of_triangles && cost < best_cost)
+            {
+                best_cost = cost;
+                best_split = bin;
+            }
+        }
+
+        Real leaf_cost = number_of_triangles * boxSurfaceArea(build_node.lower_, build_node.upper_);
+        if (number_of_triangles <= max_leaf_size_ && best_cost >= leaf_cost)
+            return;
+
+        middle = int(std::partition(triangle_order_.begin() + begin, triangle_order_.begin() + end,
+                                    [&](int triangle)
+                                    { return bin_index(triangle) <= best_split; }) -
+                     triangle_order_.begin());
+    }
+    else if (number_of_triangles <= max_leaf_size_)
+    {
+        return;
+    }
+
+    if (middle == begin || middle == end)
+    {
+        // median split if the heuristic does not separate the triangles
+        middle = begin + number_of_triangles / 2;
+        std::nth_element(triangle_order_.begin() + begin, triangle_order_.begin() + middle,
+                         triangle_order_.begin() + end,
+                         [&](int a, int b)
+                         { return centroids[a][axis] < centroids[b][axis]; });
+    }
+
+    build_node.left_ = makeUnique<BuildNode>();
+    build_node.right_ = makeUnique<BuildNode>();
+    BuildNode &left = *build_node.left_;
+    BuildNode &right = *build_node.right_;
+    if (size_t(number_of_triangles) > parallel_build_size_)
+    {
+        tbb::parallel_invoke([&]()
+                             { buildSubtree(left, lower, upper, centroids, begin, middle); },
+                             [&]()
+                             { buildSubtree(right, lower, upper, centroids, middle, end); });
+    }
+    else
+    {
+        buildSubtree(left, lower, upper, centroids, begin, middle);
+        buildSubtree(right, lower, upper, centroids, middle, end);
+    }
+}
+//=================================================================================================//
+void TriangleMeshBVH::flattenSubtree(BuildNode &build_node)
+{
+    size_t index = nodes_.size();
+    nodes_.push_back(Node{build_node.lower_, build_node.upper_, build_node.begin_, build_node.end_ - build_node.begin_});
+    if (build_node.left_ != nullptr)
+    {
+        flattenSubtree(*build_node.left_);
+        nodes_[index].right_or_first_ = int(nodes_.size());
+        nodes_[index].number_of_triangles_ = 0;
+        flattenSubtree(*build_node.right_);
+        build_node.left_.reset();
+        build_node.right_.reset();
+    }
+}
+//=================================================================================================//
+void TriangleMeshBVH::computePseudoNormals()
+{
+    size_t number_of_triangles = triangles_.size();
+    pseudo_normals_triangles_.resize(number_of_triangles);
+    pseudo_normals_edges_.resize(number_of_triangles);
+    pseudo_normals_vertices_.assign(vertices_.size(), Vec3d::Zero());
+
+    StdVec<std::array<Real, 3>> angles(number_of_triangles);
+    parallel_for(
+        tbb::blocked_range<size_t>(0, number_of_triangles),
+        [&](const tbb::blocked_range<size_t> &r)
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                const std::array<int, 3> &triangle = triangles_[i];
+                const Vec3d &a = vertices_[triangle[0]];
+                const Vec3d &b = vertices_[triangle[1]];
+                const Vec3d &c = vertices_[triangle[2]];
+                pseudo_normals_triangles_[i] = (b - a).cross(c - a).normalized();
+                angles[i][0] = acos(SMAX(Real(-1), SMIN(Real(1), (b - a).normalized().dot((c - a).normalized()))));
+                angles[i][1] = acos(SMAX(Real(-1), SMIN(Real(1), (a - b).normalized().dot((c - b).normalized()))));
+                angles[i][2] = acos(SMAX(Real(-1), SMIN(Real(1), (b - c).normalized().dot((a - c).normalized()))));
+            }
+        },
+        ap);
+
+    // edges are keyed by their sorted vertex indices
+    std::unordered_map<uint64_t, std::pair<Vec3d, int>> edges;
+    edges.reserve(2 * number_of_triangles);
+    uint64_t number_of_vertices = vertices_.size();
+    auto edge_key = [&](int i, int j)
+    { return uint64_t(SMIN(i, j)) * number_of_vertices + uint64_t(SMAX(i, j)); };
+    const std::array<std::array<int, 2>, 3> edge_vertices = {{{0, 1}, {1, 2}, {0, 2}}};
+    for (size_t i = 0; i != number_of_triangles; ++i)
+    {
+        const std::array<int, 3> &triangle = triangles_[i];
+        for (int k = 0; k != 3; ++k)
+        {
+            pseudo_normals_vertices_[triangle[k]] += angles[i][k] * pseudo_normals_triangles_[i];
+            auto result = edges.emplace(edge_key(triangle[edge_vertices[k][0]], triangle[edge_vertices[k][1]]),
+                                        std::make_pair(Vec3d::Zero().eval(), 0));
+            result.first->second.first += pseudo_normals_triangles_[i];
+            result.first->second.second++;
+        }
+    }
+
+    for (Vec3d &normal : pseudo_normals_vertices_)
+        normal.normalize();
+
+    for (size_t i = 0; i != number_of_triangles; ++i)
+    {
+        const std::array<int, 3> &triangle = triangles_[i];
+        for (int k = 0; k != 3; ++k)
+        {
+            pseudo_normals_edges_[i][k] =
+                edges[edge_key(triangle[edge_vertices[k][0]], triangle[edge_vertices[k][1]])].first.normalized();
+        }
+    }
+
+    is_manifold_ = std::all_of(edges.begin(), edges.end(), [](const auto &edge)
+                               { return edge.second.second == 2; });
+}
+//=================================================================================================//
+Real TriangleMeshBVH::squaredDistanceToBox(const Node &node, const Vec3d &probe_point) const
+{
+    Vec3d outside = (node.lower_ - probe_point).cwiseMax(probe_point - node.upper_).cwiseMax(Vec3d::Zero());
+    return outside.squaredNorm();
+}
+//=================================================================================================//
+Real TriangleMeshBVH::squaredDistanceToTriangle(size_t triangle_index, const Vec3d &p,
+                                                NearestEntity &nearest_entity, Vec3d &nearest_point) const
+{
+    // after the closest point on triangle in Real-Time Collision Detection by Ericson
+    const std::array<int, 3> &triangle = triangles_[triangle_index];
+    const Vec3d &a = vertices_[triangle[0]];
+    const Vec3d &b = vertices_[triangle[1]];
+    const Vec3d &c = vertices_[triangle[2]];
+    Vec3d ab = b - a;
+    Vec3d ac = c - a;
+    Vec3d bc = c - b;
+
+    Real snom = (p - a).dot(ab), sdenom = (p - b).dot(a - b);
+    Real tnom = (p - a).dot(ac), tdenom = (p - c).dot(a - c);
+    if (snom <= 0.0 && tnom <= 0.0)
+    {
+        nearest_entity = NearestEntity::V0;
+        nearest_point = a;
+        return (p - nearest_point).squaredNorm();
+    }
+
+    Real unom = (p - b).dot(bc), udenom = (p - c).dot(b - c);
+    if (sdenom <= 0.0 && unom <= 0.0)
+    {
+        nearest_entity = NearestEntity::V1;
+        nearest_point = b;
+        return (p - nearest_point).squaredNorm();
+    }
+    if (tdenom <= 0.0 && udenom <= 0.0)
+    {
+        nearest_entity = NearestEntity::V2;
+        nearest_point = c;
+        return (p - nearest_point).squaredNorm();
+    }
+
+    Vec3d n = ab.cross(ac);
+    Real vc = n.dot((a - p).cross(b - p));
+    if (vc <= 0.0 && snom >= 0.0 && sdenom >= 0.0)
+    {
+        nearest_entity = NearestEntity::E01;
+        nearest_point = a + snom / (snom + sdenom) * ab;
+        return (p - nearest_point).squaredNorm();
+    }
+
+    Real va = n.dot((b - p).cross(c - p));
+    if (va <= 0.0 && unom >= 0.0 && udenom >= 0.0)
+    {
+        nearest_entity = NearestEntity::E12;
+        nearest_point = b + unom / (unom + udenom) * bc;
+        return (p - nearest_point).squaredNorm();
+    }
+
+    Real vb = n.dot((c - p).cross(a - p));
+    if (vb <= 0.0 && tnom >= 0.0 && tdenom >= 0.0)
+    {
+        nearest_entity = NearestEntity::E02;
+        nearest_point = a + tnom / (tnom + tdenom) * ac;
+        return (p - nearest_point).squaredNorm();
+    }
+
+    Real u = va / (va + vb + vc);
+    Real v = vb / (va + vb + vc);
+    nearest_entity = NearestEntity::F;
+    nearest_point = u * a + v * b + (1.0 - u - v) * c;
+    return (p - nearest_point).squaredNorm();
+}
+//=================================================================================================//
+TriangleMeshQueryResult TriangleMeshBVH::findNearest(const Vec3d &probe_point, size_t triangle_hint) const
+{
+    StdVec<int> stack;
+    stack.reserve(64);
+    return findNearest(probe_point, triangle_hint, stack);
+}
+//=================================================================================================//
+TriangleMeshQueryResult TriangleMeshBVH::
+    findNearest(const Vec3d &probe_point, size_t triangle_hint, StdVec<int> &stack) const
+{
+    Real best_squared_distance = MaxReal;
+    size_t best_triangle = 0;
+    NearestEntity best_entity = NearestEntity::F;
+    Vec3d best_point = Vec3d::Zero();
+    NearestEntity entity;
+    Vec3d point;
+
+    if (triangle_hint < triangles_.size())
+    {
+        best_squared_distance = squaredDistanceToTriangle(triangle_hint, probe_point, best_entity, best_point);
+        best_triangle = triangle_hint;
+    }
+
+    stack.clear();
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        const Node &node = nodes_[stack.back()];
+        int node_index = stack.back();
+        stack.pop_back();
+        if (squaredDistanceToBox(node, probe_point) >= best_squared_distance)
+            continue;
+
+        if (node.number_of_triangles_ != 0)
+        {
+            for (int i = node.right_or_first_; i != node.right_or_first_ + node.number_of_triangles_; ++i)
+            {
+                size_t triangle = triangle_order_[i];
+                Real squared_distance = squaredDistanceToTriangle(triangle, probe_point, entity, point);
+                if (squared_distance < best_squared_distance)
+                {
+                    best_squared_distance = squared_distance;
+                    best_triangle = triangle;
+                    best_entity = entity;
+                    best_point = point;
+                }
+            }
+        }
+        else
+        {
+            // the nearer child is visited first
+            int left = node_index + 1;
+            int right = node.right_or_first_;
+            Real left_distance = squaredDistanceToBox(nodes_[left], probe_point);
+            Real right_distance = squaredDistanceToBox(nodes_[right], probe_point);
+            if (left_distance < right_distance)
+                std::swap(left, right);
+            stack.push_back(left);
+            stack.push_back(right);
+        }
+    }
+
+    Vec3d pseudo_normal = pseudo_normals_triangles_[best_triangle];
+    const std::array<int, 3> &triangle = triangles_[best_triangle];
+    switch (best_entity)
+    {
+    case NearestEntity::V0:
+        pseudo_normal = pseudo_normals_vertices_[triangle[0]];
+        break;
+    case NearestEntity::V1:
+        pseudo_normal = pseudo_normals_vertices_[triangle[1]];
+        break;
+    case NearestEntity::V2:
+        pseudo_normal = pseudo_normals_vertices_[triangle[2]];
+        break;
+    case NearestEntity::E01:
+        pseudo_normal = pseudo_normals_edges_[best_triangle][0];
+        break;
+    case NearestEntity::E12:
+        pseudo_normal = pseudo_normals_edges_[best_triangle][1];
+        break;
+    case NearestEntity::E02:
+        pseudo_normal = pseudo_normals_edges_[best_triangle][2];
+        break;
+    default:
+        break;
+    }
+
+    Real distance = sqrt(best_squared_distance);
+    return TriangleMeshQueryResult{(probe_point - best_point).dot(pseudo_normal) >= 0.0 ? distance : -distance,
+                                   best_point, best_triangle};
+}
+//=================================================================================================//
+void TriangleMeshBVH::findNearest(const Vec3d *probe_points, size_t number_of_points,
+                                  TriangleMeshQueryResult *results) const
+{
+    parallel_for(
+        tbb::blocked_range<size_t>(0, number_of_points, 256),
+        [&](const tbb::blocked_range<size_t> &r)
+        {
+            StdVec<int> stack;
+            stack.reserve(64);
+            size_t triangle_hint = MaxSize_t;
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                results[i] = findNearest(probe_points[i], triangle_hint, stack);
+                triangle_hint = results[i].triangle_index_;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void TriangleMeshBVH::findSignedDistances(const Vec3d *probe_points, size_t number_of_points,
+                                          Real *signed_distances) const
+{
+    parallel_for(
+        tbb::blocked_range<size_t>(0, number_of_points, 256),
+        [&](const tbb::blocked_range<size_t> &r)
+        {
+            StdVec<int> stack;
+            stack.reserve(64);
+            size_t triangle_hint = MaxSize_t;
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                TriangleMeshQueryResult result = findNearest(probe_points[i], triangle_hint, stack);
+                signed_distances[i] = result.signed_distance_;
+                triangle_hint = result.triangle_index_;
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+bool TriangleMeshBVH::countRayCrossings(const Vec3d &origin, const Vec3d &direction, size_t &crossings) const
+{
+    const Real tolerance = 1.0e3 * Eps;
+    Vec3d inverse_direction = direction.cwiseInverse();
+    crossings = 0;
+
+    StdVec<int> stack;
+    stack.reserve(64);
+    stack.push_back(0);
+    while (!stack.empty())
+    {
+        int node_index = stack.back();
+        const Node &node = nodes_[node_index];
+        stack.pop_back();
+
+        // slab test of the ray against the box
+        Vec3d t_lower = (node.lower_ - origin).cwiseProduct(inverse_direction);
+        Vec3d t_upper = (node.upper_ - origin).cwiseProduct(inverse_direction);
+        Real t_enter = t_lower.cwiseMin(t_upper).maxCoeff();
+        Real t_exit = t_lower.cwiseMax(t_upper).minCoeff();
+        if (t_exit < SMAX(t_enter, Real(0)))
+            continue;
+
+        if (node.number_of_triangles_ == 0)
+        {
+            stack.push_back(node_index + 1);
+            stack.push_back(node.right_or_first_);
+            continue;
+        }
+
+        for (int i = node.right_or_first_; i != node.right_or_first_ + node.number_of_triangles_; ++i)
+        {
+            // Moller-Trumbore intersection
+            const std::array<int, 3> &triangle = triangles_[triangle_order_[i]];
+            const Vec3d &a = vertices_[triangle[0]];
+            Vec3d ab = vertices_[triangle[1]] - a;
+            Vec3d ac = vertices_[triangle[2]] - a;
+            Vec3d p = direction.cross(ac);
+            Real determinant = ab.dot(p);
+            Real scale = ab.norm() * ac.norm();
+            if (fabs(determinant) <= tolerance * scale)
+                continue; // parallel to the triangle
+
+            Vec3d s = origin - a;
+            Real u = s.dot(p) / determinant;
+            if (u < -tolerance || u > 1.0 + tolerance)
+                continue;
+            Vec3d q = s.cross(ab);
+            Real v = direction.dot(q) / determinant;
+            if (v < -tolerance || u + v > 1.0 + tolerance)
+                continue;
+            Real t = ac.dot(q) / determinant;
+            if (t < -tolerance * sqrt(scale))
+                continue;
+
+            if (u < tolerance || v < tolerance || u + v > 1.0 - tolerance || t < tolerance * sqrt(scale))
+                return false; // close to an edge, a vertex or the origin on the surface
+            crossings++;
+        }
+    }
+    return true;
+}
+//=================================================================================================//
+bool TriangleMeshBVH::checkContainByRayParity(const Vec3d &probe_point) const
+{
+    // directions not aligned with the axes, to avoid hitting edges of structured meshes
+    const std::array<Vec3d, 3> directions = {Vec3d(0.8017837, 0.2672612, 0.5345225),
+                                             Vec3d(-0.3015113, 0.9045340, 0.3015113),
+                                             Vec3d(0.4264014, -0.6396021, 0.6396021)};
+    for (const Vec3d &direction : directions)
+    {
+        size_t crossings = 0;
+        if (countRayCrossings(probe_point, direction, crossings))
+            return crossings % 2 == 1;
+    }
+    return findSignedDistance(probe_point) < 0.0;
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,126 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	triangle_mesh_bvh.h
+ * @brief 	Parallel-safe distance and containment queries on a triangle mesh.
+ * @details The triangles are organized in a bounding volume hierarchy of axis-aligned boxes,
+ *          which is built in parallel with the binned surface area heuristic.
+ *          All queries are const and can be called concurrently without locks.
+ *          The sign of the distance is given by the angle-weighted pseudo-normals
+ *          of the nearest vertex, edge or face, while the containment can also be
+ *          tested by the parity of ray crossings, which does not rely on the normals.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef TRIANGLE_MESH_BVH_H
+#define TRIANGLE_MESH_BVH_H
+
+#include "base_data_package.h"
+
+#include <array>
+
+namespace SPH
+{
+struct TriangleMeshQueryResult
+{
+    Real signed_distance_; /**< negative within the mesh. */
+    Vec3d nearest_point_;
+    size_t triangle_index_;
+};
+
+/**
+ * @class TriangleMeshBVH
+ * @brief Bounding volume hierarchy of a triangle mesh for nearest point queries.
+ */
+class TriangleMeshBVH
+{
+  public:
+    TriangleMeshBVH() : is_manifold_(false){};
+    TriangleMeshBVH(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &triangles);
+    ~TriangleMeshBVH(){};
+
+    void build(const StdVec<Vec3d> &vertices, const StdVec<std::array<int, 3>> &triangles);
+    bool isBuilt() const { return !nodes_.empty(); };
+    /** closed mesh with each edge shared by exactly two triangles. */
+    bool isManifold() const { return is_manifold_; };
+    size_t NumberOfTriangles() const { return triangles_.size(); };
+
+    /** the triangle hint, e.g. the nearest triangle of a close probe point, speeds up the query */
+    TriangleMeshQueryResult findNearest(const Vec3d &probe_point, size_t triangle_hint = MaxSize_t) const;
+    Real findSignedDistance(const Vec3d &probe_point) const { return findNearest(probe_point).signed_distance_; };
+    /** batched queries in parallel, neighboring points in the batch reuse the result of the previous point */
+    void findSignedDistances(const Vec3d *probe_points, size_t number_of_points, Real *signed_distances) const;
+    void findNearest(const Vec3d *probe_points, size_t number_of_points, TriangleMeshQueryResult *results) const;
+    /** containment by the parity of ray crossings, falls back to the pseudo-normals
+     *  only if the rays in all trial directions hit the mesh ambiguously */
+    bool checkContainByRayParity(const Vec3d &probe_point) const;
+
+  protected:
+    enum class NearestEntity
+    {
+        V0,
+        V1,
+        V2,
+        E01,
+        E12,
+        E02,
+        F
+    };
+
+    /** a leaf has triangles, with indices of triangle_order_ from first, an inner node has the left child next to it */
+    struct Node
+    {
+        Vec3d lower_;
+        Vec3d upper_;
+        int right_or_first_;
+        int number_of_triangles_;
+    };
+
+    struct BuildNode;
+    static constexpr int max_leaf_size_ = 4;
+    static constexpr int number_of_bins_ = 16;
+    static constexpr size_t parallel_build_size_ = 4096;
+
+    StdVec<Vec3d> vertices_;
+    StdVec<std::array<int, 3>> triangles_;
+    StdVec<int> triangle_order_;
+    StdVec<Node> nodes_;
+    StdVec<Vec3d> pseudo_normals_triangles_;
+    StdVec<std::array<Vec3d, 3>> pseudo_normals_edges_;
+    StdVec<Vec3d> pseudo_normals_vertices_;
+    bool is_manifold_;
+
+    void buildSubtree(BuildNode &build_node, const StdVec<Vec3d> &lower, const StdVec<Vec3d> &upper,
+                      const StdVec<Vec3d> &centroids, int begin, int end);
+    void flattenSubtree(BuildNode &build_node);
+    void computePseudoNormals();
+
+    Real squaredDistanceToBox(const Node &node, const Vec3d &probe_point) const;
+    Real squaredDistanceToTriangle(size_t triangle_index, const Vec3d &probe_point,
+                                   NearestEntity &nearest_entity, Vec3d &nearest_point) const;
+    TriangleMeshQueryResult findNearest(const Vec3d &probe_point, size_t triangle_hint, StdVec<int> &stack) const;
+    /** returns false if a crossing is too close to an edge or vertex to be counted reliably */
+    bool countRayCrossings(const Vec3d &origin, const Vec3d &direction, size_t &crossings) const;
+};
+} // namespace SPH
+#endif // TRIANGLE_MESH_BVH_H
@@ -97,6 +97,20 @@ BoundingBox TriangleMeshShape::findBounds()
     return BoundingBox(lower_bound, upper_bound);
 }
 //=================================================================================================//
+void TriangleMeshShape::appendContentKey(std::string &key)
+{
+    SimTK::ContactGeometry::TriangleMesh *triangle_mesh = getTriangleMesh();
+    int number_of_vertices = triangle_mesh->getNumVertices();
+    int number_of_faces = triangle_mesh->getNumFaces();
+    appendBinaryToKey(key, number_of_vertices);
+    appendBinaryToKey(key, number_of_faces);
+    for (int i = 0; i != number_of_vertices; ++i)
+        appendBinaryToKey(key, SimTKToEigen(triangle_mesh->getVertexPosition(i)));
+    for (int i = 0; i != number_of_faces; ++i)
+        for (int k = 0; k != 3; ++k)
+            appendBinaryToKey(key, triangle_mesh->getFaceVertex(i, k));
+}
+//=================================================================================================//
 TriangleMeshShapeBrick::TriangleMeshShapeBrick(Vecd halfsize, int resolution, Vecd translation,
                                                const std::string &shape_name)
     : TriangleMeshShape(shape_name)
@@ -129,7 +143,7 @@ TriangleMeshShapeCylinder::TriangleMeshShapeCylinder(SimTK::UnitVec3 axis, Real
 //=================================================================================================//
 TriangleMeshShapeSTL::TriangleMeshShapeSTL(const std::string &filepathname, Vec3d translation,
                                            Real scale_factor, const std::string &shape_name)
-    : TriangleMeshShape(shape_name)
+    : TriangleMeshShape(shape_name), contain_by_ray_parity_(false)
 {
     if (!fs::exists(filepathname))
     {
@@ -143,15 +157,14 @@ TriangleMeshShapeSTL::TriangleMeshShapeSTL(const std::string &filepathname, Vec3
     polymesh.transformMesh(SimTKVec3(translation[0], translation[1], translation[2]));
     triangle_mesh_ = generateTriangleMesh(polymesh);
 
-    std::vector<std::array<Real, 3>> vertices;
+    StdVec<Vec3d> vertices;
     vertices.reserve(polymesh.getNumVertices());
     for (int i = 0; i < polymesh.getNumVertices(); i++)
     {
-        const auto &p = polymesh.getVertexPosition(i);
-        vertices.push_back({Real(p[0]), Real(p[1]), Real(p[2])});
+        vertices.push_back(SimTKToEigen(polymesh.getVertexPosition(i)));
     }
 
-    std::vector<std::array<int, 3>> faces;
+    StdVec<std::array<int, 3>> faces;
     faces.reserve(polymesh.getNumFaces());
     for (int i = 0; i < polymesh.getNumFaces(); i++)
     {
@@ -160,20 +173,27 @@ TriangleMeshShapeSTL::TriangleMeshShapeSTL(const std::string &filepathname, Vec3
         auto f3 = polymesh.getFaceVertex(i, 2);
         faces.push_back({f1, f2, f3});
     }
-    triangle_mesh_distance_.construct(vertices, faces);
+    triangle_mesh_bvh_.build(vertices, faces);
 }
 //=================================================================================================//
 bool TriangleMeshShapeSTL::checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED)
 {
-    Real distance = triangle_mesh_distance_.signed_distance(probe_point).distance;
-
-    return distance < 0.0 ? true : false;
+    return contain_by_ray_parity_ ? triangle_mesh_bvh_.checkContainByRayParity(probe_point)
+                                  : triangle_mesh_bvh_.findSignedDistance(probe_point) < 0.0;
 }
 //=================================================================================================//
 Vecd TriangleMeshShapeSTL::findClosestPoint(const Vecd &probe_point)
 {
-    auto closest_pnt = triangle_mesh_distance_.signed_distance(probe_point).nearest_point;
-    return Vecd(closest_pnt[0], closest_pnt[1], closest_pnt[2]);
+    return triangle_mesh_bvh_.findNearest(probe_point).nearest_point_;
+}
+//=================================================================================================//
+Real TriangleMeshShapeSTL::findSignedDistance(const Vecd &probe_point)
+{
+    if (contain_by_ray_parity_)
+    {
+        return Shape::findSignedDistance(probe_point);
+    }
+    return triangle_mesh_bvh_.findSignedDistance(probe_point);
 }
 //=================================================================================================//
 } // namespace SPH
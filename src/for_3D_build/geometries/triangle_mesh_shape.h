@@ -30,9 +30,9 @@
 #ifndef TRIANGULAR_MESH_SHAPE_H
 #define TRIANGULAR_MESH_SHAPE_H
 
-#include "TriangleMeshDistance.h"
 #include "all_simbody.h"
 #include "base_geometry.h"
+#include "triangle_mesh_bvh.h"
 
 #include <filesystem>
 #include <fstream>
@@ -63,6 +63,8 @@ class TriangleMeshShape : public Shape
      * when probe distance is far from the surface. */
     virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+    /** the vertices and faces of the triangle mesh */
+    virtual void appendContentKey(std::string &key) override;
 
     SimTK::ContactGeometry::TriangleMesh *getTriangleMesh();
 
@@ -131,13 +133,19 @@ class TriangleMeshShapeSTL : public TriangleMeshShape
                                   const std::string &shape_name = "TriangleMeshShapeSTL");
     virtual ~TriangleMeshShapeSTL(){};
 
-    /** Here, we use the open source method TriangleMeshDistance library.
+    /** The queries are answered by a bounding volume hierarchy, which can be used concurrently.
+     *  The sign of the distance is given by pseudo-normals as in the TriangleMeshDistance library.
      * https://github.com/InteractiveComputerGraphics/TriangleMeshDistance/tree/main */
     virtual bool checkContain(const Vec3d &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vec3d findClosestPoint(const Vec3d &probe_point) override;
+    virtual Real findSignedDistance(const Vec3d &probe_point) override;
+    /** containment by the parity of ray crossings, e.g. for meshes with inconsistent normals */
+    void setContainByRayParity(bool contain_by_ray_parity) { contain_by_ray_parity_ = contain_by_ray_parity; };
+    TriangleMeshBVH &getTriangleMeshBVH() { return triangle_mesh_bvh_; };
 
   protected:
-    tmd::TriangleMeshDistance triangle_mesh_distance_;
+    TriangleMeshBVH triangle_mesh_bvh_;
+    bool contain_by_ray_parity_;
 };
 } // namespace SPH
 
@@ -11,42 +11,84 @@ void BodyStatesRecordingInMeshToVtu::writeWithFileName(const std::string &sequen
     {
         if (body->checkNewlyUpdated() && state_recording_)
         {
-            std::string filefullpath = io_environment_.output_folder_ + "/SPHBody_" + body->getName() + "_" + sequence + ".vtu";
+            std::string file_name = "SPHBody_" + body->getName() + "_" + sequence + ".vtu";
+            std::string filefullpath = io_environment_.output_folder_ + "/" + file_name;
             if (fs::exists(filefullpath))
             {
                 fs::remove(filefullpath);
             }
-            std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+            if (data_format_ != VtkDataFormat::ascii)
+            {
+                std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+                writeBinaryVtuInMesh(out_file, body->getBaseParticles());
+                out_file.close();
+            }
+            else
+            {
+                std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
 
-            MeshFileHelpers::vtuFileHeader(out_file);
-            Real range_max = 0.0;
-            MeshFileHelpers::vtuFileNodeCoordinates(out_file, node_coordinates_, elements_nodes_connection_, bounds_, range_max);
+                MeshFileHelpers::vtuFileHeader(out_file);
+                Real range_max = 0.0;
+                MeshFileHelpers::vtuFileNodeCoordinates(out_file, node_coordinates_, elements_nodes_connection_, bounds_, range_max);
 
-            MeshFileHelpers::vtuFileInformationKey(out_file, range_max);
+                MeshFileHelpers::vtuFileInformationKey(out_file, range_max);
 
-            MeshFileHelpers::vtuFileCellConnectivity(out_file, elements_nodes_connection_, node_coordinates_);
+                MeshFileHelpers::vtuFileCellConnectivity(out_file, elements_nodes_connection_, node_coordinates_);
 
-            MeshFileHelpers::vtuFileOffsets(out_file, elements_nodes_connection_);
+                MeshFileHelpers::vtuFileOffsets(out_file, elements_nodes_connection_);
 
-            MeshFileHelpers::vtuFileTypeOfCell(out_file, elements_nodes_connection_);
+                MeshFileHelpers::vtuFileTypeOfCell(out_file, elements_nodes_connection_);
 
-            // write Particle data to vtu file
-            out_file << "<CellData>\n";
+                // write Particle data to vtu file
+                out_file << "<CellData>\n";
 
-            BaseParticles &particles = body->getBaseParticles();
-            writeParticlesToVtk(out_file, particles);
+                BaseParticles &particles = body->getBaseParticles();
+                writeParticlesToVtk(out_file, particles);
 
-            out_file << "</CellData>\n";
-            // Write VTU file footer
-            out_file << "</Piece>\n";
-            out_file << "</UnstructuredGrid>\n";
-            out_file << "</VTKFile>\n";
-            out_file.close();
+                out_file << "</CellData>\n";
+                // Write VTU file footer
+                out_file << "</Piece>\n";
+                out_file << "</UnstructuredGrid>\n";
+                out_file << "</VTKFile>\n";
+                out_file.close();
+            }
+            writePvdFile(body->getName(), file_name);
         }
         body->setNotNewlyUpdated();
     }
 }
 //=================================================================================================//
+void BodyStatesRecordingInMeshToVtu::writeBinaryVtuInMesh(std::ostream &output_stream, BaseParticles &particles)
+{
+    mesh_geometry_.prepare();
+    VtkBinaryWriter binary_writer(output_stream, data_format_);
+
+    output_stream << "<?xml version=\"1.0\"?>\n";
+    output_stream << "<VTKFile type=\"UnstructuredGrid\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\">\n";
+    output_stream << " <UnstructuredGrid>\n";
+    output_stream << "  <Piece NumberOfPoints=\"" << mesh_geometry_.NumberOfNodes()
+                  << "\" NumberOfCells=\"" << mesh_geometry_.NumberOfCells() << "\">\n";
+
+    output_stream << "   <Points>\n";
+    binary_writer.writeDataArray("Points", mesh_geometry_.points_.data(), mesh_geometry_.NumberOfNodes(), 3);
+    output_stream << "   </Points>\n";
+
+    output_stream << "   <Cells>\n";
+    binary_writer.writeDataArray("connectivity", mesh_geometry_.connectivity_.data(), mesh_geometry_.connectivity_.size());
+    binary_writer.writeDataArray("offsets", mesh_geometry_.offsets_.data(), mesh_geometry_.NumberOfCells());
+    binary_writer.writeDataArray("types", mesh_geometry_.types_.data(), mesh_geometry_.NumberOfCells());
+    output_stream << "   </Cells>\n";
+
+    output_stream << "   <CellData>\n";
+    writeParticlesToVtk(binary_writer, particles, mesh_geometry_.cell_ids_.data());
+    output_stream << "   </CellData>\n";
+
+    output_stream << "  </Piece>\n";
+    output_stream << " </UnstructuredGrid>\n";
+    binary_writer.writeAppendedData();
+    output_stream << "</VTKFile>\n";
+}
+//=================================================================================================//
 void BodyStatesRecordingInMeshToVtp::writeWithFileName(const std::string &sequence)
 {
     std::cout << "For 3D build:"
@@ -32,7 +32,7 @@ void CellLinkedList::
                 cell[axis] = i;
                 cell[second_axis] = j;
                 cell[third_axis] = k;
-                cell_data_lists[0].first.push_back(&getCellDataList(cell_index_lists_, cell));
+                cell_data_lists[0].first.push_back(&getCellDataList(cell_particles_.data(), cell));
                 cell_data_lists[0].second.push_back(&getCellDataList(cell_data_lists_, cell));
             }
         }
@@ -52,7 +52,7 @@ void CellLinkedList::
                 cell[axis] = i;
                 cell[second_axis] = j;
                 cell[third_axis] = k;
-                cell_data_lists[1].first.push_back(&getCellDataList(cell_index_lists_, cell));
+                cell_data_lists[1].first.push_back(&getCellDataList(cell_particles_.data(), cell));
                 cell_data_lists[1].second.push_back(&getCellDataList(cell_data_lists_, cell));
             }
         }
@@ -113,7 +113,7 @@ void CellLinkedList::writeMeshFieldToPlt(std::ofstream &output_file)
         {
             for (int i = 0; i != number_of_operation[0]; ++i)
             {
-                output_file << getCellDataList(cell_data_lists_, Array3i(i, j, k)).size() << " ";
+                output_file << getCellDataList(cell_particles_.data(), Array3i(i, j, k)).size() << " ";
             }
             output_file << " \n";
         }
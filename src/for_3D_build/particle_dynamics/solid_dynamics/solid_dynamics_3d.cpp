@@ -7,6 +7,7 @@
 #include "external_force.h"
 #include "neighborhood.h"
 #include "polar_decomposition_3x3.h"
+#include "polar_decomposition_3x3_batched.h"
 #include "solid_body.h"
 #include "weakly_compressible_fluid.h"
 
@@ -34,5 +35,52 @@ Vec3d UpdateElasticNormalDirection::getRotatedNormalDirection(const Mat3d &F, co
     return R * n0;
 }
 //=================================================================================================//
+void UpdateElasticNormalDirectionBatched::exec(Real dt)
+{
+    size_t total_real_particles = particles_->TotalRealParticles();
+    size_t number_of_batches = (total_real_particles + batch_size_ - 1) / batch_size_;
+    particle_for(execution::par, IndexRange(0, number_of_batches),
+                 [&](size_t batch)
+                 {
+                     size_t first = batch * batch_size_;
+                     int lanes = int(SMIN(size_t(batch_size_), total_real_particles - first));
+                     MatrixBatch3x3<batch_size_> A, Q, H;
+                     for (int l = 0; l != batch_size_; ++l)
+                     {
+                         // unused lanes are padded with identity
+                         A.load(l, l < lanes ? F_[first + l] : Mat3d::Identity());
+                     }
+                     polarDecompositionBatched(A, Q, H);
+                     for (int l = 0; l != lanes; ++l)
+                     {
+                         size_t index_i = first + l;
+                         n_[index_i] = Q.get(l) * n0_[index_i];
+                         Vec3d current_normal = F_[index_i].inverse().transpose() * n0_[index_i];
+                         phi_[index_i] = phi0_[index_i] / (current_normal.norm() + SqrtEps);
+                     }
+                 });
+}
+//=================================================================================================//
+Mat3d RigidBodyMotion::particleInertia(const Vecd &offset, Real mass)
+{
+    return mass * (offset.squaredNorm() * Mat3d::Identity() - offset * offset.transpose());
+}
+//=================================================================================================//
+void RigidBodyMotion::integrateRotation(const SpatialVecd &total_force, Real dt)
+{
+    // Euler's equation with the inertia in the current orientation
+    Mat3d inertia = rotation_ * initial_inertia_ * rotation_.transpose();
+    Vec3d torque = total_force.tail<3>();
+    angular_velocity_ += inertia.inverse() * (torque - angular_velocity_.cross(inertia * angular_velocity_)) * dt;
+    Real angle = angular_velocity_.norm() * dt;
+    if (angle > TinyReal)
+        rotation_ = Eigen::AngleAxis<Real>(angle, angular_velocity_.normalized()).toRotationMatrix() * rotation_;
+}
+//=================================================================================================//
+Vecd RigidBodyMotion::rotationalVelocity(const Vecd &offset)
+{
+    return angular_velocity_.cross(offset);
+}
+//=================================================================================================//
 } // namespace solid_dynamics
 } // namespace SPH
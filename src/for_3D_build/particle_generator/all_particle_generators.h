@@ -33,6 +33,7 @@
 #include "line_particle_generator.h"
 #include "particle_generator_lattice.h"
 #include "particle_generator_mesh.h"
+#include "particle_generator_split.h"
 #include "particle_generator_network.h"
 #include "particle_generator_reserve.h"
 
@@ -1,11 +1,16 @@
 #include "particle_generator_network.h"
 #include "base_body.h"
 #include "base_particles.h"
+#include "binary_data_file.h"
 #include "cell_linked_list.h"
 #include "io_all.h"
 #include "level_set.h"
 #include "sph_system.h"
 
+#include <iomanip>
+#include <sstream>
+#include <typeinfo>
+
 namespace SPH
 {
 //=================================================================================================//
@@ -166,6 +171,79 @@ bool ParticleGenerator<BaseParticles, Network>::
 }
 //=================================================================================================//
 void ParticleGenerator<BaseParticles, Network>::prepareGeometricData()
+{
+    bool is_cache_used = sph_body_.getSPHSystem().NetworkCache();
+    if (is_cache_used && readFromCache())
+        return;
+
+    growNetwork();
+
+    if (is_cache_used)
+        writeToCache();
+}
+//=================================================================================================//
+std::string ParticleGenerator<BaseParticles, Network>::cacheFileFullPath()
+{
+    std::string cache_key = std::string(typeid(*this).name()) + sph_body_.getName() + initial_shape_.getName();
+    auto append_to_key = [&](const auto &value)
+    { cache_key.append(reinterpret_cast<const char *>(&value), sizeof(value)); };
+    append_to_key(starting_pnt_);
+    append_to_key(second_pnt_);
+    append_to_key(n_it_);
+    append_to_key(fascicles_);
+    append_to_key(segments_in_branch_);
+    append_to_key(segment_length_);
+    append_to_key(angle_);
+    append_to_key(repulsivity_);
+    append_to_key(grad_factor_);
+    append_to_key(fascicle_ratio_);
+    for (const Real &fascicle_angle : fascicle_angles_)
+        append_to_key(fascicle_angle);
+    BoundingBox bounds = initial_shape_.getBounds();
+    append_to_key(bounds.first_);
+    append_to_key(bounds.second_);
+
+    std::string cache_folder = sph_body_.getSPHSystem().getIOEnvironment().reload_folder_ + "/network_cache";
+    if (!fs::exists(cache_folder))
+    {
+        fs::create_directories(cache_folder);
+    }
+    std::ostringstream hash_string;
+    hash_string << std::hex << std::setw(16) << std::setfill('0') << hashBinaryData(cache_key.data(), cache_key.size());
+    return cache_folder + "/" + sph_body_.getName() + "_" + hash_string.str() + ".bin";
+}
+//=================================================================================================//
+bool ParticleGenerator<BaseParticles, Network>::readFromCache()
+{
+    std::string filefullpath = cacheFileFullPath();
+    if (!fs::exists(filefullpath))
+        return false;
+
+    BinaryDataReader binary_reader(filefullpath);
+    if (!binary_reader.hasVariable("Position") || !tree_->readBranchesFromBinary(binary_reader))
+        return false;
+
+    StdVec<Vecd> positions(binary_reader.getIndex()["Position"].entry_.number_of_elements_);
+    binary_reader.readVariable<Vecd>("Position", positions.data(), positions.size());
+    // the first particle on the root has been added already
+    for (size_t i = 1; i < positions.size(); ++i)
+    {
+        addPositionAndVolumetricMeasure(positions[i], segment_length_);
+    }
+    std::cout << "\n Reading the network of " << sph_body_.getName()
+              << " with " << position_.size() << " particles from the cache " << filefullpath << std::endl;
+    return true;
+}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Network>::writeToCache()
+{
+    BinaryDataWriter binary_writer(cacheFileFullPath());
+    binary_writer.writeVariable<Vecd>("Position", position_.data(), position_.size());
+    tree_->writeBranchesToBinary(binary_writer);
+    binary_writer.finalize();
+}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Network>::growNetwork()
 {
     ParticleGenerationRecordingToVtp write_particle_generation(sph_body_, position_);
 
@@ -103,6 +103,15 @@ class ParticleGenerator<BaseParticles, Network> : public ParticleGenerator<BaseP
     virtual bool extraCheck(const Vecd &new_point) { return false; };
 
     void growAParticleOnBranch(TreeBody::Branch *branch, const Vecd &new_point, const Vecd &end_direction);
+    /** grow the network branch by branch, generation by generation */
+    void growNetwork();
+    /**
+     *@brief The cache file of the network, keyed by the growing parameters and the shape.
+     * The cache is used if it is enabled in the system.
+     */
+    std::string cacheFileFullPath();
+    bool readFromCache();
+    void writeToCache();
 };
 
 } // namespace SPH
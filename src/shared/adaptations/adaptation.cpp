@@ -16,7 +16,9 @@ SPHAdaptation::SPHAdaptation(Real resolution_ref, Real h_spacing_ratio, Real sys
       h_ref_(h_spacing_ratio_ * spacing_ref_), kernel_ptr_(makeUnique<KernelWendlandC2>(h_ref_)),
       sigma0_ref_(computeLatticeNumberDensity(Vecd())),
       spacing_min_(this->MostRefinedSpacingRegular(spacing_ref_, local_refinement_level_)),
-      Vol_min_(pow(spacing_min_, Dimensions)), h_ratio_max_(spacing_ref_ / spacing_min_){};
+      Vol_min_(pow(spacing_min_, Dimensions)), h_ratio_max_(spacing_ref_ / spacing_min_),
+      level_set_kernel_integrals_on_demand_(false), level_set_construction_report_(false),
+      cell_linked_list_subdivision_(1){};
 //=================================================================================================//
 Real SPHAdaptation::MostRefinedSpacing(Real coarse_particle_spacing, int local_refinement_level)
 {
@@ -84,7 +86,8 @@ void SPHAdaptation::resetAdaptationRatios(Real h_spacing_ratio, Real new_system_
 UniquePtr<BaseCellLinkedList> SPHAdaptation::
     createCellLinkedList(const BoundingBox &domain_bounds, BaseParticles &base_particles)
 {
-    return makeUnique<CellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(), base_particles, *this);
+    return makeUnique<CellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(),
+                                      cell_linked_list_subdivision_, base_particles, *this);
 }
 //=================================================================================================//
 UniquePtr<MultilevelLevelSet> SPHAdaptation::createLevelSet(Shape &shape, Real refinement_ratio)
@@ -92,8 +95,12 @@ UniquePtr<MultilevelLevelSet> SPHAdaptation::createLevelSet(Shape &shape, Real r
     // estimate the required mesh levels
     int total_levels = (int)log10(MinimumDimension(shape.getBounds()) / ReferenceSpacing()) + 2;
     Real coarsest_spacing = ReferenceSpacing() * pow(2.0, total_levels - 1);
+    // the kernel integrals of the coarser levels are never probed
+    bool kernel_integrals_on_demand = level_set_kernel_integrals_on_demand_;
+    level_set_kernel_integrals_on_demand_ = true;
     MultilevelLevelSet coarser_level_sets(shape.getBounds(), coarsest_spacing / refinement_ratio,
                                           total_levels - 1, shape, *this);
+    level_set_kernel_integrals_on_demand_ = kernel_integrals_on_demand;
     // return the finest level set only
     return makeUnique<MultilevelLevelSet>(shape.getBounds(), coarser_level_sets.getMeshLevels().back(), shape, *this);
 }
@@ -101,7 +108,8 @@ UniquePtr<MultilevelLevelSet> SPHAdaptation::createLevelSet(Shape &shape, Real r
 ParticleWithLocalRefinement::
     ParticleWithLocalRefinement(Real resolution_ref, Real h_spacing_ratio, Real system_refinement_ratio,
                                 int local_refinement_level)
-    : SPHAdaptation(resolution_ref, h_spacing_ratio, system_refinement_ratio), h_ratio_(nullptr), level_(nullptr)
+    : SPHAdaptation(resolution_ref, h_spacing_ratio, system_refinement_ratio),
+      h_ratio_(nullptr), level_(nullptr), dv_h_ratio_(nullptr), is_single_level_cell_linked_list_(false)
 {
     local_refinement_level_ = local_refinement_level;
     spacing_min_ = MostRefinedSpacingRegular(spacing_ref_, local_refinement_level_);
@@ -118,6 +126,7 @@ void ParticleWithLocalRefinement::initializeAdaptationVariables(BaseParticles &b
     h_ratio_ = base_particles.registerStateVariable<Real>(
         "SmoothingLengthRatio", [&](size_t i) -> Real
         { return ReferenceSpacing() / base_particles.ParticleSpacing(i); });
+    dv_h_ratio_ = base_particles.getVariableByName<Real>("SmoothingLengthRatio");
     level_ = base_particles.registerStateVariable<int>("ParticleMeshLevel");
     base_particles.addVariableToSort<Real>("SmoothingLengthRatio");
     base_particles.addVariableToReload<Real>("SmoothingLengthRatio");
@@ -136,6 +145,13 @@ size_t ParticleWithLocalRefinement::getLevelSetTotalLevel()
 UniquePtr<BaseCellLinkedList> ParticleWithLocalRefinement::
     createCellLinkedList(const BoundingBox &domain_bounds, BaseParticles &base_particles)
 {
+    if (is_single_level_cell_linked_list_)
+    {
+        UnsignedInt finest_subdivision = UnsignedInt(std::ceil(h_ratio_max_ - Eps));
+        return makeUnique<CellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(),
+                                          SMAX(cell_linked_list_subdivision_, finest_subdivision),
+                                          base_particles, *this);
+    }
     return makeUnique<MultilevelCellLinkedList>(domain_bounds, kernel_ptr_->CutOffRadius(),
                                                 getCellLinkedListTotalLevel(), base_particles, *this);
 }
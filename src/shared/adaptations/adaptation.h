@@ -63,6 +63,9 @@ class SPHAdaptation
     Real spacing_min_;             /**< minimum particle spacing determined by local refinement level */
     Real Vol_min_;                 /**< minimum particle volume measure determined by local refinement level */
     Real h_ratio_max_;             /**< the ratio between the reference smoothing length to the minimum smoothing length */
+    bool level_set_kernel_integrals_on_demand_; /**< kernel integrals of level set packages computed when first probed */
+    bool level_set_construction_report_;        /**< report the packages and timing of each level set level */
+    UnsignedInt cell_linked_list_subdivision_;  /**< cells of the cut-off radius divided by this subdivision */
 
   public:
     explicit SPHAdaptation(Real resolution_ref, Real h_spacing_ratio = 1.3, Real system_refinement_ratio = 1.0);
@@ -74,6 +77,16 @@ class SPHAdaptation
     Real ReferenceSmoothingLength() { return h_ref_; };
     Real MinimumSmoothingLength() { return h_ref_ / h_ratio_max_; };
     Kernel *getKernel() { return kernel_ptr_.get(); };
+    /** for shapes only used for particle generation or far from particles, saves most of the level set startup */
+    void setLevelSetKernelIntegralsOnDemand(bool on_demand) { level_set_kernel_integrals_on_demand_ = on_demand; };
+    bool LevelSetKernelIntegralsOnDemand() { return level_set_kernel_integrals_on_demand_; };
+    /** for tuning the package size and number of levels of level sets */
+    void setLevelSetConstructionReport(bool is_reported) { level_set_construction_report_ = is_reported; };
+    bool LevelSetConstructionReport() { return level_set_construction_report_; };
+    /** finer cells for pruning the neighbor search, set before the cell linked list is created,
+     *  see benchmarkCellLinkedListSubdivision for choosing it. Only for single level cell linked lists. */
+    void setCellLinkedListSubdivision(UnsignedInt subdivision) { cell_linked_list_subdivision_ = SMAX(subdivision, UnsignedInt(1)); };
+    UnsignedInt CellLinkedListSubdivision() { return cell_linked_list_subdivision_; };
     Real LatticeNumberDensity() { return sigma0_ref_; };
     Real NumberDensityScaleFactor(Real smoothing_length_ratio);
     virtual Real SmoothingLengthRatio(size_t particle_index_i) { return 1.0; };
@@ -110,12 +123,17 @@ class ParticleWithLocalRefinement : public SPHAdaptation
   public:
     Real *h_ratio_; /**< the ratio between reference smoothing length to variable smoothing length */
     int *level_;    /**< the mesh level of the particle */
+    DiscreteVariable<Real> *dv_h_ratio_;
 
     ParticleWithLocalRefinement(Real resolution_ref, Real h_spacing_ratio_, Real system_refinement_ratio, int local_refinement_level);
     virtual ~ParticleWithLocalRefinement(){};
 
     virtual size_t getCellLinkedListTotalLevel();
     size_t getLevelSetTotalLevel();
+    /** For computing kernels, the particles of all levels are listed in one cell linked list with the coarsest
+     *  cut-off radius and cells subdivided down to the finest one, see Neighbor<Adaptive, KernelType>.
+     *  Set before the cell linked list is created. */
+    void setSingleLevelCellLinkedList(bool is_single_level) { is_single_level_cell_linked_list_ = is_single_level; };
     virtual Real SmoothingLengthRatio(size_t particle_index_i) override
     {
         return h_ratio_[particle_index_i];
@@ -128,6 +146,7 @@ class ParticleWithLocalRefinement : public SPHAdaptation
   protected:
     Real finest_spacing_bound_;   /**< the adaptation bound for finest particles */
     Real coarsest_spacing_bound_; /**< the adaptation bound for coarsest particles */
+    bool is_single_level_cell_linked_list_;
 };
 
 /**
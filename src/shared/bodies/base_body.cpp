@@ -10,6 +10,8 @@ namespace SPH
 SPHBody::SPHBody(SPHSystem &sph_system, Shape &shape, const std::string &name)
     : sph_system_(sph_system), body_name_(name), newly_updated_(true),
       base_particles_(nullptr), is_bound_set_(false), initial_shape_(&shape), total_body_parts_(0),
+      is_loop_range_restricted_(false), restricted_loop_range_(0, 0), block_time_stepping_(nullptr),
+      is_configuration_frozen_(false), is_frozen_position_recorded_(false), frozen_position_hash_(0),
       sph_adaptation_(sph_adaptation_ptr_keeper_.createPtr<SPHAdaptation>(sph_system.ReferenceResolution())),
       base_material_(base_material_ptr_keeper_.createPtr<BaseMaterial>())
 {
@@ -31,6 +33,33 @@ SPHBody::SPHBody(SPHSystem &sph_system, SharedPtr<Shape> shape_ptr, const std::s
 SPHBody::SPHBody(SPHSystem &sph_system, SharedPtr<Shape> shape_ptr)
     : SPHBody(sph_system, shape_ptr, shape_ptr->getName()) {}
 //=================================================================================================//
+void SPHBody::restrictLoopRange(const IndexRange &loop_range)
+{
+    is_loop_range_restricted_ = true;
+    restricted_loop_range_ = loop_range;
+}
+//=================================================================================================//
+void SPHBody::checkFrozenConfiguration()
+{
+#ifndef NDEBUG
+    Vecd *pos = base_particles_->getVariableDataByName<Vecd>("Position");
+    uint64_t position_hash = hashBinaryData(reinterpret_cast<const char *>(pos),
+                                            base_particles_->TotalRealParticles() * sizeof(Vecd));
+    if (!is_frozen_position_recorded_)
+    {
+        frozen_position_hash_ = position_hash;
+        is_frozen_position_recorded_ = true;
+    }
+    else if (position_hash != frozen_position_hash_)
+    {
+        std::cout << "\n Error: the particles of " << body_name_
+                  << " have moved, but its configuration is frozen!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+#endif
+}
+//=================================================================================================//
 BoundingBox SPHBody::getSPHSystemBounds()
 {
     return sph_system_.system_domain_bounds_;
@@ -100,6 +129,16 @@ void SPHBody::readParticlesFromXmlForRestart(std::string &filefullpath)
     base_particles_->readParticleFromXmlForRestart(filefullpath);
 }
 //=================================================================================================//
+void SPHBody::writeParticlesToBinaryForRestart(BinaryDataWriter &binary_writer)
+{
+    base_particles_->writeParticlesToBinaryForRestart(binary_writer);
+}
+//=================================================================================================//
+void SPHBody::readParticlesFromBinaryForRestart(const std::string &filefullpath)
+{
+    base_particles_->readParticlesFromBinaryForRestart(filefullpath);
+}
+//=================================================================================================//
 void SPHBody::writeToXmlForReloadParticle(std::string &filefullpath)
 {
     base_particles_->writeToXmlForReloadParticle(filefullpath);
@@ -116,9 +155,29 @@ BaseCellLinkedList &RealBody::getCellLinkedList()
     return *cell_linked_list_ptr_.get();
 }
 //=================================================================================================//
+void RealBody::tuneCellLinkedListSubdivision(UnsignedInt max_subdivision)
+{
+    if (cell_linked_list_created_)
+    {
+        std::cout << "\n Error: the cell linked list of " << getName() << " has been created already!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    UnsignedInt subdivision = benchmarkCellLinkedListSubdivision(
+        getSPHSystemBounds(), sph_adaptation_->getKernel()->CutOffRadius(), *base_particles_, max_subdivision);
+    sph_adaptation_->setCellLinkedListSubdivision(subdivision);
+}
+//=================================================================================================//
 void RealBody::updateCellLinkedList()
 {
+    if (is_configuration_frozen_)
+    {
+        checkFrozenConfiguration();
+        if (cell_linked_list_updated_)
+            return;
+    }
     getCellLinkedList().UpdateCellLists(*base_particles_);
+    cell_linked_list_updated_ = true;
 }
 //=================================================================================================//
 } // namespace SPH
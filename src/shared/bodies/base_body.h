@@ -52,6 +52,7 @@ namespace SPH
 {
 class SPHRelation;
 class BodySurface;
+class BlockTimeStepping;
 
 /**
  * @class SPHBody
@@ -77,6 +78,14 @@ class SPHBody
     BoundingBox bound_;             /**< bounding box of the body */
     Shape *initial_shape_;          /**< initial volumetric geometry enclosing the body */
     int total_body_parts_;
+    bool is_loop_range_restricted_; /**< whether the loops are restricted to a part of the particles */
+    IndexRange restricted_loop_range_;
+    BlockTimeStepping *block_time_stepping_; /**< the block time stepping in progress, if any */
+    bool is_configuration_frozen_;           /**< whether the particles never move, e.g. in Eulerian SPH */
+    bool is_frozen_position_recorded_;
+    uint64_t frozen_position_hash_; /**< only used for checking in debug builds */
+    UnsignedInt configuration_version_ = 0;
+    UnsignedInt state_version_ = 0;
     StdVec<execution::Implementation<Base> *> all_simple_reduce_computing_kernels_;
     /**< total number of body parts */
 
@@ -100,12 +109,37 @@ class SPHBody
     BaseParticles &getBaseParticles();
     BaseMaterial &getBaseMaterial();
     StdVec<SPHRelation *> &getBodyRelations() { return body_relations_; };
-    IndexRange LoopRange() { return IndexRange(0, base_particles_->TotalRealParticles()); };
-    size_t SizeOfLoopRange() { return base_particles_->TotalRealParticles(); };
+    IndexRange LoopRange()
+    {
+        return is_loop_range_restricted_ ? restricted_loop_range_
+                                         : IndexRange(0, base_particles_->TotalRealParticles());
+    };
+    size_t SizeOfLoopRange() { return LoopRange().size(); };
+    /** the loops of the dynamics on the body run on the given particles only until released,
+     *  e.g. on the interior or boundary particles of a subdomain */
+    void restrictLoopRange(const IndexRange &loop_range);
+    void releaseLoopRange() { is_loop_range_restricted_ = false; };
+    /** during a block, the interaction dynamics on the body run on the active particles only */
+    void setBlockTimeStepping(BlockTimeStepping *block_time_stepping) { block_time_stepping_ = block_time_stepping; };
+    BlockTimeStepping *getBlockTimeStepping() { return block_time_stepping_; };
     Real getSPHBodyResolutionRef() { return sph_adaptation_->ReferenceSpacing(); };
     void setNewlyUpdated() { newly_updated_ = true; };
     void setNotNewlyUpdated() { newly_updated_ = false; };
     bool checkNewlyUpdated() { return newly_updated_; };
+    /** the cell linked list and the configurations are built once and kept afterwards,
+     *  to be called after particle relaxation, if any */
+    void freezeConfiguration() { is_configuration_frozen_ = true; };
+    bool isConfigurationFrozen() { return is_configuration_frozen_; };
+    /** in debug builds, stops if the particles of a frozen body have moved */
+    void checkFrozenConfiguration();
+    /** incremented by the relations centered at this body whenever a configuration is updated,
+     *  so that the dynamics depending only on the configurations can skip an unchanged one */
+    UnsignedInt ConfigurationVersion() { return configuration_version_; };
+    void incrementConfigurationVersion() { configuration_version_++; };
+    /** incremented by the dynamics advancing the particle states, i.e. velocity, position and volume,
+     *  so that the derived variables, such as the velocity gradient, are computed once per stage */
+    UnsignedInt StateVersion() { return state_version_; };
+    void incrementStateVersion() { state_version_++; };
     void setSPHBodyBounds(const BoundingBox &bound);
     BoundingBox getSPHBodyBounds();
     BoundingBox getSPHSystemBounds();
@@ -179,6 +213,8 @@ class SPHBody
 
     virtual void writeParticlesToXmlForRestart(std::string &filefullpath);
     virtual void readParticlesFromXmlForRestart(std::string &filefullpath);
+    virtual void writeParticlesToBinaryForRestart(BinaryDataWriter &binary_writer);
+    virtual void readParticlesFromBinaryForRestart(const std::string &filefullpath);
     virtual void writeToXmlForReloadParticle(std::string &filefullpath);
     virtual SPHBody *ThisObjectPtr() { return this; };
 };
@@ -193,18 +229,24 @@ class RealBody : public SPHBody
   private:
     UniquePtr<BaseCellLinkedList> cell_linked_list_ptr_;
     bool cell_linked_list_created_;
+    bool cell_linked_list_updated_;
 
   public:
     template <typename... Args>
     RealBody(Args &&...args)
         : SPHBody(std::forward<Args>(args)...),
-          cell_linked_list_created_(false)
+          cell_linked_list_created_(false), cell_linked_list_updated_(false)
     {
         this->getSPHSystem().addRealBody(this);
     };
     virtual ~RealBody(){};
     BaseCellLinkedList &getCellLinkedList();
+    /** choose the subdivision of the cells by a quick benchmark of the present particles,
+     *  before the cell linked list is created */
+    void tuneCellLinkedListSubdivision(UnsignedInt max_subdivision = 3);
     void updateCellLinkedList();
+    bool isCellLinkedListCreated() { return cell_linked_list_created_; };
+    bool isCellLinkedListUpdated() { return cell_linked_list_updated_; };
 };
 } // namespace SPH
 #endif // BASE_BODY_H
@@ -1,6 +1,11 @@
 #include "base_body_part.h"
 
 #include "base_particles.hpp"
+#include "base_configuration_dynamics.h"
+#include "particle_iterators.h"
+
+#include <algorithm>
+
 namespace SPH
 {
 //=================================================================================================//
@@ -10,7 +15,59 @@ void BodyPartByParticle::tagParticles(TaggingParticleMethod &tagging_particle_me
     {
         tagging_particle_method(i);
     }
+    recordOriginalIds();
 };
+//=================================================================================================//
+void BodyPartByParticle::tagParticlesInParallel(CheckIncludedMethod &check_included)
+{
+    size_t total_real_particles = base_particles_.TotalRealParticles();
+    StdLargeVec<char> is_included(total_real_particles, 0);
+    particle_for(execution::par, IndexRange(0, total_real_particles),
+                 [&](size_t i)
+                 { is_included[i] = check_included(i); });
+
+    for (size_t i = 0; i < total_real_particles; ++i)
+    {
+        if (is_included[i])
+            body_part_particles_.push_back(i);
+    }
+    recordOriginalIds();
+}
+//=================================================================================================//
+void BodyPartByParticle::recordOriginalIds()
+{
+    UnsignedInt *original_id = base_particles_.ParticleOriginalIds();
+    original_ids_.resize(body_part_particles_.size());
+    particle_for(execution::par, IndexRange(0, body_part_particles_.size()),
+                 [&](size_t n)
+                 { original_ids_[n] = original_id[body_part_particles_[n]]; });
+    total_sorts_at_last_remap_ = base_particles_.TotalSorts();
+}
+//=================================================================================================//
+void BodyPartByParticle::remapAfterSorting()
+{
+    if (base_particles_.TotalSorts() == total_sorts_at_last_remap_)
+        return;
+
+    // particles added to the list without tagging are not known by their original ids
+    if (original_ids_.size() != body_part_particles_.size())
+    {
+        total_sorts_at_last_remap_ = base_particles_.TotalSorts();
+        return;
+    }
+
+    UnsignedInt *original_id = base_particles_.ParticleOriginalIds();
+    StdLargeVec<size_t> current_index(base_particles_.ParticlesBound());
+    particle_for(execution::par, IndexRange(0, base_particles_.TotalRealParticles()),
+                 [&](size_t i)
+                 { current_index[original_id[i]] = i; });
+    particle_for(execution::par, IndexRange(0, body_part_particles_.size()),
+                 [&](size_t n)
+                 { body_part_particles_[n] = current_index[original_ids_[n]]; });
+
+    std::sort(body_part_particles_.begin(), body_part_particles_.end());
+    recordOriginalIds();
+}
 //=============================================================================================//
 size_t BodyPartByCell::SizeOfLoopRange()
 {
@@ -32,8 +89,8 @@ BodyRegionByParticle::
     : BodyPartByParticle(sph_body, body_part_shape.getName()),
       body_part_shape_(body_part_shape)
 {
-    TaggingParticleMethod tagging_particle_method = std::bind(&BodyRegionByParticle::tagByContain, this, _1);
-    tagParticles(tagging_particle_method);
+    CheckIncludedMethod check_included = std::bind(&BodyRegionByParticle::checkContain, this, _1);
+    tagParticlesInParallel(check_included);
 }
 //=================================================================================================//
 BodyRegionByParticle::BodyRegionByParticle(SPHBody &sph_body, SharedPtr<Shape> shape_ptr)
@@ -43,46 +100,39 @@ BodyRegionByParticle::BodyRegionByParticle(SPHBody &sph_body, SharedPtr<Shape> s
 }
 //==
 //=================================================================================================//
-void BodyRegionByParticle::tagByContain(size_t particle_index)
+bool BodyRegionByParticle::checkContain(size_t particle_index)
 {
-    if (body_part_shape_.checkContain(pos_[particle_index]))
-    {
-        body_part_particles_.push_back(particle_index);
-    }
+    return body_part_shape_.checkContain(pos_[particle_index]);
 }
 //=================================================================================================//
 BodySurface::BodySurface(SPHBody &sph_body)
     : BodyPartByParticle(sph_body, "BodySurface"),
       particle_spacing_min_(sph_body.sph_adaptation_->MinimumSpacing())
 {
-    TaggingParticleMethod tagging_particle_method = std::bind(&BodySurface::tagNearSurface, this, _1);
-    tagParticles(tagging_particle_method);
+    CheckIncludedMethod check_included = std::bind(&BodySurface::checkNearSurface, this, _1);
+    tagParticlesInParallel(check_included);
     std::cout << "Number of surface particles : " << body_part_particles_.size() << std::endl;
 }
 //=================================================================================================//
-void BodySurface::tagNearSurface(size_t particle_index)
+bool BodySurface::checkNearSurface(size_t particle_index)
 {
     Real phi = sph_body_.getInitialShape().findSignedDistance(pos_[particle_index]);
-    if (fabs(phi) < particle_spacing_min_)
-        body_part_particles_.push_back(particle_index);
+    return fabs(phi) < particle_spacing_min_;
 }
 //=================================================================================================//
 BodySurfaceLayer::BodySurfaceLayer(SPHBody &sph_body, Real layer_thickness)
     : BodyPartByParticle(sph_body, "InnerLayers"),
       thickness_threshold_(sph_body.sph_adaptation_->ReferenceSpacing() * layer_thickness)
 {
-    TaggingParticleMethod tagging_particle_method = std::bind(&BodySurfaceLayer::tagSurfaceLayer, this, _1);
-    tagParticles(tagging_particle_method);
+    CheckIncludedMethod check_included = std::bind(&BodySurfaceLayer::checkSurfaceLayer, this, _1);
+    tagParticlesInParallel(check_included);
     std::cout << "Number of inner layers particles : " << body_part_particles_.size() << std::endl;
 }
 //=================================================================================================//
-void BodySurfaceLayer::tagSurfaceLayer(size_t particle_index)
+bool BodySurfaceLayer::checkSurfaceLayer(size_t particle_index)
 {
     Real distance = fabs(sph_body_.getInitialShape().findSignedDistance(pos_[particle_index]));
-    if (distance < thickness_threshold_)
-    {
-        body_part_particles_.push_back(particle_index);
-    }
+    return distance < thickness_threshold_;
 }
 //=================================================================================================//
 BodyRegionByCell::BodyRegionByCell(RealBody &real_body, Shape &body_part_shape)
@@ -142,4 +192,73 @@ bool NearShapeSurface::checkNearSurface(Vecd cell_position, Real threshold)
     return level_set_shape_.checkNearSurface(cell_position, threshold);
 }
 //=================================================================================================//
+AwakeCells::AwakeCells(RealBody &real_body, Real velocity_threshold, Real acceleration_threshold,
+                       UnsignedInt quiescent_steps)
+    : BodyPartByCell(real_body, "AwakeCells"),
+      single_cell_linked_list_(*DynamicCast<CellLinkedList>(this, &real_body.getCellLinkedList())),
+      velocity_threshold_sqr_(velocity_threshold * velocity_threshold),
+      acceleration_threshold_sqr_(acceleration_threshold * acceleration_threshold),
+      quiescent_steps_(quiescent_steps),
+      cell_moving_particles_(single_cell_linked_list_.NumberOfCells(), 0),
+      cell_quiescent_steps_(single_cell_linked_list_.NumberOfCells(), 0)
+{
+    base_particles_.registerStateVariable<Vecd>("Velocity");
+    base_particles_.registerStateVariable<Vecd>("Force");
+    base_particles_.registerStateVariable<Vecd>("ForcePrior");
+    TaggingCellMethod tagging_cell_method = std::bind(&AwakeCells::checkAwake, this, _1, _2);
+    tagCells(tagging_cell_method);
+}
+//=================================================================================================//
+void AwakeCells::updateAwakeCells()
+{
+    Vecd *pos = base_particles_.ParticlePositions();
+    Vecd *vel = base_particles_.getVariableDataByName<Vecd>("Velocity");
+    Vecd *force = base_particles_.getVariableDataByName<Vecd>("Force");
+    Vecd *force_prior = base_particles_.getVariableDataByName<Vecd>("ForcePrior");
+    Real *mass = base_particles_.getVariableDataByName<Real>("Mass");
+    UnsignedInt *cell_moving_particles = cell_moving_particles_.data();
+    UnsignedInt *cell_quiescent_steps = cell_quiescent_steps_.data();
+    const IndexRange all_cells(0, cell_quiescent_steps_.size());
+
+    particle_for(execution::ParallelPolicy(), all_cells,
+                 [=](size_t i)
+                 { cell_moving_particles[i] = 0; });
+    particle_for(execution::ParallelPolicy(), IndexRange(0, base_particles_.TotalRealParticles()),
+                 [&](size_t i)
+                 {
+                     Vecd acceleration = (force[i] + force_prior[i]) / mass[i];
+                     if (vel[i].squaredNorm() > velocity_threshold_sqr_ ||
+                         acceleration.squaredNorm() > acceleration_threshold_sqr_)
+                     {
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type atomic_moving_particles(
+                             cell_moving_particles[single_cell_linked_list_.LinearCellIndexFromPosition(pos[i])]);
+                         ++atomic_moving_particles;
+                     }
+                 });
+    particle_for(execution::ParallelPolicy(), all_cells,
+                 [=](size_t i)
+                 {
+                     cell_quiescent_steps[i] = cell_moving_particles[i] != 0
+                                                   ? 0
+                                                   : SMIN(cell_quiescent_steps[i] + 1, quiescent_steps_);
+                 });
+
+    body_part_cells_.clear();
+    TaggingCellMethod tagging_cell_method = std::bind(&AwakeCells::checkAwake, this, _1, _2);
+    tagCells(tagging_cell_method);
+}
+//=================================================================================================//
+bool AwakeCells::checkAwake(Vecd cell_position, Real threshold)
+{
+    return cell_quiescent_steps_[single_cell_linked_list_.LinearCellIndexFromPosition(cell_position)] < quiescent_steps_;
+}
+//=================================================================================================//
+size_t AwakeCells::NumberOfSleepingCells()
+{
+    size_t number_of_sleeping_cells = 0;
+    for (size_t i = 0; i != cell_quiescent_steps_.size(); ++i)
+        number_of_sleeping_cells += cell_quiescent_steps_[i] >= quiescent_steps_;
+    return number_of_sleeping_cells;
+}
+//=================================================================================================//
 } // namespace SPH
@@ -73,12 +73,17 @@ class BodyPartByParticle : public BodyPart
   public:
     IndexVector body_part_particles_; /**< Collection particle in this body part. */
     BaseParticles &getBaseParticles() { return base_particles_; };
-    IndexVector &LoopRange() { return body_part_particles_; };
+    IndexVector &LoopRange()
+    {
+        remapAfterSorting();
+        return body_part_particles_;
+    };
     size_t SizeOfLoopRange() { return body_part_particles_.size(); };
 
     BodyPartByParticle(SPHBody &sph_body, const std::string &body_part_name)
         : BodyPart(sph_body, body_part_name),
-          body_part_bounds_(Vecd::Zero(), Vecd::Zero()), body_part_bounds_set_(false){};
+          body_part_bounds_(Vecd::Zero(), Vecd::Zero()), body_part_bounds_set_(false),
+          total_sorts_at_last_remap_(base_particles_.TotalSorts()){};
     virtual ~BodyPartByParticle(){};
 
     void setBodyPartBounds(BoundingBox bbox)
@@ -97,9 +102,20 @@ class BodyPartByParticle : public BodyPart
   protected:
     BoundingBox body_part_bounds_;
     bool body_part_bounds_set_;
+    UnsignedInt total_sorts_at_last_remap_;
+    IndexVector original_ids_; /**< original ids of the tagged particles, with which the indices are remapped after sorting */
 
     typedef std::function<void(size_t)> TaggingParticleMethod;
     void tagParticles(TaggingParticleMethod &tagging_particle_method);
+    /** the check is carried out for all particles in parallel, the tagged particles are in memory order */
+    typedef std::function<bool(size_t)> CheckIncludedMethod;
+    void tagParticlesInParallel(CheckIncludedMethod &check_included);
+    void recordOriginalIds();
+    /**
+     * After particle sorting, the tagged particles are found again from their original ids
+     * and put in the new memory order, instead of being tagged again.
+     */
+    void remapAfterSorting();
 };
 
 /**
@@ -140,7 +156,7 @@ class BodyRegionByParticle : public BodyPartByParticle
 
   protected:
     Shape &body_part_shape_;
-    void tagByContain(size_t particle_index);
+    bool checkContain(size_t particle_index);
 };
 
 /**
@@ -155,7 +171,7 @@ class BodySurface : public BodyPartByParticle
 
   protected:
     Real particle_spacing_min_;
-    void tagNearSurface(size_t particle_index);
+    bool checkNearSurface(size_t particle_index);
 };
 
 /**
@@ -170,7 +186,7 @@ class BodySurfaceLayer : public BodyPartByParticle
 
   private:
     Real thickness_threshold_;
-    void tagSurfaceLayer(size_t particle_index);
+    bool checkSurfaceLayer(size_t particle_index);
 };
 
 /**
@@ -218,6 +234,37 @@ class NearShapeSurface : public BodyPartByCell
     bool checkNearSurface(Vecd cell_position, Real threshold);
 };
 
+/**
+ * @class AwakeCells
+ * @brief The body part of the cells not sleeping, with which quiescent regions are skipped in the time integration.
+ * @details A cell falls asleep after its particles have stayed below the velocity and acceleration
+ * thresholds for the given number of updates. The body part includes the awake cells and the sleeping
+ * cells next to them, so that a sleeping cell is woken when its particles start moving
+ * due to the interaction with awake neighbors, or when a moving particle enters it.
+ * The sleeping particles are kept in the cell linked list and the configurations,
+ * so that they still contribute to their awake neighbors.
+ * The update is called after that of the cell linked list, and the dynamics to be skipped
+ * in the sleeping cells are defined on this body part, e.g. by InteractionInBand.
+ */
+class AwakeCells : public BodyPartByCell
+{
+  public:
+    AwakeCells(RealBody &real_body, Real velocity_threshold, Real acceleration_threshold,
+               UnsignedInt quiescent_steps);
+    virtual ~AwakeCells(){};
+    void updateAwakeCells();
+    size_t NumberOfSleepingCells();
+
+  protected:
+    CellLinkedList &single_cell_linked_list_;
+    Real velocity_threshold_sqr_;
+    Real acceleration_threshold_sqr_;
+    UnsignedInt quiescent_steps_;
+    StdLargeVec<UnsignedInt> cell_moving_particles_; /**< particles above the thresholds in each cell */
+    StdLargeVec<UnsignedInt> cell_quiescent_steps_;  /**< consecutive quiescent updates of each cell */
+    bool checkAwake(Vecd cell_position, Real threshold);
+};
+
 /**
  * @class AlignedBoxRegion
  * @brief A template body part with the collection of particles within by an AlignedBoxShape.
@@ -0,0 +1,34 @@
+#include "mesh_helper.h"
+
+#include "base_particle_dynamics.h"
+
+#include <cstdlib>
+
+namespace SPH
+{
+//=================================================================================================//
+void MeshFileHelpers::parseNodeCoordinates(const StdVec<std::string> &coordinate_lines,
+                                           StdLargeVec<Vecd> &node_coordinates_)
+{
+    size_t number_of_existing_nodes = node_coordinates_.size();
+    node_coordinates_.resize(number_of_existing_nodes + coordinate_lines.size(), Vecd::Zero());
+    parallel_for(
+        IndexRange(0, coordinate_lines.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                const char *begin = coordinate_lines[n].c_str();
+                Vecd &coordinate = node_coordinates_[number_of_existing_nodes + n];
+                for (int k = 0; k != Dimensions; ++k)
+                {
+                    char *end = nullptr;
+                    coordinate[k] = std::strtod(begin, &end);
+                    begin = end;
+                }
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -47,6 +47,8 @@ class MeshFileHelpers
     static void meshDimension(std::ifstream &mesh_file, size_t &dimension, std::string &text_line);
     static void numberOfNodes(std::ifstream &mesh_file, size_t &number_of_points, std::string &text_line);
     static void nodeCoordinates(std::ifstream &mesh_file, StdLargeVec<Vecd> &node_coordinates_, std::string &text_line, size_t &dimension);
+    /** converts the collected coordinate lines in parallel and appends the nodes in line order */
+    static void parseNodeCoordinates(const StdVec<std::string> &coordinate_lines, StdLargeVec<Vecd> &node_coordinates_);
     static void numberOfElements(std::ifstream &mesh_file, size_t &number_of_elements, std::string &text_line);
     static void dataStruct(StdVec<StdVec<StdVec<size_t>>> &mesh_topology_, StdLargeVec<StdVec<size_t>> &elements_nodes_connection_,
                            size_t number_of_elements, size_t mesh_type, size_t dimension);
@@ -4,7 +4,9 @@
 #include "base_material.h"
 #include "base_particle_dynamics.h"
 #include "base_particles.hpp"
+#include "binary_data_file.h"
 #include "neighborhood.h"
+#include "particle_iterators.h"
 
 namespace SPH
 {
@@ -98,117 +100,182 @@ void TreeBody::buildParticleConfiguration(ParticleConfiguration &particle_config
         }
     }
     /** Other branches.
-     * They are may normal branch (fully grown, has child and parent) or non-fully grown branch
+     * They are may normal branch (fully grown, has child and parent) or non-fully grown branch.
+     * Each branch only builds the neighborhoods of its own particles, so that branches are in parallel.
      */
-    for (size_t branch_idx = 2; branch_idx != branches_.size(); ++branch_idx)
-    {
-        num_ele = branches_[branch_idx]->inner_particles_.size();
-        size_t parent_branch_id = branches_[branch_idx]->in_edge_;
-        if (!branches_[branch_idx]->is_terminated_)
-        {
-            /** This branch is fully grown. */
-            for (size_t i = 0; i != num_ele; i++)
-            {
-                neighboring_ids.clear();
-                particle_id = branches_[branch_idx]->inner_particles_.front() + i;
-                if (i == 0)
-                {
-                    neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
-                    neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back() - 1);
+    particle_for(execution::ParallelPolicy(), IndexRange(2, branches_.size()),
+                 [&](size_t branch_idx)
+                 {
+                     IndexVector neighboring_ids;
+                     size_t num_ele = branches_[branch_idx]->inner_particles_.size();
+                     size_t parent_branch_id = branches_[branch_idx]->in_edge_;
+                     if (!branches_[branch_idx]->is_terminated_)
+                     {
+                         /** This branch is fully grown. */
+                         for (size_t i = 0; i != num_ele; i++)
+                         {
+                             neighboring_ids.clear();
+                             size_t particle_id = branches_[branch_idx]->inner_particles_.front() + i;
+                             if (i == 0)
+                             {
+                                 neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
+                                 neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back() - 1);
 
-                    neighboring_ids.push_back(particle_id + 1);
-                    neighboring_ids.push_back(particle_id + 2);
-                }
-                else if (i == 1)
-                {
-                    neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
-                    neighboring_ids.push_back(particle_id - 1);
-                    neighboring_ids.push_back(particle_id + 1);
-                    neighboring_ids.push_back(particle_id + 2);
-                }
-                else if (2 <= i && i <= (num_ele - 3))
-                {
-                    neighboring_ids.push_back(particle_id - 1);
-                    neighboring_ids.push_back(particle_id - 2);
-                    neighboring_ids.push_back(particle_id + 1);
-                    neighboring_ids.push_back(particle_id + 2);
-                }
-                else if (i == (num_ele - 2))
-                {
-                    neighboring_ids.push_back(particle_id - 2);
-                    neighboring_ids.push_back(particle_id - 1);
-                    neighboring_ids.push_back(particle_id + 1);
+                                 neighboring_ids.push_back(particle_id + 1);
+                                 neighboring_ids.push_back(particle_id + 2);
+                             }
+                             else if (i == 1)
+                             {
+                                 neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
+                                 neighboring_ids.push_back(particle_id - 1);
+                                 neighboring_ids.push_back(particle_id + 1);
+                                 neighboring_ids.push_back(particle_id + 2);
+                             }
+                             else if (2 <= i && i <= (num_ele - 3))
+                             {
+                                 neighboring_ids.push_back(particle_id - 1);
+                                 neighboring_ids.push_back(particle_id - 2);
+                                 neighboring_ids.push_back(particle_id + 1);
+                                 neighboring_ids.push_back(particle_id + 2);
+                             }
+                             else if (i == (num_ele - 2))
+                             {
+                                 neighboring_ids.push_back(particle_id - 2);
+                                 neighboring_ids.push_back(particle_id - 1);
+                                 neighboring_ids.push_back(particle_id + 1);
 
-                    for (size_t k = 0; k < branches_[branch_idx]->out_edge_.size(); ++k)
-                    {
-                        size_t child_branch_id = branches_[branch_idx]->out_edge_[k];
-                        neighboring_ids.push_back(branches_[child_branch_id]->inner_particles_.front());
-                    }
-                }
-                else if (i == (num_ele - 1))
-                {
-                    neighboring_ids.push_back(particle_id - 1);
-                    neighboring_ids.push_back(particle_id - 2);
+                                 for (size_t k = 0; k < branches_[branch_idx]->out_edge_.size(); ++k)
+                                 {
+                                     size_t child_branch_id = branches_[branch_idx]->out_edge_[k];
+                                     neighboring_ids.push_back(branches_[child_branch_id]->inner_particles_.front());
+                                 }
+                             }
+                             else if (i == (num_ele - 1))
+                             {
+                                 neighboring_ids.push_back(particle_id - 1);
+                                 neighboring_ids.push_back(particle_id - 2);
 
-                    for (size_t k = 0; k < branches_[branch_idx]->out_edge_.size(); ++k)
-                    {
-                        size_t child_branch_id = branches_[branch_idx]->out_edge_[k];
-                        neighboring_ids.push_back(branches_[child_branch_id]->inner_particles_.front());
-                        if (branches_[child_branch_id]->inner_particles_.size() >= 2)
-                        {
-                            neighboring_ids.push_back(branches_[child_branch_id]->inner_particles_.front() + 1);
-                        }
-                    }
-                }
+                                 for (size_t k = 0; k < branches_[branch_idx]->out_edge_.size(); ++k)
+                                 {
+                                     size_t child_branch_id = branches_[branch_idx]->out_edge_[k];
+                                     neighboring_ids.push_back(branches_[child_branch_id]->inner_particles_.front());
+                                     if (branches_[child_branch_id]->inner_particles_.size() >= 2)
+                                     {
+                                         neighboring_ids.push_back(branches_[child_branch_id]->inner_particles_.front() + 1);
+                                     }
+                                 }
+                             }
 
-                for (size_t n = 0; n != neighboring_ids.size(); ++n)
-                {
-                    size_t index_j = neighboring_ids[n];
-                    ListData list_data_j = std::make_pair(index_j, pos[index_j]);
-                    Neighborhood &neighborhood = particle_configuration[particle_id];
-                    neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
-                }
-            }
-        }
-        else
-        {
-            /** This branch is not fully grown. */
-            for (size_t i = 0; i != num_ele; i++)
-            {
-                neighboring_ids.clear();
-                particle_id = branches_[branch_idx]->inner_particles_.front() + i;
-                if (i == 0)
-                {
-                    neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
-                    if (branches_[parent_branch_id]->inner_particles_.size() >= 2)
-                        neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back() - 1);
-                }
-                else if (i == 1)
-                {
-                    neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
-                    neighboring_ids.push_back(particle_id - 1);
-                }
-                else
-                {
-                    neighboring_ids.push_back(particle_id - 1);
-                    neighboring_ids.push_back(particle_id - 2);
-                }
+                             for (size_t n = 0; n != neighboring_ids.size(); ++n)
+                             {
+                                 size_t index_j = neighboring_ids[n];
+                                 ListData list_data_j = std::make_pair(index_j, pos[index_j]);
+                                 Neighborhood &neighborhood = particle_configuration[particle_id];
+                                 neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
+                             }
+                         }
+                     }
+                     else
+                     {
+                         /** This branch is not fully grown. */
+                         for (size_t i = 0; i != num_ele; i++)
+                         {
+                             neighboring_ids.clear();
+                             size_t particle_id = branches_[branch_idx]->inner_particles_.front() + i;
+                             if (i == 0)
+                             {
+                                 neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
+                                 if (branches_[parent_branch_id]->inner_particles_.size() >= 2)
+                                     neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back() - 1);
+                             }
+                             else if (i == 1)
+                             {
+                                 neighboring_ids.push_back(branches_[parent_branch_id]->inner_particles_.back());
+                                 neighboring_ids.push_back(particle_id - 1);
+                             }
+                             else
+                             {
+                                 neighboring_ids.push_back(particle_id - 1);
+                                 neighboring_ids.push_back(particle_id - 2);
+                             }
 
-                if (i + 1 < num_ele)
-                    neighboring_ids.push_back(particle_id + 1);
-                if (i + 2 < num_ele)
-                    neighboring_ids.push_back(particle_id + 2);
+                             if (i + 1 < num_ele)
+                                 neighboring_ids.push_back(particle_id + 1);
+                             if (i + 2 < num_ele)
+                                 neighboring_ids.push_back(particle_id + 2);
 
-                for (size_t n = 0; n != neighboring_ids.size(); ++n)
-                {
-                    size_t index_j = neighboring_ids[n];
-                    ListData list_data_j = std::make_pair(index_j, pos[index_j]);
-                    Neighborhood &neighborhood = particle_configuration[particle_id];
-                    neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
-                }
-            }
-        }
+                             for (size_t n = 0; n != neighboring_ids.size(); ++n)
+                             {
+                                 size_t index_j = neighboring_ids[n];
+                                 ListData list_data_j = std::make_pair(index_j, pos[index_j]);
+                                 Neighborhood &neighborhood = particle_configuration[particle_id];
+                                 neighbor_relation_inner(neighborhood, pos[particle_id], particle_id, list_data_j);
+                             }
+                         }
+                     }
+                 });
+}
+//=================================================================================================//
+void TreeBody::writeBranchesToBinary(BinaryDataWriter &binary_writer)
+{
+    size_t number_of_branches = branches_.size();
+    StdVec<UnsignedInt> parents(number_of_branches), terminated(number_of_branches);
+    StdVec<UnsignedInt> particle_offsets(number_of_branches + 1, 0), branch_particles;
+    StdVec<Vecd> end_directions(number_of_branches);
+    for (size_t k = 0; k != number_of_branches; ++k)
+    {
+        Branch *branch = branches_[k];
+        parents[k] = branch->in_edge_ == MaxSize_t ? std::numeric_limits<UnsignedInt>::max()
+                                                   : UnsignedInt(branch->in_edge_);
+        terminated[k] = branch->is_terminated_ ? 1 : 0;
+        end_directions[k] = branch->end_direction_;
+        branch_particles.insert(branch_particles.end(), branch->inner_particles_.begin(), branch->inner_particles_.end());
+        particle_offsets[k + 1] = branch_particles.size();
+    }
+    StdVec<UnsignedInt> branch_locations(branch_locations_.begin(), branch_locations_.end());
+
+    binary_writer.writeVariable<UnsignedInt>("BranchParent", parents.data(), number_of_branches);
+    binary_writer.writeVariable<UnsignedInt>("BranchTerminated", terminated.data(), number_of_branches);
+    binary_writer.writeVariable<Vecd>("BranchEndDirection", end_directions.data(), number_of_branches);
+    binary_writer.writeVariable<UnsignedInt>("BranchParticleOffset", particle_offsets.data(), number_of_branches + 1);
+    binary_writer.writeVariable<UnsignedInt>("BranchParticle", branch_particles.data(), branch_particles.size());
+    binary_writer.writeVariable<UnsignedInt>("BranchLocation", branch_locations.data(), branch_locations.size());
+}
+//=================================================================================================//
+bool TreeBody::readBranchesFromBinary(BinaryDataReader &binary_reader)
+{
+    BinaryDataIndex &index = binary_reader.getIndex();
+    for (const std::string name : {"BranchParent", "BranchTerminated", "BranchEndDirection",
+                                   "BranchParticleOffset", "BranchParticle", "BranchLocation"})
+    {
+        if (!binary_reader.hasVariable(name))
+            return false;
+    }
+
+    size_t number_of_branches = index["BranchParent"].entry_.number_of_elements_;
+    StdVec<UnsignedInt> parents(number_of_branches), terminated(number_of_branches);
+    StdVec<UnsignedInt> particle_offsets(number_of_branches + 1);
+    StdVec<Vecd> end_directions(number_of_branches);
+    StdVec<UnsignedInt> branch_particles(index["BranchParticle"].entry_.number_of_elements_);
+    StdVec<UnsignedInt> branch_locations(index["BranchLocation"].entry_.number_of_elements_);
+    binary_reader.readVariable<UnsignedInt>("BranchParent", parents.data(), parents.size());
+    binary_reader.readVariable<UnsignedInt>("BranchTerminated", terminated.data(), terminated.size());
+    binary_reader.readVariable<Vecd>("BranchEndDirection", end_directions.data(), end_directions.size());
+    binary_reader.readVariable<UnsignedInt>("BranchParticleOffset", particle_offsets.data(), particle_offsets.size());
+    binary_reader.readVariable<UnsignedInt>("BranchParticle", branch_particles.data(), branch_particles.size());
+    binary_reader.readVariable<UnsignedInt>("BranchLocation", branch_locations.data(), branch_locations.size());
+
+    // the branches are created in the order of their ids, so that parents always exist
+    for (size_t k = 0; k != number_of_branches; ++k)
+    {
+        Branch *branch = k == 0 ? root_ : createANewBranch(parents[k]);
+        branch->is_terminated_ = terminated[k] != 0;
+        branch->end_direction_ = end_directions[k];
+        branch->inner_particles_.assign(branch_particles.begin() + particle_offsets[k],
+                                        branch_particles.begin() + particle_offsets[k + 1]);
     }
+    branch_locations_.assign(branch_locations.begin(), branch_locations.end());
+    return true;
 }
 //=================================================================================================//
 size_t TreeBody::BranchLocation(size_t total_particles, size_t particle_idx)
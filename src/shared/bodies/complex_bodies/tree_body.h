@@ -33,6 +33,9 @@
 
 namespace SPH
 {
+class BinaryDataWriter;
+class BinaryDataReader;
+
 /**
  * @class TreeBody
  * @brief The tree is composed of a root (the first branch)
@@ -69,6 +72,10 @@ class TreeBody : public SecondaryStructure, public RealBody
 
     virtual void buildParticleConfiguration(ParticleConfiguration &particle_configuration) override;
     size_t ContainerSize() { return branches_.size(); };
+    /** write the branch structure and the particle locations in branches */
+    void writeBranchesToBinary(BinaryDataWriter &binary_writer);
+    /** rebuild the branches on the root, returns false if no branch structure is found */
+    bool readBranchesFromBinary(BinaryDataReader &binary_reader);
 };
 
 /**
@@ -2,19 +2,333 @@
 #include "unstructured_mesh.h"
 
 #include "base_particle_dynamics.h"
+#include "binary_data_file.h"
+
+#include <filesystem>
+#include <numeric>
 
 namespace SPH
 {
 //=================================================================================================//
+void ANSYSMesh::reorderCells()
+{
+    size_t number_of_cells = mesh_topology_.size();
+    // the cell indices in the topology are 1-based, 0 and invalid values denote boundaries
+    auto neighbor_cell = [&](const StdVec<size_t> &face_data) -> size_t
+    {
+        return face_data[0] >= 1 && face_data[0] <= number_of_cells ? face_data[0] - 1 : MaxSize_t;
+    };
+    StdLargeVec<size_t> degrees(number_of_cells, 0);
+    for (size_t i = 0; i != number_of_cells; ++i)
+        for (const StdVec<size_t> &face_data : mesh_topology_[i])
+            if (neighbor_cell(face_data) != MaxSize_t)
+                degrees[i]++;
+
+    StdLargeVec<size_t> cell_order;
+    cell_order.reserve(number_of_cells);
+    StdVec<bool> is_ordered(number_of_cells, false);
+    StdLargeVec<size_t> cells_by_degree(number_of_cells);
+    std::iota(cells_by_degree.begin(), cells_by_degree.end(), 0);
+    std::stable_sort(cells_by_degree.begin(), cells_by_degree.end(),
+                     [&](size_t a, size_t b)
+                     { return degrees[a] < degrees[b]; });
+    StdVec<size_t> neighbors;
+    for (size_t start : cells_by_degree) // each connected region starts from a cell of minimum degree
+    {
+        if (is_ordered[start])
+            continue;
+        is_ordered[start] = true;
+        cell_order.push_back(start);
+        for (size_t k = cell_order.size() - 1; k != cell_order.size(); ++k)
+        {
+            neighbors.clear();
+            for (const StdVec<size_t> &face_data : mesh_topology_[cell_order[k]])
+            {
+                size_t j = neighbor_cell(face_data);
+                if (j != MaxSize_t && !is_ordered[j])
+                {
+                    is_ordered[j] = true;
+                    neighbors.push_back(j);
+                }
+            }
+            std::sort(neighbors.begin(), neighbors.end(),
+                      [&](size_t a, size_t b)
+                      { return degrees[a] < degrees[b]; });
+            cell_order.insert(cell_order.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    std::reverse(cell_order.begin(), cell_order.end());
+
+    StdLargeVec<size_t> new_index(number_of_cells);
+    for (size_t k = 0; k != number_of_cells; ++k)
+        new_index[cell_order[k]] = k;
+
+    StdVec<StdVec<StdVec<size_t>>> reordered_topology(number_of_cells);
+    StdLargeVec<Vecd> reordered_centroids(number_of_cells);
+    StdLargeVec<Real> reordered_volumes(number_of_cells);
+    StdLargeVec<StdVec<size_t>> reordered_nodes_connection(number_of_cells);
+    for (size_t k = 0; k != number_of_cells; ++k)
+    {
+        size_t old_index = cell_order[k];
+        reordered_topology[k] = std::move(mesh_topology_[old_index]);
+        for (StdVec<size_t> &face_data : reordered_topology[k])
+        {
+            size_t j = neighbor_cell(face_data);
+            if (j != MaxSize_t)
+                face_data[0] = new_index[j] + 1;
+        }
+        reordered_centroids[k] = elements_centroids_[old_index];
+        reordered_volumes[k] = elements_volumes_[old_index];
+        reordered_nodes_connection[k] = std::move(elements_nodes_connection_[old_index]);
+    }
+    mesh_topology_ = std::move(reordered_topology);
+    elements_centroids_ = std::move(reordered_centroids);
+    elements_volumes_ = std::move(reordered_volumes);
+    elements_nodes_connection_ = std::move(reordered_nodes_connection);
+    original_cell_ids_ = std::move(cell_order);
+}
+//=================================================================================================//
+StdVec<UnsignedInt> ANSYSMesh::meshFileKey(const std::string &full_path)
+{
+    std::ifstream mesh_file(full_path, std::ios::binary);
+    if (mesh_file.fail())
+    {
+        std::cout << "\n Error: the mesh file " << full_path << " is not found." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    std::string content((std::istreambuf_iterator<char>(mesh_file)), std::istreambuf_iterator<char>());
+    uint64_t size = content.size();
+    uint64_t hash = hashBinaryData(content.data(), content.size());
+    return {UnsignedInt(size), UnsignedInt(size >> 32), UnsignedInt(hash), UnsignedInt(hash >> 32)};
+}
+//=================================================================================================//
+bool ANSYSMesh::readFromBinaryCache(const std::string &cache_path, const StdVec<UnsignedInt> &mesh_file_key)
+{
+    if (!std::filesystem::exists(cache_path))
+        return false;
+
+    BinaryDataReader binary_reader(cache_path);
+    BinaryDataIndex &index = binary_reader.getIndex();
+    for (const std::string name : {"MeshFileKey", "BoundaryTypes", "NodeCoordinates", "ElementCentroids",
+                                   "ElementVolumes", "OriginalCellIds", "NodeOffsets", "ElementNodes",
+                                   "FaceOffsets", "FaceDataOffsets", "FaceData", "MinimumNodeDistance"})
+    {
+        if (!binary_reader.hasVariable(name))
+            return false;
+    }
+    StdVec<UnsignedInt> cached_key(mesh_file_key.size());
+    if (index["MeshFileKey"].entry_.number_of_elements_ != mesh_file_key.size())
+        return false;
+    binary_reader.readVariable<UnsignedInt>("MeshFileKey", cached_key.data(), cached_key.size());
+    if (cached_key != mesh_file_key)
+        return false;
+
+    auto read_all = [&](const std::string &name, auto &data)
+    {
+        using DataType = typename std::decay_t<decltype(data)>::value_type;
+        data.resize(index[name].entry_.number_of_elements_);
+        binary_reader.readVariable<DataType>(name, data.data(), data.size());
+    };
+    StdVec<UnsignedInt> boundary_types, original_cell_ids, node_offsets, element_nodes;
+    StdVec<UnsignedInt> face_offsets, face_data_offsets, face_data;
+    StdVec<Real> minimum_distance;
+    read_all("BoundaryTypes", boundary_types);
+    read_all("NodeCoordinates", node_coordinates_);
+    read_all("ElementCentroids", elements_centroids_);
+    read_all("ElementVolumes", elements_volumes_);
+    read_all("OriginalCellIds", original_cell_ids);
+    read_all("NodeOffsets", node_offsets);
+    read_all("ElementNodes", element_nodes);
+    read_all("FaceOffsets", face_offsets);
+    read_all("FaceDataOffsets", face_data_offsets);
+    read_all("FaceData", face_data);
+    read_all("MinimumNodeDistance", minimum_distance);
+
+    // invalid indices are stored as the largest unsigned integer
+    auto to_size_t = [](UnsignedInt value)
+    { return value == std::numeric_limits<UnsignedInt>::max() ? MaxSize_t : size_t(value); };
+    types_of_boundary_condition_.assign(boundary_types.begin(), boundary_types.end());
+    original_cell_ids_.assign(original_cell_ids.begin(), original_cell_ids.end());
+    size_t number_of_cells = elements_centroids_.size();
+    elements_nodes_connection_.resize(number_of_cells);
+    mesh_topology_.resize(number_of_cells);
+    for (size_t i = 0; i != number_of_cells; ++i)
+    {
+        elements_nodes_connection_[i].assign(element_nodes.begin() + node_offsets[i],
+                                             element_nodes.begin() + node_offsets[i + 1]);
+        mesh_topology_[i].resize(face_offsets[i + 1] - face_offsets[i]);
+        for (size_t f = face_offsets[i]; f != face_offsets[i + 1]; ++f)
+        {
+            StdVec<size_t> &face = mesh_topology_[i][f - face_offsets[i]];
+            face.resize(face_data_offsets[f + 1] - face_data_offsets[f]);
+            for (size_t k = face_data_offsets[f]; k != face_data_offsets[f + 1]; ++k)
+                face[k - face_data_offsets[f]] = to_size_t(face_data[k]);
+        }
+    }
+    min_distance_between_nodes_ = minimum_distance[0];
+    std::cout << "Mesh data is read from the binary cache " << cache_path << "." << std::endl;
+    return true;
+}
+//=================================================================================================//
+void ANSYSMesh::writeToBinaryCache(const std::string &cache_path, const StdVec<UnsignedInt> &mesh_file_key)
+{
+    auto to_unsigned = [](size_t value)
+    { return value >= std::numeric_limits<UnsignedInt>::max() ? std::numeric_limits<UnsignedInt>::max() : UnsignedInt(value); };
+    StdVec<UnsignedInt> boundary_types(types_of_boundary_condition_.begin(), types_of_boundary_condition_.end());
+    StdVec<UnsignedInt> original_cell_ids(original_cell_ids_.begin(), original_cell_ids_.end());
+    size_t number_of_cells = mesh_topology_.size();
+    StdVec<UnsignedInt> node_offsets(number_of_cells + 1, 0), element_nodes;
+    StdVec<UnsignedInt> face_offsets(number_of_cells + 1, 0), face_data_offsets(1, 0), face_data;
+    for (size_t i = 0; i != number_of_cells; ++i)
+    {
+        for (size_t node : elements_nodes_connection_[i])
+            element_nodes.push_back(to_unsigned(node));
+        node_offsets[i + 1] = element_nodes.size();
+        for (const StdVec<size_t> &face : mesh_topology_[i])
+        {
+            for (size_t value : face)
+                face_data.push_back(to_unsigned(value));
+            face_data_offsets.push_back(face_data.size());
+        }
+        face_offsets[i + 1] = face_data_offsets.size() - 1;
+    }
+    Real minimum_distance = min_distance_between_nodes_;
+
+    BinaryDataWriter binary_writer(cache_path);
+    binary_writer.writeVariable<UnsignedInt>("MeshFileKey", mesh_file_key.data(), mesh_file_key.size());
+    binary_writer.writeVariable<UnsignedInt>("BoundaryTypes", boundary_types.data(), boundary_types.size());
+    binary_writer.writeVariable<Vecd>("NodeCoordinates", node_coordinates_.data(), node_coordinates_.size());
+    binary_writer.writeVariable<Vecd>("ElementCentroids", elements_centroids_.data(), elements_centroids_.size());
+    binary_writer.writeVariable<Real>("ElementVolumes", elements_volumes_.data(), elements_volumes_.size());
+    binary_writer.writeVariable<UnsignedInt>("OriginalCellIds", original_cell_ids.data(), original_cell_ids.size());
+    binary_writer.writeVariable<UnsignedInt>("NodeOffsets", node_offsets.data(), node_offsets.size());
+    binary_writer.writeVariable<UnsignedInt>("ElementNodes", element_nodes.data(), element_nodes.size());
+    binary_writer.writeVariable<UnsignedInt>("FaceOffsets", face_offsets.data(), face_offsets.size());
+    binary_writer.writeVariable<UnsignedInt>("FaceDataOffsets", face_data_offsets.data(), face_data_offsets.size());
+    binary_writer.writeVariable<UnsignedInt>("FaceData", face_data.data(), face_data.size());
+    binary_writer.writeVariable<Real>("MinimumNodeDistance", &minimum_distance, 1);
+    binary_writer.finalize();
+}
+//=================================================================================================//
 BaseInnerRelationInFVM::BaseInnerRelationInFVM(RealBody &real_body, ANSYSMesh &ansys_mesh)
     : BaseInnerRelation(real_body), real_body_(&real_body),
       node_coordinates_(ansys_mesh.node_coordinates_),
       mesh_topology_(ansys_mesh.mesh_topology_),
       pos_(base_particles_.getVariableDataByName<Vecd>("Position")),
-      Vol_(base_particles_.getVariableDataByName<Real>("VolumetricMeasure"))
+      Vol_(base_particles_.getVariableDataByName<Real>("VolumetricMeasure")), topology_size_(0),
+      dv_neighbor_index_(face_variable_ptrs_.createPtr<DiscreteVariable<UnsignedInt>>("NeighborIndex", 1)),
+      dv_particle_offset_(face_variable_ptrs_.createPtr<DiscreteVariable<UnsignedInt>>("ParticleOffset", 1)),
+      dv_face_area_(face_variable_ptrs_.createPtr<DiscreteVariable<Real>>("FaceArea", 1)),
+      dv_face_distance_(face_variable_ptrs_.createPtr<DiscreteVariable<Real>>("FaceDistance", 1)),
+      dv_face_normal_(face_variable_ptrs_.createPtr<DiscreteVariable<Vecd>>("FaceNormal", 1))
 {
     subscribeToBody();
     inner_configuration_.resize(base_particles_.RealParticlesBound(), Neighborhood());
+    dv_neighbor_index_->setNeighborData();
+    dv_face_area_->setNeighborData();
+    dv_face_distance_->setNeighborData();
+    dv_face_normal_->setNeighborData();
 };
+//=================================================================================================//
+void BaseInnerRelationInFVM::buildFaceTopology()
+{
+    size_t number_of_cells = base_particles_.TotalRealParticles();
+    dv_particle_offset_->reallocateDataField(execution::par, number_of_cells + 1);
+    UnsignedInt *particle_offset = dv_particle_offset_->DataField();
+    particle_offset[0] = 0;
+    for (size_t i = 0; i != number_of_cells; ++i)
+        particle_offset[i + 1] = particle_offset[i] + mesh_topology_[i].size();
+
+    size_t number_of_faces = particle_offset[number_of_cells];
+    dv_neighbor_index_->reallocateDataField(execution::par, number_of_faces);
+    UnsignedInt *neighbor_index = dv_neighbor_index_->DataField();
+    dv_face_area_->reallocateDataField(execution::par, number_of_faces);
+    dv_face_distance_->reallocateDataField(execution::par, number_of_faces);
+    dv_face_normal_->reallocateDataField(execution::par, number_of_faces);
+    Real *face_area = dv_face_area_->DataField();
+    Real *face_distance = dv_face_distance_->DataField();
+    Vecd *face_normal = dv_face_normal_->DataField();
+    parallel_for(
+        IndexRange(0, number_of_cells),
+        [&](const IndexRange &r)
+        {
+            for (size_t index_i = r.begin(); index_i != r.end(); ++index_i)
+            {
+                for (size_t n = particle_offset[index_i]; n != particle_offset[index_i + 1]; ++n)
+                {
+                    const StdVec<size_t> &face_data = mesh_topology_[index_i][n - particle_offset[index_i]];
+                    neighbor_index[n] = face_data[0] - 1;
+                    computeFaceGeometry(index_i, face_data, face_area[n], face_normal[n], face_distance[n]);
+                }
+            }
+        },
+        ap);
+    dv_particle_offset_->setSynchronizationOutdated();
+    dv_neighbor_index_->setSynchronizationOutdated();
+    dv_face_area_->setSynchronizationOutdated();
+    dv_face_distance_->setSynchronizationOutdated();
+    dv_face_normal_->setSynchronizationOutdated();
+    topology_size_ = mesh_topology_.size();
+    resetComputingKernelUpdated();
+}
+//=================================================================================================//
+void BaseInnerRelationInFVM::registerComputingKernel(execution::Implementation<Base> *implementation)
+{
+    all_inner_computing_kernels_.push_back(implementation);
+}
+//=================================================================================================//
+void BaseInnerRelationInFVM::resetComputingKernelUpdated()
+{
+    for (size_t k = 0; k != all_inner_computing_kernels_.size(); ++k)
+    {
+        all_inner_computing_kernels_[k]->resetUpdated();
+    }
+}
+//=================================================================================================//
+InnerRelationInFVM::InnerRelationInFVM(RealBody &real_body, ANSYSMesh &ansys_mesh)
+    : BaseInnerRelationInFVM(real_body, ansys_mesh), get_inner_neighbor_(&real_body){};
+//=================================================================================================//
+template <typename GetParticleIndex, typename GetNeighborRelation>
+void InnerRelationInFVM::searchNeighborsByParticles(size_t total_particles, BaseParticles &source_particles,
+                                                    ParticleConfiguration &particle_configuration,
+                                                    GetParticleIndex &get_particle_index, GetNeighborRelation &get_neighbor_relation)
+{
+    UnsignedInt *neighbor_index = dv_neighbor_index_->DataField();
+    UnsignedInt *particle_offset = dv_particle_offset_->DataField();
+    Real *face_area = dv_face_area_->DataField();
+    Real *face_distance = dv_face_distance_->DataField();
+    Vecd *face_normal = dv_face_normal_->DataField();
+    parallel_for(
+        IndexRange(0, base_particles_.TotalRealParticles()),
+        [&](const IndexRange &r)
+        {
+            for (size_t num = r.begin(); num != r.end(); ++num)
+            {
+                size_t index_i = get_particle_index(num);
+                Neighborhood &neighborhood = particle_configuration[index_i];
+                for (size_t n = particle_offset[index_i]; n != particle_offset[index_i + 1]; ++n)
+                {
+                    size_t index_j = neighbor_index[n];
+                    Real r_ij = face_distance[n];
+                    Real dW_ij = -face_area[n] / (2.0 * Vol_[index_i] * Vol_[index_j]);
+                    Vecd normal = face_normal[n];
+                    get_neighbor_relation(neighborhood, r_ij, dW_ij, normal, index_j);
+                }
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void InnerRelationInFVM::buildConfiguration()
+{
+    if (topology_size_ != mesh_topology_.size())
+        buildFaceTopology();
+
+    resetNeighborhoodCurrentSize();
+    searchNeighborsByParticles(base_particles_.TotalRealParticles(),
+                               base_particles_, inner_configuration_,
+                               get_particle_index_, get_inner_neighbor_);
+}
 //=============================================================================================//
 } // namespace SPH
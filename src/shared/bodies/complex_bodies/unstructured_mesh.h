@@ -29,6 +29,7 @@
 #define UNSTRUCTURED_MESH_H
 
 #include "base_body_relation.h"
+#include "execution.h"
 
 namespace SPH
 {
@@ -39,7 +40,8 @@ namespace SPH
 class ANSYSMesh
 {
   public:
-    ANSYSMesh(const std::string &full_path);
+    /** with the binary cache, the parsed and reordered mesh is read from or written to full_path + ".cache" */
+    ANSYSMesh(const std::string &full_path, bool use_binary_cache = false);
     virtual ~ANSYSMesh(){};
 
     StdVec<size_t> types_of_boundary_condition_;
@@ -48,6 +50,8 @@ class ANSYSMesh
     StdLargeVec<Real> elements_volumes_;
     StdLargeVec<StdVec<size_t>> elements_nodes_connection_;
     StdVec<StdVec<StdVec<size_t>>> mesh_topology_;
+    /** the cell index in the mesh file of each (reordered) cell, for output */
+    StdLargeVec<size_t> original_cell_ids_;
     Real MinMeshEdge() { return min_distance_between_nodes_; }
 
   protected:
@@ -55,7 +59,16 @@ class ANSYSMesh
 
     void getDataFromMeshFile(const std::string &full_path);
     void getElementCenterCoordinates();
+    /**
+     * Reverse Cuthill-McKee ordering of the cells so that face neighbors are close in memory.
+     * All cell data and the topology are permuted consistently once after loading.
+     */
+    void reorderCells();
     void getMinimumDistanceBetweenNodes();
+    /** the cache is valid only for a mesh file with the same size and content hash */
+    StdVec<UnsignedInt> meshFileKey(const std::string &full_path);
+    bool readFromBinaryCache(const std::string &cache_path, const StdVec<UnsignedInt> &mesh_file_key);
+    void writeToBinaryCache(const std::string &cache_path, const StdVec<UnsignedInt> &mesh_file_key);
 };
 
 /**
@@ -64,6 +77,8 @@ class ANSYSMesh
  */
 class BaseInnerRelationInFVM : public BaseInnerRelation
 {
+    UniquePtrsKeeper<Entity> face_variable_ptrs_;
+
   public:
     RealBody *real_body_;
     StdLargeVec<Vecd> &node_coordinates_;
@@ -72,10 +87,32 @@ class BaseInnerRelationInFVM : public BaseInnerRelation
     explicit BaseInnerRelationInFVM(RealBody &real_body, ANSYSMesh &ansys_mesh);
     virtual ~BaseInnerRelationInFVM(){};
 
+    /** CK-style neighbor lists of the flat face-based topology, used by FaceNeighborList */
+    DiscreteVariable<UnsignedInt> *getNeighborIndex() { return dv_neighbor_index_; };
+    DiscreteVariable<UnsignedInt> *getParticleOffset() { return dv_particle_offset_; };
+    DiscreteVariable<Real> *getFaceArea() { return dv_face_area_; };
+    DiscreteVariable<Real> *getFaceDistance() { return dv_face_distance_; };
+    DiscreteVariable<Vecd> *getFaceNormal() { return dv_face_normal_; };
+    /** CK computing kernels are re-created when the face topology is rebuilt */
+    void registerComputingKernel(execution::Implementation<Base> *implementation);
+    void resetComputingKernelUpdated();
+
   protected:
     Vecd *pos_;
     Real *Vol_;
+    /** number of mesh elements, including ghost ones, when the face topology was built */
+    size_t topology_size_;
+    /** face-based topology in compressed-row form, the face data is ordered as the neighbor index */
+    DiscreteVariable<UnsignedInt> *dv_neighbor_index_, *dv_particle_offset_;
+    DiscreteVariable<Real> *dv_face_area_, *dv_face_distance_;
+    DiscreteVariable<Vecd> *dv_face_normal_; /**< unit normal pointing into the cell */
+    StdVec<execution::Implementation<Base> *> all_inner_computing_kernels_;
+
     virtual void resetNeighborhoodCurrentSize() override;
+    /** flattens the nested mesh topology once, rebuilt only if ghost elements are added */
+    void buildFaceTopology();
+    void computeFaceGeometry(size_t index_i, const StdVec<size_t> &face_data,
+                             Real &area, Vecd &normal, Real &distance);
 };
 
 /**
@@ -141,7 +178,7 @@ class InnerRelationInFVM : public BaseInnerRelationInFVM
                                     ParticleConfiguration &particle_configuration,
                                     GetParticleIndex &get_particle_index,
                                     GetNeighborRelation &get_neighbor_relation);
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 };
 
 } // namespace SPH
@@ -30,8 +30,10 @@
 #define ALL_BODY_RELATIONS_H
 
 #include "base_body_relation.h"
+#include "body_broad_phase.h"
 #include "complex_body_relation.h"
 #include "contact_body_relation.h"
 #include "inner_body_relation.h"
+#include "multi_body_cell_linked_list.h"
 
 #endif // ALL_BODY_RELATIONS_H
@@ -2,6 +2,8 @@
 
 #include "base_particle_dynamics.h"
 #include "base_particles.hpp"
+#include "particle_functors.h"
+#include "particle_iterators.h"
 namespace SPH
 {
 //=================================================================================================//
@@ -16,10 +18,84 @@ RealBodyVector BodyPartsToRealBodies(BodyPartVector body_parts)
     return real_bodies;
 }
 //=================================================================================================//
+size_t ConfigurationMemoryFootprint(const ParticleConfiguration &particle_configuration)
+{
+    size_t bytes = particle_configuration.capacity() * sizeof(Neighborhood);
+    for (const Neighborhood &neighborhood : particle_configuration)
+    {
+        bytes += neighborhood.j_.capacity() * sizeof(NeighborIndex) +
+                 (neighborhood.W_ij_.capacity() + neighborhood.dW_ij_.capacity() +
+                  neighborhood.r_ij_.capacity()) *
+                     sizeof(NeighborReal) +
+                 neighborhood.e_ij_.capacity() * sizeof(Vecd);
+    }
+    return bytes;
+}
+//=================================================================================================//
+CountStatistics ConfigurationNeighborStatistics(const ParticleConfiguration &particle_configuration,
+                                                size_t number_of_particles)
+{
+    return computeCountStatistics(SMIN(number_of_particles, particle_configuration.size()),
+                                  [&](size_t i)
+                                  { return particle_configuration[i].current_size_; });
+}
+//=================================================================================================//
 SPHRelation::SPHRelation(SPHBody &sph_body)
     : sph_body_(sph_body),
       base_particles_(sph_body.getBaseParticles()) {}
 //=================================================================================================//
+void SPHRelation::updateConfiguration()
+{
+    idle_steps_ = 0;
+    if (isConfigurationFrozen())
+    {
+        sph_body_.checkFrozenConfiguration();
+        if (is_configuration_built_)
+            return;
+    }
+
+    if (is_lazy_configuration_ && !is_configuration_built_)
+    {
+        // the cell linked lists skipped at the system initialization are updated at the first use
+        for (SPHBody *body : getInvolvedBodies())
+        {
+            RealBody *real_body = dynamic_cast<RealBody *>(body);
+            if (real_body != nullptr && !real_body->isCellLinkedListUpdated())
+                real_body->updateCellLinkedList();
+        }
+    }
+    if (is_configuration_built_ && isConfigurationReusable())
+        return;
+
+    buildConfiguration();
+    is_configuration_built_ = true;
+    total_builds_++;
+    sph_body_.incrementConfigurationVersion();
+    recordConfigurationBuild();
+}
+//=================================================================================================//
+void SPHRelation::setLazyConfiguration(size_t release_idle_steps)
+{
+    is_lazy_configuration_ = true;
+    release_idle_steps_ = release_idle_steps;
+}
+//=================================================================================================//
+void SPHRelation::countIdleStep()
+{
+    if (release_idle_steps_ != 0 && is_configuration_built_ && !isConfigurationFrozen())
+    {
+        if (++idle_steps_ >= release_idle_steps_)
+            releaseConfiguration();
+    }
+}
+//=================================================================================================//
+void SPHRelation::releaseConfiguration()
+{
+    clearConfiguration();
+    is_configuration_built_ = false;
+    idle_steps_ = 0;
+}
+//=================================================================================================//
 BaseInnerRelation::BaseInnerRelation(RealBody &real_body)
     : SPHRelation(real_body), real_body_(&real_body)
 {
@@ -29,7 +105,7 @@ BaseInnerRelation::BaseInnerRelation(RealBody &real_body)
 //=================================================================================================//
 void BaseInnerRelation::resetNeighborhoodCurrentSize()
 {
-    parallel_for(
+    arena_parallel_for(
         IndexRange(0, base_particles_.TotalRealParticles()),
         [&](const IndexRange &r)
         {
@@ -41,11 +117,40 @@ void BaseInnerRelation::resetNeighborhoodCurrentSize()
         ap);
 }
 //=================================================================================================//
+void BaseInnerRelation::clearConfiguration()
+{
+    inner_configuration_.assign(inner_configuration_.size(), Neighborhood());
+    compact_inner_configuration_ = CompactParticleConfiguration();
+    compact_reference_gradient_.clear();
+}
+//=================================================================================================//
+size_t BaseInnerRelation::MemoryFootprint()
+{
+    return ConfigurationMemoryFootprint(inner_configuration_) +
+           compact_inner_configuration_.MemoryFootprint() + compact_reference_gradient_.MemoryFootprint();
+}
+//=================================================================================================//
+CountStatistics BaseInnerRelation::NeighborStatistics()
+{
+    return ConfigurationNeighborStatistics(inner_configuration_, base_particles_.TotalRealParticles());
+}
+//=================================================================================================//
+void BaseInnerRelation::updateCompactConfiguration()
+{
+    compact_reference_gradient_.clear();
+    if (is_compact_configuration_enabled_)
+    {
+        compact_inner_configuration_.compactFrom(inner_configuration_, base_particles_.TotalRealParticles());
+    }
+}
+//=================================================================================================//
 BaseContactRelation::BaseContactRelation(SPHBody &sph_body, RealBodyVector contact_sph_bodies)
     : SPHRelation(sph_body), contact_bodies_(contact_sph_bodies)
 {
     subscribeToBody();
     contact_configuration_.resize(contact_bodies_.size());
+    compact_contact_configuration_.resize(contact_bodies_.size());
+    is_contact_active_.resize(contact_bodies_.size(), true);
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
         const std::string name = contact_bodies_[k]->getName();
@@ -55,11 +160,22 @@ BaseContactRelation::BaseContactRelation(SPHBody &sph_body, RealBodyVector conta
     }
 }
 //=================================================================================================//
+void BaseContactRelation::updateContactActivity()
+{
+    if (broad_phase_ != nullptr)
+    {
+        for (size_t k = 0; k != contact_bodies_.size(); ++k)
+        {
+            is_contact_active_[k] = broad_phase_->isOverlapping(sph_body_, *contact_bodies_[k]);
+        }
+    }
+}
+//=================================================================================================//
 void BaseContactRelation::resetNeighborhoodCurrentSize()
 {
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
-        parallel_for(
+        arena_parallel_for(
             IndexRange(0, base_particles_.TotalRealParticles()),
             [&](const IndexRange &r)
             {
@@ -72,4 +188,126 @@ void BaseContactRelation::resetNeighborhoodCurrentSize()
     }
 }
 //=================================================================================================//
+void BaseContactRelation::clearConfiguration()
+{
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        contact_configuration_[k].assign(contact_configuration_[k].size(), Neighborhood());
+        compact_contact_configuration_[k] = CompactParticleConfiguration();
+    }
+}
+//=================================================================================================//
+size_t BaseContactRelation::MemoryFootprint()
+{
+    size_t bytes = 0;
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        bytes += ConfigurationMemoryFootprint(contact_configuration_[k]) +
+                 compact_contact_configuration_[k].MemoryFootprint();
+    }
+    return bytes;
+}
+//=================================================================================================//
+CountStatistics BaseContactRelation::NeighborStatistics(size_t contact_index)
+{
+    return ConfigurationNeighborStatistics(contact_configuration_[contact_index], base_particles_.TotalRealParticles());
+}
+//=================================================================================================//
+CountStatistics BaseContactRelation::NeighborStatistics()
+{
+    size_t number_of_particles = base_particles_.TotalRealParticles();
+    return computeCountStatistics(number_of_particles,
+                                  [&](size_t i)
+                                  {
+                                      size_t count = 0;
+                                      for (size_t k = 0; k != contact_bodies_.size(); ++k)
+                                      {
+                                          if (is_contact_active_[k] && i < contact_configuration_[k].size())
+                                              count += contact_configuration_[k][i].current_size_;
+                                      }
+                                      return count;
+                                  });
+}
+//=================================================================================================//
+SPHBodyVector BaseContactRelation::getInvolvedBodies()
+{
+    SPHBodyVector involved_bodies = {&sph_body_};
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+        involved_bodies.push_back(contact_bodies_[k]);
+    return involved_bodies;
+}
+//=================================================================================================//
+void BaseContactRelation::setReuseTolerance(Real reuse_tolerance)
+{
+    reuse_tolerance_ = SMAX(reuse_tolerance, Real(0));
+    reuse_tracked_particles_ = {&base_particles_};
+    for (size_t k = 0; k != contact_particles_.size(); ++k)
+        reuse_tracked_particles_.push_back(contact_particles_[k]);
+    pos_at_last_build_.clear();
+}
+//=================================================================================================//
+bool BaseContactRelation::isConfigurationReusable()
+{
+    if (reuse_tolerance_ <= 0.0 || pos_at_last_build_.empty())
+        return false;
+
+    Real total_displacement = 0.0;
+    for (size_t l = 0; l != reuse_tracked_particles_.size(); ++l)
+    {
+        BaseParticles *particles = reuse_tracked_particles_[l];
+        size_t total_real_particles = particles->TotalRealParticles();
+        if (total_real_particles != total_real_particles_at_last_build_[l] ||
+            particles->TotalSorts() != total_sorts_at_last_build_[l])
+            return false;
+
+        Vecd *pos = particles->ParticlePositions();
+        Vecd *pos_at_last_build = pos_at_last_build_[l].data();
+        Real max_displacement_squared = particle_reduce(
+            execution::ParallelPolicy(), IndexRange(0, total_real_particles), Real(0), ReduceMax(),
+            [&](size_t i) -> Real
+            { return (pos[i] - pos_at_last_build[i]).squaredNorm(); });
+        total_displacement += sqrt(max_displacement_squared);
+    }
+    return total_displacement <= reuse_tolerance_;
+}
+//=================================================================================================//
+void BaseContactRelation::recordConfigurationBuild()
+{
+    if (reuse_tolerance_ <= 0.0)
+        return;
+
+    size_t number_of_tracked = reuse_tracked_particles_.size();
+    pos_at_last_build_.resize(number_of_tracked);
+    total_real_particles_at_last_build_.resize(number_of_tracked);
+    total_sorts_at_last_build_.resize(number_of_tracked);
+    for (size_t l = 0; l != number_of_tracked; ++l)
+    {
+        BaseParticles *particles = reuse_tracked_particles_[l];
+        Vecd *pos = particles->ParticlePositions();
+        pos_at_last_build_[l].assign(pos, pos + particles->TotalRealParticles());
+        total_real_particles_at_last_build_[l] = particles->TotalRealParticles();
+        total_sorts_at_last_build_[l] = particles->TotalSorts();
+    }
+}
+//=================================================================================================//
+bool BaseContactRelation::isConfigurationFrozen()
+{
+    bool is_frozen = sph_body_.isConfigurationFrozen();
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+        is_frozen = is_frozen && contact_bodies_[k]->isConfigurationFrozen();
+    return is_frozen;
+}
+//=================================================================================================//
+void BaseContactRelation::updateCompactConfiguration()
+{
+    if (is_compact_configuration_enabled_)
+    {
+        for (size_t k = 0; k != contact_bodies_.size(); ++k)
+        {
+            compact_contact_configuration_[k].compactFrom(
+                contact_configuration_[k], base_particles_.TotalRealParticles());
+        }
+    }
+}
+//=================================================================================================//
 } // namespace SPH
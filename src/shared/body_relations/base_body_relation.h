@@ -31,9 +31,11 @@
 
 #include "base_body.h"
 #include "base_body_part.h"
+#include "body_broad_phase.h"
 #include "base_geometry.h"
 #include "base_particles.h"
 #include "cell_linked_list.h"
+#include "compact_neighborhood.h"
 #include "execution.h"
 #include "neighborhood.h"
 
@@ -79,6 +81,26 @@ struct SearchDepthAdaptive
     };
 };
 
+/** @brief a small functor for obtaining search radius for variable smoothing length
+ * @details The radius is the larger one of the cut-off radii of the particle and
+ * of the coarsest particles in the target level, i.e. its grid spacing,
+ * as the adaptive neighbor relations use the cut-off radius of the larger smoothing length.
+ */
+struct SearchRadiusAdaptive
+{
+    Real level_cutoff_radius_;
+    Kernel *kernel_;
+    Real *h_ratio_;
+    SearchRadiusAdaptive(SPHBody &sph_body, CellLinkedList *target_cell_linked_list)
+        : level_cutoff_radius_(target_cell_linked_list->GridSpacing() + SqrtEps),
+          kernel_(sph_body.sph_adaptation_->getKernel()),
+          h_ratio_(sph_body.getBaseParticles().getVariableDataByName<Real>("SmoothingLengthRatio")){};
+    Real operator()(size_t particle_index) const
+    {
+        return SMAX(kernel_->CutOffRadius(h_ratio_[particle_index]), level_cutoff_radius_);
+    };
+};
+
 /** @brief a small functor for obtaining search depth for variable smoothing length
  * @details Note that this is only for building contact neighbor relation.
  */
@@ -100,6 +122,12 @@ struct SearchDepthAdaptiveContact
 /** Transfer body parts to real bodies. **/
 RealBodyVector BodyPartsToRealBodies(BodyPartVector body_parts);
 
+/** the memory of a classic configuration and its neighborhoods in bytes */
+size_t ConfigurationMemoryFootprint(const ParticleConfiguration &particle_configuration);
+/** the neighbor counts of the first particles of a classic configuration */
+CountStatistics ConfigurationNeighborStatistics(const ParticleConfiguration &particle_configuration,
+                                                size_t number_of_particles);
+
 /**
  * @class SPHRelation
  * @brief The abstract class for all relations within a SPH body or with its contact SPH bodies
@@ -112,11 +140,43 @@ class SPHRelation
     virtual ~SPHRelation(){};
 
     void subscribeToBody() { sph_body_.body_relations_.push_back(this); };
-    virtual void updateConfiguration() = 0;
+    /** rebuild the configuration, or keep it once built if the configuration is frozen */
+    void updateConfiguration();
+    /** whether the bodies involved never move so that the configuration is built only once */
+    virtual bool isConfigurationFrozen() { return sph_body_.isConfigurationFrozen(); };
+    /** the bodies whose particles and cell linked lists are used to build the configuration */
+    virtual SPHBodyVector getInvolvedBodies() { return {&sph_body_}; };
+    bool isConfigurationBuilt() { return is_configuration_built_; };
+    /** The configuration is not built at the system initialization but at its first update,
+     *  and, if the release steps are given, its neighbor storage is released
+     *  after so many idle steps counted by SPHSystem::releaseIdleConfigurations. */
+    void setLazyConfiguration(size_t release_idle_steps = 0);
+    bool isLazyConfiguration() { return is_lazy_configuration_; };
+    /** count an idle step, and release the neighbor storage if idle for too long */
+    void countIdleStep();
+    /** free the neighbor storage, the configuration is rebuilt at the next update */
+    void releaseConfiguration();
+    /** the memory of the neighbor storage in bytes */
+    virtual size_t MemoryFootprint() { return 0; };
+    /** the neighbor counts of the real particles, computed on demand from the current configuration */
+    virtual CountStatistics NeighborStatistics() { return CountStatistics(); };
+    /** the number of builds, with which the dynamics depending on the configuration detect a rebuild */
+    size_t TotalBuilds() { return total_builds_; };
 
   protected:
     SPHBody &sph_body_;
     BaseParticles &base_particles_;
+    bool is_configuration_built_ = false;
+    bool is_lazy_configuration_ = false;
+    size_t release_idle_steps_ = 0; /**< zero for never released */
+    size_t idle_steps_ = 0;
+    size_t total_builds_ = 0;
+
+    virtual void buildConfiguration() = 0;
+    virtual void clearConfiguration() = 0;
+    /** whether the built configuration is still valid although the bodies are not frozen */
+    virtual bool isConfigurationReusable() { return false; };
+    virtual void recordConfigurationBuild(){};
 };
 
 /**
@@ -128,12 +188,23 @@ class BaseInnerRelation : public SPHRelation
   public:
     RealBody *real_body_;
     ParticleConfiguration inner_configuration_; /**< inner configuration for the neighbor relations. */
+    CompactParticleConfiguration compact_inner_configuration_; /**< read-only compact copy, only updated when enabled. */
+    CompactReferenceGradient compact_reference_gradient_;      /**< built on request, cleared by configuration update. */
     explicit BaseInnerRelation(RealBody &real_body);
     virtual ~BaseInnerRelation(){};
     BaseInnerRelation &getRelation() { return *this; };
+    virtual size_t MemoryFootprint() override;
+    virtual CountStatistics NeighborStatistics() override;
+    void enableCompactConfiguration() { is_compact_configuration_enabled_ = true; };
+    bool isCompactConfigurationEnabled() { return is_compact_configuration_enabled_; };
 
   protected:
+    bool is_compact_configuration_enabled_ = false;
     virtual void resetNeighborhoodCurrentSize();
+    virtual void clearConfiguration() override;
+    /** rebuild the compact configuration after the classic one is updated, if enabled,
+     * and invalidate the precomputed reference gradient */
+    void updateCompactConfiguration();
 };
 
 /**
@@ -143,13 +214,29 @@ class BaseInnerRelation : public SPHRelation
 class BaseContactRelation : public SPHRelation
 {
   protected:
+    bool is_compact_configuration_enabled_ = false;
+    BodyBroadPhase *broad_phase_ = nullptr;
+    StdVec<bool> is_contact_active_;
+    Real reuse_tolerance_ = 0.0;
+    StdVec<BaseParticles *> reuse_tracked_particles_; /**< of the body and then the contact bodies */
+    StdVec<StdVec<Vecd>> pos_at_last_build_;
+    StdVec<size_t> total_real_particles_at_last_build_;
+    StdVec<UnsignedInt> total_sorts_at_last_build_;
+    virtual bool isConfigurationReusable() override;
+    virtual void recordConfigurationBuild() override;
+    /** deactivate the contact bodies not overlapping in the broad phase, if used */
+    void updateContactActivity();
     virtual void resetNeighborhoodCurrentSize();
+    virtual void clearConfiguration() override;
+    /** rebuild the compact configurations after the classic ones are updated, if enabled */
+    void updateCompactConfiguration();
 
   public:
     RealBodyVector contact_bodies_;
     StdVec<BaseParticles *> contact_particles_;
     StdVec<SPHAdaptation *> contact_adaptations_;
     StdVec<ParticleConfiguration> contact_configuration_; /**< Configurations for particle interaction between bodies. */
+    StdVec<CompactParticleConfiguration> compact_contact_configuration_; /**< read-only compact copies, only updated when enabled. */
 
     BaseContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies);
     BaseContactRelation(SPHBody &sph_body, BodyPartVector contact_body_parts)
@@ -159,6 +246,24 @@ class BaseContactRelation : public SPHRelation
     RealBodyVector getContactBodies() { return contact_bodies_; };
     StdVec<BaseParticles *> getContactParticles() { return contact_particles_; };
     StdVec<SPHAdaptation *> getContactAdaptations() { return contact_adaptations_; };
+    void enableCompactConfiguration() { is_compact_configuration_enabled_ = true; };
+    bool isCompactConfigurationEnabled() { return is_compact_configuration_enabled_; };
+    void setBroadPhase(BodyBroadPhase &broad_phase) { broad_phase_ = &broad_phase; };
+    /**
+     * The configuration, with its kernel weights, is reused at the following updates until the particles
+     * of the body and of the contact bodies together have moved more than the tolerance since the last build,
+     * or have been sorted or changed in number, e.g. for observers fixed in space sampling slowly moving bodies.
+     * The weights are those at the last build, so that the tolerance is a small fraction of the smoothing length.
+     * A zero tolerance (the default) rebuilds the configuration at every update.
+     */
+    void setReuseTolerance(Real reuse_tolerance);
+    bool isContactActive(size_t contact_index) { return is_contact_active_[contact_index]; };
+    virtual bool isConfigurationFrozen() override;
+    virtual SPHBodyVector getInvolvedBodies() override;
+    virtual size_t MemoryFootprint() override;
+    /** of the neighbors in all active contact bodies together */
+    virtual CountStatistics NeighborStatistics() override;
+    CountStatistics NeighborStatistics(size_t contact_index);
 };
 } // namespace SPH
 #endif // BASE_BODY_RELATION_H
\ No newline at end of file
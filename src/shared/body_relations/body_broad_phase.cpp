@@ -0,0 +1,94 @@
+#include "body_broad_phase.h"
+
+#include "base_kernel.h"
+#include "base_particles.hpp"
+#include "particle_functors.h"
+#include "particle_iterators.h"
+
+namespace SPH
+{
+//=================================================================================================//
+BodyBroadPhase::BodyBroadPhase(RealBodyVector bodies)
+    : bodies_(bodies), bounds_(bodies.size()), sweep_order_(bodies.size()),
+      is_overlapping_(bodies.size(), StdVec<bool>(bodies.size(), true)),
+      number_of_overlapping_pairs_(bodies.size() * (bodies.size() - 1) / 2)
+{
+    for (size_t k = 0; k != sweep_order_.size(); ++k)
+        sweep_order_[k] = k;
+}
+//=================================================================================================//
+BoundingBox BodyBroadPhase::getCurrentBounds(RealBody &body)
+{
+    BaseParticles &particles = body.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+    IndexRange particle_range(0, particles.TotalRealParticles());
+    Vecd lower_bound = particle_reduce(execution::par, particle_range, ReduceLowerBound().reference_,
+                                       ReduceLowerBound(), [&](size_t i) -> Vecd { return pos[i]; });
+    Vecd upper_bound = particle_reduce(execution::par, particle_range, ReduceUpperBound().reference_,
+                                       ReduceUpperBound(), [&](size_t i) -> Vecd { return pos[i]; });
+    Real margin = body.sph_adaptation_->getKernel()->CutOffRadius();
+    return BoundingBox(lower_bound - margin * Vecd::Ones(), upper_bound + margin * Vecd::Ones());
+}
+//=================================================================================================//
+void BodyBroadPhase::updateOverlappingPairs()
+{
+    for (size_t k = 0; k != bodies_.size(); ++k)
+    {
+        bounds_[k] = getCurrentBounds(*bodies_[k]);
+        is_overlapping_[k].assign(bodies_.size(), false);
+    }
+
+    // insertion sort by the lower bound along the first axis
+    for (size_t k = 1; k < sweep_order_.size(); ++k)
+    {
+        size_t body_index = sweep_order_[k];
+        Real lower_bound = bounds_[body_index].first_[0];
+        size_t l = k;
+        for (; l > 0 && bounds_[sweep_order_[l - 1]].first_[0] > lower_bound; --l)
+            sweep_order_[l] = sweep_order_[l - 1];
+        sweep_order_[l] = body_index;
+    }
+
+    number_of_overlapping_pairs_ = 0;
+    for (size_t k = 0; k < sweep_order_.size(); ++k)
+    {
+        size_t a = sweep_order_[k];
+        for (size_t l = k + 1; l < sweep_order_.size(); ++l)
+        {
+            size_t b = sweep_order_[l];
+            if (bounds_[b].first_[0] > bounds_[a].second_[0])
+                break; // no further box can overlap along the sweep axis
+
+            bool is_overlapping = true;
+            for (int d = 1; d < Dimensions; ++d)
+            {
+                if (bounds_[b].first_[d] > bounds_[a].second_[d] || bounds_[a].first_[d] > bounds_[b].second_[d])
+                {
+                    is_overlapping = false;
+                    break;
+                }
+            }
+            is_overlapping_[a][b] = is_overlapping_[b][a] = is_overlapping;
+            number_of_overlapping_pairs_ += is_overlapping;
+        }
+    }
+}
+//=================================================================================================//
+size_t BodyBroadPhase::bodyIndex(SPHBody &body)
+{
+    for (size_t k = 0; k != bodies_.size(); ++k)
+    {
+        if (bodies_[k] == &body)
+            return k;
+    }
+    std::cout << "\n Error: the body " << body.getName() << " is not in the broad phase!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+bool BodyBroadPhase::isOverlapping(SPHBody &body, SPHBody &contact_body)
+{
+    return is_overlapping_[bodyIndex(body)][bodyIndex(contact_body)];
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,68 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	body_broad_phase.h
+ * @brief 	Broad phase of multi-body contact by body-level bounding boxes.
+ * @details The current bounding boxes of the bodies, enlarged by the kernel cut-off radius,
+ * 			are sorted along the first axis and swept (sweep and prune) to find the overlapping pairs.
+ * 			Contact relations using the broad phase skip the neighbor search
+ * 			for contact bodies whose boxes do not overlap with their own.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef BODY_BROAD_PHASE_H
+#define BODY_BROAD_PHASE_H
+
+#include "base_body.h"
+
+namespace SPH
+{
+/**
+ * @class BodyBroadPhase
+ * @brief Overlapping pairs of bodies by sweep and prune on body bounding boxes.
+ * The sorting order is kept between updates so that the insertion sort
+ * is almost linear for the slowly changing body arrangement.
+ * The update should be executed before the contact configurations are updated.
+ */
+class BodyBroadPhase
+{
+  public:
+    explicit BodyBroadPhase(RealBodyVector bodies);
+    virtual ~BodyBroadPhase(){};
+
+    void updateOverlappingPairs();
+    bool isOverlapping(SPHBody &body, SPHBody &contact_body);
+    size_t NumberOfOverlappingPairs() { return number_of_overlapping_pairs_; };
+
+  protected:
+    RealBodyVector bodies_;
+    StdVec<BoundingBox> bounds_;
+    StdVec<size_t> sweep_order_;
+    StdVec<StdVec<bool>> is_overlapping_;
+    size_t number_of_overlapping_pairs_;
+
+    size_t bodyIndex(SPHBody &body);
+    BoundingBox getCurrentBounds(RealBody &body);
+};
+} // namespace SPH
+#endif // BODY_BROAD_PHASE_H
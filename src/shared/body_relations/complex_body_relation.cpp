@@ -32,11 +32,18 @@ ComplexRelation::
     }
 }
 //=================================================================================================//
-void ComplexRelation::updateConfiguration()
+void ComplexRelation::buildConfiguration()
 {
     inner_relation_.updateConfiguration();
     for (size_t k = 0; k != contact_relations_.size(); ++k)
         contact_relations_[k]->updateConfiguration();
 }
 //=================================================================================================//
+void ComplexRelation::clearConfiguration()
+{
+    inner_relation_.releaseConfiguration();
+    for (size_t k = 0; k != contact_relations_.size(); ++k)
+        contact_relations_[k]->releaseConfiguration();
+}
+//=================================================================================================//
 } // namespace SPH
@@ -51,8 +51,12 @@ class ComplexRelation : public SPHRelation
     ComplexRelation(BaseInnerRelation &inner_relation, BaseContactRelation &contact_relation);
     ComplexRelation(BaseInnerRelation &inner_relation, StdVec<BaseContactRelation *> contact_relations);
     virtual ~ComplexRelation(){};
+    /** the inner and contact relations are frozen individually */
+    virtual bool isConfigurationFrozen() override { return false; };
 
-    virtual void updateConfiguration() override;
+  protected:
+    virtual void buildConfiguration() override;
+    virtual void clearConfiguration() override;
 };
 } // namespace SPH
 #endif // COMPLEX_BODY_RELATION_H
\ No newline at end of file
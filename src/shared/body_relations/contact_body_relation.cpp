@@ -17,15 +17,78 @@ ContactRelation::ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodie
     }
 }
 //=================================================================================================//
-void ContactRelation::updateConfiguration()
+void ContactRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
+    updateContactActivity();
+    if (shared_cell_linked_list_ != nullptr)
+    {
+        searchSharedCellLinkedList();
+        updateCompactConfiguration();
+        return;
+    }
+
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
+        if (!is_contact_active_[k])
+            continue;
+        // the builders are created as NeighborBuilderContact, so the builder is called without dispatch
+        StaticNeighborBuilder<NeighborBuilderContact> get_contact_neighbor(*get_contact_neighbors_[k]);
         target_cell_linked_lists_[k]->searchNeighborsByParticles(
             sph_body_, contact_configuration_[k],
-            *get_search_depths_[k], *get_contact_neighbors_[k]);
+            *get_search_depths_[k], get_contact_neighbor);
+    }
+    updateCompactConfiguration();
+}
+//=================================================================================================//
+void ContactRelation::useSharedCellLinkedList(MultiBodyCellLinkedList &shared_cell_linked_list)
+{
+    shared_cell_linked_list_ = &shared_cell_linked_list;
+    shared_contact_index_.assign(shared_cell_linked_list.getBodies().size(), MaxSize_t);
+    Real cutoff_radius = sph_body_.sph_adaptation_->getKernel()->CutOffRadius();
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        size_t body_index = shared_cell_linked_list.BodyIndex(*contact_bodies_[k]);
+        if (body_index == MaxSize_t)
+        {
+            std::cout << "\n Error: the contact body " << contact_bodies_[k]->getName()
+                      << " is not in the shared cell linked list!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        shared_contact_index_[body_index] = k;
+        cutoff_radius = SMAX(cutoff_radius, contact_bodies_[k]->sph_adaptation_->getKernel()->CutOffRadius());
+    }
+    shared_search_depth_ = shared_cell_linked_list.SearchDepth(cutoff_radius);
+}
+//=================================================================================================//
+void ContactRelation::searchSharedCellLinkedList()
+{
+    StdVec<size_t> active_contact_index(shared_contact_index_);
+    for (size_t &contact_index : active_contact_index)
+    {
+        if (contact_index != MaxSize_t && !is_contact_active_[contact_index])
+            contact_index = MaxSize_t;
     }
+
+    Vecd *pos = base_particles_.ParticlePositions();
+    particle_for(execution::ParallelPolicy(), IndexRange(0, base_particles_.TotalRealParticles()),
+                 [&](size_t index_i)
+                 {
+                     shared_cell_linked_list_->forEachBodyListDataInRange(
+                         pos[index_i], shared_search_depth_,
+                         [&](const MultiBodyCellLinkedList::BodyListData &body_list_data)
+                         {
+                             const size_t k = active_contact_index[body_list_data.body_index_];
+                             if (k != MaxSize_t)
+                             {
+                                 // qualified call without dispatch as for the per-body search
+                                 get_contact_neighbors_[k]->NeighborBuilderContact::operator()(
+                                     contact_configuration_[k][index_i], pos[index_i], index_i,
+                                     body_list_data.list_data_);
+                             }
+                         });
+                 });
 }
 //=================================================================================================//
 ShellSurfaceContactRelation::ShellSurfaceContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies)
@@ -53,7 +116,7 @@ void ShellSurfaceContactRelation::resetNeighborhoodCurrentSize()
     }
 }
 //=================================================================================================//
-void ShellSurfaceContactRelation::updateConfiguration()
+void ShellSurfaceContactRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
@@ -76,7 +139,7 @@ ContactRelationToBodyPart::
     }
 }
 //=================================================================================================//
-void ContactRelationToBodyPart::updateConfiguration()
+void ContactRelationToBodyPart::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
@@ -113,7 +176,7 @@ AdaptiveContactRelation::AdaptiveContactRelation(SPHBody &sph_body, RealBodyVect
     }
 }
 //=================================================================================================//
-void AdaptiveContactRelation::updateConfiguration()
+void AdaptiveContactRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
@@ -125,6 +188,7 @@ void AdaptiveContactRelation::updateConfiguration()
                 *get_multi_level_search_range_[k][l], *get_contact_neighbors_adaptive_[k][l]);
         }
     }
+    updateCompactConfiguration();
 }
 //=================================================================================================//
 ContactRelationFromShellToFluid::ContactRelationFromShellToFluid(SPHBody &sph_body, RealBodyVector contact_bodies,
@@ -144,17 +208,26 @@ ContactRelationFromShellToFluid::ContactRelationFromShellToFluid(SPHBody &sph_bo
     }
 }
 //=================================================================================================//
-void ContactRelationFromShellToFluid::updateConfiguration()
+void ContactRelationFromShellToFluid::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
+        get_shell_contact_neighbors_[k]->refreshCurvatureCache();
         target_cell_linked_lists_[k]->searchNeighborsByParticles(
             sph_body_, contact_configuration_[k],
             *get_search_depths_[k], *get_shell_contact_neighbors_[k]);
     }
 }
 //=================================================================================================//
+void ContactRelationFromShellToFluid::setCurvatureCacheTolerance(Real tolerance)
+{
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        get_shell_contact_neighbors_[k]->setCurvatureCacheTolerance(tolerance);
+    }
+}
+//=================================================================================================//
 ContactRelationFromFluidToShell::ContactRelationFromFluidToShell(SPHBody &sph_body, RealBodyVector contact_bodies,
                                                                  const StdVec<bool> &normal_corrections)
     : ContactRelationCrossResolution(sph_body, contact_bodies)
@@ -172,17 +245,26 @@ ContactRelationFromFluidToShell::ContactRelationFromFluidToShell(SPHBody &sph_bo
     }
 }
 //=================================================================================================//
-void ContactRelationFromFluidToShell::updateConfiguration()
+void ContactRelationFromFluidToShell::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
+        get_contact_neighbors_[k]->refreshCurvatureCache();
         target_cell_linked_lists_[k]->searchNeighborsByParticles(
             sph_body_, contact_configuration_[k],
             *get_search_depths_[k], *get_contact_neighbors_[k]);
     }
 }
 //=================================================================================================//
+void ContactRelationFromFluidToShell::setCurvatureCacheTolerance(Real tolerance)
+{
+    for (size_t k = 0; k != contact_bodies_.size(); ++k)
+    {
+        get_contact_neighbors_[k]->setCurvatureCacheTolerance(tolerance);
+    }
+}
+//=================================================================================================//
 SurfaceContactRelation::SurfaceContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies, StdVec<bool> normal_corrections)
     : ContactRelationCrossResolution(sph_body, std::move(contact_bodies)),
       body_surface_layer_(shape_surface_ptr_keeper_.createPtr<BodySurfaceLayer>(sph_body)),
@@ -231,11 +313,14 @@ void SurfaceContactRelation::resetNeighborhoodCurrentSize()
     }
 }
 //=================================================================================================//
-void SurfaceContactRelation::updateConfiguration()
+void SurfaceContactRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
+    updateContactActivity();
     for (size_t k = 0; k != contact_bodies_.size(); ++k)
     {
+        if (!is_contact_active_[k])
+            continue;
         target_cell_linked_lists_[k]->searchNeighborsByParticles(
             *body_surface_layer_, contact_configuration_[k],
             *get_search_depths_[k], *get_contact_neighbors_[k]);
@@ -33,6 +33,7 @@
 
 #include "base_body_relation.h"
 #include "inner_body_relation.h"
+#include "multi_body_cell_linked_list.h"
 
 namespace SPH
 {
@@ -80,10 +81,18 @@ class ContactRelation : public ContactRelationCrossResolution
   public:
     ContactRelation(SPHBody &sph_body, RealBodyVector contact_bodies);
     virtual ~ContactRelation(){};
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
+    /** search all contact bodies in one traversal of a cell linked list shared by them,
+     *  which is to be updated before this relation */
+    void useSharedCellLinkedList(MultiBodyCellLinkedList &shared_cell_linked_list);
 
   protected:
     StdVec<NeighborBuilderContact *> get_contact_neighbors_;
+    MultiBodyCellLinkedList *shared_cell_linked_list_ = nullptr;
+    StdVec<size_t> shared_contact_index_; /**< contact index of each body in the shared list */
+    int shared_search_depth_ = 1;
+
+    void searchSharedCellLinkedList();
 };
 
 /**
@@ -105,7 +114,7 @@ class ShellSurfaceContactRelation : public ContactRelationCrossResolution
                                 RealBodyVector contact_bodies)
         : ShellSurfaceContactRelation(*solid_body_relation_self_contact.real_body_, contact_bodies){};
     virtual ~ShellSurfaceContactRelation(){};
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 
   protected:
     IndexVector &body_part_particles_;
@@ -129,7 +138,7 @@ class ContactRelationToBodyPart : public ContactRelationCrossResolution
     ContactRelationToBodyPart(SPHBody &sph_body, BodyPartVector contact_body_parts_);
     virtual ~ContactRelationToBodyPart(){};
 
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 };
 
 /**
@@ -151,7 +160,7 @@ class AdaptiveContactRelation : public BaseContactRelation
     AdaptiveContactRelation(SPHBody &body, RealBodyVector contact_bodies);
     virtual ~AdaptiveContactRelation(){};
 
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 };
 
 /**
@@ -166,7 +175,9 @@ class ContactRelationFromShellToFluid : public ContactRelationCrossResolution
   public:
     ContactRelationFromShellToFluid(SPHBody &sph_body, RealBodyVector contact_bodies, const StdVec<bool> &normal_corrections);
     ~ContactRelationFromShellToFluid() override = default;
-    void updateConfiguration() override;
+    void buildConfiguration() override;
+    /** cache the curvature-dependent weights of the shell particles, see BaseNeighborBuilderContactShell */
+    void setCurvatureCacheTolerance(Real tolerance);
 
   private:
     StdVec<NeighborBuilderContactFromShellToFluid *> get_shell_contact_neighbors_;
@@ -184,7 +195,9 @@ class ContactRelationFromFluidToShell : public ContactRelationCrossResolution
   public:
     ContactRelationFromFluidToShell(SPHBody &sph_body, RealBodyVector contact_bodies, const StdVec<bool> &normal_corrections);
     ~ContactRelationFromFluidToShell() override = default;
-    void updateConfiguration() override;
+    void buildConfiguration() override;
+    /** cache the curvature-dependent weights of the shell particles, see BaseNeighborBuilderContactShell */
+    void setCurvatureCacheTolerance(Real tolerance);
 
   private:
     StdVec<NeighborBuilderContactFromFluidToShell *> get_contact_neighbors_;
@@ -213,7 +226,7 @@ class SurfaceContactRelation : public ContactRelationCrossResolution
                                  std::move(contact_bodies),
                                  std::move(normal_corrections)){};
     ~SurfaceContactRelation() override = default;
-    void updateConfiguration() override;
+    void buildConfiguration() override;
     BodySurfaceLayer *get_body_surface_layer() { return body_surface_layer_; }
 
   private:
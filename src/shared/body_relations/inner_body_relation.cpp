@@ -2,6 +2,7 @@
 #include "base_particle_dynamics.h"
 #include "base_particles.hpp"
 #include "cell_linked_list.hpp"
+#include "particle_functors.h"
 
 #include "tree_body.h"
 namespace SPH
@@ -11,12 +12,13 @@ InnerRelation::InnerRelation(RealBody &real_body)
     : BaseInnerRelation(real_body), get_inner_neighbor_(real_body),
       cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())) {}
 //=================================================================================================//
-void InnerRelation::updateConfiguration()
+void InnerRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
         sph_body_, inner_configuration_,
         get_single_search_depth_, get_inner_neighbor_);
+    updateCompactConfiguration();
 }
 //=================================================================================================//
 AdaptiveInnerRelation::
@@ -30,21 +32,22 @@ AdaptiveInnerRelation::
     total_levels_ = cell_linked_list_levels_.size();
     for (size_t l = 0; l != total_levels_; ++l)
     {
-        get_multi_level_search_depth_.push_back(
-            adaptive_search_depth_ptr_vector_keeper_
-                .createPtr<SearchDepthAdaptive>(real_body, cell_linked_list_levels_[l]));
+        get_multi_level_search_radius_.push_back(
+            adaptive_search_radius_ptr_vector_keeper_
+                .createPtr<SearchRadiusAdaptive>(real_body, cell_linked_list_levels_[l]));
     }
 }
 //=================================================================================================//
-void AdaptiveInnerRelation::updateConfiguration()
+void AdaptiveInnerRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     for (size_t l = 0; l != total_levels_; ++l)
     {
-        cell_linked_list_levels_[l]->searchNeighborsByParticles(
+        cell_linked_list_levels_[l]->searchNeighborsWithinRadius(
             sph_body_, inner_configuration_,
-            *get_multi_level_search_depth_[l], get_adaptive_inner_neighbor_);
+            *get_multi_level_search_radius_[l], get_adaptive_inner_neighbor_);
     }
+    updateCompactConfiguration();
 }
 //=================================================================================================//
 SelfSurfaceContactRelation::
@@ -64,7 +67,7 @@ void SelfSurfaceContactRelation::resetNeighborhoodCurrentSize()
                  });
 }
 //=================================================================================================//
-void SelfSurfaceContactRelation::updateConfiguration()
+void SelfSurfaceContactRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
@@ -72,11 +75,130 @@ void SelfSurfaceContactRelation::updateConfiguration()
         get_single_search_depth_, get_self_contact_neighbor_);
 }
 //=================================================================================================//
+IncrementalSelfSurfaceContactRelation::
+    IncrementalSelfSurfaceContactRelation(RealBody &real_body, Real skin_ratio)
+    : SelfSurfaceContactRelation(real_body),
+      cutoff_radius_(real_body.sph_adaptation_->getKernel()->CutOffRadius()),
+      skin_(skin_ratio * cutoff_radius_),
+      pos_(base_particles_.ParticlePositions()),
+      pos0_(base_particles_.registerStateVariableFrom<Vecd>("InitialPosition", "Position")),
+      get_contact_neighbor_(real_body, real_body), number_of_rebuilds_(0) {}
+//=================================================================================================//
+bool IncrementalSelfSurfaceContactRelation::isRebuildRequired()
+{
+    if (pos_at_rebuild_.size() != body_part_particles_.size())
+        return true;
+
+    Real max_displacement_squared =
+        particle_reduce(execution::ParallelPolicy(), IndexRange(0, body_part_particles_.size()),
+                        Real(0), ReduceMax(),
+                        [&](size_t l) -> Real
+                        { return (pos_[body_part_particles_[l]] - pos_at_rebuild_[l]).squaredNorm(); });
+    return 4.0 * max_displacement_squared > skin_ * skin_;
+}
+//=================================================================================================//
+void IncrementalSelfSurfaceContactRelation::rebuildCandidates()
+{
+    size_t total_surface_particles = body_part_particles_.size();
+    IndexRange surface_range(0, total_surface_particles);
+    BoundingBox bounds(
+        particle_reduce(execution::ParallelPolicy(), surface_range, Vecd(MaxReal * Vecd::Ones()), ReduceLowerBound(),
+                        [&](size_t l) -> Vecd
+                        { return pos_[body_part_particles_[l]]; }),
+        particle_reduce(execution::ParallelPolicy(), surface_range, Vecd(-MaxReal * Vecd::Ones()), ReduceUpperBound(),
+                        [&](size_t l) -> Vecd
+                        { return pos_[body_part_particles_[l]]; }));
+    Real candidate_radius = cutoff_radius_ + skin_;
+    Mesh mesh(bounds, candidate_radius, 1);
+    Arrayi all_cells = mesh.AllCells();
+
+    // compact cell list of the surface particles by counting sort
+    pos_at_rebuild_.resize(total_surface_particles);
+    StdVec<size_t> cell_of_particle(total_surface_particles);
+    StdVec<size_t> cell_offsets(mesh.NumberOfCells() + 1, 0);
+    for (size_t l = 0; l != total_surface_particles; ++l)
+    {
+        pos_at_rebuild_[l] = pos_[body_part_particles_[l]];
+        cell_of_particle[l] = mesh.LinearCellIndexFromPosition(pos_at_rebuild_[l]);
+        cell_offsets[cell_of_particle[l] + 1]++;
+    }
+    for (size_t c = 0; c != mesh.NumberOfCells(); ++c)
+        cell_offsets[c + 1] += cell_offsets[c];
+    StdVec<size_t> cell_fill(cell_offsets.begin(), cell_offsets.end() - 1);
+    StdVec<size_t> cell_particles(total_surface_particles);
+    for (size_t l = 0; l != total_surface_particles; ++l)
+        cell_particles[cell_fill[cell_of_particle[l]]++] = l;
+
+    Real candidate_radius_squared = candidate_radius * candidate_radius;
+    Real cutoff_radius_squared = cutoff_radius_ * cutoff_radius_;
+    auto for_each_candidate = [&](size_t l, const auto &function)
+    {
+        size_t index_i = body_part_particles_[l];
+        Arrayi cell_index = mesh.CellIndexFromPosition(pos_at_rebuild_[l]);
+        mesh_for_each(
+            Arrayi::Zero().max(cell_index - Arrayi::Ones()),
+            all_cells.min(cell_index + 2 * Arrayi::Ones()),
+            [&](const Arrayi &neighbor_cell_index)
+            {
+                size_t c = mesh.LinearCellIndexFromCellIndex(neighbor_cell_index);
+                for (size_t k = cell_offsets[c]; k != cell_offsets[c + 1]; ++k)
+                {
+                    size_t m = cell_particles[k];
+                    size_t index_j = body_part_particles_[m];
+                    // the neighbors in the initial configuration are excluded once here
+                    if ((pos_at_rebuild_[l] - pos_at_rebuild_[m]).squaredNorm() < candidate_radius_squared &&
+                        (pos0_[index_i] - pos0_[index_j]).squaredNorm() > cutoff_radius_squared)
+                        function(index_j);
+                }
+            });
+    };
+
+    candidate_offsets_.assign(total_surface_particles + 1, 0);
+    particle_for(execution::ParallelPolicy(), surface_range,
+                 [&](size_t l)
+                 {
+                     size_t count = 0;
+                     for_each_candidate(l, [&](size_t index_j)
+                                        { ++count; });
+                     candidate_offsets_[l + 1] = count;
+                 });
+    for (size_t l = 0; l != total_surface_particles; ++l)
+        candidate_offsets_[l + 1] += candidate_offsets_[l];
+    candidates_.resize(candidate_offsets_[total_surface_particles]);
+    particle_for(execution::ParallelPolicy(), surface_range,
+                 [&](size_t l)
+                 {
+                     size_t position = candidate_offsets_[l];
+                     for_each_candidate(l, [&](size_t index_j)
+                                        { candidates_[position++] = index_j; });
+                 });
+    number_of_rebuilds_++;
+}
+//=================================================================================================//
+void IncrementalSelfSurfaceContactRelation::buildConfiguration()
+{
+    if (isRebuildRequired())
+        rebuildCandidates();
+
+    resetNeighborhoodCurrentSize();
+    particle_for(execution::ParallelPolicy(), IndexRange(0, body_part_particles_.size()),
+                 [&](size_t l)
+                 {
+                     size_t index_i = body_part_particles_[l];
+                     Neighborhood &neighborhood = inner_configuration_[index_i];
+                     for (size_t k = candidate_offsets_[l]; k != candidate_offsets_[l + 1]; ++k)
+                     {
+                         size_t index_j = candidates_[k];
+                         get_contact_neighbor_(neighborhood, pos_[index_i], index_i, ListData(index_j, pos_[index_j]));
+                     }
+                 });
+}
+//=================================================================================================//
 TreeInnerRelation::TreeInnerRelation(RealBody &real_body)
     : InnerRelation(real_body),
       generative_tree_(DynamicCast<TreeBody>(this, real_body)) {}
 //=================================================================================================//
-void TreeInnerRelation::updateConfiguration()
+void TreeInnerRelation::buildConfiguration()
 {
     generative_tree_.buildParticleConfiguration(inner_configuration_);
 }
@@ -87,7 +209,7 @@ ShellInnerRelationWithContactKernel::ShellInnerRelationWithContactKernel(RealBod
       get_contact_search_depth_(contact_body, &cell_linked_list_),
       get_inner_neighbor_with_contact_kernel_(real_body, contact_body) {}
 //=================================================================================================//
-void ShellInnerRelationWithContactKernel::updateConfiguration()
+void ShellInnerRelationWithContactKernel::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     cell_linked_list_.searchNeighborsByParticles(
@@ -101,7 +223,7 @@ ShellSelfContactRelation::
       get_shell_self_contact_neighbor_(real_body),
       cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())) {}
 //=================================================================================================//
-void ShellSelfContactRelation::updateConfiguration()
+void ShellSelfContactRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
 
@@ -110,14 +232,14 @@ void ShellSelfContactRelation::updateConfiguration()
         get_single_search_depth_, get_shell_self_contact_neighbor_);
 }
 //=================================================================================================//
-void AdaptiveSplittingInnerRelation::updateConfiguration()
+void AdaptiveSplittingInnerRelation::buildConfiguration()
 {
     resetNeighborhoodCurrentSize();
     for (size_t l = 0; l != total_levels_; ++l)
     {
-        cell_linked_list_levels_[l]->searchNeighborsByParticles(
+        cell_linked_list_levels_[l]->searchNeighborsWithinRadius(
             sph_body_, inner_configuration_,
-            *get_multi_level_search_depth_[l], get_adaptive_splitting_inner_neighbor_);
+            *get_multi_level_search_radius_[l], get_adaptive_splitting_inner_neighbor_);
     }
 }
 //=================================================================================================//
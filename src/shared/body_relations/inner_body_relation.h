@@ -49,7 +49,7 @@ class InnerRelation : public BaseInnerRelation
     virtual ~InnerRelation(){};
 
     CellLinkedList &getCellLinkedList() { return cell_linked_list_; };
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 };
 
 /**
@@ -59,11 +59,11 @@ class InnerRelation : public BaseInnerRelation
 class AdaptiveInnerRelation : public BaseInnerRelation
 {
   private:
-    UniquePtrsKeeper<SearchDepthAdaptive> adaptive_search_depth_ptr_vector_keeper_;
+    UniquePtrsKeeper<SearchRadiusAdaptive> adaptive_search_radius_ptr_vector_keeper_;
 
   protected:
     size_t total_levels_;
-    StdVec<SearchDepthAdaptive *> get_multi_level_search_depth_;
+    StdVec<SearchRadiusAdaptive *> get_multi_level_search_radius_;
     NeighborBuilderInnerAdaptive get_adaptive_inner_neighbor_;
     StdVec<CellLinkedList *> cell_linked_list_levels_;
 
@@ -71,7 +71,7 @@ class AdaptiveInnerRelation : public BaseInnerRelation
     explicit AdaptiveInnerRelation(RealBody &real_body);
     virtual ~AdaptiveInnerRelation(){};
 
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 };
 
 /**
@@ -85,7 +85,7 @@ class SelfSurfaceContactRelation : public BaseInnerRelation
 
     explicit SelfSurfaceContactRelation(RealBody &real_body);
     virtual ~SelfSurfaceContactRelation(){};
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 
   protected:
     IndexVector &body_part_particles_;
@@ -96,6 +96,35 @@ class SelfSurfaceContactRelation : public BaseInnerRelation
     virtual void resetNeighborhoodCurrentSize() override;
 };
 
+/**
+ * @class IncrementalSelfSurfaceContactRelation
+ * @brief The relation for self contact with candidate pairs among the surface particles only.
+ * The candidates within the cut-off radius plus a skin, excluding the neighbors in the initial configuration,
+ * are found from a compact cell list of the surface particles. They are rebuilt only when the maximum
+ * displacement since the last rebuild exceeds half of the skin, otherwise the neighbors are filtered
+ * directly from the candidates.
+ */
+class IncrementalSelfSurfaceContactRelation : public SelfSurfaceContactRelation
+{
+  public:
+    explicit IncrementalSelfSurfaceContactRelation(RealBody &real_body, Real skin_ratio = 0.5);
+    virtual ~IncrementalSelfSurfaceContactRelation(){};
+    virtual void buildConfiguration() override;
+    size_t NumberOfRebuilds() { return number_of_rebuilds_; };
+
+  protected:
+    Real cutoff_radius_, skin_;
+    Vecd *pos_, *pos0_;
+    NeighborBuilderContact get_contact_neighbor_;
+    size_t number_of_rebuilds_;
+    StdVec<Vecd> pos_at_rebuild_;
+    StdVec<size_t> candidate_offsets_;
+    IndexVector candidates_;
+
+    bool isRebuildRequired();
+    void rebuildCandidates();
+};
+
 class TreeBody;
 /**
  * @class TreeInnerRelation
@@ -110,7 +139,7 @@ class TreeInnerRelation : public InnerRelation
     explicit TreeInnerRelation(RealBody &real_body);
     virtual ~TreeInnerRelation(){};
 
-    virtual void updateConfiguration() override;
+    virtual void buildConfiguration() override;
 };
 
 /**
@@ -127,7 +156,7 @@ class ShellInnerRelationWithContactKernel : public BaseInnerRelation
 
   public:
     explicit ShellInnerRelationWithContactKernel(RealBody &real_body, RealBody &contact_body);
-    void updateConfiguration() override;
+    void buildConfiguration() override;
 };
 
 /**
@@ -138,7 +167,7 @@ class ShellSelfContactRelation : public BaseInnerRelation
 {
   public:
     explicit ShellSelfContactRelation(RealBody &real_body);
-    void updateConfiguration() override;
+    void buildConfiguration() override;
 
   private:
     SearchDepthSingleResolution get_single_search_depth_;
@@ -157,7 +186,7 @@ class AdaptiveSplittingInnerRelation : public AdaptiveInnerRelation
     explicit AdaptiveSplittingInnerRelation(RealBody &real_body)
         : AdaptiveInnerRelation(real_body),
           get_adaptive_splitting_inner_neighbor_(real_body){};
-    void updateConfiguration() override;
+    void buildConfiguration() override;
 
   private:
     NeighborBuilderSplitInnerAdaptive get_adaptive_splitting_inner_neighbor_;
@@ -0,0 +1,104 @@
+#include "multi_body_cell_linked_list.h"
+
+#include "adaptation.h"
+#include "base_configuration_dynamics.h"
+#include "base_kernel.h"
+#include "base_particles.hpp"
+#include "particle_functors.h"
+#include "particle_iterators.h"
+
+namespace SPH
+{
+//=================================================================================================//
+MultiBodyCellLinkedList::MultiBodyCellLinkedList(RealBodyVector bodies)
+    : Mesh(bodies[0]->getSPHSystemBounds(), largestCutOffRadius(bodies), 2),
+      bodies_(bodies), body_offsets_(bodies.size() + 1, 0),
+      cell_size_list_(NumberOfCells() + 1, 0), cell_offset_list_(NumberOfCells() + 1, 0) {}
+//=================================================================================================//
+Real MultiBodyCellLinkedList::largestCutOffRadius(RealBodyVector &bodies)
+{
+    if (bodies.empty())
+    {
+        std::cout << "\n Error: no body is given for the shared cell linked list!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    Real cutoff_radius = 0.0;
+    for (size_t k = 0; k != bodies.size(); ++k)
+        cutoff_radius = SMAX(cutoff_radius, bodies[k]->sph_adaptation_->getKernel()->CutOffRadius());
+    return cutoff_radius;
+}
+//=================================================================================================//
+size_t MultiBodyCellLinkedList::BodyIndex(SPHBody &body)
+{
+    for (size_t k = 0; k != bodies_.size(); ++k)
+    {
+        if (bodies_[k] == &body)
+            return k;
+    }
+    return MaxSize_t;
+}
+//=================================================================================================//
+void MultiBodyCellLinkedList::UpdateCellLists()
+{
+    for (size_t k = 0; k != bodies_.size(); ++k)
+        body_offsets_[k + 1] = body_offsets_[k] + bodies_[k]->getBaseParticles().TotalRealParticles();
+    if (body_list_data_.size() < body_offsets_.back())
+        body_list_data_.resize(body_offsets_.back());
+
+    const size_t number_of_cells = NumberOfCells();
+    UnsignedInt *cell_size = cell_size_list_.data();
+    UnsignedInt *cell_offset = cell_offset_list_.data();
+    BodyListData *body_list_data = body_list_data_.data();
+
+    particle_for(execution::ParallelPolicy(), IndexRange(0, number_of_cells + 1),
+                 [=](size_t i)
+                 { cell_size[i] = 0; });
+    for (size_t k = 0; k != bodies_.size(); ++k)
+    {
+        BaseParticles &particles = bodies_[k]->getBaseParticles();
+        Vecd *pos = particles.ParticlePositions();
+        particle_for(execution::ParallelPolicy(), IndexRange(0, particles.TotalRealParticles()),
+                     [&](size_t i)
+                     {
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_cell_size(cell_size[LinearCellIndexFromPosition(pos[i])]);
+                         ++atomic_cell_size;
+                     });
+    }
+    exclusive_scan(execution::ParallelPolicy(), cell_size, cell_offset,
+                   number_of_cells + 1, std::plus<UnsignedInt>());
+
+    particle_for(execution::ParallelPolicy(), IndexRange(0, number_of_cells),
+                 [=](size_t i)
+                 { cell_size[i] = 0; });
+    for (size_t k = 0; k != bodies_.size(); ++k)
+    {
+        BaseParticles &particles = bodies_[k]->getBaseParticles();
+        Vecd *pos = particles.ParticlePositions();
+        particle_for(execution::ParallelPolicy(), IndexRange(0, particles.TotalRealParticles()),
+                     [&](size_t i)
+                     {
+                         const size_t linear_index = LinearCellIndexFromPosition(pos[i]);
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_cell_size(cell_size[linear_index]);
+                         body_list_data[cell_offset[linear_index] + atomic_cell_size++] =
+                             BodyListData{UnsignedInt(k), ListData(i, pos[i])};
+                     });
+    }
+
+    // sorting within cells keeps the entry order independent of thread scheduling
+    particle_for(execution::ParallelPolicy(), IndexRange(0, number_of_cells),
+                 [=](size_t i)
+                 {
+                     std::sort(body_list_data + cell_offset[i], body_list_data + cell_offset[i + 1],
+                               [](const BodyListData &a, const BodyListData &b)
+                               {
+                                   return a.body_index_ < b.body_index_ ||
+                                          (a.body_index_ == b.body_index_ && a.list_data_.first < b.list_data_.first);
+                               });
+                 });
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,96 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	multi_body_cell_linked_list.h
+ * @brief 	A cell linked list shared by a group of bodies.
+ * @details The real particles of all bodies in the group are listed, tagged with their body index,
+ * 			in one mesh with the largest cut-off radius of the bodies as grid spacing.
+ * 			A contact relation using the shared list finds the neighbors from all its contact bodies
+ * 			in one traversal of the cells around a particle, instead of one search for each contact body.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef MULTI_BODY_CELL_LINKED_LIST_H
+#define MULTI_BODY_CELL_LINKED_LIST_H
+
+#include "base_body.h"
+#include "base_mesh.h"
+#include "mesh_iterators.hpp"
+
+namespace SPH
+{
+/**
+ * @class MultiBodyCellLinkedList
+ * @brief Flat cell lists of the real particles of a group of bodies built by a counting sort.
+ * The list data are kept with the body index so that the neighbor search
+ * dispatches each entry to the configuration of its contact body.
+ * Periodic images and extra list data entries are not included.
+ * The update should be executed after the particles of the bodies are moved
+ * and before the contact configurations using the list are updated.
+ */
+class MultiBodyCellLinkedList : public Mesh
+{
+  public:
+    /** list data of a particle with the index of its body in the group */
+    struct BodyListData
+    {
+        UnsignedInt body_index_;
+        ListData list_data_;
+    };
+
+    explicit MultiBodyCellLinkedList(RealBodyVector bodies);
+    virtual ~MultiBodyCellLinkedList(){};
+
+    void UpdateCellLists();
+    RealBodyVector getBodies() { return bodies_; };
+    /** the index of the body in the group, or MaxSize_t if not included */
+    size_t BodyIndex(SPHBody &body);
+    /** the search depth for a search radius on the shared mesh */
+    int SearchDepth(Real search_radius) { return 1 + (int)floor(search_radius / grid_spacing_); };
+    /** apply a function to the entries listed in the cells within the search depth around a position */
+    template <typename FunctionOnEach>
+    void forEachBodyListDataInRange(const Vecd &position, int search_depth, const FunctionOnEach &function) const
+    {
+        Arrayi target_cell_index = CellIndexFromPosition(position);
+        mesh_for_each(
+            Arrayi::Zero().max(target_cell_index - search_depth * Arrayi::Ones()),
+            all_cells_.min(target_cell_index + (search_depth + 1) * Arrayi::Ones()),
+            [&](const Arrayi &cell_index)
+            {
+                const size_t linear_index = LinearCellIndexFromCellIndex(cell_index);
+                for (UnsignedInt n = cell_offset_list_[linear_index]; n < cell_offset_list_[linear_index + 1]; ++n)
+                    function(body_list_data_[n]);
+            });
+    };
+
+  protected:
+    RealBodyVector bodies_;
+    StdVec<UnsignedInt> body_offsets_;              /**< number of bodies plus one offsets of the entries */
+    StdLargeVec<UnsignedInt> cell_size_list_;       /**< scratch counter for each cell */
+    StdLargeVec<UnsignedInt> cell_offset_list_;     /**< number of cells plus one offsets */
+    StdLargeVec<BodyListData> body_list_data_;      /**< list data sorted by cell */
+
+    static Real largestCutOffRadius(RealBodyVector &bodies);
+};
+} // namespace SPH
+#endif // MULTI_BODY_CELL_LINKED_LIST_H
@@ -33,6 +33,7 @@
 #include "data_type.h"
 #include "large_data_containers.h"
 #include "ownership.h"
+#include "thread_arena.h"
 #include "vector_functions.h"
 
 #define TBB_PARALLEL true
@@ -61,6 +61,29 @@ using Real = double;
 using UnsignedInt = size_t;
 #endif // SPHINXSYS_USE_FLOAT
 
+/** Floating point type for accumulating Real values, e.g. in reductions and time integration.
+ * It is double in the mixed-precision build in which Real is float. */
+#if SPHINXSYS_USE_MIXED_PRECISION
+using AccumulatedReal = double;
+#else
+using AccumulatedReal = Real;
+#endif // SPHINXSYS_USE_MIXED_PRECISION
+
+template <typename DataType>
+struct AccumulatedData
+{
+    using type = DataType;
+};
+
+template <>
+struct AccumulatedData<Real>
+{
+    using type = AccumulatedReal;
+};
+
+template <typename DataType>
+using AccumulatedType = typename AccumulatedData<DataType>::type;
+
 /** Vector with integers. */
 using Array2i = Eigen::Array<int, 2, 1>;
 using Array3i = Eigen::Array<int, 3, 1>;
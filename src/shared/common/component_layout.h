@@ -0,0 +1,265 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	component_layout.h
+ * @brief 	Component-blocked layouts of particle data, i.e. structure of arrays (SoA)
+ *          and array of structures of arrays (AoSoA), for vector and matrix variables.
+ * @details A discrete variable stores its data as an array of fixed-size Eigen objects,
+ *          with which a loop over one component cannot be vectorized across particles.
+ *          In the SoA layout, each component of all particles is contiguous.
+ *          In the AoSoA layout, the particles are grouped in blocks, e.g. of 8 or 16,
+ *          in which each component is contiguous, so that a block fits a few SIMD registers
+ *          while all components of a particle are still close in memory.
+ *          Element-wise code uses the proxy returned by operator[] as a value of the data type,
+ *          while block-wise code loops over the lanes of a block with a compile-time length,
+ *          which is vectorized by the compiler.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef COMPONENT_LAYOUT_H
+#define COMPONENT_LAYOUT_H
+
+#include "base_data_type.h"
+#include "execution_policy.h"
+#include "scalar_functions.h"
+#include "thread_arena.h"
+
+#include <new>
+
+namespace SPH
+{
+/** The real components of a data type, in the column-major order of Eigen. */
+template <typename DataType>
+struct DataComponents
+{
+    static_assert(std::is_same_v<typename DataType::Scalar, Real>, "Only real components are supported!");
+    static constexpr int number = DataType::SizeAtCompileTime;
+    static Real get(const DataType &value, int k) { return value.data()[k]; };
+    static void set(DataType &value, int k, Real component) { value.data()[k] = component; };
+};
+
+template <>
+struct DataComponents<Real>
+{
+    static constexpr int number = 1;
+    static Real get(const Real &value, int k) { return value; };
+    static void set(Real &value, int k, Real component) { value = component; };
+};
+
+/**
+ * @class ComponentBlockedField
+ * @brief The data of a particle-indexed field with each component contiguous within a block of particles.
+ *        A block size of zero gives the SoA layout, i.e. a single block of all particles.
+ *        The size is padded to full blocks and the lanes of each component are 64-byte aligned
+ *        when a block has 64 bytes or more.
+ */
+template <typename DataType, UnsignedInt BlockSize>
+class ComponentBlockedField
+{
+  public:
+    static constexpr int components = DataComponents<DataType>::number;
+    static constexpr size_t alignment = 64;
+    static constexpr bool is_soa = BlockSize == 0;
+
+    /** the proxy of a particle element, used as a value of the data type */
+    class ElementReference
+    {
+        ComponentBlockedField &field_;
+        size_t index_;
+
+      public:
+        ElementReference(ComponentBlockedField &field, size_t index) : field_(field), index_(index){};
+        operator DataType() const { return field_.get(index_); };
+        DataType operator()() const { return field_.get(index_); };
+        ElementReference &operator=(const DataType &value)
+        {
+            field_.set(index_, value);
+            return *this;
+        };
+        ElementReference &operator=(const ElementReference &other) { return *this = DataType(other); };
+        ElementReference &operator+=(const DataType &value) { return *this = field_.get(index_) + value; };
+        ElementReference &operator-=(const DataType &value) { return *this = field_.get(index_) - value; };
+    };
+
+    explicit ComponentBlockedField(size_t data_size) : data_size_(0), lanes_(0), blocks_(0), data_(nullptr)
+    {
+        allocate(data_size);
+    };
+    ComponentBlockedField(const ComponentBlockedField &) = delete;
+    ComponentBlockedField &operator=(const ComponentBlockedField &) = delete;
+    ~ComponentBlockedField() { deallocate(); };
+
+    size_t Size() const { return data_size_; };
+    /** the number of particles in a block, with padding */
+    size_t LaneNumber() const { return lanes_; };
+    size_t BlockNumber() const { return blocks_; };
+    size_t offset(size_t index, int k) const
+    {
+        return (index / lanes_ * components + k) * lanes_ + index % lanes_;
+    };
+    /** the contiguous lanes of component k in a block */
+    Real *Lanes(size_t block, int k) { return data_ + (block * components + k) * lanes_; };
+    const Real *Lanes(size_t block, int k) const { return data_ + (block * components + k) * lanes_; };
+
+    DataType get(size_t index) const
+    {
+        DataType value = ZeroData<DataType>::value;
+        for (int k = 0; k != components; ++k)
+            DataComponents<DataType>::set(value, k, data_[offset(index, k)]);
+        return value;
+    };
+    void set(size_t index, const DataType &value)
+    {
+        for (int k = 0; k != components; ++k)
+            data_[offset(index, k)] = DataComponents<DataType>::get(value, k);
+    };
+    ElementReference operator[](size_t index) { return ElementReference(*this, index); };
+    DataType operator[](size_t index) const { return get(index); };
+
+    /** the data are not kept when the size changes */
+    void resize(size_t data_size)
+    {
+        if (data_size != data_size_)
+        {
+            deallocate();
+            allocate(data_size);
+        }
+    };
+
+    /** applies the function to each block, in parallel for the parallel policies */
+    template <class ExecutionPolicy, class BlockFunction>
+    void block_for(const ExecutionPolicy &ex_policy, const BlockFunction &block_function) const
+    {
+        if constexpr (std::is_same_v<ExecutionPolicy, execution::SequencedPolicy> ||
+                      std::is_same_v<ExecutionPolicy, execution::UnsequencedPolicy> || is_soa)
+        {
+            for (size_t b = 0; b != blocks_; ++b)
+                block_function(b);
+        }
+        else
+        {
+            arena_parallel_for(
+                IndexRange(0, blocks_),
+                [&](const IndexRange &r)
+                {
+                    for (size_t b = r.begin(); b != r.end(); ++b)
+                        block_function(b);
+                });
+        }
+    };
+
+    /** copies from array-of-structures data, e.g. the data field of a discrete variable */
+    template <class ExecutionPolicy>
+    void gather(const ExecutionPolicy &ex_policy, const DataType *data, size_t data_size)
+    {
+        resize(data_size);
+        particleRangeFor(ex_policy, [&](size_t i)
+                         { set(i, data[i]); });
+    };
+
+    /** copies back to array-of-structures data */
+    template <class ExecutionPolicy>
+    void scatter(const ExecutionPolicy &ex_policy, DataType *data) const
+    {
+        particleRangeFor(ex_policy, [&](size_t i)
+                         { data[i] = get(i); });
+    };
+
+    /** the explicit SIMD path of this += factor * other, including the padding lanes */
+    template <class ExecutionPolicy>
+    void addScaled(const ExecutionPolicy &ex_policy, const ComponentBlockedField &other, Real factor)
+    {
+        block_for(ex_policy, [&](size_t b)
+                  {
+                      for (int k = 0; k != components; ++k)
+                      {
+                          Real *lanes = Lanes(b, k);
+                          const Real *other_lanes = other.Lanes(b, k);
+                          for (size_t l = 0; l != LaneLength(); ++l)
+                              lanes[l] += factor * other_lanes[l];
+                      }
+                  });
+    };
+
+  protected:
+    size_t data_size_;
+    size_t lanes_;
+    size_t blocks_;
+    Real *data_;
+
+    /** a compile-time constant for the AoSoA layout, with which the lane loops are vectorized */
+    size_t LaneLength() const
+    {
+        if constexpr (is_soa)
+            return lanes_;
+        else
+            return BlockSize;
+    };
+
+    void allocate(size_t data_size)
+    {
+        constexpr size_t soa_padding = alignment / sizeof(Real);
+        data_size_ = data_size;
+        lanes_ = is_soa ? SMAX(size_t(1), (data_size + soa_padding - 1) / soa_padding) * soa_padding
+                        : size_t(BlockSize);
+        blocks_ = is_soa ? 1 : (data_size + lanes_ - 1) / lanes_;
+        size_t total = SMAX(size_t(1), blocks_ * lanes_ * components);
+        data_ = static_cast<Real *>(::operator new[](total * sizeof(Real), std::align_val_t(alignment)));
+        for (size_t n = 0; n != total; ++n)
+            data_[n] = Real(0);
+    };
+
+    void deallocate()
+    {
+        ::operator delete[](data_, std::align_val_t(alignment));
+        data_ = nullptr;
+    };
+
+    template <class ExecutionPolicy, class ParticleFunction>
+    void particleRangeFor(const ExecutionPolicy &ex_policy, const ParticleFunction &particle_function) const
+    {
+        if constexpr (std::is_same_v<ExecutionPolicy, execution::SequencedPolicy> ||
+                      std::is_same_v<ExecutionPolicy, execution::UnsequencedPolicy>)
+        {
+            for (size_t i = 0; i != data_size_; ++i)
+                particle_function(i);
+        }
+        else
+        {
+            arena_parallel_for(
+                IndexRange(0, data_size_),
+                [&](const IndexRange &r)
+                {
+                    for (size_t i = r.begin(); i != r.end(); ++i)
+                        particle_function(i);
+                });
+        }
+    };
+};
+
+template <typename DataType>
+using StructureOfArrays = ComponentBlockedField<DataType, 0>;
+template <typename DataType, UnsignedInt BlockSize = 8>
+using ArrayOfStructuresOfArrays = ComponentBlockedField<DataType, BlockSize>;
+} // namespace SPH
+#endif // COMPONENT_LAYOUT_H
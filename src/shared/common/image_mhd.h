@@ -150,7 +150,13 @@ class ImageMHD
     Real min_value_;
     Real max_value_;
     T *data_;
+    void *mapped_address_; /**< the memory-mapped raw file, nullptr if the data is allocated */
+    size_t mapped_size_;
 
+    /** map the raw file or read it into allocated memory if mapping is not available */
+    void loadRawData(const std::string &file_path_to_raw_file);
+    /** find the value range slab by slab, so that a mapped file is not resident as a whole */
+    void findValueRange();
     std::vector<int> findNeighbors(const Vec3d &probe_point, Array3i &this_cell);
     Vec3d computeGradientAtCell(int i);
     Vec3d computeNormalAtCell(int i);
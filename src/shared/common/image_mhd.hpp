@@ -12,6 +12,16 @@
 #include "boost/algorithm/string.hpp"
 #include "image_mhd.h"
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifndef SPHINXSYS_HAS_MMAP
+#define SPHINXSYS_HAS_MMAP 1
+#endif
+#endif
+
 namespace SPH
 {
 
@@ -36,7 +46,9 @@ ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file)
       elementDataFile_(""),
       min_value_(MaxReal),
       max_value_(MinReal),
-      data_(nullptr)
+      data_(nullptr),
+      mapped_address_(nullptr),
+      mapped_size_(0)
 {
     //- read mhd file
     std::ifstream dataFile(full_path_to_file, std::ifstream::in);
@@ -95,8 +107,6 @@ ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file)
                     height_ = dimSize_[1];
                     depth_ = dimSize_[2];
                     size_ = width_ * height_ * depth_;
-                    if (data_ == nullptr)
-                        data_ = new T[dimSize_[0] * dimSize_[1] * dimSize_[2]];
                 }
                 else if (elements[0].compare("ElementDataFile") == 0)
                 {
@@ -113,25 +123,9 @@ ImageMHD<T, nDims>::ImageMHD(std::string full_path_to_file)
     std::cout << "offset: " << offset_ << std::endl;
     std::cout << "transformMatrix: " << transformMatrix_ << std::endl;
 
-    //- read raw file
-    std::ifstream dataFileRaw(file_path_to_raw_file, std::ios::in | std::ios::binary);
-
-    if (dataFileRaw.is_open())
-    {
-        dataFileRaw.read((char *)data_, sizeof(T) * size_);
-        T distance = 0;
-        for (int index = 0; index < size_; index++)
-        {
-            distance = data_[index];
-            data_[index] = distance;
-            // std::cout <<index <<" "<< distance << '\n';
-            if (distance < min_value_)
-                min_value_ = distance;
-            if (distance > max_value_)
-                max_value_ = distance;
-        }
-    }
-    dataFileRaw.close();
+    //- the raw file is mapped so that only the slabs probed are loaded
+    loadRawData(file_path_to_raw_file);
+    findValueRange();
 
     // write(std::string("sphere-binary"),ASCII);
 }
@@ -156,7 +150,9 @@ ImageMHD<T, nDims>::ImageMHD(Real radius, Array3i NxNyNz, Vec3d spacings)
       elementDataFile_(""),
       min_value_(MaxReal),
       max_value_(MinReal),
-      data_(nullptr)
+      data_(nullptr),
+      mapped_address_(nullptr),
+      mapped_size_(0)
 {
     if (data_ == nullptr)
         data_ = new float[size_];
@@ -185,12 +181,84 @@ ImageMHD<T, nDims>::ImageMHD(Real radius, Array3i NxNyNz, Vec3d spacings)
 template <typename T, int nDims>
 ImageMHD<T, nDims>::~ImageMHD()
 {
+#ifdef SPHINXSYS_HAS_MMAP
+    if (mapped_address_ != nullptr)
+    {
+        munmap(mapped_address_, mapped_size_);
+        mapped_address_ = nullptr;
+        data_ = nullptr;
+    }
+#endif
     if (data_)
     {
-        delete data_;
+        delete[] data_;
         data_ = nullptr;
     }
 }
+//=================================================================================================//
+template <typename T, int nDims>
+void ImageMHD<T, nDims>::loadRawData(const std::string &file_path_to_raw_file)
+{
+    size_t data_size = sizeof(T) * size_t(size_);
+#ifdef SPHINXSYS_HAS_MMAP
+    int file_descriptor = open(file_path_to_raw_file.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor >= 0 && fstat(file_descriptor, &file_status) == 0 &&
+        size_t(file_status.st_size) >= data_size && data_size > 0)
+    {
+        // private mapping, the data can be modified in memory without changing the file
+        void *address = mmap(nullptr, data_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file_descriptor, 0);
+        if (address != MAP_FAILED)
+        {
+            // the level set probes the narrow band only, read-ahead of the whole file is not useful
+            madvise(address, data_size, MADV_RANDOM);
+            mapped_address_ = address;
+            mapped_size_ = data_size;
+            data_ = static_cast<T *>(address);
+        }
+    }
+    if (file_descriptor >= 0)
+        close(file_descriptor);
+#endif
+    if (data_ == nullptr)
+    {
+        data_ = new T[size_];
+        std::ifstream dataFileRaw(file_path_to_raw_file, std::ios::in | std::ios::binary);
+        if (dataFileRaw.is_open())
+        {
+            dataFileRaw.read((char *)data_, data_size);
+        }
+        dataFileRaw.close();
+    }
+}
+//=================================================================================================//
+template <typename T, int nDims>
+void ImageMHD<T, nDims>::findValueRange()
+{
+    size_t slice_size = size_t(width_) * size_t(height_);
+    for (int z = 0; z < depth_; z++)
+    {
+        T *slice = data_ + z * slice_size;
+        for (size_t index = 0; index < slice_size; index++)
+        {
+            Real distance = slice[index];
+            if (distance < min_value_)
+                min_value_ = distance;
+            if (distance > max_value_)
+                max_value_ = distance;
+        }
+#ifdef SPHINXSYS_HAS_MMAP
+        // release the pages of the scanned slices, they are read again from the file when probed
+        if (mapped_address_ != nullptr)
+        {
+            size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+            size_t scanned_bytes = sizeof(T) * (z + 1) * slice_size / page_size * page_size;
+            if (scanned_bytes > 0)
+                madvise(mapped_address_, scanned_bytes, MADV_DONTNEED);
+        }
+#endif
+    }
+}
 
 //=================================================================================================//
 template <typename T, int nDims>
@@ -377,20 +445,15 @@ BoundingBox ImageMHD<T, nDims>::findBounds()
     Vec3d lower_bound = MaxReal * Vec3d::Ones();
     Vec3d upper_bound = MinReal * Vec3d::Ones();
 
-    for (int z = 0; z < depth_ + 1; z++)
+    // the mapping to physical space is affine, the bounds are given by the corners of the image
+    for (int corner = 0; corner != 8; ++corner)
     {
-        for (int y = 0; y < height_ + 1; y++)
+        Vec3d p_image = Vec3d(corner & 1 ? width_ : 0, corner & 2 ? height_ : 0, corner & 4 ? depth_ : 0);
+        Vec3d vertex_position = convertToPhysicalSpace(p_image);
+        for (int j = 0; j != 3; ++j)
         {
-            for (int x = 0; x < width_ + 1; x++)
-            {
-                Vec3d p_image = Vec3d(x, y, z);
-                Vec3d vertex_position = convertToPhysicalSpace(p_image);
-                for (int j = 0; j != 3; ++j)
-                {
-                    lower_bound[j] = SMIN(lower_bound[j], vertex_position[j]);
-                    upper_bound[j] = SMAX(upper_bound[j], vertex_position[j]);
-                }
-            }
+            lower_bound[j] = SMIN(lower_bound[j], vertex_position[j]);
+            upper_bound[j] = SMAX(upper_bound[j], vertex_position[j]);
         }
     }
     return BoundingBox(lower_bound, upper_bound);
@@ -0,0 +1,332 @@
+#include "particle_memory.h"
+
+#include "scalar_functions.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+void ParticleMemory::setPlacement(ParticleMemoryPlacement placement, bool use_huge_pages)
+{
+#if defined(__linux__)
+    placement_ = placement;
+    use_huge_pages_ = use_huge_pages;
+#else
+    if (placement != ParticleMemoryPlacement::calling_thread)
+    {
+        std::cout << "\n Warning: the particle memory placement is only available on Linux." << std::endl;
+    }
+#endif
+    is_configured_ = true;
+}
+//=================================================================================================//
+ParticleMemoryPlacement ParticleMemory::Placement()
+{
+    configureOnce();
+    return placement_;
+}
+//=================================================================================================//
+void ParticleMemory::configureOnce()
+{
+    if (!is_configured_)
+    {
+        std::call_once(environment_configured_,
+                       []()
+                       {
+                           if (!is_configured_)
+                               configureFromEnvironment();
+                       });
+    }
+}
+//=================================================================================================//
+void ParticleMemory::configureFromEnvironment()
+{
+    ParticleMemoryPlacement placement = ParticleMemoryPlacement::calling_thread;
+    if (const char *placement_name = std::getenv("SPHINXSYS_PARTICLE_MEMORY"))
+    {
+        if (std::strcmp(placement_name, "first_touch") == 0)
+            placement = ParticleMemoryPlacement::first_touch;
+        else if (std::strcmp(placement_name, "interleaved") == 0)
+            placement = ParticleMemoryPlacement::interleaved;
+    }
+    const char *huge_pages = std::getenv("SPHINXSYS_HUGE_PAGES");
+    bool use_huge_pages = huge_pages != nullptr && std::strcmp(huge_pages, "1") == 0;
+    bool has_resource_factory = false;
+    {
+        std::lock_guard<std::mutex> lock(resource_factory_mutex_);
+        has_resource_factory = static_cast<bool>(resource_factory_);
+    }
+    if (const char *placement_name = std::getenv("SPHINXSYS_PARTICLE_MEMORY"))
+    {
+        if (std::strcmp(placement_name, "arena") == 0 && !has_resource_factory)
+            useArena(use_huge_pages);
+        if (std::strcmp(placement_name, "mapped") == 0 && !has_resource_factory)
+        {
+            const char *mapped_folder = std::getenv("SPHINXSYS_MAPPED_FOLDER");
+            useMappedFiles(mapped_folder != nullptr ? std::string(mapped_folder)
+                                                    : std::filesystem::temp_directory_path().string());
+        }
+    }
+    setPlacement(placement, use_huge_pages);
+}
+//=================================================================================================//
+void ParticleMemory::setResourceFactory(const ParticleMemoryResourceFactory &resource_factory)
+{
+    std::lock_guard<std::mutex> lock(resource_factory_mutex_);
+    resource_factory_ = resource_factory;
+}
+//=================================================================================================//
+void ParticleMemory::useArena(bool use_huge_pages)
+{
+    setResourceFactory([use_huge_pages]()
+                       { return UniquePtr<ParticleMemoryResource>(
+                             makeUnique<ParticleMemoryArena>(use_huge_pages)); });
+}
+//=================================================================================================//
+void ParticleMemory::useMappedFiles(const std::string &folder)
+{
+    if (!std::filesystem::exists(folder))
+    {
+        std::filesystem::create_directories(folder);
+    }
+    setResourceFactory([folder]()
+                       { return UniquePtr<ParticleMemoryResource>(
+                             makeUnique<MappedFileMemoryResource>(folder)); });
+}
+//=================================================================================================//
+UniquePtr<ParticleMemoryResource> ParticleMemory::createResource()
+{
+    configureOnce();
+    std::lock_guard<std::mutex> lock(resource_factory_mutex_);
+    return resource_factory_ ? resource_factory_() : nullptr;
+}
+//=================================================================================================//
+void *ParticleMemory::allocatePages(size_t bytes)
+{
+#if defined(__linux__)
+    void *data = mmap(nullptr, SMAX(bytes, size_t(1)), PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    if (use_huge_pages_)
+    {
+        madvise(data, bytes, MADV_HUGEPAGE);
+    }
+    if (placement_ == ParticleMemoryPlacement::interleaved)
+    {
+        // all online nodes, as listed by the kernel
+        unsigned long node_mask = 0;
+        for (int node = 0; node != int(8 * sizeof(node_mask)); ++node)
+        {
+            if (std::filesystem::exists("/sys/devices/system/node/node" + std::to_string(node)))
+                node_mask |= 1UL << node;
+        }
+        if (node_mask != 0)
+        {
+            syscall(SYS_mbind, data, bytes, MPOL_INTERLEAVE, &node_mask, 8 * sizeof(node_mask), 0);
+        }
+    }
+    return data;
+#else
+    return ::operator new(bytes);
+#endif
+}
+//=================================================================================================//
+void ParticleMemory::deallocatePages(void *data, size_t bytes)
+{
+#if defined(__linux__)
+    munmap(data, SMAX(bytes, size_t(1)));
+#else
+    ::operator delete(data);
+#endif
+}
+//=================================================================================================//
+ParticleMemoryArena::~ParticleMemoryArena()
+{
+    for (Region &region : regions_)
+    {
+#if defined(__linux__)
+        munmap(region.data_, region.size_);
+#else
+        ::operator delete(region.data_, std::align_val_t(region_alignment));
+#endif
+    }
+}
+//=================================================================================================//
+ParticleMemoryArena::Region &ParticleMemoryArena::addRegion(size_t bytes)
+{
+    size_t region_bytes = alignedSize(SMAX(bytes, next_region_bytes_), region_alignment);
+#if defined(__linux__)
+    // over-map by one alignment to trim the region to a 2 MB boundary
+    size_t mapped_bytes = region_bytes + region_alignment;
+    void *mapped = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapped == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    char *begin = static_cast<char *>(mapped);
+    char *data = reinterpret_cast<char *>(alignedSize(reinterpret_cast<size_t>(begin), region_alignment));
+    if (data != begin)
+        munmap(begin, data - begin);
+    size_t tail_bytes = mapped_bytes - (data - begin) - region_bytes;
+    if (tail_bytes != 0)
+        munmap(data + region_bytes, tail_bytes);
+    if (use_huge_pages_)
+    {
+        madvise(data, region_bytes, MADV_HUGEPAGE);
+    }
+#else
+    char *data = static_cast<char *>(::operator new(region_bytes, std::align_val_t(region_alignment)));
+#endif
+    regions_.push_back(Region{data, region_bytes, 0, 0});
+    next_region_bytes_ = 2 * region_bytes;
+    return regions_.back();
+}
+//=================================================================================================//
+void *ParticleMemoryArena::allocate(size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t aligned_bytes = alignedSize(SMAX(bytes, size_t(1)), alignment);
+    Region *region = regions_.empty() ? nullptr : &regions_.back();
+    if (region == nullptr || region->used_ + aligned_bytes > region->size_)
+    {
+        region = &addRegion(aligned_bytes);
+    }
+    void *data = region->data_ + region->used_;
+    region->used_ += aligned_bytes;
+    region->live_fields_++;
+    return data;
+}
+//=================================================================================================//
+void ParticleMemoryArena::deallocate(void *data, size_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t aligned_bytes = alignedSize(SMAX(bytes, size_t(1)), alignment);
+    char *field = static_cast<char *>(data);
+    for (Region &region : regions_)
+    {
+        if (field >= region.data_ && field < region.data_ + region.size_)
+        {
+            region.live_fields_--;
+            if (region.live_fields_ == 0)
+                region.used_ = 0;
+            else if (field + aligned_bytes == region.data_ + region.used_)
+                region.used_ -= aligned_bytes;
+            return;
+        }
+    }
+}
+//=================================================================================================//
+size_t ParticleMemoryArena::ReservedBytes()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t reserved_bytes = 0;
+    for (const Region &region : regions_)
+        reserved_bytes += region.size_;
+    return reserved_bytes;
+}
+//=================================================================================================//
+MappedFileMemoryResource::MappedFileMemoryResource(const std::string &folder)
+    : folder_(folder), number_of_files_(0), reserved_bytes_(0)
+{
+#if !defined(__linux__)
+    std::cout << "\n Warning: the mapped particle memory is only available on Linux." << std::endl;
+#endif
+}
+//=================================================================================================//
+void *MappedFileMemoryResource::allocate(size_t bytes)
+{
+    size_t mapped_bytes = SMAX(bytes, size_t(1));
+#if defined(__linux__)
+    std::string file_path;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        file_path = folder_ + "/particle_field_" + std::to_string(getpid()) + "_" +
+                    std::to_string(reinterpret_cast<size_t>(this)) + "_" + std::to_string(number_of_files_++);
+    }
+    int file_descriptor = open(file_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+    if (file_descriptor < 0)
+    {
+        std::cout << "\n Error: the mapped particle field file " << file_path << " cannot be created!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    void *data = MAP_FAILED;
+    if (ftruncate(file_descriptor, off_t(mapped_bytes)) == 0)
+    {
+        data = mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_descriptor, 0);
+    }
+    close(file_descriptor);
+    unlink(file_path.c_str());
+    if (data == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+#else
+    void *data = ::operator new(mapped_bytes, std::align_val_t(alignment));
+#endif
+    reserved_bytes_ += mapped_bytes;
+    return data;
+}
+//=================================================================================================//
+void MappedFileMemoryResource::deallocate(void *data, size_t bytes)
+{
+    size_t mapped_bytes = SMAX(bytes, size_t(1));
+#if defined(__linux__)
+    munmap(data, mapped_bytes);
+#else
+    ::operator delete(data, std::align_val_t(alignment));
+#endif
+    reserved_bytes_ -= mapped_bytes;
+}
+//=================================================================================================//
+void ParticleCapacity::setGrowth(Real growth_factor, Real headroom)
+{
+    if (growth_factor < 1.0 || headroom < 0.0)
+    {
+        std::cout << "\n Error: the capacity growth factor is less than one or the headroom is negative!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    growth_factor_ = growth_factor;
+    headroom_ = headroom;
+}
+//=================================================================================================//
+ParticleCapacity::Statistics ParticleCapacity::getStatistics()
+{
+    Statistics statistics;
+    statistics.reallocations_ = reallocations_.load(std::memory_order_relaxed);
+    statistics.reallocated_bytes_ = reallocated_bytes_.load(std::memory_order_relaxed);
+    return statistics;
+}
+//=================================================================================================//
+void ParticleCapacity::resetStatistics()
+{
+    reallocations_.store(0, std::memory_order_relaxed);
+    reallocated_bytes_.store(0, std::memory_order_relaxed);
+}
+//=================================================================================================//
+void ParticleCapacity::writeReport(std::ostream &output)
+{
+    Statistics statistics = getStatistics();
+    output << "\n Capacity growth (factor " << growth_factor_ << ", headroom " << headroom_ << "): "
+           << statistics.reallocations_ << " reallocations, "
+           << 1.0e-6 * Real(statistics.reallocated_bytes_) << " MB reallocated." << std::endl;
+}
+//=================================================================================================//
+} // namespace SPH
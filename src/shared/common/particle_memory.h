@@ -0,0 +1,319 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	particle_memory.h
+ * @brief 	NUMA-aware allocation of the data fields of particle variables.
+ * @details By default, the data are allocated and initialized by the calling thread,
+ *          so that on multi-socket nodes all pages are placed on the socket of the main thread.
+ *          With first-touch placement, the pages are initialized in parallel by a static partition
+ *          of the particle range, which is then also the default partition of the particle loops,
+ *          so that each thread finds its particles on its own socket. With interleaved placement,
+ *          the pages are spread over all sockets round-robin. Transparent huge pages can be requested
+ *          for both. As particle sorting copies the sorted data back into the same fields,
+ *          the placement is not changed by sorting. Only available on Linux, elsewhere the default is used.
+ *          Alternatively, the variables of each body are allocated from a pluggable memory resource,
+ *          by default an arena of a few large huge-page backed regions with cache-line aligned fields,
+ *          or files mapped into memory for bodies larger than the physical memory.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PARTICLE_MEMORY_H
+#define PARTICLE_MEMORY_H
+
+#include "base_data_type.h"
+#include "large_data_containers.h"
+#include "ownership.h"
+#include "scalar_functions.h"
+#include "thread_arena.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <mutex>
+#include <new>
+#include <ostream>
+#include <string>
+
+namespace SPH
+{
+enum class ParticleMemoryPlacement
+{
+    calling_thread,
+    first_touch,
+    interleaved
+};
+
+/**
+ * @class ParticleMemoryResource
+ * @brief Pluggable allocation of the data fields of particle variables,
+ *        e.g. an arena or pinned host memory for the transfers to a device.
+ *        The memory is to be aligned to ParticleMemoryResource::alignment.
+ */
+class ParticleMemoryResource
+{
+  public:
+    static constexpr size_t alignment = 64;
+    virtual ~ParticleMemoryResource(){};
+    virtual void *allocate(size_t bytes) = 0;
+    virtual void deallocate(void *data, size_t bytes) = 0;
+    /** the bytes reserved from the system, including those not allocated yet */
+    virtual size_t ReservedBytes() { return 0; };
+};
+
+/**
+ * @class ParticleMemoryArena
+ * @brief Allocates the fields of the variables of a body from large regions, aligned to and
+ *        in multiples of 2 MB with transparent huge pages if requested, at 64-byte aligned offsets.
+ *        A field is allocated after the last one in the latest region, and a region grown geometrically
+ *        is added when it is full. The space of a freed field is only reused when it is the last one,
+ *        or when all fields of its region are freed, which is the case for capacity growth
+ *        by reallocating the latest field. All regions are released with the arena.
+ */
+class ParticleMemoryArena : public ParticleMemoryResource
+{
+  public:
+    static constexpr size_t region_alignment = 2 * 1024 * 1024;
+    explicit ParticleMemoryArena(bool use_huge_pages = true, size_t initial_region_bytes = region_alignment)
+        : use_huge_pages_(use_huge_pages), next_region_bytes_(initial_region_bytes){};
+    virtual ~ParticleMemoryArena();
+    virtual void *allocate(size_t bytes) override;
+    virtual void deallocate(void *data, size_t bytes) override;
+    virtual size_t ReservedBytes() override;
+
+  protected:
+    struct Region
+    {
+        char *data_;
+        size_t size_;
+        size_t used_;
+        size_t live_fields_;
+    };
+    bool use_huge_pages_;
+    size_t next_region_bytes_;
+    StdVec<Region> regions_;
+    std::mutex mutex_;
+
+    static size_t alignedSize(size_t bytes, size_t alignment_size)
+    {
+        return (bytes + alignment_size - 1) / alignment_size * alignment_size;
+    };
+    Region &addRegion(size_t bytes);
+};
+
+/**
+ * @class MappedFileMemoryResource
+ * @brief Allocates each field in a file of the given folder mapped into memory, so that
+ *        the fields of giant bodies are paged to and from disk by the operating system
+ *        instead of being bounded by the physical memory. The file is removed right after mapping,
+ *        its disk space is then released with the field. Only available on Linux,
+ *        elsewhere the fields are allocated from the heap.
+ */
+class MappedFileMemoryResource : public ParticleMemoryResource
+{
+  public:
+    explicit MappedFileMemoryResource(const std::string &folder);
+    virtual ~MappedFileMemoryResource(){};
+    virtual void *allocate(size_t bytes) override;
+    virtual void deallocate(void *data, size_t bytes) override;
+    virtual size_t ReservedBytes() override { return reserved_bytes_; };
+
+  protected:
+    std::string folder_;
+    size_t number_of_files_;
+    std::atomic<size_t> reserved_bytes_;
+    std::mutex mutex_;
+};
+
+using ParticleMemoryResourceFactory = std::function<UniquePtr<ParticleMemoryResource>()>;
+
+/**
+ * @class ParticleMemory
+ * @brief The placement is global and applies to the variables allocated after it is set.
+ *        It can also be given by the environment variable SPHINXSYS_PARTICLE_MEMORY
+ *        as first_touch or interleaved, and huge pages by SPHINXSYS_HUGE_PAGES=1.
+ *        With a resource factory set, or SPHINXSYS_PARTICLE_MEMORY=arena, each body created afterwards
+ *        owns a resource created by the factory, from which the variables registered in its particles
+ *        are allocated. The placement then only decides whether the fields are initialized in parallel.
+ *        SPHINXSYS_PARTICLE_MEMORY=mapped uses mapped files in the folder given by SPHINXSYS_MAPPED_FOLDER,
+ *        or in the temporary folder of the system. As the factory applies to the bodies created
+ *        afterwards, it can be set for a giant body only and reset with an empty factory.
+ */
+class ParticleMemory
+{
+  public:
+    static void setPlacement(ParticleMemoryPlacement placement, bool use_huge_pages = false);
+    static ParticleMemoryPlacement Placement();
+    static bool isPageAllocated() { return Placement() != ParticleMemoryPlacement::calling_thread; };
+    /** an empty factory for no resources, i.e. the allocation of each field by itself */
+    static void setResourceFactory(const ParticleMemoryResourceFactory &resource_factory);
+    /** an arena for the particles of each body, see ParticleMemoryArena */
+    static void useArena(bool use_huge_pages = true);
+    /** mapped files in the folder for the particles of each body, see MappedFileMemoryResource */
+    static void useMappedFiles(const std::string &folder);
+    /** the resource for the particles of a new body, null without a factory */
+    static UniquePtr<ParticleMemoryResource> createResource();
+
+    /**
+     * @class ResourceScope
+     * @brief The fields of the variables constructed on this thread within the scope
+     *        are allocated from the given resource, if not null.
+     */
+    class ResourceScope
+    {
+        ParticleMemoryResource *previous_;
+
+      public:
+        explicit ResourceScope(ParticleMemoryResource *resource) : previous_(current_resource_)
+        {
+            current_resource_ = resource;
+        };
+        ~ResourceScope() { current_resource_ = previous_; };
+    };
+    static ParticleMemoryResource *CurrentResource() { return current_resource_; };
+
+    template <typename DataType>
+    static DataType *allocate(size_t data_size, ParticleMemoryResource *resource = nullptr)
+    {
+        // the fields from resources or pages are released without calling the destructors
+        static_assert(std::is_trivially_destructible_v<DataType>, "Data type with non-trivial destructor!");
+        if (resource != nullptr)
+        {
+            static_assert(alignof(DataType) <= ParticleMemoryResource::alignment, "Over-aligned data type!");
+            DataType *data = static_cast<DataType *>(resource->allocate(data_size * sizeof(DataType)));
+            initializeData(data, data_size, Placement() == ParticleMemoryPlacement::first_touch);
+            return data;
+        }
+
+        if (!isPageAllocated())
+        {
+            return new DataType[data_size];
+        }
+
+        DataType *data = static_cast<DataType *>(allocatePages(data_size * sizeof(DataType)));
+        initializeData(data, data_size, true);
+        return data;
+    };
+
+    /** is_page_allocated is the value of isPageAllocated at the allocation, the resource that of the allocation */
+    template <typename DataType>
+    static void deallocate(DataType *data, size_t data_size, bool is_page_allocated,
+                           ParticleMemoryResource *resource = nullptr)
+    {
+        if (resource != nullptr)
+        {
+            resource->deallocate(data, data_size * sizeof(DataType));
+            return;
+        }
+
+        if (!is_page_allocated)
+        {
+            delete[] data;
+            return;
+        }
+        deallocatePages(data, data_size * sizeof(DataType));
+    };
+
+  protected:
+    /** the variables of different bodies, e.g. in an ensemble, may be allocated concurrently */
+    static inline std::atomic<bool> is_configured_{false};
+    static inline std::once_flag environment_configured_;
+    static inline std::atomic<ParticleMemoryPlacement> placement_{ParticleMemoryPlacement::calling_thread};
+    static inline std::atomic<bool> use_huge_pages_{false};
+    static inline std::mutex resource_factory_mutex_;
+    static inline ParticleMemoryResourceFactory resource_factory_;
+    static inline thread_local ParticleMemoryResource *current_resource_ = nullptr;
+
+    /** the environment is read once, only if the placement is not set before */
+    static void configureOnce();
+    static void configureFromEnvironment();
+    static void *allocatePages(size_t bytes);
+    static void deallocatePages(void *data, size_t bytes);
+
+    template <typename DataType>
+    static void initializeData(DataType *data, size_t data_size, bool is_parallel)
+    {
+        if (!is_parallel)
+        {
+            for (size_t i = 0; i != data_size; ++i)
+            {
+                new (data + i) DataType(ZeroData<DataType>::value);
+            }
+            return;
+        }
+
+        arena_parallel_for(
+            IndexRange(0, data_size),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    new (data + i) DataType(ZeroData<DataType>::value);
+                }
+            },
+            tbb::static_partitioner());
+    };
+};
+
+/**
+ * @class ParticleCapacity
+ * @brief Capacity policy of the particle-indexed storage growing at run time,
+ *        e.g. the CK neighbor lists and the pair vectors of the classic neighborhoods.
+ *        A grown capacity is the larger of the required size with the headroom
+ *        and the geometric growth of the current capacity, so that a steadily growing
+ *        storage is reallocated only logarithmically often. Reallocations are counted for reporting.
+ *        Note that particle variables are not grown, they are bounded by the reserved buffer particles.
+ */
+class ParticleCapacity
+{
+  public:
+    struct Statistics
+    {
+        size_t reallocations_ = 0;
+        size_t reallocated_bytes_ = 0; /**< bytes of the storage after the reallocations */
+    };
+
+    /** growth_factor is at least one and headroom the fraction added to the required size */
+    static void setGrowth(Real growth_factor, Real headroom);
+    static size_t GrownCapacity(size_t current_capacity, size_t required_size)
+    {
+        size_t with_headroom = required_size + size_t(headroom_ * Real(required_size));
+        size_t geometric = size_t(growth_factor_ * Real(current_capacity));
+        return SMAX(SMAX(with_headroom, geometric), required_size);
+    };
+    static void recordReallocation(size_t bytes)
+    {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+        reallocated_bytes_.fetch_add(bytes, std::memory_order_relaxed);
+    };
+    static Statistics getStatistics();
+    static void resetStatistics();
+    static void writeReport(std::ostream &output);
+
+  protected:
+    static inline Real growth_factor_ = 1.5;
+    static inline Real headroom_ = 0.25;
+    static inline std::atomic<size_t> reallocations_{0};
+    static inline std::atomic<size_t> reallocated_bytes_{0};
+};
+} // namespace SPH
+#endif // PARTICLE_MEMORY_H
@@ -31,6 +31,7 @@
 #include "base_data_type.h"
 
 #include <chrono>
+#include <cstdint>
 #include <random>
 
 namespace SPH
@@ -163,6 +164,21 @@ inline Real rand_uniform(Real lower, Real upper)
     return distribution(generator);
 }
 
+/** Counter-based (Philox2x32-10) uniform random number, which only depends on the key and the counter,
+ * so that the sequence is reproducible independent of the calling order and the number of threads. */
+inline Real rand_uniform_counter_based(uint32_t key, uint64_t counter, Real lower, Real upper)
+{
+    uint32_t low = uint32_t(counter), high = uint32_t(counter >> 32);
+    for (int round = 0; round != 10; ++round)
+    {
+        uint64_t product = uint64_t(0xD256D193) * low;
+        low = uint32_t(product >> 32) ^ key ^ high;
+        high = uint32_t(product);
+        key += 0x9E3779B9;
+    }
+    return lower + (upper - lower) * Real(low) * Real(2.3283064365386963e-10); // 2^-32
+}
+
 /** rotating axis once according to right hand rule.
  * The first_axis must be 0, 1 for 2d and 0, 1, 2 for 3d
  */
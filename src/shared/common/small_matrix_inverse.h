@@ -0,0 +1,91 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	small_matrix_inverse.h
+ * @brief 	Inverse of 2x2 and 3x3 matrices by cofactors, and the regularized inverse
+ * 			used for the kernel correction matrices.
+ * @details The functions are inlined straight-line code without branches,
+ * 			so that the particle loops calling them can be vectorized by the compiler.
+ * 			No pivoting is done, which is fine for the well-conditioned
+ * 			or regularized matrices they are applied to.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef SMALL_MATRIX_INVERSE_H
+#define SMALL_MATRIX_INVERSE_H
+
+#include "base_data_type.h"
+#include "scalar_functions.h"
+
+namespace SPH
+{
+/** the adjugate, i.e. the transposed cofactor matrix, with A * adjugate(A) = det(A) * I */
+inline Mat2d adjugateMatrix(const Mat2d &A)
+{
+    Mat2d adjugate;
+    adjugate << A(1, 1), -A(0, 1),
+        -A(1, 0), A(0, 0);
+    return adjugate;
+}
+
+inline Mat3d adjugateMatrix(const Mat3d &A)
+{
+    Mat3d adjugate;
+    adjugate(0, 0) = A(1, 1) * A(2, 2) - A(1, 2) * A(2, 1);
+    adjugate(0, 1) = A(0, 2) * A(2, 1) - A(0, 1) * A(2, 2);
+    adjugate(0, 2) = A(0, 1) * A(1, 2) - A(0, 2) * A(1, 1);
+    adjugate(1, 0) = A(1, 2) * A(2, 0) - A(1, 0) * A(2, 2);
+    adjugate(1, 1) = A(0, 0) * A(2, 2) - A(0, 2) * A(2, 0);
+    adjugate(1, 2) = A(0, 2) * A(1, 0) - A(0, 0) * A(1, 2);
+    adjugate(2, 0) = A(1, 0) * A(2, 1) - A(1, 1) * A(2, 0);
+    adjugate(2, 1) = A(0, 1) * A(2, 0) - A(0, 0) * A(2, 1);
+    adjugate(2, 2) = A(0, 0) * A(1, 1) - A(0, 1) * A(1, 0);
+    return adjugate;
+}
+
+template <class MatType>
+inline MatType inverseByCofactors(const MatType &A)
+{
+    MatType adjugate = adjugateMatrix(A);
+    Real determinant = A.row(0).dot(adjugate.col(0));
+    return adjugate / determinant;
+}
+
+/**
+ * The linear gradient correction matrix from the configuration matrix B:
+ * the Tikhonov-regularized inverse (B^T B + SqrtEps I)^{-1} B^T,
+ * blended with the identity matrix when the determinant of B is smaller than alpha.
+ */
+template <class MatType>
+inline MatType regularizedCorrectionMatrix(const MatType &B, Real alpha)
+{
+    MatType adjugate_B = adjugateMatrix(B);
+    Real determinant = B.row(0).dot(adjugate_B.col(0));
+    Real det_sqr = SMAX(alpha - determinant, Real(0));
+    MatType B_T = B.transpose();
+    MatType inverse = inverseByCofactors(MatType(B_T * B + SqrtEps * MatType::Identity())) * B_T;
+    Real weight = determinant / (determinant + det_sqr);
+    return weight * inverse + (Real(1) - weight) * MatType::Identity();
+}
+} // namespace SPH
+#endif // SMALL_MATRIX_INVERSE_H
@@ -80,6 +80,7 @@ class DiscreteConstant : public Entity
         }
         return delegated_data_field_;
     };
+    DataType *DelegatedDataField(const ParallelHybridPolicy &par_hybrid) { return DelegatedDataField(par_device); };
 
   private:
     size_t data_size_;
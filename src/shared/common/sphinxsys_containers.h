@@ -38,6 +38,7 @@ namespace SPH
 {
 class Base;             // Indicating base class
 class Adaptive;         // Indicating with adaptive resolution
+class CellRelative;     // Indicating with cell-relative positions
 class Lattice;          // Indicating with lattice points
 class UnstructuredMesh; // Indicating with unstructured mesh
 class BaseMaterial;
@@ -76,7 +77,31 @@ using ParticlesBound = std::pair<size_t, size_t>;
 using ListData = std::pair<size_t, Vecd>;
 using ListDataVector = StdLargeVec<ListData>;
 using DataListsInCells = StdLargeVec<ListDataVector *>;
-using ConcurrentCellLists = ConcurrentVec<ConcurrentIndexVector *>;
+
+/**
+ * @class CellParticles
+ * @brief The real particles listed in a cell, viewed in the flat cell lists of a cell linked list,
+ * i.e. the offsets of the cells and the particle indices sorted by cell.
+ * The view refers to the lists, not to their data, so that it stays valid when the lists are rebuilt.
+ */
+class CellParticles
+{
+    const StdLargeVec<UnsignedInt> *cell_offset_list_;
+    const StdLargeVec<UnsignedInt> *particle_index_list_;
+    size_t linear_index_;
+
+  public:
+    CellParticles(const StdLargeVec<UnsignedInt> &cell_offset_list,
+                  const StdLargeVec<UnsignedInt> &particle_index_list, size_t linear_index)
+        : cell_offset_list_(&cell_offset_list), particle_index_list_(&particle_index_list),
+          linear_index_(linear_index){};
+
+    size_t size() const { return (*cell_offset_list_)[linear_index_ + 1] - (*cell_offset_list_)[linear_index_]; };
+    size_t operator[](size_t n) const { return (*particle_index_list_)[(*cell_offset_list_)[linear_index_] + n]; };
+    const UnsignedInt *begin() const { return particle_index_list_->data() + (*cell_offset_list_)[linear_index_]; };
+    const UnsignedInt *end() const { return particle_index_list_->data() + (*cell_offset_list_)[linear_index_ + 1]; };
+};
+using ConcurrentCellLists = ConcurrentVec<CellParticles *>;
 /** Cell list for periodic boundary condition algorithms. */
 using CellLists = std::pair<ConcurrentCellLists, DataListsInCells>;
 
@@ -31,8 +31,14 @@
 #define SPHINXSYS_VARIABLE_H
 
 #include "base_data_package.h"
+#include "component_layout.h"
 #include "execution_policy.h"
 #include "ownership.h"
+#include "particle_memory.h"
+
+#include <functional>
+#include <map>
+#include <set>
 
 namespace SPH
 {
@@ -78,10 +84,42 @@ class SingularVariable : public Entity
 
     DataType *ValueAddress() { return delegated_; };
 
-    void setValue(const DataType &value) { *delegated_ = value; };
     DataType getValue() { return *delegated_; };
 
+#if SPHINXSYS_USE_MIXED_PRECISION
+    void setValue(const DataType &value)
+    {
+        *delegated_ = value;
+        compensation_ = 0;
+    };
+    /**
+     * Kahan compensated summation for Real, e.g. for accumulating the physical time in float.
+     * Only the increments made by this function are compensated, not those added through ValueAddress().
+     * The compensation is discarded once the value has been written in another way.
+     */
+    void incrementValue(const DataType &value)
+    {
+        if constexpr (std::is_same_v<DataType, Real>)
+        {
+            if (*delegated_ != compensated_sum_)
+            {
+                compensation_ = 0;
+            }
+            Real corrected = value - compensation_;
+            Real sum = *delegated_ + corrected;
+            compensation_ = (sum - *delegated_) - corrected;
+            *delegated_ = sum;
+            compensated_sum_ = sum;
+        }
+        else
+        {
+            *delegated_ += value;
+        }
+    };
+#else
+    void setValue(const DataType &value) { *delegated_ = value; };
     void incrementValue(const DataType &value) { *delegated_ += value; };
+#endif // SPHINXSYS_USE_MIXED_PRECISION
 
     template <class ExecutionPolicy>
     DataType *DelegatedData(const ExecutionPolicy &ex_policy) { return delegated_; };
@@ -95,12 +133,68 @@ class SingularVariable : public Entity
         }
         return delegated_;
     };
+    DataType *DelegatedData(const ParallelHybridPolicy &par_hybrid) { return DelegatedData(par_device); };
     bool isValueDelegated() { return value_ != delegated_; };
     void setDelegateValueAddress(DataType *new_delegated) { delegated_ = new_delegated; };
 
   protected:
     DataType *value_;
     DataType *delegated_;
+#if SPHINXSYS_USE_MIXED_PRECISION
+    Real compensation_ = 0;
+    Real compensated_sum_ = 0; /**< the value after the last compensated increment */
+#endif // SPHINXSYS_USE_MIXED_PRECISION
+};
+
+/**
+ * @class DataTrafficRecording
+ * @brief Records the discrete variables delegated to computing kernels constructed on this thread within its scope.
+ * A particle variable moves its element size for each particle, while neighbor data, such as neighbor lists,
+ * are moved as a whole. The size of the latter is taken at each call, as the lists are reallocated to fit.
+ * Used to estimate the memory traffic of a dynamics, see DynamicsProfiler.
+ */
+class DataTrafficRecording
+{
+    static inline thread_local DataTrafficRecording *recording_ = nullptr;
+    DataTrafficRecording *previous_;
+    std::map<const void *, size_t> particle_data_;
+    std::map<const void *, std::function<size_t()>> neighbor_data_;
+
+  public:
+    DataTrafficRecording() : previous_(recording_) { recording_ = this; };
+    ~DataTrafficRecording()
+    {
+        recording_ = previous_;
+        if (previous_ != nullptr)
+        {
+            previous_->particle_data_.insert(particle_data_.begin(), particle_data_.end());
+            previous_->neighbor_data_.insert(neighbor_data_.begin(), neighbor_data_.end());
+        }
+    };
+    static bool isRecording() { return recording_ != nullptr; };
+    static void recordParticleData(const void *variable, size_t element_bytes)
+    {
+        recording_->particle_data_[variable] = element_bytes;
+    };
+    static void recordNeighborData(const void *variable, const std::function<size_t()> &data_bytes)
+    {
+        recording_->neighbor_data_[variable] = data_bytes;
+    };
+    bool isEmpty() { return particle_data_.empty() && neighbor_data_.empty(); };
+    size_t BytesPerParticle()
+    {
+        size_t bytes_per_particle = 0;
+        for (auto &[variable, element_bytes] : particle_data_)
+            bytes_per_particle += element_bytes;
+        return bytes_per_particle;
+    };
+    StdVec<std::function<size_t()>> NeighborDataBytes()
+    {
+        StdVec<std::function<size_t()>> neighbor_data_bytes;
+        for (auto &[variable, data_bytes] : neighbor_data_)
+            neighbor_data_bytes.push_back(data_bytes);
+        return neighbor_data_bytes;
+    };
 };
 
 template <typename DataType>
@@ -123,22 +217,56 @@ class DiscreteVariable : public Entity
   public:
     DiscreteVariable(const std::string &name, size_t data_size)
         : Entity(name), data_size_(data_size),
-          data_field_(nullptr), device_only_variable_(nullptr),
-          device_data_field_(nullptr)
+          data_field_(nullptr), is_page_allocated_(ParticleMemory::isPageAllocated()),
+          memory_resource_(ParticleMemory::CurrentResource()),
+          device_only_variable_(nullptr), device_data_field_(nullptr), synchronized_version_(0)
     {
-        data_field_ = new DataType[data_size];
+        data_field_ = ParticleMemory::allocate<DataType>(data_size, memory_resource_);
     };
-    ~DiscreteVariable() { delete[] data_field_; };
+    ~DiscreteVariable() { ParticleMemory::deallocate(data_field_, data_size_, is_page_allocated_, memory_resource_); };
     DataType *DataField() { return data_field_; };
 
     template <class ExecutionPolicy>
-    DataType *DelegatedDataField(const ExecutionPolicy &ex_policy) { return data_field_; };
+    DataType *DelegatedDataField(const ExecutionPolicy &ex_policy)
+    {
+        recordDataTraffic();
+        return data_field_;
+    };
     DataType *DelegatedDataField(const ParallelDevicePolicy &par_device);
+    DataType *DelegatedDataField(const ParallelHybridPolicy &par_hybrid) { return DelegatedDataField(par_device); };
 
     bool existDeviceDataField() { return device_data_field_ != nullptr; };
     size_t getDataFieldSize() { return data_size_; }
+    /** the memory of the host data and of the device copy, if any, in bytes */
+    size_t MemoryFootprint() { return data_size_ * sizeof(DataType); };
+    size_t DeviceMemoryFootprint() { return existDeviceDataField() ? MemoryFootprint() : 0; };
+    /** for data moved as a whole by a kernel instead of for each particle, e.g. neighbor lists */
+    void setNeighborData() { is_neighbor_data_ = true; };
+    void recordDataTraffic()
+    {
+        if (DataTrafficRecording::isRecording())
+        {
+            if (is_neighbor_data_)
+                DataTrafficRecording::recordNeighborData(this, [this]()
+                                                         { return MemoryFootprint(); });
+            else
+                DataTrafficRecording::recordParticleData(this, sizeof(DataType));
+        }
+    };
     void setDeviceDataField(DataType *data_field) { device_data_field_ = data_field; };
 
+    /** copies the host data to or from a field in the SoA or AoSoA layout, see ComponentBlockedField */
+    template <class ExecutionPolicy, UnsignedInt BlockSize>
+    void copyToLayout(const ExecutionPolicy &ex_policy, ComponentBlockedField<DataType, BlockSize> &field)
+    {
+        field.gather(ex_policy, data_field_, data_size_);
+    };
+    template <class ExecutionPolicy, UnsignedInt BlockSize>
+    void copyFromLayout(const ExecutionPolicy &ex_policy, const ComponentBlockedField<DataType, BlockSize> &field)
+    {
+        field.scatter(ex_policy, data_field_);
+    };
+
     template <class ExecutionPolicy>
     void reallocateDataField(const ExecutionPolicy &ex_policy, size_t tentative_size)
     {
@@ -150,27 +278,46 @@ class DiscreteVariable : public Entity
 
     void reallocateDataField(const ParallelDevicePolicy &par_device, size_t tentative_size);
 
+    /** copies from the device only if a device kernel is executed after the last synchronization */
     void synchronizeWithDevice();
+    /** as synchronizeWithDevice, but the copy is only enqueued and completed in waitForOutputTransfers */
+    void enqueueSynchronizationWithDevice();
+    /** copies to the device, after which the host and device data are synchronized */
     void synchronizeToDevice();
+    /** to be called after the host data is changed, so that the next synchronization copies */
+    void setSynchronizationOutdated() { synchronized_version_ = 0; };
 
     template <class ExecutionPolicy>
     void prepareForOutput(const ExecutionPolicy &ex_policy){};
-    void prepareForOutput(const ParallelDevicePolicy &ex_policy) { synchronizeWithDevice(); };
+    void prepareForOutput(const ParallelDevicePolicy &ex_policy) { enqueueSynchronizationWithDevice(); };
+    void prepareForOutput(const ParallelHybridPolicy &ex_policy) { enqueueSynchronizationWithDevice(); };
 
   private:
     size_t data_size_;
     DataType *data_field_;
+    bool is_page_allocated_; /**< allocated with the NUMA-aware placement, see ParticleMemory */
+    ParticleMemoryResource *memory_resource_; /**< of the allocation and its growth, null if none */
     DeviceOnlyDiscreteVariable<DataType> *device_only_variable_;
     DataType *device_data_field_;
+    size_t synchronized_version_; /**< the device data version at the last synchronization, 0 if outdated */
+    bool is_neighbor_data_ = false;
 
     void reallocateDataField(size_t tentative_size)
     {
-        delete[] data_field_;
-        data_size_ = tentative_size + tentative_size / 4;
-        data_field_ = new DataType[data_size_];
+        ParticleMemory::deallocate(data_field_, data_size_, is_page_allocated_, memory_resource_);
+        data_size_ = ParticleCapacity::GrownCapacity(data_size_, tentative_size);
+        ParticleCapacity::recordReallocation(data_size_ * sizeof(DataType));
+        is_page_allocated_ = ParticleMemory::isPageAllocated();
+        data_field_ = ParticleMemory::allocate<DataType>(data_size_, memory_resource_);
     };
 };
 
+/** completes the copies enqueued by prepareForOutput, to be called before the host data is used */
+template <class ExecutionPolicy>
+void waitForOutputTransfers(const ExecutionPolicy &ex_policy){};
+void waitForOutputTransfers(const ParallelDevicePolicy &par_device);
+inline void waitForOutputTransfers(const ParallelHybridPolicy &par_hybrid) { waitForOutputTransfers(par_device); };
+
 template <typename DataType>
 class MeshVariable : public Entity
 {
@@ -191,6 +338,33 @@ class MeshVariable : public Entity
     PackageData *data_field_;
 };
 
+/**
+ * @class DataAccessRecording
+ * @brief Records the variables and bodies looked up on this thread within its scope.
+ * Used to infer the data a dynamics works on from its construction, see DynamicsTaskGraph.
+ */
+class DataAccessRecording
+{
+    static inline thread_local std::set<const void *> *recorded_ = nullptr;
+    std::set<const void *> *previous_;
+    std::set<const void *> accessed_;
+
+  public:
+    DataAccessRecording() : previous_(recorded_) { recorded_ = &accessed_; };
+    ~DataAccessRecording()
+    {
+        recorded_ = previous_;
+        if (previous_ != nullptr)
+            previous_->insert(accessed_.begin(), accessed_.end());
+    };
+    std::set<const void *> &Accessed() { return accessed_; };
+    static void record(const void *data)
+    {
+        if (recorded_ != nullptr)
+            recorded_->insert(data);
+    };
+};
+
 template <typename DataType, template <typename VariableDataType> class VariableType>
 VariableType<DataType> *findVariableByName(DataContainerAddressAssemble<VariableType> &assemble,
                                            const std::string &name)
@@ -201,7 +375,10 @@ VariableType<DataType> *findVariableByName(DataContainerAddressAssemble<Variable
                                [&](auto &variable) -> bool
                                { return variable->Name() == name; });
 
-    return result != variables.end() ? *result : nullptr;
+    if (result == variables.end())
+        return nullptr;
+    DataAccessRecording::record(*result);
+    return *result;
 };
 template <typename DataType, template <typename VariableDataType> class VariableType, typename... Args>
 VariableType<DataType> *addVariableToAssemble(DataContainerAddressAssemble<VariableType> &assemble,
@@ -212,6 +389,7 @@ VariableType<DataType> *addVariableToAssemble(DataContainerAddressAssemble<Varia
     VariableType<DataType> *new_variable =
         variable_ptrs.template createPtr<VariableType<DataType>>(std::forward<Args>(args)...);
     std::get<type_index>(assemble).push_back(new_variable);
+    DataAccessRecording::record(new_variable);
     return new_variable;
 };
 } // namespace SPH
@@ -0,0 +1,137 @@
+#include "thread_arena.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace SPH
+{
+#if defined(__linux__)
+namespace
+{
+/** the affinity masks saved on entering pinned arenas, the last one for the innermost arena */
+thread_local StdVec<cpu_set_t> saved_affinity_masks;
+} // namespace
+#endif
+//=================================================================================================//
+ThreadArena::PinningObserver::PinningObserver(tbb::task_arena &arena, const StdVec<int> &cpu_list)
+    : tbb::task_scheduler_observer(arena), cpu_list_(cpu_list)
+{
+    observe(true);
+}
+//=================================================================================================//
+void ThreadArena::PinningObserver::on_scheduler_entry(bool is_worker)
+{
+#if defined(__linux__)
+    cpu_set_t saved_mask;
+    CPU_ZERO(&saved_mask);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &saved_mask);
+    saved_affinity_masks.push_back(saved_mask);
+
+    int slot = tbb::this_task_arena::current_thread_index();
+    if (slot < 0)
+        return;
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu_list_[slot % cpu_list_.size()], &cpu_set);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+#endif
+}
+//=================================================================================================//
+void ThreadArena::PinningObserver::on_scheduler_exit(bool is_worker)
+{
+#if defined(__linux__)
+    // a worker may leave the arena without having entered it since the observer was created
+    if (saved_affinity_masks.empty())
+        return;
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &saved_affinity_masks.back());
+    saved_affinity_masks.pop_back();
+#endif
+}
+//=================================================================================================//
+ThreadArena::ThreadArena(int number_of_threads)
+    : previous_arena_(nullptr), is_active_(false),
+      number_of_threads_(number_of_threads), arena_(number_of_threads) {}
+//=================================================================================================//
+ThreadArena::~ThreadArena()
+{
+    deactivate();
+    pinning_observer_.reset();
+}
+//=================================================================================================//
+void ThreadArena::configure(int number_of_threads, const StdVec<int> &cpu_list)
+{
+    pinning_observer_.reset();
+    arena_.terminate();
+    number_of_threads_ = number_of_threads;
+    arena_.initialize(number_of_threads);
+    if (!cpu_list.empty())
+    {
+#if defined(__linux__)
+        pinning_observer_ = std::make_unique<PinningObserver>(arena_, cpu_list);
+#else
+        std::cout << "\n Warning: threads are not pinned, which is only available on Linux." << std::endl;
+#endif
+    }
+}
+//=================================================================================================//
+void ThreadArena::activate()
+{
+    if (!is_active_)
+    {
+        previous_arena_ = active_arena_;
+        active_arena_ = this;
+        is_active_ = true;
+    }
+}
+//=================================================================================================//
+void ThreadArena::deactivate()
+{
+    if (is_active_)
+    {
+        if (active_arena_ == this)
+            active_arena_ = previous_arena_;
+        is_active_ = false;
+    }
+}
+//=================================================================================================//
+StdVec<int> ThreadArena::parseCpuList(const std::string &cpu_list)
+{
+    StdVec<int> cpus;
+    std::stringstream list_stream(cpu_list);
+    std::string item;
+    while (std::getline(list_stream, item, ','))
+    {
+        size_t dash = item.find('-');
+        int first = std::stoi(item.substr(0, dash));
+        int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+        for (int cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+//=================================================================================================//
+void DeterministicReduction::setEnabled(bool is_enabled, size_t chunk_size)
+{
+    is_configured_ = true;
+    is_enabled_ = is_enabled;
+    chunk_size_ = chunk_size > 0 ? chunk_size : 1;
+}
+//=================================================================================================//
+bool DeterministicReduction::isEnabled()
+{
+    if (!is_configured_)
+    {
+        const char *deterministic_reduce = std::getenv("SPHINXSYS_DETERMINISTIC_REDUCE");
+        setEnabled(deterministic_reduce != nullptr && std::strcmp(deterministic_reduce, "1") == 0, chunk_size_);
+    }
+    return is_enabled_;
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,193 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	thread_arena.h
+ * @brief 	The TBB task arena in which the parallel loops of a system are executed.
+ * @details Without an arena, the loops run in the implicit global arena of TBB.
+ *          With an arena, e.g. the one owned by SPHSystem, the particle and mesh loops run
+ *          with its concurrency, and its threads can be pinned to given cores, so that
+ *          several cases can share a node without oversubscription.
+ *          The parallel reductions can also be made deterministic, see DeterministicReduction.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef THREAD_ARENA_H
+#define THREAD_ARENA_H
+
+#include "large_data_containers.h"
+
+#include "tbb/task_arena.h"
+#include "tbb/task_scheduler_observer.h"
+
+#include <memory>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class ThreadArena
+ * @brief The active arena is the one activated last and not yet deactivated by the calling thread.
+ * @details The active arena is kept per thread, so that systems driven by different threads,
+ *          e.g. the members of an ensemble, run their loops in their own arenas.
+ */
+class ThreadArena
+{
+    /** pins each thread entering the arena to the core of its slot,
+     *  and restores the affinity the thread had before when it leaves the arena */
+    class PinningObserver : public tbb::task_scheduler_observer
+    {
+        StdVec<int> cpu_list_;
+
+      public:
+        PinningObserver(tbb::task_arena &arena, const StdVec<int> &cpu_list);
+        virtual ~PinningObserver() { observe(false); };
+        virtual void on_scheduler_entry(bool is_worker) override;
+        virtual void on_scheduler_exit(bool is_worker) override;
+    };
+
+  public:
+    explicit ThreadArena(int number_of_threads);
+    ~ThreadArena();
+    /** cpu_list empty for no pinning, to be called before the parallel loops are run */
+    void configure(int number_of_threads, const StdVec<int> &cpu_list = StdVec<int>());
+    int NumberOfThreads() { return number_of_threads_; };
+    void activate();
+    void deactivate();
+
+    template <class Function>
+    static auto execute(const Function &function) -> decltype(function())
+    {
+        if (active_arena_ == nullptr)
+            return function();
+        return active_arena_->arena_.execute(function);
+    };
+    /** parses a list of cores such as "0-15,32-47" */
+    static StdVec<int> parseCpuList(const std::string &cpu_list);
+
+  protected:
+    static inline thread_local ThreadArena *active_arena_ = nullptr;
+    ThreadArena *previous_arena_;
+    bool is_active_;
+    int number_of_threads_;
+    tbb::task_arena arena_;
+    std::unique_ptr<PinningObserver> pinning_observer_;
+};
+
+/**
+ * @class DeterministicReduction
+ * @brief When enabled, the parallel reductions split their range into chunks of a fixed size
+ *        and join the partial results along a fixed tree, so that the floating-point result
+ *        does not depend on the scheduling or the number of threads, at the cost of some speed.
+ *        It can also be enabled by the environment variable SPHINXSYS_DETERMINISTIC_REDUCE=1.
+ */
+class DeterministicReduction
+{
+  public:
+    static void setEnabled(bool is_enabled, size_t chunk_size = 1024);
+    static bool isEnabled();
+    static size_t ChunkSize() { return chunk_size_; };
+
+    /** the range split into the fixed chunks */
+    template <typename Value>
+    static tbb::blocked_range<Value> chunkedRange(const tbb::blocked_range<Value> &range)
+    {
+        return tbb::blocked_range<Value>(range.begin(), range.end(), chunk_size_);
+    };
+    template <class Range>
+    static const Range &chunkedRange(const Range &range) { return range; };
+
+  protected:
+    static inline bool is_configured_ = false;
+    static inline bool is_enabled_ = false;
+    static inline size_t chunk_size_ = 1024;
+};
+
+/**
+ * @class ConcurrentTaskScope
+ * @brief Marks the calling thread as running one of several dynamics executed concurrently,
+ *        e.g. by ConcurrentGroup, for the lifetime of the scope.
+ * @details A tbb::affinity_partitioner is stateful and must not be used by loops running at the same time,
+ *          which is the case for the global partitioner ap shared by the particle loops.
+ *          Therefore, the loops started within the scope use tbb::auto_partitioner instead of a given affinity partitioner.
+ */
+class ConcurrentTaskScope
+{
+  public:
+    ConcurrentTaskScope() { ++depth_; };
+    ~ConcurrentTaskScope() { --depth_; };
+    static bool isWithin() { return depth_ != 0; };
+
+  protected:
+    static inline thread_local size_t depth_ = 0;
+};
+
+/** the TBB parallel loops within the active arena */
+template <typename... Args>
+void arena_parallel_for(Args &&...args)
+{
+    ThreadArena::execute([&]()
+                         { tbb::parallel_for(std::forward<Args>(args)...); });
+};
+
+template <class Range, class RangeBody>
+void arena_parallel_for(Range &&range, RangeBody &&range_body, tbb::affinity_partitioner &partitioner)
+{
+    ThreadArena::execute(
+        [&]()
+        {
+            if (ConcurrentTaskScope::isWithin())
+            {
+                tbb::parallel_for(range, range_body, tbb::auto_partitioner());
+                return;
+            }
+            tbb::parallel_for(range, range_body, partitioner);
+        });
+};
+
+template <class Range, typename Value, class RangeBody, class JoinOperation, typename... Partitioner>
+Value arena_parallel_reduce(const Range &range, const Value &identity, const RangeBody &range_body,
+                            const JoinOperation &join, Partitioner &&...partitioner)
+{
+    return ThreadArena::execute(
+        [&]() -> Value
+        {
+            if (DeterministicReduction::isEnabled())
+            {
+                return tbb::parallel_deterministic_reduce(DeterministicReduction::chunkedRange(range),
+                                                          identity, range_body, join, tbb::simple_partitioner());
+            }
+            return tbb::parallel_reduce(range, identity, range_body, join, std::forward<Partitioner>(partitioner)...);
+        });
+};
+
+template <class Range, typename Value, class RangeBody, class JoinOperation>
+Value arena_parallel_reduce(const Range &range, const Value &identity, const RangeBody &range_body,
+                            const JoinOperation &join, tbb::affinity_partitioner &partitioner)
+{
+    if (ConcurrentTaskScope::isWithin())
+        return arena_parallel_reduce(range, identity, range_body, join, tbb::auto_partitioner());
+    return arena_parallel_reduce<Range, Value, RangeBody, JoinOperation, tbb::affinity_partitioner &>(
+        range, identity, range_body, join, partitioner);
+};
+} // namespace SPH
+#endif // THREAD_ARENA_H
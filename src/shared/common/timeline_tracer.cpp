@@ -0,0 +1,101 @@
+#include "timeline_tracer.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <set>
+
+namespace SPH
+{
+//=================================================================================================//
+std::atomic<bool> TimelineTracer::is_enabled_(false);
+TickCount TimelineTracer::origin_ = TickCount::now();
+tbb::enumerable_thread_specific<StdVec<TimelineTracer::Event>> TimelineTracer::thread_events_;
+//=================================================================================================//
+TimelineTracer::Scope::Scope(const char *category, const std::string &name)
+    : category_(category), name_(nullptr)
+{
+    if (isEnabled())
+    {
+        name_ = &name;
+        start_ = TickCount::now();
+    }
+}
+//=================================================================================================//
+TimelineTracer::Scope::~Scope()
+{
+    if (name_ != nullptr)
+    {
+        TickCount end = TickCount::now();
+        thread_events_.local().push_back(
+            {category_, *name_, 1.0e6 * (start_ - origin_).seconds(),
+             1.0e6 * (end - start_).seconds(), threadIndex()});
+    }
+}
+//=================================================================================================//
+void TimelineTracer::setEnabled(bool is_enabled)
+{
+    if (is_enabled && !isEnabled())
+    {
+        origin_ = TickCount::now();
+    }
+    is_enabled_ = is_enabled;
+}
+//=================================================================================================//
+size_t TimelineTracer::threadIndex()
+{
+    static std::atomic<size_t> number_of_threads(0);
+    thread_local size_t thread_index = number_of_threads++;
+    return thread_index;
+}
+//=================================================================================================//
+void TimelineTracer::clear()
+{
+    for (StdVec<Event> &events : thread_events_)
+        events.clear();
+}
+//=================================================================================================//
+void TimelineTracer::writeToChromeTrace(const std::string &filefullpath)
+{
+    StdVec<Event> all_events;
+    for (StdVec<Event> &events : thread_events_)
+        all_events.insert(all_events.end(), events.begin(), events.end());
+    std::stable_sort(all_events.begin(), all_events.end(),
+                     [](const Event &a, const Event &b)
+                     { return a.start_ < b.start_; });
+
+    auto escaped = [](const std::string &name)
+    {
+        std::string result;
+        for (char c : name)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    };
+
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    out_file << std::fixed << std::setprecision(3);
+    out_file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    std::set<size_t> threads;
+    for (size_t i = 0; i != all_events.size(); ++i)
+    {
+        const Event &event = all_events[i];
+        threads.insert(event.thread_);
+        out_file << (i == 0 ? "\n" : ",\n")
+                 << "  {\"name\": \"" << escaped(event.name_) << "\", \"cat\": \"" << event.category_
+                 << "\", \"ph\": \"X\", \"ts\": " << event.start_ << ", \"dur\": " << event.duration_
+                 << ", \"pid\": 0, \"tid\": " << event.thread_ << "}";
+    }
+    for (size_t thread : threads)
+    {
+        out_file << ",\n  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 0, \"tid\": " << thread
+                 << ", \"args\": {\"name\": \"" << (thread == 0 ? "main" : "thread " + std::to_string(thread)) << "\"}}";
+    }
+    out_file << "\n]}\n";
+    out_file.close();
+}
+//=================================================================================================//
+} // namespace SPH
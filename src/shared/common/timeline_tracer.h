@@ -0,0 +1,89 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	timeline_tracer.h
+ * @brief 	Timeline of the dynamics, output, device synchronization and task graphs.
+ * @details When enabled, each traced scope records its begin time, duration and thread,
+ *          into a buffer of its own thread, so that tracing does not serialize the threads.
+ *          The timeline is written in the Chrome trace event format (JSON),
+ *          which is viewed with chrome://tracing or ui.perfetto.dev.
+ *          Tracing is off by default, and a disabled scope only checks a flag.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef TIMELINE_TRACER_H
+#define TIMELINE_TRACER_H
+
+#include "large_data_containers.h"
+
+#include <tbb/enumerable_thread_specific.h>
+
+#include <atomic>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class TimelineTracer
+ * @brief Process-wide recording of complete events for a timeline.
+ */
+class TimelineTracer
+{
+  public:
+    struct Event
+    {
+        const char *category_;
+        std::string name_;
+        double start_;    /**< in microseconds since the tracing is enabled */
+        double duration_; /**< in microseconds */
+        size_t thread_;
+    };
+
+    /** RAII scope of a traced event, the name is copied only if tracing is enabled
+     *  and should outlive the scope. */
+    class Scope
+    {
+        const char *category_;
+        const std::string *name_;
+        TickCount start_;
+
+      public:
+        Scope(const char *category, const std::string &name);
+        ~Scope();
+    };
+
+    static void setEnabled(bool is_enabled);
+    static bool isEnabled() { return is_enabled_.load(std::memory_order_relaxed); };
+    /** all events recorded so far, written as Chrome trace events */
+    static void writeToChromeTrace(const std::string &filefullpath);
+    static void clear();
+
+  protected:
+    static std::atomic<bool> is_enabled_;
+    static TickCount origin_;
+    static tbb::enumerable_thread_specific<StdVec<Event>> thread_events_;
+    /** small and stable index of the calling thread */
+    static size_t threadIndex();
+};
+} // namespace SPH
+#endif // TIMELINE_TRACER_H
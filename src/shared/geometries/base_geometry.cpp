@@ -1,5 +1,7 @@
 #include "base_geometry.h"
 
+#include "mesh_iterators.hpp"
+
 namespace SPH
 {
 //=================================================================================================//
@@ -46,6 +48,19 @@ Vecd Shape::findNormalDirection(const Vecd &probe_point)
     return is_contain ? direction_to_surface : -1.0 * direction_to_surface;
 }
 //=================================================================================================//
+void Shape::appendContentKey(std::string &key)
+{
+    BoundingBox bounds = getBounds();
+    appendBinaryToKey(key, bounds.first_);
+    appendBinaryToKey(key, bounds.second_);
+    const int samples = 24;
+    Vecd sample_spacing = (bounds.second_ - bounds.first_) / Real(samples);
+    mesh_for_each(Arrayi::Zero(), samples * Arrayi::Ones(), [&](const Arrayi &index)
+                  {
+                      Vecd position = bounds.first_ + (index.cast<Real>().matrix() + 0.5 * Vecd::Ones()).cwiseProduct(sample_spacing);
+                      appendBinaryToKey(key, findSignedDistance(position)); });
+}
+//=================================================================================================//
 bool BinaryShapes::isValid()
 {
     return sub_shapes_and_ops_.size() == 0 ? false : true;
@@ -71,25 +86,47 @@ BoundingBox BinaryShapes::findBounds()
 //=================================================================================================//
 bool BinaryShapes::checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED)
 {
+    if (!is_sub_shape_bins_built_.load(std::memory_order_acquire))
+    {
+        buildSubShapeBins();
+    }
+
     bool exist = false;
     bool inside = false;
+    StdVec<size_t> *sub_shape_bin = findSubShapeBin(pnt);
+    if (sub_shape_bin == nullptr)
+    {
+        return exist;
+    }
 
-    for (auto &sub_shape_and_op : sub_shapes_and_ops_)
+    for (const size_t &index : *sub_shape_bin)
     {
-        Shape *geometry = sub_shape_and_op.first;
-        ShapeBooleanOps operation_string = sub_shape_and_op.second;
+        // a sub-shape not containing the point in its bounds does not change the result
+        if (!sub_shape_bounds_[index].checkContain(pnt))
+        {
+            continue;
+        }
+
+        Shape *geometry = sub_shapes_and_ops_[index].first;
+        ShapeBooleanOps operation_string = sub_shapes_and_ops_[index].second;
         switch (operation_string)
         {
         case ShapeBooleanOps::add:
         {
-            inside = geometry->checkContain(pnt);
-            exist = exist || inside;
+            if (!exist)
+            {
+                inside = geometry->checkContain(pnt);
+                exist = exist || inside;
+            }
             break;
         }
         case ShapeBooleanOps::sub:
         {
-            inside = geometry->checkContain(pnt);
-            exist = exist && (!inside);
+            if (exist)
+            {
+                inside = geometry->checkContain(pnt);
+                exist = exist && (!inside);
+            }
             break;
         }
         default:
@@ -103,6 +140,87 @@ bool BinaryShapes::checkContain(const Vecd &pnt, bool BOUNDARY_INCLUDED)
     return exist;
 }
 //=================================================================================================//
+void BinaryShapes::buildSubShapeBins()
+{
+    std::lock_guard<std::mutex> lock(sub_shape_bins_mutex_);
+    if (is_sub_shape_bins_built_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    size_t number_of_sub_shapes = sub_shapes_and_ops_.size();
+    sub_shape_bounds_.clear();
+    Vecd lower_bound = MaxReal * Vecd::Ones();
+    Vecd upper_bound = MinReal * Vecd::Ones();
+    for (auto &sub_shape_and_op : sub_shapes_and_ops_)
+    {
+        BoundingBox shape_bounds = sub_shape_and_op.first->getBounds();
+        Real margin = 1.0e-3 * (shape_bounds.second_ - shape_bounds.first_).norm() + TinyReal;
+        shape_bounds.first_ -= margin * Vecd::Ones();
+        shape_bounds.second_ += margin * Vecd::Ones();
+        sub_shape_bounds_.push_back(shape_bounds);
+        lower_bound = lower_bound.cwiseMin(shape_bounds.first_);
+        upper_bound = upper_bound.cwiseMax(shape_bounds.second_);
+    }
+    sub_shape_bins_bounds_ = BoundingBox(lower_bound, upper_bound);
+
+    // about eight bins for each sub-shape
+    int bins_per_axis = (int)std::ceil(std::pow(Real(8 * number_of_sub_shapes + 1), 1.0 / Real(Dimensions)));
+    bins_per_axis = SMIN(SMAX(bins_per_axis, 1), 64);
+    number_of_sub_shape_bins_ = bins_per_axis * Arrayi::Ones();
+    sub_shape_bin_spacing_ = (upper_bound - lower_bound) / Real(bins_per_axis);
+    for (int l = 0; l != Dimensions; ++l)
+        sub_shape_bin_spacing_[l] = SMAX(sub_shape_bin_spacing_[l], TinyReal);
+
+    sub_shape_bins_.assign(number_of_sub_shape_bins_.prod(), StdVec<size_t>());
+    for (size_t index = 0; index != number_of_sub_shapes; ++index)
+    {
+        BoundingBox &shape_bounds = sub_shape_bounds_[index];
+        Arrayi lower_bin = Arrayi::Zero();
+        Arrayi upper_bin = Arrayi::Zero();
+        for (int l = 0; l != Dimensions; ++l)
+        {
+            lower_bin[l] = (int)std::floor((shape_bounds.first_[l] - lower_bound[l]) / sub_shape_bin_spacing_[l]);
+            upper_bin[l] = (int)std::floor((shape_bounds.second_[l] - lower_bound[l]) / sub_shape_bin_spacing_[l]) + 1;
+        }
+        lower_bin = lower_bin.max(0).min(bins_per_axis - 1);
+        upper_bin = upper_bin.max(1).min(bins_per_axis);
+
+        Arrayi bin = lower_bin;
+        while (bin[Dimensions - 1] < upper_bin[Dimensions - 1])
+        {
+            size_t linear_index = 0;
+            for (int l = Dimensions - 1; l >= 0; --l)
+                linear_index = linear_index * bins_per_axis + bin[l];
+            sub_shape_bins_[linear_index].push_back(index);
+
+            for (int l = 0; l != Dimensions; ++l)
+            {
+                if (++bin[l] < upper_bin[l] || l == Dimensions - 1)
+                    break;
+                bin[l] = lower_bin[l];
+            }
+        }
+    }
+    is_sub_shape_bins_built_.store(true, std::memory_order_release);
+}
+//=================================================================================================//
+StdVec<size_t> *BinaryShapes::findSubShapeBin(const Vecd &probe_point)
+{
+    if (sub_shapes_and_ops_.empty() || !sub_shape_bins_bounds_.checkContain(probe_point))
+    {
+        return nullptr;
+    }
+
+    size_t linear_index = 0;
+    for (int l = Dimensions - 1; l >= 0; --l)
+    {
+        int bin = (int)std::floor((probe_point[l] - sub_shape_bins_bounds_.first_[l]) / sub_shape_bin_spacing_[l]);
+        linear_index = linear_index * number_of_sub_shape_bins_[l] + SMIN(SMAX(bin, 0), number_of_sub_shape_bins_[l] - 1);
+    }
+    return &sub_shape_bins_[linear_index];
+}
+//=================================================================================================//
 Vecd BinaryShapes::findClosestPoint(const Vecd &probe_point)
 {
     // a big positive number
@@ -127,6 +245,16 @@ Vecd BinaryShapes::findClosestPoint(const Vecd &probe_point)
     return pnt_closest;
 }
 //=================================================================================================//
+void BinaryShapes::appendContentKey(std::string &key)
+{
+    for (auto &sub_shape_and_op : sub_shapes_and_ops_)
+    {
+        key += sub_shape_and_op.first->getName();
+        appendBinaryToKey(key, sub_shape_and_op.second);
+        sub_shape_and_op.first->appendContentKey(key);
+    }
+}
+//=================================================================================================//
 SubShapeAndOp *BinaryShapes::getSubShapeAndOpByName(const std::string &name)
 {
     for (auto &sub_shape_and_op : sub_shapes_and_ops_)
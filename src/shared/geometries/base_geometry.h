@@ -32,10 +32,20 @@
 
 #include "base_data_package.h"
 #include "sphinxsys_containers.h"
+
+#include <atomic>
+#include <mutex>
 #include <string>
 
 namespace SPH
 {
+/** appends the bytes of a value to a raw key, which is hashed later */
+template <typename DataType>
+void appendBinaryToKey(std::string &key, const DataType &value)
+{
+    key.append(reinterpret_cast<const char *>(&value), sizeof(DataType));
+};
+
 /**
  * @class 	ShapeBooleanOps
  * @brief 	Boolean operation for generate complex shapes
@@ -78,9 +88,12 @@ class Shape
     bool checkNotFar(const Vecd &probe_point, Real threshold);
     bool checkNearSurface(const Vecd &probe_point, Real threshold);
     /** Signed distance is negative for point within the shape. */
-    Real findSignedDistance(const Vecd &probe_point);
+    virtual Real findSignedDistance(const Vecd &probe_point);
     /** Normal direction point toward outside of the shape. */
     Vecd findNormalDirection(const Vecd &probe_point);
+    /** Appends the data defining the geometry, e.g. the triangles of a mesh, to the key of cached data.
+     *  The default, for shapes without such data, uses signed distances sampled within the bounds. */
+    virtual void appendContentKey(std::string &key);
 
   protected:
     std::string name_;
@@ -96,12 +109,16 @@ using SubShapeAndOp = std::pair<Shape *, ShapeBooleanOps>;
  * This class has ownership of all shapes by using a unique pointer vector.
  * In this way, add or subtract a shape will call the shape's constructor other than
  * passing the shape pointer.
+ * For containment queries, the sub-shapes are culled by their bounds,
+ * which are binned on a uniform grid so that only the sub-shapes overlapping the bin
+ * of a probe point are checked in the order of the operations.
  */
 class BinaryShapes : public Shape
 {
   public:
-    BinaryShapes() : Shape("BinaryShapes"){};
-    explicit BinaryShapes(const std::string &shape_name) : Shape(shape_name){};
+    BinaryShapes() : Shape("BinaryShapes"), is_sub_shape_bins_built_(false){};
+    explicit BinaryShapes(const std::string &shape_name)
+        : Shape(shape_name), is_sub_shape_bins_built_(false){};
     virtual ~BinaryShapes(){};
 
     template <class SubShapeType, typename... Args>
@@ -110,6 +127,7 @@ class BinaryShapes : public Shape
         Shape *sub_shape = sub_shape_ptrs_keeper_.createPtr<SubShapeType>(std::forward<Args>(args)...);
         SubShapeAndOp sub_shape_and_op(sub_shape, ShapeBooleanOps::add);
         sub_shapes_and_ops_.push_back(sub_shape_and_op);
+        is_sub_shape_bins_built_ = false;
     };
 
     template <class SubShapeType, typename... Args>
@@ -118,6 +136,7 @@ class BinaryShapes : public Shape
         Shape *sub_shape = sub_shape_ptrs_keeper_.createPtr<SubShapeType>(std::forward<Args>(args)...);
         SubShapeAndOp sub_shape_and_op(sub_shape, ShapeBooleanOps::sub);
         sub_shapes_and_ops_.push_back(sub_shape_and_op);
+        is_sub_shape_bins_built_ = false;
     };
 
     virtual bool isValid() override;
@@ -126,12 +145,23 @@ class BinaryShapes : public Shape
     Shape *getSubShapeByName(const std::string &name);
     SubShapeAndOp *getSubShapeAndOpByName(const std::string &name);
     size_t getSubShapeIndexByName(const std::string &name);
+    virtual void appendContentKey(std::string &key) override;
 
   protected:
     UniquePtrsKeeper<Shape> sub_shape_ptrs_keeper_;
     StdVec<SubShapeAndOp> sub_shapes_and_ops_;
+    std::atomic<bool> is_sub_shape_bins_built_; /**< reset when the sub-shapes are changed */
+    std::mutex sub_shape_bins_mutex_;
+    StdVec<BoundingBox> sub_shape_bounds_; /**< slightly enlarged bounds of the sub-shapes */
+    BoundingBox sub_shape_bins_bounds_;
+    Arrayi number_of_sub_shape_bins_;
+    Vecd sub_shape_bin_spacing_;
+    StdVec<StdVec<size_t>> sub_shape_bins_; /**< indexes of the sub-shapes overlapping each bin */
 
     virtual BoundingBox findBounds() override;
+    void buildSubShapeBins();
+    /** the sub-shapes to be checked for the probe point, nullptr if out of all sub-shape bounds */
+    StdVec<size_t> *findSubShapeBin(const Vecd &probe_point);
 };
 
 /**
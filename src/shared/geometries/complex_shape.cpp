@@ -3,6 +3,36 @@
 namespace SPH
 {
 //=================================================================================================//
+bool ComplexShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
+{
+    return baked_level_set_ != nullptr
+               ? baked_level_set_->checkContain(probe_point, BOUNDARY_INCLUDED)
+               : BinaryShapes::checkContain(probe_point, BOUNDARY_INCLUDED);
+}
+//=================================================================================================//
+Vecd ComplexShape::findClosestPoint(const Vecd &probe_point)
+{
+    return baked_level_set_ != nullptr
+               ? baked_level_set_->findClosestPoint(probe_point)
+               : BinaryShapes::findClosestPoint(probe_point);
+}
+//=================================================================================================//
+Real ComplexShape::findSignedDistance(const Vecd &probe_point)
+{
+    return baked_level_set_ != nullptr
+               ? baked_level_set_->findSignedDistance(probe_point)
+               : BinaryShapes::findSignedDistance(probe_point);
+}
+//=================================================================================================//
+LevelSetShape *ComplexShape::bakeLevelSet(SPHBody &sph_body, Real refinement_ratio)
+{
+    // the level set is built from the sub-shapes before it is used for the queries
+    baked_level_set_ = nullptr;
+    LevelSetShape *level_set_shape = baked_level_set_keeper_.createPtr<LevelSetShape>(sph_body, *this, refinement_ratio);
+    baked_level_set_ = level_set_shape;
+    return level_set_shape;
+}
+//=================================================================================================//
 bool AlignedBoxShape::checkInBounds(const Vecd &probe_point, Real lower_bound_fringe, Real upper_bound_fringe)
 {
     Vecd position_in_frame = transform_.shiftBaseStationToFrame(probe_point);
@@ -47,14 +47,24 @@ class LevelSetShape;
  * However, if only the contain function
  * is used, for example generating particles using lattice generator,
  * partially overlapped shapes are allowed.
+ * Optionally, a level set of the whole complex shape can be baked,
+ * after which the queries are answered by the level set
+ * independent of the number of sub-shapes.
  **/
 class ComplexShape : public BinaryShapes
 {
   public:
     explicit ComplexShape(const std::string &shape_name)
-        : BinaryShapes(shape_name){};
+        : BinaryShapes(shape_name), baked_level_set_(nullptr){};
     virtual ~ComplexShape(){};
 
+    virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override;
+    virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual Real findSignedDistance(const Vecd &probe_point) override;
+    /** bake the level set of the composite shape, which is used for all later queries */
+    LevelSetShape *bakeLevelSet(SPHBody &sph_body, Real refinement_ratio = 1.0);
+    bool isLevelSetBaked() { return baked_level_set_ != nullptr; };
+
     template <typename... Args>
     LevelSetShape *defineLevelSetShape(SPHBody &sph_body, const std::string &shape_name, Args &&...args)
     {
@@ -62,8 +72,13 @@ class ComplexShape : public BinaryShapes
         LevelSetShape *level_set_shape = sub_shape_ptrs_keeper_[index].createPtr<LevelSetShape>(
             sph_body, *sub_shapes_and_ops_[index].first, std::forward<Args>(args)...);
         sub_shapes_and_ops_[index].first = DynamicCast<Shape>(this, level_set_shape);
+        is_sub_shape_bins_built_ = false;
         return level_set_shape;
     };
+
+  protected:
+    UniquePtrKeeper<LevelSetShape> baked_level_set_keeper_;
+    LevelSetShape *baked_level_set_;
 };
 
 using DefaultShape = ComplexShape;
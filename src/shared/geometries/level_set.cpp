@@ -9,7 +9,9 @@ namespace SPH
 MultilevelLevelSet::MultilevelLevelSet(
     BoundingBox tentative_bounds, Real reference_data_spacing, size_t total_levels,
     Shape &shape, SPHAdaptation &sph_adaptation)
-    : BaseMeshField("LevelSet_" + shape.getName()), kernel_(*sph_adaptation.getKernel()), shape_(shape), total_levels_(total_levels)
+    : BaseMeshField("LevelSet_" + shape.getName()), kernel_(*sph_adaptation.getKernel()), shape_(shape), total_levels_(total_levels),
+      is_restored_(false), kernel_integrals_on_demand_(sph_adaptation.LevelSetKernelIntegralsOnDemand()),
+      is_construction_reported_(sph_adaptation.LevelSetConstructionReport())
 {
     Real global_h_ratio = sph_adaptation.ReferenceSpacing() / reference_data_spacing;
     global_h_ratio_vec_.push_back(global_h_ratio);
@@ -24,13 +26,15 @@ MultilevelLevelSet::MultilevelLevelSet(
         initializeLevel(level, reference_data_spacing, global_h_ratio, tentative_bounds);
     }
 
-    clean_interface = makeUnique<CleanInterface>(*mesh_data_set_.back(), kernel_, global_h_ratio_vec_.back());
-    correct_topology = makeUnique<CorrectTopology>(*mesh_data_set_.back(), kernel_, global_h_ratio_vec_.back());
+    clean_interface = makeUnique<CleanInterface>(*mesh_data_set_.back());
+    correct_topology = makeUnique<CorrectTopology>(*mesh_data_set_.back());
 }
 //=================================================================================================//
 MultilevelLevelSet::MultilevelLevelSet(
     BoundingBox tentative_bounds, MeshWithGridDataPackagesType* coarse_data, Shape &shape, SPHAdaptation &sph_adaptation)
-    : BaseMeshField("LevelSet_" + shape.getName()), kernel_(*sph_adaptation.getKernel()), shape_(shape), total_levels_(1)
+    : BaseMeshField("LevelSet_" + shape.getName()), kernel_(*sph_adaptation.getKernel()), shape_(shape), total_levels_(1),
+      is_restored_(false), kernel_integrals_on_demand_(sph_adaptation.LevelSetKernelIntegralsOnDemand()),
+      is_construction_reported_(sph_adaptation.LevelSetConstructionReport())
 {
     Real reference_data_spacing = coarse_data->DataSpacing() * 0.5;
     Real global_h_ratio = sph_adaptation.ReferenceSpacing() / reference_data_spacing;
@@ -38,8 +42,70 @@ MultilevelLevelSet::MultilevelLevelSet(
 
     initializeLevel(0, reference_data_spacing, global_h_ratio, tentative_bounds, coarse_data);
 
-    clean_interface = makeUnique<CleanInterface>(*mesh_data_set_.back(), kernel_, global_h_ratio_vec_.back());
-    correct_topology = makeUnique<CorrectTopology>(*mesh_data_set_.back(), kernel_, global_h_ratio_vec_.back());
+    clean_interface = makeUnique<CleanInterface>(*mesh_data_set_.back());
+    correct_topology = makeUnique<CorrectTopology>(*mesh_data_set_.back());
+}
+//=================================================================================================//
+MultilevelLevelSet::MultilevelLevelSet(
+    BoundingBox tentative_bounds, BinaryDataReader &binary_reader, Shape &shape, SPHAdaptation &sph_adaptation)
+    : BaseMeshField("LevelSet_" + shape.getName()), kernel_(*sph_adaptation.getKernel()), shape_(shape),
+      total_levels_(0), is_restored_(false), kernel_integrals_on_demand_(false), // all data is restored
+      is_construction_reported_(false)
+{
+    UnsignedInt total_levels = 0;
+    if (!binary_reader.hasVariable<UnsignedInt>("TotalLevels", 1) ||
+        binary_reader.readVariable<UnsignedInt>("TotalLevels", &total_levels, 1) != 1 || total_levels == 0 ||
+        !binary_reader.hasVariable<Real>("DataSpacings", total_levels) ||
+        !binary_reader.hasVariable<Real>("GlobalHRatios", total_levels))
+        return;
+
+    StdVec<Real> data_spacings(total_levels);
+    global_h_ratio_vec_.resize(total_levels);
+    binary_reader.readVariable<Real>("DataSpacings", data_spacings.data(), total_levels);
+    binary_reader.readVariable<Real>("GlobalHRatios", global_h_ratio_vec_.data(), total_levels);
+
+    total_levels_ = total_levels;
+    for (size_t level = 0; level != total_levels_; ++level)
+    {
+        mesh_data_set_.push_back(
+            mesh_data_ptr_vector_keeper_
+                .template createPtr<MeshWithGridDataPackagesType>(tentative_bounds, data_spacings[level], 4));
+
+        RegisterMeshVariable register_mesh_variable;
+        register_mesh_variable.exec(mesh_data_set_[level]);
+
+        if (!mesh_data_set_[level]->readMeshFromBinary(binary_reader, levelPrefix(level)))
+            return;
+
+        registerProbes(level);
+    }
+
+    clean_interface = makeUnique<CleanInterface>(*mesh_data_set_.back());
+    correct_topology = makeUnique<CorrectTopology>(*mesh_data_set_.back());
+    is_restored_ = true;
+}
+//=================================================================================================//
+void MultilevelLevelSet::writeToBinary(BinaryDataWriter &binary_writer)
+{
+    prepareAllKernelIntegrals();
+    UnsignedInt total_levels = total_levels_;
+    binary_writer.writeVariable<UnsignedInt>("TotalLevels", &total_levels, 1);
+    StdVec<Real> data_spacings;
+    for (size_t level = 0; level != total_levels_; ++level)
+        data_spacings.push_back(mesh_data_set_[level]->DataSpacing());
+    binary_writer.writeVariable<Real>("DataSpacings", data_spacings.data(), total_levels_);
+    binary_writer.writeVariable<Real>("GlobalHRatios", global_h_ratio_vec_.data(), total_levels_);
+
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_data_set_[level]->writeMeshToBinary(binary_writer, levelPrefix(level));
+}
+//=================================================================================================//
+bool MultilevelLevelSet::readMeshVariablesFromBinary(BinaryDataReader &binary_reader)
+{
+    bool is_complete = true;
+    for (size_t level = 0; level != total_levels_; ++level)
+        is_complete = is_complete && mesh_data_set_[level]->readMeshVariablesFromBinary(binary_reader, levelPrefix(level));
+    return is_complete;
 }
 //=================================================================================================//
 void MultilevelLevelSet::initializeLevel(size_t level, Real reference_data_spacing, Real global_h_ratio, BoundingBox tentative_bounds, MeshWithGridDataPackagesType* coarse_data)
@@ -51,6 +117,7 @@ void MultilevelLevelSet::initializeLevel(size_t level, Real reference_data_spaci
     RegisterMeshVariable register_mesh_variable;
     register_mesh_variable.exec(mesh_data_set_[level]);
 
+    TickCount t0 = TickCount::now();
     if (coarse_data == nullptr) {
         MeshAllDynamics<InitializeDataInACell> initialize_data_in_a_cell(*mesh_data_set_[level], shape_);
         initialize_data_in_a_cell.exec();
@@ -59,10 +126,23 @@ void MultilevelLevelSet::initializeLevel(size_t level, Real reference_data_spaci
         initialize_data_in_a_cell_from_coarse.exec();
     }
 
-    FinishDataPackages finish_data_packages(*mesh_data_set_[level], shape_, kernel_, global_h_ratio);
+    TickCount t1 = TickCount::now();
+    FinishDataPackages finish_data_packages(*mesh_data_set_[level], shape_);
     finish_data_packages.exec();
 
+    TickCount t2 = TickCount::now();
     registerProbes(level);
+    updateKernelIntegrals(level);
+
+    if (is_construction_reported_)
+    {
+        TickCount t3 = TickCount::now();
+        std::cout << "\n Level set of " << shape_.getName() << " level " << level << ": "
+                  << mesh_data_set_[level]->num_grid_pkgs_ - 2 << " packages with data spacing "
+                  << mesh_data_set_[level]->DataSpacing() << ", cell initialization "
+                  << (t1 - t0).seconds() << " s, package data " << (t2 - t1).seconds()
+                  << " s, kernel integrals " << (t3 - t2).seconds() << " s." << std::endl;
+    }
 }
 //=================================================================================================//
 void MultilevelLevelSet::registerProbes(size_t level)
@@ -82,6 +162,30 @@ void MultilevelLevelSet::registerProbes(size_t level)
     probe_kernel_gradient_integral_set_.push_back(
         probe_kernel_gradient_integral_vector_keeper_
             .template createPtr<ProbeKernelGradientIntegral>(*mesh_data_set_[level]));
+    kernel_integrals_on_demand_set_.push_back(
+        kernel_integrals_on_demand_vector_keeper_
+            .template createPtr<KernelIntegralsOnDemand>(*mesh_data_set_[level], kernel_, global_h_ratio_vec_[level]));
+}
+//=================================================================================================//
+void MultilevelLevelSet::updateKernelIntegrals(size_t level)
+{
+    if (kernel_integrals_on_demand_)
+    {
+        kernel_integrals_on_demand_set_[level]->resetPackages();
+        return;
+    }
+    MeshInnerDynamics<UpdateKernelIntegrals> update_kernel_integrals(
+        *mesh_data_set_[level], kernel_, global_h_ratio_vec_[level]);
+    update_kernel_integrals.exec();
+}
+//=================================================================================================//
+void MultilevelLevelSet::prepareAllKernelIntegrals()
+{
+    if (kernel_integrals_on_demand_)
+    {
+        for (size_t level = 0; level != total_levels_; ++level)
+            kernel_integrals_on_demand_set_[level]->prepareAllPackages();
+    }
 }
 //=================================================================================================//
 size_t MultilevelLevelSet::getCoarseLevel(Real h_ratio)
@@ -99,11 +203,13 @@ size_t MultilevelLevelSet::getCoarseLevel(Real h_ratio)
 void MultilevelLevelSet::cleanInterface(Real small_shift_factor)
 {
     clean_interface->exec(small_shift_factor);
+    updateKernelIntegrals(total_levels_ - 1);
 }
 //=============================================================================================//
 void MultilevelLevelSet::correctTopology(Real small_shift_factor)
 {
     correct_topology->exec(small_shift_factor);
+    updateKernelIntegrals(total_levels_ - 1);
 }
 //=============================================================================================//
 Real MultilevelLevelSet::probeSignedDistance(const Vecd &position)
@@ -134,11 +240,14 @@ size_t MultilevelLevelSet::getProbeLevel(const Vecd &position)
 Real MultilevelLevelSet::probeKernelIntegral(const Vecd &position, Real h_ratio)
 {
     if(mesh_data_set_.size() == 1){
+        prepareKernelIntegrals(0, position);
         return probe_kernel_integral_set_[0]->update(position);
     }
     size_t coarse_level = getCoarseLevel(h_ratio);
     Real alpha = (global_h_ratio_vec_[coarse_level + 1] - h_ratio) /
                  (global_h_ratio_vec_[coarse_level + 1] - global_h_ratio_vec_[coarse_level]);
+    prepareKernelIntegrals(coarse_level, position);
+    prepareKernelIntegrals(coarse_level + 1, position);
     Real coarse_level_value = probe_kernel_integral_set_[coarse_level]->update(position);
     Real fine_level_value = probe_kernel_integral_set_[coarse_level + 1]->update(position);
 
@@ -148,17 +257,95 @@ Real MultilevelLevelSet::probeKernelIntegral(const Vecd &position, Real h_ratio)
 Vecd MultilevelLevelSet::probeKernelGradientIntegral(const Vecd &position, Real h_ratio)
 {
     if(mesh_data_set_.size() == 1){
+        prepareKernelIntegrals(0, position);
         return probe_kernel_gradient_integral_set_[0]->update(position);
     }
     size_t coarse_level = getCoarseLevel(h_ratio);
     Real alpha = (global_h_ratio_vec_[coarse_level + 1] - h_ratio) /
                  (global_h_ratio_vec_[coarse_level + 1] - global_h_ratio_vec_[coarse_level]);
+    prepareKernelIntegrals(coarse_level, position);
+    prepareKernelIntegrals(coarse_level + 1, position);
     Vecd coarse_level_value = probe_kernel_gradient_integral_set_[coarse_level]->update(position);
     Vecd fine_level_value = probe_kernel_gradient_integral_set_[coarse_level + 1]->update(position);
 
     return alpha * coarse_level_value + (1.0 - alpha) * fine_level_value;
 }
 //=================================================================================================//
+StdVec<size_t> MultilevelLevelSet::sortProbesByCell(const Vecd *positions, size_t number_of_probes)
+{
+    MeshWithGridDataPackagesType &finest_mesh = *mesh_data_set_.back();
+    StdVec<std::pair<size_t, size_t>> cell_probe_pairs(number_of_probes);
+    arena_parallel_for(
+        IndexRange(0, number_of_probes),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+                cell_probe_pairs[i] = std::make_pair(finest_mesh.LinearCellIndexFromPosition(positions[i]), i);
+        },
+        ap);
+    tbb::parallel_sort(cell_probe_pairs.begin(), cell_probe_pairs.end());
+
+    StdVec<size_t> sorted_order(number_of_probes);
+    for (size_t i = 0; i != number_of_probes; ++i)
+        sorted_order[i] = cell_probe_pairs[i].second;
+    return sorted_order;
+}
+//=================================================================================================//
+template <typename DataType, typename ProbeFunction>
+void MultilevelLevelSet::probeInCellOrder(const Vecd *positions, size_t number_of_probes, DataType *values,
+                                          const ProbeFunction &probe_function)
+{
+    StdVec<size_t> sorted_order = sortProbesByCell(positions, number_of_probes);
+    arena_parallel_for(
+        IndexRange(0, number_of_probes),
+        [&](const IndexRange &r)
+        {
+            for (size_t n = r.begin(); n < r.end(); ++n)
+            {
+                size_t i = sorted_order[n];
+                values[i] = probe_function(i);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeSignedDistance(const Vecd *positions, size_t number_of_probes, Real *signed_distances)
+{
+    probeInCellOrder(positions, number_of_probes, signed_distances,
+                     [&](size_t i)
+                     { return probeSignedDistance(positions[i]); });
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeNormalDirection(const Vecd *positions, size_t number_of_probes, Vecd *normal_directions)
+{
+    probeInCellOrder(positions, number_of_probes, normal_directions,
+                     [&](size_t i)
+                     { return probeNormalDirection(positions[i]); });
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeLevelSetGradient(const Vecd *positions, size_t number_of_probes, Vecd *gradients)
+{
+    probeInCellOrder(positions, number_of_probes, gradients,
+                     [&](size_t i)
+                     { return probeLevelSetGradient(positions[i]); });
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeKernelIntegral(const Vecd *positions, size_t number_of_probes, Real *integrals,
+                                             const Real *h_ratios)
+{
+    probeInCellOrder(positions, number_of_probes, integrals,
+                     [&](size_t i)
+                     { return probeKernelIntegral(positions[i], h_ratios == nullptr ? 1.0 : h_ratios[i]); });
+}
+//=================================================================================================//
+void MultilevelLevelSet::probeKernelGradientIntegral(const Vecd *positions, size_t number_of_probes,
+                                                     Vecd *gradient_integrals, const Real *h_ratios)
+{
+    probeInCellOrder(positions, number_of_probes, gradient_integrals,
+                     [&](size_t i)
+                     { return probeKernelGradientIntegral(positions[i], h_ratios == nullptr ? 1.0 : h_ratios[i]); });
+}
+//=================================================================================================//
 bool MultilevelLevelSet::probeIsWithinMeshBound(const Vecd &position)
 {
     bool is_bounded = true;
@@ -47,6 +47,8 @@ class MultilevelLevelSet : public BaseMeshField
   public:
     MultilevelLevelSet(BoundingBox tentative_bounds, Real reference_data_spacing, size_t total_levels, Shape &shape, SPHAdaptation &sph_adaptation);
     MultilevelLevelSet(BoundingBox tentative_bounds, MeshWithGridDataPackagesType* coarse_data, Shape &shape, SPHAdaptation &sph_adaptation);
+    /** restore all levels from a binary file written by writeToBinary, check isRestored() after construction */
+    MultilevelLevelSet(BoundingBox tentative_bounds, BinaryDataReader &binary_reader, Shape &shape, SPHAdaptation &sph_adaptation);
     ~MultilevelLevelSet(){};
 
     void cleanInterface(Real small_shift_factor);
@@ -59,37 +61,78 @@ class MultilevelLevelSet : public BaseMeshField
     Real probeKernelIntegral(const Vecd &position);
     Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0);
     Vecd probeKernelGradientIntegral(const Vecd &position);
+    /** probe a batch of positions, the probes are grouped by cells of the finest level for data locality */
+    void probeSignedDistance(const Vecd *positions, size_t number_of_probes, Real *signed_distances);
+    void probeNormalDirection(const Vecd *positions, size_t number_of_probes, Vecd *normal_directions);
+    void probeLevelSetGradient(const Vecd *positions, size_t number_of_probes, Vecd *gradients);
+    /** the h_ratios are given for each probe, or all equal to 1.0 if nullptr */
+    void probeKernelIntegral(const Vecd *positions, size_t number_of_probes, Real *integrals,
+                             const Real *h_ratios = nullptr);
+    void probeKernelGradientIntegral(const Vecd *positions, size_t number_of_probes, Vecd *gradient_integrals,
+                                     const Real *h_ratios = nullptr);
     StdVec<MeshWithGridDataPackagesType *> getMeshLevels() { return mesh_data_set_; };
+    StdVec<Real> getGlobalHRatios() { return global_h_ratio_vec_; };
+    bool isRestored() { return is_restored_; };
+    void writeToBinary(BinaryDataWriter &binary_writer);
+    /** restore the data of all levels, e.g. after cleaning the interface, the package structure is kept */
+    bool readMeshVariablesFromBinary(BinaryDataReader &binary_reader);
+    /** compute the kernel integrals not yet computed on demand, e.g. before all data is written or copied */
+    void prepareAllKernelIntegrals();
 
     void writeMeshFieldToPlt(std::ofstream &output_file) override
     {
+        prepareAllKernelIntegrals();
         for(size_t l = 0; l != total_levels_; ++l)
             WriteMeshFieldToPlt(*mesh_data_set_[l]).update(output_file);
     }
+    void writeMeshFieldToBinaryPlt(TecplotBinaryWriter &binary_writer) override
+    {
+        prepareAllKernelIntegrals();
+        for (size_t l = 0; l != total_levels_; ++l)
+            WriteMeshFieldToPlt(*mesh_data_set_[l]).update(binary_writer, Name() + "_level_" + std::to_string(l));
+    }
 
   protected:
     inline size_t getProbeLevel(const Vecd &position);
     inline size_t getCoarseLevel(Real h_ratio);
+    void prepareKernelIntegrals(size_t level, const Vecd &position)
+    {
+        if (kernel_integrals_on_demand_)
+            kernel_integrals_on_demand_set_[level]->preparePackages(position);
+    };
+    /** the order of the probes sorted by their cells on the finest level */
+    StdVec<size_t> sortProbesByCell(const Vecd *positions, size_t number_of_probes);
+    template <typename DataType, typename ProbeFunction>
+    void probeInCellOrder(const Vecd *positions, size_t number_of_probes, DataType *values,
+                          const ProbeFunction &probe_function);
 
     void initializeLevel(size_t level, Real reference_data_spacing, Real global_h_ratio, BoundingBox tentative_bounds, MeshWithGridDataPackagesType* coarse_data = nullptr);
     void registerProbes(size_t level);
+    /** computes the kernel integrals of a level, or resets them to be computed on demand */
+    void updateKernelIntegrals(size_t level);
+    std::string levelPrefix(size_t level) { return "Level" + std::to_string(level) + "_"; };
 
     Kernel &kernel_;
     Shape &shape_;                           /**< the geometry is described by the level set. */
     size_t total_levels_;                    /**< level 0 is the coarsest */
     StdVec<Real> global_h_ratio_vec_;
+    bool is_restored_;                       /**< false if restoring from a binary file failed */
+    bool kernel_integrals_on_demand_;        /**< kernel integrals of a package are computed when first probed */
+    bool is_construction_reported_;          /**< the packages and timing of each level are reported */
     StdVec<MeshWithGridDataPackagesType *> mesh_data_set_;
     StdVec<ProbeSignedDistance *> probe_signed_distance_set_;
     StdVec<ProbeNormalDirection *> probe_normal_direction_set_;
     StdVec<ProbeLevelSetGradient *> probe_level_set_gradient_set_;
     StdVec<ProbeKernelIntegral *> probe_kernel_integral_set_;
     StdVec<ProbeKernelGradientIntegral *> probe_kernel_gradient_integral_set_;
+    StdVec<KernelIntegralsOnDemand *> kernel_integrals_on_demand_set_;
     UniquePtrsKeeper<MeshWithGridDataPackagesType> mesh_data_ptr_vector_keeper_;
     UniquePtrsKeeper<ProbeSignedDistance> probe_signed_distance_vector_keeper_;
     UniquePtrsKeeper<ProbeNormalDirection> probe_normal_direction_vector_keeper_;
     UniquePtrsKeeper<ProbeLevelSetGradient> probe_level_set_gradient_vector_keeper_;
     UniquePtrsKeeper<ProbeKernelIntegral> probe_kernel_integral_vector_keeper_;
     UniquePtrsKeeper<ProbeKernelGradientIntegral> probe_kernel_gradient_integral_vector_keeper_;
+    UniquePtrsKeeper<KernelIntegralsOnDemand> kernel_integrals_on_demand_vector_keeper_;
 
     UniquePtr<CleanInterface> clean_interface;
     UniquePtr<CorrectTopology> correct_topology;
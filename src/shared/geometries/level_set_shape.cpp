@@ -4,27 +4,122 @@
 #include "io_all.h"
 #include "sph_system.h"
 
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
 namespace SPH
 {
 //=================================================================================================//
 LevelSetShape::
     LevelSetShape(Shape &shape, SharedPtr<SPHAdaptation> sph_adaptation, Real refinement_ratio)
     : Shape(shape.getName()), sph_adaptation_(sph_adaptation),
-      level_set_(*level_set_keeper_.movePtr(sph_adaptation->createLevelSet(shape, refinement_ratio)))
+      level_set_(*level_set_keeper_.movePtr(sph_adaptation->createLevelSet(shape, refinement_ratio))),
+      level_set_ck_(nullptr)
 {
-    bounding_box_ = shape.getBounds();
+    initial_bounds_ = shape.getBounds();
+    bounding_box_ = initial_bounds_;
     is_bounds_found_ = true;
 }
 //=================================================================================================//
 LevelSetShape::LevelSetShape(SPHBody &sph_body, Shape &shape, Real refinement_ratio)
     : Shape(shape.getName()),
-      level_set_(*level_set_keeper_.movePtr(
-          sph_body.sph_adaptation_->createLevelSet(shape, refinement_ratio)))
+      level_set_(*level_set_keeper_.movePtr(createLevelSet(sph_body, shape, refinement_ratio))),
+      level_set_ck_(nullptr)
 {
-    bounding_box_ = shape.getBounds();
+    initial_bounds_ = shape.getBounds();
+    bounding_box_ = initial_bounds_;
     is_bounds_found_ = true;
 }
 //=================================================================================================//
+UniquePtr<MultilevelLevelSet> LevelSetShape::
+    createLevelSet(SPHBody &sph_body, Shape &shape, Real refinement_ratio)
+{
+    SPHAdaptation &sph_adaptation = *sph_body.sph_adaptation_;
+    SPHSystem &sph_system = sph_body.getSPHSystem();
+    if (!sph_system.LevelSetCache())
+    {
+        return sph_adaptation.createLevelSet(shape, refinement_ratio);
+    }
+
+    cache_folder_ = sph_system.getIOEnvironment().reload_folder_ + "/level_set_cache";
+    if (!fs::exists(cache_folder_))
+    {
+        fs::create_directories(cache_folder_);
+    }
+
+    // the geometry is keyed by its name, bounds and the data defining it, e.g. the triangles of a mesh
+    BoundingBox bounds = shape.getBounds();
+    appendToCacheKey(uint64_t(Dimensions));
+    appendToCacheKey(uint64_t(sizeof(Real)));
+    cache_key_ += shape.getName();
+    appendToCacheKey(bounds.first_);
+    appendToCacheKey(bounds.second_);
+    std::string content_key;
+    shape.appendContentKey(content_key);
+    appendToCacheKey(uint64_t(content_key.size()));
+    appendToCacheKey(hashBinaryData(content_key.data(), content_key.size()));
+    appendToCacheKey(refinement_ratio);
+    appendToCacheKey(sph_adaptation.ReferenceSpacing());
+    appendToCacheKey(sph_adaptation.MinimumSpacing());
+    appendToCacheKey(sph_adaptation.ReferenceSmoothingLength());
+    appendToCacheKey(sph_adaptation.LocalRefinementLevel());
+    cache_key_ += sph_adaptation.getKernel()->Name();
+
+    std::string filefullpath = cacheFileFullPath();
+    if (fs::exists(filefullpath))
+    {
+        // an invalid or incomplete cache file is rebuilt
+        BinaryDataReader binary_reader(filefullpath, false);
+        UniquePtr<MultilevelLevelSet> level_set =
+            makeUnique<MultilevelLevelSet>(bounds, binary_reader, shape, sph_adaptation);
+        if (level_set->isRestored())
+        {
+            std::cout << "\n Reading the level set of " << shape.getName()
+                      << " from the cache " << filefullpath << std::endl;
+            return level_set;
+        }
+    }
+
+    UniquePtr<MultilevelLevelSet> level_set = sph_adaptation.createLevelSet(shape, refinement_ratio);
+    writeToCache(*level_set);
+    return level_set;
+}
+//=================================================================================================//
+std::string LevelSetShape::cacheFileFullPath()
+{
+    std::ostringstream hash_string;
+    hash_string << std::hex << std::setw(16) << std::setfill('0') << hashBinaryData(cache_key_.data(), cache_key_.size());
+    return cache_folder_ + "/" + getName() + "_" + hash_string.str() + ".bin";
+}
+//=================================================================================================//
+void LevelSetShape::writeToCache(MultilevelLevelSet &level_set)
+{
+    // written under a temporary name and renamed, to be safe for concurrent runs sharing the cache
+    std::string filefullpath = cacheFileFullPath();
+    std::ostringstream temporary_name;
+    temporary_name << filefullpath << "." << std::hex << std::hash<std::thread::id>{}(std::this_thread::get_id())
+                   << "_" << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    {
+        BinaryDataWriter binary_writer(temporary_name.str());
+        level_set.writeToBinary(binary_writer);
+        binary_writer.finalize();
+    }
+    fs::rename(temporary_name.str(), filefullpath);
+}
+//=================================================================================================//
+bool LevelSetShape::readFromCache()
+{
+    std::string filefullpath = cacheFileFullPath();
+    if (!fs::exists(filefullpath))
+    {
+        return false;
+    }
+    BinaryDataReader binary_reader(filefullpath, false);
+    return binary_reader.isValid() && level_set_.readMeshVariablesFromBinary(binary_reader);
+}
+//=================================================================================================//
 void LevelSetShape::writeLevelSet(SPHSystem &sph_system)
 {
     MeshRecordingToPlt write_level_set_to_plt(sph_system, level_set_);
@@ -33,26 +128,56 @@ void LevelSetShape::writeLevelSet(SPHSystem &sph_system)
 //=================================================================================================//
 LevelSetShape *LevelSetShape::cleanLevelSet(Real small_shift_factor)
 {
-    level_set_.cleanInterface(small_shift_factor);
+    if (cache_key_.empty())
+    {
+        level_set_.cleanInterface(small_shift_factor);
+        return this;
+    }
+
+    cache_key_ += "CleanInterface";
+    appendToCacheKey(small_shift_factor);
+    if (!readFromCache())
+    {
+        level_set_.cleanInterface(small_shift_factor);
+        writeToCache(level_set_);
+    }
     return this;
 }
 //=================================================================================================//
 LevelSetShape *LevelSetShape::correctLevelSetSign(Real small_shift_factor)
 {
-    level_set_.correctTopology(small_shift_factor);
+    if (cache_key_.empty())
+    {
+        level_set_.correctTopology(small_shift_factor);
+        return this;
+    }
+
+    cache_key_ += "CorrectTopology";
+    appendToCacheKey(small_shift_factor);
+    if (!readFromCache())
+    {
+        level_set_.correctTopology(small_shift_factor);
+        writeToCache(level_set_);
+    }
     return this;
 }
 //=================================================================================================//
 bool LevelSetShape::checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED)
 {
-    return level_set_.probeSignedDistance(probe_point) < 0.0 ? true : false;
+    return level_set_.probeSignedDistance(rigid_motion_.shiftBaseStationToFrame(probe_point)) < 0.0 ? true : false;
 }
 //=================================================================================================//
 Vecd LevelSetShape::findClosestPoint(const Vecd &probe_point)
 {
-    Real phi = level_set_.probeSignedDistance(probe_point);
-    Vecd normal = level_set_.probeNormalDirection(probe_point);
-    return probe_point - phi * normal;
+    Vecd frame_point = rigid_motion_.shiftBaseStationToFrame(probe_point);
+    Real phi = level_set_.probeSignedDistance(frame_point);
+    Vecd normal = level_set_.probeNormalDirection(frame_point);
+    return probe_point - phi * rigid_motion_.xformFrameVecToBase(normal);
+}
+//=================================================================================================//
+Real LevelSetShape::findSignedDistance(const Vecd &probe_point)
+{
+    return level_set_.probeSignedDistance(rigid_motion_.shiftBaseStationToFrame(probe_point));
 }
 //=================================================================================================//
 BoundingBox LevelSetShape::findBounds()
@@ -66,19 +191,63 @@ BoundingBox LevelSetShape::findBounds()
     return bounding_box_;
 }
 //=================================================================================================//
+void LevelSetShape::setRigidMotion(const Transform &rigid_motion)
+{
+    rigid_motion_ = rigid_motion;
+    // the bounds enclosing the moved corners of the initial bounds
+    Vecd lower_bound = MaxReal * Vecd::Ones();
+    Vecd upper_bound = MinReal * Vecd::Ones();
+    mesh_for_each(Arrayi::Zero(), 2 * Arrayi::Ones(), [&](const Arrayi &corner)
+                  {
+                      Vecd initial_corner = initial_bounds_.first_;
+                      for (int l = 0; l != Dimensions; ++l)
+                          initial_corner[l] = corner[l] == 0 ? initial_bounds_.first_[l] : initial_bounds_.second_[l];
+                      Vecd moved_corner = rigid_motion_.shiftFrameStationToBase(initial_corner);
+                      lower_bound = lower_bound.cwiseMin(moved_corner);
+                      upper_bound = upper_bound.cwiseMax(moved_corner); });
+    bounding_box_ = BoundingBox(lower_bound, upper_bound);
+}
+//=================================================================================================//
+void LevelSetShape::setRigidMotionFunction(const RigidMotionFunction &rigid_motion_function)
+{
+    rigid_motion_function_ = rigid_motion_function;
+}
+//=================================================================================================//
+void LevelSetShape::updateRigidMotion(Real time)
+{
+    if (!rigid_motion_function_)
+    {
+        std::cout << "\n FAILURE: The rigid motion function of " << getName() << " is not set!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    setRigidMotion(rigid_motion_function_(time));
+}
+//=================================================================================================//
 Vecd LevelSetShape::findLevelSetGradient(const Vecd &probe_point)
 {
-    return level_set_.probeLevelSetGradient(probe_point);
+    return rigid_motion_.xformFrameVecToBase(
+        level_set_.probeLevelSetGradient(rigid_motion_.shiftBaseStationToFrame(probe_point)));
 }
 //=================================================================================================//
 Real LevelSetShape::computeKernelIntegral(const Vecd &probe_point, Real h_ratio)
 {
-    return level_set_.probeKernelIntegral(probe_point, h_ratio);
+    return level_set_.probeKernelIntegral(rigid_motion_.shiftBaseStationToFrame(probe_point), h_ratio);
 }
 //=================================================================================================//
 Vecd LevelSetShape::computeKernelGradientIntegral(const Vecd &probe_point, Real h_ratio)
 {
-    return level_set_.probeKernelGradientIntegral(probe_point, h_ratio);
+    return rigid_motion_.xformFrameVecToBase(
+        level_set_.probeKernelGradientIntegral(rigid_motion_.shiftBaseStationToFrame(probe_point), h_ratio));
+}
+//=================================================================================================//
+LevelSetCK &LevelSetShape::getLevelSetCK()
+{
+    if (level_set_ck_ == nullptr)
+    {
+        level_set_ck_ = level_set_ck_keeper_.createPtr<LevelSetCK>(level_set_);
+    }
+    return *level_set_ck_;
 }
 //=================================================================================================//
 } // namespace SPH
@@ -31,22 +31,33 @@
 
 #include "base_geometry.h"
 #include "level_set.h"
+#include "level_set_ck.h"
 
+#include <functional>
 #include <string>
 
 namespace SPH
 {
 class SPHBody;
 class SPHSystem;
+/** rigid motion of a shape given as function of time */
+using RigidMotionFunction = std::function<Transform(Real)>;
 /**
  * @class LevelSetShape
  * @brief A shape using level set to define geometry
+ * @details The level set is built in the initial configuration.
+ *          A rigid motion can be set for a moving body,
+ *          the probe points are then transformed to the initial frame
+ *          and the level set is reused without rebuilding.
  */
 class LevelSetShape : public Shape
 {
   private:
     UniquePtrKeeper<MultilevelLevelSet> level_set_keeper_;
+    UniquePtrKeeper<LevelSetCK> level_set_ck_keeper_;
     SharedPtr<SPHAdaptation> sph_adaptation_;
+    std::string cache_folder_;
+    std::string cache_key_; /**< the raw key of the cache, empty if the cache is not used */
 
   public:
     /** refinement_ratio is between body reference resolution and level set resolution */
@@ -57,6 +68,7 @@ class LevelSetShape : public Shape
 
     virtual bool checkContain(const Vecd &probe_point, bool BOUNDARY_INCLUDED = true) override;
     virtual Vecd findClosestPoint(const Vecd &probe_point) override;
+    virtual Real findSignedDistance(const Vecd &probe_point) override;
 
     Vecd findLevelSetGradient(const Vecd &probe_point);
     Real computeKernelIntegral(const Vecd &probe_point, Real h_ratio = 1.0);
@@ -66,11 +78,36 @@ class LevelSetShape : public Shape
     /** required to build level set from triangular mesh in stl file format. */
     LevelSetShape *correctLevelSetSign(Real small_shift_factor = 1.0);
     void writeLevelSet(SPHSystem &sph_system);
+    MultilevelLevelSet &getLevelSet() { return level_set_; };
+    /** the level set flattened for computing kernels, created at the first call and shared afterwards,
+     *  the rigid motion is not applied in its probes */
+    LevelSetCK &getLevelSetCK();
+    /** the transform maps the initial frame of the level set to the current one */
+    void setRigidMotion(const Transform &rigid_motion);
+    Transform &getRigidMotion() { return rigid_motion_; };
+    void setRigidMotionFunction(const RigidMotionFunction &rigid_motion_function);
+    /** set the rigid motion from the motion function at the given time */
+    void updateRigidMotion(Real time);
 
   protected:
     MultilevelLevelSet &level_set_; /**< narrow bounded level set mesh. */
+    LevelSetCK *level_set_ck_;
+    BoundingBox initial_bounds_;
+    Transform rigid_motion_;
+    RigidMotionFunction rigid_motion_function_;
 
     virtual BoundingBox findBounds() override;
+    /** the level set is read from the cache if it is enabled in the system and the key is found */
+    UniquePtr<MultilevelLevelSet> createLevelSet(SPHBody &sph_body, Shape &shape, Real refinement_ratio);
+    template <typename DataType>
+    void appendToCacheKey(const DataType &value)
+    {
+        cache_key_.append(reinterpret_cast<const char *>(&value), sizeof(DataType));
+    };
+    std::string cacheFileFullPath();
+    void writeToCache(MultilevelLevelSet &level_set);
+    /** reads the data of the level set, returns false if it is not cached */
+    bool readFromCache();
 };
 } // namespace SPH
 #endif // LEVEL_SET_SHAPE_H
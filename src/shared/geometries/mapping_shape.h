@@ -57,6 +57,12 @@ class InverseShape : public BaseShapeType
     {
         return !BaseShapeType::checkContain(probe_point);
     };
+
+    virtual void appendContentKey(std::string &key) override
+    {
+        key += "InverseShape";
+        BaseShapeType::appendContentKey(key);
+    };
 };
 
 /**
@@ -102,6 +108,12 @@ class ExtrudeShape : public BaseShapeType
         closest_point += BaseShapeType::checkContain(probe_point) ? shift : -shift;
         return closest_point;
     };
+
+    virtual void appendContentKey(std::string &key) override
+    {
+        appendBinaryToKey(key, thickness_);
+        BaseShapeType::appendContentKey(key);
+    };
 };
 } // namespace SPH
 
@@ -69,6 +69,14 @@ class TransformShape : public BaseShapeType
         return transform_.shiftFrameStationToBase(closest_point_origin);
     };
 
+    virtual void appendContentKey(std::string &key) override
+    {
+        appendBinaryToKey(key, transform_.shiftFrameStationToBase(Vecd::Zero()));
+        for (int l = 0; l != Dimensions; ++l)
+            appendBinaryToKey(key, transform_.xformFrameVecToBase(Vecd::Unit(l)));
+        BaseShapeType::appendContentKey(key);
+    };
+
   protected:
     Transform transform_;
 
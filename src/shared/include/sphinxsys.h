@@ -40,6 +40,8 @@
 #include "all_simbody.h"
 #include "io_all.h"
 #include "parameterization.h"
+#include "body_build_pipeline.h"
+#include "sph_ensemble.h"
 #include "sph_system.hpp"
 
 #endif // SPHINXSYS_H
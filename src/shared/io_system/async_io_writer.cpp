@@ -0,0 +1,103 @@
+#include "async_io_writer.h"
+
+#include "timeline_tracer.h"
+
+namespace SPH
+{
+//=============================================================================================//
+AsyncIOWriter::~AsyncIOWriter()
+{
+    flush();
+    if (writer_thread_.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            is_stopping_ = true;
+        }
+        queue_changed_.notify_all();
+        writer_thread_.join();
+    }
+}
+//=============================================================================================//
+void AsyncIOWriter::setQueue(size_t queue_capacity, AsyncIOQueuePolicy queue_policy)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_capacity_ = queue_capacity > 0 ? queue_capacity : 1;
+    queue_policy_ = queue_policy;
+}
+//=============================================================================================//
+void AsyncIOWriter::submit(std::function<void()> &&task)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (!writer_thread_.joinable())
+    {
+        writer_thread_ = std::thread(&AsyncIOWriter::runWriterThread, this);
+    }
+
+    if (task_queue_.size() >= queue_capacity_)
+    {
+        switch (queue_policy_)
+        {
+        case AsyncIOQueuePolicy::wait:
+            queue_changed_.wait(lock, [&]
+                                { return task_queue_.size() < queue_capacity_; });
+            break;
+        case AsyncIOQueuePolicy::write_in_caller:
+            // the queued tasks may append to the same files,
+            // so they are written first to keep the output order
+            queue_changed_.wait(lock, [&]
+                                { return task_queue_.empty() && !is_writing_; });
+            is_writing_ = true;
+            lock.unlock();
+            task();
+            lock.lock();
+            is_writing_ = false;
+            lock.unlock();
+            queue_changed_.notify_all();
+            return;
+        case AsyncIOQueuePolicy::skip:
+            skipped_tasks_++;
+            return;
+        }
+    }
+    task_queue_.push_back(std::move(task));
+    lock.unlock();
+    queue_changed_.notify_all();
+}
+//=============================================================================================//
+void AsyncIOWriter::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_changed_.wait(lock, [&]
+                        { return task_queue_.empty() && !is_writing_; });
+}
+//=============================================================================================//
+void AsyncIOWriter::runWriterThread()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true)
+    {
+        queue_changed_.wait(lock, [&]
+                            { return (!task_queue_.empty() && !is_writing_) || is_stopping_; });
+        if (task_queue_.empty())
+            break; // stopping with nothing left to write
+
+        std::function<void()> task = std::move(task_queue_.front());
+        task_queue_.pop_front();
+        is_writing_ = true;
+        lock.unlock();
+        queue_changed_.notify_all();
+
+        {
+            static const std::string timeline_name = "async output";
+            TimelineTracer::Scope timeline_scope("io", timeline_name);
+            task();
+        }
+
+        lock.lock();
+        is_writing_ = false;
+        queue_changed_.notify_all();
+    }
+}
+//=============================================================================================//
+} // namespace SPH
@@ -0,0 +1,80 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	async_io_writer.h
+ * @brief 	A background writer thread with a bounded task queue.
+ * @details The output classes take a snapshot of the data to write and submit a
+ *          self-contained writing task, so that the time stepping continues while
+ *          the files are written. When the queue is full, the back-pressure policy
+ *          decides whether the caller waits, writes by itself or skips the output.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef ASYNC_IO_WRITER_H
+#define ASYNC_IO_WRITER_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace SPH
+{
+/** What to do when a task is submitted to a full queue. */
+enum class AsyncIOQueuePolicy
+{
+    wait,            /**< block the caller until the writer has taken a task */
+    write_in_caller, /**< drain the queue and then run the task synchronously in the calling thread */
+    skip             /**< drop the task, e.g. for visualization-only output */
+};
+
+class AsyncIOWriter
+{
+  public:
+    AsyncIOWriter(){};
+    /** finishes all pending tasks before the writer thread is stopped */
+    ~AsyncIOWriter();
+
+    void setQueue(size_t queue_capacity, AsyncIOQueuePolicy queue_policy);
+    /** the task must not refer to data which may be changed or destroyed before it is executed */
+    void submit(std::function<void()> &&task);
+    /** barrier: returns when all submitted tasks are written */
+    void flush();
+    size_t SkippedTasks() { return skipped_tasks_; };
+
+  protected:
+    size_t queue_capacity_ = 4;
+    AsyncIOQueuePolicy queue_policy_ = AsyncIOQueuePolicy::wait;
+    std::deque<std::function<void()>> task_queue_;
+    std::mutex mutex_;
+    std::condition_variable queue_changed_;
+    std::thread writer_thread_;
+    bool is_writing_ = false;
+    bool is_stopping_ = false;
+    size_t skipped_tasks_ = 0;
+
+    void runWriterThread();
+};
+} // namespace SPH
+#endif // ASYNC_IO_WRITER_H
@@ -0,0 +1,91 @@
+#include "io_adios2.hpp"
+
+#if SPHINXSYS_USE_ADIOS2
+namespace SPH
+{
+//=============================================================================================//
+BodyStatesRecordingToAdios2::BodyStatesRecordingToAdios2(SPHSystem &sph_system, const std::string &stream_name,
+                                                         const std::string &engine_type)
+    : BodyStatesRecording(sph_system), stream_name_(stream_name),
+      adios_io_(adios_.DeclareIO(stream_name))
+{
+    adios_io_.SetEngine(engine_type);
+}
+//=============================================================================================//
+BodyStatesRecordingToAdios2::BodyStatesRecordingToAdios2(SPHBody &body, const std::string &engine_type)
+    : BodyStatesRecording(body), stream_name_(body.getName() + "_States"),
+      adios_io_(adios_.DeclareIO(stream_name_))
+{
+    adios_io_.SetEngine(engine_type);
+}
+//=============================================================================================//
+BodyStatesRecordingToAdios2::~BodyStatesRecordingToAdios2()
+{
+    // steps submitted for the background writer refer to the engine
+    sph_system_.flushAsyncIO();
+    if (engine_)
+    {
+        engine_.Close();
+    }
+}
+//=============================================================================================//
+void BodyStatesRecordingToAdios2::setEngineParameter(const std::string &key, const std::string &value)
+{
+    if (engine_)
+    {
+        std::cout << "\n Error: the ADIOS2 engine parameter " << key
+                  << " is set after the stream " << stream_name_ << " is opened." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    adios_io_.SetParameter(key, value);
+}
+//=============================================================================================//
+void BodyStatesRecordingToAdios2::openEngine()
+{
+    // for file based engines the stream is written into the output folder
+    std::string stream_name = adios_io_.EngineType() == "SST" || adios_io_.EngineType() == "sst"
+                                  ? stream_name_
+                                  : io_environment_.output_folder_ + "/" + stream_name_ + ".bp";
+    engine_ = adios_io_.Open(stream_name, adios2::Mode::Write);
+}
+//=============================================================================================//
+void BodyStatesRecordingToAdios2::writeWithFileName(const std::string &sequence)
+{
+    StdVec<std::pair<SPHBody *, SharedPtr<BodyStatesSnapshot>>> step_bodies;
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        SPHBody *body = bodies_[i];
+        if (body->checkNewlyUpdated() && state_recording_)
+        {
+            step_bodies.push_back(std::make_pair(body, isSnapshotNeeded(i) ? makeBodyStatesSnapshot(i) : nullptr));
+        }
+        body->setNotNewlyUpdated();
+    }
+
+    if (!step_bodies.empty())
+    {
+        if (!engine_)
+        {
+            openEngine();
+        }
+
+        Real physical_time = sv_physical_time_.getValue();
+        // without snapshots the body states are put immediately, as the output is not asynchronous
+        submitOutput([=]()
+                     {
+                         engine_.BeginStep();
+                         putVariable("Time", &physical_time, 1, 1);
+                         for (auto &step_body : step_bodies)
+                         {
+                             if (step_body.second != nullptr)
+                                 putBodyStates(step_body.first->getName(), *step_body.second);
+                             else
+                                 putBodyStates(step_body.first->getName(), step_body.first->getBaseParticles());
+                         }
+                         engine_.EndStep(); });
+    }
+}
+//=============================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_ADIOS2
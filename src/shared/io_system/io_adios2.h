@@ -0,0 +1,80 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_adios2.h
+ * @brief 	Streaming of body states through ADIOS2 for in-situ analysis.
+ * @details The states of all bodies of an output step are put into one ADIOS2 step,
+ *          as variables <body>/<variable> together with the physical time.
+ *          With the default SST engine, the steps are streamed to readers running
+ *          concurrently, e.g. analysis or rendering on other nodes, without touching
+ *          the file system. Other engines, e.g. BP5, write the same steps into files instead.
+ *          Available when built with SPHINXSYS_USE_ADIOS2.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IO_ADIOS2_H
+#define IO_ADIOS2_H
+
+#include "io_base.h"
+
+#if SPHINXSYS_USE_ADIOS2
+#include <adios2.h>
+
+namespace SPH
+{
+/**
+ * @class BodyStatesRecordingToAdios2
+ * @brief Put the states of bodies into the steps of an ADIOS2 stream.
+ * @details The variable selection of BodyStatesRecording applies, and the device data
+ *          are synchronized when written with a device policy as for other state writers.
+ */
+class BodyStatesRecordingToAdios2 : public BodyStatesRecording
+{
+  public:
+    BodyStatesRecordingToAdios2(SPHSystem &sph_system, const std::string &stream_name = "BodyStates",
+                                const std::string &engine_type = "SST");
+    BodyStatesRecordingToAdios2(SPHBody &body, const std::string &engine_type = "SST");
+    virtual ~BodyStatesRecordingToAdios2();
+    /** engine parameters, e.g. "RendezvousReaderCount" of SST, to be set before the first output */
+    void setEngineParameter(const std::string &key, const std::string &value);
+
+  protected:
+    std::string stream_name_;
+    adios2::ADIOS adios_;
+    adios2::IO adios_io_;
+    adios2::Engine engine_;
+
+    virtual void writeWithFileName(const std::string &sequence) override;
+    void openEngine();
+    /** ParticlesType is BaseParticles or, for asynchronous or selected output, BodyStatesSnapshot. */
+    template <class ParticlesType>
+    void putBodyStates(const std::string &body_name, ParticlesType &particles);
+    template <typename ScalarType>
+    void putVariable(const std::string &name, const ScalarType *data,
+                     size_t number_of_tuples, size_t number_of_components);
+    template <typename DataType>
+    void putVariables(const std::string &body_name, ParticleVariables &variables, size_t number_of_tuples);
+};
+} // namespace SPH
+#endif // SPHINXSYS_USE_ADIOS2
+#endif // IO_ADIOS2_H
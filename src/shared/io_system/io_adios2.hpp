@@ -0,0 +1,95 @@
+#ifndef IO_ADIOS2_HPP
+#define IO_ADIOS2_HPP
+
+#include "io_adios2.h"
+
+#if SPHINXSYS_USE_ADIOS2
+namespace SPH
+{
+//=============================================================================================//
+template <typename ScalarType>
+void BodyStatesRecordingToAdios2::putVariable(const std::string &name, const ScalarType *data,
+                                              size_t number_of_tuples, size_t number_of_components)
+{
+    adios2::Dims shape = number_of_components == 1 ? adios2::Dims{number_of_tuples}
+                                                   : adios2::Dims{number_of_tuples, number_of_components};
+    adios2::Dims start(shape.size(), 0);
+    adios2::Variable<ScalarType> variable = adios_io_.InquireVariable<ScalarType>(name);
+    if (!variable)
+    {
+        variable = adios_io_.DefineVariable<ScalarType>(name, shape, start, shape);
+    }
+    else
+    {
+        // the number of particles may change from step to step
+        variable.SetShape(shape);
+        variable.SetSelection({start, shape});
+    }
+    engine_.Put(variable, data, adios2::Mode::Sync);
+}
+//=============================================================================================//
+template <typename DataType>
+void BodyStatesRecordingToAdios2::putVariables(const std::string &body_name, ParticleVariables &variables,
+                                               size_t number_of_tuples)
+{
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    for (DiscreteVariable<DataType> *variable : std::get<type_index>(variables))
+    {
+        std::string name = body_name + "/" + variable->Name();
+        DataType *data = variable->DataField();
+        if constexpr (std::is_arithmetic<DataType>::value)
+        {
+            putVariable(name, data, number_of_tuples, 1);
+        }
+        else if constexpr (std::is_same<DataType, Vecd>::value)
+        {
+            // always in 3D for the readers
+            StdVec<Real> buffer(3 * number_of_tuples);
+            for (size_t i = 0; i != number_of_tuples; ++i)
+            {
+                Vec3d vector_value = upgradeToVec3d(data[i]);
+                std::copy_n(vector_value.data(), 3, &buffer[3 * i]);
+            }
+            putVariable(name, buffer.data(), number_of_tuples, 3);
+        }
+        else
+        {
+            StdVec<Real> buffer(9 * number_of_tuples);
+            for (size_t i = 0; i != number_of_tuples; ++i)
+            {
+                Mat3d matrix_value = upgradeToMat3d(data[i]);
+                std::copy_n(matrix_value.data(), 9, &buffer[9 * i]); // column major
+            }
+            putVariable(name, buffer.data(), number_of_tuples, 9);
+        }
+    }
+}
+//=============================================================================================//
+template <class ParticlesType>
+void BodyStatesRecordingToAdios2::putBodyStates(const std::string &body_name, ParticlesType &particles)
+{
+    size_t total_real_particles = particles.TotalRealParticles();
+    if (total_real_particles == 0)
+        return;
+
+    ParticleVariables &variables_to_write = particles.VariablesToWrite();
+    StdVec<Real> positions(3 * total_real_particles);
+    Vecd *pos = particles.ParticlePositions();
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Vec3d position = upgradeToVec3d(pos[i]);
+        std::copy_n(position.data(), 3, &positions[3 * i]);
+    }
+    putVariable(body_name + "/Position", positions.data(), total_real_particles, 3);
+    putVariable(body_name + "/OriginalParticle_ID", particles.ParticleOriginalIds(), total_real_particles, 1);
+
+    putVariables<UnsignedInt>(body_name, variables_to_write, total_real_particles);
+    putVariables<int>(body_name, variables_to_write, total_real_particles);
+    putVariables<Real>(body_name, variables_to_write, total_real_particles);
+    putVariables<Vecd>(body_name, variables_to_write, total_real_particles);
+    putVariables<Matd>(body_name, variables_to_write, total_real_particles);
+}
+//=============================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_ADIOS2
+#endif // IO_ADIOS2_HPP
@@ -27,10 +27,16 @@ io class used in SPHinXsys. **/
 #ifndef IO_ALL_H
 #define IO_ALL_H
 
+#include "io_adios2.h"
 #include "io_base.h"
+#include "io_distributed.h"
+#include "io_hdf5.h"
+#include "io_memory.h"
 #include "io_observation.h"
 #include "io_plt.h"
 #include "io_simbody.h"
+#include "io_snapshot.h"
+#include "io_time_series.h"
 #include "io_vtk.h"
 #include "io_vtk_fvm.h"
 
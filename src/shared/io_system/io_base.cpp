@@ -1,6 +1,12 @@
 #include "io_base.h"
 
 #include "sph_system.hpp"
+#include "timeline_tracer.h"
+
+#include <boost/core/demangle.hpp>
+
+#include <chrono>
+#include <thread>
 
 namespace SPH
 {
@@ -23,6 +29,121 @@ bool BaseIO::isBodyIncluded(const SPHBodyVector &bodies, SPHBody *sph_body)
     return result != bodies.end() ? true : false;
 }
 //=============================================================================================//
+void BaseIO::submitOutput(std::function<void()> &&output_task)
+{
+    if (sph_system_.AsyncIO())
+    {
+        sph_system_.getAsyncIOWriter().submit(std::move(output_task));
+    }
+    else
+    {
+        output_task();
+    }
+}
+//=============================================================================================//
+BodyStatesSelection::BodyStatesSelection(BaseParticles &particles)
+    : particles_(particles), particle_stride_(1) {}
+//=============================================================================================//
+void BodyStatesSelection::setOutputInterval(const std::string &variable_name, Real output_interval)
+{
+    output_intervals_[variable_name] = output_interval;
+    next_output_times_[variable_name] = std::numeric_limits<Real>::lowest();
+}
+//=============================================================================================//
+void BodyStatesSelection::setRegion(BodyPartByCell &body_part)
+{
+    ConcurrentCellLists &body_part_cells = body_part.LoopRange();
+    collect_region_particles_ = [&](IndexVector &region_particles)
+    {
+        for (size_t i = 0; i != body_part_cells.size(); ++i)
+        {
+            const CellParticles &particle_indexes = *body_part_cells[i];
+            region_particles.insert(region_particles.end(), particle_indexes.begin(), particle_indexes.end());
+        }
+    };
+}
+//=============================================================================================//
+void BodyStatesSelection::setRegion(BodyPartByParticle &body_part)
+{
+    IndexVector &body_part_particles = body_part.LoopRange();
+    collect_region_particles_ = [&](IndexVector &region_particles)
+    { region_particles = body_part_particles; };
+}
+//=============================================================================================//
+void BodyStatesSelection::update(Real physical_time)
+{
+    due_variables_.clear();
+    for (auto &[variable_name, output_interval] : output_intervals_)
+    {
+        Real &next_output_time = next_output_times_[variable_name];
+        if (physical_time >= next_output_time)
+        {
+            due_variables_.insert(variable_name);
+            next_output_time = output_interval == MaxReal
+                                   ? MaxReal
+                                   : (std::floor(physical_time / output_interval) + 1) * output_interval;
+        }
+    }
+
+    if (!isParticleSelected())
+        return;
+
+    size_t total_real_particles = particles_.TotalRealParticles();
+    IndexVector candidate_particles;
+    if (collect_region_particles_)
+    {
+        collect_region_particles_(candidate_particles);
+        std::sort(candidate_particles.begin(), candidate_particles.end());
+    }
+    else
+    {
+        candidate_particles.resize(total_real_particles);
+        std::iota(candidate_particles.begin(), candidate_particles.end(), 0);
+    }
+
+    UnsignedInt *original_id = particles_.ParticleOriginalIds();
+    selected_particles_.clear();
+    for (size_t index_i : candidate_particles)
+    {
+        if (index_i < total_real_particles && original_id[index_i] % particle_stride_ == 0)
+        {
+            selected_particles_.push_back(index_i);
+        }
+    }
+}
+//=============================================================================================//
+bool BodyStatesSelection::isVariableDue(const std::string &variable_name)
+{
+    return output_intervals_.find(variable_name) == output_intervals_.end() ||
+           due_variables_.find(variable_name) != due_variables_.end();
+}
+//=============================================================================================//
+BodyStatesSnapshot::BodyStatesSnapshot(BaseParticles &particles, BodyStatesSelection *selection)
+    : total_real_particles_(particles.TotalRealParticles())
+{
+    Vecd *pos = particles.ParticlePositions();
+    UnsignedInt *original_id = particles.ParticleOriginalIds();
+    if (selection != nullptr && selection->isParticleSelected())
+    {
+        IndexVector &selected_particles = selection->SelectedParticles();
+        total_real_particles_ = selected_particles.size();
+        for (size_t index_i : selected_particles)
+        {
+            pos_.push_back(pos[index_i]);
+            original_id_.push_back(original_id[index_i]);
+        }
+    }
+    else
+    {
+        pos_.assign(pos, pos + total_real_particles_);
+        original_id_.assign(original_id, original_id + total_real_particles_);
+    }
+
+    OperationOnDataAssemble<ParticleVariables, copyVariablesToSnapshot>
+        copy_variables_to_snapshot(particles.VariablesToWrite());
+    copy_variables_to_snapshot(*this, selection);
+}
+//=============================================================================================//
 BodyStatesRecording::BodyStatesRecording(SPHSystem &sph_system)
     : BaseIO(sph_system), bodies_(sph_system.getRealBodies()),
       state_recording_(sph_system_.StateRecording())
@@ -34,34 +155,85 @@ BodyStatesRecording::BodyStatesRecording(SPHSystem &sph_system)
         prepare_variable_to_write_.push_back(
             OperationOnDataAssemble<ParticleVariables, prepareVariablesToWrite>(
                 particles.VariablesToWrite()));
+        body_states_selections_.push_back(BodyStatesSelection(particles));
     }
 }
 //=============================================================================================//
 BodyStatesRecording::BodyStatesRecording(SPHBody &body)
     : BaseIO(body.getSPHSystem()), bodies_({&body}),
-      state_recording_(sph_system_.StateRecording()) {}
+      state_recording_(sph_system_.StateRecording())
+{
+    body_states_selections_.push_back(BodyStatesSelection(body.getBaseParticles()));
+}
+//=============================================================================================//
+BodyStatesSelection &BodyStatesRecording::getBodyStatesSelection(SPHBody &sph_body)
+{
+    auto result = std::find(bodies_.begin(), bodies_.end(), &sph_body);
+    if (result == bodies_.end())
+    {
+        std::cout << "\n Error: the body:" << sph_body.getName()
+                  << " is not in the recording list" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    return body_states_selections_[result - bodies_.begin()];
+}
+//=============================================================================================//
+void BodyStatesRecording::updateBodyStatesSelections()
+{
+    for (BodyStatesSelection &selection : body_states_selections_)
+    {
+        if (selection.isActive())
+        {
+            selection.update(sv_physical_time_.getValue());
+        }
+    }
+}
+//=============================================================================================//
+bool BodyStatesRecording::isSnapshotNeeded(size_t body_index)
+{
+    return sph_system_.AsyncIO() || body_states_selections_[body_index].isActive();
+}
+//=============================================================================================//
+SharedPtr<BodyStatesSnapshot> BodyStatesRecording::makeBodyStatesSnapshot(size_t body_index)
+{
+    BodyStatesSelection &selection = body_states_selections_[body_index];
+    return makeShared<BodyStatesSnapshot>(bodies_[body_index]->getBaseParticles(),
+                                          selection.isActive() ? &selection : nullptr);
+}
 //=============================================================================================//
 void BodyStatesRecording::writeToFile()
 {
+    static const std::string timeline_name = "BodyStatesRecording";
+    TimelineTracer::Scope timeline_scope("io", timeline_name);
     for (auto &derived_variable : derived_variables_)
     {
         derived_variable->exec();
     }
+    updateBodyStatesSelections();
     writeWithFileName(convertPhysicalTimeToString(sv_physical_time_.getValue()));
 }
 //=============================================================================================//
 void BodyStatesRecording::writeToFile(size_t iteration_step)
 {
+    static const std::string timeline_name = "BodyStatesRecording";
+    TimelineTracer::Scope timeline_scope("io", timeline_name);
     for (auto &derived_variable : derived_variables_)
     {
         derived_variable->exec();
     }
+    updateBodyStatesSelections();
     writeWithFileName(padValueWithZeros(iteration_step));
 };
 //=============================================================================================//
 RestartIO::RestartIO(SPHSystem &sph_system)
-    : BaseIO(sph_system), bodies_(sph_system.getRealBodies()),
-      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_")
+    : RestartIO(sph_system, sph_system.getRealBodies()) {}
+//=============================================================================================//
+RestartIO::RestartIO(SPHSystem &sph_system, SPHBodyVector bodies)
+    : BaseIO(sph_system), bodies_(bodies),
+      overall_file_path_(io_environment_.restart_folder_ + "/Restart_time_"),
+      compression_(BinaryDataCompression::none), is_incremental_(false), number_of_retained_(0),
+      last_indexes_(bodies_.size()), referred_files_(bodies_.size())
 {
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
@@ -76,7 +248,22 @@ RestartIO::RestartIO(SPHSystem &sph_system)
     }
 }
 //=============================================================================================//
-void RestartIO::writeToFile(size_t iteration_step)
+void RestartIO::setCompression(bool is_compressed)
+{
+    if (is_compressed && !isBinaryDataCompressionAvailable())
+    {
+        std::cout << "\n Warning: restart files are not compressed, "
+                  << "as SPHinXsys is built without SPHINXSYS_USE_ZLIB." << std::endl;
+    }
+    compression_ = is_compressed ? BinaryDataCompression::zlib : BinaryDataCompression::none;
+}
+//=============================================================================================//
+std::string RestartIO::bodyFileName(size_t body_index, size_t iteration_step)
+{
+    return bodies_[body_index]->getName() + "_rst_" + padValueWithZeros(iteration_step) + ".bin";
+}
+//=============================================================================================//
+void RestartIO::writeRestartTime(size_t iteration_step)
 {
     std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(iteration_step) + ".dat";
     if (fs::exists(overall_filefullpath))
@@ -86,16 +273,90 @@ void RestartIO::writeToFile(size_t iteration_step)
     std::ofstream out_file(overall_filefullpath.c_str(), std::ios::app);
     out_file << std::fixed << std::setprecision(9) << sv_physical_time_.getValue() << "   \n";
     out_file.close();
+}
+//=============================================================================================//
+void RestartIO::writeToFile(size_t iteration_step)
+{
+    static const std::string timeline_name = "RestartIO";
+    TimelineTracer::Scope timeline_scope("io", timeline_name);
+    writeRestartTime(iteration_step);
 
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + ".xml";
+        std::string filefullpath = file_names_[i] + padValueWithZeros(iteration_step) + ".bin";
 
         if (fs::exists(filefullpath))
         {
             fs::remove(filefullpath);
         }
-        bodies_[i]->writeParticlesToXmlForRestart(filefullpath);
+        BinaryDataWriter binary_writer(filefullpath, compression_);
+        if (is_incremental_)
+        {
+            binary_writer.setPreviousIndex(last_indexes_[i]);
+        }
+        bodies_[i]->writeParticlesToBinaryForRestart(binary_writer);
+        binary_writer.finalize();
+
+        BinaryDataIndex index = binary_writer.getIndex();
+        std::set<std::string> &referred_files = referred_files_[i][bodyFileName(i, iteration_step)];
+        referred_files.clear();
+        for (auto &[name, record] : index)
+        {
+            referred_files.insert(record.source_file_);
+        }
+        if (is_incremental_)
+        {
+            last_indexes_[i] = index;
+        }
+    }
+
+    if (number_of_retained_ != 0)
+    {
+        if (retained_steps_.empty() || retained_steps_.back() != iteration_step)
+        {
+            retained_steps_.push_back(iteration_step);
+        }
+        removeExpiredCheckpoints();
+    }
+}
+//=============================================================================================//
+void RestartIO::removeExpiredCheckpoints()
+{
+    while (retained_steps_.size() > number_of_retained_)
+    {
+        std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(retained_steps_.front()) + ".dat";
+        if (fs::exists(overall_filefullpath))
+        {
+            fs::remove(overall_filefullpath);
+        }
+        retained_steps_.erase(retained_steps_.begin());
+    }
+
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        std::set<std::string> files_in_use;
+        for (size_t step : retained_steps_)
+        {
+            std::set<std::string> &referred_files = referred_files_[i][bodyFileName(i, step)];
+            files_in_use.insert(referred_files.begin(), referred_files.end());
+        }
+
+        for (auto it = referred_files_[i].begin(); it != referred_files_[i].end();)
+        {
+            if (files_in_use.find(it->first) == files_in_use.end())
+            {
+                std::string filefullpath = io_environment_.restart_folder_ + "/" + it->first;
+                if (fs::exists(filefullpath))
+                {
+                    fs::remove(filefullpath);
+                }
+                it = referred_files_[i].erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
     }
 }
 //=============================================================================================//
@@ -117,23 +378,107 @@ Real RestartIO::readRestartTime(size_t restart_step)
     return restart_time;
 }
 //=============================================================================================//
+void RestartIO::readBodyFromFile(size_t body_index, size_t restart_step)
+{
+    std::string binary_filefullpath = file_names_[body_index] + padValueWithZeros(restart_step) + ".bin";
+    std::string xml_filefullpath = file_names_[body_index] + padValueWithZeros(restart_step) + ".xml";
+
+    if (fs::exists(binary_filefullpath))
+    {
+        bodies_[body_index]->readParticlesFromBinaryForRestart(binary_filefullpath);
+    }
+    else if (fs::exists(xml_filefullpath)) // restart files written by former versions
+    {
+        bodies_[body_index]->readParticlesFromXmlForRestart(xml_filefullpath);
+    }
+    else
+    {
+        std::cout << "\n Error: the input file:" << binary_filefullpath << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=============================================================================================//
 void RestartIO::readFromFile(size_t restart_step)
 {
     for (size_t i = 0; i < bodies_.size(); ++i)
     {
-        std::string filefullpath = file_names_[i] + padValueWithZeros(restart_step) + ".xml";
-
-        if (!fs::exists(filefullpath))
+        readBodyFromFile(i, restart_step);
+    }
+    recoverCheckpointRecords(restart_step);
+}
+//=============================================================================================//
+void RestartIO::recoverCheckpointRecords(size_t restart_step)
+{
+    // the checkpoint steps are given by the restart time files,
+    // and those after the restart step are left to be overwritten
+    const std::string time_file_prefix = fs::path(overall_file_path_).filename().string();
+    retained_steps_.clear();
+    for (const auto &entry : fs::directory_iterator(io_environment_.restart_folder_))
+    {
+        std::string file_name = entry.path().filename().string();
+        size_t prefix_size = time_file_prefix.size();
+        if (file_name.size() <= prefix_size + 4 ||
+            file_name.compare(0, prefix_size, time_file_prefix) != 0 ||
+            file_name.compare(file_name.size() - 4, 4, ".dat") != 0)
+        {
+            continue;
+        }
+        std::string step_string = file_name.substr(prefix_size, file_name.size() - prefix_size - 4);
+        if (step_string.find_first_not_of("0123456789") != std::string::npos)
+        {
+            continue;
+        }
+        size_t step = std::stoull(step_string);
+        if (step <= restart_step)
         {
-            std::cout << "\n Error: the input file:" << filefullpath << " is not exists" << std::endl;
-            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
-            exit(1);
+            retained_steps_.push_back(step);
         }
+    }
+    std::sort(retained_steps_.begin(), retained_steps_.end());
+
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        referred_files_[i].clear();
+        last_indexes_[i].clear();
+        for (size_t step : retained_steps_)
+        {
+            std::string file_name = bodyFileName(i, step);
+            std::string filefullpath = io_environment_.restart_folder_ + "/" + file_name;
+            if (!fs::exists(filefullpath)) // e.g. xml files written by former versions
+            {
+                continue;
+            }
+            BinaryDataReader binary_reader(filefullpath, false);
+            if (!binary_reader.isValid())
+            {
+                continue;
+            }
 
-        bodies_[i]->readParticlesFromXmlForRestart(filefullpath);
+            BinaryDataIndex index = binary_reader.getIndex();
+            std::set<std::string> &referred_files = referred_files_[i][file_name];
+            for (auto &[name, record] : index)
+            {
+                if (record.source_file_.empty())
+                {
+                    record.source_file_ = file_name;
+                }
+                referred_files.insert(record.source_file_);
+            }
+            if (step == restart_step)
+            {
+                last_indexes_[i] = index;
+            }
+        }
     }
 }
 //=============================================================================================//
+RemappingRestartIO::RemappingRestartIO(SPHBody &source_body, const std::string &restart_body_name)
+    : RestartIO(source_body.getSPHSystem(), SPHBodyVector{&source_body})
+{
+    file_names_[0] = io_environment_.restart_folder_ + "/" + restart_body_name + "_rst_";
+}
+//=============================================================================================//
 ReloadParticleIO::ReloadParticleIO(SPHBodyVector bodies)
     : BaseIO(bodies[0]->getSPHSystem()), bodies_(bodies)
 {
@@ -172,6 +517,127 @@ void ReloadParticleIO::writeToFile(size_t iteration_step)
     }
 }
 //=============================================================================================//
+RelaxedParticlesCache::RelaxedParticlesCache(SPHBody &sph_body, const std::string &relaxation_description)
+    : BaseIO(sph_body.getSPHSystem()), sph_body_(sph_body),
+      cache_folder_(io_environment_.reload_folder_ + "/relaxation_cache"),
+      prepare_variable_to_reload_(sph_body.getBaseParticles().VariablesToReload())
+{
+    if (!fs::exists(cache_folder_))
+    {
+        fs::create_directories(cache_folder_);
+    }
+
+    BaseParticles &particles = sph_body.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    appendToKey(uint64_t(Dimensions));
+    appendToKey(uint64_t(sizeof(Real)));
+    appendToKey(uint64_t(total_real_particles));
+    appendToKey(hashBinaryData(reinterpret_cast<const char *>(particles.ParticlePositions()),
+                               total_real_particles * sizeof(Vecd)));
+    appendToKey(hashBinaryData(reinterpret_cast<const char *>(particles.VolumetricMeasures()),
+                               total_real_particles * sizeof(Real)));
+    appendToKey(sph_body.sph_adaptation_->ReferenceSpacing());
+    appendToKey(sph_body.sph_adaptation_->ReferenceSmoothingLength());
+    key_ += sph_body.sph_adaptation_->getKernel()->Name();
+    key_ += relaxation_description;
+}
+//=============================================================================================//
+void RelaxedParticlesCache::addFileToKey(const std::string &filefullpath)
+{
+    std::ifstream in_file(filefullpath.c_str(), std::ios::binary);
+    if (!in_file)
+    {
+        std::cout << "\n Error: the input file:" << filefullpath << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    std::string content((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    appendToKey(hashBinaryData(content.data(), content.size()));
+}
+//=============================================================================================//
+std::string RelaxedParticlesCache::cacheFileFullPath()
+{
+    std::ostringstream hash_string;
+    hash_string << std::hex << std::setw(16) << std::setfill('0') << hashBinaryData(key_.data(), key_.size());
+    return cache_folder_ + "/" + sph_body_.getName() + "_" + hash_string.str() + ".bin";
+}
+//=============================================================================================//
+bool RelaxedParticlesCache::readFromFile()
+{
+    std::string filefullpath = cacheFileFullPath();
+    if (!fs::exists(filefullpath))
+    {
+        return false;
+    }
+    std::cout << "\n Reading the relaxed particles of " << sph_body_.getName()
+              << " from the cache " << filefullpath << std::endl;
+    sph_body_.getBaseParticles().readReloadParticlesFromBinary(filefullpath);
+    return true;
+}
+//=============================================================================================//
+void RelaxedParticlesCache::writeToFile(size_t iteration_step)
+{
+    // written under a temporary name and renamed, to be safe for concurrent runs sharing the cache
+    std::string filefullpath = cacheFileFullPath();
+    std::ostringstream temporary_name;
+    temporary_name << filefullpath << "." << std::hex << std::hash<std::thread::id>{}(std::this_thread::get_id())
+                   << "_" << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+    {
+        BinaryDataWriter binary_writer(temporary_name.str());
+        sph_body_.getBaseParticles().writeReloadParticlesToBinary(binary_writer);
+        binary_writer.finalize();
+    }
+    fs::rename(temporary_name.str(), filefullpath);
+}
+//=============================================================================================//
+ConfigurationStatisticsRecording::
+    ConfigurationStatisticsRecording(RealBody &real_body, size_t interval)
+    : BaseIO(real_body.getSPHSystem()), real_body_(real_body), interval_(SMAX(interval, size_t(1))),
+      relations_(real_body.getBodyRelations()),
+      filefullpath_(io_environment_.output_folder_ + "/" + real_body.getName() + "_configuration_statistics.dat")
+{
+    std::ofstream out_file(filefullpath_.c_str(), std::ios::trunc);
+    out_file << "\"run_time\"   \"step\"   \"cell_min\"   \"cell_mean\"   \"cell_max\"   \"empty_cell_fraction\"";
+    for (size_t k = 0; k != relations_.size(); ++k)
+    {
+        std::string prefix = "relation" + std::to_string(k) + "_";
+        out_file << "   \"" << prefix << "min\"   \"" << prefix << "mean\"   \"" << prefix << "max\"";
+    }
+    out_file << "\n";
+    out_file.close();
+}
+//=============================================================================================//
+void ConfigurationStatisticsRecording::writeReport(std::ostream &output)
+{
+    output << "\n Configuration statistics of " << real_body_.getName() << ":\n";
+    real_body_.getCellLinkedList().CellOccupancy().write(output, "particles per cell");
+    for (size_t k = 0; k != relations_.size(); ++k)
+    {
+        relations_[k]->NeighborStatistics().write(
+            output, "neighbors in relation " + std::to_string(k) + " " +
+                        boost::core::demangle(typeid(*relations_[k]).name()));
+    }
+}
+//=============================================================================================//
+void ConfigurationStatisticsRecording::writeToFile(size_t iteration_step)
+{
+    if (iteration_step % interval_ != 0)
+        return;
+
+    CountStatistics cell_occupancy = real_body_.getCellLinkedList().CellOccupancy();
+    std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
+    out_file << sv_physical_time_.getValue() << "   " << iteration_step << "   "
+             << cell_occupancy.Minimum() << "   " << cell_occupancy.Mean() << "   "
+             << cell_occupancy.maximum_ << "   " << cell_occupancy.ZeroFraction();
+    for (SPHRelation *relation : relations_)
+    {
+        CountStatistics neighbors = relation->NeighborStatistics();
+        out_file << "   " << neighbors.Minimum() << "   " << neighbors.Mean() << "   " << neighbors.maximum_;
+    }
+    out_file << "\n";
+    out_file.close();
+}
+//=============================================================================================//
 ParticleGenerationRecording::ParticleGenerationRecording(SPHBody &sph_body)
     : BaseIO(sph_body.getSPHSystem()), sph_body_(sph_body),
       state_recording_(sph_system_.StateRecording()) {}
@@ -39,12 +39,15 @@
 #include <filesystem>
 #include <fstream>
 #include <iomanip>
+#include <set>
 #include <sstream>
 namespace fs = std::filesystem;
 
 namespace SPH
 {
 class SPHSystem;
+template <typename DataType>
+class QuantityTimeSeries;
 
 /**
  * @class BaseIO
@@ -75,6 +78,19 @@ class BaseIO
     }
 
     bool isBodyIncluded(const SPHBodyVector &bodies, SPHBody *sph_body);
+    /** runs the writing task directly or, in async-io mode, in the background writer thread */
+    void submitOutput(std::function<void()> &&output_task);
+    /** buffers a sample of the time series, which is written once the buffer is full */
+    template <typename DataType>
+    void writeQuantities(QuantityTimeSeries<DataType> &time_series, Real physical_time, const DataType *quantities);
+    template <typename DataType>
+    void writeQuantities(QuantityTimeSeries<DataType> &time_series, Real physical_time, const DataType &quantity)
+    {
+        writeQuantities(time_series, physical_time, &quantity);
+    };
+    /** writes the buffered samples, which are moved into the task for async-io */
+    template <typename DataType>
+    void flushQuantities(QuantityTimeSeries<DataType> &time_series);
 
     struct prepareVariablesToWrite
     {
@@ -92,6 +108,98 @@ class BaseIO
     };
 };
 
+/**
+ * @class BodyStatesSelection
+ * @brief Selects the variables and the particles of a body written at an output.
+ * @details A variable given an output interval is written at the first output and then
+ * at the first output after each further interval, other variables at every output.
+ * The particles can be restricted to a body part and sub-sampled by every k-th original id,
+ * so that the same particles are written at each output.
+ */
+class BodyStatesSelection
+{
+  public:
+    explicit BodyStatesSelection(BaseParticles &particles);
+    ~BodyStatesSelection(){};
+
+    void setOutputInterval(const std::string &variable_name, Real output_interval);
+    void setParticleStride(size_t particle_stride) { particle_stride_ = SMAX(particle_stride, size_t(1)); };
+    void setRegion(BodyPartByCell &body_part);
+    void setRegion(BodyPartByParticle &body_part);
+    /** decides the variables and collects the particles to be written at this output */
+    void update(Real physical_time);
+
+    bool isActive() { return !output_intervals_.empty() || isParticleSelected(); };
+    bool isParticleSelected() { return particle_stride_ > 1 || bool(collect_region_particles_); };
+    bool isVariableDue(const std::string &variable_name);
+    IndexVector &SelectedParticles() { return selected_particles_; };
+
+  protected:
+    BaseParticles &particles_;
+    std::map<std::string, Real> output_intervals_;
+    std::map<std::string, Real> next_output_times_;
+    std::set<std::string> due_variables_;
+    size_t particle_stride_;
+    std::function<void(IndexVector &)> collect_region_particles_; /**< empty for the whole body */
+    IndexVector selected_particles_;
+};
+
+/**
+ * @class BodyStatesSnapshot
+ * @brief Copy of the positions, original ids and the variables to write of a body
+ * for writing the body states in the background while the simulation continues.
+ * It provides the accessors of BaseParticles used by the state writers.
+ * With a selection given, only the selected variables and particles are copied.
+ */
+class BodyStatesSnapshot
+{
+  public:
+    explicit BodyStatesSnapshot(BaseParticles &particles, BodyStatesSelection *selection = nullptr);
+    ~BodyStatesSnapshot(){};
+
+    size_t TotalRealParticles() { return total_real_particles_; };
+    ParticleVariables &VariablesToWrite() { return variables_to_write_; };
+    Vecd *ParticlePositions() { return pos_.data(); };
+    UnsignedInt *ParticleOriginalIds() { return original_id_.data(); };
+
+  protected:
+    size_t total_real_particles_;
+    StdVec<Vecd> pos_;
+    StdVec<UnsignedInt> original_id_;
+    ParticleVariables variables_to_write_;
+    DataContainerUniquePtrAssemble<DiscreteVariable> variable_ptrs_;
+
+    struct copyVariablesToSnapshot
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        BodyStatesSnapshot &snapshot, BodyStatesSelection *selection)
+        {
+            for (DiscreteVariable<DataType> *variable : variables)
+            {
+                if (selection != nullptr && !selection->isVariableDue(variable->Name()))
+                    continue;
+
+                DiscreteVariable<DataType> *copy = addVariableToAssemble<DataType>(
+                    snapshot.variables_to_write_, snapshot.variable_ptrs_,
+                    variable->Name(), snapshot.total_real_particles_);
+                if (selection != nullptr && selection->isParticleSelected())
+                {
+                    IndexVector &selected_particles = selection->SelectedParticles();
+                    for (size_t i = 0; i != selected_particles.size(); ++i)
+                    {
+                        copy->DataField()[i] = variable->DataField()[selected_particles[i]];
+                    }
+                }
+                else
+                {
+                    std::copy_n(variable->DataField(), snapshot.total_real_particles_, copy->DataField());
+                }
+            }
+        };
+    };
+};
+
 /**
  * @class BodyStatesRecording
  * @brief base class for write body states.
@@ -113,10 +221,13 @@ class BodyStatesRecording : public BaseIO
             dv_all_pos_[i]->prepareForOutput(ex_policy);
             prepare_variable_to_write_[i](ex_policy);
         }
+        waitForOutputTransfers(ex_policy);
 
         writeToFile();
     };
 
+    void writeToFile(const ParallelHybridPolicy &ex_policy) { writeToFile(par_device); };
+
     void writeToFile(const ParallelPolicy &ex_policy)
     {
         writeToFile();
@@ -145,6 +256,23 @@ class BodyStatesRecording : public BaseIO
         }
     };
 
+    /** the variable is written only once per output interval, MaxReal for writing it once */
+    void setOutputInterval(SPHBody &sph_body, const std::string &variable_name, Real output_interval)
+    {
+        getBodyStatesSelection(sph_body).setOutputInterval(variable_name, output_interval);
+    };
+    /** only the particles with every k-th original id are written */
+    void setParticleStride(SPHBody &sph_body, size_t particle_stride)
+    {
+        getBodyStatesSelection(sph_body).setParticleStride(particle_stride);
+    };
+    /** only the particles in the body part are written */
+    template <class BodyPartType>
+    void setOutputRegion(BodyPartType &body_part)
+    {
+        getBodyStatesSelection(body_part.getSPHBody()).setRegion(body_part);
+    };
+
     template <typename DerivedVariableMethod,
               typename DynamicsIdentifier, typename... Args>
     void addDerivedVariableRecording(DynamicsIdentifier &identifier, Args &&...args)
@@ -172,6 +300,13 @@ class BodyStatesRecording : public BaseIO
     bool state_recording_;
     StdVec<OperationOnDataAssemble<ParticleVariables, prepareVariablesToWrite>>
         prepare_variable_to_write_;
+    StdVec<BodyStatesSelection> body_states_selections_;
+
+    BodyStatesSelection &getBodyStatesSelection(SPHBody &sph_body);
+    void updateBodyStatesSelections();
+    /** a snapshot is written instead of the particles for async-io or a selection of the body states */
+    bool isSnapshotNeeded(size_t body_index);
+    SharedPtr<BodyStatesSnapshot> makeBodyStatesSnapshot(size_t body_index);
 
     virtual void writeWithFileName(const std::string &sequence) = 0;
 
@@ -181,7 +316,11 @@ class BodyStatesRecording : public BaseIO
 
 /**
  * @class RestartIO
- * @brief Write and read the restart files in XML format.
+ * @brief Write and read the restart files in binary format.
+ * @details Optionally, the payloads are compressed losslessly and, in incremental mode,
+ *          a variable unchanged since the last checkpoint refers to the earlier file
+ *          instead of being written again. With a retention number given, only the
+ *          last checkpoints are kept, together with the earlier body files they refer to.
  */
 class RestartIO : public BaseIO
 {
@@ -191,13 +330,32 @@ class RestartIO : public BaseIO
     StdVec<std::string> file_names_;
     StdVec<OperationOnDataAssemble<ParticleVariables, prepareVariablesToWrite>>
         prepare_variable_to_restart_;
+    BinaryDataCompression compression_;
+    bool is_incremental_;
+    size_t number_of_retained_; /**< zero for keeping all checkpoints */
+    StdVec<BinaryDataIndex> last_indexes_;
+    StdVec<size_t> retained_steps_;
+    /** for each body, the files referred by each written file, including the file itself */
+    StdVec<std::map<std::string, std::set<std::string>>> referred_files_;
 
     Real readRestartTime(size_t restart_step);
+    virtual std::string bodyFileName(size_t body_index, size_t iteration_step);
+    virtual void writeRestartTime(size_t iteration_step);
+    virtual void readBodyFromFile(size_t body_index, size_t restart_step);
+    void removeExpiredCheckpoints();
+    /** rebuilds the records of the checkpoints up to the restart step from the files in the restart folder,
+     *  so that a restarted run refers to and removes the earlier files as the original run would */
+    void recoverCheckpointRecords(size_t restart_step);
 
   public:
     RestartIO(SPHSystem &sph_system);
+    RestartIO(SPHSystem &sph_system, SPHBodyVector bodies);
     virtual ~RestartIO(){};
 
+    void setCompression(bool is_compressed);
+    void setIncremental(bool is_incremental) { is_incremental_ = is_incremental; };
+    void setRetention(size_t number_of_checkpoints) { number_of_retained_ = number_of_checkpoints; };
+
     virtual void writeToFile(size_t iteration_step = 0) override;
 
     template <class ExecutionPolicy>
@@ -207,6 +365,7 @@ class RestartIO : public BaseIO
         {
             prepare_variable_to_restart_[i](ex_policy);
         }
+        waitForOutputTransfers(ex_policy);
         writeToFile(iteration_step);
     };
 
@@ -219,6 +378,32 @@ class RestartIO : public BaseIO
     };
 };
 
+/**
+ * @class RemappingRestartIO
+ * @brief Read the restart files of a body saved with a different resolution or particle
+ *        decomposition into a source body, whose particles are generated from the same files
+ *        by ParticleGenerator<BaseParticles, Restart>.
+ * @details The states read are then remapped to the target body by SPH interpolation,
+ *          i.e. InterpolatingAQuantity with a contact relation from the target to the source body.
+ */
+class RemappingRestartIO : public RestartIO
+{
+  public:
+    RemappingRestartIO(SPHBody &source_body, const std::string &restart_body_name);
+    virtual ~RemappingRestartIO(){};
+
+    /** the source body is only read, and its files are not written */
+    virtual void writeToFile(size_t iteration_step = 0) override{};
+
+    template <typename DataType>
+    void addToRemap(const std::string &name)
+    {
+        BaseParticles &particles = bodies_[0]->getBaseParticles();
+        particles.registerStateVariable<DataType>(name);
+        particles.addVariableToRestart<DataType>(name);
+    };
+};
+
 /**
  * @class ReloadParticleIO
  * @brief Write and read the particle-reloading files in XML format.
@@ -262,10 +447,84 @@ class ReloadParticleIO : public BaseIO
         {
             prepare_variable_to_reload_[i](ex_policy);
         }
+        waitForOutputTransfers(ex_policy);
         writeToFile(iteration_step);
     };
 };
 
+/**
+ * @class RelaxedParticlesCache
+ * @brief Write and read the relaxed particles of a body in a binary cache.
+ * @details The cache file is keyed by a hash of the particles generated before relaxation,
+ * which reflect the geometry and the resolution, the kernel and a description of the relaxation,
+ * e.g. its parameters and the input files of the geometry. The cache is constructed after
+ * the particles are generated and before the relaxation, so that the relaxation is skipped
+ * if the relaxed particles are read from the cache.
+ */
+class RelaxedParticlesCache : public BaseIO
+{
+  protected:
+    SPHBody &sph_body_;
+    std::string cache_folder_;
+    std::string key_; /**< the raw key, which is hashed for the cache file name */
+    OperationOnDataAssemble<ParticleVariables, prepareVariablesToWrite> prepare_variable_to_reload_;
+
+    template <typename DataType>
+    void appendToKey(const DataType &value)
+    {
+        key_.append(reinterpret_cast<const char *>(&value), sizeof(DataType));
+    };
+    std::string cacheFileFullPath();
+
+  public:
+    RelaxedParticlesCache(SPHBody &sph_body, const std::string &relaxation_description = "");
+    virtual ~RelaxedParticlesCache(){};
+
+    void addToKey(const std::string &description) { key_ += description; };
+    /** adds the content of an input file, e.g. the STL file of the geometry, to the key */
+    void addFileToKey(const std::string &filefullpath);
+    template <typename DataType>
+    void addToReload(const std::string &name)
+    {
+        sph_body_.getBaseParticles().addVariableToReload<DataType>(name);
+    };
+
+    bool isCached() { return fs::exists(cacheFileFullPath()); };
+    /** reads the relaxed particles, returns false if they are not cached */
+    bool readFromFile();
+    virtual void writeToFile(size_t iteration_step = 0) override;
+
+    template <class ExecutionPolicy>
+    void writeToFile(const ExecutionPolicy &ex_policy, size_t iteration_step = 0)
+    {
+        prepare_variable_to_reload_(ex_policy);
+        waitForOutputTransfers(ex_policy);
+        writeToFile(iteration_step);
+    };
+};
+
+/**
+ * @class ConfigurationStatisticsRecording
+ * @brief Write the cell occupancy and the neighbor counts of the relations of a real body
+ * every given number of steps, e.g. to find the clustering which slows the neighbor search
+ * or to size the neighbor lists on device. The relations are those created before this recording.
+ */
+class ConfigurationStatisticsRecording : public BaseIO
+{
+  protected:
+    RealBody &real_body_;
+    size_t interval_;
+    StdVec<SPHRelation *> relations_;
+    std::string filefullpath_;
+
+  public:
+    ConfigurationStatisticsRecording(RealBody &real_body, size_t interval = 1);
+    virtual ~ConfigurationStatisticsRecording(){};
+    /** write the histograms as well, e.g. at the end of a run */
+    void writeReport(std::ostream &output);
+    virtual void writeToFile(size_t iteration_step = 0) override;
+};
+
 class ParticleGenerationRecording : public BaseIO
 {
 
@@ -0,0 +1,234 @@
+#include "io_distributed.hpp"
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+//=============================================================================================//
+DistributedParticlesScope::
+    DistributedParticlesScope(StdVec<DistributedParticleExchange *> &particle_exchanges)
+    : particle_exchanges_(particle_exchanges)
+{
+    for (DistributedParticleExchange *particle_exchange : particle_exchanges_)
+    {
+        particle_exchange->getSPHBody().getBaseParticles().decrementTotalRealParticles(
+            particle_exchange->TotalHaloParticles());
+    }
+}
+//=============================================================================================//
+DistributedParticlesScope::~DistributedParticlesScope()
+{
+    for (DistributedParticleExchange *particle_exchange : particle_exchanges_)
+    {
+        particle_exchange->getSPHBody().getBaseParticles().incrementTotalRealParticles(
+            particle_exchange->TotalHaloParticles());
+    }
+}
+//=============================================================================================//
+DistributedBodyStatesRecordingToVtp::
+    DistributedBodyStatesRecordingToVtp(SPHSystem &sph_system, DistributedDomain &distributed_domain,
+                                        StdVec<DistributedParticleExchange *> particle_exchanges)
+    : BodyStatesRecordingToVtp(sph_system), domain_(distributed_domain),
+      particle_exchanges_(particle_exchanges), written_steps_(bodies_.size()) {}
+//=============================================================================================//
+void DistributedBodyStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
+{
+    StdVec<bool> is_written(bodies_.size(), false);
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        is_written[i] = state_recording_ && bodies_[i]->checkNewlyUpdated();
+    }
+
+    {
+        DistributedParticlesScope owned_particles_only(particle_exchanges_);
+        BodyStatesRecordingToVtp::writeWithFileName(sequence + "_p" + std::to_string(domain_.Rank()));
+    }
+
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        if (is_written[i])
+        {
+            written_steps_[i].push_back(std::make_pair(sequence, sv_physical_time_.getValue()));
+            if (domain_.Rank() == 0)
+            {
+                writePvdFile(i);
+            }
+        }
+    }
+}
+//=============================================================================================//
+void DistributedBodyStatesRecordingToVtp::writePvdFile(size_t body_index)
+{
+    std::string body_name = bodies_[body_index]->getName();
+    std::string filefullpath = io_environment_.output_folder_ + "/" + body_name + ".pvd";
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+    out_file << " <Collection>\n";
+    for (const auto &[sequence, physical_time] : written_steps_[body_index])
+    {
+        for (int rank = 0; rank != domain_.NumberOfRanks(); ++rank)
+        {
+            out_file << "  <DataSet timestep=\"" << std::setprecision(9) << physical_time
+                     << "\" part=\"" << rank << "\" file=\"" << body_name << "_" << sequence
+                     << "_p" << rank << ".vtp\"/>\n";
+        }
+    }
+    out_file << " </Collection>\n";
+    out_file << "</VTKFile>\n";
+    out_file.close();
+}
+//=============================================================================================//
+DistributedRestartIO::
+    DistributedRestartIO(SPHSystem &sph_system, DistributedDomain &distributed_domain,
+                         StdVec<DistributedParticleExchange *> particle_exchanges)
+    : RestartIO(sph_system), domain_(distributed_domain),
+      particle_exchanges_(particle_exchanges), body_exchanges_(bodies_.size(), nullptr)
+{
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        for (DistributedParticleExchange *particle_exchange : particle_exchanges_)
+        {
+            if (&particle_exchange->getSPHBody() == bodies_[i])
+            {
+                body_exchanges_[i] = particle_exchange;
+            }
+        }
+        file_names_[i] = pieceFileName(i, domain_.Rank());
+    }
+}
+//=============================================================================================//
+std::string DistributedRestartIO::pieceFileName(size_t body_index, int piece)
+{
+    return io_environment_.restart_folder_ + "/" + bodies_[body_index]->getName() +
+           "_p" + std::to_string(piece) + "_rst_";
+}
+//=============================================================================================//
+std::string DistributedRestartIO::bodyFileName(size_t body_index, size_t iteration_step)
+{
+    return bodies_[body_index]->getName() + "_p" + std::to_string(domain_.Rank()) +
+           "_rst_" + padValueWithZeros(iteration_step) + ".bin";
+}
+//=============================================================================================//
+void DistributedRestartIO::writeToFile(size_t iteration_step)
+{
+    DistributedParticlesScope owned_particles_only(particle_exchanges_);
+    RestartIO::writeToFile(iteration_step);
+}
+//=============================================================================================//
+void DistributedRestartIO::writeRestartTime(size_t iteration_step)
+{
+    if (domain_.Rank() == 0)
+    {
+        RestartIO::writeRestartTime(iteration_step);
+
+        std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(iteration_step) + ".dat";
+        std::ofstream out_file(overall_filefullpath.c_str(), std::ios::app);
+        StdVec<Real> &slab_cuts = domain_.SlabCuts();
+        out_file << domain_.NumberOfRanks();
+        for (Real slab_cut : slab_cuts)
+        {
+            out_file << " " << std::setprecision(17) << slab_cut;
+        }
+        out_file << "\n";
+        out_file.close();
+    }
+}
+//=============================================================================================//
+void DistributedRestartIO::readFromFile(size_t restart_step)
+{
+    readRestartSlabCuts(restart_step);
+    if (int(restart_slab_cuts_.size()) == domain_.NumberOfRanks() + 1)
+    {
+        domain_.resetSlabCuts(restart_slab_cuts_);
+    }
+    RestartIO::readFromFile(restart_step);
+}
+//=============================================================================================//
+void DistributedRestartIO::readRestartSlabCuts(size_t restart_step)
+{
+    std::string overall_filefullpath = overall_file_path_ + padValueWithZeros(restart_step) + ".dat";
+    std::ifstream in_file(overall_filefullpath.c_str());
+    Real restart_time;
+    int number_of_pieces = 0;
+    in_file >> restart_time >> number_of_pieces;
+    if (!in_file || number_of_pieces < 1)
+    {
+        std::cout << "\n Error: the input file:" << overall_filefullpath
+                  << " is not written by a distributed run" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    restart_slab_cuts_.resize(number_of_pieces + 1);
+    for (Real &slab_cut : restart_slab_cuts_)
+    {
+        in_file >> slab_cut;
+    }
+    in_file.close();
+}
+//=============================================================================================//
+void DistributedRestartIO::readBodyFromFile(size_t body_index, size_t restart_step)
+{
+    std::string step = padValueWithZeros(restart_step) + ".bin";
+    DistributedParticleExchange *particle_exchange = body_exchanges_[body_index];
+    if (particle_exchange == nullptr)
+    {
+        readPieceFromFile(body_index, pieceFileName(body_index, 0) + step, true);
+        return;
+    }
+
+    int axis = domain_.DecompositionAxis();
+    BoundingBox &local_bounds = domain_.LocalDomainBounds();
+    int number_of_pieces = int(restart_slab_cuts_.size()) - 1;
+    bool is_first_piece = true;
+    for (int piece = 0; piece != number_of_pieces; ++piece)
+    {
+        if (restart_slab_cuts_[piece + 1] >= local_bounds.first_[axis] &&
+            restart_slab_cuts_[piece] <= local_bounds.second_[axis])
+        {
+            readPieceFromFile(body_index, pieceFileName(body_index, piece) + step, is_first_piece);
+            is_first_piece = false;
+        }
+    }
+    particle_exchange->distributeInitialParticles();
+    particle_exchange->exec();
+}
+//=============================================================================================//
+UnsignedInt DistributedRestartIO::
+    readPieceFromFile(size_t body_index, const std::string &filefullpath, bool is_first_piece)
+{
+    if (!fs::exists(filefullpath))
+    {
+        std::cout << "\n Error: the input file:" << filefullpath << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    BaseParticles &particles = bodies_[body_index]->getBaseParticles();
+    BinaryDataReader binary_reader(filefullpath);
+    UnsignedInt number_of_particles = binary_reader.getIndex()["OriginalID"].entry_.number_of_elements_;
+    UnsignedInt first_index = is_first_piece ? 0 : particles.TotalRealParticles();
+    if (first_index + number_of_particles > particles.RealParticlesBound())
+    {
+        std::cout << "\n Error: the particle buffer of " << bodies_[body_index]->getName()
+                  << " is not large enough for the restart pieces!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    if (is_first_piece) // the restart variables not initialized yet are initialized by the body
+    {
+        bodies_[body_index]->readParticlesFromBinaryForRestart(filefullpath);
+    }
+    else
+    {
+        OperationOnDataAssemble<ParticleVariables, ReadPieceVariables>
+            read_piece_variables(particles.VariablesToRestart());
+        read_piece_variables(binary_reader, first_index);
+    }
+    particles.decrementTotalRealParticles(particles.TotalRealParticles() - first_index);
+    particles.incrementTotalRealParticles(number_of_particles);
+    return number_of_particles;
+}
+//=============================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
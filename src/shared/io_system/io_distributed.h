@@ -0,0 +1,120 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_distributed.h
+ * @brief 	Output and restart of bodies decomposed across MPI ranks.
+ * @details Each rank writes the owned particles of its slab into its own piece file in parallel,
+ *          so that the halo is not written and no rank waits for another.
+ *          The first rank writes the small master files only.
+ *          Available when built with SPHINXSYS_USE_MPI.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IO_DISTRIBUTED_H
+#define IO_DISTRIBUTED_H
+
+#include "distributed_dynamics_ck.h"
+#include "io_vtk.h"
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+/**
+ * @class DistributedParticlesScope
+ * @brief Hides the halo particles behind the owned ones within the scope.
+ */
+class DistributedParticlesScope
+{
+    StdVec<DistributedParticleExchange *> &particle_exchanges_;
+
+  public:
+    explicit DistributedParticlesScope(StdVec<DistributedParticleExchange *> &particle_exchanges);
+    ~DistributedParticlesScope();
+};
+
+/**
+ * @class DistributedBodyStatesRecordingToVtp
+ * @brief Each rank writes its piece <body>_<step>_p<rank>.vtp, and the first rank
+ *        keeps a <body>.pvd collection with all pieces of all steps for ParaView.
+ */
+class DistributedBodyStatesRecordingToVtp : public BodyStatesRecordingToVtp
+{
+  public:
+    DistributedBodyStatesRecordingToVtp(SPHSystem &sph_system, DistributedDomain &distributed_domain,
+                                        StdVec<DistributedParticleExchange *> particle_exchanges);
+    virtual ~DistributedBodyStatesRecordingToVtp() {};
+
+  protected:
+    DistributedDomain &domain_;
+    StdVec<DistributedParticleExchange *> particle_exchanges_;
+    /** the steps and physical times written for each body */
+    StdVec<StdVec<std::pair<std::string, Real>>> written_steps_;
+
+    virtual void writeWithFileName(const std::string &sequence) override;
+    void writePvdFile(size_t body_index);
+};
+
+/**
+ * @class DistributedRestartIO
+ * @brief Each rank writes the restart files of its piece, and the first rank writes
+ *        the physical time followed by the slab cuts of the pieces.
+ *        The files can be read back on a different number of ranks: each rank reads the pieces
+ *        overlapping its slab and keeps the particles in it. With the same number of ranks,
+ *        the slab cuts of the checkpoint are restored so that each rank reads only its own piece.
+ *        Bodies without particle exchange are replicated on all ranks and read from the first piece.
+ */
+class DistributedRestartIO : public RestartIO
+{
+    struct ReadPieceVariables
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        BinaryDataReader &binary_reader, size_t first_index);
+    };
+
+  public:
+    DistributedRestartIO(SPHSystem &sph_system, DistributedDomain &distributed_domain,
+                         StdVec<DistributedParticleExchange *> particle_exchanges);
+    virtual ~DistributedRestartIO() {};
+
+    virtual void writeToFile(size_t iteration_step = 0) override;
+    virtual void readFromFile(size_t iteration_step = 0) override;
+
+  protected:
+    DistributedDomain &domain_;
+    StdVec<DistributedParticleExchange *> particle_exchanges_;
+    /** for each body, its particle exchange or nullptr if replicated */
+    StdVec<DistributedParticleExchange *> body_exchanges_;
+    StdVec<Real> restart_slab_cuts_;
+
+    std::string pieceFileName(size_t body_index, int piece);
+    virtual std::string bodyFileName(size_t body_index, size_t iteration_step) override;
+    virtual void writeRestartTime(size_t iteration_step) override;
+    virtual void readBodyFromFile(size_t body_index, size_t restart_step) override;
+    void readRestartSlabCuts(size_t restart_step);
+    /** returns the number of particles read */
+    UnsignedInt readPieceFromFile(size_t body_index, const std::string &filefullpath, bool is_first_piece);
+};
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
+#endif // IO_DISTRIBUTED_H
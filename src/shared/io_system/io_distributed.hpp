@@ -0,0 +1,24 @@
+#ifndef IO_DISTRIBUTED_HPP
+#define IO_DISTRIBUTED_HPP
+
+#include "io_distributed.h"
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+//=============================================================================================//
+template <typename DataType>
+void DistributedRestartIO::ReadPieceVariables::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           BinaryDataReader &binary_reader, size_t first_index)
+{
+    for (DiscreteVariable<DataType> *variable : variables)
+    {
+        binary_reader.readVariable(variable->Name(), variable->DataField() + first_index,
+                                   variable->getDataFieldSize() - first_index);
+    }
+}
+//=============================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
+#endif // IO_DISTRIBUTED_HPP
@@ -11,6 +11,12 @@ IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output)
       input_folder_("./input"), output_folder_("./output"),
       restart_folder_("./restart"), reload_folder_("./reload")
 {
+    if (!sph_system.MemberName().empty())
+    {
+        output_folder_ += "/" + sph_system.MemberName();
+        restart_folder_ += "/" + sph_system.MemberName();
+    }
+
     if (!fs::exists(input_folder_))
     {
         fs::create_directory(input_folder_);
@@ -18,12 +24,12 @@ IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output)
 
     if (!fs::exists(output_folder_))
     {
-        fs::create_directory(output_folder_);
+        fs::create_directories(output_folder_);
     }
 
     if (!fs::exists(restart_folder_))
     {
-        fs::create_directory(restart_folder_);
+        fs::create_directories(restart_folder_);
     }
 
     if (!fs::exists(reload_folder_))
@@ -34,11 +40,11 @@ IOEnvironment::IOEnvironment(SPHSystem &sph_system, bool delete_output)
     if (sph_system.RestartStep() == 0)
     {
         fs::remove_all(restart_folder_);
-        fs::create_directory(restart_folder_);
+        fs::create_directories(restart_folder_);
         if (delete_output == true)
         {
             fs::remove_all(output_folder_);
-            fs::create_directory(output_folder_);
+            fs::create_directories(output_folder_);
         }
     }
 
@@ -0,0 +1,88 @@
+#include "io_hdf5.hpp"
+
+#if SPHINXSYS_USE_HDF5
+namespace SPH
+{
+//=============================================================================================//
+BodyStatesRecordingToHdf5::BodyStatesRecordingToHdf5(SPHSystem &sph_system, const std::string &file_name)
+    : BodyStatesRecording(sph_system), hdf5_file_name_(file_name + ".h5"),
+      hdf5_filefullpath_(io_environment_.output_folder_ + "/" + hdf5_file_name_),
+      xdmf_filefullpath_(io_environment_.output_folder_ + "/" + file_name + ".xmf"),
+      compression_level_(0), is_file_created_(false) {}
+//=============================================================================================//
+BodyStatesRecordingToHdf5::BodyStatesRecordingToHdf5(SPHBody &body)
+    : BodyStatesRecording(body), hdf5_file_name_(body.getName() + "_States.h5"),
+      hdf5_filefullpath_(io_environment_.output_folder_ + "/" + hdf5_file_name_),
+      xdmf_filefullpath_(io_environment_.output_folder_ + "/" + body.getName() + "_States.xmf"),
+      compression_level_(0), is_file_created_(false) {}
+//=============================================================================================//
+void BodyStatesRecordingToHdf5::writeWithFileName(const std::string &sequence)
+{
+    std::string step_grid;
+    std::string hdf5_filefullpath = hdf5_filefullpath_;
+    int compression_level = compression_level_;
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        SPHBody *body = bodies_[i];
+        if (body->checkNewlyUpdated() && state_recording_)
+        {
+            std::string group_name = "/" + sequence + "/" + body->getName();
+            bool is_file_created = is_file_created_;
+            is_file_created_ = true;
+            BaseParticles &base_particles = body->getBaseParticles();
+
+            auto write_body = [=](auto &particles)
+            {
+                hid_t file_id = is_file_created
+                                    ? H5Fopen(hdf5_filefullpath.c_str(), H5F_ACC_RDWR, H5P_DEFAULT)
+                                    : H5Fcreate(hdf5_filefullpath.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+                if (file_id < 0)
+                {
+                    std::cout << "\n Error: the HDF5 file:" << hdf5_filefullpath << " can not be opened." << std::endl;
+                    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                    exit(1);
+                }
+                writeBodyToHdf5(file_id, group_name, compression_level, particles);
+                H5Fclose(file_id);
+            };
+
+            if (isSnapshotNeeded(i))
+            {
+                SharedPtr<BodyStatesSnapshot> snapshot = makeBodyStatesSnapshot(i);
+                step_grid += xdmfBodyGrid(body->getName(), group_name, *snapshot);
+                submitOutput([=]()
+                             { write_body(*snapshot); });
+            }
+            else
+            {
+                step_grid += xdmfBodyGrid(body->getName(), group_name, base_particles);
+                write_body(base_particles);
+            }
+        }
+        body->setNotNewlyUpdated();
+    }
+
+    if (!step_grid.empty())
+    {
+        xdmf_steps_ += "   <Grid Name=\"Step_" + sequence + "\" GridType=\"Collection\" CollectionType=\"Spatial\">\n";
+        xdmf_steps_ += "    <Time Value=\"" + std::to_string(sv_physical_time_.getValue()) + "\"/>\n";
+        xdmf_steps_ += step_grid;
+        xdmf_steps_ += "   </Grid>\n";
+
+        std::string xdmf_file_content = "<?xml version=\"1.0\"?>\n";
+        xdmf_file_content += "<Xdmf Version=\"3.0\">\n <Domain>\n";
+        xdmf_file_content += "  <Grid Name=\"BodyStates\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+        xdmf_file_content += xdmf_steps_;
+        xdmf_file_content += "  </Grid>\n </Domain>\n</Xdmf>\n";
+
+        std::string xdmf_filefullpath = xdmf_filefullpath_;
+        submitOutput([=]()
+                     {
+                         std::ofstream out_file(xdmf_filefullpath.c_str(), std::ios::trunc);
+                         out_file << xdmf_file_content;
+                         out_file.close(); });
+    }
+}
+//=============================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_HDF5
@@ -0,0 +1,90 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_hdf5.h
+ * @brief 	Output of body states into a single HDF5 file with an XDMF description.
+ * @details All bodies and all output steps of a run are written into one file
+ *          as groups /<step>/<body>/<variable>, so that a run no longer creates
+ *          a large number of small files and the data can be read partially in
+ *          post-processing. The XDMF file describes the data as a temporal
+ *          collection of poly-vertex grids which can be opened by ParaView.
+ *          Available when built with SPHINXSYS_USE_HDF5.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IO_HDF5_H
+#define IO_HDF5_H
+
+#include "io_base.h"
+
+#if SPHINXSYS_USE_HDF5
+#include <hdf5.h>
+
+namespace SPH
+{
+/**
+ * @class BodyStatesRecordingToHdf5
+ * @brief Write the states of bodies into a chunked and optionally compressed HDF5 file.
+ */
+class BodyStatesRecordingToHdf5 : public BodyStatesRecording
+{
+  public:
+    BodyStatesRecordingToHdf5(SPHSystem &sph_system, const std::string &file_name = "BodyStates");
+    BodyStatesRecordingToHdf5(SPHBody &body);
+    virtual ~BodyStatesRecordingToHdf5(){};
+    /** deflate level from 0 (no compression) to 9, used if the filter is available */
+    void setCompressionLevel(int compression_level) { compression_level_ = compression_level; };
+
+  protected:
+    std::string hdf5_file_name_;
+    std::string hdf5_filefullpath_;
+    std::string xdmf_filefullpath_;
+    int compression_level_;
+    bool is_file_created_;
+    std::string xdmf_steps_; /**< the grids of all steps written so far */
+
+    virtual void writeWithFileName(const std::string &sequence) override;
+    /** ParticlesType is BaseParticles or, for asynchronous or selected output, BodyStatesSnapshot. */
+    template <class ParticlesType>
+    std::string xdmfBodyGrid(const std::string &body_name, const std::string &group_name, ParticlesType &particles);
+    template <class ParticlesType>
+    static void writeBodyToHdf5(hid_t file_id, const std::string &group_name,
+                                int compression_level, ParticlesType &particles);
+    template <typename ScalarType>
+    static void writeDataSet(hid_t group_id, const std::string &name, const ScalarType *data,
+                             size_t number_of_tuples, int number_of_components, int compression_level);
+    template <int DIMENSION>
+    static void writeVectorDataSet(hid_t group_id, const std::string &name, const Eigen::Matrix<Real, DIMENSION, 1> *data,
+                                   size_t number_of_tuples, int compression_level);
+    template <int DIMENSION>
+    static void writeMatrixDataSet(hid_t group_id, const std::string &name, const Eigen::Matrix<Real, DIMENSION, DIMENSION> *data,
+                                   size_t number_of_tuples, int compression_level);
+    template <typename ScalarType>
+    std::string xdmfDataItem(const std::string &path, size_t number_of_tuples, int number_of_components);
+    template <typename DataType>
+    void appendXdmfAttributes(std::string &grid, const std::string &group_name, const std::string &attribute_type,
+                              int number_of_components, ParticleVariables &variables, size_t number_of_tuples);
+};
+} // namespace SPH
+#endif // SPHINXSYS_USE_HDF5
+#endif // IO_HDF5_H
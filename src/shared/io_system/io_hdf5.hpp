@@ -0,0 +1,202 @@
+#ifndef IO_HDF5_HPP
+#define IO_HDF5_HPP
+
+#include "io_hdf5.h"
+
+#if SPHINXSYS_USE_HDF5
+namespace SPH
+{
+//=============================================================================================//
+template <typename ScalarType>
+hid_t hdf5NativeType()
+{
+    if constexpr (std::is_floating_point<ScalarType>::value)
+        return sizeof(ScalarType) == 8 ? H5T_NATIVE_DOUBLE : H5T_NATIVE_FLOAT;
+    else if constexpr (std::is_signed<ScalarType>::value)
+        return sizeof(ScalarType) == 8 ? H5T_NATIVE_INT64 : H5T_NATIVE_INT32;
+    else
+        return sizeof(ScalarType) == 8 ? H5T_NATIVE_UINT64 : H5T_NATIVE_UINT32;
+}
+//=============================================================================================//
+template <typename ScalarType>
+void BodyStatesRecordingToHdf5::writeDataSet(hid_t group_id, const std::string &name, const ScalarType *data,
+                                             size_t number_of_tuples, int number_of_components, int compression_level)
+{
+    int rank = number_of_components == 1 ? 1 : 2;
+    hsize_t dimensions[2] = {number_of_tuples, hsize_t(number_of_components)};
+    hid_t data_space_id = H5Screate_simple(rank, dimensions, nullptr);
+
+    hid_t property_id = H5Pcreate(H5P_DATASET_CREATE);
+    if (number_of_tuples != 0)
+    {
+        hsize_t chunk_dimensions[2] = {SMIN(number_of_tuples, size_t(65536)), hsize_t(number_of_components)};
+        H5Pset_chunk(property_id, rank, chunk_dimensions);
+        if (compression_level > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+        {
+            H5Pset_shuffle(property_id);
+            H5Pset_deflate(property_id, compression_level);
+        }
+    }
+
+    hid_t data_set_id = H5Dcreate2(group_id, name.c_str(), hdf5NativeType<ScalarType>(), data_space_id,
+                                   H5P_DEFAULT, property_id, H5P_DEFAULT);
+    if (number_of_tuples != 0)
+    {
+        H5Dwrite(data_set_id, hdf5NativeType<ScalarType>(), H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+    }
+    H5Dclose(data_set_id);
+    H5Pclose(property_id);
+    H5Sclose(data_space_id);
+}
+//=============================================================================================//
+template <int DIMENSION>
+void BodyStatesRecordingToHdf5::writeVectorDataSet(hid_t group_id, const std::string &name,
+                                                   const Eigen::Matrix<Real, DIMENSION, 1> *data,
+                                                   size_t number_of_tuples, int compression_level)
+{
+    if constexpr (DIMENSION == 3)
+    {
+        writeDataSet(group_id, name, reinterpret_cast<const Real *>(data), number_of_tuples, 3, compression_level);
+    }
+    else
+    {
+        StdVec<Real> buffer(3 * number_of_tuples);
+        for (size_t i = 0; i != number_of_tuples; ++i)
+        {
+            Vec3d vector_value = upgradeToVec3d(data[i]);
+            for (int k = 0; k != 3; ++k)
+                buffer[3 * i + k] = vector_value[k];
+        }
+        writeDataSet(group_id, name, buffer.data(), number_of_tuples, 3, compression_level);
+    }
+}
+//=============================================================================================//
+template <int DIMENSION>
+void BodyStatesRecordingToHdf5::writeMatrixDataSet(hid_t group_id, const std::string &name,
+                                                   const Eigen::Matrix<Real, DIMENSION, DIMENSION> *data,
+                                                   size_t number_of_tuples, int compression_level)
+{
+    if constexpr (DIMENSION == 3)
+    {
+        writeDataSet(group_id, name, reinterpret_cast<const Real *>(data), number_of_tuples, 9, compression_level);
+    }
+    else
+    {
+        StdVec<Real> buffer(9 * number_of_tuples);
+        for (size_t i = 0; i != number_of_tuples; ++i)
+        {
+            Mat3d matrix_value = upgradeToMat3d(data[i]);
+            std::copy_n(matrix_value.data(), 9, &buffer[9 * i]); // column major
+        }
+        writeDataSet(group_id, name, buffer.data(), number_of_tuples, 9, compression_level);
+    }
+}
+//=============================================================================================//
+template <class ParticlesType>
+void BodyStatesRecordingToHdf5::writeBodyToHdf5(hid_t file_id, const std::string &group_name,
+                                                int compression_level, ParticlesType &particles)
+{
+    size_t total_real_particles = particles.TotalRealParticles();
+    ParticleVariables &variables_to_write = particles.VariablesToWrite();
+
+    hid_t link_property_id = H5Pcreate(H5P_LINK_CREATE);
+    H5Pset_create_intermediate_group(link_property_id, 1);
+    hid_t group_id = H5Gcreate2(file_id, group_name.c_str(), link_property_id, H5P_DEFAULT, H5P_DEFAULT);
+
+    writeVectorDataSet(group_id, "Position", particles.ParticlePositions(), total_real_particles, compression_level);
+    writeDataSet(group_id, "OriginalParticle_ID", particles.ParticleOriginalIds(), total_real_particles, 1, compression_level);
+
+    constexpr int type_index_UnsignedInt = DataTypeIndex<UnsignedInt>::value;
+    for (DiscreteVariable<UnsignedInt> *variable : std::get<type_index_UnsignedInt>(variables_to_write))
+    {
+        writeDataSet(group_id, variable->Name(), variable->DataField(), total_real_particles, 1, compression_level);
+    }
+
+    constexpr int type_index_int = DataTypeIndex<int>::value;
+    for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write))
+    {
+        writeDataSet(group_id, variable->Name(), variable->DataField(), total_real_particles, 1, compression_level);
+    }
+
+    constexpr int type_index_Real = DataTypeIndex<Real>::value;
+    for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables_to_write))
+    {
+        writeDataSet(group_id, variable->Name(), variable->DataField(), total_real_particles, 1, compression_level);
+    }
+
+    constexpr int type_index_Vecd = DataTypeIndex<Vecd>::value;
+    for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write))
+    {
+        writeVectorDataSet(group_id, variable->Name(), variable->DataField(), total_real_particles, compression_level);
+    }
+
+    constexpr int type_index_Matd = DataTypeIndex<Matd>::value;
+    for (DiscreteVariable<Matd> *variable : std::get<type_index_Matd>(variables_to_write))
+    {
+        writeMatrixDataSet(group_id, variable->Name(), variable->DataField(), total_real_particles, compression_level);
+    }
+
+    H5Gclose(group_id);
+    H5Pclose(link_property_id);
+}
+//=============================================================================================//
+template <typename ScalarType>
+std::string BodyStatesRecordingToHdf5::xdmfDataItem(const std::string &path, size_t number_of_tuples,
+                                                   int number_of_components)
+{
+    std::string number_type = std::is_floating_point<ScalarType>::value
+                                  ? "Float"
+                                  : (std::is_signed<ScalarType>::value ? "Int" : "UInt");
+    std::string dimensions = std::to_string(number_of_tuples);
+    if (number_of_components != 1)
+        dimensions += " " + std::to_string(number_of_components);
+
+    return "      <DataItem Dimensions=\"" + dimensions + "\" NumberType=\"" + number_type +
+           "\" Precision=\"" + std::to_string(sizeof(ScalarType)) + "\" Format=\"HDF\">" +
+           hdf5_file_name_ + ":" + path + "</DataItem>\n";
+}
+//=============================================================================================//
+template <typename DataType>
+void BodyStatesRecordingToHdf5::appendXdmfAttributes(std::string &grid, const std::string &group_name,
+                                                     const std::string &attribute_type, int number_of_components,
+                                                     ParticleVariables &variables, size_t number_of_tuples)
+{
+    using ScalarType = std::conditional_t<std::is_arithmetic<DataType>::value, DataType, Real>;
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    for (DiscreteVariable<DataType> *variable : std::get<type_index>(variables))
+    {
+        grid += "     <Attribute Name=\"" + variable->Name() + "\" AttributeType=\"" + attribute_type + "\" Center=\"Node\">\n";
+        grid += xdmfDataItem<ScalarType>(group_name + "/" + variable->Name(), number_of_tuples, number_of_components);
+        grid += "     </Attribute>\n";
+    }
+}
+//=============================================================================================//
+template <class ParticlesType>
+std::string BodyStatesRecordingToHdf5::xdmfBodyGrid(const std::string &body_name, const std::string &group_name,
+                                                    ParticlesType &particles)
+{
+    size_t total_real_particles = particles.TotalRealParticles();
+    ParticleVariables &variables_to_write = particles.VariablesToWrite();
+
+    std::string grid = "    <Grid Name=\"" + body_name + "\" GridType=\"Uniform\">\n";
+    grid += "     <Topology TopologyType=\"Polyvertex\" NumberOfElements=\"" +
+            std::to_string(total_real_particles) + "\" NodesPerElement=\"1\"/>\n";
+    grid += "     <Geometry GeometryType=\"XYZ\">\n";
+    grid += xdmfDataItem<Real>(group_name + "/Position", total_real_particles, 3);
+    grid += "     </Geometry>\n";
+    grid += "     <Attribute Name=\"OriginalParticle_ID\" AttributeType=\"Scalar\" Center=\"Node\">\n";
+    grid += xdmfDataItem<UnsignedInt>(group_name + "/OriginalParticle_ID", total_real_particles, 1);
+    grid += "     </Attribute>\n";
+
+    appendXdmfAttributes<UnsignedInt>(grid, group_name, "Scalar", 1, variables_to_write, total_real_particles);
+    appendXdmfAttributes<int>(grid, group_name, "Scalar", 1, variables_to_write, total_real_particles);
+    appendXdmfAttributes<Real>(grid, group_name, "Scalar", 1, variables_to_write, total_real_particles);
+    appendXdmfAttributes<Vecd>(grid, group_name, "Vector", 3, variables_to_write, total_real_particles);
+    appendXdmfAttributes<Matd>(grid, group_name, "Tensor", 9, variables_to_write, total_real_particles);
+    grid += "    </Grid>\n";
+    return grid;
+}
+//=============================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_HDF5
+#endif // IO_HDF5_HPP
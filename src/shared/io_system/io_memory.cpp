@@ -0,0 +1,58 @@
+#include "io_memory.h"
+
+namespace SPH
+{
+//=============================================================================================//
+const StateBuffer *BodyStatesBuffers::findBuffer(const std::string &name) const
+{
+    for (const StateBuffer &buffer : buffers_)
+    {
+        if (buffer.name_ == name)
+            return &buffer;
+    }
+    return nullptr;
+}
+//=============================================================================================//
+BodyStatesRecordingToMemory::
+    BodyStatesRecordingToMemory(SPHSystem &sph_system, MemoryExportMode mode)
+    : BodyStatesRecording(sph_system), mode_(mode), body_states_buffers_(bodies_.size())
+{
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        body_states_buffers_[i].body_name_ = bodies_[i]->getName();
+    }
+}
+//=============================================================================================//
+BodyStatesBuffers &BodyStatesRecordingToMemory::getBodyStatesBuffers(SPHBody &sph_body)
+{
+    auto result = std::find(bodies_.begin(), bodies_.end(), &sph_body);
+    if (result == bodies_.end())
+    {
+        std::cout << "\n Error: the body:" << sph_body.getName()
+                  << " is not in the recording list" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    return body_states_buffers_[result - bodies_.begin()];
+}
+//=============================================================================================//
+void BodyStatesRecordingToMemory::writeWithFileName(const std::string &sequence)
+{
+    sequence_ = sequence;
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        BodyStatesBuffers &body_states = body_states_buffers_[i];
+        if (mode_ == MemoryExportMode::copy || body_states_selections_[i].isActive())
+        {
+            body_states.snapshot_ = makeBodyStatesSnapshot(i);
+            exportBodyStates(body_states, *body_states.snapshot_);
+        }
+        else
+        {
+            body_states.snapshot_.reset();
+            exportBodyStates(body_states, bodies_[i]->getBaseParticles());
+        }
+    }
+}
+//=============================================================================================//
+} // namespace SPH
@@ -0,0 +1,198 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_memory.h
+ * @brief 	In-memory export of the body states as typed buffers, without formatting them as VTK strings.
+ * @details Each body is exported as a list of contiguous arrays, the positions, the original ids
+ *          and the variables to write, which are consumed directly by the C++, Python or JS hosts.
+ *          A zero-copy export points to the particle data, which is valid until the particles
+ *          are sorted, advanced or reallocated, while a copy is kept alive by the exported buffers.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IO_MEMORY_H
+#define IO_MEMORY_H
+
+#include "io_base.h"
+
+#include <cstdint>
+
+namespace SPH
+{
+enum class StateScalarType
+{
+    uint32,
+    uint64,
+    int32,
+    int64,
+    float32,
+    float64
+};
+
+template <typename ScalarType>
+constexpr StateScalarType stateScalarType()
+{
+    static_assert(std::is_arithmetic_v<ScalarType> && (sizeof(ScalarType) == 4 || sizeof(ScalarType) == 8),
+                  "Only 32 or 64 bit scalars are exported!");
+    if constexpr (std::is_floating_point_v<ScalarType>)
+        return sizeof(ScalarType) == 4 ? StateScalarType::float32 : StateScalarType::float64;
+    else if constexpr (std::is_signed_v<ScalarType>)
+        return sizeof(ScalarType) == 4 ? StateScalarType::int32 : StateScalarType::int64;
+    else
+        return sizeof(ScalarType) == 4 ? StateScalarType::uint32 : StateScalarType::uint64;
+};
+
+template <typename DataType>
+struct StateBufferLayout
+{
+    using ScalarType = DataType;
+    static constexpr size_t number_of_components = 1;
+};
+
+/** the components of a matrix are stored in the column-major order of Eigen */
+template <typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct StateBufferLayout<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>>
+{
+    using ScalarType = Scalar;
+    static constexpr size_t number_of_components = Rows * Cols;
+};
+
+/**
+ * @struct StateBuffer
+ * @brief A contiguous array of the number of particles times the number of components scalars.
+ */
+struct StateBuffer
+{
+    std::string name_;
+    StateScalarType scalar_type_;
+    size_t number_of_components_;
+    const void *data_;
+
+    template <typename DataType>
+    StateBuffer(const std::string &name, const DataType *data)
+        : name_(name), scalar_type_(stateScalarType<typename StateBufferLayout<DataType>::ScalarType>()),
+          number_of_components_(StateBufferLayout<DataType>::number_of_components), data_(data){};
+};
+
+/** calls the function with the data of the buffer as a pointer to its scalar type */
+template <typename Function>
+void visitStateBufferData(const StateBuffer &buffer, const Function &function)
+{
+    switch (buffer.scalar_type_)
+    {
+    case StateScalarType::uint32:
+        function(static_cast<const uint32_t *>(buffer.data_));
+        break;
+    case StateScalarType::uint64:
+        function(static_cast<const uint64_t *>(buffer.data_));
+        break;
+    case StateScalarType::int32:
+        function(static_cast<const int32_t *>(buffer.data_));
+        break;
+    case StateScalarType::int64:
+        function(static_cast<const int64_t *>(buffer.data_));
+        break;
+    case StateScalarType::float32:
+        function(static_cast<const float *>(buffer.data_));
+        break;
+    case StateScalarType::float64:
+        function(static_cast<const double *>(buffer.data_));
+        break;
+    }
+};
+
+/**
+ * @struct BodyStatesBuffers
+ * @brief The exported states of a body. The positions and the original ids come first,
+ * followed by the variables to write. The copied data, if any, is owned by the snapshot.
+ */
+struct BodyStatesBuffers
+{
+    std::string body_name_;
+    size_t number_of_particles_ = 0;
+    StdVec<StateBuffer> buffers_;
+    SharedPtr<BodyStatesSnapshot> snapshot_;
+
+    /** the buffer with the given name, nullptr if not exported */
+    const StateBuffer *findBuffer(const std::string &name) const;
+};
+
+enum class MemoryExportMode
+{
+    zero_copy,
+    copy
+};
+
+/**
+ * @class BodyStatesRecordingToMemory
+ * @brief Export the body states to typed buffers in memory with the interface of body states recording.
+ * The selections of the body states are applied, for which the data is always copied.
+ * Different from writing files, the export is not switched off without state recording
+ * and does not depend on whether the bodies are newly updated.
+ */
+class BodyStatesRecordingToMemory : public BodyStatesRecording
+{
+  public:
+    explicit BodyStatesRecordingToMemory(SPHSystem &sph_system, MemoryExportMode mode = MemoryExportMode::zero_copy);
+    virtual ~BodyStatesRecordingToMemory(){};
+
+    MemoryExportMode ExportMode() { return mode_; };
+    /** the sequence of the last export, i.e. the physical time or the iteration step */
+    const std::string &Sequence() { return sequence_; };
+    StdVec<BodyStatesBuffers> &getBodyStatesBuffers() { return body_states_buffers_; };
+    BodyStatesBuffers &getBodyStatesBuffers(SPHBody &sph_body);
+
+  protected:
+    MemoryExportMode mode_;
+    std::string sequence_;
+    StdVec<BodyStatesBuffers> body_states_buffers_;
+
+    virtual void writeWithFileName(const std::string &sequence) override;
+
+    struct exportVariables
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        StdVec<StateBuffer> &buffers)
+        {
+            for (DiscreteVariable<DataType> *variable : variables)
+            {
+                buffers.emplace_back(variable->Name(), variable->DataField());
+            }
+        };
+    };
+
+    template <class ParticlesType>
+    void exportBodyStates(BodyStatesBuffers &body_states, ParticlesType &particles)
+    {
+        body_states.number_of_particles_ = particles.TotalRealParticles();
+        body_states.buffers_.clear();
+        body_states.buffers_.emplace_back("Position", particles.ParticlePositions());
+        body_states.buffers_.emplace_back("OriginalID", particles.ParticleOriginalIds());
+        OperationOnDataAssemble<ParticleVariables, exportVariables>
+            export_variables(particles.VariablesToWrite());
+        export_variables(body_states.buffers_);
+    };
+};
+} // namespace SPH
+#endif // IO_MEMORY_H
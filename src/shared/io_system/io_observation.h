@@ -31,7 +31,7 @@
 
 #include "io_base.h"
 
-#include "io_plt.h"
+#include "io_time_series.h"
 
 namespace SPH
 {
@@ -50,6 +50,7 @@ class ObservedQuantityRecording<VariableType> : public BodyStatesRecording,
     std::string dynamics_identifier_name_;
     const std::string quantity_name_;
     std::string filefullpath_output_;
+    QuantityTimeSeries<VariableType> time_series_;
 
   public:
     VariableType type_indicator_; /*< this is an indicator to identify the variable type. */
@@ -61,10 +62,12 @@ class ObservedQuantityRecording<VariableType> : public BodyStatesRecording,
           observer_(contact_relation.getSPHBody()), plt_engine_(),
           base_particles_(observer_.getBaseParticles()),
           dynamics_identifier_name_(contact_relation.getSPHBody().getName()),
-          quantity_name_(quantity_name)
+          quantity_name_(quantity_name),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + ".dat"),
+          time_series_(filefullpath_output_, base_particles_.TotalRealParticles(),
+                       sph_system_.ObservationBufferSize(), sph_system_.ObservationBinaryOutput())
     {
         /** Output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + ".dat";
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << "run_time"
                  << "   ";
@@ -76,25 +79,147 @@ class ObservedQuantityRecording<VariableType> : public BodyStatesRecording,
         out_file << "\n";
         out_file.close();
     };
-    virtual ~ObservedQuantityRecording(){};
+    virtual ~ObservedQuantityRecording() { flushQuantities(time_series_); };
 
     virtual void writeWithFileName(const std::string &sequence) override
     {
         this->exec();
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << sv_physical_time_.getValue() << "   ";
+        writeQuantities(time_series_, sv_physical_time_.getValue(), this->interpolated_quantities_);
+    };
+
+    VariableType *getObservedQuantity()
+    {
+        return this->interpolated_quantities_;
+    }
+};
+
+/**
+ * @struct QuantityColumns
+ * @brief Flattens a quantity into the real-valued columns of a time series.
+ */
+struct QuantityColumns
+{
+    static size_t number(const Real &quantity) { return 1; };
+    static size_t number(const Vecd &quantity) { return Dimensions; };
+    static Real *write(const Real &quantity, Real *columns)
+    {
+        *columns = quantity;
+        return columns + 1;
+    };
+    static Real *write(const Vecd &quantity, Real *columns)
+    {
+        for (int i = 0; i != Dimensions; ++i)
+            columns[i] = quantity[i];
+        return columns + Dimensions;
+    };
+};
+
+/**
+ * @class ObservedQuantitiesRecording
+ * @brief Write several quantities observed in one interpolation pass, as the columns of one file.
+ * The observing dynamics, ObservingQuantities or ObservingQuantitiesCK, is given as template parameter.
+ */
+template <class ObservingQuantitiesType>
+class ObservedQuantitiesRecording : public BodyStatesRecording, public ObservingQuantitiesType
+{
+  protected:
+    using VariableNames = typename ObservingQuantitiesType::VariableNames;
+    using ObservationExecutionPolicy = typename ObservingQuantitiesType::ObservationExecutionPolicy;
+    static constexpr size_t number_of_quantities_ = std::tuple_size<VariableNames>::value;
+
+    SPHBody &observer_;
+    PltEngine plt_engine_;
+    BaseParticles &base_particles_;
+    std::string dynamics_identifier_name_;
+    const VariableNames quantity_names_;
+    std::string filefullpath_output_;
+    StdVec<Real> columns_;
+    QuantityTimeSeries<Real> time_series_;
+
+    std::string fileName()
+    {
+        std::string file_name = dynamics_identifier_name_;
+        for (const std::string &quantity_name : quantity_names_)
+            file_name += "_" + quantity_name;
+        return file_name + ".dat";
+    };
+
+    template <size_t... Is>
+    size_t numberOfColumns(std::index_sequence<Is...>)
+    {
+        return (QuantityColumns::number(std::decay_t<decltype(*std::get<Is>(this->dv_interpolated_quantities_)->DataField())>()) + ...) *
+               base_particles_.TotalRealParticles();
+    };
+
+    template <size_t... Is>
+    void writeQuantityHeaders(std::ofstream &out_file, std::index_sequence<Is...>)
+    {
+        (writeQuantityHeader(out_file, std::get<Is>(this->dv_interpolated_quantities_)->DataField(), quantity_names_[Is]), ...);
+    };
+
+    template <typename DataType>
+    void writeQuantityHeader(std::ofstream &out_file, DataType *quantities, const std::string &quantity_name)
+    {
         for (size_t i = 0; i != base_particles_.TotalRealParticles(); ++i)
         {
-            plt_engine_.writeAQuantity(out_file, this->interpolated_quantities_[i]);
+            std::string quantity_name_i = quantity_name + "[" + std::to_string(i) + "]";
+            plt_engine_.writeAQuantityHeader(out_file, quantities[i], quantity_name_i);
         }
+    };
+
+    template <size_t... Is>
+    void prepareQuantitiesForOutput(std::index_sequence<Is...>)
+    {
+        (std::get<Is>(this->dv_interpolated_quantities_)->prepareForOutput(ObservationExecutionPolicy{}), ...);
+        waitForOutputTransfers(ObservationExecutionPolicy{});
+    };
+
+    template <size_t... Is>
+    void writeColumns(std::index_sequence<Is...>)
+    {
+        Real *columns = columns_.data();
+        ((columns = writeColumns(std::get<Is>(this->dv_interpolated_quantities_)->DataField(), columns)), ...);
+    };
+
+    template <typename DataType>
+    Real *writeColumns(DataType *quantities, Real *columns)
+    {
+        for (size_t i = 0; i != base_particles_.TotalRealParticles(); ++i)
+            columns = QuantityColumns::write(quantities[i], columns);
+        return columns;
+    };
+
+  public:
+    template <class ContactRelationType>
+    ObservedQuantitiesRecording(const VariableNames &quantity_names, ContactRelationType &contact_relation)
+        : BodyStatesRecording(contact_relation.getSPHBody()),
+          ObservingQuantitiesType(contact_relation, quantity_names),
+          observer_(contact_relation.getSPHBody()), plt_engine_(),
+          base_particles_(observer_.getBaseParticles()),
+          dynamics_identifier_name_(contact_relation.getSPHBody().getName()),
+          quantity_names_(quantity_names),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + fileName()),
+          columns_(numberOfColumns(std::make_index_sequence<number_of_quantities_>{})),
+          time_series_(filefullpath_output_, columns_.size(),
+                       sph_system_.ObservationBufferSize(), sph_system_.ObservationBinaryOutput())
+    {
+        /** Output for .dat file. */
+        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
+        out_file << "run_time"
+                 << "   ";
+        writeQuantityHeaders(out_file, std::make_index_sequence<number_of_quantities_>{});
         out_file << "\n";
         out_file.close();
     };
+    virtual ~ObservedQuantitiesRecording() { flushQuantities(time_series_); };
 
-    VariableType *getObservedQuantity()
+    virtual void writeWithFileName(const std::string &sequence) override
     {
-        return this->interpolated_quantities_;
-    }
+        this->exec();
+        prepareQuantitiesForOutput(std::make_index_sequence<number_of_quantities_>{});
+        writeColumns(std::make_index_sequence<number_of_quantities_>{});
+        writeQuantities(time_series_, sv_physical_time_.getValue(), columns_.data());
+    };
 };
 
 template <typename...>
@@ -112,6 +237,7 @@ class ReducedQuantityRecording<LocalReduceMethodType> : public BaseIO
     std::string dynamics_identifier_name_;
     const std::string quantity_name_;
     std::string filefullpath_output_;
+    QuantityTimeSeries<typename LocalReduceMethodType::ReturnType> time_series_;
 
   public:
     /*< deduce variable type from reduce method. */
@@ -124,10 +250,11 @@ class ReducedQuantityRecording<LocalReduceMethodType> : public BaseIO
         : BaseIO(identifier.getSPHBody().getSPHSystem()), plt_engine_(),
           reduce_method_(identifier, std::forward<Args>(args)...),
           dynamics_identifier_name_(reduce_method_.DynamicsIdentifierName()),
-          quantity_name_(reduce_method_.QuantityName())
+          quantity_name_(reduce_method_.QuantityName()),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat"),
+          time_series_(filefullpath_output_, 1, sph_system_.ObservationBufferSize(), sph_system_.ObservationBinaryOutput())
     {
         /** output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat";
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << "\"run_time\""
                  << "   ";
@@ -135,16 +262,83 @@ class ReducedQuantityRecording<LocalReduceMethodType> : public BaseIO
         out_file << "\n";
         out_file.close();
     };
-    virtual ~ReducedQuantityRecording(){};
+    virtual ~ReducedQuantityRecording() { flushQuantities(time_series_); };
 
     virtual void writeToFile(size_t iteration_step = 0) override
     {
+        writeQuantities(time_series_, sv_physical_time_.getValue(), reduce_method_.exec());
+    };
+};
+
+/**
+ * @class ReducedQuantitiesRecording
+ * @brief write several reduced quantities of a body, evaluated in one particle loop, as the columns of one file.
+ * The reduce methods are given by ConstructorArgs with the same dynamics identifier and their other arguments.
+ */
+template <class... LocalReduceMethodTypes>
+class ReducedQuantitiesRecording : public BaseIO
+{
+  protected:
+    PltEngine plt_engine_;
+    FusedReduceDynamics<ParallelPolicy, LocalReduceMethodTypes...> reduce_methods_;
+    std::string dynamics_identifier_name_;
+    std::string filefullpath_output_;
+    StdVec<Real> columns_;
+    QuantityTimeSeries<Real> time_series_;
+
+    std::string fileName()
+    {
+        std::string file_name = reduce_methods_.DynamicsIdentifierName();
+        for (const std::string &quantity_name : reduce_methods_.QuantityNames())
+            file_name += "_" + quantity_name;
+        return file_name + ".dat";
+    };
+
+  public:
+    using VariableType = typename FusedReduceDynamics<ParallelPolicy, LocalReduceMethodTypes...>::ReturnType;
+
+  public:
+    template <typename... ParameterSets>
+    explicit ReducedQuantitiesRecording(ParameterSets &&...parameter_sets)
+        : BaseIO(std::get<0>(std::forward_as_tuple(parameter_sets...)).getSPHBody().getSPHSystem()),
+          plt_engine_(), reduce_methods_(std::forward<ParameterSets>(parameter_sets)...),
+          dynamics_identifier_name_(reduce_methods_.DynamicsIdentifierName()),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + fileName()),
+          columns_(std::apply([](const auto &...quantities)
+                              { return (QuantityColumns::number(quantities) + ...); },
+                              VariableType())),
+          time_series_(filefullpath_output_, columns_.size(),
+                       sph_system_.ObservationBufferSize(), sph_system_.ObservationBinaryOutput())
+    {
+        /** output for .dat file. */
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << sv_physical_time_.getValue() << "   ";
-        plt_engine_.writeAQuantity(out_file, reduce_method_.exec());
+        out_file << "\"run_time\""
+                 << "   ";
+        writeQuantityHeaders(out_file, std::index_sequence_for<LocalReduceMethodTypes...>{});
         out_file << "\n";
         out_file.close();
     };
+    virtual ~ReducedQuantitiesRecording() { flushQuantities(time_series_); };
+
+    virtual void writeToFile(size_t iteration_step = 0) override
+    {
+        VariableType quantities = reduce_methods_.exec();
+        std::apply([&](const auto &...quantity)
+                   {
+                       Real *columns = columns_.data();
+                       ((columns = QuantityColumns::write(quantity, columns)), ...); },
+                   quantities);
+        writeQuantities(time_series_, sv_physical_time_.getValue(), columns_.data());
+    };
+
+  protected:
+    template <size_t... Is>
+    void writeQuantityHeaders(std::ofstream &out_file, std::index_sequence<Is...>)
+    {
+        (plt_engine_.writeAQuantityHeader(out_file, reduce_methods_.template getLocalDynamics<Is>().Reference(),
+                                          reduce_methods_.template getLocalDynamics<Is>().QuantityName()),
+         ...);
+    };
 };
 } // namespace SPH
 #endif // IO_OBSERVATION_H
@@ -93,6 +93,78 @@ void BodyStatesRecordingToPlt::writePltFileParticleData(
     };
 }
 //=============================================================================================//
+void BodyStatesRecordingToPlt::writeBinaryPltFile(const std::string &filefullpath, SPHBody &body)
+{
+    BaseParticles &particles = body.getBaseParticles();
+    ParticleVariables &variables_to_write = particles.VariablesToWrite();
+    size_t total_real_particles = particles.TotalRealParticles();
+    Vecd *position = particles.ParticlePositions();
+
+    StdVec<std::string> variable_names = {"x", "y", "z", "ID"};
+    constexpr int type_index_int = DataTypeIndex<int>::value;
+    for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write))
+    {
+        variable_names.push_back(variable->Name());
+    };
+    constexpr int type_index_Vecd = DataTypeIndex<Vecd>::value;
+    for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write))
+    {
+        variable_names.push_back(variable->Name() + "_x");
+        variable_names.push_back(variable->Name() + "_y");
+        variable_names.push_back(variable->Name() + "_z");
+    };
+    constexpr int type_index_Real = DataTypeIndex<Real>::value;
+    for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables_to_write))
+    {
+        variable_names.push_back(variable->Name());
+    };
+
+    TecplotBinaryWriter binary_writer(body.getName());
+    TecplotZone &zone = binary_writer.addZone(variable_names, body.getName(), Array3i(total_real_particles, 1, 1));
+    size_t variable_index = 0;
+    auto fill_variable = [&](const auto &value_of)
+    {
+        Real *variable_data = zone.VariableData(variable_index++);
+        particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                     [&](size_t i)
+                     { variable_data[i] = value_of(i); });
+    };
+
+    for (int n = 0; n != 3; ++n)
+    {
+        fill_variable([&](size_t i)
+                      { return upgradeToVec3d(position[i])[n]; });
+    }
+    fill_variable([](size_t i)
+                  { return Real(i); });
+
+    for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write))
+    {
+        int *data_field = variable->DataField();
+        fill_variable([&](size_t i)
+                      { return Real(data_field[i]); });
+    };
+
+    for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write))
+    {
+        Vecd *data_field = variable->DataField();
+        for (int n = 0; n != 3; ++n)
+        {
+            fill_variable([&](size_t i)
+                          { return upgradeToVec3d(data_field[i])[n]; });
+        }
+    };
+
+    for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables_to_write))
+    {
+        Real *data_field = variable->DataField();
+        fill_variable([&](size_t i)
+                      { return data_field[i]; });
+    };
+
+    binary_writer.writeToFile(filefullpath);
+}
+//=============================================================================================//
 void BodyStatesRecordingToPlt::writeWithFileName(const std::string &sequence)
 {
     for (SPHBody *body : bodies_)
@@ -109,17 +181,24 @@ void BodyStatesRecordingToPlt::writeWithFileName(const std::string &sequence)
                 {
                     fs::remove(filefullpath);
                 }
-                std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
-                writePltFileHeader(out_file, variables_to_write);
-                out_file << "\n";
-
-                Vecd *position = particles.ParticlePositions();
-                for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+                if (data_format_ == PltDataFormat::binary)
+                {
+                    writeBinaryPltFile(filefullpath, *body);
+                }
+                else
                 {
-                    writePltFileParticleData(out_file, variables_to_write, position, i);
+                    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+                    writePltFileHeader(out_file, variables_to_write);
                     out_file << "\n";
-                };
-                out_file.close();
+
+                    Vecd *position = particles.ParticlePositions();
+                    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+                    {
+                        writePltFileParticleData(out_file, variables_to_write, position, i);
+                        out_file << "\n";
+                    };
+                    out_file.close();
+                }
             }
         }
         body->setNotNewlyUpdated();
@@ -132,6 +211,15 @@ MeshRecordingToPlt ::MeshRecordingToPlt(SPHSystem &sph_system, BaseMeshField &me
 //=============================================================================================//
 void MeshRecordingToPlt::writeToFile(size_t iteration_step)
 {
+    if (data_format_ == PltDataFormat::binary)
+    {
+        TecplotBinaryWriter binary_writer(mesh_field_.Name());
+        mesh_field_.writeMeshFieldToBinaryPlt(binary_writer);
+        binary_writer.writeToFile(io_environment_.output_folder_ + "/" + mesh_field_.Name() + "_" +
+                                  padValueWithZeros(iteration_step) + ".plt");
+        return;
+    }
+
     std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
     mesh_field_.writeMeshFieldToPlt(out_file);
     out_file.close();
@@ -33,6 +33,13 @@
 
 namespace SPH
 {
+/** Encoding of Tecplot files. */
+enum class PltDataFormat
+{
+    ascii, /**< human readable, mainly for debugging */
+    binary /**< whole variable arrays in block packing, much smaller and faster */
+};
+
 /**
  * @class PltEngine
  * @brief The base class which defines Tecplot file related operation.
@@ -60,8 +67,12 @@ class BodyStatesRecordingToPlt : public BodyStatesRecording
     BodyStatesRecordingToPlt(SPHBody &body) : BodyStatesRecording(body){};
     BodyStatesRecordingToPlt(SPHSystem &sph_system) : BodyStatesRecording(sph_system){};
     virtual ~BodyStatesRecordingToPlt(){};
+    void setDataFormat(PltDataFormat data_format) { data_format_ = data_format; };
 
   protected:
+    PltDataFormat data_format_ = PltDataFormat::ascii;
+
+    void writeBinaryPltFile(const std::string &filefullpath, SPHBody &body);
     void writePltFileHeader(std::ofstream &output_file, ParticleVariables &variables_to_write);
     void writePltFileParticleData(std::ofstream &output_file, ParticleVariables &variables_to_write, Vecd *position, size_t index);
     virtual void writeWithFileName(const std::string &sequence) override;
@@ -76,10 +87,14 @@ class MeshRecordingToPlt : public BaseIO
   protected:
     BaseMeshField &mesh_field_;
     std::string filefullpath_;
+    PltDataFormat data_format_ = PltDataFormat::ascii;
 
   public:
     MeshRecordingToPlt(SPHSystem &sph_system, BaseMeshField &mesh_field);
     virtual ~MeshRecordingToPlt(){};
+    /** in binary format, each output is a separate file numbered by the iteration step
+     *  instead of being appended to a single file */
+    void setDataFormat(PltDataFormat data_format) { data_format_ = data_format; };
     virtual void writeToFile(size_t iteration_step = 0) override;
 };
 } // namespace SPH
@@ -0,0 +1,237 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_python.h
+ * @brief 	NumPy views of particle variables for the Python bindings built with pybind11.
+ * @details The views share the memory of the data fields through the buffer protocol without copying.
+ *          A scalar variable is viewed as a 1D array, a vector one as a 2D array of shape (particles, dimensions)
+ *          and a matrix one as a 3D array, with the strides of the column-major Eigen storage.
+ *          A view is valid until the data field is reallocated, e.g. when the particle buffer grows,
+ *          and is to be requested again after that. A read-only view cannot be written from Python.
+ *          On device, the host data is synchronized when a view is requested,
+ *          and a read-write view is copied back to the device by commit.
+ *          This header is only included by the Python bindings, which provide pybind11.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IO_PYTHON_H
+#define IO_PYTHON_H
+
+#include "base_particles.h"
+#include "io_memory.h"
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+namespace SPH
+{
+enum class PythonViewAccess
+{
+    read_only,
+    read_write
+};
+
+template <typename DataType>
+struct PythonViewLayout
+{
+    using ScalarType = DataType;
+    static StdVec<pybind11::ssize_t> shape(size_t size) { return {pybind11::ssize_t(size)}; };
+    static StdVec<pybind11::ssize_t> strides() { return {pybind11::ssize_t(sizeof(DataType))}; };
+};
+
+template <typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+struct PythonViewLayout<Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>>
+{
+    using DataType = Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols>;
+    using ScalarType = Scalar;
+    static StdVec<pybind11::ssize_t> shape(size_t size)
+    {
+        if (Cols == 1)
+            return {pybind11::ssize_t(size), Rows};
+        return {pybind11::ssize_t(size), Rows, Cols};
+    };
+    static StdVec<pybind11::ssize_t> strides()
+    {
+        bool is_row_major = (Options & Eigen::RowMajor) != 0;
+        pybind11::ssize_t row_stride = is_row_major ? Cols * sizeof(Scalar) : sizeof(Scalar);
+        pybind11::ssize_t col_stride = is_row_major ? sizeof(Scalar) : Rows * sizeof(Scalar);
+        if (Cols == 1)
+            return {pybind11::ssize_t(sizeof(DataType)), row_stride};
+        return {pybind11::ssize_t(sizeof(DataType)), row_stride, col_stride};
+    };
+};
+
+/** a view of the first size entries of the data field, kept alive by base, e.g. the Python owner of the particles */
+template <typename DataType>
+pybind11::array viewAsNumpy(DiscreteVariable<DataType> *variable, size_t size,
+                            PythonViewAccess access, pybind11::handle base)
+{
+#if SPHINXSYS_USE_SYCL
+    variable->synchronizeWithDevice();
+#endif
+    using Layout = PythonViewLayout<DataType>;
+    using ScalarType = typename Layout::ScalarType;
+    pybind11::array view(pybind11::dtype::of<ScalarType>(), Layout::shape(size), Layout::strides(),
+                         reinterpret_cast<ScalarType *>(variable->DataField()), base);
+    if (access == PythonViewAccess::read_only)
+        view.attr("flags").attr("writeable") = false;
+    return view;
+};
+
+/**
+ * @class ParticleVariableViews
+ * @brief NumPy views of the variables of particles, found by name among all supported data types.
+ */
+class ParticleVariableViews
+{
+  public:
+    explicit ParticleVariableViews(BaseParticles &particles) : particles_(particles){};
+
+    /** a view of the real particles, kept alive by base */
+    pybind11::array view(const std::string &name, PythonViewAccess access, pybind11::handle base)
+    {
+        pybind11::array result;
+        bool is_found = false;
+        forEachDataType(
+            [&](auto *variable)
+            {
+                if (variable != nullptr && !is_found)
+                {
+                    result = viewAsNumpy(variable, particles_.TotalRealParticles(), access, base);
+                    is_found = true;
+                }
+            },
+            name);
+        if (!is_found)
+            throw pybind11::key_error("No particle variable named " + name + "!");
+        return result;
+    };
+
+    /** copies the host data written through a read-write view to the device, if any */
+    void commit(const std::string &name)
+    {
+        forEachDataType(
+            [&](auto *variable)
+            {
+#if SPHINXSYS_USE_SYCL
+                if (variable != nullptr)
+                    variable->synchronizeToDevice();
+#endif
+            },
+            name);
+    };
+
+    /** registers the access mode and a view class with the given name in a module */
+    static void bind(pybind11::module_ &module, const std::string &class_name)
+    {
+        if (!pybind11::hasattr(module, "ViewAccess"))
+        {
+            pybind11::enum_<PythonViewAccess>(module, "ViewAccess")
+                .value("read_only", PythonViewAccess::read_only)
+                .value("read_write", PythonViewAccess::read_write);
+        }
+        pybind11::class_<ParticleVariableViews>(module, class_name.c_str())
+            .def(
+                "view",
+                [](pybind11::object self, const std::string &name, PythonViewAccess access)
+                { return self.cast<ParticleVariableViews &>().view(name, access, self); },
+                pybind11::arg("name"), pybind11::arg("access") = PythonViewAccess::read_only)
+            .def("commit", &ParticleVariableViews::commit);
+    };
+
+  protected:
+    BaseParticles &particles_;
+
+    template <typename Function>
+    void forEachDataType(const Function &function, const std::string &name)
+    {
+        ParticleVariables &variables = particles_.AllDiscreteVariables();
+        function(findVariableByName<UnsignedInt>(variables, name));
+        function(findVariableByName<int>(variables, name));
+        function(findVariableByName<Real>(variables, name));
+        function(findVariableByName<Vecd>(variables, name));
+        function(findVariableByName<Matd>(variables, name));
+    };
+};
+
+/**
+ * @brief NumPy arrays of the buffers exported for a body, keyed by the variable names.
+ * A copied export is kept alive by the arrays themselves, while a zero-copy one by base,
+ * e.g. the Python owner of the recording, and is valid only until the particles are updated.
+ */
+inline pybind11::dict bodyStatesAsNumpy(const BodyStatesBuffers &body_states, pybind11::handle base)
+{
+    pybind11::object owner = pybind11::reinterpret_borrow<pybind11::object>(base);
+    if (body_states.snapshot_ != nullptr)
+    {
+        owner = pybind11::capsule(new SharedPtr<BodyStatesSnapshot>(body_states.snapshot_),
+                                  [](void *snapshot)
+                                  { delete static_cast<SharedPtr<BodyStatesSnapshot> *>(snapshot); });
+    }
+    pybind11::dict arrays;
+    for (const StateBuffer &buffer : body_states.buffers_)
+    {
+        visitStateBufferData(
+            buffer,
+            [&](const auto *data)
+            {
+                using ScalarType = std::remove_const_t<std::remove_pointer_t<decltype(data)>>;
+                StdVec<pybind11::ssize_t> shape = {pybind11::ssize_t(body_states.number_of_particles_)};
+                if (buffer.number_of_components_ != 1)
+                    shape.push_back(pybind11::ssize_t(buffer.number_of_components_));
+                pybind11::array_t<ScalarType> array(shape, data, owner);
+                array.attr("flags").attr("writeable") = false;
+                arrays[buffer.name_.c_str()] = array;
+            });
+    }
+    return arrays;
+};
+
+/** registers the export modes and a recording class with the given name in a module,
+ *  whose export method records the states and returns the arrays of each body by name */
+inline void bindBodyStatesRecordingToMemory(pybind11::module_ &module, const std::string &class_name)
+{
+    if (!pybind11::hasattr(module, "MemoryExportMode"))
+    {
+        pybind11::enum_<MemoryExportMode>(module, "MemoryExportMode")
+            .value("zero_copy", MemoryExportMode::zero_copy)
+            .value("copy", MemoryExportMode::copy);
+    }
+    pybind11::class_<BodyStatesRecordingToMemory>(module, class_name.c_str())
+        .def(
+            "export",
+            [](pybind11::object self)
+            {
+                BodyStatesRecordingToMemory &recording = self.cast<BodyStatesRecordingToMemory &>();
+                recording.writeToFile();
+                pybind11::dict bodies;
+                for (const BodyStatesBuffers &body_states : recording.getBodyStatesBuffers())
+                {
+                    bodies[body_states.body_name_.c_str()] = bodyStatesAsNumpy(body_states, self);
+                }
+                return bodies;
+            })
+        .def("sequence", &BodyStatesRecordingToMemory::Sequence);
+};
+} // namespace SPH
+#endif // IO_PYTHON_H
@@ -0,0 +1,83 @@
+#include "io_snapshot.h"
+
+namespace SPH
+{
+//=============================================================================================//
+size_t StateSnapshot::MemoryFootprint()
+{
+    size_t footprint = 0;
+    for (auto &copy : variable_copies_)
+    {
+        footprint += copy.data_.size();
+    }
+    return footprint;
+}
+//=============================================================================================//
+StateSnapshot StateSnapshotIO::takeSnapshot()
+{
+    StateSnapshot snapshot;
+    for (SPHBody *body : sph_system_.sph_bodies_)
+    {
+        BaseParticles &particles = body->getBaseParticles();
+        copyToSnapshot(particles.AllDiscreteVariables(), snapshot.variable_copies_);
+        copyToSnapshot(particles.AllSingularVariables(), snapshot.variable_copies_);
+    }
+    copyToSnapshot(sph_system_.AllSystemVariables(), snapshot.variable_copies_);
+
+    for (SimTK::Integrator *integ : integrators_)
+    {
+        snapshot.simbody_states_.push_back(integ->getState());
+    }
+    return snapshot;
+}
+//=============================================================================================//
+void StateSnapshotIO::restoreSnapshot(const StateSnapshot &snapshot)
+{
+    size_t position = 0;
+    for (SPHBody *body : sph_system_.sph_bodies_)
+    {
+        BaseParticles &particles = body->getBaseParticles();
+        copyFromSnapshot(particles.AllDiscreteVariables(), snapshot.variable_copies_, position);
+        copyFromSnapshot(particles.AllSingularVariables(), snapshot.variable_copies_, position);
+    }
+    copyFromSnapshot(sph_system_.AllSystemVariables(), snapshot.variable_copies_, position);
+
+    if (position != snapshot.variable_copies_.size() ||
+        snapshot.simbody_states_.size() != integrators_.size())
+    {
+        std::cout << "\n Error: the snapshot is not taken from this system!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    for (size_t i = 0; i != integrators_.size(); ++i)
+    {
+        integrators_[i]->initialize(snapshot.simbody_states_[i]);
+    }
+    updateConfigurations();
+}
+//=============================================================================================//
+void StateSnapshotIO::updateConfigurations()
+{
+    for (SPHBody *body : sph_system_.sph_bodies_)
+    {
+        // invalidates the neighbor lists reused by computing kernels, as the particles are moved
+        body->getBaseParticles().incrementTotalSorts();
+        for (SPHRelation *relation : body->getBodyRelations())
+        {
+            if (relation->isLazyConfiguration() && relation->isConfigurationBuilt() &&
+                !relation->isConfigurationFrozen())
+                relation->releaseConfiguration();
+        }
+    }
+
+    for (SPHBody *body : sph_system_.getRealBodies())
+    {
+        RealBody *real_body = DynamicCast<RealBody>(this, body);
+        if (real_body->isCellLinkedListUpdated())
+            real_body->updateCellLinkedList();
+    }
+    sph_system_.initializeSystemConfigurations();
+}
+//=============================================================================================//
+} // namespace SPH
@@ -0,0 +1,174 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	io_snapshot.h
+ * @brief 	In-memory snapshots of the state of an SPH system for fast resets.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IO_SNAPSHOT_H
+#define IO_SNAPSHOT_H
+
+#include "io_base.h"
+
+#include <cstring>
+
+namespace SPH
+{
+/**
+ * @class StateSnapshot
+ * @brief The copy of the state of an SPH system taken and restored by StateSnapshotIO.
+ */
+class StateSnapshot
+{
+    friend class StateSnapshotIO;
+    struct VariableCopy
+    {
+        Entity *variable_;
+        StdVec<char> data_;
+    };
+    StdVec<VariableCopy> variable_copies_;
+    StdVec<SimTK::State> simbody_states_;
+
+  public:
+    bool isEmpty() { return variable_copies_.empty(); };
+    /** the memory of the copied variables in bytes, excluding the Simbody states */
+    size_t MemoryFootprint();
+};
+
+/**
+ * @class StateSnapshotIO
+ * @brief Takes and restores in-memory snapshots of the state of an SPH system.
+ * @details A snapshot copies all particle and singular variables of all bodies,
+ *          the system variables, such as the physical time, and the states of the added
+ *          Simbody integrators. Restoring is a bulk copy, after which the cell linked lists
+ *          and the eager configurations are updated, the lazy ones are rebuilt at their
+ *          next use, and the neighbor lists of computing kernels are invalidated as after sorting.
+ *          A snapshot can only be restored to the system it is taken from, and the variables
+ *          registered after it is taken are left unchanged.
+ */
+class StateSnapshotIO
+{
+  protected:
+    SPHSystem &sph_system_;
+    StdVec<SimTK::Integrator *> integrators_;
+
+    using VariableCopy = StateSnapshot::VariableCopy;
+
+    struct CopyVariablesToSnapshot
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        StdVec<VariableCopy> &copies)
+        {
+            for (DiscreteVariable<DataType> *variable : variables)
+            {
+#if SPHINXSYS_USE_SYCL
+                if (variable->existDeviceDataField())
+                    variable->synchronizeWithDevice();
+#endif
+                char *data = reinterpret_cast<char *>(variable->DataField());
+                copies.push_back({variable, StdVec<char>(data, data + variable->MemoryFootprint())});
+            }
+        };
+
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<SingularVariable<DataType>> &variables,
+                        StdVec<VariableCopy> &copies)
+        {
+            for (SingularVariable<DataType> *variable : variables)
+            {
+                char *data = reinterpret_cast<char *>(variable->ValueAddress());
+                copies.push_back({variable, StdVec<char>(data, data + sizeof(DataType))});
+            }
+        };
+    };
+
+    /** The variables in the snapshot are a subsequence of the current ones,
+     *  as variables are only appended after the snapshot is taken. */
+    struct CopyVariablesFromSnapshot
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        const StdVec<VariableCopy> &copies, size_t &position)
+        {
+            for (DiscreteVariable<DataType> *variable : variables)
+            {
+                if (position == copies.size() || copies[position].variable_ != variable)
+                    continue;
+                const StdVec<char> &data = copies[position++].data_;
+                if (data.size() > variable->MemoryFootprint())
+                {
+                    std::cout << "\n Error: the variable " << variable->Name()
+                              << " is smaller than in the snapshot!" << std::endl;
+                    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                    exit(1);
+                }
+                std::memcpy(variable->DataField(), data.data(), data.size());
+#if SPHINXSYS_USE_SYCL
+                if (variable->existDeviceDataField())
+                    variable->synchronizeToDevice();
+#endif
+            }
+        };
+
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<SingularVariable<DataType>> &variables,
+                        const StdVec<VariableCopy> &copies, size_t &position)
+        {
+            for (SingularVariable<DataType> *variable : variables)
+            {
+                if (position == copies.size() || copies[position].variable_ != variable)
+                    continue;
+                DataType value;
+                std::memcpy(&value, copies[position++].data_.data(), sizeof(DataType));
+                variable->setValue(value);
+            }
+        };
+    };
+
+    template <class VariablesType>
+    void copyToSnapshot(VariablesType &variables, StdVec<VariableCopy> &copies)
+    {
+        OperationOnDataAssemble<VariablesType, CopyVariablesToSnapshot>(variables)(copies);
+    };
+
+    template <class VariablesType>
+    void copyFromSnapshot(VariablesType &variables, const StdVec<VariableCopy> &copies, size_t &position)
+    {
+        OperationOnDataAssemble<VariablesType, CopyVariablesFromSnapshot>(variables)(copies, position);
+    };
+
+    void updateConfigurations();
+
+  public:
+    explicit StateSnapshotIO(SPHSystem &sph_system) : sph_system_(sph_system){};
+    virtual ~StateSnapshotIO(){};
+
+    /** the state of the integrator is included in the snapshots taken afterwards */
+    void addSimbodyIntegrator(SimTK::Integrator &integ) { integrators_.push_back(&integ); };
+    StateSnapshot takeSnapshot();
+    void restoreSnapshot(const StateSnapshot &snapshot);
+};
+} // namespace SPH
+#endif // IO_SNAPSHOT_H
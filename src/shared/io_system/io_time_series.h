@@ -0,0 +1,292 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    io_time_series.h
+ * @brief   Buffered output of the time series of observed and reduced quantities.
+ * @details The samples are kept in memory and appended to the .dat file every given
+ *          number of samples and when the recorder is destroyed, or at exit if the run is
+ *          stopped by exit(), e.g. on an error. Optionally, the samples
+ *          are also written into a binary columnar file, which consists of a header and
+ *          blocks of the sample times followed by the samples of each quantity.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef IO_TIME_SERIES_H
+#define IO_TIME_SERIES_H
+
+#include "io_plt.h"
+
+#include <cstdlib>
+#include <mutex>
+#include <set>
+
+namespace SPH
+{
+struct QuantityTimeSeriesFileHeader
+{
+    char magic_[8] = {'S', 'P', 'H', 'X', 'S', 'E', 'R', '\0'};
+    uint32_t version_ = 1;
+    uint32_t type_index_ = 0;
+    uint32_t type_size_ = 0;
+    uint32_t real_size_ = uint32_t(sizeof(Real));
+    uint64_t number_of_quantities_ = 0;
+};
+
+/**
+ * @class QuantityTimeSeriesSamples
+ * @brief Samples of a time series, sample by sample, to be written in one go.
+ */
+template <typename DataType>
+class QuantityTimeSeriesSamples
+{
+  public:
+    QuantityTimeSeriesSamples(const std::string &filefullpath, const std::string &binary_filefullpath,
+                              size_t number_of_quantities)
+        : filefullpath_(filefullpath), binary_filefullpath_(binary_filefullpath),
+          number_of_quantities_(number_of_quantities){};
+
+    bool isEmpty() const { return times_.empty(); };
+    size_t NumberOfSamples() const { return times_.size(); };
+
+    void append(Real physical_time, const DataType *quantities)
+    {
+        times_.push_back(physical_time);
+        quantities_.insert(quantities_.end(), quantities, quantities + number_of_quantities_);
+    };
+
+    void clear()
+    {
+        times_.clear();
+        quantities_.clear();
+    };
+    /** moves the samples into the returned ones without copying, after which this is empty */
+    QuantityTimeSeriesSamples takeSamples()
+    {
+        QuantityTimeSeriesSamples samples(filefullpath_, binary_filefullpath_, number_of_quantities_);
+        samples.times_.swap(times_);
+        samples.quantities_.swap(quantities_);
+        return samples;
+    };
+
+    void write() const
+    {
+        PltEngine plt_engine;
+        std::ofstream out_file(filefullpath_.c_str(), std::ios::app);
+        for (size_t i = 0; i != times_.size(); ++i)
+        {
+            out_file << times_[i] << "   ";
+            for (size_t j = 0; j != number_of_quantities_; ++j)
+            {
+                plt_engine.writeAQuantity(out_file, quantities_[i * number_of_quantities_ + j]);
+            }
+            out_file << "\n";
+        }
+        out_file.close();
+
+        if (!binary_filefullpath_.empty())
+        {
+            writeBinaryBlock();
+        }
+    };
+
+  protected:
+    std::string filefullpath_;
+    std::string binary_filefullpath_; /**< empty if no binary output */
+    size_t number_of_quantities_;
+    StdVec<Real> times_;
+    StdVec<DataType> quantities_;
+
+    void writeBinaryBlock() const
+    {
+        std::ofstream out_file(binary_filefullpath_.c_str(), std::ios::app | std::ios::binary);
+        uint64_t number_of_samples = times_.size();
+        out_file.write(reinterpret_cast<const char *>(&number_of_samples), sizeof(uint64_t));
+        out_file.write(reinterpret_cast<const char *>(times_.data()), number_of_samples * sizeof(Real));
+        StdVec<DataType> column(number_of_samples);
+        for (size_t j = 0; j != number_of_quantities_; ++j)
+        {
+            for (size_t i = 0; i != number_of_samples; ++i)
+            {
+                column[i] = quantities_[i * number_of_quantities_ + j];
+            }
+            out_file.write(reinterpret_cast<const char *>(column.data()), number_of_samples * sizeof(DataType));
+        }
+        out_file.close();
+    };
+};
+
+/**
+ * @class BaseQuantityTimeSeries
+ * @brief Keeps track of the existing time series, so that their buffered samples are written at exit.
+ * @details exit() does not destroy the recorders, which would otherwise write the samples.
+ */
+class BaseQuantityTimeSeries
+{
+  public:
+    BaseQuantityTimeSeries()
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        if (!is_exit_handler_registered_)
+        {
+            std::atexit(writeAllAtExit);
+            is_exit_handler_registered_ = true;
+        }
+        registry_.insert(this);
+    };
+    virtual ~BaseQuantityTimeSeries()
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        registry_.erase(this);
+    };
+    /** writes the buffered samples directly, i.e. not by the async io writer */
+    virtual void writeSamples() = 0;
+
+  private:
+    static inline std::mutex registry_mutex_;
+    static inline std::set<BaseQuantityTimeSeries *> registry_;
+    static inline bool is_exit_handler_registered_ = false;
+
+    static void writeAllAtExit()
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex_);
+        for (BaseQuantityTimeSeries *time_series : registry_)
+        {
+            time_series->writeSamples();
+        }
+    };
+};
+
+/**
+ * @class QuantityTimeSeries
+ * @brief Buffers the samples of a time series until the given number of samples is reached.
+ */
+template <typename DataType>
+class QuantityTimeSeries : public BaseQuantityTimeSeries
+{
+  public:
+    QuantityTimeSeries(const std::string &filefullpath, size_t number_of_quantities,
+                       size_t buffer_size = 1, bool binary_output = false)
+        : BaseQuantityTimeSeries(), buffer_size_(SMAX(buffer_size, size_t(1))),
+          samples_(filefullpath, binary_output ? binaryFileName(filefullpath) : std::string(), number_of_quantities)
+    {
+        if (binary_output)
+        {
+            QuantityTimeSeriesFileHeader header;
+            header.type_index_ = uint32_t(DataTypeIndex<DataType>::value);
+            header.type_size_ = uint32_t(sizeof(DataType));
+            header.number_of_quantities_ = number_of_quantities;
+            std::ofstream out_file(binaryFileName(filefullpath).c_str(), std::ios::trunc | std::ios::binary);
+            out_file.write(reinterpret_cast<const char *>(&header), sizeof(QuantityTimeSeriesFileHeader));
+            out_file.close();
+        }
+    };
+
+    void append(Real physical_time, const DataType *quantities) { samples_.append(physical_time, quantities); };
+    bool isFull() const { return samples_.NumberOfSamples() >= buffer_size_; };
+    bool isEmpty() const { return samples_.isEmpty(); };
+    /** the buffered samples, after which the buffer is empty for the next samples */
+    QuantityTimeSeriesSamples<DataType> takeSamples() { return samples_.takeSamples(); };
+    virtual void writeSamples() override
+    {
+        if (!samples_.isEmpty())
+        {
+            takeSamples().write();
+        }
+    };
+
+    static std::string binaryFileName(const std::string &filefullpath)
+    {
+        return fs::path(filefullpath).replace_extension(".bin").string();
+    };
+
+  protected:
+    size_t buffer_size_;
+    QuantityTimeSeriesSamples<DataType> samples_;
+};
+
+/**
+ * @brief Reads the binary columnar file of a time series.
+ * @details The quantities are given snapshot by snapshot, as the current results in the regression tests.
+ */
+template <typename DataType>
+void readQuantityTimeSeries(const std::string &binary_filefullpath,
+                            StdVec<Real> &times, BiVector<DataType> &quantities)
+{
+    std::ifstream in_file(binary_filefullpath.c_str(), std::ios::binary);
+    QuantityTimeSeriesFileHeader header, expected;
+    in_file.read(reinterpret_cast<char *>(&header), sizeof(QuantityTimeSeriesFileHeader));
+    if (!in_file || std::memcmp(header.magic_, expected.magic_, sizeof(header.magic_)) != 0 ||
+        header.version_ > expected.version_ || header.real_size_ != sizeof(Real) ||
+        header.type_index_ != uint32_t(DataTypeIndex<DataType>::value) || header.type_size_ != sizeof(DataType))
+    {
+        std::cout << "\n Error: the file " << binary_filefullpath
+                  << " is not a time series of the requested type." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    times.clear();
+    quantities.clear();
+    size_t number_of_quantities = header.number_of_quantities_;
+    uint64_t number_of_samples;
+    while (in_file.read(reinterpret_cast<char *>(&number_of_samples), sizeof(uint64_t)))
+    {
+        size_t first_sample = times.size();
+        times.resize(first_sample + number_of_samples);
+        in_file.read(reinterpret_cast<char *>(times.data() + first_sample), number_of_samples * sizeof(Real));
+        quantities.resize(first_sample + number_of_samples, StdVec<DataType>(number_of_quantities));
+
+        StdVec<DataType> column(number_of_samples);
+        for (size_t j = 0; j != number_of_quantities; ++j)
+        {
+            in_file.read(reinterpret_cast<char *>(column.data()), number_of_samples * sizeof(DataType));
+            for (size_t i = 0; i != number_of_samples; ++i)
+            {
+                quantities[first_sample + i][j] = column[i];
+            }
+        }
+    }
+}
+
+template <typename DataType>
+void BaseIO::writeQuantities(QuantityTimeSeries<DataType> &time_series, Real physical_time,
+                             const DataType *quantities)
+{
+    time_series.append(physical_time, quantities);
+    if (time_series.isFull())
+    {
+        flushQuantities(time_series);
+    }
+}
+
+template <typename DataType>
+void BaseIO::flushQuantities(QuantityTimeSeries<DataType> &time_series)
+{
+    if (!time_series.isEmpty())
+    {
+        submitOutput([samples = time_series.takeSamples()]()
+                     { samples.write(); });
+    }
+}
+} // namespace SPH
+#endif // IO_TIME_SERIES_H
@@ -5,77 +5,159 @@
 
 #include "io_vtk.hpp"
 
+#if SPHINXSYS_USE_ZLIB
+#include <zlib.h>
+#endif
+
 namespace SPH
 {
 //=============================================================================================//
+VtkBinaryWriter::VtkBinaryWriter(std::ostream &output_stream, VtkDataFormat data_format)
+    : output_stream_(output_stream), data_format_(data_format), appended_offset_(0)
+{
+    if (data_format_ == VtkDataFormat::ascii)
+    {
+        std::cout << "\n Error: VtkBinaryWriter does not write ascii data!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=============================================================================================//
+void VtkBinaryWriter::setCompression(const VtkCompression &compression)
+{
+    compression_ = compression;
+    compression_.is_zlib_compressed_ = compression.is_zlib_compressed_ && isBinaryDataCompressionAvailable();
+}
+//=============================================================================================//
+std::string VtkBinaryWriter::CompressorAttribute()
+{
+    return compression_.is_zlib_compressed_ ? " compressor=\"vtkZLibDataCompressor\"" : "";
+}
+//=============================================================================================//
+const char *VtkBinaryWriter::compressData(const char *data, uint64_t &size)
+{
+#if SPHINXSYS_USE_ZLIB
+    constexpr uint64_t block_size = 32768;
+    uint64_t number_of_blocks = (size + block_size - 1) / block_size;
+    StdVec<StdVec<Bytef>> compressed_blocks(number_of_blocks);
+    arena_parallel_for(
+        IndexRange(0, number_of_blocks),
+        [&](const IndexRange &r)
+        {
+            for (size_t b = r.begin(); b != r.end(); ++b)
+            {
+                uLong block_bytes = uLong(SMIN(block_size, size - b * block_size));
+                uLongf compressed_size = compressBound(block_bytes);
+                compressed_blocks[b].resize(compressed_size);
+                compress2(compressed_blocks[b].data(), &compressed_size,
+                          reinterpret_cast<const Bytef *>(data) + b * block_size, block_bytes, Z_BEST_SPEED);
+                compressed_blocks[b].resize(compressed_size);
+            }
+        });
+
+    // header: number of blocks, block size, size of the last partial block and the compressed sizes
+    StdVec<uint64_t> header(3 + number_of_blocks);
+    header[0] = number_of_blocks;
+    header[1] = block_size;
+    header[2] = size % block_size;
+    uint64_t total_size = header.size() * sizeof(uint64_t);
+    for (size_t b = 0; b != number_of_blocks; ++b)
+    {
+        header[3 + b] = compressed_blocks[b].size();
+        total_size += compressed_blocks[b].size();
+    }
+
+    StdVec<char> &owned_buffer = owned_buffers_.emplace_back(total_size);
+    char *destination = owned_buffer.data();
+    std::memcpy(destination, header.data(), header.size() * sizeof(uint64_t));
+    destination += header.size() * sizeof(uint64_t);
+    for (const StdVec<Bytef> &block : compressed_blocks)
+    {
+        std::memcpy(destination, block.data(), block.size());
+        destination += block.size();
+    }
+    size = total_size;
+    return owned_buffer.data();
+#else
+    return data;
+#endif
+}
+//=============================================================================================//
+void VtkBinaryWriter::writeBase64(const char *data, uint64_t size, bool with_size_header)
+{
+    static const char base64_table[] =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    // the byte-count header and the data are encoded as one continuous base64 stream
+    const char *header = reinterpret_cast<const char *>(&size);
+    uint64_t header_size = with_size_header ? sizeof(uint64_t) : 0;
+    auto byte = [&](uint64_t k) -> unsigned char
+    { return k < header_size ? header[k] : data[k - header_size]; };
+
+    uint64_t total_bytes = header_size + size;
+    std::string encoded;
+    encoded.reserve(65536);
+    for (uint64_t k = 0; k < total_bytes; k += 3)
+    {
+        uint64_t remaining = total_bytes - k;
+        uint32_t triple = uint32_t(byte(k)) << 16;
+        if (remaining > 1)
+            triple |= uint32_t(byte(k + 1)) << 8;
+        if (remaining > 2)
+            triple |= uint32_t(byte(k + 2));
+        encoded.push_back(base64_table[(triple >> 18) & 0x3F]);
+        encoded.push_back(base64_table[(triple >> 12) & 0x3F]);
+        encoded.push_back(remaining > 1 ? base64_table[(triple >> 6) & 0x3F] : '=');
+        encoded.push_back(remaining > 2 ? base64_table[triple & 0x3F] : '=');
+        if (encoded.size() >= 65532)
+        {
+            output_stream_.write(encoded.data(), encoded.size());
+            encoded.clear();
+        }
+    }
+    output_stream_.write(encoded.data(), encoded.size());
+}
+//=============================================================================================//
+void VtkBinaryWriter::writeAppendedData()
+{
+    if (data_format_ != VtkDataFormat::appended)
+        return;
+
+    output_stream_ << " <AppendedData encoding=\"raw\">\n_";
+    for (const AppendedBlock &block : appended_blocks_)
+    {
+        // compressed data are led by their block header instead of the byte count
+        if (!compression_.is_zlib_compressed_)
+            output_stream_.write(reinterpret_cast<const char *>(&block.size_), sizeof(uint64_t));
+        output_stream_.write(block.data_, block.size_);
+    }
+    output_stream_ << "\n </AppendedData>\n";
+    appended_blocks_.clear();
+    owned_buffers_.clear();
+}
+//=============================================================================================//
 void BodyStatesRecordingToVtp::writeWithFileName(const std::string &sequence)
 {
-    for (SPHBody *body : bodies_)
+    for (size_t i = 0; i < bodies_.size(); ++i)
     {
+        SPHBody *body = bodies_[i];
         if (body->checkNewlyUpdated())
         {
-            BaseParticles &base_particles = body->getBaseParticles();
-
             if (state_recording_)
             {
                 std::string filefullpath = io_environment_.output_folder_ + "/" + body->getName() + "_" + sequence + ".vtp";
-                if (fs::exists(filefullpath))
-                {
-                    fs::remove(filefullpath);
-                }
-                std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
-                // begin of the XML file
-                out_file << "<?xml version=\"1.0\"?>\n";
-                out_file << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
-                out_file << " <PolyData>\n";
-
-                size_t total_real_particles = base_particles.TotalRealParticles();
-                out_file << "  <Piece Name =\"" << body->getName() << "\" NumberOfPoints=\"" << total_real_particles
-                         << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
-
-                // write current/final particle positions first
-                out_file << "   <Points>\n";
-                out_file << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
-                out_file << "    ";
-                for (size_t i = 0; i != total_real_particles; ++i)
+                std::string body_name = body->getName();
+                VtkDataFormat data_format = data_format_;
+                VtkCompression compression = compression_;
+                if (isSnapshotNeeded(i))
                 {
-                    Vec3d particle_position = upgradeToVec3d(base_particles.ParticlePositions()[i]);
-                    out_file << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
+                    SharedPtr<BodyStatesSnapshot> snapshot = makeBodyStatesSnapshot(i);
+                    submitOutput([=]()
+                                 { writeVtpFile(filefullpath, data_format, compression, body_name, *snapshot); });
                 }
-                out_file << std::endl;
-                out_file << "    </DataArray>\n";
-                out_file << "   </Points>\n";
-
-                // write header of particles data
-                out_file << "   <PointData  Vectors=\"vector\">\n";
-                writeParticlesToVtk(out_file, base_particles);
-                out_file << "   </PointData>\n";
-
-                // write empty cells
-                out_file << "   <Verts>\n";
-                out_file << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
-                out_file << "    ";
-                for (size_t i = 0; i != total_real_particles; ++i)
+                else
                 {
-                    out_file << i << " ";
+                    writeVtpFile(filefullpath, data_format, compression, body_name, body->getBaseParticles());
                 }
-                out_file << std::endl;
-                out_file << "    </DataArray>\n";
-                out_file << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
-                out_file << "    ";
-                for (size_t i = 0; i != total_real_particles; ++i)
-                {
-                    out_file << i + 1 << " ";
-                }
-                out_file << std::endl;
-                out_file << "    </DataArray>\n";
-                out_file << "   </Verts>\n";
-
-                out_file << "  </Piece>\n";
-                out_file << " </PolyData>\n";
-                out_file << "</VTKFile>\n";
-
-                out_file.close();
             }
         }
         body->setNotNewlyUpdated();
@@ -162,6 +244,32 @@ void WriteToVtpIfVelocityOutOfBound::writeWithFileName(const std::string &sequen
     }
 }
 //=============================================================================================//
+WriteToVtpIfStateSentinelTriggered::
+    WriteToVtpIfStateSentinelTriggered(SPHSystem &sph_system, Real velocity_bound)
+    : BodyStatesRecordingToVtp(sph_system), is_triggered_(false)
+{
+    for (size_t i = 0; i < bodies_.size(); ++i)
+    {
+        state_sentinels_.push_back(state_sentinels_ptr_keeper_.createPtr<StateSentinel>(*bodies_[i]));
+        state_sentinels_.back()->setVelocityBound(velocity_bound);
+    }
+}
+//=============================================================================================//
+void WriteToVtpIfStateSentinelTriggered::writeWithFileName(const std::string &sequence)
+{
+    for (auto state_sentinel : state_sentinels_)
+    {
+        is_triggered_ = is_triggered_ || state_sentinel->isTriggered();
+    }
+
+    if (is_triggered_)
+    {
+        BodyStatesRecordingToVtp::writeWithFileName(sequence);
+        std::cout << "\n Velocity is out of bound or not a number at iteration step " << sequence
+                  << "\n The body states have been outputted and the simulation terminates here. \n";
+    }
+}
+//=============================================================================================//
 void ParticleGenerationRecordingToVtp::writeWithFileName(const std::string &sequence)
 {
 
@@ -30,11 +30,111 @@
 #define IO_VTK_H
 
 #include "io_base.h"
+#include "state_sentinel.h"
+
+#include <cstring>
+#include <list>
+#include <map>
+#include <numeric>
 
 using VtuStringData = std::map<std::string, std::string>;
 
 namespace SPH
 {
+/** Encoding of the data arrays in vtk XML files. */
+enum class VtkDataFormat
+{
+    ascii,   /**< human readable, mainly for debugging */
+    binary,  /**< base64 encoded raw data inline with the xml structure */
+    appended /**< raw data appended after the xml structure, the fastest and most compact */
+};
+
+/** Error bound of the lossy compression of a floating-point data array. */
+struct VtkLossyCompression
+{
+    Real error_bound_;
+    bool is_relative_; /**< relative to the value range of the array, as the relative bound of SZ */
+};
+
+/**
+ * @struct VtkCompression
+ * @brief Compression of the data arrays in the binary formats.
+ * The arrays are compressed losslessly by zlib in blocks. Before that, the values of
+ * the arrays given a lossy compression are quantized to multiples of twice the error bound,
+ * which keeps the error within the bound and makes the zlib compression effective.
+ * Without zlib in the build, the arrays are written uncompressed.
+ */
+struct VtkCompression
+{
+    bool is_zlib_compressed_ = false;
+    std::map<std::string, VtkLossyCompression> lossy_compressions_; /**< by array name */
+};
+
+/** VTK type name of a scalar type, e.g. Float64 for double. */
+template <typename ScalarType>
+std::string vtkScalarTypeName()
+{
+    std::string prefix = std::is_floating_point<ScalarType>::value
+                             ? "Float"
+                             : (std::is_signed<ScalarType>::value ? "Int" : "UInt");
+    return prefix + std::to_string(8 * sizeof(ScalarType));
+}
+
+/**
+ * @class VtkBinaryWriter
+ * @brief Writes data arrays of a vtk XML file in binary or appended format.
+ * Each array is written as a single block, with a UInt64 byte-count header,
+ * directly from the given memory. In appended format, only the array headers
+ * with their offsets are written first and the data are written by writeAppendedData
+ * after the xml structure, so that the memory must remain valid till then.
+ * With compression, the arrays are written in the block format of vtkZLibDataCompressor
+ * and the blocks are compressed in parallel.
+ */
+class VtkBinaryWriter
+{
+  public:
+    VtkBinaryWriter(std::ostream &output_stream, VtkDataFormat data_format);
+    ~VtkBinaryWriter(){};
+
+    template <typename ScalarType>
+    void writeDataArray(const std::string &name, const ScalarType *data,
+                        size_t number_of_tuples, int number_of_components = 1);
+    /** For data which have to be converted or generated before writing. */
+    template <typename ScalarType>
+    void writeDataArray(const std::string &name, StdVec<ScalarType> &&buffer, int number_of_components = 1);
+    /** Writes vectors with three components as required by vtk. */
+    template <int DIMENSION>
+    void writeVectorArray(const std::string &name, const Eigen::Matrix<Real, DIMENSION, 1> *data, size_t number_of_tuples);
+    /** Writes matrices with nine components in column-major order. */
+    template <int DIMENSION>
+    void writeMatrixArray(const std::string &name, const Eigen::Matrix<Real, DIMENSION, DIMENSION> *data, size_t number_of_tuples);
+    void writeAppendedData();
+    void setCompression(const VtkCompression &compression);
+    /** the attribute of the VTKFile element declaring the compressor, if any */
+    std::string CompressorAttribute();
+
+  protected:
+    struct AppendedBlock
+    {
+        const char *data_;
+        uint64_t size_;
+    };
+    std::ostream &output_stream_;
+    VtkDataFormat data_format_;
+    uint64_t appended_offset_;
+    StdVec<AppendedBlock> appended_blocks_;
+    std::list<StdVec<char>> owned_buffers_; /**< list for stable addresses */
+    VtkCompression compression_;
+
+    /** with the size header, the byte count of the data is encoded in front of the data */
+    void writeBase64(const char *data, uint64_t size, bool with_size_header = true);
+    /** returns the quantized copy of the data if a lossy compression is given for the array */
+    template <typename ScalarType>
+    const ScalarType *quantizeData(const std::string &name, const ScalarType *data, size_t number_of_values);
+    /** returns the compressed blocks led by the block header, with the size updated */
+    const char *compressData(const char *data, uint64_t &size);
+};
+
 /**
  * @class BodyStatesRecordingToVtp
  * @brief  Write files for bodies
@@ -46,11 +146,39 @@ class BodyStatesRecordingToVtp : public BodyStatesRecording
     BodyStatesRecordingToVtp(SPHBody &body) : BodyStatesRecording(body){};
     BodyStatesRecordingToVtp(SPHSystem &sph_system) : BodyStatesRecording(sph_system){};
     virtual ~BodyStatesRecordingToVtp(){};
+    /** binary formats are recommended for large cases, ascii is the default for debugging */
+    void setDataFormat(VtkDataFormat data_format) { data_format_ = data_format; };
+    /** lossless zlib compression of the binary formats */
+    void setCompression(bool is_compressed) { compression_.is_zlib_compressed_ = is_compressed; };
+    /** Lossy compression of a variable within an absolute or value-range relative error bound,
+     *  which turns on the zlib compression. Positions and ids are always lossless. */
+    void setLossyCompression(const std::string &variable_name, Real error_bound, bool is_relative = false)
+    {
+        compression_.is_zlib_compressed_ = true;
+        compression_.lossy_compressions_[variable_name] = VtkLossyCompression{error_bound, is_relative};
+    };
 
   protected:
+    VtkDataFormat data_format_ = VtkDataFormat::ascii;
+    VtkCompression compression_;
+
     virtual void writeWithFileName(const std::string &sequence) override;
-    template <typename OutStreamType>
-    void writeParticlesToVtk(OutStreamType &output_stream, BaseParticles &particles);
+    /** ParticlesType is BaseParticles or, for asynchronous output, BodyStatesSnapshot.
+     *  These writers are static so that they can be executed in the background writer thread. */
+    template <class ParticlesType>
+    static void writeVtpFile(const std::string &filefullpath, VtkDataFormat data_format,
+                             const VtkCompression &compression, const std::string &body_name,
+                             ParticlesType &particles);
+    template <class ParticlesType>
+    static void writeAsciiVtp(std::ostream &output_stream, const std::string &body_name, ParticlesType &particles);
+    template <class ParticlesType>
+    static void writeBinaryVtp(std::ostream &output_stream, VtkDataFormat data_format,
+                               const VtkCompression &compression, const std::string &body_name,
+                               ParticlesType &particles);
+    template <typename OutStreamType, class ParticlesType>
+    static void writeParticlesToVtk(OutStreamType &output_stream, ParticlesType &particles);
+    template <class ParticlesType>
+    static void writeParticlesToVtk(VtkBinaryWriter &binary_writer, ParticlesType &particles, const UnsignedInt *sorted_ids);
 };
 
 /**
@@ -101,6 +229,29 @@ class WriteToVtpIfVelocityOutOfBound
     virtual ~WriteToVtpIfVelocityOutOfBound(){};
 };
 
+/**
+ * @class WriteToVtpIfStateSentinelTriggered
+ * @brief Output body states if the sentinel flag of a body has been raised by the integration kernels,
+ * which only reads one flag per body instead of the reduction in WriteToVtpIfVelocityOutOfBound.
+ * Only the bodies integrated by the dynamics checking the sentinel, such as the second half steps
+ * of the fluid and solid integrations, are monitored.
+ */
+class WriteToVtpIfStateSentinelTriggered
+    : public BodyStatesRecordingToVtp
+{
+  private:
+    UniquePtrsKeeper<StateSentinel> state_sentinels_ptr_keeper_;
+
+  protected:
+    bool is_triggered_;
+    StdVec<StateSentinel *> state_sentinels_;
+    virtual void writeWithFileName(const std::string &sequence) override;
+
+  public:
+    WriteToVtpIfStateSentinelTriggered(SPHSystem &sph_system, Real velocity_bound);
+    virtual ~WriteToVtpIfStateSentinelTriggered(){};
+};
+
 class ParticleGenerationRecordingToVtp : public ParticleGenerationRecording
 {
   public:
@@ -6,8 +6,301 @@
 namespace SPH
 {
 //=============================================================================================//
-template <typename OutStreamType>
-void BodyStatesRecordingToVtp::writeParticlesToVtk(OutStreamType &output_stream, BaseParticles &particles)
+template <typename ScalarType>
+void VtkBinaryWriter::writeDataArray(const std::string &name, const ScalarType *data,
+                                     size_t number_of_tuples, int number_of_components)
+{
+    size_t number_of_values = number_of_tuples * number_of_components;
+    uint64_t size = number_of_values * sizeof(ScalarType);
+    const char *bytes = reinterpret_cast<const char *>(quantizeData(name, data, number_of_values));
+    if (compression_.is_zlib_compressed_)
+    {
+        bytes = compressData(bytes, size);
+    }
+
+    output_stream_ << "    <DataArray Name=\"" << name << "\" type=\"" << vtkScalarTypeName<ScalarType>()
+                   << "\" NumberOfComponents=\"" << number_of_components << "\"";
+    if (data_format_ == VtkDataFormat::appended)
+    {
+        output_stream_ << " format=\"appended\" offset=\"" << appended_offset_ << "\"/>\n";
+        appended_blocks_.push_back(AppendedBlock{bytes, size});
+        appended_offset_ += (compression_.is_zlib_compressed_ ? 0 : sizeof(uint64_t)) + size;
+    }
+    else
+    {
+        output_stream_ << " format=\"binary\">\n";
+        if (compression_.is_zlib_compressed_)
+        {
+            // the block header and the compressed blocks are encoded separately
+            uint64_t header_size = (3 + reinterpret_cast<const uint64_t *>(bytes)[0]) * sizeof(uint64_t);
+            writeBase64(bytes, header_size, false);
+            writeBase64(bytes + header_size, size - header_size, false);
+        }
+        else
+        {
+            writeBase64(bytes, size);
+        }
+        output_stream_ << "\n    </DataArray>\n";
+    }
+}
+//=============================================================================================//
+template <typename ScalarType>
+const ScalarType *VtkBinaryWriter::quantizeData(const std::string &name, const ScalarType *data,
+                                                size_t number_of_values)
+{
+    if constexpr (std::is_floating_point<ScalarType>::value)
+    {
+        auto lossy_compression = compression_.lossy_compressions_.find(name);
+        if (lossy_compression == compression_.lossy_compressions_.end() || number_of_values == 0)
+            return data;
+
+        Real error_bound = lossy_compression->second.error_bound_;
+        if (lossy_compression->second.is_relative_)
+        {
+            auto min_max = std::minmax_element(data, data + number_of_values);
+            error_bound *= Real(*min_max.second - *min_max.first);
+        }
+        if (!(error_bound > 0.0))
+            return data;
+
+        StdVec<char> &owned_buffer = owned_buffers_.emplace_back(number_of_values * sizeof(ScalarType));
+        ScalarType *quantized = reinterpret_cast<ScalarType *>(owned_buffer.data());
+        ScalarType quantum = ScalarType(2 * error_bound);
+        arena_parallel_for(
+            IndexRange(0, number_of_values),
+            [&](const IndexRange &r)
+            {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                    quantized[i] = std::round(data[i] / quantum) * quantum;
+            });
+        return quantized;
+    }
+    else
+    {
+        return data;
+    }
+}
+//=============================================================================================//
+template <typename ScalarType>
+void VtkBinaryWriter::writeDataArray(const std::string &name, StdVec<ScalarType> &&buffer, int number_of_components)
+{
+    size_t number_of_tuples = buffer.size() / number_of_components;
+    if (data_format_ == VtkDataFormat::appended && !compression_.is_zlib_compressed_)
+    {
+        StdVec<char> &owned_buffer = owned_buffers_.emplace_back(buffer.size() * sizeof(ScalarType));
+        std::memcpy(owned_buffer.data(), buffer.data(), owned_buffer.size());
+        buffer.clear();
+        writeDataArray(name, reinterpret_cast<const ScalarType *>(owned_buffer.data()),
+                       number_of_tuples, number_of_components);
+    }
+    else
+    {
+        writeDataArray(name, buffer.data(), number_of_tuples, number_of_components);
+    }
+}
+//=============================================================================================//
+template <int DIMENSION>
+void VtkBinaryWriter::writeVectorArray(const std::string &name, const Eigen::Matrix<Real, DIMENSION, 1> *data,
+                                       size_t number_of_tuples)
+{
+    if constexpr (DIMENSION == 3)
+    {
+        writeDataArray(name, reinterpret_cast<const Real *>(data), number_of_tuples, 3);
+    }
+    else
+    {
+        StdVec<Real> buffer(3 * number_of_tuples);
+        for (size_t i = 0; i != number_of_tuples; ++i)
+        {
+            Vec3d vector_value = upgradeToVec3d(data[i]);
+            for (int k = 0; k != 3; ++k)
+                buffer[3 * i + k] = vector_value[k];
+        }
+        writeDataArray(name, std::move(buffer), 3);
+    }
+}
+//=============================================================================================//
+template <int DIMENSION>
+void VtkBinaryWriter::writeMatrixArray(const std::string &name, const Eigen::Matrix<Real, DIMENSION, DIMENSION> *data,
+                                       size_t number_of_tuples)
+{
+    if constexpr (DIMENSION == 3)
+    {
+        writeDataArray(name, reinterpret_cast<const Real *>(data), number_of_tuples, 9);
+    }
+    else
+    {
+        StdVec<Real> buffer(9 * number_of_tuples);
+        for (size_t i = 0; i != number_of_tuples; ++i)
+        {
+            Mat3d matrix_value = upgradeToMat3d(data[i]);
+            std::memcpy(&buffer[9 * i], matrix_value.data(), 9 * sizeof(Real)); // column major
+        }
+        writeDataArray(name, std::move(buffer), 9);
+    }
+}
+//=============================================================================================//
+template <class ParticlesType>
+void BodyStatesRecordingToVtp::writeVtpFile(const std::string &filefullpath, VtkDataFormat data_format,
+                                            const VtkCompression &compression,
+                                            const std::string &body_name, ParticlesType &particles)
+{
+    if (fs::exists(filefullpath))
+    {
+        fs::remove(filefullpath);
+    }
+
+    if (data_format == VtkDataFormat::ascii)
+    {
+        std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+        writeAsciiVtp(out_file, body_name, particles);
+        out_file.close();
+    }
+    else
+    {
+        std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+        writeBinaryVtp(out_file, data_format, compression, body_name, particles);
+        out_file.close();
+    }
+}
+//=============================================================================================//
+template <class ParticlesType>
+void BodyStatesRecordingToVtp::writeAsciiVtp(std::ostream &output_stream, const std::string &body_name,
+                                             ParticlesType &particles)
+{
+    output_stream << "<?xml version=\"1.0\"?>\n";
+    output_stream << "<VTKFile type=\"PolyData\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+    output_stream << " <PolyData>\n";
+
+    size_t total_real_particles = particles.TotalRealParticles();
+    output_stream << "  <Piece Name =\"" << body_name << "\" NumberOfPoints=\"" << total_real_particles
+                  << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
+
+    // write current/final particle positions first
+    output_stream << "   <Points>\n";
+    output_stream << "    <DataArray Name=\"Position\" type=\"Float32\"  NumberOfComponents=\"3\" Format=\"ascii\">\n";
+    output_stream << "    ";
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        Vec3d particle_position = upgradeToVec3d(particles.ParticlePositions()[i]);
+        output_stream << particle_position[0] << " " << particle_position[1] << " " << particle_position[2] << " ";
+    }
+    output_stream << std::endl;
+    output_stream << "    </DataArray>\n";
+    output_stream << "   </Points>\n";
+
+    // write header of particles data
+    output_stream << "   <PointData  Vectors=\"vector\">\n";
+    writeParticlesToVtk(output_stream, particles);
+    output_stream << "   </PointData>\n";
+
+    // write empty cells
+    output_stream << "   <Verts>\n";
+    output_stream << "    <DataArray type=\"Int32\"  Name=\"connectivity\"  Format=\"ascii\">\n";
+    output_stream << "    ";
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        output_stream << i << " ";
+    }
+    output_stream << std::endl;
+    output_stream << "    </DataArray>\n";
+    output_stream << "    <DataArray type=\"Int32\"  Name=\"offsets\"  Format=\"ascii\">\n";
+    output_stream << "    ";
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        output_stream << i + 1 << " ";
+    }
+    output_stream << std::endl;
+    output_stream << "    </DataArray>\n";
+    output_stream << "   </Verts>\n";
+
+    output_stream << "  </Piece>\n";
+    output_stream << " </PolyData>\n";
+    output_stream << "</VTKFile>\n";
+}
+//=============================================================================================//
+template <class ParticlesType>
+void BodyStatesRecordingToVtp::writeBinaryVtp(std::ostream &output_stream, VtkDataFormat data_format,
+                                              const VtkCompression &compression, const std::string &body_name,
+                                              ParticlesType &particles)
+{
+    size_t total_real_particles = particles.TotalRealParticles();
+    VtkBinaryWriter binary_writer(output_stream, data_format);
+    binary_writer.setCompression(compression);
+    StdVec<UnsignedInt> sorted_ids(total_real_particles); // also the connectivity of the vertices
+    std::iota(sorted_ids.begin(), sorted_ids.end(), 0);
+
+    output_stream << "<?xml version=\"1.0\"?>\n";
+    output_stream << "<VTKFile type=\"PolyData\" version=\"1.0\" byte_order=\"LittleEndian\" header_type=\"UInt64\""
+                  << binary_writer.CompressorAttribute() << ">\n";
+    output_stream << " <PolyData>\n";
+    output_stream << "  <Piece Name =\"" << body_name << "\" NumberOfPoints=\"" << total_real_particles
+                  << "\" NumberOfVerts=\"" << total_real_particles << "\">\n";
+
+    output_stream << "   <Points>\n";
+    binary_writer.writeVectorArray("Position", particles.ParticlePositions(), total_real_particles);
+    output_stream << "   </Points>\n";
+
+    output_stream << "   <PointData  Vectors=\"vector\">\n";
+    writeParticlesToVtk(binary_writer, particles, sorted_ids.data());
+    output_stream << "   </PointData>\n";
+
+    StdVec<UnsignedInt> offsets(total_real_particles);
+    std::iota(offsets.begin(), offsets.end(), 1);
+    output_stream << "   <Verts>\n";
+    binary_writer.writeDataArray("connectivity", sorted_ids.data(), total_real_particles);
+    binary_writer.writeDataArray("offsets", offsets.data(), total_real_particles);
+    output_stream << "   </Verts>\n";
+
+    output_stream << "  </Piece>\n";
+    output_stream << " </PolyData>\n";
+    binary_writer.writeAppendedData();
+    output_stream << "</VTKFile>\n";
+}
+//=============================================================================================//
+template <class ParticlesType>
+void BodyStatesRecordingToVtp::writeParticlesToVtk(VtkBinaryWriter &binary_writer, ParticlesType &particles,
+                                                   const UnsignedInt *sorted_ids)
+{
+    size_t total_real_particles = particles.TotalRealParticles();
+    ParticleVariables &variables_to_write = particles.VariablesToWrite();
+
+    binary_writer.writeDataArray("SortedParticle_ID", sorted_ids, total_real_particles);
+    binary_writer.writeDataArray("OriginalParticle_ID", particles.ParticleOriginalIds(), total_real_particles);
+
+    constexpr int type_index_UnsignedInt = DataTypeIndex<UnsignedInt>::value;
+    for (DiscreteVariable<UnsignedInt> *variable : std::get<type_index_UnsignedInt>(variables_to_write))
+    {
+        binary_writer.writeDataArray(variable->Name(), variable->DataField(), total_real_particles);
+    }
+
+    constexpr int type_index_int = DataTypeIndex<int>::value;
+    for (DiscreteVariable<int> *variable : std::get<type_index_int>(variables_to_write))
+    {
+        binary_writer.writeDataArray(variable->Name(), variable->DataField(), total_real_particles);
+    }
+
+    constexpr int type_index_Real = DataTypeIndex<Real>::value;
+    for (DiscreteVariable<Real> *variable : std::get<type_index_Real>(variables_to_write))
+    {
+        binary_writer.writeDataArray(variable->Name(), variable->DataField(), total_real_particles);
+    }
+
+    constexpr int type_index_Vecd = DataTypeIndex<Vecd>::value;
+    for (DiscreteVariable<Vecd> *variable : std::get<type_index_Vecd>(variables_to_write))
+    {
+        binary_writer.writeVectorArray(variable->Name(), variable->DataField(), total_real_particles);
+    }
+
+    constexpr int type_index_Matd = DataTypeIndex<Matd>::value;
+    for (DiscreteVariable<Matd> *variable : std::get<type_index_Matd>(variables_to_write))
+    {
+        binary_writer.writeMatrixArray(variable->Name(), variable->DataField(), total_real_particles);
+    }
+}
+//=============================================================================================//
+template <typename OutStreamType, class ParticlesType>
+void BodyStatesRecordingToVtp::writeParticlesToVtk(OutStreamType &output_stream, ParticlesType &particles)
 {
     size_t total_real_particles = particles.TotalRealParticles();
     ParticleVariables &variables_to_write = particles.VariablesToWrite();
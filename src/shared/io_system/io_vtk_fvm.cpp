@@ -3,12 +3,78 @@
 namespace SPH
 {
 //=================================================================================================//
-BodyStatesRecordingInMeshToVtp::BodyStatesRecordingInMeshToVtp(SPHBody &body, ANSYSMesh &ansys_mesh)
-    : BodyStatesRecordingToVtp(body), node_coordinates_(ansys_mesh.node_coordinates_),
-      elements_nodes_connection_(ansys_mesh.elements_nodes_connection_) {}
+VtkMeshGeometry::VtkMeshGeometry(ANSYSMesh &ansys_mesh)
+    : node_coordinates_(ansys_mesh.node_coordinates_),
+      elements_nodes_connection_(ansys_mesh.elements_nodes_connection_), is_prepared_(false) {}
 //=================================================================================================//
-BodyStatesRecordingInMeshToVtu::BodyStatesRecordingInMeshToVtu(SPHBody &body, ANSYSMesh &ansys_mesh)
+void VtkMeshGeometry::prepare()
+{
+    if (is_prepared_)
+        return;
+
+    size_t total_nodes = node_coordinates_.size();
+    points_.resize(3 * total_nodes);
+    for (size_t node = 0; node != total_nodes; ++node)
+    {
+        Vec3d node_position = upgradeToVec3d(node_coordinates_[node]);
+        for (int k = 0; k != 3; ++k)
+            points_[3 * node + k] = node_position[k];
+    }
+
+    size_t total_cells = elements_nodes_connection_.size();
+    offsets_.resize(total_cells);
+    types_.resize(total_cells);
+    cell_ids_.resize(total_cells);
+    int64_t offset = 0;
+    for (size_t cell = 0; cell != total_cells; ++cell)
+    {
+        const StdVec<size_t> &cell_nodes = elements_nodes_connection_[cell];
+        for (size_t vertex : cell_nodes)
+        {
+            connectivity_.push_back(vertex);
+        }
+        offset += cell_nodes.size();
+        offsets_[cell] = offset;
+        cell_ids_[cell] = cell;
+
+        // vtk cell types: triangle 5, polygon 7, quad 9, tetra 10, hexahedron 12, wedge 13, pyramid 14
+        size_t number_of_nodes = cell_nodes.size();
+        if (Dimensions == 2)
+        {
+            types_[cell] = number_of_nodes == 3 ? 5 : (number_of_nodes == 4 ? 9 : 7);
+        }
+        else
+        {
+            types_[cell] = number_of_nodes == 8   ? 12
+                           : number_of_nodes == 6 ? 13
+                           : number_of_nodes == 5 ? 14
+                                                  : 10;
+        }
+    }
+    is_prepared_ = true;
+}
+//=================================================================================================//
+BodyStatesRecordingInMesh::BodyStatesRecordingInMesh(SPHBody &body, ANSYSMesh &ansys_mesh)
     : BodyStatesRecordingToVtp(body), node_coordinates_(ansys_mesh.node_coordinates_),
-      elements_nodes_connection_(ansys_mesh.elements_nodes_connection_), bounds_(body){};
+      elements_nodes_connection_(ansys_mesh.elements_nodes_connection_), mesh_geometry_(ansys_mesh) {}
+//=================================================================================================//
+void BodyStatesRecordingInMesh::writePvdFile(const std::string &body_name, const std::string &file_name)
+{
+    written_files_.push_back(std::make_pair(file_name, sv_physical_time_.getValue()));
+
+    std::string filefullpath = io_environment_.output_folder_ + "/" + body_name + ".pvd";
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    out_file << "<?xml version=\"1.0\"?>\n";
+    out_file << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\">\n";
+    out_file << " <Collection>\n";
+    for (const auto &[written_file, physical_time] : written_files_)
+    {
+        out_file << "  <DataSet timestep=\"" << std::setprecision(9) << physical_time
+                 << "\" part=\"0\" file=\"" << written_file << "\"/>\n";
+    }
+    out_file << " </Collection>\n";
+    out_file << "</VTKFile>\n";
+    out_file.close();
+}
 //=================================================================================================//
 } // namespace SPH
@@ -34,33 +34,83 @@
 
 namespace SPH
 {
+/**
+ * @class VtkMeshGeometry
+ * @brief The static geometry of an unstructured mesh arranged as vtk data arrays.
+ * It is prepared at the first binary output and then written directly from memory,
+ * so that only the cell data are encoded at each output step.
+ */
+class VtkMeshGeometry
+{
+  public:
+    explicit VtkMeshGeometry(ANSYSMesh &ansys_mesh);
+    ~VtkMeshGeometry(){};
+
+    void prepare();
+    size_t NumberOfNodes() { return node_coordinates_.size(); };
+    size_t NumberOfCells() { return elements_nodes_connection_.size(); };
+
+    StdVec<Real> points_; /**< node coordinates with three components */
+    StdVec<int64_t> connectivity_;
+    StdVec<int64_t> offsets_;
+    StdVec<uint8_t> types_; /**< vtk cell types from the number of nodes of each cell */
+    StdVec<UnsignedInt> cell_ids_; /**< identical to the particle ids */
+
+  protected:
+    StdLargeVec<Vecd> &node_coordinates_;
+    StdLargeVec<StdVec<size_t>> &elements_nodes_connection_;
+    bool is_prepared_;
+};
+
+/**
+ * @class BodyStatesRecordingInMesh
+ * @brief Base class for writing body states on an unstructured mesh.
+ * With binary or appended data format, the mesh geometry is prepared only once.
+ * A <body>.pvd collection of all written files is kept for loading the time series in ParaView.
+ */
+class BodyStatesRecordingInMesh : public BodyStatesRecordingToVtp
+{
+  public:
+    BodyStatesRecordingInMesh(SPHBody &body, ANSYSMesh &ansys_mesh);
+    virtual ~BodyStatesRecordingInMesh(){};
+
+  protected:
+    StdLargeVec<Vecd> &node_coordinates_;
+    StdLargeVec<StdVec<size_t>> &elements_nodes_connection_;
+    VtkMeshGeometry mesh_geometry_;
+    /** file names and physical times of the written files */
+    StdVec<std::pair<std::string, Real>> written_files_;
+
+    void writePvdFile(const std::string &body_name, const std::string &file_name);
+};
+
 /**
  * @class BodyStatesRecordingInMeshToVtp
  * @brief  Write files for bodies
  * the output file is VTK XML format in FVMcan visualized by ParaView the data type vtkPolyData
  */
-class BodyStatesRecordingInMeshToVtp : public BodyStatesRecordingToVtp
+class BodyStatesRecordingInMeshToVtp : public BodyStatesRecordingInMesh
 {
   public:
-    BodyStatesRecordingInMeshToVtp(SPHBody &body, ANSYSMesh &ansys_mesh);
+    BodyStatesRecordingInMeshToVtp(SPHBody &body, ANSYSMesh &ansys_mesh)
+        : BodyStatesRecordingInMesh(body, ansys_mesh){};
     virtual ~BodyStatesRecordingInMeshToVtp(){};
 
   protected:
     virtual void writeWithFileName(const std::string &sequence) override;
-    StdLargeVec<Vecd> &node_coordinates_;
-    StdLargeVec<StdVec<size_t>> &elements_nodes_connection_;
+    void writeBinaryVtpInMesh(std::ostream &output_stream, BaseParticles &particles);
 };
 
-class BodyStatesRecordingInMeshToVtu : public BodyStatesRecordingToVtp
+class BodyStatesRecordingInMeshToVtu : public BodyStatesRecordingInMesh
 {
   public:
-    BodyStatesRecordingInMeshToVtu(SPHBody &body, ANSYSMesh &ansys_mesh);
+    BodyStatesRecordingInMeshToVtu(SPHBody &body, ANSYSMesh &ansys_mesh)
+        : BodyStatesRecordingInMesh(body, ansys_mesh), bounds_(body){};
     virtual ~BodyStatesRecordingInMeshToVtu(){};
 
   protected:
     virtual void writeWithFileName(const std::string &sequence) override;
-    StdLargeVec<Vecd> &node_coordinates_;
-    StdLargeVec<StdVec<size_t>> &elements_nodes_connection_;
+    void writeBinaryVtuInMesh(std::ostream &output_stream, BaseParticles &particles);
     SPHBody &bounds_;
 };
 } // namespace SPH
@@ -55,6 +55,11 @@ class AnisotropicKernel : public KernelType
   protected:
     Mat2d transformed_tensor_2d_;
     Mat3d transformed_tensor_3d_;
+    /** The transformation tensors are diagonal (the transform vector is not used for rotation),
+     * so their diagonals and squared diagonals (the metric) are pre-baked for the evaluations. */
+    Vec2d scaling_2d_, metric_2d_;
+    Vec3d scaling_3d_, metric_3d_;
+    Real kernel_size_sqr_;
 
   public:
     explicit AnisotropicKernel(Real h, Vec2d kernel_vector = Vec2d(1.0, 1.0), Vec2d transform_vector = Vec2d(0.0, 0.0))
@@ -75,6 +80,12 @@ class AnisotropicKernel : public KernelType
 
     void getFactors()
     {
+        scaling_2d_ = transformed_tensor_2d_.diagonal();
+        scaling_3d_ = transformed_tensor_3d_.diagonal();
+        metric_2d_ = scaling_2d_.cwiseProduct(scaling_2d_);
+        metric_3d_ = scaling_3d_.cwiseProduct(scaling_3d_);
+        kernel_size_sqr_ = this->KernelSize() * this->KernelSize();
+
         this->factor_W_1D_ = this->h_ * 1.0 / this->h_ * this->FactorW1D();
         this->factor_W_2D_ = this->h_ * this->h_ * transformed_tensor_2d_.determinant() * this->FactorW2D();
         this->factor_W_3D_ = this->h_ * this->h_ * this->h_ * transformed_tensor_3d_.determinant() * this->FactorW3D();
@@ -33,37 +33,27 @@ Mat3d AnisotropicKernel<KernelType>::getCoordinateTransformationTensorG(Vec3d ke
 template <class KernelType>
 Vec2d AnisotropicKernel<KernelType>::e(const Real &distance, const Vec2d &displacement) const
 {
-    Vec2d transformed_displacement_ = this->h_ * transformed_tensor_2d_ * displacement;
-    return transformed_tensor_2d_ * transformed_displacement_ / ((transformed_displacement_).norm() + TinyReal);
+    Vec2d transformed_displacement = this->h_ * scaling_2d_.cwiseProduct(displacement);
+    return scaling_2d_.cwiseProduct(transformed_displacement) / (transformed_displacement.norm() + TinyReal);
 }
 //=========================================================================================//
 template <class KernelType>
 Vec3d AnisotropicKernel<KernelType>::e(const Real &r_ij, const Vec3d &displacement) const
 {
-    Vec3d transformed_displacement_ = this->h_ * transformed_tensor_3d_ * displacement;
-    return transformed_tensor_3d_ * transformed_displacement_ / ((transformed_displacement_).norm() + TinyReal);
+    Vec3d transformed_displacement = this->h_ * scaling_3d_.cwiseProduct(displacement);
+    return scaling_3d_.cwiseProduct(transformed_displacement) / (transformed_displacement.norm() + TinyReal);
 }
 //=========================================================================================//
 template <class KernelType>
 bool AnisotropicKernel<KernelType>::checkIfWithinCutOffRadius(Vec2d displacement)
 {
-    Vec2d transformed_displacement = this->h_ * transformed_tensor_2d_ * displacement;
-    Real distance_metric = transformed_displacement.squaredNorm();
-    if (distance_metric < this->CutOffRadiusSqr())
-        return true;
-    else
-        return false;
+    return metric_2d_.dot(displacement.cwiseProduct(displacement)) < kernel_size_sqr_;
 }
 //=========================================================================================//
 template <class KernelType>
 bool AnisotropicKernel<KernelType>::checkIfWithinCutOffRadius(Vec3d displacement)
 {
-    Vec3d transformed_displacement = this->h_ * transformed_tensor_3d_ * displacement;
-    Real distance_metric = transformed_displacement.squaredNorm();
-    if (distance_metric < this->CutOffRadiusSqr())
-        return true;
-    else
-        return false;
+    return metric_3d_.dot(displacement.cwiseProduct(displacement)) < kernel_size_sqr_;
 }
 //=========================================================================================//
 template <class KernelType>
@@ -76,16 +66,14 @@ Real AnisotropicKernel<KernelType>::W(const Real &r_ij, const Real &displacement
 template <class KernelType>
 Real AnisotropicKernel<KernelType>::W(const Real &r_ij, const Vec2d &displacement) const
 {
-    Vec2d transformed_displacement = transformed_tensor_2d_ * displacement;
-    Real q = transformed_displacement.norm();
+    Real q = std::sqrt(metric_2d_.dot(displacement.cwiseProduct(displacement)));
     return this->factor_W_2D_ * this->W_2D(q);
 }
 //=========================================================================================//
 template <class KernelType>
 Real AnisotropicKernel<KernelType>::W(const Real &r_ij, const Vec3d &displacement) const
 {
-    Vec3d transformed_displacement = transformed_tensor_3d_ * displacement;
-    Real q = transformed_displacement.norm();
+    Real q = std::sqrt(metric_3d_.dot(displacement.cwiseProduct(displacement)));
     return this->factor_W_3D_ * this->W_3D(q);
 }
 //=========================================================================================//
@@ -99,16 +87,14 @@ Real AnisotropicKernel<KernelType>::dW(const Real &r_ij, const Real &displacemen
 template <class KernelType>
 Real AnisotropicKernel<KernelType>::dW(const Real &r_ij, const Vec2d &displacement) const
 {
-    Vec2d transformed_displacement = transformed_tensor_2d_ * displacement;
-    Real q = transformed_displacement.norm();
+    Real q = std::sqrt(metric_2d_.dot(displacement.cwiseProduct(displacement)));
     return this->factor_dW_2D_ * this->dW_2D(q);
 }
 //=========================================================================================//
 template <class KernelType>
 Real AnisotropicKernel<KernelType>::dW(const Real &r_ij, const Vec3d &displacement) const
 {
-    Vec3d transformed_displacement = transformed_tensor_3d_ * displacement;
-    Real q = transformed_displacement.norm();
+    Real q = std::sqrt(metric_3d_.dot(displacement.cwiseProduct(displacement)));
     return this->factor_dW_3D_ * this->dW_3D(q);
 }
 //=========================================================================================//
@@ -122,18 +108,18 @@ Real AnisotropicKernel<KernelType>::d2W(const Real &r_ij, const Real &displaceme
 template <class KernelType>
 Real AnisotropicKernel<KernelType>::d2W(const Real &r_ij, const Vec2d &displacement) const
 {
-    Vec2d transformed_displacement = transformed_tensor_2d_ * displacement;
+    Vec2d transformed_displacement = scaling_2d_.cwiseProduct(displacement);
     Real q = transformed_displacement.norm();
-    Real derivate_parameter2D_ = (transformed_tensor_2d_ * transformed_displacement).norm() / (q + TinyReal);
+    Real derivate_parameter2D_ = scaling_2d_.cwiseProduct(transformed_displacement).norm() / (q + TinyReal);
     return this->factor_d2W_2D_ * derivate_parameter2D_ * derivate_parameter2D_ * this->d2W_2D(q);
 }
 //=========================================================================================//
 template <class KernelType>
 Real AnisotropicKernel<KernelType>::d2W(const Real &r_ij, const Vec3d &displacement) const
 {
-    Vec3d transformed_displacement = transformed_tensor_3d_ * displacement;
+    Vec3d transformed_displacement = scaling_3d_.cwiseProduct(displacement);
     Real q = transformed_displacement.norm();
-    Real derivate_parameter3D_ = (transformed_tensor_3d_ * transformed_displacement).norm() / (q + TinyReal);
+    Real derivate_parameter3D_ = scaling_3d_.cwiseProduct(transformed_displacement).norm() / (q + TinyReal);
     return this->factor_d2W_3D_ * derivate_parameter3D_ * derivate_parameter3D_ * this->d2W_3D(q);
 }
 //=========================================================================================//
@@ -215,5 +215,77 @@ class Kernel
     void reduceOnce();  /** reduce for thin structures or films */
     void reduceTwice(); /** reduce for linear structures or filaments */
 };
+
+/**
+ * @class KernelWithStaticDispatch
+ * @brief A kernel whose dimensionless functions are given by the inline static functions of q
+ *        of the template parameter. Evaluated by StaticDispatchEvaluation, the kernel is resolved
+ *        at compile time and inlined, while the virtual interface is kept for the kernels selected at runtime.
+ */
+template <class KernelFunctionType>
+class KernelWithStaticDispatch : public Kernel
+{
+  public:
+    using Kernel::Kernel;
+    using Kernel::dW;
+    using Kernel::W;
+
+    Real W(const Real &r_ij, const Vec2d &displacement) const override
+    {
+        return factor_W_2D_ * KernelFunctionType::W_2D(r_ij * inv_h_);
+    };
+    Real W(const Real &r_ij, const Vec3d &displacement) const override
+    {
+        return factor_W_3D_ * KernelFunctionType::W_3D(r_ij * inv_h_);
+    };
+    Real dW(const Real &r_ij, const Vec2d &displacement) const override
+    {
+        return factor_dW_2D_ * KernelFunctionType::dW_2D(r_ij * inv_h_);
+    };
+    Real dW(const Real &r_ij, const Vec3d &displacement) const override
+    {
+        return factor_dW_3D_ * KernelFunctionType::dW_3D(r_ij * inv_h_);
+    };
+
+    Real W_1D(const Real q) const override { return KernelFunctionType::W_1D(q); };
+    Real W_2D(const Real q) const override { return KernelFunctionType::W_2D(q); };
+    Real W_3D(const Real q) const override { return KernelFunctionType::W_3D(q); };
+    Real dW_1D(const Real q) const override { return KernelFunctionType::dW_1D(q); };
+    Real dW_2D(const Real q) const override { return KernelFunctionType::dW_2D(q); };
+    Real dW_3D(const Real q) const override { return KernelFunctionType::dW_3D(q); };
+    Real d2W_1D(const Real q) const override { return KernelFunctionType::d2W_1D(q); };
+    Real d2W_2D(const Real q) const override { return KernelFunctionType::d2W_2D(q); };
+    Real d2W_3D(const Real q) const override { return KernelFunctionType::d2W_3D(q); };
+};
+
+/**
+ * @class StaticDispatchEvaluation
+ * @brief Evaluates a kernel by qualified, hence non-virtual and inlined, calls.
+ *        Only valid when the dynamic type of the kernel is exactly KernelType.
+ */
+template <class KernelType>
+class StaticDispatchEvaluation
+{
+    const KernelType &kernel_;
+
+  public:
+    explicit StaticDispatchEvaluation(const KernelType &kernel) : kernel_(kernel){};
+
+    template <class DisplacementType>
+    Real W(const Real &r_ij, const DisplacementType &displacement) const
+    {
+        return kernel_.KernelType::W(r_ij, displacement);
+    };
+    template <class DisplacementType>
+    Real dW(const Real &r_ij, const DisplacementType &displacement) const
+    {
+        return kernel_.KernelType::dW(r_ij, displacement);
+    };
+    template <class DisplacementType>
+    DisplacementType e(const Real &distance, const DisplacementType &displacement) const
+    {
+        return kernel_.KernelType::e(distance, displacement);
+    };
+};
 } // namespace SPH
 #endif // BASE_KERNELS_H
@@ -6,7 +6,7 @@ namespace SPH
 {
 //=================================================================================================//
 KernelWendlandC2::KernelWendlandC2(Real h)
-    : Kernel(h, 2.0, 2.0, "Wendland2CKernel")
+    : KernelWithStaticDispatch<KernelWendlandC2Function>(h, 2.0, 2.0, "Wendland2CKernel")
 {
     factor_W_1D_ = inv_h_ * 3.0 / 4.0;
     factor_W_2D_ = inv_h_ * inv_h_ * 7.0 / (4.0 * Pi);
@@ -14,49 +14,4 @@ KernelWendlandC2::KernelWendlandC2(Real h)
     setDerivativeParameters();
 }
 //=================================================================================================//
-Real KernelWendlandC2::W_1D(const Real q) const
-{
-    return pow(1.0 - 0.5 * q, 4) * (1.0 + 2.0 * q);
-}
-//=================================================================================================//
-Real KernelWendlandC2::W_2D(const Real q) const
-{
-    return W_1D(q);
-}
-//=================================================================================================//
-Real KernelWendlandC2::W_3D(const Real q) const
-{
-    return W_2D(q);
-}
-//=================================================================================================//
-Real KernelWendlandC2::dW_1D(const Real q) const
-{
-    return 0.625 * pow(q - 2.0, 3) * q;
-}
-//=================================================================================================//
-Real KernelWendlandC2::dW_2D(const Real q) const
-{
-    return dW_1D(q);
-}
-//=================================================================================================//
-Real KernelWendlandC2::dW_3D(const Real q) const
-{
-    return dW_2D(q);
-}
-//=================================================================================================//
-Real KernelWendlandC2::d2W_1D(const Real q) const
-{
-    return 1.25 * pow(q - 2.0, 2) * (2.0 * q - 1.0);
-}
-//=================================================================================================//
-Real KernelWendlandC2::d2W_2D(const Real q) const
-{
-    return d2W_1D(q);
-}
-//=================================================================================================//
-Real KernelWendlandC2::d2W_3D(const Real q) const
-{
-    return d2W_2D(q);
-}
-//=================================================================================================//
 } // namespace SPH
@@ -33,30 +33,28 @@
 
 namespace SPH
 {
+struct KernelWendlandC2Function
+{
+    static inline Real W_1D(Real q) { return pow(1.0 - 0.5 * q, 4) * (1.0 + 2.0 * q); };
+    static inline Real W_2D(Real q) { return W_1D(q); };
+    static inline Real W_3D(Real q) { return W_1D(q); };
+    static inline Real dW_1D(Real q) { return 0.625 * pow(q - 2.0, 3) * q; };
+    static inline Real dW_2D(Real q) { return dW_1D(q); };
+    static inline Real dW_3D(Real q) { return dW_1D(q); };
+    static inline Real d2W_1D(Real q) { return 1.25 * pow(q - 2.0, 2) * (2.0 * q - 1.0); };
+    static inline Real d2W_2D(Real q) { return d2W_1D(q); };
+    static inline Real d2W_3D(Real q) { return d2W_1D(q); };
+};
+
 /**
  * @class KernelWendlandC2
- * @brief Kernel WendlandC2
+ * @brief Kernel WendlandC2, the default kernel, which is evaluated by static dispatch
+ *        when it is exactly the kernel type in use.
  */
-class KernelWendlandC2 : public Kernel
+class KernelWendlandC2 : public KernelWithStaticDispatch<KernelWendlandC2Function>
 {
   public:
     explicit KernelWendlandC2(Real h);
-
-    /**
-     * Calculates the kernel value for
-     * the given distance of two particles
-     */
-    virtual Real W_1D(const Real q) const override;
-    virtual Real W_2D(const Real q) const override;
-    virtual Real W_3D(const Real q) const override;
-
-    virtual Real dW_1D(const Real q) const override;
-    virtual Real dW_2D(const Real q) const override;
-    virtual Real dW_3D(const Real q) const override;
-
-    virtual Real d2W_1D(const Real q) const override;
-    virtual Real d2W_2D(const Real q) const override;
-    virtual Real d2W_3D(const Real q) const override;
 };
 } // namespace SPH
 #endif // KERNEL_WENLAND_C2_H
\ No newline at end of file
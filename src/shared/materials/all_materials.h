@@ -36,4 +36,5 @@
 #include "elastic_solid.h"
 #include "general_continuum.h"
 #include "inelastic_solid.h"
+#include "porous_media_solid.h"
 #include "weakly_compressible_fluid.h"
\ No newline at end of file
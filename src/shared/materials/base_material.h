@@ -42,6 +42,23 @@ namespace SPH
 {
 class BaseParticles;
 
+/**
+ * @brief Batched evaluation of a material function for the particles in [begin, end).
+ * The function is usually a lambda calling the computing kernel of a concrete material,
+ * such as WeaklyCompressibleFluid::EosKernel or LinearElasticSolid::ConstituteKernel,
+ * so that it is dispatched statically and the loop can be inlined and vectorized, e.g.
+ * evaluate(begin, end, [&](Real rho) { return eos.getPressure(rho); }, p, rho).
+ */
+template <typename FunctionType, typename OutputType, typename... InputTypes>
+inline void evaluate(size_t begin, size_t end, const FunctionType &function,
+                     OutputType *output, const InputTypes *...inputs)
+{
+    for (size_t i = begin; i != end; ++i)
+    {
+        output[i] = function(inputs[i]...);
+    }
+}
+
 /** @class  BaseMaterial
  *  @brief Base of all materials
  *  @details Note that the case dependent parameters of the material properties
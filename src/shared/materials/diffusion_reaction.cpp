@@ -37,7 +37,7 @@ LocalIsotropicDiffusion::LocalIsotropicDiffusion(const std::string &diffusion_sp
                                                  const std::string &gradient_species_name,
                                                  Real diff_cf)
     : IsotropicDiffusion(diffusion_species_name, gradient_species_name, diff_cf),
-      local_diffusivity_(nullptr)
+      local_diffusivity_(nullptr), dv_local_diffusivity_(nullptr)
 {
     material_type_name_ = "LocalIsotropicDiffusion";
 }
@@ -50,6 +50,7 @@ void LocalIsotropicDiffusion::initializeLocalParameters(BaseParticles *base_part
     local_diffusivity_ = base_particles->registerStateVariable<Real>(
         "ThermalConductivity", [&](size_t i) -> Real
         { return diff_cf_; });
+    dv_local_diffusivity_ = base_particles->getVariableByName<Real>("ThermalConductivity");
     base_particles->addVariableToWrite<Real>("ThermalConductivity");
 }
 //=================================================================================================//
@@ -81,7 +82,8 @@ LocalDirectionalDiffusion::LocalDirectionalDiffusion(const std::string &diffusio
                                                      Real diff_cf, Real bias_diff_cf, Vecd bias_direction)
     : DirectionalDiffusion(diffusion_species_name, gradient_species_name,
                            diff_cf, bias_diff_cf, bias_direction),
-      local_bias_direction_(nullptr), local_transformed_diffusivity_(nullptr)
+      local_bias_direction_(nullptr), local_transformed_diffusivity_(nullptr),
+      dv_local_transformed_diffusivity_(nullptr)
 {
     material_type_name_ = "LocalDirectionalDiffusion";
 }
@@ -111,6 +113,7 @@ void LocalDirectionalDiffusion::initializeLocalParameters(BaseParticles *base_pa
                           bias_diff_cf_ * local_bias_direction_[i] * local_bias_direction_[i].transpose();
             return inverseCholeskyDecomposition(diff_i);
         });
+    dv_local_transformed_diffusivity_ = base_particles->getVariableByName<Matd>("LocalTransformedDiffusivity");
 
     std::cout << "\n Local diffusion parameters setup finished " << std::endl;
 };
@@ -85,6 +85,18 @@ class IsotropicDiffusion : public BaseDiffusion
     {
         return diff_cf_;
     };
+
+    class InterParticleDiffusionCoeff
+    {
+      public:
+        template <class ExecutionPolicy>
+        InterParticleDiffusionCoeff(const ExecutionPolicy &ex_policy, IsotropicDiffusion &encloser)
+            : diff_cf_(encloser.diff_cf_){};
+        Real operator()(size_t index_i, size_t index_j, const Vecd &e_ij) { return diff_cf_; };
+
+      protected:
+        Real diff_cf_;
+    };
 };
 
 /**
@@ -96,6 +108,7 @@ class LocalIsotropicDiffusion : public IsotropicDiffusion
 {
   protected:
     Real *local_diffusivity_;
+    DiscreteVariable<Real> *dv_local_diffusivity_;
 
   public:
     LocalIsotropicDiffusion(const std::string &diffusion_species_name,
@@ -112,6 +125,21 @@ class LocalIsotropicDiffusion : public IsotropicDiffusion
     {
         return 0.5 * (local_diffusivity_[index_i] + local_diffusivity_[index_j]);
     };
+
+    class InterParticleDiffusionCoeff
+    {
+      public:
+        template <class ExecutionPolicy>
+        InterParticleDiffusionCoeff(const ExecutionPolicy &ex_policy, LocalIsotropicDiffusion &encloser)
+            : local_diffusivity_(encloser.dv_local_diffusivity_->DelegatedDataField(ex_policy)){};
+        Real operator()(size_t index_i, size_t index_j, const Vecd &e_ij)
+        {
+            return 0.5 * (local_diffusivity_[index_i] + local_diffusivity_[index_j]);
+        };
+
+      protected:
+        Real *local_diffusivity_;
+    };
 };
 
 /**
@@ -145,6 +173,22 @@ class DirectionalDiffusion : public IsotropicDiffusion
         Vecd grad_ij = transformed_diffusivity_ * e_ij;
         return 1.0 / grad_ij.squaredNorm();
     };
+
+    class InterParticleDiffusionCoeff
+    {
+      public:
+        template <class ExecutionPolicy>
+        InterParticleDiffusionCoeff(const ExecutionPolicy &ex_policy, DirectionalDiffusion &encloser)
+            : transformed_diffusivity_(encloser.transformed_diffusivity_){};
+        Real operator()(size_t index_i, size_t index_j, const Vecd &e_ij)
+        {
+            Vecd grad_ij = transformed_diffusivity_ * e_ij;
+            return 1.0 / grad_ij.squaredNorm();
+        };
+
+      protected:
+        Matd transformed_diffusivity_;
+    };
 };
 
 /**
@@ -156,6 +200,7 @@ class LocalDirectionalDiffusion : public DirectionalDiffusion
   protected:
     Vecd *local_bias_direction_;
     Matd *local_transformed_diffusivity_;
+    DiscreteVariable<Matd> *dv_local_transformed_diffusivity_;
 
   public:
     LocalDirectionalDiffusion(const std::string &diffusion_species_name,
@@ -175,6 +220,27 @@ class LocalDirectionalDiffusion : public DirectionalDiffusion
         Vecd grad_ij = trans_diffusivity * e_ij;
         return 1.0 / grad_ij.squaredNorm();
     };
+
+    class InterParticleDiffusionCoeff
+    {
+      public:
+        template <class ExecutionPolicy>
+        InterParticleDiffusionCoeff(const ExecutionPolicy &ex_policy, LocalDirectionalDiffusion &encloser)
+            : local_transformed_diffusivity_(
+                  encloser.dv_local_transformed_diffusivity_->DelegatedDataField(ex_policy)){};
+        Real operator()(size_t index_i, size_t index_j, const Vecd &e_ij)
+        {
+            const Matd &A = local_transformed_diffusivity_[index_i];
+            const Matd &B = local_transformed_diffusivity_[index_j];
+            Matd trans_diffusivity = 2.0 * A.cwiseProduct(B).cwiseQuotient(
+                                               A + B + TinyReal * Matd::Ones());
+            Vecd grad_ij = trans_diffusivity * e_ij;
+            return 1.0 / grad_ij.squaredNorm();
+        };
+
+      protected:
+        Matd *local_transformed_diffusivity_;
+    };
 };
 
 /**
@@ -45,6 +45,12 @@ DiscreteVariable<Vecd> *ElasticSolid::AverageAccelerationVariable(BaseParticles
     return base_particles->registerStateVariableOnly<Vecd>("AverageAcceleration");
 }
 //=================================================================================================//
+ElasticSolid::ConstituteKernel::ConstituteKernel(ElasticSolid &encloser)
+    : rho0_(encloser.rho0_), c0_(encloser.c0_), G0_(encloser.G0_), K0_(encloser.K0_) {}
+//=================================================================================================//
+LinearElasticSolid::ConstituteKernel::ConstituteKernel(LinearElasticSolid &encloser)
+    : ElasticSolid::ConstituteKernel(encloser), lambda0_(encloser.lambda0_) {}
+//=================================================================================================//
 LinearElasticSolid::
     LinearElasticSolid(Real rho0, Real youngs_modulus, Real poisson_ratio) : ElasticSolid(rho0)
 {
@@ -111,6 +111,21 @@ class ElasticSolid : public Solid
     /** Get average acceleration when interacting with fluid. */
     virtual DiscreteVariable<Vecd> *AverageAccelerationVariable(BaseParticles *base_particles) override;
     virtual ElasticSolid *ThisObjectPtr() override { return this; };
+
+    /** Material parameters copied into computing kernels, which cannot call virtual functions on the device. */
+    class ConstituteKernel
+    {
+      public:
+        ConstituteKernel(ElasticSolid &encloser);
+
+        Real PairNumericalDamping(Real dE_dt_ij, Real smoothing_length)
+        {
+            return 0.5 * rho0_ * c0_ * dE_dt_ij * smoothing_length;
+        };
+
+      protected:
+        Real rho0_, c0_, G0_, K0_;
+    };
 };
 
 /**
@@ -137,6 +152,23 @@ class LinearElasticSolid : public ElasticSolid
     Real getPoissonRatio() { return nu_; };
     Real getDensity() { return rho0_; };
 
+    class ConstituteKernel : public ElasticSolid::ConstituteKernel
+    {
+      public:
+        ConstituteKernel(LinearElasticSolid &encloser);
+
+        Matd StressPK2(const Matd &F, size_t index_i)
+        {
+            Matd strain = 0.5 * (F.transpose() + F) - Matd::Identity();
+            return lambda0_ * strain.trace() * Matd::Identity() + 2.0 * G0_ * strain;
+        };
+
+        Matd StressPK1(const Matd &F, size_t index_i) { return F * StressPK2(F, index_i); };
+
+      protected:
+        Real lambda0_;
+    };
+
   protected:
     Real lambda0_; /*< first Lame parameter */
     Real getBulkModulus(Real youngs_modulus, Real poisson_ratio);
@@ -162,6 +194,21 @@ class SaintVenantKirchhoffSolid : public LinearElasticSolid
 
     /** second Piola-Kirchhoff stress related with green-lagrangian deformation tensor */
     virtual Matd StressPK2(Matd &deformation, size_t particle_index_i) override;
+
+    class ConstituteKernel : public LinearElasticSolid::ConstituteKernel
+    {
+      public:
+        ConstituteKernel(SaintVenantKirchhoffSolid &encloser)
+            : LinearElasticSolid::ConstituteKernel(encloser){};
+
+        Matd StressPK2(const Matd &F, size_t index_i)
+        {
+            Matd strain = 0.5 * (F.transpose() * F - Matd::Identity());
+            return lambda0_ * strain.trace() * Matd::Identity() + 2.0 * G0_ * strain;
+        };
+
+        Matd StressPK1(const Matd &F, size_t index_i) { return F * StressPK2(F, index_i); };
+    };
 };
 
 /**
@@ -185,6 +232,22 @@ class NeoHookeanSolid : public LinearElasticSolid
     virtual Real VolumetricKirchhoff(Real J) override;
     /** Define the calculation of the stress matrix for postprocessing */
     virtual std::string getRelevantStressMeasureName() override { return "Cauchy"; };
+
+    class ConstituteKernel : public LinearElasticSolid::ConstituteKernel
+    {
+      public:
+        ConstituteKernel(NeoHookeanSolid &encloser)
+            : LinearElasticSolid::ConstituteKernel(encloser){};
+
+        Matd StressPK2(const Matd &F, size_t index_i)
+        {
+            Matd right_cauchy = F.transpose() * F;
+            Real J = F.determinant();
+            return G0_ * Matd::Identity() + (lambda0_ * (J - 1.0) - G0_) * J * right_cauchy.inverse();
+        };
+
+        Matd StressPK1(const Matd &F, size_t index_i) { return F * StressPK2(F, index_i); };
+    };
 };
 
 /**
@@ -27,6 +27,9 @@ Matd GeneralContinuum::ConstitutiveRelationShearStress(Matd &velocity_gradient,
     return stress_rate;
 }
 //=================================================================================================//
+GeneralContinuum::ConstituteKernel::ConstituteKernel(GeneralContinuum &encloser)
+    : G_(encloser.G_) {}
+//=================================================================================================//
 Real PlasticContinuum::getDPConstantsA(Real friction_angle)
 {
     return tan(friction_angle) / sqrt(9.0 + 12.0 * tan(friction_angle) * tan(friction_angle));
@@ -75,6 +78,11 @@ Mat3d PlasticContinuum::ReturnMapping(Mat3d &stress_tensor)
     return stress_tensor;
 }
 //=================================================================================================//
+PlasticContinuum::ConstituteKernel::ConstituteKernel(PlasticContinuum &encloser)
+    : GeneralContinuum::ConstituteKernel(encloser), K_(encloser.K_),
+      alpha_phi_(encloser.alpha_phi_), alpha_psi_(encloser.getDPConstantsA(encloser.psi_)),
+      k_c_(encloser.k_c_), stress_dimension_(encloser.stress_dimension_) {}
+//=================================================================================================//
 Matd J2Plasticity::ConstitutiveRelationShearStress(Matd &velocity_gradient, Matd &shear_stress, Real &hardening_factor)
 {
     Matd strain_rate = 0.5 * (velocity_gradient + velocity_gradient.transpose());
@@ -116,4 +124,8 @@ Real J2Plasticity::HardeningFactorRate(const Matd &shear_stress, Real &hardening
     Real f = sqrt(2.0 * stress_tensor_J2) - sqrt_2_over_3_ * (hardening_modulus_ * hardening_factor + yield_stress_);
     return (f > TinyReal) ? 0.5 * f / (G_ + hardening_modulus_ / 3.0) : 0.0;
 }
+//=================================================================================================//
+J2Plasticity::ConstituteKernel::ConstituteKernel(J2Plasticity &encloser)
+    : GeneralContinuum::ConstituteKernel(encloser), yield_stress_(encloser.yield_stress_),
+      hardening_modulus_(encloser.hardening_modulus_), sqrt_2_over_3_(encloser.sqrt_2_over_3_) {}
 } // namespace SPH
\ No newline at end of file
@@ -67,6 +67,23 @@ class GeneralContinuum : public WeaklyCompressibleFluid
     virtual Matd ConstitutiveRelationShearStress(Matd &velocity_gradient, Matd &shear_stress);
 
     virtual GeneralContinuum *ThisObjectPtr() override { return this; };
+
+    class ConstituteKernel
+    {
+      public:
+        ConstituteKernel(GeneralContinuum &encloser);
+
+        Matd ShearStressRate(const Matd &velocity_gradient, const Matd &shear_stress)
+        {
+            Matd strain_rate = 0.5 * (velocity_gradient + velocity_gradient.transpose());
+            Matd spin_rate = 0.5 * (velocity_gradient - velocity_gradient.transpose());
+            Matd deviatoric_strain_rate = strain_rate - (1.0 / (Real)Dimensions) * strain_rate.trace() * Matd::Identity();
+            return 2.0 * G_ * deviatoric_strain_rate + shear_stress * (spin_rate.transpose()) + spin_rate * shear_stress;
+        };
+
+      protected:
+        Real G_;
+    };
 };
 
 class PlasticContinuum : public GeneralContinuum
@@ -97,6 +114,54 @@ class PlasticContinuum : public GeneralContinuum
     virtual Mat3d ReturnMapping(Mat3d &stress_tensor);
 
     virtual GeneralContinuum *ThisObjectPtr() override { return this; };
+
+    class ConstituteKernel : public GeneralContinuum::ConstituteKernel
+    {
+      public:
+        ConstituteKernel(PlasticContinuum &encloser);
+
+        Mat3d StressRate(const Mat3d &velocity_gradient, const Mat3d &stress_tensor)
+        {
+            Mat3d strain_rate = 0.5 * (velocity_gradient + velocity_gradient.transpose());
+            Mat3d spin_rate = 0.5 * (velocity_gradient - velocity_gradient.transpose());
+            Mat3d deviatoric_strain_rate = strain_rate - (1.0 / stress_dimension_) * strain_rate.trace() * Mat3d::Identity();
+            Mat3d stress_rate_elastic = 2.0 * G_ * deviatoric_strain_rate + K_ * strain_rate.trace() * Mat3d::Identity() +
+                                        stress_tensor * (spin_rate.transpose()) + spin_rate * stress_tensor;
+            Mat3d deviatoric_stress_tensor = stress_tensor - (1.0 / stress_dimension_) * stress_tensor.trace() * Mat3d::Identity();
+            Real stress_tensor_J2 = 0.5 * (deviatoric_stress_tensor.cwiseProduct(deviatoric_stress_tensor.transpose())).sum();
+            Real f = sqrt(stress_tensor_J2) + alpha_phi_ * stress_tensor.trace() - k_c_;
+            if (f >= TinyReal)
+            {
+                Real deviatoric_stress_times_strain_rate = (deviatoric_stress_tensor.cwiseProduct(strain_rate)).sum();
+                // non-associate flow rule
+                Real lambda_dot = (3.0 * alpha_phi_ * K_ * strain_rate.trace() +
+                                   (G_ / sqrt(stress_tensor_J2)) * deviatoric_stress_times_strain_rate) /
+                                  (9.0 * alpha_phi_ * K_ * alpha_psi_ + G_);
+                stress_rate_elastic -= lambda_dot * (3.0 * K_ * alpha_psi_ * Mat3d::Identity() +
+                                                     G_ * deviatoric_stress_tensor / (sqrt(stress_tensor_J2)));
+            }
+            return stress_rate_elastic;
+        };
+
+        Mat3d ReturnMapping(Mat3d stress_tensor)
+        {
+            Real stress_tensor_I1 = stress_tensor.trace();
+            if (-alpha_phi_ * stress_tensor_I1 + k_c_ < 0)
+                stress_tensor -= (1.0 / stress_dimension_) * (stress_tensor_I1 - k_c_ / alpha_phi_) * Mat3d::Identity();
+            stress_tensor_I1 = stress_tensor.trace();
+            Mat3d deviatoric_stress_tensor = stress_tensor - (1.0 / stress_dimension_) * stress_tensor.trace() * Mat3d::Identity();
+            Real stress_tensor_J2 = 0.5 * (deviatoric_stress_tensor.cwiseProduct(deviatoric_stress_tensor.transpose())).sum();
+            if (-alpha_phi_ * stress_tensor_I1 + k_c_ < sqrt(stress_tensor_J2))
+            {
+                Real r = (-alpha_phi_ * stress_tensor_I1 + k_c_) / (sqrt(stress_tensor_J2) + TinyReal);
+                stress_tensor = r * deviatoric_stress_tensor + (1.0 / stress_dimension_) * stress_tensor_I1 * Mat3d::Identity();
+            }
+            return stress_tensor;
+        };
+
+      protected:
+        Real K_, alpha_phi_, alpha_psi_, k_c_, stress_dimension_;
+    };
 };
 
 class J2Plasticity : public GeneralContinuum
@@ -123,6 +188,57 @@ class J2Plasticity : public GeneralContinuum
     virtual Real ScalePenaltyForce(Matd &shear_stress, Real &hardening_factor);
     virtual Real HardeningFactorRate(const Matd &shear_stress, Real &hardening_factor);
     virtual J2Plasticity *ThisObjectPtr() override { return this; };
+
+    class ConstituteKernel : public GeneralContinuum::ConstituteKernel
+    {
+      public:
+        ConstituteKernel(J2Plasticity &encloser);
+
+        Matd ShearStressRate(const Matd &velocity_gradient, const Matd &shear_stress, Real hardening_factor)
+        {
+            Matd strain_rate = 0.5 * (velocity_gradient + velocity_gradient.transpose());
+            Matd deviatoric_strain_rate = strain_rate - (1.0 / (Real)Dimensions) * strain_rate.trace() * Matd::Identity();
+            Matd shear_stress_rate_elastic = 2.0 * G_ * deviatoric_strain_rate;
+            Real stress_tensor_J2 = 0.5 * (shear_stress.cwiseProduct(shear_stress.transpose())).sum();
+            Real f = sqrt(2.0 * stress_tensor_J2) - YieldRadius(hardening_factor);
+            if (f > TinyReal)
+            {
+                Real deviatoric_stress_times_strain_rate = (shear_stress.cwiseProduct(strain_rate)).sum();
+                Real lambda_dot = deviatoric_stress_times_strain_rate /
+                                  (sqrt(2.0 * stress_tensor_J2) * (1.0 + hardening_modulus_ / (3.0 * G_)));
+                shear_stress_rate_elastic -= lambda_dot * (sqrt(2.0) * G_ * shear_stress / (sqrt(stress_tensor_J2)));
+            }
+            return shear_stress_rate_elastic;
+        };
+
+        /** the ratio of the yield radius to the trial stress radius, one within the yield surface */
+        Real ScalePenaltyForce(const Matd &shear_stress, Real hardening_factor)
+        {
+            Real stress_tensor_J2 = 0.5 * (shear_stress.cwiseProduct(shear_stress.transpose())).sum();
+            Real f = sqrt(2.0 * stress_tensor_J2) - YieldRadius(hardening_factor);
+            return f > TinyReal ? YieldRadius(hardening_factor) / (sqrt(2.0 * stress_tensor_J2) + TinyReal) : Real(1);
+        };
+
+        Matd ReturnMappingShearStress(const Matd &shear_stress, Real hardening_factor)
+        {
+            return ScalePenaltyForce(shear_stress, hardening_factor) * shear_stress;
+        };
+
+        Real HardeningFactorRate(const Matd &shear_stress, Real hardening_factor)
+        {
+            Real stress_tensor_J2 = 0.5 * (shear_stress.cwiseProduct(shear_stress.transpose())).sum();
+            Real f = sqrt(2.0 * stress_tensor_J2) - YieldRadius(hardening_factor);
+            return f > TinyReal ? 0.5 * f / (G_ + hardening_modulus_ / 3.0) : Real(0);
+        };
+
+      protected:
+        Real yield_stress_, hardening_modulus_, sqrt_2_over_3_;
+
+        Real YieldRadius(Real hardening_factor)
+        {
+            return sqrt_2_over_3_ * (hardening_modulus_ * hardening_factor + yield_stress_);
+        };
+    };
 };
 } // namespace SPH
 #endif // GENERAL_CONTINUUM_H
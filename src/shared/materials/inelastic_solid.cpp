@@ -4,6 +4,15 @@
 namespace SPH
 {
 //=================================================================================================//
+void PlasticSolid::ElasticLeftCauchyBatch(const Matd *deformation, size_t index_begin, size_t lanes,
+                                          Matd *normalized_be, Real dt)
+{
+    for (size_t l = 0; l != lanes; ++l)
+    {
+        normalized_be[l] = ElasticLeftCauchy(deformation[l], index_begin + l, dt);
+    }
+}
+//=================================================================================================//
 void HardeningPlasticSolid::initializeLocalParameters(BaseParticles *base_particles)
 {
     PlasticSolid::initializeLocalParameters(base_particles);
@@ -18,63 +27,121 @@ void HardeningPlasticSolid::initializeLocalParameters(BaseParticles *base_partic
 //=================================================================================================//
 Matd HardeningPlasticSolid::ElasticLeftCauchy(const Matd &F, size_t index_i, Real dt)
 {
-    Matd be = F * inverse_plastic_strain_[index_i] * F.transpose();
-    Matd normalized_be = be * pow(be.determinant(), -OneOverDimensions);
-    Real normalized_be_isentropic = normalized_be.trace() * OneOverDimensions;
-    Matd deviatoric_Kirchhoff = DeviatoricKirchhoff(normalized_be - normalized_be_isentropic * Matd::Identity());
-    Real deviatoric_Kirchhoff_norm = deviatoric_Kirchhoff.norm();
-    Real trial_function = deviatoric_Kirchhoff_norm -
-                          sqrt_2_over_3_ * (hardening_modulus_ * hardening_parameter_[index_i] + yield_stress_);
-    if (trial_function > 0.0)
+    Matd normalized_be;
+    ElasticLeftCauchyBatch(&F, index_i, 1, &normalized_be, dt);
+    return normalized_be;
+}
+//=================================================================================================//
+void HardeningPlasticSolid::ElasticLeftCauchyBatch(const Matd *F, size_t index_begin, size_t lanes,
+                                                   Matd *normalized_be, Real dt)
+{
+    Real normalized_be_isentropic[PlasticBatchSize], deviatoric_Kirchhoff_norm[PlasticBatchSize];
+    Real trial_function[PlasticBatchSize], relax_increment[PlasticBatchSize];
+    Matd deviatoric_Kirchhoff[PlasticBatchSize];
+    // trial elastic state
+    for (size_t l = 0; l != lanes; ++l)
     {
-        Real renormalized_shear_modulus = normalized_be_isentropic * G0_;
-        Real relax_increment = 0.5 * trial_function / (renormalized_shear_modulus + hardening_modulus_ / 3.0);
-        hardening_parameter_[index_i] += sqrt_2_over_3_ * relax_increment;
-        deviatoric_Kirchhoff -= 2.0 * renormalized_shear_modulus * relax_increment * deviatoric_Kirchhoff / deviatoric_Kirchhoff_norm;
-        Matd relaxed_be = deviatoric_Kirchhoff / G0_ + normalized_be_isentropic * Matd::Identity();
-        normalized_be = relaxed_be * pow(relaxed_be.determinant(), -OneOverDimensions);
+        size_t index_i = index_begin + l;
+        Matd be = F[l] * inverse_plastic_strain_[index_i] * F[l].transpose();
+        normalized_be[l] = be * pow(be.determinant(), -OneOverDimensions);
+        normalized_be_isentropic[l] = normalized_be[l].trace() * OneOverDimensions;
+        deviatoric_Kirchhoff[l] = DeviatoricKirchhoff(normalized_be[l] - normalized_be_isentropic[l] * Matd::Identity());
+        deviatoric_Kirchhoff_norm[l] = deviatoric_Kirchhoff[l].norm();
+        trial_function[l] = deviatoric_Kirchhoff_norm[l] -
+                            sqrt_2_over_3_ * (hardening_modulus_ * hardening_parameter_[index_i] + yield_stress_);
+    }
+    // radial return in closed form without branching, zero increment for elastic lanes
+    for (size_t l = 0; l != lanes; ++l)
+    {
+        Real renormalized_shear_modulus = normalized_be_isentropic[l] * G0_;
+        relax_increment[l] = 0.5 * SMAX(trial_function[l], Real(0)) /
+                             (renormalized_shear_modulus + hardening_modulus_ / 3.0);
+        hardening_parameter_[index_begin + l] += sqrt_2_over_3_ * relax_increment[l];
+    }
+    // relaxed state for all lanes, masked select keeps the trial state of elastic lanes
+    for (size_t l = 0; l != lanes; ++l)
+    {
+        size_t index_i = index_begin + l;
+        Real renormalized_shear_modulus = normalized_be_isentropic[l] * G0_;
+        Matd relaxed_deviatoric_Kirchhoff =
+            deviatoric_Kirchhoff[l] - 2.0 * renormalized_shear_modulus * relax_increment[l] *
+                                          deviatoric_Kirchhoff[l] / SMAX(deviatoric_Kirchhoff_norm[l], TinyReal);
+        Real plastic_mask = Real(trial_function[l] > 0.0);
+        normalized_be[l] = plastic_mask * RelaxedLeftCauchy(relaxed_deviatoric_Kirchhoff, normalized_be_isentropic[l]) +
+                           (1.0 - plastic_mask) * normalized_be[l];
+        Matd inverse_F = F[l].inverse();
+        inverse_plastic_strain_[index_i] = inverse_F * normalized_be[l] * inverse_F.transpose();
     }
-    Matd inverse_F = F.inverse();
-    Matd inverse_F_T = inverse_F.transpose();
-    inverse_plastic_strain_[index_i] = inverse_F * normalized_be * inverse_F_T;
-
-    return normalized_be;
 }
 //=================================================================================================//
 Matd NonLinearHardeningPlasticSolid::ElasticLeftCauchy(const Matd &F, size_t index_i, Real dt)
 {
-    Matd normalized_F = F * pow(F.determinant(), -OneOverDimensions);
-    Matd normalized_be = normalized_F * inverse_plastic_strain_[index_i] * normalized_F.transpose();
-    Real normalized_be_isentropic = normalized_be.trace() * OneOverDimensions;
-    Matd deviatoric_Kirchhoff = DeviatoricKirchhoff(normalized_be - normalized_be_isentropic * Matd::Identity());
-    Real deviatoric_Kirchhoff_norm = deviatoric_Kirchhoff.norm();
-
-    Real relax_increment = 0.0;
-    Real trial_function = deviatoric_Kirchhoff_norm - sqrt_2_over_3_ * NonlinearHardening(hardening_parameter_[index_i]);
-    if (trial_function > 0.0)
+    Matd normalized_be;
+    ElasticLeftCauchyBatch(&F, index_i, 1, &normalized_be, dt);
+    return normalized_be;
+}
+//=================================================================================================//
+void NonLinearHardeningPlasticSolid::ElasticLeftCauchyBatch(const Matd *F, size_t index_begin, size_t lanes,
+                                                            Matd *normalized_be, Real dt)
+{
+    Real normalized_be_isentropic[PlasticBatchSize], deviatoric_Kirchhoff_norm[PlasticBatchSize];
+    Real trial_function[PlasticBatchSize], relax_increment[PlasticBatchSize];
+    bool is_yielding[PlasticBatchSize], is_active[PlasticBatchSize];
+    Matd normalized_F[PlasticBatchSize], deviatoric_Kirchhoff[PlasticBatchSize];
+    // trial elastic state
+    size_t active_lanes = 0;
+    for (size_t l = 0; l != lanes; ++l)
+    {
+        size_t index_i = index_begin + l;
+        normalized_F[l] = F[l] * pow(F[l].determinant(), -OneOverDimensions);
+        normalized_be[l] = normalized_F[l] * inverse_plastic_strain_[index_i] * normalized_F[l].transpose();
+        normalized_be_isentropic[l] = normalized_be[l].trace() * OneOverDimensions;
+        deviatoric_Kirchhoff[l] = DeviatoricKirchhoff(normalized_be[l] - normalized_be_isentropic[l] * Matd::Identity());
+        deviatoric_Kirchhoff_norm[l] = deviatoric_Kirchhoff[l].norm();
+        relax_increment[l] = 0.0;
+        trial_function[l] = deviatoric_Kirchhoff_norm[l] - sqrt_2_over_3_ * NonlinearHardening(hardening_parameter_[index_i]);
+        is_yielding[l] = trial_function[l] > 0.0;
+        is_active[l] = is_yielding[l];
+        active_lanes += is_active[l];
+    }
+    // Newton iterations masked per lane until all yielding lanes return to the yield surface
+    while (active_lanes != 0)
     {
-        Real renormalized_shear_modulus = normalized_be_isentropic * G0_;
-        while (trial_function > 0.0)
+        active_lanes = 0;
+        for (size_t l = 0; l != lanes; ++l)
         {
-            Real function_relax_increment_derivative = -2.0 * renormalized_shear_modulus *
-                                                       (1.0 + NonlinearHardeningDerivative(hardening_parameter_[index_i] + sqrt_2_over_3_ * relax_increment) /
-                                                                  3.0 / renormalized_shear_modulus);
-            relax_increment -= trial_function / function_relax_increment_derivative;
+            if (!is_active[l])
+                continue;
+
+            Real renormalized_shear_modulus = normalized_be_isentropic[l] * G0_;
+            Real hardening_parameter = hardening_parameter_[index_begin + l];
+            Real function_relax_increment_derivative =
+                -2.0 * renormalized_shear_modulus *
+                (1.0 + NonlinearHardeningDerivative(hardening_parameter + sqrt_2_over_3_ * relax_increment[l]) /
+                           3.0 / renormalized_shear_modulus);
+            relax_increment[l] -= trial_function[l] / function_relax_increment_derivative;
 
-            trial_function = deviatoric_Kirchhoff_norm - sqrt_2_over_3_ * NonlinearHardening(hardening_parameter_[index_i] + sqrt_2_over_3_ * relax_increment) -
-                             2.0 * renormalized_shear_modulus * relax_increment;
+            trial_function[l] = deviatoric_Kirchhoff_norm[l] -
+                                sqrt_2_over_3_ * NonlinearHardening(hardening_parameter + sqrt_2_over_3_ * relax_increment[l]) -
+                                2.0 * renormalized_shear_modulus * relax_increment[l];
+            is_active[l] = trial_function[l] > 0.0;
+            active_lanes += is_active[l];
         }
-        hardening_parameter_[index_i] += sqrt_2_over_3_ * relax_increment;
-        deviatoric_Kirchhoff -= 2.0 * renormalized_shear_modulus * relax_increment * deviatoric_Kirchhoff / deviatoric_Kirchhoff_norm;
-        Matd relaxed_be = deviatoric_Kirchhoff / G0_ + normalized_be_isentropic * Matd::Identity();
-        normalized_be = relaxed_be * pow(relaxed_be.determinant(), -OneOverDimensions);
     }
-
-    Matd inverse_normalized_F = normalized_F.inverse();
-    Matd inverse_normalized_F_T = inverse_normalized_F.transpose();
-    inverse_plastic_strain_[index_i] = inverse_normalized_F * normalized_be * inverse_normalized_F_T;
-
-    return normalized_be;
+    for (size_t l = 0; l != lanes; ++l)
+    {
+        size_t index_i = index_begin + l;
+        if (is_yielding[l])
+        {
+            Real renormalized_shear_modulus = normalized_be_isentropic[l] * G0_;
+            hardening_parameter_[index_i] += sqrt_2_over_3_ * relax_increment[l];
+            deviatoric_Kirchhoff[l] -= 2.0 * renormalized_shear_modulus * relax_increment[l] *
+                                       deviatoric_Kirchhoff[l] / deviatoric_Kirchhoff_norm[l];
+            normalized_be[l] = RelaxedLeftCauchy(deviatoric_Kirchhoff[l], normalized_be_isentropic[l]);
+        }
+        Matd inverse_normalized_F = normalized_F[l].inverse();
+        inverse_plastic_strain_[index_i] = inverse_normalized_F * normalized_be[l] * inverse_normalized_F.transpose();
+    }
 }
 //=================================================================================================//
 void ViscousPlasticSolid::initializeLocalParameters(BaseParticles *base_particles)
@@ -89,47 +156,76 @@ void ViscousPlasticSolid::initializeLocalParameters(BaseParticles *base_particle
 //=================================================================================================//
 Matd ViscousPlasticSolid::ElasticLeftCauchy(const Matd &F, size_t index_i, Real dt)
 {
-    Matd be = F * inverse_plastic_strain_[index_i] * F.transpose();
-    Matd normalized_be = be * pow(be.determinant(), -OneOverDimensions);
-    Real normalized_be_isentropic = normalized_be.trace() * OneOverDimensions;
-    Matd deviatoric_Kirchhoff = DeviatoricKirchhoff(normalized_be - normalized_be_isentropic * Matd::Identity());
-    Real deviatoric_Kirchhoff_norm = deviatoric_Kirchhoff.norm();
-    Real trial_function = deviatoric_Kirchhoff_norm - sqrt_2_over_3_ * yield_stress_;
-    if (trial_function > 0.0)
+    Matd normalized_be;
+    ElasticLeftCauchyBatch(&F, index_i, 1, &normalized_be, dt);
+    return normalized_be;
+}
+//=================================================================================================//
+void ViscousPlasticSolid::ElasticLeftCauchyBatch(const Matd *F, size_t index_begin, size_t lanes,
+                                                 Matd *normalized_be, Real dt)
+{
+    Real normalized_be_isentropic[PlasticBatchSize], deviatoric_Kirchhoff_norm[PlasticBatchSize];
+    Real deviatoric_Kirchhoff_norm_Mid[PlasticBatchSize], deviatoric_Kirchhoff_norm_Max[PlasticBatchSize];
+    Real deviatoric_Kirchhoff_norm_Min[PlasticBatchSize];
+    bool is_yielding[PlasticBatchSize], is_active[PlasticBatchSize];
+    Matd deviatoric_Kirchhoff[PlasticBatchSize];
+    const Real yield_norm = sqrt_2_over_3_ * yield_stress_;
+    // trial elastic state
+    size_t active_lanes = 0;
+    for (size_t l = 0; l != lanes; ++l)
+    {
+        size_t index_i = index_begin + l;
+        Matd be = F[l] * inverse_plastic_strain_[index_i] * F[l].transpose();
+        normalized_be[l] = be * pow(be.determinant(), -OneOverDimensions);
+        normalized_be_isentropic[l] = normalized_be[l].trace() * OneOverDimensions;
+        deviatoric_Kirchhoff[l] = DeviatoricKirchhoff(normalized_be[l] - normalized_be_isentropic[l] * Matd::Identity());
+        deviatoric_Kirchhoff_norm[l] = deviatoric_Kirchhoff[l].norm();
+        deviatoric_Kirchhoff_norm_Mid[l] = 0.0;
+        deviatoric_Kirchhoff_norm_Max[l] = deviatoric_Kirchhoff_norm[l];
+        deviatoric_Kirchhoff_norm_Min[l] = yield_norm;
+        is_yielding[l] = deviatoric_Kirchhoff_norm[l] - yield_norm > 0.0;
+        is_active[l] = is_yielding[l];
+        active_lanes += is_active[l];
+    }
+    // bisection masked per lane until all yielding lanes reach the precision
+    const Real Precision = 1.0e-6;
+    const Real viscous_factor = pow(viscous_modulus_, 1.0 / Herschel_Bulkley_power_);
+    while (active_lanes != 0)
     {
-        Real renormalized_shear_modulus = normalized_be_isentropic * G0_;
-        Real deviatoric_Kirchhoff_norm_Mid = 0.0;
-        Real deviatoric_Kirchhoff_norm_Max = deviatoric_Kirchhoff_norm;
-        Real deviatoric_Kirchhoff_norm_Min = sqrt_2_over_3_ * yield_stress_;
-        Real predicted_func = 0.0;
-        Real Precision = 1.0e-6;
-        Real Relative_Error;
-        do
+        active_lanes = 0;
+        for (size_t l = 0; l != lanes; ++l)
         {
-            deviatoric_Kirchhoff_norm_Mid = (deviatoric_Kirchhoff_norm_Max + deviatoric_Kirchhoff_norm_Min) / 2.0;
-            predicted_func = pow(viscous_modulus_, 1.0 / Herschel_Bulkley_power_) * (deviatoric_Kirchhoff_norm_Mid - deviatoric_Kirchhoff_norm) +
-                             2.0 * renormalized_shear_modulus * dt * pow((deviatoric_Kirchhoff_norm_Mid - sqrt_2_over_3_ * yield_stress_), 1.0 / Herschel_Bulkley_power_);
+            if (!is_active[l])
+                continue;
+
+            Real renormalized_shear_modulus = normalized_be_isentropic[l] * G0_;
+            deviatoric_Kirchhoff_norm_Mid[l] = (deviatoric_Kirchhoff_norm_Max[l] + deviatoric_Kirchhoff_norm_Min[l]) / 2.0;
+            Real predicted_func = viscous_factor * (deviatoric_Kirchhoff_norm_Mid[l] - deviatoric_Kirchhoff_norm[l]) +
+                                  2.0 * renormalized_shear_modulus * dt *
+                                      pow((deviatoric_Kirchhoff_norm_Mid[l] - yield_norm), 1.0 / Herschel_Bulkley_power_);
             if (predicted_func < 0.0)
             {
-                deviatoric_Kirchhoff_norm_Min = deviatoric_Kirchhoff_norm_Mid;
+                deviatoric_Kirchhoff_norm_Min[l] = deviatoric_Kirchhoff_norm_Mid[l];
             }
             else
             {
-                deviatoric_Kirchhoff_norm_Max = deviatoric_Kirchhoff_norm_Mid;
+                deviatoric_Kirchhoff_norm_Max[l] = deviatoric_Kirchhoff_norm_Mid[l];
             }
-            Relative_Error = predicted_func / deviatoric_Kirchhoff_norm;
-        } while (fabs(Relative_Error) >= Precision);
-
-        deviatoric_Kirchhoff = deviatoric_Kirchhoff_norm_Mid * deviatoric_Kirchhoff / deviatoric_Kirchhoff_norm;
-        Matd relaxed_be = deviatoric_Kirchhoff / G0_ + normalized_be_isentropic * Matd::Identity();
-        normalized_be = relaxed_be * pow(relaxed_be.determinant(), -OneOverDimensions);
+            is_active[l] = fabs(predicted_func / deviatoric_Kirchhoff_norm[l]) >= Precision;
+            active_lanes += is_active[l];
+        }
     }
-
-    Matd inverse_F = F.inverse();
-    Matd inverse_F_T = inverse_F.transpose();
-    inverse_plastic_strain_[index_i] = inverse_F * normalized_be * inverse_F_T;
-
-    return normalized_be;
-};
+    for (size_t l = 0; l != lanes; ++l)
+    {
+        size_t index_i = index_begin + l;
+        if (is_yielding[l])
+        {
+            deviatoric_Kirchhoff[l] = deviatoric_Kirchhoff_norm_Mid[l] * deviatoric_Kirchhoff[l] / deviatoric_Kirchhoff_norm[l];
+            normalized_be[l] = RelaxedLeftCauchy(deviatoric_Kirchhoff[l], normalized_be_isentropic[l]);
+        }
+        Matd inverse_F = F[l].inverse();
+        inverse_plastic_strain_[index_i] = inverse_F * normalized_be[l] * inverse_F.transpose();
+    }
+}
 //=================================================================================================//
 } // namespace SPH
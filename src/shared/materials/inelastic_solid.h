@@ -32,6 +32,9 @@
 
 namespace SPH
 {
+/** number of particles of which the return mapping is carried out together */
+constexpr size_t PlasticBatchSize = 8;
+
 /**
  * @class PlasticSolid
  * @brief Abstract class for a generalized plastic solid
@@ -53,8 +56,19 @@ class PlasticSolid : public NeoHookeanSolid
     Real YieldStress() { return yield_stress_; };
     /** compute the elastic part of normalized left Cauchy-Green deformation gradient tensor. */
     virtual Matd ElasticLeftCauchy(const Matd &deformation, size_t index_i, Real dt = 0.0) = 0;
+    /** the same for the batch of particles from index_begin, the default is particle by particle. */
+    virtual void ElasticLeftCauchyBatch(const Matd *deformation, size_t index_begin, size_t lanes,
+                                        Matd *normalized_be, Real dt = 0.0);
 
     virtual PlasticSolid *ThisObjectPtr() override { return this; };
+
+  protected:
+    /** normalized elastic left Cauchy-Green tensor from the relaxed deviatoric Kirchhoff stress */
+    Matd RelaxedLeftCauchy(const Matd &deviatoric_Kirchhoff, Real normalized_be_isentropic)
+    {
+        Matd relaxed_be = deviatoric_Kirchhoff / G0_ + normalized_be_isentropic * Matd::Identity();
+        return relaxed_be * pow(relaxed_be.determinant(), -OneOverDimensions);
+    };
 };
 
 /**
@@ -83,6 +97,8 @@ class HardeningPlasticSolid : public PlasticSolid
     Real HardeningModulus() { return hardening_modulus_; };
     /** compute the elastic part of normalized left Cauchy-Green deformation gradient tensor. */
     virtual Matd ElasticLeftCauchy(const Matd &deformation, size_t index_i, Real dt = 0.0) override;
+    virtual void ElasticLeftCauchyBatch(const Matd *deformation, size_t index_begin, size_t lanes,
+                                        Matd *normalized_be, Real dt = 0.0) override;
 
     virtual HardeningPlasticSolid *ThisObjectPtr() override { return this; };
 };
@@ -118,6 +134,8 @@ class NonLinearHardeningPlasticSolid : public HardeningPlasticSolid
     };
     /** compute the elastic part of normalized left Cauchy-Green deformation gradient tensor. */
     virtual Matd ElasticLeftCauchy(const Matd &deformation, size_t index_i, Real dt = 0.0) override;
+    virtual void ElasticLeftCauchyBatch(const Matd *deformation, size_t index_begin, size_t lanes,
+                                        Matd *normalized_be, Real dt = 0.0) override;
 
     virtual NonLinearHardeningPlasticSolid *ThisObjectPtr() override { return this; };
 };
@@ -147,6 +165,8 @@ class ViscousPlasticSolid : public PlasticSolid
     Real ViscousModulus() { return viscous_modulus_; };
     /** compute the elastic part of normalized left Cauchy-Green deformation gradient tensor. */
     virtual Matd ElasticLeftCauchy(const Matd &deformation, size_t index_i, Real dt = 0.0) override;
+    virtual void ElasticLeftCauchyBatch(const Matd *deformation, size_t index_begin, size_t lanes,
+                                        Matd *normalized_be, Real dt = 0.0) override;
 
     virtual ViscousPlasticSolid *ThisObjectPtr() override { return this; };
 };
@@ -68,6 +68,18 @@ class PorousMediaSolid : public LinearElasticSolid
     };
 
     virtual ~PorousMediaSolid(){};
+
+    class ConstituteKernel : public LinearElasticSolid::ConstituteKernel
+    {
+      public:
+        ConstituteKernel(PorousMediaSolid &encloser)
+            : LinearElasticSolid::ConstituteKernel(encloser){};
+
+        Matd StressCauchy(const Matd &almansi_strain, size_t index_i)
+        {
+            return lambda0_ * almansi_strain.trace() * Matd::Identity() + 2.0 * G0_ * almansi_strain;
+        };
+    };
 };
 
 } // namespace multi_species_continuum
@@ -48,6 +48,22 @@ struct FluidStateOut
     FluidStateOut(Real rho, Vecd vel, Real p) : vel_(vel), rho_(rho), p_(p){};
 };
 
+/**
+ * @struct RiemannPairBlock
+ * @brief States of a block of particle pairs in structure-of-arrays form,
+ * so that the Riemann problems of several neighbors are solved in one call.
+ * Only the states projected on the pair directions are needed.
+ * The interface velocity is the average velocity corrected by -e_ij * u_dissipative_.
+ */
+struct RiemannPairBlock
+{
+    static constexpr size_t capacity_ = 16;
+    size_t size_ = 0;
+    Real p_i_[capacity_], p_j_[capacity_];
+    Real ul_[capacity_], ur_[capacity_]; /**< velocities projected on -e_ij */
+    Real p_star_[capacity_], u_dissipative_[capacity_];
+};
+
 /**
  * @struct NoRiemannSolver
  * @brief  Central difference scheme without Riemann flux.
@@ -72,6 +88,14 @@ class NoRiemannSolver
 
     Vecd AverageV(const Vecd &vel_i, const Vecd &vel_j);
     FluidStateOut InterfaceState(const FluidStateIn &state_i, const FluidStateIn &state_j, const Vecd &e_ij);
+    void InterfaceStates(RiemannPairBlock &block)
+    {
+        for (size_t k = 0; k != block.size_; ++k)
+        {
+            block.p_star_[k] = 0.5 * (block.p_i_[k] + block.p_j_[k]);
+            block.u_dissipative_[k] = 0.0;
+        }
+    };
 
   protected:
     Real rho0_i_, rho0_j_;
@@ -114,6 +138,20 @@ class BaseAcousticRiemannSolver : public NoRiemannSolver
         return FluidStateOut(average_state.rho_, vel_star, p_star);
     };
 
+    /** same as the pairwise interface state, the limiter is free of branches */
+    void InterfaceStates(RiemannPairBlock &block)
+    {
+        for (size_t k = 0; k != block.size_; ++k)
+        {
+            Real u_jump = block.ul_[k] - block.ur_[k];
+            Real limited_mach_number = limiter_(SMAX(u_jump, Real(0)));
+            block.p_star_[k] = 0.5 * (block.p_i_[k] + block.p_j_[k]) +
+                               0.5 * rho0c0_geo_ave_ * u_jump * limited_mach_number;
+            block.u_dissipative_[k] = 0.5 * (block.p_i_[k] - block.p_j_[k]) * inv_rho0c0_ave_ *
+                                      limited_mach_number * limited_mach_number;
+        }
+    };
+
   protected:
     Real inv_rho0c0_ave_, rho0c0_geo_ave_;
     LimiterType limiter_;
@@ -44,6 +44,13 @@ Real SymmetricTaitFluid::getSoundSpeed(Real p, Real rho)
                : sqrt((p0_ - Real(gamma_) * p) / rho);
 }
 //=================================================================================================//
+GeneralizedNewtonianFluid::ViscosityKernel::ViscosityKernel(GeneralizedNewtonianFluid &encloser)
+    : min_shear_rate_(encloser.min_shear_rate_), max_shear_rate_(encloser.max_shear_rate_) {}
+//=================================================================================================//
+HerschelBulkleyFluid::ViscosityKernel::ViscosityKernel(HerschelBulkleyFluid &encloser)
+    : GeneralizedNewtonianFluid::ViscosityKernel(encloser), consistency_index_(encloser.consistency_index_),
+      power_index_(encloser.power_index_), yield_stress_(encloser.yield_stress_) {}
+//=================================================================================================//
 Real HerschelBulkleyFluid::getViscosity(Real shear_rate)
 {
 
@@ -52,6 +59,10 @@ Real HerschelBulkleyFluid::getViscosity(Real shear_rate)
            effective_shear_rate;
 }
 //=================================================================================================//
+CarreauFluid::ViscosityKernel::ViscosityKernel(CarreauFluid &encloser)
+    : GeneralizedNewtonianFluid::ViscosityKernel(encloser), characteristic_time_(encloser.characteristic_time_),
+      mu_infty_(encloser.mu_infty_), mu0_(encloser.mu0_), power_index_(encloser.power_index_) {}
+//=================================================================================================//
 Real CarreauFluid::getViscosity(Real shear_rate)
 {
     Real effective_shear_rate = SMAX(SMIN(shear_rate, max_shear_rate_), min_shear_rate_);
@@ -173,6 +173,21 @@ class GeneralizedNewtonianFluid : public WeaklyCompressibleFluid
 
     Real getMinShearRate() { return min_shear_rate_; };
     Real getMaxShearRate() { return max_shear_rate_; };
+
+    /** Statically dispatched viscosity laws, see the derived materials. */
+    class ViscosityKernel
+    {
+      public:
+        ViscosityKernel(GeneralizedNewtonianFluid &encloser);
+
+        Real EffectiveShearRate(Real shear_rate)
+        {
+            return SMAX(SMIN(shear_rate, max_shear_rate_), min_shear_rate_);
+        };
+
+      protected:
+        Real min_shear_rate_, max_shear_rate_;
+    };
 };
 
 /**
@@ -202,6 +217,22 @@ class HerschelBulkleyFluid : public GeneralizedNewtonianFluid
 
     Real getViscosity(Real shear_rate) override;
     virtual HerschelBulkleyFluid *ThisObjectPtr() override { return this; };
+
+    class ViscosityKernel : public GeneralizedNewtonianFluid::ViscosityKernel
+    {
+      public:
+        ViscosityKernel(HerschelBulkleyFluid &encloser);
+
+        Real getViscosity(Real shear_rate)
+        {
+            Real effective_shear_rate = EffectiveShearRate(shear_rate);
+            return (yield_stress_ + consistency_index_ * std::pow(effective_shear_rate, power_index_)) /
+                   effective_shear_rate;
+        };
+
+      protected:
+        Real consistency_index_, power_index_, yield_stress_;
+    };
 };
 
 /**
@@ -234,6 +265,23 @@ class CarreauFluid : public GeneralizedNewtonianFluid
 
     Real getViscosity(Real shear_rate) override;
     virtual CarreauFluid *ThisObjectPtr() override { return this; };
+
+    class ViscosityKernel : public GeneralizedNewtonianFluid::ViscosityKernel
+    {
+      public:
+        ViscosityKernel(CarreauFluid &encloser);
+
+        Real getViscosity(Real shear_rate)
+        {
+            Real effective_shear_rate = EffectiveShearRate(shear_rate);
+            return mu_infty_ + (mu0_ - mu_infty_) *
+                                   std::pow(1.0 + std::pow(characteristic_time_ * effective_shear_rate, 2),
+                                            0.5 * (power_index_ - 1.0));
+        };
+
+      protected:
+        Real characteristic_time_, mu_infty_, mu0_, power_index_;
+    };
 };
 } // namespace SPH
 #endif // WEAKLY_COMPRESSIBLE_FLUID_H
\ No newline at end of file
@@ -53,11 +53,9 @@ class RegisterMeshVariable
 class FinishDataPackages : public BaseMeshDynamics
 {
   public:
-    explicit FinishDataPackages(MeshWithGridDataPackages<4> &mesh_data, Shape &shape, Kernel &kernel, Real global_h_ratio)
+    explicit FinishDataPackages(MeshWithGridDataPackagesType &mesh_data, Shape &shape)
         : BaseMeshDynamics(mesh_data),
           shape_(shape),
-          kernel_(kernel),
-          global_h_ratio_(global_h_ratio),
           grid_spacing_(mesh_data.GridSpacing()),
           buffer_width_(mesh_data.BufferWidth()){};
     virtual ~FinishDataPackages(){};
@@ -67,22 +65,24 @@ class FinishDataPackages : public BaseMeshDynamics
 
         mesh_data_.organizeOccupiedPackages();
         initialize_index_mesh.exec();
-        initialize_cell_neighborhood.exec();
         mesh_data_.resizeMeshVariableData();
 
         Real far_field_distance = grid_spacing_ * (Real)buffer_width_;
         initialize_data_for_singular_package.update(0, -far_field_distance);
         initialize_data_for_singular_package.update(1, far_field_distance);
 
-        initialize_basic_data_for_a_package.exec();
+        // both are local to a package, so they are fused into one sweep
+        package_parallel_for(
+            [&](size_t package_index)
+            {
+                initialize_cell_neighborhood.update(package_index);
+                initialize_basic_data_for_a_package.update(package_index);
+            });
         update_level_set_gradient.exec();
-        update_kernel_integrals.exec();
     };
 
   private:
     Shape &shape_;
-    Kernel &kernel_;
-    Real global_h_ratio_;
     Real grid_spacing_;
     size_t buffer_width_;
 
@@ -92,7 +92,6 @@ class FinishDataPackages : public BaseMeshDynamics
     MeshInnerDynamics<InitializeCellNeighborhood> initialize_cell_neighborhood{mesh_data_};
     MeshInnerDynamics<InitializeBasicDataForAPackage> initialize_basic_data_for_a_package{mesh_data_, shape_};
     MeshInnerDynamics<UpdateLevelSetGradient> update_level_set_gradient{mesh_data_};
-    MeshInnerDynamics<UpdateKernelIntegrals> update_kernel_integrals{mesh_data_, kernel_, global_h_ratio_};
 };
 
 class ProbeNormalDirection : public BaseMeshLocalDynamics
@@ -124,10 +123,8 @@ class ProbeNormalDirection : public BaseMeshLocalDynamics
 class CleanInterface : public BaseMeshDynamics
 {
   public:
-    explicit CleanInterface(MeshWithGridDataPackagesType &mesh_data, Kernel &kernel, Real global_h_ratio)
-        : BaseMeshDynamics(mesh_data),
-          kernel_(kernel),
-          global_h_ratio_(global_h_ratio){};
+    explicit CleanInterface(MeshWithGridDataPackagesType &mesh_data)
+        : BaseMeshDynamics(mesh_data){};
     virtual ~CleanInterface(){};
 
     void exec(Real small_shift_factor){
@@ -136,14 +133,10 @@ class CleanInterface : public BaseMeshDynamics
         redistance_interface.exec();
         reinitialize_level_set.exec();
         update_level_set_gradient.exec();
-        update_kernel_integrals.exec();
     }
 
   private:
-    Kernel &kernel_;
-    Real global_h_ratio_;
     MeshInnerDynamics<UpdateLevelSetGradient> update_level_set_gradient{mesh_data_};
-    MeshInnerDynamics<UpdateKernelIntegrals> update_kernel_integrals{mesh_data_, kernel_, global_h_ratio_};
     MeshInnerDynamics<MarkNearInterface> mark_near_interface{mesh_data_};
     MeshCoreDynamics<RedistanceInterface> redistance_interface{mesh_data_};
     MeshInnerDynamics<ReinitializeLevelSet> reinitialize_level_set{mesh_data_};
@@ -152,26 +145,33 @@ class CleanInterface : public BaseMeshDynamics
 class CorrectTopology : public BaseMeshDynamics
 {
   public:
-    explicit CorrectTopology(MeshWithGridDataPackagesType &mesh_data, Kernel &kernel, Real global_h_ratio)
-        : BaseMeshDynamics(mesh_data),
-          kernel_(kernel),
-          global_h_ratio_(global_h_ratio){};
+    explicit CorrectTopology(MeshWithGridDataPackagesType &mesh_data)
+        : BaseMeshDynamics(mesh_data){};
     virtual ~CorrectTopology(){};
 
     void exec(Real small_shift_factor){
         mark_near_interface.setSmallShiftFactor(small_shift_factor);
         mark_near_interface.exec();
-        for (size_t i = 0; i != 10; ++i)
-            diffuse_level_set_sign.exec();
+        // flood fill of the sign, each sweep fills the packages locally and is repeated until no package is changed.
+        // The sweeps are sequential in the package order, as a package reads the signs of its neighbouring packages,
+        // so that the result is deterministic. Each cell is filled at most once,
+        // and the fill front crosses at least one package per sweep, which bounds the number of sweeps.
+        bool is_changed = true;
+        for (size_t sweep = 0; is_changed && sweep != num_grid_pkgs_; ++sweep)
+        {
+            is_changed = false;
+            package_sequential_for(
+                [&](size_t package_index)
+                {
+                    if (diffuse_level_set_sign.update(package_index))
+                        is_changed = true;
+                });
+        }
         update_level_set_gradient.exec();
-        update_kernel_integrals.exec();
     }
 
   private:
-    Kernel &kernel_;
-    Real global_h_ratio_;
     MeshInnerDynamics<UpdateLevelSetGradient> update_level_set_gradient{mesh_data_};
-    MeshInnerDynamics<UpdateKernelIntegrals> update_kernel_integrals{mesh_data_, kernel_, global_h_ratio_};
     MeshInnerDynamics<MarkNearInterface> mark_near_interface{mesh_data_};
     MeshInnerDynamics<DiffuseLevelSetSign> diffuse_level_set_sign{mesh_data_};
 };
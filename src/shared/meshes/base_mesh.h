@@ -37,6 +37,7 @@
 #include "base_data_package.h"
 #include "my_memory_pool.h"
 #include "sphinxsys_containers.h"
+#include "tecplot_binary_file.h"
 
 #include <algorithm>
 #include <fstream>
@@ -85,6 +86,22 @@ class Mesh
         return transferMeshIndexTo1D(all_cells_, cell_index);
     };
 
+    /** Squared distance from a position to a cell. The outmost cells are open outward,
+     *  as the positions beyond the mesh are clamped into them. */
+    Real SquaredDistanceToCell(const Vecd &position, const Arrayi &cell_index) const
+    {
+        Real squared_distance = 0;
+        for (int k = 0; k != Dimensions; ++k)
+        {
+            const Real lower = mesh_lower_bound_[k] + Real(cell_index[k]) * grid_spacing_;
+            const Real below = cell_index[k] == 0 ? Real(0) : lower - position[k];
+            const Real above = cell_index[k] == all_cells_[k] - 1 ? Real(0) : position[k] - lower - grid_spacing_;
+            const Real gap = SMAX(below, above, Real(0));
+            squared_distance += gap * gap;
+        }
+        return squared_distance;
+    };
+
     Vecd CellPositionFromIndex(const Arrayi &cell_index) const;
     Vecd GridPositionFromIndex(const Arrayi &grid_index) const;
     Vecd CellLowerCornerPosition(const Arrayi &cell_index) const;
@@ -155,6 +172,8 @@ class BaseMeshField
     std::string Name() { return name_; };
     /** output mesh data for Tecplot visualization */
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) = 0;
+    /** output mesh data as zones of a binary Tecplot file */
+    virtual void writeMeshFieldToBinaryPlt(TecplotBinaryWriter &binary_writer) = 0;
 };
 
 /**
@@ -210,6 +229,13 @@ class MultilevelMesh : public MeshFieldType
             mesh_levels_[l]->writeMeshFieldToPlt(output_file);
         }
     }
+    void writeMeshFieldToBinaryPlt(TecplotBinaryWriter &binary_writer) override
+    {
+        for (size_t l = 0; l != total_levels_; ++l)
+        {
+            mesh_levels_[l]->writeMeshFieldToBinaryPlt(binary_writer);
+        }
+    }
 };
 } // namespace SPH
 #endif // BASE_MESH_H
\ No newline at end of file
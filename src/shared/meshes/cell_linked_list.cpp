@@ -3,7 +3,9 @@
 #include "base_kernel.h"
 #include "base_particle_dynamics.h"
 #include "base_particles.h"
+#include "cell_linked_list.hpp"
 #include "mesh_iterators.hpp"
+#include "particle_functors.h"
 #include "particle_iterators.h"
 
 namespace SPH
@@ -13,15 +15,51 @@ BaseCellLinkedList::
     BaseCellLinkedList(BaseParticles &base_particles, SPHAdaptation &sph_adaptation)
     : BaseMeshField("CellLinkedList"), kernel_(*sph_adaptation.getKernel()) {}
 //=================================================================================================//
+size_t BaseCellLinkedList::MemoryFootprint()
+{
+    size_t bytes = 0;
+    for (CellLinkedList *level : CellLinkedListLevels())
+        bytes += level->LevelMemoryFootprint();
+    return bytes;
+}
+//=================================================================================================//
+CountStatistics BaseCellLinkedList::CellOccupancy()
+{
+    CountStatistics statistics;
+    for (CellLinkedList *level : CellLinkedListLevels())
+        statistics.join(level->LevelCellOccupancy());
+    return statistics;
+}
+//=================================================================================================//
+bool BaseCellLinkedList::isPeriodicImageSearch()
+{
+    for (CellLinkedList *level : CellLinkedListLevels())
+    {
+        if (level->getPeriodicImage().isPeriodic())
+            return true;
+    }
+    return false;
+}
+//=================================================================================================//
 CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
                                BaseParticles &base_particles, SPHAdaptation &sph_adaptation)
-    : BaseCellLinkedList(base_particles, sph_adaptation), Mesh(tentative_bounds, grid_spacing, 2),
+    : CellLinkedList(tentative_bounds, grid_spacing, 1, base_particles, sph_adaptation) {}
+//=================================================================================================//
+CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real cutoff_radius, UnsignedInt subdivision,
+                               BaseParticles &base_particles, SPHAdaptation &sph_adaptation)
+    : BaseCellLinkedList(base_particles, sph_adaptation),
+      Mesh(tentative_bounds, cutoff_radius / Real(subdivision), 2 * subdivision),
       cell_offset_list_size_(NumberOfCells() + 1),
       index_list_size_(SMAX(base_particles.ParticlesBound(), cell_offset_list_size_)),
       dv_particle_index_(base_particles.registerDiscreteVariableOnly<UnsignedInt>("ParticleIndex", index_list_size_)),
       dv_cell_offset_(base_particles.registerDiscreteVariableOnly<UnsignedInt>("CellOffset", cell_offset_list_size_)),
-      cell_index_lists_(nullptr), cell_data_lists_(nullptr),
-      number_of_split_cell_lists_(static_cast<size_t>(pow(3, Dimensions)))
+      cell_data_lists_(nullptr),
+      cell_size_list_(cell_offset_list_size_, 0), cell_offset_list_(cell_offset_list_size_, 0),
+      particle_index_list_(base_particles.ParticlesBound(), 0), particle_pos_(nullptr),
+      moved_fraction_threshold_(0.0), is_cell_list_built_(false),
+      total_real_particles_at_last_build_(0), total_sorts_at_last_build_(0),
+      subdivision_(subdivision), search_radius_(cutoff_radius), color_stride_(2 * subdivision + 1),
+      number_of_split_cell_lists_(static_cast<size_t>(pow(color_stride_, Dimensions)))
 {
     allocateMeshDataMatrix();
     single_cell_linked_list_level_.push_back(this);
@@ -30,66 +68,219 @@ CellLinkedList::CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
 void CellLinkedList ::allocateMeshDataMatrix()
 {
     size_t number_of_all_cells = transferMeshIndexTo1D(all_cells_, all_cells_);
-    cell_index_lists_ = new ConcurrentIndexVector[number_of_all_cells];
+    cell_particles_.reserve(number_of_all_cells);
+    for (size_t i = 0; i != number_of_all_cells; ++i)
+        cell_particles_.push_back(CellParticles(cell_offset_list_, particle_index_list_, i));
     cell_data_lists_ = new ListDataVector[number_of_all_cells];
 }
 //=================================================================================================//
 void CellLinkedList ::deleteMeshDataMatrix()
 {
-    delete[] cell_index_lists_;
     delete[] cell_data_lists_;
 }
 //=================================================================================================//
 void CellLinkedList::clearCellLists()
 {
+    UnsignedInt *cell_offset = cell_offset_list_.data();
+    particle_for(execution::ParallelPolicy(), IndexRange(0, cell_offset_list_size_),
+                 [=](size_t i)
+                 { cell_offset[i] = 0; });
     mesh_parallel_for(MeshRange(Arrayi::Zero(), all_cells_),
                       [&](const Arrayi &cell_index)
                       {
-                          getCellDataList(cell_index_lists_, cell_index).clear();
+                          getCellDataList(cell_data_lists_, cell_index).clear();
                       });
 }
 //=================================================================================================//
-void CellLinkedList::UpdateCellListData(BaseParticles &base_particles)
+size_t CellLinkedList::LevelMemoryFootprint()
 {
-    Vecd *pos = base_particles.ParticlePositions();
-    mesh_parallel_for(
-        MeshRange(Arrayi::Zero(), all_cells_),
-        [&](const Arrayi &cell_index)
-        {
-            ListDataVector &cell_data_list = getCellDataList(cell_data_lists_, cell_index);
-            cell_data_list.clear();
-            ConcurrentIndexVector &cell_list = getCellDataList(cell_index_lists_, cell_index);
-            for (size_t s = 0; s != cell_list.size(); ++s)
-            {
-                size_t index = cell_list[s];
-                cell_data_list.emplace_back(std::make_pair(index, pos[index]));
-            }
-        });
+    size_t number_of_all_cells = transferMeshIndexTo1D(all_cells_, all_cells_);
+    size_t bytes = number_of_all_cells * (sizeof(CellParticles) + sizeof(ListDataVector));
+    for (size_t i = 0; i != number_of_all_cells; ++i)
+    {
+        bytes += cell_data_lists_[i].capacity() * sizeof(ListData);
+    }
+    return bytes + (cell_size_list_.capacity() + cell_offset_list_.capacity() +
+                    particle_index_list_.capacity() + particle_cell_list_.capacity() +
+                    cell_moves_list_.capacity() + previous_cell_offset_list_.capacity() +
+                    previous_particle_index_list_.capacity()) *
+                       sizeof(UnsignedInt);
+}
+//=================================================================================================//
+CountStatistics CellLinkedList::LevelCellOccupancy()
+{
+    return computeCountStatistics(transferMeshIndexTo1D(all_cells_, all_cells_),
+                                  [&](size_t i)
+                                  { return cell_particles_[i].size() + cell_data_lists_[i].size(); });
+}
+//=================================================================================================//
+CountStatistics CellLinkedList::FlatCellOccupancy()
+{
+    UnsignedInt *cell_offset = dv_cell_offset_->DataField();
+    return computeCountStatistics(cell_offset_list_size_ - 1,
+                                  [&](size_t i)
+                                  { return size_t(cell_offset[i + 1] - cell_offset[i]); });
+}
+//=================================================================================================//
+void CellLinkedList::setPeriodicAxis(const BoundingBox &periodic_bounds, int axis)
+{
+    // a particle near both bounds would otherwise find the same neighbor twice
+    if (periodic_bounds.second_[axis] - periodic_bounds.first_[axis] < 2.0 * search_radius_)
+    {
+        std::cout << "\n Error: the periodic domain is smaller than twice the search range!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    periodic_image_.setPeriodicAxis(periodic_bounds.first_, periodic_bounds.second_, axis);
 }
 //=================================================================================================//
 void CellLinkedList::UpdateCellLists(BaseParticles &base_particles)
 {
-    clearCellLists();
-    Vecd *pos_n = base_particles.ParticlePositions();
     size_t total_real_particles = base_particles.TotalRealParticles();
-    parallel_for(
-        IndexRange(0, total_real_particles),
-        [&](const IndexRange &r)
-        {
-            for (size_t i = r.begin(); i != r.end(); ++i)
-            {
-                insertParticleIndex(i, pos_n[i]);
-            }
-        },
-        ap);
+    if (moved_fraction_threshold_ > 0.0 && is_cell_list_built_ &&
+        total_real_particles == total_real_particles_at_last_build_ &&
+        base_particles.TotalSorts() == total_sorts_at_last_build_ &&
+        base_particles.ParticlePositions() == particle_pos_ &&
+        updateCellListsIncrementally(total_real_particles))
+    {
+        return;
+    }
+
+    buildCellListsByCountingSort(base_particles, [](size_t i)
+                                 { return true; });
+    if (moved_fraction_threshold_ > 0.0)
+    {
+        recordParticleCells(base_particles);
+    }
+}
+//=================================================================================================//
+void CellLinkedList::setIncrementalUpdate(Real moved_fraction_threshold)
+{
+    moved_fraction_threshold_ = SMAX(moved_fraction_threshold, Real(0));
+    is_cell_list_built_ = false;
+}
+//=================================================================================================//
+void CellLinkedList::recordParticleCells(BaseParticles &base_particles)
+{
+    size_t total_real_particles = base_particles.TotalRealParticles();
+    if (particle_cell_list_.size() < total_real_particles)
+        particle_cell_list_.resize(total_real_particles);
+    cell_moves_list_.resize(cell_offset_list_size_);
 
-    UpdateCellListData(base_particles);
+    Vecd *pos = particle_pos_;
+    UnsignedInt *particle_cell = particle_cell_list_.data();
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                 [&](size_t i)
+                 { particle_cell[i] = LinearCellIndexFromPosition(pos[i]); });
+    is_cell_list_built_ = true;
+    total_real_particles_at_last_build_ = total_real_particles;
+    total_sorts_at_last_build_ = base_particles.TotalSorts();
+}
+//=================================================================================================//
+bool CellLinkedList::updateCellListsIncrementally(size_t total_real_particles)
+{
+    Vecd *pos = particle_pos_;
+    UnsignedInt *particle_cell = particle_cell_list_.data();
+    const IndexRange all_particles(0, total_real_particles);
+    const IndexRange all_cells(0, cell_offset_list_size_ - 1);
+    UnsignedInt moved_particles = particle_reduce(
+        execution::ParallelPolicy(), all_particles, UnsignedInt(0), ReduceSum<UnsignedInt>(),
+        [&](size_t i) -> UnsignedInt
+        { return LinearCellIndexFromPosition(pos[i]) != particle_cell[i] ? 1 : 0; });
+    if (Real(moved_particles) > moved_fraction_threshold_ * Real(total_real_particles))
+    {
+        return false;
+    }
+
+    std::swap(cell_offset_list_, previous_cell_offset_list_);
+    std::swap(particle_index_list_, previous_particle_index_list_);
+    cell_offset_list_.resize(cell_offset_list_size_);
+    if (particle_index_list_.size() < total_real_particles)
+        particle_index_list_.resize(total_real_particles);
+
+    UnsignedInt *cell_size = cell_size_list_.data();
+    UnsignedInt *cell_moves = cell_moves_list_.data();
+    UnsignedInt *cell_offset = cell_offset_list_.data();
+    UnsignedInt *particle_index = particle_index_list_.data();
+    UnsignedInt *previous_cell_offset = previous_cell_offset_list_.data();
+    UnsignedInt *previous_particle_index = previous_particle_index_list_.data();
+
+    // the sizes of the cells after moving the particles which changed cell
+    particle_for(execution::ParallelPolicy(), all_cells,
+                 [=](size_t i)
+                 {
+                     cell_size[i] = previous_cell_offset[i + 1] - previous_cell_offset[i];
+                     cell_moves[i] = 0;
+                 });
+    cell_size[cell_offset_list_size_ - 1] = 0;
+    particle_for(execution::ParallelPolicy(), all_particles,
+                 [&](size_t i)
+                 {
+                     const UnsignedInt linear_index = LinearCellIndexFromPosition(pos[i]);
+                     if (linear_index != particle_cell[i])
+                     {
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_previous_cell_size(cell_size[particle_cell[i]]);
+                         --atomic_previous_cell_size;
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_cell_size(cell_size[linear_index]);
+                         ++atomic_cell_size;
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_previous_cell_moves(cell_moves[particle_cell[i]]);
+                         ++atomic_previous_cell_moves;
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_cell_moves(cell_moves[linear_index]);
+                         ++atomic_cell_moves;
+                     }
+                 });
+    exclusive_scan(execution::ParallelPolicy(), cell_size, cell_offset,
+                   cell_offset_list_size_, std::plus<UnsignedInt>());
+
+    // Here, cell_size counts the particles filled into the cell.
+    particle_for(execution::ParallelPolicy(), all_cells,
+                 [&](size_t i)
+                 {
+                     UnsignedInt filled_size = 0;
+                     for (UnsignedInt n = previous_cell_offset[i]; n < previous_cell_offset[i + 1]; ++n)
+                     {
+                         const UnsignedInt index_j = previous_particle_index[n];
+                         if (cell_moves[i] == 0 || LinearCellIndexFromPosition(pos[index_j]) == i)
+                         {
+                             particle_index[cell_offset[i] + filled_size] = index_j;
+                             filled_size++;
+                         }
+                     }
+                     cell_size[i] = filled_size;
+                 });
+    particle_for(execution::ParallelPolicy(), all_particles,
+                 [&](size_t i)
+                 {
+                     const UnsignedInt linear_index = LinearCellIndexFromPosition(pos[i]);
+                     if (linear_index != particle_cell[i])
+                     {
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_cell_size(cell_size[linear_index]);
+                         particle_index[cell_offset[linear_index] + atomic_cell_size++] = i;
+                         particle_cell[i] = linear_index;
+                     }
+                 });
+
+    // only the cells with moved particles are sorted again
+    particle_for(execution::ParallelPolicy(), all_cells,
+                 [&](size_t i)
+                 {
+                     if (cell_moves[i] != 0)
+                     {
+                         std::sort(particle_index + cell_offset[i], particle_index + cell_offset[i + 1]);
+                     }
+                     cell_data_lists_[i].clear();
+                 });
+    return true;
 }
 //=================================================================================================//
 void CellLinkedList ::insertParticleIndex(size_t particle_index, const Vecd &particle_position)
 {
-    Arrayi cell_index = CellIndexFromPosition(particle_position);
-    getCellDataList(cell_index_lists_, cell_index).emplace_back(particle_index);
+    InsertListDataEntry(particle_index, particle_position);
 }
 //=================================================================================================//
 void CellLinkedList ::InsertListDataEntry(size_t particle_index, const Vecd &particle_position)
@@ -105,21 +296,22 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
     ListData nearest_entry = std::make_pair(MaxSize_t, MaxReal * Vecd::Ones());
 
     Arrayi cell = CellIndexFromPosition(position);
+    const int search_depth = subdivision_;
     mesh_for_each(
-        Arrayi::Zero().max(cell - Arrayi::Ones()),
-        all_cells_.min(cell + 2 * Arrayi::Ones()),
+        Arrayi::Zero().max(cell - search_depth * Arrayi::Ones()),
+        all_cells_.min(cell + (search_depth + 1) * Arrayi::Ones()),
         [&](const Arrayi &cell_index)
         {
-            ListDataVector &target_particles = getCellDataList(cell_data_lists_, cell_index);
-            for (const ListData &list_data : target_particles)
-            {
-                Real distance_sqr = (position - std::get<1>(list_data)).squaredNorm();
-                if (distance_sqr < min_distance_sqr)
+            forEachListDataInCell(
+                cell_index, [&](const ListData &list_data)
                 {
-                    min_distance_sqr = distance_sqr;
-                    nearest_entry = list_data;
-                }
-            }
+                    Real distance_sqr = (position - std::get<1>(list_data)).squaredNorm();
+                    if (distance_sqr < min_distance_sqr)
+                    {
+                        min_distance_sqr = distance_sqr;
+                        nearest_entry = list_data;
+                    }
+                });
         });
     return nearest_entry;
 }
@@ -127,6 +319,16 @@ ListData CellLinkedList::findNearestListDataEntry(const Vecd &position)
 void CellLinkedList::
     tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included)
 {
+    // the check, often a distance query to a shape, is carried out only once for each cell
+    StdLargeVec<char> is_cell_checked(NumberOfCells(), 0);
+    mesh_parallel_for(
+        MeshRange(Arrayi::Zero(), all_cells_),
+        [&](const Arrayi &cell_index)
+        {
+            is_cell_checked[LinearCellIndexFromCellIndex(cell_index)] =
+                check_included(CellPositionFromIndex(cell_index), grid_spacing_);
+        });
+
     mesh_parallel_for(
         MeshRange(Arrayi::Zero(), all_cells_),
         [&](const Arrayi &cell_index)
@@ -137,13 +339,13 @@ void CellLinkedList::
                 all_cells_.min(cell_index + 2 * Arrayi::Ones()),
                 [&](const Arrayi &neighbor_cell_index)
                 {
-                    if (check_included(CellPositionFromIndex(neighbor_cell_index), grid_spacing_))
+                    if (is_cell_checked[LinearCellIndexFromCellIndex(neighbor_cell_index)])
                     {
                         is_included = true;
                     }
                 });
             if (is_included == true)
-                cell_lists.push_back(&getCellDataList(cell_index_lists_, cell_index));
+                cell_lists.push_back(&getCellDataList(cell_particles_.data(), cell_index));
         });
 }
 //=================================================================================================//
@@ -152,6 +354,29 @@ UnsignedInt CellLinkedList::computingSequence(Vecd &position, size_t index_i)
     return transferMeshIndexToMortonOrder(CellIndexFromPosition(position));
 }
 //=================================================================================================//
+void CellLinkedList::writeMeshFieldToBinaryPlt(TecplotBinaryWriter &binary_writer)
+{
+    const std::string axis_names[3] = {"x", "y", "z"};
+    StdVec<std::string> variable_names(axis_names, axis_names + Dimensions);
+    variable_names.push_back("particles_in_cell");
+
+    Array3i zone_size = Array3i::Ones();
+    zone_size.head<Dimensions>() = all_cells_;
+    TecplotZone &zone = binary_writer.addZone(variable_names, Name(), zone_size);
+
+    mesh_parallel_for(
+        MeshRange(Arrayi::Zero(), all_cells_),
+        [&](const Arrayi &cell_index)
+        {
+            size_t point_index = zone.PointIndex(cell_index);
+            Vecd cell_position = CellPositionFromIndex(cell_index);
+            for (int n = 0; n != Dimensions; ++n)
+                zone.VariableData(n)[point_index] = cell_position[n];
+            zone.VariableData(Dimensions)[point_index] =
+                Real(getCellDataList(cell_particles_.data(), cell_index).size());
+        });
+}
+//=================================================================================================//
 MultilevelCellLinkedList::MultilevelCellLinkedList(BoundingBox tentative_bounds,
                                                    Real reference_grid_spacing, size_t total_levels,
                                                    BaseParticles &base_particles, SPHAdaptation &sph_adaptation)
@@ -191,26 +416,17 @@ void MultilevelCellLinkedList::InsertListDataEntry(size_t particle_index, const
 //=================================================================================================//
 void MultilevelCellLinkedList::UpdateCellLists(BaseParticles &base_particles)
 {
-    for (size_t level = 0; level != total_levels_; ++level)
-        mesh_levels_[level]->clearCellLists();
-
-    Vecd *pos_n = base_particles.ParticlePositions();
     size_t total_real_particles = base_particles.TotalRealParticles();
-    // rebuild the corresponding particle list.
-    parallel_for(
-        IndexRange(0, total_real_particles),
-        [&](const IndexRange &r)
-        {
-            for (size_t i = r.begin(); i != r.end(); ++i)
-            {
-                insertParticleIndex(i, pos_n[i]);
-            }
-        },
-        ap);
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_real_particles),
+                 [&](size_t i)
+                 { level_[i] = getMeshLevel(kernel_.CutOffRadius(h_ratio_[i])); });
 
     for (size_t level = 0; level != total_levels_; ++level)
     {
-        mesh_levels_[level]->UpdateCellListData(base_particles);
+        int current_level = static_cast<int>(level);
+        mesh_levels_[level]->buildCellListsByCountingSort(
+            base_particles, [&](size_t i)
+            { return level_[i] == current_level; });
     }
 }
 //=================================================================================================//
@@ -230,4 +446,62 @@ void MultilevelCellLinkedList::
     }
 }
 //=================================================================================================//
+UnsignedInt benchmarkCellLinkedListSubdivision(const BoundingBox &domain_bounds, Real cutoff_radius,
+                                               BaseParticles &base_particles, UnsignedInt max_subdivision)
+{
+    const size_t total_real_particles = base_particles.TotalRealParticles();
+    const Vecd *pos = base_particles.ParticlePositions();
+    const Real cutoff_radius_squared = cutoff_radius * cutoff_radius;
+
+    UnsignedInt fastest_subdivision = 1;
+    Real shortest_time = MaxReal;
+    for (UnsignedInt subdivision = 1; subdivision <= max_subdivision; ++subdivision)
+    {
+        Mesh mesh(domain_bounds, cutoff_radius / Real(subdivision), 2 * subdivision);
+        // flat cell lists by a counting sort, as built for the computing kernels
+        StdVec<UnsignedInt> cell_offset(mesh.NumberOfCells() + 1, 0);
+        StdVec<UnsignedInt> particle_index(total_real_particles);
+        for (size_t i = 0; i != total_real_particles; ++i)
+            cell_offset[mesh.LinearCellIndexFromPosition(pos[i]) + 1]++;
+        for (size_t k = 1; k != cell_offset.size(); ++k)
+            cell_offset[k] += cell_offset[k - 1];
+        StdVec<UnsignedInt> cell_fill(cell_offset.begin(), cell_offset.end() - 1);
+        for (size_t i = 0; i != total_real_particles; ++i)
+            particle_index[cell_fill[mesh.LinearCellIndexFromPosition(pos[i])]++] = i;
+
+        TickCount t1 = TickCount::now();
+        UnsignedInt total_neighbors = particle_reduce(
+            execution::ParallelPolicy(), IndexRange(0, total_real_particles), UnsignedInt(0), ReduceSum<UnsignedInt>(),
+            [&](size_t index_i) -> UnsignedInt
+            {
+                UnsignedInt count = 0;
+                const Vecd &pos_i = pos[index_i];
+                mesh_for_each(
+                    mesh.CellIndexFromPosition(pos_i - cutoff_radius * Vecd::Ones()),
+                    mesh.CellIndexFromPosition(pos_i + cutoff_radius * Vecd::Ones()) + Arrayi::Ones(),
+                    [&](const Arrayi &cell_index)
+                    {
+                        if (mesh.SquaredDistanceToCell(pos_i, cell_index) >= cutoff_radius_squared)
+                            return;
+                        const size_t linear_index = mesh.LinearCellIndexFromCellIndex(cell_index);
+                        for (UnsignedInt n = cell_offset[linear_index]; n < cell_offset[linear_index + 1]; ++n)
+                        {
+                            count += (pos_i - pos[particle_index[n]]).squaredNorm() < cutoff_radius_squared;
+                        }
+                    });
+                return count;
+            });
+        Real search_time = (TickCount::now() - t1).seconds();
+        std::cout << "Cell linked list subdivision " << subdivision << ": " << search_time
+                  << " seconds for " << total_neighbors << " neighbors." << std::endl;
+
+        if (search_time < shortest_time)
+        {
+            shortest_time = search_time;
+            fastest_subdivision = subdivision;
+        }
+    }
+    return fastest_subdivision;
+}
+//=================================================================================================//
 } // namespace SPH
@@ -59,8 +59,15 @@ class BaseCellLinkedList : public BaseMeshField
 
     /** access concrete cell linked list levels*/
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() = 0;
+    /** the memory of the cell lists of all levels in bytes,
+     *  the particle index and cell offset variables are counted with the particle variables */
+    size_t MemoryFootprint();
+    /** the particles and extra entries listed in each cell of all levels */
+    CountStatistics CellOccupancy();
+    /** whether any level handles periodicity by searching periodic images */
+    bool isPeriodicImageSearch();
     virtual void UpdateCellLists(BaseParticles &base_particles) = 0;
-    /** Insert a cell-linked_list entry to the concurrent index list. */
+    /** Insert a cell-linked_list entry of a particle index, listed with its position until the next update. */
     virtual void insertParticleIndex(size_t particle_index, const Vecd &particle_position) = 0;
     /** Insert a cell-linked_list entry of the index and particle position pair. */
     virtual void InsertListDataEntry(size_t particle_index, const Vecd &particle_position) = 0;
@@ -80,16 +87,29 @@ class NeighborSearch : public Mesh
     template <class ExecutionPolicy>
     NeighborSearch(const ExecutionPolicy &ex_policy,
                    CellLinkedList &cell_linked_list, DiscreteVariable<Vecd> *pos);
+    /** search radius larger than the cut-off radius, e.g. cut-off radius plus a Verlet skin */
+    template <class ExecutionPolicy>
+    NeighborSearch(const ExecutionPolicy &ex_policy,
+                   CellLinkedList &cell_linked_list, DiscreteVariable<Vecd> *pos, Real search_radius);
 
     template <typename FunctionOnEach>
     void forEachSearch(UnsignedInt index_i, const Vecd *source_pos,
                        const FunctionOnEach &function) const;
+    /** search within a radius not larger than the search radius, e.g. of a particle with a smaller smoothing length */
+    template <typename FunctionOnEach>
+    void forEachSearch(UnsignedInt index_i, const Vecd *source_pos, Real search_radius,
+                       const FunctionOnEach &function) const;
+    Real SearchRadius() const { return search_radius_; };
+    /** the search radius beyond the cut-off radius of the cell linked list */
+    Real VerletSkin() const { return verlet_skin_; };
 
   protected:
-    Real grid_spacing_squared_;
+    Real search_radius_;
+    Real verlet_skin_;
     Vecd *pos_;
     UnsignedInt *particle_index_;
     UnsignedInt *cell_offset_;
+    PeriodicImage periodic_image_;
 };
 
 /**
@@ -107,11 +127,31 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     DiscreteVariable<UnsignedInt> *dv_cell_offset_;
 
   protected:
-    /** using concurrent vectors due to writing conflicts when building the list */
-    ConcurrentIndexVector *cell_index_lists_;
-    /** non-concurrent list data rewritten for building neighbor list */
+    /** per-cell views of the real particles in the flat cell lists below, e.g. for body parts by cell */
+    StdVec<CellParticles> cell_particles_;
+    /** extra list data entries, e.g. periodic images, inserted after building the cell lists */
     ListDataVector *cell_data_lists_;
-    /**< number of split cell lists */
+    /** flat cell lists of real particles built by a counting sort */
+    StdLargeVec<UnsignedInt> cell_size_list_;     /**< scratch counter for each cell */
+    StdLargeVec<UnsignedInt> cell_offset_list_;   /**< number of cells plus one offsets */
+    StdLargeVec<UnsignedInt> particle_index_list_; /**< particle indices sorted by cell */
+    Vecd *particle_pos_;                          /**< positions of the listed particles */
+    PeriodicImage periodic_image_;                /**< periodicity applied in neighbor search */
+    /** incremental update of the cell lists, see setIncrementalUpdate */
+    Real moved_fraction_threshold_;
+    bool is_cell_list_built_;
+    size_t total_real_particles_at_last_build_;
+    UnsignedInt total_sorts_at_last_build_;
+    StdLargeVec<UnsignedInt> particle_cell_list_;           /**< the cell of each particle at the last update */
+    StdLargeVec<UnsignedInt> cell_moves_list_;              /**< particles moved into or out of each cell */
+    StdLargeVec<UnsignedInt> previous_cell_offset_list_;    /**< cell offsets of the last update */
+    StdLargeVec<UnsignedInt> previous_particle_index_list_; /**< particle indices of the last update */
+    /** cells of the cut-off radius divided by the subdivision,
+     *  with which fewer candidates are tested as the cells farther than the cut-off radius are pruned */
+    UnsignedInt subdivision_;
+    Real search_radius_;
+    /**< number of split cell lists, with the color stride of the cells not sharing neighbors */
+    int color_stride_;
     size_t number_of_split_cell_lists_;
 
     void allocateMeshDataMatrix(); /**< allocate memories for addresses of data packages. */
@@ -121,15 +161,45 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     {
         return data_lists[transferMeshIndexTo1D(all_cells_, cell_index)];
     };
+    /** returns false if too many particles changed cell for an incremental update */
+    bool updateCellListsIncrementally(size_t total_real_particles);
+    void recordParticleCells(BaseParticles &base_particles);
+    /** apply a function to the real particles and the extra entries listed in a cell */
+    template <typename FunctionOnEach>
+    void forEachListDataInCell(const Arrayi &cell_index, const FunctionOnEach &function);
 
   public:
     CellLinkedList(BoundingBox tentative_bounds, Real grid_spacing,
                    BaseParticles &base_particles, SPHAdaptation &sph_adaptation);
+    /** the cells are of the cut-off radius divided by the subdivision */
+    CellLinkedList(BoundingBox tentative_bounds, Real cutoff_radius, UnsignedInt subdivision,
+                   BaseParticles &base_particles, SPHAdaptation &sph_adaptation);
     ~CellLinkedList() { deleteMeshDataMatrix(); };
 
+    /** the cut-off radius, i.e. the grid spacing times the subdivision */
+    Real SearchRadius() { return search_radius_; };
+    UnsignedInt Subdivision() { return subdivision_; };
+
     void clearCellLists();
-    void UpdateCellListData(BaseParticles &base_particles);
+    /** the memory of the cell lists on this level in bytes */
+    size_t LevelMemoryFootprint();
+    /** the particles and extra entries listed in each cell on this level */
+    CountStatistics LevelCellOccupancy();
+    /** the particles in each cell from the cell offsets updated by UpdateCellLinkedList,
+     *  the host data of which is to be synchronized before if updated on device */
+    CountStatistics FlatCellOccupancy();
+    /** build flat cell lists for the real particles satisfying is_included */
+    template <typename IsIncluded>
+    void buildCellListsByCountingSort(BaseParticles &base_particles, const IsIncluded &is_included);
     virtual void UpdateCellLists(BaseParticles &base_particles) override;
+    /**
+     * Incremental mode: only the particles whose cell changed since the last update are moved
+     * to their new cells, the others keep their entries, and only the cells with moved particles
+     * are sorted and listed again. The lists are rebuilt as a whole when more than the given fraction
+     * of the particles changed cell, or after sorting or a change of the particle number.
+     * A zero fraction (the default) rebuilds the lists at every update.
+     */
+    void setIncrementalUpdate(Real moved_fraction_threshold);
     void insertParticleIndex(size_t particle_index, const Vecd &particle_position) override;
     void InsertListDataEntry(size_t particle_index, const Vecd &particle_position) override;
     virtual ListData findNearestListDataEntry(const Vecd &position) override;
@@ -137,24 +207,54 @@ class CellLinkedList : public BaseCellLinkedList, public Mesh
     virtual void tagBodyPartByCell(ConcurrentCellLists &cell_lists, std::function<bool(Vecd, Real)> &check_included) override;
     virtual void tagBoundingCells(StdVec<CellLists> &cell_data_lists, const BoundingBox &bounding_bounds, int axis) override;
     virtual void writeMeshFieldToPlt(std::ofstream &output_file) override;
+    virtual void writeMeshFieldToBinaryPlt(TecplotBinaryWriter &binary_writer) override;
     virtual StdVec<CellLinkedList *> CellLinkedListLevels() override { return single_cell_linked_list_level_; };
 
     /** generalized particle search algorithm */
     template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
     void searchNeighborsByParticles(DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
                                     GetSearchDepth &get_search_depth, GetNeighborRelation &get_neighbor_relation);
+    /** particle search within a per-particle radius, only visiting the cells
+     * overlapping the box around the particle and closer than the radius */
+    template <class DynamicsRange, typename GetSearchRadius, typename GetNeighborRelation>
+    void searchNeighborsWithinRadius(DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
+                                     GetSearchRadius &get_search_radius, GetNeighborRelation &get_neighbor_relation);
 
     template <class ExecutionPolicy>
     NeighborSearch createNeighborSearch(const ExecutionPolicy &ex_policy, DiscreteVariable<Vecd> *pos);
+    template <class ExecutionPolicy>
+    NeighborSearch createNeighborSearch(const ExecutionPolicy &ex_policy, DiscreteVariable<Vecd> *pos,
+                                        Real search_radius);
     UnsignedInt getCellOffsetListSize() { return cell_offset_list_size_; };
     DiscreteVariable<UnsignedInt> *getParticleIndex() { return dv_particle_index_; };
     DiscreteVariable<UnsignedInt> *getCellOffset() { return dv_cell_offset_; };
+    /** Ghost-free periodicity along an axis, handled by searching the periodic images.
+     * The particles are kept within the periodic bounds by periodic bounding only. */
+    void setPeriodicAxis(const BoundingBox &periodic_bounds, int axis);
+    const PeriodicImage &getPeriodicImage() { return periodic_image_; };
 
     /** split algorithm */;
     template <class LocalDynamicsFunction>
     void particle_for_split(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function);
     template <class LocalDynamicsFunction>
     void particle_for_split(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function);
+    /** 3^d cell coloring, or (2s + 1)^d for the subdivision s: particles in cells of the same color
+     * have no common neighbor, so that a particle may also write to its neighbors without data race. */
+    template <class LocalDynamicsFunction>
+    void particle_for_colored(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function);
+    template <class LocalDynamicsFunction>
+    void particle_for_colored(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function);
+    /** split algorithm with 2^d coloring of blocks of 2^d cells, or (2s)^d for the subdivision s:
+     * blocks of the same color are separated by two cut-off radii as in the cell coloring, but the forward
+     * and backward sweeps synchronize 2^d instead of 3^d times. Cells within a block are swept sequentially. */
+    template <class LocalDynamicsFunction>
+    void particle_for_block_split(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function);
+    template <class LocalDynamicsFunction>
+    void particle_for_block_split(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function);
+
+  protected:
+    template <class LocalDynamicsFunction>
+    void sweepCellBlock(const Arrayi &block_index, bool is_forward, const LocalDynamicsFunction &local_dynamics_function);
 };
 
 template <>
@@ -204,6 +304,18 @@ class MultilevelCellLinkedList : public MultilevelMesh<BaseCellLinkedList, CellL
     void particle_for_split(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function);
     template <class LocalDynamicsFunction>
     void particle_for_split(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function);
+    template <class LocalDynamicsFunction>
+    void particle_for_block_split(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function);
+    template <class LocalDynamicsFunction>
+    void particle_for_block_split(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function);
 };
+
+/**
+ * A quick benchmark of the pruned cell search for the present particles with the subdivisions
+ * of the cut-off radius from 1 to max_subdivision, returning the fastest one.
+ * The choice depends on the particle distribution and the hardware, e.g. the cache size.
+ */
+UnsignedInt benchmarkCellLinkedListSubdivision(const BoundingBox &domain_bounds, Real cutoff_radius,
+                                               BaseParticles &base_particles, UnsignedInt max_subdivision = 3);
 } // namespace SPH
 #endif // MESH_CELL_LINKED_LIST_H
\ No newline at end of file
@@ -9,44 +9,73 @@
 
 #pragma once
 
+#include "base_configuration_dynamics.h"
 #include "base_particles.h"
 #include "cell_linked_list.h"
 #include "mesh_iterators.hpp"
 #include "particle_iterators.h"
 
+#include <algorithm>
+
 namespace SPH
 {
 //=================================================================================================//
 template <class ExecutionPolicy>
 NeighborSearch::NeighborSearch(
     const ExecutionPolicy &ex_policy, CellLinkedList &cell_linked_list, DiscreteVariable<Vecd> *pos)
-    : Mesh(cell_linked_list), grid_spacing_squared_(grid_spacing_ * grid_spacing_),
+    : NeighborSearch(ex_policy, cell_linked_list, pos, cell_linked_list.SearchRadius()) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+NeighborSearch::NeighborSearch(const ExecutionPolicy &ex_policy, CellLinkedList &cell_linked_list,
+                               DiscreteVariable<Vecd> *pos, Real search_radius)
+    : Mesh(cell_linked_list),
+      search_radius_(search_radius),
+      verlet_skin_(SMAX(search_radius - cell_linked_list.SearchRadius(), Real(0))),
       pos_(pos->DelegatedDataField(ex_policy)),
       particle_index_(cell_linked_list.getParticleIndex()->DelegatedDataField(ex_policy)),
-      cell_offset_(cell_linked_list.getCellOffset()->DelegatedDataField(ex_policy)) {}
+      cell_offset_(cell_linked_list.getCellOffset()->DelegatedDataField(ex_policy)),
+      periodic_image_(cell_linked_list.getPeriodicImage()) {}
 //=================================================================================================//
 template <typename FunctionOnEach>
 void NeighborSearch::forEachSearch(UnsignedInt index_i, const Vecd *source_pos,
                                    const FunctionOnEach &function) const
 {
-    const Arrayi target_cell_index = CellIndexFromPosition(source_pos[index_i]);
-    mesh_for_each(
-        Arrayi::Zero().max(target_cell_index - Arrayi::Ones()),
-        all_cells_.min(target_cell_index + 2 * Arrayi::Ones()),
-        [&](const Arrayi &cell_index)
-        {
-            const UnsignedInt linear_index = LinearCellIndexFromCellIndex(cell_index);
-            // Since offset_cell_size_ has linear_cell_size_+1 elements, no boundary checks are needed.
-            // offset_cell_size_[0] == 0 && offset_cell_size_[linear_cell_size_] == total_real_particles_
-            for (UnsignedInt n = cell_offset_[linear_index]; n < cell_offset_[linear_index + 1]; ++n)
+    forEachSearch(index_i, source_pos, search_radius_, function);
+}
+//=================================================================================================//
+template <typename FunctionOnEach>
+void NeighborSearch::forEachSearch(UnsignedInt index_i, const Vecd *source_pos, Real search_radius,
+                                   const FunctionOnEach &function) const
+{
+    const Real search_radius_squared = search_radius * search_radius;
+    Vecd image_shifts[1 << Dimensions];
+    const int number_of_images = periodic_image_.ImageShifts(
+        source_pos[index_i], search_radius, image_shifts);
+    for (int k = 0; k != number_of_images; ++k)
+    {
+        // searching around the shifted position finds the neighbors across the periodic bounds
+        const Vecd image_pos = source_pos[index_i] + image_shifts[k];
+        mesh_for_each(
+            CellIndexFromPosition(image_pos - search_radius * Vecd::Ones()),
+            CellIndexFromPosition(image_pos + search_radius * Vecd::Ones()) + Arrayi::Ones(),
+            [&](const Arrayi &cell_index)
             {
-                const UnsignedInt index_j = particle_index_[n];
-                if ((source_pos[index_i] - pos_[index_j]).squaredNorm() < grid_spacing_squared_)
+                // the cells in the corners of the box hold no neighbors
+                if (SquaredDistanceToCell(image_pos, cell_index) >= search_radius_squared)
+                    return;
+                const UnsignedInt linear_index = LinearCellIndexFromCellIndex(cell_index);
+                // Since offset_cell_size_ has linear_cell_size_+1 elements, no boundary checks are needed.
+                // offset_cell_size_[0] == 0 && offset_cell_size_[linear_cell_size_] == total_real_particles_
+                for (UnsignedInt n = cell_offset_[linear_index]; n < cell_offset_[linear_index + 1]; ++n)
                 {
-                    function(index_j);
+                    const UnsignedInt index_j = particle_index_[n];
+                    if ((image_pos - pos_[index_j]).squaredNorm() < search_radius_squared)
+                    {
+                        function(index_j);
+                    }
                 }
-            }
-        });
+            });
+    }
 }
 //=================================================================================================//
 template <class ExecutionPolicy>
@@ -56,6 +85,83 @@ NeighborSearch CellLinkedList::createNeighborSearch(
     return NeighborSearch(ex_policy, *this, pos);
 }
 //=================================================================================================//
+template <class ExecutionPolicy>
+NeighborSearch CellLinkedList::createNeighborSearch(
+    const ExecutionPolicy &ex_policy, DiscreteVariable<Vecd> *pos, Real search_radius)
+{
+    return NeighborSearch(ex_policy, *this, pos, search_radius);
+}
+//=================================================================================================//
+template <typename IsIncluded>
+void CellLinkedList::buildCellListsByCountingSort(BaseParticles &base_particles, const IsIncluded &is_included)
+{
+    particle_pos_ = base_particles.ParticlePositions();
+    const size_t total_real_particles = base_particles.TotalRealParticles();
+    if (particle_index_list_.size() < total_real_particles)
+        particle_index_list_.resize(total_real_particles);
+
+    Vecd *pos = particle_pos_;
+    UnsignedInt *cell_size = cell_size_list_.data();
+    UnsignedInt *cell_offset = cell_offset_list_.data();
+    UnsignedInt *particle_index = particle_index_list_.data();
+    const IndexRange all_cells(0, cell_offset_list_size_ - 1);
+    const IndexRange all_particles(0, total_real_particles);
+
+    particle_for(execution::ParallelPolicy(), IndexRange(0, cell_offset_list_size_),
+                 [=](size_t i)
+                 { cell_size[i] = 0; });
+    particle_for(execution::ParallelPolicy(), all_particles,
+                 [&](size_t i)
+                 {
+                     if (is_included(i))
+                     {
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_cell_size(cell_size[LinearCellIndexFromPosition(pos[i])]);
+                         ++atomic_cell_size;
+                     }
+                 });
+    exclusive_scan(execution::ParallelPolicy(), cell_size, cell_offset,
+                   cell_offset_list_size_, std::plus<UnsignedInt>());
+
+    particle_for(execution::ParallelPolicy(), all_cells,
+                 [=](size_t i)
+                 { cell_size[i] = 0; });
+    particle_for(execution::ParallelPolicy(), all_particles,
+                 [&](size_t i)
+                 {
+                     if (is_included(i))
+                     {
+                         const size_t linear_index = LinearCellIndexFromPosition(pos[i]);
+                         AtomicUnsignedIntRef<execution::ParallelPolicy>::type
+                             atomic_cell_size(cell_size[linear_index]);
+                         particle_index[cell_offset[linear_index] + atomic_cell_size++] = i;
+                     }
+                 });
+
+    // sorting within cells keeps the particle order independent of thread scheduling
+    particle_for(execution::ParallelPolicy(), all_cells,
+                 [&](size_t i)
+                 {
+                     std::sort(particle_index + cell_offset[i], particle_index + cell_offset[i + 1]);
+                     cell_data_lists_[i].clear();
+                 });
+}
+//=================================================================================================//
+template <typename FunctionOnEach>
+void CellLinkedList::forEachListDataInCell(const Arrayi &cell_index, const FunctionOnEach &function)
+{
+    const size_t linear_index = LinearCellIndexFromCellIndex(cell_index);
+    for (UnsignedInt n = cell_offset_list_[linear_index]; n < cell_offset_list_[linear_index + 1]; ++n)
+    {
+        const UnsignedInt index_j = particle_index_list_[n];
+        function(ListData(index_j, particle_pos_[index_j]));
+    }
+    for (const ListData &list_data : cell_data_lists_[linear_index])
+    {
+        function(list_data);
+    }
+}
+//=================================================================================================//
 template <class DynamicsRange, typename GetSearchDepth, typename GetNeighborRelation>
 void CellLinkedList::searchNeighborsByParticles(
     DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
@@ -66,20 +172,69 @@ void CellLinkedList::searchNeighborsByParticles(
                  [&](size_t index_i)
                  {
                      int search_depth = get_search_depth(index_i);
-                     Arrayi target_cell_index = CellIndexFromPosition(pos[index_i]);
+                     Neighborhood &neighborhood = particle_configuration[index_i];
 
+                     Vecd image_shifts[1 << Dimensions];
+                     const int number_of_images = periodic_image_.ImageShifts(
+                         pos[index_i], Real(search_depth) * grid_spacing_, image_shifts);
+                     for (int k = 0; k != number_of_images; ++k)
+                     {
+                         const Vecd &image_shift = image_shifts[k];
+                         Arrayi target_cell_index = CellIndexFromPosition(pos[index_i] + image_shift);
+                         mesh_for_each(
+                             Arrayi::Zero().max(target_cell_index - search_depth * Arrayi::Ones()),
+                             all_cells_.min(target_cell_index + (search_depth + 1) * Arrayi::Ones()),
+                             [&](const Arrayi &cell_index)
+                             {
+                                 forEachListDataInCell(
+                                     cell_index, [&](const ListData &data_list)
+                                     {
+                                         // the neighbor is presented at its image position around particle i
+                                         get_neighbor_relation(neighborhood, pos[index_i], index_i,
+                                                               ListData(data_list.first, data_list.second - image_shift));
+                                     });
+                             });
+                     }
+                 });
+}
+//=================================================================================================//
+template <class DynamicsRange, typename GetSearchRadius, typename GetNeighborRelation>
+void CellLinkedList::searchNeighborsWithinRadius(
+    DynamicsRange &dynamics_range, ParticleConfiguration &particle_configuration,
+    GetSearchRadius &get_search_radius, GetNeighborRelation &get_neighbor_relation)
+{
+    Vecd *pos = dynamics_range.getBaseParticles().ParticlePositions();
+    particle_for(execution::ParallelPolicy(), dynamics_range.LoopRange(),
+                 [&](size_t index_i)
+                 {
+                     const Real search_radius = get_search_radius(index_i);
+                     const Real search_radius_squared = search_radius * search_radius;
                      Neighborhood &neighborhood = particle_configuration[index_i];
-                     mesh_for_each(
-                         Arrayi::Zero().max(target_cell_index - search_depth * Arrayi::Ones()),
-                         all_cells_.min(target_cell_index + (search_depth + 1) * Arrayi::Ones()),
-                         [&](const Arrayi &cell_index)
-                         {
-                             ListDataVector &target_particles = getCellDataList(cell_data_lists_, cell_index);
-                             for (const ListData &data_list : target_particles)
+
+                     Vecd image_shifts[1 << Dimensions];
+                     const int number_of_images = periodic_image_.ImageShifts(
+                         pos[index_i], search_radius, image_shifts);
+                     for (int k = 0; k != number_of_images; ++k)
+                     {
+                         const Vecd &image_shift = image_shifts[k];
+                         const Vecd image_pos = pos[index_i] + image_shift;
+                         mesh_for_each(
+                             CellIndexFromPosition(image_pos - search_radius * Vecd::Ones()),
+                             CellIndexFromPosition(image_pos + search_radius * Vecd::Ones()) + Arrayi::Ones(),
+                             [&](const Arrayi &cell_index)
                              {
-                                 get_neighbor_relation(neighborhood, pos[index_i], index_i, data_list);
-                             }
-                         });
+                                 // the cells in the corners of the box hold no neighbors
+                                 if (SquaredDistanceToCell(image_pos, cell_index) >= search_radius_squared)
+                                     return;
+                                 forEachListDataInCell(
+                                     cell_index, [&](const ListData &data_list)
+                                     {
+                                         // the neighbor is presented at its image position around particle i
+                                         get_neighbor_relation(neighborhood, pos[index_i], index_i,
+                                                               ListData(data_list.first, data_list.second - image_shift));
+                                     });
+                             });
+                     }
                  });
 }
 //=================================================================================================//
@@ -87,15 +242,70 @@ template <class LocalDynamicsFunction>
 void CellLinkedList::particle_for_split(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function)
 {
     // foward sweeping
+    particle_for_colored(execution::SequencedPolicy(), local_dynamics_function);
+
+    // backward sweeping
+    for (size_t k = number_of_split_cell_lists_; k != 0; --k)
+    {
+        const Arrayi split_cell_index = transfer1DtoMeshIndex(color_stride_ * Arrayi::Ones(), k - 1);
+        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / color_stride_ + Arrayi::Ones();
+        const size_t number_of_cells = all_cells_k.prod();
+
+        for (size_t l = 0; l < number_of_cells; l++)
+        {
+            const Arrayi cell_index = split_cell_index + color_stride_ * transfer1DtoMeshIndex(all_cells_k, l);
+            const CellParticles &cell_list = getCellDataList(cell_particles_.data(), cell_index);
+            for (size_t i = cell_list.size(); i != 0; --i)
+            {
+                local_dynamics_function(cell_list[i - 1]);
+            }
+        }
+    }
+}
+//=================================================================================================//
+template <class LocalDynamicsFunction>
+void CellLinkedList::particle_for_split(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function)
+{
+    // foward sweeping
+    particle_for_colored(execution::ParallelPolicy(), local_dynamics_function);
+
+    // backward sweeping
+    for (size_t k = number_of_split_cell_lists_; k != 0; --k)
+    {
+        const Arrayi split_cell_index = transfer1DtoMeshIndex(color_stride_ * Arrayi::Ones(), k - 1);
+        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / color_stride_ + Arrayi::Ones();
+        const size_t number_of_cells = all_cells_k.prod();
+
+        arena_parallel_for(
+            IndexRange(0, number_of_cells),
+            [&](const IndexRange &r)
+            {
+                for (size_t l = r.begin(); l < r.end(); ++l)
+                {
+                    const Arrayi cell_index = split_cell_index + color_stride_ * transfer1DtoMeshIndex(all_cells_k, l);
+                    const CellParticles &cell_list = getCellDataList(cell_particles_.data(), cell_index);
+                    for (size_t i = cell_list.size(); i != 0; --i)
+                    {
+                        local_dynamics_function(cell_list[i - 1]);
+                    }
+                }
+            },
+            ap);
+    }
+}
+//=================================================================================================//
+template <class LocalDynamicsFunction>
+void CellLinkedList::particle_for_colored(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function)
+{
     for (size_t k = 0; k < number_of_split_cell_lists_; k++)
     {
         // get the corresponding 2D/3D split cell index (m, n)
         // e.g., for k = 0, split_cell_index = (0,0), for k = 3, split_cell_index = (1,0), etc.
-        const Arrayi split_cell_index = transfer1DtoMeshIndex(3 * Arrayi::Ones(), k);
+        const Arrayi split_cell_index = transfer1DtoMeshIndex(color_stride_ * Arrayi::Ones(), k);
         // get the number of cells belonging to the split cell k
-        // i_max = (M - m - 1) / 3 + 1, j_max = (N - n - 1) / 3 + 1
+        // i_max = (M - m - 1) / 3 + 1, j_max = (N - n - 1) / 3 + 1 for the color stride 3
         // e.g. all_cells = (M,N) = (6, 9), (m, n) = (1, 1), then i_max = 2, j_max = 3
-        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / 3 + Arrayi::Ones();
+        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / color_stride_ + Arrayi::Ones();
         const size_t number_of_cells = all_cells_k.prod(); // i_max * j_max
 
         // looping over all cells in the split cell k
@@ -105,9 +315,9 @@ void CellLinkedList::particle_for_split(const execution::SequencedPolicy &, cons
             // (i , j) = (m + 3 * (l / j_max), n + 3 * l % i_max)
             // e.g. all_cells = (M,N) = (6, 9), (m, n) = (1, 1), l = 0, then (i, j) = (1, 1)
             // l = 1, then (i, j) = (1, 4), l = 3, then (i, j) = (4, 1), etc.
-            const Arrayi cell_index = split_cell_index + 3 * transfer1DtoMeshIndex(all_cells_k, l);
+            const Arrayi cell_index = split_cell_index + color_stride_ * transfer1DtoMeshIndex(all_cells_k, l);
             // get the list of particles in the cell (i, j)
-            const ConcurrentIndexVector &cell_list = getCellDataList(cell_index_lists_, cell_index);
+            const CellParticles &cell_list = getCellDataList(cell_particles_.data(), cell_index);
             // looping over all particles in the cell (i, j)
             for (const size_t index_i : cell_list)
             {
@@ -115,44 +325,25 @@ void CellLinkedList::particle_for_split(const execution::SequencedPolicy &, cons
             }
         }
     }
-
-    // backward sweeping
-    for (size_t k = number_of_split_cell_lists_; k != 0; --k)
-    {
-        const Arrayi split_cell_index = transfer1DtoMeshIndex(3 * Arrayi::Ones(), k - 1);
-        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / 3 + Arrayi::Ones();
-        const size_t number_of_cells = all_cells_k.prod();
-
-        for (size_t l = 0; l < number_of_cells; l++)
-        {
-            const Arrayi cell_index = split_cell_index + 3 * transfer1DtoMeshIndex(all_cells_k, l);
-            const ConcurrentIndexVector &cell_list = getCellDataList(cell_index_lists_, cell_index);
-            for (size_t i = cell_list.size(); i != 0; --i)
-            {
-                local_dynamics_function(cell_list[i - 1]);
-            }
-        }
-    }
 }
 //=================================================================================================//
 template <class LocalDynamicsFunction>
-void CellLinkedList::particle_for_split(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function)
+void CellLinkedList::particle_for_colored(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function)
 {
-    // foward sweeping
     for (size_t k = 0; k < number_of_split_cell_lists_; k++)
     {
-        const Arrayi split_cell_index = transfer1DtoMeshIndex(3 * Arrayi::Ones(), k);
-        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / 3 + Arrayi::Ones();
+        const Arrayi split_cell_index = transfer1DtoMeshIndex(color_stride_ * Arrayi::Ones(), k);
+        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / color_stride_ + Arrayi::Ones();
         const size_t number_of_cells = all_cells_k.prod();
 
-        parallel_for(
+        arena_parallel_for(
             IndexRange(0, number_of_cells),
             [&](const IndexRange &r)
             {
                 for (size_t l = r.begin(); l < r.end(); ++l)
                 {
-                    const Arrayi cell_index = split_cell_index + 3 * transfer1DtoMeshIndex(all_cells_k, l);
-                    const ConcurrentIndexVector &cell_list = getCellDataList(cell_index_lists_, cell_index);
+                    const Arrayi cell_index = split_cell_index + color_stride_ * transfer1DtoMeshIndex(all_cells_k, l);
+                    const CellParticles &cell_list = getCellDataList(cell_particles_.data(), cell_index);
                     for (const size_t index_i : cell_list)
                     {
                         local_dynamics_function(index_i);
@@ -161,26 +352,77 @@ void CellLinkedList::particle_for_split(const execution::ParallelPolicy &, const
             },
             ap);
     }
-
-    // backward sweeping
-    for (size_t k = number_of_split_cell_lists_; k != 0; --k)
+}
+//=================================================================================================//
+template <class LocalDynamicsFunction>
+void CellLinkedList::sweepCellBlock(const Arrayi &block_index, bool is_forward,
+                                    const LocalDynamicsFunction &local_dynamics_function)
+{
+    const int block_width = 2 * subdivision_;
+    const size_t cells_in_block = static_cast<size_t>(pow(block_width, Dimensions));
+    for (size_t m = 0; m != cells_in_block; ++m)
     {
-        const Arrayi split_cell_index = transfer1DtoMeshIndex(3 * Arrayi::Ones(), k - 1);
-        const Arrayi all_cells_k = (all_cells_ - split_cell_index - Arrayi::Ones()) / 3 + Arrayi::Ones();
-        const size_t number_of_cells = all_cells_k.prod();
+        const Arrayi cell_offset = transfer1DtoMeshIndex(block_width * Arrayi::Ones(), is_forward ? m : cells_in_block - 1 - m);
+        const Arrayi cell_index = block_width * block_index + cell_offset;
+        if ((cell_index < all_cells_).all())
+        {
+            const CellParticles &cell_list = getCellDataList(cell_particles_.data(), cell_index);
+            if (is_forward)
+            {
+                for (const size_t index_i : cell_list)
+                    local_dynamics_function(index_i);
+            }
+            else
+            {
+                for (size_t i = cell_list.size(); i != 0; --i)
+                    local_dynamics_function(cell_list[i - 1]);
+            }
+        }
+    }
+}
+//=================================================================================================//
+template <class LocalDynamicsFunction>
+void CellLinkedList::particle_for_block_split(const execution::SequencedPolicy &, const LocalDynamicsFunction &local_dynamics_function)
+{
+    const size_t number_of_block_colors = 1 << Dimensions;
+    const Arrayi all_blocks = (all_cells_ + (2 * subdivision_ - 1) * Arrayi::Ones()) / (2 * subdivision_);
+    for (size_t s = 0; s != 2 * number_of_block_colors; ++s)
+    {
+        // forward sweeping followed by backward sweeping
+        bool is_forward = s < number_of_block_colors;
+        size_t k = is_forward ? s : 2 * number_of_block_colors - 1 - s;
+        const Arrayi block_color = transfer1DtoMeshIndex(2 * Arrayi::Ones(), k);
+        const Arrayi all_blocks_k = (all_blocks - block_color - Arrayi::Ones()) / 2 + Arrayi::Ones();
+        const size_t number_of_blocks = all_blocks_k.prod();
+        for (size_t l = 0; l < number_of_blocks; l++)
+        {
+            size_t block = is_forward ? l : number_of_blocks - 1 - l;
+            sweepCellBlock(block_color + 2 * transfer1DtoMeshIndex(all_blocks_k, block), is_forward, local_dynamics_function);
+        }
+    }
+}
+//=================================================================================================//
+template <class LocalDynamicsFunction>
+void CellLinkedList::particle_for_block_split(const execution::ParallelPolicy &, const LocalDynamicsFunction &local_dynamics_function)
+{
+    const size_t number_of_block_colors = 1 << Dimensions;
+    const Arrayi all_blocks = (all_cells_ + (2 * subdivision_ - 1) * Arrayi::Ones()) / (2 * subdivision_);
+    for (size_t s = 0; s != 2 * number_of_block_colors; ++s)
+    {
+        // forward sweeping followed by backward sweeping
+        bool is_forward = s < number_of_block_colors;
+        size_t k = is_forward ? s : 2 * number_of_block_colors - 1 - s;
+        const Arrayi block_color = transfer1DtoMeshIndex(2 * Arrayi::Ones(), k);
+        const Arrayi all_blocks_k = (all_blocks - block_color - Arrayi::Ones()) / 2 + Arrayi::Ones();
+        const size_t number_of_blocks = all_blocks_k.prod();
 
-        parallel_for(
-            IndexRange(0, number_of_cells),
+        arena_parallel_for(
+            IndexRange(0, number_of_blocks),
             [&](const IndexRange &r)
             {
                 for (size_t l = r.begin(); l < r.end(); ++l)
                 {
-                    const Arrayi cell_index = split_cell_index + 3 * transfer1DtoMeshIndex(all_cells_k, l);
-                    const ConcurrentIndexVector &cell_list = getCellDataList(cell_index_lists_, cell_index);
-                    for (size_t i = cell_list.size(); i != 0; --i)
-                    {
-                        local_dynamics_function(cell_list[i - 1]);
-                    }
+                    sweepCellBlock(block_color + 2 * transfer1DtoMeshIndex(all_blocks_k, l), is_forward, local_dynamics_function);
                 }
             },
             ap);
@@ -201,4 +443,18 @@ void MultilevelCellLinkedList::particle_for_split(const execution::ParallelPolic
         mesh_levels_[level]->particle_for_split(par, local_dynamics_function);
 }
 //=================================================================================================//
+template <class LocalDynamicsFunction>
+void MultilevelCellLinkedList::particle_for_block_split(const execution::SequencedPolicy &seq, const LocalDynamicsFunction &local_dynamics_function)
+{
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->particle_for_block_split(seq, local_dynamics_function);
+}
+//=================================================================================================//
+template <class LocalDynamicsFunction>
+void MultilevelCellLinkedList::particle_for_block_split(const execution::ParallelPolicy &par, const LocalDynamicsFunction &local_dynamics_function)
+{
+    for (size_t level = 0; level != total_levels_; ++level)
+        mesh_levels_[level]->particle_for_block_split(par, local_dynamics_function);
+}
+//=================================================================================================//
 } // namespace SPH
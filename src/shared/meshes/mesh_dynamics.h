@@ -50,7 +50,7 @@ namespace SPH
 class BaseMeshDynamics
 {
   public:
-    BaseMeshDynamics(MeshWithGridDataPackages<4> &mesh_data)
+    BaseMeshDynamics(MeshWithGridDataPackagesType &mesh_data)
         : mesh_data_(mesh_data),
           all_cells_(mesh_data.AllCells()),
           num_grid_pkgs_(mesh_data.num_grid_pkgs_),
@@ -58,7 +58,7 @@ class BaseMeshDynamics
     virtual ~BaseMeshDynamics(){};
 
   protected:
-    MeshWithGridDataPackages<4> &mesh_data_;
+    MeshWithGridDataPackagesType &mesh_data_;
     Arrayi all_cells_;
     size_t &num_grid_pkgs_;
     std::pair<Arrayi, int>* &meta_data_cell_; 
@@ -77,7 +77,7 @@ class BaseMeshDynamics
     template <typename FunctionOnData>
     void package_parallel_for(const FunctionOnData &function)
     {
-        parallel_for(IndexRange(2, num_grid_pkgs_),
+        arena_parallel_for(IndexRange(2, num_grid_pkgs_),
                     [&](const IndexRange &r)
                     {
                         for (size_t i = r.begin(); i != r.end(); ++i)
@@ -87,6 +87,16 @@ class BaseMeshDynamics
                     },
                     ap);
     }
+
+    /** Iterator on a collection of mesh data packages. sequential computing in the package order. */
+    template <typename FunctionOnData>
+    void package_sequential_for(const FunctionOnData &function)
+    {
+        for (size_t i = 2; i != num_grid_pkgs_; ++i)
+        {
+            function(i);
+        }
+    }
 };
 
 /**
@@ -98,7 +108,7 @@ class MeshAllDynamics : public LocalDynamicsType, public BaseMeshDynamics
 {
   public:
     template <typename... Args>
-    MeshAllDynamics(MeshWithGridDataPackages<4> &mesh_data, Args &&...args)
+    MeshAllDynamics(MeshWithGridDataPackagesType &mesh_data, Args &&...args)
         : LocalDynamicsType(mesh_data, std::forward<Args>(args)...),
           BaseMeshDynamics(mesh_data){};
     virtual ~MeshAllDynamics(){};
@@ -123,7 +133,7 @@ class MeshInnerDynamics : public LocalDynamicsType, public BaseMeshDynamics
 {
   public:
     template <typename... Args>
-    MeshInnerDynamics(MeshWithGridDataPackages<4> &mesh_data, Args &&...args)
+    MeshInnerDynamics(MeshWithGridDataPackagesType &mesh_data, Args &&...args)
         : LocalDynamicsType(mesh_data, std::forward<Args>(args)...),
           BaseMeshDynamics(mesh_data){};
     virtual ~MeshInnerDynamics(){};
@@ -98,6 +98,46 @@ void UpdateKernelIntegrals::update(const size_t &package_index)
         { return computeKernelGradientIntegral(position); });
 }
 //=================================================================================================//
+void KernelIntegralsOnDemand::resetPackages()
+{
+    number_of_packages_ = mesh_data_.num_grid_pkgs_;
+    is_package_computed_.reset(new std::once_flag[number_of_packages_]);
+    is_neighborhood_prepared_.reset(new std::atomic<bool>[number_of_packages_]);
+    for (size_t i = 0; i != number_of_packages_; ++i)
+        is_neighborhood_prepared_[i].store(false, std::memory_order_relaxed);
+}
+//=================================================================================================//
+void KernelIntegralsOnDemand::preparePackages(const Vecd &position)
+{
+    Arrayi cell_index = mesh_data_.CellIndexFromPosition(position);
+    size_t package_index = mesh_data_.PackageIndexFromCellIndex(cell_index);
+    if (package_index < 2 || is_neighborhood_prepared_[package_index].load(std::memory_order_acquire))
+        return;
+
+    const int *neighborhood = reinterpret_cast<const int *>(&mesh_data_.cell_neighborhood_[package_index]);
+    for (size_t n = 0; n != sizeof(CellNeighborhood) / sizeof(int); ++n)
+    {
+        if (neighborhood[n] > 1)
+            preparePackage(neighborhood[n]);
+    }
+    is_neighborhood_prepared_[package_index].store(true, std::memory_order_release);
+}
+//=================================================================================================//
+void KernelIntegralsOnDemand::prepareAllPackages()
+{
+    arena_parallel_for(
+        IndexRange(2, number_of_packages_),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                preparePackage(i);
+                is_neighborhood_prepared_[i].store(true, std::memory_order_release);
+            }
+        },
+        ap);
+}
+//=================================================================================================//
 void InitializeDataInACellFromCoarse::update(const Arrayi &cell_index)
 {
     Vecd cell_position = mesh_data_.CellPositionFromIndex(cell_index);
@@ -121,5 +161,56 @@ void InitializeDataInACellFromCoarse::update(const Arrayi &cell_index)
     }
 }
 //=================================================================================================//
+void WriteMeshFieldToPlt::update(TecplotBinaryWriter &binary_writer, const std::string &zone_name)
+{
+    const std::string axis_names[3] = {"x", "y", "z"};
+    StdVec<std::string> variable_names;
+    for (int n = 0; n != Dimensions; ++n)
+        variable_names.push_back(axis_names[n]);
+    variable_names.push_back("phi");
+    for (int n = 0; n != Dimensions; ++n)
+        variable_names.push_back("n_" + axis_names[n]);
+    variable_names.push_back("near_interface_id");
+    variable_names.push_back("kernel_weight");
+    for (int n = 0; n != Dimensions; ++n)
+        variable_names.push_back("kernel_gradient_" + axis_names[n]);
+
+    Arrayi all_grid_points = mesh_data_.global_mesh_.AllGridPoints();
+    Array3i zone_size = Array3i::Ones();
+    zone_size.head<Dimensions>() = all_grid_points;
+    TecplotZone &zone = binary_writer.addZone(variable_names, zone_name, zone_size);
+    const int pkg_size = all_grid_points[0] / all_cells_[0]; // grid points of a package in each direction
+
+    mesh_parallel_for(
+        MeshRange(Arrayi::Zero(), all_cells_),
+        [&](const Arrayi &cell_index)
+        {
+            mesh_for_each(
+                Arrayi::Zero(), pkg_size * Arrayi::Ones(),
+                [&](const Arrayi &data_index)
+                {
+                    Arrayi global_index = cell_index * pkg_size + data_index;
+                    size_t point_index = zone.PointIndex(global_index);
+                    Vecd position = mesh_data_.global_mesh_.GridPositionFromIndex(global_index);
+                    Vecd phi_gradient = mesh_data_.DataValueFromGlobalIndex(phi_gradient_, global_index);
+                    Vecd kernel_gradient = mesh_data_.DataValueFromGlobalIndex(kernel_gradient_, global_index);
+
+                    size_t variable_index = 0;
+                    for (int n = 0; n != Dimensions; ++n)
+                        zone.VariableData(variable_index++)[point_index] = position[n];
+                    zone.VariableData(variable_index++)[point_index] =
+                        mesh_data_.DataValueFromGlobalIndex(phi_, global_index);
+                    for (int n = 0; n != Dimensions; ++n)
+                        zone.VariableData(variable_index++)[point_index] = phi_gradient[n];
+                    zone.VariableData(variable_index++)[point_index] =
+                        Real(mesh_data_.DataValueFromGlobalIndex(near_interface_id_, global_index));
+                    zone.VariableData(variable_index++)[point_index] =
+                        mesh_data_.DataValueFromGlobalIndex(kernel_weight_, global_index);
+                    for (int n = 0; n != Dimensions; ++n)
+                        zone.VariableData(variable_index++)[point_index] = kernel_gradient[n];
+                });
+        });
+}
+//=================================================================================================//
 } // namespace SPH
 //=================================================================================================//
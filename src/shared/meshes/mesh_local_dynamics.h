@@ -36,10 +36,11 @@
 #include "base_kernel.h"
 #include "data_type.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace SPH
 {
-using MeshWithGridDataPackagesType = MeshWithGridDataPackages<4>;
-
 /**
  * @class BaseMeshLocalDynamics
  * @brief The base class for all mesh local particle dynamics.
@@ -47,7 +48,7 @@ using MeshWithGridDataPackagesType = MeshWithGridDataPackages<4>;
 class BaseMeshLocalDynamics
 {
   public:
-    explicit BaseMeshLocalDynamics(MeshWithGridDataPackages<4> &mesh_data)
+    explicit BaseMeshLocalDynamics(MeshWithGridDataPackagesType &mesh_data)
         : mesh_data_(mesh_data),
           all_cells_(mesh_data.AllCells()),
           grid_spacing_(mesh_data.GridSpacing()),
@@ -60,7 +61,7 @@ class BaseMeshLocalDynamics
     virtual ~BaseMeshLocalDynamics(){};
 
   protected:
-    MeshWithGridDataPackages<4> &mesh_data_;
+    MeshWithGridDataPackagesType &mesh_data_;
     Arrayi all_cells_;
     Real grid_spacing_;
     Real data_spacing_;
@@ -78,7 +79,7 @@ class BaseMeshLocalDynamics
 class InitializeDataForSingularPackage : public BaseMeshLocalDynamics
 {
   public:
-    explicit InitializeDataForSingularPackage(MeshWithGridDataPackages<4> &mesh_data)
+    explicit InitializeDataForSingularPackage(MeshWithGridDataPackagesType &mesh_data)
         : BaseMeshLocalDynamics(mesh_data){};
     virtual ~InitializeDataForSingularPackage(){};
 
@@ -88,7 +89,7 @@ class InitializeDataForSingularPackage : public BaseMeshLocalDynamics
 class InitializeDataInACell : public BaseMeshLocalDynamics
 {
   public:
-    explicit InitializeDataInACell(MeshWithGridDataPackages<4> &mesh_data, Shape &shape)
+    explicit InitializeDataInACell(MeshWithGridDataPackagesType &mesh_data, Shape &shape)
         : BaseMeshLocalDynamics(mesh_data),
           shape_(shape){};
     virtual ~InitializeDataInACell(){};
@@ -149,7 +150,7 @@ class InitializeBasicDataForAPackage : public BaseMeshLocalDynamics
 class UpdateLevelSetGradient : public BaseMeshLocalDynamics
 {
   public:
-    explicit UpdateLevelSetGradient(MeshWithGridDataPackages<4> &mesh_data)
+    explicit UpdateLevelSetGradient(MeshWithGridDataPackagesType &mesh_data)
         : BaseMeshLocalDynamics(mesh_data){};
     virtual ~UpdateLevelSetGradient(){};
 
@@ -192,6 +193,43 @@ class UpdateKernelIntegrals : public BaseMeshLocalDynamics
     }
 };
 
+/**
+ * @class KernelIntegralsOnDemand
+ * @brief The kernel integrals of a package are computed when the package is first probed.
+ * @details The packages neighboring a probed one are also computed,
+ *          as they provide the data for interpolation.
+ *          Each package is computed only once even if probed by several threads.
+ */
+class KernelIntegralsOnDemand : public BaseMeshLocalDynamics
+{
+  public:
+    explicit KernelIntegralsOnDemand(MeshWithGridDataPackagesType &mesh_data, Kernel &kernel, Real global_h_ratio)
+        : BaseMeshLocalDynamics(mesh_data),
+          update_kernel_integrals_(mesh_data, kernel, global_h_ratio)
+    {
+        resetPackages();
+    };
+    virtual ~KernelIntegralsOnDemand(){};
+
+    /** all packages are computed again on demand, e.g. after the level set is changed */
+    void resetPackages();
+    void preparePackages(const Vecd &position);
+    void prepareAllPackages();
+
+  private:
+    UpdateKernelIntegrals update_kernel_integrals_;
+    size_t number_of_packages_;
+    UniquePtr<std::once_flag[]> is_package_computed_;
+    UniquePtr<std::atomic<bool>[]> is_neighborhood_prepared_;
+
+    void preparePackage(size_t package_index)
+    {
+        std::call_once(is_package_computed_[package_index],
+                       [&]()
+                       { update_kernel_integrals_.update(package_index); });
+    };
+};
+
 class ReinitializeLevelSet : public BaseMeshLocalDynamics
 {
   public:
@@ -255,7 +293,8 @@ class DiffuseLevelSetSign : public BaseMeshLocalDynamics
         : BaseMeshLocalDynamics(mesh_data){};
     virtual ~DiffuseLevelSetSign(){};
 
-    void update(const size_t &package_index);
+    /** repeated within the package until no sign is changed, returns true if any is changed */
+    bool update(const size_t &package_index);
 };
 
 class InitializeDataInACellFromCoarse : public BaseMeshLocalDynamics
@@ -359,6 +398,8 @@ class WriteMeshFieldToPlt : public BaseMeshLocalDynamics
     virtual ~WriteMeshFieldToPlt(){};
 
     void update(std::ofstream &output_file);
+    /** the data are gathered package by package in parallel into a zone of the binary file */
+    void update(TecplotBinaryWriter &binary_writer, const std::string &zone_name);
 };
 } // namespace SPH
 #endif // MESH_LOCAL_DYNAMICS_H
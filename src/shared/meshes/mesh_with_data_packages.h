@@ -30,7 +30,9 @@
 #define MESH_WITH_DATA_PACKAGES_H
 
 #include "base_mesh.h"
+#include "binary_data_file.h"
 #include "my_memory_pool.h"
+#include "package_index_mesh.h"
 #include "sphinxsys_variable.h"
 #include "tbb/parallel_sort.h"
 #include "mesh_iterators.h"
@@ -58,8 +60,10 @@ namespace SPH
  * and then the address matrix by the function initializeAddressesInACell.
  * All these data packages are indexed by a concurrent vector inner_data_pkgs_.
  * Note that a data package should be not near the mesh bound, otherwise one will encounter the error "out of range".
+ * The package index of each cell is kept by the PackageIndexMeshType,
+ * which is either dense or tiled for huge domains, see package_index_mesh.h.
  */
-template <int PKG_SIZE>
+template <int PKG_SIZE, class PackageIndexMeshType = DensePackageIndexMesh>
 class MeshWithGridDataPackages : public Mesh
 {
   private:
@@ -70,13 +74,9 @@ class MeshWithGridDataPackages : public Mesh
     explicit MeshWithGridDataPackages(BoundingBox tentative_bounds, Real data_spacing, size_t buffer_size)
         : Mesh(tentative_bounds, pkg_size * data_spacing, buffer_size),
           global_mesh_(mesh_lower_bound_ + 0.5 * data_spacing * Vecd::Ones(), data_spacing, all_cells_ * pkg_size),
-          data_spacing_(data_spacing)
-    {
-        allocateIndexDataMatrix();
-    };
+          data_spacing_(data_spacing), index_data_mesh_(all_cells_){};
     virtual ~MeshWithGridDataPackages()
     {
-        deleteIndexDataMatrix();
         delete[] cell_neighborhood_;
         delete[] meta_data_cell_;
     };
@@ -87,8 +87,8 @@ class MeshWithGridDataPackages : public Mesh
 
   public:
     ConcurrentVec<std::pair<size_t, int>> occupied_data_pkgs_; /**< (size_t)sort_index, (int)core1/inner0. */
-    CellNeighborhood *cell_neighborhood_;                  /**< 3*3(*3) array to store indicies of neighborhood cells. */
-    std::pair<Arrayi, int> *meta_data_cell_;          /**< metadata for each occupied cell: (arrayi)cell index, (int)core1/inner0. */
+    CellNeighborhood *cell_neighborhood_ = nullptr;        /**< 3*3(*3) array to store indicies of neighborhood cells. */
+    std::pair<Arrayi, int> *meta_data_cell_ = nullptr; /**< metadata for each occupied cell: (arrayi)cell index, (int)core1/inner0. */
     Mesh global_mesh_;                            /**< the mesh for the locations of all possible data points. */
     size_t num_grid_pkgs_ = 2;                        /**< the number of all distinct packages, initially only 2 singular packages. */
 
@@ -97,7 +97,7 @@ class MeshWithGridDataPackages : public Mesh
     static constexpr int pkg_size = PKG_SIZE;         /**< the size of the data package matrix*/
     const Real data_spacing_;                         /**< spacing of data in the data packages*/
     using MetaData = std::pair<int, size_t>;          /**< stores the metadata for each cell: (int)singular0/inner1/core2, (size_t)package data index*/
-    MeshDataMatrix<size_t> index_data_mesh_;         /**< metadata for all cells. */
+    PackageIndexMeshType index_data_mesh_;           /**< package index of all cells. */
     using NeighbourIndex = std::pair<size_t, Arrayi>; /**< stores shifted neighbour info: (size_t)package index, (arrayi)local grid index. */
     template <typename DataType>
     using PackageData = PackageDataMatrix<DataType, pkg_size>;
@@ -105,9 +105,6 @@ class MeshWithGridDataPackages : public Mesh
     template <typename DataType>
     using PackageTemporaryData = PackageDataMatrix<DataType, pkg_size + 1>;
 
-    void allocateIndexDataMatrix(); /**< allocate memories for metadata of data packages. */
-    void deleteIndexDataMatrix();   /**< delete memories for metadata of data packages. */
-
     /** resize all mesh variable data field with `num_grid_pkgs_` size(initially only singular data) */
     struct ResizeMeshVariableData
     {
@@ -124,6 +121,59 @@ class MeshWithGridDataPackages : public Mesh
     };
     OperationOnDataAssemble<MeshVariableAssemble, ResizeMeshVariableData> resize_mesh_variable_data_{all_mesh_variables_};
 
+    /** write or read the data fields of all mesh variables, the data is named by the variable name */
+    struct WriteMeshVariableData
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<MeshVariable<DataType>> &all_mesh_variables_,
+                        BinaryDataWriter &binary_writer, const std::string &prefix, const size_t num_grid_pkgs_)
+        {
+            for (size_t l = 0; l != all_mesh_variables_.size(); ++l)
+            {
+                MeshVariable<DataType> *variable = all_mesh_variables_[l];
+                binary_writer.writeVariable(prefix + variable->Name(), reinterpret_cast<const DataType *>(variable->DataField()),
+                                            num_grid_pkgs_ * sizeof(PackageData<DataType>) / sizeof(DataType));
+            }
+        }
+    };
+    OperationOnDataAssemble<MeshVariableAssemble, WriteMeshVariableData> write_mesh_variable_data_{all_mesh_variables_};
+
+    /** checks that all mesh variables are in the file with the expected types and sizes */
+    struct CheckMeshVariableData
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<MeshVariable<DataType>> &all_mesh_variables_,
+                        BinaryDataReader &binary_reader, const std::string &prefix,
+                        const size_t num_grid_pkgs, bool &is_complete)
+        {
+            for (size_t l = 0; l != all_mesh_variables_.size(); ++l)
+            {
+                MeshVariable<DataType> *variable = all_mesh_variables_[l];
+                size_t data_size = num_grid_pkgs * sizeof(PackageData<DataType>) / sizeof(DataType);
+                is_complete = is_complete && binary_reader.hasVariable<DataType>(prefix + variable->Name(), data_size);
+            }
+        }
+    };
+    OperationOnDataAssemble<MeshVariableAssemble, CheckMeshVariableData> check_mesh_variable_data_{all_mesh_variables_};
+
+    struct ReadMeshVariableData
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<MeshVariable<DataType>> &all_mesh_variables_,
+                        BinaryDataReader &binary_reader, const std::string &prefix, const size_t num_grid_pkgs_)
+        {
+            for (size_t l = 0; l != all_mesh_variables_.size(); ++l)
+            {
+                MeshVariable<DataType> *variable = all_mesh_variables_[l];
+                size_t data_size = num_grid_pkgs_ * sizeof(PackageData<DataType>) / sizeof(DataType);
+                binary_reader.readVariable(prefix + variable->Name(),
+                                           reinterpret_cast<DataType *>(variable->DataField()), data_size);
+            }
+        }
+    };
+    OperationOnDataAssemble<MeshVariableAssemble, ReadMeshVariableData> read_mesh_variable_data_{all_mesh_variables_};
+    bool checkMeshVariablesInBinary(BinaryDataReader &binary_reader, const std::string &prefix, size_t num_grid_pkgs);
+
     /** probe by applying bi and tri-linear interpolation within the package. */
     template <class DataType>
     DataType probeDataPackage(MeshVariable<DataType> &mesh_variable, size_t package_index, const Arrayi &cell_index, const Vecd &position);
@@ -178,6 +228,20 @@ class MeshWithGridDataPackages : public Mesh
     {
         resize_mesh_variable_data_(num_grid_pkgs_);
     }
+    /** the memory of the package data of all mesh variables and the package metadata in bytes */
+    size_t MemoryFootprint()
+    {
+        size_t bytes = num_grid_pkgs_ * (sizeof(CellNeighborhood) + sizeof(std::pair<Arrayi, int>));
+        std::apply([&](auto &...variables_of_type)
+                   { ((bytes += PackageDataFootprint(variables_of_type)), ...); },
+                   all_mesh_variables_);
+        return bytes;
+    }
+    template <typename DataType>
+    size_t PackageDataFootprint(DataContainerAddressKeeper<MeshVariable<DataType>> &variables)
+    {
+        return variables.size() * num_grid_pkgs_ * sizeof(typename MeshVariable<DataType>::PackageData);
+    }
 
     template <typename DataType>
     MeshVariable<DataType> *getMeshVariable(const std::string &variable_name)
@@ -229,6 +293,15 @@ class MeshWithGridDataPackages : public Mesh
         return isCoreDataPackage(cell_index);
     }
 
+    /** write the package structure and the data of all mesh variables, all named with the prefix */
+    void writeMeshToBinary(BinaryDataWriter &binary_writer, const std::string &prefix = "");
+    /** restore the package structure and the data of all registered mesh variables,
+     *  returns false, with this mesh unchanged, if the stored mesh does not match or is incomplete */
+    bool readMeshFromBinary(BinaryDataReader &binary_reader, const std::string &prefix = "");
+    /** restore only the data of all mesh variables, the package structure is kept,
+     *  returns false, with the data unchanged, if a variable is missing or incomplete */
+    bool readMeshVariablesFromBinary(BinaryDataReader &binary_reader, const std::string &prefix = "");
+
     template <typename DataType>
     MeshVariable<DataType> *registerMeshVariable(const std::string &variable_name)
     {
@@ -244,5 +317,11 @@ class MeshWithGridDataPackages : public Mesh
         return variable;
     };
 };
+
+#if SPHINXSYS_USE_TILED_INDEX_MESH
+using MeshWithGridDataPackagesType = MeshWithGridDataPackages<4, TiledPackageIndexMesh>;
+#else
+using MeshWithGridDataPackagesType = MeshWithGridDataPackages<4>;
+#endif
 } // namespace SPH
 #endif // MESH_WITH_DATA_PACKAGES_H
@@ -22,82 +22,112 @@
  * ------------------------------------------------------------------------- */
 /**
  * @file 	my_memory_pool.h
- * @brief 	A class template for scalable memory allocation from memory blocks provided by an underlying allocator.
- * @details A memory_pool allocates and frees memory in a way that scales with the number of processors.
- *			The memory is obtained as big chunks from an underlying allocator specified by the template argument.
- *			The latter must satisfy the subset of the allocator requirements from the [allocator.requirements] ISO C++ Standard section.
- *			A memory_pool meet the Memory Pool named requirement.
+ * @brief 	A class template for scalable memory allocation of data packages.
+ * @details The nodes are allocated contiguously in big chunks aligned to cache lines,
+ *			in the order of allocation, by an atomic counter without locking,
+ *			a mutex is only used when a new chunk is required.
+ *			Freed nodes are kept in per-thread free lists for reuse.
+ *			All nodes are released together by releaseAll or at destruction.
  * @author	Chi Zhang and Xiangyu Hu
  */
 
 #ifndef MY_MEMORY_POOL_H
 #define MY_MEMORY_POOL_H
 
-#define TBB_PREVIEW_MEMORY_POOL 1
-
+#include "tbb/concurrent_vector.h"
 #include "tbb/enumerable_thread_specific.h"
-#include "tbb/memory_pool.h"
 
-#include <list>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
 
 /**
  * @class MyMemoryPool
  * @brief Note that the data package T should has a default constructor.
+ *		  A reused node is not constructed again.
  */
 template <class T>
 class MyMemoryPool
 {
+    static constexpr size_t cache_line_size = 64;
+    static constexpr size_t chunk_alignment = alignof(T) > cache_line_size ? alignof(T) : cache_line_size;
+    const size_t chunk_size_;                             /**< number of nodes in a chunk. */
+    tbb::concurrent_vector<T *> chunks_;                  /**< all chunks allocated. */
+    std::atomic<size_t> number_of_chunks_;                /**< chunks ready for use. */
+    std::atomic<size_t> number_of_nodes_;                 /**< nodes handed out from the chunks. */
+    std::mutex chunk_mutex_;                              /**< only for allocating new chunks. */
+    tbb::enumerable_thread_specific<std::vector<T *>> free_lists_; /**< free nodes of each thread. */
 
-#ifdef __EMSCRIPTEN__
-    std::allocator<T> my_pool; /**< memory pool. */
-    std::list<T> data_list;    /**< list of all nodes allocated. */
-#else
-    tbb::memory_pool<std::allocator<T>> my_pool;            /**< memory pool. */
-    typedef tbb::memory_pool_allocator<T> pool_allocator_t; /**< memory allocator. */
-    std::list<T, pool_allocator_t> data_list;               /**< list of all nodes allocated. */
-#endif
-    std::list<T *> free_list; /**< list of all free nodes. */
+    T *allocateChunk()
+    {
+        return static_cast<T *>(::operator new(chunk_size_ * sizeof(T), std::align_val_t(chunk_alignment)));
+    };
+
+    T *NodeAddress(size_t node_index)
+    {
+        size_t chunk_index = node_index / chunk_size_;
+        if (chunk_index >= number_of_chunks_.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(chunk_mutex_);
+            while (chunk_index >= number_of_chunks_.load(std::memory_order_relaxed))
+            {
+                chunks_.push_back(allocateChunk());
+                number_of_chunks_.fetch_add(1, std::memory_order_release);
+            }
+        }
+        return chunks_[chunk_index] + node_index % chunk_size_;
+    };
 
   public:
-#ifdef __EMSCRIPTEN__
-    MyMemoryPool() : data_list(my_pool){};
-#else
-    MyMemoryPool() : data_list(pool_allocator_t(my_pool)){};
-#endif
+    explicit MyMemoryPool(size_t chunk_size = 1024)
+        : chunk_size_(chunk_size), number_of_chunks_(0), number_of_nodes_(0){};
+    ~MyMemoryPool() { releaseAll(); };
 
-    ~MyMemoryPool(){
-        // my_pool.recycle();
-    };
     /**  Prepare an available node. */
     template <typename... Args>
     T *malloc(Args &&...args)
     {
-        if (free_list.empty())
-        {
-            data_list.emplace_back(std::forward<Args>(args)...);
-            return (&data_list.back());
-        }
-        else
+        std::vector<T *> &free_list = free_lists_.local();
+        if (!free_list.empty())
         {
-            T *result = free_list.front();
-            free_list.pop_front();
+            T *result = free_list.back();
+            free_list.pop_back();
             return result;
         }
+        size_t node_index = number_of_nodes_.fetch_add(1, std::memory_order_relaxed);
+        return new (NodeAddress(node_index)) T(std::forward<Args>(args)...);
     };
     /** Relinquish an unused node. */
     void free(T *ptr)
     {
-        free_list.push_back(ptr);
+        free_lists_.local().push_back(ptr);
+    };
+    /** Release all nodes at once, not to be called concurrently with other functions. */
+    void releaseAll()
+    {
+        size_t number_of_nodes = number_of_nodes_.load();
+        for (size_t i = 0; i != number_of_nodes; ++i)
+            (chunks_[i / chunk_size_] + i % chunk_size_)->~T();
+        for (size_t i = 0; i != chunks_.size(); ++i)
+            ::operator delete(chunks_[i], std::align_val_t(chunk_alignment));
+        chunks_.clear();
+        number_of_chunks_ = 0;
+        number_of_nodes_ = 0;
+        free_lists_.clear();
     };
     /** Return the total number of nodes allocated. */
     int capacity()
     {
-        return data_list.size();
+        return number_of_nodes_.load();
     };
     /** Return the number of current available nodes. */
     int available_node()
     {
-        return free_list.size();
+        int number_of_free_nodes = 0;
+        for (const std::vector<T *> &free_list : free_lists_)
+            number_of_free_nodes += free_list.size();
+        return number_of_free_nodes;
     };
 };
 
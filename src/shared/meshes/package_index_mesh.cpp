@@ -0,0 +1,46 @@
+#include "package_index_mesh.h"
+
+namespace SPH
+{
+//=================================================================================================//
+TiledPackageIndexMesh::TiledPackageIndexMesh(const Arrayi &all_cells)
+    : all_tiles_((all_cells + (tile_size - 1) * Arrayi::Ones()) / tile_size),
+      block_size_(std::pow(tile_size, Dimensions)),
+      tiles_(new std::atomic<size_t>[all_tiles_.prod()])
+{
+    for (int i = 0; i != all_tiles_.prod(); ++i)
+        tiles_[i].store(0, std::memory_order_relaxed);
+}
+//=================================================================================================//
+void TiledPackageIndexMesh::set(const Arrayi &cell_index, size_t package_index)
+{
+    std::atomic<size_t> &tile = tiles_[TileIndex(cell_index)];
+    size_t entry = tile.load(std::memory_order_acquire);
+    if ((entry & block_flag) == 0)
+    {
+        if (entry == package_index)
+            return;
+
+        std::lock_guard<std::mutex> lock(block_mutex_);
+        entry = tile.load(std::memory_order_acquire);
+        if ((entry & block_flag) == 0)
+        {
+            if (entry == package_index)
+                return;
+
+            std::unique_ptr<size_t[]> block(new size_t[block_size_]);
+            std::fill(block.get(), block.get() + block_size_, entry);
+            auto new_block = blocks_.push_back(std::move(block));
+            entry = block_flag | size_t(new_block - blocks_.begin());
+            tile.store(entry, std::memory_order_release);
+        }
+    }
+    blocks_[entry & ~block_flag][IndexInTile(cell_index)] = package_index;
+}
+//=================================================================================================//
+size_t TiledPackageIndexMesh::AllocatedBytes() const
+{
+    return all_tiles_.prod() * sizeof(std::atomic<size_t>) + blocks_.size() * block_size_ * sizeof(size_t);
+}
+//=================================================================================================//
+} // namespace SPH
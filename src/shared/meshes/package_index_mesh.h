@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    package_index_mesh.h
+ * @brief   The storages of the package index of each cell for MeshWithGridDataPackages.
+ * @details The dense one keeps an index for every cell of the mesh.
+ *          The tiled one is a two-level tree: the cells are grouped in tiles,
+ *          and a tile keeps either a uniform index for all its cells,
+ *          like the singular packages far from the interface,
+ *          or refers to a block of indices of its cells.
+ *          Only the tiles cut by the interface hold blocks,
+ *          so that the memory scales with the interface area rather than the domain volume.
+ *          Both give O(1) lookup of a cell.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef PACKAGE_INDEX_MESH_H
+#define PACKAGE_INDEX_MESH_H
+
+#include "base_data_package.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace SPH
+{
+class DensePackageIndexMesh
+{
+  public:
+    explicit DensePackageIndexMesh(const Arrayi &all_cells)
+        : all_cells_(all_cells), package_index_(all_cells.prod(), 0){};
+    ~DensePackageIndexMesh(){};
+
+    size_t get(const Arrayi &cell_index) const { return package_index_[LinearIndex(cell_index)]; };
+    void set(const Arrayi &cell_index, size_t package_index) { package_index_[LinearIndex(cell_index)] = package_index; };
+    size_t AllocatedBytes() const { return package_index_.size() * sizeof(size_t); };
+
+  protected:
+    Arrayi all_cells_;
+    StdVec<size_t> package_index_;
+
+    size_t LinearIndex(const Arrayi &cell_index) const
+    {
+        size_t linear_index = 0;
+        for (int d = 0; d != Dimensions; ++d)
+            linear_index = linear_index * all_cells_[d] + cell_index[d];
+        return linear_index;
+    };
+};
+
+class TiledPackageIndexMesh
+{
+    static constexpr int tile_size = 8; /**< number of cells of a tile in each direction */
+    static constexpr size_t block_flag = size_t(1) << (8 * sizeof(size_t) - 1);
+
+  public:
+    explicit TiledPackageIndexMesh(const Arrayi &all_cells);
+    ~TiledPackageIndexMesh(){};
+
+    size_t get(const Arrayi &cell_index) const
+    {
+        size_t tile = tiles_[TileIndex(cell_index)].load(std::memory_order_acquire);
+        return (tile & block_flag) == 0 ? tile : blocks_[tile & ~block_flag][IndexInTile(cell_index)];
+    };
+    /** thread safe for different cells, a block is only allocated for a tile with different indices */
+    void set(const Arrayi &cell_index, size_t package_index);
+    size_t AllocatedBytes() const;
+
+  protected:
+    Arrayi all_tiles_;
+    size_t block_size_;
+    std::unique_ptr<std::atomic<size_t>[]> tiles_; /**< uniform index, or block index with the block flag */
+    ConcurrentVec<std::unique_ptr<size_t[]>> blocks_;
+    std::mutex block_mutex_;
+
+    size_t TileIndex(const Arrayi &cell_index) const
+    {
+        size_t linear_index = 0;
+        for (int d = 0; d != Dimensions; ++d)
+            linear_index = linear_index * all_tiles_[d] + cell_index[d] / tile_size;
+        return linear_index;
+    };
+    size_t IndexInTile(const Arrayi &cell_index) const
+    {
+        size_t linear_index = 0;
+        for (int d = 0; d != Dimensions; ++d)
+            linear_index = linear_index * tile_size + cell_index[d] % tile_size;
+        return linear_index;
+    };
+};
+} // namespace SPH
+#endif // PACKAGE_INDEX_MESH_H
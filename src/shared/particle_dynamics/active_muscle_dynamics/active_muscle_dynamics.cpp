@@ -10,5 +10,74 @@ MuscleActivation::MuscleActivation(SPHBody &sph_body)
       pos0_(particles_->registerStateVariableFrom<Vecd>("InitialPosition", "Position")),
       active_contraction_stress_(particles_->getVariableDataByName<Real>("ActiveContractionStress")){};
 //=================================================================================================//
+RecordActiveStressAtCouplingPoint::RecordActiveStressAtCouplingPoint(SPHBody &sph_body)
+    : LocalDynamics(sph_body),
+      active_contraction_stress_(particles_->getVariableDataByName<Real>("ActiveContractionStress")),
+      active_stress_start_(particles_->registerStateVariable<Real>("ActiveContractionStressStart")),
+      active_stress_end_(particles_->registerStateVariable<Real>("ActiveContractionStressEnd")) {}
+//=================================================================================================//
+void RecordActiveStressAtCouplingPoint::update(size_t index_i, Real dt)
+{
+    active_stress_start_[index_i] = active_stress_end_[index_i];
+    active_stress_end_[index_i] = active_contraction_stress_[index_i];
+}
+//=================================================================================================//
+InterpolateActiveStressInTime::InterpolateActiveStressInTime(SPHBody &sph_body)
+    : LocalDynamics(sph_body), weight_(1.0),
+      active_contraction_stress_(particles_->getVariableDataByName<Real>("ActiveContractionStress")),
+      active_stress_start_(particles_->registerStateVariable<Real>("ActiveContractionStressStart")),
+      active_stress_end_(particles_->registerStateVariable<Real>("ActiveContractionStressEnd")) {}
+//=================================================================================================//
+void InterpolateActiveStressInTime::update(size_t index_i, Real dt)
+{
+    active_contraction_stress_[index_i] =
+        active_stress_start_[index_i] + weight_ * (active_stress_end_[index_i] - active_stress_start_[index_i]);
+}
+//=================================================================================================//
+MultiRateElectroMechanicsCoupling::MultiRateElectroMechanicsCoupling(
+    SPHBody &mechanics_body, BaseDynamics<void> &active_stress_transfer,
+    BaseDynamics<Real> &physiology_time_step, std::function<void(Real)> physiology_step,
+    BaseDynamics<Real> &mechanics_time_step, std::function<void(Real)> mechanics_step)
+    : BaseDynamics<void>(), active_stress_transfer_(active_stress_transfer),
+      physiology_time_step_(physiology_time_step), physiology_step_(physiology_step),
+      mechanics_time_step_(mechanics_time_step), mechanics_step_(mechanics_step),
+      record_active_stress_(mechanics_body), interpolate_active_stress_(mechanics_body),
+      is_first_interval_(true), physiology_steps_(0), mechanics_steps_(0) {}
+//=================================================================================================//
+void MultiRateElectroMechanicsCoupling::exec(Real dt)
+{
+    if (is_first_interval_)
+    {
+        // the active stress is constant before the first coupling point
+        active_stress_transfer_.exec();
+        record_active_stress_.exec();
+        record_active_stress_.exec();
+        is_first_interval_ = false;
+    }
+
+    Real physiology_time = 0.0;
+    while (physiology_time < dt)
+    {
+        Real dt_p = SMIN(physiology_time_step_.exec(), dt - physiology_time);
+        physiology_step_(dt_p);
+        physiology_time += dt_p;
+        physiology_steps_++;
+    }
+
+    active_stress_transfer_.exec();
+    record_active_stress_.exec();
+
+    Real mechanics_time = 0.0;
+    while (mechanics_time < dt)
+    {
+        Real dt_s = SMIN(mechanics_time_step_.exec(), dt - mechanics_time);
+        interpolate_active_stress_.setInterpolationWeight((mechanics_time + 0.5 * dt_s) / dt);
+        interpolate_active_stress_.exec();
+        mechanics_step_(dt_s);
+        mechanics_time += dt_s;
+        mechanics_steps_++;
+    }
+}
+//=================================================================================================//
 } // namespace active_muscle_dynamics
 } // namespace SPH
@@ -53,6 +53,78 @@ class MuscleActivation : public LocalDynamics
     Vecd *pos0_;
     Real *active_contraction_stress_;
 };
+
+/**
+ * @class RecordActiveStressAtCouplingPoint
+ * @brief Shift the active stress interval of the mechanics body at a coupling point,
+ * i.e. the stress at the end of the previous interval becomes the start of the new one,
+ * and the newly transferred active stress becomes its end.
+ */
+class RecordActiveStressAtCouplingPoint : public LocalDynamics
+{
+  public:
+    explicit RecordActiveStressAtCouplingPoint(SPHBody &sph_body);
+    virtual ~RecordActiveStressAtCouplingPoint(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Real *active_contraction_stress_;
+    Real *active_stress_start_, *active_stress_end_;
+};
+
+/**
+ * @class InterpolateActiveStressInTime
+ * @brief Linear interpolation of the active stress between two coupling points.
+ */
+class InterpolateActiveStressInTime : public LocalDynamics
+{
+  public:
+    explicit InterpolateActiveStressInTime(SPHBody &sph_body);
+    virtual ~InterpolateActiveStressInTime(){};
+    void setInterpolationWeight(Real weight) { weight_ = weight; };
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Real weight_;
+    Real *active_contraction_stress_;
+    Real *active_stress_start_, *active_stress_end_;
+};
+
+/**
+ * @class MultiRateElectroMechanicsCoupling
+ * @brief Advance electrophysiology and active mechanics over a coupling interval
+ * with their own time-step sizes.
+ * @details The physiology is advanced first over the whole interval.
+ * The active stress is transferred to the mechanics body only at the coupling point
+ * and then interpolated in time while the mechanics sub-cycles over the same interval.
+ * The step functions advance the respective bodies by the given time-step size,
+ * e.g. a lambda calling the reaction-diffusion splitting or the stress relaxation.
+ */
+class MultiRateElectroMechanicsCoupling : public BaseDynamics<void>
+{
+  public:
+    MultiRateElectroMechanicsCoupling(SPHBody &mechanics_body, BaseDynamics<void> &active_stress_transfer,
+                                      BaseDynamics<Real> &physiology_time_step,
+                                      std::function<void(Real)> physiology_step,
+                                      BaseDynamics<Real> &mechanics_time_step,
+                                      std::function<void(Real)> mechanics_step);
+    virtual ~MultiRateElectroMechanicsCoupling(){};
+    /** advance both physics over the coupling interval dt */
+    virtual void exec(Real dt = 0.0) override;
+    size_t PhysiologySteps() { return physiology_steps_; };
+    size_t MechanicsSteps() { return mechanics_steps_; };
+
+  protected:
+    BaseDynamics<void> &active_stress_transfer_;
+    BaseDynamics<Real> &physiology_time_step_;
+    std::function<void(Real)> physiology_step_;
+    BaseDynamics<Real> &mechanics_time_step_;
+    std::function<void(Real)> mechanics_step_;
+    SimpleDynamics<RecordActiveStressAtCouplingPoint> record_active_stress_;
+    SimpleDynamics<InterpolateActiveStressInTime> interpolate_active_stress_;
+    bool is_first_interval_;
+    size_t physiology_steps_, mechanics_steps_;
+};
 } // namespace active_muscle_dynamics
 } // namespace SPH
 #endif // ACTIVE_MUSCLE_DYNAMICS_H
\ No newline at end of file
@@ -30,5 +30,7 @@
 #define ALL_PARTICLE_DYNAMICS_H
 
 #include "dynamics_algorithms.h"
+#include "dual_time_stepper.h"
+#include "dynamics_task_graph.h"
 #include "particle_functors.h"
 #endif // ALL_PARTICLE_DYNAMICS_H
\ No newline at end of file
@@ -57,12 +57,16 @@ class BaseLocalDynamics
     explicit BaseLocalDynamics(DynamicsIdentifier &identifier)
         : identifier_(identifier), sph_system_(identifier.getSPHSystem()),
           sph_body_(identifier.getSPHBody()),
-          particles_(&sph_body_.getBaseParticles()){};
+          particles_(&sph_body_.getBaseParticles())
+    {
+        DataAccessRecording::record(&sph_body_);
+    };
     virtual ~BaseLocalDynamics(){};
     DynamicsIdentifier &getDynamicsIdentifier() { return identifier_; };
     SPHBody &getSPHBody() { return sph_body_; };
     BaseParticles *getParticles() { return particles_; };
-    virtual void setupDynamics(Real dt = 0.0){}; // setup global parameters
+    virtual void setupDynamics(Real dt = 0.0){};  // setup global parameters
+    virtual void finishDynamics(Real dt = 0.0){}; // batched operations after the particle loop
     void registerComputingKernel(Implementation<Base> *implementation)
     {
         sph_body_.registerComputingKernel(implementation);
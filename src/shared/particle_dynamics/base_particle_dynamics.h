@@ -34,8 +34,13 @@
 #include "all_body_relations.h"
 #include "base_body.h"
 #include "base_data_package.h"
+#include "instrumentation.h"
 #include "neighborhood.h"
 #include "sphinxsys_containers.h"
+#include "timeline_tracer.h"
+
+#include <boost/core/demangle.hpp>
+#include <typeinfo>
 
 namespace SPH
 {
@@ -59,14 +64,134 @@ class BaseDynamics
         sph_body.setNewlyUpdated();
         is_newly_updated_ = true;
     };
+    /** estimated memory traffic per particle for the profiling report */
+    void setProfilingBytesPerParticle(size_t bytes_per_particle)
+    {
+        profiling_bytes_per_particle_ = bytes_per_particle;
+        if (profiling_record_ != nullptr)
+            profiling_record_->given_bytes_per_particle_ = bytes_per_particle;
+    };
+    /** label of the instrumentation region instead of the identifier and type name,
+     *  only used if built with instrumentation */
+    void setInstrumentationLabel(const std::string &label)
+    {
+#if SPHINXSYS_USE_INSTRUMENTATION
+        instrumentation_label_ = label;
+#endif
+    };
 
     /** There is the interface functions for computing. */
     virtual ReturnType exec(Real dt = 0.0) = 0;
 
+  protected:
+    size_t profiling_bytes_per_particle_ = 0;
+    bool is_profiling_checked_ = false;
+    DynamicsProfiler::Record *profiling_record_ = nullptr;
+    std::string timeline_name_;
+#if SPHINXSYS_USE_INSTRUMENTATION
+    std::string instrumentation_label_;
+    InstrumentationRegion *instrumentation_region_ = nullptr;
+
+    InstrumentationRegion *instrumentationRegion(const std::string &identifier_name)
+    {
+        if (instrumentation_region_ == nullptr)
+        {
+            instrumentation_region_ = InstrumentationRegion::getRegion(
+                !instrumentation_label_.empty() ? instrumentation_label_
+                                                : identifier_name + ": " + boost::core::demangle(typeid(*this).name()));
+        }
+        return instrumentation_region_;
+    };
+#endif
+
+    /** the scopes opened for each call of exec(), closed in reverse order */
+    struct DynamicsScope
+    {
+#if SPHINXSYS_USE_INSTRUMENTATION
+        InstrumentationRegion::Scope region_scope_;
+#endif
+        TimelineTracer::Scope timeline_scope_;
+        DynamicsProfiler::Scope profiler_scope_;
+    };
+
+    /** name of the timeline event, composed only once tracing is enabled */
+    const std::string &timelineName(const std::string &identifier_name)
+    {
+        if (timeline_name_.empty() && TimelineTracer::isEnabled())
+            timeline_name_ = identifier_name + ": " + boost::core::demangle(typeid(*this).name());
+        return timeline_name_;
+    };
+
+    /** registered in the system profiler at the first call if profiling is enabled */
+    DynamicsProfiler::Record *profilingRecord(SPHSystem &sph_system, const std::string &identifier_name)
+    {
+        if (!is_profiling_checked_)
+        {
+            is_profiling_checked_ = true;
+            DynamicsProfiler &dynamics_profiler = sph_system.getDynamicsProfiler();
+            if (dynamics_profiler.isEnabled())
+            {
+                profiling_record_ = dynamics_profiler.registerDynamics(
+                    identifier_name + ": " + boost::core::demangle(typeid(*this).name()),
+                    profiling_bytes_per_particle_);
+            }
+        }
+        return profiling_record_;
+    };
+
+    template <class DynamicsIdentifier>
+    auto profilingScope(SPHSystem &sph_system, DynamicsIdentifier &identifier)
+    {
+        DynamicsProfiler::Record *record = profilingRecord(sph_system, identifier.getName());
+        return DynamicsScope{
+#if SPHINXSYS_USE_INSTRUMENTATION
+            InstrumentationRegion::Scope(instrumentationRegion(identifier.getName())),
+#endif
+            TimelineTracer::Scope("dynamics", timelineName(identifier.getName())),
+            DynamicsProfiler::Scope(record, record != nullptr ? identifier.SizeOfLoopRange() : 0)};
+    };
+
   private:
     bool is_newly_updated_;
 };
 
+/**
+ * @class ConcurrentGroup
+ * @brief Executes dynamics without dependence on each other, typically on different bodies,
+ * concurrently as tasks, so that the particle loops of small bodies share the thread pool.
+ * The particle loops within each dynamics are still parallel as given by their execution policies.
+ * Dynamics in a group should neither write the data read by another nor reduce into shared data.
+ * As a stateful tbb::affinity_partitioner must not be used by concurrent loops, the loops of the dynamics
+ * in a group use tbb::auto_partitioner instead of an affinity partitioner, see ConcurrentTaskScope.
+ * For the same reason, a dynamics with its own LoopPartitioner should be added to a group only once.
+ */
+class ConcurrentGroup : public BaseDynamics<void>
+{
+    StdVec<BaseDynamics<void> *> dynamics_;
+
+  public:
+    template <class... DynamicsType>
+    explicit ConcurrentGroup(DynamicsType &...dynamics)
+        : BaseDynamics<void>(), dynamics_{&dynamics...} {};
+    virtual ~ConcurrentGroup() {};
+    void add(BaseDynamics<void> &dynamics) { dynamics_.push_back(&dynamics); };
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        arena_parallel_for(
+            IndexRange(0, dynamics_.size(), 1),
+            [&](const IndexRange &r)
+            {
+                for (size_t k = r.begin(); k != r.end(); ++k)
+                {
+                    ConcurrentTaskScope concurrent_task_scope;
+                    dynamics_[k]->exec(dt);
+                }
+            },
+            tbb::simple_partitioner());
+    };
+};
+
 /**
  * @class DataDelegateInner
  * @brief prepare data for inner particle dynamics
@@ -78,13 +203,16 @@ class DataDelegateInner
   public:
     explicit DataDelegateInner(BaseInnerRelation &inner_relation)
         : inner_relation_(inner_relation),
-          inner_configuration_(inner_relation.inner_configuration_) {};
+          inner_configuration_(inner_relation.inner_configuration_),
+          compact_inner_configuration_(inner_relation.compact_inner_configuration_) {};
     virtual ~DataDelegateInner() {};
     BaseInnerRelation &getBodyRelation() { return inner_relation_; };
 
   protected:
     /** inner configuration of the designated body */
     ParticleConfiguration &inner_configuration_;
+    /** compact inner configuration, available when enabled in the relation */
+    CompactParticleConfiguration &compact_inner_configuration_;
 };
 
 /**
@@ -105,6 +233,7 @@ class DataDelegateContact
             contact_bodies_.push_back(contact_sph_bodies[i]);
             contact_particles_.push_back(&contact_sph_bodies[i]->getBaseParticles());
             contact_configuration_.push_back(&contact_relation.contact_configuration_[i]);
+            compact_contact_configuration_.push_back(&contact_relation.compact_contact_configuration_[i]);
         }
     };
     virtual ~DataDelegateContact() {};
@@ -115,6 +244,8 @@ class DataDelegateContact
     StdVec<BaseParticles *> contact_particles_;
     /** Configurations for particle interaction between bodies. */
     StdVec<ParticleConfiguration *> contact_configuration_;
+    /** Compact configurations, available when enabled in the relation. */
+    StdVec<CompactParticleConfiguration *> compact_contact_configuration_;
 };
 } // namespace SPH
 #endif // BASE_PARTICLE_DYNAMICS_H
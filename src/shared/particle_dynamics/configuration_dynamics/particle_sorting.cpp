@@ -8,18 +8,17 @@
 namespace SPH
 {
 //=================================================================================================//
-SwapSortableParticleData::SwapSortableParticleData(BaseParticles *base_particles)
+SwapParticleSequence::SwapParticleSequence(BaseParticles *base_particles)
     : sequence_(base_particles->getVariableDataByName<UnsignedInt>("Sequence")),
-      sortable_data_(base_particles->SortableParticleData()),
-      swap_particle_data_value_(sortable_data_) {}
+      index_permutation_(base_particles->getVariableDataByName<UnsignedInt>("IndexPermutation")) {}
 //=================================================================================================//
-void SwapSortableParticleData::operator()(UnsignedInt *a, UnsignedInt *b)
+void SwapParticleSequence::operator()(UnsignedInt *a, UnsignedInt *b)
 {
     std::swap(*a, *b);
 
     UnsignedInt index_a = a - sequence_;
     UnsignedInt index_b = b - sequence_;
-    swap_particle_data_value_(index_a, index_b);
+    std::swap(index_permutation_[index_a], index_permutation_[index_b]);
 }
 //=================================================================================================//
 ParticleSequence::ParticleSequence(RealBody &real_body)
@@ -36,18 +35,29 @@ void ParticleSequence::update(size_t index_i, Real dt)
 ParticleDataSort<ParallelPolicy>::ParticleDataSort(RealBody &real_body)
     : LocalDynamics(real_body), BaseDynamics<void>(),
       sequence_(particles_->getVariableDataByName<UnsignedInt>("Sequence")),
-      swap_sortable_particle_data_(particles_), compare_(),
-      quick_sort_particle_range_(sequence_, 0, compare_, swap_sortable_particle_data_),
-      quick_sort_particle_body_()
+      index_permutation_(particles_->registerDiscreteVariable<UnsignedInt>(
+          "IndexPermutation", particles_->ParticlesBound())),
+      swap_particle_sequence_(particles_), compare_(),
+      quick_sort_particle_range_(sequence_, 0, compare_, swap_particle_sequence_),
+      quick_sort_particle_body_(), permute_sortable_data_(particles_->SortableParticleData())
 {
     particles_->addVariableToSort<UnsignedInt>("OriginalID");
 }
 //=================================================================================================//
 void ParticleDataSort<ParallelPolicy>::exec(Real dt)
 {
+    UnsignedInt total_real_particles = particles_->TotalRealParticles();
+    UnsignedInt *index_permutation = index_permutation_;
+    particle_for(par, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { index_permutation[i] = i; });
+
     quick_sort_particle_range_.begin_ = sequence_;
-    quick_sort_particle_range_.size_ = particles_->TotalRealParticles();
-    parallel_for(quick_sort_particle_range_, quick_sort_particle_body_, ap);
+    quick_sort_particle_range_.size_ = total_real_particles;
+    arena_parallel_for(quick_sort_particle_range_, quick_sort_particle_body_, ap);
+
+    permute_sortable_data_(particles_, index_permutation_);
+    particles_->incrementTotalSorts();
 }
 //=================================================================================================//
 UpdateSortedID::UpdateSortedID(RealBody &real_body)
@@ -60,4 +70,28 @@ void UpdateSortedID::update(size_t index_i, Real dt)
     sorted_id_[original_id_[index_i]] = index_i;
 }
 //=================================================================================================//
+bool SortingScheduler::decideSorting(Real disorder)
+{
+    statistics_.checks_++;
+    statistics_.disorder_ = disorder;
+    statistics_.is_sorting_ = false;
+
+    if (is_reference_required_)
+    {
+        statistics_.reference_disorder_ = disorder;
+        statistics_.locality_loss_ = 0.0;
+        is_reference_required_ = false;
+        return false;
+    }
+
+    statistics_.locality_loss_ += SMAX(disorder - statistics_.reference_disorder_, Real(0));
+    if (statistics_.locality_loss_ > relative_sort_cost_)
+    {
+        statistics_.is_sorting_ = true;
+        statistics_.sorts_++;
+        is_reference_required_ = true;
+    }
+    return statistics_.is_sorting_;
+}
+//=================================================================================================//
 } // namespace SPH
@@ -199,16 +199,60 @@ namespace SPH
 {
 class BaseParticles;
 
-struct SwapParticleDataValue
+/**
+ * Permutes data fields of a type by gathering through the index permutation,
+ * i.e. the new data at i are the old ones at index_permutation[i].
+ * The gather of a field into one of two temporary fields is fused with the copy back
+ * of the previously gathered field, so that n fields are permuted by n + 1 loops instead of 2n.
+ */
+template <class ExecutionPolicy, typename DataType>
+void permuteDataFields(const ExecutionPolicy &ex_policy, const StdVec<DataType *> &data_fields,
+                       UnsignedInt *index_permutation, UnsignedInt data_size, DataType *temp_data_fields[2])
+{
+    DataType *gathered_data_field = nullptr;
+    DataType *gathered_temp_field = nullptr;
+    for (size_t k = 0; k != data_fields.size(); ++k)
+    {
+        DataType *sorted_data_field = data_fields[k];
+        DataType *temp_data_field = temp_data_fields[k % 2];
+        particle_for(ex_policy, IndexRange(0, data_size),
+                     [=](size_t i)
+                     {
+                         temp_data_field[i] = sorted_data_field[index_permutation[i]];
+                         if (gathered_data_field != nullptr)
+                             gathered_data_field[i] = gathered_temp_field[i];
+                     });
+        gathered_data_field = sorted_data_field;
+        gathered_temp_field = temp_data_field;
+    }
+
+    if (gathered_data_field != nullptr)
+    {
+        particle_for(ex_policy, IndexRange(0, data_size),
+                     [=](size_t i)
+                     { gathered_data_field[i] = gathered_temp_field[i]; });
+    }
+};
+
+/**
+ * @class PermuteParticleDataValue
+ * @brief Permutes the sortable data of a type, with the two temporary fields
+ *        acquired from the scratch variable pool of the particles.
+ */
+struct PermuteParticleDataValue
 {
     template <typename DataType>
-    void operator()(DataContainerKeeper<AllocatedData<DataType>> &data_keeper, size_t index_a, size_t index_b) const
+    void operator()(DataContainerKeeper<AllocatedData<DataType>> &data_keeper,
+                    BaseParticles *particles, UnsignedInt *index_permutation) const
     {
-        for (size_t i = 0; i != data_keeper.size(); ++i)
-        {
-            DataType *data_field = data_keeper[i];
-            std::swap(data_field[index_a], data_field[index_b]);
-        }
+        if (data_keeper.empty())
+            return;
+
+        ScratchVariablePool &scratch_pool = particles->getScratchVariablePool();
+        ScopedScratchVariable<DataType> temp_variable(scratch_pool, particles->ParticlesBound());
+        ScopedScratchVariable<DataType> swap_temp_variable(scratch_pool, particles->ParticlesBound());
+        DataType *temp_data_fields[2] = {temp_variable->DataField(), swap_temp_variable->DataField()};
+        permuteDataFields(par, data_keeper, index_permutation, particles->TotalRealParticles(), temp_data_fields);
     };
 };
 
@@ -225,19 +269,20 @@ struct CompareParticleSequence
 };
 
 /**
- * @class SwapSortableParticleData
- * @brief swap sortable particle data according to a sequence
+ * @class SwapParticleSequence
+ * @brief Swaps the sequence and the index permutation of two particles during sorting,
+ *        so that the sortable data are permuted by a gather once after sorting,
+ *        instead of being swapped element by element.
  */
-class SwapSortableParticleData
+class SwapParticleSequence
 {
   protected:
     UnsignedInt *sequence_;
-    ParticleData &sortable_data_;
-    OperationOnDataAssemble<ParticleData, SwapParticleDataValue> swap_particle_data_value_;
+    UnsignedInt *index_permutation_;
 
   public:
-    explicit SwapSortableParticleData(BaseParticles *base_particles);
-    ~SwapSortableParticleData(){};
+    explicit SwapParticleSequence(BaseParticles *base_particles);
+    ~SwapParticleSequence(){};
 
     /** the operator overload for swapping particle data.
      *  the arguments are the same with std::iter_swap
@@ -267,16 +312,17 @@ class ParticleDataSort<ParallelPolicy>
 {
   protected:
     UnsignedInt *sequence_;
+    UnsignedInt *index_permutation_;
 
-    /** using pointer because it is constructed after particles. */
-    SwapSortableParticleData swap_sortable_particle_data_;
+    SwapParticleSequence swap_particle_sequence_;
     CompareParticleSequence compare_;
     tbb::interface9::QuickSortParticleRange<
-        UnsignedInt *, CompareParticleSequence, SwapSortableParticleData>
+        UnsignedInt *, CompareParticleSequence, SwapParticleSequence>
         quick_sort_particle_range_;
     tbb::interface9::QuickSortParticleBody<
-        UnsignedInt *, CompareParticleSequence, SwapSortableParticleData>
+        UnsignedInt *, CompareParticleSequence, SwapParticleSequence>
         quick_sort_particle_body_;
+    OperationOnDataAssemble<ParticleData, PermuteParticleDataValue> permute_sortable_data_;
 
   public:
     explicit ParticleDataSort(RealBody &real_body);
@@ -296,16 +342,71 @@ class UpdateSortedID : public LocalDynamics
     void update(size_t index_i, Real dt = 0.0);
 };
 
+/**
+ * @class SortingScheduler
+ * @brief Decides when to sort from a locality metric, which is the mean fraction of neighbors
+ * of sampled particles whose index distance exceeds a cache window.
+ * At most sample_size_ particles, evenly strided over the real particles, are visited,
+ * so that the cost of a check does not grow with the number of particles.
+ * The excess of the metric over its value measured after the last sort is accumulated
+ * as locality loss, and sorting is triggered once the loss exceeds the relative sort cost.
+ * Since the neighbor lists are only valid after the next relation update,
+ * the reference value is taken at the first check after a sort.
+ */
+class SortingScheduler
+{
+  public:
+    struct Statistics
+    {
+        UnsignedInt checks_ = 0;
+        UnsignedInt sorts_ = 0;
+        Real disorder_ = 0.0;
+        Real reference_disorder_ = 0.0;
+        Real locality_loss_ = 0.0;
+        bool is_sorting_ = false; /**< decision of the latest check */
+    };
+
+    static constexpr UnsignedInt sample_size_ = 1024;
+    static constexpr UnsignedInt cache_window_ = 64;
+
+    explicit SortingScheduler(Real relative_sort_cost = 5.0)
+        : relative_sort_cost_(relative_sort_cost){};
+    void setRelativeSortCost(Real relative_sort_cost) { relative_sort_cost_ = relative_sort_cost; };
+    UnsignedInt SampleStride(UnsignedInt total_real_particles)
+    {
+        return SMAX(UnsignedInt(1), total_real_particles / sample_size_);
+    };
+    UnsignedInt NumberOfSamples(UnsignedInt total_real_particles)
+    {
+        return total_real_particles / SampleStride(total_real_particles);
+    };
+    bool decideSorting(Real disorder);
+    const Statistics &getStatistics() const { return statistics_; };
+
+  protected:
+    Real relative_sort_cost_;
+    bool is_reference_required_ = true;
+    Statistics statistics_;
+};
+
 template <class ExecutionPolicy = ParallelPolicy>
 class ParticleSorting : public BaseDynamics<void>
 {
+    BaseParticles &particles_;
     SimpleDynamics<ParticleSequence, ExecutionPolicy> particle_sequence_;
     ParticleDataSort<ParallelPolicy> particle_data_sort_;
     SimpleDynamics<UpdateSortedID, ExecutionPolicy> update_sorted_id_;
+    BaseInnerRelation *auto_sorting_relation_;
+    SortingScheduler sorting_scheduler_;
+
+    Real measureDisorder();
 
   public:
     ParticleSorting(RealBody &real_body);
     virtual ~ParticleSorting(){};
+    /** auto policy: exec() may be called every step and sorts only when decided by the scheduler */
+    void setAutoSorting(BaseInnerRelation &inner_relation, Real relative_sort_cost = 5.0);
+    const SortingScheduler::Statistics &getSortingStatistics() { return sorting_scheduler_.getStatistics(); };
 
     virtual void exec(Real dt = 0.0) override;
 };
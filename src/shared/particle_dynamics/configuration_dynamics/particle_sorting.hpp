@@ -8,13 +8,53 @@ namespace SPH
 //=================================================================================================//
 template <class ExecutionPolicy>
 ParticleSorting<ExecutionPolicy>::ParticleSorting(RealBody &real_body)
-    : BaseDynamics<void>(),
+    : BaseDynamics<void>(), particles_(real_body.getBaseParticles()),
       particle_sequence_(real_body), particle_data_sort_(real_body),
-      update_sorted_id_(real_body) {}
+      update_sorted_id_(real_body), auto_sorting_relation_(nullptr) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void ParticleSorting<ExecutionPolicy>::
+    setAutoSorting(BaseInnerRelation &inner_relation, Real relative_sort_cost)
+{
+    auto_sorting_relation_ = &inner_relation;
+    sorting_scheduler_.setRelativeSortCost(relative_sort_cost);
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+Real ParticleSorting<ExecutionPolicy>::measureDisorder()
+{
+    UnsignedInt total_real_particles = particles_.TotalRealParticles();
+    UnsignedInt stride = sorting_scheduler_.SampleStride(total_real_particles);
+    UnsignedInt number_of_samples = sorting_scheduler_.NumberOfSamples(total_real_particles);
+    ParticleConfiguration &inner_configuration = auto_sorting_relation_->inner_configuration_;
+
+    Real disorder_sum = particle_reduce(
+        ExecutionPolicy(), IndexRange(0, number_of_samples), Real(0), ReduceSum<Real>(),
+        [&](size_t k) -> Real
+        {
+            size_t index_i = k * stride;
+            const Neighborhood &neighborhood = inner_configuration[index_i];
+            size_t far_neighbors = 0;
+            for (size_t n = 0; n != neighborhood.current_size_; ++n)
+            {
+                size_t index_j = neighborhood.j_[n];
+                size_t distance = index_i > index_j ? index_i - index_j : index_j - index_i;
+                if (distance > SortingScheduler::cache_window_)
+                    far_neighbors++;
+            }
+            return Real(far_neighbors) / Real(SMAX(neighborhood.current_size_, size_t(1)));
+        });
+    return disorder_sum / Real(SMAX(number_of_samples, UnsignedInt(1)));
+}
 //=================================================================================================//
 template <class ExecutionPolicy>
 void ParticleSorting<ExecutionPolicy>::exec(Real dt)
 {
+    if (auto_sorting_relation_ != nullptr && !sorting_scheduler_.decideSorting(measureDisorder()))
+    {
+        return;
+    }
+
     particle_sequence_.exec();
     particle_data_sort_.exec();
     update_sorted_id_.exec();
@@ -94,7 +94,7 @@ void ParameterSplittingByPDEInner<DataType>::interaction(size_t index_i, Real dt
         Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
         {
-            size_t &index_j = inner_neighborhood.j_[n];
+            size_t index_j = inner_neighborhood.j_[n];
             this->variable_[index_j] = this->parameter_recovery_[index_j];
         }
 
@@ -114,7 +114,7 @@ void ParameterSplittingByPDEInner<DataType>::interaction(size_t index_i, Real dt
             Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
             for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
             {
-                size_t &index_j = inner_neighborhood.j_[n];
+                size_t index_j = inner_neighborhood.j_[n];
                 this->variable_[index_j] = this->parameter_recovery_[index_j];
             }
         }
@@ -164,7 +164,7 @@ ErrorAndParameters<DataType> ParameterSplittingByPDEWithBoundary<DataType>::
         Neighborhood &contact_neighborhood = (*this->contact_configuration_[k])[index_i];
         for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
         {
-            size_t &index_j = contact_neighborhood.j_[n];
+            size_t index_j = contact_neighborhood.j_[n];
 
             if (species_k[index_j] > 0.0)
             {
@@ -25,8 +25,8 @@ ErrorAndParameters<DataType> TemperatureSplittingByPDEInner<DataType>::
     Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
-        size_t &index_j = inner_neighborhood.j_[n];
-        Real &r_ij_ = inner_neighborhood.r_ij_[n];
+        size_t index_j = inner_neighborhood.j_[n];
+        Real r_ij_ = inner_neighborhood.r_ij_[n];
         Vecd &e_ij_ = inner_neighborhood.e_ij_[n];
 
         // linear projection
@@ -54,8 +54,8 @@ void TemperatureSplittingByPDEInner<DataType>::
     Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
-        size_t &index_j = inner_neighborhood.j_[n];
-        Real &r_ij_ = inner_neighborhood.r_ij_[n];
+        size_t index_j = inner_neighborhood.j_[n];
+        Real r_ij_ = inner_neighborhood.r_ij_[n];
         Vecd &e_ij_ = inner_neighborhood.e_ij_[n];
 
         Real diff_coff_ij = this->diffusion_.getInterParticleDiffusionCoeff(index_i, index_j, e_ij_);
@@ -109,7 +109,7 @@ ErrorAndParameters<DataType> TemperatureSplittingByPDEWithBoundary<DataType>::
         Neighborhood &contact_neighborhood = (*this->contact_configuration_[k])[index_i];
         for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
         {
-            size_t &index_j = contact_neighborhood.j_[n];
+            size_t index_j = contact_neighborhood.j_[n];
 
             if (variable_k[index_j] > 0.0)
             {
@@ -31,4 +31,6 @@
 
 #include "diffusion_dynamics.hpp"
 #include "general_diffusion_reaction_dynamics.h"
+#include "implicit_diffusion_dynamics.hpp"
 #include "reaction_dynamics.hpp"
+#include "steady_diffusion_dynamics.hpp"
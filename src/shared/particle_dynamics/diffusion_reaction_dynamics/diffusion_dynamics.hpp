@@ -83,26 +83,24 @@ DiffusionRelaxation<Inner<KernelGradientType>, DiffusionType>::
 template <class KernelGradientType, class DiffusionType>
 void DiffusionRelaxation<Inner<KernelGradientType>, DiffusionType>::interaction(size_t index_i, Real dt)
 {
-    for (size_t m = 0; m < this->diffusions_.size(); ++m)
+    // neighbor data and kernel gradients are read once and shared by all species
+    Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
     {
-        auto diffusion_m = this->diffusions_[m];
-        Real *gradient_species = this->gradient_species_[m];
-        Real d_species = 0.0;
-        Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
-        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        {
-            size_t index_j = inner_neighborhood.j_[n];
-            Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * this->Vol_[index_j];
-            Real r_ij_ = inner_neighborhood.r_ij_[n];
-            Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        size_t index_j = inner_neighborhood.j_[n];
+        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * this->Vol_[index_j];
+        Real r_ij_ = inner_neighborhood.r_ij_[n];
+        Vecd &e_ij = inner_neighborhood.e_ij_[n];
 
-            Real diff_coeff_ij = diffusion_m->getInterParticleDiffusionCoeff(index_i, index_j, e_ij);
-            const Vecd &grad_ijV_j = this->kernel_gradient_(index_i, index_j, dW_ijV_j, e_ij);
-            Real surface_area_ij = 2.0 * grad_ijV_j.dot(e_ij) / r_ij_;
+        const Vecd &grad_ijV_j = this->kernel_gradient_(index_i, index_j, dW_ijV_j, e_ij);
+        Real surface_area_ij = 2.0 * grad_ijV_j.dot(e_ij) / r_ij_;
+        for (size_t m = 0; m < this->diffusions_.size(); ++m)
+        {
+            Real diff_coeff_ij = this->diffusions_[m]->getInterParticleDiffusionCoeff(index_i, index_j, e_ij);
+            Real *gradient_species = this->gradient_species_[m];
             Real phi_ij = gradient_species[index_i] - gradient_species[index_j];
-            d_species += diff_coeff_ij * phi_ij * surface_area_ij;
+            this->diffusion_dt_[m][index_i] += diff_coeff_ij * phi_ij * surface_area_ij;
         }
-        this->diffusion_dt_[m][index_i] += d_species;
     }
 }
 //=================================================================================================//
@@ -0,0 +1,118 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    implicit_diffusion_dynamics.h
+ * @brief   Implicit time integration of the diffusion of all species.
+ * @details The SPH Laplacian of the inner neighbor lists, together with the Dirichlet, Neumann and Robin
+ *          boundary terms from contact neighbor lists, is assembled into a sparse matrix L in
+ *          compressed-row form, in which the columns are the neighbor indices and the structure is
+ *          only rebuilt when the neighbor counts change. The theta scheme
+ *          (V / dt + theta L) phi^{n+1} = V / dt phi^n - (1 - theta) L phi^n + b,
+ *          with theta = 1 for backward Euler and theta = 0.5 for Crank-Nicolson, is symmetric positive definite
+ *          after scaling with the particle volume V, and is solved for each species by
+ *          the Jacobi preconditioned conjugate gradient method warm started from phi^n.
+ *          The time-step size is therefore chosen by accuracy rather than by GetDiffusionTimeStepSize.
+ *          Only diffusion with identical diffusion and gradient species is supported.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef IMPLICIT_DIFFUSION_DYNAMICS_H
+#define IMPLICIT_DIFFUSION_DYNAMICS_H
+
+#include "diffusion_dynamics.h"
+
+namespace SPH
+{
+/**
+ * @class ImplicitDiffusion
+ * @brief Backward Euler or Crank-Nicolson diffusion relaxation of all species on a body,
+ * with optional Dirichlet, Neumann and Robin contact boundaries.
+ */
+template <class KernelGradientType, class ContactKernelGradientType,
+          class DiffusionType, class ExecutionPolicy = ParallelPolicy>
+class ImplicitDiffusion
+    : public DiffusionRelaxation<Inner<KernelGradientType>, DiffusionType>,
+      public BaseDynamics<void>
+{
+    struct ContactBoundary
+    {
+        ParticleConfiguration *configuration_;
+        ContactKernelGradientType kernel_gradient_;
+        Real *Vol_;
+        Vecd *n_;
+        StdVec<Real *> values_;   /**< wall species, flux or convection coefficient */
+        StdVec<Real *> infinity_; /**< ambient species for Robin boundary */
+    };
+
+  public:
+    template <typename DiffusionArg>
+    ImplicitDiffusion(BaseInnerRelation &inner_relation, DiffusionArg &&diffusions,
+                      Real theta = 1.0, Real tolerance = 1.0e-8, UnsignedInt max_iterations = 500);
+    virtual ~ImplicitDiffusion(){};
+
+    void addDirichletBoundary(BaseContactRelation &contact_relation);
+    void addNeumannBoundary(BaseContactRelation &contact_relation);
+    void addRobinBoundary(BaseContactRelation &contact_relation);
+
+    UnsignedInt Iterations() { return iterations_; };
+    Real RelativeResidual() { return relative_residual_; };
+    UnsignedInt StructureRebuilds() { return structure_rebuilds_; };
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    Real theta_;
+    Real tolerance_;
+    UnsignedInt max_iterations_;
+    UnsignedInt iterations_;
+    Real relative_residual_;
+    UnsignedInt structure_rebuilds_;
+    Vecd *n_;
+    StdVec<ContactBoundary> dirichlet_, neumann_, robin_;
+
+    /** compressed-row structure shared by all species, columns are inner neighbor indices */
+    StdVec<size_t> row_offsets_, row_sizes_, columns_;
+    /** off-diagonal coefficients, diagonal of L and boundary source b for each species */
+    StdVec<StdVec<Real>> coefficients_, laplacian_diagonal_, boundary_source_;
+    StdVec<Real> diagonal_, previous_, rhs_, residual_, direction_, operator_direction_;
+
+    ContactBoundary createContactBoundary(BaseContactRelation &contact_relation, size_t k);
+    void resizeWorkArrays();
+    void updateMatrixStructure();
+    /** assemble the matrices of all species with a single pass over the neighbor lists */
+    void assembleMatrix(size_t index_i);
+    Real offDiagonalProduct(size_t species_index, size_t index_i, Real *field);
+    /** the product of the Laplacian matrix L with a field */
+    Real laplacianProduct(size_t species_index, size_t index_i, Real *field);
+    template <class ParticleFunction>
+    Real sum(const ParticleFunction &particle_function);
+};
+
+template <class DiffusionType>
+using ImplicitDiffusionInner =
+    ImplicitDiffusion<KernelGradientInner, KernelGradientContact, DiffusionType>;
+template <class DiffusionType>
+using ImplicitDiffusionCorrectedInner =
+    ImplicitDiffusion<CorrectedKernelGradientInner, CorrectedKernelGradientContact, DiffusionType>;
+} // namespace SPH
+#endif // IMPLICIT_DIFFUSION_DYNAMICS_H
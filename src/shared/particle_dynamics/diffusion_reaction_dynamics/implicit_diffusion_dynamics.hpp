@@ -0,0 +1,391 @@
+/**
+ * @file 	implicit_diffusion_dynamics.hpp
+ * @brief 	Implicit diffusion relaxation of all species.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IMPLICIT_DIFFUSION_DYNAMICS_HPP
+#define IMPLICIT_DIFFUSION_DYNAMICS_HPP
+
+#include "implicit_diffusion_dynamics.h"
+
+#include "diffusion_dynamics.hpp"
+
+#include <numeric>
+
+namespace SPH
+{
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+template <typename DiffusionArg>
+ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    ImplicitDiffusion(BaseInnerRelation &inner_relation, DiffusionArg &&diffusions,
+                      Real theta, Real tolerance, UnsignedInt max_iterations)
+    : DiffusionRelaxation<Inner<KernelGradientType>, DiffusionType>(
+          inner_relation, std::forward<DiffusionArg>(diffusions)),
+      BaseDynamics<void>(), theta_(theta), tolerance_(tolerance), max_iterations_(max_iterations),
+      iterations_(0), relative_residual_(0.0), structure_rebuilds_(0), n_(nullptr),
+      coefficients_(this->diffusions_.size()), laplacian_diagonal_(this->diffusions_.size()),
+      boundary_source_(this->diffusions_.size())
+{
+    if (theta_ < 0.5 || theta_ > 1.0)
+    {
+        std::cout << "\n Error: the implicit factor of ImplicitDiffusion should be between 0.5 and 1!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    for (auto &diffusion : this->diffusions_)
+    {
+        if (diffusion->DiffusionSpeciesName() != diffusion->GradientSpeciesName())
+        {
+            std::cout << "\n Error: ImplicitDiffusion requires identical diffusion and gradient species for "
+                      << diffusion->DiffusionSpeciesName() << "!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+typename ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::ContactBoundary
+ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    createContactBoundary(BaseContactRelation &contact_relation, size_t k)
+{
+    BaseParticles *contact_particles = &contact_relation.contact_bodies_[k]->getBaseParticles();
+    return ContactBoundary{&contact_relation.contact_configuration_[k],
+                           ContactKernelGradientType(this->particles_, contact_particles),
+                           contact_particles->template registerStateVariable<Real>("VolumetricMeasure"),
+                           nullptr, StdVec<Real *>(), StdVec<Real *>()};
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    addDirichletBoundary(BaseContactRelation &contact_relation)
+{
+    for (size_t k = 0; k != contact_relation.contact_bodies_.size(); ++k)
+    {
+        ContactBoundary boundary = createContactBoundary(contact_relation, k);
+        BaseParticles &contact_particles = contact_relation.contact_bodies_[k]->getBaseParticles();
+        for (auto &diffusion : this->diffusions_)
+        {
+            std::string gradient_species_name = diffusion->GradientSpeciesName();
+            boundary.values_.push_back(contact_particles.registerStateVariable<Real>(gradient_species_name));
+            contact_particles.addVariableToWrite<Real>(gradient_species_name);
+        }
+        dirichlet_.push_back(boundary);
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    addNeumannBoundary(BaseContactRelation &contact_relation)
+{
+    n_ = this->particles_->template getVariableDataByName<Vecd>("NormalDirection");
+    for (size_t k = 0; k != contact_relation.contact_bodies_.size(); ++k)
+    {
+        ContactBoundary boundary = createContactBoundary(contact_relation, k);
+        BaseParticles &contact_particles = contact_relation.contact_bodies_[k]->getBaseParticles();
+        boundary.n_ = contact_particles.getVariableDataByName<Vecd>("NormalDirection");
+        for (auto &diffusion : this->diffusions_)
+        {
+            std::string diffusion_species_name = diffusion->DiffusionSpeciesName();
+            boundary.values_.push_back(contact_particles.registerStateVariable<Real>(diffusion_species_name + "Flux"));
+        }
+        neumann_.push_back(boundary);
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    addRobinBoundary(BaseContactRelation &contact_relation)
+{
+    n_ = this->particles_->template getVariableDataByName<Vecd>("NormalDirection");
+    for (size_t k = 0; k != contact_relation.contact_bodies_.size(); ++k)
+    {
+        ContactBoundary boundary = createContactBoundary(contact_relation, k);
+        BaseParticles &contact_particles = contact_relation.contact_bodies_[k]->getBaseParticles();
+        boundary.n_ = contact_particles.getVariableDataByName<Vecd>("NormalDirection");
+        for (auto &diffusion : this->diffusions_)
+        {
+            std::string diffusion_species_name = diffusion->DiffusionSpeciesName();
+            boundary.values_.push_back(
+                contact_particles.registerStateVariable<Real>(diffusion_species_name + "Convection"));
+            boundary.infinity_.push_back(
+                contact_particles.registerSingularVariable<Real>(diffusion_species_name + "Infinity")->ValueAddress());
+        }
+        robin_.push_back(boundary);
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    resizeWorkArrays()
+{
+    size_t particles_bound = this->particles_->RealParticlesBound();
+    if (diagonal_.size() < particles_bound)
+    {
+        row_sizes_.resize(particles_bound, 0);
+        row_offsets_.resize(particles_bound + 1, 0);
+        diagonal_.resize(particles_bound);
+        previous_.resize(particles_bound);
+        rhs_.resize(particles_bound);
+        residual_.resize(particles_bound);
+        direction_.resize(particles_bound);
+        operator_direction_.resize(particles_bound);
+        for (size_t m = 0; m != this->diffusions_.size(); ++m)
+        {
+            laplacian_diagonal_[m].resize(particles_bound);
+            boundary_source_[m].resize(particles_bound);
+        }
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    updateMatrixStructure()
+{
+    IndexRange loop_range = this->identifier_.LoopRange();
+    UnsignedInt changed_rows = particle_reduce(
+        ExecutionPolicy(), loop_range, UnsignedInt(0), ReduceSum<UnsignedInt>(),
+        [&](size_t i) -> UnsignedInt
+        {
+            size_t row_size = this->inner_configuration_[i].current_size_;
+            UnsignedInt is_changed = row_size != row_sizes_[i] ? 1 : 0;
+            row_sizes_[i] = row_size;
+            return is_changed;
+        });
+
+    size_t number_of_rows = loop_range.size();
+    if (changed_rows != 0 || row_offsets_[number_of_rows] != columns_.size())
+    {
+        std::partial_sum(row_sizes_.begin(), row_sizes_.begin() + number_of_rows, row_offsets_.begin() + 1);
+        size_t number_of_nonzeros = row_offsets_[number_of_rows];
+        columns_.resize(number_of_nonzeros);
+        for (size_t m = 0; m != this->diffusions_.size(); ++m)
+            coefficients_[m].resize(number_of_nonzeros);
+        structure_rebuilds_++;
+    }
+
+    // the column indices change with the neighbor lists even if the row sizes do not
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 {
+                     const Neighborhood &inner_neighborhood = this->inner_configuration_[i];
+                     size_t *columns = &columns_[row_offsets_[i]];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                         columns[n] = inner_neighborhood.j_[n];
+                 });
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    assembleMatrix(size_t index_i)
+{
+    // neighbor data and kernel gradients are read once and shared by all species
+    size_t number_of_species = this->diffusions_.size();
+    Real Vol_i = this->Vol_[index_i];
+    size_t row_offset = row_offsets_[index_i];
+    for (size_t m = 0; m != number_of_species; ++m)
+    {
+        laplacian_diagonal_[m][index_i] = 0.0;
+        boundary_source_[m][index_i] = 0.0;
+    }
+
+    const Neighborhood &inner_neighborhood = this->inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * this->Vol_[index_j];
+        Vecd e_ij = inner_neighborhood.e_ij_[n];
+
+        const Vecd &grad_ijV_j = this->kernel_gradient_(index_i, index_j, dW_ijV_j, e_ij);
+        Real surface_area_ij = 2.0 * grad_ijV_j.dot(e_ij) / inner_neighborhood.r_ij_[n];
+        for (size_t m = 0; m != number_of_species; ++m)
+        {
+            Real diff_coeff_ij = this->diffusions_[m]->getInterParticleDiffusionCoeff(index_i, index_j, e_ij);
+            Real coefficient = -Vol_i * diff_coeff_ij * surface_area_ij;
+            coefficients_[m][row_offset + n] = coefficient;
+            laplacian_diagonal_[m][index_i] += coefficient;
+        }
+    }
+
+    for (auto &boundary : dirichlet_)
+    {
+        const Neighborhood &contact_neighborhood = (*boundary.configuration_)[index_i];
+        for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = contact_neighborhood.j_[n];
+            Real dW_ijV_j = contact_neighborhood.dW_ij_[n] * boundary.Vol_[index_j];
+            Vecd e_ij = contact_neighborhood.e_ij_[n];
+
+            const Vecd &grad_ijV_j = boundary.kernel_gradient_(index_i, index_j, dW_ijV_j, e_ij);
+            Real area_ij = 2.0 * grad_ijV_j.dot(e_ij) / contact_neighborhood.r_ij_[n];
+            for (size_t m = 0; m != number_of_species; ++m)
+            {
+                Real diff_coeff_ij = this->diffusions_[m]->getInterParticleDiffusionCoeff(index_i, index_i, e_ij);
+                Real coefficient = -2.0 * Vol_i * diff_coeff_ij * area_ij;
+                laplacian_diagonal_[m][index_i] += coefficient;
+                boundary_source_[m][index_i] += coefficient * boundary.values_[m][index_j];
+            }
+        }
+    }
+
+    for (auto &boundary : neumann_)
+    {
+        const Neighborhood &contact_neighborhood = (*boundary.configuration_)[index_i];
+        for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = contact_neighborhood.j_[n];
+            Real dW_ijV_j = contact_neighborhood.dW_ij_[n] * boundary.Vol_[index_j];
+            Vecd e_ij = contact_neighborhood.e_ij_[n];
+
+            const Vecd &grad_ijV_j = boundary.kernel_gradient_(index_i, index_j, dW_ijV_j, e_ij);
+            Real area_ij_Neumann = grad_ijV_j.dot(n_[index_i] - boundary.n_[index_j]);
+            for (size_t m = 0; m != number_of_species; ++m)
+            {
+                boundary_source_[m][index_i] += Vol_i * area_ij_Neumann * boundary.values_[m][index_j];
+            }
+        }
+    }
+
+    for (auto &boundary : robin_)
+    {
+        const Neighborhood &contact_neighborhood = (*boundary.configuration_)[index_i];
+        for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = contact_neighborhood.j_[n];
+            Real dW_ijV_j = contact_neighborhood.dW_ij_[n] * boundary.Vol_[index_j];
+            Vecd e_ij = contact_neighborhood.e_ij_[n];
+
+            const Vecd &grad_ijV_j = boundary.kernel_gradient_(index_i, index_j, dW_ijV_j, e_ij);
+            Real area_ij_Robin = grad_ijV_j.dot(n_[index_i] - boundary.n_[index_j]);
+            for (size_t m = 0; m != number_of_species; ++m)
+            {
+                Real coefficient = Vol_i * boundary.values_[m][index_j] * area_ij_Robin;
+                laplacian_diagonal_[m][index_i] += coefficient;
+                boundary_source_[m][index_i] += coefficient * (*boundary.infinity_[m]);
+            }
+        }
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+Real ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    offDiagonalProduct(size_t m, size_t index_i, Real *field)
+{
+    Real product = 0.0;
+    const Real *coefficients = &coefficients_[m][row_offsets_[index_i]];
+    const size_t *columns = &columns_[row_offsets_[index_i]];
+    for (size_t n = 0; n != row_sizes_[index_i]; ++n)
+    {
+        product += coefficients[n] * field[columns[n]];
+    }
+    return product;
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+Real ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    laplacianProduct(size_t m, size_t index_i, Real *field)
+{
+    return laplacian_diagonal_[m][index_i] * field[index_i] - offDiagonalProduct(m, index_i, field);
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+template <class ParticleFunction>
+Real ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    sum(const ParticleFunction &particle_function)
+{
+    return particle_reduce(ExecutionPolicy(), this->identifier_.LoopRange(),
+                           Real(0), ReduceSum<Real>(), particle_function);
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    exec(Real dt)
+{
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+    this->setUpdated(this->identifier_.getSPHBody());
+    this->setupDynamics(dt);
+    IndexRange loop_range = this->identifier_.LoopRange();
+    Real inv_dt = 1.0 / (dt + TinyReal);
+
+    resizeWorkArrays();
+    updateMatrixStructure();
+
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 { assembleMatrix(i); });
+
+    iterations_ = 0;
+    relative_residual_ = 0.0;
+    for (size_t m = 0; m != this->diffusions_.size(); ++m)
+    {
+        Real *species = this->diffusion_species_[m];
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     {
+                         diagonal_[i] = this->Vol_[i] * inv_dt + theta_ * laplacian_diagonal_[m][i];
+                         previous_[i] = species[i];
+                     });
+
+        // warm started from phi^n, the initial residual is b - L phi^n
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     {
+                         Real laplacian = laplacianProduct(m, i, previous_.data());
+                         rhs_[i] = this->Vol_[i] * inv_dt * previous_[i] -
+                                   (1.0 - theta_) * laplacian + boundary_source_[m][i];
+                         residual_[i] = boundary_source_[m][i] - laplacian;
+                         direction_[i] = residual_[i] / diagonal_[i];
+                     });
+        Real rhs_norm = std::sqrt(sum([&](size_t i) -> Real
+                                      { return rhs_[i] * rhs_[i]; }));
+        Real residual_dot = sum([&](size_t i) -> Real
+                                { return residual_[i] * direction_[i]; });
+        Real relative_residual = std::sqrt(sum([&](size_t i) -> Real
+                                               { return residual_[i] * residual_[i]; })) /
+                                 (rhs_norm + TinyReal);
+
+        UnsignedInt iterations = 0;
+        while (relative_residual > tolerance_ && iterations < max_iterations_)
+        {
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         {
+                             operator_direction_[i] = diagonal_[i] * direction_[i] -
+                                                      theta_ * offDiagonalProduct(m, i, direction_.data());
+                         });
+            Real alpha = residual_dot / (sum([&](size_t i) -> Real
+                                             { return direction_[i] * operator_direction_[i]; }) +
+                                         TinyReal);
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         {
+                             species[i] += alpha * direction_[i];
+                             residual_[i] -= alpha * operator_direction_[i];
+                         });
+            Real new_residual_dot = sum([&](size_t i) -> Real
+                                        { return residual_[i] * residual_[i] / diagonal_[i]; });
+            Real beta = new_residual_dot / (residual_dot + TinyReal);
+            residual_dot = new_residual_dot;
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         { direction_[i] = residual_[i] / diagonal_[i] + beta * direction_[i]; });
+            relative_residual = std::sqrt(sum([&](size_t i) -> Real
+                                              { return residual_[i] * residual_[i]; })) /
+                                (rhs_norm + TinyReal);
+            ++iterations;
+        }
+        iterations_ = SMAX(iterations_, iterations);
+        relative_residual_ = SMAX(relative_residual_, relative_residual);
+
+        // the change rate equivalent to the implicit increment over the time step
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { this->diffusion_dt_[m][i] = (species[i] - previous_[i]) * inv_dt; });
+    }
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // IMPLICIT_DIFFUSION_DYNAMICS_HPP
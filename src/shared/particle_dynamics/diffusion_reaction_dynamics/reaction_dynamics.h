@@ -45,18 +45,19 @@ class BaseReactionRelaxation : public LocalDynamics
     {
         Real operator()(Real input, Real production_rate, Real loss_rate, Real dt) const;
     };
+    static constexpr int NumReactiveSpecies = ReactionModelType::NumSpecies;
+    typedef std::array<Real, NumReactiveSpecies> LocalSpecies;
     void advanceForwardStep(size_t index_i, Real dt);
     void advanceBackwardStep(size_t index_i, Real dt);
+    void advanceForwardSpecies(LocalSpecies &local_species, Real dt);
+    void loadLocalSpecies(LocalSpecies &local_species, size_t index_i);
+    void applyGlobalSpecies(LocalSpecies &local_species, size_t index_i);
 
   private:
-    static constexpr int NumReactiveSpecies = ReactionModelType::NumSpecies;
     typedef std::array<std::string, NumReactiveSpecies> ReactiveSpeciesNames;
-    typedef std::array<Real, NumReactiveSpecies> LocalSpecies;
     StdVec<Real *> reactive_species_;
     ReactionModelType &reaction_model_;
     UpdateReactionSpecies update_reaction_species_;
-    void loadLocalSpecies(LocalSpecies &local_species, size_t index_i);
-    void applyGlobalSpecies(LocalSpecies &local_species, size_t index_i);
 
   public:
     explicit BaseReactionRelaxation(SPHBody &sph_body, ReactionModelType &reaction_model);
@@ -92,5 +93,32 @@ class ReactionRelaxationBackward : public BaseReactionRelaxation<ReactionModelTy
     virtual ~ReactionRelaxationBackward(){};
     void update(size_t index_i, Real dt = 0.0) { this->advanceBackwardStep(index_i, dt); };
 };
+
+/**
+ * @class AdaptiveReactionRelaxation
+ * @brief Compute the reaction process of all species by forward splitting
+ * with per-particle adaptive sub-steps.
+ * @details The local error of each sub-step is estimated by step doubling,
+ * i.e. comparing one sub-step with two half sub-steps of the exponential update.
+ * The accepted sub-step size is kept for each particle as the initial guess of the next step,
+ * so that quiescent particles take the global step directly
+ * while particles near a reaction front sub-cycle.
+ */
+template <class ReactionModelType>
+class AdaptiveReactionRelaxation : public BaseReactionRelaxation<ReactionModelType>
+{
+  public:
+    AdaptiveReactionRelaxation(SPHBody &sph_body, ReactionModelType &reaction_model,
+                               Real tolerance = 1.0e-4, UnsignedInt max_sub_steps = 1000);
+    virtual ~AdaptiveReactionRelaxation(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    using LocalSpecies = typename BaseReactionRelaxation<ReactionModelType>::LocalSpecies;
+    Real tolerance_;
+    UnsignedInt max_sub_steps_;
+    Real *sub_step_size_;
+    int *sub_steps_;
+};
 } // namespace SPH
 #endif // REACTION_DYNAMICS_H
\ No newline at end of file
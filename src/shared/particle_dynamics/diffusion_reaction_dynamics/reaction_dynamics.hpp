@@ -52,16 +52,23 @@ operator()(Real input, Real production_rate, Real loss_rate, Real dt) const
 }
 //=================================================================================================//
 template <class ReactionModelType>
-void BaseReactionRelaxation<ReactionModelType>::advanceForwardStep(size_t index_i, Real dt)
+void BaseReactionRelaxation<ReactionModelType>::
+    advanceForwardSpecies(LocalSpecies &local_species, Real dt)
 {
-    LocalSpecies local_species;
-    loadLocalSpecies(local_species, index_i);
     for (size_t k = 0; k != NumReactiveSpecies; ++k)
     {
         Real production_rate = reaction_model_.get_production_rates_[k](local_species);
         Real loss_rate = reaction_model_.get_loss_rates_[k](local_species);
         local_species[k] = update_reaction_species_(local_species[k], production_rate, loss_rate, dt);
     }
+}
+//=================================================================================================//
+template <class ReactionModelType>
+void BaseReactionRelaxation<ReactionModelType>::advanceForwardStep(size_t index_i, Real dt)
+{
+    LocalSpecies local_species;
+    loadLocalSpecies(local_species, index_i);
+    advanceForwardSpecies(local_species, dt);
     applyGlobalSpecies(local_species, index_i);
 }
 //=================================================================================================//
@@ -80,5 +87,64 @@ void BaseReactionRelaxation<ReactionModelType>::advanceBackwardStep(size_t index
     applyGlobalSpecies(local_species, index_i);
 }
 //=================================================================================================//
+template <class ReactionModelType>
+AdaptiveReactionRelaxation<ReactionModelType>::
+    AdaptiveReactionRelaxation(SPHBody &sph_body, ReactionModelType &reaction_model,
+                               Real tolerance, UnsignedInt max_sub_steps)
+    : BaseReactionRelaxation<ReactionModelType>(sph_body, reaction_model),
+      tolerance_(tolerance), max_sub_steps_(max_sub_steps),
+      sub_step_size_(this->particles_->template registerStateVariable<Real>("ReactionSubStepSize", MaxReal)),
+      sub_steps_(this->particles_->template registerStateVariable<int>("ReactionSubSteps"))
+{
+    this->particles_->template addVariableToSort<Real>("ReactionSubStepSize");
+}
+//=================================================================================================//
+template <class ReactionModelType>
+void AdaptiveReactionRelaxation<ReactionModelType>::update(size_t index_i, Real dt)
+{
+    LocalSpecies local_species;
+    this->loadLocalSpecies(local_species, index_i);
+
+    Real min_sub_dt = dt / Real(max_sub_steps_);
+    Real sub_dt = SMIN(sub_step_size_[index_i], dt);
+    Real time = 0.0;
+    int sub_steps = 0;
+    while (time < dt)
+    {
+        Real step = SMIN(sub_dt, dt - time);
+        LocalSpecies full_step = local_species;
+        this->advanceForwardSpecies(full_step, step);
+        LocalSpecies half_steps = local_species;
+        this->advanceForwardSpecies(half_steps, 0.5 * step);
+        this->advanceForwardSpecies(half_steps, 0.5 * step);
+
+        Real error = 0.0;
+        for (size_t k = 0; k != this->NumReactiveSpecies; ++k)
+        {
+            Real scale = tolerance_ * SMAX(Real(1), ABS(half_steps[k]));
+            error = SMAX(error, ABS(full_step[k] - half_steps[k]) / scale);
+        }
+
+        // the splitting error is of second order in the step size
+        Real factor = 0.9 / (std::sqrt(error) + TinyReal);
+        if (error <= 1.0 || step <= min_sub_dt)
+        {
+            local_species = half_steps;
+            time += step;
+            sub_steps++;
+            if (step == sub_dt)
+                sub_dt = SMIN(step * SMIN(factor, Real(2)), dt);
+        }
+        else
+        {
+            sub_dt = SMAX(step * SMAX(factor, Real(0.25)), min_sub_dt);
+        }
+    }
+
+    sub_step_size_[index_i] = sub_dt;
+    sub_steps_[index_i] = sub_steps;
+    this->applyGlobalSpecies(local_species, index_i);
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // REACTION_DYNAMICS_HPP
\ No newline at end of file
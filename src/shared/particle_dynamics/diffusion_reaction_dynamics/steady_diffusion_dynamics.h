@@ -0,0 +1,115 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    steady_diffusion_dynamics.h
+ * @brief   Steady-state solution of the diffusion of all species.
+ * @details The SPH Laplacian L and the boundary source b assembled by ImplicitDiffusion are used
+ *          to solve the steady problem L phi = b directly instead of time marching to steady state.
+ *          The system is solved by the conjugate gradient method preconditioned with one multigrid
+ *          V-cycle. The multigrid hierarchy is built from coarsened particle sets, in which the particles
+ *          of a level are aggregated by background cells of twice the spacing of the finer level,
+ *          as the cells of the multi-resolution level sets. The restriction sums the residuals of
+ *          the particles in an aggregate and the prolongation copies the coarse correction back,
+ *          so that the coarse operators are the Galerkin products of the SPH Laplacian.
+ *          As usual for such aggregation, the coarse correction is over-weighted.
+ *          Damped Jacobi smoothing is used on all levels but the coarsest one, which is solved
+ *          by symmetric Gauss-Seidel sweeps. At least one Dirichlet or Robin boundary
+ *          is required for a unique solution.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef STEADY_DIFFUSION_DYNAMICS_H
+#define STEADY_DIFFUSION_DYNAMICS_H
+
+#include "implicit_diffusion_dynamics.h"
+
+namespace SPH
+{
+/**
+ * @class SteadyDiffusion
+ * @brief Multigrid preconditioned steady-state solution of all species on a body,
+ * with optional Dirichlet, Neumann and Robin contact boundaries.
+ */
+template <class KernelGradientType, class ContactKernelGradientType,
+          class DiffusionType, class ExecutionPolicy = ParallelPolicy>
+class SteadyDiffusion
+    : public ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>
+{
+    using BaseImplicitDiffusion =
+        ImplicitDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>;
+
+    /** a coarsened particle set, i.e. the aggregates of the finer level, and its Galerkin operator */
+    struct CoarseLevel
+    {
+        StdVec<size_t> aggregate_; /**< the aggregate of each row of the finer level */
+        StdVec<Arrayi> cells_;     /**< background cell of each aggregate */
+        StdVec<size_t> row_offsets_, columns_;
+        StdVec<Real> off_diagonal_, diagonal_; /**< entries of the operator */
+        StdVec<Real> solution_, rhs_, residual_;
+        size_t size() const { return cells_.size(); };
+    };
+
+  public:
+    template <typename DiffusionArg>
+    SteadyDiffusion(BaseInnerRelation &inner_relation, DiffusionArg &&diffusions,
+                    Real tolerance = 1.0e-8, UnsignedInt max_cycles = 100, size_t coarsest_size = 64);
+    virtual ~SteadyDiffusion(){};
+
+    /** number of V-cycles, i.e. preconditioned conjugate gradient iterations, of the last solve */
+    UnsignedInt Cycles() { return this->iterations_; };
+    size_t NumberOfLevels() { return coarse_levels_.size() + 1; };
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    size_t coarsest_size_;
+    UnsignedInt smoothing_sweeps_;
+    UnsignedInt coarsest_sweeps_;
+    Real jacobi_weight_;
+    Real correction_factor_; /**< over-correction compensating the piecewise constant prolongation */
+    size_t hierarchy_rebuilds_;
+    Vecd *pos_;
+    StdVec<CoarseLevel> coarse_levels_;
+    StdVec<Real> preconditioned_, fine_residual_;
+
+    /** aggregate the particles level by level until the coarsest size is reached */
+    void buildHierarchy();
+    /** Galerkin product of the finer operator, given by the entries of each of its rows */
+    template <class RowEntries>
+    void buildCoarseOperator(CoarseLevel &coarse_level, size_t fine_size, const RowEntries &row_entries);
+    void buildCoarseOperators(size_t species_index);
+    Real coarseOperatorProduct(CoarseLevel &coarse_level, size_t index_i, Real *field);
+    /** V-cycle on the coarse levels starting from a zero initial guess */
+    void coarseCycle(size_t level);
+    /** one V-cycle for the preconditioned residual of the particles */
+    void precondition(size_t species_index);
+};
+
+template <class DiffusionType>
+using SteadyDiffusionInner =
+    SteadyDiffusion<KernelGradientInner, KernelGradientContact, DiffusionType>;
+template <class DiffusionType>
+using SteadyDiffusionCorrectedInner =
+    SteadyDiffusion<CorrectedKernelGradientInner, CorrectedKernelGradientContact, DiffusionType>;
+} // namespace SPH
+#endif // STEADY_DIFFUSION_DYNAMICS_H
@@ -0,0 +1,349 @@
+/**
+ * @file 	steady_diffusion_dynamics.hpp
+ * @brief 	Multigrid preconditioned steady-state diffusion of all species.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef STEADY_DIFFUSION_DYNAMICS_HPP
+#define STEADY_DIFFUSION_DYNAMICS_HPP
+
+#include "steady_diffusion_dynamics.h"
+
+#include "implicit_diffusion_dynamics.hpp"
+
+#include <map>
+#include <unordered_map>
+
+namespace SPH
+{
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+template <typename DiffusionArg>
+SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    SteadyDiffusion(BaseInnerRelation &inner_relation, DiffusionArg &&diffusions,
+                    Real tolerance, UnsignedInt max_cycles, size_t coarsest_size)
+    : BaseImplicitDiffusion(inner_relation, std::forward<DiffusionArg>(diffusions), 1.0, tolerance, max_cycles),
+      coarsest_size_(coarsest_size), smoothing_sweeps_(2), coarsest_sweeps_(20), jacobi_weight_(2.0 / 3.0),
+      correction_factor_(1.8),
+      pos_(this->particles_->template getVariableDataByName<Vecd>("Position")) {}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    buildHierarchy()
+{
+    coarse_levels_.clear();
+    size_t fine_size = this->identifier_.LoopRange().size();
+    if (fine_size <= coarsest_size_)
+        return;
+
+    Vecd lower_bound = pos_[0];
+    for (size_t i = 1; i != fine_size; ++i)
+        lower_bound = lower_bound.cwiseMin(pos_[i]);
+
+    // the first coarse level aggregates particles by cells of twice the reference spacing
+    Real cell_size = 2.0 * this->sph_body_.getSPHBodyResolutionRef();
+    StdVec<Arrayi> fine_cells(fine_size);
+    for (size_t i = 0; i != fine_size; ++i)
+        fine_cells[i] = ((pos_[i] - lower_bound) / cell_size).array().floor().template cast<int>();
+
+    while (true)
+    {
+        CoarseLevel coarse_level;
+        coarse_level.aggregate_.resize(fine_size);
+        std::unordered_map<size_t, size_t> cell_aggregates;
+        for (size_t i = 0; i != fine_size; ++i)
+        {
+            size_t cell_key = 0;
+            for (int d = 0; d != Dimensions; ++d)
+                cell_key |= size_t(fine_cells[i][d]) << (21 * d);
+
+            auto inserted = cell_aggregates.emplace(cell_key, coarse_level.size());
+            if (inserted.second)
+                coarse_level.cells_.push_back(fine_cells[i]);
+            coarse_level.aggregate_[i] = inserted.first->second;
+        }
+
+        // stop if the particles are not coarsened anymore, e.g. for a thin body
+        if (10 * coarse_level.size() > 9 * fine_size)
+            break;
+
+        coarse_levels_.push_back(coarse_level);
+        fine_size = coarse_level.size();
+        if (fine_size <= coarsest_size_)
+            break;
+
+        fine_cells.resize(fine_size);
+        for (size_t i = 0; i != fine_size; ++i)
+            fine_cells[i] = coarse_levels_.back().cells_[i] / 2;
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+template <class RowEntries>
+void SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    buildCoarseOperator(CoarseLevel &coarse_level, size_t fine_size, const RowEntries &row_entries)
+{
+    size_t coarse_size = coarse_level.size();
+    StdVec<std::map<size_t, Real>> coarse_rows(coarse_size);
+    for (size_t i = 0; i != fine_size; ++i)
+    {
+        std::map<size_t, Real> &coarse_row = coarse_rows[coarse_level.aggregate_[i]];
+        row_entries(i, [&](size_t index_j, Real entry)
+                    { coarse_row[coarse_level.aggregate_[index_j]] += entry; });
+    }
+
+    coarse_level.row_offsets_.assign(coarse_size + 1, 0);
+    coarse_level.columns_.clear();
+    coarse_level.off_diagonal_.clear();
+    coarse_level.diagonal_.assign(coarse_size, 0.0);
+    for (size_t i = 0; i != coarse_size; ++i)
+    {
+        for (const auto &entry : coarse_rows[i])
+        {
+            if (entry.first == i)
+            {
+                coarse_level.diagonal_[i] = entry.second;
+            }
+            else
+            {
+                coarse_level.columns_.push_back(entry.first);
+                coarse_level.off_diagonal_.push_back(entry.second);
+            }
+        }
+        coarse_level.row_offsets_[i + 1] = coarse_level.columns_.size();
+    }
+    coarse_level.solution_.assign(coarse_size, 0.0);
+    coarse_level.rhs_.assign(coarse_size, 0.0);
+    coarse_level.residual_.assign(coarse_size, 0.0);
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    buildCoarseOperators(size_t m)
+{
+    if (coarse_levels_.empty())
+        return;
+
+    buildCoarseOperator(coarse_levels_[0], this->identifier_.LoopRange().size(),
+                        [&](size_t i, const auto &add_entry)
+                        {
+                            add_entry(i, this->laplacian_diagonal_[m][i]);
+                            size_t row_offset = this->row_offsets_[i];
+                            for (size_t n = 0; n != this->row_sizes_[i]; ++n)
+                                add_entry(this->columns_[row_offset + n], -this->coefficients_[m][row_offset + n]);
+                        });
+
+    for (size_t k = 1; k != coarse_levels_.size(); ++k)
+    {
+        CoarseLevel &fine_level = coarse_levels_[k - 1];
+        buildCoarseOperator(coarse_levels_[k], fine_level.size(),
+                            [&](size_t i, const auto &add_entry)
+                            {
+                                add_entry(i, fine_level.diagonal_[i]);
+                                for (size_t n = fine_level.row_offsets_[i]; n != fine_level.row_offsets_[i + 1]; ++n)
+                                    add_entry(fine_level.columns_[n], fine_level.off_diagonal_[n]);
+                            });
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+Real SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    coarseOperatorProduct(CoarseLevel &coarse_level, size_t index_i, Real *field)
+{
+    Real product = coarse_level.diagonal_[index_i] * field[index_i];
+    for (size_t n = coarse_level.row_offsets_[index_i]; n != coarse_level.row_offsets_[index_i + 1]; ++n)
+    {
+        product += coarse_level.off_diagonal_[n] * field[coarse_level.columns_[n]];
+    }
+    return product;
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    coarseCycle(size_t level)
+{
+    CoarseLevel &coarse_level = coarse_levels_[level];
+    IndexRange level_range(0, coarse_level.size());
+    Real *solution = coarse_level.solution_.data();
+
+    if (level + 1 == coarse_levels_.size())
+    {
+        // symmetric Gauss-Seidel sweeps keep the preconditioner symmetric
+        std::fill(coarse_level.solution_.begin(), coarse_level.solution_.end(), 0.0);
+        auto gauss_seidel = [&](size_t i)
+        {
+            Real off_diagonal_product = coarseOperatorProduct(coarse_level, i, solution) -
+                                        coarse_level.diagonal_[i] * solution[i];
+            solution[i] = (coarse_level.rhs_[i] - off_diagonal_product) / (coarse_level.diagonal_[i] + TinyReal);
+        };
+        for (UnsignedInt k = 0; k != coarsest_sweeps_; ++k)
+        {
+            for (size_t i = 0; i != coarse_level.size(); ++i)
+                gauss_seidel(i);
+            for (size_t i = coarse_level.size(); i != 0; --i)
+                gauss_seidel(i - 1);
+        }
+        return;
+    }
+
+    auto jacobi_sweeps = [&]()
+    {
+        for (UnsignedInt k = 0; k != smoothing_sweeps_; ++k)
+        {
+            particle_for(ExecutionPolicy(), level_range,
+                         [&](size_t i)
+                         { coarse_level.residual_[i] = coarse_level.rhs_[i] - coarseOperatorProduct(coarse_level, i, solution); });
+            particle_for(ExecutionPolicy(), level_range,
+                         [&](size_t i)
+                         { solution[i] += jacobi_weight_ * coarse_level.residual_[i] / (coarse_level.diagonal_[i] + TinyReal); });
+        }
+    };
+
+    std::fill(coarse_level.solution_.begin(), coarse_level.solution_.end(), 0.0);
+    jacobi_sweeps();
+
+    CoarseLevel &next_level = coarse_levels_[level + 1];
+    particle_for(ExecutionPolicy(), level_range,
+                 [&](size_t i)
+                 { coarse_level.residual_[i] = coarse_level.rhs_[i] - coarseOperatorProduct(coarse_level, i, solution); });
+    std::fill(next_level.rhs_.begin(), next_level.rhs_.end(), 0.0);
+    for (size_t i = 0; i != coarse_level.size(); ++i)
+        next_level.rhs_[next_level.aggregate_[i]] += coarse_level.residual_[i];
+
+    coarseCycle(level + 1);
+
+    particle_for(ExecutionPolicy(), level_range,
+                 [&](size_t i)
+                 { solution[i] += correction_factor_ * next_level.solution_[next_level.aggregate_[i]]; });
+    jacobi_sweeps();
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    precondition(size_t m)
+{
+    IndexRange loop_range = this->identifier_.LoopRange();
+    Real *preconditioned = preconditioned_.data();
+    auto jacobi_sweeps = [&]()
+    {
+        for (UnsignedInt k = 0; k != smoothing_sweeps_; ++k)
+        {
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         { fine_residual_[i] = this->residual_[i] - this->laplacianProduct(m, i, preconditioned); });
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         { preconditioned[i] += jacobi_weight_ * fine_residual_[i] / (this->laplacian_diagonal_[m][i] + TinyReal); });
+        }
+    };
+
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 { preconditioned[i] = 0.0; });
+    jacobi_sweeps();
+
+    if (!coarse_levels_.empty())
+    {
+        CoarseLevel &coarse_level = coarse_levels_[0];
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { fine_residual_[i] = this->residual_[i] - this->laplacianProduct(m, i, preconditioned); });
+        std::fill(coarse_level.rhs_.begin(), coarse_level.rhs_.end(), 0.0);
+        for (size_t i = 0; i != loop_range.size(); ++i)
+            coarse_level.rhs_[coarse_level.aggregate_[i]] += fine_residual_[i];
+
+        coarseCycle(0);
+
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { preconditioned[i] += correction_factor_ * coarse_level.solution_[coarse_level.aggregate_[i]]; });
+        jacobi_sweeps();
+    }
+}
+//=================================================================================================//
+template <class KernelGradientType, class ContactKernelGradientType, class DiffusionType, class ExecutionPolicy>
+void SteadyDiffusion<KernelGradientType, ContactKernelGradientType, DiffusionType, ExecutionPolicy>::
+    exec(Real dt)
+{
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+    this->setUpdated(this->identifier_.getSPHBody());
+    this->setupDynamics(dt);
+    IndexRange loop_range = this->identifier_.LoopRange();
+
+    this->resizeWorkArrays();
+    if (preconditioned_.size() < this->residual_.size())
+    {
+        preconditioned_.resize(this->residual_.size());
+        fine_residual_.resize(this->residual_.size());
+    }
+    this->updateMatrixStructure();
+
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 { this->assembleMatrix(i); });
+    buildHierarchy();
+
+    this->iterations_ = 0;
+    this->relative_residual_ = 0.0;
+    for (size_t m = 0; m != this->diffusions_.size(); ++m)
+    {
+        buildCoarseOperators(m);
+        Real *species = this->diffusion_species_[m];
+        StdVec<Real> &boundary_source = this->boundary_source_[m];
+
+        // warm started from the current species, the residual is b - L phi
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { this->residual_[i] = boundary_source[i] - this->laplacianProduct(m, i, species); });
+        precondition(m);
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { this->direction_[i] = preconditioned_[i]; });
+        Real source_norm = std::sqrt(this->sum([&](size_t i) -> Real
+                                               { return boundary_source[i] * boundary_source[i]; }));
+        Real residual_dot = this->sum([&](size_t i) -> Real
+                                      { return this->residual_[i] * preconditioned_[i]; });
+        Real relative_residual = std::sqrt(this->sum([&](size_t i) -> Real
+                                                     { return this->residual_[i] * this->residual_[i]; })) /
+                                 (source_norm + TinyReal);
+
+        UnsignedInt cycles = 0;
+        while (relative_residual > this->tolerance_ && cycles < this->max_iterations_)
+        {
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         { this->operator_direction_[i] = this->laplacianProduct(m, i, this->direction_.data()); });
+            Real alpha = residual_dot / (this->sum([&](size_t i) -> Real
+                                                   { return this->direction_[i] * this->operator_direction_[i]; }) +
+                                         TinyReal);
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         {
+                             species[i] += alpha * this->direction_[i];
+                             this->residual_[i] -= alpha * this->operator_direction_[i];
+                         });
+            precondition(m);
+            Real new_residual_dot = this->sum([&](size_t i) -> Real
+                                              { return this->residual_[i] * preconditioned_[i]; });
+            Real beta = new_residual_dot / (residual_dot + TinyReal);
+            residual_dot = new_residual_dot;
+            particle_for(ExecutionPolicy(), loop_range,
+                         [&](size_t i)
+                         { this->direction_[i] = preconditioned_[i] + beta * this->direction_[i]; });
+            relative_residual = std::sqrt(this->sum([&](size_t i) -> Real
+                                                    { return this->residual_[i] * this->residual_[i]; })) /
+                                (source_norm + TinyReal);
+            ++cycles;
+        }
+        this->iterations_ = SMAX(this->iterations_, cycles);
+        this->relative_residual_ = SMAX(this->relative_residual_, relative_residual);
+
+        // the solution is steady
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { this->diffusion_dt_[m][i] = 0.0; });
+    }
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // STEADY_DIFFUSION_DYNAMICS_HPP
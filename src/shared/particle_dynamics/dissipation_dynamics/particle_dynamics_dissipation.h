@@ -180,18 +180,24 @@ using DampingPairwiseWithWall = ComplexInteraction<Damping<Inner<Pairwise>, Cont
  * Note that, if periodic boundary condition is applied,
  * the parallelized version of the method requires the one using ghost particles
  * because the splitting partition only works in this case.
+ * The choice is drawn from a counter-based random number of the seed and the number of executions,
+ * and the split sweeps visit the sorted cell lists, so that the results are reproducible
+ * independent of the number of threads.
  */
 template <class DampingAlgorithmType>
 class DampingWithRandomChoice : public DampingAlgorithmType
 {
   protected:
     Real random_ratio_;
+    uint32_t random_seed_;
+    uint64_t number_of_choices_;
     bool RandomChoice();
 
   public:
     template <typename... Args>
     DampingWithRandomChoice(Real random_ratio, Args &&...args);
     virtual ~DampingWithRandomChoice(){};
+    void setRandomSeed(uint32_t random_seed) { random_seed_ = random_seed; };
 
     virtual void exec(Real dt = 0.0) override;
 };
@@ -160,14 +160,15 @@ template <class DampingAlgorithmType>
 template <typename... Args>
 DampingWithRandomChoice<DampingAlgorithmType>::
     DampingWithRandomChoice(Real random_ratio, Args &&...args)
-    : DampingAlgorithmType(std::forward<Args>(args)...), random_ratio_(random_ratio)
+    : DampingAlgorithmType(std::forward<Args>(args)...), random_ratio_(random_ratio),
+      random_seed_(0), number_of_choices_(0)
 {
 }
 //=================================================================================================//
 template <class DampingAlgorithmType>
 bool DampingWithRandomChoice<DampingAlgorithmType>::RandomChoice()
 {
-    return rand_uniform(0.0, 1.0) < random_ratio_ ? true : false;
+    return rand_uniform_counter_based(random_seed_, number_of_choices_++, 0.0, 1.0) < random_ratio_ ? true : false;
 }
 //=================================================================================================//
 template <class DampingAlgorithmType>
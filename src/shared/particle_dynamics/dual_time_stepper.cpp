@@ -0,0 +1,225 @@
+#include "dual_time_stepper.h"
+
+#include "timeline_tracer.h"
+
+#include <iomanip>
+
+namespace SPH
+{
+//=================================================================================================//
+DualTimeStepper::DualTimeStepper(SPHSystem &sph_system, const DualTimeStepperParameters &parameters)
+    : sph_system_(sph_system), parameters_(parameters),
+      sv_physical_time_(sph_system.getSystemVariableByName<Real>("PhysicalTime")),
+      advection_time_step_(nullptr), acoustic_time_step_(nullptr),
+      advection_time_step_position_(0), number_of_iterations_(0) {}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::setAdvectionTimeStep(BaseDynamics<Real> &time_step)
+{
+    advection_time_step_ = &time_step;
+    advection_time_step_position_ = advection_stages_.size();
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::setAcousticTimeStep(BaseDynamics<Real> &time_step)
+{
+    acoustic_time_step_ = &time_step;
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addAdvectionStage(BaseDynamics<void> &dynamics)
+{
+    advection_stages_.push_back(createStage(dynamics));
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addAcousticStage(BaseDynamics<void> &dynamics)
+{
+    acoustic_stages_.push_back(createStage(dynamics));
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addAdvectionCloseStage(BaseDynamics<void> &dynamics)
+{
+    advection_close_stages_.push_back(createStage(dynamics));
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addParticleSort(BaseDynamics<void> &particle_sort)
+{
+    particle_sorts_.push_back(createStage(particle_sort));
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addConfigurationUpdate(BaseDynamics<void> &dynamics)
+{
+    configuration_updates_.push_back(createStage(dynamics));
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addBodyStatesOutput(const std::function<void()> &output)
+{
+    body_states_outputs_.push_back(output);
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addObservation(const std::function<void(size_t)> &observation)
+{
+    observations_.push_back(observation);
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper &DualTimeStepper::addRestartOutput(const std::function<void(size_t)> &restart_output)
+{
+    restart_outputs_.push_back(restart_output);
+    return *this;
+}
+//=================================================================================================//
+DualTimeStepper::Stage DualTimeStepper::createStage(BaseDynamics<void> &dynamics)
+{
+    BaseDynamics<void> *dynamics_ptr = &dynamics;
+    return Stage{[=](Real dt)
+                 { dynamics_ptr->exec(dt); },
+                 TimeInterval()};
+}
+//=================================================================================================//
+void DualTimeStepper::execStages(StdVec<Stage> &stages, Real dt)
+{
+    for (Stage &stage : stages)
+    {
+        TickCount time_instance = TickCount::now();
+        stage.function_(dt);
+        stage.interval_ += TickCount::now() - time_instance;
+    }
+}
+//=================================================================================================//
+Real DualTimeStepper::execAdvectionStages()
+{
+    Real advection_dt = 0.0;
+    for (size_t k = 0; k <= advection_stages_.size(); ++k)
+    {
+        if (k == advection_time_step_position_)
+        {
+            TickCount time_instance = TickCount::now();
+            advection_dt = advection_time_step_->exec();
+            interval_computing_time_step_ += TickCount::now() - time_instance;
+        }
+        if (k != advection_stages_.size())
+        {
+            Stage &stage = advection_stages_[k];
+            TickCount time_instance = TickCount::now();
+            stage.function_(advection_dt);
+            stage.interval_ += TickCount::now() - time_instance;
+        }
+    }
+    return advection_dt;
+}
+//=================================================================================================//
+Real DualTimeStepper::execAcousticSubSteps(Real advection_dt)
+{
+    TimelineTracer::Scope timeline_scope("stepper", "acoustic_sub_steps");
+    Real relaxation_time = 0.0;
+    Real acoustic_dt = 0.0;
+    while (relaxation_time < advection_dt)
+    {
+        TickCount time_instance = TickCount::now();
+        acoustic_dt = acoustic_time_step_->exec();
+        interval_computing_time_step_ += TickCount::now() - time_instance;
+
+        execStages(acoustic_stages_, acoustic_dt);
+        relaxation_time += acoustic_dt;
+        sv_physical_time_->incrementValue(acoustic_dt);
+    }
+    return acoustic_dt;
+}
+//=================================================================================================//
+void DualTimeStepper::writeBodyStates()
+{
+    TickCount time_instance = TickCount::now();
+    for (auto &output : body_states_outputs_)
+        output();
+    interval_output_ += TickCount::now() - time_instance;
+}
+//=================================================================================================//
+void DualTimeStepper::run()
+{
+    if (advection_time_step_ == nullptr || acoustic_time_step_ == nullptr)
+    {
+        std::cout << "\n Error: the advection or acoustic time step is not set for the dual time stepper!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    number_of_iterations_ = sph_system_.RestartStep();
+    TickCount t1 = TickCount::now();
+    writeBodyStates();
+    for (auto &observation : observations_)
+        observation(number_of_iterations_);
+
+    while (sv_physical_time_->getValue() < parameters_.end_time_)
+    {
+        Real integration_time = 0.0;
+        while (integration_time < parameters_.output_interval_)
+        {
+            Real start_time = sv_physical_time_->getValue();
+            Real advection_dt = execAdvectionStages();
+            Real acoustic_dt = execAcousticSubSteps(advection_dt);
+            integration_time += sv_physical_time_->getValue() - start_time;
+
+            if (number_of_iterations_ % parameters_.screen_output_interval_ == 0)
+            {
+                std::cout << std::fixed << std::setprecision(9) << "N=" << number_of_iterations_ << "\tTime = "
+                          << sv_physical_time_->getValue()
+                          << "\tadvection_dt = " << advection_dt << "\tacoustic_dt = " << acoustic_dt << "\n";
+            }
+
+            TickCount time_instance = TickCount::now();
+            if (parameters_.observation_interval_ != 0 &&
+                number_of_iterations_ % parameters_.observation_interval_ == 0 &&
+                number_of_iterations_ != sph_system_.RestartStep())
+            {
+                for (auto &observation : observations_)
+                    observation(number_of_iterations_);
+            }
+            if (parameters_.restart_interval_ != 0 && number_of_iterations_ % parameters_.restart_interval_ == 0)
+            {
+                for (auto &restart_output : restart_outputs_)
+                    restart_output(number_of_iterations_);
+            }
+            interval_output_ += TickCount::now() - time_instance;
+            number_of_iterations_++;
+
+            execStages(advection_close_stages_, advection_dt);
+            if (parameters_.sort_interval_ != 0 &&
+                number_of_iterations_ % parameters_.sort_interval_ == 0 && number_of_iterations_ != 1)
+            {
+                execStages(particle_sorts_, advection_dt);
+            }
+            execStages(configuration_updates_, advection_dt);
+        }
+        writeBodyStates();
+    }
+    writeReport(TickCount::now() - t1 - interval_output_);
+}
+//=================================================================================================//
+void DualTimeStepper::writeReport(TimeInterval total_interval)
+{
+    auto accumulate = [](const StdVec<Stage> &stages)
+    {
+        TimeInterval interval;
+        for (const Stage &stage : stages)
+            interval += stage.interval_;
+        return interval;
+    };
+
+    std::cout << std::fixed << std::setprecision(9)
+              << "Total wall time for computation: " << total_interval.seconds() << " seconds.\n"
+              << "interval_computing_time_step = " << interval_computing_time_step_.seconds() << "\n"
+              << "interval_advection_stages = " << accumulate(advection_stages_).seconds() << "\n"
+              << "interval_acoustic_steps = " << accumulate(acoustic_stages_).seconds() << "\n"
+              << "interval_advection_close_stages = " << accumulate(advection_close_stages_).seconds() << "\n"
+              << "interval_sorting = " << accumulate(particle_sorts_).seconds() << "\n"
+              << "interval_updating_configuration = " << accumulate(configuration_updates_).seconds() << "\n"
+              << "interval_output = " << interval_output_.seconds() << "\n";
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,118 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	dual_time_stepper.h
+ * @brief 	The dual time stepping loop of weakly compressible flows, i.e. the advection steps
+ *			with nested acoustic sub-steps, shared by the simulation drivers.
+ * @details The dynamics of each stage are given by reference and executed in the order added.
+ *			Particle sorting, observations, restart files and body state outputs follow
+ *			the cadences in the parameters, the latter only at the boundaries of output intervals,
+ *			and the wall-clock time of each stage is accumulated and reported.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DUAL_TIME_STEPPER_H
+#define DUAL_TIME_STEPPER_H
+
+#include "base_particle_dynamics.h"
+#include "sph_system.h"
+
+#include <functional>
+
+namespace SPH
+{
+struct DualTimeStepperParameters
+{
+    Real end_time_ = 1.0;
+    Real output_interval_ = 0.1;          /**< physical time between body state outputs */
+    size_t screen_output_interval_ = 100; /**< in advection steps */
+    size_t observation_interval_ = 0;     /**< in advection steps, no output if zero */
+    size_t restart_interval_ = 0;         /**< in advection steps, no output if zero */
+    size_t sort_interval_ = 100;          /**< in advection steps, no sorting if zero */
+};
+
+/**
+ * @class DualTimeStepper
+ * @brief The advection time step size is computed at the position it is set within the advection stages,
+ * so that the stages added after it are executed with it, e.g. an advection step setup after
+ * the density regularization. The acoustic time step size is computed first in each sub-step.
+ * Outputs are given as functions so that the writers may be asynchronous or
+ * given with their execution policy, e.g. writeToFile(MyExecutionPolicy{}).
+ */
+class DualTimeStepper
+{
+    struct Stage
+    {
+        std::function<void(Real)> function_;
+        TimeInterval interval_;
+    };
+
+  public:
+    DualTimeStepper(SPHSystem &sph_system, const DualTimeStepperParameters &parameters);
+    virtual ~DualTimeStepper(){};
+
+    DualTimeStepper &setAdvectionTimeStep(BaseDynamics<Real> &time_step);
+    DualTimeStepper &setAcousticTimeStep(BaseDynamics<Real> &time_step);
+    /** executed once in each advection step before the acoustic sub-steps */
+    DualTimeStepper &addAdvectionStage(BaseDynamics<void> &dynamics);
+    /** executed in each acoustic sub-step */
+    DualTimeStepper &addAcousticStage(BaseDynamics<void> &dynamics);
+    /** executed once in each advection step after the acoustic sub-steps */
+    DualTimeStepper &addAdvectionCloseStage(BaseDynamics<void> &dynamics);
+    /** executed before the configuration update with the sort interval */
+    DualTimeStepper &addParticleSort(BaseDynamics<void> &particle_sort);
+    /** cell linked lists and relations updated at the end of each advection step */
+    DualTimeStepper &addConfigurationUpdate(BaseDynamics<void> &dynamics);
+    DualTimeStepper &addBodyStatesOutput(const std::function<void()> &output);
+    /** the argument is the number of advection steps */
+    DualTimeStepper &addObservation(const std::function<void(size_t)> &observation);
+    DualTimeStepper &addRestartOutput(const std::function<void(size_t)> &restart_output);
+
+    /** runs to the end time from the current physical time and restart step */
+    void run();
+    size_t TotalAdvectionSteps() { return number_of_iterations_; };
+
+  protected:
+    SPHSystem &sph_system_;
+    DualTimeStepperParameters parameters_;
+    SingularVariable<Real> *sv_physical_time_;
+    BaseDynamics<Real> *advection_time_step_;
+    BaseDynamics<Real> *acoustic_time_step_;
+    size_t advection_time_step_position_;
+    StdVec<Stage> advection_stages_, acoustic_stages_, advection_close_stages_;
+    StdVec<Stage> particle_sorts_, configuration_updates_;
+    StdVec<std::function<void()>> body_states_outputs_;
+    StdVec<std::function<void(size_t)>> observations_, restart_outputs_;
+    size_t number_of_iterations_;
+    TimeInterval interval_computing_time_step_;
+    TimeInterval interval_output_;
+
+    Stage createStage(BaseDynamics<void> &dynamics);
+    void execStages(StdVec<Stage> &stages, Real dt);
+    Real execAdvectionStages();
+    Real execAcousticSubSteps(Real advection_dt);
+    void writeBodyStates();
+    void writeReport(TimeInterval total_interval);
+};
+} // namespace SPH
+#endif // DUAL_TIME_STEPPER_H
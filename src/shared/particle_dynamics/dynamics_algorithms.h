@@ -29,6 +29,7 @@
  * 			SimpleDynamics is without particle interaction. Particles just update their states;
  *			InteractionDynamics is with particle interaction with its neighbors;
  *			InteractionSplit is InteractionDynamics but using spliting algorithm;
+ *			InteractionBlockSplit is InteractionSplit with fewer synchronization points;
  *			InteractionWithUpdate is with particle interaction with its neighbors and then update their states;
  *			Dynamics1Level is the most complex dynamics, has successive three steps: initialization, interaction and update.
  *			In order to avoid misusing of the above algorithms, type traits are used to make sure that the matching between
@@ -53,9 +54,12 @@
 #include "base_local_dynamics.h"
 #include "base_particle_dynamics.h"
 #include "cell_linked_list.hpp"
+#include "particle_functors.h"
 #include "particle_iterators.h"
 
+#include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace SPH
 {
@@ -89,14 +93,49 @@ struct has_update<T, std::void_t<decltype(&T::update)>> : std::true_type
 {
 };
 
+template <class T, class = void>
+struct has_symmetric_interaction : std::false_type
+{
+};
+
+template <class T>
+struct has_symmetric_interaction<T, std::void_t<decltype(&T::symmetricInteraction)>> : std::true_type
+{
+};
+
 using namespace execution;
 
+/**
+ * @class PartitionedLoops
+ * @brief The partitioners of the particle loops of a classic particle dynamics,
+ * in their order within exec(), which are passed to particle_for and particle_reduce.
+ */
+class PartitionedLoops
+{
+  public:
+    LoopPartitioner &getLoopPartitioner(size_t loop_index = 0) { return loop_partitioners_[loop_index]; };
+    void setLoopPartitioner(PartitionerType type, size_t grain_size = 1)
+    {
+        for (LoopPartitioner &loop_partitioner : loop_partitioners_)
+            loop_partitioner.setPartitioner(type, grain_size);
+    };
+    void enableLoopAutoTuning(size_t calls_per_candidate = 4, size_t serial_loop_size_limit = 1024)
+    {
+        for (LoopPartitioner &loop_partitioner : loop_partitioners_)
+            loop_partitioner.enableAutoTuning(calls_per_candidate, serial_loop_size_limit);
+    };
+
+  protected:
+    static constexpr size_t number_of_loops_ = 3;
+    LoopPartitioner loop_partitioners_[number_of_loops_];
+};
+
 /**
  * @class SimpleDynamics
  * @brief Simple particle dynamics without considering particle interaction
  */
 template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
-class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
+class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>, public PartitionedLoops
 {
   public:
     template <class DynamicsIdentifier, typename... Args>
@@ -112,11 +151,14 @@ class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
 
     virtual void exec(Real dt = 0.0) override
     {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         this->setUpdated(this->identifier_.getSPHBody());
         this->setupDynamics(dt);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
-                     [&](size_t i) { this->update(i, dt); });
+                     [&](size_t i) { this->update(i, dt); },
+                     this->loop_partitioners_[0]);
+        this->finishDynamics(dt);
     };
 };
 
@@ -126,7 +168,8 @@ class SimpleDynamics : public LocalDynamicsType, public BaseDynamics<void>
  */
 template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
 class ReduceDynamics : public LocalDynamicsType,
-                       public BaseDynamics<typename LocalDynamicsType::ReturnType>
+                       public BaseDynamics<typename LocalDynamicsType::ReturnType>,
+                       public PartitionedLoops
 {
   public:
     using ReturnType = typename LocalDynamicsType::ReturnType;
@@ -141,20 +184,127 @@ class ReduceDynamics : public LocalDynamicsType,
 
     virtual ReturnType exec(Real dt = 0.0) override
     {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         this->setupDynamics(dt);
         ReturnType temp = particle_reduce(ExecutionPolicy(),
                                           this->identifier_.LoopRange(), this->Reference(), this->getOperation(),
-                                          [&](size_t i) -> ReturnType { return this->reduce(i, dt); });
+                                          [&](size_t i) -> ReturnType { return this->reduce(i, dt); },
+                                          this->loop_partitioners_[0]);
         return this->outputResult(temp);
     };
 };
 
+/**
+ * @class FusedReduceDynamics
+ * @brief Several particle-wise reduce operations on the same dynamics identifier in one particle loop.
+ * The local reduce dynamics are constructed from ConstructorArgs with the identifier and their other arguments,
+ * and the results are returned as a tuple in the order of the local reduce dynamics.
+ */
+template <class ExecutionPolicy, class... LocalDynamicsTypes>
+class FusedReduceDynamics
+    : public BaseDynamics<std::tuple<typename LocalDynamicsTypes::ReturnType...>>,
+      public PartitionedLoops
+{
+    static_assert(sizeof...(LocalDynamicsTypes) != 0, "No local reduce dynamics given!");
+    using Indices = std::index_sequence_for<LocalDynamicsTypes...>;
+    using AccumulatedTuple = std::tuple<AccumulatedType<typename LocalDynamicsTypes::ReturnType>...>;
+
+  public:
+    using ReturnType = std::tuple<typename LocalDynamicsTypes::ReturnType...>;
+    template <typename... ParameterSets>
+    explicit FusedReduceDynamics(ParameterSets &&...parameter_sets)
+        : BaseDynamics<ReturnType>(),
+          local_dynamics_(makeLocalDynamics<LocalDynamicsTypes>(std::forward<ParameterSets>(parameter_sets))...)
+    {
+        static_assert(sizeof...(ParameterSets) == sizeof...(LocalDynamicsTypes),
+                      "One parameter set is required for each local reduce dynamics!");
+        checkDynamicsIdentifiers(Indices{});
+    };
+    virtual ~FusedReduceDynamics(){};
+
+    template <size_t Index>
+    auto &getLocalDynamics() { return *std::get<Index>(local_dynamics_); };
+    StdVec<std::string> QuantityNames() { return quantityNames(Indices{}); };
+    std::string DynamicsIdentifierName() { return getLocalDynamics<0>().getDynamicsIdentifier().getName(); };
+
+    virtual ReturnType exec(Real dt = 0.0) override
+    {
+        auto &identifier = getLocalDynamics<0>().getDynamicsIdentifier();
+        auto profiling_scope = this->profilingScope(getLocalDynamics<0>().getSPHBody().getSPHSystem(), identifier);
+        std::apply([&](auto &...local_dynamics)
+                   { (local_dynamics->setupDynamics(dt), ...); },
+                   local_dynamics_);
+        AccumulatedTuple temp = particle_reduce(
+            ExecutionPolicy(), identifier.LoopRange(), reference(Indices{}),
+            [&](const AccumulatedTuple &x, const AccumulatedTuple &y) -> AccumulatedTuple
+            { return operate(x, y, Indices{}); },
+            [&](size_t i) -> AccumulatedTuple
+            { return reduce(i, dt, Indices{}); },
+            this->loop_partitioners_[0]);
+        return outputResults(temp, Indices{});
+    };
+
+  protected:
+    std::tuple<UniquePtr<LocalDynamicsTypes>...> local_dynamics_;
+
+    template <class LocalDynamicsType, class DynamicsIdentifier, typename... Args>
+    static UniquePtr<LocalDynamicsType> makeLocalDynamics(ConstructorArgs<DynamicsIdentifier, Args...> parameters)
+    {
+        return std::apply([&](auto &&...args)
+                          { return makeUnique<LocalDynamicsType>(parameters.body_relation_, args...); },
+                          parameters.others_);
+    };
+
+    template <size_t... Is>
+    void checkDynamicsIdentifiers(std::index_sequence<Is...>)
+    {
+        void *identifier = &getLocalDynamics<0>().getDynamicsIdentifier();
+        if (((identifier != static_cast<void *>(&getLocalDynamics<Is>().getDynamicsIdentifier())) || ...))
+        {
+            std::cout << "\n Error: the fused reduce dynamics are not on the same dynamics identifier!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    };
+
+    template <size_t... Is>
+    StdVec<std::string> quantityNames(std::index_sequence<Is...>)
+    {
+        return {getLocalDynamics<Is>().QuantityName()...};
+    };
+
+    template <size_t... Is>
+    AccumulatedTuple reference(std::index_sequence<Is...>)
+    {
+        return AccumulatedTuple(getLocalDynamics<Is>().Reference()...);
+    };
+
+    template <size_t... Is>
+    AccumulatedTuple operate(const AccumulatedTuple &x, const AccumulatedTuple &y, std::index_sequence<Is...>)
+    {
+        return AccumulatedTuple(getLocalDynamics<Is>().getOperation()(std::get<Is>(x), std::get<Is>(y))...);
+    };
+
+    template <size_t... Is>
+    AccumulatedTuple reduce(size_t index_i, Real dt, std::index_sequence<Is...>)
+    {
+        return AccumulatedTuple(getLocalDynamics<Is>().reduce(index_i, dt)...);
+    };
+
+    template <size_t... Is>
+    ReturnType outputResults(const AccumulatedTuple &reduced_values, std::index_sequence<Is...>)
+    {
+        return ReturnType(getLocalDynamics<Is>().outputResult(
+            typename LocalDynamicsTypes::ReturnType(std::get<Is>(reduced_values)))...);
+    };
+};
+
 /**
  * @class BaseInteractionDynamics
  * @brief This is the base class for particle interaction with other particles
  */
 template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
-class BaseInteractionDynamics : public LocalDynamicsType, public BaseDynamics<void>
+class BaseInteractionDynamics : public LocalDynamicsType, public BaseDynamics<void>, public PartitionedLoops
 {
   public:
     template <typename... Args>
@@ -184,6 +334,7 @@ class BaseInteractionDynamics : public LocalDynamicsType, public BaseDynamics<vo
 
     virtual void exec(Real dt = 0.0) override
     {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         this->setUpdated(this->identifier_.getSPHBody());
         this->setupDynamics(dt);
         runInteraction(dt);
@@ -227,6 +378,156 @@ using InteractionSplit = BaseInteractionSplit<LocalDynamicsType, CellLinkedList>
 template <class LocalDynamicsType>
 using InteractionAdaptiveSplit = BaseInteractionSplit<LocalDynamicsType, MultilevelCellLinkedList>;
 
+/**
+ * @class BaseInteractionBlockSplit
+ * @brief The splitting algorithm with the 2^d coloring of cell blocks,
+ * which has fewer synchronization points than InteractionSplit.
+ * The maximum absolute value of a monitored residual variable
+ * can be recorded after each sweep to report the convergence per iteration.
+ */
+template <class LocalDynamicsType, class CellLinkedListType, class ExecutionPolicy = ParallelPolicy>
+class BaseInteractionBlockSplit : public BaseInteractionSplit<LocalDynamicsType, CellLinkedListType, ExecutionPolicy>
+{
+  protected:
+    Real *monitored_residual_;
+    StdVec<Real> residual_history_;
+
+  public:
+    template <typename... Args>
+    explicit BaseInteractionBlockSplit(Args &&...args)
+        : BaseInteractionSplit<LocalDynamicsType, CellLinkedListType, ExecutionPolicy>(std::forward<Args>(args)...),
+          monitored_residual_(nullptr){};
+
+    void monitorResidual(const std::string &variable_name)
+    {
+        monitored_residual_ = this->particles_->template getVariableDataByName<Real>(variable_name);
+    };
+    StdVec<Real> &ResidualHistory() { return residual_history_; };
+
+    void runMainStep(Real dt) override
+    {
+        this->cell_linked_list_.particle_for_block_split(ExecutionPolicy(), [&](size_t i)
+                                                         { this->interaction(i, dt * 0.5); });
+        if (monitored_residual_ != nullptr)
+        {
+            residual_history_.push_back(
+                particle_reduce(ExecutionPolicy(), this->identifier_.LoopRange(), Real(0), ReduceMax(),
+                                [&](size_t i) -> Real
+                                { return ABS(monitored_residual_[i]); }));
+        }
+    }
+};
+
+template <class LocalDynamicsType>
+using InteractionBlockSplit = BaseInteractionBlockSplit<LocalDynamicsType, CellLinkedList>;
+
+template <class LocalDynamicsType>
+using InteractionAdaptiveBlockSplit = BaseInteractionBlockSplit<LocalDynamicsType, MultilevelCellLinkedList>;
+
+/**
+ * @class InteractionSymmetric
+ * @brief Inner interaction evaluating each particle pair only once.
+ * The local dynamics provides symmetricPrepare, symmetricInteraction and symmetricFinish.
+ * symmetricInteraction only handles the neighbors with larger index
+ * and writes the pair contribution to both particles.
+ * The pairs are visited with the 3^d cell coloring of the cell linked list so that no data race occurs,
+ * which requires that the neighbors are within the adjacent cells, i.e. no periodic images
+ * of PeriodicConditionUsingCellLinkedList, and the dynamics is applied on the whole body.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class InteractionSymmetric : public BaseInteractionDynamics<LocalDynamicsType, ExecutionPolicy>
+{
+  protected:
+    RealBody &real_body_;
+    CellLinkedList &cell_linked_list_;
+
+  public:
+    template <typename... Args>
+    explicit InteractionSymmetric(Args &&...args)
+        : BaseInteractionDynamics<LocalDynamicsType, ExecutionPolicy>(std::forward<Args>(args)...),
+          real_body_(DynamicCast<RealBody>(this, this->getSPHBody())),
+          cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body_.getCellLinkedList()))
+    {
+        static_assert(has_symmetric_interaction<LocalDynamicsType>::value,
+                      "LocalDynamicsType does not fulfill InteractionSymmetric requirements");
+    };
+    virtual ~InteractionSymmetric(){};
+
+    /** run the main interaction step between particles. */
+    virtual void runMainStep(Real dt) override
+    {
+        particle_for(ExecutionPolicy(),
+                     this->identifier_.LoopRange(),
+                     [&](size_t i) { this->symmetricPrepare(i, dt); },
+                     this->loop_partitioners_[1]);
+
+        cell_linked_list_.particle_for_colored(ExecutionPolicy(), [&](size_t i)
+                                               { this->symmetricInteraction(i, dt); });
+
+        particle_for(ExecutionPolicy(),
+                     this->identifier_.LoopRange(),
+                     [&](size_t i) { this->symmetricFinish(i, dt); },
+                     this->loop_partitioners_[1]);
+    }
+};
+
+/**
+ * @class InteractionSymmetricWithUpdate
+ * @brief Symmetric interaction followed by an update step.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class InteractionSymmetricWithUpdate : public InteractionSymmetric<LocalDynamicsType, ExecutionPolicy>
+{
+  public:
+    template <typename... Args>
+    explicit InteractionSymmetricWithUpdate(Args &&...args)
+        : InteractionSymmetric<LocalDynamicsType, ExecutionPolicy>(std::forward<Args>(args)...){};
+    virtual ~InteractionSymmetricWithUpdate(){};
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+        InteractionSymmetric<LocalDynamicsType, ExecutionPolicy>::exec(dt);
+        particle_for(ExecutionPolicy(),
+                     this->identifier_.LoopRange(),
+                     [&](size_t i) { this->update(i, dt); },
+                     this->loop_partitioners_[2]);
+    };
+};
+
+/**
+ * @class Dynamics1LevelSymmetric
+ * @brief Initialization, symmetric interaction and update steps.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy>
+class Dynamics1LevelSymmetric : public InteractionSymmetric<LocalDynamicsType, ExecutionPolicy>
+{
+  public:
+    template <typename... Args>
+    explicit Dynamics1LevelSymmetric(Args &&...args)
+        : InteractionSymmetric<LocalDynamicsType, ExecutionPolicy>(std::forward<Args>(args)...){};
+    virtual ~Dynamics1LevelSymmetric(){};
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+        this->setUpdated(this->identifier_.getSPHBody());
+        this->setupDynamics(dt);
+
+        particle_for(ExecutionPolicy(),
+                     this->identifier_.LoopRange(),
+                     [&](size_t i) { this->initialization(i, dt); },
+                     this->loop_partitioners_[0]);
+
+        InteractionSymmetric<LocalDynamicsType, ExecutionPolicy>::runInteraction(dt);
+
+        particle_for(ExecutionPolicy(),
+                     this->identifier_.LoopRange(),
+                     [&](size_t i) { this->update(i, dt); },
+                     this->loop_partitioners_[2]);
+    };
+};
+
 /**
  * @class InteractionDynamics
  * @brief This is the class with a single step of particle interaction with other particles
@@ -250,7 +551,8 @@ class InteractionDynamics : public BaseInteractionDynamics<LocalDynamicsType, Ex
     {
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
-                     [&](size_t i) { this->interaction(i, dt); });
+                     [&](size_t i) { this->interaction(i, dt); },
+                     this->loop_partitioners_[1]);
     }
 
   protected:
@@ -278,13 +580,57 @@ class InteractionWithUpdate : public InteractionDynamics<LocalDynamicsType, Exec
 
     virtual void exec(Real dt = 0.0) override
     {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
-                     [&](size_t i) { this->update(i, dt); });
+                     [&](size_t i) { this->update(i, dt); },
+                     this->loop_partitioners_[2]);
     };
 };
 
+/**
+ * @class InteractionInBand
+ * @brief Initialization (if defined), interaction and update (if defined) steps looping only over
+ * the particles of a body part, typically a narrow band around the surface or the awake cells,
+ * instead of the body the local dynamics is defined on.
+ */
+template <class LocalDynamicsType, class ExecutionPolicy = ParallelPolicy, class BandType = BodyPartByParticle>
+class InteractionInBand : public InteractionDynamics<LocalDynamicsType, ExecutionPolicy>
+{
+  public:
+    template <typename... Args>
+    InteractionInBand(BandType &band, Args &&... args)
+        : InteractionDynamics<LocalDynamicsType, ExecutionPolicy>(false, std::forward<Args>(args)...),
+          band_(band){};
+    virtual ~InteractionInBand(){};
+
+    virtual void runMainStep(Real dt) override
+    {
+        particle_for(ExecutionPolicy(), band_.LoopRange(),
+                     [&](size_t i) { this->interaction(i, dt); });
+    }
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+        if constexpr (has_initialize<LocalDynamicsType>::value)
+        {
+            particle_for(ExecutionPolicy(), band_.LoopRange(),
+                         [&](size_t i) { this->initialization(i, dt); });
+        }
+        InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
+        if constexpr (has_update<LocalDynamicsType>::value)
+        {
+            particle_for(ExecutionPolicy(), band_.LoopRange(),
+                         [&](size_t i) { this->update(i, dt); });
+        }
+    };
+
+  protected:
+    BandType &band_;
+};
+
 /**
  * @class InteractionWithInitialization
  * @brief This class includes an interaction and an initialization steps
@@ -304,9 +650,11 @@ class InteractionWithInitialization : public InteractionDynamics<LocalDynamicsTy
 
     virtual void exec(Real dt = 0.0) override
     {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
-                     [&](size_t i) { this->initialization(i, dt); });
+                     [&](size_t i) { this->initialization(i, dt); },
+                     this->loop_partitioners_[0]);
         InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::exec(dt);
     };
 };
@@ -329,18 +677,21 @@ class Dynamics1Level : public InteractionDynamics<LocalDynamicsType, ExecutionPo
 
     virtual void exec(Real dt = 0.0) override
     {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         this->setUpdated(this->identifier_.getSPHBody());
         this->setupDynamics(dt);
 
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
-                     [&](size_t i) { this->initialization(i, dt); });
+                     [&](size_t i) { this->initialization(i, dt); },
+                     this->loop_partitioners_[0]);
 
         InteractionDynamics<LocalDynamicsType, ExecutionPolicy>::runInteraction(dt);
 
         particle_for(ExecutionPolicy(),
                      this->identifier_.LoopRange(),
-                     [&](size_t i) { this->update(i, dt); });
+                     [&](size_t i) { this->update(i, dt); },
+                     this->loop_partitioners_[2]);
     };
 };
 } // namespace SPH
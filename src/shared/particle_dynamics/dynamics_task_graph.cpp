@@ -0,0 +1,114 @@
+#include "dynamics_task_graph.h"
+
+#include "timeline_tracer.h"
+
+namespace SPH
+{
+//=================================================================================================//
+DynamicsTaskGraph::Stage &DynamicsTaskGraph::Stage::reads(const void *data)
+{
+    reads_.insert(data);
+    return *this;
+}
+//=================================================================================================//
+DynamicsTaskGraph::Stage &DynamicsTaskGraph::Stage::writes(const void *data)
+{
+    writes_.insert(data);
+    return *this;
+}
+//=================================================================================================//
+DynamicsTaskGraph::Stage &DynamicsTaskGraph::Stage::readsOnly(const void *data)
+{
+    writes_.erase(data);
+    reads_.insert(data);
+    return *this;
+}
+//=================================================================================================//
+DynamicsTaskGraph::Stage &DynamicsTaskGraph::Stage::after(Stage &stage)
+{
+    explicit_predecessors_.push_back(&stage);
+    return *this;
+}
+//=================================================================================================//
+bool DynamicsTaskGraph::Stage::dependsOn(Stage &earlier_stage)
+{
+    for (Stage *predecessor : explicit_predecessors_)
+    {
+        if (predecessor == &earlier_stage)
+            return true;
+    }
+    for (const void *data : writes_)
+    {
+        if (earlier_stage.writes_.count(data) != 0 || earlier_stage.reads_.count(data) != 0)
+            return true;
+    }
+    for (const void *data : reads_)
+    {
+        if (earlier_stage.writes_.count(data) != 0)
+            return true;
+    }
+    return false;
+}
+//=================================================================================================//
+DynamicsTaskGraph::Stage &DynamicsTaskGraph::addStage(BaseDynamics<void> &dynamics)
+{
+    BaseDynamics<void> *dynamics_ptr = &dynamics;
+    return addStage([=](Real dt)
+                    { dynamics_ptr->exec(dt); });
+}
+//=================================================================================================//
+DynamicsTaskGraph::Stage &DynamicsTaskGraph::addStage(const std::function<void(Real)> &function)
+{
+    if (is_built_)
+    {
+        std::cout << "\n Error: a stage is added after the task graph is executed!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    Stage *stage = stage_ptrs_.createPtr<Stage>(function);
+    stages_.push_back(stage);
+    return *stage;
+}
+//=================================================================================================//
+void DynamicsTaskGraph::buildFlowGraph()
+{
+    for (Stage *stage : stages_)
+    {
+        nodes_.push_back(std::make_unique<tbb::flow::continue_node<tbb::flow::continue_msg>>(
+            flow_graph_, [this, stage](const tbb::flow::continue_msg &)
+            { stage->function_(dt_); }));
+    }
+
+    for (size_t later = 0; later != stages_.size(); ++later)
+    {
+        bool is_source = true;
+        for (size_t earlier = 0; earlier != later; ++earlier)
+        {
+            if (stages_[later]->dependsOn(*stages_[earlier]))
+            {
+                tbb::flow::make_edge(*nodes_[earlier], *nodes_[later]);
+                is_source = false;
+            }
+        }
+        if (is_source)
+            source_nodes_.push_back(later);
+    }
+    is_built_ = true;
+}
+//=================================================================================================//
+void DynamicsTaskGraph::exec(Real dt)
+{
+    if (!is_built_)
+        buildFlowGraph();
+
+    dt_ = dt;
+    static const std::string timeline_name = "DynamicsTaskGraph";
+    TimelineTracer::Scope timeline_scope("task_graph", timeline_name);
+    for (size_t source : source_nodes_)
+    {
+        nodes_[source]->try_put(tbb::flow::continue_msg());
+    }
+    flow_graph_.wait_for_all();
+}
+//=================================================================================================//
+} // namespace SPH
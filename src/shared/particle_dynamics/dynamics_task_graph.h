@@ -0,0 +1,111 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	dynamics_task_graph.h
+ * @brief 	Time stepping as a graph of dynamics ordered by their data dependence.
+ * @details The stages are added in the order of a sequential time step. A stage depends on
+ *			an earlier one if one of them writes data the other reads or writes.
+ *			Stages without dependence on each other are executed concurrently
+ *			as the nodes of a TBB flow graph, while the particle loops
+ *			within each stage stay parallel.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DYNAMICS_TASK_GRAPH_H
+#define DYNAMICS_TASK_GRAPH_H
+
+#include "base_particle_dynamics.h"
+
+#include "tbb/flow_graph.h"
+
+#include <functional>
+#include <set>
+
+namespace SPH
+{
+/**
+ * @class DynamicsTaskGraph
+ * @brief The data of a stage created by the graph are those the dynamics looks up during its construction,
+ * i.e. the variables found by name and the bodies of its local dynamics, all taken as written.
+ * As this is conservative, stages on the same body are not overlapped, but those on different bodies are,
+ * e.g. observer interpolation and the normal direction update of a wall.
+ * A variable can be declared as read only to relax the dependence.
+ * Data not looked up by name, such as cell linked lists and neighbor lists,
+ * and the data of stages given as functions need to be declared or ordered by hand.
+ */
+class DynamicsTaskGraph
+{
+  public:
+    class Stage
+    {
+        friend class DynamicsTaskGraph;
+        std::function<void(Real)> function_;
+        std::set<const void *> reads_;
+        std::set<const void *> writes_;
+        StdVec<Stage *> explicit_predecessors_;
+
+      public:
+        explicit Stage(const std::function<void(Real)> &function) : function_(function){};
+        Stage &reads(const void *data);
+        Stage &writes(const void *data);
+        /** the stage only reads the data recorded as written */
+        Stage &readsOnly(const void *data);
+        Stage &after(Stage &stage);
+        bool dependsOn(Stage &earlier_stage);
+    };
+
+    DynamicsTaskGraph() : is_built_(false){};
+    virtual ~DynamicsTaskGraph(){};
+
+    /** creates a dynamics owned by the graph with the data it uses recorded */
+    template <class DynamicsType, typename... Args>
+    DynamicsType &createStage(Args &&...args)
+    {
+        DataAccessRecording recording;
+        DynamicsType *dynamics = dynamics_ptrs_.createPtr<DynamicsType>(std::forward<Args>(args)...);
+        Stage &stage = addStage([=](Real dt)
+                                { dynamics->exec(dt); });
+        stage.writes_ = recording.Accessed();
+        return *dynamics;
+    };
+    /** the data of an existing dynamics are declared with the returned stage */
+    Stage &addStage(BaseDynamics<void> &dynamics);
+    /** e.g. for a time-step reduction, its data are declared with the returned stage */
+    Stage &addStage(const std::function<void(Real)> &function);
+    Stage &lastStage() { return *stages_.back(); };
+    void exec(Real dt = 0.0);
+
+  protected:
+    UniquePtrsKeeper<BaseDynamics<void>> dynamics_ptrs_;
+    UniquePtrsKeeper<Stage> stage_ptrs_;
+    StdVec<Stage *> stages_;
+    bool is_built_;
+    Real dt_ = 0.0;
+    tbb::flow::graph flow_graph_;
+    StdVec<std::unique_ptr<tbb::flow::continue_node<tbb::flow::continue_msg>>> nodes_;
+    StdVec<size_t> source_nodes_;
+
+    void buildFlowGraph();
+};
+} // namespace SPH
+#endif // DYNAMICS_TASK_GRAPH_H
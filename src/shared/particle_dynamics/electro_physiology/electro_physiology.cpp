@@ -27,6 +27,10 @@ Real ElectroPhysiologyReaction::getLossRateActiveContractionStress(LocalSpecies
     return 0.1 + (1.0 - 0.1) * exp(-exp(-voltage_dim));
 }
 //=================================================================================================//
+ElectroPhysiologyReaction::ReactionKernel::ReactionKernel(ElectroPhysiologyReaction &encloser)
+    : k_a_(encloser.k_a_), voltage_(encloser.voltage_), gate_variable_(encloser.gate_variable_),
+      active_contraction_stress_(encloser.active_contraction_stress_) {}
+//=================================================================================================//
 Real AlievPanfilowModel::getProductionRateIonicCurrent(LocalSpecies &species)
 {
     Real voltage = species[voltage_];
@@ -55,4 +59,9 @@ Real AlievPanfilowModel::
     return epsilon_ + mu_1_ * gate_variable / (mu_2_ + voltage + Eps);
 }
 //=================================================================================================//
+AlievPanfilowModel::ReactionKernel::ReactionKernel(AlievPanfilowModel &encloser)
+    : ElectroPhysiologyReaction::ReactionKernel(encloser),
+      k_(encloser.k_), a_(encloser.a_), b_(encloser.b_), mu_1_(encloser.mu_1_),
+      mu_2_(encloser.mu_2_), epsilon_(encloser.epsilon_), c_m_(encloser.c_m_) {}
+//=================================================================================================//
 } // namespace SPH
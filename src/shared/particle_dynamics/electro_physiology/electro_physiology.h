@@ -62,6 +62,31 @@ class ElectroPhysiologyReaction : public BaseReactionModel<3>
     virtual ~ElectroPhysiologyReaction(){};
 
     void initializeElectroPhysiologyReaction();
+
+    class ReactionKernel
+    {
+      public:
+        ReactionKernel(ElectroPhysiologyReaction &encloser);
+
+      protected:
+        Real k_a_;
+        UnsignedInt voltage_;
+        UnsignedInt gate_variable_;
+        UnsignedInt active_contraction_stress_;
+
+        Real getProductionActiveContractionStress(const LocalSpecies &species)
+        {
+            Real voltage_dim = species[voltage_] * 100.0 - 80.0;
+            Real factor = 0.1 + (1.0 - 0.1) * exp(-exp(-voltage_dim));
+            return factor * k_a_ * (voltage_dim + 80.0);
+        };
+
+        Real getLossRateActiveContractionStress(const LocalSpecies &species)
+        {
+            Real voltage_dim = species[voltage_] * 100.0 - 80.0;
+            return 0.1 + (1.0 - 0.1) * exp(-exp(-voltage_dim));
+        };
+    };
 };
 
 /**
@@ -89,6 +114,44 @@ class AlievPanfilowModel : public ElectroPhysiologyReaction
         reaction_model_ = "AlievPanfilowModel";
     };
     virtual ~AlievPanfilowModel(){};
+
+    /** The rates of the reactive species without virtual calls, used by computing kernels. */
+    class ReactionKernel : public ElectroPhysiologyReaction::ReactionKernel
+    {
+      public:
+        ReactionKernel(AlievPanfilowModel &encloser);
+
+        Real getProductionRate(UnsignedInt k, const LocalSpecies &species)
+        {
+            Real voltage = species[voltage_];
+            if (k == voltage_)
+            {
+                return -k_ * voltage * (voltage * voltage - a_ * voltage - voltage) / c_m_;
+            }
+            if (k == gate_variable_)
+            {
+                Real temp = epsilon_ + mu_1_ * species[gate_variable_] / (mu_2_ + voltage + Eps);
+                return -temp * k_ * voltage * (voltage - b_ - 1.0);
+            }
+            return getProductionActiveContractionStress(species);
+        };
+
+        Real getLossRate(UnsignedInt k, const LocalSpecies &species)
+        {
+            if (k == voltage_)
+            {
+                return (k_ * a_ + species[gate_variable_]) / c_m_;
+            }
+            if (k == gate_variable_)
+            {
+                return epsilon_ + mu_1_ * species[gate_variable_] / (mu_2_ + species[voltage_] + Eps);
+            }
+            return getLossRateActiveContractionStress(species);
+        };
+
+      protected:
+        Real k_, a_, b_, mu_1_, mu_2_, epsilon_, c_m_;
+    };
 };
 
 /**
@@ -145,6 +208,9 @@ using ElectroPhysiologyReactionRelaxationForward =
 /** Solve the reaction ODE equation of trans-membrane potential	using backward sweeping */
 using ElectroPhysiologyReactionRelaxationBackward =
     SimpleDynamics<ReactionRelaxationBackward<ElectroPhysiologyReaction>>;
+/** Solve the reaction ODE equation of trans-membrane potential	with per-particle adaptive sub-steps */
+using ElectroPhysiologyReactionRelaxationAdaptive =
+    SimpleDynamics<AdaptiveReactionRelaxation<ElectroPhysiologyReaction>>;
 } // namespace electro_physiology
 } // namespace SPH
 #endif // ELECTRO_PHYSIOLOGY_H
\ No newline at end of file
@@ -54,11 +54,18 @@ class ParallelDevicePolicy
 {
 };
 
+/** A loop is split between the device and the host threads, while the data and kernels are those of
+ * ParallelDevicePolicy. For dynamics without atomic updates, e.g. state, interaction and reduce dynamics. */
+class ParallelHybridPolicy
+{
+};
+
 inline constexpr auto seq = SequencedPolicy{};
 inline constexpr auto unseq = UnsequencedPolicy{};
 inline constexpr auto par = ParallelPolicy{};
 inline constexpr auto par_unseq = ParallelUnsequencedPolicy{};
 inline constexpr auto par_device = ParallelDevicePolicy{};
+inline constexpr auto par_hybrid = ParallelHybridPolicy{};
 } // namespace execution
 } // namespace SPH
 #endif // EXECUTION_POLICY_H
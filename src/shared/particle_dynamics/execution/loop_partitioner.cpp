@@ -0,0 +1,83 @@
+#include "loop_partitioner.h"
+
+namespace SPH
+{
+namespace execution
+{
+//=================================================================================================//
+LoopPartitioner::LoopPartitioner()
+    : type_(ParticleMemory::Placement() == ParticleMemoryPlacement::first_touch
+                ? PartitionerType::Static
+                : PartitionerType::Affinity),
+      grain_size_(1), is_auto_tuning_enabled_(false),
+      is_auto_tuning_(false), calls_per_candidate_(4),
+      serial_loop_size_limit_(1024), tuned_loop_size_(0),
+      current_candidate_(0), current_calls_(0) {}
+//=================================================================================================//
+void LoopPartitioner::setPartitioner(PartitionerType type, size_t grain_size)
+{
+    type_ = type;
+    grain_size_ = SMAX(grain_size, size_t(1));
+    is_auto_tuning_enabled_ = false;
+    is_auto_tuning_ = false;
+}
+//=================================================================================================//
+void LoopPartitioner::enableAutoTuning(size_t calls_per_candidate, size_t serial_loop_size_limit)
+{
+    calls_per_candidate_ = SMAX(calls_per_candidate, size_t(1));
+    serial_loop_size_limit_ = serial_loop_size_limit;
+    tuned_loop_size_ = 0;
+    is_auto_tuning_enabled_ = true;
+    is_auto_tuning_ = false;
+}
+//=================================================================================================//
+void LoopPartitioner::startTuning(size_t loop_size)
+{
+    candidates_.clear();
+    if (loop_size <= serial_loop_size_limit_)
+        candidates_.push_back({PartitionerType::Serial, 1, 0.0, 0});
+    for (PartitionerType type : {PartitionerType::Affinity, PartitionerType::Static, PartitionerType::Auto})
+    {
+        for (size_t grain_size : {1, 32, 256})
+        {
+            candidates_.push_back({type, grain_size, 0.0, 0});
+        }
+    }
+
+    tuned_loop_size_ = SMAX(loop_size, size_t(1));
+    current_candidate_ = 0;
+    current_calls_ = 0;
+    is_auto_tuning_ = true;
+}
+//=================================================================================================//
+void LoopPartitioner::recordTuning(size_t loop_size, Real elapsed_time)
+{
+    Candidate &candidate = candidates_[current_candidate_];
+    candidate.elapsed_time_ += elapsed_time;
+    candidate.loop_items_ += loop_size;
+
+    if (++current_calls_ < calls_per_candidate_)
+        return;
+
+    current_calls_ = 0;
+    if (++current_candidate_ < candidates_.size())
+        return;
+
+    size_t best = 0;
+    Real best_time_per_item = MaxReal;
+    for (size_t k = 0; k != candidates_.size(); ++k)
+    {
+        Real time_per_item = candidates_[k].elapsed_time_ / Real(SMAX(candidates_[k].loop_items_, size_t(1)));
+        if (time_per_item < best_time_per_item)
+        {
+            best_time_per_item = time_per_item;
+            best = k;
+        }
+    }
+    type_ = candidates_[best].type_;
+    grain_size_ = candidates_[best].grain_size_;
+    is_auto_tuning_ = false;
+}
+//=================================================================================================//
+} // namespace execution
+} // namespace SPH
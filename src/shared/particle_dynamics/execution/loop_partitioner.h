@@ -0,0 +1,185 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	loop_partitioner.h
+ * @brief 	Partitioner state owned by a particle dynamics for its parallel loops,
+ * 			with an optional autotuner of partitioner type and grain size.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef LOOP_PARTITIONER_H
+#define LOOP_PARTITIONER_H
+
+#include "base_data_package.h"
+#include "sphinxsys_containers.h"
+
+namespace SPH
+{
+namespace execution
+{
+enum class PartitionerType
+{
+    Serial,
+    Affinity,
+    Static,
+    Auto
+};
+
+/**
+ * @class LoopPartitioner
+ * @brief The default is an affinity partitioner with unit grain size as the global one,
+ * or a static partitioner matching the first touch of the particle data, see ParticleMemory.
+ * When autotuning is enabled, the candidate partitioner types and grain sizes are
+ * measured in turn, each over a given number of calls,
+ * and the one with the smallest time per loop item is kept afterwards.
+ * Serial execution is a candidate only for loops not larger than a given size,
+ * so that a large loop is not locked into serial execution by noisy timings.
+ * The tuning is repeated when the loop size changes by more than a factor of two from the tuned one.
+ * With deterministic reduction enabled, the reductions are not tuned but run with its fixed chunks.
+ */
+class LoopPartitioner
+{
+  public:
+    LoopPartitioner();
+    ~LoopPartitioner(){};
+
+    void setPartitioner(PartitionerType type, size_t grain_size = 1);
+    void enableAutoTuning(size_t calls_per_candidate = 4, size_t serial_loop_size_limit = 1024);
+    bool isAutoTuning() { return is_auto_tuning_; };
+    PartitionerType getPartitionerType() { return type_; };
+    size_t getGrainSize() { return grain_size_; };
+
+    template <class RangeBody>
+    void parallelFor(const IndexRange &loop_range, const RangeBody &range_body)
+    {
+        if (is_auto_tuning_enabled_)
+            checkTuning(loop_range.size());
+
+        if (!is_auto_tuning_)
+        {
+            runFor(type_, grain_size_, loop_range, range_body);
+            return;
+        }
+
+        const Candidate &candidate = candidates_[current_candidate_];
+        TickCount t0 = TickCount::now();
+        runFor(candidate.type_, candidate.grain_size_, loop_range, range_body);
+        recordTuning(loop_range.size(), (TickCount::now() - t0).seconds());
+    };
+
+    template <typename ReturnType, class RangeBody, class JoinOperation>
+    ReturnType parallelReduce(const IndexRange &loop_range, ReturnType identity,
+                              const RangeBody &range_body, const JoinOperation &join)
+    {
+        if (DeterministicReduction::isEnabled())
+        {
+            return arena_parallel_reduce(loop_range, identity, range_body, join);
+        }
+
+        if (is_auto_tuning_enabled_)
+            checkTuning(loop_range.size());
+
+        if (!is_auto_tuning_)
+        {
+            return runReduce(type_, grain_size_, loop_range, identity, range_body, join);
+        }
+
+        const Candidate &candidate = candidates_[current_candidate_];
+        TickCount t0 = TickCount::now();
+        ReturnType result = runReduce(candidate.type_, candidate.grain_size_,
+                                      loop_range, identity, range_body, join);
+        recordTuning(loop_range.size(), (TickCount::now() - t0).seconds());
+        return result;
+    };
+
+  protected:
+    struct Candidate
+    {
+        PartitionerType type_;
+        size_t grain_size_;
+        Real elapsed_time_;
+        size_t loop_items_;
+    };
+
+    PartitionerType type_;
+    size_t grain_size_;
+    tbb::affinity_partitioner affinity_partitioner_;
+    bool is_auto_tuning_enabled_;
+    bool is_auto_tuning_;
+    size_t calls_per_candidate_;
+    size_t serial_loop_size_limit_;
+    size_t tuned_loop_size_; /**< loop size at the start of the last tuning */
+    size_t current_candidate_;
+    size_t current_calls_;
+    StdVec<Candidate> candidates_;
+
+    /** starts a tuning for the first loop or when the loop size has changed substantially */
+    void checkTuning(size_t loop_size)
+    {
+        if (!is_auto_tuning_ && loop_size != 0 && (loop_size > 2 * tuned_loop_size_ || 2 * loop_size < tuned_loop_size_))
+            startTuning(loop_size);
+    };
+    void startTuning(size_t loop_size);
+    void recordTuning(size_t loop_size, Real elapsed_time);
+
+    template <class RangeBody>
+    void runFor(PartitionerType type, size_t grain_size, const IndexRange &loop_range, const RangeBody &range_body)
+    {
+        IndexRange range(loop_range.begin(), loop_range.end(), grain_size);
+        switch (type)
+        {
+        case PartitionerType::Serial:
+            range_body(IndexRange(loop_range.begin(), loop_range.end()));
+            break;
+        case PartitionerType::Affinity:
+            arena_parallel_for(range, range_body, affinity_partitioner_);
+            break;
+        case PartitionerType::Static:
+            arena_parallel_for(range, range_body, tbb::static_partitioner());
+            break;
+        default:
+            arena_parallel_for(range, range_body, tbb::auto_partitioner());
+        }
+    };
+
+    template <typename ReturnType, class RangeBody, class JoinOperation>
+    ReturnType runReduce(PartitionerType type, size_t grain_size, const IndexRange &loop_range, ReturnType identity,
+                         const RangeBody &range_body, const JoinOperation &join)
+    {
+        IndexRange range(loop_range.begin(), loop_range.end(), grain_size);
+        switch (type)
+        {
+        case PartitionerType::Serial:
+            return range_body(IndexRange(loop_range.begin(), loop_range.end()), identity);
+        case PartitionerType::Affinity:
+            return arena_parallel_reduce(range, identity, range_body, join, affinity_partitioner_);
+        case PartitionerType::Static:
+            return arena_parallel_reduce(range, identity, range_body, join, tbb::static_partitioner());
+        default:
+            return arena_parallel_reduce(range, identity, range_body, join, tbb::auto_partitioner());
+        }
+    };
+};
+} // namespace execution
+} // namespace SPH
+#endif // LOOP_PARTITIONER_H
@@ -37,7 +37,10 @@
 #include "density_summation.hpp"
 #include "fluid_integration.hpp"
 #include "fluid_time_step.h"
+#include "implicit_viscous_dynamics.hpp"
+#include "incompressible_projection.hpp"
 #include "non_newtonian_dynamics.h"
+#include "particle_splitting_merging.h"
 #include "shape_confinement.h"
 #include "surface_tension.hpp"
 #include "transport_velocity_correction.hpp"
@@ -35,3 +35,4 @@
 #include "near_wall_boundary.h"
 #include "fluid_boundary.h"
 #include "non_reflective_boundary.h"
+#include "wave_relaxation_zone.h"
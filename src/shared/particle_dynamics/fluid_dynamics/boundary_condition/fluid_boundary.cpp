@@ -77,18 +77,32 @@ void EmitterInflowInjection::update(size_t original_index_i, Real dt)
     size_t sorted_index_i = sorted_id_[original_index_i];
     if (aligned_box_.checkUpperBound(pos_[sorted_index_i]))
     {
-        mutex_switch_to_real_.lock();
-        buffer_.checkEnoughBuffer(*particles_);
-        particles_->createRealParticleFrom(sorted_index_i);
-        mutex_switch_to_real_.unlock();
-
-        /** Periodic bounding. */
-        pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(pos_[sorted_index_i]);
-        rho_[sorted_index_i] = fluid_.ReferenceDensity();
-        p_[sorted_index_i] = fluid_.getPressure(rho_[sorted_index_i]);
+        passing_particles_.push_back(sorted_index_i);
     }
 }
 //=================================================================================================//
+void EmitterInflowInjection::finishDynamics(Real dt)
+{
+    if (passing_particles_.empty())
+        return;
+
+    IndexVector sources(passing_particles_.begin(), passing_particles_.end());
+    passing_particles_.clear();
+    std::sort(sources.begin(), sources.end()); // deterministic order of the new particles
+    buffer_.checkEnoughBuffer(*particles_, sources.size());
+    particles_->createRealParticlesFrom(sources);
+
+    particle_for(execution::par, IndexRange(0, sources.size()),
+                 [&](size_t k)
+                 {
+                     size_t sorted_index_i = sources[k];
+                     /** Periodic bounding. */
+                     pos_[sorted_index_i] = aligned_box_.getUpperPeriodic(pos_[sorted_index_i]);
+                     rho_[sorted_index_i] = fluid_.ReferenceDensity();
+                     p_[sorted_index_i] = fluid_.getPressure(rho_[sorted_index_i]);
+                 });
+}
+//=================================================================================================//
 DisposerOutflowDeletion::
     DisposerOutflowDeletion(BodyAlignedBoxByCell &aligned_box_part)
     : BaseLocalDynamics<BodyPartByCell>(aligned_box_part),
@@ -97,12 +111,21 @@ DisposerOutflowDeletion::
 //=================================================================================================//
 void DisposerOutflowDeletion::update(size_t index_i, Real dt)
 {
-    mutex_switch_to_buffer_.lock();
-    while (aligned_box_.checkUpperBound(pos_[index_i]) && index_i < particles_->TotalRealParticles())
+    if (aligned_box_.checkUpperBound(pos_[index_i]))
     {
-        particles_->switchToBufferParticle(index_i);
+        leaving_particles_.push_back(index_i);
     }
-    mutex_switch_to_buffer_.unlock();
+}
+//=================================================================================================//
+void DisposerOutflowDeletion::finishDynamics(Real dt)
+{
+    if (leaving_particles_.empty())
+        return;
+
+    IndexVector sorted_indices(leaving_particles_.begin(), leaving_particles_.end());
+    leaving_particles_.clear();
+    std::sort(sorted_indices.begin(), sorted_indices.end());
+    particles_->switchToBufferParticles(sorted_indices);
 }
 } // namespace fluid_dynamics
 } // namespace SPH
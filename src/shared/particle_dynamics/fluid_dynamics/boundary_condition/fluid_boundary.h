@@ -216,7 +216,8 @@ class EmitterInflowCondition : public BaseLocalDynamics<BodyPartByParticle>
  * @class EmitterInflowInjection
  * @brief Inject particles into the computational domain.
  * Note that the axis is at the local coordinate and upper bound direction is
- * the local positive direction.
+ * the local positive direction. The emitter particles passing the upper bound
+ * are collected in the particle loop and injected in one batch afterwards.
  */
 class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>
 {
@@ -225,9 +226,10 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>
     virtual ~EmitterInflowInjection(){};
 
     void update(size_t original_index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_real_; /**< mutex exclusion for memory conflict */
+    ConcurrentIndexVector passing_particles_;
     Fluid &fluid_;
     UnsignedInt *original_id_;
     UnsignedInt *sorted_id_;
@@ -240,6 +242,8 @@ class EmitterInflowInjection : public BaseLocalDynamics<BodyPartByParticle>
 /**
  * @class DisposerOutflowDeletion
  * @brief Delete particles who ruing out the computational domain.
+ * The particles to be deleted are collected in the particle loop and
+ * switched to buffer in one batch afterwards.
  */
 class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>
 {
@@ -248,9 +252,10 @@ class DisposerOutflowDeletion : public BaseLocalDynamics<BodyPartByCell>
     virtual ~DisposerOutflowDeletion(){};
 
     void update(size_t index_i, Real dt = 0.0);
+    virtual void finishDynamics(Real dt = 0.0) override;
 
   protected:
-    std::mutex mutex_switch_to_buffer_; /**< mutex exclusion for memory conflict */
+    ConcurrentIndexVector leaving_particles_;
     Vecd *pos_;
     AlignedBoxShape &aligned_box_;
 };
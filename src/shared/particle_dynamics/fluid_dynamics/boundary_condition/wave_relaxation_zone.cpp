@@ -0,0 +1,81 @@
+#include "wave_relaxation_zone.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+StillWaterSolution::StillWaterSolution(Real water_depth, Real gravity, Real rho0)
+    : water_depth_(water_depth), gravity_(gravity), rho0_(rho0) {}
+//=================================================================================================//
+Real StillWaterSolution::getPressure(const Vecd &position, Real time)
+{
+    return rho0_ * gravity_ * SMAX(water_depth_ - position[Dimensions - 1], Real(0));
+}
+//=================================================================================================//
+LinearWaveSolution::LinearWaveSolution(Real water_depth, Real gravity, Real rho0,
+                                       Real wave_height, Real wave_period, Real ramp_time)
+    : StillWaterSolution(water_depth, gravity, rho0),
+      amplitude_(0.5 * wave_height), angular_frequency_(2.0 * Pi / wave_period),
+      ramp_time_(ramp_time), wave_number_(solveWaveNumber()) {}
+//=================================================================================================//
+Real LinearWaveSolution::solveWaveNumber()
+{
+    // deep water wave number as initial guess of omega^2 = g k tanh(k d)
+    Real omega_square = angular_frequency_ * angular_frequency_;
+    Real wave_number = SMAX(omega_square / gravity_, angular_frequency_ / sqrt(gravity_ * water_depth_));
+    for (size_t i = 0; i != 100; ++i)
+    {
+        Real tanh_kd = tanh(wave_number * water_depth_);
+        Real residual = gravity_ * wave_number * tanh_kd - omega_square;
+        Real derivative = gravity_ * (tanh_kd + wave_number * water_depth_ * (1.0 - tanh_kd * tanh_kd));
+        Real increment = residual / derivative;
+        wave_number -= increment;
+        if (ABS(increment) < 1.0e-12 * wave_number)
+            break;
+    }
+    return wave_number;
+}
+//=================================================================================================//
+Real LinearWaveSolution::rampedAmplitude(Real time)
+{
+    return time < ramp_time_ ? amplitude_ * 0.5 * (1.0 - cos(Pi * time / ramp_time_)) : amplitude_;
+}
+//=================================================================================================//
+Real LinearWaveSolution::stretchedVertical(const Vecd &position, Real surface_elevation)
+{
+    Real vertical = SMIN(position[Dimensions - 1], water_depth_ + surface_elevation);
+    return water_depth_ * vertical / (water_depth_ + surface_elevation);
+}
+//=================================================================================================//
+Real LinearWaveSolution::getSurfaceElevation(const Vecd &position, Real time)
+{
+    return rampedAmplitude(time) * cos(wave_number_ * position[0] - angular_frequency_ * time);
+}
+//=================================================================================================//
+Vecd LinearWaveSolution::getVelocity(const Vecd &position, Real time)
+{
+    Real phase = wave_number_ * position[0] - angular_frequency_ * time;
+    Real amplitude = rampedAmplitude(time);
+    Real vertical = stretchedVertical(position, amplitude * cos(phase));
+    Real factor = amplitude * angular_frequency_ / sinh(wave_number_ * water_depth_);
+
+    Vecd velocity = Vecd::Zero();
+    velocity[0] = factor * cosh(wave_number_ * vertical) * cos(phase);
+    velocity[Dimensions - 1] = factor * sinh(wave_number_ * vertical) * sin(phase);
+    return velocity;
+}
+//=================================================================================================//
+Real LinearWaveSolution::getPressure(const Vecd &position, Real time)
+{
+    Real phase = wave_number_ * position[0] - angular_frequency_ * time;
+    Real amplitude = rampedAmplitude(time);
+    Real surface_elevation = amplitude * cos(phase);
+    Real vertical = stretchedVertical(position, surface_elevation);
+    Real dynamic_pressure = rho0_ * gravity_ * surface_elevation *
+                            cosh(wave_number_ * vertical) / cosh(wave_number_ * water_depth_);
+    return SMAX(rho0_ * gravity_ * (water_depth_ - position[Dimensions - 1]) + dynamic_pressure, Real(0));
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
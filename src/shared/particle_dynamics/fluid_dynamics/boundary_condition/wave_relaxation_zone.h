@@ -0,0 +1,136 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	wave_relaxation_zone.h
+ * @brief 	Relaxation zones which couple the SPH fluid to an analytic wave solution,
+ *          so that waves are generated and absorbed within short buffers
+ *          and the SPH domain is reduced to a few wavelengths around the structure.
+ * @details The coupling is one-way: in the zone, the velocity and the density (pressure)
+ *          of the fluid particles are relaxed to the far-field solution with the weighting
+ *          function of Jacobsen et al. (2012), which vanishes at the side facing the SPH domain.
+ *          The wave solutions are given in the base frame with waves propagating along the first axis,
+ *          the last axis pointing upward and the bottom of the tank at zero vertical coordinate.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef WAVE_RELAXATION_ZONE_H
+#define WAVE_RELAXATION_ZONE_H
+
+#include "fluid_boundary.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+/**
+ * @class StillWaterSolution
+ * @brief Far field at rest with hydrostatic pressure, used for absorbing waves.
+ */
+class StillWaterSolution
+{
+  public:
+    StillWaterSolution(Real water_depth, Real gravity, Real rho0);
+    Vecd getVelocity(const Vecd &position, Real time) { return Vecd::Zero(); };
+    Real getPressure(const Vecd &position, Real time);
+
+  protected:
+    Real water_depth_, gravity_, rho0_;
+};
+
+/**
+ * @class LinearWaveSolution
+ * @brief Regular wave of linear (Airy) theory with Wheeler stretching above the still water level.
+ * The wave is ramped up smoothly from still water within the given ramp time.
+ */
+class LinearWaveSolution : public StillWaterSolution
+{
+  public:
+    LinearWaveSolution(Real water_depth, Real gravity, Real rho0,
+                       Real wave_height, Real wave_period, Real ramp_time = 0.0);
+    Real WaveNumber() { return wave_number_; };
+    Real WaveLength() { return 2.0 * Pi / wave_number_; };
+    Real getSurfaceElevation(const Vecd &position, Real time);
+    Vecd getVelocity(const Vecd &position, Real time);
+    Real getPressure(const Vecd &position, Real time);
+
+  protected:
+    Real amplitude_, angular_frequency_, ramp_time_, wave_number_;
+
+    /** solves the dispersion relation by Newton iterations. */
+    Real solveWaveNumber();
+    Real rampedAmplitude(Real time);
+    /** vertical coordinate stretched to the still water depth */
+    Real stretchedVertical(const Vecd &position, Real surface_elevation);
+};
+
+/**
+ * @class WaveRelaxationZone
+ * @brief Relaxes the fluid particles in an aligned box to a far-field wave solution.
+ * The solution is imposed fully at the lower bound of the alignment axis, i.e. the outer end of the tank,
+ * and not at all at the upper bound facing the SPH domain. For a zone at the other end of the tank,
+ * the aligned box is rotated accordingly. The density is relaxed consistently with the pressure
+ * through the equation of state, so the zone is applied after the density update of a time step.
+ */
+template <class WaveSolutionType>
+class WaveRelaxationZone : public BaseFlowBoundaryCondition
+{
+  public:
+    WaveRelaxationZone(BodyAlignedBoxByCell &aligned_box_part, const WaveSolutionType &wave_solution)
+        : BaseFlowBoundaryCondition(aligned_box_part),
+          fluid_(DynamicCast<Fluid>(this, particles_->getBaseMaterial())),
+          aligned_box_(aligned_box_part.getAlignedBoxShape()),
+          transform_(aligned_box_.getTransform()),
+          alignment_axis_(aligned_box_.AlignmentAxis()),
+          halfsize_(aligned_box_.HalfSize()[alignment_axis_]),
+          wave_solution_(wave_solution),
+          physical_time_(sph_system_.getSystemVariableDataByName<Real>("PhysicalTime")){};
+    virtual ~WaveRelaxationZone(){};
+    WaveSolutionType &getWaveSolution() { return wave_solution_; };
+
+    void update(size_t index_i, Real dt = 0.0)
+    {
+        Vecd frame_position = transform_.shiftBaseStationToFrame(pos_[index_i]);
+        Real chi = (halfsize_ - frame_position[alignment_axis_]) / (2.0 * halfsize_);
+        if (chi >= 0.0 && chi <= 1.0)
+        {
+            Real weight = (exp(pow(chi, 3.5)) - 1.0) / (exp(1.0) - 1.0);
+            Vecd target_velocity = wave_solution_.getVelocity(pos_[index_i], *physical_time_);
+            Real target_density = fluid_.DensityFromPressure(wave_solution_.getPressure(pos_[index_i], *physical_time_));
+            vel_[index_i] += weight * (target_velocity - vel_[index_i]);
+            rho_[index_i] += weight * (target_density - rho_[index_i]);
+            p_[index_i] = fluid_.getPressure(rho_[index_i]);
+        }
+    };
+
+  protected:
+    Fluid &fluid_;
+    AlignedBoxShape &aligned_box_;
+    Transform &transform_;
+    int alignment_axis_;
+    Real halfsize_;
+    WaveSolutionType wave_solution_;
+    Real *physical_time_;
+};
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // WAVE_RELAXATION_ZONE_H
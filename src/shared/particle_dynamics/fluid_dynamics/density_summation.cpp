@@ -8,9 +8,18 @@ namespace fluid_dynamics
 void DensitySummation<Inner<>>::interaction(size_t index_i, Real dt)
 {
     Real sigma = W0_;
-    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
-        sigma += inner_neighborhood.W_ij_[n];
+    if (getBodyRelation().isCompactConfigurationEnabled())
+    {
+        const CompactNeighborhood inner_neighborhood = compact_inner_configuration_[index_i];
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            sigma += inner_neighborhood.W_ij_[n];
+    }
+    else
+    {
+        const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+            sigma += inner_neighborhood.W_ij_[n];
+    }
 
     rho_sum_[index_i] = sigma * rho0_ * inv_sigma0_;
 }
@@ -21,6 +30,32 @@ void DensitySummation<Inner<>>::update(size_t index_i, Real dt)
     Vol_[index_i] = mass_[index_i] / rho_[index_i];
 }
 //=================================================================================================//
+void DensitySummation<Inner<>>::symmetricPrepare(size_t index_i, Real dt)
+{
+    rho_sum_[index_i] = W0_;
+}
+//=================================================================================================//
+void DensitySummation<Inner<>>::symmetricInteraction(size_t index_i, Real dt)
+{
+    Real sigma = 0.0;
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        if (index_j > index_i)
+        {
+            sigma += inner_neighborhood.W_ij_[n];
+            rho_sum_[index_j] += inner_neighborhood.W_ij_[n];
+        }
+    }
+    rho_sum_[index_i] += sigma;
+}
+//=================================================================================================//
+void DensitySummation<Inner<>>::symmetricFinish(size_t index_i, Real dt)
+{
+    rho_sum_[index_i] *= rho0_ * inv_sigma0_;
+}
+//=================================================================================================//
 DensitySummation<Inner<Adaptive>>::DensitySummation(BaseInnerRelation &inner_relation)
     : DensitySummation<Inner<Base>>(inner_relation),
       sph_adaptation_(*sph_body_.sph_adaptation_),
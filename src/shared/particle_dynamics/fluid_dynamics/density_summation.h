@@ -71,8 +71,13 @@ class DensitySummation<Inner<>> : public DensitySummation<Inner<Base>>
     explicit DensitySummation(BaseInnerRelation &inner_relation)
         : DensitySummation<Inner<Base>>(inner_relation){};
     virtual ~DensitySummation(){};
+    /** reads the compact configuration if it is enabled in the relation */
     void interaction(size_t index_i, Real dt = 0.0);
     void update(size_t index_i, Real dt = 0.0);
+    /** for InteractionSymmetricWithUpdate */
+    void symmetricPrepare(size_t index_i, Real dt = 0.0);
+    void symmetricInteraction(size_t index_i, Real dt = 0.0);
+    void symmetricFinish(size_t index_i, Real dt = 0.0);
 };
 using DensitySummationInner = DensitySummation<Inner<>>;
 
@@ -33,4 +33,6 @@
 #pragma once
 
 #include "eulerian_compressible_fluid_integration.hpp"
+#include "eulerian_compressible_implicit_integration.hpp"
 #include "eulerian_fluid_integration.hpp"
+#include "eulerian_local_time_stepping.h"
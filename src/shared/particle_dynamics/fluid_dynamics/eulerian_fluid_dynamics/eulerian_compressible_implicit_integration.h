@@ -0,0 +1,94 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    eulerian_compressible_implicit_integration.h
+ * @brief   Implicit pseudo-time integration towards steady state for the compressible
+ *          Eulerian SPH and FVM methods.
+ * @details The backward Euler step with local time stepping is linearized with the
+ *          Rusanov (local Lax-Friedrichs) approximate flux Jacobian and solved by a lower-upper
+ *          symmetric Gauss-Seidel (LU-SGS) sweep. The method is matrix free, the off-diagonal
+ *          contributions are given by flux differences of the neighbor states.
+ *          The explicit residual is the same as that of the explicit integration,
+ *          so that the converged steady solutions agree. The CFL number is ramped up
+ *          by switched evolution relaxation as the residual decreases.
+ *          Boundary conditions, such as ghost states, are updated outside and kept fixed
+ *          during a sweep.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef EULERIAN_COMPRESSIBLE_IMPLICIT_INTEGRATION_H
+#define EULERIAN_COMPRESSIBLE_IMPLICIT_INTEGRATION_H
+
+#include "eulerian_compressible_fluid_integration.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+/**
+ * @class EulerianCompressibleImplicitLUSGS
+ * @brief One implicit pseudo-time step of the conservative variables for each call of exec.
+ * The given time step size is not used as the time steps are local.
+ */
+template <class RiemannSolverType, class ExecutionPolicy = ParallelPolicy>
+class EulerianCompressibleImplicitLUSGS : public BaseIntegrationInCompressible, public BaseDynamics<void>
+{
+  public:
+    explicit EulerianCompressibleImplicitLUSGS(BaseInnerRelation &inner_relation, Real limiter_parameter = 5.0,
+                                               Real initial_cfl = 1.0, Real max_cfl = 1.0e3, Real tolerance = 1.0e-6);
+    virtual ~EulerianCompressibleImplicitLUSGS(){};
+    RiemannSolverType riemann_solver_;
+
+    UnsignedInt Iterations() { return iterations_; };
+    /** root mean square of the density residual */
+    Real Residual() { return residual_; };
+    /** the residual relative to that of the first iteration */
+    Real RelativeResidual() { return residual_ / (initial_residual_ + TinyReal); };
+    Real CFLNumber() { return cfl_; };
+    bool isConverged() { return iterations_ > 0 && RelativeResidual() < tolerance_; };
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    Real initial_cfl_, max_cfl_, cfl_, tolerance_;
+    UnsignedInt iterations_;
+    Real initial_residual_, residual_;
+    StdVec<Real> diagonal_, drho_, drho_e_;
+    StdVec<Vecd> drho_u_;
+
+    /** flux of the conservative variables per volume through the direction e */
+    void normalFlux(Real rho, const Vecd &rho_u, Real rho_e, const Vecd &e,
+                    Real &mass_flux, Vecd &momentum_flux, Real &energy_flux);
+    Real spectralRadius(size_t index_i, const Vecd &e);
+    /** explicit residual and the diagonal of the approximate Jacobian */
+    void computeResidual(size_t index_i);
+    /** adds the off-diagonal contribution of neighbor j, with or without an update yet */
+    void addNeighborContribution(size_t index_i, size_t index_j, Real coefficient, const Vecd &e_ij,
+                                 Real &rhs_rho, Vecd &rhs_rho_u, Real &rhs_rho_e);
+    void sweep(size_t index_i, bool is_forward);
+};
+using EulerianCompressibleImplicitLUSGSHLLCRiemann = EulerianCompressibleImplicitLUSGS<HLLCRiemannSolver>;
+using EulerianCompressibleImplicitLUSGSHLLCWithLimiterRiemann = EulerianCompressibleImplicitLUSGS<HLLCWithLimiterRiemannSolver>;
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // EULERIAN_COMPRESSIBLE_IMPLICIT_INTEGRATION_H
@@ -0,0 +1,176 @@
+#ifndef EULERIAN_COMPRESSIBLE_IMPLICIT_INTEGRATION_HPP
+#define EULERIAN_COMPRESSIBLE_IMPLICIT_INTEGRATION_HPP
+
+#include "eulerian_compressible_implicit_integration.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <class RiemannSolverType, class ExecutionPolicy>
+EulerianCompressibleImplicitLUSGS<RiemannSolverType, ExecutionPolicy>::
+    EulerianCompressibleImplicitLUSGS(BaseInnerRelation &inner_relation, Real limiter_parameter,
+                                      Real initial_cfl, Real max_cfl, Real tolerance)
+    : BaseIntegrationInCompressible(inner_relation), BaseDynamics<void>(),
+      riemann_solver_(compressible_fluid_, compressible_fluid_, limiter_parameter),
+      initial_cfl_(initial_cfl), max_cfl_(SMAX(max_cfl, initial_cfl)), cfl_(initial_cfl),
+      tolerance_(tolerance), iterations_(0), initial_residual_(0.0), residual_(0.0) {}
+//=================================================================================================//
+template <class RiemannSolverType, class ExecutionPolicy>
+void EulerianCompressibleImplicitLUSGS<RiemannSolverType, ExecutionPolicy>::
+    normalFlux(Real rho, const Vecd &rho_u, Real rho_e, const Vecd &e,
+               Real &mass_flux, Vecd &momentum_flux, Real &energy_flux)
+{
+    Vecd vel = rho_u / rho;
+    Real vel_n = vel.dot(e);
+    Real p = compressible_fluid_.getPressure(rho, rho_e - 0.5 * rho * vel.squaredNorm());
+    mass_flux = rho * vel_n;
+    momentum_flux = rho_u * vel_n + p * e;
+    energy_flux = (rho_e + p) * vel_n;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class ExecutionPolicy>
+Real EulerianCompressibleImplicitLUSGS<RiemannSolverType, ExecutionPolicy>::
+    spectralRadius(size_t index_i, const Vecd &e)
+{
+    return ABS(vel_[index_i].dot(e)) + compressible_fluid_.getSoundSpeed(p_[index_i], rho_[index_i]);
+}
+//=================================================================================================//
+template <class RiemannSolverType, class ExecutionPolicy>
+void EulerianCompressibleImplicitLUSGS<RiemannSolverType, ExecutionPolicy>::computeResidual(size_t index_i)
+{
+    Real energy_per_volume_i = E_[index_i] / Vol_[index_i];
+    CompressibleFluidState state_i(rho_[index_i], vel_[index_i], p_[index_i], energy_per_volume_i);
+    Real mass_change_rate = 0.0;
+    Vecd momentum_change_rate = force_prior_[index_i];
+    Real energy_change_rate = force_prior_[index_i].dot(vel_[index_i]);
+    Real spectral_sum = 0.0;
+    Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        Real coefficient = -2.0 * Vol_[index_i] * inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+
+        Real energy_per_volume_j = E_[index_j] / Vol_[index_j];
+        CompressibleFluidState state_j(rho_[index_j], vel_[index_j], p_[index_j], energy_per_volume_j);
+        CompressibleFluidStarState interface_state = riemann_solver_.getInterfaceState(state_i, state_j, e_ij);
+
+        Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
+        mass_change_rate += coefficient * (interface_state.rho_ * interface_state.vel_).dot(e_ij);
+        momentum_change_rate += coefficient * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij;
+        energy_change_rate += coefficient * ((interface_state.E_ + interface_state.p_) * interface_state.vel_).dot(e_ij);
+        spectral_sum += coefficient * SMAX(spectralRadius(index_i, e_ij), spectralRadius(index_j, e_ij));
+    }
+    dmass_dt_[index_i] = mass_change_rate;
+    force_[index_i] = momentum_change_rate;
+    dE_dt_[index_i] = energy_change_rate;
+    diagonal_[index_i] = 0.5 * spectral_sum;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class ExecutionPolicy>
+void EulerianCompressibleImplicitLUSGS<RiemannSolverType, ExecutionPolicy>::
+    addNeighborContribution(size_t index_i, size_t index_j, Real coefficient, const Vecd &e_ij,
+                            Real &rhs_rho, Vecd &rhs_rho_u, Real &rhs_rho_e)
+{
+    Real rho_j = rho_[index_j];
+    Vecd rho_u_j = mom_[index_j] / Vol_[index_j];
+    Real rho_e_j = E_[index_j] / Vol_[index_j];
+    Real mass_flux, mass_flux_new, energy_flux, energy_flux_new;
+    Vecd momentum_flux, momentum_flux_new;
+    normalFlux(rho_j, rho_u_j, rho_e_j, e_ij, mass_flux, momentum_flux, energy_flux);
+    normalFlux(rho_j + drho_[index_j], rho_u_j + drho_u_[index_j], rho_e_j + drho_e_[index_j], e_ij,
+               mass_flux_new, momentum_flux_new, energy_flux_new);
+
+    Real weight = 0.5 * coefficient;
+    Real lambda = SMAX(spectralRadius(index_i, e_ij), spectralRadius(index_j, e_ij));
+    rhs_rho += weight * (mass_flux_new - mass_flux + lambda * drho_[index_j]);
+    rhs_rho_u += weight * (momentum_flux_new - momentum_flux + lambda * drho_u_[index_j]);
+    rhs_rho_e += weight * (energy_flux_new - energy_flux + lambda * drho_e_[index_j]);
+}
+//=================================================================================================//
+template <class RiemannSolverType, class ExecutionPolicy>
+void EulerianCompressibleImplicitLUSGS<RiemannSolverType, ExecutionPolicy>::sweep(size_t index_i, bool is_forward)
+{
+    Real rhs_rho = is_forward ? dmass_dt_[index_i] : 0.0;
+    Vecd rhs_rho_u = is_forward ? force_[index_i] : Vecd::Zero();
+    Real rhs_rho_e = is_forward ? dE_dt_[index_i] : 0.0;
+    size_t total_real_particles = particles_->TotalRealParticles();
+    Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        // ghost or boundary states are kept, and only the lower or upper part is used in a sweep
+        if (index_j >= total_real_particles || (is_forward ? index_j > index_i : index_j < index_i))
+            continue;
+        Real coefficient = -2.0 * Vol_[index_i] * inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+        addNeighborContribution(index_i, index_j, coefficient, inner_neighborhood.e_ij_[n],
+                                rhs_rho, rhs_rho_u, rhs_rho_e);
+    }
+
+    Real inv_diagonal = 1.0 / ((1.0 + 1.0 / cfl_) * diagonal_[index_i] + TinyReal);
+    if (is_forward)
+    {
+        drho_[index_i] = rhs_rho * inv_diagonal;
+        drho_u_[index_i] = rhs_rho_u * inv_diagonal;
+        drho_e_[index_i] = rhs_rho_e * inv_diagonal;
+    }
+    else
+    {
+        drho_[index_i] += rhs_rho * inv_diagonal;
+        drho_u_[index_i] += rhs_rho_u * inv_diagonal;
+        drho_e_[index_i] += rhs_rho_e * inv_diagonal;
+    }
+}
+//=================================================================================================//
+template <class RiemannSolverType, class ExecutionPolicy>
+void EulerianCompressibleImplicitLUSGS<RiemannSolverType, ExecutionPolicy>::exec(Real dt)
+{
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+    this->setUpdated(this->identifier_.getSPHBody());
+    this->setupDynamics(dt);
+    IndexRange loop_range = this->identifier_.LoopRange();
+
+    size_t particles_bound = particles_->ParticlesBound();
+    diagonal_.resize(particles_bound);
+    drho_.assign(particles_bound, 0.0);
+    drho_u_.assign(particles_bound, Vecd::Zero());
+    drho_e_.assign(particles_bound, 0.0);
+
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 { computeResidual(i); });
+
+    Real squared_residual = particle_reduce(ExecutionPolicy(), loop_range, Real(0), ReduceSum<Real>(),
+                                            [&](size_t i) -> Real
+                                            { return dmass_dt_[i] * dmass_dt_[i] / (Vol_[i] * Vol_[i]); });
+    residual_ = std::sqrt(squared_residual / Real(loop_range.size() + 1));
+    if (iterations_ == 0)
+        initial_residual_ = residual_;
+    // switched evolution relaxation, the CFL number grows as the residual drops
+    cfl_ = SMIN(max_cfl_, SMAX(initial_cfl_, initial_cfl_ * initial_residual_ / (residual_ + TinyReal)));
+
+    // the sweeps follow the particle ordering and are therefore sequential
+    for (size_t i = loop_range.begin(); i != loop_range.end(); ++i)
+        sweep(i, true);
+    for (size_t i = loop_range.end(); i != loop_range.begin(); --i)
+        sweep(i - 1, false);
+
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 {
+                     mass_[i] += drho_[i] * Vol_[i];
+                     mom_[i] += drho_u_[i] * Vol_[i];
+                     E_[i] += drho_e_[i] * Vol_[i];
+                     rho_[i] = mass_[i] / Vol_[i];
+                     vel_[i] = mom_[i] / mass_[i];
+                     Real rho_e = E_[i] / Vol_[i] - 0.5 * vel_[i].squaredNorm() * rho_[i];
+                     p_[i] = compressible_fluid_.getPressure(rho_[i], rho_e);
+                 });
+    iterations_++;
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // EULERIAN_COMPRESSIBLE_IMPLICIT_INTEGRATION_HPP
@@ -26,19 +26,36 @@ EulerianIntegration1stHalf<Inner<>, RiemannSolverType>::
 template <class RiemannSolverType>
 void EulerianIntegration1stHalf<Inner<>, RiemannSolverType>::interaction(size_t index_i, Real dt)
 {
-    FluidStateIn state_i(rho_[index_i], vel_[index_i], p_[index_i]);
     Vecd momentum_change_rate = Vecd::Zero();
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    // the Riemann problems are solved for blocks of neighbors at once
+    RiemannPairBlock block;
+    for (size_t first = 0; first < inner_neighborhood.current_size_; first += RiemannPairBlock::capacity_)
     {
-        size_t index_j = inner_neighborhood.j_[n];
-        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
+        block.size_ = SMIN(RiemannPairBlock::capacity_, inner_neighborhood.current_size_ - first);
+        for (size_t k = 0; k != block.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[first + k];
+            Vecd &e_ij = inner_neighborhood.e_ij_[first + k];
+            block.p_i_[k] = p_[index_i];
+            block.p_j_[k] = p_[index_j];
+            block.ul_[k] = -e_ij.dot(vel_[index_i]);
+            block.ur_[k] = -e_ij.dot(vel_[index_j]);
+        }
+        riemann_solver_.InterfaceStates(block);
 
-        FluidStateIn state_j(rho_[index_j], vel_[index_j], p_[index_j]);
-        FluidStateOut interface_state = riemann_solver_.InterfaceState(state_i, state_j, e_ij);
-        Matd convect_flux = interface_state.rho_ * interface_state.vel_ * interface_state.vel_.transpose();
-        momentum_change_rate -= 2.0 * Vol_[index_i] * (convect_flux + interface_state.p_ * Matd::Identity()) * e_ij * dW_ijV_j;
+        for (size_t k = 0; k != block.size_; ++k)
+        {
+            size_t n = first + k;
+            size_t index_j = inner_neighborhood.j_[n];
+            Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+            Vecd &e_ij = inner_neighborhood.e_ij_[n];
+
+            Real rho_star = 0.5 * (rho_[index_i] + rho_[index_j]);
+            Vecd vel_star = 0.5 * (vel_[index_i] + vel_[index_j]) - e_ij * block.u_dissipative_[k];
+            Matd convect_flux = rho_star * vel_star * vel_star.transpose();
+            momentum_change_rate -= 2.0 * Vol_[index_i] * (convect_flux + block.p_star_[k] * Matd::Identity()) * e_ij * dW_ijV_j;
+        }
     }
     dmom_dt_[index_i] = momentum_change_rate;
 }
@@ -94,18 +111,34 @@ EulerianIntegration2ndHalf<Inner<>, RiemannSolverType>::
 template <class RiemannSolverType>
 void EulerianIntegration2ndHalf<Inner<>, RiemannSolverType>::interaction(size_t index_i, Real dt)
 {
-    FluidStateIn state_i(rho_[index_i], vel_[index_i], p_[index_i]);
     Real mass_change_rate = 0.0;
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
-    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    RiemannPairBlock block;
+    for (size_t first = 0; first < inner_neighborhood.current_size_; first += RiemannPairBlock::capacity_)
     {
-        size_t index_j = inner_neighborhood.j_[n];
-        Vecd &e_ij = inner_neighborhood.e_ij_[n];
-        Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+        block.size_ = SMIN(RiemannPairBlock::capacity_, inner_neighborhood.current_size_ - first);
+        for (size_t k = 0; k != block.size_; ++k)
+        {
+            size_t index_j = inner_neighborhood.j_[first + k];
+            Vecd &e_ij = inner_neighborhood.e_ij_[first + k];
+            block.p_i_[k] = p_[index_i];
+            block.p_j_[k] = p_[index_j];
+            block.ul_[k] = -e_ij.dot(vel_[index_i]);
+            block.ur_[k] = -e_ij.dot(vel_[index_j]);
+        }
+        riemann_solver_.InterfaceStates(block);
 
-        FluidStateIn state_j(rho_[index_j], vel_[index_j], p_[index_j]);
-        FluidStateOut interface_state = riemann_solver_.InterfaceState(state_i, state_j, e_ij);
-        mass_change_rate -= 2.0 * Vol_[index_i] * (interface_state.rho_ * interface_state.vel_).dot(e_ij) * dW_ijV_j;
+        for (size_t k = 0; k != block.size_; ++k)
+        {
+            size_t n = first + k;
+            size_t index_j = inner_neighborhood.j_[n];
+            Vecd &e_ij = inner_neighborhood.e_ij_[n];
+            Real dW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j];
+
+            Real rho_star = 0.5 * (rho_[index_i] + rho_[index_j]);
+            Vecd vel_star = 0.5 * (vel_[index_i] + vel_[index_j]) - e_ij * block.u_dissipative_[k];
+            mass_change_rate -= 2.0 * Vol_[index_i] * (rho_star * vel_star).dot(e_ij) * dW_ijV_j;
+        }
     }
     dmass_dt_[index_i] = mass_change_rate;
 }
@@ -0,0 +1,26 @@
+#include "eulerian_local_time_stepping.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+LocalPseudoTimeStep::LocalPseudoTimeStep(SPHBody &sph_body, Real acousticCFL)
+    : LocalDynamics(sph_body),
+      fluid_(DynamicCast<Fluid>(this, particles_->getBaseMaterial())),
+      rho_(particles_->getVariableDataByName<Real>("Density")),
+      p_(particles_->getVariableDataByName<Real>("Pressure")),
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
+      vel_(particles_->getVariableDataByName<Vecd>("Velocity")),
+      local_dt_(particles_->registerDiscreteVariable<Real>("LocalTimeStep", particles_->ParticlesBound())),
+      acousticCFL_(acousticCFL) {}
+//=================================================================================================//
+void LocalPseudoTimeStep::update(size_t index_i, Real dt)
+{
+    Real local_size = std::pow(Vol_[index_i], OneOverDimensions);
+    Real signal_speed = fluid_.getSoundSpeed(p_[index_i], rho_[index_i]) + vel_[index_i].norm();
+    local_dt_[index_i] = acousticCFL_ * local_size / (signal_speed + TinyReal);
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
@@ -0,0 +1,84 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    eulerian_local_time_stepping.h
+ * @brief   Local pseudo-time stepping for steady Eulerian SPH and FVM computations.
+ * @details Each particle or cell advances with its own time step limited by
+ *          its size, estimated from the volume, and its acoustic signal speed,
+ *          so that no global reduction of the time step is required.
+ *          The transient is not time accurate any more, only the steady solution is meaningful.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef EULERIAN_LOCAL_TIME_STEPPING_H
+#define EULERIAN_LOCAL_TIME_STEPPING_H
+
+#include "base_general_dynamics.h"
+#include "base_material.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+/**
+ * @class LocalPseudoTimeStep
+ * @brief Computes the local time step of each particle before the integration steps.
+ */
+class LocalPseudoTimeStep : public LocalDynamics
+{
+  public:
+    explicit LocalPseudoTimeStep(SPHBody &sph_body, Real acousticCFL = 0.4);
+    virtual ~LocalPseudoTimeStep(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Fluid &fluid_;
+    Real *rho_, *p_, *Vol_;
+    Vecd *vel_;
+    Real *local_dt_;
+    Real acousticCFL_;
+};
+
+/**
+ * @class LocalTimeStepping
+ * @brief Integration step with the local time step in the update instead of the given global one,
+ * applicable to both the weakly compressible and the compressible Eulerian integrations.
+ */
+template <class IntegrationType>
+class LocalTimeStepping : public IntegrationType
+{
+  public:
+    template <typename... Args>
+    explicit LocalTimeStepping(Args &&...args)
+        : IntegrationType(std::forward<Args>(args)...),
+          local_dt_(this->particles_->template registerDiscreteVariable<Real>(
+              "LocalTimeStep", this->particles_->ParticlesBound())){};
+    virtual ~LocalTimeStepping(){};
+    void update(size_t index_i, Real dt = 0.0) { IntegrationType::update(index_i, local_dt_[index_i]); };
+
+  protected:
+    Real *local_dt_;
+};
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // EULERIAN_LOCAL_TIME_STEPPING_H
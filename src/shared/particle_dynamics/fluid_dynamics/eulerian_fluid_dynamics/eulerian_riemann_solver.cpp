@@ -32,40 +32,18 @@ CompressibleFluidStarState HLLCRiemannSolver::
     Real s_r = ur + compressible_fluid_j_.getSoundSpeed(state_j.p_, state_j.rho_);
     Real s_star = (state_j.rho_ * ur * (s_r - ur) + state_i.rho_ * ul * (ul - s_l) + state_i.p_ - state_j.p_) /
                   (state_j.rho_ * (s_r - ur) + state_i.rho_ * (ul - s_l));
-    Real p_star = 0.0;
-    Vecd v_star = Vecd::Zero();
-    Real rho_star = 0.0;
-    Real energy_star = 0.0;
-    if (0.0 < s_l)
-    {
-        p_star = state_i.p_;
-        v_star = state_i.vel_;
-        rho_star = state_i.rho_;
-        energy_star = state_i.E_;
-    }
-    if (s_l <= 0.0 && 0.0 <= s_star)
-    {
-        p_star = state_i.p_ + state_i.rho_ * (s_l - ul) * (s_star - ul);
-        v_star = state_i.vel_ - e_ij * (s_star - ul);
-        rho_star = state_i.rho_ * (s_l - ul) / (s_l - s_star);
-        energy_star = state_i.rho_ * (s_l - ul) / (s_l - s_star) *
-                      (state_i.E_ / state_i.rho_ + (s_star - ul) * (s_star + state_i.p_ / state_i.rho_ / (s_l - ul)));
-    }
-    if (s_star <= 0.0 && 0.0 <= s_r)
-    {
-        p_star = state_i.p_ + state_i.rho_ * (s_l - ul) * (s_star - ul);
-        v_star = state_j.vel_ - e_ij * (s_star - ur);
-        rho_star = state_j.rho_ * (s_r - ur) / (s_r - s_star);
-        energy_star = state_j.rho_ * (s_r - ur) / (s_r - s_star) *
-                      (state_j.E_ / state_j.rho_ + (s_star - ur) * (s_star + state_j.p_ / state_j.rho_ / (s_r - ur)));
-    }
-    if (s_r < 0.0)
-    {
-        p_star = state_j.p_;
-        v_star = state_j.vel_;
-        rho_star = state_j.rho_;
-        energy_star = state_j.E_;
-    }
+    // both star regions are evaluated and the wave pattern is selected without branches
+    Real p_star_middle = state_i.p_ + state_i.rho_ * (s_l - ul) * (s_star - ul);
+    Real rho_star_l = state_i.rho_ * (s_l - ul) / (s_l - s_star);
+    Real rho_star_r = state_j.rho_ * (s_r - ur) / (s_r - s_star);
+    Real energy_star_l = rho_star_l * (state_i.E_ / state_i.rho_ + (s_star - ul) * (s_star + state_i.p_ / state_i.rho_ / (s_l - ul)));
+    Real energy_star_r = rho_star_r * (state_j.E_ / state_j.rho_ + (s_star - ur) * (s_star + state_j.p_ / state_j.rho_ / (s_r - ur)));
+    HLLCWaveSelection selection(s_l, s_star, s_r);
+    Real p_star = selection.select(state_i.p_, p_star_middle, p_star_middle, state_j.p_);
+    Vecd v_star = selection.select(state_i.vel_, Vecd(state_i.vel_ - e_ij * (s_star - ul)),
+                                   Vecd(state_j.vel_ - e_ij * (s_star - ur)), state_j.vel_);
+    Real rho_star = selection.select(state_i.rho_, rho_star_l, rho_star_r, state_j.rho_);
+    Real energy_star = selection.select(state_i.E_, energy_star_l, energy_star_r, state_j.E_);
     return CompressibleFluidStarState(rho_star, v_star, p_star, energy_star);
 }
 //=================================================================================================//
@@ -107,42 +85,19 @@ CompressibleFluidStarState HLLCWithLimiterRiemannSolver::
                       (state_i.rho_ * (s_l - ul) - state_j.rho_ * (s_r - ur)) +
                   (state_i.rho_ * (s_l - ul) * ul - state_j.rho_ * (s_r - ur) * ur) /
                       (state_i.rho_ * (s_l - ul) - state_j.rho_ * (s_r - ur));
-    Real p_star = 0.0;
-    Vecd v_star = Vecd::Zero();
-    Real rho_star = 0.0;
-    Real energy_star = 0.0;
-    if (0.0 < s_l)
-    {
-        p_star = state_i.p_;
-        v_star = state_i.vel_;
-        rho_star = state_i.rho_;
-        energy_star = state_i.E_;
-    }
-    if (s_l <= 0.0 && 0.0 <= s_star)
-    {
-        p_star = 0.5 * (state_i.p_ + state_j.p_) +
-                 0.5 * (state_i.rho_ * (s_l - ul) * (s_star - ul) + state_j.rho_ * (s_r - ur) * (s_star - ur)) *
-                     SMIN(limiter_parameter_ * SMAX((ul - ur) / clr, Real(0)), Real(1));
-        v_star = state_i.vel_ - e_ij * (s_star - ul);
-        rho_star = state_i.rho_ * (s_l - ul) / (s_l - s_star);
-        energy_star = ((s_l - ul) * state_i.E_ - state_i.p_ * ul + p_star * s_star) / (s_l - s_star);
-    }
-    if (s_star <= 0.0 && 0.0 <= s_r)
-    {
-        p_star = 0.5 * (state_i.p_ + state_j.p_) +
-                 0.5 * (state_i.rho_ * (s_l - ul) * (s_star - ul) + state_j.rho_ * (s_r - ur) * (s_star - ur)) *
-                     SMIN(limiter_parameter_ * SMAX((ul - ur) / clr, Real(0)), Real(1));
-        v_star = state_j.vel_ - e_ij * (s_star - ur);
-        rho_star = state_j.rho_ * (s_r - ur) / (s_r - s_star);
-        energy_star = ((s_r - ur) * state_j.E_ - state_j.p_ * ur + p_star * s_star) / (s_r - s_star);
-    }
-    if (s_r < 0.0)
-    {
-        p_star = state_j.p_;
-        v_star = state_j.vel_;
-        rho_star = state_j.rho_;
-        energy_star = state_j.E_;
-    }
+    Real limited_mach_number = SMIN(limiter_parameter_ * SMAX((ul - ur) / clr, Real(0)), Real(1));
+    Real p_star_middle = 0.5 * (state_i.p_ + state_j.p_) +
+                         0.5 * (state_i.rho_ * (s_l - ul) * (s_star - ul) + state_j.rho_ * (s_r - ur) * (s_star - ur)) *
+                             limited_mach_number;
+    Real energy_star_l = ((s_l - ul) * state_i.E_ - state_i.p_ * ul + p_star_middle * s_star) / (s_l - s_star);
+    Real energy_star_r = ((s_r - ur) * state_j.E_ - state_j.p_ * ur + p_star_middle * s_star) / (s_r - s_star);
+    HLLCWaveSelection selection(s_l, s_star, s_r);
+    Real p_star = selection.select(state_i.p_, p_star_middle, p_star_middle, state_j.p_);
+    Vecd v_star = selection.select(state_i.vel_, Vecd(state_i.vel_ - e_ij * (s_star - ul)),
+                                   Vecd(state_j.vel_ - e_ij * (s_star - ur)), state_j.vel_);
+    Real rho_star = selection.select(state_i.rho_, state_i.rho_ * (s_l - ul) / (s_l - s_star),
+                                     state_j.rho_ * (s_r - ur) / (s_r - s_star), state_j.rho_);
+    Real energy_star = selection.select(state_i.E_, energy_star_l, energy_star_r, state_j.E_);
     return CompressibleFluidStarState(rho_star, v_star, p_star, energy_star);
 }
 //=================================================================================================//
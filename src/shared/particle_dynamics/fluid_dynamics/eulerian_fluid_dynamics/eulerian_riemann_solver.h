@@ -64,6 +64,31 @@ class NoRiemannSolverInCompressibleEulerianMethod
     CompressibleFluidStarState getInterfaceState(const CompressibleFluidState &state_i, const CompressibleFluidState &state_j, const Vecd &e_ij);
 };
 
+/**
+ * @struct HLLCWaveSelection
+ * @brief Selects the left, left star, right star or right state from the wave speeds
+ * by conditional moves instead of branches, with the same precedence as the wave cases,
+ * i.e. the right states are preferred at the boundaries between two regions.
+ */
+struct HLLCWaveSelection
+{
+    bool is_right_, is_right_star_, is_left_star_, is_left_;
+    HLLCWaveSelection(Real s_l, Real s_star, Real s_r)
+        : is_right_(s_r < 0.0),
+          is_right_star_(!is_right_ && s_star <= 0.0 && 0.0 <= s_r),
+          is_left_star_(!is_right_ && !is_right_star_ && s_l <= 0.0 && 0.0 <= s_star),
+          is_left_(!is_right_ && !is_right_star_ && !is_left_star_ && 0.0 < s_l){};
+
+    template <typename DataType>
+    DataType select(const DataType &left, const DataType &left_star,
+                    const DataType &right_star, const DataType &right) const
+    {
+        DataType none = ZeroData<DataType>::value;
+        DataType left_side = is_left_star_ ? left_star : (is_left_ ? left : none);
+        return is_right_ ? right : (is_right_star_ ? right_star : left_side);
+    };
+};
+
 /**
  * @struct HLLCRiemannSolver
  * @brief  HLLC Riemann solver.
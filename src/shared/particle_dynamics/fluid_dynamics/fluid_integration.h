@@ -35,6 +35,7 @@
 #include "base_fluid_dynamics.h"
 #include "base_local_dynamics.h"
 #include "riemann_solver.h"
+#include "state_sentinel.h"
 #include "weakly_compressible_fluid.h"
 
 namespace SPH
@@ -73,6 +74,8 @@ class BaseIntegration : public LocalDynamics, public DataDelegationType
     template <class BaseRelationType>
     explicit BaseIntegration(BaseRelationType &base_relation);
     virtual ~BaseIntegration(){};
+    /** only called once for the inner part of a complex integration */
+    virtual void setupDynamics(Real dt = 0.0) override { sph_body_.incrementStateVersion(); };
 
   protected:
     Fluid &fluid_;
@@ -93,6 +96,10 @@ class Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>
     void initialization(size_t index_i, Real dt = 0.0);
     void interaction(size_t index_i, Real dt = 0.0);
     void update(size_t index_i, Real dt = 0.0);
+    /** for Dynamics1LevelSymmetric */
+    void symmetricPrepare(size_t index_i, Real dt = 0.0);
+    void symmetricInteraction(size_t index_i, Real dt = 0.0);
+    void symmetricFinish(size_t index_i, Real dt = 0.0);
 
   protected:
     KernelCorrectionType correction_;
@@ -166,6 +173,7 @@ class Integration2ndHalf<Inner<>, RiemannSolverType>
   protected:
     RiemannSolverType riemann_solver_;
     Real *mass_, *Vol_;
+    StateSentinelCheck state_sentinel_;
 };
 using Integration2ndHalfInnerRiemann = Integration2ndHalf<Inner<>, AcousticRiemannSolver>;
 using Integration2ndHalfInnerNoRiemann = Integration2ndHalf<Inner<>, NoRiemannSolver>;
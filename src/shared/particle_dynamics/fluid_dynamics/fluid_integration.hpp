@@ -92,6 +92,49 @@ void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::inter
 }
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::
+    symmetricPrepare(size_t index_i, Real dt)
+{
+    drho_dt_[index_i] = 0.0;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::
+    symmetricInteraction(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    Real rho_dissipation(0);
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        if (index_j > index_i)
+        {
+            Real dW_ij = inner_neighborhood.dW_ij_[n];
+            const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+
+            Vecd pair_force = -(p_[index_i] * correction_(index_j) + p_[index_j] * correction_(index_i)) *
+                              dW_ij * Vol_[index_i] * Vol_[index_j] * e_ij;
+            force += pair_force;
+            force_[index_j] -= pair_force;
+            // the dissipative velocity jump is linear in the pressure jump
+            Real u_jump = riemann_solver_.DissipativeUJump(p_[index_i] - p_[index_j]) * dW_ij;
+            rho_dissipation += u_jump * Vol_[index_j];
+            drho_dt_[index_j] -= u_jump * Vol_[index_i];
+        }
+    }
+    force_[index_i] += force;
+    drho_dt_[index_i] += rho_dissipation;
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
+void Integration1stHalf<Inner<>, RiemannSolverType, KernelCorrectionType>::
+    symmetricFinish(size_t index_i, Real dt)
+{
+    drho_dt_[index_i] *= rho_[index_i];
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType>
 Integration1stHalf<Contact<Wall>, RiemannSolverType, KernelCorrectionType>::
     Integration1stHalf(BaseContactRelation &wall_contact_relation)
     : BaseIntegrationWithWall(wall_contact_relation),
@@ -173,7 +216,8 @@ Integration2ndHalf<Inner<>, RiemannSolverType>::
     Integration2ndHalf(BaseInnerRelation &inner_relation)
     : BaseIntegration<DataDelegateInner>(inner_relation), riemann_solver_(this->fluid_, this->fluid_),
       mass_(particles_->getVariableDataByName<Real>("Mass")),
-      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")) {}
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
+      state_sentinel_(particles_) {}
 //=================================================================================================//
 template <class RiemannSolverType>
 void Integration2ndHalf<Inner<>, RiemannSolverType>::initialization(size_t index_i, Real dt)
@@ -185,6 +229,7 @@ template <class RiemannSolverType>
 void Integration2ndHalf<Inner<>, RiemannSolverType>::update(size_t index_i, Real dt)
 {
     rho_[index_i] += drho_dt_[index_i] * dt * 0.5;
+    state_sentinel_.check(vel_[index_i]);
 }
 //=================================================================================================//
 template <class RiemannSolverType>
@@ -0,0 +1,80 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	implicit_viscous_dynamics.h
+ * @brief 	Implicit viscous force for high-viscosity and non-Newtonian flows.
+ * @details The velocity after the viscous diffusion over the advection time step is obtained by
+ *          the backward Euler method, i.e. (M / dt + L) v^{n+1} = M / dt v^n, with L the viscous operator
+ *          from the inner neighbor lists, which is symmetric positive definite. The system is solved
+ *          matrix free by the Jacobi preconditioned conjugate gradient method
+ *          warm started from the increment of the previous solution.
+ *          The viscous force is then the one giving the same velocity increment over the advection step,
+ *          so that the time-step size is bounded by advection rather than viscous diffusion,
+ *          i.e. AdvectionTimeStep can be used instead of AdvectionViscousTimeStep.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef IMPLICIT_VISCOUS_DYNAMICS_H
+#define IMPLICIT_VISCOUS_DYNAMICS_H
+
+#include "viscous_dynamics.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+template <typename... InteractionTypes>
+class ImplicitViscousForce;
+
+template <typename ViscosityType, class ExecutionPolicy>
+class ImplicitViscousForce<Inner<>, ViscosityType, ExecutionPolicy>
+    : public ViscousForce<DataDelegateInner>, public BaseDynamics<void>
+{
+  public:
+    explicit ImplicitViscousForce(BaseInnerRelation &inner_relation,
+                                  Real tolerance = 1.0e-6, UnsignedInt max_iterations = 100);
+    virtual ~ImplicitViscousForce(){};
+    UnsignedInt Iterations() { return iterations_; };
+    Real RelativeResidual() { return relative_residual_; };
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    ViscosityType mu_;
+    Real tolerance_;
+    UnsignedInt max_iterations_;
+    UnsignedInt iterations_;
+    Real relative_residual_;
+    Real *diagonal_;
+    Vecd *solution_, *residual_, *direction_, *operator_direction_, *increment_;
+
+    Real coefficient(size_t index_i, const Neighborhood &inner_neighborhood, size_t n);
+    /** the off-diagonal part of the viscous operator applied on a field */
+    Vecd offDiagonalProduct(size_t index_i, Vecd *field);
+    template <class ParticleFunction>
+    Real sum(const ParticleFunction &particle_function);
+};
+using ImplicitViscousForceInner = ImplicitViscousForce<Inner<>, FixedViscosity, ParallelPolicy>;
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // IMPLICIT_VISCOUS_DYNAMICS_H
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "implicit_viscous_dynamics.h"
+
+#include "viscous_dynamics.hpp"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <typename ViscosityType, class ExecutionPolicy>
+ImplicitViscousForce<Inner<>, ViscosityType, ExecutionPolicy>::
+    ImplicitViscousForce(BaseInnerRelation &inner_relation, Real tolerance, UnsignedInt max_iterations)
+    : ViscousForce<DataDelegateInner>(inner_relation), BaseDynamics<void>(),
+      mu_(particles_), tolerance_(tolerance), max_iterations_(max_iterations),
+      iterations_(0), relative_residual_(0.0),
+      diagonal_(particles_->registerStateVariable<Real>("ImplicitViscousDiagonal")),
+      solution_(particles_->registerStateVariable<Vecd>("ImplicitViscousVelocity")),
+      residual_(particles_->registerStateVariable<Vecd>("ImplicitViscousResidual")),
+      direction_(particles_->registerStateVariable<Vecd>("ImplicitViscousDirection")),
+      operator_direction_(particles_->registerStateVariable<Vecd>("ImplicitViscousOperatorDirection")),
+      increment_(particles_->registerStateVariable<Vecd>("ImplicitViscousIncrement"))
+{
+    static_assert(std::is_base_of<ParticleAverage, ViscosityType>::value,
+                  "ParticleAverage is not the base of ViscosityType!");
+}
+//=================================================================================================//
+template <typename ViscosityType, class ExecutionPolicy>
+Real ImplicitViscousForce<Inner<>, ViscosityType, ExecutionPolicy>::
+    coefficient(size_t index_i, const Neighborhood &inner_neighborhood, size_t n)
+{
+    size_t index_j = inner_neighborhood.j_[n];
+    return -2.0 * mu_(index_i, index_j) * inner_neighborhood.dW_ij_[n] * Vol_[index_i] * Vol_[index_j] /
+           (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
+}
+//=================================================================================================//
+template <typename ViscosityType, class ExecutionPolicy>
+Vecd ImplicitViscousForce<Inner<>, ViscosityType, ExecutionPolicy>::
+    offDiagonalProduct(size_t index_i, Vecd *field)
+{
+    Vecd product = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        product += coefficient(index_i, inner_neighborhood, n) * field[inner_neighborhood.j_[n]];
+    }
+    return product;
+}
+//=================================================================================================//
+template <typename ViscosityType, class ExecutionPolicy>
+template <class ParticleFunction>
+Real ImplicitViscousForce<Inner<>, ViscosityType, ExecutionPolicy>::
+    sum(const ParticleFunction &particle_function)
+{
+    return particle_reduce(ExecutionPolicy(), this->identifier_.LoopRange(),
+                           Real(0), ReduceSum<Real>(), particle_function);
+}
+//=================================================================================================//
+template <typename ViscosityType, class ExecutionPolicy>
+void ImplicitViscousForce<Inner<>, ViscosityType, ExecutionPolicy>::exec(Real dt)
+{
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+    this->setUpdated(this->identifier_.getSPHBody());
+    this->setupDynamics(dt);
+    IndexRange loop_range = this->identifier_.LoopRange();
+    Real inv_dt = 1.0 / (dt + TinyReal);
+
+    // the diagonal, the warm start and the initial residual of (M / dt + L) v = M / dt v^n
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 {
+                     Real diagonal = mass_[i] * inv_dt;
+                     const Neighborhood &inner_neighborhood = inner_configuration_[i];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                         diagonal += coefficient(i, inner_neighborhood, n);
+                     diagonal_[i] = diagonal;
+                     solution_[i] = vel_[i] + increment_[i];
+                 });
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 {
+                     residual_[i] = mass_[i] * inv_dt * vel_[i] -
+                                    diagonal_[i] * solution_[i] + offDiagonalProduct(i, solution_);
+                     direction_[i] = residual_[i] / diagonal_[i];
+                 });
+    Real rhs_norm = std::sqrt(sum([&](size_t i) -> Real
+                                  { return (mass_[i] * inv_dt * vel_[i]).squaredNorm(); }));
+    Real residual_dot = sum([&](size_t i) -> Real
+                            { return residual_[i].dot(direction_[i]); });
+    relative_residual_ = std::sqrt(sum([&](size_t i) -> Real
+                                       { return residual_[i].squaredNorm(); })) /
+                         (rhs_norm + TinyReal);
+
+    iterations_ = 0;
+    while (relative_residual_ > tolerance_ && iterations_ < max_iterations_)
+    {
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { operator_direction_[i] = diagonal_[i] * direction_[i] - offDiagonalProduct(i, direction_); });
+        Real alpha = residual_dot / (sum([&](size_t i) -> Real
+                                         { return direction_[i].dot(operator_direction_[i]); }) +
+                                     TinyReal);
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     {
+                         solution_[i] += alpha * direction_[i];
+                         residual_[i] -= alpha * operator_direction_[i];
+                     });
+        Real new_residual_dot = sum([&](size_t i) -> Real
+                                    { return residual_[i].dot(residual_[i] / diagonal_[i]); });
+        Real beta = new_residual_dot / (residual_dot + TinyReal);
+        residual_dot = new_residual_dot;
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { direction_[i] = residual_[i] / diagonal_[i] + beta * direction_[i]; });
+        relative_residual_ = std::sqrt(sum([&](size_t i) -> Real
+                                           { return residual_[i].squaredNorm(); })) /
+                             (rhs_norm + TinyReal);
+        ++iterations_;
+    }
+
+    // the viscous force giving the implicit velocity increment over the advection step
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 {
+                     increment_[i] = solution_[i] - vel_[i];
+                     viscous_force_[i] = mass_[i] * inv_dt * increment_[i];
+                     this->update(i, dt);
+                 });
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
@@ -0,0 +1,64 @@
+#include "incompressible_projection.hpp"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+ProjectionPredictor::ProjectionPredictor(SPHBody &sph_body)
+    : LocalDynamics(sph_body),
+      mass_(particles_->getVariableDataByName<Real>("Mass")),
+      pos_(particles_->getVariableDataByName<Vecd>("Position")),
+      vel_(particles_->getVariableDataByName<Vecd>("Velocity")),
+      force_prior_(particles_->getVariableDataByName<Vecd>("ForcePrior")) {}
+//=================================================================================================//
+void ProjectionPredictor::update(size_t index_i, Real dt)
+{
+    vel_[index_i] += force_prior_[index_i] / mass_[index_i] * dt;
+    pos_[index_i] += vel_[index_i] * dt;
+}
+//=================================================================================================//
+ProjectionCorrection<Inner<>>::ProjectionCorrection(BaseInnerRelation &inner_relation)
+    : ProjectionCorrection<DataDelegateInner>(inner_relation) {}
+//=================================================================================================//
+void ProjectionCorrection<Inner<>>::interaction(size_t index_i, Real dt)
+{
+    Vecd acceleration = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        acceleration -= (p_[index_i] + p_[index_j]) * inner_neighborhood.dW_ij_[n] *
+                        inner_neighborhood.e_ij_[n] * Vol_[index_j];
+    }
+    pressure_acc_[index_i] = acceleration / rho_[index_i];
+}
+//=================================================================================================//
+void ProjectionCorrection<Inner<>>::update(size_t index_i, Real dt)
+{
+    vel_[index_i] += pressure_acc_[index_i] * dt;
+    pos_[index_i] += pressure_acc_[index_i] * dt * dt;
+}
+//=================================================================================================//
+ProjectionCorrection<Contact<Wall>>::ProjectionCorrection(BaseContactRelation &wall_contact_relation)
+    : InteractionWithWall<ProjectionCorrection>(wall_contact_relation) {}
+//=================================================================================================//
+void ProjectionCorrection<Contact<Wall>>::interaction(size_t index_i, Real dt)
+{
+    Vecd acceleration = Vecd::Zero();
+    for (size_t k = 0; k < contact_configuration_.size(); ++k)
+    {
+        Real *wall_Vol_k = wall_Vol_[k];
+        const Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+        for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = contact_neighborhood.j_[n];
+            acceleration -= 2.0 * p_[index_i] * contact_neighborhood.dW_ij_[n] *
+                            contact_neighborhood.e_ij_[n] * wall_Vol_k[index_j];
+        }
+    }
+    pressure_acc_[index_i] += acceleration / rho_[index_i];
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
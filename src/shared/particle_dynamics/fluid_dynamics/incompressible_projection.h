@@ -0,0 +1,149 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	incompressible_projection.h
+ * @brief 	Here, we define the algorithm classes for incompressible SPH (ISPH)
+ *          by the pressure projection of the density-invariant type.
+ * @details An advection step consists of
+ *          the predictor (velocity by the prior forces and the predicted positions),
+ *          the configuration update and DensitySummation at the predicted positions,
+ *          the solution of the pressure Poisson equation
+ *          div(1 / rho grad p) = (rho_0 - rho) / (rho_0 dt^2) and
+ *          the projection correcting the velocity and positions by the pressure gradient,
+ *          in which the wall pressure is mirrored from the fluid for the Neumann condition.
+ *          TransportVelocityCorrection can be applied afterwards as for the weakly compressible fluid.
+ *          As there is no artificial sound speed, the time-step size is given by
+ *          AdvectionViscousTimeStep and no acoustic sub-step is needed.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef INCOMPRESSIBLE_PROJECTION_H
+#define INCOMPRESSIBLE_PROJECTION_H
+
+#include "base_fluid_dynamics.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+/**
+ * @class ProjectionPredictor
+ * @brief The intermediate velocity by the prior forces, e.g. gravity and viscous force,
+ *        and the predicted positions.
+ */
+class ProjectionPredictor : public LocalDynamics
+{
+  public:
+    explicit ProjectionPredictor(SPHBody &sph_body);
+    virtual ~ProjectionPredictor(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Real *mass_;
+    Vecd *pos_, *vel_, *force_prior_;
+};
+
+/**
+ * @class PressurePoissonSolver
+ * @brief The pressure Poisson equation multiplied by the particle volume,
+ *        which gives a symmetric positive (semi-)definite system from the inner neighbor lists,
+ *        is solved matrix free by the Jacobi preconditioned conjugate gradient method
+ *        warm started from the previous pressure.
+ *        With free surface, the surface particles given by the surface indication take
+ *        the zero pressure as the Dirichlet condition. Otherwise, the pressure level is
+ *        fixed by a small relative regularization of the diagonal.
+ */
+template <class ExecutionPolicy = ParallelPolicy>
+class PressurePoissonSolver : public LocalDynamics, public DataDelegateInner, public BaseDynamics<void>
+{
+  public:
+    explicit PressurePoissonSolver(BaseInnerRelation &inner_relation, bool is_free_surface = false,
+                                   Real tolerance = 1.0e-6, UnsignedInt max_iterations = 500);
+    virtual ~PressurePoissonSolver(){};
+    UnsignedInt Iterations() { return iterations_; };
+    Real RelativeResidual() { return relative_residual_; };
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    bool is_free_surface_;
+    Real tolerance_;
+    UnsignedInt max_iterations_;
+    UnsignedInt iterations_;
+    Real relative_residual_;
+    Real rho0_, smoothing_length_, regularization_;
+    int *indicator_;
+    Real *rho_, *Vol_, *p_;
+    Real *diagonal_, *rhs_, *residual_, *direction_, *operator_direction_;
+
+    bool isDirichlet(size_t index_i) { return is_free_surface_ && indicator_[index_i] == 1; };
+    Real coefficient(size_t index_i, const Neighborhood &inner_neighborhood, size_t n);
+    Real offDiagonalProduct(size_t index_i, Real *field);
+    template <class ParticleFunction>
+    Real sum(const ParticleFunction &particle_function);
+};
+
+template <typename... InteractionTypes>
+class ProjectionCorrection;
+
+template <class DataDelegationType>
+class ProjectionCorrection<DataDelegationType>
+    : public LocalDynamics, public DataDelegationType
+{
+  public:
+    template <class BaseRelationType>
+    explicit ProjectionCorrection(BaseRelationType &base_relation);
+    virtual ~ProjectionCorrection(){};
+
+  protected:
+    Real *rho_, *p_, *Vol_;
+    Vecd *pos_, *vel_, *pressure_acc_;
+};
+
+/**
+ * @class ProjectionCorrection
+ * @brief Correcting the velocity and the predicted positions by the pressure gradient.
+ */
+template <>
+class ProjectionCorrection<Inner<>> : public ProjectionCorrection<DataDelegateInner>
+{
+  public:
+    explicit ProjectionCorrection(BaseInnerRelation &inner_relation);
+    virtual ~ProjectionCorrection(){};
+    void interaction(size_t index_i, Real dt = 0.0);
+    void update(size_t index_i, Real dt = 0.0);
+};
+
+template <>
+class ProjectionCorrection<Contact<Wall>> : public InteractionWithWall<ProjectionCorrection>
+{
+  public:
+    explicit ProjectionCorrection(BaseContactRelation &wall_contact_relation);
+    virtual ~ProjectionCorrection(){};
+    void interaction(size_t index_i, Real dt = 0.0);
+};
+
+using ProjectionCorrectionWithWall = ComplexInteraction<ProjectionCorrection<Inner<>, Contact<Wall>>>;
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // INCOMPRESSIBLE_PROJECTION_H
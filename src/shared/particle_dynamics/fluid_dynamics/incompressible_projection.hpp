@@ -0,0 +1,145 @@
+#pragma once
+
+#include "incompressible_projection.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+template <class ExecutionPolicy>
+PressurePoissonSolver<ExecutionPolicy>::
+    PressurePoissonSolver(BaseInnerRelation &inner_relation, bool is_free_surface,
+                          Real tolerance, UnsignedInt max_iterations)
+    : LocalDynamics(inner_relation.getSPHBody()), DataDelegateInner(inner_relation), BaseDynamics<void>(),
+      is_free_surface_(is_free_surface), tolerance_(tolerance), max_iterations_(max_iterations),
+      iterations_(0), relative_residual_(0.0),
+      rho0_(sph_body_.getBaseMaterial().ReferenceDensity()),
+      smoothing_length_(sph_body_.sph_adaptation_->ReferenceSmoothingLength()),
+      regularization_(is_free_surface ? 0.0 : 1.0e-6),
+      indicator_(is_free_surface ? particles_->getVariableDataByName<int>("Indicator") : nullptr),
+      rho_(particles_->getVariableDataByName<Real>("Density")),
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
+      p_(particles_->getVariableDataByName<Real>("Pressure")),
+      diagonal_(particles_->registerStateVariable<Real>("PoissonDiagonal")),
+      rhs_(particles_->registerStateVariable<Real>("PoissonRightHandSide")),
+      residual_(particles_->registerStateVariable<Real>("PoissonResidual")),
+      direction_(particles_->registerStateVariable<Real>("PoissonDirection")),
+      operator_direction_(particles_->registerStateVariable<Real>("PoissonOperatorDirection")) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+Real PressurePoissonSolver<ExecutionPolicy>::
+    coefficient(size_t index_i, const Neighborhood &inner_neighborhood, size_t n)
+{
+    size_t index_j = inner_neighborhood.j_[n];
+    return -4.0 * inner_neighborhood.dW_ij_[n] * Vol_[index_i] * Vol_[index_j] /
+           ((rho_[index_i] + rho_[index_j]) * (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_));
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+Real PressurePoissonSolver<ExecutionPolicy>::offDiagonalProduct(size_t index_i, Real *field)
+{
+    Real product = 0.0;
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        product += coefficient(index_i, inner_neighborhood, n) * field[inner_neighborhood.j_[n]];
+    }
+    return product;
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+template <class ParticleFunction>
+Real PressurePoissonSolver<ExecutionPolicy>::sum(const ParticleFunction &particle_function)
+{
+    return particle_reduce(ExecutionPolicy(), this->identifier_.LoopRange(),
+                           Real(0), ReduceSum<Real>(), particle_function);
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void PressurePoissonSolver<ExecutionPolicy>::exec(Real dt)
+{
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
+    this->setUpdated(this->identifier_.getSPHBody());
+    this->setupDynamics(dt);
+    IndexRange loop_range = this->identifier_.LoopRange();
+    Real inv_dt_square = 1.0 / (dt * dt + TinyReal);
+
+    // the diagonal, the right hand side and the Dirichlet condition
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 {
+                     if (isDirichlet(i))
+                     {
+                         diagonal_[i] = 1.0;
+                         rhs_[i] = 0.0;
+                         p_[i] = 0.0;
+                         return;
+                     }
+                     Real diagonal = 0.0;
+                     const Neighborhood &inner_neighborhood = inner_configuration_[i];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                         diagonal += coefficient(i, inner_neighborhood, n);
+                     diagonal_[i] = (1.0 + regularization_) * diagonal + TinyReal;
+                     rhs_[i] = Vol_[i] * (rho_[i] - rho0_) / rho0_ * inv_dt_square;
+                 });
+    particle_for(ExecutionPolicy(), loop_range,
+                 [&](size_t i)
+                 {
+                     residual_[i] = isDirichlet(i) ? 0.0
+                                                   : rhs_[i] - diagonal_[i] * p_[i] + offDiagonalProduct(i, p_);
+                     direction_[i] = residual_[i] / diagonal_[i];
+                 });
+    Real rhs_norm = std::sqrt(sum([&](size_t i) -> Real
+                                  { return rhs_[i] * rhs_[i]; }));
+    Real residual_dot = sum([&](size_t i) -> Real
+                            { return residual_[i] * direction_[i]; });
+    relative_residual_ = std::sqrt(sum([&](size_t i) -> Real
+                                       { return residual_[i] * residual_[i]; })) /
+                         (rhs_norm + TinyReal);
+
+    iterations_ = 0;
+    while (relative_residual_ > tolerance_ && iterations_ < max_iterations_)
+    {
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     {
+                         operator_direction_[i] = isDirichlet(i) ? 0.0
+                                                                 : diagonal_[i] * direction_[i] - offDiagonalProduct(i, direction_);
+                     });
+        Real alpha = residual_dot / (sum([&](size_t i) -> Real
+                                         { return direction_[i] * operator_direction_[i]; }) +
+                                     TinyReal);
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     {
+                         p_[i] += alpha * direction_[i];
+                         residual_[i] -= alpha * operator_direction_[i];
+                     });
+        Real new_residual_dot = sum([&](size_t i) -> Real
+                                    { return residual_[i] * residual_[i] / diagonal_[i]; });
+        Real beta = new_residual_dot / (residual_dot + TinyReal);
+        residual_dot = new_residual_dot;
+        particle_for(ExecutionPolicy(), loop_range,
+                     [&](size_t i)
+                     { direction_[i] = residual_[i] / diagonal_[i] + beta * direction_[i]; });
+        relative_residual_ = std::sqrt(sum([&](size_t i) -> Real
+                                           { return residual_[i] * residual_[i]; })) /
+                             (rhs_norm + TinyReal);
+        ++iterations_;
+    }
+}
+//=================================================================================================//
+template <class DataDelegationType>
+template <class BaseRelationType>
+ProjectionCorrection<DataDelegationType>::ProjectionCorrection(BaseRelationType &base_relation)
+    : LocalDynamics(base_relation.getSPHBody()), DataDelegationType(base_relation),
+      rho_(particles_->getVariableDataByName<Real>("Density")),
+      p_(particles_->getVariableDataByName<Real>("Pressure")),
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
+      pos_(particles_->getVariableDataByName<Vecd>("Position")),
+      vel_(particles_->getVariableDataByName<Vecd>("Velocity")),
+      pressure_acc_(particles_->registerStateVariable<Vecd>("PressureAcceleration")) {}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
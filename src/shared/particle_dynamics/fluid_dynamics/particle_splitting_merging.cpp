@@ -0,0 +1,112 @@
+#include "particle_splitting_merging.h"
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+//=================================================================================================//
+BaseParticleSplittingMerging::
+    BaseParticleSplittingMerging(SPHBody &sph_body, const std::string &indicator_name)
+    : h_ratio_factor_(std::pow(2.0, 1.0 / Real(Dimensions))),
+      h_ratio_max_(sph_body.sph_adaptation_->ReferenceSmoothingLength() /
+                   sph_body.sph_adaptation_->MinimumSmoothingLength()),
+      indicator_(sph_body.getBaseParticles().getVariableDataByName<Real>(indicator_name)),
+      h_ratio_(sph_body.getBaseParticles().getVariableDataByName<Real>("SmoothingLengthRatio")),
+      pos_(sph_body.getBaseParticles().getVariableDataByName<Vecd>("Position")),
+      vel_(sph_body.getBaseParticles().getVariableDataByName<Vecd>("Velocity")),
+      mass_(sph_body.getBaseParticles().getVariableDataByName<Real>("Mass")),
+      Vol_(sph_body.getBaseParticles().getVariableDataByName<Real>("VolumetricMeasure")),
+      rho_(sph_body.getBaseParticles().getVariableDataByName<Real>("Density")) {}
+//=================================================================================================//
+ParticleSplitting::ParticleSplitting(SPHBody &sph_body, ParticleBuffer<Base> &buffer,
+                                     const std::string &indicator_name, Real splitting_threshold)
+    : LocalDynamics(sph_body), BaseParticleSplittingMerging(sph_body, indicator_name),
+      buffer_(buffer), splitting_threshold_(splitting_threshold)
+{
+    buffer_.checkParticlesReserved();
+}
+//=================================================================================================//
+void ParticleSplitting::update(size_t index_i, Real dt)
+{
+    if (indicator_[index_i] > splitting_threshold_ &&
+        h_ratio_[index_i] * h_ratio_factor_ < h_ratio_max_ + Eps)
+    {
+        mutex_split_.lock();
+        buffer_.checkEnoughBuffer(*particles_);
+        size_t new_index = particles_->createRealParticleFrom(index_i);
+        mutex_split_.unlock();
+
+        int level = std::lround(std::log(h_ratio_[index_i]) / std::log(h_ratio_factor_));
+        Vecd offset = 0.25 * particles_->ParticleSpacing(index_i) * Vecd::Unit(level % Dimensions);
+        pos_[index_i] -= offset;
+        pos_[new_index] = pos_[index_i] + 2.0 * offset;
+        mass_[index_i] *= 0.5;
+        Vol_[index_i] *= 0.5;
+        h_ratio_[index_i] *= h_ratio_factor_;
+        mass_[new_index] = mass_[index_i];
+        Vol_[new_index] = Vol_[index_i];
+        h_ratio_[new_index] = h_ratio_[index_i];
+    }
+}
+//=================================================================================================//
+ParticleMerging::ParticleMerging(BaseInnerRelation &inner_relation,
+                                 const std::string &indicator_name, Real merging_threshold)
+    : LocalDynamics(inner_relation.getSPHBody()), DataDelegateInner(inner_relation),
+      BaseParticleSplittingMerging(inner_relation.getSPHBody(), indicator_name),
+      merging_threshold_(merging_threshold),
+      merging_partner_(particles_->registerDiscreteVariable<UnsignedInt>("MergingPartner", particles_->ParticlesBound())),
+      is_merged_(particles_->registerStateVariable<int>("IsMerged")) {}
+//=================================================================================================//
+void ParticleMerging::interaction(size_t index_i, Real dt)
+{
+    is_merged_[index_i] = 0;
+    merging_partner_[index_i] = index_i;
+    if (!isToBeCoarsened(index_i))
+        return;
+
+    Real r_min = MaxReal;
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        if (isToBeCoarsened(index_j) && inner_neighborhood.r_ij_[n] < r_min &&
+            ABS(h_ratio_[index_j] - h_ratio_[index_i]) < Eps * h_ratio_[index_i])
+        {
+            r_min = inner_neighborhood.r_ij_[n];
+            merging_partner_[index_i] = index_j;
+        }
+    }
+}
+//=================================================================================================//
+void ParticleMerging::update(size_t index_i, Real dt)
+{
+    size_t index_j = merging_partner_[index_i];
+    if (index_j > index_i && merging_partner_[index_j] == index_i)
+    {
+        Real mass = mass_[index_i] + mass_[index_j];
+        Real weight_i = mass_[index_i] / mass;
+        Real weight_j = mass_[index_j] / mass;
+        pos_[index_i] = weight_i * pos_[index_i] + weight_j * pos_[index_j];
+        vel_[index_i] = weight_i * vel_[index_i] + weight_j * vel_[index_j];
+        mass_[index_i] = mass;
+        Vol_[index_i] += Vol_[index_j];
+        rho_[index_i] = mass / Vol_[index_i];
+        h_ratio_[index_i] /= h_ratio_factor_;
+        is_merged_[index_j] = 1;
+    }
+}
+//=================================================================================================//
+MergedParticleDeletion::MergedParticleDeletion(SPHBody &sph_body)
+    : LocalDynamics(sph_body),
+      is_merged_(particles_->getVariableDataByName<int>("IsMerged")) {}
+//=================================================================================================//
+void MergedParticleDeletion::update(size_t index_i, Real dt)
+{
+    while (index_i < particles_->TotalRealParticles() && is_merged_[index_i] == 1)
+    {
+        particles_->switchToBufferParticle(index_i);
+    }
+}
+//=================================================================================================//
+} // namespace fluid_dynamics
+} // namespace SPH
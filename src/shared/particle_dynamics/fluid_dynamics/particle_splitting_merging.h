@@ -0,0 +1,131 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	particle_splitting_merging.h
+ * @brief 	Run-time splitting and merging of fluid particles for adaptive resolution.
+ * @details A particle is split into two daughters where a refinement indicator,
+ *          e.g. the distance to the free surface, the vorticity or a user field,
+ *          is above the splitting threshold, and two mutual nearest particles of the same resolution
+ *          are merged where it is below the merging threshold.
+ *          Both conserve mass, momentum and center of mass.
+ *          The daughters are taken from the particle buffer and the smoothing length ratios are
+ *          updated by the factor 2^(1/Dimensions) so that adaptive neighbor builders follow the changes.
+ *          Both are used with the adaptive particles of ParticleWithLocalRefinement, and
+ *          the configuration should be updated after them.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PARTICLE_SPLITTING_MERGING_H
+#define PARTICLE_SPLITTING_MERGING_H
+
+#include "base_fluid_dynamics.h"
+#include "particle_reserve.h"
+
+#include <mutex>
+
+namespace SPH
+{
+namespace fluid_dynamics
+{
+class BaseParticleSplittingMerging
+{
+  public:
+    BaseParticleSplittingMerging(SPHBody &sph_body, const std::string &indicator_name);
+    virtual ~BaseParticleSplittingMerging(){};
+
+  protected:
+    Real h_ratio_factor_;  /**< change of the smoothing length ratio by splitting or merging */
+    Real h_ratio_max_;     /**< for the finest particles */
+    Real *indicator_, *h_ratio_;
+    Vecd *pos_, *vel_;
+    Real *mass_, *Vol_, *rho_;
+};
+
+/**
+ * @class ParticleSplitting
+ * @brief Splitting a particle into two daughters with half of its mass and volume,
+ *        which are placed along the axis cycled with the resolution level,
+ *        so that repeated splittings keep the particle distribution regular.
+ */
+class ParticleSplitting : public LocalDynamics, public BaseParticleSplittingMerging
+{
+  public:
+    ParticleSplitting(SPHBody &sph_body, ParticleBuffer<Base> &buffer,
+                      const std::string &indicator_name, Real splitting_threshold);
+    virtual ~ParticleSplitting(){};
+
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    std::mutex mutex_split_; /**< mutex exclusion for memory conflict */
+    ParticleBuffer<Base> &buffer_;
+    Real splitting_threshold_;
+};
+
+/**
+ * @class ParticleMerging
+ * @brief The interaction finds for each particle to be coarsened its nearest neighbor
+ *        to be coarsened with the same resolution, and the update merges the mutual nearest pairs
+ *        into the particle with the lower index and marks the other one.
+ *        The marked particles are removed by MergedParticleDeletion afterwards.
+ */
+class ParticleMerging : public LocalDynamics, public DataDelegateInner, public BaseParticleSplittingMerging
+{
+  public:
+    ParticleMerging(BaseInnerRelation &inner_relation, const std::string &indicator_name, Real merging_threshold);
+    virtual ~ParticleMerging(){};
+
+    void interaction(size_t index_i, Real dt = 0.0);
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Real merging_threshold_;
+    UnsignedInt *merging_partner_;
+    int *is_merged_;
+
+    bool isToBeCoarsened(size_t index_i)
+    {
+        return indicator_[index_i] < merging_threshold_ && h_ratio_[index_i] > h_ratio_factor_ - Eps;
+    };
+};
+
+/**
+ * @class MergedParticleDeletion
+ * @brief Removing the particles marked by ParticleMerging into the buffer.
+ *        Note that it should be run with the sequenced execution policy,
+ *        as the last real particle is moved into the place of a removed one.
+ */
+class MergedParticleDeletion : public LocalDynamics
+{
+  public:
+    explicit MergedParticleDeletion(SPHBody &sph_body);
+    virtual ~MergedParticleDeletion(){};
+
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    int *is_merged_;
+};
+} // namespace fluid_dynamics
+} // namespace SPH
+#endif // PARTICLE_SPLITTING_MERGING_H
@@ -57,9 +57,30 @@ void StaticConfinementIntegration2ndHalf::update(size_t index_i, Real dt)
     drho_dt_[index_i] += rho_[index_i] * (vel_[index_i] - vel_in_wall).dot(kernel_gradient);
 }
 //=================================================================================================//
+StaticConfinementViscousForce::StaticConfinementViscousForce(NearShapeSurface &near_surface)
+    : BaseLocalDynamics<BodyPartByCell>(near_surface),
+      mu_(DynamicCast<Fluid>(this, particles_->getBaseMaterial()).ReferenceViscosity()),
+      smoothing_length_(sph_body_.sph_adaptation_->ReferenceSmoothingLength()),
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
+      pos_(particles_->getVariableDataByName<Vecd>("Position")),
+      vel_(particles_->getVariableDataByName<Vecd>("Velocity")),
+      viscous_force_(particles_->getVariableDataByName<Vecd>("ViscousForce")),
+      level_set_shape_(&near_surface.getLevelSetShape()) {}
+//=================================================================================================//
+void StaticConfinementViscousForce::update(size_t index_i, Real dt)
+{
+    Vecd kernel_gradient = level_set_shape_->computeKernelGradientIntegral(pos_[index_i]);
+    Real distance_to_mirror = 2.0 * ABS(level_set_shape_->findSignedDistance(pos_[index_i]));
+    Vecd vel_derivative = 2.0 * vel_[index_i] / (distance_to_mirror + 0.01 * smoothing_length_);
+    viscous_force_[index_i] -= 2.0 * mu_ * vel_derivative * kernel_gradient.norm() * Vol_[index_i];
+}
+//=================================================================================================//
 StaticConfinement::StaticConfinement(NearShapeSurface &near_surface)
     : density_summation_(near_surface), pressure_relaxation_(near_surface),
       density_relaxation_(near_surface), surface_bounding_(near_surface) {}
 //=================================================================================================//
+StaticConfinementWithViscosity::StaticConfinementWithViscosity(NearShapeSurface &near_surface)
+    : StaticConfinement(near_surface), viscous_force_(near_surface) {}
+//=================================================================================================//
 } // namespace fluid_dynamics
 } // namespace SPH
@@ -94,9 +94,32 @@ class StaticConfinementIntegration2ndHalf : public BaseLocalDynamics<BodyPartByC
     AcousticRiemannSolver riemann_solver_;
 };
 
+/**
+ * @class StaticConfinementViscousForce
+ * @brief static confinement condition for the viscous force of a no-slip wall,
+ *        in which the wall contribution is evaluated with the kernel gradient integral
+ *        and the distance to the mirrored particle in the wall.
+ */
+class StaticConfinementViscousForce : public BaseLocalDynamics<BodyPartByCell>
+{
+  public:
+    StaticConfinementViscousForce(NearShapeSurface &near_surface);
+    virtual ~StaticConfinementViscousForce(){};
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Real mu_, smoothing_length_;
+    Real *Vol_;
+    Vecd *pos_, *vel_, *viscous_force_;
+    LevelSetShape *level_set_shape_;
+};
+
 /**
  * @class StaticConfinement
- * @brief Static confined boundary condition for complex structures.
+ * @brief Static confined boundary condition for complex structures,
+ *        which replaces the dummy wall particles and their contact interactions
+ *        by the kernel integrals of the level set of the wall shape.
+ *        The confinement dynamics are run as post processes of the corresponding inner fluid dynamics.
  */
 class StaticConfinement
 {
@@ -110,6 +133,20 @@ class StaticConfinement
     virtual ~StaticConfinement(){};
 };
 
+/**
+ * @class StaticConfinementWithViscosity
+ * @brief Static confined boundary condition for viscous flows,
+ *        in which viscous_force_ is run after the inner viscous force.
+ */
+class StaticConfinementWithViscosity : public StaticConfinement
+{
+  public:
+    SimpleDynamics<StaticConfinementViscousForce> viscous_force_;
+
+    StaticConfinementWithViscosity(NearShapeSurface &near_surface);
+    virtual ~StaticConfinementWithViscosity(){};
+};
+
 } // namespace fluid_dynamics
 } // namespace SPH
 #endif // SHAPE_CONFINEMENT_H
\ No newline at end of file
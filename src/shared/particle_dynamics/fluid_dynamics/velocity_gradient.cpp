@@ -11,6 +11,9 @@ VelocityGradient<Contact<Wall>>::VelocityGradient(BaseContactRelation &wall_cont
 //=================================================================================================//
 void VelocityGradient<Contact<Wall>>::interaction(size_t index_i, Real dt)
 {
+    if (!*update_due_)
+        return;
+
     Matd vel_grad = Matd::Zero();
     const Vecd &distance_from_wall = distance_from_wall_[index_i];
     for (size_t k = 0; k < contact_configuration_.size(); ++k)
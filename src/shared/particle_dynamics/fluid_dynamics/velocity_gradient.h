@@ -39,6 +39,14 @@ namespace fluid_dynamics
 template <typename... InteractionTypes>
 class VelocityGradient;
 
+/**
+ * The velocity gradient is a derived variable shared by several dynamics,
+ * e.g. the shear-rate dependent viscosity and the Oldroyd-B stress.
+ * It is only computed again at a new stage, i.e. after the configuration,
+ * the particle states or the physical time has been changed,
+ * so that executing it before each of the dependent dynamics costs one neighbor loop per stage.
+ * The decision is taken by the inner part and shared with the wall contact part.
+ */
 template <class DataDelegationType>
 class VelocityGradient<DataDelegationType>
     : public LocalDynamics, public DataDelegationType
@@ -52,6 +60,8 @@ class VelocityGradient<DataDelegationType>
     Real *Vol_;
     Vecd *vel_;
     Matd *vel_grad_;
+    SingularVariable<UnsignedInt> *sv_update_due_;
+    UnsignedInt *update_due_;
 };
 
 template <class KernelCorrectionType>
@@ -61,11 +71,15 @@ class VelocityGradient<Inner<KernelCorrectionType>>
   public:
     explicit VelocityGradient(BaseInnerRelation &inner_relation);
     virtual ~VelocityGradient(){};
+    virtual void setupDynamics(Real dt = 0.0) override;
     void interaction(size_t index_i, Real dt = 0.0);
     void update(size_t index_i, Real dt = 0.0);
 
   protected:
     KernelCorrectionType kernel_correction_;
+    Real *physical_time_;
+    UnsignedInt configuration_version_, state_version_;
+    Real stage_time_;
 };
 using VelocityGradientInner = VelocityGradient<Inner<NoKernelCorrection>>;
 
@@ -13,16 +13,38 @@ VelocityGradient<DataDelegationType>::VelocityGradient(BaseRelationType &base_re
     : LocalDynamics(base_relation.getSPHBody()), DataDelegationType(base_relation),
       Vol_(this->particles_->template getVariableDataByName<Real>("VolumetricMeasure")),
       vel_(this->particles_->template getVariableDataByName<Vecd>("Velocity")),
-      vel_grad_(this->particles_->template registerStateVariable<Matd>("VelocityGradient")) {}
+      vel_grad_(this->particles_->template registerStateVariable<Matd>("VelocityGradient")),
+      sv_update_due_(this->particles_->template registerSingularVariable<UnsignedInt>(
+          "VelocityGradientUpdateDue", 1)),
+      update_due_(sv_update_due_->ValueAddress()) {}
 //=================================================================================================//
 template <class KernelCorrectionType>
 VelocityGradient<Inner<KernelCorrectionType>>::VelocityGradient(BaseInnerRelation &inner_relation)
     : VelocityGradient<DataDelegateInner>(inner_relation),
-      kernel_correction_(particles_) {}
+      kernel_correction_(particles_),
+      physical_time_(sph_system_.getSystemVariableDataByName<Real>("PhysicalTime")),
+      configuration_version_(std::numeric_limits<UnsignedInt>::max()),
+      state_version_(std::numeric_limits<UnsignedInt>::max()),
+      stage_time_(MaxReal) {}
+//=================================================================================================//
+template <class KernelCorrectionType>
+void VelocityGradient<Inner<KernelCorrectionType>>::setupDynamics(Real dt)
+{
+    UnsignedInt configuration_version = sph_body_.ConfigurationVersion();
+    UnsignedInt state_version = sph_body_.StateVersion();
+    sv_update_due_->setValue(configuration_version != configuration_version_ ||
+                             state_version != state_version_ || *physical_time_ != stage_time_);
+    configuration_version_ = configuration_version;
+    state_version_ = state_version;
+    stage_time_ = *physical_time_;
+}
 //=================================================================================================//
 template <class KernelCorrectionType>
 void VelocityGradient<Inner<KernelCorrectionType>>::interaction(size_t index_i, Real dt)
 {
+    if (!*update_due_)
+        return;
+
     Matd vel_grad = Matd::Zero();
     Neighborhood &inner_neighborhood = inner_configuration_[index_i];
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
@@ -38,6 +60,9 @@ void VelocityGradient<Inner<KernelCorrectionType>>::interaction(size_t index_i,
 template <class KernelCorrectionType>
 void VelocityGradient<Inner<KernelCorrectionType>>::update(size_t index_i, Real dt)
 {
+    if (!*update_due_)
+        return;
+
     vel_grad_[index_i] *= kernel_correction_(index_i);
 }
 //=================================================================================================//
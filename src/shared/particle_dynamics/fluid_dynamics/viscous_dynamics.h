@@ -88,6 +88,10 @@ class ViscousForce<Inner<>, ViscosityType, KernelCorrectionType>
     explicit ViscousForce(BaseInnerRelation &inner_relation);
     virtual ~ViscousForce(){};
     void interaction(size_t index_i, Real dt = 0.0);
+    /** for InteractionSymmetric */
+    void symmetricPrepare(size_t index_i, Real dt = 0.0);
+    void symmetricInteraction(size_t index_i, Real dt = 0.0);
+    void symmetricFinish(size_t index_i, Real dt = 0.0){};
 
   protected:
     ViscosityType mu_;
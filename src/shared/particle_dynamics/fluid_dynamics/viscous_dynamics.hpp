@@ -51,6 +51,35 @@ void ViscousForce<Inner<>, ViscosityType, KernelCorrectionType>::interaction(siz
 }
 //=================================================================================================//
 template <typename ViscosityType, class KernelCorrectionType>
+void ViscousForce<Inner<>, ViscosityType, KernelCorrectionType>::symmetricPrepare(size_t index_i, Real dt)
+{
+    viscous_force_[index_i] = Vecd::Zero();
+}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType>
+void ViscousForce<Inner<>, ViscosityType, KernelCorrectionType>::symmetricInteraction(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        if (index_j > index_i)
+        {
+            const Vecd &e_ij = inner_neighborhood.e_ij_[n];
+            Vecd vel_derivative = (vel_[index_i] - vel_[index_j]) /
+                                  (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
+            Vecd pair_force = e_ij.dot((kernel_correction_(index_i) + kernel_correction_(index_j)) * e_ij) *
+                              mu_(index_i, index_j) * vel_derivative *
+                              inner_neighborhood.dW_ij_[n] * Vol_[index_i] * Vol_[index_j];
+            force += pair_force;
+            viscous_force_[index_j] -= pair_force;
+        }
+    }
+    viscous_force_[index_i] += force;
+}
+//=================================================================================================//
+template <typename ViscosityType, class KernelCorrectionType>
 ViscousForce<Inner<AngularConservative>, ViscosityType, KernelCorrectionType>::
     ViscousForce(BaseInnerRelation &inner_relation)
     : ViscousForce<DataDelegateInner>(inner_relation),
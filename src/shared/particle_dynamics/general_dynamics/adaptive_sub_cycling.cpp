@@ -0,0 +1,76 @@
+#include "adaptive_sub_cycling.h"
+
+namespace SPH
+{
+//=================================================================================================//
+KernelSumDeviation::KernelSumDeviation(BaseInnerRelation &inner_relation)
+    : LocalDynamicsReduce<ReduceSum<Real>>(inner_relation.getSPHBody()),
+      DataDelegateInner(inner_relation),
+      W0_(sph_body_.sph_adaptation_->getKernel()->W0(ZeroVecd)),
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure"))
+{
+    quantity_name_ = "KernelSumDeviation";
+}
+//=================================================================================================//
+Real KernelSumDeviation::reduce(size_t index_i, Real dt)
+{
+    Real sigma = W0_ * Vol_[index_i];
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        sigma += inner_neighborhood.W_ij_[n] * Vol_[inner_neighborhood.j_[n]];
+    }
+    return ABS(sigma - 1.0);
+}
+//=================================================================================================//
+DisplacementSinceEvaluation::DisplacementSinceEvaluation(SPHBody &sph_body)
+    : LocalDynamicsReduce<ReduceMax>(sph_body),
+      pos_(particles_->getVariableDataByName<Vecd>("Position")),
+      pos_at_evaluation_(particles_->registerStateVariableFrom<Vecd>("PositionAtEvaluation", "Position"))
+{
+    particles_->addVariableToSort<Vecd>("PositionAtEvaluation");
+    quantity_name_ = "DisplacementSinceEvaluation";
+}
+//=================================================================================================//
+Real DisplacementSinceEvaluation::reduce(size_t index_i, Real dt)
+{
+    return (pos_[index_i] - pos_at_evaluation_[index_i]).norm();
+}
+//=================================================================================================//
+RecordPositionAtEvaluation::RecordPositionAtEvaluation(SPHBody &sph_body)
+    : LocalDynamics(sph_body),
+      pos_(particles_->getVariableDataByName<Vecd>("Position")),
+      pos_at_evaluation_(particles_->getVariableDataByName<Vecd>("PositionAtEvaluation")) {}
+//=================================================================================================//
+void RecordPositionAtEvaluation::update(size_t index_i, Real dt)
+{
+    pos_at_evaluation_[index_i] = pos_[index_i];
+}
+//=================================================================================================//
+AdaptiveSubCycling::AdaptiveSubCycling(BaseInnerRelation &inner_relation, UnsignedInt max_interval,
+                                       Real disorder_tolerance, Real displacement_ratio)
+    : max_interval_(SMAX(max_interval, UnsignedInt(1))), disorder_tolerance_(disorder_tolerance),
+      displacement_tolerance_(displacement_ratio *
+                              inner_relation.getSPHBody().sph_adaptation_->ReferenceSpacing()),
+      interval_(1), steps_since_evaluation_(0), disorder_metric_(0),
+      kernel_sum_deviation_(inner_relation),
+      displacement_since_evaluation_(inner_relation.getSPHBody()),
+      record_position_at_evaluation_(inner_relation.getSPHBody()) {}
+//=================================================================================================//
+bool AdaptiveSubCycling::isEvaluationStep()
+{
+    ++steps_since_evaluation_;
+    if (steps_since_evaluation_ >= interval_)
+        return true;
+    return displacement_since_evaluation_.exec() > displacement_tolerance_;
+}
+//=================================================================================================//
+void AdaptiveSubCycling::finishEvaluation()
+{
+    disorder_metric_ = kernel_sum_deviation_.exec();
+    interval_ = disorder_metric_ < disorder_tolerance_ ? SMIN(2 * interval_, max_interval_) : 1;
+    steps_since_evaluation_ = 0;
+    record_position_at_evaluation_.exec();
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,128 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	adaptive_sub_cycling.h
+ * @brief 	Evaluating particle regularization dynamics, such as transport velocity correction
+ * 			and density summation, only every k-th advection step when the particle distribution
+ * 			is regular, with k adapted from a particle-disorder metric.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef ADAPTIVE_SUB_CYCLING_H
+#define ADAPTIVE_SUB_CYCLING_H
+
+#include "base_general_dynamics.h"
+
+namespace SPH
+{
+/**
+ * @class KernelSumDeviation
+ * @brief Deviation of the volume-weighted kernel summation from unity,
+ * which vanishes for a regular particle distribution with full support.
+ * The stored kernel values of the neighborhood are used so that no kernel is evaluated.
+ */
+class KernelSumDeviation : public LocalDynamicsReduce<ReduceSum<Real>>, public DataDelegateInner
+{
+  public:
+    explicit KernelSumDeviation(BaseInnerRelation &inner_relation);
+    virtual ~KernelSumDeviation(){};
+
+    Real reduce(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Real W0_;
+    Real *Vol_;
+};
+
+/**
+ * @class DisplacementSinceEvaluation
+ * @brief The maximum particle displacement since the positions were recorded last time.
+ */
+class DisplacementSinceEvaluation : public LocalDynamicsReduce<ReduceMax>
+{
+  public:
+    explicit DisplacementSinceEvaluation(SPHBody &sph_body);
+    virtual ~DisplacementSinceEvaluation(){};
+
+    Real reduce(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Vecd *pos_, *pos_at_evaluation_;
+};
+
+/**
+ * @class RecordPositionAtEvaluation
+ * @brief Record the current particle positions for DisplacementSinceEvaluation.
+ */
+class RecordPositionAtEvaluation : public LocalDynamics
+{
+  public:
+    explicit RecordPositionAtEvaluation(SPHBody &sph_body);
+    virtual ~RecordPositionAtEvaluation(){};
+
+    void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    Vecd *pos_, *pos_at_evaluation_;
+};
+
+/**
+ * @class AdaptiveSubCycling
+ * @brief Decides whether the regularization dynamics are evaluated in the current advection step.
+ * After each evaluation, the averaged kernel-sum deviation doubles the interval (up to the maximum)
+ * when it is below the tolerance, and resets it to every step otherwise.
+ * As error monitor, the maximum displacement since the last evaluation forces
+ * an evaluation when it exceeds the given fraction of the reference particle spacing.
+ * Typical usage in the advection loop:
+ * 		if (sub_cycling.isEvaluationStep())
+ * 		{
+ * 			update_density_by_summation.exec();
+ * 			transport_velocity_correction.exec();
+ * 			sub_cycling.finishEvaluation();
+ * 		}
+ */
+class AdaptiveSubCycling
+{
+  public:
+    AdaptiveSubCycling(BaseInnerRelation &inner_relation, UnsignedInt max_interval = 8,
+                       Real disorder_tolerance = 0.01, Real displacement_ratio = 0.1);
+    virtual ~AdaptiveSubCycling(){};
+
+    bool isEvaluationStep();
+    void finishEvaluation();
+    UnsignedInt Interval() { return interval_; };
+    Real DisorderMetric() { return disorder_metric_; };
+
+  protected:
+    UnsignedInt max_interval_;
+    Real disorder_tolerance_;
+    Real displacement_tolerance_;
+    UnsignedInt interval_;
+    UnsignedInt steps_since_evaluation_;
+    Real disorder_metric_;
+    ReduceDynamics<Average<KernelSumDeviation>> kernel_sum_deviation_;
+    ReduceDynamics<DisplacementSinceEvaluation> displacement_since_evaluation_;
+    SimpleDynamics<RecordPositionAtEvaluation> record_position_at_evaluation_;
+};
+} // namespace SPH
+#endif // ADAPTIVE_SUB_CYCLING_H
@@ -29,6 +29,7 @@
 
 #pragma once
 
+#include "adaptive_sub_cycling.h"
 #include "all_domain_bounding.h"
 #include "all_surface_indication.h"
 #include "base_general_dynamics.h"
@@ -39,4 +40,6 @@
 #include "general_interpolation.h"
 #include "general_reduce.h"
 #include "kernel_correction.hpp"
-#include "particle_smoothing.hpp"
\ No newline at end of file
+#include "particle_smoothing.hpp"
+#include "state_sentinel.h"
+#include "time_averaged_fields.h"
\ No newline at end of file
@@ -20,6 +20,27 @@ GhostCreationFromMesh::GhostCreationFromMesh(RealBody &real_body, ANSYSMesh &ans
     each_boundary_type_with_all_ghosts_eij_.resize(50);
     each_boundary_type_contact_real_index_.resize(50);
     addGhostParticleAndSetInConfiguration();
+    flattenGhostMapping();
+}
+//=================================================================================================//
+void GhostCreationFromMesh::flattenGhostMapping()
+{
+    for (size_t boundary_type = 0; boundary_type != each_boundary_type_with_all_ghosts_index_.size(); ++boundary_type)
+    {
+        StdVec<size_t> &ghosts_index = each_boundary_type_with_all_ghosts_index_[boundary_type];
+        if (!ghosts_index.empty())
+        {
+            size_t begin = ghost_index_.size();
+            ghost_index_.insert(ghost_index_.end(), ghosts_index.begin(), ghosts_index.end());
+            contact_real_index_.insert(contact_real_index_.end(),
+                                       each_boundary_type_contact_real_index_[boundary_type].begin(),
+                                       each_boundary_type_contact_real_index_[boundary_type].end());
+            ghost_eij_.insert(ghost_eij_.end(),
+                              each_boundary_type_with_all_ghosts_eij_[boundary_type].begin(),
+                              each_boundary_type_with_all_ghosts_eij_[boundary_type].end());
+            boundary_type_ranges_.push_back(std::make_pair(boundary_type, IndexRange(begin, ghost_index_.size())));
+        }
+    }
 }
 //=================================================================================================//
 BoundaryConditionSetupInFVM::
@@ -35,6 +56,60 @@ BoundaryConditionSetupInFVM::
       ghost_bound_(ghost_creation.ghost_bound_),
       each_boundary_type_with_all_ghosts_index_(ghost_creation.each_boundary_type_with_all_ghosts_index_),
       each_boundary_type_with_all_ghosts_eij_(ghost_creation.each_boundary_type_with_all_ghosts_eij_),
-      each_boundary_type_contact_real_index_(ghost_creation.each_boundary_type_contact_real_index_) {}
+      each_boundary_type_contact_real_index_(ghost_creation.each_boundary_type_contact_real_index_),
+      ghost_index_(ghost_creation.ghost_index_), contact_real_index_(ghost_creation.contact_real_index_),
+      ghost_eij_(ghost_creation.ghost_eij_), boundary_type_ranges_(ghost_creation.boundary_type_ranges_) {}
+//=================================================================================================//
+void BoundaryConditionSetupInFVM::resetBoundaryConditions()
+{
+    for (const auto &[boundary_type, ghost_range] : boundary_type_ranges_)
+    {
+        // the boundary type is dispatched once for the whole loop
+        switch (boundary_type)
+        {
+        case 3: // this refer to the different types of wall boundary conditions
+            particle_for(ParallelPolicy(), ghost_range,
+                         [&](size_t k)
+                         {
+                             applyNonSlipWallBoundary(ghost_index_[k], contact_real_index_[k]);
+                             applyReflectiveWallBoundary(ghost_index_[k], contact_real_index_[k], ghost_eij_[k]);
+                         });
+            break;
+        case 4:
+            particle_for(ParallelPolicy(), ghost_range,
+                         [&](size_t k)
+                         { applyTopBoundary(ghost_index_[k], contact_real_index_[k]); });
+            break;
+        case 5:
+            particle_for(ParallelPolicy(), ghost_range,
+                         [&](size_t k)
+                         { applyPressureOutletBC(ghost_index_[k], contact_real_index_[k]); });
+            break;
+        case 7:
+            particle_for(ParallelPolicy(), ghost_range,
+                         [&](size_t k)
+                         { applySymmetryBoundary(ghost_index_[k], contact_real_index_[k], ghost_eij_[k]); });
+            break;
+        case 9:
+            particle_for(ParallelPolicy(), ghost_range,
+                         [&](size_t k)
+                         { applyFarFieldBoundary(ghost_index_[k]); });
+            break;
+        case 10:
+            particle_for(ParallelPolicy(), ghost_range,
+                         [&](size_t k)
+                         {
+                             applyGivenValueInletFlow(ghost_index_[k]);
+                             applyVelocityInletFlow(ghost_index_[k], contact_real_index_[k]);
+                         });
+            break;
+        case 36:
+            particle_for(ParallelPolicy(), ghost_range,
+                         [&](size_t k)
+                         { applyOutletBoundary(ghost_index_[k], contact_real_index_[k]); });
+            break;
+        }
+    }
+}
 //=================================================================================================//
 } // namespace SPH
@@ -54,12 +54,19 @@ class GhostCreationFromMesh : public LocalDynamics
     Vecd *pos_;
     Real *Vol_;
     void addGhostParticleAndSetInConfiguration();
+    /** gathers the ghost mapping into flat arrays sorted by boundary type */
+    void flattenGhostMapping();
 
   public:
     std::pair<size_t, size_t> &ghost_bound_;
     StdVec<StdVec<size_t>> each_boundary_type_with_all_ghosts_index_;
     StdVec<StdVec<Vecd>> each_boundary_type_with_all_ghosts_eij_;
     StdVec<StdVec<size_t>> each_boundary_type_contact_real_index_;
+    /** flat ghost mapping, computed once after the ghost creation */
+    StdVec<size_t> ghost_index_;
+    StdVec<size_t> contact_real_index_;
+    StdVec<Vecd> ghost_eij_;
+    StdVec<std::pair<size_t, IndexRange>> boundary_type_ranges_; /**< boundary type and its range in the flat arrays */
 };
 
 //----------------------------------------------------------------------
@@ -89,6 +96,10 @@ class BoundaryConditionSetupInFVM : public LocalDynamics, public DataDelegateInn
     StdVec<StdVec<size_t>> &each_boundary_type_with_all_ghosts_index_;
     StdVec<StdVec<Vecd>> &each_boundary_type_with_all_ghosts_eij_;
     StdVec<StdVec<size_t>> &each_boundary_type_contact_real_index_;
+    StdVec<size_t> &ghost_index_;
+    StdVec<size_t> &contact_real_index_;
+    StdVec<Vecd> &ghost_eij_;
+    StdVec<std::pair<size_t, IndexRange>> &boundary_type_ranges_;
 };
 } // namespace SPH
 #endif // FVM_GHOST_BOUNDARY_H
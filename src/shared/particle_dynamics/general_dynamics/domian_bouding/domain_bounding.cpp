@@ -16,52 +16,80 @@ PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::
       cell_linked_list_(real_body.getCellLinkedList()) {}
 //=================================================================================================//
 void PeriodicConditionUsingCellLinkedList::
-    PeriodicCellLinkedList::checkUpperBound(ListDataVector &cell_list_data, Real dt)
+    PeriodicCellLinkedList::insertImageNearUpperBound(size_t index_i, const Vecd &particle_position)
 {
-    for (size_t num = 0; num < cell_list_data.size(); ++num)
+    if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
+        particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
     {
-        Vecd particle_position = std::get<1>(cell_list_data[num]);
-        if (particle_position[axis_] < bounding_bounds_.second_[axis_] &&
-            particle_position[axis_] > (bounding_bounds_.second_[axis_] - cut_off_radius_max_))
-        {
-            Vecd translated_position = particle_position - periodic_translation_;
-            /** insert ghost particle to cell linked list */
-            mutex_cell_list_entry_.lock();
-            cell_linked_list_.InsertListDataEntry(cell_list_data[num].first, translated_position);
-            mutex_cell_list_entry_.unlock();
-        }
+        Vecd translated_position = particle_position - periodic_translation_;
+        /** insert ghost particle to cell linked list */
+        mutex_cell_list_entry_.lock();
+        cell_linked_list_.InsertListDataEntry(index_i, translated_position);
+        mutex_cell_list_entry_.unlock();
     }
 }
 //=================================================================================================//
 void PeriodicConditionUsingCellLinkedList::
-    PeriodicCellLinkedList::checkLowerBound(ListDataVector &cell_list_data, Real dt)
+    PeriodicCellLinkedList::insertImageNearLowerBound(size_t index_i, const Vecd &particle_position)
 {
-    for (size_t num = 0; num < cell_list_data.size(); ++num)
+    if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
+        particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
     {
-        Vecd particle_position = std::get<1>(cell_list_data[num]);
-        if (particle_position[axis_] > bounding_bounds_.first_[axis_] &&
-            particle_position[axis_] < (bounding_bounds_.first_[axis_] + cut_off_radius_max_))
-        {
-            Vecd translated_position = particle_position + periodic_translation_;
-            /** insert ghost particle to cell linked list */
-            mutex_cell_list_entry_.lock();
-            cell_linked_list_.InsertListDataEntry(cell_list_data[num].first, translated_position);
-            mutex_cell_list_entry_.unlock();
-        }
+        Vecd translated_position = particle_position + periodic_translation_;
+        /** insert ghost particle to cell linked list */
+        mutex_cell_list_entry_.lock();
+        cell_linked_list_.InsertListDataEntry(index_i, translated_position);
+        mutex_cell_list_entry_.unlock();
     }
 }
 //=================================================================================================//
+void PeriodicConditionUsingCellLinkedList::
+    PeriodicCellLinkedList::checkUpperBound(size_t index_i, Real dt)
+{
+    insertImageNearUpperBound(index_i, pos_[index_i]);
+}
+//=================================================================================================//
+void PeriodicConditionUsingCellLinkedList::
+    PeriodicCellLinkedList::checkLowerBound(size_t index_i, Real dt)
+{
+    insertImageNearLowerBound(index_i, pos_[index_i]);
+}
+//=================================================================================================//
 void PeriodicConditionUsingCellLinkedList::PeriodicCellLinkedList::exec(Real dt)
 {
     setupDynamics(dt);
-
+    // The real particles are listed by index, and their positions are those used for the build
+    // as this is carried out just after updating the cell linked list.
+    // The list data entries of the cells are the images inserted by the periodic conditions
+    // along other axes, which are imaged again here to obtain the corner images.
+    particle_for(execution::ParallelPolicy(), bound_cells_data_[0].first,
+                 [&](size_t i)
+                 { checkLowerBound(i, dt); });
     particle_for(execution::ParallelPolicy(), bound_cells_data_[0].second,
-                 [&](ListDataVector *cell_ist)
-                 { checkLowerBound(*cell_ist, dt); });
+                 [&](ListDataVector *cell_list_data)
+                 {
+                     for (const ListData &list_data : *cell_list_data)
+                         insertImageNearLowerBound(list_data.first, list_data.second);
+                 });
 
+    particle_for(execution::ParallelPolicy(), bound_cells_data_[1].first,
+                 [&](size_t i)
+                 { checkUpperBound(i, dt); });
     particle_for(execution::ParallelPolicy(), bound_cells_data_[1].second,
-                 [&](ListDataVector *cell_ist)
-                 { checkUpperBound(*cell_ist, dt); });
+                 [&](ListDataVector *cell_list_data)
+                 {
+                     for (const ListData &list_data : *cell_list_data)
+                         insertImageNearUpperBound(list_data.first, list_data.second);
+                 });
+}
+//=================================================================================================//
+PeriodicConditionUsingImageSearch::
+    PeriodicConditionUsingImageSearch(RealBody &real_body, PeriodicAlongAxis &periodic_box)
+    : BasePeriodicCondition<execution::ParallelPolicy>(real_body, periodic_box),
+      bounding_(bound_cells_data_, real_body, periodic_box)
+{
+    CellLinkedList &cell_linked_list = DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList());
+    cell_linked_list.setPeriodicAxis(periodic_box.getBoundingBox(), periodic_box.getAxis());
 }
 //=================================================================================================//
 } // namespace SPH
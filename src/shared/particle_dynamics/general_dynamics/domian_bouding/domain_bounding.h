@@ -148,8 +148,10 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
         std::mutex mutex_cell_list_entry_; /**< mutex exclusion for memory conflict */
         BaseCellLinkedList &cell_linked_list_;
 
-        virtual void checkLowerBound(ListDataVector &cell_list_data, Real dt = 0.0);
-        virtual void checkUpperBound(ListDataVector &cell_list_data, Real dt = 0.0);
+        virtual void checkLowerBound(size_t index_i, Real dt = 0.0) override;
+        virtual void checkUpperBound(size_t index_i, Real dt = 0.0) override;
+        void insertImageNearLowerBound(size_t index_i, const Vecd &particle_position);
+        void insertImageNearUpperBound(size_t index_i, const Vecd &particle_position);
 
       public:
         PeriodicCellLinkedList(StdVec<CellLists> &bound_cells_data,
@@ -166,5 +168,28 @@ class PeriodicConditionUsingCellLinkedList : public BasePeriodicCondition<execut
     PeriodicConditionUsingCellLinkedList(RealBody &real_body, PeriodicAlongAxis &periodic_box);
     virtual ~PeriodicConditionUsingCellLinkedList(){};
 };
+
+/**
+ * @class PeriodicConditionUsingImageSearch
+ * @brief The method imposing periodic boundary condition in an axis direction
+ *	without ghost particles or extra cell list entries.
+ *	The periodicity is handled by the neighbor search of the cell linked list,
+ *	which also searches the periodic images of the particles near the bounds,
+ *	so that several axes can be periodic at once.
+ *	Only the periodic bounding is carried out, before updating the cell linked list.
+ *	Note that the periodicity applies to all relations searching the cell linked list of this body.
+ *	Only the neighbor positions and displacements given by the relations are corrected,
+ *	so that dynamics taking position differences of the particles directly,
+ *	such as the classic elastic integration and porous media relaxation, are not supported.
+ *	The periodic domain should not be smaller than twice the search range.
+ */
+class PeriodicConditionUsingImageSearch : public BasePeriodicCondition<execution::ParallelPolicy>
+{
+  public:
+    PeriodicBounding bounding_;
+
+    PeriodicConditionUsingImageSearch(RealBody &real_body, PeriodicAlongAxis &periodic_box);
+    virtual ~PeriodicConditionUsingImageSearch(){};
+};
 } // namespace SPH
 #endif // DOMAIN_BOUNDING_H
@@ -12,7 +12,8 @@ namespace SPH
 CorrectInterpolationKernelWeights::
     CorrectInterpolationKernelWeights(BaseContactRelation &contact_relation)
     : LocalDynamics(contact_relation.getSPHBody()),
-      DataDelegateContact(contact_relation)
+      DataDelegateContact(contact_relation),
+      is_correction_due_(true), total_builds_at_last_correction_(0)
 {
     for (size_t k = 0; k != contact_particles_.size(); ++k)
     {
@@ -120,9 +120,112 @@ class ObservingAQuantity : public InteractionDynamics<BaseInterpolation<DataType
     virtual ~ObservingAQuantity(){};
 };
 
+/**
+ * @class BaseQuantitiesInterpolation
+ * @brief Base class for interpolating several variables together,
+ * so that the weights of a pair of particles are evaluated only once for all variables.
+ */
+template <typename... DataTypes>
+class BaseQuantitiesInterpolation : public LocalDynamics, public DataDelegateContact
+{
+  public:
+    using VariableNames = std::array<std::string, sizeof...(DataTypes)>;
+
+    explicit BaseQuantitiesInterpolation(BaseContactRelation &contact_relation, const VariableNames &variable_names)
+        : LocalDynamics(contact_relation.getSPHBody()), DataDelegateContact(contact_relation)
+    {
+        for (size_t k = 0; k != this->contact_particles_.size(); ++k)
+        {
+            contact_Vol_.push_back(contact_particles_[k]->template getVariableDataByName<Real>("VolumetricMeasure"));
+            contact_data_.push_back(getContactData(*contact_particles_[k], variable_names,
+                                                   std::index_sequence_for<DataTypes...>{}));
+        }
+    };
+    virtual ~BaseQuantitiesInterpolation(){};
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        std::tuple<DataTypes...> observed_quantities(ZeroData<DataTypes>::value...);
+        Real ttl_weight(0);
+
+        for (size_t k = 0; k < this->contact_configuration_.size(); ++k)
+        {
+            Real *Vol_k = contact_Vol_[k];
+            const std::tuple<DataTypes *...> &data_k = contact_data_[k];
+            Neighborhood &contact_neighborhood = (*this->contact_configuration_[k])[index_i];
+            for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+            {
+                size_t index_j = contact_neighborhood.j_[n];
+                Real weight_j = contact_neighborhood.W_ij_[n] * Vol_k[index_j];
+
+                accumulate(observed_quantities, data_k, weight_j, index_j, std::index_sequence_for<DataTypes...>{});
+                ttl_weight += weight_j;
+            }
+        }
+        assign(observed_quantities, ttl_weight + TinyReal, index_i, std::index_sequence_for<DataTypes...>{});
+    };
+
+  protected:
+    std::tuple<DiscreteVariable<DataTypes> *...> dv_interpolated_quantities_;
+    std::tuple<DataTypes *...> interpolated_quantities_;
+    StdVec<Real *> contact_Vol_;
+    StdVec<std::tuple<DataTypes *...>> contact_data_;
+
+    template <size_t... Is>
+    static std::tuple<DataTypes *...> getContactData(BaseParticles &contact_particles, const VariableNames &variable_names,
+                                                     std::index_sequence<Is...>)
+    {
+        return std::make_tuple(contact_particles.template getVariableDataByName<DataTypes>(variable_names[Is])...);
+    };
+
+    template <size_t... Is>
+    inline void accumulate(std::tuple<DataTypes...> &quantities, const std::tuple<DataTypes *...> &data,
+                           Real weight_j, size_t index_j, std::index_sequence<Is...>)
+    {
+        ((std::get<Is>(quantities) += weight_j * std::get<Is>(data)[index_j]), ...);
+    };
+
+    template <size_t... Is>
+    inline void assign(const std::tuple<DataTypes...> &quantities, Real ttl_weight, size_t index_i, std::index_sequence<Is...>)
+    {
+        ((std::get<Is>(interpolated_quantities_)[index_i] = std::get<Is>(quantities) / ttl_weight), ...);
+    };
+};
+
+/**
+ * @class ObservingQuantities
+ * @brief Observing several variables from contact bodies in one pass over the neighbors.
+ */
+template <typename... DataTypes>
+class ObservingQuantities : public InteractionDynamics<BaseQuantitiesInterpolation<DataTypes...>>
+{
+  public:
+    using VariableNames = typename BaseQuantitiesInterpolation<DataTypes...>::VariableNames;
+    using ObservationExecutionPolicy = execution::ParallelPolicy;
+
+    explicit ObservingQuantities(BaseContactRelation &contact_relation, const VariableNames &variable_names)
+        : InteractionDynamics<BaseQuantitiesInterpolation<DataTypes...>>(contact_relation, variable_names)
+    {
+        registerObservedQuantities(variable_names, std::index_sequence_for<DataTypes...>{});
+    };
+    virtual ~ObservingQuantities(){};
+
+  protected:
+    template <size_t... Is>
+    void registerObservedQuantities(const VariableNames &variable_names, std::index_sequence<Is...>)
+    {
+        this->dv_interpolated_quantities_ = std::make_tuple(
+            this->particles_->template registerStateVariableOnly<DataTypes>(variable_names[Is])...);
+        this->interpolated_quantities_ = std::make_tuple(
+            std::get<Is>(this->dv_interpolated_quantities_)->DataField()...);
+    };
+};
+
 /**
  * @class CorrectInterpolationKernelWeights
  * @brief  correct kernel weights for interpolation between general bodies
+ * As the kernel weights are corrected in place, the correction is applied only once
+ * after each build of the configuration, which may be reused with a reuse tolerance.
  * TODO: this formulation is not correct, need to be fixed.
  */
 class CorrectInterpolationKernelWeights : public LocalDynamics,
@@ -132,8 +235,18 @@ class CorrectInterpolationKernelWeights : public LocalDynamics,
     explicit CorrectInterpolationKernelWeights(BaseContactRelation &contact_relation);
     virtual ~CorrectInterpolationKernelWeights(){};
 
+    virtual void setupDynamics(Real dt = 0.0) override
+    {
+        size_t total_builds = getBodyRelation().TotalBuilds();
+        is_correction_due_ = total_builds != total_builds_at_last_correction_;
+        total_builds_at_last_correction_ = total_builds;
+    };
+
     inline void interaction(size_t index_i, Real dt = 0.0)
     {
+        if (!is_correction_due_)
+            return;
+
         Vecd weight_correction = Vecd::Zero();
         Matd local_configuration = Eps * Matd::Identity();
 
@@ -170,6 +283,8 @@ class CorrectInterpolationKernelWeights : public LocalDynamics,
 
   protected:
     StdVec<Real *> contact_Vol_;
+    bool is_correction_due_;
+    size_t total_builds_at_last_correction_;
 };
 } // namespace SPH
 #endif // GENERAL_INTERPOLATION_H
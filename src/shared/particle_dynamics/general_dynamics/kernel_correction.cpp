@@ -3,8 +3,18 @@
 namespace SPH
 {
 //=================================================================================================//
+void LinearGradientCorrectionMatrix<Inner<>>::setupDynamics(Real dt)
+{
+    UnsignedInt configuration_version = sph_body_.ConfigurationVersion();
+    sv_update_due_->setValue(configuration_version != configuration_version_at_last_update_);
+    configuration_version_at_last_update_ = configuration_version;
+}
+//=================================================================================================//
 void LinearGradientCorrectionMatrix<Inner<>>::interaction(size_t index_i, Real dt)
 {
+    if (!*update_due_)
+        return;
+
     Matd local_configuration = ZeroData<Matd>::value;
     const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
@@ -19,12 +29,10 @@ void LinearGradientCorrectionMatrix<Inner<>>::interaction(size_t index_i, Real d
 //=================================================================================================//
 void LinearGradientCorrectionMatrix<Inner<>>::update(size_t index_i, Real dt)
 {
-    Real det_sqr = SMAX(alpha_ - B_[index_i].determinant(), Real(0));
-    Matd B_T = B_[index_i].transpose(); //for Tikhonov regularization
-    Matd inverse = (B_T * B_[index_i] + SqrtEps * Matd::Identity()).inverse() * B_T;
-    Real weight1_ = B_[index_i].determinant() / (B_[index_i].determinant() + det_sqr);
-    Real weight2_ = det_sqr / (B_[index_i].determinant() + det_sqr);
-    B_[index_i] = weight1_ * inverse + weight2_ * Matd::Identity();
+    if (!*update_due_)
+        return;
+
+    B_[index_i] = regularizedCorrectionMatrix(B_[index_i], alpha_);
 }
 //=================================================================================================//
 LinearGradientCorrectionMatrix<Contact<>>::
@@ -40,6 +48,9 @@ LinearGradientCorrectionMatrix<Contact<>>::
 //=================================================================================================//
 void LinearGradientCorrectionMatrix<Contact<>>::interaction(size_t index_i, Real dt)
 {
+    if (!*update_due_)
+        return;
+
     Matd local_configuration = ZeroData<Matd>::value;
     for (size_t k = 0; k < contact_configuration_.size(); ++k)
     {
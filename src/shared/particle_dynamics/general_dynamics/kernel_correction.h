@@ -32,6 +32,7 @@
 #define KERNEL_CORRECTION_H
 
 #include "base_general_dynamics.h"
+#include "small_matrix_inverse.h"
 
 namespace SPH
 {
@@ -41,6 +42,12 @@ class LinearGradientCorrectionMatrix;
 // WKGC1 will be used for calculate the KGC matrix.
 // The difference between WKGC1 and WKGC2 can refer to https://doi.org/10.1016/j.cma.2023.116460
 
+/**
+ * The matrix is only computed again after a configuration of the body has been updated,
+ * e.g. it is computed once for Eulerian bodies and frozen configurations.
+ * The decision is taken by the inner part and shared with the contact parts of a complex correction,
+ * and the volumes are assumed to change only together with the configuration.
+ */
 template <class DataDelegationType>
 class LinearGradientCorrectionMatrix<DataDelegationType>
     : public LocalDynamics, public DataDelegationType
@@ -53,6 +60,8 @@ class LinearGradientCorrectionMatrix<DataDelegationType>
   protected:
     Real *Vol_;
     Matd *B_;
+    SingularVariable<UnsignedInt> *sv_update_due_;
+    UnsignedInt *update_due_;
 };
 
 template <>
@@ -63,13 +72,18 @@ class LinearGradientCorrectionMatrix<Inner<>>
 
   public:
     explicit LinearGradientCorrectionMatrix(BaseInnerRelation &inner_relation, Real alpha = Real(0))
-        : LinearGradientCorrectionMatrix<DataDelegateInner>(inner_relation), alpha_(alpha){};
+        : LinearGradientCorrectionMatrix<DataDelegateInner>(inner_relation), alpha_(alpha),
+          configuration_version_at_last_update_(std::numeric_limits<UnsignedInt>::max()){};
     template <typename BodyRelationType, typename FirstArg>
     explicit LinearGradientCorrectionMatrix(ConstructorArgs<BodyRelationType, FirstArg> parameters)
         : LinearGradientCorrectionMatrix(parameters.body_relation_, std::get<0>(parameters.others_)){};
     virtual ~LinearGradientCorrectionMatrix(){};
+    virtual void setupDynamics(Real dt = 0.0) override;
     void interaction(size_t index_i, Real dt = 0.0);
     void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    UnsignedInt configuration_version_at_last_update_;
 };
 using LinearGradientCorrectionMatrixInner = LinearGradientCorrectionMatrix<Inner<>>;
 
@@ -13,7 +13,10 @@ LinearGradientCorrectionMatrix<DataDelegationType>::
     : LocalDynamics(base_relation.getSPHBody()), DataDelegationType(base_relation),
       Vol_(this->particles_->template getVariableDataByName<Real>("VolumetricMeasure")),
       B_(this->particles_->template registerStateVariable<Matd>(
-          "LinearGradientCorrectionMatrix", IdentityMatrix<Matd>::value)) {}
+          "LinearGradientCorrectionMatrix", IdentityMatrix<Matd>::value)),
+      sv_update_due_(this->particles_->template registerSingularVariable<UnsignedInt>(
+          "LinearGradientCorrectionMatrixUpdateDue", 1)),
+      update_due_(sv_update_due_->ValueAddress()) {}
 //=================================================================================================//
 template <class DataDelegationType>
 template <class BaseRelationType>
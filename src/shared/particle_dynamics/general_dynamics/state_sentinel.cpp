@@ -0,0 +1,18 @@
+#include "state_sentinel.h"
+
+#include "base_body.h"
+
+namespace SPH
+{
+//=================================================================================================//
+StateSentinel::StateSentinel(SPHBody &sph_body)
+    : sv_velocity_bound_squared_(sph_body.getBaseParticles().registerSingularVariable<Real>(
+          "SentinelVelocityBoundSquared", MaxReal)),
+      sv_sentinel_flag_(sph_body.getBaseParticles().registerSingularVariable<UnsignedInt>("SentinelFlag", 0)) {}
+//=================================================================================================//
+void StateSentinel::setVelocityBound(Real velocity_bound)
+{
+    sv_velocity_bound_squared_->setValue(velocity_bound * velocity_bound);
+}
+//=================================================================================================//
+} // namespace SPH
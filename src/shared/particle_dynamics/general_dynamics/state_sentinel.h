@@ -0,0 +1,91 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	state_sentinel.h
+ * @brief 	A sentinel flag of a body which is raised by integration kernels
+ * 			when a particle state violates a given bound.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef STATE_SENTINEL_H
+#define STATE_SENTINEL_H
+
+#include "base_configuration_dynamics.h"
+#include "base_particles.hpp"
+
+namespace SPH
+{
+/**
+ * @class StateSentinelCheck
+ * @brief Checked on the freshly updated velocity within an integration kernel,
+ * so that no additional pass over the particles, as in VelocityBoundCheck, is required.
+ * The velocity bound is not set by default, i.e. only NaN and infinite velocities are detected.
+ */
+class StateSentinelCheck
+{
+  public:
+    template <class ExecutionPolicy>
+    StateSentinelCheck(const ExecutionPolicy &ex_policy, BaseParticles *particles)
+        : velocity_bound_squared_(particles->registerSingularVariable<Real>(
+                                               "SentinelVelocityBoundSquared", MaxReal)
+                                      ->DelegatedData(ex_policy)),
+          sentinel_flag_(particles->registerSingularVariable<UnsignedInt>("SentinelFlag", 0)
+                             ->DelegatedData(ex_policy)){};
+    explicit StateSentinelCheck(BaseParticles *particles)
+        : StateSentinelCheck(execution::par, particles){};
+
+    inline void check(const Vecd &vel)
+    {
+        // comparisons with NaN are false
+        if (!(vel.squaredNorm() <= *velocity_bound_squared_))
+        {
+            AtomicUnsignedIntRef<execution::ParallelPolicy>::type sentinel_flag(*sentinel_flag_);
+            sentinel_flag.store(1);
+        }
+    };
+
+  protected:
+    Real *velocity_bound_squared_;
+    UnsignedInt *sentinel_flag_;
+};
+
+/**
+ * @class StateSentinel
+ * @brief The host side of the sentinel flag of a body,
+ * which is read once per check instead of reducing over all particles.
+ */
+class StateSentinel
+{
+  public:
+    explicit StateSentinel(SPHBody &sph_body);
+    virtual ~StateSentinel(){};
+    void setVelocityBound(Real velocity_bound);
+    bool isTriggered() { return sv_sentinel_flag_->getValue() != 0; };
+    void reset() { sv_sentinel_flag_->setValue(0); };
+
+  protected:
+    SingularVariable<Real> *sv_velocity_bound_squared_;
+    SingularVariable<UnsignedInt> *sv_sentinel_flag_;
+};
+} // namespace SPH
+#endif // STATE_SENTINEL_H
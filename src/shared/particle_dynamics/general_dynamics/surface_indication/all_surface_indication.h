@@ -29,5 +29,6 @@
 
 #pragma once
 
+#include "narrow_band_surface.h"
 #include "smeared_surface_indication.h"
 #include "surface_indication.hpp"
@@ -0,0 +1,84 @@
+#include "narrow_band_surface.h"
+
+#include "base_particles.hpp"
+#include "particle_iterators.h"
+
+namespace SPH
+{
+//=================================================================================================//
+SurfaceNarrowBand::SurfaceNarrowBand(BaseInnerRelation &inner_relation, UnsignedInt buffer_layers)
+    : BodyPartByParticle(inner_relation.getSPHBody(), "SurfaceNarrowBand"),
+      buffer_layers_(buffer_layers), inner_configuration_(inner_relation.inner_configuration_),
+      indicator_(base_particles_.registerStateVariable<int>("Indicator")),
+      original_id_(base_particles_.ParticleOriginalIds()),
+      sorted_id_(base_particles_.ParticleSortedIds())
+{
+    base_particles_.addVariableToSort<int>("Indicator");
+    resetToAllParticles();
+}
+//=================================================================================================//
+void SurfaceNarrowBand::resetToAllParticles()
+{
+    size_t total_real_particles = base_particles_.TotalRealParticles();
+    body_part_particles_.resize(total_real_particles);
+    band_original_ids_.resize(total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        body_part_particles_[i] = i;
+        band_original_ids_[i] = original_id_[i];
+    }
+    is_in_band_.assign(base_particles_.ParticlesBound(), false);
+}
+//=================================================================================================//
+void SurfaceNarrowBand::updateNarrowBand()
+{
+    size_t total_real_particles = base_particles_.TotalRealParticles();
+    is_in_band_.assign(base_particles_.ParticlesBound(), false);
+
+    IndexVector front;
+    for (size_t k = 0; k != band_original_ids_.size(); ++k)
+    {
+        size_t index_i = sorted_id_[band_original_ids_[k]];
+        if (index_i < total_real_particles && indicator_[index_i] == 1 && !is_in_band_[index_i])
+        {
+            is_in_band_[index_i] = true;
+            front.push_back(index_i);
+        }
+    }
+
+    IndexVector band(front);
+    for (UnsignedInt layer = 0; layer != buffer_layers_; ++layer)
+    {
+        candidates_.clear();
+        particle_for(execution::par, front,
+                     [&](size_t index_i)
+                     {
+                         const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+                         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                         {
+                             size_t index_j = inner_neighborhood.j_[n];
+                             if (!is_in_band_[index_j])
+                                 candidates_.push_back(index_j);
+                         }
+                     });
+
+        front.clear();
+        for (size_t index_j : candidates_)
+        {
+            if (!is_in_band_[index_j])
+            {
+                is_in_band_[index_j] = true;
+                front.push_back(index_j);
+            }
+        }
+        band.insert(band.end(), front.begin(), front.end());
+    }
+
+    std::sort(band.begin(), band.end());
+    body_part_particles_.swap(band);
+    band_original_ids_.resize(body_part_particles_.size());
+    for (size_t k = 0; k != body_part_particles_.size(); ++k)
+        band_original_ids_[k] = original_id_[body_part_particles_[k]];
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,68 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	narrow_band_surface.h
+ * @brief 	A body part holding the particles within a narrow band around the free surface.
+ * Surface detection and surface tension only need to be computed in this band,
+ * so that the loops run over a compacted particle list instead of the whole body.
+ * @author	Xiangyu Hu
+ */
+#ifndef NARROW_BAND_SURFACE_H
+#define NARROW_BAND_SURFACE_H
+
+#include "base_body_part.h"
+#include "base_body_relation.h"
+
+namespace SPH
+{
+/**
+ * @class SurfaceNarrowBand
+ * @brief The band includes the surface particles indicated previously
+ * and a given number of neighbor layers around them.
+ * Initially, the band includes all particles so that the first surface indication is global.
+ * Since the band is built from the previous band (tracked by original particle ids),
+ * it is robust to particle sorting. Note that a surface appearing far away
+ * from the previous band, e.g. a new cavity, is only captured after resetToAllParticles().
+ * The band should be updated after each update of the inner configuration.
+ */
+class SurfaceNarrowBand : public BodyPartByParticle
+{
+  public:
+    SurfaceNarrowBand(BaseInnerRelation &inner_relation, UnsignedInt buffer_layers = 2);
+    virtual ~SurfaceNarrowBand(){};
+
+    void resetToAllParticles();
+    void updateNarrowBand();
+
+  protected:
+    UnsignedInt buffer_layers_;
+    ParticleConfiguration &inner_configuration_;
+    int *indicator_;
+    UnsignedInt *original_id_;
+    UnsignedInt *sorted_id_;
+    IndexVector band_original_ids_;
+    StdLargeVec<bool> is_in_band_;
+    ConcurrentIndexVector candidates_;
+};
+} // namespace SPH
+#endif // NARROW_BAND_SURFACE_H
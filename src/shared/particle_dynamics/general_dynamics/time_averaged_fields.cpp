@@ -0,0 +1,89 @@
+/**
+ * @file 	time_averaged_fields.cpp
+ * @brief 	Implementation of the running time-averaged statistics.
+ * @author	Xiangyu Hu
+ */
+
+#include "time_averaged_fields.h"
+
+namespace SPH
+{
+//=================================================================================================//
+BaseTimeAveragedFields::BaseTimeAveragedFields(SPHBody &sph_body, const StdVec<std::string> &scalar_names,
+                                               const StdVec<std::string> &vector_names)
+    : LocalDynamics(sph_body), scalar_names_(scalar_names), vector_names_(vector_names),
+      number_of_samples_(0), accumulated_weight_(0), sample_fraction_(1)
+{
+    for (const std::string &name : scalar_names_)
+        scalar_statistics_.push_back(registerFieldStatistics<Real>(name));
+    for (const std::string &name : vector_names_)
+        vector_statistics_.push_back(registerFieldStatistics<Vecd>(name));
+}
+//=================================================================================================//
+template <typename DataType>
+BaseTimeAveragedFields::FieldStatistics<DataType>
+BaseTimeAveragedFields::registerFieldStatistics(const std::string &name)
+{
+    FieldStatistics<DataType> statistics;
+    DataType **fields[4] = {&statistics.mean_, &statistics.variance_, &statistics.minimum_, &statistics.maximum_};
+    const std::string suffixes[4] = {"Mean", "Variance", "Minimum", "Maximum"};
+    for (size_t i = 0; i != 4; ++i)
+    {
+        *fields[i] = particles_->registerStateVariable<DataType>(name + suffixes[i]);
+        particles_->addVariableToWrite<DataType>(name + suffixes[i]);
+    }
+    return statistics;
+}
+//=================================================================================================//
+void BaseTimeAveragedFields::setupDynamics(Real dt)
+{
+    Real sample_weight = dt > 0.0 ? dt : Real(1);
+    number_of_samples_++;
+    accumulated_weight_ += sample_weight;
+    sample_fraction_ = sample_weight / accumulated_weight_;
+}
+//=================================================================================================//
+void BaseTimeAveragedFields::resetStatistics()
+{
+    number_of_samples_ = 0;
+    accumulated_weight_ = 0;
+    sample_fraction_ = 1;
+}
+//=================================================================================================//
+TimeAveragedFields::TimeAveragedFields(SPHBody &sph_body, const StdVec<std::string> &scalar_names,
+                                       const StdVec<std::string> &vector_names)
+    : BaseTimeAveragedFields(sph_body, scalar_names, vector_names)
+{
+    const std::string suffixes[4] = {"Mean", "Variance", "Minimum", "Maximum"};
+    for (const std::string &name : scalar_names_)
+    {
+        scalars_.push_back(particles_->getVariableDataByName<Real>(name));
+        for (const std::string &suffix : suffixes)
+            particles_->addVariableToSort<Real>(name + suffix);
+    }
+    for (const std::string &name : vector_names_)
+    {
+        vectors_.push_back(particles_->getVariableDataByName<Vecd>(name));
+        for (const std::string &suffix : suffixes)
+            particles_->addVariableToSort<Vecd>(name + suffix);
+    }
+}
+//=================================================================================================//
+ObservedTimeAveragedFields::
+    ObservedTimeAveragedFields(BaseContactRelation &contact_relation, const StdVec<std::string> &scalar_names,
+                               const StdVec<std::string> &vector_names)
+    : BaseTimeAveragedFields(contact_relation.getSPHBody(), scalar_names, vector_names),
+      DataDelegateContact(contact_relation),
+      contact_scalars_(scalar_names.size()), contact_vectors_(vector_names.size())
+{
+    for (size_t k = 0; k != contact_particles_.size(); ++k)
+    {
+        contact_Vol_.push_back(contact_particles_[k]->getVariableDataByName<Real>("VolumetricMeasure"));
+        for (size_t l = 0; l != scalar_names_.size(); ++l)
+            contact_scalars_[l].push_back(contact_particles_[k]->getVariableDataByName<Real>(scalar_names_[l]));
+        for (size_t l = 0; l != vector_names_.size(); ++l)
+            contact_vectors_[l].push_back(contact_particles_[k]->getVariableDataByName<Vecd>(vector_names_[l]));
+    }
+}
+//=================================================================================================//
+} // namespace SPH
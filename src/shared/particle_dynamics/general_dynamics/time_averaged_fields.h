@@ -0,0 +1,201 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	time_averaged_fields.h
+ * @brief 	Running time-averaged statistics of particle variables,
+ * 			accumulated in place during the simulation instead of from output snapshots.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef TIME_AVERAGED_FIELDS_H
+#define TIME_AVERAGED_FIELDS_H
+
+#include "base_general_dynamics.h"
+
+namespace SPH
+{
+/**
+ * @class BaseTimeAveragedFields
+ * @brief Accumulates the running mean, variance and extrema of scalar and vector variables.
+ * @details The statistics of a variable, e.g. "Pressure", are the particle variables
+ * "PressureMean", "PressureVariance", "PressureMinimum" and "PressureMaximum",
+ * which are component-wise for vectors and are added to the variables to write.
+ * The samples are weighted by the time step given by exec(dt), so that varying advection steps
+ * are accounted for, while a zero time step gives equal weights.
+ * The mean and variance are updated by the weighted incremental algorithm (West 1979).
+ */
+class BaseTimeAveragedFields : public LocalDynamics
+{
+  public:
+    BaseTimeAveragedFields(SPHBody &sph_body, const StdVec<std::string> &scalar_names,
+                           const StdVec<std::string> &vector_names);
+    virtual ~BaseTimeAveragedFields(){};
+    virtual void setupDynamics(Real dt = 0.0) override;
+    /** restart the averaging, e.g. after the initial transient */
+    void resetStatistics();
+    size_t NumberOfSamples() { return number_of_samples_; };
+    Real AccumulatedWeight() { return accumulated_weight_; };
+
+  protected:
+    template <typename DataType>
+    struct FieldStatistics
+    {
+        DataType *mean_;
+        DataType *variance_;
+        DataType *minimum_;
+        DataType *maximum_;
+    };
+    StdVec<std::string> scalar_names_, vector_names_;
+    StdVec<FieldStatistics<Real>> scalar_statistics_;
+    StdVec<FieldStatistics<Vecd>> vector_statistics_;
+    size_t number_of_samples_;
+    Real accumulated_weight_;
+    Real sample_fraction_; /**< weight of the current sample over the accumulated weight */
+
+    template <typename DataType>
+    FieldStatistics<DataType> registerFieldStatistics(const std::string &name);
+
+    inline void accumulate(FieldStatistics<Real> &statistics, size_t index_i, Real value)
+    {
+        if (number_of_samples_ == 1)
+        {
+            statistics.mean_[index_i] = value;
+            statistics.variance_[index_i] = 0.0;
+            statistics.minimum_[index_i] = value;
+            statistics.maximum_[index_i] = value;
+            return;
+        }
+        Real deviation = value - statistics.mean_[index_i];
+        statistics.mean_[index_i] += sample_fraction_ * deviation;
+        statistics.variance_[index_i] = (Real(1) - sample_fraction_) *
+                                        (statistics.variance_[index_i] + sample_fraction_ * deviation * deviation);
+        statistics.minimum_[index_i] = SMIN(statistics.minimum_[index_i], value);
+        statistics.maximum_[index_i] = SMAX(statistics.maximum_[index_i], value);
+    };
+
+    inline void accumulate(FieldStatistics<Vecd> &statistics, size_t index_i, const Vecd &value)
+    {
+        if (number_of_samples_ == 1)
+        {
+            statistics.mean_[index_i] = value;
+            statistics.variance_[index_i] = Vecd::Zero();
+            statistics.minimum_[index_i] = value;
+            statistics.maximum_[index_i] = value;
+            return;
+        }
+        Vecd deviation = value - statistics.mean_[index_i];
+        statistics.mean_[index_i] += sample_fraction_ * deviation;
+        statistics.variance_[index_i] = (Real(1) - sample_fraction_) *
+                                        (statistics.variance_[index_i] + sample_fraction_ * deviation.cwiseProduct(deviation));
+        statistics.minimum_[index_i] = statistics.minimum_[index_i].cwiseMin(value);
+        statistics.maximum_[index_i] = statistics.maximum_[index_i].cwiseMax(value);
+    };
+};
+
+/**
+ * @class TimeAveragedFields
+ * @brief Lagrangian statistics, i.e. following the particles of the body.
+ * All variables are updated in a single pass, e.g. by SimpleDynamics<TimeAveragedFields>.
+ * The statistics are sorted with the particles.
+ */
+class TimeAveragedFields : public BaseTimeAveragedFields
+{
+  public:
+    TimeAveragedFields(SPHBody &sph_body, const StdVec<std::string> &scalar_names,
+                       const StdVec<std::string> &vector_names = {});
+    virtual ~TimeAveragedFields(){};
+
+    inline void update(size_t index_i, Real dt = 0.0)
+    {
+        for (size_t l = 0; l != scalar_statistics_.size(); ++l)
+            accumulate(scalar_statistics_[l], index_i, scalars_[l][index_i]);
+        for (size_t l = 0; l != vector_statistics_.size(); ++l)
+            accumulate(vector_statistics_[l], index_i, vectors_[l][index_i]);
+    };
+
+  protected:
+    StdVec<Real *> scalars_;
+    StdVec<Vecd *> vectors_;
+};
+
+/**
+ * @class ObservedTimeAveragedFields
+ * @brief Eulerian statistics at fixed probes, e.g. the particles of an observer body
+ * placed at the points of a mesh, from the variables of the contact bodies.
+ * The values at a probe are interpolated as by ObservingAQuantity and accumulated
+ * in the same pass, e.g. by InteractionDynamics<ObservedTimeAveragedFields>.
+ */
+class ObservedTimeAveragedFields : public BaseTimeAveragedFields, public DataDelegateContact
+{
+  public:
+    ObservedTimeAveragedFields(BaseContactRelation &contact_relation, const StdVec<std::string> &scalar_names,
+                               const StdVec<std::string> &vector_names = {});
+    virtual ~ObservedTimeAveragedFields(){};
+
+    inline void interaction(size_t index_i, Real dt = 0.0)
+    {
+        Real ttl_weight = totalWeight(index_i) + TinyReal;
+        for (size_t l = 0; l != scalar_statistics_.size(); ++l)
+            accumulate(scalar_statistics_[l], index_i, interpolate(index_i, contact_scalars_[l]) / ttl_weight);
+        for (size_t l = 0; l != vector_statistics_.size(); ++l)
+            accumulate(vector_statistics_[l], index_i, interpolate(index_i, contact_vectors_[l]) / ttl_weight);
+    };
+
+  protected:
+    StdVec<Real *> contact_Vol_;
+    StdVec<StdVec<Real *>> contact_scalars_; /**< for each variable, the data of all contact bodies */
+    StdVec<StdVec<Vecd *>> contact_vectors_;
+
+    inline Real totalWeight(size_t index_i)
+    {
+        Real ttl_weight(0);
+        for (size_t k = 0; k < contact_configuration_.size(); ++k)
+        {
+            Real *Vol_k = contact_Vol_[k];
+            Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+            for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+                ttl_weight += contact_neighborhood.W_ij_[n] * Vol_k[contact_neighborhood.j_[n]];
+        }
+        return ttl_weight;
+    };
+
+    template <typename DataType>
+    inline DataType interpolate(size_t index_i, const StdVec<DataType *> &contact_data)
+    {
+        DataType weighted_sum = ZeroData<DataType>::value;
+        for (size_t k = 0; k < contact_configuration_.size(); ++k)
+        {
+            Real *Vol_k = contact_Vol_[k];
+            DataType *data_k = contact_data[k];
+            Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
+            for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
+            {
+                size_t index_j = contact_neighborhood.j_[n];
+                weighted_sum += contact_neighborhood.W_ij_[n] * Vol_k[index_j] * data_k[index_j];
+            }
+        }
+        return weighted_sum;
+    };
+};
+} // namespace SPH
+#endif // TIME_AVERAGED_FIELDS_H
@@ -274,6 +274,9 @@ struct ReduceSum
 {
     ReturnType reference_ = ZeroData<ReturnType>::value;
     ReturnType operator()(const ReturnType &x, const ReturnType &y) const { return x + y; };
+    /** for summing in the accumulated type of the mixed-precision build */
+    template <typename AccumulatedDataType>
+    AccumulatedDataType operator()(const AccumulatedDataType &x, const AccumulatedDataType &y) const { return x + y; };
 };
 
 struct ReduceMax
@@ -323,5 +326,18 @@ struct ReduceUpperBound
         return upper_bound;
     };
 };
+
+template <typename VectorType>
+struct ReduceComponentwiseMax
+{
+    VectorType reference_ = MinReal * VectorType::Ones();
+    VectorType operator()(const VectorType &x, const VectorType &y) const
+    {
+        VectorType upper_bound;
+        for (int i = 0; i < upper_bound.size(); ++i)
+            upper_bound[i] = SMAX(x[i], y[i]);
+        return upper_bound;
+    };
+};
 } // namespace SPH
 #endif // PARTICLE_FUNCTORS_H
@@ -31,6 +31,7 @@
 
 #include "base_data_package.h"
 #include "execution.h"
+#include "loop_partitioner.h"
 #include "sphinxsys_containers.h"
 
 #include <numeric>
@@ -64,7 +65,7 @@ template <class LocalDynamicsFunction>
 inline void particle_for(const ParallelPolicy &par, const IndexRange &particles_range,
                          const LocalDynamicsFunction &local_dynamics_function)
 {
-    parallel_for(
+    arena_parallel_for(
         particles_range,
         [&](const IndexRange &r)
         {
@@ -91,7 +92,7 @@ template <class LocalDynamicsFunction>
 inline void particle_for(const ParallelPolicy &par, const IndexVector &body_part_particles,
                          const LocalDynamicsFunction &local_dynamics_function)
 {
-    parallel_for(
+    arena_parallel_for(
         IndexRange(0, body_part_particles.size()),
         [&](const IndexRange &r)
         {
@@ -111,7 +112,7 @@ inline void particle_for(const SequencedPolicy &seq, const ConcurrentCellLists &
 {
     for (size_t i = 0; i != body_part_cells.size(); ++i)
     {
-        ConcurrentIndexVector &particle_indexes = *body_part_cells[i];
+        const CellParticles &particle_indexes = *body_part_cells[i];
         for (size_t num = 0; num < particle_indexes.size(); ++num)
         {
             local_dynamics_function(particle_indexes[num]);
@@ -123,13 +124,13 @@ template <class LocalDynamicsFunction>
 inline void particle_for(const ParallelPolicy &par, const ConcurrentCellLists &body_part_cells,
                          const LocalDynamicsFunction &local_dynamics_function)
 {
-    parallel_for(
+    arena_parallel_for(
         IndexRange(0, body_part_cells.size()),
         [&](const IndexRange &r)
         {
             for (size_t i = r.begin(); i < r.end(); ++i)
             {
-                ConcurrentIndexVector &particle_indexes = *body_part_cells[i];
+                const CellParticles &particle_indexes = *body_part_cells[i];
                 for (size_t num = 0; num < particle_indexes.size(); ++num)
                 {
                     local_dynamics_function(particle_indexes[num]);
@@ -153,7 +154,7 @@ template <class LocalDynamicsFunction>
 inline void particle_for(const ParallelPolicy &par, const DataListsInCells &body_part_cells,
                          const LocalDynamicsFunction &local_dynamics_function)
 {
-    parallel_for(
+    arena_parallel_for(
         IndexRange(0, body_part_cells.size()),
         [&](const IndexRange &r)
         {
@@ -165,6 +166,81 @@ inline void particle_for(const ParallelPolicy &par, const DataListsInCells &body
         ap);
 };
 
+/**
+ * Iterators with the partitioner state owned by a dynamics.
+ * Only the parallel policy makes use of the partitioner, others fall back to the iterators above.
+ */
+template <class ExecutionPolicy, typename DynamicsRange, class LocalDynamicsFunction>
+inline void particle_for(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
+                         const LocalDynamicsFunction &local_dynamics_function, LoopPartitioner &loop_partitioner)
+{
+    particle_for(execution_policy, dynamics_range, local_dynamics_function);
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelPolicy &par, const IndexRange &particles_range,
+                         const LocalDynamicsFunction &local_dynamics_function, LoopPartitioner &loop_partitioner)
+{
+    loop_partitioner.parallelFor(
+        particles_range,
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                local_dynamics_function(i);
+            }
+        });
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelPolicy &par, const IndexVector &body_part_particles,
+                         const LocalDynamicsFunction &local_dynamics_function, LoopPartitioner &loop_partitioner)
+{
+    loop_partitioner.parallelFor(
+        IndexRange(0, body_part_particles.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                local_dynamics_function(body_part_particles[i]);
+            }
+        });
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelPolicy &par, const ConcurrentCellLists &body_part_cells,
+                         const LocalDynamicsFunction &local_dynamics_function, LoopPartitioner &loop_partitioner)
+{
+    loop_partitioner.parallelFor(
+        IndexRange(0, body_part_cells.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                const CellParticles &particle_indexes = *body_part_cells[i];
+                for (size_t num = 0; num < particle_indexes.size(); ++num)
+                {
+                    local_dynamics_function(particle_indexes[num]);
+                }
+            }
+        });
+};
+
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelPolicy &par, const DataListsInCells &body_part_cells,
+                         const LocalDynamicsFunction &local_dynamics_function, LoopPartitioner &loop_partitioner)
+{
+    loop_partitioner.parallelFor(
+        IndexRange(0, body_part_cells.size()),
+        [&](const IndexRange &r)
+        {
+            for (size_t i = r.begin(); i < r.end(); ++i)
+            {
+                local_dynamics_function(body_part_cells[i]);
+            }
+        });
+};
+
 template <class ExecutionPolicy, typename DynamicsRange, class ReturnType,
           typename Operation, class LocalDynamicsFunction>
 void particle_reduce(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
@@ -183,11 +259,12 @@ inline ReturnType particle_reduce(const SequencedPolicy &seq, const IndexRange &
                                   ReturnType temp, Operation &&operation,
                                   const LocalDynamicsFunction &local_dynamics_function)
 {
+    AccumulatedType<ReturnType> sum = temp;
     for (size_t i = particles_range.begin(); i < particles_range.end(); ++i)
     {
-        temp = operation(temp, local_dynamics_function(i));
+        sum = operation(sum, AccumulatedType<ReturnType>(local_dynamics_function(i)));
     }
-    return temp;
+    return ReturnType(sum);
 }
 
 template <class ReturnType, typename Operation, class LocalDynamicsFunction>
@@ -195,19 +272,32 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexRange &p
                                   ReturnType temp, Operation &&operation,
                                   const LocalDynamicsFunction &local_dynamics_function)
 {
-    return parallel_reduce(
+    return ReturnType(arena_parallel_reduce(
         particles_range,
-        temp, [&](const IndexRange &r, ReturnType temp0) -> ReturnType
+        AccumulatedType<ReturnType>(temp), [&](const IndexRange &r, AccumulatedType<ReturnType> temp0) -> AccumulatedType<ReturnType>
         {
 				for (size_t i = r.begin(); i != r.end(); ++i)
 				{
-					temp0 = operation(temp0, local_dynamics_function(i));
+					temp0 = operation(temp0, AccumulatedType<ReturnType>(local_dynamics_function(i)));
 				}
 				return temp0; },
-        [&](const ReturnType &x, const ReturnType &y) -> ReturnType
+        [&](const AccumulatedType<ReturnType> &x, const AccumulatedType<ReturnType> &y) -> AccumulatedType<ReturnType>
         {
             return operation(x, y);
-        });
+        }));
+};
+/**
+ * Reduce into a value address, which is given by the delegated data of a singular variable
+ * so that the reduced value may stay on the device for device execution policies.
+ */
+template <class ExecutionPolicy, typename DynamicsRange, class ReturnType,
+          typename Operation, class LocalDynamicsFunction>
+inline void particle_reduce(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
+                            ReturnType temp, Operation &&operation,
+                            const LocalDynamicsFunction &local_dynamics_function, ReturnType *result)
+{
+    *result = particle_reduce(execution_policy, dynamics_range, temp,
+                              std::forward<Operation>(operation), local_dynamics_function);
 };
 /**
  * BodypartByParticle-wise reduce iterators (for sequential and parallel computing).
@@ -217,11 +307,12 @@ inline ReturnType particle_reduce(const SequencedPolicy &seq, const IndexVector
                                   ReturnType temp, Operation &&operation,
                                   const LocalDynamicsFunction &local_dynamics_function)
 {
+    AccumulatedType<ReturnType> sum = temp;
     for (size_t i = 0; i < body_part_particles.size(); ++i)
     {
-        temp = operation(temp, local_dynamics_function(body_part_particles[i]));
+        sum = operation(sum, AccumulatedType<ReturnType>(local_dynamics_function(body_part_particles[i])));
     }
-    return temp;
+    return ReturnType(sum);
 }
 
 template <class ReturnType, typename Operation, class LocalDynamicsFunction>
@@ -229,21 +320,78 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexVector &
                                   ReturnType temp, Operation &&operation,
                                   const LocalDynamicsFunction &local_dynamics_function)
 {
-    return parallel_reduce(
+    return ReturnType(arena_parallel_reduce(
         IndexRange(0, body_part_particles.size()),
-        temp,
-        [&](const IndexRange &r, ReturnType temp0) -> ReturnType
+        AccumulatedType<ReturnType>(temp),
+        [&](const IndexRange &r, AccumulatedType<ReturnType> temp0) -> AccumulatedType<ReturnType>
         {
             for (size_t n = r.begin(); n != r.end(); ++n)
             {
-                temp0 = operation(temp0, local_dynamics_function(body_part_particles[n]));
+                temp0 = operation(temp0, AccumulatedType<ReturnType>(local_dynamics_function(body_part_particles[n])));
             }
             return temp0;
         },
-        [&](const ReturnType &x, const ReturnType &y) -> ReturnType
+        [&](const AccumulatedType<ReturnType> &x, const AccumulatedType<ReturnType> &y) -> AccumulatedType<ReturnType>
         {
             return operation(x, y);
-        });
+        }));
+};
+/**
+ * Reduce iterators with the partitioner state owned by a dynamics.
+ */
+template <class ExecutionPolicy, typename DynamicsRange, class ReturnType,
+          typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ExecutionPolicy &execution_policy, const DynamicsRange &dynamics_range,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function,
+                                  LoopPartitioner &loop_partitioner)
+{
+    return particle_reduce(execution_policy, dynamics_range, temp,
+                           std::forward<Operation>(operation), local_dynamics_function);
+};
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexRange &particles_range,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function,
+                                  LoopPartitioner &loop_partitioner)
+{
+    return ReturnType(loop_partitioner.parallelReduce(
+        particles_range, AccumulatedType<ReturnType>(temp),
+        [&](const IndexRange &r, AccumulatedType<ReturnType> temp0) -> AccumulatedType<ReturnType>
+        {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                temp0 = operation(temp0, AccumulatedType<ReturnType>(local_dynamics_function(i)));
+            }
+            return temp0;
+        },
+        [&](const AccumulatedType<ReturnType> &x, const AccumulatedType<ReturnType> &y) -> AccumulatedType<ReturnType>
+        {
+            return operation(x, y);
+        }));
+};
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ParallelPolicy &par, const IndexVector &body_part_particles,
+                                  ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function,
+                                  LoopPartitioner &loop_partitioner)
+{
+    return ReturnType(loop_partitioner.parallelReduce(
+        IndexRange(0, body_part_particles.size()), AccumulatedType<ReturnType>(temp),
+        [&](const IndexRange &r, AccumulatedType<ReturnType> temp0) -> AccumulatedType<ReturnType>
+        {
+            for (size_t n = r.begin(); n != r.end(); ++n)
+            {
+                temp0 = operation(temp0, AccumulatedType<ReturnType>(local_dynamics_function(body_part_particles[n])));
+            }
+            return temp0;
+        },
+        [&](const AccumulatedType<ReturnType> &x, const AccumulatedType<ReturnType> &y) -> AccumulatedType<ReturnType>
+        {
+            return operation(x, y);
+        }));
 };
 /**
  * BodypartByCell-wise reduce iterators (for sequential and parallel computing).
@@ -253,16 +401,17 @@ inline ReturnType particle_reduce(const SequencedPolicy &seq, const ConcurrentCe
                                   ReturnType temp, Operation &&operation,
                                   const LocalDynamicsFunction &local_dynamics_function)
 {
+    AccumulatedType<ReturnType> sum = temp;
     for (size_t i = 0; i != body_part_cells.size(); ++i)
     {
-        ConcurrentIndexVector &particle_indexes = *body_part_cells[i];
+        const CellParticles &particle_indexes = *body_part_cells[i];
         for (size_t num = 0; num < particle_indexes.size(); ++num)
         {
-            temp = operation(temp, local_dynamics_function(particle_indexes[num]));
+            sum = operation(sum, AccumulatedType<ReturnType>(local_dynamics_function(particle_indexes[num])));
         }
     }
 
-    return temp;
+    return ReturnType(sum);
 }
 
 template <class ReturnType, typename Operation, class LocalDynamicsFunction>
@@ -270,23 +419,23 @@ inline ReturnType particle_reduce(const ParallelPolicy &par, const ConcurrentCel
                                   ReturnType temp, Operation &&operation,
                                   const LocalDynamicsFunction &local_dynamics_function)
 {
-    return parallel_reduce(
+    return ReturnType(arena_parallel_reduce(
         IndexRange(0, body_part_cells.size()),
-        temp,
-        [&](const IndexRange &r, ReturnType temp0) -> ReturnType
+        AccumulatedType<ReturnType>(temp),
+        [&](const IndexRange &r, AccumulatedType<ReturnType> temp0) -> AccumulatedType<ReturnType>
         {
             for (size_t i = r.begin(); i != r.end(); ++i)
             {
-                ConcurrentIndexVector &particle_indexes = *body_part_cells[i];
+                const CellParticles &particle_indexes = *body_part_cells[i];
                 for (size_t num = 0; num < particle_indexes.size(); ++num)
                 {
-                    temp0 = operation(temp0, local_dynamics_function(particle_indexes[num]));
+                    temp0 = operation(temp0, AccumulatedType<ReturnType>(local_dynamics_function(particle_indexes[num])));
                 }
             }
             return temp0;
         },
-        [&](const ReturnType &x, const ReturnType &y) -> ReturnType
-        { return operation(x, y); });
+        [&](const AccumulatedType<ReturnType> &x, const AccumulatedType<ReturnType> &y) -> AccumulatedType<ReturnType>
+        { return operation(x, y); }));
 }
 
 template <typename T, typename Op>
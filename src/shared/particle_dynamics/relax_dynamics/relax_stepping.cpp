@@ -53,7 +53,7 @@ void RelaxationResidue<Contact<>>::interaction(size_t index_i, Real dt)
 RelaxationScaling::RelaxationScaling(SPHBody &sph_body)
     : LocalDynamicsReduce<ReduceMax>(sph_body),
       residue_(particles_->getVariableDataByName<Vecd>("ZeroOrderResidue")),
-      h_ref_(sph_body.sph_adaptation_->ReferenceSmoothingLength()) {}
+      h_ref_(sph_body.sph_adaptation_->ReferenceSmoothingLength()), max_residue_(0.0) {}
 //=================================================================================================//
 Real RelaxationScaling::reduce(size_t index_i, Real dt)
 {
@@ -62,6 +62,7 @@ Real RelaxationScaling::reduce(size_t index_i, Real dt)
 //=================================================================================================//
 Real RelaxationScaling::outputResult(Real reduced_value)
 {
+    max_residue_ = reduced_value;
     return 0.0625 * h_ref_ / (reduced_value + TinyReal);
 }
 //=================================================================================================//
@@ -96,5 +97,147 @@ void UpdateSmoothingLengthRatioByShape::update(size_t index_i, Real dt_square)
     Vol_[index_i] = pow(local_spacing, Dimensions);
 }
 //=================================================================================================//
+RelaxationDriver::RelaxationDriver(StdVec<BaseRelaxationStep *> relaxation_steps,
+                                   size_t max_iterations, size_t check_interval)
+    : relaxation_steps_(relaxation_steps), max_iterations_(max_iterations),
+      check_interval_(check_interval), absolute_tolerance_(1.0e-3), relative_tolerance_(0.01),
+      step_scaling_(1.0), max_residue_(MaxReal) {}
+//=================================================================================================//
+void RelaxationDriver::setTolerances(Real absolute_tolerance, Real relative_tolerance)
+{
+    absolute_tolerance_ = absolute_tolerance;
+    relative_tolerance_ = relative_tolerance;
+}
+//=================================================================================================//
+Real RelaxationDriver::currentMaxResidue()
+{
+    Real max_residue = 0.0;
+    for (BaseRelaxationStep *relaxation_step : relaxation_steps_)
+    {
+        max_residue = SMAX(max_residue, relaxation_step->MaxResidue());
+    }
+    return max_residue;
+}
+//=================================================================================================//
+bool RelaxationDriver::checkTermination(Real max_residue, Real &checked_residue, Real &step_scaling)
+{
+    const Real min_step_scaling = 0.125;
+    if (max_residue < absolute_tolerance_)
+        return true;
+
+    if (max_residue > checked_residue)
+    {
+        // backtracking, terminated as stagnated if the step can not be reduced anymore
+        if (step_scaling <= min_step_scaling)
+            return true;
+        step_scaling = SMAX(Real(0.5) * step_scaling, min_step_scaling);
+    }
+    else
+    {
+        if (max_residue > (1.0 - relative_tolerance_) * checked_residue)
+            return true;
+        step_scaling = SMIN(Real(2.0) * step_scaling, Real(1.0));
+    }
+    checked_residue = max_residue;
+    return false;
+}
+//=================================================================================================//
+size_t RelaxationDriver::exec()
+{
+    TickCount t0 = TickCount::now();
+    Real checked_residue = MaxReal;
+    size_t ite = 0;
+    while (ite < max_iterations_)
+    {
+        for (BaseRelaxationStep *relaxation_step : relaxation_steps_)
+        {
+            relaxation_step->setStepScaling(step_scaling_);
+            relaxation_step->exec();
+        }
+        ite++;
+
+        if (ite % check_interval_ == 0)
+        {
+            max_residue_ = currentMaxResidue();
+            std::cout << std::fixed << std::setprecision(9) << "Relaxation steps N = " << ite
+                      << ", maximum residue = " << max_residue_ << ", step scaling = " << step_scaling_ << "\n";
+
+            if (checkTermination(max_residue_, checked_residue, step_scaling_))
+                break;
+        }
+    }
+
+    max_residue_ = currentMaxResidue();
+    Real elapsed_seconds = (TickCount::now() - t0).seconds();
+    std::cout << "Relaxation finished after " << ite << " steps with maximum residue " << max_residue_
+              << ", " << Real(ite) / (elapsed_seconds + TinyReal) << " steps per second." << std::endl;
+    return ite;
+}
+//=================================================================================================//
+ConcurrentRelaxationDriver::
+    ConcurrentRelaxationDriver(StdVec<BaseRelaxationStep *> relaxation_steps,
+                               size_t max_iterations, size_t check_interval)
+    : RelaxationDriver(relaxation_steps, max_iterations, check_interval),
+      step_scalings_(relaxation_steps.size(), 1.0), checked_residues_(relaxation_steps.size(), MaxReal),
+      iterations_(relaxation_steps.size(), 0), is_terminated_(relaxation_steps.size(), false) {}
+//=================================================================================================//
+size_t ConcurrentRelaxationDriver::exec()
+{
+    TickCount t0 = TickCount::now();
+    StdVec<size_t> active_steps;
+    for (size_t k = 0; k != relaxation_steps_.size(); ++k)
+    {
+        if (!is_terminated_[k])
+            active_steps.push_back(k);
+    }
+
+    size_t ite = 0;
+    while (ite < max_iterations_ && !active_steps.empty())
+    {
+        arena_parallel_for(
+            IndexRange(0, active_steps.size(), 1),
+            [&](const IndexRange &r)
+            {
+                for (size_t n = r.begin(); n != r.end(); ++n)
+                {
+                    size_t k = active_steps[n];
+                    relaxation_steps_[k]->setStepScaling(step_scalings_[k]);
+                    relaxation_steps_[k]->exec();
+                    iterations_[k]++;
+                }
+            },
+            tbb::simple_partitioner());
+        ite++;
+
+        if (ite % check_interval_ == 0)
+        {
+            StdVec<size_t> continued_steps;
+            for (size_t k : active_steps)
+            {
+                Real max_residue = relaxation_steps_[k]->MaxResidue();
+                std::cout << std::fixed << std::setprecision(9) << "Relaxation step " << k << ": N = " << ite
+                          << ", maximum residue = " << max_residue << ", step scaling = " << step_scalings_[k] << "\n";
+                is_terminated_[k] = checkTermination(max_residue, checked_residues_[k], step_scalings_[k]);
+                if (is_terminated_[k])
+                {
+                    std::cout << "Relaxation step " << k << " finished after " << iterations_[k] << " steps.\n";
+                }
+                else
+                {
+                    continued_steps.push_back(k);
+                }
+            }
+            active_steps = continued_steps;
+        }
+    }
+
+    max_residue_ = currentMaxResidue();
+    Real elapsed_seconds = (TickCount::now() - t0).seconds();
+    std::cout << "Concurrent relaxation of " << relaxation_steps_.size() << " steps finished after " << ite
+              << " iterations with maximum residue " << max_residue_ << ", "
+              << Real(ite) / (elapsed_seconds + TinyReal) << " iterations per second." << std::endl;
+    return ite;
+}
+//=================================================================================================//
 } // namespace relax_dynamics
 } // namespace SPH
@@ -121,10 +121,13 @@ class RelaxationScaling : public LocalDynamicsReduce<ReduceMax>
     virtual ~RelaxationScaling(){};
     Real reduce(size_t index_i, Real dt = 0.0);
     virtual Real outputResult(Real reduced_value);
+    /** maximum residue norm found by the last reduction */
+    Real MaxResidue() { return max_residue_; };
 
   protected:
     Vecd *residue_;
     Real h_ref_;
+    Real max_residue_;
 };
 
 /**
@@ -159,8 +162,25 @@ class UpdateSmoothingLengthRatioByShape : public LocalDynamics
     void update(size_t index_i, Real dt = 0.0);
 };
 
+/**
+ * @class BaseRelaxationStep
+ * @brief Interface of relaxation steps monitored by RelaxationDriver.
+ */
+class BaseRelaxationStep : public BaseDynamics<void>
+{
+  public:
+    BaseRelaxationStep() : BaseDynamics<void>(), step_scaling_(1.0){};
+    virtual ~BaseRelaxationStep(){};
+    /** maximum residue norm of the last step, non-dimensionalized by the reference smoothing length */
+    virtual Real MaxResidue() = 0;
+    void setStepScaling(Real step_scaling) { step_scaling_ = step_scaling; };
+
+  protected:
+    Real step_scaling_; /**< additional scaling of the position update, 1 by default */
+};
+
 template <class RelaxationResidueType>
-class RelaxationStep : public BaseDynamics<void>
+class RelaxationStep : public BaseRelaxationStep
 {
   public:
     template <typename FirstArg, typename... OtherArgs>
@@ -168,6 +188,7 @@ class RelaxationStep : public BaseDynamics<void>
     virtual ~RelaxationStep(){};
     SimpleDynamics<ShapeSurfaceBounding> &SurfaceBounding() { return surface_bounding_; };
     virtual void exec(Real dt = 0.0) override;
+    virtual Real MaxResidue() override;
 
   protected:
     RealBody &real_body_;
@@ -179,6 +200,62 @@ class RelaxationStep : public BaseDynamics<void>
     SimpleDynamics<ShapeSurfaceBounding> surface_bounding_;
 };
 
+/**
+ * @class RelaxationDriver
+ * @brief Runs relaxation steps until the maximum residue converges instead of a fixed count.
+ * The residue is checked every check interval. The relaxation is terminated when
+ * the residue is below the absolute tolerance, or when it has stagnated, i.e.
+ * decreased by less than the relative tolerance during the last check interval.
+ * If the residue grows, the step is scaled back as in a backtracking line search,
+ * and recovered gradually afterwards.
+ */
+class RelaxationDriver
+{
+  public:
+    explicit RelaxationDriver(StdVec<BaseRelaxationStep *> relaxation_steps,
+                              size_t max_iterations = 2000, size_t check_interval = 50);
+    virtual ~RelaxationDriver(){};
+    void setTolerances(Real absolute_tolerance, Real relative_tolerance);
+    /** returns the number of iterations carried out */
+    virtual size_t exec();
+    Real MaxResidue() { return max_residue_; };
+
+  protected:
+    StdVec<BaseRelaxationStep *> relaxation_steps_;
+    size_t max_iterations_, check_interval_;
+    Real absolute_tolerance_, relative_tolerance_;
+    Real step_scaling_, max_residue_;
+
+    Real currentMaxResidue();
+    /** adapts the step scaling from the residue at a check and returns true if the relaxation is terminated */
+    bool checkTermination(Real max_residue, Real &checked_residue, Real &step_scaling);
+};
+
+/**
+ * @class ConcurrentRelaxationDriver
+ * @brief Relaxes independent bodies, one relaxation step for each, in a single loop.
+ * The steps are executed concurrently as tasks, as ConcurrentGroup does,
+ * so that the particle loops of small bodies share the thread pool.
+ * The convergence of each step is checked separately with its own step scaling,
+ * and a converged step is no longer executed while the others continue.
+ * The bodies should not be coupled by contact relations.
+ */
+class ConcurrentRelaxationDriver : public RelaxationDriver
+{
+  public:
+    explicit ConcurrentRelaxationDriver(StdVec<BaseRelaxationStep *> relaxation_steps,
+                                        size_t max_iterations = 2000, size_t check_interval = 50);
+    virtual ~ConcurrentRelaxationDriver(){};
+    /** returns the number of iterations of the step relaxed longest */
+    virtual size_t exec() override;
+    size_t Iterations(size_t step_index) { return iterations_[step_index]; };
+
+  protected:
+    StdVec<Real> step_scalings_, checked_residues_;
+    StdVec<size_t> iterations_;
+    StdVec<bool> is_terminated_;
+};
+
 using RelaxationStepInner = RelaxationStep<RelaxationResidue<Inner<>>>;
 using RelaxationStepLevelSetCorrectionInner = RelaxationStep<RelaxationResidue<Inner<LevelSetCorrection>>>;
 using RelaxationStepComplex = RelaxationStep<ComplexInteraction<RelaxationResidue<Inner<>, Contact<>>>>;
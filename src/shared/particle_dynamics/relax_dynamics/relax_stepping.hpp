@@ -26,7 +26,7 @@ template <class RelaxationResidueType>
 template <typename FirstArg, typename... OtherArgs>
 RelaxationStep<RelaxationResidueType>::
     RelaxationStep(FirstArg &&first_arg, OtherArgs &&...other_args)
-    : BaseDynamics<void>(),
+    : BaseRelaxationStep(),
       real_body_(DynamicCast<RealBody>(this, first_arg.getSPHBody())),
       body_relations_(real_body_.getBodyRelations()),
       relaxation_residue_(first_arg, std::forward<OtherArgs>(other_args)...),
@@ -44,10 +44,16 @@ void RelaxationStep<RelaxationResidueType>::exec(Real dt)
     }
     relaxation_residue_.exec();
     Real scaling = relaxation_scaling_.exec();
-    position_relaxation_.exec(scaling);
+    position_relaxation_.exec(step_scaling_ * scaling);
     surface_bounding_.exec();
 }
 //=================================================================================================//
+template <class RelaxationResidueType>
+Real RelaxationStep<RelaxationResidueType>::MaxResidue()
+{
+    return relaxation_scaling_.MaxResidue() * real_body_.sph_adaptation_->ReferenceSmoothingLength();
+}
+//=================================================================================================//
 } // namespace relax_dynamics
 } // namespace SPH
 #endif // RELAX_STEPPING_HPP
@@ -36,6 +36,9 @@
 #include "general_solid_dynamics.h"
 #include "inelastic_dynamics.h"
 #include "loading_dynamics.h"
+#include "porous_media_dynamics.h"
+#include "quasi_static_dynamics.h"
+#include "rigid_body_dynamics.h"
 #include "solid_dynamics_variable.h"
 #include "thin_structure_dynamics.h"
 #include "thin_structure_math.h"
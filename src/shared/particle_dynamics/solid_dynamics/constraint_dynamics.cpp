@@ -106,5 +106,126 @@ void ConstrainSolidBodyMassCenter::update(size_t index_i, Real dt)
     vel_[index_i] -= velocity_correction_;
 }
 //=================================================================================================//
+LevelSetShapeMotionBySimBody::
+    LevelSetShapeMotionBySimBody(LevelSetShape &level_set_shape, SimTK::MultibodySystem &MBsystem,
+                                 SimTK::MobilizedBody &mobod, SimTK::RungeKuttaMersonIntegrator &integ)
+    : level_set_shape_(level_set_shape), MBsystem_(MBsystem), mobod_(mobod), integ_(integ)
+{
+    const SimTK::State *state = &integ_.getState();
+    MBsystem_.realize(*state, SimTK::Stage::Position);
+    initial_origin_location_ = SimTKToEigen(mobod_.getBodyOriginLocation(*state));
+}
+//=================================================================================================//
+void LevelSetShapeMotionBySimBody::exec()
+{
+    const SimTK::State *state = &integ_.getState();
+    MBsystem_.realize(*state, SimTK::Stage::Position);
+    Mat3d rotation = SimTKToEigen(mobod_.getBodyRotation(*state));
+    Vec3d translation = SimTKToEigen(mobod_.getBodyOriginLocation(*state)) - rotation * initial_origin_location_;
+    level_set_shape_.setRigidMotion(Transform(Rotation(degradeToMatd(rotation)), degradeToVecd(translation)));
+}
+//=================================================================================================//
+SimBodyCoupling::SimBodyCoupling(SimTK::MultibodySystem &MBsystem, SimTK::RungeKuttaMersonIntegrator &integ)
+    : MBsystem_(MBsystem), integ_(integ) {}
+//=================================================================================================//
+void SimBodyCoupling::addCoupledBody(SPHBody &sph_body, SimTK::MobilizedBody &mobod)
+{
+    BaseParticles &particles = sph_body.getBaseParticles();
+    IndexVector particle_indices(particles.TotalRealParticles());
+    std::iota(particle_indices.begin(), particle_indices.end(), 0);
+    addCoupledParticles(particles, particle_indices, mobod);
+}
+//=================================================================================================//
+void SimBodyCoupling::addCoupledBody(BodyPartByParticle &body_part, SimTK::MobilizedBody &mobod)
+{
+    addCoupledParticles(body_part.getSPHBody().getBaseParticles(), body_part.LoopRange(), mobod);
+}
+//=================================================================================================//
+void SimBodyCoupling::addCoupledParticles(BaseParticles &particles, const IndexVector &particle_indices,
+                                          SimTK::MobilizedBody &mobod)
+{
+    CoupledBody coupled_body;
+    coupled_body.mobod_ = &mobod;
+    coupled_body.particle_indices_ = particle_indices;
+    coupled_body.pos_ = particles.getVariableDataByName<Vecd>("Position");
+    coupled_body.pos0_ = particles.registerStateVariableFrom<Vecd>("InitialPosition", "Position");
+    coupled_body.vel_ = particles.registerStateVariable<Vecd>("Velocity");
+    coupled_body.n_ = particles.getVariableDataByName<Vecd>("NormalDirection");
+    coupled_body.n0_ = particles.registerStateVariableFrom<Vecd>("InitialNormalDirection", "NormalDirection");
+    coupled_body.acc_ = particles.registerStateVariable<Vecd>("Acceleration");
+    coupled_body.force_ = particles.registerStateVariable<Vecd>("Force");
+    coupled_body.force_prior_ = particles.getVariableDataByName<Vecd>("ForcePrior");
+
+    const SimTK::State &state = integ_.getState();
+    MBsystem_.realize(state, SimTK::Stage::Acceleration);
+    coupled_body.simbody_state_.updateFromMobilizedBody(mobod, state);
+    coupled_body.simbody_state_.initial_origin_location_ = coupled_body.simbody_state_.origin_location_;
+    coupled_bodies_.push_back(coupled_body);
+    total_forces_.push_back(ZeroData<SimTK::SpatialVec>::value);
+}
+//=================================================================================================//
+void SimBodyCoupling::updateStates()
+{
+    const SimTK::State &state = integ_.getState();
+    MBsystem_.realize(state, SimTK::Stage::Acceleration);
+    for (CoupledBody &coupled_body : coupled_bodies_)
+    {
+        coupled_body.simbody_state_.updateFromMobilizedBody(*coupled_body.mobod_, state);
+    }
+}
+//=================================================================================================//
+void SimBodyCoupling::applyForces(SimTK::Force::DiscreteForces &discrete_forces)
+{
+    particle_for(execution::par, IndexRange(0, coupled_bodies_.size()),
+                 [&](size_t k)
+                 {
+                     CoupledBody &coupled_body = coupled_bodies_[k];
+                     Vec3d origin_location = coupled_body.simbody_state_.origin_location_;
+                     total_forces_[k] = particle_reduce(
+                         execution::par, coupled_body.particle_indices_, ZeroData<SimTK::SpatialVec>::value,
+                         ReduceSum<SimTK::SpatialVec>(),
+                         [&](size_t i) -> SimTK::SpatialVec
+                         {
+                             Vecd force = coupled_body.force_[i] + coupled_body.force_prior_[i];
+                             SimTKVec3 force_from_particle = EigenToSimTK(upgradeToVec3d(force));
+                             SimTKVec3 displacement =
+                                 EigenToSimTK(Vec3d(upgradeToVec3d(coupled_body.pos_[i]) - origin_location));
+                             SimTKVec3 torque_from_particle = SimTK::cross(displacement, force_from_particle);
+                             return SimTK::SpatialVec(torque_from_particle, force_from_particle);
+                         });
+                 });
+
+    SimTK::State &state_for_update = integ_.updAdvancedState();
+    discrete_forces.clearAllBodyForces(state_for_update);
+    for (size_t k = 0; k != coupled_bodies_.size(); ++k)
+    {
+        // several body parts may be coupled to the same mobilized body
+        SimTK::MobilizedBody &mobod = *coupled_bodies_[k].mobod_;
+        discrete_forces.setOneBodyForce(state_for_update, mobod,
+                                        discrete_forces.getOneBodyForce(state_for_update, mobod) + total_forces_[k]);
+    }
+}
+//=================================================================================================//
+void SimBodyCoupling::constrainBodies()
+{
+    particle_for(execution::par, IndexRange(0, coupled_bodies_.size()),
+                 [&](size_t k)
+                 {
+                     CoupledBody &coupled_body = coupled_bodies_[k];
+                     particle_for(execution::par, coupled_body.particle_indices_,
+                                  [&](size_t i)
+                                  {
+                                      Vec3d pos, vel, acc, n;
+                                      coupled_body.simbody_state_.findStationLocationVelocityAndAccelerationInGround(
+                                          upgradeToVec3d(coupled_body.pos0_[i]), upgradeToVec3d(coupled_body.n0_[i]),
+                                          pos, vel, acc, n);
+                                      coupled_body.pos_[i] = degradeToVecd(pos);
+                                      coupled_body.vel_[i] = degradeToVecd(vel);
+                                      coupled_body.acc_[i] = degradeToVecd(acc);
+                                      coupled_body.n_[i] = degradeToVecd(n);
+                                  });
+                 });
+}
+//=================================================================================================//
 } // namespace solid_dynamics
 } // namespace SPH
@@ -36,6 +36,7 @@
 #include "elastic_solid.h"
 #include "general_constraint.h"
 #include "general_reduce.h"
+#include "level_set_shape.h"
 #include "solid_body.h"
 
 namespace SPH
@@ -181,6 +182,16 @@ struct SimbodyState
                                angular_velocity_.cross(temp_velocity);
         normalInGround = rotation_ * initial_normal;
     };
+
+    void updateFromMobilizedBody(const SimTK::MobilizedBody &mobod, const SimTK::State &state)
+    {
+        origin_location_ = SimTKToEigen(mobod.getBodyOriginLocation(state));
+        origin_velocity_ = SimTKToEigen(mobod.getBodyOriginVelocity(state));
+        origin_acceleration_ = SimTKToEigen(mobod.getBodyOriginAcceleration(state));
+        angular_velocity_ = SimTKToEigen(mobod.getBodyAngularVelocity(state));
+        angular_acceleration_ = SimTKToEigen(mobod.getBodyAngularAcceleration(state));
+        rotation_ = SimTKToEigen(mobod.getBodyRotation(state));
+    };
 };
 
 /**
@@ -210,6 +221,27 @@ class ConstraintBySimBody : public MotionConstraint<DynamicsIdentifier>
 using ConstraintBodyBySimBody = ConstraintBySimBody<SPHBody>;
 using ConstraintBodyPartBySimBody = ConstraintBySimBody<BodyPartByParticle>;
 
+/**
+ * @class LevelSetShapeMotionBySimBody
+ * @brief Set the rigid motion of a level set shape from the motion computed from Simbody,
+ *        so that the level set built in the initial configuration is reused for the moving body.
+ */
+class LevelSetShapeMotionBySimBody
+{
+  public:
+    LevelSetShapeMotionBySimBody(LevelSetShape &level_set_shape, SimTK::MultibodySystem &MBsystem,
+                                 SimTK::MobilizedBody &mobod, SimTK::RungeKuttaMersonIntegrator &integ);
+    virtual ~LevelSetShapeMotionBySimBody(){};
+    void exec();
+
+  protected:
+    LevelSetShape &level_set_shape_;
+    SimTK::MultibodySystem &MBsystem_;
+    SimTK::MobilizedBody &mobod_;
+    SimTK::RungeKuttaMersonIntegrator &integ_;
+    Vec3d initial_origin_location_;
+};
+
 /**
  * @class TotalForceForSimBody
  * @brief Compute the force acting on the solid body part
@@ -237,6 +269,48 @@ class TotalForceForSimBody
 };
 using TotalForceOnBodyForSimBody = TotalForceForSimBody<SPHBody>;
 using TotalForceOnBodyPartForSimBody = TotalForceForSimBody<BodyPartByParticle>;
+
+/**
+ * @class SimBodyCoupling
+ * @brief Batched coupling between many bodies or body parts and the mobilized bodies of one multibody system.
+ * The system is realized once per sub-step and the states of all mobilized bodies are cached.
+ * The total forces on all coupled bodies are obtained in one parallel loop and
+ * the cached rigid motions are applied to all coupled particles in parallel.
+ * A typical sub-step is applyForces, integ.stepBy(dt), updateStates and constrainBodies,
+ * so that the forces use the states cached at the end of the previous sub-step.
+ */
+class SimBodyCoupling
+{
+  public:
+    SimBodyCoupling(SimTK::MultibodySystem &MBsystem, SimTK::RungeKuttaMersonIntegrator &integ);
+    virtual ~SimBodyCoupling(){};
+    void addCoupledBody(SPHBody &sph_body, SimTK::MobilizedBody &mobod);
+    void addCoupledBody(BodyPartByParticle &body_part, SimTK::MobilizedBody &mobod);
+    /** realize the present state once and cache the states of all mobilized bodies */
+    void updateStates();
+    /** total forces from all coupled bodies set to the discrete forces on the advanced state */
+    void applyForces(SimTK::Force::DiscreteForces &discrete_forces);
+    /** rigid motions from the cached states applied to all coupled particles */
+    void constrainBodies();
+    StdVec<SimTK::SpatialVec> &TotalForces() { return total_forces_; };
+
+  protected:
+    struct CoupledBody
+    {
+        SimTK::MobilizedBody *mobod_;
+        IndexVector particle_indices_;
+        Vecd *pos_, *pos0_, *vel_, *n_, *n0_, *acc_, *force_, *force_prior_;
+        SimbodyState simbody_state_;
+    };
+
+    SimTK::MultibodySystem &MBsystem_;
+    SimTK::RungeKuttaMersonIntegrator &integ_;
+    StdVec<CoupledBody> coupled_bodies_;
+    StdVec<SimTK::SpatialVec> total_forces_;
+
+    void addCoupledParticles(BaseParticles &particles, const IndexVector &particle_indices,
+                             SimTK::MobilizedBody &mobod);
+};
 } // namespace solid_dynamics
 } // namespace SPH
 #endif // CONSTRAINT_DYNAMICS_H
\ No newline at end of file
@@ -54,6 +54,8 @@ void RepulsionForce<Contact<>>::interaction(size_t index_i, Real dt)
     Vecd force = Vecd::Zero();
     for (size_t k = 0; k < contact_configuration_.size(); ++k)
     {
+        if (!getBodyRelation().isContactActive(k))
+            continue;
         Vecd force_k = Vecd::Zero();
         Real *contact_repulsion_facto_k = contact_repulsion_factor_[k];
         Real *Vol_k = contact_Vol_[k];
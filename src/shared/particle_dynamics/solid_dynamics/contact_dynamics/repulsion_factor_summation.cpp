@@ -35,6 +35,8 @@ void RepulsionFactorSummation<Contact<>>::interaction(size_t index_i, Real dt)
     Real sigma = 0.0;
     for (size_t k = 0; k < contact_configuration_.size(); ++k)
     {
+        if (!getBodyRelation().isContactActive(k))
+            continue;
         Neighborhood &contact_neighborhood = (*contact_configuration_[k])[index_i];
 
         for (size_t n = 0; n != contact_neighborhood.current_size_; ++n)
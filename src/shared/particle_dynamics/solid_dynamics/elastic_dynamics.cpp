@@ -49,9 +49,23 @@ void UpdateElasticNormalDirection::update(size_t index_i, Real dt)
     phi_[index_i] = phi0_[index_i] / (current_normal.norm() + SqrtEps); // todo: check this
 }
 //=================================================================================================//
+ReferenceGradientPrecomputation::
+    ReferenceGradientPrecomputation(BaseInnerRelation &inner_relation)
+    : LocalDynamics(inner_relation.getSPHBody()), BaseDynamics<void>(),
+      inner_relation_(inner_relation),
+      Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
+      B_(particles_->getVariableDataByName<Matd>("LinearGradientCorrectionMatrix")) {}
+//=================================================================================================//
+void ReferenceGradientPrecomputation::exec(Real dt)
+{
+    inner_relation_.compact_reference_gradient_.buildFrom(
+        inner_relation_.inner_configuration_, particles_->TotalRealParticles(), Vol_, B_);
+}
+//=================================================================================================//
 DeformationGradientBySummation::
     DeformationGradientBySummation(BaseInnerRelation &inner_relation)
     : LocalDynamics(inner_relation.getSPHBody()), DataDelegateInner(inner_relation),
+      reference_gradient_(inner_relation.compact_reference_gradient_),
       Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
       pos_(particles_->getVariableDataByName<Vecd>("Position")),
       B_(particles_->getVariableDataByName<Matd>("LinearGradientCorrectionMatrix")),
@@ -60,13 +74,24 @@ DeformationGradientBySummation::
 BaseElasticIntegration::
     BaseElasticIntegration(BaseInnerRelation &inner_relation)
     : LocalDynamics(inner_relation.getSPHBody()), DataDelegateInner(inner_relation),
+      reference_gradient_(inner_relation.compact_reference_gradient_),
       Vol_(particles_->getVariableDataByName<Real>("VolumetricMeasure")),
       pos_(particles_->getVariableDataByName<Vecd>("Position")),
       vel_(particles_->registerStateVariable<Vecd>("Velocity")),
       force_(particles_->registerStateVariable<Vecd>("Force")),
       B_(particles_->getVariableDataByName<Matd>("LinearGradientCorrectionMatrix")),
       F_(particles_->registerStateVariable<Matd>("DeformationGradient", IdentityMatrix<Matd>::value)),
-      dF_dt_(particles_->registerStateVariable<Matd>("DeformationRate")) {}
+      dF_dt_(particles_->registerStateVariable<Matd>("DeformationRate"))
+{
+    // the position differences of the pairs are not corrected by periodic image search
+    if (inner_relation.real_body_->getCellLinkedList().isPeriodicImageSearch())
+    {
+        std::cout << "\n Error: the elastic integration does not support periodic image search, "
+                  << "use PeriodicConditionUsingCellLinkedList instead!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
 //=================================================================================================//
 BaseIntegration1stHalf::
     BaseIntegration1stHalf(BaseInnerRelation &inner_relation)
@@ -175,6 +200,7 @@ void Integration2ndHalf::initialization(size_t index_i, Real dt)
 void Integration2ndHalf::update(size_t index_i, Real dt)
 {
     F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+    state_sentinel_.check(vel_[index_i]);
 }
 //=================================================================================================//
 void Integration1stHalfPK2RightCauchy::initialization(size_t index_i, Real dt)
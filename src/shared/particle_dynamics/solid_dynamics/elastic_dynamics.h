@@ -36,6 +36,7 @@
 #include "base_kernel.h"
 #include "elastic_solid.h"
 #include "solid_body.h"
+#include "state_sentinel.h"
 
 namespace SPH
 {
@@ -75,6 +76,23 @@ class UpdateElasticNormalDirection : public LocalDynamics
     void update(size_t index_i, Real dt = 0.0);
 };
 
+/**
+ * @class UpdateElasticNormalDirectionBatched
+ * @brief The same update as UpdateElasticNormalDirection, but the particles are processed
+ * in batches so that, in 3D, the rotations are extracted by the batched polar decomposition.
+ */
+class UpdateElasticNormalDirectionBatched : public UpdateElasticNormalDirection, public BaseDynamics<void>
+{
+  public:
+    explicit UpdateElasticNormalDirectionBatched(SPHBody &sph_body)
+        : UpdateElasticNormalDirection(sph_body), BaseDynamics<void>(){};
+    virtual ~UpdateElasticNormalDirectionBatched(){};
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    static constexpr int batch_size_ = 8;
+};
+
 /**
  * @class AcousticTimeStep
  * @brief Computing the acoustic time step size
@@ -96,6 +114,27 @@ class AcousticTimeStep : public LocalDynamicsReduce<ReduceMin>
     Real reduce(size_t index_i, Real dt = 0.0);
 };
 
+/**
+ * @class ReferenceGradientPrecomputation
+ * @brief Precompute the volume-weighted and corrected kernel gradients of the reference configuration
+ * into the compact storage of the inner relation. It should be executed after the correction matrix is computed.
+ * Afterwards, DeformationGradientBySummation, Integration1stHalf and Integration2ndHalf
+ * stream through the precomputed gradients instead of recomputing them at each sub-step.
+ * The storage is invalidated when the inner configuration is updated.
+ */
+class ReferenceGradientPrecomputation : public LocalDynamics, public BaseDynamics<void>
+{
+  public:
+    explicit ReferenceGradientPrecomputation(BaseInnerRelation &inner_relation);
+    virtual ~ReferenceGradientPrecomputation(){};
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    BaseInnerRelation &inner_relation_;
+    Real *Vol_;
+    Matd *B_;
+};
+
 /**
  * @class DeformationGradientBySummation
  * @brief computing deformation gradient tensor by summation
@@ -110,6 +149,19 @@ class DeformationGradientBySummation : public LocalDynamics, public DataDelegate
     {
         Vecd &pos_n_i = pos_[index_i];
 
+        if (reference_gradient_.isBuilt())
+        {
+            Matd deformation = Matd::Zero();
+            const CompactGradientNeighborhood gradient_neighborhood = reference_gradient_[index_i];
+            for (size_t n = 0; n != gradient_neighborhood.current_size_; ++n)
+            {
+                Vecd corrected_gradW_ijV_j = gradient_neighborhood.corrected_gradW_ijV_j_[n].cast<Real>();
+                deformation -= (pos_n_i - pos_[gradient_neighborhood.j_[n]]) * corrected_gradW_ijV_j.transpose();
+            }
+            F_[index_i] = deformation;
+            return;
+        }
+
         Matd deformation = Matd::Zero();
         Neighborhood &inner_neighborhood = inner_configuration_[index_i];
         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
@@ -124,6 +176,7 @@ class DeformationGradientBySummation : public LocalDynamics, public DataDelegate
     };
 
   protected:
+    CompactReferenceGradient &reference_gradient_;
     Real *Vol_;
     Vecd *pos_;
     Matd *B_, *F_;
@@ -140,6 +193,7 @@ class BaseElasticIntegration : public LocalDynamics, public DataDelegateInner
     virtual ~BaseElasticIntegration(){};
 
   protected:
+    CompactReferenceGradient &reference_gradient_;
     Real *Vol_;
     Vecd *pos_, *vel_, *force_;
     Matd *B_, *F_, *dF_dt_;
@@ -181,6 +235,8 @@ class Integration1stHalf : public BaseIntegration1stHalf
         // including gravity and force from fluid
         Vecd force = Vecd::Zero();
         const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+        const CompactVecd *precomputed_gradW_ijV_j =
+            reference_gradient_.isBuilt() ? reference_gradient_[index_i].gradW_ijV_j_ : nullptr;
         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
         {
             size_t index_j = inner_neighborhood.j_[n];
@@ -193,10 +249,13 @@ class Integration1stHalf : public BaseIntegration1stHalf
             Real weight = inner_neighborhood.W_ij_[n] * inv_W0_;
             Matd numerical_stress_ij =
                 0.5 * (F_[index_i] + F_[index_j]) * elastic_solid_.PairNumericalDamping(strain_rate, smoothing_length_);
-            force += mass_[index_i] * inv_rho0_ * inner_neighborhood.dW_ij_[n] * Vol_[index_j] *
+            Vecd gradW_ijV_j = precomputed_gradW_ijV_j != nullptr
+                                   ? Vecd(precomputed_gradW_ijV_j[n].cast<Real>())
+                                   : Vecd(inner_neighborhood.dW_ij_[n] * Vol_[index_j] * e_ij);
+            force += mass_[index_i] * inv_rho0_ *
                      (stress_PK1_B_[index_i] + stress_PK1_B_[index_j] +
                       numerical_dissipation_factor_ * weight * numerical_stress_ij) *
-                     e_ij;
+                     gradW_ijV_j;
         }
 
         force_[index_i] = force;
@@ -328,7 +387,7 @@ class Integration2ndHalf : public BaseElasticIntegration
 {
   public:
     explicit Integration2ndHalf(BaseInnerRelation &inner_relation)
-        : BaseElasticIntegration(inner_relation){};
+        : BaseElasticIntegration(inner_relation), state_sentinel_(particles_){};
     virtual ~Integration2ndHalf(){};
     void initialization(size_t index_i, Real dt = 0.0);
 
@@ -336,6 +395,20 @@ class Integration2ndHalf : public BaseElasticIntegration
     {
         const Vecd &vel_n_i = vel_[index_i];
 
+        if (reference_gradient_.isBuilt())
+        {
+            Matd deformation_gradient_change_rate = Matd::Zero();
+            const CompactGradientNeighborhood gradient_neighborhood = reference_gradient_[index_i];
+            for (size_t n = 0; n != gradient_neighborhood.current_size_; ++n)
+            {
+                Vecd corrected_gradW_ijV_j = gradient_neighborhood.corrected_gradW_ijV_j_[n].cast<Real>();
+                deformation_gradient_change_rate -=
+                    (vel_n_i - vel_[gradient_neighborhood.j_[n]]) * corrected_gradW_ijV_j.transpose();
+            }
+            dF_dt_[index_i] = deformation_gradient_change_rate;
+            return;
+        }
+
         Matd deformation_gradient_change_rate = Matd::Zero();
         const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
         for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
@@ -350,6 +423,9 @@ class Integration2ndHalf : public BaseElasticIntegration
     };
 
     void update(size_t index_i, Real dt = 0.0);
+
+  protected:
+    StateSentinelCheck state_sentinel_;
 };
 } // namespace solid_dynamics
 } // namespace SPH
@@ -86,5 +86,35 @@ AverageVelocityAndAcceleration::
     : initialize_displacement_(solid_body),
       update_averages_(solid_body) {}
 //=================================================================================================//
+SolidSubCycling::SolidSubCycling(SolidBody &solid_body, BaseDynamics<Real> &solid_time_step,
+                                 BaseDynamics<void> &solid_first_half, BaseDynamics<void> &solid_second_half,
+                                 StdVec<BaseDynamics<void> *> solid_constraints)
+    : average_velocity_and_acceleration_(solid_body), solid_time_step_(solid_time_step),
+      solid_first_half_(solid_first_half), solid_second_half_(solid_second_half),
+      solid_constraints_(solid_constraints) {}
+//=================================================================================================//
+UnsignedInt SolidSubCycling::runSubCycles(Real dt)
+{
+    average_velocity_and_acceleration_.initialize_displacement_.exec();
+    Real dt_s = solid_time_step_.exec();
+    UnsignedInt number_of_sub_cycles = SMAX(UnsignedInt(1), UnsignedInt(std::ceil(dt / dt_s)));
+    Real sub_cycle_dt = dt / Real(number_of_sub_cycles);
+    for (UnsignedInt k = 0; k != number_of_sub_cycles; ++k)
+    {
+        solid_first_half_.exec(sub_cycle_dt);
+        for (size_t l = 0; l != solid_constraints_.size(); ++l)
+            solid_constraints_[l]->exec(sub_cycle_dt);
+        solid_second_half_.exec(sub_cycle_dt);
+    }
+    return number_of_sub_cycles;
+}
+//=================================================================================================//
+UnsignedInt SolidSubCycling::exec(Real dt)
+{
+    UnsignedInt number_of_sub_cycles = runSubCycles(dt);
+    average_velocity_and_acceleration_.update_averages_.exec(dt);
+    return number_of_sub_cycles;
+}
+//=================================================================================================//
 } // namespace solid_dynamics
 } // namespace SPH
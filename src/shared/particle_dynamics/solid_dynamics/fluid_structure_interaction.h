@@ -35,6 +35,8 @@
 #include "force_prior.hpp"
 #include "riemann_solver.h"
 
+#include "tbb/parallel_invoke.h"
+
 namespace SPH
 {
 namespace solid_dynamics
@@ -151,6 +153,48 @@ class AverageVelocityAndAcceleration
     explicit AverageVelocityAndAcceleration(SolidBody &solid_body);
     ~AverageVelocityAndAcceleration(){};
 };
+
+/**
+ * @class SolidSubCycling
+ * @brief Scheduler of the solid sub-cycles within a fluid time step for FSI applications.
+ * The number of sub-cycles is computed from the ratio between the fluid and the current solid time step,
+ * and the fluid step is divided into equal solid sub-steps.
+ * The displacement initialization and the averaging of velocity and acceleration are handled here.
+ * Optionally, fluid-only work, i.e. not using the solid states updated in the sub-cycles,
+ * such as the fluid density relaxation which uses the averages of the previous step, runs concurrently.
+ */
+class SolidSubCycling
+{
+  public:
+    SolidSubCycling(SolidBody &solid_body, BaseDynamics<Real> &solid_time_step,
+                    BaseDynamics<void> &solid_first_half, BaseDynamics<void> &solid_second_half,
+                    StdVec<BaseDynamics<void> *> solid_constraints = StdVec<BaseDynamics<void> *>());
+    ~SolidSubCycling(){};
+
+    /** run the solid sub-cycles for the fluid time step and return the number of sub-cycles */
+    UnsignedInt exec(Real dt);
+
+    template <class FluidOnlyWork>
+    UnsignedInt exec(Real dt, const FluidOnlyWork &fluid_only_work)
+    {
+        UnsignedInt number_of_sub_cycles = 0;
+        tbb::parallel_invoke([&]()
+                             { number_of_sub_cycles = runSubCycles(dt); },
+                             [&]()
+                             { fluid_only_work(); });
+        average_velocity_and_acceleration_.update_averages_.exec(dt);
+        return number_of_sub_cycles;
+    };
+
+  protected:
+    AverageVelocityAndAcceleration average_velocity_and_acceleration_;
+    BaseDynamics<Real> &solid_time_step_;
+    BaseDynamics<void> &solid_first_half_;
+    BaseDynamics<void> &solid_second_half_;
+    StdVec<BaseDynamics<void> *> solid_constraints_;
+
+    UnsignedInt runSubCycles(Real dt);
+};
 } // namespace solid_dynamics
 } // namespace SPH
 #endif // FLUID_STRUCTURE_INTERACTION_H
\ No newline at end of file
@@ -14,14 +14,21 @@ DecomposedPlasticIntegration1stHalf::
       inverse_F_(particles_->registerStateVariable<Matd>("InverseDeformation")) {}
 //=================================================================================================//
 void DecomposedPlasticIntegration1stHalf::initialization(size_t index_i, Real dt)
+{
+    advanceHalfStep(index_i, dt);
+    computeStress(index_i, plastic_solid_.ElasticLeftCauchy(F_[index_i], index_i, dt), dt);
+}
+//=================================================================================================//
+void DecomposedPlasticIntegration1stHalf::advanceHalfStep(size_t index_i, Real dt)
 {
     pos_[index_i] += vel_[index_i] * dt * 0.5;
     F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+    rho_[index_i] = rho0_ / F_[index_i].determinant();
+}
+//=================================================================================================//
+void DecomposedPlasticIntegration1stHalf::computeStress(size_t index_i, const Matd &normalized_be, Real dt)
+{
     Real J = F_[index_i].determinant();
-    Real one_over_J = 1.0 / J;
-    rho_[index_i] = rho0_ * one_over_J;
-
-    Matd normalized_be = plastic_solid_.ElasticLeftCauchy(F_[index_i], index_i, dt);
     inverse_F_[index_i] = F_[index_i].inverse();
     Matd inverse_F_T = inverse_F_[index_i].transpose();
     scaling_matrix_[index_i] = normalized_be * inverse_F_T;
@@ -32,6 +39,36 @@ void DecomposedPlasticIntegration1stHalf::initialization(size_t index_i, Real dt
         0.125 * plastic_solid_.NumericalDampingLeftCauchy(F_[index_i], dF_dt_[index_i], smoothing_length_, index_i) * inverse_F_T;
 }
 //=================================================================================================//
+void DecomposedPlasticIntegration1stHalfBatched::exec(Real dt)
+{
+    auto profiling_scope = profilingScope(sph_system_, identifier_);
+    setUpdated(identifier_.getSPHBody());
+    setupDynamics(dt);
+    size_t total_real_particles = particles_->TotalRealParticles();
+    size_t number_of_batches = (total_real_particles + PlasticBatchSize - 1) / PlasticBatchSize;
+    particle_for(execution::par, IndexRange(0, number_of_batches),
+                 [&](size_t batch)
+                 {
+                     size_t first = batch * PlasticBatchSize;
+                     size_t lanes = SMIN(PlasticBatchSize, total_real_particles - first);
+                     for (size_t l = 0; l != lanes; ++l)
+                         advanceHalfStep(first + l, dt);
+
+                     Matd normalized_be[PlasticBatchSize];
+                     plastic_solid_.ElasticLeftCauchyBatch(&F_[first], first, lanes, normalized_be, dt);
+                     for (size_t l = 0; l != lanes; ++l)
+                         computeStress(first + l, normalized_be[l], dt);
+                 });
+
+    IndexRange loop_range(0, total_real_particles);
+    particle_for(execution::par, loop_range,
+                 [&](size_t index_i)
+                 { interaction(index_i, dt); });
+    particle_for(execution::par, loop_range,
+                 [&](size_t index_i)
+                 { update(index_i, dt); });
+}
+//=================================================================================================//
 } // namespace solid_dynamics
   //=====================================================================================================//
 } // namespace SPH
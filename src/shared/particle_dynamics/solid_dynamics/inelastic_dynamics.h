@@ -77,6 +77,25 @@ class DecomposedPlasticIntegration1stHalf
   protected:
     PlasticSolid &plastic_solid_;
     Matd *scaling_matrix_, *inverse_F_;
+
+    void advanceHalfStep(size_t index_i, Real dt);
+    void computeStress(size_t index_i, const Matd &normalized_be, Real dt);
+};
+
+/**
+ * @class DecomposedPlasticIntegration1stHalfBatched
+ * @brief The same as DecomposedPlasticIntegration1stHalf executed as a whole
+ * with the return mapping carried out by the material for batches of particles,
+ * in which the iterations of the return mapping are masked per particle.
+ */
+class DecomposedPlasticIntegration1stHalfBatched
+    : public DecomposedPlasticIntegration1stHalf, public BaseDynamics<void>
+{
+  public:
+    explicit DecomposedPlasticIntegration1stHalfBatched(BaseInnerRelation &inner_relation)
+        : DecomposedPlasticIntegration1stHalf(inner_relation), BaseDynamics<void>(){};
+    virtual ~DecomposedPlasticIntegration1stHalfBatched(){};
+    virtual void exec(Real dt = 0.0) override;
 };
 } // namespace solid_dynamics
 } // namespace SPH
@@ -25,6 +25,14 @@ BasePorousMediaRelaxation::BasePorousMediaRelaxation(BaseInnerRelation &inner_re
     rho0_ = porous_solid_.ReferenceDensity();
     inv_rho0_ = 1.0 / rho0_;
     smoothing_length_ = sph_body_.sph_adaptation_->ReferenceSmoothingLength();
+    // the position differences of the pairs are not corrected by periodic image search
+    if (inner_relation.real_body_->getCellLinkedList().isPeriodicImageSearch())
+    {
+        std::cout << "\n Error: the porous media relaxation does not support periodic image search, "
+                  << "use PeriodicConditionUsingCellLinkedList instead!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
 }
 //=================================================================================================//
 MomentumConstraint::MomentumConstraint(BodyPartByParticle &body_part)
@@ -0,0 +1,238 @@
+#include "quasi_static_dynamics.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+//=================================================================================================//
+QuasiStaticEquilibrium::
+    QuasiStaticEquilibrium(BaseInnerRelation &inner_relation, Real tolerance,
+                           UnsignedInt max_newton_iterations, UnsignedInt max_linear_iterations)
+    : BaseIntegration1stHalf(inner_relation), BaseDynamics<void>(),
+      tolerance_(tolerance), max_newton_iterations_(max_newton_iterations),
+      max_linear_iterations_(max_linear_iterations), newton_iterations_(0), linear_iterations_(0),
+      relative_residual_(0.0),
+      stiffness_(rho0_ * elastic_solid_.ReferenceSoundSpeed() * elastic_solid_.ReferenceSoundSpeed()),
+      stress_PK1_B_(particles_->registerStateVariable<Matd>("StressPK1OnParticle")),
+      is_fixed_(particles_->registerStateVariable<int>("QuasiStaticFixed")),
+      diagonal_(particles_->registerStateVariable<Real>("QuasiStaticDiagonal")),
+      trial_pos_(particles_->registerStateVariable<Vecd>("QuasiStaticTrialPosition")),
+      residual_(particles_->registerStateVariable<Vecd>("QuasiStaticResidual")),
+      trial_residual_(particles_->registerStateVariable<Vecd>("QuasiStaticTrialResidual")),
+      increment_(particles_->registerStateVariable<Vecd>("QuasiStaticIncrement")),
+      linear_residual_(particles_->registerStateVariable<Vecd>("QuasiStaticLinearResidual")),
+      direction_(particles_->registerStateVariable<Vecd>("QuasiStaticDirection")),
+      operator_direction_(particles_->registerStateVariable<Vecd>("QuasiStaticOperatorDirection")) {}
+//=================================================================================================//
+void QuasiStaticEquilibrium::fixBodyPart(BodyPartByParticle &body_part)
+{
+    for (size_t index_i : body_part.LoopRange())
+    {
+        is_fixed_[index_i] = 1;
+    }
+}
+//=================================================================================================//
+Matd QuasiStaticEquilibrium::deformationGradient(size_t index_i, Vecd *position)
+{
+    const Vecd &pos_i = position[index_i];
+    if (reference_gradient_.isBuilt())
+    {
+        Matd deformation = Matd::Zero();
+        const CompactGradientNeighborhood gradient_neighborhood = reference_gradient_[index_i];
+        for (size_t n = 0; n != gradient_neighborhood.current_size_; ++n)
+        {
+            Vecd corrected_gradW_ijV_j = gradient_neighborhood.corrected_gradW_ijV_j_[n].cast<Real>();
+            deformation -= (pos_i - position[gradient_neighborhood.j_[n]]) * corrected_gradW_ijV_j.transpose();
+        }
+        return deformation;
+    }
+
+    Matd deformation = Matd::Zero();
+    const Neighborhood &inner_neighborhood = inner_configuration_[index_i];
+    for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+    {
+        size_t index_j = inner_neighborhood.j_[n];
+        Vecd gradW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j] * inner_neighborhood.e_ij_[n];
+        deformation -= (pos_i - position[index_j]) * gradW_ijV_j.transpose();
+    }
+    return deformation * B_[index_i];
+}
+//=================================================================================================//
+void QuasiStaticEquilibrium::computeResidual(Vecd *position, Vecd *residual)
+{
+    IndexRange loop_range(0, particles_->TotalRealParticles());
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 {
+                     F_[i] = deformationGradient(i, position);
+                     stress_PK1_B_[i] = elastic_solid_.StressPK1(F_[i], i) * B_[i].transpose();
+                 });
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 {
+                     if (is_fixed_[i] != 0)
+                     {
+                         residual[i] = Vecd::Zero();
+                         return;
+                     }
+
+                     Vecd force = force_prior_[i];
+                     const Neighborhood &inner_neighborhood = inner_configuration_[i];
+                     const CompactVecd *precomputed_gradW_ijV_j =
+                         reference_gradient_.isBuilt() ? reference_gradient_[i].gradW_ijV_j_ : nullptr;
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                     {
+                         size_t index_j = inner_neighborhood.j_[n];
+                         Vecd gradW_ijV_j = precomputed_gradW_ijV_j != nullptr
+                                                ? Vecd(precomputed_gradW_ijV_j[n].cast<Real>())
+                                                : Vecd(inner_neighborhood.dW_ij_[n] * Vol_[index_j] *
+                                                       inner_neighborhood.e_ij_[n]);
+                         force += mass_[i] * inv_rho0_ * (stress_PK1_B_[i] + stress_PK1_B_[index_j]) * gradW_ijV_j;
+                     }
+                     residual[i] = force;
+                 });
+}
+//=================================================================================================//
+Real QuasiStaticEquilibrium::dot(Vecd *field_a, Vecd *field_b)
+{
+    return particle_reduce(execution::par, IndexRange(0, particles_->TotalRealParticles()),
+                           Real(0), ReduceSum<Real>(),
+                           [&](size_t i) -> Real
+                           { return field_a[i].dot(field_b[i]); });
+}
+//=================================================================================================//
+void QuasiStaticEquilibrium::applyStiffness(Vecd *field, Vecd *product)
+{
+    IndexRange loop_range(0, particles_->TotalRealParticles());
+    // perturbation scaled so that the root-mean-square displacement is a small fraction of smoothing length
+    Real field_rms = std::sqrt(dot(field, field) / Real(particles_->TotalRealParticles()));
+    Real epsilon = perturbation_ * smoothing_length_ / (field_rms + TinyReal);
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 { trial_pos_[i] = pos_[i] + epsilon * field[i]; });
+    computeResidual(trial_pos_, trial_residual_);
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 { product[i] = (residual_[i] - trial_residual_[i]) / epsilon; });
+}
+//=================================================================================================//
+void QuasiStaticEquilibrium::solveLinearSystem(Real residual_norm, Real forcing)
+{
+    IndexRange loop_range(0, particles_->TotalRealParticles());
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 {
+                     increment_[i] = Vecd::Zero();
+                     linear_residual_[i] = residual_[i];
+                     direction_[i] = residual_[i] / diagonal_[i];
+                 });
+    Real residual_dot = particle_reduce(execution::par, loop_range, Real(0), ReduceSum<Real>(),
+                                        [&](size_t i) -> Real
+                                        { return residual_[i].dot(residual_[i] / diagonal_[i]); });
+
+    for (UnsignedInt k = 0; k != max_linear_iterations_; ++k)
+    {
+        applyStiffness(direction_, operator_direction_);
+        Real curvature = dot(direction_, operator_direction_);
+        if (curvature <= 0.0)
+        {
+            // the tangent stiffness is not positive definite along the direction,
+            // the preconditioned residual is taken if no progress has been made
+            if (k == 0)
+            {
+                particle_for(execution::par, loop_range,
+                             [&](size_t i)
+                             { increment_[i] = direction_[i]; });
+            }
+            break;
+        }
+
+        Real alpha = residual_dot / curvature;
+        particle_for(execution::par, loop_range,
+                     [&](size_t i)
+                     {
+                         increment_[i] += alpha * direction_[i];
+                         linear_residual_[i] -= alpha * operator_direction_[i];
+                     });
+        ++linear_iterations_;
+        if (std::sqrt(dot(linear_residual_, linear_residual_)) < forcing * residual_norm)
+            break;
+
+        Real new_residual_dot = particle_reduce(execution::par, loop_range, Real(0), ReduceSum<Real>(),
+                                                [&](size_t i) -> Real
+                                                { return linear_residual_[i].dot(linear_residual_[i] / diagonal_[i]); });
+        Real beta = new_residual_dot / (residual_dot + TinyReal);
+        residual_dot = new_residual_dot;
+        particle_for(execution::par, loop_range,
+                     [&](size_t i)
+                     { direction_[i] = linear_residual_[i] / diagonal_[i] + beta * direction_[i]; });
+    }
+}
+//=================================================================================================//
+void QuasiStaticEquilibrium::exec(Real dt)
+{
+    IndexRange loop_range(0, particles_->TotalRealParticles());
+    // the diagonal preconditioner from the P-wave modulus and the kernel gradient
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 {
+                     Real diagonal = 0.0;
+                     const Neighborhood &inner_neighborhood = inner_configuration_[i];
+                     for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+                     {
+                         diagonal -= 2.0 * inner_neighborhood.dW_ij_[n] * Vol_[inner_neighborhood.j_[n]] /
+                                     (inner_neighborhood.r_ij_[n] + 0.01 * smoothing_length_);
+                     }
+                     diagonal_[i] = is_fixed_[i] != 0 ? 1.0 : mass_[i] * inv_rho0_ * stiffness_ * diagonal + TinyReal;
+                 });
+
+    computeResidual(pos_, residual_);
+    Real initial_norm = std::sqrt(dot(residual_, residual_));
+    Real residual_norm = initial_norm;
+    relative_residual_ = initial_norm > TinyReal ? 1.0 : 0.0;
+    newton_iterations_ = 0;
+    linear_iterations_ = 0;
+    while (relative_residual_ > tolerance_ && newton_iterations_ < max_newton_iterations_)
+    {
+        // inexact Newton with the forcing term decreasing along with the residual
+        solveLinearSystem(residual_norm, SMIN(Real(0.1), std::sqrt(relative_residual_)));
+
+        Real step = 1.0;
+        Real trial_norm = residual_norm;
+        for (UnsignedInt k = 0; k != max_line_search_; ++k)
+        {
+            particle_for(execution::par, loop_range,
+                         [&](size_t i)
+                         { trial_pos_[i] = pos_[i] + step * increment_[i]; });
+            computeResidual(trial_pos_, trial_residual_);
+            trial_norm = std::sqrt(dot(trial_residual_, trial_residual_));
+            if (trial_norm < residual_norm)
+                break;
+            step *= 0.5;
+        }
+
+        particle_for(execution::par, loop_range,
+                     [&](size_t i)
+                     {
+                         pos_[i] = trial_pos_[i];
+                         residual_[i] = trial_residual_[i];
+                     });
+        residual_norm = trial_norm;
+        relative_residual_ = residual_norm / initial_norm;
+        ++newton_iterations_;
+    }
+
+    // deformation and stress consistent with the equilibrium positions
+    computeResidual(pos_, residual_);
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 {
+                     rho_[i] = rho0_ / F_[i].determinant();
+                     force_[i] = residual_[i] - force_prior_[i];
+                     vel_[i] = Vecd::Zero();
+                     dF_dt_[i] = Matd::Zero();
+                 });
+}
+//=================================================================================================//
+} // namespace solid_dynamics
+} // namespace SPH
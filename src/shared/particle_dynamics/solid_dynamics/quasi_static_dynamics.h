@@ -0,0 +1,91 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	quasi_static_dynamics.h
+ * @brief 	Implicit quasi-static equilibrium of elastic solids under slow loading.
+ * @details The static equilibrium R(x) = f_prior + f_int(x) = 0 is solved by the Newton-Raphson method
+ *          with backtracking line search. The linear system K dx = R, with the tangent stiffness K = -dR/dx,
+ *          is solved by the Jacobi preconditioned conjugate gradient method, in which the product of
+ *          the tangent stiffness and a vector is obtained matrix free by finite difference of the
+ *          SPH stress divergence, i.e. the same total Lagrangian formulation as Integration1stHalf.
+ *          Particles of fixed body parts are excluded from the unknowns.
+ *          Each Newton iteration takes only tens of residual evaluations so that the equilibrium
+ *          is reached much faster than by explicit integration with damping.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef QUASI_STATIC_DYNAMICS_H
+#define QUASI_STATIC_DYNAMICS_H
+
+#include "elastic_dynamics.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+/**
+ * @class QuasiStaticEquilibrium
+ * @brief Newton-Krylov solver for the static equilibrium under the present prior force.
+ * The prior force, e.g. gravity or surface pressure, should be updated before exec.
+ */
+class QuasiStaticEquilibrium : public BaseIntegration1stHalf, public BaseDynamics<void>
+{
+  public:
+    explicit QuasiStaticEquilibrium(BaseInnerRelation &inner_relation, Real tolerance = 1.0e-6,
+                                    UnsignedInt max_newton_iterations = 50,
+                                    UnsignedInt max_linear_iterations = 200);
+    virtual ~QuasiStaticEquilibrium(){};
+    /** particles in the body part keep their present positions */
+    void fixBodyPart(BodyPartByParticle &body_part);
+    UnsignedInt NewtonIterations() { return newton_iterations_; };
+    UnsignedInt LinearIterations() { return linear_iterations_; };
+    Real RelativeResidual() { return relative_residual_; };
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    Real tolerance_;
+    UnsignedInt max_newton_iterations_, max_linear_iterations_;
+    UnsignedInt newton_iterations_, linear_iterations_;
+    Real relative_residual_;
+    Real stiffness_;
+    const UnsignedInt max_line_search_ = 8;
+    const Real perturbation_ = 1.0e-6;
+    Matd *stress_PK1_B_;
+    int *is_fixed_;
+    Real *diagonal_;
+    Vecd *trial_pos_, *residual_, *trial_residual_, *increment_;
+    Vecd *linear_residual_, *direction_, *operator_direction_;
+
+    Matd deformationGradient(size_t index_i, Vecd *position);
+    /** the out-of-balance force of the given particle positions */
+    void computeResidual(Vecd *position, Vecd *residual);
+    /** the matrix-free product of the tangent stiffness and a field */
+    void applyStiffness(Vecd *field, Vecd *product);
+    /** approximately solving K dx = R with the given relative tolerance */
+    void solveLinearSystem(Real residual_norm, Real forcing);
+    Real dot(Vecd *field_a, Vecd *field_b);
+};
+} // namespace solid_dynamics
+} // namespace SPH
+#endif // QUASI_STATIC_DYNAMICS_H
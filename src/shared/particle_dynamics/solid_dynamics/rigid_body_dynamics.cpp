@@ -0,0 +1,68 @@
+#include "rigid_body_dynamics.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+//=================================================================================================//
+RigidBodyMotion::RigidBodyMotion(SolidBody &solid_body)
+    : MotionConstraint<SPHBody>(solid_body), BaseDynamics<void>(),
+      mass_(particles_->getVariableDataByName<Real>("Mass")),
+      force_(particles_->registerStateVariable<Vecd>("Force")),
+      force_prior_(particles_->registerStateVariable<Vecd>("ForcePrior")),
+      n_(particles_->getVariableDataByName<Vecd>("NormalDirection")),
+      n0_(particles_->registerStateVariableFrom<Vecd>("InitialNormalDirection", "NormalDirection")),
+      acc_(particles_->registerStateVariable<Vecd>("Acceleration")),
+      velocity_(Vecd::Zero()), translation_mask_(Vecd::Ones()), rotation_(Matd::Identity()),
+      angular_velocity_(ZeroData<AngularVecd>::value), is_rotation_free_(true),
+      total_force_(SpatialVecd::Zero())
+{
+    IndexRange loop_range(0, particles_->TotalRealParticles());
+    total_mass_ = particle_reduce(execution::par, loop_range, Real(0), ReduceSum<Real>(),
+                                  [&](size_t i) -> Real
+                                  { return mass_[i]; });
+    initial_mass_center_ = particle_reduce(execution::par, loop_range, Vecd(Vecd::Zero()), ReduceSum<Vecd>(),
+                                           [&](size_t i) -> Vecd
+                                           { return mass_[i] * pos0_[i]; }) /
+                           total_mass_;
+    mass_center_ = initial_mass_center_;
+    initial_inertia_ = particle_reduce(execution::par, loop_range, ZeroData<InertiaType>::value,
+                                       ReduceSum<InertiaType>(),
+                                       [&](size_t i) -> InertiaType
+                                       { return particleInertia(pos0_[i] - initial_mass_center_, mass_[i]); });
+}
+//=================================================================================================//
+void RigidBodyMotion::exec(Real dt)
+{
+    IndexRange loop_range(0, particles_->TotalRealParticles());
+    total_force_ = particle_reduce(execution::par, loop_range, SpatialVecd(SpatialVecd::Zero()),
+                                   ReduceSum<SpatialVecd>(),
+                                   [&](size_t i) -> SpatialVecd
+                                   {
+                                       Vecd force = force_[i] + force_prior_[i];
+                                       SpatialVecd spatial_force;
+                                       spatial_force << force, getCrossProduct(Vecd(pos_[i] - mass_center_), force);
+                                       return spatial_force;
+                                   });
+
+    Vecd total_force = total_force_.head<Dimensions>();
+    velocity_ += translation_mask_.cwiseProduct(total_force) / total_mass_ * dt;
+    mass_center_ += velocity_ * dt;
+    if (is_rotation_free_)
+        integrateRotation(total_force_, dt);
+
+    Real inv_dt = 1.0 / (dt + TinyReal);
+    particle_for(execution::par, loop_range,
+                 [&](size_t i)
+                 {
+                     Vecd offset = rotation_ * (pos0_[i] - initial_mass_center_);
+                     pos_[i] = mass_center_ + offset;
+                     Vecd vel = velocity_ + rotationalVelocity(offset);
+                     acc_[i] = (vel - vel_[i]) * inv_dt;
+                     vel_[i] = vel;
+                     n_[i] = rotation_ * n0_[i];
+                 });
+}
+//=================================================================================================//
+} // namespace solid_dynamics
+} // namespace SPH
@@ -0,0 +1,89 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	rigid_body_dynamics.h
+ * @brief 	Rigid-body motion of a solid body without per-particle solid dynamics.
+ * @details The total force and torque from the prior force, e.g. from fluid and gravity,
+ *          and the contact force are obtained by a single parallel reduction.
+ *          The motion of the mass center and the rotation are integrated by the symplectic Euler method
+ *          and the particles are updated by the rigid transform from the initial configuration.
+ *          The elastic Integration1stHalf and Integration2ndHalf are not required for such a body.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef RIGID_BODY_DYNAMICS_H
+#define RIGID_BODY_DYNAMICS_H
+
+#include "all_particle_dynamics.h"
+#include "general_constraint.h"
+#include "solid_body.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+/**
+ * @class RigidBodyMotion
+ * @brief Free rigid-body motion driven by the total force and torque on the body.
+ */
+class RigidBodyMotion : public MotionConstraint<SPHBody>, public BaseDynamics<void>
+{
+  public:
+    /** force followed by torque */
+    using SpatialVecd = Eigen::Matrix<Real, Dimensions *(Dimensions + 1) / 2, 1>;
+    /** rotational inertia, scalar in 2D and matrix in 3D */
+    using InertiaType = std::conditional_t<Dimensions == 2, Real, Mat3d>;
+
+    explicit RigidBodyMotion(SolidBody &solid_body);
+    virtual ~RigidBodyMotion(){};
+    /** the translation is only free along the directions with non-zero components */
+    void constrainTranslation(const Vecd &free_direction) { translation_mask_ = free_direction; };
+    void constrainRotation() { is_rotation_free_ = false; };
+    Real TotalMass() { return total_mass_; };
+    Vecd MassCenter() { return mass_center_; };
+    Vecd Velocity() { return velocity_; };
+    Matd RotationMatrix() { return rotation_; };
+    AngularVecd AngularVelocity() { return angular_velocity_; };
+    SpatialVecd TotalForce() { return total_force_; };
+
+    virtual void exec(Real dt = 0.0) override;
+
+  protected:
+    Real *mass_;
+    Vecd *force_, *force_prior_, *n_, *n0_, *acc_;
+    Real total_mass_;
+    Vecd initial_mass_center_, mass_center_, velocity_, translation_mask_;
+    Matd rotation_;
+    AngularVecd angular_velocity_;
+    InertiaType initial_inertia_;
+    bool is_rotation_free_;
+    SpatialVecd total_force_;
+
+    /** the following are dimension dependent */
+    InertiaType particleInertia(const Vecd &offset, Real mass);
+    void integrateRotation(const SpatialVecd &total_force, Real dt);
+    Vecd rotationalVelocity(const Vecd &offset);
+};
+} // namespace solid_dynamics
+} // namespace SPH
+#endif // RIGID_BODY_DYNAMICS_H
@@ -159,28 +159,41 @@ void ShellStressRelaxationFirstHalf::initialization(size_t index_i, Real dt)
     /** Get transformation matrix from initial local coordinates to current local coordinates. */
     Matd transformation_matrix_0_to_current = current_transformation_matrix * transformation_matrix0_[index_i].transpose();
 
+    Matd transformation_matrix_0_to_current_T = transformation_matrix_0_to_current.transpose();
+
+    /** correct out-plane numerical damping, with a local copy as particles are updated in parallel. */
+    Matd numerical_damping_scaling_matrix = numerical_damping_scaling_matrix_;
+    numerical_damping_scaling_matrix(Dimensions - 1, Dimensions - 1) = SMIN(thickness_[index_i], smoothing_length_);
+
+    /** the quantities invariant along the thickness are evaluated once before the loop on Gaussian points. */
+    const Real half_thickness = 0.5 * thickness_[index_i];
+    const Matd &F_i = F_[index_i];
+    const Matd &F_bending_i = F_bending_[index_i];
+    const Matd &dF_dt_i = dF_dt_[index_i];
+    const Matd &dF_bending_dt_i = dF_bending_dt_[index_i];
+
     Matd resultant_stress = Matd::Zero();
     Matd resultant_moment = Matd::Zero();
     Vecd resultant_shear_stress = Vecd::Zero();
 
     for (int i = 0; i != number_of_gaussian_points_; ++i)
     {
-        Matd F_gaussian_point = F_[index_i] + gaussian_point_[i] * F_bending_[index_i] * thickness_[index_i] * 0.5;
-        Matd dF_gaussian_point_dt = dF_dt_[index_i] + gaussian_point_[i] * dF_bending_dt_[index_i] * thickness_[index_i] * 0.5;
+        const Real thickness_coordinate = gaussian_point_[i] * half_thickness;
+        Matd F_gaussian_point = F_i + thickness_coordinate * F_bending_i;
+        Matd dF_gaussian_point_dt = dF_dt_i + thickness_coordinate * dF_bending_dt_i;
         Matd inverse_F_gaussian_point = F_gaussian_point.inverse();
         Matd current_local_almansi_strain = transformation_matrix_0_to_current * 0.5 *
                                             (Matd::Identity() - inverse_F_gaussian_point.transpose() * inverse_F_gaussian_point) *
-                                            transformation_matrix_0_to_current.transpose();
+                                            transformation_matrix_0_to_current_T;
 
         /** correct Almansi strain tensor according to plane stress problem. */
         current_local_almansi_strain = getCorrectedAlmansiStrain(current_local_almansi_strain, nu_);
 
-        /** correct out-plane numerical damping. */
-        numerical_damping_scaling_matrix_(Dimensions - 1, Dimensions - 1) = thickness_[i] < smoothing_length_ ? thickness_[i] : smoothing_length_;
+        Matd transformed_F = transformation_matrix_0_to_current * F_gaussian_point;
         Matd cauchy_stress = elastic_solid_.StressCauchy(current_local_almansi_strain, index_i) +
-                             transformation_matrix_0_to_current * F_gaussian_point *
-                                 elastic_solid_.NumericalDampingRightCauchy(F_gaussian_point, dF_gaussian_point_dt, numerical_damping_scaling_matrix_, index_i) *
-                                 F_gaussian_point.transpose() * transformation_matrix_0_to_current.transpose() / F_gaussian_point.determinant();
+                             transformed_F *
+                                 elastic_solid_.NumericalDampingRightCauchy(F_gaussian_point, dF_gaussian_point_dt, numerical_damping_scaling_matrix, index_i) *
+                                 transformed_F.transpose() / F_gaussian_point.determinant();
 
         /** Impose modeling assumptions. */
         cauchy_stress.col(Dimensions - 1) *= shear_correction_factor_;
@@ -193,16 +206,13 @@ void ShellStressRelaxationFirstHalf::initialization(size_t index_i, Real dt)
         }
 
         /** Integrate Cauchy stress along thickness. */
-        resultant_stress +=
-            0.5 * thickness_[index_i] * gaussian_weight_[i] * cauchy_stress;
-        resultant_moment +=
-            0.5 * thickness_[index_i] * gaussian_weight_[i] * (cauchy_stress * gaussian_point_[i] * thickness_[index_i] * 0.5);
-        resultant_shear_stress -=
-            0.5 * thickness_[index_i] * gaussian_weight_[i] * cauchy_stress.col(Dimensions - 1);
-
-        resultant_stress.col(Dimensions - 1) = Vecd::Zero();
-        resultant_moment.col(Dimensions - 1) = Vecd::Zero();
+        const Real weight = half_thickness * gaussian_weight_[i];
+        resultant_stress += weight * cauchy_stress;
+        resultant_moment += (weight * thickness_coordinate) * cauchy_stress;
+        resultant_shear_stress -= weight * cauchy_stress.col(Dimensions - 1);
     }
+    resultant_stress.col(Dimensions - 1) = Vecd::Zero();
+    resultant_moment.col(Dimensions - 1) = Vecd::Zero();
 
     /** stress and moment in global coordinates for pair interaction */
     global_stress_[index_i] = J * current_transformation_matrix.transpose() *
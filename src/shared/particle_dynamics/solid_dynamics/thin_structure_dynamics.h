@@ -218,8 +218,9 @@ class ShellStressRelaxationFirstHalf : public BaseShellRelaxation
                                               inner_neighborhood.dW_ij_[n] * Vol_[index_j] * pow(thickness_[index_i], 2) * limiter_pseudo_n;
             }
 
-            force += mass_[index_i] * (global_stress_i + global_stress_[index_j]) * inner_neighborhood.dW_ij_[n] * Vol_[index_j] * inner_neighborhood.e_ij_[n];
-            pseudo_normal_acceleration += (global_moment_i + global_moment_[index_j]) * inner_neighborhood.dW_ij_[n] * Vol_[index_j] * inner_neighborhood.e_ij_[n];
+            Vecd gradW_ijV_j = inner_neighborhood.dW_ij_[n] * Vol_[index_j] * inner_neighborhood.e_ij_[n];
+            force += mass_[index_i] * (global_stress_i + global_stress_[index_j]) * gradW_ijV_j;
+            pseudo_normal_acceleration += (global_moment_i + global_moment_[index_j]) * gradW_ijV_j;
         }
 
         force_[index_i] = force * inv_rho0_ / thickness_[index_i];
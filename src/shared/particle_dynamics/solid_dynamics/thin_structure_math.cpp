@@ -1,5 +1,7 @@
 #include "thin_structure_math.h"
 
+#include "small_matrix_inverse.h"
+
 namespace SPH
 {
 //=====================================================================================================//
@@ -189,7 +191,7 @@ Mat2d getCorrectionMatrix(const Mat2d &local_deformation_part_one)
 Mat3d getCorrectionMatrix(const Mat3d &local_deformation_part_one)
 {
     Mat3d correction_matrix = Mat3d::Zero();
-    correction_matrix.block<2, 2>(0, 0) = local_deformation_part_one.block<2, 2>(0, 0).inverse();
+    correction_matrix.block<2, 2>(0, 0) = inverseByCofactors(Mat2d(local_deformation_part_one.block<2, 2>(0, 0)));
     return correction_matrix;
 }
 //=================================================================================================//
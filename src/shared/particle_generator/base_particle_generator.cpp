@@ -77,4 +77,44 @@ void ParticleGenerator<ObserverParticles>::prepareGeometricData()
     }
 }
 //=================================================================================================//
+ParticleGenerator<BaseParticles, Restart>::
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles,
+                      const std::string &restart_body_name, size_t restart_step)
+    : ParticleGenerator<BaseParticles>(sph_body, base_particles)
+{
+    std::ostringstream padded_step;
+    padded_step << std::setw(10) << std::setfill('0') << restart_step;
+    file_path_ = sph_body.getSPHSystem().getIOEnvironment().restart_folder_ + "/" +
+                 restart_body_name + "_rst_" + padded_step.str() + ".bin";
+    if (!fs::exists(file_path_))
+    {
+        std::cout << "\n Error: the restart file:" << file_path_ << " is not exists" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Restart>::prepareGeometricData()
+{
+    BinaryDataReader binary_reader(file_path_);
+    if (!binary_reader.hasVariable("Position"))
+    {
+        std::cout << "\n Error: no particle positions in the restart file:" << file_path_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    size_t number_of_particles = binary_reader.getIndex()["Position"].entry_.number_of_elements_;
+    StdLargeVec<Vecd> position(number_of_particles);
+    binary_reader.readVariable("Position", position.data(), number_of_particles);
+    // the volumes of the saved particles default to those of the reference spacing
+    StdLargeVec<Real> volumetric_measure(number_of_particles, pow(particle_spacing_ref_, Dimensions));
+    if (binary_reader.hasVariable("VolumetricMeasure"))
+        binary_reader.readVariable("VolumetricMeasure", volumetric_measure.data(), number_of_particles);
+
+    for (size_t i = 0; i != number_of_particles; ++i)
+    {
+        addPositionAndVolumetricMeasure(position[i], volumetric_measure[i]);
+    }
+}
+//=================================================================================================//
 } // namespace SPH
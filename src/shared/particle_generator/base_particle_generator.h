@@ -115,5 +115,18 @@ class ParticleGenerator<ParticlesType, Reload> : public ParticleGenerator<Partic
     virtual void setAllParticleBounds() override;
     virtual void initializeParticleVariables() override;
 };
+
+class Restart;
+template <> // generate particles at the positions saved in a restart file, e.g. for remapping to a new resolution
+class ParticleGenerator<BaseParticles, Restart> : public ParticleGenerator<BaseParticles>
+{
+    std::string file_path_;
+
+  public:
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles,
+                      const std::string &restart_body_name, size_t restart_step);
+    virtual ~ParticleGenerator(){};
+    virtual void prepareGeometricData() override;
+};
 } // namespace SPH
 #endif // BASE_PARTICLE_GENERATOR_H
@@ -2,7 +2,9 @@
 
 #include "adaptation.h"
 #include "base_body.h"
+#include "base_mesh.h"
 #include "complex_shape.h"
+#include "mesh_iterators.hpp"
 
 namespace SPH
 {
@@ -20,11 +22,140 @@ GeneratingMethod<Lattice>::GeneratingMethod(SPHBody &sph_body)
     }
 }
 //=================================================================================================//
+template <typename FunctionOnContained>
+void GeneratingMethod<Lattice>::forEachContainedInBlock(
+    const Mesh &mesh, const Arrayi &block, const FunctionOnContained &function)
+{
+    Arrayi lower = block * lattice_block_size_;
+    Arrayi upper = (lower + lattice_block_size_).min(mesh.AllCells());
+    Vecd lower_position = mesh.CellPositionFromIndex(lower);
+    Vecd upper_position = mesh.CellPositionFromIndex(upper - Arrayi::Ones());
+    Vecd block_center = 0.5 * (lower_position + upper_position);
+    // the block is inside or outside as a whole if the surface is farther than its corners
+    Real threshold = 0.5 * (upper_position - lower_position).norm() + lattice_spacing_;
+    Real phi = initial_shape_.findSignedDistance(block_center);
+    if (ABS(phi) > threshold && initial_shape_.checkContain(block_center) == (phi < 0.0))
+    {
+        if (phi < 0.0)
+        {
+            mesh_for_each(lower, upper, function);
+        }
+        return;
+    }
+    mesh_for_each(lower, upper, [&](const Arrayi &index)
+                  {
+                      if (initial_shape_.checkContain(mesh.CellPositionFromIndex(index)))
+                          function(index); });
+}
+//=================================================================================================//
+StdVec<Vecd> GeneratingMethod<Lattice>::findContainedLatticePositions()
+{
+    Mesh mesh(domain_bounds_, lattice_spacing_, 0);
+    Arrayi number_of_lattices = mesh.AllCells();
+    Arrayi number_of_blocks = (number_of_lattices + (lattice_block_size_ - 1)) / lattice_block_size_;
+    auto linear_index = [&](const Arrayi &index)
+    {
+        size_t linear = 0;
+        for (int l = 0; l != Dimensions; ++l)
+            linear = linear * number_of_lattices[l] + index[l];
+        return linear;
+    };
+
+    StdVec<char> is_contained(number_of_lattices.cast<size_t>().prod(), 0);
+    mesh_parallel_for(
+        MeshRange(Arrayi::Zero(), number_of_blocks),
+        [&](const Arrayi &block)
+        {
+            forEachContainedInBlock(mesh, block, [&](const Arrayi &index)
+                                    { is_contained[linear_index(index)] = 1; });
+        });
+
+    StdVec<Vecd> contained_positions;
+    mesh_for_each(Arrayi::Zero(), number_of_lattices, [&](const Arrayi &index)
+                  {
+                      if (is_contained[linear_index(index)])
+                          contained_positions.push_back(mesh.CellPositionFromIndex(index)); });
+    return contained_positions;
+}
+//=================================================================================================//
 ParticleGenerator<BaseParticles, Lattice>::
     ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles)
     : ParticleGenerator<BaseParticles>(sph_body, base_particles),
       GeneratingMethod<Lattice>(sph_body) {}
 //=================================================================================================//
+ParticleGenerator<BaseParticles, Lattice, OutOfCore>::
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles)
+    : ParticleGenerator<BaseParticles, Lattice>(sph_body, base_particles),
+      number_of_blocks_(Arrayi::Zero()) {}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Lattice, OutOfCore>::prepareGeometricData()
+{
+    Mesh mesh(domain_bounds_, lattice_spacing_, 0);
+    number_of_blocks_ = (mesh.AllCells() + (lattice_block_size_ - 1)) / lattice_block_size_;
+    Arrayi number_of_blocks = number_of_blocks_;
+    auto block_linear_index = [&](const Arrayi &block)
+    {
+        size_t linear = 0;
+        for (int l = 0; l != Dimensions; ++l)
+            linear = linear * number_of_blocks[l] + block[l];
+        return linear;
+    };
+
+    StdVec<size_t> block_sizes(number_of_blocks.cast<size_t>().prod(), 0);
+    mesh_parallel_for(
+        MeshRange(Arrayi::Zero(), number_of_blocks),
+        [&](const Arrayi &block)
+        {
+            size_t block_size = 0;
+            forEachContainedInBlock(mesh, block, [&](const Arrayi &index)
+                                    { block_size++; });
+            block_sizes[block_linear_index(block)] = block_size;
+        });
+
+    block_offsets_.assign(block_sizes.size() + 1, 0);
+    for (size_t k = 0; k != block_sizes.size(); ++k)
+    {
+        block_offsets_[k + 1] = block_offsets_[k] + block_sizes[k];
+    }
+}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Lattice, OutOfCore>::setAllParticleBounds()
+{
+    base_particles_.initializeAllParticlesBounds(block_offsets_.back());
+}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, Lattice, OutOfCore>::initializeParticleVariables()
+{
+    base_particles_.registerPositionAndVolumetricMeasure();
+    Vecd *pos = base_particles_.ParticlePositions();
+    Real *Vol = base_particles_.VolumetricMeasures();
+    Real particle_volume = pow(lattice_spacing_, Dimensions);
+
+    Mesh mesh(domain_bounds_, lattice_spacing_, 0);
+    Arrayi number_of_blocks = number_of_blocks_;
+    auto block_linear_index = [&](const Arrayi &block)
+    {
+        size_t linear = 0;
+        for (int l = 0; l != Dimensions; ++l)
+            linear = linear * number_of_blocks[l] + block[l];
+        return linear;
+    };
+
+    mesh_parallel_for(
+        MeshRange(Arrayi::Zero(), number_of_blocks),
+        [&](const Arrayi &block)
+        {
+            size_t index_i = block_offsets_[block_linear_index(block)];
+            forEachContainedInBlock(mesh, block, [&](const Arrayi &index)
+                                    {
+                                        pos[index_i] = mesh.CellPositionFromIndex(index);
+                                        Vol[index_i] = particle_volume;
+                                        index_i++; });
+        });
+    block_offsets_.clear();
+    block_offsets_.shrink_to_fit();
+}
+//=================================================================================================//
 ParticleGenerator<BaseParticles, Lattice, Adaptive>::
     ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles, Shape &target_shape)
     : ParticleGenerator<BaseParticles, Lattice>(sph_body, base_particles),
@@ -36,8 +36,10 @@ namespace SPH
 {
 
 class Shape;
+class Mesh;
 class ParticleRefinementByShape;
 class SurfaceParticles;
+class OutOfCore; // Indicating particles generated directly into their variables
 
 template <> // Base class for generating particles from lattice positions
 class GeneratingMethod<Lattice>
@@ -47,9 +49,24 @@ class GeneratingMethod<Lattice>
     virtual ~GeneratingMethod(){};
 
   protected:
-    Real lattice_spacing_;      /**< Initial particle spacing. */
-    BoundingBox domain_bounds_; /**< Domain bounds. */
-    Shape &initial_shape_;      /**< Geometry shape for body. */
+    static constexpr int lattice_block_size_ = 8; /**< Lattice positions of a block in each dimension. */
+    Real lattice_spacing_;                        /**< Initial particle spacing. */
+    BoundingBox domain_bounds_;                   /**< Domain bounds. */
+    Shape &initial_shape_;                        /**< Geometry shape for body. */
+
+    /**
+     * Calls the function with the lattice index of each lattice position of the block
+     * contained by the initial shape, in the order of the lattice within the block.
+     */
+    template <typename FunctionOnContained>
+    void forEachContainedInBlock(const Mesh &mesh, const Arrayi &block, const FunctionOnContained &function);
+
+    /**
+     * The lattice positions contained by the initial shape, in the order of the lattice.
+     * The lattice is tiled into blocks classified in parallel by the signed distance at the block centers.
+     * Only the lattice positions in the blocks near the surface are checked one by one.
+     */
+    StdVec<Vecd> findContainedLatticePositions();
 };
 
 template <>
@@ -62,6 +79,29 @@ class ParticleGenerator<BaseParticles, Lattice>
     virtual void prepareGeometricData() override;
 };
 
+/**
+ * For generating the particles of giant bodies without temporary lattice results.
+ * The contained lattice positions are counted block by block first, and after the variables are
+ * registered, the positions of each block are written directly at its offset, so that the particles
+ * are in the spatial order of the blocks. The positions near the surface are checked twice instead.
+ * Together with ParticleMemory::useMappedFiles, the particles are streamed into mapped files,
+ * which can be written in the binary reload format for reuse.
+ */
+template <>
+class ParticleGenerator<BaseParticles, Lattice, OutOfCore> : public ParticleGenerator<BaseParticles, Lattice>
+{
+  public:
+    explicit ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles);
+    virtual ~ParticleGenerator(){};
+    virtual void prepareGeometricData() override;
+    virtual void setAllParticleBounds() override;
+    virtual void initializeParticleVariables() override;
+
+  protected:
+    Arrayi number_of_blocks_;
+    StdVec<size_t> block_offsets_; /**< Offsets of the particles of the blocks, with the total at the end. */
+};
+
 template <> // For generating particles with adaptive resolution from lattice positions
 class ParticleGenerator<BaseParticles, Lattice, Adaptive> : public ParticleGenerator<BaseParticles, Lattice>
 {
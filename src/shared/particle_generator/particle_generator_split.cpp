@@ -0,0 +1,40 @@
+#include "particle_generator_split.h"
+
+#include "base_body.h"
+#include "mesh_iterators.hpp"
+
+namespace SPH
+{
+//=================================================================================================//
+ParticleGenerator<BaseParticles, SplitFromCoarse>::
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles, SPHBody &coarse_body)
+    : ParticleGenerator<BaseParticles>(sph_body, base_particles),
+      coarse_particles_(coarse_body.getBaseParticles()),
+      initial_shape_(sph_body.getInitialShape()) {}
+//=================================================================================================//
+void ParticleGenerator<BaseParticles, SplitFromCoarse>::prepareGeometricData()
+{
+    Vecd *coarse_pos = coarse_particles_.ParticlePositions();
+    Real *coarse_Vol = coarse_particles_.getVariableDataByName<Real>("VolumetricMeasure");
+    size_t total_coarse_particles = coarse_particles_.TotalRealParticles();
+
+    for (size_t i = 0; i != total_coarse_particles; ++i)
+    {
+        // the children are on a local lattice of the target spacing centered at the coarse particle
+        Real coarse_spacing = pow(coarse_Vol[i], OneOverDimensions);
+        int number_of_splits = SMAX(int(std::round(coarse_spacing / particle_spacing_ref_)), 1);
+        Real child_spacing = coarse_spacing / Real(number_of_splits);
+        Real child_volume = coarse_Vol[i] / pow(Real(number_of_splits), Dimensions);
+        Vecd lower_child = coarse_pos[i] - 0.5 * Real(number_of_splits - 1) * child_spacing * Vecd::Ones();
+
+        mesh_for_each(Arrayi::Zero(), number_of_splits * Arrayi::Ones(),
+                      [&](const Arrayi &index)
+                      {
+                          Vecd child_position = lower_child + child_spacing * index.cast<Real>().matrix();
+                          if (initial_shape_.checkContain(child_position))
+                              addPositionAndVolumetricMeasure(child_position, child_volume);
+                      });
+    }
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,56 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file particle_generator_split.h
+ * @brief The split generator generates particles by splitting the particles
+ * of a relaxed coarser body, as the refinement step of a coarse-to-fine multilevel relaxation.
+ * The coarse body is usually defined with the same (level set) shape, so that
+ * the multilevel level set is built once and used for the boundary correction at all levels,
+ * and it is relaxed before the fine body is generated and relaxed briefly.
+ * @author Xiangyu Hu
+ */
+
+#ifndef PARTICLE_GENERATOR_SPLIT_H
+#define PARTICLE_GENERATOR_SPLIT_H
+
+#include "base_particle_generator.h"
+
+namespace SPH
+{
+class Shape;
+class SplitFromCoarse;
+
+template <> // For generating particles by splitting the particles of a coarser body
+class ParticleGenerator<BaseParticles, SplitFromCoarse> : public ParticleGenerator<BaseParticles>
+{
+  public:
+    ParticleGenerator(SPHBody &sph_body, BaseParticles &base_particles, SPHBody &coarse_body);
+    virtual ~ParticleGenerator(){};
+    virtual void prepareGeometricData() override;
+
+  protected:
+    BaseParticles &coarse_particles_;
+    Shape &initial_shape_;
+};
+} // namespace SPH
+#endif // PARTICLE_GENERATOR_SPLIT_H
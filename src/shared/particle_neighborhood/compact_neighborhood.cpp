@@ -0,0 +1,96 @@
+#include "compact_neighborhood.h"
+
+#include "particle_iterators.h"
+
+namespace SPH
+{
+//=================================================================================================//
+void CompactParticleConfiguration::
+    compactFrom(const ParticleConfiguration &particle_configuration, size_t total_particles)
+{
+    total_particles_ = total_particles;
+    neighbor_size_.assign(total_particles_ + 1, 0);
+    offset_.resize(total_particles_ + 1);
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_particles_),
+                 [&](size_t index_i)
+                 { neighbor_size_[index_i] = particle_configuration[index_i].current_size_; });
+    size_t total_neighbors = exclusive_scan(execution::ParallelPolicy(), neighbor_size_.data(), offset_.data(),
+                                            total_particles_ + 1, std::plus<size_t>());
+    resizeNeighborData(total_neighbors);
+
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_particles_),
+                 [&](size_t index_i)
+                 {
+                     const Neighborhood &neighborhood = particle_configuration[index_i];
+                     size_t first = offset_[index_i];
+                     for (size_t n = 0; n != neighborhood.current_size_; ++n)
+                     {
+                         j_[first + n] = static_cast<CompactIndex>(neighborhood.j_[n]);
+                         W_ij_[first + n] = static_cast<CompactReal>(neighborhood.W_ij_[n]);
+                         dW_ij_[first + n] = static_cast<CompactReal>(neighborhood.dW_ij_[n]);
+                         r_ij_[first + n] = static_cast<CompactReal>(neighborhood.r_ij_[n]);
+                         e_ij_[first + n] = neighborhood.e_ij_[n].cast<CompactReal>();
+                     }
+                 });
+}
+//=================================================================================================//
+void CompactParticleConfiguration::resizeNeighborData(size_t total_neighbors)
+{
+    // the buffers only grow so that no reallocation happens for a stable configuration
+    if (j_.size() < total_neighbors)
+    {
+        size_t new_size = total_neighbors + total_neighbors / 4;
+        j_.resize(new_size);
+        W_ij_.resize(new_size);
+        dW_ij_.resize(new_size);
+        r_ij_.resize(new_size);
+        e_ij_.resize(new_size);
+    }
+}
+//=================================================================================================//
+size_t CompactParticleConfiguration::MemoryFootprint() const
+{
+    return (neighbor_size_.capacity() + offset_.capacity()) * sizeof(size_t) + j_.capacity() * sizeof(CompactIndex) +
+           (W_ij_.capacity() + dW_ij_.capacity() + r_ij_.capacity()) * sizeof(CompactReal) +
+           e_ij_.capacity() * sizeof(CompactVecd);
+}
+//=================================================================================================//
+void CompactReferenceGradient::buildFrom(const ParticleConfiguration &particle_configuration,
+                                         size_t total_particles, const Real *Vol, const Matd *B)
+{
+    total_particles_ = total_particles;
+    neighbor_size_.assign(total_particles_ + 1, 0);
+    offset_.resize(total_particles_ + 1);
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_particles_),
+                 [&](size_t index_i)
+                 { neighbor_size_[index_i] = particle_configuration[index_i].current_size_; });
+    size_t total_neighbors = exclusive_scan(execution::ParallelPolicy(), neighbor_size_.data(), offset_.data(),
+                                            total_particles_ + 1, std::plus<size_t>());
+    j_.resize(total_neighbors);
+    gradW_ijV_j_.resize(total_neighbors);
+    corrected_gradW_ijV_j_.resize(total_neighbors);
+
+    particle_for(execution::ParallelPolicy(), IndexRange(0, total_particles_),
+                 [&](size_t index_i)
+                 {
+                     const Neighborhood &neighborhood = particle_configuration[index_i];
+                     Matd B_T = B[index_i].transpose();
+                     size_t first = offset_[index_i];
+                     for (size_t n = 0; n != neighborhood.current_size_; ++n)
+                     {
+                         size_t index_j = neighborhood.j_[n];
+                         Vecd gradW_ijV_j = neighborhood.dW_ij_[n] * Vol[index_j] * neighborhood.e_ij_[n];
+                         j_[first + n] = static_cast<CompactIndex>(index_j);
+                         gradW_ijV_j_[first + n] = gradW_ijV_j.cast<CompactReal>();
+                         corrected_gradW_ijV_j_[first + n] = (B_T * gradW_ijV_j).cast<CompactReal>();
+                     }
+                 });
+}
+//=================================================================================================//
+size_t CompactReferenceGradient::MemoryFootprint() const
+{
+    return (neighbor_size_.capacity() + offset_.capacity()) * sizeof(size_t) + j_.capacity() * sizeof(CompactIndex) +
+           (gradW_ijV_j_.capacity() + corrected_gradW_ijV_j_.capacity()) * sizeof(CompactVecd);
+}
+//=================================================================================================//
+} // namespace SPH
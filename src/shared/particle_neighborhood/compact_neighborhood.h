@@ -0,0 +1,155 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	compact_neighborhood.h
+ * @brief 	Compact, structure-of-arrays storage of a particle configuration.
+ * @details The classic particle configuration keeps several vectors for each particle.
+ * 			Here, the neighbors of all particles are saved in one contiguous buffer
+ * 			for each kind of data, addressed by per-particle offsets (CSR format).
+ * 			Neighbor indices are saved as 32-bit integers and kernel data in single precision.
+ * 			The compact storage is an extra read-only cache, not a replacement:
+ * 			it is copied from the classic configuration after each build so that
+ * 			all neighbor builders can be used unchanged, and the classic storage is kept.
+ * 			The copy costs several sweeps over the configuration, so the cache only pays off
+ * 			when the configuration is read many times between builds, e.g. when it is frozen
+ * 			or reused within the skin tolerance. The mid-level benchmarks in benchmarks_2d
+ * 			time the copy and a density summation reading either storage.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef COMPACT_NEIGHBORHOOD_H
+#define COMPACT_NEIGHBORHOOD_H
+
+#include "neighborhood.h"
+
+#include <cstdint>
+
+namespace SPH
+{
+using CompactIndex = uint32_t;
+using CompactReal = float;
+using CompactVecd = Eigen::Matrix<CompactReal, Dimensions, 1>;
+
+/**
+ * @class CompactNeighborhood
+ * @brief A light-weighted view on the neighbors of particle i in the compact storage.
+ */
+class CompactNeighborhood
+{
+  public:
+    size_t current_size_;       /**< the current number of neighbors */
+    const CompactIndex *j_;     /**< index of the neighbor particle. */
+    const CompactReal *W_ij_;   /**< kernel value or particle volume contribution */
+    const CompactReal *dW_ij_;  /**< derivative of kernel function or inter-particle surface contribution */
+    const CompactReal *r_ij_;   /**< distance between j and i. */
+    const CompactVecd *e_ij_;   /**< unit vector pointing from j to i or inter-particle surface direction */
+};
+
+/**
+ * @class CompactParticleConfiguration
+ * @brief Read-only copy of a particle configuration saved in CSR format with one buffer for each neighbor data.
+ */
+class CompactParticleConfiguration
+{
+  public:
+    CompactParticleConfiguration(){};
+    ~CompactParticleConfiguration(){};
+
+    /** rebuild the compact storage from a classic configuration */
+    void compactFrom(const ParticleConfiguration &particle_configuration, size_t total_particles);
+    size_t TotalParticles() const { return total_particles_; };
+    size_t TotalNeighbors() const { return offset_.empty() ? 0 : offset_[total_particles_]; };
+    size_t NeighborSize(size_t index_i) const { return offset_[index_i + 1] - offset_[index_i]; };
+    /** the memory for neighbor data in bytes */
+    size_t MemoryFootprint() const;
+
+    CompactNeighborhood operator[](size_t index_i) const
+    {
+        size_t first = offset_[index_i];
+        return CompactNeighborhood{NeighborSize(index_i), &j_[first], &W_ij_[first],
+                                   &dW_ij_[first], &r_ij_[first], &e_ij_[first]};
+    };
+
+  protected:
+    size_t total_particles_ = 0;
+    StdLargeVec<size_t> neighbor_size_; /**< temporary storage for the scan of neighbor sizes */
+    StdLargeVec<size_t> offset_; /**< the first neighbor of particle i, with total_particles_ + 1 entries */
+    StdLargeVec<CompactIndex> j_;
+    StdLargeVec<CompactReal> W_ij_;
+    StdLargeVec<CompactReal> dW_ij_;
+    StdLargeVec<CompactReal> r_ij_;
+    StdLargeVec<CompactVecd> e_ij_;
+
+    void resizeNeighborData(size_t total_neighbors);
+};
+
+/**
+ * @class CompactGradientNeighborhood
+ * @brief A light-weighted view on the precomputed reference gradients of particle i.
+ */
+class CompactGradientNeighborhood
+{
+  public:
+    size_t current_size_;                      /**< the current number of neighbors */
+    const CompactIndex *j_;                    /**< index of the neighbor particle. */
+    const CompactVecd *gradW_ijV_j_;           /**< dW_ij * V_j * e_ij */
+    const CompactVecd *corrected_gradW_ijV_j_; /**< B_i^T * dW_ij * V_j * e_ij */
+};
+
+/**
+ * @class CompactReferenceGradient
+ * @brief Kernel gradients weighted by the neighbor volume, and their corrected counterparts,
+ * 		  precomputed from a configuration which is not updated anymore,
+ * 		  such as the reference configuration of a total Lagrangian solid.
+ * 		  The neighbors are saved in the same order as the classic configuration
+ * 		  so that the pair index n can be used for both storages.
+ */
+class CompactReferenceGradient
+{
+  public:
+    CompactReferenceGradient(){};
+    ~CompactReferenceGradient(){};
+
+    void buildFrom(const ParticleConfiguration &particle_configuration, size_t total_particles,
+                   const Real *Vol, const Matd *B);
+    void clear() { total_particles_ = 0; };
+    bool isBuilt() const { return total_particles_ != 0; };
+    size_t MemoryFootprint() const;
+
+    CompactGradientNeighborhood operator[](size_t index_i) const
+    {
+        size_t first = offset_[index_i];
+        return CompactGradientNeighborhood{offset_[index_i + 1] - first, &j_[first],
+                                           &gradW_ijV_j_[first], &corrected_gradW_ijV_j_[first]};
+    };
+
+  protected:
+    size_t total_particles_ = 0;
+    StdLargeVec<size_t> neighbor_size_;
+    StdLargeVec<size_t> offset_;
+    StdLargeVec<CompactIndex> j_;
+    StdLargeVec<CompactVecd> gradW_ijV_j_;
+    StdLargeVec<CompactVecd> corrected_gradW_ijV_j_;
+};
+} // namespace SPH
+#endif // COMPACT_NEIGHBORHOOD_H
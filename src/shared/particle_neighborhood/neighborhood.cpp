@@ -8,6 +8,7 @@
 #include "all_complex_bodies.h"
 #include "base_particle_dynamics.h"
 #include "base_particles.hpp"
+#include "particle_iterators.h"
 
 namespace SPH
 {
@@ -22,32 +23,46 @@ void Neighborhood::removeANeighbor(size_t neighbor_n)
     e_ij_[neighbor_n] = e_ij_[current_size_];
 }
 //=================================================================================================//
-void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
-                                     const Vecd &displacement, size_t index_j)
+void Neighborhood::reserveForNewNeighbor()
 {
-    neighborhood.j_.push_back(index_j);
-    neighborhood.W_ij_.push_back(kernel_->W(distance, displacement));
-    neighborhood.dW_ij_.push_back(kernel_->dW(distance, displacement));
-    neighborhood.r_ij_.push_back(distance);
-    neighborhood.e_ij_.push_back(kernel_->e(distance, displacement));
-    neighborhood.allocated_size_++;
+    if (allocated_size_ == j_.capacity())
+    {
+        size_t new_capacity = ParticleCapacity::GrownCapacity(j_.capacity(), allocated_size_ + 1);
+        j_.reserve(new_capacity);
+        W_ij_.reserve(new_capacity);
+        dW_ij_.reserve(new_capacity);
+        r_ij_.reserve(new_capacity);
+        e_ij_.reserve(new_capacity);
+        ParticleCapacity::recordReallocation(new_capacity * (sizeof(size_t) + 3 * sizeof(Real) + sizeof(Vecd)));
+    }
 }
 //=================================================================================================//
-void NeighborBuilder::initializeNeighbor(Neighborhood &neighborhood, const Real &distance,
-                                         const Vecd &displacement, size_t index_j)
+void CountStatistics::join(const CountStatistics &other)
 {
-    size_t current_size = neighborhood.current_size_;
-    neighborhood.j_[current_size] = index_j;
-    neighborhood.W_ij_[current_size] = kernel_->W(distance, displacement);
-    neighborhood.dW_ij_[current_size] = kernel_->dW(distance, displacement);
-    neighborhood.r_ij_[current_size] = distance;
-    neighborhood.e_ij_[current_size] = kernel_->e(distance, displacement);
+    entries_ += other.entries_;
+    minimum_ = SMIN(minimum_, other.minimum_);
+    maximum_ = SMAX(maximum_, other.maximum_);
+    total_ += other.total_;
+    zeros_ += other.zeros_;
+    for (size_t k = 0; k != histogram_bins_; ++k)
+        histogram_[k] += other.histogram_[k];
+}
+//=================================================================================================//
+void CountStatistics::write(std::ostream &output, const std::string &name) const
+{
+    output << " " << name << ": entries " << entries_ << ", min " << Minimum()
+           << ", mean " << Mean() << ", max " << maximum_ << ", zero fraction " << ZeroFraction() << "\n";
+    output << "  histogram:";
+    for (size_t k = 0; k <= SMIN(maximum_, histogram_bins_ - 1); ++k)
+        output << " " << histogram_[k];
+    output << (maximum_ >= histogram_bins_ - 1 ? " (last bin and beyond)\n" : "\n");
 }
 //=================================================================================================//
 void NeighborBuilder::createNeighbor(Neighborhood &neighborhood, const Real &distance,
                                      const Vecd &displacement, size_t index_j,
                                      Real i_h_ratio, Real h_ratio_min)
 {
+    neighborhood.reserveForNewNeighbor();
     neighborhood.j_.push_back(index_j);
     Real weight = distance < kernel_->CutOffRadius(i_h_ratio) ? kernel_->W(i_h_ratio, distance, displacement) : 0.0;
     neighborhood.W_ij_.push_back(weight);
@@ -81,21 +96,6 @@ Kernel *NeighborBuilder::chooseKernel(SPHBody &body, SPHBody &target_body)
 NeighborBuilderInner::NeighborBuilderInner(SPHBody &body)
     : NeighborBuilder(body.sph_adaptation_->getKernel()) {}
 //=================================================================================================//
-void NeighborBuilderInner::operator()(Neighborhood &neighborhood,
-                                      const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
-{
-    size_t index_j = list_data_j.first;
-    Vecd displacement = pos_i - list_data_j.second;
-    Real distance_metric = displacement.squaredNorm();
-    if (kernel_->checkIfWithinCutOffRadius(displacement) && index_i != index_j)
-    {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j)
-            : initializeNeighbor(neighborhood, std::sqrt(distance_metric), displacement, index_j);
-        neighborhood.current_size_++;
-    }
-};
-//=================================================================================================//
 NeighborBuilderInnerAdaptive::
     NeighborBuilderInnerAdaptive(SPHBody &body)
     : NeighborBuilder(body.sph_adaptation_->getKernel()),
@@ -143,27 +143,13 @@ void NeighborBuilderSelfContact::operator()(Neighborhood &neighborhood,
 NeighborBuilderContact::NeighborBuilderContact(SPHBody &body, SPHBody &contact_body)
     : NeighborBuilder(NeighborBuilder::chooseKernel(body, contact_body)) {}
 //=================================================================================================//
-void NeighborBuilderContact::operator()(Neighborhood &neighborhood,
-                                        const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
-{
-    size_t index_j = list_data_j.first;
-    Vecd displacement = pos_i - list_data_j.second;
-    Real distance = displacement.norm();
-    if (distance < kernel_->CutOffRadius())
-    {
-        neighborhood.current_size_ >= neighborhood.allocated_size_
-            ? createNeighbor(neighborhood, distance, displacement, index_j)
-            : initializeNeighbor(neighborhood, distance, displacement, index_j);
-        neighborhood.current_size_++;
-    }
-};
-//=================================================================================================//
 NeighborBuilderSurfaceContact::NeighborBuilderSurfaceContact(SPHBody &body, SPHBody &contact_body)
     : NeighborBuilderContact(body, contact_body)
 {
     Real source_smoothing_length = body.sph_adaptation_->ReferenceSmoothingLength();
     Real target_smoothing_length = contact_body.sph_adaptation_->ReferenceSmoothingLength();
     kernel_ = kernel_keeper_.createPtr<KernelWendlandC2>(0.5 * (source_smoothing_length + target_smoothing_length));
+    resolveStaticKernel();
 }
 //=================================================================================================//
 NeighborBuilderContactBodyPart::NeighborBuilderContactBodyPart(SPHBody &body, BodyPart &contact_body_part)
@@ -219,17 +205,86 @@ void NeighborBuilderContactAdaptive::operator()(Neighborhood &neighborhood,
     }
 }
 //=================================================================================================//
-BaseNeighborBuilderContactShell::BaseNeighborBuilderContactShell(SPHBody &shell_body)
+BaseNeighborBuilderContactShell::BaseNeighborBuilderContactShell(SPHBody &shell_body, Real direction_corrector)
     : NeighborBuilder(shell_body.sph_adaptation_->getKernel()),
+      shell_particles_(&shell_body.getBaseParticles()),
       n_(shell_body.getBaseParticles().getVariableDataByName<Vecd>("NormalDirection")),
       thickness_(shell_body.getBaseParticles().getVariableDataByName<Real>("Thickness")),
       k1_ave_(shell_body.getBaseParticles().registerStateVariable<Real>("Average1stPrincipleCurvature")),
       k2_ave_(shell_body.getBaseParticles().registerStateVariable<Real>("Average2ndPrincipleCurvature")),
-      particle_distance_(shell_body.getSPHBodyResolutionRef()) {}
+      particle_distance_(shell_body.getSPHBodyResolutionRef()),
+      direction_corrector_(direction_corrector), is_curvature_cached_(false),
+      curvature_cache_tolerance_(0.0), cached_dummy_layers_(0) {}
+//=================================================================================================//
+void BaseNeighborBuilderContactShell::setCurvatureCacheTolerance(Real tolerance)
+{
+    is_curvature_cached_ = true;
+    curvature_cache_tolerance_ = tolerance;
+    cached_dummy_layers_ = 0; // all factors are recomputed at the next refresh
+}
+//=================================================================================================//
+void BaseNeighborBuilderContactShell::computeDummyVolumeFactors(size_t index_shell)
+{
+    const Real k1 = direction_corrector_ * k1_ave_[index_shell];
+    const Real k2 = direction_corrector_ * k2_ave_[index_shell];
+    Real *factors = &cached_dummy_volume_factors_[index_shell * cached_dummy_layers_];
+    bool is_valid = true;
+    for (UnsignedInt layer = 1; layer <= cached_dummy_layers_; ++layer)
+    {
+        const Real factor_1 = 1 + layer * k1 * particle_distance_;
+        const Real factor_2 = 1 + layer * k2 * particle_distance_;
+        is_valid = is_valid && factor_1 > 0 && factor_2 > 0;
+        factors[layer - 1] = is_valid ? factor_1 * factor_2 : 0.0;
+    }
+    cached_k1_[index_shell] = k1_ave_[index_shell];
+    cached_k2_[index_shell] = k2_ave_[index_shell];
+}
+//=================================================================================================//
+void BaseNeighborBuilderContactShell::refreshCurvatureCache()
+{
+    if (!is_curvature_cached_)
+        return;
+
+    size_t total_shell_particles = shell_particles_->TotalRealParticles();
+    // a dummy particle is not further than twice the cut-off radius from the shell particle
+    UnsignedInt dummy_layers = std::ceil(2.0 * kernel_->CutOffRadius() / particle_distance_) + 1;
+    if (dummy_layers != cached_dummy_layers_ || cached_k1_.size() < total_shell_particles)
+    {
+        cached_dummy_layers_ = dummy_layers;
+        cached_k1_.resize(total_shell_particles);
+        cached_k2_.resize(total_shell_particles);
+        cached_dummy_volume_factors_.resize(total_shell_particles * cached_dummy_layers_);
+        particle_for(execution::par, IndexRange(0, total_shell_particles),
+                     [&](size_t i)
+                     { computeDummyVolumeFactors(i); });
+        return;
+    }
+
+    particle_for(execution::par, IndexRange(0, total_shell_particles),
+                 [&](size_t i)
+                 {
+                     if (ABS(k1_ave_[i] - cached_k1_[i]) > curvature_cache_tolerance_ ||
+                         ABS(k2_ave_[i] - cached_k2_[i]) > curvature_cache_tolerance_)
+                         computeDummyVolumeFactors(i);
+                 });
+}
+//=================================================================================================//
+Real BaseNeighborBuilderContactShell::dummyVolumeFactor(size_t index_shell, int layer)
+{
+    if (is_curvature_cached_ && UnsignedInt(layer) <= cached_dummy_layers_)
+        return cached_dummy_volume_factors_[index_shell * cached_dummy_layers_ + layer - 1];
+
+    // k1 and k2 are principle curvatures of the shell
+    // For 2d, k1 is the curvature, k2 = 0
+    const Real factor_1 = 1 + layer * direction_corrector_ * k1_ave_[index_shell] * particle_distance_;
+    const Real factor_2 = 1 + layer * direction_corrector_ * k2_ave_[index_shell] * particle_distance_;
+    return factor_1 <= 0 || factor_2 <= 0 ? 0.0 : factor_1 * factor_2;
+}
 //=================================================================================================//
 void BaseNeighborBuilderContactShell::createNeighbor(Neighborhood &neighborhood, const Real &distance,
                                                      size_t index_j, const Real &W_ij, const Real &dW_ij, const Vecd &e_ij)
 {
+    neighborhood.reserveForNewNeighbor();
     neighborhood.j_.push_back(index_j);
     neighborhood.W_ij_.push_back(W_ij);
     neighborhood.dW_ij_.push_back(dW_ij);
@@ -250,10 +305,7 @@ void BaseNeighborBuilderContactShell::initializeNeighbor(Neighborhood &neighborh
 }
 //=================================================================================================//
 BaseNeighborBuilderContactFromShell::BaseNeighborBuilderContactFromShell(SPHBody &body, SPHBody &contact_body, bool normal_correction)
-    : BaseNeighborBuilderContactShell(contact_body),
-      direction_corrector_(normal_correction ? -1 : 1)
-{
-}
+    : BaseNeighborBuilderContactShell(contact_body, normal_correction ? -1 : 1) {}
 //=================================================================================================//
 void BaseNeighborBuilderContactFromShell::update_neighbors(Neighborhood &neighborhood,
                                                            const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
@@ -277,20 +329,13 @@ void BaseNeighborBuilderContactFromShell::update_neighbors(Neighborhood &neighbo
         Vecd displacement_dummy = pos_i - pos_j_dummy;
         Real distance_dummy = displacement_dummy.norm();
 
-        // k1 and k2 are principle curvatures of the shell
-        // For 2d, k1 is the curvature, k2 = 0
-        const Real k1_j = direction_corrector_ * k1_ave_[index_j];
-        const Real k2_j = direction_corrector_ * k2_ave_[index_j];
-
         int counter = 0;
         while (distance_dummy < kernel_->CutOffRadius())
         {
             counter++;
-            const Real factor_1 = 1 + counter * k1_j * particle_distance_;
-            const Real factor_2 = 1 + counter * k2_j * particle_distance_;
-            if (factor_1 <= 0 || factor_2 <= 0)
+            const Real Vol_j_dummy = dummyVolumeFactor(index_j, counter);
+            if (Vol_j_dummy <= 0)
                 break;
-            const Real Vol_j_dummy = factor_1 * factor_2;
             Real dW_ijV_j = kernel_->dW(distance_dummy, displacement_dummy) * Vol_j_dummy;
             Vecd e_ij = displacement_dummy / distance_dummy;
             W_ijV_j_ttl += kernel_->W(distance_dummy, displacement_dummy) * Vol_j_dummy;
@@ -322,13 +367,14 @@ NeighborBuilderContactFromShellToFluid::NeighborBuilderContactFromShellToFluid(S
     if (fluid_reference_spacing < shell_reference_spacing)
         throw std::runtime_error("NeighborBuilderContactToShell: fluid spacing should be larger or equal than shell spacing...");
     kernel_ = body.sph_adaptation_->getKernel();
+    resolveStaticKernel();
 }
 //=================================================================================================//
 NeighborBuilderContactFromFluidToShell::NeighborBuilderContactFromFluidToShell(SPHBody &body, SPHBody &contact_body, bool normal_correction)
-    : BaseNeighborBuilderContactShell(body),
-      direction_corrector_(normal_correction ? -1 : 1)
+    : BaseNeighborBuilderContactShell(body, normal_correction ? -1 : 1)
 {
     kernel_ = NeighborBuilder::chooseKernel(body, contact_body);
+    resolveStaticKernel();
 }
 //=================================================================================================//
 void NeighborBuilderContactFromFluidToShell::operator()(Neighborhood &neighborhood,
@@ -354,20 +400,13 @@ void NeighborBuilderContactFromFluidToShell::operator()(Neighborhood &neighborho
         Vecd displacement_dummy = pos_i_dummy - pos_j;
         Real distance_dummy = displacement_dummy.norm();
 
-        // k1 and k2 are principle curvatures of the shell
-        // For 2d, k1 is the curvature, k2 = 0
-        const Real k1_i = direction_corrector_ * k1_ave_[index_i];
-        const Real k2_i = direction_corrector_ * k2_ave_[index_i];
-
         int counter = 0;
         while (distance_dummy < kernel_->CutOffRadius())
         {
             counter++;
-            const Real factor_1 = 1 + counter * k1_i * particle_distance_;
-            const Real factor_2 = 1 + counter * k2_i * particle_distance_;
-            if (factor_1 <= 0 || factor_2 <= 0)
+            const Real Vol_i_factor = dummyVolumeFactor(index_i, counter);
+            if (Vol_i_factor <= 0)
                 break;
-            const Real Vol_i_factor = factor_1 * factor_2;
 
             Real dW_ijV_j = kernel_->dW(distance_dummy, displacement_dummy) * Vol_i_factor;
             Vecd e_ij = displacement_dummy / distance_dummy;
@@ -396,6 +435,7 @@ ShellNeighborBuilderInnerWithContactKernel::ShellNeighborBuilderInnerWithContact
     // create a reduced kernel with refined smoothing length for shell
     Real smoothing_length = contact_body.sph_adaptation_->ReferenceSmoothingLength();
     kernel_ = kernel_keeper_.createPtr<KernelWendlandC2>(smoothing_length);
+    resolveStaticKernel();
     kernel_->reduceOnce();
 }
 //=================================================================================================//
@@ -409,6 +449,7 @@ NeighborBuilderShellSelfContact::
     // create a unreduced kernel for shell self contact
     Real smoothing_length = body.sph_adaptation_->ReferenceSmoothingLength();
     kernel_ = kernel_keeper_.createPtr<KernelWendlandC2>(smoothing_length);
+    resolveStaticKernel();
 }
 //=================================================================================================//
 void NeighborBuilderShellSelfContact::operator()(Neighborhood &neighborhood,
@@ -480,6 +521,7 @@ NeighborBuilderSurfaceContactFromShell::NeighborBuilderSurfaceContactFromShell(S
     Real source_smoothing_length = body.sph_adaptation_->ReferenceSmoothingLength();
     Real target_smoothing_length = contact_body.sph_adaptation_->ReferenceSmoothingLength();
     kernel_ = kernel_keeper_.createPtr<KernelWendlandC2>(0.5 * (source_smoothing_length + target_smoothing_length));
+    resolveStaticKernel();
 }
 //=================================================================================================//
 NeighborBuilderSurfaceContactFromSolid::NeighborBuilderSurfaceContactFromSolid(SPHBody &body, SPHBody &contact_body)
@@ -493,6 +535,7 @@ NeighborBuilderSurfaceContactFromSolid::NeighborBuilderSurfaceContactFromSolid(S
 void NeighborBuilderSurfaceContactFromSolid::createNeighbor(Neighborhood &neighborhood, const Real &distance,
                                                             const Vecd &displacement, size_t index_j)
 {
+    neighborhood.reserveForNewNeighbor();
     neighborhood.j_.push_back(index_j);
     neighborhood.W_ij_.push_back(std::max(kernel_->W(distance, displacement) - offset_W_ij_, Real(0)));
     neighborhood.dW_ij_.push_back(kernel_->dW(distance, displacement));
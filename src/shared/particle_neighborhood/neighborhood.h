@@ -35,6 +35,8 @@
 #include "base_data_package.h"
 #include "sphinxsys_containers.h"
 
+#include <typeinfo>
+
 namespace SPH
 {
 
@@ -42,6 +44,167 @@ class SPHBody;
 class BodyPart;
 class SPHAdaptation;
 
+/**
+ * @class PeriodicImage
+ * @brief Periodicity handled inside the neighbor search without ghost particles or extra list entries.
+ *        A particle near a periodic bound also searches around its images shifted by the periodic translation,
+ *        and the displacement to a neighbor found so is corrected by the same shift.
+ *        All axes may be periodic at once. The periodic translation is zero along non-periodic axes.
+ *        It is a plain value so that it can be copied into computing kernels.
+ */
+class PeriodicImage
+{
+  public:
+    PeriodicImage()
+        : is_periodic_(false), periodic_translation_(Vecd::Zero()),
+          lower_bound_(Vecd::Zero()), upper_bound_(Vecd::Zero()){};
+    void setPeriodicAxis(const Vecd &lower_bound, const Vecd &upper_bound, int axis)
+    {
+        lower_bound_[axis] = lower_bound[axis];
+        upper_bound_[axis] = upper_bound[axis];
+        periodic_translation_[axis] = upper_bound[axis] - lower_bound[axis];
+        is_periodic_ = true;
+    };
+    bool isPeriodic() const { return is_periodic_; };
+    Vecd PeriodicTranslation() const { return periodic_translation_; };
+
+    /** Image shifts of a position within search range of periodic bounds.
+     *  The first one is always zero and the number of shifts, at most 2^Dimensions, is returned. */
+    inline int ImageShifts(const Vecd &position, Real search_range, Vecd *shifts) const
+    {
+        int number_of_shifts = 1;
+        shifts[0] = Vecd::Zero();
+        if (!is_periodic_)
+            return number_of_shifts;
+
+        for (int axis = 0; axis != Dimensions; ++axis)
+        {
+            if (periodic_translation_[axis] > 0.0)
+            {
+                Real shift = 0.0;
+                if (position[axis] < lower_bound_[axis] + search_range)
+                    shift = periodic_translation_[axis];
+                else if (position[axis] > upper_bound_[axis] - search_range)
+                    shift = -periodic_translation_[axis];
+
+                if (shift != 0.0)
+                {
+                    for (int n = 0; n != number_of_shifts; ++n)
+                    {
+                        shifts[number_of_shifts + n] = shifts[n];
+                        shifts[number_of_shifts + n][axis] = shift;
+                    }
+                    number_of_shifts *= 2;
+                }
+            }
+        }
+        return number_of_shifts;
+    };
+
+    /** the displacement to the nearest periodic image */
+    inline Vecd MinimumImage(const Vecd &displacement) const
+    {
+        if (!is_periodic_)
+            return displacement;
+
+        Vecd minimum_image = displacement;
+        for (int axis = 0; axis != Dimensions; ++axis)
+        {
+            if (periodic_translation_[axis] > 0.0)
+            {
+                if (minimum_image[axis] > 0.5 * periodic_translation_[axis])
+                    minimum_image[axis] -= periodic_translation_[axis];
+                else if (minimum_image[axis] < -0.5 * periodic_translation_[axis])
+                    minimum_image[axis] += periodic_translation_[axis];
+            }
+        }
+        return minimum_image;
+    };
+
+  protected:
+    bool is_periodic_;
+    Vecd periodic_translation_;
+    Vecd lower_bound_;
+    Vecd upper_bound_;
+};
+
+/**
+ * @class CellRelativePosition
+ * @brief Positions kept as the integral coordinates of a cell and the offset from the cell corner.
+ *        The displacement between near particles is then computed from the small difference of
+ *        the cell coordinates and the offsets, without the round-off of large absolute positions
+ *        in single precision. The cell coordinates are integral values stored as reals,
+ *        which are exact up to 2^24 cells along an axis in float.
+ *        It is a plain value so that it can be copied into computing kernels.
+ */
+class CellRelativePosition
+{
+  public:
+    CellRelativePosition() : origin_(Vecd::Zero()), cell_size_(1.0), inv_cell_size_(1.0){};
+    CellRelativePosition(const Vecd &origin, Real cell_size)
+        : origin_(origin), cell_size_(cell_size), inv_cell_size_(1.0 / cell_size){};
+    Vecd Origin() const { return origin_; };
+    Real CellSize() const { return cell_size_; };
+    bool isSameFrame(const CellRelativePosition &other) const
+    {
+        return origin_ == other.origin_ && cell_size_ == other.cell_size_;
+    };
+
+    inline void encode(const Vecd &position, Vecd &cell, Vecd &offset) const
+    {
+        Vecd relative_position = position - origin_;
+        cell = (relative_position * inv_cell_size_).array().floor().matrix();
+        offset = relative_position - cell * cell_size_;
+    };
+    inline Vecd decode(const Vecd &cell, const Vecd &offset) const
+    {
+        return origin_ + cell * cell_size_ + offset;
+    };
+    inline Vecd displacement(const Vecd &cell_i, const Vecd &offset_i,
+                             const Vecd &cell_j, const Vecd &offset_j) const
+    {
+        return (cell_i - cell_j) * cell_size_ + (offset_i - offset_j);
+    };
+    /** moves by a displacement, the offset carried over to the cell when leaving the cell */
+    inline void shift(Vecd &cell, Vecd &offset, const Vecd &displacement) const
+    {
+        offset += displacement;
+        Vecd carry = (offset * inv_cell_size_).array().floor().matrix();
+        cell += carry;
+        offset -= carry * cell_size_;
+    };
+    /** encodes the position, which is then decoded so that both agree exactly */
+    inline void encodeAndDecode(Vecd &position, Vecd &cell, Vecd &offset) const
+    {
+        encode(position, cell, offset);
+        position = decode(cell, offset);
+    };
+    /** encodes again a position changed without its cell-relative position */
+    inline void encodeIfStale(Vecd &position, Vecd &cell, Vecd &offset) const
+    {
+        if (decode(cell, offset) != position)
+            encodeAndDecode(position, cell, offset);
+    };
+
+  protected:
+    Vecd origin_;
+    Real cell_size_;
+    Real inv_cell_size_;
+};
+
+/**
+ * With the compressed neighborhood, the neighbor indices are 32-bit and the scalar pair data are float
+ * also in double builds, which nearly halves the memory and bandwidth of the neighbor data.
+ * The pair data are read as values, and the particle number of a body is limited to 2^32.
+ */
+#if SPHINXSYS_USE_COMPRESSED_NEIGHBORHOOD
+using NeighborIndex = uint32_t;
+using NeighborReal = float;
+#else
+using NeighborIndex = size_t;
+using NeighborReal = Real;
+#endif // SPHINXSYS_USE_COMPRESSED_NEIGHBORHOOD
+
 /**
  * @class Neighborhood
  * @brief A neighborhood around particle i.
@@ -52,19 +215,74 @@ class Neighborhood
     size_t current_size_;   /**< the current number of neighbors */
     size_t allocated_size_; /**< the limit of neighbors does not require memory allocation  */
 
-    StdLargeVec<size_t> j_;   /**< index of the neighbor particle. */
-    StdLargeVec<Real> W_ij_;  /**< kernel value or particle volume contribution */
-    StdLargeVec<Real> dW_ij_; /**< derivative of kernel function or inter-particle surface contribution */
-    StdLargeVec<Real> r_ij_;  /**< distance between j and i. */
-    StdLargeVec<Vecd> e_ij_;  /**< unit vector pointing from j to i or inter-particle surface direction */
+    StdLargeVec<NeighborIndex> j_;  /**< index of the neighbor particle. */
+    StdLargeVec<NeighborReal> W_ij_;  /**< kernel value or particle volume contribution */
+    StdLargeVec<NeighborReal> dW_ij_; /**< derivative of kernel function or inter-particle surface contribution */
+    StdLargeVec<NeighborReal> r_ij_;  /**< distance between j and i. */
+    StdLargeVec<Vecd> e_ij_;          /**< unit vector pointing from j to i or inter-particle surface direction */
 
     Neighborhood() : current_size_(0), allocated_size_(0){};
     ~Neighborhood(){};
 
     void removeANeighbor(size_t neighbor_n);
+    /** grows the capacities of all pair vectors together by the capacity policy before a neighbor is created */
+    void reserveForNewNeighbor();
 };
 using ParticleConfiguration = StdLargeVec<Neighborhood>;
 
+/**
+ * @class CountStatistics
+ * @brief Minimum, mean and maximum of counts, such as the neighbors of particles or the particles in cells,
+ *        with a histogram of unit bins of which the last one also collects all larger counts.
+ */
+class CountStatistics
+{
+  public:
+    static constexpr size_t histogram_bins_ = 128;
+    size_t entries_ = 0;
+    size_t minimum_ = std::numeric_limits<size_t>::max();
+    size_t maximum_ = 0;
+    size_t total_ = 0;
+    size_t zeros_ = 0; /**< entries without any count, e.g. empty cells */
+    StdVec<size_t> histogram_;
+
+    CountStatistics() : histogram_(histogram_bins_, 0){};
+    void include(size_t count)
+    {
+        entries_++;
+        minimum_ = SMIN(minimum_, count);
+        maximum_ = SMAX(maximum_, count);
+        total_ += count;
+        zeros_ += count == 0 ? 1 : 0;
+        histogram_[SMIN(count, histogram_bins_ - 1)]++;
+    };
+    void join(const CountStatistics &other);
+    size_t Minimum() const { return entries_ != 0 ? minimum_ : 0; };
+    Real Mean() const { return entries_ != 0 ? Real(total_) / Real(entries_) : 0.0; };
+    Real ZeroFraction() const { return entries_ != 0 ? Real(zeros_) / Real(entries_) : 0.0; };
+    /** the histogram is written up to the maximum count */
+    void write(std::ostream &output, const std::string &name) const;
+};
+
+/** statistics of the counts given for the indices in [0, number_of_entries), computed in parallel */
+template <typename GetCount>
+CountStatistics computeCountStatistics(size_t number_of_entries, const GetCount &get_count)
+{
+    return tbb::parallel_reduce(
+        tbb::blocked_range<size_t>(0, number_of_entries), CountStatistics(),
+        [&](const tbb::blocked_range<size_t> &range, CountStatistics statistics) -> CountStatistics
+        {
+            for (size_t i = range.begin(); i != range.end(); ++i)
+                statistics.include(get_count(i));
+            return statistics;
+        },
+        [](CountStatistics a, const CountStatistics &b) -> CountStatistics
+        {
+            a.join(b);
+            return a;
+        });
+};
+
 /**
  * @class NeighborBuilder
  * @brief Base class for building a neighbor particle j around particles i.
@@ -73,11 +291,71 @@ class NeighborBuilder
 {
   protected:
     Kernel *kernel_;
+    /** Non-null if the kernel is the default WendlandC2 kernel, which is then evaluated without virtual dispatch. */
+    KernelWendlandC2 *wendland_c2_kernel_;
+    /** To be called whenever kernel_ is reassigned.
+     *  The exact type is required, as derived kernels, e.g. anisotropic ones, override the evaluations. */
+    void resolveStaticKernel()
+    {
+        wendland_c2_kernel_ = typeid(*kernel_) == typeid(KernelWendlandC2) ? static_cast<KernelWendlandC2 *>(kernel_) : nullptr;
+    };
     //----------------------------------------------------------------------
-    //	Below are for constant smoothing length.
+    //	Below are for constant smoothing length,
+    //  defined inline so that they are inlined into the search loops.
     //----------------------------------------------------------------------
-    void createNeighbor(Neighborhood &neighborhood, const Real &distance, const Vecd &displacement, size_t j_index);
-    void initializeNeighbor(Neighborhood &neighborhood, const Real &distance, const Vecd &displacement, size_t j_index);
+    template <class KernelType>
+    inline void createNeighbor(KernelType &kernel, Neighborhood &neighborhood,
+                               const Real &distance, const Vecd &displacement, size_t j_index)
+    {
+        neighborhood.reserveForNewNeighbor();
+        neighborhood.j_.push_back(j_index);
+        neighborhood.W_ij_.push_back(kernel.W(distance, displacement));
+        neighborhood.dW_ij_.push_back(kernel.dW(distance, displacement));
+        neighborhood.r_ij_.push_back(distance);
+        neighborhood.e_ij_.push_back(kernel.e(distance, displacement));
+        neighborhood.allocated_size_++;
+    };
+    template <class KernelType>
+    inline void initializeNeighbor(KernelType &kernel, Neighborhood &neighborhood,
+                                   const Real &distance, const Vecd &displacement, size_t j_index)
+    {
+        size_t current_size = neighborhood.current_size_;
+        neighborhood.j_[current_size] = j_index;
+        neighborhood.W_ij_[current_size] = kernel.W(distance, displacement);
+        neighborhood.dW_ij_[current_size] = kernel.dW(distance, displacement);
+        neighborhood.r_ij_[current_size] = distance;
+        neighborhood.e_ij_[current_size] = kernel.e(distance, displacement);
+    };
+    template <class KernelType>
+    inline void addNeighbor(KernelType &kernel, Neighborhood &neighborhood,
+                            const Real &distance, const Vecd &displacement, size_t j_index)
+    {
+        neighborhood.current_size_ >= neighborhood.allocated_size_
+            ? createNeighbor(kernel, neighborhood, distance, displacement, j_index)
+            : initializeNeighbor(kernel, neighborhood, distance, displacement, j_index);
+        neighborhood.current_size_++;
+    };
+    inline void createNeighbor(Neighborhood &neighborhood, const Real &distance, const Vecd &displacement, size_t j_index)
+    {
+        createNeighbor(*kernel_, neighborhood, distance, displacement, j_index);
+    };
+    inline void initializeNeighbor(Neighborhood &neighborhood, const Real &distance, const Vecd &displacement, size_t j_index)
+    {
+        initializeNeighbor(*kernel_, neighborhood, distance, displacement, j_index);
+    };
+    /** Adds a neighbor with the kernel evaluated by static dispatch if possible. */
+    inline void addNeighbor(Neighborhood &neighborhood, const Real &distance, const Vecd &displacement, size_t j_index)
+    {
+        if (wendland_c2_kernel_ != nullptr)
+        {
+            StaticDispatchEvaluation<KernelWendlandC2> wendland_c2_kernel(*wendland_c2_kernel_);
+            addNeighbor(wendland_c2_kernel, neighborhood, distance, displacement, j_index);
+        }
+        else
+        {
+            addNeighbor(*kernel_, neighborhood, distance, displacement, j_index);
+        }
+    };
     //----------------------------------------------------------------------
     //	Below are for variable smoothing length.
     //----------------------------------------------------------------------
@@ -88,7 +366,7 @@ class NeighborBuilder
     static Kernel *chooseKernel(SPHBody &body, SPHBody &target_body);
 
   public:
-    NeighborBuilder(Kernel *kernel) : kernel_(kernel){};
+    NeighborBuilder(Kernel *kernel) : kernel_(kernel) { resolveStaticKernel(); };
     virtual ~NeighborBuilder(){};
     virtual void operator()(Neighborhood &neighborhood,
                             const Vecd &pos_i, size_t index_i, const ListData &list_data_j) = 0;
@@ -102,8 +380,37 @@ class NeighborBuilderInner : public NeighborBuilder
 {
   public:
     explicit NeighborBuilderInner(SPHBody &body);
-    void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+    inline void operator()(Neighborhood &neighborhood,
+                           const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final
+    {
+        size_t index_j = list_data_j.first;
+        Vecd displacement = pos_i - list_data_j.second;
+        if (kernel_->checkIfWithinCutOffRadius(displacement) && index_i != index_j)
+        {
+            addNeighbor(neighborhood, displacement.norm(), displacement, index_j);
+        }
+    };
+};
+
+/**
+ * @class StaticNeighborBuilder
+ * @brief Calls the operator of a builder of exactly the given type without virtual dispatch,
+ *        so that the neighbor building is inlined into the search loop, e.g. for the builders
+ *        kept by base pointers but of a type which has derived builders.
+ */
+template <class NeighborBuilderType>
+class StaticNeighborBuilder
+{
+    NeighborBuilderType &neighbor_builder_;
+
+  public:
+    explicit StaticNeighborBuilder(NeighborBuilderType &neighbor_builder)
+        : neighbor_builder_(neighbor_builder){};
+    inline void operator()(Neighborhood &neighborhood,
+                           const Vecd &pos_i, size_t index_i, const ListData &list_data_j)
+    {
+        neighbor_builder_.NeighborBuilderType::operator()(neighborhood, pos_i, index_i, list_data_j);
+    };
 };
 
 /**
@@ -115,7 +422,7 @@ class NeighborBuilderInnerAdaptive : public NeighborBuilder
   public:
     explicit NeighborBuilderInnerAdaptive(SPHBody &body);
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 
   protected:
     Real *h_ratio_;
@@ -131,7 +438,7 @@ class NeighborBuilderSelfContact : public NeighborBuilder
     explicit NeighborBuilderSelfContact(SPHBody &body);
     virtual ~NeighborBuilderSelfContact(){};
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 
   protected:
     Vecd *pos0_;
@@ -146,8 +453,17 @@ class NeighborBuilderContact : public NeighborBuilder
   public:
     NeighborBuilderContact(SPHBody &body, SPHBody &contact_body);
     virtual ~NeighborBuilderContact(){};
-    virtual void operator()(Neighborhood &neighborhood,
-                            const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+    inline virtual void operator()(Neighborhood &neighborhood,
+                                   const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override
+    {
+        size_t index_j = list_data_j.first;
+        Vecd displacement = pos_i - list_data_j.second;
+        Real distance = displacement.norm();
+        if (distance < kernel_->CutOffRadius())
+        {
+            addNeighbor(neighborhood, distance, displacement, index_j);
+        }
+    };
 };
 
 /**
@@ -174,7 +490,7 @@ class NeighborBuilderContactBodyPart : public NeighborBuilder
     NeighborBuilderContactBodyPart(SPHBody &body, BodyPart &contact_body_part);
     virtual ~NeighborBuilderContactBodyPart(){};
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 
   protected:
     int *part_indicator_; /**< indicator of the body part */
@@ -190,7 +506,7 @@ class NeighborBuilderContactAdaptive : public NeighborBuilder
     explicit NeighborBuilderContactAdaptive(SPHBody &body, SPHBody &contact_body);
     virtual ~NeighborBuilderContactAdaptive(){};
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 
   protected:
     SPHAdaptation &adaptation_, &contact_adaptation_;
@@ -204,15 +520,35 @@ class NeighborBuilderContactAdaptive : public NeighborBuilder
 class BaseNeighborBuilderContactShell : public NeighborBuilder
 {
   public:
-    explicit BaseNeighborBuilderContactShell(SPHBody &shell_body);
+    explicit BaseNeighborBuilderContactShell(SPHBody &shell_body, Real direction_corrector = 1.0);
+    /**
+     * The curvature-dependent volume factors of the dummy particles along the shell normal
+     * are cached for each shell particle and only recomputed for the particles whose curvature
+     * has changed by more than the tolerance since the last refresh,
+     * e.g. for rigid or slowly deforming shells.
+     */
+    void setCurvatureCacheTolerance(Real tolerance);
+    /** called before searching the neighbors, does nothing if the cache is not used */
+    void refreshCurvatureCache();
 
   protected:
     UniquePtrKeeper<Kernel> kernel_keeper_;
+    BaseParticles *shell_particles_;
     Vecd *n_; // normal direction of contact body
     Real *thickness_;
     Real *k1_ave_;           // 1st principle curvature of contact body
     Real *k2_ave_;           // 2nd principle curvature of contact body
     Real particle_distance_; // reference spacing of contact body
+    Real direction_corrector_;
+    bool is_curvature_cached_;
+    Real curvature_cache_tolerance_;
+    UnsignedInt cached_dummy_layers_;
+    StdLargeVec<Real> cached_k1_, cached_k2_;
+    StdLargeVec<Real> cached_dummy_volume_factors_; // zero from the first invalid layer on
+
+    /** non-positive for the layer and beyond where the shell curvature makes the dummy particles invalid */
+    Real dummyVolumeFactor(size_t index_shell, int layer);
+    void computeDummyVolumeFactors(size_t index_shell);
 
     void createNeighbor(Neighborhood &neighborhood, const Real &distance,
                         size_t index_j, const Real &W_ij,
@@ -234,9 +570,6 @@ class BaseNeighborBuilderContactFromShell : public BaseNeighborBuilderContactShe
   protected:
     void update_neighbors(Neighborhood &neighborhood, const Vecd &pos_i, size_t index_i,
                           const ListData &list_data_j);
-
-  private:
-    Real direction_corrector_;
 };
 
 /**
@@ -248,7 +581,7 @@ class NeighborBuilderContactFromShellToFluid : public BaseNeighborBuilderContact
   public:
     NeighborBuilderContactFromShellToFluid(SPHBody &body, SPHBody &contact_body, bool normal_correction);
     inline void operator()(Neighborhood &neighborhood,
-                           const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override
+                           const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final
     {
         update_neighbors(neighborhood, pos_i, index_i, list_data_j);
     };
@@ -263,10 +596,7 @@ class NeighborBuilderContactFromFluidToShell : public BaseNeighborBuilderContact
   public:
     NeighborBuilderContactFromFluidToShell(SPHBody &body, SPHBody &contact_body, bool normal_correction);
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
-
-  private:
-    Real direction_corrector_;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 };
 
 /**
@@ -292,7 +622,7 @@ class NeighborBuilderShellSelfContact : public BaseNeighborBuilderContactShell
   public:
     explicit NeighborBuilderShellSelfContact(SPHBody &body);
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 
   private:
     Real *k1_; // 1st principle curvature of contact body
@@ -309,7 +639,7 @@ class NeighborBuilderSurfaceContactFromShell : public BaseNeighborBuilderContact
   public:
     NeighborBuilderSurfaceContactFromShell(SPHBody &body, SPHBody &contact_body, bool normal_correction);
     inline void operator()(Neighborhood &neighborhood,
-                           const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override
+                           const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final
     {
         update_neighbors(neighborhood, pos_i, index_i, list_data_j);
     }
@@ -330,7 +660,7 @@ class NeighborBuilderSurfaceContactFromSolid : public NeighborBuilderSurfaceCont
     NeighborBuilderSurfaceContactFromSolid(SPHBody &body, SPHBody &contact_body);
     ~NeighborBuilderSurfaceContactFromSolid() override = default;
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 };
 
 /**
@@ -343,7 +673,7 @@ class NeighborBuilderSplitInnerAdaptive : public NeighborBuilder
   public:
     explicit NeighborBuilderSplitInnerAdaptive(SPHBody &body);
     void operator()(Neighborhood &neighborhood,
-                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) override;
+                    const Vecd &pos_i, size_t index_i, const ListData &list_data_j) final;
 
   private:
     Real *h_ratio_;
@@ -4,13 +4,15 @@
 #include "base_body_part.h"
 #include "base_material.h"
 #include "base_particle_generator.h"
+#include "particle_iterators.h"
 #include "xml_parser.h"
 
 namespace SPH
 {
 //=================================================================================================//
 BaseParticles::BaseParticles(SPHBody &sph_body, BaseMaterial *base_material)
-    : v_total_real_particles_(nullptr), real_particles_bound_(0), particles_bound_(0),
+    : memory_resource_(ParticleMemory::createResource()),
+      v_total_real_particles_(nullptr), real_particles_bound_(0), particles_bound_(0),
       original_id_(nullptr), sorted_id_(nullptr),
       pos_(nullptr), Vol_(nullptr), rho_(nullptr), mass_(nullptr),
       sph_body_(sph_body), body_name_(sph_body.getName()),
@@ -20,7 +22,11 @@ BaseParticles::BaseParticles(SPHBody &sph_body, BaseMaterial *base_material)
       copy_particle_state_(all_state_data_),
       write_restart_variable_to_xml_(variables_to_restart_, restart_xml_parser_),
       write_reload_variable_to_xml_(variables_to_reload_, reload_xml_parser_),
-      read_restart_variable_from_xml_(variables_to_restart_, restart_xml_parser_)
+      read_restart_variable_from_xml_(variables_to_restart_, restart_xml_parser_),
+      write_restart_variable_to_binary_(variables_to_restart_),
+      read_restart_variable_from_binary_(variables_to_restart_),
+      write_reload_variable_to_binary_(variables_to_reload_),
+      read_reload_variable_from_binary_(variables_to_reload_)
 {
     sph_body.assignBaseParticles(this);
     v_total_real_particles_ = registerSingularVariable<UnsignedInt>("TotalRealParticles");
@@ -56,6 +62,14 @@ void BaseParticles::registerPositionAndVolumetricMeasureFromReload()
     Vol_ = registerStateVariableFromReload<Real>("VolumetricMeasure");
 }
 //=================================================================================================//
+void BaseParticles::registerPositionAndVolumetricMeasure()
+{
+    pos_ = registerStateVariable<Vecd>("Position");
+    Vol_ = registerStateVariable<Real>("VolumetricMeasure");
+    addVariableToReload<Vecd>("Position");
+    addVariableToReload<Real>("VolumetricMeasure");
+}
+//=================================================================================================//
 void BaseParticles::initializeAllParticlesBounds(size_t number_of_particles)
 {
     UnsignedInt *total_real_particles = v_total_real_particles_->ValueAddress();
@@ -118,6 +132,52 @@ UnsignedInt BaseParticles::createRealParticleFrom(UnsignedInt index)
     return new_original_id;
 }
 //=================================================================================================//
+void BaseParticles::switchToBufferParticles(const IndexVector &sorted_indices)
+{
+    size_t total_real_particles = TotalRealParticles();
+    size_t remaining_bound = total_real_particles - sorted_indices.size();
+    // the removed particles below the remaining bound are filled by the kept ones above it
+    size_t holes = std::lower_bound(sorted_indices.begin(), sorted_indices.end(), remaining_bound) -
+                   sorted_indices.begin();
+    IndexVector movers;
+    movers.reserve(holes);
+    size_t next_removed = holes;
+    for (size_t index = remaining_bound; index != total_real_particles; ++index)
+    {
+        if (next_removed != sorted_indices.size() && sorted_indices[next_removed] == index)
+        {
+            ++next_removed;
+            continue;
+        }
+        movers.push_back(index);
+    }
+
+    particle_for(execution::par, IndexRange(0, holes),
+                 [&](size_t k)
+                 {
+                     size_t index = sorted_indices[k];
+                     size_t mover = movers[k];
+                     copyFromAnotherParticle(index, mover);
+                     std::swap(original_id_[index], original_id_[mover]);
+                     sorted_id_[original_id_[index]] = index;
+                 });
+    decrementTotalRealParticles(sorted_indices.size());
+}
+//=================================================================================================//
+UnsignedInt BaseParticles::createRealParticlesFrom(const IndexVector &indices)
+{
+    UnsignedInt first_new_index = TotalRealParticles();
+    particle_for(execution::par, IndexRange(0, indices.size()),
+                 [&](size_t k)
+                 {
+                     size_t new_index = first_new_index + k;
+                     original_id_[new_index] = new_index;
+                     copyFromAnotherParticle(new_index, indices[k]);
+                 });
+    incrementTotalRealParticles(indices.size());
+    return first_new_index;
+}
+//=================================================================================================//
 void BaseParticles::resizeXmlDocForParticles(XmlParser &xml_parser)
 {
     size_t total_elements = xml_parser.Size(xml_parser.first_element_);
@@ -142,6 +202,17 @@ void BaseParticles::readParticleFromXmlForRestart(std::string &filefullpath)
     read_restart_variable_from_xml_(this);
 }
 //=================================================================================================//
+void BaseParticles::writeParticlesToBinaryForRestart(BinaryDataWriter &binary_writer)
+{
+    write_restart_variable_to_binary_(binary_writer, TotalRealParticles());
+}
+//=================================================================================================//
+void BaseParticles::readParticlesFromBinaryForRestart(const std::string &filefullpath)
+{
+    BinaryDataReader binary_reader(filefullpath);
+    read_restart_variable_from_binary_(binary_reader, this);
+}
+//=================================================================================================//
 void BaseParticles::writeToXmlForReloadParticle(std::string &filefullpath)
 {
     resizeXmlDocForParticles(reload_xml_parser_);
@@ -149,6 +220,17 @@ void BaseParticles::writeToXmlForReloadParticle(std::string &filefullpath)
     reload_xml_parser_.writeToXmlFile(filefullpath);
 }
 //=================================================================================================//
+void BaseParticles::writeReloadParticlesToBinary(BinaryDataWriter &binary_writer)
+{
+    write_reload_variable_to_binary_(binary_writer, TotalRealParticles());
+}
+//=================================================================================================//
+void BaseParticles::readReloadParticlesFromBinary(const std::string &filefullpath)
+{
+    BinaryDataReader binary_reader(filefullpath);
+    read_reload_variable_from_binary_(binary_reader, this);
+}
+//=================================================================================================//
 XmlParser &BaseParticles::readReloadXmlFile(const std::string &filefullpath)
 {
     is_reload_file_read_ = true;
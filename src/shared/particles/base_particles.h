@@ -34,6 +34,8 @@
 #define BASE_PARTICLES_H
 
 #include "base_data_package.h"
+#include "binary_data_file.h"
+#include "scratch_variable_pool.h"
 #include "sphinxsys_containers.h"
 #include "sphinxsys_variable.h"
 #include "xml_parser.h"
@@ -81,15 +83,18 @@ class BodySurface;
 class BaseParticles
 {
   private:
+    UniquePtr<ParticleMemoryResource> memory_resource_; /**< declared first to outlive the variables */
     DataContainerUniquePtrAssemble<DiscreteVariable> all_discrete_variable_ptrs_;
     DataContainerUniquePtrAssemble<SingularVariable> all_global_variable_ptrs_;
     UniquePtrsKeeper<Entity> unique_variable_ptrs_;
+    ScratchVariablePool scratch_variable_pool_;
 
   public:
     explicit BaseParticles(SPHBody &sph_body, BaseMaterial *base_material);
     virtual ~BaseParticles(){};
     SPHBody &getSPHBody() { return sph_body_; };
     BaseMaterial &getBaseMaterial() { return base_material_; };
+    ParticleMemoryResource *getMemoryResource() { return memory_resource_.get(); };
 
     //----------------------------------------------------------------------
     // Global information for defining particle groups
@@ -122,6 +127,10 @@ class BaseParticles
     void updateGhostParticle(size_t ghost_index, size_t index);
     void switchToBufferParticle(size_t index);
     UnsignedInt createRealParticleFrom(UnsignedInt index);
+    /** batched versions: the removed indices are given in ascending order,
+     *  and the created particles are copied from the given ones and start from the returned index */
+    void switchToBufferParticles(const IndexVector &sorted_indices);
+    UnsignedInt createRealParticlesFrom(const IndexVector &indices);
     //----------------------------------------------------------------------
     // Parameterized management on particle variables and data
     //----------------------------------------------------------------------
@@ -190,6 +199,7 @@ class BaseParticles
     UnsignedInt *sorted_id_;   /**< the current sorted particle ids of particles from original ids. */
     ParticleData sortable_data_;
     ParticleVariables variables_to_sort_;
+    UnsignedInt total_sorts_ = 0; /**< number of sorts done, used to detect invalidated neighbor lists. */
 
   public:
     template <typename DataType>
@@ -197,6 +207,8 @@ class BaseParticles
     UnsignedInt *ParticleOriginalIds() { return original_id_; };
     UnsignedInt *ParticleSortedIds() { return sorted_id_; };
     ParticleData &SortableParticleData() { return sortable_data_; };
+    UnsignedInt TotalSorts() { return total_sorts_; };
+    void incrementTotalSorts() { total_sorts_++; };
     AssignIndex getAssignIndex() { return AssignIndex(); };
 
     //----------------------------------------------------------------------
@@ -206,7 +218,11 @@ class BaseParticles
     void resizeXmlDocForParticles(XmlParser &xml_parser);
     void writeParticlesToXmlForRestart(std::string &filefullpath);
     void readParticleFromXmlForRestart(std::string &filefullpath);
+    void writeParticlesToBinaryForRestart(BinaryDataWriter &binary_writer);
+    void readParticlesFromBinaryForRestart(const std::string &filefullpath);
     void writeToXmlForReloadParticle(std::string &filefullpath);
+    void writeReloadParticlesToBinary(BinaryDataWriter &binary_writer);
+    void readReloadParticlesFromBinary(const std::string &filefullpath);
     XmlParser &readReloadXmlFile(const std::string &filefullpath);
     template <typename OwnerType>
     void checkReloadFileRead(OwnerType *owner);
@@ -215,6 +231,8 @@ class BaseParticles
     //----------------------------------------------------------------------
     void registerPositionAndVolumetricMeasure(StdLargeVec<Vecd> &pos, StdLargeVec<Real> &Vol);
     void registerPositionAndVolumetricMeasureFromReload();
+    /** registered with zero data, to be filled in place by the particle generator */
+    void registerPositionAndVolumetricMeasure();
     Vecd *ParticlePositions() { return pos_; }
     Real *VolumetricMeasures() { return Vol_; }
     virtual Real ParticleVolume(size_t index) { return Vol_[index]; }
@@ -240,6 +258,10 @@ class BaseParticles
     bool is_reload_file_read_ = false;
 
   public:
+    ParticleVariables &AllDiscreteVariables() { return all_discrete_variables_; };
+    SingularVariables &AllSingularVariables() { return all_singular_variables_; };
+    /** temporary variables which are released after a single stage and reused by other dynamics */
+    ScratchVariablePool &getScratchVariablePool() { return scratch_variable_pool_; };
     ParticleVariables &VariablesToWrite() { return variables_to_write_; };
     ParticleVariables &VariablesToRestart() { return variables_to_restart_; };
     ParticleVariables &VariablesToReload() { return variables_to_reload_; };
@@ -273,9 +295,27 @@ class BaseParticles
         void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, BaseParticles *base_particles);
     };
 
+    struct WriteAParticleVariableToBinary
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        BinaryDataWriter &binary_writer, size_t total_real_particles);
+    };
+
+    struct ReadAParticleVariableFromBinary
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        BinaryDataReader &binary_reader, BaseParticles *base_particles);
+    };
+
     OperationOnDataAssemble<ParticleData, CopyParticleState> copy_particle_state_;
     OperationOnDataAssemble<ParticleVariables, WriteAParticleVariableToXml> write_restart_variable_to_xml_, write_reload_variable_to_xml_;
     OperationOnDataAssemble<ParticleVariables, ReadAParticleVariableFromXml> read_restart_variable_from_xml_;
+    OperationOnDataAssemble<ParticleVariables, WriteAParticleVariableToBinary> write_restart_variable_to_binary_;
+    OperationOnDataAssemble<ParticleVariables, ReadAParticleVariableFromBinary> read_restart_variable_from_binary_;
+    OperationOnDataAssemble<ParticleVariables, WriteAParticleVariableToBinary> write_reload_variable_to_binary_;
+    OperationOnDataAssemble<ParticleVariables, ReadAParticleVariableFromBinary> read_reload_variable_from_binary_;
 };
 } // namespace SPH
 #endif // BASE_PARTICLES_H
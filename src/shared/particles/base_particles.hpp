@@ -2,6 +2,7 @@
 #define BASE_PARTICLES_HPP
 
 #include "base_particles.h"
+#include "scratch_variable_pool.hpp"
 
 namespace SPH
 {
@@ -57,7 +58,7 @@ template <class DataType, typename... Args>
 DataType *BaseParticles::
     addUniqueDiscreteVariable(const std::string &name, size_t data_size, Args &&...args)
 {
-
+    ParticleMemory::ResourceScope memory_scope(memory_resource_.get());
     DiscreteVariable<DataType> *variable =
         unique_variable_ptrs_.createPtr<DiscreteVariable<DataType>>(name, data_size);
     initializeVariable(variable, std::forward<Args>(args)...);
@@ -71,6 +72,7 @@ DataType *BaseParticles::registerDiscreteVariable(const std::string &name,
     DiscreteVariable<DataType> *variable = findVariableByName<DataType>(all_discrete_variables_, name);
     if (variable == nullptr)
     {
+        ParticleMemory::ResourceScope memory_scope(memory_resource_.get());
         variable = addVariableToAssemble<DataType>(all_discrete_variables_, all_discrete_variable_ptrs_,
                                                    name, data_size);
         initializeVariable(variable, std::forward<Args>(args)...);
@@ -85,6 +87,7 @@ DiscreteVariable<DataType> *BaseParticles::
     DiscreteVariable<DataType> *variable = findVariableByName<DataType>(all_discrete_variables_, name);
     if (variable == nullptr)
     {
+        ParticleMemory::ResourceScope memory_scope(memory_resource_.get());
         variable = addVariableToAssemble<DataType>(all_discrete_variables_, all_discrete_variable_ptrs_,
                                                    name, data_size);
         initializeVariable(variable, std::forward<Args>(args)...);
@@ -343,5 +346,30 @@ operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, Ba
     }
 }
 //=================================================================================================//
+template <typename DataType>
+void BaseParticles::WriteAParticleVariableToBinary::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           BinaryDataWriter &binary_writer, size_t total_real_particles)
+{
+    for (size_t i = 0; i != variables.size(); ++i)
+    {
+        binary_writer.writeVariable(variables[i]->Name(), variables[i]->DataField(), total_real_particles);
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void BaseParticles::ReadAParticleVariableFromBinary::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           BinaryDataReader &binary_reader, BaseParticles *base_particles)
+{
+    for (size_t i = 0; i != variables.size(); ++i)
+    {
+        DataType *data_field = variables[i]->DataField() != nullptr
+                                   ? variables[i]->DataField()
+                                   : base_particles->initializeVariable<DataType>(variables[i]);
+        binary_reader.readVariable(variables[i]->Name(), data_field, variables[i]->getDataFieldSize());
+    }
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // BASE_PARTICLES_HPP
\ No newline at end of file
@@ -29,6 +29,16 @@ void ParticleBuffer<Base>::checkEnoughBuffer(BaseParticles &base_particles)
     }
 }
 //=================================================================================================//
+void ParticleBuffer<Base>::checkEnoughBuffer(BaseParticles &base_particles, size_t new_particles)
+{
+    if (base_particles.TotalRealParticles() + new_particles > base_particles.RealParticlesBound())
+    {
+        std::cout << "\n ERROR: Not enough buffer particles have been reserved!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
 void ParticleBuffer<Base>::allocateBufferParticles(BaseParticles &base_particles, size_t buffer_size)
 {
     base_particles.increaseAllParticlesBounds(buffer_size);
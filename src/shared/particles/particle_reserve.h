@@ -69,6 +69,7 @@ class ParticleBuffer<Base> : public ParticleReserve
     ParticleBuffer() : ParticleReserve(){};
     virtual ~ParticleBuffer(){};
     void checkEnoughBuffer(BaseParticles &base_particles);
+    void checkEnoughBuffer(BaseParticles &base_particles, size_t new_particles);
     void allocateBufferParticles(BaseParticles &base_particles, size_t buffer_size);
 };
 
@@ -0,0 +1,44 @@
+#include "scratch_variable_pool.hpp"
+
+#include <algorithm>
+
+namespace SPH
+{
+//=================================================================================================//
+void ScratchVariablePool::trim()
+{
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    std::apply(
+        [](auto &...variables_of_type)
+        {
+            auto remove_released = [](auto &variables)
+            {
+                variables.erase(std::remove_if(variables.begin(), variables.end(),
+                                               [](const auto &variable)
+                                               { return !variable.second; }),
+                                variables.end());
+            };
+            (remove_released(variables_of_type), ...);
+        },
+        scratch_variables_);
+}
+//=================================================================================================//
+size_t ScratchVariablePool::MemoryFootprint()
+{
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    size_t bytes = 0;
+    std::apply(
+        [&](auto &...variables_of_type)
+        {
+            auto add_footprint = [&](auto &variables)
+            {
+                for (auto &variable : variables)
+                    bytes += variable.first->MemoryFootprint() + variable.first->DeviceMemoryFootprint();
+            };
+            (add_footprint(variables_of_type), ...);
+        },
+        scratch_variables_);
+    return bytes;
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,85 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    scratch_variable_pool.h
+ * @brief   Pool of temporary discrete variables shared by the dynamics of a body.
+ * @details A scratch variable is acquired for a single stage only, e.g. as the buffer of a permutation,
+ *          and released afterwards, so that the same memory is reused by the next acquisition
+ *          instead of each dynamics keeping its own full-size variable for the whole run.
+ *          The data of a scratch variable is undefined when acquired.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef SCRATCH_VARIABLE_POOL_H
+#define SCRATCH_VARIABLE_POOL_H
+
+#include "base_data_package.h"
+#include "sphinxsys_variable.h"
+
+#include <mutex>
+
+namespace SPH
+{
+/** a scratch variable with the flag whether it is in use */
+template <typename VariableType>
+using ScratchVariableKeeper = StdVec<std::pair<UniquePtr<VariableType>, bool>>;
+
+class ScratchVariablePool
+{
+    DataAssemble<ScratchVariableKeeper, DiscreteVariable> scratch_variables_;
+    std::mutex pool_mutex_; /**< dynamics in a concurrent group may acquire at the same time */
+
+  public:
+    ScratchVariablePool(){};
+    ~ScratchVariablePool(){};
+
+    /** a released variable with at least the data size, or a new one if none is available */
+    template <typename DataType>
+    DiscreteVariable<DataType> *acquire(size_t data_size);
+    template <typename DataType>
+    void release(DiscreteVariable<DataType> *variable);
+    /** free the memory of all released variables */
+    void trim();
+    /** the memory held by the pool in bytes, in use or not */
+    size_t MemoryFootprint();
+};
+
+/**
+ * @class ScopedScratchVariable
+ * @brief Acquires a scratch variable at construction and releases it at destruction.
+ */
+template <typename DataType>
+class ScopedScratchVariable
+{
+    ScratchVariablePool &pool_;
+    DiscreteVariable<DataType> *variable_;
+
+  public:
+    ScopedScratchVariable(ScratchVariablePool &pool, size_t data_size)
+        : pool_(pool), variable_(pool.acquire<DataType>(data_size)){};
+    ~ScopedScratchVariable() { pool_.release(variable_); };
+    DiscreteVariable<DataType> *operator->() { return variable_; };
+    DiscreteVariable<DataType> *get() { return variable_; };
+};
+} // namespace SPH
+#endif // SCRATCH_VARIABLE_POOL_H
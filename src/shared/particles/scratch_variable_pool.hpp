@@ -0,0 +1,49 @@
+#ifndef SCRATCH_VARIABLE_POOL_HPP
+#define SCRATCH_VARIABLE_POOL_HPP
+
+#include "scratch_variable_pool.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <typename DataType>
+DiscreteVariable<DataType> *ScratchVariablePool::acquire(size_t data_size)
+{
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    ScratchVariableKeeper<DiscreteVariable<DataType>> &variables = std::get<type_index>(scratch_variables_);
+    for (auto &variable : variables)
+    {
+        if (!variable.second && variable.first->getDataFieldSize() >= data_size)
+        {
+            variable.second = true;
+            return variable.first.get();
+        }
+    }
+
+    std::string name = "Scratch" + std::to_string(type_index) + "_" + std::to_string(variables.size());
+    variables.emplace_back(makeUnique<DiscreteVariable<DataType>>(name, data_size), true);
+    return variables.back().first.get();
+}
+//=================================================================================================//
+template <typename DataType>
+void ScratchVariablePool::release(DiscreteVariable<DataType> *variable)
+{
+    constexpr int type_index = DataTypeIndex<DataType>::value;
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    for (auto &scratch_variable : std::get<type_index>(scratch_variables_))
+    {
+        if (scratch_variable.first.get() == variable)
+        {
+            scratch_variable.second = false;
+            return;
+        }
+    }
+
+    std::cout << "\n Error: the variable " << variable->Name() << " is not from the scratch pool!" << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // SCRATCH_VARIABLE_POOL_HPP
@@ -62,8 +62,11 @@ class RegressionTestDynamicTimeWarping : public RegressionTestTimeAverage<Observ
         return (variable_a - variable_b).norm();
     };
 
-    /** the local constrained method used for calculating the dtw distance between two lines. */
-    StdVec<Real> calculateDTWDistance(BiVector<VariableType> dataset_a_, BiVector<VariableType> dataset_b_);
+    /** the local constrained method used for calculating the dtw distance between two lines,
+     *  with memory linear in the length of the lines. */
+    Real calculateDTWDistance(const StdVec<VariableType> &data_a, const StdVec<VariableType> &data_b);
+    /** the dtw distances of all observations, computed in parallel. */
+    StdVec<Real> calculateDTWDistance(const BiVector<VariableType> &dataset_a, const BiVector<VariableType> &dataset_b);
 
   public:
     template <typename... Args>
@@ -14,39 +14,70 @@ namespace SPH
 {
 //=================================================================================================//
 template <class ObserveMethodType>
-StdVec<Real> RegressionTestDynamicTimeWarping<ObserveMethodType>::calculateDTWDistance(BiVector<VariableType> dataset_a_, BiVector<VariableType> dataset_b_)
+Real RegressionTestDynamicTimeWarping<ObserveMethodType>::
+    calculateDTWDistance(const StdVec<VariableType> &data_a, const StdVec<VariableType> &data_b)
 {
-    /* define the container to hold the dtw distance.*/
-    StdVec<Real> dtw_distance;
-    for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
+    int a_length = data_a.size();
+    int b_length = data_b.size();
+    /** add locality constraint */
+    int window_size = SMAX(5, ABS(a_length - b_length));
+
+    /** Two rolling rows of the local DTW distance instead of the full [a_length, b_length] matrix.
+     *  As in the full matrix, the first column is accumulated for all rows and
+     *  the entries outside of the window are zero, so that the distances are unchanged. */
+    StdVec<Real> previous_row(b_length, 0), current_row(b_length, 0);
+    previous_row[0] = calculatePNorm(data_a[0], data_b[0]);
+    for (int index_j = 1; index_j < b_length; ++index_j)
+        previous_row[index_j] = previous_row[index_j - 1] + calculatePNorm(data_a[0], data_b[index_j]);
+
+    /** the window written to current_row two rows before, which is cleared before reused */
+    int stale_begin = 1, stale_end = 1;
+    int previous_begin = 1, previous_end = b_length;
+    for (int index_i = 1; index_i < a_length; ++index_i)
     {
-        int window_size_ = 5;
-        int a_length = dataset_a_[observation_index].size();
-        int b_length = dataset_b_[observation_index].size();
+        for (int index_j = stale_begin; index_j < stale_end; ++index_j)
+            current_row[index_j] = 0;
+
+        current_row[0] = previous_row[0] + calculatePNorm(data_a[index_i], data_b[0]);
+        int window_begin = SMAX(1, index_i - window_size);
+        int window_end = SMIN(b_length, index_i + window_size);
+        for (int index_j = window_begin; index_j < window_end; ++index_j)
+            current_row[index_j] = calculatePNorm(data_a[index_i], data_b[index_j]) +
+                                   SMIN(previous_row[index_j], current_row[index_j - 1], previous_row[index_j - 1]);
 
+        std::swap(previous_row, current_row);
+        stale_begin = previous_begin;
+        stale_end = previous_end;
+        previous_begin = window_begin;
+        previous_end = window_end;
+    }
+    return previous_row[b_length - 1];
+}
+//=================================================================================================//
+template <class ObserveMethodType>
+StdVec<Real> RegressionTestDynamicTimeWarping<ObserveMethodType>::
+    calculateDTWDistance(const BiVector<VariableType> &dataset_a, const BiVector<VariableType> &dataset_b)
+{
+    for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
+    {
+        int a_length = dataset_a[observation_index].size();
+        int b_length = dataset_b[observation_index].size();
         if (b_length > 1.1 * a_length || b_length < 0.9 * a_length)
         {
             std::cout << "\n Error: please check the time step change, because the data length changed a lot !" << std::endl;
             std::cout << __FILE__ << ':' << __LINE__ << std::endl;
             exit(1);
         }
-
-        /** create a 2D vector with [a_length, b_length] to contain the local DTW distance value. */
-        BiVector<Real> local_dtw_distance(a_length, StdVec<Real>(b_length, 0));
-        local_dtw_distance[0][0] = calculatePNorm(dataset_a_[observation_index][0], dataset_b_[observation_index][0]);
-        for (int index_i = 1; index_i < a_length; ++index_i)
-            local_dtw_distance[index_i][0] = local_dtw_distance[index_i - 1][0] + calculatePNorm(dataset_a_[observation_index][index_i], dataset_b_[observation_index][0]);
-        for (int index_j = 1; index_j < b_length; ++index_j)
-            local_dtw_distance[0][index_j] = local_dtw_distance[0][index_j - 1] + calculatePNorm(dataset_a_[observation_index][0], dataset_b_[observation_index][index_j]);
-
-        /** add locality constraint */
-        window_size_ = SMAX(window_size_, ABS(a_length - b_length));
-        for (int index_i = 1; index_i != a_length; ++index_i)
-            for (int index_j = SMAX(1, index_i - window_size_); index_j != SMIN(b_length, index_i + window_size_); ++index_j)
-                local_dtw_distance[index_i][index_j] = calculatePNorm(dataset_a_[observation_index][index_i], dataset_b_[observation_index][index_j]) +
-                                                       SMIN(local_dtw_distance[index_i - 1][index_j], local_dtw_distance[index_i][index_j - 1], local_dtw_distance[index_i - 1][index_j - 1]);
-        dtw_distance.push_back(local_dtw_distance[a_length - 1][b_length - 1]);
     }
+
+    /* the observations are independent and computed in parallel. */
+    StdVec<Real> dtw_distance(this->observation_, 0);
+    particle_for(execution::par, IndexRange(0, this->observation_),
+                 [&](size_t observation_index)
+                 {
+                     dtw_distance[observation_index] =
+                         calculateDTWDistance(dataset_a[observation_index], dataset_b[observation_index]);
+                 });
     return dtw_distance;
 };
 //=================================================================================================//
@@ -47,11 +47,20 @@ class RegressionTestEnsembleAverage : public RegressionTestTimeAverage<ObserveMe
   protected:
     BiVector<VariableType> meanvalue_, meanvalue_new_; /* the container of (new) mean value. [different from time-averaged]*/
     BiVector<VariableType> variance_, variance_new_;   /* the container of (new) variance. [different from time-averaged]*/
+    /* The minimum and maximum of the results over all runs, with which the variance is updated
+     * without reloading the previous results, are kept in a binary file. */
+    std::string extreme_value_filefullpath_;
+    BiVector<VariableType> minimum_, maximum_;
+
+    /** the method used for including a result into the minimum and maximum. */
+    void includeExtremeValues(BiVector<Real> &result, BiVector<Real> &minimum, BiVector<Real> &maximum);
+    void includeExtremeValues(BiVector<Vecd> &result, BiVector<Vecd> &minimum, BiVector<Vecd> &maximum);
+    void includeExtremeValues(BiVector<Matd> &result, BiVector<Matd> &minimum, BiVector<Matd> &maximum);
 
     /** the method used for calculating the new variance. */
-    void calculateNewVariance(TriVector<Real> &result, BiVector<Real> &meanvalue_new, BiVector<Real> &variance, BiVector<Real> &variance_new);
-    void calculateNewVariance(TriVector<Vecd> &result, BiVector<Vecd> &meanvalue_new, BiVector<Vecd> &variance, BiVector<Vecd> &variance_new);
-    void calculateNewVariance(TriVector<Matd> &result, BiVector<Matd> &meanvalue_new, BiVector<Matd> &variance, BiVector<Matd> &variance_new);
+    void calculateNewVariance(BiVector<Real> &minimum, BiVector<Real> &maximum, BiVector<Real> &meanvalue_new, BiVector<Real> &variance, BiVector<Real> &variance_new);
+    void calculateNewVariance(BiVector<Vecd> &minimum, BiVector<Vecd> &maximum, BiVector<Vecd> &meanvalue_new, BiVector<Vecd> &variance, BiVector<Vecd> &variance_new);
+    void calculateNewVariance(BiVector<Matd> &minimum, BiVector<Matd> &maximum, BiVector<Matd> &meanvalue_new, BiVector<Matd> &variance, BiVector<Matd> &variance_new);
 
     /** the method used for comparing the meanvalue and variance. */
     int compareParameter(std::string par_name, BiVector<Real> &parameter, BiVector<Real> &parameter_new, Real &threshold);
@@ -69,10 +78,13 @@ class RegressionTestEnsembleAverage : public RegressionTestTimeAverage<ObserveMe
         : RegressionTestTimeAverage<ObserveMethodType>(std::forward<Args>(args)...)
     {
         this->mean_variance_filefullpath_ = this->input_folder_path_ + "/" + this->dynamics_identifier_name_ + "_" + this->quantity_name_ + "_ensemble_averaged_mean_variance.xml";
+        extreme_value_filefullpath_ = this->input_folder_path_ + "/" + this->dynamics_identifier_name_ + "_" + this->quantity_name_ + "_ensemble_averaged_extreme_values.bin";
     };
     virtual ~RegressionTestEnsembleAverage(){};
 
     void setupAndCorrection();      /** setup and correct the number of old and new result. */
+    void updateExtremeValues();     /** update the minimum and maximum with the current result. */
+    void writeExtremeValues();      /** write the minimum and maximum to the binary file. */
     void readMeanVarianceFromXml(); /** read the meanvalue and variance from the .xml file. */
     void updateMeanVariance();      /** update the meanvalue and variance from new result. */
     void writeMeanVarianceToXml();  /** write the meanvalue and variance to the .xml file. */
@@ -88,12 +100,12 @@ class RegressionTestEnsembleAverage : public RegressionTestTimeAverage<ObserveMe
         if (this->converged == "false")
         {
             setupAndCorrection();
-            this->readResultFromXml();
+            updateExtremeValues();
             if (filter == "true")
                 this->filterExtremeValues();
             readMeanVarianceFromXml();
             updateMeanVariance();
-            this->writeResultToXml();
+            writeExtremeValues();
             writeMeanVarianceToXml();
             compareMeanVariance();
         };
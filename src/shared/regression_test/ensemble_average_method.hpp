@@ -13,54 +13,115 @@ namespace SPH
 {
 //=================================================================================================//
 template <class ObserveMethodType>
-void RegressionTestEnsembleAverage<ObserveMethodType>::calculateNewVariance(TriVector<Real> &result,
+void RegressionTestEnsembleAverage<ObserveMethodType>::includeExtremeValues(BiVector<Real> &result,
+                                                                            BiVector<Real> &minimum, BiVector<Real> &maximum)
+{
+    particle_for(execution::par, IndexRange(0, this->observation_),
+                 [&](size_t observation_index)
+                 {
+                     for (size_t snapshot_index = 0; snapshot_index != minimum.size(); ++snapshot_index)
+                     {
+                         minimum[snapshot_index][observation_index] =
+                             SMIN(minimum[snapshot_index][observation_index], result[snapshot_index][observation_index]);
+                         maximum[snapshot_index][observation_index] =
+                             SMAX(maximum[snapshot_index][observation_index], result[snapshot_index][observation_index]);
+                     }
+                 });
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestEnsembleAverage<ObserveMethodType>::includeExtremeValues(BiVector<Vecd> &result,
+                                                                            BiVector<Vecd> &minimum, BiVector<Vecd> &maximum)
+{
+    particle_for(execution::par, IndexRange(0, this->observation_),
+                 [&](size_t observation_index)
+                 {
+                     for (size_t snapshot_index = 0; snapshot_index != minimum.size(); ++snapshot_index)
+                     {
+                         minimum[snapshot_index][observation_index] =
+                             minimum[snapshot_index][observation_index].cwiseMin(result[snapshot_index][observation_index]);
+                         maximum[snapshot_index][observation_index] =
+                             maximum[snapshot_index][observation_index].cwiseMax(result[snapshot_index][observation_index]);
+                     }
+                 });
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestEnsembleAverage<ObserveMethodType>::includeExtremeValues(BiVector<Matd> &result,
+                                                                            BiVector<Matd> &minimum, BiVector<Matd> &maximum)
+{
+    particle_for(execution::par, IndexRange(0, this->observation_),
+                 [&](size_t observation_index)
+                 {
+                     for (size_t snapshot_index = 0; snapshot_index != minimum.size(); ++snapshot_index)
+                     {
+                         minimum[snapshot_index][observation_index] =
+                             minimum[snapshot_index][observation_index].cwiseMin(result[snapshot_index][observation_index]);
+                         maximum[snapshot_index][observation_index] =
+                             maximum[snapshot_index][observation_index].cwiseMax(result[snapshot_index][observation_index]);
+                     }
+                 });
+};
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestEnsembleAverage<ObserveMethodType>::calculateNewVariance(BiVector<Real> &minimum, BiVector<Real> &maximum,
                                                                             BiVector<Real> &meanvalue_new, BiVector<Real> &variance, BiVector<Real> &variance_new)
 {
-    for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
-        for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
-            for (int run_index = 0; run_index != this->number_of_run_; ++run_index)
-            {
-                variance_new[snapshot_index][observation_index] = SMAX(
-                    (Real)variance[snapshot_index][observation_index],
-                    (Real)variance_new[snapshot_index][observation_index],
-                    (Real)pow((result[run_index][snapshot_index][observation_index] - meanvalue_new[snapshot_index][observation_index]), 2),
-                    (Real)pow(meanvalue_new[snapshot_index][observation_index] * 1.0e-2, 2));
-            }
+    /** The largest squared deviation over all runs is given by the minimum or the maximum. */
+    particle_for(execution::par, IndexRange(0, this->observation_),
+                 [&](size_t observation_index)
+                 {
+                     for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
+                     {
+                         variance_new[snapshot_index][observation_index] = SMAX(
+                             (Real)variance[snapshot_index][observation_index],
+                             (Real)variance_new[snapshot_index][observation_index],
+                             (Real)pow((minimum[snapshot_index][observation_index] - meanvalue_new[snapshot_index][observation_index]), 2),
+                             (Real)pow((maximum[snapshot_index][observation_index] - meanvalue_new[snapshot_index][observation_index]), 2),
+                             (Real)pow(meanvalue_new[snapshot_index][observation_index] * 1.0e-2, 2));
+                     }
+                 });
 };
 //=================================================================================================//
 template <class ObserveMethodType>
-void RegressionTestEnsembleAverage<ObserveMethodType>::calculateNewVariance(TriVector<Vecd> &result,
+void RegressionTestEnsembleAverage<ObserveMethodType>::calculateNewVariance(BiVector<Vecd> &minimum, BiVector<Vecd> &maximum,
                                                                             BiVector<Vecd> &meanvalue_new, BiVector<Vecd> &variance, BiVector<Vecd> &variance_new)
 {
-    for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
-        for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
-            for (int run_index = 0; run_index != this->number_of_run_; ++run_index)
-                for (int i = 0; i != variance[0][0].size(); ++i)
-                {
-                    variance_new[snapshot_index][observation_index][i] = SMAX(
-                        (Real)variance[snapshot_index][observation_index][i],
-                        (Real)variance_new[snapshot_index][observation_index][i],
-                        (Real)pow((result[run_index][snapshot_index][observation_index][i] - meanvalue_new[snapshot_index][observation_index][i]), 2),
-                        (Real)pow(meanvalue_new[snapshot_index][observation_index][i] * 1.0e-2, 2));
-                }
+    particle_for(execution::par, IndexRange(0, this->observation_),
+                 [&](size_t observation_index)
+                 {
+                     for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
+                         for (int i = 0; i != variance[0][0].size(); ++i)
+                         {
+                             variance_new[snapshot_index][observation_index][i] = SMAX(
+                                 (Real)variance[snapshot_index][observation_index][i],
+                                 (Real)variance_new[snapshot_index][observation_index][i],
+                                 (Real)pow((minimum[snapshot_index][observation_index][i] - meanvalue_new[snapshot_index][observation_index][i]), 2),
+                                 (Real)pow((maximum[snapshot_index][observation_index][i] - meanvalue_new[snapshot_index][observation_index][i]), 2),
+                                 (Real)pow(meanvalue_new[snapshot_index][observation_index][i] * 1.0e-2, 2));
+                         }
+                 });
 };
 //=================================================================================================//
 template <class ObserveMethodType>
-void RegressionTestEnsembleAverage<ObserveMethodType>::calculateNewVariance(TriVector<Matd> &result,
+void RegressionTestEnsembleAverage<ObserveMethodType>::calculateNewVariance(BiVector<Matd> &minimum, BiVector<Matd> &maximum,
                                                                             BiVector<Matd> &meanvalue_new, BiVector<Matd> &variance, BiVector<Matd> &variance_new)
 {
-    for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
-        for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
-            for (int run_index = 0; run_index != this->number_of_run_; ++run_index)
-                for (size_t i = 0; i != variance[0][0].size(); ++i)
-                    for (size_t j = 0; j != variance[0][0].size(); ++j)
-                    {
-                        variance_new[snapshot_index][observation_index](i, j) = SMAX(
-                            (Real)variance[snapshot_index][observation_index](i, j),
-                            (Real)variance_new[snapshot_index][observation_index](i, j),
-                            (Real)pow((result[run_index][snapshot_index][observation_index](i, j) - meanvalue_new[snapshot_index][observation_index](i, j)), 2),
-                            (Real)pow(meanvalue_new[snapshot_index][observation_index](i, j) * Real(0.01), 2));
-                    }
+    particle_for(execution::par, IndexRange(0, this->observation_),
+                 [&](size_t observation_index)
+                 {
+                     for (int snapshot_index = 0; snapshot_index != SMIN(this->snapshot_, this->number_of_snapshot_old_); ++snapshot_index)
+                         for (size_t i = 0; i != variance[0][0].size(); ++i)
+                             for (size_t j = 0; j != variance[0][0].size(); ++j)
+                             {
+                                 variance_new[snapshot_index][observation_index](i, j) = SMAX(
+                                     (Real)variance[snapshot_index][observation_index](i, j),
+                                     (Real)variance_new[snapshot_index][observation_index](i, j),
+                                     (Real)pow((minimum[snapshot_index][observation_index](i, j) - meanvalue_new[snapshot_index][observation_index](i, j)), 2),
+                                     (Real)pow((maximum[snapshot_index][observation_index](i, j) - meanvalue_new[snapshot_index][observation_index](i, j)), 2),
+                                     (Real)pow(meanvalue_new[snapshot_index][observation_index](i, j) * Real(0.01), 2));
+                             }
+                 });
 };
 //=================================================================================================//
 template <class ObserveMethodType>
@@ -222,7 +283,9 @@ void RegressionTestEnsembleAverage<ObserveMethodType>::setupAndCorrection()
 
     if (this->number_of_run_ > 1)
     {
-        if (this->converged == "false") /*< To identify the database generation or new result testing. */
+        /*< To identify the database generation or new result testing,
+         *  and the previous results are only required if the extreme values are not available. */
+        if (this->converged == "false" && !fs::exists(extreme_value_filefullpath_))
         {
             if (!fs::exists(this->result_filefullpath_))
             {
@@ -274,6 +337,65 @@ void RegressionTestEnsembleAverage<ObserveMethodType>::setupAndCorrection()
 }
 //=================================================================================================//
 template <class ObserveMethodType>
+void RegressionTestEnsembleAverage<ObserveMethodType>::updateExtremeValues()
+{
+    int number_of_snapshot = SMIN(this->snapshot_, this->number_of_snapshot_old_);
+    if (this->number_of_run_ > 1 && fs::exists(extreme_value_filefullpath_))
+    {
+        BinaryDataReader reader(extreme_value_filefullpath_);
+        int size[2] = {0, 0}; /* the number of snapshots and observations */
+        reader.readVariable("Size", size, 2);
+        if (size[0] < number_of_snapshot || size[1] != this->observation_)
+        {
+            std::cout << "\n Error: the extreme values in " << extreme_value_filefullpath_ << " do not match the current result!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        StdVec<VariableType> minimum_in(size[0] * size[1]), maximum_in(size[0] * size[1]);
+        reader.readVariable("Minimum", minimum_in.data(), minimum_in.size());
+        reader.readVariable("Maximum", maximum_in.data(), maximum_in.size());
+
+        /** Unify the length of the extreme values and the current result. */
+        minimum_ = BiVector<VariableType>(number_of_snapshot, StdVec<VariableType>(this->observation_));
+        maximum_ = minimum_;
+        for (int snapshot_index = 0; snapshot_index != number_of_snapshot; ++snapshot_index)
+            for (int observation_index = 0; observation_index != this->observation_; ++observation_index)
+            {
+                minimum_[snapshot_index][observation_index] = minimum_in[snapshot_index * size[1] + observation_index];
+                maximum_[snapshot_index][observation_index] = maximum_in[snapshot_index * size[1] + observation_index];
+            }
+    }
+    else
+    {
+        /** Start from the current result, or from all results of a database without extreme values. */
+        this->readResultFromXml();
+        minimum_ = this->current_result_;
+        maximum_ = this->current_result_;
+        for (size_t run_index = 0; run_index != this->result_.size(); ++run_index)
+            includeExtremeValues(this->result_[run_index], minimum_, maximum_);
+        this->result_.clear();
+    }
+    includeExtremeValues(this->current_result_, minimum_, maximum_);
+}
+//=================================================================================================//
+template <class ObserveMethodType>
+void RegressionTestEnsembleAverage<ObserveMethodType>::writeExtremeValues()
+{
+    int size[2] = {SMIN(this->snapshot_, this->number_of_snapshot_old_), this->observation_};
+    StdVec<VariableType> minimum_out, maximum_out;
+    for (int snapshot_index = 0; snapshot_index != size[0]; ++snapshot_index)
+    {
+        minimum_out.insert(minimum_out.end(), minimum_[snapshot_index].begin(), minimum_[snapshot_index].end());
+        maximum_out.insert(maximum_out.end(), maximum_[snapshot_index].begin(), maximum_[snapshot_index].end());
+    }
+    BinaryDataWriter writer(extreme_value_filefullpath_);
+    writer.writeVariable("Size", size, 2);
+    writer.writeVariable("Minimum", minimum_out.data(), minimum_out.size());
+    writer.writeVariable("Maximum", maximum_out.data(), maximum_out.size());
+    writer.finalize();
+}
+//=================================================================================================//
+template <class ObserveMethodType>
 void RegressionTestEnsembleAverage<ObserveMethodType>::readMeanVarianceFromXml()
 {
     if (this->number_of_run_ > 1)
@@ -312,7 +434,7 @@ void RegressionTestEnsembleAverage<ObserveMethodType>::updateMeanVariance()
                                                                  this->current_result_[snapshot_index][observation_index]) /
                                                                 this->number_of_run_;
     /** Update the variance of the result. */
-    calculateNewVariance(this->result_, meanvalue_new_, variance_, variance_new_);
+    calculateNewVariance(minimum_, maximum_, meanvalue_new_, variance_, variance_new_);
 }
 //=================================================================================================//
 template <class ObserveMethodType>
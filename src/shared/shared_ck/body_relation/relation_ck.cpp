@@ -6,13 +6,44 @@ namespace SPH
 Relation<Base>::Relation(SPHBody &sph_body)
     : sph_body_(sph_body),
       particles_(sph_body.getBaseParticles()),
-      offset_list_size_(particles_.RealParticlesBound() + 1) {}
+      offset_list_size_(particles_.RealParticlesBound() + 1), configuration_version_(0) {}
+//=================================================================================================//
+void Relation<Base>::incrementConfigurationVersion()
+{
+    configuration_version_++;
+    sph_body_.incrementConfigurationVersion();
+}
+//=================================================================================================//
+CountStatistics Relation<Base>::OffsetNeighborStatistics(DiscreteVariable<UnsignedInt> *dv_particle_offset)
+{
+    UnsignedInt *particle_offset = dv_particle_offset->DataField();
+    return computeCountStatistics(particles_.TotalRealParticles(),
+                                  [&](size_t i)
+                                  { return size_t(particle_offset[i + 1] - particle_offset[i]); });
+}
 //=================================================================================================//
 Relation<Inner<>>::Relation(RealBody &real_body)
     : Relation<Base>(real_body), real_body_(&real_body),
       cell_linked_list_(DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList())),
       dv_neighbor_index_(addRelationVariable<UnsignedInt>("NeighborIndex", offset_list_size_)),
-      dv_particle_offset_(addRelationVariable<UnsignedInt>("ParticleOffset", offset_list_size_)) {}
+      dv_particle_offset_(addRelationVariable<UnsignedInt>("ParticleOffset", offset_list_size_)),
+      dv_pair_dW_ij_(nullptr), dv_pair_e_ij_(nullptr),
+      pair_geometry_version_(std::numeric_limits<UnsignedInt>::max())
+{
+    dv_neighbor_index_->setNeighborData();
+}
+//=================================================================================================//
+void Relation<Inner<>>::enablePairGeometryCache()
+{
+    if (dv_pair_dW_ij_ == nullptr)
+    {
+        size_t pair_list_size = dv_neighbor_index_->getDataFieldSize();
+        dv_pair_dW_ij_ = addRelationVariable<Real>("PairKernelGradient", pair_list_size);
+        dv_pair_e_ij_ = addRelationVariable<Vecd>("PairUnitVector", pair_list_size);
+        dv_pair_dW_ij_->setNeighborData();
+        dv_pair_e_ij_->setNeighborData();
+    }
+}
 //=================================================================================================//
 void Relation<Inner<>>::registerComputingKernel(execution::Implementation<Base> *implementation)
 {
@@ -42,6 +73,7 @@ Relation<Contact<>>::Relation(SPHBody &sph_body, RealBodyVector contact_sph_bodi
 
         dv_contact_neighbor_index_.push_back(addRelationVariable<UnsignedInt>(
             "Contact" + name + "NeighborIndex", offset_list_size_));
+        dv_contact_neighbor_index_.back()->setNeighborData();
         dv_contact_particle_offset_.push_back(addRelationVariable<UnsignedInt>(
             "Contact" + name + "ParticleOffset", offset_list_size_));
         all_contact_computing_kernels_.resize(contact_bodies_.size());
@@ -49,14 +49,21 @@ class Relation<Base>
     virtual ~Relation(){};
     SPHBody &getSPHBody() { return sph_body_; };
     UnsignedInt getParticleOffsetListSize() { return offset_list_size_; };
+    /** the number of updates of the neighbor lists, also counted by the body */
+    UnsignedInt ConfigurationVersion() { return configuration_version_; };
+    void incrementConfigurationVersion();
 
   protected:
     SPHBody &sph_body_;
     BaseParticles &particles_;
     UnsignedInt offset_list_size_;
+    UnsignedInt configuration_version_;
 
     template <class DataType>
     DiscreteVariable<DataType> *addRelationVariable(const std::string &name, size_t data_size);
+    /** the neighbor counts of the real particles from the host data of the particle offsets,
+     *  which is to be synchronized before if updated on device */
+    CountStatistics OffsetNeighborStatistics(DiscreteVariable<UnsignedInt> *dv_particle_offset);
 };
 
 template <>
@@ -71,12 +78,29 @@ class Relation<Inner<>> : public Relation<Base>
     DiscreteVariable<UnsignedInt> *getParticleOffset() { return dv_particle_offset_; };
     void registerComputingKernel(execution::Implementation<Base> *implementation);
     void resetComputingKernelUpdated();
+    /**
+     * Allocate per-pair storage of kernel gradient and unit vector so that kernels
+     * on the same neighbor list can reuse the pair geometry instead of recomputing it.
+     * It costs (1 + Dimensions) reals per neighbor pair and should be enabled
+     * before the interaction dynamics using this relation are executed.
+     */
+    void enablePairGeometryCache();
+    bool isPairGeometryCached() { return dv_pair_dW_ij_ != nullptr; };
+    DiscreteVariable<Real> *getPairKernelGradient() { return dv_pair_dW_ij_; };
+    DiscreteVariable<Vecd> *getPairUnitVector() { return dv_pair_e_ij_; };
+    /** record that the pair geometry is written for the current configuration version */
+    void stampPairGeometry() { pair_geometry_version_ = configuration_version_; };
+    bool isPairGeometryCurrent() { return pair_geometry_version_ == configuration_version_; };
+    CountStatistics NeighborStatistics() { return OffsetNeighborStatistics(dv_particle_offset_); };
 
   protected:
     RealBody *real_body_;
     CellLinkedList &cell_linked_list_;
     DiscreteVariable<UnsignedInt> *dv_neighbor_index_;
     DiscreteVariable<UnsignedInt> *dv_particle_offset_;
+    DiscreteVariable<Real> *dv_pair_dW_ij_;
+    DiscreteVariable<Vecd> *dv_pair_e_ij_;
+    UnsignedInt pair_geometry_version_;
     StdVec<execution::Implementation<Base> *> all_inner_computing_kernels_;
 };
 
@@ -103,6 +127,76 @@ class Relation<Contact<>> : public Relation<Base>
     StdVec<DiscreteVariable<UnsignedInt> *> getContactParticleOffset() { return dv_contact_particle_offset_; };
     void registerComputingKernel(execution::Implementation<Base> *implementation, UnsignedInt contact_index);
     void resetComputingKernelUpdated(UnsignedInt contact_index);
+    CountStatistics NeighborStatistics(UnsignedInt contact_index)
+    {
+        return OffsetNeighborStatistics(dv_contact_particle_offset_[contact_index]);
+    };
+};
+
+/**
+ * @brief Relations whose computing kernels use the given smoothing kernel type
+ *        instead of the default Wendland C2 one, e.g. Relation<Inner<KernelCubicBSplineCK>>.
+ */
+template <class KernelType>
+class Relation<Inner<KernelType>> : public Relation<Inner<>>
+{
+  public:
+    explicit Relation(RealBody &real_body) : Relation<Inner<>>(real_body){};
+    virtual ~Relation(){};
+};
+
+template <class KernelType>
+class Relation<Contact<KernelType>> : public Relation<Contact<>>
+{
+  public:
+    Relation(SPHBody &sph_body, RealBodyVector contact_bodies)
+        : Relation<Contact<>>(sph_body, contact_bodies){};
+    virtual ~Relation(){};
+};
+
+/**
+ * @brief Relations whose computing kernels use the smoothing length of each particle,
+ *        e.g. Relation<Inner<Adaptive>> or Relation<Inner<Adaptive, KernelCubicBSplineCK>>,
+ *        see Neighbor<Adaptive, KernelType>. A body with local refinement is to be listed
+ *        in a single level cell linked list, see ParticleWithLocalRefinement::setSingleLevelCellLinkedList.
+ */
+template <class KernelType>
+class Relation<Inner<Adaptive, KernelType>> : public Relation<Inner<>>
+{
+  public:
+    explicit Relation(RealBody &real_body) : Relation<Inner<>>(real_body){};
+    virtual ~Relation(){};
+};
+
+template <class KernelType>
+class Relation<Contact<Adaptive, KernelType>> : public Relation<Contact<>>
+{
+  public:
+    Relation(SPHBody &sph_body, RealBodyVector contact_bodies)
+        : Relation<Contact<>>(sph_body, contact_bodies){};
+    virtual ~Relation(){};
+};
+
+/**
+ * @brief Relations whose computing kernels use the cell-relative positions,
+ *        e.g. Relation<Inner<CellRelative>> or Relation<Contact<CellRelative, KernelCubicBSplineCK>>,
+ *        see Neighbor<CellRelative, KernelType> and EncodeCellRelativePositionCK.
+ */
+template <class KernelType>
+class Relation<Inner<CellRelative, KernelType>> : public Relation<Inner<>>
+{
+  public:
+    explicit Relation(RealBody &real_body) : Relation<Inner<>>(real_body){};
+    virtual ~Relation(){};
+};
+
+template <class KernelType>
+class Relation<Contact<CellRelative, KernelType>> : public Relation<Contact<>>
+{
+  public:
+    Relation(SPHBody &sph_body, RealBodyVector contact_bodies)
+        : Relation<Contact<>>(sph_body, contact_bodies){};
+    virtual ~Relation(){};
 };
 } // namespace SPH
 #endif // RELATION_CK_H
\ No newline at end of file
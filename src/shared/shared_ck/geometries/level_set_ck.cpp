@@ -0,0 +1,99 @@
+#include "level_set_ck.hpp"
+
+namespace SPH
+{
+//=================================================================================================//
+LevelSetCK::LevelSetCK(MultilevelLevelSet &level_set)
+    : level_set_(level_set), total_levels_(level_set.getMeshLevels().size()),
+      dv_mesh_lower_bound_(addLevelSetVariable<Vecd>("MeshLowerBound", total_levels_)),
+      dv_grid_spacing_(addLevelSetVariable<Real>("GridSpacing", total_levels_)),
+      dv_data_spacing_(addLevelSetVariable<Real>("DataSpacing", total_levels_)),
+      dv_global_h_ratio_(addLevelSetVariable<Real>("GlobalHRatio", total_levels_)),
+      dv_all_cells_(addLevelSetVariable<Arrayi>("AllCells", total_levels_)),
+      dv_cell_offset_(addLevelSetVariable<UnsignedInt>("CellOffset", total_levels_)),
+      dv_package_offset_(addLevelSetVariable<UnsignedInt>("PackageOffset", total_levels_))
+{
+    StdVec<MeshWithGridDataPackagesType *> mesh_levels = level_set.getMeshLevels();
+    StdVec<Real> global_h_ratios = level_set.getGlobalHRatios();
+    UnsignedInt total_cells = 0;
+    UnsignedInt total_packages = 0;
+    for (UnsignedInt l = 0; l != total_levels_; ++l)
+    {
+        MeshWithGridDataPackagesType &mesh_data = *mesh_levels[l];
+        dv_mesh_lower_bound_->DataField()[l] = mesh_data.MeshLowerBound();
+        dv_grid_spacing_->DataField()[l] = mesh_data.GridSpacing();
+        dv_data_spacing_->DataField()[l] = mesh_data.DataSpacing();
+        dv_global_h_ratio_->DataField()[l] = global_h_ratios[l];
+        dv_all_cells_->DataField()[l] = mesh_data.AllCells();
+        dv_cell_offset_->DataField()[l] = total_cells;
+        dv_package_offset_->DataField()[l] = total_packages;
+        total_cells += mesh_data.NumberOfCells();
+        total_packages += mesh_data.num_grid_pkgs_;
+    }
+
+    constexpr int neighborhood_size = sizeof(CellNeighborhood) / sizeof(int);
+    dv_cell_package_index_ = addLevelSetVariable<UnsignedInt>("CellPackageIndex", total_cells);
+    dv_cell_neighborhood_ = addLevelSetVariable<UnsignedInt>("CellNeighborhood", total_packages * neighborhood_size);
+    dv_is_core_package_ = addLevelSetVariable<int>("IsCorePackage", total_packages);
+    for (UnsignedInt l = 0; l != total_levels_; ++l)
+    {
+        MeshWithGridDataPackagesType &mesh_data = *mesh_levels[l];
+        Arrayi all_cells = mesh_data.AllCells();
+        UnsignedInt *cell_package_index = dv_cell_package_index_->DataField() + dv_cell_offset_->DataField()[l];
+        mesh_for_each(Arrayi::Zero(), all_cells, [&](const Arrayi &cell_index)
+                      {
+                          UnsignedInt linear_index = 0;
+                          for (int d = 0; d != Dimensions; ++d)
+                              linear_index = linear_index * all_cells[d] + cell_index[d];
+                          cell_package_index[linear_index] = mesh_data.PackageIndexFromCellIndex(cell_index); });
+
+        UnsignedInt package_offset = dv_package_offset_->DataField()[l];
+        for (size_t package_index = 0; package_index != mesh_data.num_grid_pkgs_; ++package_index)
+        {
+            UnsignedInt *neighborhood = dv_cell_neighborhood_->DataField() + (package_offset + package_index) * neighborhood_size;
+            bool is_singular = package_index < 2; // singular packages have no neighborhood
+            const int *cell_neighborhood = reinterpret_cast<const int *>(&mesh_data.cell_neighborhood_[package_index]);
+            for (int n = 0; n != neighborhood_size; ++n)
+                neighborhood[n] = is_singular ? package_index : cell_neighborhood[n];
+            dv_is_core_package_->DataField()[package_offset + package_index] =
+                is_singular ? 0 : mesh_data.meta_data_cell_[package_index].second;
+        }
+    }
+
+    constexpr int package_data_size = sizeof(PackageDataMatrix<Real, 4>) / sizeof(Real);
+    dv_phi_ = addLevelSetVariable<Real>("Levelset", total_packages * package_data_size);
+    dv_kernel_weight_ = addLevelSetVariable<Real>("KernelWeight", total_packages * package_data_size);
+    dv_phi_gradient_ = addLevelSetVariable<Vecd>("LevelsetGradient", total_packages * package_data_size);
+    dv_kernel_gradient_ = addLevelSetVariable<Vecd>("KernelGradient", total_packages * package_data_size);
+    updateMeshVariableData();
+}
+//=================================================================================================//
+template <typename DataType>
+void LevelSetCK::copyPackageData(const std::string &name, DiscreteVariable<DataType> *dv_data)
+{
+    constexpr int package_data_size = sizeof(PackageDataMatrix<DataType, 4>) / sizeof(DataType);
+    StdVec<MeshWithGridDataPackagesType *> mesh_levels = level_set_.getMeshLevels();
+    for (UnsignedInt l = 0; l != total_levels_; ++l)
+    {
+        MeshWithGridDataPackagesType &mesh_data = *mesh_levels[l];
+        const DataType *mesh_variable_data =
+            reinterpret_cast<const DataType *>(mesh_data.getMeshVariable<DataType>(name)->DataField());
+        std::copy(mesh_variable_data, mesh_variable_data + mesh_data.num_grid_pkgs_ * package_data_size,
+                  dv_data->DataField() + dv_package_offset_->DataField()[l] * package_data_size);
+    }
+#if SPHINXSYS_USE_SYCL
+    if (dv_data->existDeviceDataField())
+        dv_data->synchronizeToDevice();
+#endif
+}
+//=================================================================================================//
+void LevelSetCK::updateMeshVariableData()
+{
+    level_set_.prepareAllKernelIntegrals();
+    copyPackageData("Levelset", dv_phi_);
+    copyPackageData("KernelWeight", dv_kernel_weight_);
+    copyPackageData("LevelsetGradient", dv_phi_gradient_);
+    copyPackageData("KernelGradient", dv_kernel_gradient_);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,103 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    level_set_ck.h
+ * @brief   The multilevel level set flattened into discrete variables,
+ *          so that it can be probed in computing kernels, also on device.
+ * @details The index meshes, cell neighborhoods and package data of all levels
+ *          are concatenated with the offsets of each level.
+ *          The probes are the same as those of MultilevelLevelSet
+ *          but without virtual function calls or nested pointers.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef LEVEL_SET_CK_H
+#define LEVEL_SET_CK_H
+
+#include "level_set.h"
+
+namespace SPH
+{
+class LevelSetCK
+{
+    UniquePtrsKeeper<Entity> variable_ptrs_;
+
+  public:
+    explicit LevelSetCK(MultilevelLevelSet &level_set);
+    ~LevelSetCK(){};
+    /** copy the package data again, e.g. after the level set is cleaned */
+    void updateMeshVariableData();
+
+    class ProbeKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ProbeKernel(const ExecutionPolicy &ex_policy, LevelSetCK &encloser);
+
+        Real probeSignedDistance(const Vecd &position);
+        Vecd probeLevelSetGradient(const Vecd &position);
+        Vecd probeNormalDirection(const Vecd &position);
+        Real probeKernelIntegral(const Vecd &position, Real h_ratio = 1.0);
+        Vecd probeKernelGradientIntegral(const Vecd &position, Real h_ratio = 1.0);
+
+      protected:
+        UnsignedInt total_levels_;
+        Vecd *mesh_lower_bound_;
+        Real *grid_spacing_, *data_spacing_, *global_h_ratio_;
+        Arrayi *all_cells_;
+        UnsignedInt *cell_offset_, *package_offset_;
+        UnsignedInt *cell_package_index_, *cell_neighborhood_;
+        int *is_core_package_;
+        Real *phi_, *kernel_weight_;
+        Vecd *phi_gradient_, *kernel_gradient_;
+
+        /** the finest level on which the position is within a core package */
+        UnsignedInt ProbeLevel(const Vecd &position);
+        /** the coarser one of the two levels bounding the h_ratio */
+        UnsignedInt CoarseLevel(Real h_ratio);
+        template <typename DataType>
+        DataType probeMesh(DataType *data, UnsignedInt level, const Vecd &position);
+        template <typename DataType>
+        DataType probeBetweenLevels(DataType *data, const Vecd &position, Real h_ratio);
+    };
+
+  protected:
+    MultilevelLevelSet &level_set_;
+    UnsignedInt total_levels_;
+    DiscreteVariable<Vecd> *dv_mesh_lower_bound_;
+    DiscreteVariable<Real> *dv_grid_spacing_, *dv_data_spacing_, *dv_global_h_ratio_;
+    DiscreteVariable<Arrayi> *dv_all_cells_;
+    DiscreteVariable<UnsignedInt> *dv_cell_offset_, *dv_package_offset_;
+    DiscreteVariable<UnsignedInt> *dv_cell_package_index_; /**< package index of each cell on its level */
+    DiscreteVariable<UnsignedInt> *dv_cell_neighborhood_;  /**< flattened 3^d neighborhood of each package */
+    DiscreteVariable<int> *dv_is_core_package_;
+    DiscreteVariable<Real> *dv_phi_, *dv_kernel_weight_;
+    DiscreteVariable<Vecd> *dv_phi_gradient_, *dv_kernel_gradient_;
+
+    template <typename DataType>
+    DiscreteVariable<DataType> *addLevelSetVariable(const std::string &name, size_t data_size);
+    template <typename DataType>
+    void copyPackageData(const std::string &name, DiscreteVariable<DataType> *dv_data);
+};
+} // namespace SPH
+#endif // LEVEL_SET_CK_H
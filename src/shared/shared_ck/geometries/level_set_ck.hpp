@@ -0,0 +1,168 @@
+#ifndef LEVEL_SET_CK_HPP
+#define LEVEL_SET_CK_HPP
+
+#include "level_set_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <typename DataType>
+DiscreteVariable<DataType> *LevelSetCK::addLevelSetVariable(const std::string &name, size_t data_size)
+{
+    return variable_ptrs_.createPtr<DiscreteVariable<DataType>>(name, data_size);
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+LevelSetCK::ProbeKernel::ProbeKernel(const ExecutionPolicy &ex_policy, LevelSetCK &encloser)
+    : total_levels_(encloser.total_levels_),
+      mesh_lower_bound_(encloser.dv_mesh_lower_bound_->DelegatedDataField(ex_policy)),
+      grid_spacing_(encloser.dv_grid_spacing_->DelegatedDataField(ex_policy)),
+      data_spacing_(encloser.dv_data_spacing_->DelegatedDataField(ex_policy)),
+      global_h_ratio_(encloser.dv_global_h_ratio_->DelegatedDataField(ex_policy)),
+      all_cells_(encloser.dv_all_cells_->DelegatedDataField(ex_policy)),
+      cell_offset_(encloser.dv_cell_offset_->DelegatedDataField(ex_policy)),
+      package_offset_(encloser.dv_package_offset_->DelegatedDataField(ex_policy)),
+      cell_package_index_(encloser.dv_cell_package_index_->DelegatedDataField(ex_policy)),
+      cell_neighborhood_(encloser.dv_cell_neighborhood_->DelegatedDataField(ex_policy)),
+      is_core_package_(encloser.dv_is_core_package_->DelegatedDataField(ex_policy)),
+      phi_(encloser.dv_phi_->DelegatedDataField(ex_policy)),
+      kernel_weight_(encloser.dv_kernel_weight_->DelegatedDataField(ex_policy)),
+      phi_gradient_(encloser.dv_phi_gradient_->DelegatedDataField(ex_policy)),
+      kernel_gradient_(encloser.dv_kernel_gradient_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+inline UnsignedInt LevelSetCK::ProbeKernel::ProbeLevel(const Vecd &position)
+{
+    for (UnsignedInt level = total_levels_; level != 0; --level)
+    {
+        UnsignedInt l = level - 1;
+        Arrayi cell_index = floor((position - mesh_lower_bound_[l]).array() / grid_spacing_[l])
+                                .template cast<int>()
+                                .max(Arrayi::Zero())
+                                .min(all_cells_[l] - Arrayi::Ones());
+        UnsignedInt linear_index = 0;
+        for (int d = 0; d != Dimensions; ++d)
+            linear_index = linear_index * all_cells_[l][d] + cell_index[d];
+
+        UnsignedInt package_index = cell_package_index_[cell_offset_[l] + linear_index];
+        if (is_core_package_[package_offset_[l] + package_index] == 1)
+            return l; // jump out of the loop!
+    }
+    return 0;
+}
+//=================================================================================================//
+inline UnsignedInt LevelSetCK::ProbeKernel::CoarseLevel(Real h_ratio)
+{
+    for (UnsignedInt level = total_levels_ - 1; level != 0; --level)
+        if (h_ratio > global_h_ratio_[level - 1])
+            return level - 1; // jump out the loop!
+    return 0;
+}
+//=================================================================================================//
+template <typename DataType>
+DataType LevelSetCK::ProbeKernel::probeMesh(DataType *data, UnsignedInt level, const Vecd &position)
+{
+    constexpr int pkg_size = 4;
+    constexpr int package_data_size = Dimensions == 2 ? pkg_size * pkg_size : pkg_size * pkg_size * pkg_size;
+    constexpr int neighborhood_size = Dimensions == 2 ? 9 : 27;
+
+    Arrayi cell_index = floor((position - mesh_lower_bound_[level]).array() / grid_spacing_[level])
+                            .template cast<int>()
+                            .max(Arrayi::Zero())
+                            .min(all_cells_[level] - Arrayi::Ones());
+    UnsignedInt linear_cell_index = 0;
+    for (int d = 0; d != Dimensions; ++d)
+        linear_cell_index = linear_cell_index * all_cells_[level][d] + cell_index[d];
+
+    UnsignedInt package_index = cell_package_index_[cell_offset_[level] + linear_cell_index];
+    UnsignedInt package_offset = package_offset_[level];
+    if (package_index < 2) // singular package
+        return data[(package_offset + package_index) * package_data_size];
+
+    Real data_spacing = data_spacing_[level];
+    Vecd data_lower_bound = mesh_lower_bound_[level] +
+                            cell_index.cast<Real>().matrix() * grid_spacing_[level] +
+                            0.5 * data_spacing * Vecd::Ones();
+    Arrayi data_index = floor((position - data_lower_bound).array() / data_spacing)
+                            .template cast<int>()
+                            .max(Arrayi::Zero())
+                            .min((pkg_size - 1) * Arrayi::Ones());
+    Vecd alpha = (position - data_lower_bound - data_index.cast<Real>().matrix() * data_spacing) / data_spacing;
+    Vecd beta = Vecd::Ones() - alpha;
+
+    UnsignedInt *neighborhood = cell_neighborhood_ + (package_offset + package_index) * neighborhood_size;
+    DataType probed_value = data[0];
+    for (int corner = 0; corner != (1 << Dimensions); ++corner)
+    {
+        Real weight = 1.0;
+        UnsignedInt neighbor_index = 0;
+        UnsignedInt local_index = 0;
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            int shift = (corner >> d) & 1;
+            weight *= shift == 1 ? alpha[d] : beta[d];
+            int shifted_index = data_index[d] + shift + pkg_size;
+            int neighbor = shifted_index / pkg_size;
+            neighbor_index = neighbor_index * 3 + neighbor;
+            local_index = local_index * pkg_size + shifted_index - neighbor * pkg_size;
+        }
+        UnsignedInt neighbor_package = package_offset + neighborhood[neighbor_index];
+        DataType corner_value = data[neighbor_package * package_data_size + local_index] * weight;
+        if (corner == 0)
+            probed_value = corner_value;
+        else
+            probed_value += corner_value;
+    }
+    return probed_value;
+}
+//=================================================================================================//
+template <typename DataType>
+DataType LevelSetCK::ProbeKernel::probeBetweenLevels(DataType *data, const Vecd &position, Real h_ratio)
+{
+    if (total_levels_ == 1)
+        return probeMesh(data, 0, position);
+
+    UnsignedInt coarse_level = CoarseLevel(h_ratio);
+    Real alpha = (global_h_ratio_[coarse_level + 1] - h_ratio) /
+                 (global_h_ratio_[coarse_level + 1] - global_h_ratio_[coarse_level]);
+    return probeMesh(data, coarse_level, position) * alpha +
+           probeMesh(data, coarse_level + 1, position) * (1.0 - alpha);
+}
+//=================================================================================================//
+inline Real LevelSetCK::ProbeKernel::probeSignedDistance(const Vecd &position)
+{
+    return probeMesh(phi_, ProbeLevel(position), position);
+}
+//=================================================================================================//
+inline Vecd LevelSetCK::ProbeKernel::probeLevelSetGradient(const Vecd &position)
+{
+    return probeMesh(phi_gradient_, ProbeLevel(position), position);
+}
+//=================================================================================================//
+inline Vecd LevelSetCK::ProbeKernel::probeNormalDirection(const Vecd &position)
+{
+    UnsignedInt level = ProbeLevel(position);
+    Vecd probed_value = probeMesh(phi_gradient_, level, position);
+
+    // deterministic jittering along the axes instead of the random one on host
+    Real threshold = 1.0e-2 * data_spacing_[level];
+    for (int n = 0; n != 2 * Dimensions && probed_value.norm() < threshold; ++n)
+    {
+        Vecd jittered = position;
+        jittered[n / 2] += (n % 2 == 0 ? 0.25 : -0.25) * data_spacing_[level];
+        probed_value = probeMesh(phi_gradient_, level, jittered);
+    }
+    return probed_value / (probed_value.norm() + TinyReal);
+}
+//=================================================================================================//
+inline Real LevelSetCK::ProbeKernel::probeKernelIntegral(const Vecd &position, Real h_ratio)
+{
+    return probeBetweenLevels(kernel_weight_, position, h_ratio);
+}
+//=================================================================================================//
+inline Vecd LevelSetCK::ProbeKernel::probeKernelGradientIntegral(const Vecd &position, Real h_ratio)
+{
+    return probeBetweenLevels(kernel_gradient_, position, h_ratio);
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // LEVEL_SET_CK_HPP
@@ -33,7 +33,7 @@
 
 #include "execution_policy.h"
 #include "interpolation_dynamics.hpp"
-#include "io_plt.h"
+#include "io_time_series.h"
 
 namespace SPH
 {
@@ -49,6 +49,7 @@ class ObservedQuantityRecording<ExecutionPolicy, DataType>
     std::string dynamics_identifier_name_;
     const std::string quantity_name_;
     std::string filefullpath_output_;
+    QuantityTimeSeries<DataType> time_series_;
 
   public:
     DataType type_indicator_; /*< this is an indicator to identify the variable type. */
@@ -60,11 +61,13 @@ class ObservedQuantityRecording<ExecutionPolicy, DataType>
           observer_(contact_relation.getSPHBody()), plt_engine_(),
           base_particles_(observer_.getBaseParticles()),
           dynamics_identifier_name_(contact_relation.getSPHBody().getName()),
-          quantity_name_(quantity_name)
+          quantity_name_(quantity_name),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + ".dat"),
+          time_series_(filefullpath_output_, base_particles_.TotalRealParticles(),
+                       sph_system_.ObservationBufferSize(), sph_system_.ObservationBinaryOutput())
     {
         DataType *interpolated_quantities = this->dv_interpolated_quantities_->DataField();
         /** Output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name + ".dat";
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << "run_time"
                  << "   ";
@@ -77,21 +80,14 @@ class ObservedQuantityRecording<ExecutionPolicy, DataType>
         out_file << "\n";
         out_file.close();
     };
-    virtual ~ObservedQuantityRecording(){};
+    virtual ~ObservedQuantityRecording() { flushQuantities(time_series_); };
 
     virtual void writeWithFileName(const std::string &sequence) override
     {
         this->exec();
         this->dv_interpolated_quantities_->prepareForOutput(ExecutionPolicy{});
-        DataType *interpolated_quantities = this->dv_interpolated_quantities_->DataField();
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << sv_physical_time_.getValue() << "   ";
-        for (size_t i = 0; i != base_particles_.TotalRealParticles(); ++i)
-        {
-            plt_engine_.writeAQuantity(out_file, interpolated_quantities[i]);
-        }
-        out_file << "\n";
-        out_file.close();
+        waitForOutputTransfers(ExecutionPolicy{});
+        writeQuantities(time_series_, sv_physical_time_.getValue(), this->dv_interpolated_quantities_->DataField());
     };
 
     DataType *getObservedQuantity()
@@ -109,6 +105,7 @@ class ReducedQuantityRecording<ExecutionPolicy, LocalReduceMethodType> : public
     std::string dynamics_identifier_name_;
     const std::string quantity_name_;
     std::string filefullpath_output_;
+    QuantityTimeSeries<typename LocalReduceMethodType::ReturnType> time_series_;
 
   public:
     /*< deduce variable type from reduce method. */
@@ -121,10 +118,11 @@ class ReducedQuantityRecording<ExecutionPolicy, LocalReduceMethodType> : public
         : BaseIO(identifier.getSPHBody().getSPHSystem()), plt_engine_(),
           reduce_method_(identifier, std::forward<Args>(args)...),
           dynamics_identifier_name_(reduce_method_.DynamicsIdentifierName()),
-          quantity_name_(reduce_method_.QuantityName())
+          quantity_name_(reduce_method_.QuantityName()),
+          filefullpath_output_(io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat"),
+          time_series_(filefullpath_output_, 1, sph_system_.ObservationBufferSize(), sph_system_.ObservationBinaryOutput())
     {
         /** output for .dat file. */
-        filefullpath_output_ = io_environment_.output_folder_ + "/" + dynamics_identifier_name_ + "_" + quantity_name_ + ".dat";
         std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
         out_file << "\"run_time\""
                  << "   ";
@@ -132,15 +130,11 @@ class ReducedQuantityRecording<ExecutionPolicy, LocalReduceMethodType> : public
         out_file << "\n";
         out_file.close();
     };
-    virtual ~ReducedQuantityRecording(){};
+    virtual ~ReducedQuantityRecording() { flushQuantities(time_series_); };
 
     virtual void writeToFile(size_t iteration_step = 0) override
     {
-        std::ofstream out_file(filefullpath_output_.c_str(), std::ios::app);
-        out_file << sv_physical_time_.getValue() << "   ";
-        plt_engine_.writeAQuantity(out_file, reduce_method_.exec());
-        out_file << "\n";
-        out_file.close();
+        writeQuantities(time_series_, sv_physical_time_.getValue(), reduce_method_.exec());
     };
 };
 } // namespace SPH
@@ -31,7 +31,7 @@
 #ifndef NEIGHBORHOOD_CK_H
 #define NEIGHBORHOOD_CK_H
 
-#include "kernel_wenland_c2_ck.h"
+#include "all_kernels_ck.h"
 #include "neighborhood.h"
 
 namespace SPH
@@ -39,18 +39,29 @@ namespace SPH
 template <typename... T>
 class Neighbor;
 
-template <>
-class Neighbor<>
+/**
+ * @class Neighbor
+ * @brief Pair geometry and kernel values of computing kernels,
+ *        with the smoothing kernel type as compile-time parameter.
+ */
+template <class KernelType>
+class Neighbor<KernelType>
 {
   public:
     template <class ExecutionPolicy>
-    Neighbor(const ExecutionPolicy &ex_policy, SPHAdaptation *sph_adaptation, DiscreteVariable<Vecd> *dv_pos);
+    Neighbor(const ExecutionPolicy &ex_policy, SPHAdaptation *sph_adaptation, DiscreteVariable<Vecd> *dv_pos,
+             const PeriodicImage &periodic_image = PeriodicImage());
 
     template <class ExecutionPolicy>
     Neighbor(const ExecutionPolicy &ex_policy, SPHAdaptation *sph_adaptation, SPHAdaptation *contact_adaptation,
-             DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_target_pos);
+             DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_target_pos,
+             const PeriodicImage &periodic_image = PeriodicImage());
 
-    inline Vecd vec_r_ij(size_t i, size_t j) const { return source_pos_[i] - target_pos_[j]; };
+    /** displacement to the nearest image of the neighbor when the search is periodic */
+    inline Vecd vec_r_ij(size_t i, size_t j) const
+    {
+        return periodic_image_.MinimumImage(source_pos_[i] - target_pos_[j]);
+    };
     inline Real W_ij(size_t i, size_t j) const { return kernel_.W(vec_r_ij(i, j)); }
     inline Real dW_ij(size_t i, size_t j) const { return kernel_.dW(vec_r_ij(i, j)); }
 
@@ -60,10 +71,193 @@ class Neighbor<>
         return displacement / (displacement.norm() + TinyReal);
     }
 
+    /** the neighbors are all the particles found by the search, e.g. within the cut-off radius plus a Verlet skin */
+    template <class SearchType, typename FunctionOnEach>
+    void forEachNeighbor(const SearchType &search, UnsignedInt i, const FunctionOnEach &function) const
+    {
+        search.forEachSearch(i, source_pos_, function);
+    };
+
   protected:
-    KernelWendlandC2CK kernel_;
+    KernelType kernel_;
     Vecd *source_pos_;
     Vecd *target_pos_;
+    PeriodicImage periodic_image_;
+};
+
+/** The default uses the Wendland C2 kernel. */
+template <>
+class Neighbor<> : public Neighbor<KernelWendlandC2CK>
+{
+  public:
+    template <typename... Args>
+    Neighbor(Args &&...args) : Neighbor<KernelWendlandC2CK>(std::forward<Args>(args)...){};
+};
+
+/**
+ * @class Neighbor<Adaptive, KernelType>
+ * @brief Pair kernel values with the smoothing length of each particle, e.g. by ParticleWithLocalRefinement,
+ *        symmetrized with the average smoothing length of the pair, i.e. h_ij = (h_i + h_j) / 2.
+ *        The smoothing lengths are given as the ratios of the kernel smoothing length to them,
+ *        and a body without local refinement has the reference smoothing length of its own.
+ *        The search radius of the cell linked list is taken as the largest cut-off radius of the particles listed,
+ *        so that each particle searches only as far as its largest pair cut-off radius.
+ */
+template <class KernelType>
+class Neighbor<Adaptive, KernelType> : public Neighbor<KernelType>
+{
+  public:
+    template <class ExecutionPolicy>
+    Neighbor(const ExecutionPolicy &ex_policy, SPHAdaptation *sph_adaptation, DiscreteVariable<Vecd> *dv_pos,
+             const PeriodicImage &periodic_image = PeriodicImage());
+
+    template <class ExecutionPolicy>
+    Neighbor(const ExecutionPolicy &ex_policy, SPHAdaptation *sph_adaptation, SPHAdaptation *contact_adaptation,
+             DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_target_pos,
+             const PeriodicImage &periodic_image = PeriodicImage());
+
+    inline Real h_ratio_ij(size_t i, size_t j) const
+    {
+        const Real h_ratio_i = SourceHRatio(i);
+        const Real h_ratio_j = target_h_scale_ * (target_h_ratio_ != nullptr ? target_h_ratio_[j] : Real(1));
+        return 2.0 * h_ratio_i * h_ratio_j / (h_ratio_i + h_ratio_j);
+    };
+    inline Real W_ij(size_t i, size_t j) const { return this->kernel_.W(h_ratio_ij(i, j), this->vec_r_ij(i, j)); }
+    inline Real dW_ij(size_t i, size_t j) const { return this->kernel_.dW(h_ratio_ij(i, j), this->vec_r_ij(i, j)); }
+
+    template <class SearchType, typename FunctionOnEach>
+    void forEachNeighbor(const SearchType &search, UnsignedInt i, const FunctionOnEach &function) const
+    {
+        const Real skin = search.VerletSkin();
+        const Real largest_cutoff = 0.5 * (this->kernel_.CutOffRadius(SourceHRatio(i)) + search.SearchRadius() - skin);
+        search.forEachSearch(
+            i, this->source_pos_, SMIN(largest_cutoff + skin, search.SearchRadius()),
+            [&](UnsignedInt j)
+            {
+                const Real cutoff = this->kernel_.CutOffRadius(h_ratio_ij(i, j)) + skin;
+                const Vecd displacement = this->periodic_image_.MinimumImage(this->source_pos_[i] - this->target_pos_[j]);
+                if (displacement.squaredNorm() < cutoff * cutoff)
+                    function(j);
+            });
+    };
+
+  protected:
+    Real *source_h_ratio_;
+    Real *target_h_ratio_;
+    Real source_h_scale_; /**< converting the ratios of a body to those of the kernel smoothing length */
+    Real target_h_scale_;
+
+    inline Real SourceHRatio(size_t i) const
+    {
+        return source_h_scale_ * (source_h_ratio_ != nullptr ? source_h_ratio_[i] : Real(1));
+    };
+    template <class ExecutionPolicy>
+    static Real *getSmoothingLengthRatio(const ExecutionPolicy &ex_policy, SPHAdaptation *sph_adaptation);
+};
+
+/** The default adaptive neighbor uses the Wendland C2 kernel. */
+template <>
+class Neighbor<Adaptive> : public Neighbor<Adaptive, KernelWendlandC2CK>
+{
+  public:
+    template <typename... Args>
+    Neighbor(Args &&...args) : Neighbor<Adaptive, KernelWendlandC2CK>(std::forward<Args>(args)...){};
+};
+
+/**
+ * @class CellRelativeDisplacement
+ * @brief The pair displacement from the cell-relative positions of the source and target particles,
+ *        see CellRelativePosition. The variables are set by useCellRelativePosition.
+ */
+class CellRelativeDisplacement
+{
+  public:
+    void setCellRelativePosition(const CellRelativePosition &cell_frame,
+                                 Vecd *source_cell, Vecd *source_offset,
+                                 Vecd *target_cell, Vecd *target_offset)
+    {
+        cell_frame_ = cell_frame;
+        source_cell_ = source_cell;
+        source_offset_ = source_offset;
+        target_cell_ = target_cell;
+        target_offset_ = target_offset;
+    };
+
+  protected:
+    CellRelativePosition cell_frame_;
+    Vecd *source_cell_ = nullptr;
+    Vecd *source_offset_ = nullptr;
+    Vecd *target_cell_ = nullptr;
+    Vecd *target_offset_ = nullptr;
+
+    inline Vecd CellRelativeVecRij(size_t i, size_t j) const
+    {
+        return cell_frame_.displacement(source_cell_[i], source_offset_[i], target_cell_[j], target_offset_[j]);
+    };
+};
+
+/**
+ * @class Neighbor<CellRelative, KernelType>
+ * @brief Pair kernel values with the displacements computed from the cell-relative positions,
+ *        e.g. by Relation<Inner<CellRelative>>, for large single-precision domains.
+ *        The source and target bodies are to be encoded in the same frame by EncodeCellRelativePositionCK.
+ *        The neighbor search still uses the absolute positions.
+ */
+template <class KernelType>
+class Neighbor<CellRelative, KernelType> : public Neighbor<KernelType>, public CellRelativeDisplacement
+{
+  public:
+    template <typename... Args>
+    Neighbor(Args &&...args) : Neighbor<KernelType>(std::forward<Args>(args)...){};
+
+    inline Vecd vec_r_ij(size_t i, size_t j) const
+    {
+        return this->periodic_image_.MinimumImage(CellRelativeVecRij(i, j));
+    };
+    inline Real W_ij(size_t i, size_t j) const { return this->kernel_.W(vec_r_ij(i, j)); }
+    inline Real dW_ij(size_t i, size_t j) const { return this->kernel_.dW(vec_r_ij(i, j)); }
+
+    inline Vecd e_ij(size_t i, size_t j) const
+    {
+        Vecd displacement = vec_r_ij(i, j);
+        return displacement / (displacement.norm() + TinyReal);
+    }
+};
+
+/** The default cell-relative neighbor uses the Wendland C2 kernel. */
+template <>
+class Neighbor<CellRelative> : public Neighbor<CellRelative, KernelWendlandC2CK>
+{
+  public:
+    template <typename... Args>
+    Neighbor(Args &&...args) : Neighbor<CellRelative, KernelWendlandC2CK>(std::forward<Args>(args)...){};
+};
+
+/**
+ * @class PairGeometryCache
+ * @brief Optional per-pair storage of kernel gradient and unit vector, addressed by the neighbor list index.
+ *        It is written by a kernel evaluating the pair geometry and read by a later kernel
+ *        on the same neighbor list while particle positions are unchanged, e.g. the 2nd half acoustic step.
+ *        When the cache is not enabled in the relation, the pointers are null and nothing is cached.
+ *        The writer stamps the relation with its configuration version, which the reader checks in debug builds.
+ */
+class PairGeometryCache
+{
+  public:
+    template <class ExecutionPolicy>
+    PairGeometryCache(const ExecutionPolicy &ex_policy,
+                      DiscreteVariable<Real> *dv_pair_dW_ij,
+                      DiscreteVariable<Vecd> *dv_pair_e_ij);
+
+  protected:
+    Real *pair_dW_ij_;
+    Vecd *pair_e_ij_;
+    inline bool isPairGeometryCached() const { return pair_dW_ij_ != nullptr; };
+    inline void cachePairGeometry(UnsignedInt n, Real dW_ij, const Vecd &e_ij)
+    {
+        pair_dW_ij_[n] = dW_ij;
+        pair_e_ij_[n] = e_ij;
+    };
 };
 
 class NeighborList
@@ -80,5 +274,23 @@ class NeighborList
     inline UnsignedInt FirstNeighbor(UnsignedInt i) { return particle_offset_[i]; };
     inline UnsignedInt LastNeighbor(UnsignedInt i) { return particle_offset_[i + 1]; };
 };
+
+/**
+ * @class FaceNeighborList
+ * @brief Neighbor list of the cells of an unstructured mesh, with the face geometry
+ *        ordered as the neighbor index, so that FVM kernels are written as particle kernels
+ *        and run under the same execution policies, including par_device.
+ */
+class FaceNeighborList : public NeighborList
+{
+  public:
+    template <class ExecutionPolicy, class FaceRelationType>
+    FaceNeighborList(const ExecutionPolicy &ex_policy, FaceRelationType &face_relation);
+
+  protected:
+    Real *face_area_;
+    Real *face_distance_;
+    Vecd *face_normal_; /**< unit normal pointing into the cell */
+};
 } // namespace SPH
 #endif // NEIGHBORHOOD_CK_H
\ No newline at end of file
@@ -3,31 +3,76 @@
 
 #include "neighborhood_ck.h"
 
+#include "adaptation.h"
+
 namespace SPH
 {
 //=================================================================================================//
+template <class KernelType>
 template <class ExecutionPolicy>
-Neighbor<>::Neighbor(const ExecutionPolicy &ex_policy,
-                     SPHAdaptation *sph_adaptation, DiscreteVariable<Vecd> *dv_pos)
+Neighbor<KernelType>::Neighbor(const ExecutionPolicy &ex_policy,
+                               SPHAdaptation *sph_adaptation, DiscreteVariable<Vecd> *dv_pos,
+                               const PeriodicImage &periodic_image)
     : kernel_(*sph_adaptation->getKernel()),
       source_pos_(dv_pos->DelegatedDataField(ex_policy)),
-      target_pos_(dv_pos->DelegatedDataField(ex_policy)){};
+      target_pos_(dv_pos->DelegatedDataField(ex_policy)),
+      periodic_image_(periodic_image){};
 //=================================================================================================//
+template <class KernelType>
 template <class ExecutionPolicy>
-Neighbor<>::Neighbor(const ExecutionPolicy &ex_policy,
-                     SPHAdaptation *sph_adaptation, SPHAdaptation *contact_adaptation,
-                     DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_contact_pos)
+Neighbor<KernelType>::Neighbor(const ExecutionPolicy &ex_policy,
+                               SPHAdaptation *sph_adaptation, SPHAdaptation *contact_adaptation,
+                               DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_contact_pos,
+                               const PeriodicImage &periodic_image)
     : kernel_(*sph_adaptation->getKernel()),
       source_pos_(dv_pos->DelegatedDataField(ex_policy)),
-      target_pos_(dv_contact_pos->DelegatedDataField(ex_policy))
+      target_pos_(dv_contact_pos->DelegatedDataField(ex_policy)),
+      periodic_image_(periodic_image)
 {
-    KernelWendlandC2CK contact_kernel(*contact_adaptation->getKernel());
+    KernelType contact_kernel(*contact_adaptation->getKernel());
     if (kernel_.CutOffRadius() < contact_kernel.CutOffRadius())
     {
         kernel_ = contact_kernel;
     }
 }
 //=================================================================================================//
+template <class KernelType>
+template <class ExecutionPolicy>
+Neighbor<Adaptive, KernelType>::Neighbor(const ExecutionPolicy &ex_policy,
+                                         SPHAdaptation *sph_adaptation, DiscreteVariable<Vecd> *dv_pos,
+                                         const PeriodicImage &periodic_image)
+    : Neighbor<KernelType>(ex_policy, sph_adaptation, dv_pos, periodic_image),
+      source_h_ratio_(getSmoothingLengthRatio(ex_policy, sph_adaptation)),
+      target_h_ratio_(source_h_ratio_), source_h_scale_(1.0), target_h_scale_(1.0) {}
+//=================================================================================================//
+template <class KernelType>
+template <class ExecutionPolicy>
+Neighbor<Adaptive, KernelType>::Neighbor(const ExecutionPolicy &ex_policy,
+                                         SPHAdaptation *sph_adaptation, SPHAdaptation *contact_adaptation,
+                                         DiscreteVariable<Vecd> *dv_pos, DiscreteVariable<Vecd> *dv_contact_pos,
+                                         const PeriodicImage &periodic_image)
+    : Neighbor<KernelType>(ex_policy, sph_adaptation, contact_adaptation, dv_pos, dv_contact_pos, periodic_image),
+      source_h_ratio_(getSmoothingLengthRatio(ex_policy, sph_adaptation)),
+      target_h_ratio_(getSmoothingLengthRatio(ex_policy, contact_adaptation)),
+      source_h_scale_(this->kernel_.CutOffRadius() / sph_adaptation->getKernel()->CutOffRadius()),
+      target_h_scale_(this->kernel_.CutOffRadius() / contact_adaptation->getKernel()->CutOffRadius()) {}
+//=================================================================================================//
+template <class KernelType>
+template <class ExecutionPolicy>
+Real *Neighbor<Adaptive, KernelType>::getSmoothingLengthRatio(const ExecutionPolicy &ex_policy,
+                                                              SPHAdaptation *sph_adaptation)
+{
+    ParticleWithLocalRefinement *refinement = dynamic_cast<ParticleWithLocalRefinement *>(sph_adaptation);
+    return refinement != nullptr ? refinement->dv_h_ratio_->DelegatedDataField(ex_policy) : nullptr;
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+PairGeometryCache::PairGeometryCache(const ExecutionPolicy &ex_policy,
+                                     DiscreteVariable<Real> *dv_pair_dW_ij,
+                                     DiscreteVariable<Vecd> *dv_pair_e_ij)
+    : pair_dW_ij_(dv_pair_dW_ij != nullptr ? dv_pair_dW_ij->DelegatedDataField(ex_policy) : nullptr),
+      pair_e_ij_(dv_pair_e_ij != nullptr ? dv_pair_e_ij->DelegatedDataField(ex_policy) : nullptr) {}
+//=================================================================================================//
 template <class ExecutionPolicy>
 NeighborList::NeighborList(const ExecutionPolicy &ex_policy,
                            DiscreteVariable<UnsignedInt> *dv_neighbor_index,
@@ -35,5 +80,12 @@ NeighborList::NeighborList(const ExecutionPolicy &ex_policy,
     : neighbor_index_(dv_neighbor_index->DelegatedDataField(ex_policy)),
       particle_offset_(dv_particle_offset->DelegatedDataField(ex_policy)) {}
 //=================================================================================================//
+template <class ExecutionPolicy, class FaceRelationType>
+FaceNeighborList::FaceNeighborList(const ExecutionPolicy &ex_policy, FaceRelationType &face_relation)
+    : NeighborList(ex_policy, face_relation.getNeighborIndex(), face_relation.getParticleOffset()),
+      face_area_(face_relation.getFaceArea()->DelegatedDataField(ex_policy)),
+      face_distance_(face_relation.getFaceDistance()->DelegatedDataField(ex_policy)),
+      face_normal_(face_relation.getFaceNormal()->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
 } // namespace SPH
 #endif // NEIGHBORHOOD_CK_HPP
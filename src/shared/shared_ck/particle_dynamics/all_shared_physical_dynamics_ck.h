@@ -35,10 +35,19 @@
 #include "acoustic_step_2nd_half.hpp"
 #include "all_general_dynamics_ck.h"
 #include "complex_algorithms_ck.h"
+#include "continuum_integration_ck.hpp"
 #include "density_regularization.hpp"
+#include "diffusion_dynamics_ck.hpp"
+#include "distributed_dynamics_ck.hpp"
+#include "distributed_load_balance.h"
+#include "elastic_dynamics_ck.hpp"
+#include "electro_physiology_ck.h"
 #include "fluid_time_step_ck.hpp"
 #include "interaction_algorithms_ck.hpp"
 #include "particle_sort_ck.hpp"
+#include "porous_media_dynamics_ck.hpp"
+#include "reaction_dynamics_ck.hpp"
+#include "relax_stepping_ck.hpp"
 #include "simple_algorithms_ck.h"
 
 #endif // ALL_SHARED_PHYSICAL_DYNAMICS_CK_H
@@ -0,0 +1,27 @@
+#include "block_time_stepping_ck.h"
+
+#include "base_particles.hpp"
+
+namespace SPH
+{
+//=================================================================================================//
+BlockTimeStepping::BlockTimeStepping(SPHBody &sph_body, UnsignedInt max_level)
+    : sph_body_(sph_body), max_level_(max_level), block_level_(0), sub_step_(0),
+      dv_level_(sph_body.getBaseParticles().registerDiscreteVariableOnly<UnsignedInt>(
+          "TimeStepLevel", sph_body.getBaseParticles().ParticlesBound())),
+      dv_level_estimate_(sph_body.getBaseParticles().registerDiscreteVariableOnly<UnsignedInt>(
+          "TimeStepLevelEstimate", sph_body.getBaseParticles().ParticlesBound())) {}
+//=================================================================================================//
+void BlockTimeStepping::beginSubStep(UnsignedInt sub_step)
+{
+    sub_step_ = sub_step;
+    sph_body_.setBlockTimeStepping(this);
+}
+//=================================================================================================//
+void BlockTimeStepping::endBlock()
+{
+    sub_step_ = 0;
+    sph_body_.setBlockTimeStepping(nullptr);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,127 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    block_time_stepping_ck.h
+ * @brief   Hierarchical block time stepping, in which the particles of a body
+ *          advance with their own power-of-two multiples of the finest time-step size.
+ * @details A particle of level k advances with 2^k times the finest step size. A block consists of
+ *          the finest sub-steps up to the coarsest level in use, and on sub-step s the particles
+ *          of the levels k with s a multiple of 2^k are active. During a block, the interaction and
+ *          update steps of the interaction dynamics on the body are only run on the active particles
+ *          with their own step sizes, while the initialization steps are run on all particles
+ *          with the finest step size, so that the inactive particles, e.g. their positions and densities,
+ *          are interpolated with their last rates of change. The levels are assigned at the beginning
+ *          of a block, e.g. by AcousticTimeStepLevelCK, and limited by TimeStepLevelLimitCK
+ *          so that neighboring levels differ by at most one.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef BLOCK_TIME_STEPPING_CK_H
+#define BLOCK_TIME_STEPPING_CK_H
+
+#include "base_body.h"
+#include "particle_iterators.h"
+
+namespace SPH
+{
+/**
+ * @class BlockTimeStepping
+ * @brief A block is run as:
+ *        setBlockLevel(...); for each sub-step s: beginSubStep(s), the dynamics with the finest step size; endBlock().
+ */
+class BlockTimeStepping
+{
+  public:
+    explicit BlockTimeStepping(SPHBody &sph_body, UnsignedInt max_level = 3);
+    virtual ~BlockTimeStepping() {};
+
+    SPHBody &getSPHBody() { return sph_body_; };
+    UnsignedInt MaxLevel() { return max_level_; };
+    DiscreteVariable<UnsignedInt> *dvTimeStepLevel() { return dv_level_; };
+    DiscreteVariable<UnsignedInt> *dvTimeStepLevelEstimate() { return dv_level_estimate_; };
+    /** the coarsest level in use, which gives the length of the block */
+    void setBlockLevel(UnsignedInt block_level) { block_level_ = SMIN(block_level, max_level_); };
+    UnsignedInt NumberOfSubSteps() { return UnsignedInt(1) << block_level_; };
+    UnsignedInt SubStep() { return sub_step_; };
+    /** the interaction dynamics on the body are run on the active particles from now on */
+    void beginSubStep(UnsignedInt sub_step);
+    /** the interaction dynamics on the body are run on all particles again */
+    void endBlock();
+
+    class ComputingKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ComputingKernel(const ExecutionPolicy &ex_policy, BlockTimeStepping &encloser)
+            : level_(encloser.dv_level_->DelegatedDataField(ex_policy)), sub_step_(encloser.sub_step_){};
+
+        bool isActive(size_t index_i) const
+        {
+            return (sub_step_ & ((UnsignedInt(1) << level_[index_i]) - 1)) == 0;
+        };
+        Real TimeStep(size_t index_i, Real finest_dt) const
+        {
+            return finest_dt * Real(UnsignedInt(1) << level_[index_i]);
+        };
+
+      protected:
+        UnsignedInt *level_;
+        UnsignedInt sub_step_;
+    };
+
+  protected:
+    SPHBody &sph_body_;
+    UnsignedInt max_level_;
+    UnsignedInt block_level_;
+    UnsignedInt sub_step_;
+    DiscreteVariable<UnsignedInt> *dv_level_;
+    DiscreteVariable<UnsignedInt> *dv_level_estimate_;
+};
+
+/**
+ * Loop over the active particles with their own time-step sizes during a block,
+ * or over all particles with the given step size otherwise.
+ */
+template <class ExecutionPolicy, class DynamicsIdentifier, class StepFunction>
+inline void particle_for_active(const ExecutionPolicy &ex_policy, DynamicsIdentifier &identifier,
+                                Real dt, const StepFunction &step_function)
+{
+    BlockTimeStepping *block_time_stepping = identifier.getSPHBody().getBlockTimeStepping();
+    if (block_time_stepping == nullptr)
+    {
+        particle_for(ex_policy, identifier.LoopRange(),
+                     [=](size_t i)
+                     { step_function(i, dt); });
+        return;
+    }
+
+    BlockTimeStepping::ComputingKernel block_step(ex_policy, *block_time_stepping);
+    particle_for(ex_policy, identifier.LoopRange(),
+                 [=](size_t i)
+                 {
+                     if (block_step.isActive(i))
+                         step_function(i, block_step.TimeStep(i, dt));
+                 });
+};
+} // namespace SPH
+#endif // BLOCK_TIME_STEPPING_CK_H
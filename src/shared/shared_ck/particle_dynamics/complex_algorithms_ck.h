@@ -32,6 +32,9 @@
 
 #include "base_local_dynamics.h"
 #include "base_particle_dynamics.h"
+#include "simple_algorithms_ck.h"
+
+#include <tuple>
 
 namespace SPH
 {
@@ -69,5 +72,70 @@ class SequencedCombination<AlgorithmType<ExecutionPolicy, LocalDynamicsName<Firs
         other_interactions_.exec(dt);
     };
 };
+
+/**
+ * @class SequencedCombination
+ * @brief Fused execution of several state dynamics on the same body.
+ * As state dynamics are particle-wise, the update kernels are applied
+ * one after another for each particle in a single particle loop,
+ * so that the particle data are loaded once and only one kernel is launched.
+ */
+template <class ExecutionPolicy, class FirstUpdateType, class SecondUpdateType, class... OtherUpdateTypes>
+class SequencedCombination<StateDynamics<ExecutionPolicy, FirstUpdateType>,
+                           StateDynamics<ExecutionPolicy, SecondUpdateType>,
+                           StateDynamics<ExecutionPolicy, OtherUpdateTypes>...> : public BaseDynamics<void>
+{
+    using StateDynamicsTuple = std::tuple<StateDynamics<ExecutionPolicy, FirstUpdateType> &,
+                                          StateDynamics<ExecutionPolicy, SecondUpdateType> &,
+                                          StateDynamics<ExecutionPolicy, OtherUpdateTypes> &...>;
+    StateDynamicsTuple state_dynamics_;
+    SPHBody &sph_body_;
+
+  public:
+    SequencedCombination(StateDynamics<ExecutionPolicy, FirstUpdateType> &first_dynamics,
+                         StateDynamics<ExecutionPolicy, SecondUpdateType> &second_dynamics,
+                         StateDynamics<ExecutionPolicy, OtherUpdateTypes> &...other_dynamics)
+        : BaseDynamics<void>(), state_dynamics_(first_dynamics, second_dynamics, other_dynamics...),
+          sph_body_(first_dynamics.getSPHBody())
+    {
+        std::apply(
+            [&](auto &...state_dynamics)
+            {
+                if (((&state_dynamics.getDynamicsIdentifier() !=
+                      &first_dynamics.getDynamicsIdentifier()) ||
+                     ...))
+                {
+                    std::cout << "\n Error: fused state dynamics are not on the same identifier!" << std::endl;
+                    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                    exit(1);
+                }
+            },
+            state_dynamics_);
+    };
+    virtual ~SequencedCombination(){};
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        auto profiling_scope = this->profilingScope(
+            sph_body_.getSPHSystem(), std::get<0>(state_dynamics_).getDynamicsIdentifier());
+        this->setUpdated(sph_body_);
+        auto update_kernels = std::apply(
+            [&](auto &...state_dynamics)
+            {
+                (state_dynamics.setupDynamics(dt), ...);
+                return std::make_tuple(state_dynamics.getUpdateKernel()...);
+            },
+            state_dynamics_);
+
+        particle_for(ExecutionPolicy{},
+                     std::get<0>(state_dynamics_).getDynamicsIdentifier().LoopRange(),
+                     [=](size_t i)
+                     {
+                         std::apply([&](auto *...update_kernel)
+                                    { (update_kernel->update(i, dt), ...); },
+                                    update_kernels);
+                     });
+    };
+};
 } // namespace SPH
 #endif // COMPLEX_ALGORITHMS_CK_H
@@ -4,10 +4,7 @@ namespace SPH
 {
 //=================================================================================================//
 UpdateSortableVariables::UpdateSortableVariables(BaseParticles *particles)
-    : particles_(particles), initialize_temp_variables_(temp_variables_)
-{
-    initialize_temp_variables_(particles_->ParticlesBound());
-}
+    : particles_(particles) {}
 //=================================================================================================//
 QuickSort::SwapParticleIndex::SwapParticleIndex(UnsignedInt *sequence, UnsignedInt *index_permutation)
     : sequence_(sequence), index_permutation_(index_permutation) {}
@@ -25,7 +22,7 @@ void QuickSort::sort(const ParallelPolicy &ex_policy, BaseParticles *particles)
 {
     quick_sort_particle_range_.begin_ = sequence_;
     quick_sort_particle_range_.size_ = particles->TotalRealParticles();
-    tbb::parallel_for(quick_sort_particle_range_, quick_sort_particle_body_);
+    arena_parallel_for(quick_sort_particle_range_, quick_sort_particle_body_);
 }
 //=================================================================================================//
 } // namespace SPH
\ No newline at end of file
@@ -29,26 +29,26 @@
 #ifndef PARTICLE_SORT_H
 #define PARTICLE_SORT_H
 
+#include "base_configuration_dynamics.h"
 #include "particle_sorting.h"
+#include "relation_ck.h"
 
 /**
  * SPH implementation.
  */
 namespace SPH
 {
+/**
+ * @class UpdateSortableVariables
+ * @brief Permutes all sortable variables. The gather of a variable into one of two temporary
+ *        fields is fused with the copy back of the previously gathered variable,
+ *        so that n variables of a type are permuted by n + 1 loops instead of 2n.
+ *        The temporary fields are scratch variables of the particles, acquired only
+ *        for the data types with sortable variables and released after the permutation.
+ */
 class UpdateSortableVariables
 {
-    typedef DataAssemble<UniquePtr, DiscreteVariable> TemporaryVariables;
-
-    struct InitializeTemporaryVariables
-    {
-        template <typename DataType>
-        void operator()(UniquePtr<DiscreteVariable<DataType>> &variable_ptr, UnsignedInt data_size);
-    };
-
     BaseParticles *particles_;
-    TemporaryVariables temp_variables_;
-    OperationOnDataAssemble<TemporaryVariables, InitializeTemporaryVariables> initialize_temp_variables_;
 
   public:
     UpdateSortableVariables(BaseParticles *particles);
@@ -93,6 +93,139 @@ class QuickSort
         quick_sort_particle_body_;
 };
 
+/**
+ * @class SpaceFillingCurve
+ * @brief Base of 64-bit space-filling-curve keys computed from
+ * positions normalized into the unit box.
+ */
+class SpaceFillingCurve
+{
+  public:
+    static constexpr int bits_per_dimension_ = 64 / Dimensions;
+
+  protected:
+    void quantize(const Vecd &normalized_position, uint32_t *coordinates) const
+    {
+        const Real max_coordinate = Real((uint64_t(1) << bits_per_dimension_) - 1);
+        for (int d = 0; d != Dimensions; ++d)
+        {
+            Real clamped = SMIN(SMAX(normalized_position[d], Real(0)), Real(1));
+            coordinates[d] = uint32_t(SMIN(uint64_t(clamped * max_coordinate),
+                                           (uint64_t(1) << bits_per_dimension_) - 1));
+        }
+    };
+
+    uint64_t interleaveBits(const uint32_t *coordinates) const
+    {
+        uint64_t key = 0;
+        for (int b = bits_per_dimension_ - 1; b >= 0; --b)
+            for (int d = 0; d != Dimensions; ++d)
+                key = (key << 1) | ((coordinates[d] >> b) & 1);
+        return key;
+    };
+};
+
+class MortonCurve : public SpaceFillingCurve
+{
+  public:
+    uint64_t operator()(const Vecd &normalized_position) const
+    {
+        uint32_t coordinates[Dimensions];
+        quantize(normalized_position, coordinates);
+        return interleaveBits(coordinates);
+    };
+};
+
+/** Hilbert keys by the transpose algorithm of Skilling (AIP Conf. Proc. 707, 2004). */
+class HilbertCurve : public SpaceFillingCurve
+{
+  public:
+    uint64_t operator()(const Vecd &normalized_position) const
+    {
+        uint32_t x[Dimensions];
+        quantize(normalized_position, x);
+
+        const uint32_t m = uint32_t(1) << (bits_per_dimension_ - 1);
+        for (uint32_t q = m; q > 1; q >>= 1) // inverse undo
+        {
+            const uint32_t p = q - 1;
+            for (int d = 0; d != Dimensions; ++d)
+            {
+                if (x[d] & q)
+                {
+                    x[0] ^= p;
+                }
+                else
+                {
+                    const uint32_t t = (x[0] ^ x[d]) & p;
+                    x[0] ^= t;
+                    x[d] ^= t;
+                }
+            }
+        }
+
+        for (int d = 1; d != Dimensions; ++d) // Gray encode
+            x[d] ^= x[d - 1];
+        uint32_t t = 0;
+        for (uint32_t q = m; q > 1; q >>= 1)
+            if (x[Dimensions - 1] & q)
+                t ^= q - 1;
+        for (int d = 0; d != Dimensions; ++d)
+            x[d] ^= t;
+
+        return interleaveBits(x);
+    };
+};
+
+/** Number of blocks, each sorted serially, used by the parallel radix sort. */
+template <class ExecutionPolicy>
+struct RadixSortBlocks
+{
+    static UnsignedInt number(UnsignedInt data_size)
+    {
+        UnsignedInt max_blocks = 4 * tbb::this_task_arena::max_concurrency();
+        return SMAX(UnsignedInt(1), SMIN((data_size + 1023) / 1024, max_blocks));
+    };
+};
+
+template <>
+struct RadixSortBlocks<SequencedPolicy>
+{
+    static UnsignedInt number(UnsignedInt data_size) { return 1; };
+};
+
+/**
+ * @class SpaceFillingCurveRadixSort
+ * @brief Sort particles along Morton or Hilbert curve by a parallel LSD radix sort on 64-bit keys.
+ * Each pass counts the digits block-wise, scans the digit-major counts
+ * and scatters the blocks stably, so that the sort is linear in particle number.
+ */
+template <class CurveType>
+class SpaceFillingCurveRadixSort
+{
+  public:
+    template <class ExecutionPolicy>
+    explicit SpaceFillingCurveRadixSort(const ExecutionPolicy &ex_policy,
+                                        DiscreteVariable<UnsignedInt> *dv_sequence,
+                                        DiscreteVariable<UnsignedInt> *dv_index_permutation);
+    template <class ExecutionPolicy>
+    void sort(const ExecutionPolicy &ex_policy, BaseParticles *particles);
+
+  protected:
+    static constexpr int radix_bits_ = 8;
+    static constexpr UnsignedInt radix_ = UnsignedInt(1) << radix_bits_;
+    static constexpr int key_bits_ = CurveType::bits_per_dimension_ * Dimensions;
+
+    DiscreteVariable<UnsignedInt> *dv_index_permutation_;
+    DiscreteVariable<uint64_t> dv_key_;
+    DiscreteVariable<uint64_t> dv_key_buffer_;
+    DiscreteVariable<UnsignedInt> dv_index_buffer_;
+    DiscreteVariable<UnsignedInt> dv_digit_count_;
+    DiscreteVariable<UnsignedInt> dv_digit_offset_;
+};
+using MortonRadixSort = SpaceFillingCurveRadixSort<MortonCurve>;
+using HilbertRadixSort = SpaceFillingCurveRadixSort<HilbertCurve>;
+
 template <class ExecutionPolicy, class SortMethodType>
 class ParticleSortCK : public LocalDynamics, public BaseDynamics<void>
 {
@@ -118,6 +251,9 @@ class ParticleSortCK : public LocalDynamics, public BaseDynamics<void>
         UnsignedInt *sorted_id_;
     };
 
+    /** auto policy: exec() may be called every step and sorts only when decided by the scheduler */
+    void setAutoSorting(Relation<Inner<>> &inner_relation, Real relative_sort_cost = 5.0);
+    const SortingScheduler::Statistics &getSortingStatistics() { return sorting_scheduler_.getStatistics(); };
     virtual void exec(Real dt = 0.0) override;
     typedef ParticleSortCK<ExecutionPolicy, SortMethodType> LocalDynamicsType;
     using ComputingKernel = typename LocalDynamicsType::ComputingKernel;
@@ -135,6 +271,10 @@ class ParticleSortCK : public LocalDynamics, public BaseDynamics<void>
         update_variables_to_sort_;
     SortMethodType sort_method_;
     Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernel> kernel_implementation_;
+    Relation<Inner<>> *auto_sorting_relation_;
+    SortingScheduler sorting_scheduler_;
+
+    Real measureDisorder();
 };
 } // namespace SPH
 #endif // PARTICLE_SORT_H
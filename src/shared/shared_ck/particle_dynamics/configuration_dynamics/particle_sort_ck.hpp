@@ -6,35 +6,30 @@
 namespace SPH
 {
 //=================================================================================================//
-template <typename DataType>
-void UpdateSortableVariables::InitializeTemporaryVariables::operator()(
-    UniquePtr<DiscreteVariable<DataType>> &variable_ptr, UnsignedInt data_size)
-{
-    variable_ptr = makeUnique<DiscreteVariable<DataType>>("Temporary", data_size);
-}
-//=================================================================================================//
 template <class ExecutionPolicy, typename DataType>
 void UpdateSortableVariables::operator()(
     DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
     ExecutionPolicy &ex_policy, BaseParticles *particles,
     DiscreteVariable<UnsignedInt> *dv_index_permutation)
 {
-    constexpr int type_index = DataTypeIndex<DataType>::value;
-    DataType *temp_data_field = std::get<type_index>(temp_variables_)->DelegatedDataField(ex_policy);
+    if (variables.empty())
+        return;
 
-    UnsignedInt *index_permutation = dv_index_permutation->DelegatedDataField(ex_policy);
+    ScratchVariablePool &scratch_pool = particles_->getScratchVariablePool();
+    ScopedScratchVariable<DataType> temp_variable(scratch_pool, particles_->ParticlesBound());
+    ScopedScratchVariable<DataType> swap_temp_variable(scratch_pool, particles_->ParticlesBound());
+    DataType *temp_data_fields[2] = {
+        temp_variable->DelegatedDataField(ex_policy),
+        swap_temp_variable->DelegatedDataField(ex_policy)};
 
-    UnsignedInt total_real_particles = particles->TotalRealParticles();
+    UnsignedInt *index_permutation = dv_index_permutation->DelegatedDataField(ex_policy);
+    StdVec<DataType *> sorted_data_fields;
     for (size_t k = 0; k != variables.size(); ++k)
     {
-        DataType *sorted_data_field = variables[k]->DelegatedDataField(ex_policy);
-        particle_for(ex_policy, IndexRange(0, total_real_particles),
-                     [=](size_t i)
-                     { temp_data_field[i] = sorted_data_field[i]; });
-        particle_for(ex_policy, IndexRange(0, total_real_particles),
-                     [=](size_t i)
-                     { sorted_data_field[i] = temp_data_field[index_permutation[i]]; });
+        sorted_data_fields.push_back(variables[k]->DelegatedDataField(ex_policy));
     }
+    permuteDataFields(ex_policy, sorted_data_fields, index_permutation,
+                      particles->TotalRealParticles(), temp_data_fields);
 }
 //=================================================================================================//
 template <class ExecutionPolicy>
@@ -47,6 +42,105 @@ QuickSort::QuickSort(const ExecutionPolicy &ex_policy,
       quick_sort_particle_range_(sequence_, 0, compare_, swap_particle_index_),
       quick_sort_particle_body_() {}
 //=================================================================================================//
+template <class CurveType>
+template <class ExecutionPolicy>
+SpaceFillingCurveRadixSort<CurveType>::SpaceFillingCurveRadixSort(
+    const ExecutionPolicy &ex_policy, DiscreteVariable<UnsignedInt> *dv_sequence,
+    DiscreteVariable<UnsignedInt> *dv_index_permutation)
+    : dv_index_permutation_(dv_index_permutation),
+      dv_key_("SortKey", dv_sequence->getDataFieldSize()),
+      dv_key_buffer_("SortKeyBuffer", dv_sequence->getDataFieldSize()),
+      dv_index_buffer_("IndexPermutationBuffer", dv_sequence->getDataFieldSize()),
+      dv_digit_count_("DigitCount", radix_ + 1),
+      dv_digit_offset_("DigitOffset", radix_ + 1) {}
+//=================================================================================================//
+template <class CurveType>
+template <class ExecutionPolicy>
+void SpaceFillingCurveRadixSort<CurveType>::sort(const ExecutionPolicy &ex_policy, BaseParticles *particles)
+{
+    UnsignedInt total_real_particles = particles->TotalRealParticles();
+    Vecd *pos = particles->getVariableByName<Vecd>("Position")->DelegatedDataField(ex_policy);
+
+    ReduceLowerBound reduce_lower_bound;
+    ReduceUpperBound reduce_upper_bound;
+    Vecd lower_bound = particle_reduce(
+        ex_policy, IndexRange(0, total_real_particles), reduce_lower_bound.reference_, reduce_lower_bound,
+        [=](size_t i) -> Vecd
+        { return pos[i]; });
+    Vecd upper_bound = particle_reduce(
+        ex_policy, IndexRange(0, total_real_particles), reduce_upper_bound.reference_, reduce_upper_bound,
+        [=](size_t i) -> Vecd
+        { return pos[i]; });
+    Vecd inv_extent = (upper_bound - lower_bound + TinyReal * Vecd::Ones()).cwiseInverse();
+
+    uint64_t *key_in = dv_key_.DelegatedDataField(ex_policy);
+    uint64_t *key_out = dv_key_buffer_.DelegatedDataField(ex_policy);
+    UnsignedInt *index_permutation = dv_index_permutation_->DelegatedDataField(ex_policy);
+    UnsignedInt *index_in = index_permutation;
+    UnsignedInt *index_out = dv_index_buffer_.DelegatedDataField(ex_policy);
+
+    CurveType curve;
+    particle_for(ex_policy, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 {
+                     key_in[i] = curve(Vecd((pos[i] - lower_bound).cwiseProduct(inv_extent)));
+                     index_in[i] = i;
+                 });
+
+    const UnsignedInt number_of_blocks = RadixSortBlocks<ExecutionPolicy>::number(total_real_particles);
+    const UnsignedInt block_size = (total_real_particles + number_of_blocks - 1) / number_of_blocks;
+    const UnsignedInt digit_table_size = radix_ * number_of_blocks;
+    const UnsignedInt digit_mask = radix_ - 1;
+    dv_digit_count_.reallocateDataField(ex_policy, digit_table_size + 1);
+    dv_digit_offset_.reallocateDataField(ex_policy, digit_table_size + 1);
+    UnsignedInt *digit_count = dv_digit_count_.DelegatedDataField(ex_policy);
+    UnsignedInt *digit_offset = dv_digit_offset_.DelegatedDataField(ex_policy);
+
+    for (int shift = 0; shift < key_bits_; shift += radix_bits_)
+    {
+        particle_for(ex_policy, IndexRange(0, digit_table_size + 1),
+                     [=](size_t i)
+                     { digit_count[i] = 0; });
+
+        // digit-major table so that the exclusive scan gives the stable output position of each block
+        particle_for(ex_policy, IndexRange(0, number_of_blocks),
+                     [=](size_t k)
+                     {
+                         const UnsignedInt end = SMIN(UnsignedInt(k + 1) * block_size, total_real_particles);
+                         for (UnsignedInt i = k * block_size; i < end; ++i)
+                         {
+                             digit_count[((key_in[i] >> shift) & digit_mask) * number_of_blocks + k]++;
+                         }
+                     });
+
+        exclusive_scan(ex_policy, digit_count, digit_offset, digit_table_size + 1,
+                       typename PlusUnsignedInt<ExecutionPolicy>::type());
+
+        particle_for(ex_policy, IndexRange(0, number_of_blocks),
+                     [=](size_t k)
+                     {
+                         const UnsignedInt end = SMIN(UnsignedInt(k + 1) * block_size, total_real_particles);
+                         for (UnsignedInt i = k * block_size; i < end; ++i)
+                         {
+                             UnsignedInt &position = digit_offset[((key_in[i] >> shift) & digit_mask) * number_of_blocks + k];
+                             key_out[position] = key_in[i];
+                             index_out[position] = index_in[i];
+                             position++;
+                         }
+                     });
+
+        std::swap(key_in, key_out);
+        std::swap(index_in, index_out);
+    }
+
+    if (index_in != index_permutation)
+    {
+        particle_for(ex_policy, IndexRange(0, total_real_particles),
+                     [=](size_t i)
+                     { index_permutation[i] = index_in[i]; });
+    }
+}
+//=================================================================================================//
 template <class ExecutionPolicy, class SortMethodType>
 ParticleSortCK<ExecutionPolicy, SortMethodType>::ParticleSortCK(RealBody &real_body)
     : LocalDynamics(real_body), BaseDynamics<void>(),
@@ -62,12 +156,49 @@ ParticleSortCK<ExecutionPolicy, SortMethodType>::ParticleSortCK(RealBody &real_b
       dv_sorted_id_(particles_->getVariableByName<UnsignedInt>("SortedID")),
       update_variables_to_sort_(particles_->VariablesToSort(), particles_),
       sort_method_(ExecutionPolicy{}, dv_sequence_, dv_index_permutation_),
-      kernel_implementation_(*this)
+      kernel_implementation_(*this), auto_sorting_relation_(nullptr)
 {
     particles_->addVariableToSort<UnsignedInt>("OriginalID");
 }
 //=================================================================================================//
 template <class ExecutionPolicy, class SortMethodType>
+void ParticleSortCK<ExecutionPolicy, SortMethodType>::
+    setAutoSorting(Relation<Inner<>> &inner_relation, Real relative_sort_cost)
+{
+    auto_sorting_relation_ = &inner_relation;
+    sorting_scheduler_.setRelativeSortCost(relative_sort_cost);
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class SortMethodType>
+Real ParticleSortCK<ExecutionPolicy, SortMethodType>::measureDisorder()
+{
+    UnsignedInt total_real_particles = particles_->TotalRealParticles();
+    UnsignedInt stride = sorting_scheduler_.SampleStride(total_real_particles);
+    UnsignedInt number_of_samples = sorting_scheduler_.NumberOfSamples(total_real_particles);
+    UnsignedInt cache_window = SortingScheduler::cache_window_;
+    UnsignedInt *neighbor_index = auto_sorting_relation_->getNeighborIndex()->DelegatedDataField(ex_policy_);
+    UnsignedInt *particle_offset = auto_sorting_relation_->getParticleOffset()->DelegatedDataField(ex_policy_);
+
+    Real disorder_sum = particle_reduce(
+        ex_policy_, IndexRange(0, number_of_samples), Real(0), ReduceSum<Real>(),
+        [=](size_t k) -> Real
+        {
+            UnsignedInt index_i = k * stride;
+            UnsignedInt far_neighbors = 0;
+            for (UnsignedInt n = particle_offset[index_i]; n < particle_offset[index_i + 1]; ++n)
+            {
+                UnsignedInt index_j = neighbor_index[n];
+                UnsignedInt distance = index_i > index_j ? index_i - index_j : index_j - index_i;
+                if (distance > cache_window)
+                    far_neighbors++;
+            }
+            UnsignedInt neighbor_size = particle_offset[index_i + 1] - particle_offset[index_i];
+            return Real(far_neighbors) / Real(SMAX(neighbor_size, UnsignedInt(1)));
+        });
+    return disorder_sum / Real(SMAX(number_of_samples, UnsignedInt(1)));
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class SortMethodType>
 ParticleSortCK<ExecutionPolicy, SortMethodType>::ComputingKernel::
     ComputingKernel(const ExecutionPolicy &ex_policy,
                     ParticleSortCK<ExecutionPolicy, SortMethodType> &encloser)
@@ -95,6 +226,11 @@ void ParticleSortCK<ExecutionPolicy, SortMethodType>::ComputingKernel::
 template <class ExecutionPolicy, class SortMethodType>
 void ParticleSortCK<ExecutionPolicy, SortMethodType>::exec(Real dt)
 {
+    if (auto_sorting_relation_ != nullptr && !sorting_scheduler_.decideSorting(measureDisorder()))
+    {
+        return;
+    }
+
     UnsignedInt total_real_particles = particles_->TotalRealParticles();
     ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
 
@@ -108,6 +244,7 @@ void ParticleSortCK<ExecutionPolicy, SortMethodType>::exec(Real dt)
     particle_for(ex_policy_, IndexRange(0, total_real_particles),
                  [=](size_t i)
                  { computing_kernel->updateSortedID(i); });
+    particles_->incrementTotalSorts();
 }
 //=================================================================================================//
 } // namespace SPH
@@ -49,6 +49,21 @@ class UpdateRelation<ExecutionPolicy, Inner<Parameters...>>
     UpdateRelation(Relation<Inner<Parameters...>> &inner_relation);
     virtual ~UpdateRelation(){};
     virtual void exec(Real dt = 0.0) override;
+    /**
+     * Verlet skin mode: neighbor lists are built with the cut-off radius enlarged by the skin
+     * and reused until the maximum particle displacement since the last build exceeds half the skin.
+     * The neighbors within the skin add nothing to the kernel values and gradients,
+     * as SmoothingKernelCK, shared by all computing-kernel kernels, vanishes beyond the kernel size.
+     * A zero skin (the default) rebuilds the lists at every call.
+     */
+    void setVerletSkin(Real verlet_skin);
+    /**
+     * Single-pass mode: each particle writes its neighbors directly into a bucket of fixed capacity,
+     * estimated from the largest neighbor size of the previous build enlarged by the given factor,
+     * and the buckets are compacted into the neighbor list after one scan of the neighbor sizes.
+     * Only when a bucket overflows, the neighbor list is filled by a second search as in the default mode.
+     */
+    void setSinglePassBuild(Real bucket_capacity_factor = 1.25);
 
   protected:
     class ComputingKernel
@@ -57,11 +72,16 @@ class UpdateRelation<ExecutionPolicy, Inner<Parameters...>>
       public:
         template <class EncloserType>
         ComputingKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
-        void incrementNeighborSize(UnsignedInt index_i);
+        UnsignedInt incrementNeighborSize(UnsignedInt index_i);
         void updateNeighborList(UnsignedInt index_i);
+        UnsignedInt fillNeighborBucket(UnsignedInt index_i, UnsignedInt *bucket, UnsignedInt capacity);
+        void compactNeighborBucket(UnsignedInt index_i, UnsignedInt *bucket, UnsignedInt capacity);
+        void recordBuildPosition(UnsignedInt index_i);
+        Real displacementSquaredSinceBuild(UnsignedInt index_i);
 
       protected:
         NeighborSearch neighbor_search_;
+        Vecd *pos_at_last_build_;
     };
     typedef UpdateRelation<ExecutionPolicy, Inner<Parameters...>> LocalDynamicsType;
     using KernelImplementation = Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernel>;
@@ -69,7 +89,29 @@ class UpdateRelation<ExecutionPolicy, Inner<Parameters...>>
     ExecutionPolicy ex_policy_;
     CellLinkedList &cell_linked_list_;
     UnsignedInt particle_offset_list_size_;
+    Real verlet_skin_;
+    Real search_radius_;
+    DiscreteVariable<Vecd> dv_pos_at_last_build_;
+    bool is_neighbor_list_built_;
+    UnsignedInt total_real_particles_at_last_build_;
+    UnsignedInt total_sorts_at_last_build_;
+    bool is_single_pass_build_;
+    Real bucket_capacity_factor_;
+    UnsignedInt max_neighbor_size_;
     Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernel> kernel_implementation_;
+
+    bool isNeighborListReusable(UnsignedInt total_real_particles);
+    /** scan the neighbor sizes into the particle offsets and enlarge the neighbor list if required */
+    void scanNeighborSize(ComputingKernel *computing_kernel);
+    void buildNeighborListTwoPass(ComputingKernel *computing_kernel, UnsignedInt total_real_particles);
+    /** return false if a bucket overflows so that the neighbor list is still to be filled */
+    bool buildNeighborListSinglePass(ComputingKernel *computing_kernel, UnsignedInt total_real_particles);
+    /**
+     * After a single sort since the last build, the neighbor lists are still valid up to
+     * the particle indices, they are permuted with the index permutation of the sort
+     * instead of being rebuilt by searching the cell linked list.
+     */
+    void permuteNeighborListAfterSort(UnsignedInt total_real_particles);
 };
 
 template <class ExecutionPolicy, typename... Parameters>
@@ -80,6 +122,19 @@ class UpdateRelation<ExecutionPolicy, Contact<Parameters...>>
     UpdateRelation(Relation<Contact<Parameters...>> &contact_relation);
     virtual ~UpdateRelation(){};
     virtual void exec(Real dt = 0.0) override;
+    /**
+     * Verlet skin mode: neighbor lists are built with the cut-off radius enlarged by the skin
+     * and reused until the maximum displacements of the particles and of the contact particles
+     * since the last build sum up to more than the skin, e.g. for observers fixed in space
+     * sampling slowly moving bodies. A zero skin (the default) rebuilds the lists at every call.
+     */
+    void setVerletSkin(Real verlet_skin);
+    /**
+     * Fused mode: the neighbor sizes and then the neighbor lists of all contact bodies
+     * are obtained in one particle loop each, instead of one pair of loops per contact body,
+     * which saves kernel launches and repeated reading of the particle data for many contact bodies.
+     */
+    void setFusedUpdate(bool is_fused_update = true) { is_fused_update_ = is_fused_update; };
 
   protected:
     class ComputingKernel
@@ -90,9 +145,15 @@ class UpdateRelation<ExecutionPolicy, Contact<Parameters...>>
         ComputingKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index);
         void incrementNeighborSize(UnsignedInt index_i);
         void updateNeighborList(UnsignedInt index_i);
+        void recordBuildPosition(UnsignedInt index_i);
+        void recordContactBuildPosition(UnsignedInt index_j);
+        Real displacementSquaredSinceBuild(UnsignedInt index_i);
+        Real contactDisplacementSquaredSinceBuild(UnsignedInt index_j);
 
       protected:
         NeighborSearch neighbor_search_;
+        Vecd *pos_at_last_build_;
+        Vecd *contact_pos_at_last_build_;
     };
     typedef UpdateRelation<ExecutionPolicy, Contact<Parameters...>> LocalDynamicsType;
     using KernelImplementation = Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernel>;
@@ -102,6 +163,23 @@ class UpdateRelation<ExecutionPolicy, Contact<Parameters...>>
     UnsignedInt particle_offset_list_size_;
     StdVec<CellLinkedList *> contact_cell_linked_list_;
     StdVec<KernelImplementation *> contact_kernel_implementation_;
+    Real verlet_skin_;
+    StdVec<Real> contact_search_radius_;
+    DiscreteVariable<Vecd> dv_pos_at_last_build_;
+    UniquePtrsKeeper<DiscreteVariable<Vecd>> contact_pos_at_last_build_ptrs_;
+    StdVec<DiscreteVariable<Vecd> *> dv_contact_pos_at_last_build_;
+    bool is_neighbor_list_built_;
+    UnsignedInt total_real_particles_at_last_build_;
+    UnsignedInt total_sorts_at_last_build_;
+    StdVec<UnsignedInt> contact_total_real_particles_at_last_build_;
+    StdVec<UnsignedInt> contact_total_sorts_at_last_build_;
+    bool is_fused_update_;
+
+    bool isNeighborListReusable(UnsignedInt total_real_particles);
+    /** scan the neighbor sizes into the particle offsets and enlarge the neighbor list if required */
+    void scanContactNeighborSize(UnsignedInt contact_index);
+    void updateNeighborListSeparately(UnsignedInt total_real_particles);
+    void updateNeighborListFused(UnsignedInt total_real_particles);
 };
 
 template <class ExecutionPolicy>
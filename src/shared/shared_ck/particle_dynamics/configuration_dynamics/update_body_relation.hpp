@@ -15,26 +15,48 @@ UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
       BaseDynamics<void>(), ex_policy_(ExecutionPolicy{}),
       cell_linked_list_(inner_relation.getCellLinkedList()),
       particle_offset_list_size_(inner_relation.getParticleOffsetListSize()),
-      kernel_implementation_(*this)
+      verlet_skin_(0.0), search_radius_(cell_linked_list_.SearchRadius()),
+      dv_pos_at_last_build_("PositionAtLastBuild", this->particles_->ParticlesBound()),
+      is_neighbor_list_built_(false), total_real_particles_at_last_build_(0),
+      total_sorts_at_last_build_(0), is_single_pass_build_(false),
+      bucket_capacity_factor_(1.25), max_neighbor_size_(0), kernel_implementation_(*this)
 {
     this->particles_->addVariableToWrite(this->dv_particle_offset_);
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::setVerletSkin(Real verlet_skin)
+{
+    verlet_skin_ = SMAX(verlet_skin, Real(0));
+    search_radius_ = cell_linked_list_.SearchRadius() + verlet_skin_;
+    is_neighbor_list_built_ = false;
+    kernel_implementation_.resetUpdated();
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::setSinglePassBuild(Real bucket_capacity_factor)
+{
+    is_single_pass_build_ = true;
+    bucket_capacity_factor_ = SMAX(bucket_capacity_factor, Real(1));
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
 template <class EncloserType>
 UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::ComputingKernel::ComputingKernel(
     const ExecutionPolicy &ex_policy, EncloserType &encloser)
     : Interaction<Inner<Parameters...>>::InteractKernel(ex_policy, encloser),
-      neighbor_search_(encloser.cell_linked_list_.createNeighborSearch(ex_policy, encloser.dv_pos_)) {}
+      neighbor_search_(encloser.cell_linked_list_.createNeighborSearch(
+          ex_policy, encloser.dv_pos_, encloser.search_radius_)),
+      pos_at_last_build_(encloser.dv_pos_at_last_build_.DelegatedDataField(ex_policy)) {}
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
-void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+UnsignedInt UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
     ComputingKernel::incrementNeighborSize(UnsignedInt index_i)
 {
     // Here, neighbor_index_ takes role of temporary storage for neighbor size list.
     UnsignedInt neighbor_count = 0;
-    neighbor_search_.forEachSearch(
-        index_i, this->source_pos_,
+    this->forEachNeighbor(
+        neighbor_search_, index_i,
         [&](size_t index_j)
         {
             if (index_i != index_j)
@@ -43,6 +65,7 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
             }
         });
     this->neighbor_index_[index_i] = neighbor_count;
+    return neighbor_count;
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
@@ -50,8 +73,8 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
     ComputingKernel::updateNeighborList(UnsignedInt index_i)
 {
     UnsignedInt neighbor_count = 0;
-    neighbor_search_.forEachSearch(
-        index_i, this->source_pos_,
+    this->forEachNeighbor(
+        neighbor_search_, index_i,
         [&](size_t index_j)
         {
             if (index_i != index_j)
@@ -63,15 +86,155 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
-void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::exec(Real dt)
+UnsignedInt UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::ComputingKernel::
+    fillNeighborBucket(UnsignedInt index_i, UnsignedInt *bucket, UnsignedInt capacity)
 {
-    UnsignedInt total_real_particles = this->particles_->TotalRealParticles();
+    // Here, neighbor_index_ takes role of temporary storage for neighbor size list.
+    UnsignedInt neighbor_count = 0;
+    UnsignedInt bucket_begin = index_i * capacity;
+    this->forEachNeighbor(
+        neighbor_search_, index_i,
+        [&](size_t index_j)
+        {
+            if (index_i != index_j)
+            {
+                if (neighbor_count < capacity)
+                    bucket[bucket_begin + neighbor_count] = index_j;
+                neighbor_count++;
+            }
+        });
+    this->neighbor_index_[index_i] = neighbor_count;
+    return neighbor_count;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::ComputingKernel::
+    compactNeighborBucket(UnsignedInt index_i, UnsignedInt *bucket, UnsignedInt capacity)
+{
+    UnsignedInt bucket_begin = index_i * capacity;
+    UnsignedInt neighbor_begin = this->particle_offset_[index_i];
+    UnsignedInt neighbor_size = this->particle_offset_[index_i + 1] - neighbor_begin;
+    for (UnsignedInt m = 0; m != neighbor_size; ++m)
+    {
+        this->neighbor_index_[neighbor_begin + m] = bucket[bucket_begin + m];
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+    ComputingKernel::recordBuildPosition(UnsignedInt index_i)
+{
+    pos_at_last_build_[index_i] = this->source_pos_[index_i];
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+Real UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+    ComputingKernel::displacementSquaredSinceBuild(UnsignedInt index_i)
+{
+    return (this->source_pos_[index_i] - pos_at_last_build_[index_i]).squaredNorm();
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+bool UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+    isNeighborListReusable(UnsignedInt total_real_particles)
+{
+    if (verlet_skin_ <= 0.0 || !is_neighbor_list_built_ ||
+        total_real_particles != total_real_particles_at_last_build_ ||
+        this->particles_->TotalSorts() != total_sorts_at_last_build_)
+    {
+        return false;
+    }
+
     ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
-    particle_for(ex_policy_,
-                 IndexRange(0, total_real_particles),
+    Real max_displacement_squared = particle_reduce(
+        ex_policy_, IndexRange(0, total_real_particles), Real(0), ReduceMax(),
+        [=](size_t i) -> Real
+        { return computing_kernel->displacementSquaredSinceBuild(i); });
+    return max_displacement_squared <= 0.25 * verlet_skin_ * verlet_skin_;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+    permuteNeighborListAfterSort(UnsignedInt total_real_particles)
+{
+    if (verlet_skin_ <= 0.0 || !is_neighbor_list_built_ ||
+        total_real_particles != total_real_particles_at_last_build_ ||
+        this->particles_->TotalSorts() != total_sorts_at_last_build_ + 1)
+    {
+        return;
+    }
+
+    DiscreteVariable<UnsignedInt> *dv_index_permutation =
+        findVariableByName<UnsignedInt>(this->particles_->AllDiscreteVariables(), "IndexPermutation");
+    if (dv_index_permutation == nullptr)
+    {
+        return;
+    }
+
+    ScratchVariablePool &scratch_pool = this->particles_->getScratchVariablePool();
+    UnsignedInt neighbor_index_size = this->dv_neighbor_index_->getDataFieldSize();
+    UnsignedInt offset_list_size = this->particle_offset_list_size_;
+    ScopedScratchVariable<UnsignedInt> old_neighbor_index_variable(scratch_pool, neighbor_index_size);
+    ScopedScratchVariable<UnsignedInt> old_particle_offset_variable(scratch_pool, offset_list_size);
+    UnsignedInt particles_bound = this->particles_->ParticlesBound();
+    ScopedScratchVariable<UnsignedInt> old_to_new_variable(scratch_pool, particles_bound);
+    ScopedScratchVariable<Vecd> old_pos_at_last_build_variable(scratch_pool, total_real_particles);
+
+    UnsignedInt *index_permutation = dv_index_permutation->DelegatedDataField(ex_policy_);
+    UnsignedInt *neighbor_index = this->dv_neighbor_index_->DelegatedDataField(ex_policy_);
+    UnsignedInt *particle_offset = this->dv_particle_offset_->DelegatedDataField(ex_policy_);
+    Vecd *pos_at_last_build = dv_pos_at_last_build_.DelegatedDataField(ex_policy_);
+    UnsignedInt *old_neighbor_index = old_neighbor_index_variable->DelegatedDataField(ex_policy_);
+    UnsignedInt *old_particle_offset = old_particle_offset_variable->DelegatedDataField(ex_policy_);
+    UnsignedInt *old_to_new = old_to_new_variable->DelegatedDataField(ex_policy_);
+    Vecd *old_pos_at_last_build = old_pos_at_last_build_variable->DelegatedDataField(ex_policy_);
+
+    particle_for(ex_policy_, IndexRange(0, neighbor_index_size),
+                 [=](size_t n)
+                 { old_neighbor_index[n] = neighbor_index[n]; });
+    particle_for(ex_policy_, IndexRange(0, offset_list_size),
+                 [=](size_t i)
+                 { old_particle_offset[i] = particle_offset[i]; });
+    // neighbors beyond the real particles, e.g. ghosts, are not sorted and keep their indices
+    particle_for(ex_policy_, IndexRange(0, particles_bound),
+                 [=](size_t i)
+                 { old_to_new[i] = i; });
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 {
+                     old_to_new[index_permutation[i]] = i;
+                     old_pos_at_last_build[i] = pos_at_last_build[i];
+                 });
+
+    // Here, neighbor_index takes role of temporary storage for neighbor size list.
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
                  [=](size_t i)
-                 { computing_kernel->incrementNeighborSize(i); });
+                 {
+                     UnsignedInt old_index = index_permutation[i];
+                     neighbor_index[i] = old_particle_offset[old_index + 1] - old_particle_offset[old_index];
+                 });
+    exclusive_scan(ex_policy_, neighbor_index, particle_offset, offset_list_size,
+                   typename PlusUnsignedInt<ExecutionPolicy>::type());
 
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 {
+                     UnsignedInt old_index = index_permutation[i];
+                     UnsignedInt old_begin = old_particle_offset[old_index];
+                     UnsignedInt neighbor_size = old_particle_offset[old_index + 1] - old_begin;
+                     for (UnsignedInt m = 0; m != neighbor_size; ++m)
+                     {
+                         neighbor_index[particle_offset[i] + m] = old_to_new[old_neighbor_index[old_begin + m]];
+                     }
+                     pos_at_last_build[i] = old_pos_at_last_build[old_index];
+                 });
+    total_sorts_at_last_build_ = this->particles_->TotalSorts();
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+    scanNeighborSize(ComputingKernel *computing_kernel)
+{
     UnsignedInt *neighbor_index = this->dv_neighbor_index_->DelegatedDataField(ex_policy_);
     UnsignedInt *particle_offset = this->dv_particle_offset_->DelegatedDataField(ex_policy_);
     UnsignedInt current_neighbor_index_size =
@@ -82,9 +245,36 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::exec(Real dt)
     if (current_neighbor_index_size > this->dv_neighbor_index_->getDataFieldSize())
     {
         this->dv_neighbor_index_->reallocateDataField(ex_policy_, current_neighbor_index_size);
+        if (this->inner_relation_.isPairGeometryCached())
+        {
+            this->inner_relation_.getPairKernelGradient()->reallocateDataField(ex_policy_, current_neighbor_index_size);
+            this->inner_relation_.getPairUnitVector()->reallocateDataField(ex_policy_, current_neighbor_index_size);
+        }
         this->inner_relation_.resetComputingKernelUpdated();
         kernel_implementation_.overwriteComputingKernel();
     }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+    buildNeighborListTwoPass(ComputingKernel *computing_kernel, UnsignedInt total_real_particles)
+{
+    if (is_single_pass_build_)
+    {
+        max_neighbor_size_ = (UnsignedInt)particle_reduce(
+            ex_policy_, IndexRange(0, total_real_particles), Real(0), ReduceMax(),
+            [=](size_t i) -> Real
+            { return Real(computing_kernel->incrementNeighborSize(i)); });
+    }
+    else
+    {
+        particle_for(ex_policy_,
+                     IndexRange(0, total_real_particles),
+                     [=](size_t i)
+                     { computing_kernel->incrementNeighborSize(i); });
+    }
+
+    scanNeighborSize(computing_kernel);
 
     particle_for(ex_policy_,
                  IndexRange(0, total_real_particles),
@@ -93,29 +283,122 @@ void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::exec(Real dt)
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
+bool UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::
+    buildNeighborListSinglePass(ComputingKernel *computing_kernel, UnsignedInt total_real_particles)
+{
+    if (max_neighbor_size_ == 0) // no estimate before the first build
+    {
+        return false;
+    }
+
+    UnsignedInt capacity = UnsignedInt(bucket_capacity_factor_ * Real(max_neighbor_size_)) + 1;
+    ScopedScratchVariable<UnsignedInt> bucket_variable(
+        this->particles_->getScratchVariablePool(), total_real_particles * capacity);
+    UnsignedInt *bucket = bucket_variable->DelegatedDataField(ex_policy_);
+    max_neighbor_size_ = (UnsignedInt)particle_reduce(
+        ex_policy_, IndexRange(0, total_real_particles), Real(0), ReduceMax(),
+        [=](size_t i) -> Real
+        { return Real(computing_kernel->fillNeighborBucket(i, bucket, capacity)); });
+
+    scanNeighborSize(computing_kernel);
+
+    if (max_neighbor_size_ > capacity)
+    {
+        // the neighbor sizes are already scanned, only the second search is required
+        particle_for(ex_policy_,
+                     IndexRange(0, total_real_particles),
+                     [=](size_t i)
+                     { computing_kernel->updateNeighborList(i); });
+        return true;
+    }
+
+    particle_for(ex_policy_,
+                 IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { computing_kernel->compactNeighborBucket(i, bucket, capacity); });
+    return true;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Inner<Parameters...>>::exec(Real dt)
+{
+    // the pair geometry follows the current positions even if the neighbor lists are reused
+    this->inner_relation_.incrementConfigurationVersion();
+    UnsignedInt total_real_particles = this->particles_->TotalRealParticles();
+    permuteNeighborListAfterSort(total_real_particles);
+    if (isNeighborListReusable(total_real_particles))
+    {
+        return;
+    }
+
+    ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
+    if (!is_single_pass_build_ || !buildNeighborListSinglePass(computing_kernel, total_real_particles))
+    {
+        buildNeighborListTwoPass(computing_kernel, total_real_particles);
+    }
+
+    if (verlet_skin_ > 0.0)
+    {
+        particle_for(ex_policy_,
+                     IndexRange(0, total_real_particles),
+                     [=](size_t i)
+                     { computing_kernel->recordBuildPosition(i); });
+        is_neighbor_list_built_ = true;
+        total_real_particles_at_last_build_ = total_real_particles;
+        total_sorts_at_last_build_ = this->particles_->TotalSorts();
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
 UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
     UpdateRelation(Relation<Contact<Parameters...>> &contact_relation)
     : Interaction<Contact<Parameters...>>(contact_relation),
       BaseDynamics<void>(), ex_policy_(ExecutionPolicy{}),
       particle_offset_list_size_(contact_relation.getParticleOffsetListSize()),
-      contact_cell_linked_list_(contact_relation.getContactCellLinkedList())
+      contact_cell_linked_list_(contact_relation.getContactCellLinkedList()), verlet_skin_(0.0),
+      dv_pos_at_last_build_("PositionAtLastBuild", this->particles_->ParticlesBound()),
+      is_neighbor_list_built_(false), total_real_particles_at_last_build_(0),
+      total_sorts_at_last_build_(0),
+      contact_total_real_particles_at_last_build_(this->contact_bodies_.size(), 0),
+      contact_total_sorts_at_last_build_(this->contact_bodies_.size(), 0),
+      is_fused_update_(false)
 {
     for (size_t k = 0; k != this->contact_bodies_.size(); ++k)
     {
         this->particles_->addVariableToWrite(this->dv_contact_particle_offset_[k]);
+        contact_search_radius_.push_back(contact_cell_linked_list_[k]->SearchRadius());
+        dv_contact_pos_at_last_build_.push_back(
+            contact_pos_at_last_build_ptrs_.template createPtr<DiscreteVariable<Vecd>>(
+                "ContactPositionAtLastBuild", this->contact_particles_[k]->ParticlesBound()));
         contact_kernel_implementation_.push_back(
             contact_kernel_implementation_ptrs_.template createPtr<KernelImplementation>(*this));
     }
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::setVerletSkin(Real verlet_skin)
+{
+    verlet_skin_ = SMAX(verlet_skin, Real(0));
+    for (size_t k = 0; k != this->contact_bodies_.size(); ++k)
+    {
+        contact_search_radius_[k] = contact_cell_linked_list_[k]->SearchRadius() + verlet_skin_;
+        contact_kernel_implementation_[k]->resetUpdated();
+    }
+    is_neighbor_list_built_ = false;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
 template <class EncloserType>
 UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
     ComputingKernel::ComputingKernel(
         const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index)
-    : Interaction<Contact<>>::InteractKernel(ex_policy, encloser, contact_index),
+    : Interaction<Contact<Parameters...>>::InteractKernel(ex_policy, encloser, contact_index),
       neighbor_search_(encloser.contact_cell_linked_list_[contact_index]
-                           ->createNeighborSearch(ex_policy, encloser.contact_pos_[contact_index])) {}
+                           ->createNeighborSearch(ex_policy, encloser.contact_pos_[contact_index],
+                                                  encloser.contact_search_radius_[contact_index])),
+      pos_at_last_build_(encloser.dv_pos_at_last_build_.DelegatedDataField(ex_policy)),
+      contact_pos_at_last_build_(
+          encloser.dv_contact_pos_at_last_build_[contact_index]->DelegatedDataField(ex_policy)) {}
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
 void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
@@ -123,8 +406,8 @@ void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
 {
     // Here, neighbor_index_ takes role of temporary storage for neighbor size list.
     UnsignedInt neighbor_count = 0;
-    neighbor_search_.forEachSearch(
-        index_i, this->source_pos_,
+    this->forEachNeighbor(
+        neighbor_search_, index_i,
         [&](size_t index_j)
         {
             neighbor_count++;
@@ -137,8 +420,8 @@ void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
     ComputingKernel::updateNeighborList(UnsignedInt index_i)
 {
     UnsignedInt neighbor_count = 0;
-    neighbor_search_.forEachSearch(
-        index_i, this->source_pos_,
+    this->forEachNeighbor(
+        neighbor_search_, index_i,
         [&](size_t index_j)
         {
             this->neighbor_index_[this->particle_offset_[index_i] + neighbor_count] = index_j;
@@ -147,10 +430,95 @@ void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename... Parameters>
-void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::exec(Real dt)
+void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    ComputingKernel::recordBuildPosition(UnsignedInt index_i)
 {
-    UnsignedInt total_real_particles = this->particles_->TotalRealParticles();
+    pos_at_last_build_[index_i] = this->source_pos_[index_i];
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    ComputingKernel::recordContactBuildPosition(UnsignedInt index_j)
+{
+    contact_pos_at_last_build_[index_j] = this->target_pos_[index_j];
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+Real UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    ComputingKernel::displacementSquaredSinceBuild(UnsignedInt index_i)
+{
+    return (this->source_pos_[index_i] - pos_at_last_build_[index_i]).squaredNorm();
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+Real UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    ComputingKernel::contactDisplacementSquaredSinceBuild(UnsignedInt index_j)
+{
+    return (this->target_pos_[index_j] - contact_pos_at_last_build_[index_j]).squaredNorm();
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+bool UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    isNeighborListReusable(UnsignedInt total_real_particles)
+{
+    if (verlet_skin_ <= 0.0 || !is_neighbor_list_built_ || this->contact_bodies_.empty() ||
+        total_real_particles != total_real_particles_at_last_build_ ||
+        this->particles_->TotalSorts() != total_sorts_at_last_build_)
+    {
+        return false;
+    }
+
+    for (size_t k = 0; k != this->contact_bodies_.size(); ++k)
+    {
+        if (this->contact_particles_[k]->TotalRealParticles() != contact_total_real_particles_at_last_build_[k] ||
+            this->contact_particles_[k]->TotalSorts() != contact_total_sorts_at_last_build_[k])
+        {
+            return false;
+        }
+    }
+
+    ComputingKernel *first_kernel = contact_kernel_implementation_[0]->getComputingKernel(0);
+    Real max_displacement = sqrt(particle_reduce(
+        ex_policy_, IndexRange(0, total_real_particles), Real(0), ReduceMax(),
+        [=](size_t i) -> Real
+        { return first_kernel->displacementSquaredSinceBuild(i); }));
+
+    for (size_t k = 0; k != this->contact_bodies_.size(); ++k)
+    {
+        ComputingKernel *computing_kernel = contact_kernel_implementation_[k]->getComputingKernel(k);
+        Real max_contact_displacement = sqrt(particle_reduce(
+            ex_policy_, IndexRange(0, contact_total_real_particles_at_last_build_[k]), Real(0), ReduceMax(),
+            [=](size_t j) -> Real
+            { return computing_kernel->contactDisplacementSquaredSinceBuild(j); }));
+        if (max_displacement + max_contact_displacement > verlet_skin_)
+            return false;
+    }
+    return true;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    scanContactNeighborSize(UnsignedInt contact_index)
+{
+    UnsignedInt *neighbor_index = this->dv_contact_neighbor_index_[contact_index]->DelegatedDataField(ex_policy_);
+    UnsignedInt *particle_offset = this->dv_contact_particle_offset_[contact_index]->DelegatedDataField(ex_policy_);
+    UnsignedInt current_neighbor_index_size =
+        exclusive_scan(ex_policy_, neighbor_index, particle_offset,
+                       this->particle_offset_list_size_,
+                       typename PlusUnsignedInt<ExecutionPolicy>::type());
 
+    if (current_neighbor_index_size > this->dv_contact_neighbor_index_[contact_index]->getDataFieldSize())
+    {
+        this->dv_contact_neighbor_index_[contact_index]->reallocateDataField(ex_policy_, current_neighbor_index_size);
+        this->contact_relation_.resetComputingKernelUpdated(contact_index);
+        contact_kernel_implementation_[contact_index]->overwriteComputingKernel(contact_index);
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    updateNeighborListSeparately(UnsignedInt total_real_particles)
+{
     for (size_t k = 0; k != this->contact_bodies_.size(); ++k)
     {
         ComputingKernel *computing_kernel = contact_kernel_implementation_[k]->getComputingKernel(k);
@@ -159,19 +527,7 @@ void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::exec(Real dt)
                      [=](size_t i)
                      { computing_kernel->incrementNeighborSize(i); });
 
-        UnsignedInt *neighbor_index = this->dv_contact_neighbor_index_[k]->DelegatedDataField(ex_policy_);
-        UnsignedInt *particle_offset = this->dv_contact_particle_offset_[k]->DelegatedDataField(ex_policy_);
-        UnsignedInt current_neighbor_index_size =
-            exclusive_scan(ex_policy_, neighbor_index, particle_offset,
-                           this->particle_offset_list_size_,
-                           typename PlusUnsignedInt<ExecutionPolicy>::type());
-
-        if (current_neighbor_index_size > this->dv_contact_neighbor_index_[k]->getDataFieldSize())
-        {
-            this->dv_contact_neighbor_index_[k]->reallocateDataField(ex_policy_, current_neighbor_index_size);
-            this->contact_relation_.resetComputingKernelUpdated(k);
-            contact_kernel_implementation_[k]->overwriteComputingKernel(k);
-        }
+        scanContactNeighborSize(k);
 
         particle_for(ex_policy_,
                      IndexRange(0, total_real_particles),
@@ -180,6 +536,86 @@ void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::exec(Real dt)
     }
 }
 //=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::
+    updateNeighborListFused(UnsignedInt total_real_particles)
+{
+    UnsignedInt number_of_contact_bodies = this->contact_bodies_.size();
+    StdVec<ComputingKernel *> contact_computing_kernels;
+    for (size_t k = 0; k != number_of_contact_bodies; ++k)
+    {
+        contact_computing_kernels.push_back(contact_kernel_implementation_[k]->getComputingKernel(k));
+    }
+    ComputingKernel **computing_kernels = contact_computing_kernels.data();
+
+    particle_for(ex_policy_,
+                 IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 {
+                     for (UnsignedInt k = 0; k != number_of_contact_bodies; ++k)
+                         computing_kernels[k]->incrementNeighborSize(i);
+                 });
+
+    // the kernels are overwritten in place if the neighbor lists are enlarged
+    for (size_t k = 0; k != number_of_contact_bodies; ++k)
+    {
+        scanContactNeighborSize(k);
+    }
+
+    particle_for(ex_policy_,
+                 IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 {
+                     for (UnsignedInt k = 0; k != number_of_contact_bodies; ++k)
+                         computing_kernels[k]->updateNeighborList(i);
+                 });
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename... Parameters>
+void UpdateRelation<ExecutionPolicy, Contact<Parameters...>>::exec(Real dt)
+{
+    this->contact_relation_.incrementConfigurationVersion();
+    UnsignedInt total_real_particles = this->particles_->TotalRealParticles();
+    if (isNeighborListReusable(total_real_particles))
+    {
+        return;
+    }
+
+    if (is_fused_update_)
+    {
+        updateNeighborListFused(total_real_particles);
+    }
+    else
+    {
+        updateNeighborListSeparately(total_real_particles);
+    }
+
+    if (verlet_skin_ > 0.0)
+    {
+        for (size_t k = 0; k != this->contact_bodies_.size(); ++k)
+        {
+            ComputingKernel *computing_kernel = contact_kernel_implementation_[k]->getComputingKernel(k);
+            if (k == 0)
+            {
+                particle_for(ex_policy_,
+                             IndexRange(0, total_real_particles),
+                             [=](size_t i)
+                             { computing_kernel->recordBuildPosition(i); });
+            }
+            UnsignedInt contact_total_real_particles = this->contact_particles_[k]->TotalRealParticles();
+            particle_for(ex_policy_,
+                         IndexRange(0, contact_total_real_particles),
+                         [=](size_t j)
+                         { computing_kernel->recordContactBuildPosition(j); });
+            contact_total_real_particles_at_last_build_[k] = contact_total_real_particles;
+            contact_total_sorts_at_last_build_[k] = this->contact_particles_[k]->TotalSorts();
+        }
+        is_neighbor_list_built_ = true;
+        total_real_particles_at_last_build_ = total_real_particles;
+        total_sorts_at_last_build_ = this->particles_->TotalSorts();
+    }
+}
+//=================================================================================================//
 template <class ExecutionPolicy, class FirstRelation, class... Others>
 template <class FirstParameterSet, typename... OtherParameterSets>
 UpdateRelation<ExecutionPolicy, FirstRelation, Others...>::UpdateRelation(
@@ -34,6 +34,7 @@
 #include "all_particle_dynamics.h"
 #include "base_body.h"
 #include "base_particles.hpp"
+#include "cell_relative_position_ck.h"
 
 namespace SPH
 {
@@ -52,10 +53,18 @@ class UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>
     DiscreteVariable<UnsignedInt> *dv_particle_index_;
     DiscreteVariable<UnsignedInt> *dv_cell_offset_;
     DiscreteVariable<UnsignedInt> dv_current_cell_size_;
+    DiscreteVariable<UnsignedInt> dv_particle_cell_; /**< the cell of each particle at the last update */
 
   public:
     UpdateCellLinkedList(RealBody &real_body);
     virtual ~UpdateCellLinkedList(){};
+    /**
+     * Incremental mode: only the particles whose cell changed since the last update are moved
+     * to their new cells, the others keep their entries. The lists are rebuilt as a whole when more than
+     * the given fraction of the particles changed cell, or after sorting or a change of the particle number.
+     * A zero fraction (the default) rebuilds the lists at every call.
+     */
+    void setIncrementalUpdate(Real moved_fraction_threshold);
 
     class ComputingKernel
     {
@@ -65,6 +74,12 @@ class UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>
         void clearAllLists(UnsignedInt index_i);
         void incrementCellSize(UnsignedInt index_i);
         void updateCellList(UnsignedInt index_i);
+        void recordParticleCell(UnsignedInt index_i);
+        UnsignedInt isCellChanged(UnsignedInt index_i);
+        void moveCellSize(UnsignedInt index_i);
+        void keepUnmovedParticles(UnsignedInt cell_index, UnsignedInt *previous_particle_index,
+                                  UnsignedInt *previous_cell_offset);
+        void appendMovedParticle(UnsignedInt index_i);
 
       protected:
         Mesh mesh_;
@@ -74,6 +89,7 @@ class UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>
         UnsignedInt *particle_index_;
         UnsignedInt *cell_offset_;
         UnsignedInt *current_cell_size_;
+        UnsignedInt *particle_cell_;
     };
 
     virtual void exec(Real dt = 0.0) override;
@@ -83,6 +99,15 @@ class UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>
   protected:
     ExecutionPolicy ex_policy_;
     Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernel> kernel_implementation_;
+    Real moved_fraction_threshold_;
+    bool is_cell_list_built_;
+    UnsignedInt total_real_particles_at_last_build_;
+    UnsignedInt total_sorts_at_last_build_;
+
+    /** returns false if too many particles changed cell for an incremental update */
+    bool updateIncrementally(UnsignedInt total_real_particles);
+    /** encodes again the cell-relative positions, if used, of the particles moved by other dynamics */
+    void encodeStaleCellRelativePositions(UnsignedInt total_real_particles);
 };
 
 } // namespace SPH
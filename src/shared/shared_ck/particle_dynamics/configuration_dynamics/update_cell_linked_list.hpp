@@ -20,12 +20,23 @@ UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::UpdateCellLinkedList(
       dv_particle_index_(cell_linked_list_.getParticleIndex()),
       dv_cell_offset_(cell_linked_list_.getCellOffset()),
       dv_current_cell_size_(DiscreteVariable<UnsignedInt>("CurrentCellSize", cell_offset_list_size_)),
-      ex_policy_(ExecutionPolicy{}), kernel_implementation_(*this)
+      dv_particle_cell_(DiscreteVariable<UnsignedInt>("ParticleCell", particles_->ParticlesBound())),
+      ex_policy_(ExecutionPolicy{}), kernel_implementation_(*this),
+      moved_fraction_threshold_(0.0), is_cell_list_built_(false),
+      total_real_particles_at_last_build_(0), total_sorts_at_last_build_(0)
 {
     particles_->addVariableToWrite<UnsignedInt>("ParticleIndex");
 }
 //=================================================================================================//
 template <class ExecutionPolicy, typename CellLinkedListType>
+void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::
+    setIncrementalUpdate(Real moved_fraction_threshold)
+{
+    moved_fraction_threshold_ = SMAX(moved_fraction_threshold, Real(0));
+    is_cell_list_built_ = false;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename CellLinkedListType>
 UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
     ComputingKernel(const ExecutionPolicy &ex_policy,
                     UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType> &encloser)
@@ -34,7 +45,8 @@ UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
       pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
       particle_index_(encloser.dv_particle_index_->DelegatedDataField(ex_policy)),
       cell_offset_(encloser.dv_cell_offset_->DelegatedDataField(ex_policy)),
-      current_cell_size_(encloser.dv_current_cell_size_.DelegatedDataField(ex_policy)) {}
+      current_cell_size_(encloser.dv_current_cell_size_.DelegatedDataField(ex_policy)),
+      particle_cell_(encloser.dv_particle_cell_.DelegatedDataField(ex_policy)) {}
 //=================================================================================================//
 template <class ExecutionPolicy, typename CellLinkedListType>
 void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
@@ -67,10 +79,154 @@ void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel:
     particle_index_[cell_offset_[linear_index] + atomic_current_cell_size++] = index_i;
 }
 //=================================================================================================//
+template <class ExecutionPolicy, typename CellLinkedListType>
+void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
+    recordParticleCell(UnsignedInt index_i)
+{
+    particle_cell_[index_i] = mesh_.LinearCellIndexFromPosition(pos_[index_i]);
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename CellLinkedListType>
+UnsignedInt UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
+    isCellChanged(UnsignedInt index_i)
+{
+    return mesh_.LinearCellIndexFromPosition(pos_[index_i]) != particle_cell_[index_i] ? 1 : 0;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename CellLinkedListType>
+void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
+    moveCellSize(UnsignedInt index_i)
+{
+    const UnsignedInt linear_index = mesh_.LinearCellIndexFromPosition(pos_[index_i]);
+    if (linear_index != particle_cell_[index_i])
+    {
+        typename AtomicUnsignedIntRef<ExecutionPolicy>::type
+            atomic_previous_cell_size(current_cell_size_[particle_cell_[index_i]]);
+        --atomic_previous_cell_size;
+        typename AtomicUnsignedIntRef<ExecutionPolicy>::type
+            atomic_cell_size(current_cell_size_[linear_index]);
+        ++atomic_cell_size;
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename CellLinkedListType>
+void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
+    keepUnmovedParticles(UnsignedInt cell_index, UnsignedInt *previous_particle_index,
+                         UnsignedInt *previous_cell_offset)
+{
+    // Here, current_cell_size_ counts the particles filled into the cell.
+    for (UnsignedInt n = previous_cell_offset[cell_index]; n < previous_cell_offset[cell_index + 1]; ++n)
+    {
+        const UnsignedInt index_j = previous_particle_index[n];
+        if (mesh_.LinearCellIndexFromPosition(pos_[index_j]) == cell_index)
+        {
+            particle_index_[cell_offset_[cell_index] + current_cell_size_[cell_index]] = index_j;
+            current_cell_size_[cell_index]++;
+        }
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, typename CellLinkedListType>
+void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::ComputingKernel::
+    appendMovedParticle(UnsignedInt index_i)
+{
+    const UnsignedInt linear_index = mesh_.LinearCellIndexFromPosition(pos_[index_i]);
+    if (linear_index != particle_cell_[index_i])
+    {
+        typename AtomicUnsignedIntRef<ExecutionPolicy>::type
+            atomic_current_cell_size(current_cell_size_[linear_index]);
+        particle_index_[cell_offset_[linear_index] + atomic_current_cell_size++] = index_i;
+        particle_cell_[index_i] = linear_index;
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class CellLinkedListType>
+bool UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::
+    updateIncrementally(UnsignedInt total_real_particles)
+{
+    ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
+    UnsignedInt moved_particles = particle_reduce(
+        ex_policy_, IndexRange(0, total_real_particles), UnsignedInt(0), ReduceSum<UnsignedInt>(),
+        [=](size_t i) -> UnsignedInt
+        { return computing_kernel->isCellChanged(i); });
+    if (Real(moved_particles) > moved_fraction_threshold_ * Real(total_real_particles))
+    {
+        return false;
+    }
+    if (moved_particles == 0)
+    {
+        return true;
+    }
+
+    ScratchVariablePool &scratch_pool = this->particles_->getScratchVariablePool();
+    UnsignedInt cell_offset_list_size = this->cell_offset_list_size_;
+    ScopedScratchVariable<UnsignedInt> previous_particle_index_variable(scratch_pool, total_real_particles);
+    ScopedScratchVariable<UnsignedInt> previous_cell_offset_variable(scratch_pool, cell_offset_list_size);
+    UnsignedInt *previous_particle_index = previous_particle_index_variable->DelegatedDataField(ex_policy_);
+    UnsignedInt *previous_cell_offset = previous_cell_offset_variable->DelegatedDataField(ex_policy_);
+    UnsignedInt *particle_index = this->dv_particle_index_->DelegatedDataField(ex_policy_);
+    UnsignedInt *cell_offset = this->dv_cell_offset_->DelegatedDataField(ex_policy_);
+    UnsignedInt *current_cell_size = this->dv_current_cell_size_.DelegatedDataField(ex_policy_);
+
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { previous_particle_index[i] = particle_index[i]; });
+    particle_for(ex_policy_, IndexRange(0, cell_offset_list_size),
+                 [=](size_t i)
+                 {
+                     previous_cell_offset[i] = cell_offset[i];
+                     current_cell_size[i] = i + 1 < cell_offset_list_size ? cell_offset[i + 1] - cell_offset[i] : 0;
+                 });
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { computing_kernel->moveCellSize(i); });
+    exclusive_scan(ex_policy_, current_cell_size, cell_offset, cell_offset_list_size,
+                   typename PlusUnsignedInt<ExecutionPolicy>::type());
+
+    particle_for(ex_policy_, IndexRange(0, cell_offset_list_size),
+                 [=](size_t i)
+                 { current_cell_size[i] = 0; });
+    particle_for(ex_policy_, IndexRange(0, cell_offset_list_size - 1),
+                 [=](size_t i)
+                 { computing_kernel->keepUnmovedParticles(i, previous_particle_index, previous_cell_offset); });
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { computing_kernel->appendMovedParticle(i); });
+    return true;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class CellLinkedListType>
+void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::
+    encodeStaleCellRelativePositions(UnsignedInt total_real_particles)
+{
+    CellRelativePositionVariables cell_relative_position(this->particles_);
+    if (!cell_relative_position.isEncoded())
+    {
+        return;
+    }
+
+    CellRelativePosition frame = cell_relative_position.Frame();
+    Vecd *pos = this->dv_pos_->DelegatedDataField(ex_policy_);
+    Vecd *cell = cell_relative_position.getCell()->DelegatedDataField(ex_policy_);
+    Vecd *offset = cell_relative_position.getOffset()->DelegatedDataField(ex_policy_);
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { frame.encodeIfStale(pos[i], cell[i], offset[i]); });
+}
+//=================================================================================================//
 template <class ExecutionPolicy, class CellLinkedListType>
 void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::exec(Real dt)
 {
     UnsignedInt total_real_particles = this->particles_->TotalRealParticles();
+    encodeStaleCellRelativePositions(total_real_particles);
+    if (moved_fraction_threshold_ > 0.0 && is_cell_list_built_ &&
+        total_real_particles == total_real_particles_at_last_build_ &&
+        this->particles_->TotalSorts() == total_sorts_at_last_build_ &&
+        updateIncrementally(total_real_particles))
+    {
+        return;
+    }
+
     ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
 
     particle_for(ex_policy_,
@@ -93,6 +249,17 @@ void UpdateCellLinkedList<ExecutionPolicy, CellLinkedListType>::exec(Real dt)
                  IndexRange(0, total_real_particles),
                  [=](size_t i)
                  { computing_kernel->updateCellList(i); });
+
+    if (moved_fraction_threshold_ > 0.0)
+    {
+        particle_for(ex_policy_,
+                     IndexRange(0, total_real_particles),
+                     [=](size_t i)
+                     { computing_kernel->recordParticleCell(i); });
+        is_cell_list_built_ = true;
+        total_real_particles_at_last_build_ = total_real_particles;
+        total_sorts_at_last_build_ = this->particles_->TotalSorts();
+    }
 }
 //=================================================================================================//
 } // namespace SPH
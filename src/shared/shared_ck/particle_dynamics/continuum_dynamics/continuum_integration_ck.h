@@ -0,0 +1,375 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	continuum_integration_ck.h
+ * @brief 	Here, we define the computing-kernel algorithm classes for continuum dynamics,
+ *          i.e. the plastic integration of granular and soil materials and
+ *          the shear stress relaxation with hourglass control.
+ * @details The formulations are those of the classic continuum_integration.h.
+ *          The stress update is given by the ConstituteKernel of the material,
+ *          so that no virtual function is called in the computing kernels.
+ * @author	Shuaihao Zhang and Xiangyu Hu
+ */
+
+#ifndef CONTINUUM_INTEGRATION_CK_H
+#define CONTINUUM_INTEGRATION_CK_H
+
+#include "acoustic_step_1st_half.hpp"
+#include "general_continuum.h"
+
+namespace SPH
+{
+namespace continuum_dynamics
+{
+template <class BaseInteractionType>
+class PlasticAcousticStep : public fluid_dynamics::AcousticStep<BaseInteractionType>
+{
+  public:
+    template <class DynamicsIdentifier>
+    explicit PlasticAcousticStep(DynamicsIdentifier &identifier);
+    virtual ~PlasticAcousticStep(){};
+
+  protected:
+    PlasticContinuum &plastic_continuum_;
+    DiscreteVariable<Mat3d> *dv_stress_tensor_3D_, *dv_strain_tensor_3D_, *dv_stress_rate_3D_, *dv_strain_rate_3D_;
+    DiscreteVariable<Matd> *dv_velocity_gradient_;
+};
+
+template <typename...>
+class PlasticIntegration1stHalfCK;
+
+template <class RiemannSolverType, typename... Parameters>
+class PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>
+    : public PlasticAcousticStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = PlasticAcousticStep<Interaction<Inner<Parameters...>>>;
+
+  public:
+    explicit PlasticIntegration1stHalfCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~PlasticIntegration1stHalfCK(){};
+
+    class InitializeKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void initialize(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *rho_, *p_, *drho_dt_;
+        Vecd *vel_, *dpos_;
+        Mat3d *stress_tensor_3D_;
+    };
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        RiemannSolverType riemann_solver_;
+        Real *Vol_, *rho_, *mass_, *p_, *drho_dt_;
+        Vecd *force_;
+        Mat3d *stress_tensor_3D_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *mass_;
+        Vecd *vel_, *force_, *force_prior_;
+    };
+
+  protected:
+    RiemannSolverType riemann_solver_;
+};
+
+template <class RiemannSolverType, typename... Parameters>
+class PlasticIntegration1stHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>
+    : public PlasticAcousticStep<Interaction<Contact<Wall, Parameters...>>>
+{
+    using BaseInteraction = PlasticAcousticStep<Interaction<Contact<Wall, Parameters...>>>;
+
+  public:
+    explicit PlasticIntegration1stHalfCK(Relation<Contact<Parameters...>> &wall_contact_relation);
+    virtual ~PlasticIntegration1stHalfCK(){};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        RiemannSolverType riemann_solver_;
+        Real *rho_, *mass_, *p_, *drho_dt_;
+        Vecd *force_, *force_prior_;
+        Mat3d *stress_tensor_3D_;
+        Real *wall_Vol_;
+        Vecd *wall_acc_ave_;
+    };
+
+  protected:
+    RiemannSolverType riemann_solver_;
+};
+
+using PlasticIntegration1stHalfWithWallRiemannCK =
+    PlasticIntegration1stHalfCK<Inner<OneLevel, AcousticRiemannSolver>, Contact<Wall, AcousticRiemannSolver>>;
+
+template <typename...>
+class PlasticIntegration2ndHalfCK;
+
+template <class RiemannSolverType, typename... Parameters>
+class PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>
+    : public PlasticAcousticStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = PlasticAcousticStep<Interaction<Inner<Parameters...>>>;
+    using ConstituteKernel = typename PlasticContinuum::ConstituteKernel;
+
+  public:
+    explicit PlasticIntegration2ndHalfCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~PlasticIntegration2ndHalfCK(){};
+
+    class InitializeKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void initialize(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Vecd *vel_, *dpos_;
+    };
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        RiemannSolverType riemann_solver_;
+        Real *Vol_, *rho_, *mass_, *drho_dt_;
+        Vecd *vel_, *force_;
+        Matd *velocity_gradient_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        ConstituteKernel constitute_;
+        Real *Vol_, *rho_, *mass_, *drho_dt_;
+        Mat3d *stress_tensor_3D_, *strain_tensor_3D_, *stress_rate_3D_, *strain_rate_3D_;
+        Matd *velocity_gradient_;
+    };
+
+  protected:
+    RiemannSolverType riemann_solver_;
+};
+
+template <class RiemannSolverType, typename... Parameters>
+class PlasticIntegration2ndHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>
+    : public PlasticAcousticStep<Interaction<Contact<Wall, Parameters...>>>
+{
+    using BaseInteraction = PlasticAcousticStep<Interaction<Contact<Wall, Parameters...>>>;
+
+  public:
+    explicit PlasticIntegration2ndHalfCK(Relation<Contact<Parameters...>> &wall_contact_relation);
+    virtual ~PlasticIntegration2ndHalfCK(){};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        RiemannSolverType riemann_solver_;
+        Real *rho_, *mass_, *drho_dt_;
+        Vecd *vel_, *force_;
+        Matd *velocity_gradient_;
+        Real *wall_Vol_;
+        Vecd *wall_vel_ave_, *wall_n_;
+    };
+
+  protected:
+    RiemannSolverType riemann_solver_;
+};
+
+using PlasticIntegration2ndHalfWithWallRiemannCK =
+    PlasticIntegration2ndHalfCK<Inner<OneLevel, AcousticRiemannSolver>, Contact<Wall, AcousticRiemannSolver>>;
+
+template <typename...>
+class StressDiffusionCK;
+
+template <typename... Parameters>
+class StressDiffusionCK<Inner<Parameters...>>
+    : public PlasticAcousticStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = PlasticAcousticStep<Interaction<Inner<Parameters...>>>;
+
+  public:
+    explicit StressDiffusionCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~StressDiffusionCK(){};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real zeta_, one_minus_sin_phi_, rho0_, smoothing_length_, sound_speed_;
+        Real *Vol_, *mass_;
+        Vecd *force_prior_;
+        Mat3d *stress_tensor_3D_, *stress_rate_3D_;
+    };
+
+  protected:
+    Real zeta_ = 0.1; /*diffusion coefficient*/
+    Real one_minus_sin_phi_, smoothing_length_, sound_speed_;
+};
+
+template <class BaseInteractionType>
+class ShearStressRelaxation : public BaseInteractionType
+{
+  public:
+    template <class DynamicsIdentifier>
+    explicit ShearStressRelaxation(DynamicsIdentifier &identifier);
+    virtual ~ShearStressRelaxation(){};
+
+  protected:
+    GeneralContinuum &continuum_;
+    DiscreteVariable<Real> *dv_Vol_, *dv_rho_, *dv_scale_penalty_force_;
+    DiscreteVariable<Vecd> *dv_vel_;
+    DiscreteVariable<Matd> *dv_shear_stress_, *dv_velocity_gradient_;
+};
+
+/**
+ * @class ShearStressRelaxationHourglassControl1stHalfCK
+ * @brief The velocity gradient and the shear stress, for which the material type is
+ *        GeneralContinuum or J2Plasticity, the latter with hardening and return mapping.
+ */
+template <typename...>
+class ShearStressRelaxationHourglassControl1stHalfCK;
+
+template <class MaterialType, class KernelCorrectionType, typename... Parameters>
+class ShearStressRelaxationHourglassControl1stHalfCK<Inner<WithUpdate, MaterialType, KernelCorrectionType, Parameters...>>
+    : public ShearStressRelaxation<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = ShearStressRelaxation<Interaction<Inner<Parameters...>>>;
+    using ConstituteKernel = typename MaterialType::ConstituteKernel;
+    using CorrectionKernel = typename KernelCorrectionType::ComputingKernel;
+    static constexpr bool is_hardening_ = std::is_base_of<J2Plasticity, MaterialType>::value;
+
+  public:
+    explicit ShearStressRelaxationHourglassControl1stHalfCK(
+        Relation<Inner<Parameters...>> &inner_relation, Real xi = is_hardening_ ? 0.2 : 4.0);
+    virtual ~ShearStressRelaxationHourglassControl1stHalfCK(){};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        CorrectionKernel correction_;
+        Real *Vol_;
+        Vecd *vel_;
+        Matd *velocity_gradient_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        ConstituteKernel constitute_;
+        Real xi_;
+        Real *scale_penalty_force_, *hardening_factor_;
+        Matd *shear_stress_, *velocity_gradient_, *strain_tensor_;
+    };
+
+  protected:
+    MaterialType &material_;
+    KernelCorrectionType kernel_correction_;
+    Real xi_;
+    DiscreteVariable<Matd> *dv_strain_tensor_;
+    DiscreteVariable<Real> *dv_hardening_factor_;
+};
+
+template <typename...>
+class ShearStressRelaxationHourglassControl2ndHalfCK;
+
+template <typename... Parameters>
+class ShearStressRelaxationHourglassControl2ndHalfCK<Inner<Parameters...>>
+    : public ShearStressRelaxation<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = ShearStressRelaxation<Interaction<Inner<Parameters...>>>;
+
+  public:
+    explicit ShearStressRelaxationHourglassControl2ndHalfCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~ShearStressRelaxationHourglassControl2ndHalfCK(){};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real G_;
+        Real *Vol_, *rho_, *scale_penalty_force_;
+        Vecd *vel_, *acc_shear_, *acc_hourglass_;
+        Matd *shear_stress_, *velocity_gradient_;
+    };
+
+  protected:
+    Real G_;
+    DiscreteVariable<Vecd> *dv_acc_shear_, *dv_acc_hourglass_;
+};
+} // namespace continuum_dynamics
+} // namespace SPH
+#endif // CONTINUUM_INTEGRATION_CK_H
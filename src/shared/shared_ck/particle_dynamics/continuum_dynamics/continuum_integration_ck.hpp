@@ -0,0 +1,486 @@
+#ifndef CONTINUUM_INTEGRATION_CK_HPP
+#define CONTINUUM_INTEGRATION_CK_HPP
+
+#include "continuum_integration_ck.h"
+
+namespace SPH
+{
+namespace continuum_dynamics
+{
+//=================================================================================================//
+template <class BaseInteractionType>
+template <class DynamicsIdentifier>
+PlasticAcousticStep<BaseInteractionType>::PlasticAcousticStep(DynamicsIdentifier &identifier)
+    : fluid_dynamics::AcousticStep<BaseInteractionType>(identifier),
+      plastic_continuum_(DynamicCast<PlasticContinuum>(this, this->sph_body_.getBaseMaterial())),
+      dv_stress_tensor_3D_(this->particles_->template registerStateVariableOnly<Mat3d>("StressTensor3D")),
+      dv_strain_tensor_3D_(this->particles_->template registerStateVariableOnly<Mat3d>("StrainTensor3D")),
+      dv_stress_rate_3D_(this->particles_->template registerStateVariableOnly<Mat3d>("StressRate3D")),
+      dv_strain_rate_3D_(this->particles_->template registerStateVariableOnly<Mat3d>("StrainRate3D")),
+      dv_velocity_gradient_(this->particles_->template registerStateVariableOnly<Matd>("VelocityGradient"))
+{
+    this->particles_->template addVariableToSort<Mat3d>("StrainTensor3D");
+    this->particles_->template addVariableToSort<Mat3d>("StressTensor3D");
+    this->particles_->template addVariableToSort<Mat3d>("StrainRate3D");
+    this->particles_->template addVariableToSort<Mat3d>("StressRate3D");
+    this->particles_->template addVariableToRestart<Mat3d>("StressTensor3D");
+    this->particles_->template addVariableToRestart<Mat3d>("StrainTensor3D");
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    PlasticIntegration1stHalfCK(Relation<Inner<Parameters...>> &inner_relation)
+    : PlasticAcousticStep<Interaction<Inner<Parameters...>>>(inner_relation),
+      riemann_solver_(this->plastic_continuum_, this->plastic_continuum_) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InitializeKernel::InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      p_(encloser.dv_p_->DelegatedDataField(ex_policy)),
+      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      dpos_(encloser.dv_dpos_->DelegatedDataField(ex_policy)),
+      stress_tensor_3D_(encloser.dv_stress_tensor_3D_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InitializeKernel::initialize(size_t index_i, Real dt)
+{
+    rho_[index_i] += drho_dt_[index_i] * dt * 0.5;
+    p_[index_i] = -stress_tensor_3D_[index_i].trace() / 3;
+    dpos_[index_i] += vel_[index_i] * dt * 0.5;
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      riemann_solver_(encloser.riemann_solver_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      p_(encloser.dv_p_->DelegatedDataField(ex_policy)),
+      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      stress_tensor_3D_(encloser.dv_stress_tensor_3D_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    Real rho_dissipation(0);
+    Real rho_i = rho_[index_i];
+    Matd stress_tensor_i = stress_tensor_3D_[index_i].block<Dimensions, Dimensions>(0, 0);
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+        Vecd nablaW_ijV_j = dW_ijV_j * this->e_ij(index_i, index_j);
+        Matd stress_tensor_j = stress_tensor_3D_[index_j].block<Dimensions, Dimensions>(0, 0);
+
+        force += mass_[index_i] * rho_[index_j] * ((stress_tensor_i + stress_tensor_j) / (rho_i * rho_[index_j])) * nablaW_ijV_j;
+        rho_dissipation += riemann_solver_.DissipativeUJump(p_[index_i] - p_[index_j]) * dW_ijV_j;
+    }
+    force_[index_i] += force;
+    drho_dt_[index_i] = rho_dissipation * rho_i;
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    UpdateKernel::UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration1stHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    UpdateKernel::update(size_t index_i, Real dt)
+{
+    vel_[index_i] += (force_prior_[index_i] + force_[index_i]) / mass_[index_i] * dt;
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+PlasticIntegration1stHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>::
+    PlasticIntegration1stHalfCK(Relation<Contact<Parameters...>> &wall_contact_relation)
+    : PlasticAcousticStep<Interaction<Contact<Wall, Parameters...>>>(wall_contact_relation),
+      riemann_solver_(this->plastic_continuum_, this->plastic_continuum_) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration1stHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>::
+    InteractKernel::InteractKernel(
+        const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index)
+    : BaseInteraction::InteractKernel(ex_policy, encloser, contact_index),
+      riemann_solver_(encloser.riemann_solver_),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      p_(encloser.dv_p_->DelegatedDataField(ex_policy)),
+      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedDataField(ex_policy)),
+      stress_tensor_3D_(encloser.dv_stress_tensor_3D_->DelegatedDataField(ex_policy)),
+      wall_Vol_(encloser.dv_wall_Vol_[contact_index]->DelegatedDataField(ex_policy)),
+      wall_acc_ave_(encloser.dv_wall_acc_ave_[contact_index]->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration1stHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Vecd force = force_prior_[index_i];
+    Real rho_dissipation(0);
+    Matd stress_tensor_i = stress_tensor_3D_[index_i].block<Dimensions, Dimensions>(0, 0);
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * wall_Vol_[index_j];
+        Vecd e_ij = this->e_ij(index_i, index_j);
+        Real r_ij = this->vec_r_ij(index_i, index_j).norm();
+
+        Real face_wall_external_acceleration = (force_prior_[index_i] / mass_[index_i] - wall_acc_ave_[index_j]).dot(-e_ij);
+        Real p_in_wall = p_[index_i] + rho_[index_i] * r_ij * SMAX(Real(0), face_wall_external_acceleration);
+        force += 2 * mass_[index_i] * stress_tensor_i * dW_ijV_j * e_ij;
+        rho_dissipation += riemann_solver_.DissipativeUJump(p_[index_i] - p_in_wall) * dW_ijV_j;
+    }
+    force_[index_i] += force / rho_[index_i];
+    drho_dt_[index_i] += rho_dissipation * rho_[index_i];
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    PlasticIntegration2ndHalfCK(Relation<Inner<Parameters...>> &inner_relation)
+    : PlasticAcousticStep<Interaction<Inner<Parameters...>>>(inner_relation),
+      riemann_solver_(this->plastic_continuum_, this->plastic_continuum_, 20.0 * (Real)Dimensions) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InitializeKernel::InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      dpos_(encloser.dv_dpos_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InitializeKernel::initialize(size_t index_i, Real dt)
+{
+    dpos_[index_i] += vel_[index_i] * dt * 0.5;
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      riemann_solver_(encloser.riemann_solver_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      velocity_gradient_(encloser.dv_velocity_gradient_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Real density_change_rate(0);
+    Vecd p_dissipation = Vecd::Zero();
+    Matd velocity_gradient = Matd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd e_ij = this->e_ij(index_i, index_j);
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+
+        Real u_jump = (vel_[index_i] - vel_[index_j]).dot(e_ij);
+        density_change_rate += u_jump * dW_ijV_j;
+        p_dissipation += mass_[index_i] * riemann_solver_.DissipativePJump(u_jump) * dW_ijV_j * e_ij;
+        velocity_gradient -= (vel_[index_i] - vel_[index_j]) * dW_ijV_j * e_ij.transpose();
+    }
+    drho_dt_[index_i] += density_change_rate * rho_[index_i];
+    force_[index_i] = p_dissipation / rho_[index_i];
+    velocity_gradient_[index_i] = velocity_gradient;
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    UpdateKernel::UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : constitute_(encloser.plastic_continuum_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)),
+      stress_tensor_3D_(encloser.dv_stress_tensor_3D_->DelegatedDataField(ex_policy)),
+      strain_tensor_3D_(encloser.dv_strain_tensor_3D_->DelegatedDataField(ex_policy)),
+      stress_rate_3D_(encloser.dv_stress_rate_3D_->DelegatedDataField(ex_policy)),
+      strain_rate_3D_(encloser.dv_strain_rate_3D_->DelegatedDataField(ex_policy)),
+      velocity_gradient_(encloser.dv_velocity_gradient_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration2ndHalfCK<Inner<OneLevel, RiemannSolverType, Parameters...>>::
+    UpdateKernel::update(size_t index_i, Real dt)
+{
+    rho_[index_i] += drho_dt_[index_i] * dt * 0.5;
+    Vol_[index_i] = mass_[index_i] / rho_[index_i];
+    Mat3d velocity_gradient = Mat3d::Zero();
+    velocity_gradient.block<Dimensions, Dimensions>(0, 0) = velocity_gradient_[index_i];
+    stress_rate_3D_[index_i] += constitute_.StressRate(velocity_gradient, stress_tensor_3D_[index_i]);
+    stress_tensor_3D_[index_i] += stress_rate_3D_[index_i] * dt;
+    stress_tensor_3D_[index_i] = constitute_.ReturnMapping(stress_tensor_3D_[index_i]);
+    strain_rate_3D_[index_i] = 0.5 * (velocity_gradient + velocity_gradient.transpose());
+    strain_tensor_3D_[index_i] += strain_rate_3D_[index_i] * dt;
+}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+PlasticIntegration2ndHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>::
+    PlasticIntegration2ndHalfCK(Relation<Contact<Parameters...>> &wall_contact_relation)
+    : PlasticAcousticStep<Interaction<Contact<Wall, Parameters...>>>(wall_contact_relation),
+      riemann_solver_(this->plastic_continuum_, this->plastic_continuum_) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PlasticIntegration2ndHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>::
+    InteractKernel::InteractKernel(
+        const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index)
+    : BaseInteraction::InteractKernel(ex_policy, encloser, contact_index),
+      riemann_solver_(encloser.riemann_solver_),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      velocity_gradient_(encloser.dv_velocity_gradient_->DelegatedDataField(ex_policy)),
+      wall_Vol_(encloser.dv_wall_Vol_[contact_index]->DelegatedDataField(ex_policy)),
+      wall_vel_ave_(encloser.dv_wall_vel_ave_[contact_index]->DelegatedDataField(ex_policy)),
+      wall_n_(encloser.dv_wall_n_[contact_index]->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class RiemannSolverType, typename... Parameters>
+void PlasticIntegration2ndHalfCK<Contact<Wall, RiemannSolverType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Real density_change_rate = 0.0;
+    Vecd p_dissipation = Vecd::Zero();
+    Matd velocity_gradient = Matd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd e_ij = this->e_ij(index_i, index_j);
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * wall_Vol_[index_j];
+
+        Vecd vel_in_wall = 2.0 * wall_vel_ave_[index_j] - vel_[index_i];
+        density_change_rate += (vel_[index_i] - vel_in_wall).dot(e_ij) * dW_ijV_j;
+        Real u_jump = 2.0 * (vel_[index_i] - wall_vel_ave_[index_j]).dot(wall_n_[index_j]);
+        p_dissipation += mass_[index_i] * riemann_solver_.DissipativePJump(u_jump) * dW_ijV_j * wall_n_[index_j];
+        velocity_gradient -= (vel_[index_i] - vel_in_wall) * dW_ijV_j * e_ij.transpose();
+    }
+    drho_dt_[index_i] += density_change_rate * rho_[index_i];
+    force_[index_i] += p_dissipation / rho_[index_i];
+    velocity_gradient_[index_i] += velocity_gradient;
+}
+//=================================================================================================//
+template <typename... Parameters>
+StressDiffusionCK<Inner<Parameters...>>::StressDiffusionCK(Relation<Inner<Parameters...>> &inner_relation)
+    : PlasticAcousticStep<Interaction<Inner<Parameters...>>>(inner_relation),
+      one_minus_sin_phi_(1.0 - sin(this->plastic_continuum_.getFrictionAngle())),
+      smoothing_length_(this->sph_body_.sph_adaptation_->ReferenceSmoothingLength()),
+      sound_speed_(this->plastic_continuum_.ReferenceSoundSpeed()) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+StressDiffusionCK<Inner<Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      zeta_(encloser.zeta_), one_minus_sin_phi_(encloser.one_minus_sin_phi_),
+      rho0_(encloser.plastic_continuum_.getDensity()),
+      smoothing_length_(encloser.smoothing_length_), sound_speed_(encloser.sound_speed_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedDataField(ex_policy)),
+      stress_tensor_3D_(encloser.dv_stress_tensor_3D_->DelegatedDataField(ex_policy)),
+      stress_rate_3D_(encloser.dv_stress_rate_3D_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void StressDiffusionCK<Inner<Parameters...>>::InteractKernel::interact(size_t index_i, Real dt)
+{
+    Real gravity = ABS((force_prior_[index_i] / mass_[index_i])[1]);
+    Real lateral_coefficient = one_minus_sin_phi_ * rho0_ * gravity;
+    Mat3d diffusion_stress_rate = Mat3d::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+        Real r_ij = vec_r_ij.norm();
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+        Real y_ij = vec_r_ij[1];
+
+        Mat3d diffusion_stress = stress_tensor_3D_[index_i] - stress_tensor_3D_[index_j];
+        diffusion_stress(0, 0) -= lateral_coefficient * y_ij;
+        diffusion_stress(1, 1) -= rho0_ * gravity * y_ij;
+        diffusion_stress(2, 2) -= lateral_coefficient * y_ij;
+        diffusion_stress_rate += 2 * zeta_ * smoothing_length_ * sound_speed_ *
+                                 diffusion_stress * r_ij * dW_ijV_j / (r_ij * r_ij + 0.01 * smoothing_length_);
+    }
+    stress_rate_3D_[index_i] = diffusion_stress_rate;
+}
+//=================================================================================================//
+template <class BaseInteractionType>
+template <class DynamicsIdentifier>
+ShearStressRelaxation<BaseInteractionType>::ShearStressRelaxation(DynamicsIdentifier &identifier)
+    : BaseInteractionType(identifier),
+      continuum_(DynamicCast<GeneralContinuum>(this, this->sph_body_.getBaseMaterial())),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_rho_(this->particles_->template getVariableByName<Real>("Density")),
+      dv_scale_penalty_force_(this->particles_->template registerStateVariableOnly<Real>("ScalePenaltyForce")),
+      dv_vel_(this->particles_->template registerStateVariableOnly<Vecd>("Velocity")),
+      dv_shear_stress_(this->particles_->template registerStateVariableOnly<Matd>("ShearStress")),
+      dv_velocity_gradient_(this->particles_->template registerStateVariableOnly<Matd>("VelocityGradient"))
+{
+    this->particles_->template addVariableToSort<Matd>("ShearStress");
+    this->particles_->template addVariableToSort<Matd>("VelocityGradient");
+    this->particles_->template addVariableToSort<Real>("ScalePenaltyForce");
+    this->particles_->template addVariableToRestart<Matd>("ShearStress");
+}
+//=================================================================================================//
+template <class MaterialType, class KernelCorrectionType, typename... Parameters>
+ShearStressRelaxationHourglassControl1stHalfCK<Inner<WithUpdate, MaterialType, KernelCorrectionType, Parameters...>>::
+    ShearStressRelaxationHourglassControl1stHalfCK(Relation<Inner<Parameters...>> &inner_relation, Real xi)
+    : ShearStressRelaxation<Interaction<Inner<Parameters...>>>(inner_relation),
+      material_(DynamicCast<MaterialType>(this, this->sph_body_.getBaseMaterial())),
+      kernel_correction_(this->particles_), xi_(xi),
+      dv_strain_tensor_(this->particles_->template registerStateVariableOnly<Matd>("StrainTensor")),
+      dv_hardening_factor_(is_hardening_ ? this->particles_->template registerStateVariableOnly<Real>("HardeningFactor")
+                                         : nullptr)
+{
+    static_assert(std::is_base_of<GeneralContinuum, MaterialType>::value,
+                  "GeneralContinuum is not the base of MaterialType!");
+    static_assert(std::is_base_of<KernelCorrection, KernelCorrectionType>::value,
+                  "KernelCorrection is not the base of KernelCorrectionType!");
+    this->particles_->template addVariableToSort<Matd>("StrainTensor");
+    if constexpr (is_hardening_)
+    {
+        this->particles_->template addVariableToSort<Real>("HardeningFactor");
+        this->particles_->template addVariableToRestart<Real>("HardeningFactor");
+    }
+}
+//=================================================================================================//
+template <class MaterialType, class KernelCorrectionType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+ShearStressRelaxationHourglassControl1stHalfCK<Inner<WithUpdate, MaterialType, KernelCorrectionType, Parameters...>>::
+    InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      correction_(ex_policy, encloser.kernel_correction_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      velocity_gradient_(encloser.dv_velocity_gradient_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class MaterialType, class KernelCorrectionType, typename... Parameters>
+void ShearStressRelaxationHourglassControl1stHalfCK<Inner<WithUpdate, MaterialType, KernelCorrectionType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Matd velocity_gradient = Matd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+        Vecd corrected_e_ij = correction_(index_i) * this->e_ij(index_i, index_j);
+
+        velocity_gradient -= (vel_[index_i] - vel_[index_j]) * (corrected_e_ij * dW_ijV_j).transpose();
+    }
+    velocity_gradient_[index_i] = velocity_gradient;
+}
+//=================================================================================================//
+template <class MaterialType, class KernelCorrectionType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+ShearStressRelaxationHourglassControl1stHalfCK<Inner<WithUpdate, MaterialType, KernelCorrectionType, Parameters...>>::
+    UpdateKernel::UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : constitute_(encloser.material_), xi_(encloser.xi_),
+      scale_penalty_force_(encloser.dv_scale_penalty_force_->DelegatedDataField(ex_policy)),
+      hardening_factor_(encloser.dv_hardening_factor_ != nullptr
+                            ? encloser.dv_hardening_factor_->DelegatedDataField(ex_policy)
+                            : nullptr),
+      shear_stress_(encloser.dv_shear_stress_->DelegatedDataField(ex_policy)),
+      velocity_gradient_(encloser.dv_velocity_gradient_->DelegatedDataField(ex_policy)),
+      strain_tensor_(encloser.dv_strain_tensor_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class MaterialType, class KernelCorrectionType, typename... Parameters>
+void ShearStressRelaxationHourglassControl1stHalfCK<Inner<WithUpdate, MaterialType, KernelCorrectionType, Parameters...>>::
+    UpdateKernel::update(size_t index_i, Real dt)
+{
+    if constexpr (is_hardening_)
+    {
+        Matd shear_stress_rate = constitute_.ShearStressRate(
+            velocity_gradient_[index_i], shear_stress_[index_i], hardening_factor_[index_i]);
+        Matd shear_stress_try = shear_stress_[index_i] + shear_stress_rate * dt;
+        hardening_factor_[index_i] += sqrt(2.0 / 3.0) * constitute_.HardeningFactorRate(shear_stress_try, hardening_factor_[index_i]);
+        scale_penalty_force_[index_i] = xi_ * constitute_.ScalePenaltyForce(shear_stress_try, hardening_factor_[index_i]);
+        shear_stress_[index_i] = constitute_.ReturnMappingShearStress(shear_stress_try, hardening_factor_[index_i]);
+    }
+    else
+    {
+        shear_stress_[index_i] += constitute_.ShearStressRate(velocity_gradient_[index_i], shear_stress_[index_i]) * dt;
+        scale_penalty_force_[index_i] = xi_;
+    }
+    Matd strain_rate = 0.5 * (velocity_gradient_[index_i] + velocity_gradient_[index_i].transpose());
+    strain_tensor_[index_i] += strain_rate * dt;
+}
+//=================================================================================================//
+template <typename... Parameters>
+ShearStressRelaxationHourglassControl2ndHalfCK<Inner<Parameters...>>::
+    ShearStressRelaxationHourglassControl2ndHalfCK(Relation<Inner<Parameters...>> &inner_relation)
+    : ShearStressRelaxation<Interaction<Inner<Parameters...>>>(inner_relation),
+      G_(this->continuum_.getShearModulus(this->continuum_.getYoungsModulus(), this->continuum_.getPoissonRatio())),
+      dv_acc_shear_(this->particles_->template registerStateVariableOnly<Vecd>("AccelerationByShear")),
+      dv_acc_hourglass_(this->particles_->template registerStateVariableOnly<Vecd>("AccelerationHourglass"))
+{
+    this->particles_->template addVariableToSort<Vecd>("AccelerationByShear");
+    this->particles_->template addVariableToSort<Vecd>("AccelerationHourglass");
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+ShearStressRelaxationHourglassControl2ndHalfCK<Inner<Parameters...>>::
+    InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser), G_(encloser.G_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      scale_penalty_force_(encloser.dv_scale_penalty_force_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      acc_shear_(encloser.dv_acc_shear_->DelegatedDataField(ex_policy)),
+      acc_hourglass_(encloser.dv_acc_hourglass_->DelegatedDataField(ex_policy)),
+      shear_stress_(encloser.dv_shear_stress_->DelegatedDataField(ex_policy)),
+      velocity_gradient_(encloser.dv_velocity_gradient_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void ShearStressRelaxationHourglassControl2ndHalfCK<Inner<Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Real rho_i = rho_[index_i];
+    Vecd acceleration = Vecd::Zero();
+    Vecd acceleration_hourglass = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd e_ij = this->e_ij(index_i, index_j);
+        Real r_ij = this->vec_r_ij(index_i, index_j).norm();
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+
+        acceleration += ((shear_stress_[index_i] + shear_stress_[index_j]) / rho_i) * dW_ijV_j * e_ij;
+        Vecd v_ij = vel_[index_i] - vel_[index_j];
+        Vecd v_ij_correction = v_ij - 0.5 * (velocity_gradient_[index_i] + velocity_gradient_[index_j]) * r_ij * e_ij;
+        acceleration_hourglass += 0.5 * (scale_penalty_force_[index_i] + scale_penalty_force_[index_j]) *
+                                  G_ * v_ij_correction * dW_ijV_j * dt / (rho_i * r_ij);
+    }
+    acc_hourglass_[index_i] += acceleration_hourglass;
+    acc_shear_[index_i] = acceleration + acc_hourglass_[index_i];
+}
+//=================================================================================================//
+} // namespace continuum_dynamics
+} // namespace SPH
+#endif // CONTINUUM_INTEGRATION_CK_HPP
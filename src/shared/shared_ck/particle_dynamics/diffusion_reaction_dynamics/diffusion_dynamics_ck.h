@@ -0,0 +1,145 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	diffusion_dynamics_ck.h
+ * @brief 	Computing-kernel version of the diffusion relaxation.
+ * @details Each dynamics relaxes one diffusion species, the inter-particle diffusion
+ *          coefficient is given by the InterParticleDiffusionCoeff kernel of the diffusion type.
+ *          The intermediate species of the Runge-Kutta stages is kept as a discrete variable,
+ *          so that both stages run on the device.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef DIFFUSION_DYNAMICS_CK_H
+#define DIFFUSION_DYNAMICS_CK_H
+
+#include "base_general_dynamics.h"
+#include "diffusion_reaction.h"
+#include "interaction_algorithms_ck.hpp"
+#include "kernel_correction_ck.hpp"
+
+namespace SPH
+{
+class ForwardEuler;       /**< Single-stage time stepping */
+class RungeKutta1stStage; /**< First stage of the 2nd-order Runge-Kutta scheme */
+class RungeKutta2ndStage; /**< Second stage of the 2nd-order Runge-Kutta scheme */
+
+template <class BaseInteractionType, class DiffusionType>
+class DiffusionStep : public BaseInteractionType
+{
+  public:
+    template <class DynamicsIdentifier>
+    DiffusionStep(DynamicsIdentifier &identifier, DiffusionType &diffusion);
+    virtual ~DiffusionStep(){};
+
+  protected:
+    DiffusionType &diffusion_;
+    DiscreteVariable<Real> *dv_Vol_, *dv_diffusion_species_, *dv_gradient_species_;
+    DiscreteVariable<Real> *dv_diffusion_dt_;
+};
+
+template <typename...>
+class DiffusionRelaxationCK;
+
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+class DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>
+    : public DiffusionStep<Interaction<Inner<Parameters...>>, DiffusionType>
+{
+    using BaseInteraction = DiffusionStep<Interaction<Inner<Parameters...>>, DiffusionType>;
+    using DiffusionCoeffKernel = typename DiffusionType::InterParticleDiffusionCoeff;
+    using CorrectionKernel = typename KernelCorrectionType::ComputingKernel;
+
+  public:
+    DiffusionRelaxationCK(Relation<Inner<Parameters...>> &inner_relation, DiffusionType &diffusion);
+    virtual ~DiffusionRelaxationCK(){};
+
+    class InitializeKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void initialize(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *diffusion_dt_, *diffusion_species_, *diffusion_species_s_;
+    };
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        DiffusionCoeffKernel diffusion_coeff_;
+        CorrectionKernel correction_;
+        Real *Vol_, *gradient_species_, *diffusion_dt_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *diffusion_dt_, *diffusion_species_, *diffusion_species_s_;
+    };
+
+  protected:
+    KernelCorrectionType kernel_correction_;
+    /** intermediate species of the Runge-Kutta stages, nullptr for forward Euler */
+    DiscreteVariable<Real> *dv_diffusion_species_s_;
+};
+
+/**
+ * @class DiffusionRelaxationRK2CK
+ * @brief The 2nd-order Runge-Kutta scheme with both stages as computing kernels.
+ */
+template <class ExecutionPolicy, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+class DiffusionRelaxationRK2CK : public BaseDynamics<void>
+{
+    template <class TimeSteppingType>
+    using RK2Stage = InteractionDynamicsCK<
+        ExecutionPolicy, DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType,
+                                                     KernelCorrectionType, Parameters...>>>;
+    RK2Stage<RungeKutta1stStage> rk2_1st_stage_;
+    RK2Stage<RungeKutta2ndStage> rk2_2nd_stage_;
+
+  public:
+    DiffusionRelaxationRK2CK(Relation<Inner<Parameters...>> &inner_relation, DiffusionType &diffusion)
+        : BaseDynamics<void>(),
+          rk2_1st_stage_(inner_relation, diffusion),
+          rk2_2nd_stage_(inner_relation, diffusion){};
+    virtual ~DiffusionRelaxationRK2CK(){};
+
+    virtual void exec(Real dt = 0.0) override
+    {
+        rk2_1st_stage_.exec(dt);
+        rk2_2nd_stage_.exec(dt);
+    };
+};
+} // namespace SPH
+#endif // DIFFUSION_DYNAMICS_CK_H
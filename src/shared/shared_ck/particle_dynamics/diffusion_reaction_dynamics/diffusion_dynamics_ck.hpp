@@ -0,0 +1,119 @@
+#ifndef DIFFUSION_DYNAMICS_CK_HPP
+#define DIFFUSION_DYNAMICS_CK_HPP
+
+#include "diffusion_dynamics_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class BaseInteractionType, class DiffusionType>
+template <class DynamicsIdentifier>
+DiffusionStep<BaseInteractionType, DiffusionType>::
+    DiffusionStep(DynamicsIdentifier &identifier, DiffusionType &diffusion)
+    : BaseInteractionType(identifier), diffusion_(diffusion),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_diffusion_species_(this->particles_->template registerStateVariableOnly<Real>(
+          diffusion.DiffusionSpeciesName())),
+      dv_gradient_species_(this->particles_->template registerStateVariableOnly<Real>(
+          diffusion.GradientSpeciesName())),
+      dv_diffusion_dt_(this->particles_->template registerStateVariableOnly<Real>(
+          diffusion.DiffusionSpeciesName() + "ChangeRate"))
+{
+    this->particles_->template addVariableToSort<Real>(diffusion.DiffusionSpeciesName());
+    this->particles_->template addVariableToWrite<Real>(diffusion.DiffusionSpeciesName());
+    this->particles_->template addVariableToSort<Real>(diffusion.GradientSpeciesName());
+    this->particles_->template addVariableToWrite<Real>(diffusion.GradientSpeciesName());
+}
+//=================================================================================================//
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>::
+    DiffusionRelaxationCK(Relation<Inner<Parameters...>> &inner_relation, DiffusionType &diffusion)
+    : BaseInteraction(inner_relation, diffusion), kernel_correction_(this->particles_),
+      dv_diffusion_species_s_(nullptr)
+{
+    static_assert(std::is_base_of<KernelCorrection, KernelCorrectionType>::value,
+                  "KernelCorrection is not the base of KernelCorrectionType!");
+
+    if constexpr (!std::is_same_v<TimeSteppingType, ForwardEuler>)
+    {
+        dv_diffusion_species_s_ = this->particles_->template registerStateVariableOnly<Real>(
+            diffusion.DiffusionSpeciesName() + "Intermediate");
+    }
+}
+//=================================================================================================//
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>::
+    InitializeKernel::InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : diffusion_dt_(encloser.dv_diffusion_dt_->DelegatedDataField(ex_policy)),
+      diffusion_species_(encloser.dv_diffusion_species_->DelegatedDataField(ex_policy)),
+      diffusion_species_s_(encloser.dv_diffusion_species_s_ != nullptr
+                               ? encloser.dv_diffusion_species_s_->DelegatedDataField(ex_policy)
+                               : nullptr) {}
+//=================================================================================================//
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+void DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>::
+    InitializeKernel::initialize(size_t index_i, Real dt)
+{
+    diffusion_dt_[index_i] = 0.0;
+    if constexpr (std::is_same_v<TimeSteppingType, RungeKutta1stStage>)
+    {
+        diffusion_species_s_[index_i] = diffusion_species_[index_i];
+    }
+}
+//=================================================================================================//
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>::
+    InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      diffusion_coeff_(ex_policy, encloser.diffusion_),
+      correction_(ex_policy, encloser.kernel_correction_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      gradient_species_(encloser.dv_gradient_species_->DelegatedDataField(ex_policy)),
+      diffusion_dt_(encloser.dv_diffusion_dt_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+void DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    Real d_species(0);
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+        Vecd vec_r_ij = this->vec_r_ij(index_i, index_j);
+        Real r_ij = vec_r_ij.norm();
+        Vecd e_ij = vec_r_ij / (r_ij + TinyReal);
+
+        Real diff_coeff_ij = diffusion_coeff_(index_i, index_j, e_ij);
+        Vecd grad_ijV_j = 0.5 * dW_ijV_j * (correction_(index_i) + correction_(index_j)) * e_ij;
+        Real surface_area_ij = 2.0 * grad_ijV_j.dot(e_ij) / r_ij;
+        d_species += diff_coeff_ij * (gradient_species_[index_i] - gradient_species_[index_j]) * surface_area_ij;
+    }
+    diffusion_dt_[index_i] += d_species;
+}
+//=================================================================================================//
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>::
+    UpdateKernel::UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : diffusion_dt_(encloser.dv_diffusion_dt_->DelegatedDataField(ex_policy)),
+      diffusion_species_(encloser.dv_diffusion_species_->DelegatedDataField(ex_policy)),
+      diffusion_species_s_(encloser.dv_diffusion_species_s_ != nullptr
+                               ? encloser.dv_diffusion_species_s_->DelegatedDataField(ex_policy)
+                               : nullptr) {}
+//=================================================================================================//
+template <class TimeSteppingType, class DiffusionType, class KernelCorrectionType, typename... Parameters>
+void DiffusionRelaxationCK<Inner<OneLevel, TimeSteppingType, DiffusionType, KernelCorrectionType, Parameters...>>::
+    UpdateKernel::update(size_t index_i, Real dt)
+{
+    diffusion_species_[index_i] += dt * diffusion_dt_[index_i];
+    if constexpr (std::is_same_v<TimeSteppingType, RungeKutta2ndStage>)
+    {
+        diffusion_species_[index_i] = 0.5 * diffusion_species_s_[index_i] + 0.5 * diffusion_species_[index_i];
+    }
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // DIFFUSION_DYNAMICS_CK_HPP
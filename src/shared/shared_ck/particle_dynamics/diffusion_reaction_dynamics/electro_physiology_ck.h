@@ -0,0 +1,56 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	electro_physiology_ck.h
+ * @brief 	Computing-kernel diffusion and reaction relaxations for electrophysiology.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef ELECTRO_PHYSIOLOGY_CK_H
+#define ELECTRO_PHYSIOLOGY_CK_H
+
+#include "diffusion_dynamics_ck.hpp"
+#include "electro_physiology.h"
+#include "reaction_dynamics_ck.hpp"
+#include "simple_algorithms_ck.h"
+
+namespace SPH
+{
+namespace electro_physiology
+{
+/** Compute the diffusion relaxation of the trans-membrane potential with the RK2 scheme */
+template <class ExecutionPolicy, class DirectionalDiffusionType>
+using ElectroPhysiologyDiffusionInnerRK2CK =
+    DiffusionRelaxationRK2CK<ExecutionPolicy, DirectionalDiffusionType, LinearCorrectionCK>;
+
+/** Solve the reaction ODE equation of trans-membrane potential	using forward sweeping */
+template <class ExecutionPolicy, class ReactionModelType = AlievPanfilowModel>
+using ElectroPhysiologyReactionRelaxationForwardCK =
+    StateDynamics<ExecutionPolicy, ReactionRelaxationForwardCK<ReactionModelType>>;
+/** Solve the reaction ODE equation of trans-membrane potential	using backward sweeping */
+template <class ExecutionPolicy, class ReactionModelType = AlievPanfilowModel>
+using ElectroPhysiologyReactionRelaxationBackwardCK =
+    StateDynamics<ExecutionPolicy, ReactionRelaxationBackwardCK<ReactionModelType>>;
+} // namespace electro_physiology
+} // namespace SPH
+#endif // ELECTRO_PHYSIOLOGY_CK_H
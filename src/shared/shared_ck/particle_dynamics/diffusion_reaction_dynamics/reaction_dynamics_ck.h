@@ -0,0 +1,113 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	reaction_dynamics_ck.h
+ * @brief 	Computing-kernel version of the reaction relaxation by operator splitting.
+ * @details The reaction model provides a ReactionKernel giving the production and
+ *          loss rates of each reactive species, so that no std::function is called
+ *          in the computing kernels.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef REACTION_DYNAMICS_CK_H
+#define REACTION_DYNAMICS_CK_H
+
+#include "base_general_dynamics.h"
+#include "diffusion_reaction.h"
+
+namespace SPH
+{
+template <class ReactionModelType>
+class BaseReactionRelaxationCK : public LocalDynamics
+{
+    static constexpr int NumReactiveSpecies = ReactionModelType::NumSpecies;
+    using LocalSpecies = std::array<Real, NumReactiveSpecies>;
+    using ReactionKernel = typename ReactionModelType::ReactionKernel;
+
+  public:
+    BaseReactionRelaxationCK(SPHBody &sph_body, ReactionModelType &reaction_model);
+    virtual ~BaseReactionRelaxationCK(){};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+
+      protected:
+        ReactionKernel reaction_;
+        std::array<Real *, NumReactiveSpecies> reactive_species_;
+
+        Real updateReactionSpecies(Real input, Real production_rate, Real loss_rate, Real dt)
+        {
+            Real alpha = exp(-loss_rate * dt);
+            return input * alpha + production_rate * (1.0 - alpha) / (loss_rate + TinyReal);
+        };
+        void advanceForwardStep(size_t index_i, Real dt);
+        void advanceBackwardStep(size_t index_i, Real dt);
+    };
+
+  protected:
+    ReactionModelType &reaction_model_;
+    StdVec<DiscreteVariable<Real> *> dv_reactive_species_;
+};
+
+template <class ReactionModelType>
+class ReactionRelaxationForwardCK : public BaseReactionRelaxationCK<ReactionModelType>
+{
+  public:
+    template <typename... Args>
+    ReactionRelaxationForwardCK(Args &&...args)
+        : BaseReactionRelaxationCK<ReactionModelType>(std::forward<Args>(args)...){};
+    virtual ~ReactionRelaxationForwardCK(){};
+
+    class UpdateKernel : public BaseReactionRelaxationCK<ReactionModelType>::UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy, ReactionRelaxationForwardCK<ReactionModelType> &encloser)
+            : BaseReactionRelaxationCK<ReactionModelType>::UpdateKernel(ex_policy, encloser){};
+        void update(size_t index_i, Real dt = 0.0) { this->advanceForwardStep(index_i, dt); };
+    };
+};
+
+template <class ReactionModelType>
+class ReactionRelaxationBackwardCK : public BaseReactionRelaxationCK<ReactionModelType>
+{
+  public:
+    template <typename... Args>
+    ReactionRelaxationBackwardCK(Args &&...args)
+        : BaseReactionRelaxationCK<ReactionModelType>(std::forward<Args>(args)...){};
+    virtual ~ReactionRelaxationBackwardCK(){};
+
+    class UpdateKernel : public BaseReactionRelaxationCK<ReactionModelType>::UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy, ReactionRelaxationBackwardCK<ReactionModelType> &encloser)
+            : BaseReactionRelaxationCK<ReactionModelType>::UpdateKernel(ex_policy, encloser){};
+        void update(size_t index_i, Real dt = 0.0) { this->advanceBackwardStep(index_i, dt); };
+    };
+};
+} // namespace SPH
+#endif // REACTION_DYNAMICS_CK_H
@@ -0,0 +1,82 @@
+#ifndef REACTION_DYNAMICS_CK_HPP
+#define REACTION_DYNAMICS_CK_HPP
+
+#include "reaction_dynamics_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class ReactionModelType>
+BaseReactionRelaxationCK<ReactionModelType>::
+    BaseReactionRelaxationCK(SPHBody &sph_body, ReactionModelType &reaction_model)
+    : LocalDynamics(sph_body), reaction_model_(reaction_model)
+{
+    auto &species_names = reaction_model.getSpeciesNames();
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        dv_reactive_species_.push_back(
+            this->particles_->template registerStateVariableOnly<Real>(species_names[k]));
+    }
+}
+//=================================================================================================//
+template <class ReactionModelType>
+template <class ExecutionPolicy, class EncloserType>
+BaseReactionRelaxationCK<ReactionModelType>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : reaction_(encloser.reaction_model_)
+{
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        reactive_species_[k] = encloser.dv_reactive_species_[k]->DelegatedDataField(ex_policy);
+    }
+}
+//=================================================================================================//
+template <class ReactionModelType>
+void BaseReactionRelaxationCK<ReactionModelType>::UpdateKernel::
+    advanceForwardStep(size_t index_i, Real dt)
+{
+    LocalSpecies local_species;
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        local_species[k] = reactive_species_[k][index_i];
+    }
+
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        Real production_rate = reaction_.getProductionRate(k, local_species);
+        Real loss_rate = reaction_.getLossRate(k, local_species);
+        local_species[k] = updateReactionSpecies(local_species[k], production_rate, loss_rate, dt);
+    }
+
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        reactive_species_[k][index_i] = local_species[k];
+    }
+}
+//=================================================================================================//
+template <class ReactionModelType>
+void BaseReactionRelaxationCK<ReactionModelType>::UpdateKernel::
+    advanceBackwardStep(size_t index_i, Real dt)
+{
+    LocalSpecies local_species;
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        local_species[k] = reactive_species_[k][index_i];
+    }
+
+    for (size_t k = NumReactiveSpecies; k != 0; --k)
+    {
+        size_t m = k - 1;
+        Real production_rate = reaction_.getProductionRate(m, local_species);
+        Real loss_rate = reaction_.getLossRate(m, local_species);
+        local_species[m] = updateReactionSpecies(local_species[m], production_rate, loss_rate, dt);
+    }
+
+    for (size_t k = 0; k != NumReactiveSpecies; ++k)
+    {
+        reactive_species_[k][index_i] = local_species[k];
+    }
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // REACTION_DYNAMICS_CK_HPP
@@ -0,0 +1,136 @@
+#include "distributed_domain.h"
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+//=================================================================================================//
+DistributedDomain::DistributedDomain(SPHSystem &sph_system, MPI_Comm communicator)
+    : communicator_(communicator), rank_(0), number_of_ranks_(1), axis_(0),
+      local_bounds_(sph_system.system_domain_bounds_),
+      lower_neighbor_rank_(MPI_PROC_NULL), upper_neighbor_rank_(MPI_PROC_NULL)
+{
+    int is_initialized = 0;
+    MPI_Initialized(&is_initialized);
+    if (!is_initialized)
+    {
+        std::cout << "\n Error: MPI is not initialized before the domain decomposition!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    MPI_Comm_rank(communicator_, &rank_);
+    MPI_Comm_size(communicator_, &number_of_ranks_);
+
+    BoundingBox &system_bounds = sph_system.system_domain_bounds_;
+    Vecd extent = system_bounds.second_ - system_bounds.first_;
+    extent.maxCoeff(&axis_);
+
+    Real slab_width = extent[axis_] / Real(number_of_ranks_);
+    StdVec<Real> slab_cuts(number_of_ranks_ + 1);
+    for (int k = 0; k != number_of_ranks_; ++k)
+    {
+        slab_cuts[k] = system_bounds.first_[axis_] + Real(k) * slab_width;
+    }
+    slab_cuts[number_of_ranks_] = system_bounds.second_[axis_];
+    resetSlabCuts(slab_cuts);
+    lower_neighbor_rank_ = rank_ == 0 ? MPI_PROC_NULL : rank_ - 1;
+    upper_neighbor_rank_ = rank_ == number_of_ranks_ - 1 ? MPI_PROC_NULL : rank_ + 1;
+}
+//=================================================================================================//
+void DistributedDomain::resetSlabCuts(const StdVec<Real> &slab_cuts)
+{
+    Real lower_bound = slab_cuts_.empty() ? slab_cuts.front() : slab_cuts_.front();
+    Real upper_bound = slab_cuts_.empty() ? slab_cuts.back() : slab_cuts_.back();
+    slab_cuts_ = slab_cuts;
+    slab_cuts_.front() = lower_bound;
+    slab_cuts_.back() = upper_bound;
+    local_bounds_.first_[axis_] = slab_cuts_[rank_];
+    local_bounds_.second_[axis_] = slab_cuts_[rank_ + 1];
+}
+//=================================================================================================//
+bool DistributedDomain::isBelowLocalDomain(const Vecd &position)
+{
+    return lower_neighbor_rank_ != MPI_PROC_NULL && position[axis_] < local_bounds_.first_[axis_];
+}
+//=================================================================================================//
+bool DistributedDomain::isAboveLocalDomain(const Vecd &position)
+{
+    return upper_neighbor_rank_ != MPI_PROC_NULL && position[axis_] >= local_bounds_.second_[axis_];
+}
+//=================================================================================================//
+bool DistributedDomain::isInLocalDomain(const Vecd &position)
+{
+    return !isBelowLocalDomain(position) && !isAboveLocalDomain(position);
+}
+//=================================================================================================//
+size_t DistributedDomain::allReduceSum(size_t local_value)
+{
+    unsigned long long local_sum = local_value;
+    unsigned long long global_sum = local_sum;
+    MPI_Allreduce(&local_sum, &global_sum, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, communicator_);
+    return size_t(global_sum);
+}
+//=================================================================================================//
+Real DistributedDomain::allReduceSum(Real local_value)
+{
+    Real global_sum = local_value;
+    MPI_Allreduce(&local_value, &global_sum, 1, MPIDataType<Real>::type(), MPI_SUM, communicator_);
+    return global_sum;
+}
+//=================================================================================================//
+void DistributedDomain::allReduceSum(StdVec<Real> &values)
+{
+    MPI_Allreduce(MPI_IN_PLACE, values.data(), int(values.size()),
+                  MPIDataType<Real>::type(), MPI_SUM, communicator_);
+}
+//=================================================================================================//
+void DistributedDomain::exchangeWithNeighbors(const StdVec<char> &send_to_lower, const StdVec<char> &send_to_upper,
+                                              StdVec<char> &receive_from_lower, StdVec<char> &receive_from_upper)
+{
+    exchangeBytes(send_to_upper, upper_neighbor_rank_, receive_from_lower, lower_neighbor_rank_);
+    exchangeBytes(send_to_lower, lower_neighbor_rank_, receive_from_upper, upper_neighbor_rank_);
+}
+//=================================================================================================//
+void DistributedDomain::startExchangeWithNeighbors(const StdVec<char> &send_to_lower, const StdVec<char> &send_to_upper,
+                                                   StdVec<char> &receive_from_lower, StdVec<char> &receive_from_upper,
+                                                   StdVec<MPI_Request> &requests)
+{
+    if (!requests.empty())
+    {
+        std::cout << "\n Error: an exchange with the neighbors is started before the last one is finished!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    requests.resize(4);
+    MPI_Irecv(receive_from_lower.data(), int(receive_from_lower.size()), MPI_BYTE, lower_neighbor_rank_, 2,
+              communicator_, &requests[0]);
+    MPI_Irecv(receive_from_upper.data(), int(receive_from_upper.size()), MPI_BYTE, upper_neighbor_rank_, 3,
+              communicator_, &requests[1]);
+    MPI_Isend(send_to_upper.data(), int(send_to_upper.size()), MPI_BYTE, upper_neighbor_rank_, 2,
+              communicator_, &requests[2]);
+    MPI_Isend(send_to_lower.data(), int(send_to_lower.size()), MPI_BYTE, lower_neighbor_rank_, 3,
+              communicator_, &requests[3]);
+}
+//=================================================================================================//
+void DistributedDomain::finishExchangeWithNeighbors(StdVec<MPI_Request> &requests)
+{
+    MPI_Waitall(int(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    requests.clear();
+}
+//=================================================================================================//
+void DistributedDomain::exchangeBytes(const StdVec<char> &send_buffer, int destination,
+                                      StdVec<char> &receive_buffer, int source)
+{
+    unsigned long long send_size = send_buffer.size();
+    unsigned long long receive_size = 0;
+    MPI_Sendrecv(&send_size, 1, MPI_UNSIGNED_LONG_LONG, destination, 0,
+                 &receive_size, 1, MPI_UNSIGNED_LONG_LONG, source, 0,
+                 communicator_, MPI_STATUS_IGNORE);
+
+    receive_buffer.resize(receive_size);
+    MPI_Sendrecv(send_buffer.data(), int(send_size), MPI_BYTE, destination, 1,
+                 receive_buffer.data(), int(receive_size), MPI_BYTE, source, 1,
+                 communicator_, MPI_STATUS_IGNORE);
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
@@ -0,0 +1,146 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    distributed_domain.h
+ * @brief   Decomposition of the system domain across MPI ranks.
+ * @details The system domain bounds are cut into slabs along their longest axis,
+ *          one slab for each rank. The slabs have equal width initially and
+ *          their cuts can be moved later for load balancing. A rank owns the particles in its slab and exchanges
+ *          particles only with the ranks of the neighboring slabs.
+ *          Available when built with SPHINXSYS_USE_MPI.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef DISTRIBUTED_DOMAIN_H
+#define DISTRIBUTED_DOMAIN_H
+
+#include "base_data_package.h"
+#include "particle_functors.h"
+#include "sph_system.h"
+
+#if SPHINXSYS_USE_MPI
+#include <mpi.h>
+
+namespace SPH
+{
+template <typename DataType>
+struct MPIDataType;
+
+template <>
+struct MPIDataType<double>
+{
+    static MPI_Datatype type() { return MPI_DOUBLE; };
+};
+
+template <>
+struct MPIDataType<float>
+{
+    static MPI_Datatype type() { return MPI_FLOAT; };
+};
+
+template <>
+struct MPIDataType<unsigned long long>
+{
+    static MPI_Datatype type() { return MPI_UNSIGNED_LONG_LONG; };
+};
+
+template <class Operation>
+struct MPIReduceOperation;
+
+template <>
+struct MPIReduceOperation<ReduceMax>
+{
+    static MPI_Op op() { return MPI_MAX; };
+};
+
+template <>
+struct MPIReduceOperation<ReduceMin>
+{
+    static MPI_Op op() { return MPI_MIN; };
+};
+
+/**
+ * @class DistributedDomain
+ * @brief The slab of the system domain owned by this rank and the ranks of the neighboring slabs.
+ *        MPI is to be initialized before, e.g. by MPI_Init at the beginning of main.
+ */
+class DistributedDomain
+{
+  public:
+    explicit DistributedDomain(SPHSystem &sph_system, MPI_Comm communicator = MPI_COMM_WORLD);
+    virtual ~DistributedDomain() {};
+
+    MPI_Comm Communicator() { return communicator_; };
+    int Rank() { return rank_; };
+    int NumberOfRanks() { return number_of_ranks_; };
+    int DecompositionAxis() { return axis_; };
+    BoundingBox &LocalDomainBounds() { return local_bounds_; };
+    /** MPI_PROC_NULL for the first and last slab, so that the exchanges there are void */
+    int LowerNeighborRank() { return lower_neighbor_rank_; };
+    int UpperNeighborRank() { return upper_neighbor_rank_; };
+    bool isBelowLocalDomain(const Vecd &position);
+    bool isAboveLocalDomain(const Vecd &position);
+    bool isInLocalDomain(const Vecd &position);
+
+    template <typename DataType, class Operation>
+    DataType allReduce(DataType local_value, Operation &operation)
+    {
+        DataType global_value = local_value;
+        MPI_Allreduce(&local_value, &global_value, 1, MPIDataType<DataType>::type(),
+                      MPIReduceOperation<Operation>::op(), communicator_);
+        return global_value;
+    };
+    size_t allReduceSum(size_t local_value);
+    Real allReduceSum(Real local_value);
+    /** element-wise sum over all ranks in place */
+    void allReduceSum(StdVec<Real> &values);
+    /** the positions of all slab bounds along the axis, number of ranks plus one */
+    StdVec<Real> &SlabCuts() { return slab_cuts_; };
+    /** moves the inner cuts and the local bounds, the outer cuts are fixed by the system domain */
+    void resetSlabCuts(const StdVec<Real> &slab_cuts);
+    /** sends to the upper and lower neighbors and receives from them, the receive buffers are resized */
+    void exchangeWithNeighbors(const StdVec<char> &send_to_lower, const StdVec<char> &send_to_upper,
+                               StdVec<char> &receive_from_lower, StdVec<char> &receive_from_upper);
+    /** non-blocking exchange into receive buffers already sized to the expected bytes,
+     *  the buffers are not to be touched until the requests are finished */
+    void startExchangeWithNeighbors(const StdVec<char> &send_to_lower, const StdVec<char> &send_to_upper,
+                                    StdVec<char> &receive_from_lower, StdVec<char> &receive_from_upper,
+                                    StdVec<MPI_Request> &requests);
+    void finishExchangeWithNeighbors(StdVec<MPI_Request> &requests);
+
+  protected:
+    MPI_Comm communicator_;
+    int rank_;
+    int number_of_ranks_;
+    int axis_;
+    BoundingBox local_bounds_;
+    StdVec<Real> slab_cuts_;
+    int lower_neighbor_rank_;
+    int upper_neighbor_rank_;
+
+    void exchangeBytes(const StdVec<char> &send_buffer, int destination,
+                       StdVec<char> &receive_buffer, int source);
+};
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
+#endif // DISTRIBUTED_DOMAIN_H
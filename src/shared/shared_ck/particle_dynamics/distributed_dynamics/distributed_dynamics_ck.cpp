@@ -0,0 +1,251 @@
+#include "distributed_dynamics_ck.hpp"
+
+#include "base_particles.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+//=================================================================================================//
+DistributedParticleExchange::
+    DistributedParticleExchange(RealBody &real_body, DistributedDomain &distributed_domain)
+    : LocalDynamics(real_body), BaseDynamics<void>(), domain_(distributed_domain),
+      halo_width_(real_body.sph_adaptation_->getKernel()->CutOffRadius()),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      total_owned_particles_(particles_->TotalRealParticles()), total_interior_particles_(0),
+      halo_from_lower_(0), halo_from_upper_(0),
+      particle_bytes_(particles_->VariablesToSort()),
+      pack_particles_(particles_->VariablesToSort()),
+      unpack_particles_(particles_->VariablesToSort()),
+      swap_particles_(particles_->VariablesToSort())
+{
+    particles_->addVariableToSort<Vecd>("Position");
+}
+//=================================================================================================//
+void DistributedParticleExchange::distributeInitialParticles()
+{
+    removeHaloParticles();
+    total_owned_particles_ = particles_->TotalRealParticles();
+    Vecd *pos = dv_pos_->DataField();
+    IndexVector not_local;
+    for (size_t i = 0; i != total_owned_particles_; ++i)
+    {
+        if (!domain_.isInLocalDomain(pos[i]))
+        {
+            not_local.push_back(i);
+        }
+    }
+    removeOwnedParticles(not_local);
+    total_interior_particles_ = 0;
+}
+//=================================================================================================//
+void DistributedParticleExchange::exec(Real dt)
+{
+    removeHaloParticles();
+    migrateParticles();
+    buildHalo();
+}
+//=================================================================================================//
+void DistributedParticleExchange::redistributeParticles()
+{
+    removeHaloParticles();
+    while (domain_.allReduceSum(migrateParticles()) != 0)
+    {
+    }
+    buildHalo();
+}
+//=================================================================================================//
+void DistributedParticleExchange::updateHalo()
+{
+    packParticles(lower_halo_, send_to_lower_);
+    packParticles(upper_halo_, send_to_upper_);
+    domain_.exchangeWithNeighbors(send_to_lower_, send_to_upper_, receive_from_lower_, receive_from_upper_);
+
+    size_t particle_bytes = ParticleBytesOfVariables();
+    if (receive_from_lower_.size() != halo_from_lower_ * particle_bytes ||
+        receive_from_upper_.size() != halo_from_upper_ * particle_bytes)
+    {
+        std::cout << "\n Error: the halo of " << sph_body_.getName()
+                  << " is changed without rebuilding!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    unpackParticles(receive_from_lower_, total_owned_particles_, halo_from_lower_);
+    unpackParticles(receive_from_upper_, total_owned_particles_ + halo_from_lower_, halo_from_upper_);
+}
+//=================================================================================================//
+void DistributedParticleExchange::startHaloUpdate()
+{
+    packParticles(lower_halo_, send_to_lower_);
+    packParticles(upper_halo_, send_to_upper_);
+    size_t particle_bytes = ParticleBytesOfVariables();
+    receive_from_lower_.resize(halo_from_lower_ * particle_bytes);
+    receive_from_upper_.resize(halo_from_upper_ * particle_bytes);
+    domain_.startExchangeWithNeighbors(send_to_lower_, send_to_upper_,
+                                       receive_from_lower_, receive_from_upper_, halo_requests_);
+}
+//=================================================================================================//
+void DistributedParticleExchange::finishHaloUpdate()
+{
+    domain_.finishExchangeWithNeighbors(halo_requests_);
+    unpackParticles(receive_from_lower_, total_owned_particles_, halo_from_lower_);
+    unpackParticles(receive_from_upper_, total_owned_particles_ + halo_from_lower_, halo_from_upper_);
+}
+//=================================================================================================//
+IndexRange DistributedParticleExchange::HaloRange()
+{
+    return IndexRange(total_owned_particles_, total_owned_particles_ + TotalHaloParticles());
+}
+//=================================================================================================//
+IndexRange DistributedParticleExchange::BoundaryRange()
+{
+    return IndexRange(total_interior_particles_, total_owned_particles_ + TotalHaloParticles());
+}
+//=================================================================================================//
+size_t DistributedParticleExchange::ParticleBytesOfVariables()
+{
+    size_t bytes = 0;
+    particle_bytes_(bytes);
+    return bytes;
+}
+//=================================================================================================//
+void DistributedParticleExchange::packParticles(const IndexVector &particles, StdVec<char> &buffer)
+{
+    buffer.clear();
+    pack_particles_(particles, buffer);
+}
+//=================================================================================================//
+void DistributedParticleExchange::
+    unpackParticles(const StdVec<char> &buffer, size_t first_index, size_t number_of_particles)
+{
+    const char *data = buffer.data();
+    unpack_particles_(first_index, number_of_particles, data);
+}
+//=================================================================================================//
+void DistributedParticleExchange::removeOwnedParticles(IndexVector &particles)
+{
+    std::sort(particles.begin(), particles.end(), std::greater<size_t>());
+    for (size_t index : particles)
+    {
+        size_t last_owned_particle = total_owned_particles_ - 1;
+        if (index < last_owned_particle)
+        {
+            particles_->copyFromAnotherParticle(index, last_owned_particle);
+        }
+        total_owned_particles_--;
+        particles_->decrementTotalRealParticles();
+    }
+}
+//=================================================================================================//
+UnsignedInt DistributedParticleExchange::appendParticles(const StdVec<char> &buffer)
+{
+    size_t particle_bytes = ParticleBytesOfVariables();
+    UnsignedInt number_of_particles = particle_bytes == 0 ? 0 : buffer.size() / particle_bytes;
+    UnsignedInt first_index = particles_->TotalRealParticles();
+    if (first_index + number_of_particles > particles_->RealParticlesBound())
+    {
+        std::cout << "\n Error: the particle buffer of " << sph_body_.getName()
+                  << " is not large enough for the particles from other ranks!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    unpackParticles(buffer, first_index, number_of_particles);
+    particles_->incrementTotalRealParticles(number_of_particles);
+    return number_of_particles;
+}
+//=================================================================================================//
+void DistributedParticleExchange::removeHaloParticles()
+{
+    particles_->decrementTotalRealParticles(halo_from_lower_ + halo_from_upper_);
+    halo_from_lower_ = 0;
+    halo_from_upper_ = 0;
+}
+//=================================================================================================//
+size_t DistributedParticleExchange::migrateParticles()
+{
+    Vecd *pos = dv_pos_->DataField();
+    IndexVector to_lower, to_upper;
+    for (size_t i = 0; i != total_owned_particles_; ++i)
+    {
+        if (domain_.isBelowLocalDomain(pos[i]))
+        {
+            to_lower.push_back(i);
+        }
+        else if (domain_.isAboveLocalDomain(pos[i]))
+        {
+            to_upper.push_back(i);
+        }
+    }
+    packParticles(to_lower, send_to_lower_);
+    packParticles(to_upper, send_to_upper_);
+
+    IndexVector leaving(to_lower);
+    leaving.insert(leaving.end(), to_upper.begin(), to_upper.end());
+    removeOwnedParticles(leaving);
+
+    domain_.exchangeWithNeighbors(send_to_lower_, send_to_upper_, receive_from_lower_, receive_from_upper_);
+    total_owned_particles_ += appendParticles(receive_from_lower_);
+    total_owned_particles_ += appendParticles(receive_from_upper_);
+    return leaving.size();
+}
+//=================================================================================================//
+void DistributedParticleExchange::orderInteriorParticlesFirst(Real lower_halo_bound, Real upper_halo_bound)
+{
+    Vecd *pos = dv_pos_->DataField();
+    int axis = domain_.DecompositionAxis();
+    auto is_boundary = [&](size_t i)
+    {
+        return (domain_.LowerNeighborRank() != MPI_PROC_NULL && pos[i][axis] < lower_halo_bound) ||
+               (domain_.UpperNeighborRank() != MPI_PROC_NULL && pos[i][axis] >= upper_halo_bound);
+    };
+
+    IndexVector boundary_in_front, interior_behind;
+    size_t front = 0;
+    size_t behind = total_owned_particles_;
+    while (true)
+    {
+        while (front < behind && !is_boundary(front))
+            ++front;
+        while (front < behind && is_boundary(behind - 1))
+            --behind;
+        if (front >= behind)
+            break;
+        boundary_in_front.push_back(front++);
+        interior_behind.push_back(--behind);
+    }
+    swap_particles_(boundary_in_front, interior_behind);
+    total_interior_particles_ = front;
+}
+//=================================================================================================//
+void DistributedParticleExchange::buildHalo()
+{
+    Vecd *pos = dv_pos_->DataField();
+    int axis = domain_.DecompositionAxis();
+    Real lower_halo_bound = domain_.LocalDomainBounds().first_[axis] + halo_width_;
+    Real upper_halo_bound = domain_.LocalDomainBounds().second_[axis] - halo_width_;
+    orderInteriorParticlesFirst(lower_halo_bound, upper_halo_bound);
+    lower_halo_.clear();
+    upper_halo_.clear();
+    for (size_t i = 0; i != total_owned_particles_; ++i)
+    {
+        if (domain_.LowerNeighborRank() != MPI_PROC_NULL && pos[i][axis] < lower_halo_bound)
+        {
+            lower_halo_.push_back(i);
+        }
+        if (domain_.UpperNeighborRank() != MPI_PROC_NULL && pos[i][axis] >= upper_halo_bound)
+        {
+            upper_halo_.push_back(i);
+        }
+    }
+    packParticles(lower_halo_, send_to_lower_);
+    packParticles(upper_halo_, send_to_upper_);
+
+    domain_.exchangeWithNeighbors(send_to_lower_, send_to_upper_, receive_from_lower_, receive_from_upper_);
+    halo_from_lower_ = appendParticles(receive_from_lower_);
+    halo_from_upper_ = appendParticles(receive_from_upper_);
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
@@ -0,0 +1,175 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    distributed_dynamics_ck.h
+ * @brief   Particle migration, halo exchange and global reductions across MPI ranks.
+ * @details Each rank keeps its owned particles as the first real particles and the halo,
+ *          the particles of the neighboring ranks within one cut-off radius, as the following ones.
+ *          The local dynamics then run on owned and halo particles without change.
+ *          The states obtained for halo particles are discarded, as the halo is refreshed
+ *          from its owners by the next exchange. The exchanged states are the sortable variables,
+ *          i.e. all states which persist between steps. The particle buffer of a body needs to hold
+ *          the incoming and halo particles. The data are exchanged on the host.
+ *          Available when built with SPHINXSYS_USE_MPI.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef DISTRIBUTED_DYNAMICS_CK_H
+#define DISTRIBUTED_DYNAMICS_CK_H
+
+#include "distributed_domain.h"
+
+#include "base_local_dynamics.h"
+#include "base_particle_dynamics.h"
+#include "interaction_algorithms_ck.h"
+#include "simple_algorithms_ck.h"
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+/**
+ * @class DistributedParticleExchange
+ * @brief Migrates the owned particles which have left the local domain to the neighboring ranks
+ *        and rebuilds the halo. To be executed before UpdateCellLinkedList and UpdateRelation,
+ *        while updateHalo refreshes the halo states between the stages of a time step.
+ *        Particle sorting, if any, is to be done before exec, when the halo is removed.
+ *        The owned particles are ordered with the interior ones, which are farther than the halo width
+ *        from the neighboring subdomains, first, so that an interaction dynamics given this exchange
+ *        by setHaloUpdateOverlap computes them while the halo update is in flight.
+ */
+class DistributedParticleExchange : public LocalDynamics, public BaseDynamics<void>, public HaloUpdateOverlap
+{
+    struct ParticleBytes
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, size_t &bytes);
+    };
+
+    struct PackParticles
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        const IndexVector &particles, StdVec<char> &buffer);
+    };
+
+    struct UnpackParticles
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        size_t first_index, size_t number_of_particles, const char *&data);
+    };
+
+    struct SwapParticles
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        const IndexVector &particles, const IndexVector &other_particles);
+    };
+
+  public:
+    DistributedParticleExchange(RealBody &real_body, DistributedDomain &distributed_domain);
+    virtual ~DistributedParticleExchange() {};
+    /** keeps only the real particles in the local domain, e.g. when each rank generates the whole body
+     *  or has read the restart files of other ranks, the halo is rebuilt by the next exec */
+    void distributeInitialParticles();
+    virtual void exec(Real dt = 0.0) override;
+    /** migrates in bulk after the slab cuts are moved, particles may pass several ranks */
+    void redistributeParticles();
+    void updateHalo();
+    virtual void startHaloUpdate() override;
+    virtual void finishHaloUpdate() override;
+    virtual IndexRange InteriorRange() override { return IndexRange(0, total_interior_particles_); };
+    virtual IndexRange OwnedRange() override { return IndexRange(0, total_owned_particles_); };
+    virtual IndexRange HaloRange() override;
+    virtual IndexRange BoundaryRange() override;
+    virtual void restrictLoopRange(const IndexRange &loop_range) override { sph_body_.restrictLoopRange(loop_range); };
+    virtual void releaseLoopRange() override { sph_body_.releaseLoopRange(); };
+    Vecd *ParticlePositions() { return dv_pos_->DataField(); };
+    Real HaloWidth() { return halo_width_; };
+    UnsignedInt TotalOwnedParticles() { return total_owned_particles_; };
+    UnsignedInt TotalHaloParticles() { return halo_from_lower_ + halo_from_upper_; };
+    size_t TotalOwnedParticlesOfAllRanks() { return domain_.allReduceSum(total_owned_particles_); };
+
+  protected:
+    DistributedDomain &domain_;
+    Real halo_width_;
+    DiscreteVariable<Vecd> *dv_pos_;
+    UnsignedInt total_owned_particles_;
+    UnsignedInt total_interior_particles_;
+    UnsignedInt halo_from_lower_;
+    UnsignedInt halo_from_upper_;
+    IndexVector lower_halo_;
+    IndexVector upper_halo_;
+    StdVec<char> send_to_lower_, send_to_upper_;
+    StdVec<char> receive_from_lower_, receive_from_upper_;
+    StdVec<MPI_Request> halo_requests_;
+    OperationOnDataAssemble<ParticleVariables, ParticleBytes> particle_bytes_;
+    OperationOnDataAssemble<ParticleVariables, PackParticles> pack_particles_;
+    OperationOnDataAssemble<ParticleVariables, UnpackParticles> unpack_particles_;
+    OperationOnDataAssemble<ParticleVariables, SwapParticles> swap_particles_;
+
+    size_t ParticleBytesOfVariables();
+    void packParticles(const IndexVector &particles, StdVec<char> &buffer);
+    void unpackParticles(const StdVec<char> &buffer, size_t first_index, size_t number_of_particles);
+    /** removes the given owned particles, by moving the last owned particles into their places */
+    void removeOwnedParticles(IndexVector &particles);
+    /** appends the received particles behind the real particles and returns their number */
+    UnsignedInt appendParticles(const StdVec<char> &buffer);
+    void removeHaloParticles();
+    /** returns the number of particles sent to the neighbors */
+    size_t migrateParticles();
+    /** moves the owned particles within the halo width from the neighboring subdomains behind the interior ones */
+    void orderInteriorParticlesFirst(Real lower_halo_bound, Real upper_halo_bound);
+    void buildHalo();
+};
+
+/**
+ * @class GlobalReduceDynamicsCK
+ * @brief The reduced value of the local particles, including the halo, is reduced over all ranks.
+ *        As halo particles are also owned by another rank, only maximum and minimum are supported,
+ *        e.g. for the time-step sizes.
+ */
+template <class ExecutionPolicy, class ReduceType>
+class GlobalReduceDynamicsCK : public ReduceDynamicsCK<ExecutionPolicy, ReduceType>
+{
+    using ReturnType = typename ReduceType::ReturnType;
+
+  public:
+    template <class DynamicsIdentifier, typename... Args>
+    GlobalReduceDynamicsCK(DynamicsIdentifier &identifier, DistributedDomain &distributed_domain, Args &&...args)
+        : ReduceDynamicsCK<ExecutionPolicy, ReduceType>(identifier, std::forward<Args>(args)...),
+          domain_(distributed_domain){};
+    virtual ~GlobalReduceDynamicsCK() {};
+
+    virtual ReturnType exec(Real dt = 0.0) override
+    {
+        ReturnType local_result = ReduceDynamicsCK<ExecutionPolicy, ReduceType>::exec(dt);
+        return domain_.allReduce(local_result, this->getOperation());
+    };
+
+  protected:
+    DistributedDomain &domain_;
+};
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
+#endif // DISTRIBUTED_DYNAMICS_CK_H
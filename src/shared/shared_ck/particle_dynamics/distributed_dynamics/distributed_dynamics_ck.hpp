@@ -0,0 +1,68 @@
+#ifndef DISTRIBUTED_DYNAMICS_CK_HPP
+#define DISTRIBUTED_DYNAMICS_CK_HPP
+
+#include "distributed_dynamics_ck.h"
+
+#include <cstring>
+#include <utility>
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+//=================================================================================================//
+template <typename DataType>
+void DistributedParticleExchange::ParticleBytes::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables, size_t &bytes)
+{
+    bytes += variables.size() * sizeof(DataType);
+}
+//=================================================================================================//
+template <typename DataType>
+void DistributedParticleExchange::PackParticles::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           const IndexVector &particles, StdVec<char> &buffer)
+{
+    for (DiscreteVariable<DataType> *variable : variables)
+    {
+        DataType *data_field = variable->DataField();
+        size_t offset = buffer.size();
+        buffer.resize(offset + particles.size() * sizeof(DataType));
+        for (size_t k = 0; k != particles.size(); ++k)
+        {
+            std::memcpy(buffer.data() + offset + k * sizeof(DataType),
+                        &data_field[particles[k]], sizeof(DataType));
+        }
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void DistributedParticleExchange::UnpackParticles::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           size_t first_index, size_t number_of_particles, const char *&data)
+{
+    for (DiscreteVariable<DataType> *variable : variables)
+    {
+        std::memcpy(reinterpret_cast<char *>(variable->DataField() + first_index), data,
+                    number_of_particles * sizeof(DataType));
+        data += number_of_particles * sizeof(DataType);
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void DistributedParticleExchange::SwapParticles::
+operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+           const IndexVector &particles, const IndexVector &other_particles)
+{
+    for (DiscreteVariable<DataType> *variable : variables)
+    {
+        DataType *data_field = variable->DataField();
+        for (size_t k = 0; k != particles.size(); ++k)
+        {
+            std::swap(data_field[particles[k]], data_field[other_particles[k]]);
+        }
+    }
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
+#endif // DISTRIBUTED_DYNAMICS_CK_HPP
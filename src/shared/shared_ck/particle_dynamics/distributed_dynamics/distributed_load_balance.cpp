@@ -0,0 +1,132 @@
+#include "distributed_load_balance.h"
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+//=================================================================================================//
+DistributedLoadBalance::
+    DistributedLoadBalance(SPHSystem &sph_system, DistributedDomain &distributed_domain,
+                           StdVec<DistributedParticleExchange *> particle_exchanges,
+                           Real imbalance_tolerance, size_t number_of_bins)
+    : dynamics_profiler_(sph_system.getDynamicsProfiler()), domain_(distributed_domain),
+      particle_exchanges_(particle_exchanges), imbalance_tolerance_(imbalance_tolerance),
+      number_of_bins_(number_of_bins), imbalance_(1.0),
+      last_profiled_time_(dynamics_profiler_.TotalTime()), min_slab_width_(0.0)
+{
+    for (DistributedParticleExchange *particle_exchange : particle_exchanges_)
+    {
+        min_slab_width_ = SMAX(min_slab_width_, particle_exchange->HaloWidth());
+    }
+}
+//=================================================================================================//
+bool DistributedLoadBalance::exec()
+{
+    Real local_cost = measureLocalCost();
+    ReduceMax reduce_max;
+    Real max_cost = domain_.allReduce(local_cost, reduce_max);
+    Real mean_cost = domain_.allReduceSum(local_cost) / Real(domain_.NumberOfRanks());
+    imbalance_ = mean_cost > 0.0 ? max_cost / mean_cost : 1.0;
+    if (imbalance_ <= imbalance_tolerance_)
+    {
+        return false;
+    }
+
+    size_t owned_particles = TotalOwnedParticles();
+    Real cost_per_particle = owned_particles == 0 ? 0.0 : local_cost / Real(owned_particles);
+    domain_.resetSlabCuts(balancedSlabCuts(costHistogram(cost_per_particle)));
+    for (DistributedParticleExchange *particle_exchange : particle_exchanges_)
+    {
+        particle_exchange->redistributeParticles();
+    }
+    return true;
+}
+//=================================================================================================//
+size_t DistributedLoadBalance::TotalOwnedParticles()
+{
+    size_t owned_particles = 0;
+    for (DistributedParticleExchange *particle_exchange : particle_exchanges_)
+    {
+        owned_particles += particle_exchange->TotalOwnedParticles();
+    }
+    return owned_particles;
+}
+//=================================================================================================//
+Real DistributedLoadBalance::measureLocalCost()
+{
+    if (dynamics_profiler_.isEnabled())
+    {
+        Real profiled_time = dynamics_profiler_.TotalTime();
+        Real cost = profiled_time - last_profiled_time_;
+        last_profiled_time_ = profiled_time;
+        if (cost > 0.0)
+        {
+            return cost;
+        }
+    }
+    return Real(TotalOwnedParticles());
+}
+//=================================================================================================//
+StdVec<Real> DistributedLoadBalance::costHistogram(Real cost_per_particle)
+{
+    StdVec<Real> &slab_cuts = domain_.SlabCuts();
+    int axis = domain_.DecompositionAxis();
+    Real lower_bound = slab_cuts.front();
+    Real bin_width = (slab_cuts.back() - lower_bound) / Real(number_of_bins_);
+
+    StdVec<Real> cost_histogram(number_of_bins_, 0.0);
+    for (DistributedParticleExchange *particle_exchange : particle_exchanges_)
+    {
+        Vecd *pos = particle_exchange->ParticlePositions();
+        for (size_t i = 0; i != particle_exchange->TotalOwnedParticles(); ++i)
+        {
+            int bin = int(std::floor((pos[i][axis] - lower_bound) / bin_width));
+            cost_histogram[SMIN(SMAX(bin, 0), int(number_of_bins_) - 1)] += cost_per_particle;
+        }
+    }
+    domain_.allReduceSum(cost_histogram);
+    return cost_histogram;
+}
+//=================================================================================================//
+StdVec<Real> DistributedLoadBalance::balancedSlabCuts(const StdVec<Real> &cost_histogram)
+{
+    StdVec<Real> slab_cuts = domain_.SlabCuts();
+    int number_of_ranks = domain_.NumberOfRanks();
+    Real lower_bound = slab_cuts.front();
+    Real bin_width = (slab_cuts.back() - lower_bound) / Real(number_of_bins_);
+
+    Real total_cost = 0.0;
+    for (Real bin_cost : cost_histogram)
+        total_cost += bin_cost;
+    if (total_cost <= 0.0)
+    {
+        return slab_cuts;
+    }
+
+    Real accumulated_cost = 0.0;
+    size_t bin = 0;
+    for (int k = 1; k != number_of_ranks; ++k)
+    {
+        Real target_cost = total_cost * Real(k) / Real(number_of_ranks);
+        while (bin != number_of_bins_ - 1 && accumulated_cost + cost_histogram[bin] < target_cost)
+        {
+            accumulated_cost += cost_histogram[bin];
+            bin++;
+        }
+        Real fraction = cost_histogram[bin] > 0.0 ? (target_cost - accumulated_cost) / cost_histogram[bin] : 0.0;
+        slab_cuts[k] = lower_bound + (Real(bin) + SMIN(fraction, Real(1))) * bin_width;
+    }
+
+    // the halo from the neighboring slabs is valid only for slabs not thinner than it
+    for (int k = 1; k != number_of_ranks; ++k)
+    {
+        slab_cuts[k] = SMAX(slab_cuts[k], slab_cuts[k - 1] + min_slab_width_);
+    }
+    for (int k = number_of_ranks - 1; k != 0; --k)
+    {
+        slab_cuts[k] = SMIN(slab_cuts[k], slab_cuts[k + 1] - min_slab_width_);
+    }
+    return slab_cuts;
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
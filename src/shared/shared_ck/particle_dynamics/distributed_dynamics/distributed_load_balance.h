@@ -0,0 +1,77 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    distributed_load_balance.h
+ * @brief   Rebalancing of the slab decomposition by the measured cost of the ranks.
+ * @details The cost of a rank is the wall time in the dynamics profiler since the last balancing,
+ *          or the number of owned particles when profiling is not enabled.
+ *          As the domain is decomposed into slabs, the recursive coordinate bisection
+ *          reduces to cutting the cost histogram along the decomposition axis into equal parts.
+ *          Available when built with SPHINXSYS_USE_MPI.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef DISTRIBUTED_LOAD_BALANCE_H
+#define DISTRIBUTED_LOAD_BALANCE_H
+
+#include "distributed_dynamics_ck.h"
+
+#if SPHINXSYS_USE_MPI
+namespace SPH
+{
+/**
+ * @class DistributedLoadBalance
+ * @brief Moves the slab cuts when the cost imbalance, i.e. the maximum over the mean cost of the ranks,
+ *        exceeds the tolerance, and then migrates the particles of all the given bodies in bulk.
+ *        To be called periodically, e.g. every few hundred steps, in place of the particle exchanges.
+ */
+class DistributedLoadBalance
+{
+  public:
+    DistributedLoadBalance(SPHSystem &sph_system, DistributedDomain &distributed_domain,
+                           StdVec<DistributedParticleExchange *> particle_exchanges,
+                           Real imbalance_tolerance = 1.1, size_t number_of_bins = 1024);
+    virtual ~DistributedLoadBalance() {};
+    /** returns true if the slabs are rebalanced */
+    bool exec();
+    Real Imbalance() { return imbalance_; };
+
+  protected:
+    DynamicsProfiler &dynamics_profiler_;
+    DistributedDomain &domain_;
+    StdVec<DistributedParticleExchange *> particle_exchanges_;
+    Real imbalance_tolerance_;
+    size_t number_of_bins_;
+    Real imbalance_;
+    Real last_profiled_time_;
+    Real min_slab_width_;
+
+    size_t TotalOwnedParticles();
+    Real measureLocalCost();
+    /** the cost of all ranks distributed along the decomposition axis */
+    StdVec<Real> costHistogram(Real cost_per_particle);
+    StdVec<Real> balancedSlabCuts(const StdVec<Real> &cost_histogram);
+};
+} // namespace SPH
+#endif // SPHINXSYS_USE_MPI
+#endif // DISTRIBUTED_LOAD_BALANCE_H
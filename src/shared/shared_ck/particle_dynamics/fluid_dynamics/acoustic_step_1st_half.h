@@ -69,6 +69,7 @@ class AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionTyp
   public:
     explicit AcousticStep1stHalf(Relation<Inner<Parameters...>> &inner_relation);
     virtual ~AcousticStep1stHalf(){};
+    virtual void setupDynamics(Real dt = 0.0) override;
 
     class InitializeKernel
     {
@@ -83,7 +84,7 @@ class AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionTyp
         Vecd *vel_, *dpos_;
     };
 
-    class InteractKernel : public BaseInteraction::InteractKernel
+    class InteractKernel : public BaseInteraction::InteractKernel, public PairGeometryCache
     {
       public:
         template <class ExecutionPolicy, class EncloserType>
@@ -62,6 +62,16 @@ AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Par
 }
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType, typename... Parameters>
+void AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
+    setupDynamics(Real dt)
+{
+    if (this->inner_relation_.isPairGeometryCached())
+    {
+        this->inner_relation_.stampPairGeometry();
+    }
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType, typename... Parameters>
 template <class ExecutionPolicy, class EncloserType>
 AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
     InitializeKernel::InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
@@ -86,6 +96,8 @@ template <class ExecutionPolicy, class EncloserType>
 AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
     InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
     : BaseInteraction::InteractKernel(ex_policy, encloser),
+      PairGeometryCache(ex_policy, encloser.inner_relation_.getPairKernelGradient(),
+                        encloser.inner_relation_.getPairUnitVector()),
       correction_(ex_policy, encloser.kernel_correction_),
       riemann_solver_(encloser.riemann_solver_),
       Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
@@ -103,8 +115,11 @@ void AcousticStep1stHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType
     for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
     {
         UnsignedInt index_j = this->neighbor_index_[n];
-        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
+        Real dW_ij = this->dW_ij(index_i, index_j);
         Vecd e_ij = this->e_ij(index_i, index_j);
+        if (this->isPairGeometryCached())
+            this->cachePairGeometry(n, dW_ij, e_ij);
+        Real dW_ijV_j = dW_ij * Vol_[index_j];
 
         force -= (p_[index_i] * correction_(index_j) + p_[index_j] * correction_(index_i)) * dW_ijV_j * e_ij;
         rho_dissipation += riemann_solver_.DissipativeUJump(p_[index_i] - p_[index_j]) * dW_ijV_j;
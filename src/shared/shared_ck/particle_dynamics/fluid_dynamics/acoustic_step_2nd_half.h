@@ -31,6 +31,7 @@
 #define ACOUSTIC_STEP_2ND_HALF_H
 
 #include "acoustic_step_1st_half.h"
+#include "state_sentinel.h"
 
 namespace SPH
 {
@@ -50,6 +51,7 @@ class AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionTyp
   public:
     explicit AcousticStep2ndHalf(Relation<Inner<Parameters...>> &inner_relation);
     virtual ~AcousticStep2ndHalf(){};
+    virtual void setupDynamics(Real dt = 0.0) override;
 
     class InitializeKernel
     {
@@ -62,7 +64,7 @@ class AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionTyp
         Vecd *vel_, *dpos_;
     };
 
-    class InteractKernel : public BaseInteraction::InteractKernel
+    class InteractKernel : public BaseInteraction::InteractKernel, public PairGeometryCache
     {
       public:
         template <class ExecutionPolicy, class EncloserType>
@@ -85,6 +87,8 @@ class AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionTyp
 
       protected:
         Real *rho_, *drho_dt_;
+        Vecd *vel_;
+        StateSentinelCheck state_sentinel_;
     };
 
   protected:
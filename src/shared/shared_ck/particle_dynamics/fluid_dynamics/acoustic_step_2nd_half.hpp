@@ -19,6 +19,21 @@ AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Par
 }
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType, typename... Parameters>
+void AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
+    setupDynamics(Real dt)
+{
+#ifndef NDEBUG
+    if (this->inner_relation_.isPairGeometryCached() && !this->inner_relation_.isPairGeometryCurrent())
+    {
+        std::cout << "\n Error: the cached pair geometry of " << this->sph_body_.getName()
+                  << " is not written by the 1st half step after the last relation update!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+#endif
+}
+//=================================================================================================//
+template <class RiemannSolverType, class KernelCorrectionType, typename... Parameters>
 template <class ExecutionPolicy, class EncloserType>
 AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
     InitializeKernel::InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
@@ -37,6 +52,8 @@ template <class ExecutionPolicy, class EncloserType>
 AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
     InteractKernel::InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
     : BaseInteraction::InteractKernel(ex_policy, encloser),
+      PairGeometryCache(ex_policy, encloser.inner_relation_.getPairKernelGradient(),
+                        encloser.inner_relation_.getPairUnitVector()),
       correction_(ex_policy, encloser.kernel_correction_),
       riemann_solver_(encloser.riemann_solver_),
       Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
@@ -54,8 +71,11 @@ void AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType
     for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
     {
         UnsignedInt index_j = this->neighbor_index_[n];
-        Real dW_ijV_j = this->dW_ij(index_i, index_j) * Vol_[index_j];
-        Vecd corrected_e_ij = correction_(index_i) * this->e_ij(index_i, index_j);
+        // positions are unchanged since the 1st half step, whose pair geometry is reused if cached
+        Real dW_ij = this->isPairGeometryCached() ? this->pair_dW_ij_[n] : this->dW_ij(index_i, index_j);
+        Vecd e_ij = this->isPairGeometryCached() ? this->pair_e_ij_[n] : this->e_ij(index_i, index_j);
+        Real dW_ijV_j = dW_ij * Vol_[index_j];
+        Vecd corrected_e_ij = correction_(index_i) * e_ij;
 
         Real u_jump = (vel_[index_i] - vel_[index_j]).dot(corrected_e_ij);
         density_change_rate += u_jump * dW_ijV_j;
@@ -70,13 +90,16 @@ template <class ExecutionPolicy, class EncloserType>
 AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
     UpdateKernel::UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
     : rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
-      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)) {}
+      drho_dt_(encloser.dv_drho_dt_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      state_sentinel_(ex_policy, encloser.particles_) {}
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType, typename... Parameters>
 void AcousticStep2ndHalf<Inner<OneLevel, RiemannSolverType, KernelCorrectionType, Parameters...>>::
     UpdateKernel::update(size_t index_i, Real dt)
 {
     rho_[index_i] += drho_dt_[index_i] * dt * 0.5;
+    state_sentinel_.check(vel_[index_i]);
 }
 //=================================================================================================//
 template <class RiemannSolverType, class KernelCorrectionType, typename... Parameters>
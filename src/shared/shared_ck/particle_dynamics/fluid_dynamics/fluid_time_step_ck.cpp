@@ -24,6 +24,15 @@ Real AcousticTimeStepCK::outputResult(Real reduced_value)
     return acousticCFL_ * h_min_ / (reduced_value + TinyReal);
 }
 //=================================================================================================//
+AcousticTimeStepLevelCK::
+    AcousticTimeStepLevelCK(BlockTimeStepping &block_time_stepping, Real acousticCFL)
+    : LocalDynamics(block_time_stepping.getSPHBody()),
+      acoustic_time_step_(block_time_stepping.getSPHBody(), acousticCFL),
+      acousticCFL_(acousticCFL),
+      h_min_(sph_body_.sph_adaptation_->MinimumSmoothingLength()),
+      max_level_(block_time_stepping.MaxLevel()),
+      dv_level_estimate_(block_time_stepping.dvTimeStepLevelEstimate()) {}
+//=================================================================================================//
 AdvectionTimeStepCK::
     AdvectionTimeStepCK(SPHBody &sph_body, Real U_ref, Real advectionCFL)
     : LocalDynamicsReduce<ReduceMax>(sph_body),
@@ -48,6 +57,31 @@ AdvectionViscousTimeStepCK::AdvectionViscousTimeStepCK(SPHBody &sph_body, Real U
     speed_ref_ = SMAX(viscous_speed, speed_ref_);
 }
 //=================================================================================================//
+AdvectionAcousticTimeStepCK::AdvectionAcousticTimeStepCK(
+    SPHBody &sph_body, Real U_ref, Real advectionCFL, Real acousticCFL)
+    : LocalDynamicsReduce<ReduceComponentwiseMax<Vec2d>>(sph_body),
+      fluid_(DynamicCast<WeaklyCompressibleFluid>(this, particles_->getBaseMaterial())),
+      dv_rho_(particles_->getVariableByName<Real>("Density")),
+      dv_p_(particles_->getVariableByName<Real>("Pressure")),
+      dv_mass_(particles_->getVariableByName<Real>("Mass")),
+      dv_vel_(particles_->getVariableByName<Vecd>("Velocity")),
+      dv_force_(particles_->getVariableByName<Vecd>("Force")),
+      dv_force_prior_(particles_->getVariableByName<Vecd>("ForcePrior")),
+      h_min_(sph_body.sph_adaptation_->MinimumSmoothingLength()),
+      speed_ref_(U_ref), advectionCFL_(advectionCFL), acousticCFL_(acousticCFL)
+{
+    Real viscous_speed = fluid_.ReferenceViscosity() / fluid_.ReferenceDensity() / h_min_;
+    speed_ref_ = SMAX(viscous_speed, speed_ref_);
+    quantity_name_ = "AdvectionAcousticTimeStep";
+}
+//=================================================================================================//
+Vec2d AdvectionAcousticTimeStepCK::outputResult(Vec2d reduced_value)
+{
+    Real speed_max = sqrt(reduced_value[0]);
+    return Vec2d(advectionCFL_ * h_min_ / (SMAX(speed_max, speed_ref_) + TinyReal),
+                 acousticCFL_ * h_min_ / (reduced_value[1] + TinyReal));
+}
+//=================================================================================================//
 AdvectionStepSetup::AdvectionStepSetup(SPHBody &sph_body)
     : LocalDynamics(sph_body),
       dv_Vol_(particles_->getVariableByName<Real>("VolumetricMeasure")),
@@ -33,6 +33,8 @@
 #define FLUID_TIME_STEP_CK_H
 
 #include "base_fluid_dynamics.h"
+#include "block_time_stepping_ck.h"
+#include "cell_relative_position_ck.h"
 #include "weakly_compressible_fluid.h"
 
 namespace SPH
@@ -76,6 +78,47 @@ class AcousticTimeStepCK : public LocalDynamicsReduce<ReduceMax>
     Real acousticCFL_;
 };
 
+/**
+ * @class AcousticTimeStepLevelCK
+ * @brief Estimating the time-step levels of block time stepping from the local acoustic time-step sizes.
+ * A particle takes the highest level whose step size, as power-of-two multiple of the finest one,
+ * i.e. the global acoustic time-step size, does not exceed its own acoustic time-step size.
+ */
+class AcousticTimeStepLevelCK : public LocalDynamics
+{
+  public:
+    explicit AcousticTimeStepLevelCK(BlockTimeStepping &block_time_stepping, Real acousticCFL = 0.6);
+    virtual ~AcousticTimeStepLevelCK(){};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy, AcousticTimeStepLevelCK &encloser);
+
+        void update(size_t index_i, Real dt)
+        {
+            Real local_dt = acousticCFL_ * h_min_ / (signal_speed_.reduce(index_i) + TinyReal);
+            UnsignedInt level = 0;
+            while (level < max_level_ && dt * Real(UnsignedInt(1) << (level + 1)) <= local_dt)
+                ++level;
+            level_estimate_[index_i] = level;
+        };
+
+      protected:
+        AcousticTimeStepCK::ReduceKernel signal_speed_;
+        Real acousticCFL_, h_min_;
+        UnsignedInt max_level_;
+        UnsignedInt *level_estimate_;
+    };
+
+  protected:
+    AcousticTimeStepCK acoustic_time_step_;
+    Real acousticCFL_, h_min_;
+    UnsignedInt max_level_;
+    DiscreteVariable<UnsignedInt> *dv_level_estimate_;
+};
+
 class AdvectionTimeStepCK
     : public LocalDynamicsReduce<ReduceMax>
 {
@@ -142,6 +185,53 @@ class AdvectionViscousTimeStepCK : public AdvectionTimeStepCK
     };
 };
 
+/**
+ * @class AdvectionAcousticTimeStepCK
+ * @brief Computing the advection (with viscous limit) and acoustic time-step sizes in a single pass,
+ *        which reads velocity and forces once for both criteria.
+ *        The result is the pair (advection, acoustic) time-step sizes,
+ *        e.g. the acoustic one is used for the first acoustic sub-step of the advection step.
+ */
+class AdvectionAcousticTimeStepCK : public LocalDynamicsReduce<ReduceComponentwiseMax<Vec2d>>
+{
+    using EosKernel = typename WeaklyCompressibleFluid::EosKernel;
+
+  public:
+    AdvectionAcousticTimeStepCK(SPHBody &sph_body, Real U_ref,
+                                Real advectionCFL = 0.25, Real acousticCFL = 0.6);
+    virtual ~AdvectionAcousticTimeStepCK(){};
+    virtual Vec2d outputResult(Vec2d reduced_value) override;
+
+    class ReduceKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ReduceKernel(const ExecutionPolicy &ex_policy, AdvectionAcousticTimeStepCK &encloser);
+
+        Vec2d reduce(size_t index_i, Real dt = 0.0)
+        {
+            Real acceleration_scale = 4.0 * h_min_ *
+                                      (force_[index_i] + force_prior_[index_i]).norm() / mass_[index_i];
+            Real speed = vel_[index_i].norm();
+            return Vec2d(SMAX(speed * speed, acceleration_scale),
+                         SMAX(eos_.getSoundSpeed(p_[index_i], rho_[index_i]) + speed, acceleration_scale));
+        };
+
+      protected:
+        EosKernel eos_;
+        Real *rho_, *p_, *mass_;
+        Vecd *vel_, *force_, *force_prior_;
+        Real h_min_;
+    };
+
+  protected:
+    WeaklyCompressibleFluid &fluid_;
+    DiscreteVariable<Real> *dv_rho_, *dv_p_, *dv_mass_;
+    DiscreteVariable<Vecd> *dv_vel_, *dv_force_, *dv_force_prior_;
+    Real h_min_;
+    Real speed_ref_, advectionCFL_, acousticCFL_;
+};
+
 class AdvectionStepSetup : public LocalDynamics
 {
   public:
@@ -184,11 +274,21 @@ class AdvectionStepClose : public LocalDynamics
 
         void update(size_t index_i, Real dt = 0.0)
         {
-            pos_[index_i] += dpos_[index_i];
+            if (cell_ != nullptr)
+            {
+                frame_.shift(cell_[index_i], offset_[index_i], dpos_[index_i]);
+                pos_[index_i] = frame_.decode(cell_[index_i], offset_[index_i]);
+            }
+            else
+            {
+                pos_[index_i] += dpos_[index_i];
+            }
         };
 
       protected:
         Vecd *pos_, *dpos_;
+        CellRelativePosition frame_;
+        Vecd *cell_, *offset_; /**< null if the positions are not encoded */
     };
 
   protected:
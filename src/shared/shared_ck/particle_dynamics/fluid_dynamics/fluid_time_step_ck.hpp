@@ -21,6 +21,26 @@ AcousticTimeStepCK::ReduceKernel::ReduceKernel(
       h_min_(encloser.h_min_) {}
 //=================================================================================================//
 template <class ExecutionPolicy>
+AcousticTimeStepLevelCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, AcousticTimeStepLevelCK &encloser)
+    : signal_speed_(ex_policy, encloser.acoustic_time_step_),
+      acousticCFL_(encloser.acousticCFL_), h_min_(encloser.h_min_),
+      max_level_(encloser.max_level_),
+      level_estimate_(encloser.dv_level_estimate_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+AdvectionAcousticTimeStepCK::ReduceKernel::ReduceKernel(
+    const ExecutionPolicy &ex_policy, AdvectionAcousticTimeStepCK &encloser)
+    : eos_(encloser.fluid_),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      p_(encloser.dv_p_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedDataField(ex_policy)),
+      h_min_(encloser.h_min_) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
 AdvectionStepSetup::UpdateKernel::
     UpdateKernel(const ExecutionPolicy &ex_policy, AdvectionStepSetup &encloser)
     : Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
@@ -32,7 +52,17 @@ template <class ExecutionPolicy>
 AdvectionStepClose::UpdateKernel::
     UpdateKernel(const ExecutionPolicy &ex_policy, AdvectionStepClose &encloser)
     : pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
-      dpos_(encloser.dv_dpos_->DelegatedDataField(ex_policy)) {}
+      dpos_(encloser.dv_dpos_->DelegatedDataField(ex_policy)),
+      cell_(nullptr), offset_(nullptr)
+{
+    CellRelativePositionVariables cell_relative_position(encloser.particles_);
+    if (cell_relative_position.isEncoded())
+    {
+        frame_ = cell_relative_position.Frame();
+        cell_ = cell_relative_position.getCell()->DelegatedDataField(ex_policy);
+        offset_ = cell_relative_position.getOffset()->DelegatedDataField(ex_policy);
+    }
+}
 //=================================================================================================//
 } // namespace fluid_dynamics
 } // namespace SPH
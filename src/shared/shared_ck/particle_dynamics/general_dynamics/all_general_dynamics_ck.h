@@ -29,8 +29,12 @@
 
 #pragma once
 
+#include "cell_relative_position_ck.hpp"
+#include "domain_bounding_ck.hpp"
 #include "force_prior_ck.hpp"
 #include "general_reduce_ck.hpp"
 #include "geometric_dynamics.hpp"
 #include "interpolation_dynamics.hpp"
 #include "kernel_correction_ck.hpp"
+#include "particle_buffer_ck.hpp"
+#include "time_step_level_limit_ck.hpp"
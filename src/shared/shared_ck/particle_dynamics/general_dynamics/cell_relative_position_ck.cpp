@@ -0,0 +1,48 @@
+#include "cell_relative_position_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+CellRelativePositionVariables::CellRelativePositionVariables(BaseParticles *particles)
+    : dv_cell_(findVariableByName<Vecd>(particles->AllDiscreteVariables(), "PositionCell")),
+      dv_offset_(findVariableByName<Vecd>(particles->AllDiscreteVariables(), "PositionOffset"))
+{
+    SingularVariable<Vecd> *sv_origin =
+        findVariableByName<Vecd>(particles->AllSingularVariables(), "PositionCellOrigin");
+    SingularVariable<Real> *sv_cell_size =
+        findVariableByName<Real>(particles->AllSingularVariables(), "PositionCellSize");
+    if (dv_cell_ != nullptr && dv_offset_ != nullptr && sv_origin != nullptr && sv_cell_size != nullptr)
+    {
+        frame_ = CellRelativePosition(sv_origin->getValue(), sv_cell_size->getValue());
+    }
+    else
+    {
+        dv_cell_ = nullptr;
+        dv_offset_ = nullptr;
+    }
+}
+//=================================================================================================//
+bool CellRelativePositionVariables::isEncodedAlike(CellRelativePositionVariables &other)
+{
+    return isEncoded() && other.isEncoded() && frame_.isSameFrame(other.frame_);
+}
+//=================================================================================================//
+EncodeCellRelativePositionCK::EncodeCellRelativePositionCK(SPHBody &sph_body)
+    : EncodeCellRelativePositionCK(
+          sph_body, CellRelativePosition(sph_body.getSPHSystem().system_domain_bounds_.first_,
+                                         sph_body.getSPHSystem().resolution_ref_)) {}
+//=================================================================================================//
+EncodeCellRelativePositionCK::
+    EncodeCellRelativePositionCK(SPHBody &sph_body, const CellRelativePosition &frame)
+    : LocalDynamics(sph_body), frame_(frame),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      dv_cell_(particles_->registerStateVariableOnly<Vecd>("PositionCell")),
+      dv_offset_(particles_->registerStateVariableOnly<Vecd>("PositionOffset"))
+{
+    particles_->registerSingularVariable<Vecd>("PositionCellOrigin")->setValue(frame_.Origin());
+    particles_->registerSingularVariable<Real>("PositionCellSize")->setValue(frame_.CellSize());
+    particles_->addVariableToSort<Vecd>("PositionCell");
+    particles_->addVariableToSort<Vecd>("PositionOffset");
+}
+//=================================================================================================//
+} // namespace SPH
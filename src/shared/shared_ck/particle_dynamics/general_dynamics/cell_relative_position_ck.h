@@ -0,0 +1,106 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    cell_relative_position_ck.h
+ * @brief   Particle positions also kept relative to the cells of a frame shared by all bodies,
+ *          see CellRelativePosition, for exact pair displacements in large single-precision domains.
+ * @details The interactions opt in by the CellRelative relation parameter,
+ *          e.g. Relation<Inner<CellRelative>>, see Neighbor<CellRelative, KernelType>,
+ *          and the other interactions use the absolute positions without any extra cost.
+ *          The fluid advection and the periodic condition update the cell-relative positions
+ *          together with the absolute positions. The positions changed by other dynamics
+ *          are encoded again by the cell linked list update, which is found by comparing
+ *          the absolute positions with those decoded from the cell-relative positions.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef CELL_RELATIVE_POSITION_CK_H
+#define CELL_RELATIVE_POSITION_CK_H
+
+#include "base_general_dynamics.h"
+
+namespace SPH
+{
+/**
+ * @class CellRelativePositionVariables
+ * @brief The cell-relative position variables of a body, looked up when constructing a computing kernel.
+ *        The variables are null if the body is not encoded.
+ */
+class CellRelativePositionVariables
+{
+  public:
+    explicit CellRelativePositionVariables(BaseParticles *particles);
+    bool isEncoded() { return dv_cell_ != nullptr; };
+    bool isEncodedAlike(CellRelativePositionVariables &other);
+    CellRelativePosition Frame() { return frame_; };
+    DiscreteVariable<Vecd> *getCell() { return dv_cell_; };
+    DiscreteVariable<Vecd> *getOffset() { return dv_offset_; };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_cell_, *dv_offset_;
+    CellRelativePosition frame_;
+};
+
+/** sets the cell-relative positions to a neighbor with CellRelative parameter, nothing for other neighbors,
+ * the source and target bodies are required to be encoded in the same frame */
+template <class ExecutionPolicy, class NeighborType>
+void useCellRelativePosition(const ExecutionPolicy &ex_policy, NeighborType &neighbor,
+                             BaseParticles *source_particles, BaseParticles *target_particles);
+
+/**
+ * @class EncodeCellRelativePositionCK
+ * @brief Encodes the particle positions, to be executed after the positions are set,
+ *        e.g. after particle relaxation or reloading, and before the first interaction.
+ *        By default, the frame starts at the lower bound of the system domain
+ *        with the reference resolution of the system as cell size, so that all bodies share it.
+ *        The cell-relative variables are sorted with the particles.
+ *        The absolute positions are decoded from the encoding, so that both agree exactly.
+ */
+class EncodeCellRelativePositionCK : public LocalDynamics
+{
+  public:
+    explicit EncodeCellRelativePositionCK(SPHBody &sph_body);
+    EncodeCellRelativePositionCK(SPHBody &sph_body, const CellRelativePosition &frame);
+    virtual ~EncodeCellRelativePositionCK(){};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncodeCellRelativePositionCK &encloser);
+        void update(size_t index_i, Real dt = 0.0)
+        {
+            frame_.encodeAndDecode(pos_[index_i], cell_[index_i], offset_[index_i]);
+        };
+
+      protected:
+        CellRelativePosition frame_;
+        Vecd *pos_, *cell_, *offset_;
+    };
+
+  protected:
+    CellRelativePosition frame_;
+    DiscreteVariable<Vecd> *dv_pos_, *dv_cell_, *dv_offset_;
+};
+} // namespace SPH
+#endif // CELL_RELATIVE_POSITION_CK_H
@@ -0,0 +1,46 @@
+#ifndef CELL_RELATIVE_POSITION_CK_HPP
+#define CELL_RELATIVE_POSITION_CK_HPP
+
+#include "cell_relative_position_ck.h"
+
+#include "neighborhood_ck.h"
+
+#include <type_traits>
+
+namespace SPH
+{
+//=================================================================================================//
+template <class ExecutionPolicy, class NeighborType>
+void useCellRelativePosition(const ExecutionPolicy &ex_policy, NeighborType &neighbor,
+                             BaseParticles *source_particles, BaseParticles *target_particles)
+{
+    if constexpr (std::is_base_of_v<CellRelativeDisplacement, NeighborType>)
+    {
+        CellRelativePositionVariables source(source_particles);
+        CellRelativePositionVariables target(target_particles);
+        if (!source.isEncodedAlike(target))
+        {
+            std::cout << "\n Error: the particles of " << source_particles->getSPHBody().getName()
+                      << " and " << target_particles->getSPHBody().getName()
+                      << " are not encoded in the same cell-relative frame!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        neighbor.setCellRelativePosition(source.Frame(),
+                                         source.getCell()->DelegatedDataField(ex_policy),
+                                         source.getOffset()->DelegatedDataField(ex_policy),
+                                         target.getCell()->DelegatedDataField(ex_policy),
+                                         target.getOffset()->DelegatedDataField(ex_policy));
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+EncodeCellRelativePositionCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncodeCellRelativePositionCK &encloser)
+    : frame_(encloser.frame_),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      cell_(encloser.dv_cell_->DelegatedDataField(ex_policy)),
+      offset_(encloser.dv_offset_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+} // namespace SPH
+#endif // CELL_RELATIVE_POSITION_CK_HPP
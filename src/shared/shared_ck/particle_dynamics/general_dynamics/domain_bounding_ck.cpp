@@ -0,0 +1,15 @@
+#include "domain_bounding_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+PeriodicConditionCK::PeriodicConditionCK(RealBody &real_body, PeriodicAlongAxis &periodic_box)
+    : LocalDynamics(real_body), bounding_bounds_(periodic_box.getBoundingBox()),
+      axis_(periodic_box.getAxis()),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position"))
+{
+    CellLinkedList &cell_linked_list = DynamicCast<CellLinkedList>(this, real_body.getCellLinkedList());
+    cell_linked_list.setPeriodicAxis(bounding_bounds_, axis_);
+}
+//=================================================================================================//
+} // namespace SPH
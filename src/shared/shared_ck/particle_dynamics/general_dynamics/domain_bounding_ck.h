@@ -0,0 +1,90 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    domain_bounding_ck.h
+ * @brief   Periodic boundary condition for the computing kernels.
+ * @details The periodic condition is ghost free: the particles are bounded into the periodic box
+ *          and the neighbor search of the cell linked list searches the periodic images,
+ *          so that CK relations and interaction kernels see the neighbors across the periodic bounds.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef DOMAIN_BOUNDING_CK_H
+#define DOMAIN_BOUNDING_CK_H
+
+#include "base_general_dynamics.h"
+#include "cell_relative_position_ck.h"
+#include "domain_bounding.h"
+
+namespace SPH
+{
+/**
+ * @class PeriodicConditionCK
+ * @brief Periodic bounding of particle positions in an axis direction.
+ * It sets the periodicity of the cell linked list at construction
+ * and should be executed before updating the cell linked list, as
+ * StateDynamics<ExecutionPolicy, PeriodicConditionCK> periodic_condition(real_body, periodic_box);
+ * Several axes are periodic by several conditions.
+ */
+class PeriodicConditionCK : public LocalDynamics
+{
+  public:
+    PeriodicConditionCK(RealBody &real_body, PeriodicAlongAxis &periodic_box);
+    virtual ~PeriodicConditionCK(){};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy, PeriodicConditionCK &encloser);
+        void update(size_t index_i, Real dt = 0.0)
+        {
+            Real translation = 0.0;
+            if (pos_[index_i][axis_] < lower_bound_)
+                translation = periodic_translation_;
+            else if (pos_[index_i][axis_] > upper_bound_)
+                translation = -periodic_translation_;
+
+            if (translation != 0.0)
+            {
+                pos_[index_i][axis_] += translation;
+                if (cell_ != nullptr)
+                    frame_.encodeAndDecode(pos_[index_i], cell_[index_i], offset_[index_i]);
+            }
+        };
+
+      protected:
+        int axis_;
+        Real lower_bound_, upper_bound_, periodic_translation_;
+        Vecd *pos_;
+        CellRelativePosition frame_;
+        Vecd *cell_, *offset_; /**< null if the positions are not encoded */
+    };
+
+  protected:
+    BoundingBox bounding_bounds_;
+    const int axis_;
+    DiscreteVariable<Vecd> *dv_pos_;
+};
+} // namespace SPH
+#endif // DOMAIN_BOUNDING_CK_H
@@ -0,0 +1,29 @@
+#ifndef DOMAIN_BOUNDING_CK_HPP
+#define DOMAIN_BOUNDING_CK_HPP
+
+#include "domain_bounding_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class ExecutionPolicy>
+PeriodicConditionCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, PeriodicConditionCK &encloser)
+    : axis_(encloser.axis_),
+      lower_bound_(encloser.bounding_bounds_.first_[axis_]),
+      upper_bound_(encloser.bounding_bounds_.second_[axis_]),
+      periodic_translation_(upper_bound_ - lower_bound_),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      cell_(nullptr), offset_(nullptr)
+{
+    CellRelativePositionVariables cell_relative_position(encloser.particles_);
+    if (cell_relative_position.isEncoded())
+    {
+        frame_ = cell_relative_position.Frame();
+        cell_ = cell_relative_position.getCell()->DelegatedDataField(ex_policy);
+        offset_ = cell_relative_position.getOffset()->DelegatedDataField(ex_policy);
+    }
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // DOMAIN_BOUNDING_CK_HPP
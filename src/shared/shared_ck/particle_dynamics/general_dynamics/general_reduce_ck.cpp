@@ -18,4 +18,11 @@ TotalMechanicalEnergyCK::TotalMechanicalEnergyCK(SPHBody &sph_body, Gravity &gra
     quantity_name_ = "TotalMechanicalEnergy";
 }
 //=================================================================================================//
+MaximumTimeStepLevelCK::MaximumTimeStepLevelCK(SPHBody &sph_body)
+    : LocalDynamicsReduce<ReduceMax>(sph_body),
+      dv_level_(particles_->getVariableByName<UnsignedInt>("TimeStepLevel"))
+{
+    quantity_name_ = "MaximumTimeStepLevel";
+}
+//=================================================================================================//
 } // namespace SPH
@@ -116,5 +116,30 @@ class TotalMechanicalEnergyCK : public TotalKineticEnergyCK
     DiscreteVariable<Vecd> *dv_pos_;
 };
 
+/**
+ * @class MaximumTimeStepLevelCK
+ * @brief The coarsest time-step level of block time stepping in use,
+ * which gives the number of the finest sub-steps in a block.
+ */
+class MaximumTimeStepLevelCK : public LocalDynamicsReduce<ReduceMax>
+{
+  public:
+    explicit MaximumTimeStepLevelCK(SPHBody &sph_body);
+    virtual ~MaximumTimeStepLevelCK(){};
+
+    class ReduceKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        Real reduce(size_t index_i, Real dt = 0.0) { return Real(level_[index_i]); };
+
+      protected:
+        UnsignedInt *level_;
+    };
+
+  protected:
+    DiscreteVariable<UnsignedInt> *dv_level_;
+};
 } // namespace SPH
 #endif // GENERAL_REDUCE_CK_H
@@ -31,5 +31,10 @@ TotalMechanicalEnergyCK::ReduceKernel::
       gravity_(encloser.gravity_),
       pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)) {}
 //=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+MaximumTimeStepLevelCK::ReduceKernel::
+    ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : level_(encloser.dv_level_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
 } // namespace SPH
 #endif // GENERAL_REDUCE_CK_HPP
@@ -75,5 +75,68 @@ class ObservingAQuantityCK : public InteractionDynamicsCK<ExecutionPolicy, Inter
         : InteractionDynamicsCK<ExecutionPolicy, Interpolation<Contact<DataType>>>(pair_contact_relation, variable_name){};
     virtual ~ObservingAQuantityCK(){};
 };
+
+template <typename...>
+class QuantitiesInterpolation;
+/**
+ * @class QuantitiesInterpolation
+ * @brief Interpolating several variables together,
+ * so that the weights of a pair of particles are evaluated only once for all variables.
+ */
+template <typename... DataTypes>
+class QuantitiesInterpolation<Contact<DataTypes...>> : public Interaction<Contact<>>
+{
+  public:
+    using VariableNames = std::array<std::string, sizeof...(DataTypes)>;
+
+    QuantitiesInterpolation(Relation<Contact<>> &pair_contact_relation, const VariableNames &variable_names);
+    virtual ~QuantitiesInterpolation(){};
+
+    class InteractKernel : public Interaction<Contact<>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        std::tuple<DataTypes *...> interpolated_quantities_;
+        Real *contact_Vol_;
+        std::tuple<DataTypes *...> contact_data_;
+
+        template <size_t... Is>
+        void accumulate(std::tuple<DataTypes...> &quantities, Real weight_j, UnsignedInt index_j, std::index_sequence<Is...>);
+        template <size_t... Is>
+        void assign(const std::tuple<DataTypes...> &quantities, Real ttl_weight, size_t index_i, std::index_sequence<Is...>);
+    };
+
+  protected:
+    std::tuple<DiscreteVariable<DataTypes> *...> dv_interpolated_quantities_;
+    StdVec<DiscreteVariable<Real> *> dv_contact_Vol_;
+    StdVec<std::tuple<DiscreteVariable<DataTypes> *...>> dv_contact_data_;
+
+    template <size_t... Is>
+    static std::tuple<DiscreteVariable<DataTypes> *...> registerVariables(
+        BaseParticles &particles, const VariableNames &variable_names, std::index_sequence<Is...>);
+    template <size_t... Is>
+    static std::tuple<DiscreteVariable<DataTypes> *...> getVariables(
+        BaseParticles &particles, const VariableNames &variable_names, std::index_sequence<Is...>);
+    template <class ExecutionPolicy>
+    static std::tuple<DataTypes *...> delegatedDataFields(
+        const ExecutionPolicy &ex_policy, const std::tuple<DiscreteVariable<DataTypes> *...> &variables);
+};
+
+template <class ExecutionPolicy, typename... DataTypes>
+class ObservingQuantitiesCK : public InteractionDynamicsCK<ExecutionPolicy, QuantitiesInterpolation<Contact<DataTypes...>>>
+{
+  public:
+    using VariableNames = typename QuantitiesInterpolation<Contact<DataTypes...>>::VariableNames;
+    using ObservationExecutionPolicy = ExecutionPolicy;
+
+    explicit ObservingQuantitiesCK(Relation<Contact<>> &pair_contact_relation, const VariableNames &variable_names)
+        : InteractionDynamicsCK<ExecutionPolicy, QuantitiesInterpolation<Contact<DataTypes...>>>(
+              pair_contact_relation, variable_names){};
+    virtual ~ObservingQuantitiesCK(){};
+};
 } // namespace SPH
 #endif // INTERPOLATION_DYNAMICS_H
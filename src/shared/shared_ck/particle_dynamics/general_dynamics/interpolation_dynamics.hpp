@@ -48,5 +48,89 @@ void Interpolation<Contact<DataType>>::InteractKernel::interact(size_t index_i,
     interpolated_quantities_[index_i] = interpolated_quantity / (ttl_weight + TinyReal);
 }
 //=================================================================================================//
+template <typename... DataTypes>
+QuantitiesInterpolation<Contact<DataTypes...>>::
+    QuantitiesInterpolation(Relation<Contact<>> &pair_contact_relation, const VariableNames &variable_names)
+    : Interaction<Contact<>>(pair_contact_relation),
+      dv_interpolated_quantities_(registerVariables(*this->particles_, variable_names, std::index_sequence_for<DataTypes...>{}))
+{
+    if (this->contact_particles_.size() > 1)
+    {
+        std::cout << "\n Error: QuantitiesInterpolation only works for single contact body!" << std::endl;
+        exit(1);
+    }
+    // must be single contact body
+    dv_contact_Vol_.push_back(this->contact_particles_[0]->template getVariableByName<Real>("VolumetricMeasure"));
+    dv_contact_data_.push_back(getVariables(*this->contact_particles_[0], variable_names, std::index_sequence_for<DataTypes...>{}));
+}
+//=================================================================================================//
+template <typename... DataTypes>
+template <size_t... Is>
+std::tuple<DiscreteVariable<DataTypes> *...> QuantitiesInterpolation<Contact<DataTypes...>>::
+    registerVariables(BaseParticles &particles, const VariableNames &variable_names, std::index_sequence<Is...>)
+{
+    return std::make_tuple(particles.template registerStateVariableOnly<DataTypes>(variable_names[Is])...);
+}
+//=================================================================================================//
+template <typename... DataTypes>
+template <size_t... Is>
+std::tuple<DiscreteVariable<DataTypes> *...> QuantitiesInterpolation<Contact<DataTypes...>>::
+    getVariables(BaseParticles &particles, const VariableNames &variable_names, std::index_sequence<Is...>)
+{
+    return std::make_tuple(particles.template getVariableByName<DataTypes>(variable_names[Is])...);
+}
+//=================================================================================================//
+template <typename... DataTypes>
+template <class ExecutionPolicy>
+std::tuple<DataTypes *...> QuantitiesInterpolation<Contact<DataTypes...>>::
+    delegatedDataFields(const ExecutionPolicy &ex_policy, const std::tuple<DiscreteVariable<DataTypes> *...> &variables)
+{
+    return std::apply([&](auto *...variable)
+                      { return std::make_tuple(variable->DelegatedDataField(ex_policy)...); },
+                      variables);
+}
+//=================================================================================================//
+template <typename... DataTypes>
+template <class ExecutionPolicy, class EncloserType>
+QuantitiesInterpolation<Contact<DataTypes...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser, UnsignedInt contact_index)
+    : Interaction<Contact<>>::InteractKernel(ex_policy, encloser, contact_index),
+      interpolated_quantities_(delegatedDataFields(ex_policy, encloser.dv_interpolated_quantities_)),
+      contact_Vol_(encloser.dv_contact_Vol_[contact_index]->DelegatedDataField(ex_policy)),
+      contact_data_(delegatedDataFields(ex_policy, encloser.dv_contact_data_[contact_index])) {}
+//=================================================================================================//
+template <typename... DataTypes>
+void QuantitiesInterpolation<Contact<DataTypes...>>::InteractKernel::interact(size_t index_i, Real dt)
+{
+    std::tuple<DataTypes...> interpolated_quantities(ZeroData<DataTypes>::value...);
+    Real ttl_weight(0);
+
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real weight_j = this->W_ij(index_i, index_j) * contact_Vol_[index_j];
+
+        accumulate(interpolated_quantities, weight_j, index_j, std::index_sequence_for<DataTypes...>{});
+        ttl_weight += weight_j;
+    }
+    assign(interpolated_quantities, ttl_weight + TinyReal, index_i, std::index_sequence_for<DataTypes...>{});
+}
+//=================================================================================================//
+template <typename... DataTypes>
+template <size_t... Is>
+void QuantitiesInterpolation<Contact<DataTypes...>>::InteractKernel::
+    accumulate(std::tuple<DataTypes...> &quantities, Real weight_j, UnsignedInt index_j, std::index_sequence<Is...>)
+{
+    ((std::get<Is>(quantities) += weight_j * std::get<Is>(contact_data_)[index_j]), ...);
+}
+//=================================================================================================//
+template <typename... DataTypes>
+template <size_t... Is>
+void QuantitiesInterpolation<Contact<DataTypes...>>::InteractKernel::
+    assign(const std::tuple<DataTypes...> &quantities, Real ttl_weight, size_t index_i, std::index_sequence<Is...>)
+{
+    ((std::get<Is>(interpolated_quantities_)[index_i] = std::get<Is>(quantities) / ttl_weight), ...);
+}
+//=================================================================================================//
 } // namespace SPH
 #endif // INTERPOLATION_DYNAMICS_HPP
@@ -32,6 +32,7 @@
 #define KERNEL_CORRECTION_CK_H
 
 #include "base_general_dynamics.h"
+#include "small_matrix_inverse.h"
 
 namespace SPH
 {
@@ -60,11 +61,13 @@ class LinearCorrectionMatrix<Base, RelationType<Parameters...>>
       protected:
         Real *Vol_;
         Matd *B_;
+        UnsignedInt *update_due_;
     };
 
   protected:
     DiscreteVariable<Real> *dv_Vol_;
     DiscreteVariable<Matd> *dv_B_;
+    SingularVariable<UnsignedInt> *sv_update_due_;
 };
 
 template <typename... Parameters>
@@ -74,11 +77,15 @@ class LinearCorrectionMatrix<Inner<WithUpdate, Parameters...>>
 
   public:
     explicit LinearCorrectionMatrix(Relation<Inner<Parameters...>> &inner_relation, Real alpha = Real(0))
-        : LinearCorrectionMatrix<Base, Inner<Parameters...>>(inner_relation), alpha_(alpha){};
+        : LinearCorrectionMatrix<Base, Inner<Parameters...>>(inner_relation), alpha_(alpha),
+          configuration_version_at_last_update_(std::numeric_limits<UnsignedInt>::max()){};
     template <typename BodyRelationType, typename FirstArg>
     explicit LinearCorrectionMatrix(ConstructorArgs<BodyRelationType, FirstArg> parameters)
         : LinearCorrectionMatrix(parameters.body_relation_, std::get<0>(parameters.others_)){};
     virtual ~LinearCorrectionMatrix(){};
+    /** the matrix is only computed again after a configuration of the body has been updated,
+     *  the decision is shared with the contact parts of a complex correction */
+    virtual void setupDynamics(Real dt = 0.0) override;
 
     class InteractKernel
         : public LinearCorrectionMatrix<Base, Inner<Parameters...>>::InteractKernel
@@ -105,6 +112,7 @@ class LinearCorrectionMatrix<Inner<WithUpdate, Parameters...>>
 
   protected:
     Real alpha_;
+    UnsignedInt configuration_version_at_last_update_;
 };
 using LinearCorrectionMatrixInner = LinearCorrectionMatrix<Inner<WithUpdate>>;
 
@@ -13,7 +13,9 @@ LinearCorrectionMatrix<Base, RelationType<Parameters...>>::
     : Interaction<RelationType<Parameters...>>(identifier),
       dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
       dv_B_(this->particles_->template registerStateVariableOnly<Matd>(
-          "LinearCorrectionMatrix", IdentityMatrix<Matd>::value)) {}
+          "LinearCorrectionMatrix", IdentityMatrix<Matd>::value)),
+      sv_update_due_(this->particles_->template registerSingularVariable<UnsignedInt>(
+          "LinearCorrectionMatrixUpdateDue", 1)) {}
 //=================================================================================================//
 template <template <typename...> class RelationType, typename... Parameters>
 template <class ExecutionPolicy, typename... Args>
@@ -24,7 +26,8 @@ LinearCorrectionMatrix<Base, RelationType<Parameters...>>::InteractKernel::
     : Interaction<RelationType<Parameters...>>::
           InteractKernel(ex_policy, encloser, std::forward<Args>(args)...),
       Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
-      B_(encloser.dv_B_->DelegatedDataField(ex_policy)) {}
+      B_(encloser.dv_B_->DelegatedDataField(ex_policy)),
+      update_due_(encloser.sv_update_due_->DelegatedData(ex_policy)) {}
 //=================================================================================================//
 template <typename... Parameters>
 template <class ExecutionPolicy>
@@ -34,9 +37,20 @@ LinearCorrectionMatrix<Inner<WithUpdate, Parameters...>>::InteractKernel::
     : LinearCorrectionMatrix<Base, Inner<Parameters...>>::InteractKernel(ex_policy, encloser) {}
 //=================================================================================================//
 template <typename... Parameters>
+void LinearCorrectionMatrix<Inner<WithUpdate, Parameters...>>::setupDynamics(Real dt)
+{
+    UnsignedInt configuration_version = this->sph_body_.ConfigurationVersion();
+    this->sv_update_due_->setValue(configuration_version != configuration_version_at_last_update_);
+    configuration_version_at_last_update_ = configuration_version;
+}
+//=================================================================================================//
+template <typename... Parameters>
 void LinearCorrectionMatrix<Inner<WithUpdate, Parameters...>>::
     InteractKernel::interact(size_t index_i, Real dt)
 {
+    if (!*this->update_due_)
+        return;
+
     Matd local_configuration = Matd::Zero();
     for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
     {
@@ -59,12 +73,10 @@ template <typename... Parameters>
 void LinearCorrectionMatrix<Inner<WithUpdate, Parameters...>>::
     UpdateKernel::update(size_t index_i, Real dt)
 {
-    Real determinant = this->B_[index_i].determinant();
-    Real det_sqr = SMAX(alpha_ - determinant, Real(0));
-    Matd B_T = this->B_[index_i].transpose(); // for Tikhonov regularization
-    Matd inverse = (B_T * this->B_[index_i] + SqrtEps * Matd::Identity()).inverse() * B_T;
-    Real weight = determinant / (determinant + det_sqr);
-    this->B_[index_i] = weight * inverse + (1.0 - weight) * Matd::Identity();
+    if (!*this->update_due_)
+        return;
+
+    this->B_[index_i] = regularizedCorrectionMatrix(this->B_[index_i], alpha_);
 }
 //=================================================================================================//
 template <typename... Parameters>
@@ -92,6 +104,9 @@ template <typename... Parameters>
 void LinearCorrectionMatrix<Contact<Parameters...>>::
     InteractKernel::interact(size_t index_i, Real dt)
 {
+    if (!*this->update_due_)
+        return;
+
     Matd local_configuration = Matd::Zero();
     for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
     {
@@ -0,0 +1,228 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    particle_buffer_ck.h
+ * @brief   Buffer particle management for the computing kernels,
+ *          i.e. inflow injection and outflow deletion of particles.
+ * @details The particles to be created or deleted are flagged by computing kernels
+ *          and ranked by an exclusive scan of the flags, so that the particle states
+ *          are moved by device kernels without atomics or host-side index lists.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef PARTICLE_BUFFER_CK_H
+#define PARTICLE_BUFFER_CK_H
+
+#include "base_general_dynamics.h"
+#include "complex_shape.h"
+#include "particle_reserve.h"
+#include "weakly_compressible_fluid.h"
+
+namespace SPH
+{
+/**
+ * @class AlignedBoxBoundCK
+ * @brief The bound checks of an aligned box shape which can be copied into computing kernels.
+ */
+class AlignedBoxBoundCK
+{
+  public:
+    explicit AlignedBoxBoundCK(AlignedBoxShape &aligned_box)
+        : transform_(aligned_box.getTransform()), halfsize_(aligned_box.HalfSize()),
+          alignment_axis_(aligned_box.AlignmentAxis()){};
+
+    bool checkUpperBound(const Vecd &probe_point)
+    {
+        Vecd position_in_frame = transform_.shiftBaseStationToFrame(probe_point);
+        return position_in_frame[alignment_axis_] > halfsize_[alignment_axis_];
+    };
+
+    /** within the box in the directions other than the alignment axis */
+    bool checkInLateralBounds(const Vecd &probe_point)
+    {
+        Vecd position_in_frame = transform_.shiftBaseStationToFrame(probe_point);
+        for (int axis = 0; axis != Dimensions; ++axis)
+        {
+            if (axis != alignment_axis_ && ABS(position_in_frame[axis]) > halfsize_[axis])
+                return false;
+        }
+        return true;
+    };
+
+    Vecd getUpperPeriodic(const Vecd &probe_point)
+    {
+        Vecd position_in_frame = transform_.shiftBaseStationToFrame(probe_point);
+        position_in_frame[alignment_axis_] -= 2.0 * halfsize_[alignment_axis_];
+        return transform_.shiftFrameStationToBase(position_in_frame);
+    };
+
+  protected:
+    Transform transform_;
+    Vecd halfsize_;
+    int alignment_axis_;
+};
+
+/**
+ * @class ParticleBufferUpdateCK
+ * @brief Scan-based batched creation and deletion of real particles.
+ * Creation copies the flagged real particles to the buffer particles after the real ones.
+ * Deletion fills the flagged particles below the remaining bound with the kept ones above it,
+ * as BaseParticles::switchToBufferParticles does on the host.
+ * Both keep the particle order deterministic. The copied states are the variables to sort,
+ * which are the ones the CK pipeline keeps following the particles.
+ */
+template <class ExecutionPolicy>
+class ParticleBufferUpdateCK
+{
+    struct CopyParticleStateCK
+    {
+        template <typename DataType>
+        void operator()(DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+                        const ExecutionPolicy &ex_policy, UnsignedInt number_of_copies,
+                        UnsignedInt *source, UnsignedInt *destination);
+    };
+
+  public:
+    explicit ParticleBufferUpdateCK(BaseParticles &particles);
+    ~ParticleBufferUpdateCK(){};
+    /** the flags to be set for all real particles before creation or deletion */
+    DiscreteVariable<UnsignedInt> *dvFlag() { return dv_flag_; };
+    /** realize buffer particles as copies of the flagged real particles,
+     *  the number of new particles, which start from the former total real particles, is returned */
+    UnsignedInt createRealParticles(ParticleBuffer<Base> &buffer);
+    /** switch the flagged real particles to buffer particles and return their number */
+    UnsignedInt switchToBufferParticles();
+
+  protected:
+    ExecutionPolicy ex_policy_;
+    BaseParticles &particles_;
+    DiscreteVariable<UnsignedInt> *dv_flag_;
+    DiscreteVariable<UnsignedInt> *dv_original_id_;
+    DiscreteVariable<UnsignedInt> *dv_sorted_id_;
+    OperationOnDataAssemble<ParticleVariables, CopyParticleStateCK> copy_particle_state_;
+};
+
+/**
+ * @class EmitterInflowInjectionCK
+ * @brief Inject particles into the computational domain, as EmitterInflowInjection.
+ * The emitter particles are tagged at construction as those in the aligned box.
+ * A tagged particle passing the upper bound is copied to a new real particle,
+ * and itself is moved back by the box length and reset to the reference density.
+ */
+template <class ExecutionPolicy>
+class EmitterInflowInjectionCK : public LocalDynamics, public BaseDynamics<void>
+{
+    using EosKernel = typename WeaklyCompressibleFluid::EosKernel;
+
+  public:
+    EmitterInflowInjectionCK(RealBody &real_body, AlignedBoxShape &aligned_box, ParticleBuffer<Base> &buffer);
+    virtual ~EmitterInflowInjectionCK(){};
+
+    class ComputingKernel
+    {
+      public:
+        ComputingKernel(const ExecutionPolicy &ex_policy,
+                        EmitterInflowInjectionCK<ExecutionPolicy> &encloser);
+        void flagPassingParticle(UnsignedInt index_i)
+        {
+            flag_[index_i] = emitter_tag_[index_i] != 0 && aligned_box_.checkUpperBound(pos_[index_i]) ? 1 : 0;
+        };
+        void updateEmitterParticle(UnsignedInt index_i)
+        {
+            if (flag_[index_i] != 0)
+            {
+                pos_[index_i] = aligned_box_.getUpperPeriodic(pos_[index_i]);
+                rho_[index_i] = rho0_;
+                p_[index_i] = eos_.getPressure(rho0_);
+            }
+        };
+        void updateNewParticle(UnsignedInt index_i) { emitter_tag_[index_i] = 0; };
+
+      protected:
+        AlignedBoxBoundCK aligned_box_;
+        EosKernel eos_;
+        Real rho0_;
+        UnsignedInt *flag_;
+        int *emitter_tag_;
+        Vecd *pos_;
+        Real *rho_, *p_;
+    };
+
+    virtual void exec(Real dt = 0.0) override;
+    typedef EmitterInflowInjectionCK<ExecutionPolicy> LocalDynamicsType;
+
+  protected:
+    ExecutionPolicy ex_policy_;
+    AlignedBoxShape &aligned_box_;
+    ParticleBuffer<Base> &buffer_;
+    WeaklyCompressibleFluid &fluid_;
+    ParticleBufferUpdateCK<ExecutionPolicy> buffer_update_;
+    DiscreteVariable<int> *dv_emitter_tag_;
+    DiscreteVariable<Vecd> *dv_pos_;
+    DiscreteVariable<Real> *dv_rho_, *dv_p_;
+    Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernel> kernel_implementation_;
+};
+
+/**
+ * @class DisposerOutflowDeletionCK
+ * @brief Delete particles leaving the computational domain through
+ * the upper bound of the aligned box, as DisposerOutflowDeletion.
+ */
+template <class ExecutionPolicy>
+class DisposerOutflowDeletionCK : public LocalDynamics, public BaseDynamics<void>
+{
+  public:
+    DisposerOutflowDeletionCK(RealBody &real_body, AlignedBoxShape &aligned_box);
+    virtual ~DisposerOutflowDeletionCK(){};
+
+    class ComputingKernel
+    {
+      public:
+        ComputingKernel(const ExecutionPolicy &ex_policy,
+                        DisposerOutflowDeletionCK<ExecutionPolicy> &encloser);
+        void flagLeavingParticle(UnsignedInt index_i)
+        {
+            flag_[index_i] = aligned_box_.checkUpperBound(pos_[index_i]) &&
+                                     aligned_box_.checkInLateralBounds(pos_[index_i])
+                                 ? 1
+                                 : 0;
+        };
+
+      protected:
+        AlignedBoxBoundCK aligned_box_;
+        UnsignedInt *flag_;
+        Vecd *pos_;
+    };
+
+    virtual void exec(Real dt = 0.0) override;
+    typedef DisposerOutflowDeletionCK<ExecutionPolicy> LocalDynamicsType;
+
+  protected:
+    ExecutionPolicy ex_policy_;
+    AlignedBoxShape &aligned_box_;
+    ParticleBufferUpdateCK<ExecutionPolicy> buffer_update_;
+    DiscreteVariable<Vecd> *dv_pos_;
+    Implementation<ExecutionPolicy, LocalDynamicsType, ComputingKernel> kernel_implementation_;
+};
+} // namespace SPH
+#endif // PARTICLE_BUFFER_CK_H
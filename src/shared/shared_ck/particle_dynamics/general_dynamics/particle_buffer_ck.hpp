@@ -0,0 +1,227 @@
+#ifndef PARTICLE_BUFFER_CK_HPP
+#define PARTICLE_BUFFER_CK_HPP
+
+#include "particle_buffer_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <class ExecutionPolicy>
+template <typename DataType>
+void ParticleBufferUpdateCK<ExecutionPolicy>::CopyParticleStateCK::operator()(
+    DataContainerAddressKeeper<DiscreteVariable<DataType>> &variables,
+    const ExecutionPolicy &ex_policy, UnsignedInt number_of_copies,
+    UnsignedInt *source, UnsignedInt *destination)
+{
+    for (size_t l = 0; l != variables.size(); ++l)
+    {
+        DataType *data_field = variables[l]->DelegatedDataField(ex_policy);
+        particle_for(ex_policy, IndexRange(0, number_of_copies),
+                     [=](size_t k)
+                     { data_field[destination[k]] = data_field[source[k]]; });
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+ParticleBufferUpdateCK<ExecutionPolicy>::ParticleBufferUpdateCK(BaseParticles &particles)
+    : ex_policy_(ExecutionPolicy{}), particles_(particles),
+      dv_flag_(particles.registerDiscreteVariableOnly<UnsignedInt>(
+          "BufferUpdateFlag", particles.ParticlesBound() + 1)),
+      dv_original_id_(particles.getVariableByName<UnsignedInt>("OriginalID")),
+      dv_sorted_id_(particles.getVariableByName<UnsignedInt>("SortedID")),
+      copy_particle_state_(particles.VariablesToSort()) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+UnsignedInt ParticleBufferUpdateCK<ExecutionPolicy>::createRealParticles(ParticleBuffer<Base> &buffer)
+{
+    UnsignedInt total_real_particles = particles_.TotalRealParticles();
+    ScratchVariablePool &scratch_pool = particles_.getScratchVariablePool();
+    ScopedScratchVariable<UnsignedInt> rank_variable(scratch_pool, particles_.ParticlesBound() + 1);
+    UnsignedInt *flag = dv_flag_->DelegatedDataField(ex_policy_);
+    UnsignedInt *rank = rank_variable->DelegatedDataField(ex_policy_);
+    UnsignedInt number_of_new_particles =
+        exclusive_scan(ex_policy_, flag, rank, total_real_particles + 1, std::plus<UnsignedInt>());
+    if (number_of_new_particles == 0)
+        return 0;
+
+    buffer.checkEnoughBuffer(particles_, number_of_new_particles);
+    ScopedScratchVariable<UnsignedInt> source_variable(scratch_pool, number_of_new_particles);
+    ScopedScratchVariable<UnsignedInt> destination_variable(scratch_pool, number_of_new_particles);
+    UnsignedInt *source = source_variable->DelegatedDataField(ex_policy_);
+    UnsignedInt *destination = destination_variable->DelegatedDataField(ex_policy_);
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 {
+                     if (flag[i] != 0)
+                     {
+                         source[rank[i]] = i;
+                         destination[rank[i]] = total_real_particles + rank[i];
+                     }
+                 });
+
+    copy_particle_state_(ex_policy_, number_of_new_particles, source, destination);
+
+    UnsignedInt *original_id = dv_original_id_->DelegatedDataField(ex_policy_);
+    UnsignedInt *sorted_id = dv_sorted_id_->DelegatedDataField(ex_policy_);
+    particle_for(ex_policy_, IndexRange(0, number_of_new_particles),
+                 [=](size_t k)
+                 {
+                     UnsignedInt new_index = destination[k];
+                     original_id[new_index] = new_index;
+                     sorted_id[new_index] = new_index;
+                 });
+    particles_.incrementTotalRealParticles(number_of_new_particles);
+    return number_of_new_particles;
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+UnsignedInt ParticleBufferUpdateCK<ExecutionPolicy>::switchToBufferParticles()
+{
+    UnsignedInt total_real_particles = particles_.TotalRealParticles();
+    ScratchVariablePool &scratch_pool = particles_.getScratchVariablePool();
+    ScopedScratchVariable<UnsignedInt> rank_variable(scratch_pool, particles_.ParticlesBound() + 1);
+    UnsignedInt *flag = dv_flag_->DelegatedDataField(ex_policy_);
+    UnsignedInt *rank = rank_variable->DelegatedDataField(ex_policy_);
+    UnsignedInt number_of_removed_particles =
+        exclusive_scan(ex_policy_, flag, rank, total_real_particles + 1, std::plus<UnsignedInt>());
+    if (number_of_removed_particles == 0)
+        return 0;
+
+    // the removed particles below the remaining bound are the holes filled by the kept ones above it
+    UnsignedInt remaining_bound = total_real_particles - number_of_removed_particles;
+    UnsignedInt number_of_holes = particle_reduce(
+        ex_policy_, IndexRange(0, remaining_bound), UnsignedInt(0), ReduceSum<UnsignedInt>(),
+        [=](size_t i) -> UnsignedInt
+        { return flag[i]; });
+
+    if (number_of_holes != 0)
+    {
+        ScopedScratchVariable<UnsignedInt> hole_variable(scratch_pool, number_of_holes);
+        ScopedScratchVariable<UnsignedInt> mover_variable(scratch_pool, number_of_holes);
+        ScopedScratchVariable<UnsignedInt> removed_id_variable(scratch_pool, number_of_holes);
+        UnsignedInt *hole = hole_variable->DelegatedDataField(ex_policy_);
+        UnsignedInt *mover = mover_variable->DelegatedDataField(ex_policy_);
+        UnsignedInt *removed_id = removed_id_variable->DelegatedDataField(ex_policy_);
+        particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                     [=](size_t i)
+                     {
+                         if (i < remaining_bound)
+                         {
+                             if (flag[i] != 0)
+                                 hole[rank[i]] = i;
+                         }
+                         else if (flag[i] == 0)
+                         {
+                             // the rank among the kept particles above the remaining bound
+                             mover[i - remaining_bound - (rank[i] - rank[remaining_bound])] = i;
+                         }
+                     });
+
+        UnsignedInt *original_id = dv_original_id_->DelegatedDataField(ex_policy_);
+        UnsignedInt *sorted_id = dv_sorted_id_->DelegatedDataField(ex_policy_);
+        particle_for(ex_policy_, IndexRange(0, number_of_holes),
+                     [=](size_t k)
+                     { removed_id[k] = original_id[hole[k]]; });
+
+        copy_particle_state_(ex_policy_, number_of_holes, mover, hole);
+
+        particle_for(ex_policy_, IndexRange(0, number_of_holes),
+                     [=](size_t k)
+                     {
+                         original_id[hole[k]] = original_id[mover[k]];
+                         original_id[mover[k]] = removed_id[k];
+                         sorted_id[original_id[hole[k]]] = hole[k];
+                         sorted_id[removed_id[k]] = mover[k];
+                     });
+    }
+    particles_.decrementTotalRealParticles(number_of_removed_particles);
+    return number_of_removed_particles;
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+EmitterInflowInjectionCK<ExecutionPolicy>::
+    EmitterInflowInjectionCK(RealBody &real_body, AlignedBoxShape &aligned_box, ParticleBuffer<Base> &buffer)
+    : LocalDynamics(real_body), BaseDynamics<void>(),
+      ex_policy_(ExecutionPolicy{}), aligned_box_(aligned_box), buffer_(buffer),
+      fluid_(DynamicCast<WeaklyCompressibleFluid>(this, particles_->getBaseMaterial())),
+      buffer_update_(*particles_),
+      dv_emitter_tag_(nullptr),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      dv_rho_(particles_->getVariableByName<Real>("Density")),
+      dv_p_(particles_->getVariableByName<Real>("Pressure")),
+      kernel_implementation_(*this)
+{
+    buffer_.checkParticlesReserved();
+    Vecd *pos = dv_pos_->DataField();
+    UnsignedInt total_real_particles = particles_->TotalRealParticles();
+    std::string tag_name = "EmitterTag" + aligned_box.getName();
+    dv_emitter_tag_ = particles_->registerStateVariableOnly<int>(
+        tag_name, [&](size_t i) -> int
+        { return i < total_real_particles && aligned_box_.checkContain(pos[i]) ? 1 : 0; });
+    particles_->addVariableToSort<int>(tag_name);
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+EmitterInflowInjectionCK<ExecutionPolicy>::ComputingKernel::
+    ComputingKernel(const ExecutionPolicy &ex_policy,
+                    EmitterInflowInjectionCK<ExecutionPolicy> &encloser)
+    : aligned_box_(encloser.aligned_box_), eos_(encloser.fluid_),
+      rho0_(encloser.fluid_.ReferenceDensity()),
+      flag_(encloser.buffer_update_.dvFlag()->DelegatedDataField(ex_policy)),
+      emitter_tag_(encloser.dv_emitter_tag_->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      p_(encloser.dv_p_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void EmitterInflowInjectionCK<ExecutionPolicy>::exec(Real dt)
+{
+    UnsignedInt total_real_particles = particles_->TotalRealParticles();
+    ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { computing_kernel->flagPassingParticle(i); });
+
+    UnsignedInt number_of_new_particles = buffer_update_.createRealParticles(buffer_);
+    if (number_of_new_particles == 0)
+        return;
+
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { computing_kernel->updateEmitterParticle(i); });
+    particle_for(ex_policy_, IndexRange(total_real_particles, total_real_particles + number_of_new_particles),
+                 [=](size_t i)
+                 { computing_kernel->updateNewParticle(i); });
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+DisposerOutflowDeletionCK<ExecutionPolicy>::
+    DisposerOutflowDeletionCK(RealBody &real_body, AlignedBoxShape &aligned_box)
+    : LocalDynamics(real_body), BaseDynamics<void>(),
+      ex_policy_(ExecutionPolicy{}), aligned_box_(aligned_box),
+      buffer_update_(*particles_),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      kernel_implementation_(*this) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+DisposerOutflowDeletionCK<ExecutionPolicy>::ComputingKernel::
+    ComputingKernel(const ExecutionPolicy &ex_policy,
+                    DisposerOutflowDeletionCK<ExecutionPolicy> &encloser)
+    : aligned_box_(encloser.aligned_box_),
+      flag_(encloser.buffer_update_.dvFlag()->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class ExecutionPolicy>
+void DisposerOutflowDeletionCK<ExecutionPolicy>::exec(Real dt)
+{
+    UnsignedInt total_real_particles = particles_->TotalRealParticles();
+    ComputingKernel *computing_kernel = kernel_implementation_.getComputingKernel();
+    particle_for(ex_policy_, IndexRange(0, total_real_particles),
+                 [=](size_t i)
+                 { computing_kernel->flagLeavingParticle(i); });
+
+    buffer_update_.switchToBufferParticles();
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // PARTICLE_BUFFER_CK_HPP
@@ -0,0 +1,72 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4                                              *
+ *                                                                           *
+ * Portions copyright (c) 2017-2022 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file time_step_level_limit_ck.h
+ * @brief Limiting the time-step levels of block time stepping
+ * so that the levels of neighboring particles differ by at most one.
+ * @author Xiangyu Hu
+ */
+
+#ifndef TIME_STEP_LEVEL_LIMIT_CK_H
+#define TIME_STEP_LEVEL_LIMIT_CK_H
+
+#include "base_general_dynamics.h"
+#include "interaction_ck.hpp"
+
+namespace SPH
+{
+template <typename... RelationTypes>
+class TimeStepLevelLimitCK;
+
+/**
+ * @class TimeStepLevelLimitCK
+ * @brief The level of a particle is the smaller one of its own estimated level
+ * and the lowest estimated level of its neighbors plus one, so that a particle never
+ * skips the interactions with a fast neighbor for more than one step of that neighbor.
+ */
+template <typename... Parameters>
+class TimeStepLevelLimitCK<Inner<Parameters...>>
+    : public Interaction<Inner<Parameters...>>
+{
+  public:
+    explicit TimeStepLevelLimitCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~TimeStepLevelLimitCK(){};
+
+    class InteractKernel
+        : public Interaction<Inner<Parameters...>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       TimeStepLevelLimitCK<Inner<Parameters...>> &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        UnsignedInt *level_, *level_estimate_;
+    };
+
+  protected:
+    DiscreteVariable<UnsignedInt> *dv_level_, *dv_level_estimate_;
+};
+} // namespace SPH
+#endif // TIME_STEP_LEVEL_LIMIT_CK_H
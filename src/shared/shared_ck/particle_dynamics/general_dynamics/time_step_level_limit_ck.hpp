@@ -0,0 +1,37 @@
+#ifndef TIME_STEP_LEVEL_LIMIT_CK_HPP
+#define TIME_STEP_LEVEL_LIMIT_CK_HPP
+
+#include "time_step_level_limit_ck.h"
+
+namespace SPH
+{
+//=================================================================================================//
+template <typename... Parameters>
+TimeStepLevelLimitCK<Inner<Parameters...>>::
+    TimeStepLevelLimitCK(Relation<Inner<Parameters...>> &inner_relation)
+    : Interaction<Inner<Parameters...>>(inner_relation),
+      dv_level_(this->particles_->template getVariableByName<UnsignedInt>("TimeStepLevel")),
+      dv_level_estimate_(this->particles_->template getVariableByName<UnsignedInt>("TimeStepLevelEstimate")) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy>
+TimeStepLevelLimitCK<Inner<Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy,
+                   TimeStepLevelLimitCK<Inner<Parameters...>> &encloser)
+    : Interaction<Inner<Parameters...>>::InteractKernel(ex_policy, encloser),
+      level_(encloser.dv_level_->DelegatedDataField(ex_policy)),
+      level_estimate_(encloser.dv_level_estimate_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void TimeStepLevelLimitCK<Inner<Parameters...>>::InteractKernel::interact(size_t index_i, Real dt)
+{
+    UnsignedInt level = level_estimate_[index_i];
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        level = SMIN(level, level_estimate_[this->neighbor_index_[n]] + 1);
+    }
+    level_[index_i] = level;
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // TIME_STEP_LEVEL_LIMIT_CK_HPP
@@ -5,6 +5,12 @@ namespace SPH
 //=================================================================================================//
 void InteractionDynamicsCK<Base>::runAllSteps(Real dt)
 {
+    if (halo_update_overlap_ != nullptr)
+    {
+        runAllStepsWithHaloOverlap(dt, false, false);
+        return;
+    }
+
     for (size_t k = 0; k < this->pre_processes_.size(); ++k)
         this->pre_processes_[k]->exec(dt);
 
@@ -14,20 +20,77 @@ void InteractionDynamicsCK<Base>::runAllSteps(Real dt)
         this->post_processes_[k]->exec(dt);
 }
 //=================================================================================================//
+void InteractionDynamicsCK<Base>::runAllStepsWithHaloOverlap(Real dt, bool with_initialization, bool with_update)
+{
+    HaloUpdateOverlap &overlap = *halo_update_overlap_;
+    overlap.startHaloUpdate();
+    if (with_initialization)
+    {
+        overlap.restrictLoopRange(overlap.OwnedRange());
+        runInitializationStep(dt);
+        overlap.releaseLoopRange();
+    }
+
+    for (size_t k = 0; k < this->pre_processes_.size(); ++k)
+        this->pre_processes_[k]->exec(dt);
+
+    overlap.restrictLoopRange(overlap.InteriorRange());
+    runInteractionStep(dt);
+    overlap.releaseLoopRange();
+
+    overlap.finishHaloUpdate();
+    if (with_initialization)
+    {
+        overlap.restrictLoopRange(overlap.HaloRange());
+        runInitializationStep(dt);
+        overlap.releaseLoopRange();
+    }
+
+    overlap.restrictLoopRange(overlap.BoundaryRange());
+    runInteractionStep(dt);
+    overlap.releaseLoopRange();
+
+    for (size_t k = 0; k < this->post_processes_.size(); ++k)
+        this->post_processes_[k]->exec(dt);
+
+    if (with_update)
+    {
+        runUpdateStep(dt);
+    }
+}
+//=================================================================================================//
 void InteractionDynamicsCK<WithUpdate>::runAllSteps(Real dt)
 {
+    if (halo_update_overlap_ != nullptr)
+    {
+        runAllStepsWithHaloOverlap(dt, false, true);
+        return;
+    }
+
     InteractionDynamicsCK<Base>::runAllSteps(dt);
     runUpdateStep(dt);
 }
 //=================================================================================================//
 void InteractionDynamicsCK<WithInitialization>::runAllSteps(Real dt)
 {
+    if (halo_update_overlap_ != nullptr)
+    {
+        runAllStepsWithHaloOverlap(dt, true, false);
+        return;
+    }
+
     runInitializationStep(dt);
     InteractionDynamicsCK<Base>::runAllSteps(dt);
 }
 //=================================================================================================//
 void InteractionDynamicsCK<OneLevel>::runAllSteps(Real dt)
 {
+    if (halo_update_overlap_ != nullptr)
+    {
+        runAllStepsWithHaloOverlap(dt, true, true);
+        return;
+    }
+
     runInitializationStep(dt);
     InteractionDynamicsCK<Base>::runAllSteps(dt);
     runUpdateStep(dt);
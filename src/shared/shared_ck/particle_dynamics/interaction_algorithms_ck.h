@@ -38,23 +38,52 @@ namespace SPH
 template <typename...>
 class InteractionDynamicsCK;
 
+/**
+ * @class HaloUpdateOverlap
+ * @brief The halo update of a decomposed body which is overlapped with the interaction of its interior particles.
+ * The owned particles are ordered with the interior ones, which have no halo particle as neighbor, first,
+ * and the halo particles are behind the owned ones.
+ */
+class HaloUpdateOverlap
+{
+  public:
+    virtual ~HaloUpdateOverlap(){};
+    virtual void startHaloUpdate() = 0;
+    virtual void finishHaloUpdate() = 0;
+    virtual IndexRange InteriorRange() = 0;
+    virtual IndexRange OwnedRange() = 0;
+    virtual IndexRange HaloRange() = 0;
+    /** the owned particles near the subdomain bounds and the halo particles */
+    virtual IndexRange BoundaryRange() = 0;
+    virtual void restrictLoopRange(const IndexRange &loop_range) = 0;
+    virtual void releaseLoopRange() = 0;
+};
+
 template <>
 class InteractionDynamicsCK<Base>
 {
   public:
-    InteractionDynamicsCK(){};
+    InteractionDynamicsCK() : halo_update_overlap_(nullptr){};
     void addPreProcess(BaseDynamics<void> *pre_process) { pre_processes_.push_back(pre_process); };
     void addPostProcess(BaseDynamics<void> *post_process) { post_processes_.push_back(post_process); };
+    /** the halo is then updated within the dynamics, instead of by a separate halo update before */
+    void setHaloUpdateOverlap(HaloUpdateOverlap &halo_update_overlap) { halo_update_overlap_ = &halo_update_overlap; };
 
   protected:
     /** pre process such as update ghost state */
     StdVec<BaseDynamics<void> *> pre_processes_;
     /** post process such as impose constraint */
     StdVec<BaseDynamics<void> *> post_processes_;
+    HaloUpdateOverlap *halo_update_overlap_;
     /** run the interaction step between particles. */
     virtual void runInteractionStep(Real dt) = 0;
+    virtual void runInitializationStep(Real dt){};
+    virtual void runUpdateStep(Real dt){};
     /** run all interactions step. */
     virtual void runAllSteps(Real dt);
+    /** the interior particles are computed while the halo update is in flight,
+     *  the halo particles are initialized and the boundary particles interact after it is finished */
+    void runAllStepsWithHaloOverlap(Real dt, bool with_initialization, bool with_update);
 };
 
 template <>
@@ -3,6 +3,8 @@
 
 #include "interaction_algorithms_ck.h"
 
+#include "block_time_stepping_ck.h"
+
 namespace SPH
 {
 //=================================================================================================//
@@ -18,10 +20,9 @@ void InteractionDynamicsCK<ExecutionPolicy, Base, InteractionType<Inner<Paramete
     runInteraction(Real dt)
 {
     InteractKernel *interact_kernel = kernel_implementation_.getComputingKernel();
-    particle_for(ExecutionPolicy{},
-                 this->identifier_.LoopRange(),
-                 [=](size_t i)
-                 { interact_kernel->interact(i, dt); });
+    particle_for_active(ExecutionPolicy{}, this->identifier_, dt,
+                        [=](size_t i, Real dt_i)
+                        { interact_kernel->interact(i, dt_i); });
 }
 //=================================================================================================//
 template <class ExecutionPolicy, template <typename...> class InteractionType, typename... Parameters>
@@ -47,10 +48,9 @@ void InteractionDynamicsCK<ExecutionPolicy, Base, InteractionType<Contact<Parame
         InteractKernel *interact_kernel =
             contact_kernel_implementation_[k]->getComputingKernel(k);
 
-        particle_for(ExecutionPolicy{},
-                     this->identifier_.LoopRange(),
-                     [=](size_t i)
-                     { interact_kernel->interact(i, dt); });
+        particle_for_active(ExecutionPolicy{}, this->identifier_, dt,
+                            [=](size_t i, Real dt_i)
+                            { interact_kernel->interact(i, dt_i); });
     }
 }
 //=================================================================================================//
@@ -69,6 +69,7 @@ template <class ExecutionPolicy, template <typename...> class InteractionType,
 void InteractionDynamicsCK<ExecutionPolicy, InteractionType<RelationType<Parameters...>>>::
     exec(Real dt)
 {
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
     this->setUpdated(this->identifier_.getSPHBody());
     this->setupDynamics(dt);
     InteractionDynamicsCK<Base>::runAllSteps(dt);
@@ -99,6 +100,7 @@ template <class ExecutionPolicy, template <typename...> class InteractionType,
 void InteractionDynamicsCK<ExecutionPolicy, InteractionType<RelationType<WithUpdate, OtherParameters...>>>::
     exec(Real dt)
 {
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
     this->setUpdated(this->identifier_.getSPHBody());
     this->setupDynamics(dt);
     InteractionDynamicsCK<WithUpdate>::runAllSteps(dt);
@@ -118,10 +120,9 @@ void InteractionDynamicsCK<ExecutionPolicy, InteractionType<RelationType<WithUpd
     runUpdateStep(Real dt)
 {
     UpdateKernel *update_kernel = kernel_implementation_.getComputingKernel();
-    particle_for(ExecutionPolicy{},
-                 this->identifier_.LoopRange(),
-                 [=](size_t i)
-                 { update_kernel->update(i, dt); });
+    particle_for_active(ExecutionPolicy{}, this->identifier_, dt,
+                        [=](size_t i, Real dt_i)
+                        { update_kernel->update(i, dt_i); });
 }
 //=================================================================================================//
 template <class ExecutionPolicy, template <typename...> class InteractionType,
@@ -139,6 +140,7 @@ template <class ExecutionPolicy, template <typename...> class InteractionType,
 void InteractionDynamicsCK<ExecutionPolicy, InteractionType<RelationType<OneLevel, OtherParameters...>>>::
     exec(Real dt)
 {
+    auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
     this->setUpdated(this->identifier_.getSPHBody());
     this->setupDynamics(dt);
     InteractionDynamicsCK<OneLevel>::runAllSteps(dt);
@@ -170,10 +172,9 @@ void InteractionDynamicsCK<ExecutionPolicy, InteractionType<RelationType<OneLeve
     runUpdateStep(Real dt)
 {
     UpdateKernel *update_kernel = update_kernel_implementation_.getComputingKernel();
-    particle_for(ExecutionPolicy{},
-                 this->identifier_.LoopRange(),
-                 [=](size_t i)
-                 { update_kernel->update(i, dt); });
+    particle_for_active(ExecutionPolicy{}, this->identifier_, dt,
+                        [=](size_t i, Real dt_i)
+                        { update_kernel->update(i, dt_i); });
 }
 //=================================================================================================//
 template <class ExecutionPolicy, template <typename...> class InteractionType,
@@ -31,6 +31,7 @@
 #define INTERACTION_CK_H
 
 #include "base_local_dynamics.h"
+#include "cell_relative_position_ck.hpp"
 #include "neighborhood_ck.hpp"
 #include "relation_ck.hpp"
 
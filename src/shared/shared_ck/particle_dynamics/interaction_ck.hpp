@@ -35,7 +35,11 @@ Interaction<Inner<Parameters...>>::InteractKernel::
     InteractKernel(const ExecutionPolicy &ex_policy,
                    Interaction<Inner<Parameters...>> &encloser)
     : NeighborList(ex_policy, encloser.dv_neighbor_index_, encloser.dv_particle_offset_),
-      Neighbor<Parameters...>(ex_policy, encloser.sph_adaptation_, encloser.dv_pos_) {}
+      Neighbor<Parameters...>(ex_policy, encloser.sph_adaptation_, encloser.dv_pos_,
+                              encloser.inner_relation_.getCellLinkedList().getPeriodicImage())
+{
+    useCellRelativePosition(ex_policy, *this, encloser.particles_, encloser.particles_);
+}
 //=================================================================================================//
 template <typename... Parameters>
 Interaction<Contact<Parameters...>>::
@@ -80,7 +84,11 @@ Interaction<Contact<Parameters...>>::InteractKernel::
                    encloser.dv_contact_particle_offset_[contact_index]),
       Neighbor<Parameters...>(ex_policy, encloser.sph_adaptation_,
                               encloser.contact_adaptations_[contact_index],
-                              encloser.dv_pos_, encloser.contact_pos_[contact_index]) {}
+                              encloser.dv_pos_, encloser.contact_pos_[contact_index],
+                              encloser.contact_relation_.getContactCellLinkedList()[contact_index]->getPeriodicImage())
+{
+    useCellRelativePosition(ex_policy, *this, encloser.particles_, encloser.contact_particles_[contact_index]);
+}
 //=================================================================================================//
 template <typename... Parameters>
 Interaction<Contact<Wall, Parameters...>>::
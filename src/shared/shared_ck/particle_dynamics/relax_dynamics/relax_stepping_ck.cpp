@@ -0,0 +1,24 @@
+#include "relax_stepping_ck.hpp"
+
+namespace SPH
+{
+namespace relax_dynamics
+{
+//=================================================================================================//
+RelaxationScalingCK::RelaxationScalingCK(SPHBody &sph_body)
+    : RelaxationScaling(sph_body),
+      dv_residue_(particles_->getVariableByName<Vecd>("ZeroOrderResidue")) {}
+//=================================================================================================//
+PositionRelaxationCK::PositionRelaxationCK(SPHBody &sph_body)
+    : LocalDynamics(sph_body),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      dv_residue_(particles_->getVariableByName<Vecd>("ZeroOrderResidue")) {}
+//=================================================================================================//
+ShapeSurfaceBoundingCK::ShapeSurfaceBoundingCK(SPHBody &sph_body)
+    : LocalDynamics(sph_body),
+      dv_pos_(particles_->getVariableByName<Vecd>("Position")),
+      constrained_distance_(0.5 * sph_body.sph_adaptation_->MinimumSpacing()),
+      level_set_ck_(DynamicCast<LevelSetShape>(this, sph_body.getInitialShape()).getLevelSetCK()) {}
+//=================================================================================================//
+} // namespace relax_dynamics
+} // namespace SPH
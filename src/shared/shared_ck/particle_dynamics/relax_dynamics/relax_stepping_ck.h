@@ -0,0 +1,276 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    relax_stepping_ck.h
+ * @brief   Particle relaxation steps with computing kernels,
+ *          which can be executed with the sequenced, parallel and device policies.
+ * @details The relaxation residue, scaling and position update are the same as
+ *          those of RelaxationStep for a body with a single resolution.
+ *          The level set correction and surface bounding probe the flattened level set,
+ *          i.e. LevelSetCK, of the initial shape of the body.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef RELAX_STEPPING_CK_H
+#define RELAX_STEPPING_CK_H
+
+#include "base_general_dynamics.h"
+#include "interaction_algorithms_ck.h"
+#include "level_set_shape.h"
+#include "relax_stepping.h"
+#include "simple_algorithms_ck.h"
+#include "update_body_relation.h"
+#include "update_cell_linked_list.h"
+
+namespace SPH
+{
+namespace relax_dynamics
+{
+template <typename... RelationTypes>
+class RelaxationResidueCK;
+
+template <template <typename...> class RelationType, typename... Parameters>
+class RelaxationResidueCK<Base, RelationType<Parameters...>>
+    : public Interaction<RelationType<Parameters...>>
+{
+  public:
+    template <class DynamicsIdentifier>
+    explicit RelaxationResidueCK(DynamicsIdentifier &identifier);
+    virtual ~RelaxationResidueCK(){};
+
+    class InteractKernel
+        : public Interaction<RelationType<Parameters...>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, typename... Args>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       RelaxationResidueCK<Base, RelationType<Parameters...>> &encloser,
+                       Args &&...args);
+
+      protected:
+        Real *Vol_;
+        Vecd *residue_;
+    };
+
+  protected:
+    DiscreteVariable<Real> *dv_Vol_;
+    DiscreteVariable<Vecd> *dv_residue_;
+};
+
+template <typename... Parameters>
+class RelaxationResidueCK<Inner<Parameters...>>
+    : public RelaxationResidueCK<Base, Inner<Parameters...>>
+{
+  public:
+    explicit RelaxationResidueCK(Relation<Inner<Parameters...>> &inner_relation)
+        : RelaxationResidueCK<Base, Inner<Parameters...>>(inner_relation){};
+    virtual ~RelaxationResidueCK(){};
+
+    class InteractKernel
+        : public RelaxationResidueCK<Base, Inner<Parameters...>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       RelaxationResidueCK<Inner<Parameters...>> &encloser)
+            : RelaxationResidueCK<Base, Inner<Parameters...>>::InteractKernel(ex_policy, encloser){};
+        void interact(size_t index_i, Real dt = 0.0);
+    };
+};
+
+template <typename... Parameters>
+class RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>>
+    : public RelaxationResidueCK<Inner<Parameters...>>
+{
+  public:
+    explicit RelaxationResidueCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~RelaxationResidueCK(){};
+
+    class InteractKernel
+        : public RelaxationResidueCK<Inner<Parameters...>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>> &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Vecd *pos_;
+        LevelSetCK::ProbeKernel level_set_probe_;
+    };
+
+  protected:
+    LevelSetCK &level_set_ck_;
+};
+
+template <typename... Parameters>
+class RelaxationResidueCK<Contact<Parameters...>>
+    : public RelaxationResidueCK<Base, Contact<Parameters...>>
+{
+  public:
+    explicit RelaxationResidueCK(Relation<Contact<Parameters...>> &contact_relation);
+    virtual ~RelaxationResidueCK(){};
+
+    class InteractKernel
+        : public RelaxationResidueCK<Base, Contact<Parameters...>>::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        InteractKernel(const ExecutionPolicy &ex_policy,
+                       RelaxationResidueCK<Contact<Parameters...>> &encloser,
+                       size_t contact_index);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *contact_Vol_k_;
+    };
+
+  protected:
+    StdVec<DiscreteVariable<Real> *> dv_contact_Vol_;
+};
+
+/**
+ * @class RelaxationScalingCK
+ * @brief The scale of a relaxation step from the maximum residue norm.
+ */
+class RelaxationScalingCK : public RelaxationScaling
+{
+  public:
+    explicit RelaxationScalingCK(SPHBody &sph_body);
+    virtual ~RelaxationScalingCK(){};
+
+    class ReduceKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        Real reduce(size_t index_i, Real dt = 0.0) { return residue_[index_i].norm(); };
+
+      protected:
+        Vecd *residue_;
+    };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_residue_;
+};
+
+/**
+ * @class PositionRelaxationCK
+ * @brief Update the particle position for a relaxation step with a single resolution.
+ */
+class PositionRelaxationCK : public LocalDynamics
+{
+  public:
+    explicit PositionRelaxationCK(SPHBody &sph_body);
+    virtual ~PositionRelaxationCK(){};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt_square)
+        {
+            pos_[index_i] += residue_[index_i] * dt_square * 0.5;
+        };
+
+      protected:
+        Vecd *pos_, *residue_;
+    };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_pos_, *dv_residue_;
+};
+
+/**
+ * @class ShapeSurfaceBoundingCK
+ * @brief Constrain the particles within the body shape by the flattened level set.
+ * The whole body is looped as the near-surface cells are not available in computing kernels,
+ * particles far from the surface are left unchanged by the signed distance check.
+ */
+class ShapeSurfaceBoundingCK : public LocalDynamics
+{
+  public:
+    explicit ShapeSurfaceBoundingCK(SPHBody &sph_body);
+    virtual ~ShapeSurfaceBoundingCK(){};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Vecd *pos_;
+        Real constrained_distance_;
+        LevelSetCK::ProbeKernel level_set_probe_;
+    };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_pos_;
+    Real constrained_distance_;
+    LevelSetCK &level_set_ck_;
+};
+
+/**
+ * @class RelaxationStepCK
+ * @brief A relaxation step with computing kernels.
+ * The cell linked list of the relaxed body and the given relations are updated in the step,
+ * while those of the contact bodies are the responsibility of the user.
+ */
+template <class ExecutionPolicy, class RelaxationResidueType, typename... RelationTypes>
+class RelaxationStepCK : public BaseRelaxationStep
+{
+  public:
+    explicit RelaxationStepCK(Relation<RelationTypes> &...relations);
+    virtual ~RelaxationStepCK(){};
+    virtual void exec(Real dt = 0.0) override;
+    virtual Real MaxResidue() override;
+
+  protected:
+    RealBody &real_body_;
+    UpdateCellLinkedList<ExecutionPolicy, CellLinkedList> update_cell_linked_list_;
+    UpdateRelation<ExecutionPolicy, RelationTypes...> update_relation_;
+    InteractionDynamicsCK<ExecutionPolicy, RelaxationResidueType> relaxation_residue_;
+    ReduceDynamicsCK<ExecutionPolicy, RelaxationScalingCK> relaxation_scaling_;
+    StateDynamics<ExecutionPolicy, PositionRelaxationCK> position_relaxation_;
+    StateDynamics<ExecutionPolicy, ShapeSurfaceBoundingCK> surface_bounding_;
+};
+
+template <class ExecutionPolicy>
+using RelaxationStepInnerCK =
+    RelaxationStepCK<ExecutionPolicy, RelaxationResidueCK<Inner<>>, Inner<>>;
+template <class ExecutionPolicy>
+using RelaxationStepLevelSetCorrectionInnerCK =
+    RelaxationStepCK<ExecutionPolicy, RelaxationResidueCK<Inner<LevelSetCorrection>>, Inner<>>;
+template <class ExecutionPolicy>
+using RelaxationStepComplexCK =
+    RelaxationStepCK<ExecutionPolicy, RelaxationResidueCK<Inner<>, Contact<>>, Inner<>, Contact<>>;
+template <class ExecutionPolicy>
+using RelaxationStepLevelSetCorrectionComplexCK =
+    RelaxationStepCK<ExecutionPolicy, RelaxationResidueCK<Inner<LevelSetCorrection>, Contact<>>, Inner<>, Contact<>>;
+} // namespace relax_dynamics
+} // namespace SPH
+#endif // RELAX_STEPPING_CK_H
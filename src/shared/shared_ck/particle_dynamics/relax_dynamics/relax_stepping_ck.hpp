@@ -0,0 +1,160 @@
+#ifndef RELAX_STEPPING_CK_HPP
+#define RELAX_STEPPING_CK_HPP
+
+#include "relax_stepping_ck.h"
+
+#include "interaction_algorithms_ck.hpp"
+#include "level_set_ck.hpp"
+#include "update_body_relation.hpp"
+#include "update_cell_linked_list.hpp"
+
+namespace SPH
+{
+namespace relax_dynamics
+{
+//=================================================================================================//
+template <template <typename...> class RelationType, typename... Parameters>
+template <class DynamicsIdentifier>
+RelaxationResidueCK<Base, RelationType<Parameters...>>::
+    RelaxationResidueCK(DynamicsIdentifier &identifier)
+    : Interaction<RelationType<Parameters...>>(identifier),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_residue_(this->particles_->template registerStateVariableOnly<Vecd>("ZeroOrderResidue")) {}
+//=================================================================================================//
+template <template <typename...> class RelationType, typename... Parameters>
+template <class ExecutionPolicy, typename... Args>
+RelaxationResidueCK<Base, RelationType<Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy,
+                   RelaxationResidueCK<Base, RelationType<Parameters...>> &encloser,
+                   Args &&...args)
+    : Interaction<RelationType<Parameters...>>::
+          InteractKernel(ex_policy, encloser, std::forward<Args>(args)...),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      residue_(encloser.dv_residue_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void RelaxationResidueCK<Inner<Parameters...>>::InteractKernel::interact(size_t index_i, Real dt)
+{
+    Vecd residue = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        residue -= 2.0 * this->dW_ij(index_i, index_j) * this->Vol_[index_j] * this->e_ij(index_i, index_j);
+    }
+    this->residue_[index_i] = residue;
+}
+//=================================================================================================//
+template <typename... Parameters>
+RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>>::
+    RelaxationResidueCK(Relation<Inner<Parameters...>> &inner_relation)
+    : RelaxationResidueCK<Inner<Parameters...>>(inner_relation),
+      level_set_ck_(DynamicCast<LevelSetShape>(this, this->sph_body_.getInitialShape()).getLevelSetCK()) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy>
+RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy,
+                   RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>> &encloser)
+    : RelaxationResidueCK<Inner<Parameters...>>::InteractKernel(ex_policy, encloser),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      level_set_probe_(ex_policy, encloser.level_set_ck_) {}
+//=================================================================================================//
+template <typename... Parameters>
+void RelaxationResidueCK<Inner<LevelSetCorrection, Parameters...>>::
+    InteractKernel::interact(size_t index_i, Real dt)
+{
+    RelaxationResidueCK<Inner<Parameters...>>::InteractKernel::interact(index_i, dt);
+    this->residue_[index_i] -= 2.0 * level_set_probe_.probeKernelGradientIntegral(pos_[index_i]);
+}
+//=================================================================================================//
+template <typename... Parameters>
+RelaxationResidueCK<Contact<Parameters...>>::
+    RelaxationResidueCK(Relation<Contact<Parameters...>> &contact_relation)
+    : RelaxationResidueCK<Base, Contact<Parameters...>>(contact_relation)
+{
+    for (size_t k = 0; k != this->contact_particles_.size(); ++k)
+    {
+        dv_contact_Vol_.push_back(this->contact_particles_[k]->template getVariableByName<Real>("VolumetricMeasure"));
+    }
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy>
+RelaxationResidueCK<Contact<Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy,
+                   RelaxationResidueCK<Contact<Parameters...>> &encloser,
+                   size_t contact_index)
+    : RelaxationResidueCK<Base, Contact<Parameters...>>::
+          InteractKernel(ex_policy, encloser, contact_index),
+      contact_Vol_k_(encloser.dv_contact_Vol_[contact_index]->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void RelaxationResidueCK<Contact<Parameters...>>::InteractKernel::interact(size_t index_i, Real dt)
+{
+    Vecd residue = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        residue -= 2.0 * this->dW_ij(index_i, index_j) * contact_Vol_k_[index_j] * this->e_ij(index_i, index_j);
+    }
+    this->residue_[index_i] += residue;
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+RelaxationScalingCK::ReduceKernel::
+    ReduceKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : residue_(encloser.dv_residue_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+PositionRelaxationCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      residue_(encloser.dv_residue_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class ExecutionPolicy, class EncloserType>
+ShapeSurfaceBoundingCK::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      constrained_distance_(encloser.constrained_distance_),
+      level_set_probe_(ex_policy, encloser.level_set_ck_) {}
+//=================================================================================================//
+inline void ShapeSurfaceBoundingCK::UpdateKernel::update(size_t index_i, Real dt)
+{
+    Real phi = level_set_probe_.probeSignedDistance(pos_[index_i]);
+
+    if (phi > -constrained_distance_)
+    {
+        Vecd unit_normal = level_set_probe_.probeNormalDirection(pos_[index_i]);
+        pos_[index_i] -= (phi + constrained_distance_) * unit_normal;
+    }
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class RelaxationResidueType, typename... RelationTypes>
+RelaxationStepCK<ExecutionPolicy, RelaxationResidueType, RelationTypes...>::
+    RelaxationStepCK(Relation<RelationTypes> &...relations)
+    : BaseRelaxationStep(),
+      real_body_(DynamicCast<RealBody>(this, std::get<0>(std::tie(relations...)).getSPHBody())),
+      update_cell_linked_list_(real_body_), update_relation_(relations...),
+      relaxation_residue_(relations...), relaxation_scaling_(real_body_),
+      position_relaxation_(real_body_), surface_bounding_(real_body_) {}
+//=================================================================================================//
+template <class ExecutionPolicy, class RelaxationResidueType, typename... RelationTypes>
+void RelaxationStepCK<ExecutionPolicy, RelaxationResidueType, RelationTypes...>::exec(Real dt)
+{
+    update_cell_linked_list_.exec();
+    update_relation_.exec();
+    relaxation_residue_.exec();
+    Real scaling = relaxation_scaling_.exec();
+    position_relaxation_.exec(step_scaling_ * scaling);
+    surface_bounding_.exec();
+}
+//=================================================================================================//
+template <class ExecutionPolicy, class RelaxationResidueType, typename... RelationTypes>
+Real RelaxationStepCK<ExecutionPolicy, RelaxationResidueType, RelationTypes...>::MaxResidue()
+{
+    return relaxation_scaling_.MaxResidue() * real_body_.sph_adaptation_->ReferenceSmoothingLength();
+}
+//=================================================================================================//
+} // namespace relax_dynamics
+} // namespace SPH
+#endif // RELAX_STEPPING_CK_HPP
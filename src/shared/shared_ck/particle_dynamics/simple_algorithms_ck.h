@@ -50,9 +50,11 @@ class StateDynamics : public UpdateType, public BaseDynamics<void>
         : UpdateType(identifier, std::forward<Args>(args)...),
           BaseDynamics<void>(), kernel_implementation_(*this){};
     virtual ~StateDynamics() {};
+    UpdateKernel *getUpdateKernel() { return kernel_implementation_.getComputingKernel(); };
 
     virtual void exec(Real dt = 0.0) override
     {
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         this->setUpdated(this->identifier_.getSPHBody());
         this->setupDynamics(dt);
         UpdateKernel *update_kernel = kernel_implementation_.getComputingKernel();
@@ -63,6 +65,14 @@ class StateDynamics : public UpdateType, public BaseDynamics<void>
     };
 };
 
+/**
+ * @class ReduceDynamicsCK
+ * @brief The reduced value is kept in a singular variable delegated to the execution policy,
+ *        so that device kernels may use it without a copy to the host.
+ *        With an output interval larger than one, the result is only read back every interval executions
+ *        and reused in between, which saves the host synchronizations,
+ *        e.g. for a time step size which changes slowly over the sub-steps.
+ */
 template <class ExecutionPolicy, class ReduceType>
 class ReduceDynamicsCK : public ReduceType,
                          public BaseDynamics<typename ReduceType::ReturnType>
@@ -72,27 +82,46 @@ class ReduceDynamicsCK : public ReduceType,
     using KernelImplementation =
         Implementation<ExecutionPolicy, ReduceType, ReduceKernel>;
     KernelImplementation kernel_implementation_;
+    SingularVariable<ReturnType> sv_reduced_value_;
+    ReturnType *reduced_value_;
+    UnsignedInt output_interval_;
+    UnsignedInt exec_count_;
+    ReturnType output_result_;
 
   public:
     template <class DynamicsIdentifier, typename... Args>
     ReduceDynamicsCK(DynamicsIdentifier &identifier, Args &&...args)
         : ReduceType(identifier, std::forward<Args>(args)...),
-          BaseDynamics<ReturnType>(), kernel_implementation_(*this){};
+          BaseDynamics<ReturnType>(), kernel_implementation_(*this),
+          sv_reduced_value_(this->quantity_name_, this->Reference()),
+          reduced_value_(sv_reduced_value_.DelegatedData(ExecutionPolicy{})),
+          output_interval_(1), exec_count_(0), output_result_(this->Reference()){};
     virtual ~ReduceDynamicsCK() {};
 
     std::string QuantityName() { return this->quantity_name_; };
     std::string DynamicsIdentifierName() { return this->identifier_.getName(); };
+    /** the reduced value before outputResult, delegated to the execution policy */
+    SingularVariable<ReturnType> &getReducedVariable() { return sv_reduced_value_; };
+    void setOutputInterval(UnsignedInt output_interval) { output_interval_ = SMAX(output_interval, UnsignedInt(1)); };
 
     virtual ReturnType exec(Real dt = 0.0) override
     {
+        if (exec_count_++ % output_interval_ != 0)
+        {
+            return output_result_;
+        }
+
+        auto profiling_scope = this->profilingScope(this->sph_system_, this->identifier_);
         this->setupDynamics(dt);
         ReduceKernel *reduce_kernel = kernel_implementation_.getComputingKernel();
-        ReturnType temp = particle_reduce(
+        particle_reduce(
             ExecutionPolicy{},
             this->identifier_.LoopRange(), this->Reference(), this->getOperation(),
             [=](size_t i) -> ReturnType
-            { return reduce_kernel->reduce(i, dt); });
-        return this->outputResult(temp);
+            { return reduce_kernel->reduce(i, dt); },
+            reduced_value_);
+        output_result_ = this->outputResult(sv_reduced_value_.getValue());
+        return output_result_;
     };
 };
 } // namespace SPH
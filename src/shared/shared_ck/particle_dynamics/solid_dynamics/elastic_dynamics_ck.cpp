@@ -0,0 +1,18 @@
+#include "elastic_dynamics_ck.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+//=================================================================================================//
+AcousticTimeStepCK::AcousticTimeStepCK(SPHBody &sph_body, Real CFL)
+    : LocalDynamicsReduce<ReduceMin>(sph_body), CFL_(CFL),
+      h_min_(sph_body.sph_adaptation_->MinimumSmoothingLength()),
+      c0_(DynamicCast<ElasticSolid>(this, sph_body.getBaseMaterial()).ReferenceSoundSpeed()),
+      dv_mass_(particles_->getVariableByName<Real>("Mass")),
+      dv_vel_(particles_->registerStateVariableOnly<Vecd>("Velocity")),
+      dv_force_(particles_->registerStateVariableOnly<Vecd>("Force")),
+      dv_force_prior_(particles_->registerStateVariableOnly<Vecd>("ForcePrior")) {}
+//=================================================================================================//
+} // namespace solid_dynamics
+} // namespace SPH
@@ -0,0 +1,255 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	elastic_dynamics_ck.h
+ * @brief 	Here, we define the computing-kernel algorithm classes for elastic solid dynamics.
+ * @details The total Lagrangian formulation is used, i.e. the kernel and its gradient
+ *          are evaluated in the initial configuration, with the inner neighbor lists
+ *          built once before the solid deforms. The stress is given by the
+ *          ConstituteKernel of the material type, which is a template parameter
+ *          so that no virtual function is called in the computing kernels.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef ELASTIC_DYNAMICS_CK_H
+#define ELASTIC_DYNAMICS_CK_H
+
+#include "base_general_dynamics.h"
+#include "elastic_solid.h"
+#include "interaction_ck.hpp"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+template <class BaseInteractionType>
+class ElasticStep : public BaseInteractionType
+{
+  public:
+    template <class DynamicsIdentifier>
+    explicit ElasticStep(DynamicsIdentifier &identifier);
+    virtual ~ElasticStep(){};
+
+    class InteractKernel : public BaseInteractionType::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+
+      protected:
+        Vecd *pos0_;
+
+        inline Vecd vec_r_ij0(size_t i, size_t j) const { return pos0_[i] - pos0_[j]; };
+        inline Real W_ij0(size_t i, size_t j) const { return this->kernel_.W(vec_r_ij0(i, j)); };
+        inline Real dW_ij0(size_t i, size_t j) const { return this->kernel_.dW(vec_r_ij0(i, j)); };
+        inline Vecd e_ij0(size_t i, size_t j) const
+        {
+            Vecd displacement = vec_r_ij0(i, j);
+            return displacement / (displacement.norm() + TinyReal);
+        };
+    };
+
+  protected:
+    DiscreteVariable<Real> *dv_Vol_, *dv_rho_, *dv_mass_;
+    DiscreteVariable<Vecd> *dv_pos0_, *dv_vel_, *dv_force_, *dv_force_prior_;
+    DiscreteVariable<Matd> *dv_B_, *dv_F_, *dv_dF_dt_;
+};
+
+template <typename...>
+class DeformationGradientBySummationCK;
+
+template <typename... Parameters>
+class DeformationGradientBySummationCK<Inner<Parameters...>>
+    : public ElasticStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = ElasticStep<Interaction<Inner<Parameters...>>>;
+
+  public:
+    explicit DeformationGradientBySummationCK(Relation<Inner<Parameters...>> &inner_relation)
+        : BaseInteraction(inner_relation){};
+    virtual ~DeformationGradientBySummationCK(){};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *Vol_;
+        Vecd *pos_;
+        Matd *B_, *F_;
+    };
+};
+
+template <typename...>
+class Integration1stHalfCK;
+
+template <class MaterialType, typename... Parameters>
+class Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>
+    : public ElasticStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = ElasticStep<Interaction<Inner<Parameters...>>>;
+    using ConstituteKernel = typename MaterialType::ConstituteKernel;
+
+  public:
+    explicit Integration1stHalfCK(Relation<Inner<Parameters...>> &inner_relation);
+    virtual ~Integration1stHalfCK(){};
+
+    class InitializeKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void initialize(size_t index_i, Real dt = 0.0);
+
+      protected:
+        ConstituteKernel constitute_;
+        Real rho0_;
+        Real *rho_;
+        Vecd *pos_, *vel_;
+        Matd *B_, *F_, *dF_dt_, *stress_PK1_B_;
+    };
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        ConstituteKernel constitute_;
+        Real inv_rho0_, inv_W0_, smoothing_length_, numerical_dissipation_factor_;
+        Real *Vol_, *mass_;
+        Vecd *pos_, *vel_, *force_;
+        Matd *F_, *stress_PK1_B_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *mass_;
+        Vecd *vel_, *force_, *force_prior_;
+    };
+
+  protected:
+    MaterialType &elastic_solid_;
+    DiscreteVariable<Matd> *dv_stress_PK1_B_;
+    Real rho0_, smoothing_length_;
+    Real numerical_dissipation_factor_ = 0.25;
+};
+
+template <typename...>
+class Integration2ndHalfCK;
+
+template <typename... Parameters>
+class Integration2ndHalfCK<Inner<OneLevel, Parameters...>>
+    : public ElasticStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = ElasticStep<Interaction<Inner<Parameters...>>>;
+
+  public:
+    explicit Integration2ndHalfCK(Relation<Inner<Parameters...>> &inner_relation)
+        : BaseInteraction(inner_relation){};
+    virtual ~Integration2ndHalfCK(){};
+
+    class InitializeKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void initialize(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Vecd *pos_, *vel_;
+    };
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *Vol_;
+        Vecd *vel_;
+        Matd *B_, *dF_dt_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Matd *F_, *dF_dt_;
+    };
+};
+
+class AcousticTimeStepCK : public LocalDynamicsReduce<ReduceMin>
+{
+  public:
+    explicit AcousticTimeStepCK(SPHBody &sph_body, Real CFL = 0.6);
+    virtual ~AcousticTimeStepCK(){};
+
+    class ReduceKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        ReduceKernel(const ExecutionPolicy &ex_policy, AcousticTimeStepCK &encloser);
+
+        Real reduce(size_t index_i, Real dt = 0.0)
+        {
+            Real acceleration_norm = ((force_[index_i] + force_prior_[index_i]) / mass_[index_i]).norm();
+            return CFL_ * SMIN((Real)sqrt(h_min_ / (acceleration_norm + TinyReal)),
+                               h_min_ / (c0_ + vel_[index_i].norm()));
+        };
+
+      protected:
+        Real CFL_, h_min_, c0_;
+        Real *mass_;
+        Vecd *vel_, *force_, *force_prior_;
+    };
+
+  protected:
+    Real CFL_, h_min_, c0_;
+    DiscreteVariable<Real> *dv_mass_;
+    DiscreteVariable<Vecd> *dv_vel_, *dv_force_, *dv_force_prior_;
+};
+
+using Integration1stHalfSaintVenantKirchhoffCK = Integration1stHalfCK<Inner<OneLevel, SaintVenantKirchhoffSolid>>;
+using Integration1stHalfNeoHookeanCK = Integration1stHalfCK<Inner<OneLevel, NeoHookeanSolid>>;
+using Integration2ndHalfInnerCK = Integration2ndHalfCK<Inner<OneLevel>>;
+} // namespace solid_dynamics
+} // namespace SPH
+#endif // ELASTIC_DYNAMICS_CK_H
@@ -0,0 +1,222 @@
+#ifndef ELASTIC_DYNAMICS_CK_HPP
+#define ELASTIC_DYNAMICS_CK_HPP
+
+#include "elastic_dynamics_ck.h"
+
+namespace SPH
+{
+namespace solid_dynamics
+{
+//=================================================================================================//
+template <class BaseInteractionType>
+template <class DynamicsIdentifier>
+ElasticStep<BaseInteractionType>::ElasticStep(DynamicsIdentifier &identifier)
+    : BaseInteractionType(identifier),
+      dv_Vol_(this->particles_->template getVariableByName<Real>("VolumetricMeasure")),
+      dv_rho_(this->particles_->template getVariableByName<Real>("Density")),
+      dv_mass_(this->particles_->template getVariableByName<Real>("Mass")),
+      dv_pos0_(this->particles_->template registerStateVariableOnly<Vecd>("InitialPosition", this->dv_pos_)),
+      dv_vel_(this->particles_->template registerStateVariableOnly<Vecd>("Velocity")),
+      dv_force_(this->particles_->template registerStateVariableOnly<Vecd>("Force")),
+      dv_force_prior_(this->particles_->template registerStateVariableOnly<Vecd>("ForcePrior")),
+      dv_B_(this->particles_->template registerStateVariableOnly<Matd>(
+          "LinearCorrectionMatrix", IdentityMatrix<Matd>::value)),
+      dv_F_(this->particles_->template registerStateVariableOnly<Matd>(
+          "DeformationGradient", IdentityMatrix<Matd>::value)),
+      dv_dF_dt_(this->particles_->template registerStateVariableOnly<Matd>("DeformationRate"))
+{
+    //----------------------------------------------------------------------
+    //		add restart output particle data
+    //----------------------------------------------------------------------
+    this->particles_->template addVariableToRestart<Vecd>("Position");
+    this->particles_->template addVariableToRestart<Vecd>("Velocity");
+    this->particles_->template addVariableToRestart<Vecd>("Force");
+    this->particles_->template addVariableToRestart<Matd>("DeformationGradient");
+    this->particles_->template addVariableToRestart<Matd>("DeformationRate");
+}
+//=================================================================================================//
+template <class BaseInteractionType>
+template <class ExecutionPolicy, class EncloserType>
+ElasticStep<BaseInteractionType>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteractionType::InteractKernel(ex_policy, encloser),
+      pos0_(encloser.dv_pos0_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+DeformationGradientBySummationCK<Inner<Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      B_(encloser.dv_B_->DelegatedDataField(ex_policy)),
+      F_(encloser.dv_F_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void DeformationGradientBySummationCK<Inner<Parameters...>>::InteractKernel::
+    interact(size_t index_i, Real dt)
+{
+    Matd deformation = Matd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd gradW_ijV_j = this->dW_ij0(index_i, index_j) * Vol_[index_j] * this->e_ij0(index_i, index_j);
+        deformation -= (pos_[index_i] - pos_[index_j]) * gradW_ijV_j.transpose();
+    }
+    F_[index_i] = deformation * B_[index_i];
+}
+//=================================================================================================//
+template <class MaterialType, typename... Parameters>
+Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>::
+    Integration1stHalfCK(Relation<Inner<Parameters...>> &inner_relation)
+    : BaseInteraction(inner_relation),
+      elastic_solid_(DynamicCast<MaterialType>(this, this->sph_body_.getBaseMaterial())),
+      dv_stress_PK1_B_(this->particles_->template registerStateVariableOnly<Matd>("StressPK1OnParticle")),
+      rho0_(elastic_solid_.ReferenceDensity()),
+      smoothing_length_(this->sph_body_.sph_adaptation_->ReferenceSmoothingLength()) {}
+//=================================================================================================//
+template <class MaterialType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>::InitializeKernel::
+    InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : constitute_(encloser.elastic_solid_), rho0_(encloser.rho0_),
+      rho_(encloser.dv_rho_->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      B_(encloser.dv_B_->DelegatedDataField(ex_policy)),
+      F_(encloser.dv_F_->DelegatedDataField(ex_policy)),
+      dF_dt_(encloser.dv_dF_dt_->DelegatedDataField(ex_policy)),
+      stress_PK1_B_(encloser.dv_stress_PK1_B_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class MaterialType, typename... Parameters>
+void Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>::InitializeKernel::
+    initialize(size_t index_i, Real dt)
+{
+    pos_[index_i] += vel_[index_i] * dt * 0.5;
+    F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+    rho_[index_i] = rho0_ / F_[index_i].determinant();
+    // the correction matrix is in a form of transpose
+    stress_PK1_B_[index_i] = constitute_.StressPK1(F_[index_i], index_i) * B_[index_i].transpose();
+}
+//=================================================================================================//
+template <class MaterialType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      constitute_(encloser.elastic_solid_), inv_rho0_(1.0 / encloser.rho0_),
+      inv_W0_(1.0 / this->kernel_.W(ZeroData<Vecd>::value)),
+      smoothing_length_(encloser.smoothing_length_),
+      numerical_dissipation_factor_(encloser.numerical_dissipation_factor_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      F_(encloser.dv_F_->DelegatedDataField(ex_policy)),
+      stress_PK1_B_(encloser.dv_stress_PK1_B_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class MaterialType, typename... Parameters>
+void Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>::InteractKernel::
+    interact(size_t index_i, Real dt)
+{
+    Vecd force = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd e_ij = this->e_ij0(index_i, index_j);
+        Real dim_r_ij_1 = Dimensions / this->vec_r_ij0(index_i, index_j).norm();
+        Vecd pos_jump = pos_[index_i] - pos_[index_j];
+        Vecd vel_jump = vel_[index_i] - vel_[index_j];
+        Real strain_rate = dim_r_ij_1 * dim_r_ij_1 * pos_jump.dot(vel_jump);
+        Real weight = this->W_ij0(index_i, index_j) * inv_W0_;
+        Matd numerical_stress_ij =
+            0.5 * (F_[index_i] + F_[index_j]) * constitute_.PairNumericalDamping(strain_rate, smoothing_length_);
+        force += mass_[index_i] * inv_rho0_ * this->dW_ij0(index_i, index_j) * Vol_[index_j] *
+                 (stress_PK1_B_[index_i] + stress_PK1_B_[index_j] +
+                  numerical_dissipation_factor_ * weight * numerical_stress_ij) *
+                 e_ij;
+    }
+    force_[index_i] = force;
+}
+//=================================================================================================//
+template <class MaterialType, typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <class MaterialType, typename... Parameters>
+void Integration1stHalfCK<Inner<OneLevel, MaterialType, Parameters...>>::UpdateKernel::
+    update(size_t index_i, Real dt)
+{
+    vel_[index_i] += (force_prior_[index_i] + force_[index_i]) / mass_[index_i] * dt;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+Integration2ndHalfCK<Inner<OneLevel, Parameters...>>::InitializeKernel::
+    InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void Integration2ndHalfCK<Inner<OneLevel, Parameters...>>::InitializeKernel::
+    initialize(size_t index_i, Real dt)
+{
+    pos_[index_i] += vel_[index_i] * dt * 0.5;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+Integration2ndHalfCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      B_(encloser.dv_B_->DelegatedDataField(ex_policy)),
+      dF_dt_(encloser.dv_dF_dt_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void Integration2ndHalfCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    interact(size_t index_i, Real dt)
+{
+    Matd deformation_gradient_change_rate = Matd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd gradW_ij = this->dW_ij0(index_i, index_j) * Vol_[index_j] * this->e_ij0(index_i, index_j);
+        deformation_gradient_change_rate -= (vel_[index_i] - vel_[index_j]) * gradW_ij.transpose();
+    }
+    dF_dt_[index_i] = deformation_gradient_change_rate * B_[index_i];
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+Integration2ndHalfCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : F_(encloser.dv_F_->DelegatedDataField(ex_policy)),
+      dF_dt_(encloser.dv_dF_dt_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void Integration2ndHalfCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    update(size_t index_i, Real dt)
+{
+    F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+}
+//=================================================================================================//
+template <class ExecutionPolicy>
+AcousticTimeStepCK::ReduceKernel::
+    ReduceKernel(const ExecutionPolicy &ex_policy, AcousticTimeStepCK &encloser)
+    : CFL_(encloser.CFL_), h_min_(encloser.h_min_), c0_(encloser.c0_),
+      mass_(encloser.dv_mass_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+} // namespace solid_dynamics
+} // namespace SPH
+#endif // ELASTIC_DYNAMICS_CK_HPP
@@ -0,0 +1,13 @@
+#include "porous_media_dynamics_ck.h"
+
+namespace SPH
+{
+namespace multi_species_continuum
+{
+//=================================================================================================//
+MomentumConstraintCK::MomentumConstraintCK(BodyPartByParticle &body_part)
+    : BaseLocalDynamics<BodyPartByParticle>(body_part),
+      dv_total_momentum_(particles_->registerStateVariableOnly<Vecd>("TotalMomentum")) {}
+//=================================================================================================//
+} // namespace multi_species_continuum
+} // namespace SPH
@@ -0,0 +1,243 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	porous_media_dynamics_ck.h
+ * @brief 	Computing kernels of the stress and saturation relaxation in porous media,
+ *          which follow the classic dynamics in porous_media_dynamics.h
+ *          and the total Lagrangian formulation of elastic_dynamics_ck.h.
+ * @author	Chi Zhang and Xiangyu Hu
+ */
+
+#ifndef POROUS_MEDIA_DYNAMICS_CK_H
+#define POROUS_MEDIA_DYNAMICS_CK_H
+
+#include "elastic_dynamics_ck.h"
+#include "porous_media_solid.h"
+
+namespace SPH
+{
+namespace multi_species_continuum
+{
+template <class BaseInteractionType>
+class PorousMediaStep : public solid_dynamics::ElasticStep<BaseInteractionType>
+{
+    using BaseInteraction = solid_dynamics::ElasticStep<BaseInteractionType>;
+
+  public:
+    template <class DynamicsIdentifier>
+    explicit PorousMediaStep(DynamicsIdentifier &identifier);
+    virtual ~PorousMediaStep(){};
+
+  protected:
+    PorousMediaSolid &porous_solid_;
+    Real rho0_, smoothing_length_;
+    Real diffusivity_constant_, fluid_initial_density_, water_pressure_constant_;
+    DiscreteVariable<Real> *dv_Vol_update_, *dv_fluid_saturation_, *dv_total_mass_,
+        *dv_fluid_mass_, *dv_dfluid_mass_dt_;
+    DiscreteVariable<Vecd> *dv_total_momentum_, *dv_fluid_velocity_, *dv_relative_fluid_flux_;
+    DiscreteVariable<Matd> *dv_outer_fluid_velocity_relative_fluid_flux_, *dv_stress_;
+};
+
+template <typename...>
+class PorousMediaStressRelaxationFirstHalfCK;
+
+template <typename... Parameters>
+class PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel, Parameters...>>
+    : public PorousMediaStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = PorousMediaStep<Interaction<Inner<Parameters...>>>;
+    using ConstituteKernel = typename PorousMediaSolid::ConstituteKernel;
+
+  public:
+    explicit PorousMediaStressRelaxationFirstHalfCK(Relation<Inner<Parameters...>> &inner_relation)
+        : BaseInteraction(inner_relation){};
+    virtual ~PorousMediaStressRelaxationFirstHalfCK(){};
+
+    class InitializeKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void initialize(size_t index_i, Real dt = 0.0);
+
+      protected:
+        ConstituteKernel constitute_;
+        Real water_pressure_constant_;
+        Real *Vol_, *Vol_update_, *fluid_saturation_;
+        Vecd *pos_, *vel_, *fluid_velocity_, *relative_fluid_flux_;
+        Matd *F_, *dF_dt_, *outer_fluid_velocity_relative_fluid_flux_, *stress_;
+    };
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        ConstituteKernel constitute_;
+        Real inv_W0_, smoothing_length_, numerical_dissipation_factor_;
+        Real *Vol_;
+        Vecd *pos_, *vel_, *force_;
+        Matd *F_, *outer_fluid_velocity_relative_fluid_flux_, *stress_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Vecd *total_momentum_, *force_, *force_prior_;
+    };
+
+  protected:
+    Real numerical_dissipation_factor_ = 0.25;
+};
+
+template <typename...>
+class PorousMediaStressRelaxationSecondHalfCK;
+
+template <typename... Parameters>
+class PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel, Parameters...>>
+    : public PorousMediaStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = PorousMediaStep<Interaction<Inner<Parameters...>>>;
+
+  public:
+    explicit PorousMediaStressRelaxationSecondHalfCK(Relation<Inner<Parameters...>> &inner_relation)
+        : BaseInteraction(inner_relation){};
+    virtual ~PorousMediaStressRelaxationSecondHalfCK(){};
+
+    class InitializeKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void initialize(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real fluid_initial_density_;
+        Real *Vol_update_, *total_mass_, *fluid_saturation_;
+        Vecd *pos_, *vel_, *total_momentum_, *fluid_velocity_, *relative_fluid_flux_;
+    };
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real *Vol_;
+        Vecd *vel_;
+        Matd *B_, *dF_dt_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Matd *F_, *dF_dt_;
+    };
+};
+
+template <typename...>
+class SaturationRelaxationInPorousMediaCK;
+
+template <typename... Parameters>
+class SaturationRelaxationInPorousMediaCK<Inner<OneLevel, Parameters...>>
+    : public PorousMediaStep<Interaction<Inner<Parameters...>>>
+{
+    using BaseInteraction = PorousMediaStep<Interaction<Inner<Parameters...>>>;
+
+  public:
+    explicit SaturationRelaxationInPorousMediaCK(Relation<Inner<Parameters...>> &inner_relation)
+        : BaseInteraction(inner_relation){};
+    virtual ~SaturationRelaxationInPorousMediaCK(){};
+
+    class InteractKernel : public BaseInteraction::InteractKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void interact(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real diffusivity_constant_, fluid_initial_density_;
+        Real *Vol_, *Vol_update_, *fluid_saturation_, *dfluid_mass_dt_;
+        Vecd *relative_fluid_flux_;
+    };
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy, class EncloserType>
+        UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser);
+        void update(size_t index_i, Real dt = 0.0);
+
+      protected:
+        Real rho0_, fluid_initial_density_;
+        Real *Vol_, *Vol_update_, *fluid_saturation_, *total_mass_, *fluid_mass_, *dfluid_mass_dt_;
+    };
+};
+
+/**@class MomentumConstraintCK
+ * @brief MomentumConstraint with zero momentum.
+ */
+class MomentumConstraintCK : public BaseLocalDynamics<BodyPartByParticle>
+{
+  public:
+    explicit MomentumConstraintCK(BodyPartByParticle &body_part);
+    virtual ~MomentumConstraintCK(){};
+
+    class UpdateKernel
+    {
+      public:
+        template <class ExecutionPolicy>
+        UpdateKernel(const ExecutionPolicy &ex_policy, MomentumConstraintCK &encloser)
+            : total_momentum_(encloser.dv_total_momentum_->DelegatedDataField(ex_policy)){};
+        void update(size_t index_i, Real dt = 0.0) { total_momentum_[index_i] = Vecd::Zero(); };
+
+      protected:
+        Vecd *total_momentum_;
+    };
+
+  protected:
+    DiscreteVariable<Vecd> *dv_total_momentum_;
+};
+
+using PorousMediaStressRelaxationFirstHalfInnerCK = PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel>>;
+using PorousMediaStressRelaxationSecondHalfInnerCK = PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel>>;
+using SaturationRelaxationInPorousMediaInnerCK = SaturationRelaxationInPorousMediaCK<Inner<OneLevel>>;
+} // namespace multi_species_continuum
+} // namespace SPH
+#endif // POROUS_MEDIA_DYNAMICS_CK_H
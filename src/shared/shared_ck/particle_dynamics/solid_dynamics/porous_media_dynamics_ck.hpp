@@ -0,0 +1,256 @@
+#ifndef POROUS_MEDIA_DYNAMICS_CK_HPP
+#define POROUS_MEDIA_DYNAMICS_CK_HPP
+
+#include "elastic_dynamics_ck.hpp"
+#include "porous_media_dynamics_ck.h"
+
+namespace SPH
+{
+namespace multi_species_continuum
+{
+//=================================================================================================//
+template <class BaseInteractionType>
+template <class DynamicsIdentifier>
+PorousMediaStep<BaseInteractionType>::PorousMediaStep(DynamicsIdentifier &identifier)
+    : BaseInteraction(identifier),
+      porous_solid_(DynamicCast<PorousMediaSolid>(this, this->sph_body_.getBaseMaterial())),
+      rho0_(porous_solid_.ReferenceDensity()),
+      smoothing_length_(this->sph_body_.sph_adaptation_->ReferenceSmoothingLength()),
+      diffusivity_constant_(porous_solid_.getDiffusivityConstant()),
+      fluid_initial_density_(porous_solid_.getFluidInitialDensity()),
+      water_pressure_constant_(porous_solid_.getWaterPressureConstant()),
+      dv_Vol_update_(this->particles_->template registerStateVariableOnly<Real>("UpdateVolume")),
+      dv_fluid_saturation_(this->particles_->template registerStateVariableOnly<Real>("FluidSaturation")),
+      dv_total_mass_(this->particles_->template registerStateVariableOnly<Real>("TotalMass")),
+      dv_fluid_mass_(this->particles_->template registerStateVariableOnly<Real>("FluidMass")),
+      dv_dfluid_mass_dt_(this->particles_->template registerStateVariableOnly<Real>("FluidMassIncrement")),
+      dv_total_momentum_(this->particles_->template registerStateVariableOnly<Vecd>("TotalMomentum")),
+      dv_fluid_velocity_(this->particles_->template registerStateVariableOnly<Vecd>("FluidVelocity")),
+      dv_relative_fluid_flux_(this->particles_->template registerStateVariableOnly<Vecd>("RelativeFluidFlux")),
+      dv_outer_fluid_velocity_relative_fluid_flux_(
+          this->particles_->template registerStateVariableOnly<Matd>("OuterFluidVelocityRelativeFluidFlux")),
+      dv_stress_(this->particles_->template registerStateVariableOnly<Matd>("Stress")) {}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel, Parameters...>>::InitializeKernel::
+    InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : constitute_(encloser.porous_solid_),
+      water_pressure_constant_(encloser.water_pressure_constant_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      Vol_update_(encloser.dv_Vol_update_->DelegatedDataField(ex_policy)),
+      fluid_saturation_(encloser.dv_fluid_saturation_->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      fluid_velocity_(encloser.dv_fluid_velocity_->DelegatedDataField(ex_policy)),
+      relative_fluid_flux_(encloser.dv_relative_fluid_flux_->DelegatedDataField(ex_policy)),
+      F_(encloser.dv_F_->DelegatedDataField(ex_policy)),
+      dF_dt_(encloser.dv_dF_dt_->DelegatedDataField(ex_policy)),
+      outer_fluid_velocity_relative_fluid_flux_(
+          encloser.dv_outer_fluid_velocity_relative_fluid_flux_->DelegatedDataField(ex_policy)),
+      stress_(encloser.dv_stress_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel, Parameters...>>::InitializeKernel::
+    initialize(size_t index_i, Real dt)
+{
+    pos_[index_i] += vel_[index_i] * dt * 0.5;
+    F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+    Real J = F_[index_i].determinant();
+    Matd inverse_F_T = F_[index_i].inverse().transpose();
+    Matd almansi_strain = 0.5 * (Matd::Identity() - (F_[index_i] * F_[index_i].transpose()).inverse());
+
+    // first, update solid density and volume
+    Vol_update_[index_i] = Vol_[index_i] * J;
+    // the Cauchy stress without J, J is added in total momentum
+    stress_[index_i] = (constitute_.StressCauchy(almansi_strain, index_i) -
+                        water_pressure_constant_ * (fluid_saturation_[index_i] - Eps) * Matd::Identity()) *
+                       inverse_F_T;
+    outer_fluid_velocity_relative_fluid_flux_[index_i] =
+        fluid_velocity_[index_i] * relative_fluid_flux_[index_i].transpose() * inverse_F_T;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      constitute_(encloser.porous_solid_),
+      inv_W0_(1.0 / this->kernel_.W(ZeroData<Vecd>::value)),
+      smoothing_length_(encloser.smoothing_length_),
+      numerical_dissipation_factor_(encloser.numerical_dissipation_factor_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      F_(encloser.dv_F_->DelegatedDataField(ex_policy)),
+      outer_fluid_velocity_relative_fluid_flux_(
+          encloser.dv_outer_fluid_velocity_relative_fluid_flux_->DelegatedDataField(ex_policy)),
+      stress_(encloser.dv_stress_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    interact(size_t index_i, Real dt)
+{
+    Vecd total_momentum_increment = Vecd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd gradW_ijV_j = this->dW_ij0(index_i, index_j) * Vol_[index_j] * this->e_ij0(index_i, index_j);
+        Real dim_r_ij_1 = Dimensions / this->vec_r_ij0(index_i, index_j).norm();
+        Vecd pos_jump = pos_[index_i] - pos_[index_j];
+        Vecd vel_jump = vel_[index_i] - vel_[index_j];
+        Real strain_rate = pos_jump.dot(vel_jump) * dim_r_ij_1 * dim_r_ij_1;
+        Real weight = this->W_ij0(index_i, index_j) * inv_W0_;
+        Matd numerical_stress_ij =
+            0.5 * (F_[index_i] + F_[index_j]) * constitute_.PairNumericalDamping(strain_rate, smoothing_length_);
+
+        // three parts for the momentum increment
+        total_momentum_increment += (stress_[index_i] + stress_[index_j] + numerical_dissipation_factor_ * numerical_stress_ij * weight -
+                                     outer_fluid_velocity_relative_fluid_flux_[index_i] - outer_fluid_velocity_relative_fluid_flux_[index_j]) *
+                                    gradW_ijV_j;
+    }
+    force_[index_i] = total_momentum_increment;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : total_momentum_(encloser.dv_total_momentum_->DelegatedDataField(ex_policy)),
+      force_(encloser.dv_force_->DelegatedDataField(ex_policy)),
+      force_prior_(encloser.dv_force_prior_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void PorousMediaStressRelaxationFirstHalfCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    update(size_t index_i, Real dt)
+{
+    total_momentum_[index_i] += (force_prior_[index_i] + force_[index_i]) * dt;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel, Parameters...>>::InitializeKernel::
+    InitializeKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : fluid_initial_density_(encloser.fluid_initial_density_),
+      Vol_update_(encloser.dv_Vol_update_->DelegatedDataField(ex_policy)),
+      total_mass_(encloser.dv_total_mass_->DelegatedDataField(ex_policy)),
+      fluid_saturation_(encloser.dv_fluid_saturation_->DelegatedDataField(ex_policy)),
+      pos_(encloser.dv_pos_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      total_momentum_(encloser.dv_total_momentum_->DelegatedDataField(ex_policy)),
+      fluid_velocity_(encloser.dv_fluid_velocity_->DelegatedDataField(ex_policy)),
+      relative_fluid_flux_(encloser.dv_relative_fluid_flux_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel, Parameters...>>::InitializeKernel::
+    initialize(size_t index_i, Real dt)
+{
+    // update solid velocity.
+    vel_[index_i] = (total_momentum_[index_i] - relative_fluid_flux_[index_i]) * Vol_update_[index_i] / total_mass_[index_i];
+    // update fluid velocity based on updated relative velocity, fluid density and solid velocity,
+    fluid_velocity_[index_i] = vel_[index_i] - relative_fluid_flux_[index_i] / fluid_initial_density_ /
+                                                   (fluid_saturation_[index_i] + TinyReal);
+    pos_[index_i] += vel_[index_i] * dt * 0.5;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      vel_(encloser.dv_vel_->DelegatedDataField(ex_policy)),
+      B_(encloser.dv_B_->DelegatedDataField(ex_policy)),
+      dF_dt_(encloser.dv_dF_dt_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    interact(size_t index_i, Real dt)
+{
+    Matd deformation_gradient_change_rate = Matd::Zero();
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Vecd gradW_ijV_j = this->dW_ij0(index_i, index_j) * Vol_[index_j] * this->e_ij0(index_i, index_j);
+        deformation_gradient_change_rate -= (vel_[index_i] - vel_[index_j]) * gradW_ijV_j.transpose();
+    }
+    dF_dt_[index_i] = deformation_gradient_change_rate * B_[index_i];
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : F_(encloser.dv_F_->DelegatedDataField(ex_policy)),
+      dF_dt_(encloser.dv_dF_dt_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void PorousMediaStressRelaxationSecondHalfCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    update(size_t index_i, Real dt)
+{
+    F_[index_i] += dF_dt_[index_i] * dt * 0.5;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+SaturationRelaxationInPorousMediaCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    InteractKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : BaseInteraction::InteractKernel(ex_policy, encloser),
+      diffusivity_constant_(encloser.diffusivity_constant_),
+      fluid_initial_density_(encloser.fluid_initial_density_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      Vol_update_(encloser.dv_Vol_update_->DelegatedDataField(ex_policy)),
+      fluid_saturation_(encloser.dv_fluid_saturation_->DelegatedDataField(ex_policy)),
+      dfluid_mass_dt_(encloser.dv_dfluid_mass_dt_->DelegatedDataField(ex_policy)),
+      relative_fluid_flux_(encloser.dv_relative_fluid_flux_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void SaturationRelaxationInPorousMediaCK<Inner<OneLevel, Parameters...>>::InteractKernel::
+    interact(size_t index_i, Real dt)
+{
+    Vecd fluid_saturation_gradient = Vecd::Zero();
+    Real relative_fluid_flux_divergence = 0.0;
+    for (UnsignedInt n = this->FirstNeighbor(index_i); n != this->LastNeighbor(index_i); ++n)
+    {
+        UnsignedInt index_j = this->neighbor_index_[n];
+        Real r_ij = this->vec_r_ij0(index_i, index_j).norm();
+        Real dw_ijV_j = this->dW_ij0(index_i, index_j) * Vol_[index_j];
+        Vecd e_ij = this->e_ij0(index_i, index_j);
+
+        fluid_saturation_gradient -= (fluid_saturation_[index_i] - fluid_saturation_[index_j]) * e_ij * dw_ijV_j;
+        relative_fluid_flux_divergence += 0.5 * (fluid_saturation_[index_i] * fluid_saturation_[index_i] -
+                                                 fluid_saturation_[index_j] * fluid_saturation_[index_j]) /
+                                          (r_ij + TinyReal) * dw_ijV_j;
+    }
+    // then we update relative velocity based on the updated fluid density
+    relative_fluid_flux_[index_i] =
+        -diffusivity_constant_ * fluid_initial_density_ * fluid_saturation_[index_i] * fluid_saturation_gradient;
+    dfluid_mass_dt_[index_i] =
+        diffusivity_constant_ * Vol_update_[index_i] * fluid_initial_density_ * relative_fluid_flux_divergence;
+}
+//=================================================================================================//
+template <typename... Parameters>
+template <class ExecutionPolicy, class EncloserType>
+SaturationRelaxationInPorousMediaCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    UpdateKernel(const ExecutionPolicy &ex_policy, EncloserType &encloser)
+    : rho0_(encloser.rho0_), fluid_initial_density_(encloser.fluid_initial_density_),
+      Vol_(encloser.dv_Vol_->DelegatedDataField(ex_policy)),
+      Vol_update_(encloser.dv_Vol_update_->DelegatedDataField(ex_policy)),
+      fluid_saturation_(encloser.dv_fluid_saturation_->DelegatedDataField(ex_policy)),
+      total_mass_(encloser.dv_total_mass_->DelegatedDataField(ex_policy)),
+      fluid_mass_(encloser.dv_fluid_mass_->DelegatedDataField(ex_policy)),
+      dfluid_mass_dt_(encloser.dv_dfluid_mass_dt_->DelegatedDataField(ex_policy)) {}
+//=================================================================================================//
+template <typename... Parameters>
+void SaturationRelaxationInPorousMediaCK<Inner<OneLevel, Parameters...>>::UpdateKernel::
+    update(size_t index_i, Real dt)
+{
+    fluid_mass_[index_i] += dfluid_mass_dt_[index_i] * dt;
+    total_mass_[index_i] = rho0_ * Vol_[index_i] + fluid_mass_[index_i];
+    fluid_saturation_[index_i] = fluid_mass_[index_i] / fluid_initial_density_ / Vol_update_[index_i];
+}
+//=================================================================================================//
+} // namespace multi_species_continuum
+} // namespace SPH
+#endif // POROUS_MEDIA_DYNAMICS_CK_HPP
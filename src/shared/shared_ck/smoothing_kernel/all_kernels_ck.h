@@ -0,0 +1,39 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	all_kernels_ck.h
+ * @brief 	All smoothing kernels for computing kernels.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef ALL_KERNELS_CK_H
+#define ALL_KERNELS_CK_H
+
+#include "kernel_cubic_B_spline_ck.h"
+#include "kernel_hyperbolic_ck.h"
+#include "kernel_laguerre_gauss_ck.h"
+#include "kernel_quadratic_ck.h"
+#include "kernel_tabulated_ck.h"
+#include "kernel_wenland_c2_ck.h"
+
+#endif // ALL_KERNELS_CK_H
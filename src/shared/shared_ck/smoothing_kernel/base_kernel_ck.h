@@ -0,0 +1,156 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	base_kernel_ck.h
+ * @brief 	Device-copyable smoothing kernel for computing kernels.
+ * @details The normalization factors and the cut-off radius are copied from the host kernel,
+ *          while the dimensionless kernel function is given by the template parameter
+ *          with inline static functions of q, so that the kernel is fully inlined
+ *          without virtual dispatch. The kernel type should agree with the one
+ *          of the body's SPH adaptation. The values and gradients are zero beyond the kernel size,
+ *          so that neighbors found with an enlarged search radius, e.g. a Verlet skin, contribute nothing.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef BASE_KERNEL_CK_H
+#define BASE_KERNEL_CK_H
+
+#include "base_kernel.h"
+
+namespace SPH
+{
+template <class KernelFunctionType>
+class SmoothingKernelCK
+{
+  public:
+    explicit SmoothingKernelCK(Kernel &kernel)
+    {
+        inv_h_ = 1.0 / kernel.SmoothingLength();
+        kernel_size_ = kernel.KernelSize();
+        factor_W_1D_ = kernel.FactorW1D();
+        factor_W_2D_ = kernel.FactorW2D();
+        factor_W_3D_ = kernel.FactorW3D();
+        factor_dW_1D_ = inv_h_ * factor_W_1D_;
+        factor_dW_2D_ = inv_h_ * factor_W_2D_;
+        factor_dW_3D_ = inv_h_ * factor_W_3D_;
+        rc_ref_ = kernel.CutOffRadius();
+        rc_ref_sqr_ = kernel.CutOffRadiusSqr();
+    };
+
+    Real W(const Real &displacement) const
+    {
+        Real q = displacement * inv_h_;
+        return q < kernel_size_ ? factor_W_1D_ * KernelFunctionType::W_1D(q) : Real(0);
+    };
+
+    Real W(const Vec2d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_;
+        return q < kernel_size_ ? factor_W_2D_ * KernelFunctionType::W_2D(q) : Real(0);
+    };
+
+    Real W(const Vec3d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_;
+        return q < kernel_size_ ? factor_W_3D_ * KernelFunctionType::W_3D(q) : Real(0);
+    };
+
+    /** Neighbors beyond the cut-off (e.g. within a Verlet skin) contribute nothing. */
+    Real W_1D(Real q) const { return q < kernel_size_ ? KernelFunctionType::W_1D(q) : Real(0); };
+
+    Real dW(const Real &displacement) const
+    {
+        Real q = displacement * inv_h_;
+        return q < kernel_size_ ? factor_dW_1D_ * KernelFunctionType::dW_1D(q) : Real(0);
+    };
+
+    Real dW(const Vec2d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_;
+        return q < kernel_size_ ? factor_dW_2D_ * KernelFunctionType::dW_2D(q) : Real(0);
+    };
+
+    Real dW(const Vec3d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_;
+        return q < kernel_size_ ? factor_dW_3D_ * KernelFunctionType::dW_3D(q) : Real(0);
+    };
+
+    Real dW_1D(Real q) const { return q < kernel_size_ ? KernelFunctionType::dW_1D(q) : Real(0); };
+
+    Vec2d e(const Real &distance, const Vec2d &displacement) const
+    {
+        return displacement / (distance + TinyReal);
+    };
+    Vec3d e(const Real &distance, const Vec3d &displacement) const
+    {
+        return displacement / (distance + TinyReal);
+    };
+
+    bool checkIfWithinCutOffRadius(const Vec2d &displacement) const
+    {
+        return displacement.squaredNorm() < CutOffRadiusSqr();
+    };
+
+    bool checkIfWithinCutOffRadius(const Vec3d &displacement) const
+    {
+        return displacement.squaredNorm() < CutOffRadiusSqr();
+    };
+
+    inline Real CutOffRadius() const { return rc_ref_; };
+    inline Real CutOffRadiusSqr() const { return rc_ref_sqr_; };
+
+    /** With the smoothing length of the kernel divided by h_ratio, for adaptive resolutions. */
+    Real W(const Real &h_ratio, const Vec2d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_ * h_ratio;
+        return q < kernel_size_ ? h_ratio * h_ratio * factor_W_2D_ * KernelFunctionType::W_2D(q) : Real(0);
+    };
+
+    Real W(const Real &h_ratio, const Vec3d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_ * h_ratio;
+        return q < kernel_size_ ? h_ratio * h_ratio * h_ratio * factor_W_3D_ * KernelFunctionType::W_3D(q) : Real(0);
+    };
+
+    Real dW(const Real &h_ratio, const Vec2d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_ * h_ratio;
+        return q < kernel_size_ ? h_ratio * h_ratio * h_ratio * factor_dW_2D_ * KernelFunctionType::dW_2D(q) : Real(0);
+    };
+
+    Real dW(const Real &h_ratio, const Vec3d &displacement) const
+    {
+        Real q = displacement.norm() * inv_h_ * h_ratio;
+        return q < kernel_size_ ? h_ratio * h_ratio * h_ratio * h_ratio * factor_dW_3D_ * KernelFunctionType::dW_3D(q) : Real(0);
+    };
+
+    inline Real CutOffRadius(const Real &h_ratio) const { return rc_ref_ / h_ratio; };
+
+  protected:
+    Real inv_h_, kernel_size_, rc_ref_, rc_ref_sqr_,
+        factor_W_1D_, factor_W_2D_, factor_W_3D_,
+        factor_dW_1D_, factor_dW_2D_, factor_dW_3D_;
+};
+} // namespace SPH
+#endif // BASE_KERNEL_CK_H
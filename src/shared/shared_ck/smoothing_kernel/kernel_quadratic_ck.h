@@ -0,0 +1,51 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	kernel_quadratic_ck.h
+ * @brief 	This is the class for quadratic kernel.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef KERNEL_QUADRATIC_CK_H
+#define KERNEL_QUADRATIC_CK_H
+
+#include "base_kernel_ck.h"
+
+namespace SPH
+{
+/** The derivatives follow the host kernel, which differ in 3D. */
+struct KernelQuadraticFunction
+{
+    static inline Real W_1D(Real q) { return 5.0 * (3.0 * q * q - 12.0 * q + 12.0) / 64.0; };
+    static inline Real W_2D(Real q) { return W_1D(q); };
+    static inline Real W_3D(Real q) { return W_1D(q); };
+    static inline Real dW_1D(Real q)
+    {
+        return q < 1.0 ? -6.0 + 3.0 * q * q : -pow(2.0 - q, 2);
+    };
+    static inline Real dW_2D(Real q) { return dW_1D(q); };
+    static inline Real dW_3D(Real q) { return 15.0 * (q - 2.0) / 32.0; };
+};
+using KernelQuadraticCK = SmoothingKernelCK<KernelQuadraticFunction>;
+} // namespace SPH
+#endif // KERNEL_QUADRATIC_CK_H
@@ -0,0 +1,134 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	kernel_tabulated_ck.h
+ * @brief 	Tabulated version of the CK smoothing kernels. The kernel functions
+ *          are sampled once at construction on a uniform grid in q with
+ *          Size intervals, and evaluated afterwards by linear or cubic
+ *          (Catmull-Rom) interpolation. The tables are held by value so that
+ *          the kernel remains device copyable and can be used with Neighbor<>.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef KERNEL_TABULATED_CK_H
+#define KERNEL_TABULATED_CK_H
+
+#include "base_kernel_ck.h"
+
+#include <array>
+
+namespace SPH
+{
+template <class KernelFunctionType, UnsignedInt Size = 128, bool IsCubic = true>
+class KernelTabulatedCK : public SmoothingKernelCK<KernelFunctionType>
+{
+    using BaseKernel = SmoothingKernelCK<KernelFunctionType>;
+    using Table = std::array<Real, Size + 1>;
+    static_assert(Size >= 2, "KernelTabulatedCK: at least two table intervals are required.");
+
+  public:
+    explicit KernelTabulatedCK(Kernel &kernel)
+        : BaseKernel(kernel), inv_dq_(Real(Size) / this->kernel_size_)
+    {
+        Real dq = this->kernel_size_ / Real(Size);
+        for (UnsignedInt k = 0; k != Size + 1; ++k)
+        {
+            Real q = Real(k) * dq;
+            W_1D_table_[k] = KernelFunctionType::W_1D(q);
+            dW_1D_table_[k] = KernelFunctionType::dW_1D(q);
+            W_table_[k] = Dimensions == 2 ? KernelFunctionType::W_2D(q) : KernelFunctionType::W_3D(q);
+            dW_table_[k] = Dimensions == 2 ? KernelFunctionType::dW_2D(q) : KernelFunctionType::dW_3D(q);
+        }
+    };
+
+    Real W(const Real &displacement) const
+    {
+        return this->factor_W_1D_ * W_1D(displacement * this->inv_h_);
+    };
+
+    /** Only the dimension of the build is tabulated, the other falls back to direct evaluation. */
+    Real W(const Vec2d &displacement) const
+    {
+        return Dimensions == 2 ? this->factor_W_2D_ * lookup(W_table_, displacement.norm() * this->inv_h_)
+                               : BaseKernel::W(displacement);
+    };
+
+    Real W(const Vec3d &displacement) const
+    {
+        return Dimensions == 3 ? this->factor_W_3D_ * lookup(W_table_, displacement.norm() * this->inv_h_)
+                               : BaseKernel::W(displacement);
+    };
+
+    Real W_1D(Real q) const { return lookup(W_1D_table_, q); };
+
+    Real dW(const Real &displacement) const
+    {
+        return this->factor_dW_1D_ * dW_1D(displacement * this->inv_h_);
+    };
+
+    Real dW(const Vec2d &displacement) const
+    {
+        return Dimensions == 2 ? this->factor_dW_2D_ * lookup(dW_table_, displacement.norm() * this->inv_h_)
+                               : BaseKernel::dW(displacement);
+    };
+
+    Real dW(const Vec3d &displacement) const
+    {
+        return Dimensions == 3 ? this->factor_dW_3D_ * lookup(dW_table_, displacement.norm() * this->inv_h_)
+                               : BaseKernel::dW(displacement);
+    };
+
+    Real dW_1D(Real q) const { return lookup(dW_1D_table_, q); };
+
+    static constexpr UnsignedInt TableSize() { return Size; };
+    static constexpr bool isCubic() { return IsCubic; };
+
+  protected:
+    Real inv_dq_;
+    Table W_1D_table_, dW_1D_table_, W_table_, dW_table_;
+
+    /** Zero beyond the cut-off, as for the exact kernel. Missing end points are extrapolated quadratically. */
+    Real lookup(const Table &table, Real q) const
+    {
+        if (q >= this->kernel_size_)
+            return Real(0);
+
+        Real s = q * inv_dq_;
+        UnsignedInt k = SMIN(UnsignedInt(s), Size - 1);
+        Real t = s - Real(k);
+        Real p1 = table[k];
+        Real p2 = table[k + 1];
+        if constexpr (!IsCubic)
+        {
+            return p1 + t * (p2 - p1);
+        }
+        else
+        {
+            Real p0 = k == 0 ? 3.0 * (p1 - p2) + table[2] : table[k - 1];
+            Real p3 = k + 1 == Size ? 3.0 * (p2 - p1) + table[k - 1] : table[k + 2];
+            return p1 + 0.5 * t * (p2 - p0 + t * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3 + t * (3.0 * (p1 - p2) + p3 - p0)));
+        }
+    };
+};
+} // namespace SPH
+#endif // KERNEL_TABULATED_CK_H
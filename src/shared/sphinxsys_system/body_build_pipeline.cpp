@@ -0,0 +1,61 @@
+#include "body_build_pipeline.h"
+
+#include "timeline_tracer.h"
+
+#include <set>
+
+namespace SPH
+{
+//=================================================================================================//
+BodyBuildPipeline::TaskNode *BodyBuildPipeline::createNode(const std::function<void()> &task)
+{
+    nodes_.push_back(std::make_unique<TaskNode>(
+        flow_graph_, [task](const tbb::flow::continue_msg &)
+        {
+            static const std::string timeline_name = "BodyBuildTask";
+            TimelineTracer::Scope timeline_scope("startup", timeline_name);
+            task(); }));
+    return nodes_.back().get();
+}
+//=================================================================================================//
+void BodyBuildPipeline::addBodyTask(SPHBody &sph_body, const std::function<void()> &task)
+{
+    addTask({&sph_body}, task);
+}
+//=================================================================================================//
+void BodyBuildPipeline::addTask(const StdVec<SPHBody *> &bodies, const std::function<void()> &task)
+{
+    if (bodies.empty())
+    {
+        std::cout << "\n Error: a build task is given without bodies!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    TaskNode *node = createNode(task);
+    std::set<TaskNode *> predecessors;
+    for (SPHBody *body : bodies)
+    {
+        auto last_task = last_body_tasks_.find(body);
+        if (last_task != last_body_tasks_.end())
+            predecessors.insert(last_task->second);
+        last_body_tasks_[body] = node;
+    }
+
+    for (TaskNode *predecessor : predecessors)
+        tbb::flow::make_edge(*predecessor, *node);
+    if (predecessors.empty())
+        source_nodes_.push_back(node);
+}
+//=================================================================================================//
+void BodyBuildPipeline::run()
+{
+    for (TaskNode *source : source_nodes_)
+        source->try_put(tbb::flow::continue_msg());
+    flow_graph_.wait_for_all();
+    source_nodes_.clear();
+    last_body_tasks_.clear();
+    nodes_.clear();
+}
+//=================================================================================================//
+} // namespace SPH
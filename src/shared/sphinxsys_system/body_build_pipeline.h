@@ -0,0 +1,75 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	body_build_pipeline.h
+ * @brief 	Concurrent construction of the geometries, particles and relations of bodies at startup.
+ * @details The bodies themselves are created in the main thread as they register to the system.
+ *			The tasks building each body, e.g. its level set shape and particle generation,
+ *			run concurrently with those of other bodies, and a task on several bodies,
+ *			e.g. creating a relation, runs once all of them are built.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef BODY_BUILD_PIPELINE_H
+#define BODY_BUILD_PIPELINE_H
+
+#include "base_body.h"
+
+#include "tbb/flow_graph.h"
+
+#include <functional>
+#include <map>
+
+namespace SPH
+{
+/**
+ * @class BodyBuildPipeline
+ * @brief The tasks involving the same body run in the order added, as relations subscribe to
+ * the body they belong to and may register variables on the bodies they contact.
+ * Hence, the concurrency is mainly among building different bodies, which is the costly part.
+ * The IO environment should be set up before running, as it is shared by all tasks.
+ */
+class BodyBuildPipeline
+{
+  public:
+    BodyBuildPipeline(){};
+    virtual ~BodyBuildPipeline(){};
+
+    /** e.g. defining the level set shape and generating the particles of the body */
+    void addBodyTask(SPHBody &sph_body, const std::function<void()> &task);
+    /** e.g. creating the relations of a body to others */
+    void addTask(const StdVec<SPHBody *> &bodies, const std::function<void()> &task);
+    /** runs all tasks and waits for them to finish */
+    void run();
+
+  protected:
+    using TaskNode = tbb::flow::continue_node<tbb::flow::continue_msg>;
+    tbb::flow::graph flow_graph_;
+    StdVec<std::unique_ptr<TaskNode>> nodes_;
+    StdVec<TaskNode *> source_nodes_;
+    std::map<SPHBody *, TaskNode *> last_body_tasks_;
+
+    TaskNode *createNode(const std::function<void()> &task);
+};
+} // namespace SPH
+#endif // BODY_BUILD_PIPELINE_H
@@ -0,0 +1,206 @@
+#include "dynamics_profiler.h"
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace SPH
+{
+//=================================================================================================//
+DynamicsProfiler::Scope::Scope(Record *record, size_t particles)
+    : record_(record), particles_(particles)
+{
+    if (record_ != nullptr)
+    {
+        if (record_->is_active_)
+        {
+            record_ = nullptr;
+        }
+        else
+        {
+            record_->is_active_ = true;
+            if (!record_->is_traffic_recorded_)
+                traffic_recording_ = makeUnique<DataTrafficRecording>();
+            start_ = TickCount::now();
+        }
+    }
+}
+//=================================================================================================//
+DynamicsProfiler::Scope::~Scope()
+{
+    if (record_ != nullptr)
+    {
+        Real time = (TickCount::now() - start_).seconds();
+        record_->calls_++;
+        record_->particles_ += particles_;
+        record_->total_time_ += time;
+        record_->max_time_ = SMAX(record_->max_time_, time);
+        if (traffic_recording_ != nullptr)
+        {
+            record_->is_traffic_recorded_ = true;
+            record_->recorded_bytes_per_particle_ = traffic_recording_->BytesPerParticle();
+            record_->neighbor_data_bytes_ = traffic_recording_->NeighborDataBytes();
+            traffic_recording_.reset();
+        }
+        for (auto &neighbor_data_bytes : record_->neighbor_data_bytes_)
+            record_->neighbor_bytes_ += Real(neighbor_data_bytes());
+        record_->is_active_ = false;
+    }
+}
+//=================================================================================================//
+size_t DynamicsProfiler::Record::BytesPerParticle()
+{
+    return given_bytes_per_particle_ != 0 ? given_bytes_per_particle_ : recorded_bytes_per_particle_;
+}
+//=================================================================================================//
+Real DynamicsProfiler::Record::Bandwidth()
+{
+    Real bytes = Real(particles_) * Real(BytesPerParticle()) + neighbor_bytes_;
+    return total_time_ > 0.0 ? bytes / total_time_ : 0.0;
+}
+//=================================================================================================//
+DynamicsProfiler::Record *DynamicsProfiler::
+    registerDynamics(const std::string &name, size_t bytes_per_particle)
+{
+    std::lock_guard<std::mutex> lock(register_mutex_);
+    Record *record = record_ptrs_.createPtr<Record>(name, bytes_per_particle);
+    records_.push_back(record);
+    return record;
+}
+//=================================================================================================//
+Real DynamicsProfiler::TotalTime()
+{
+    Real total_time = 0.0;
+    for (Record *record : records_)
+        total_time += record->total_time_;
+    return total_time;
+}
+//=================================================================================================//
+Real DynamicsProfiler::PeakBandwidth()
+{
+    if (peak_bandwidth_ <= 0.0)
+        peak_bandwidth_ = measurePeakBandwidth();
+    return peak_bandwidth_;
+}
+//=================================================================================================//
+Real DynamicsProfiler::measurePeakBandwidth()
+{
+    // arrays much larger than the last level cache, the best of several repetitions
+    size_t size = size_t(1) << 23;
+    StdVec<Real> a(size, 1.0), b(size, 2.0), c(size, 0.0);
+    Real best_time = MaxReal;
+    for (size_t repeat = 0; repeat != 5; ++repeat)
+    {
+        TickCount start = TickCount::now();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, size),
+                          [&](const tbb::blocked_range<size_t> &range)
+                          {
+                              for (size_t i = range.begin(); i != range.end(); ++i)
+                                  c[i] = a[i] + Real(3) * b[i];
+                          });
+        best_time = SMIN(best_time, Real((TickCount::now() - start).seconds()));
+    }
+    return 3.0 * Real(size * sizeof(Real)) / best_time;
+}
+//=================================================================================================//
+StdVec<DynamicsProfiler::Record *> DynamicsProfiler::sortedRecords()
+{
+    StdVec<Record *> sorted_records = records_;
+    std::stable_sort(sorted_records.begin(), sorted_records.end(),
+                     [](const Record *a, const Record *b)
+                     { return a->total_time_ > b->total_time_; });
+    return sorted_records;
+}
+//=================================================================================================//
+void DynamicsProfiler::writeReport(std::ostream &output)
+{
+    Real all_time = TotalTime();
+    Real peak_bandwidth = PeakBandwidth();
+
+    output << "\n Dynamics profiling report (sorted by total wall time, peak bandwidth "
+           << std::fixed << std::setprecision(1) << 1.0e-9 * peak_bandwidth << " GB/s):\n";
+    output << std::setw(10) << "calls" << std::setw(14) << "total[s]" << std::setw(8) << "%"
+           << std::setw(14) << "max[ms]" << std::setw(14) << "Mparticle/s"
+           << std::setw(12) << "GB/s" << std::setw(8) << "%peak" << "  name\n";
+    for (Record *record : sortedRecords())
+    {
+        Real throughput = record->total_time_ > 0.0 ? Real(record->particles_) / record->total_time_ : 0.0;
+        output << std::setw(10) << record->calls_
+               << std::setw(14) << std::fixed << std::setprecision(6) << record->total_time_
+               << std::setw(8) << std::setprecision(2)
+               << (all_time > 0.0 ? 100.0 * record->total_time_ / all_time : 0.0)
+               << std::setw(14) << std::setprecision(3) << 1.0e3 * record->max_time_
+               << std::setw(14) << 1.0e-6 * throughput
+               << std::setw(12) << 1.0e-9 * record->Bandwidth()
+               << std::setw(8) << std::setprecision(1) << 100.0 * record->Bandwidth() / peak_bandwidth
+               << "  " << record->name_ << "\n";
+    }
+    output << std::defaultfloat;
+}
+//=================================================================================================//
+void DynamicsProfiler::writeToCSV(const std::string &filefullpath)
+{
+    Real peak_bandwidth = PeakBandwidth();
+    // the quotes in the type names are doubled within the quoted field
+    auto escaped = [](const std::string &name)
+    {
+        std::string result;
+        for (char c : name)
+        {
+            if (c == '"')
+                result += '"';
+            result += c;
+        }
+        return result;
+    };
+
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    out_file << "name,calls,total_time,max_time,particles,bytes_per_particle,neighbor_bytes,bandwidth,peak_fraction\n";
+    for (Record *record : sortedRecords())
+    {
+        out_file << "\"" << escaped(record->name_) << "\"," << record->calls_ << ","
+                 << record->total_time_ << "," << record->max_time_ << ","
+                 << record->particles_ << "," << record->BytesPerParticle() << ","
+                 << record->neighbor_bytes_ << "," << record->Bandwidth() << ","
+                 << record->Bandwidth() / peak_bandwidth << "\n";
+    }
+    out_file.close();
+}
+//=================================================================================================//
+void DynamicsProfiler::writeToJSON(const std::string &filefullpath)
+{
+    Real peak_bandwidth = PeakBandwidth();
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    StdVec<Record *> sorted_records = sortedRecords();
+    auto escaped = [](const std::string &name)
+    {
+        std::string result;
+        for (char c : name)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    };
+    out_file << "{\"peak_bandwidth\": " << peak_bandwidth << ", \"dynamics\": [\n";
+    for (size_t i = 0; i != sorted_records.size(); ++i)
+    {
+        Record *record = sorted_records[i];
+        out_file << "  {\"name\": \"" << escaped(record->name_) << "\", \"calls\": " << record->calls_
+                 << ", \"total_time\": " << record->total_time_ << ", \"max_time\": " << record->max_time_
+                 << ", \"particles\": " << record->particles_
+                 << ", \"bytes_per_particle\": " << record->BytesPerParticle()
+                 << ", \"neighbor_bytes\": " << record->neighbor_bytes_
+                 << ", \"bandwidth\": " << record->Bandwidth()
+                 << ", \"peak_fraction\": " << record->Bandwidth() / peak_bandwidth << "}"
+                 << (i + 1 != sorted_records.size() ? ",\n" : "\n");
+    }
+    out_file << "]}\n";
+    out_file.close();
+}
+//=================================================================================================//
+} // namespace SPH
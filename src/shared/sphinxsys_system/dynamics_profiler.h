@@ -0,0 +1,120 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file dynamics_profiler.h
+ * @brief Registry of the wall time spent in each dynamics object of a system.
+ * @details Profiling is off by default. When it is enabled in the SPH system,
+ * each dynamics registers itself at its first execution and
+ * a report sorted by total time is given when the system is destroyed.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef DYNAMICS_PROFILER_H
+#define DYNAMICS_PROFILER_H
+
+#include "base_data_package.h"
+#include "ownership.h"
+#include "sphinxsys_variable.h"
+
+#include <iostream>
+#include <mutex>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class DynamicsProfiler
+ * @brief Accumulates call count, total and maximum wall time,
+ * particle throughput and estimated memory traffic for each registered dynamics.
+ * Unless given at registration, the memory traffic is estimated from the variables
+ * delegated to the computing kernels constructed in the first call, see DataTrafficRecording,
+ * and the achieved bandwidth is reported against the peak bandwidth of the machine,
+ * so that memory-bound dynamics are identified as those close to the peak.
+ */
+class DynamicsProfiler
+{
+  public:
+    struct Record
+    {
+        std::string name_;
+        size_t given_bytes_per_particle_;        /**< given by the dynamics, zero if not given */
+        size_t recorded_bytes_per_particle_ = 0; /**< of the variables delegated to the kernels */
+        size_t calls_ = 0;
+        size_t particles_ = 0; /**< particles processed in all calls */
+        Real total_time_ = 0.0;
+        Real max_time_ = 0.0;
+        bool is_active_ = false; /**< to skip the nested exec of base algorithms */
+        bool is_traffic_recorded_ = false;
+        StdVec<std::function<size_t()>> neighbor_data_bytes_; /**< of the neighbor data at a call */
+        Real neighbor_bytes_ = 0.0;                             /**< neighbor data moved in all calls */
+
+        /** estimated bytes touched for each particle, the given one if any, zero if unknown */
+        size_t BytesPerParticle();
+        Real Bandwidth(); /**< achieved, in bytes per second */
+
+        Record(const std::string &name, size_t given_bytes_per_particle)
+            : name_(name), given_bytes_per_particle_(given_bytes_per_particle){};
+    };
+
+    /** RAII timer scope of one execution. */
+    class Scope
+    {
+        Record *record_;
+        size_t particles_;
+        TickCount start_;
+        UniquePtr<DataTrafficRecording> traffic_recording_;
+
+      public:
+        Scope(Record *record, size_t particles);
+        ~Scope();
+    };
+
+    DynamicsProfiler() : is_enabled_(false), peak_bandwidth_(0.0){};
+    ~DynamicsProfiler(){};
+
+    void setEnabled(bool is_enabled) { is_enabled_ = is_enabled; };
+    bool isEnabled() { return is_enabled_; };
+    Record *registerDynamics(const std::string &name, size_t bytes_per_particle = 0);
+    StdVec<Record *> &Records() { return records_; };
+    /** in bytes per second, measured with a triad loop at the first report if not given */
+    void setPeakBandwidth(Real peak_bandwidth) { peak_bandwidth_ = peak_bandwidth; };
+    Real PeakBandwidth();
+    static Real measurePeakBandwidth();
+    /** wall time accumulated in all registered dynamics */
+    Real TotalTime();
+    /** report sorted by total wall time */
+    void writeReport(std::ostream &output);
+    void writeToCSV(const std::string &filefullpath);
+    void writeToJSON(const std::string &filefullpath);
+
+  protected:
+    bool is_enabled_;
+    Real peak_bandwidth_;
+    UniquePtrsKeeper<Record> record_ptrs_;
+    StdVec<Record *> records_;
+    std::mutex register_mutex_; /**< dynamics may register concurrently, e.g. within a concurrent group */
+
+    StdVec<Record *> sortedRecords();
+};
+} // namespace SPH
+#endif // DYNAMICS_PROFILER_H
@@ -0,0 +1,114 @@
+#include "instrumentation.h"
+
+#if SPHINXSYS_USE_INSTRUMENTATION
+#include <cstdlib>
+#include <map>
+
+#if SPHINXSYS_USE_LIKWID
+#include <likwid-marker.h>
+#endif
+#if SPHINXSYS_USE_ITTNOTIFY
+#include <ittnotify.h>
+#endif
+#if SPHINXSYS_USE_PAPI
+#include <papi.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+std::mutex InstrumentationRegion::region_mutex_;
+UniquePtrsKeeper<InstrumentationRegion> InstrumentationRegion::region_ptrs_;
+#if SPHINXSYS_USE_ITTNOTIFY
+static __itt_domain *itt_domain = nullptr;
+#endif
+//=================================================================================================//
+InstrumentationRegion::Scope::Scope(InstrumentationRegion *region) : region_(region)
+{
+    if (region_->is_active_)
+    {
+        region_ = nullptr;
+    }
+    else
+    {
+        region_->is_active_ = true;
+        region_->begin();
+    }
+}
+//=================================================================================================//
+InstrumentationRegion::Scope::~Scope()
+{
+    if (region_ != nullptr)
+    {
+        region_->end();
+        region_->is_active_ = false;
+    }
+}
+//=================================================================================================//
+InstrumentationRegion::InstrumentationRegion(const std::string &name)
+    : name_(name), handle_(nullptr), is_active_(false)
+{
+#if SPHINXSYS_USE_ITTNOTIFY
+    handle_ = __itt_string_handle_create(name_.c_str());
+#endif
+#if SPHINXSYS_USE_LIKWID
+    LIKWID_MARKER_REGISTER(name_.c_str());
+#endif
+}
+//=================================================================================================//
+InstrumentationRegion *InstrumentationRegion::getRegion(const std::string &name)
+{
+    static std::map<std::string, InstrumentationRegion *> regions;
+    std::lock_guard<std::mutex> lock(region_mutex_);
+    if (regions.empty())
+    {
+        initializeTool();
+    }
+    auto found = regions.find(name);
+    if (found != regions.end())
+        return found->second;
+    InstrumentationRegion *region = region_ptrs_.createPtr<InstrumentationRegion>(name);
+    regions[name] = region;
+    return region;
+}
+//=================================================================================================//
+void InstrumentationRegion::initializeTool()
+{
+#if SPHINXSYS_USE_LIKWID
+    LIKWID_MARKER_INIT;
+    std::atexit([]()
+                { LIKWID_MARKER_CLOSE; });
+#endif
+#if SPHINXSYS_USE_ITTNOTIFY
+    itt_domain = __itt_domain_create("SPHinXsys");
+#endif
+}
+//=================================================================================================//
+void InstrumentationRegion::begin()
+{
+#if SPHINXSYS_USE_LIKWID
+    LIKWID_MARKER_START(name_.c_str());
+#endif
+#if SPHINXSYS_USE_ITTNOTIFY
+    __itt_task_begin(itt_domain, __itt_null, __itt_null, static_cast<__itt_string_handle *>(handle_));
+#endif
+#if SPHINXSYS_USE_PAPI
+    PAPI_hl_region_begin(name_.c_str());
+#endif
+}
+//=================================================================================================//
+void InstrumentationRegion::end()
+{
+#if SPHINXSYS_USE_PAPI
+    PAPI_hl_region_end(name_.c_str());
+#endif
+#if SPHINXSYS_USE_ITTNOTIFY
+    __itt_task_end(itt_domain);
+#endif
+#if SPHINXSYS_USE_LIKWID
+    LIKWID_MARKER_STOP(name_.c_str());
+#endif
+}
+//=================================================================================================//
+} // namespace SPH
+#endif // SPHINXSYS_USE_INSTRUMENTATION
@@ -0,0 +1,85 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	instrumentation.h
+ * @brief 	Named regions for external profilers, opened at the execution of each dynamics.
+ * @details The regions are compiled in only with SPHINXSYS_USE_LIKWID (LIKWID marker API),
+ *          SPHINXSYS_USE_ITTNOTIFY (VTune tasks) or SPHINXSYS_USE_PAPI (PAPI high-level regions).
+ *          Otherwise nothing is added to the dynamics and their execution.
+ *          The hardware counters, such as cache misses, FLOP rates and memory bandwidth,
+ *          are selected and reported per region by the tool,
+ *          e.g. likwid-perfctr -m -g MEM_DP, or PAPI_EVENTS for PAPI.
+ *          Note that LIKWID and PAPI count on the thread opening the region,
+ *          which is the calling thread of the parallel loops.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#define SPHINXSYS_USE_INSTRUMENTATION (SPHINXSYS_USE_LIKWID || SPHINXSYS_USE_ITTNOTIFY || SPHINXSYS_USE_PAPI)
+
+#if SPHINXSYS_USE_INSTRUMENTATION
+#include "ownership.h"
+
+#include <mutex>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class InstrumentationRegion
+ * @brief A named region, created once and opened at each execution.
+ */
+class InstrumentationRegion
+{
+  public:
+    /** RAII scope of one execution, nested executions of the same region are skipped. */
+    class Scope
+    {
+        InstrumentationRegion *region_;
+
+      public:
+        explicit Scope(InstrumentationRegion *region);
+        ~Scope();
+    };
+
+    explicit InstrumentationRegion(const std::string &name);
+    /** the region of the name, the tool is initialized with the first region */
+    static InstrumentationRegion *getRegion(const std::string &name);
+
+  protected:
+    std::string name_;
+    void *handle_; /**< the string handle of the tool if it has one */
+    bool is_active_;
+
+    void begin();
+    void end();
+
+    static std::mutex region_mutex_;
+    static UniquePtrsKeeper<InstrumentationRegion> region_ptrs_;
+    static void initializeTool();
+};
+} // namespace SPH
+#endif // SPHINXSYS_USE_INSTRUMENTATION
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,158 @@
+#include "memory_report.h"
+
+#include "base_body.h"
+#include "base_body_relation.h"
+#include "base_particles.h"
+#include "level_set_shape.h"
+#include "sph_system.h"
+
+#include <boost/core/demangle.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+namespace SPH
+{
+//=================================================================================================//
+void MemoryReport::record(const std::string &body_name, const std::string &category,
+                          const std::string &name, size_t bytes)
+{
+    std::string key = body_name + "/" + category + "/" + name;
+    auto found = entry_index_.find(key);
+    if (found == entry_index_.end())
+    {
+        entry_index_[key] = entries_.size();
+        Entry entry;
+        entry.body_name_ = body_name;
+        entry.category_ = category;
+        entry.name_ = name;
+        entries_.push_back(entry);
+        found = entry_index_.find(key);
+    }
+    Entry &entry = entries_[found->second];
+    entry.bytes_ += bytes;
+    entry.peak_bytes_ = SMAX(entry.peak_bytes_, entry.bytes_);
+    total_bytes_ += bytes;
+}
+//=================================================================================================//
+void MemoryReport::recordBody(SPHBody &sph_body)
+{
+    const std::string body_name = sph_body.getName();
+    BaseParticles &base_particles = sph_body.getBaseParticles();
+    size_t total_real_particles = base_particles.TotalRealParticles();
+    size_t particles_bound = base_particles.ParticlesBound();
+    size_t reserve_bytes = 0;
+    std::apply(
+        [&](auto &...variables_of_type)
+        {
+            auto record_variables = [&](auto &variables)
+            {
+                for (auto *variable : variables)
+                {
+                    size_t bytes = variable->MemoryFootprint();
+                    record(body_name, "variable", variable->Name(), bytes);
+                    if (variable->DeviceMemoryFootprint() != 0)
+                        record(body_name, "device", variable->Name(), variable->DeviceMemoryFootprint());
+                    if (variable->getDataFieldSize() == particles_bound)
+                        reserve_bytes += bytes / particles_bound * (particles_bound - total_real_particles);
+                }
+            };
+            (record_variables(variables_of_type), ...);
+        },
+        base_particles.AllDiscreteVariables());
+    // the part of the variables beyond the real particles, i.e. buffer and ghost reserves
+    record(body_name, "reserve", "UnusedParticleReserve", reserve_bytes);
+    record(body_name, "scratch", "ScratchVariablePool", base_particles.getScratchVariablePool().MemoryFootprint());
+
+    StdVec<SPHRelation *> &body_relations = sph_body.getBodyRelations();
+    for (size_t k = 0; k != body_relations.size(); ++k)
+    {
+        record(body_name, "relation",
+               std::to_string(k) + ": " + boost::core::demangle(typeid(*body_relations[k]).name()),
+               body_relations[k]->MemoryFootprint());
+    }
+
+    RealBody *real_body = dynamic_cast<RealBody *>(&sph_body);
+    if (real_body != nullptr && real_body->isCellLinkedListCreated())
+    {
+        record(body_name, "cell_linked_list", "CellLinkedList", real_body->getCellLinkedList().MemoryFootprint());
+    }
+
+    LevelSetShape *level_set_shape = dynamic_cast<LevelSetShape *>(&sph_body.getInitialShape());
+    if (level_set_shape != nullptr)
+    {
+        size_t bytes = 0;
+        for (auto *mesh_level : level_set_shape->getLevelSet().getMeshLevels())
+            bytes += mesh_level->MemoryFootprint();
+        record(body_name, "level_set", level_set_shape->getName(), bytes);
+    }
+}
+//=================================================================================================//
+void MemoryReport::update(SPHSystem &sph_system)
+{
+    total_bytes_ = 0;
+    for (Entry &entry : entries_)
+        entry.bytes_ = 0;
+
+    for (SPHBody *sph_body : sph_system.sph_bodies_)
+        recordBody(*sph_body);
+    peak_total_bytes_ = SMAX(peak_total_bytes_, total_bytes_);
+}
+//=================================================================================================//
+void MemoryReport::writeReport(std::ostream &output)
+{
+    StdVec<Entry> sorted_entries = entries_;
+    std::stable_sort(sorted_entries.begin(), sorted_entries.end(),
+                     [](const Entry &a, const Entry &b)
+                     { return a.body_name_ == b.body_name_ ? a.bytes_ > b.bytes_ : a.body_name_ < b.body_name_; });
+
+    output << "\n Memory report, total " << std::fixed << std::setprecision(3)
+           << 1.0e-6 * Real(total_bytes_) << " MB, peak " << 1.0e-6 * Real(peak_total_bytes_) << " MB:\n";
+    output << std::setw(14) << "MB" << std::setw(14) << "peak[MB]" << std::setw(18) << "category"
+           << "  body: name\n";
+    for (const Entry &entry : sorted_entries)
+    {
+        output << std::setw(14) << 1.0e-6 * Real(entry.bytes_)
+               << std::setw(14) << 1.0e-6 * Real(entry.peak_bytes_)
+               << std::setw(18) << entry.category_
+               << "  " << entry.body_name_ << ": " << entry.name_ << "\n";
+    }
+    ParticleCapacity::writeReport(output);
+    output << std::defaultfloat;
+}
+//=================================================================================================//
+void MemoryReport::writeToJSON(const std::string &filefullpath)
+{
+    auto escaped = [](const std::string &name)
+    {
+        std::string result;
+        for (char c : name)
+        {
+            if (c == '"' || c == '\\')
+                result += '\\';
+            result += c;
+        }
+        return result;
+    };
+
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    ParticleCapacity::Statistics capacity_statistics = ParticleCapacity::getStatistics();
+    out_file << "{\n  \"total_bytes\": " << total_bytes_
+             << ",\n  \"peak_total_bytes\": " << peak_total_bytes_
+             << ",\n  \"reallocations\": " << capacity_statistics.reallocations_
+             << ",\n  \"reallocated_bytes\": " << capacity_statistics.reallocated_bytes_
+             << ",\n  \"entries\": [\n";
+    for (size_t i = 0; i != entries_.size(); ++i)
+    {
+        const Entry &entry = entries_[i];
+        out_file << "    {\"body\": \"" << escaped(entry.body_name_) << "\", \"category\": \"" << entry.category_
+                 << "\", \"name\": \"" << escaped(entry.name_) << "\", \"bytes\": " << entry.bytes_
+                 << ", \"peak_bytes\": " << entry.peak_bytes_ << "}"
+                 << (i + 1 != entries_.size() ? ",\n" : "\n");
+    }
+    out_file << "  ]\n}\n";
+    out_file.close();
+}
+//=================================================================================================//
+} // namespace SPH
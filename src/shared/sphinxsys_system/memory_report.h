@@ -0,0 +1,84 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	memory_report.h
+ * @brief 	Accounting of the memory held by the bodies of a system.
+ * @details The footprints of the particle variables, their device copies,
+ *          the unused particle reserves, the body relations, the cell linked lists
+ *          and the level sets are collected at each update, with the peak of each entry.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef MEMORY_REPORT_H
+#define MEMORY_REPORT_H
+
+#include "base_data_package.h"
+
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace SPH
+{
+class SPHSystem;
+class SPHBody;
+
+/**
+ * @class MemoryReport
+ * @brief Bytes held by each body, broken down by variable, relation, mesh and device buffer.
+ */
+class MemoryReport
+{
+  public:
+    struct Entry
+    {
+        std::string body_name_;
+        std::string category_; /**< variable, device, reserve, scratch, relation, cell_linked_list or level_set */
+        std::string name_;
+        size_t bytes_ = 0;
+        size_t peak_bytes_ = 0;
+    };
+
+    MemoryReport() : total_bytes_(0), peak_total_bytes_(0){};
+    ~MemoryReport(){};
+
+    /** collect the current footprints of all bodies and update the peaks */
+    void update(SPHSystem &sph_system);
+    size_t TotalBytes() { return total_bytes_; };
+    size_t PeakTotalBytes() { return peak_total_bytes_; };
+    StdVec<Entry> &Entries() { return entries_; };
+    /** report grouped by body, with the entries sorted by current bytes */
+    void writeReport(std::ostream &output);
+    void writeToJSON(const std::string &filefullpath);
+
+  protected:
+    StdVec<Entry> entries_;
+    std::map<std::string, size_t> entry_index_; /**< position of an entry by its body, category and name */
+    size_t total_bytes_, peak_total_bytes_;
+
+    void record(const std::string &body_name, const std::string &category,
+                const std::string &name, size_t bytes);
+    void recordBody(SPHBody &sph_body);
+};
+} // namespace SPH
+#endif // MEMORY_REPORT_H
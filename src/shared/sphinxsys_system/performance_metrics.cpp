@@ -0,0 +1,112 @@
+#include "performance_metrics.h"
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace SPH
+{
+//=================================================================================================//
+void PerformanceMetrics::collect(DynamicsProfiler &dynamics_profiler)
+{
+    Real wall_time = (TickCount::now() - start_).seconds();
+    size_t steps = 0;
+    size_t particle_updates = 0;
+    for (DynamicsProfiler::Record *record : dynamics_profiler.Records())
+    {
+        steps = SMAX(steps, record->calls_);
+        particle_updates += record->particles_;
+    }
+
+    metrics_.clear();
+    metrics_.push_back({"wall_time", wall_time, false});
+    metrics_.push_back({"steps_per_second", Real(steps) / (wall_time + TinyReal), true});
+    metrics_.push_back({"particle_updates_per_second", Real(particle_updates) / (wall_time + TinyReal), true});
+    metrics_.push_back({"peak_memory", Real(PeakResidentMemory()), false});
+}
+//=================================================================================================//
+void PerformanceMetrics::writeToFile(const std::string &filefullpath)
+{
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc);
+    out_file << std::setprecision(9);
+    for (Metric &metric : metrics_)
+        out_file << metric.name_ << " " << metric.value_ << "\n";
+    out_file.close();
+}
+//=================================================================================================//
+bool PerformanceMetrics::compareWithBaseline(const std::string &filefullpath, Real tolerance, std::ostream &output)
+{
+    std::map<std::string, Real> baseline;
+    std::ifstream in_file(filefullpath.c_str());
+    std::string name;
+    Real value;
+    while (in_file >> name >> value)
+        baseline[name] = value;
+    in_file.close();
+
+    bool is_within_tolerance = true;
+    output << "\n Performance compared with the baseline " << filefullpath
+           << " (tolerance " << 100.0 * tolerance << "%):\n";
+    output << std::setw(30) << "metric" << std::setw(16) << "baseline" << std::setw(16) << "current"
+           << std::setw(10) << "change" << "\n";
+    for (Metric &metric : metrics_)
+    {
+        auto found = baseline.find(metric.name_);
+        if (found == baseline.end() || found->second <= 0.0 || metric.value_ <= 0.0)
+        {
+            output << std::setw(30) << metric.name_ << "  not compared\n";
+            continue;
+        }
+        Real change = metric.value_ / found->second - 1.0;
+        bool is_failed = metric.is_higher_better_ ? change < -tolerance : change > tolerance;
+        output << std::setw(30) << metric.name_ << std::setw(16) << found->second
+               << std::setw(16) << metric.value_
+               << std::setw(9) << std::fixed << std::setprecision(1) << 100.0 * change << "%"
+               << std::defaultfloat << std::setprecision(6)
+               << (is_failed ? "  FAILED" : "") << "\n";
+        is_within_tolerance = is_within_tolerance && !is_failed;
+    }
+    return is_within_tolerance;
+}
+//=================================================================================================//
+std::string PerformanceMetrics::BaselineFile(const std::string &prefix)
+{
+    char machine_name[256] = "unknown";
+#if defined(_WIN32)
+    DWORD size = sizeof(machine_name);
+    GetComputerNameA(machine_name, &size);
+#else
+    gethostname(machine_name, sizeof(machine_name) - 1);
+#endif
+    return prefix + "_" + std::string(machine_name) + ".dat";
+}
+//=================================================================================================//
+size_t PerformanceMetrics::PeakResidentMemory()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return size_t(counters.PeakWorkingSetSize);
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#if defined(__APPLE__)
+    return size_t(usage.ru_maxrss);
+#else
+    return size_t(usage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,78 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	performance_metrics.h
+ * @brief 	Performance metrics of a run and their comparison with a baseline.
+ * @details The metrics are collected from the dynamics profiler and the process,
+ *          and compared with the baseline recorded before on the same machine,
+ *          so that a slowdown beyond the tolerance fails the run.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PERFORMANCE_METRICS_H
+#define PERFORMANCE_METRICS_H
+
+#include "base_data_package.h"
+#include "dynamics_profiler.h"
+
+#include <iostream>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @class PerformanceMetrics
+ * @brief Steps and particle updates per second, wall time and peak memory of a run.
+ * @details The steps are counted as the calls of the most frequently called dynamics,
+ *          which is the innermost time step of the integration loop.
+ */
+class PerformanceMetrics
+{
+  public:
+    struct Metric
+    {
+        std::string name_;
+        Real value_;
+        bool is_higher_better_;
+    };
+
+    PerformanceMetrics() : start_(TickCount::now()){};
+    ~PerformanceMetrics(){};
+
+    void collect(DynamicsProfiler &dynamics_profiler);
+    StdVec<Metric> &Metrics() { return metrics_; };
+    /** one metric per line with its name and value */
+    void writeToFile(const std::string &filefullpath);
+    /** compares with the baseline and writes the differences, true if all are within the tolerance */
+    bool compareWithBaseline(const std::string &filefullpath, Real tolerance, std::ostream &output);
+    /** the baseline file of the given prefix for this machine */
+    static std::string BaselineFile(const std::string &prefix);
+    /** peak resident memory of the process in bytes, zero if not available */
+    static size_t PeakResidentMemory();
+
+  protected:
+    TickCount start_;
+    StdVec<Metric> metrics_;
+};
+} // namespace SPH
+#endif // PERFORMANCE_METRICS_H
@@ -0,0 +1,109 @@
+#include "sph_ensemble.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+
+namespace SPH
+{
+//=================================================================================================//
+SPHEnsemble::SPHEnsemble(BoundingBox system_domain_bounds, Real resolution_ref,
+                         size_t number_of_members, size_t number_of_concurrent_members)
+    : system_domain_bounds_(system_domain_bounds), resolution_ref_(resolution_ref),
+      number_of_members_(number_of_members),
+      number_of_concurrent_members_(number_of_concurrent_members)
+{
+    size_t number_of_threads = SMAX(size_t(std::thread::hardware_concurrency()), size_t(1));
+    if (number_of_concurrent_members_ == 0)
+    {
+        number_of_concurrent_members_ = number_of_threads;
+    }
+    number_of_concurrent_members_ = SMIN(number_of_concurrent_members_, SMAX(number_of_members_, size_t(1)));
+}
+//=================================================================================================//
+SPHEnsemble *SPHEnsemble::setCpuList(const StdVec<int> &cpu_list)
+{
+    cpu_list_ = cpu_list;
+    return this;
+}
+//=================================================================================================//
+SPHEnsemble *SPHEnsemble::setPreparation(const CaseFunction &preparation)
+{
+    preparation_ = preparation;
+    return this;
+}
+//=================================================================================================//
+std::string SPHEnsemble::memberName(size_t member)
+{
+    return "member_" + std::to_string(member);
+}
+//=================================================================================================//
+void SPHEnsemble::run(const MemberCaseFunction &member_case)
+{
+    if (preparation_)
+    {
+        SPHSystem sph_system(system_domain_bounds_, resolution_ref_);
+        sph_system.setRunParticleRelaxation(true);
+        sph_system.setLevelSetCache(true);
+        preparation_(sph_system);
+    }
+
+    std::atomic<size_t> next_member(0);
+    std::exception_ptr first_exception = nullptr;
+    std::mutex exception_mutex;
+    StdVec<std::thread> drivers;
+    for (size_t driver = 0; driver != number_of_concurrent_members_; ++driver)
+    {
+        drivers.emplace_back([&, driver]()
+                             {
+                                 for (size_t member = next_member++; member < number_of_members_; member = next_member++)
+                                 {
+                                     try
+                                     {
+                                         runMember(member_case, member, driver);
+                                     }
+                                     catch (...)
+                                     {
+                                         std::lock_guard<std::mutex> lock(exception_mutex);
+                                         if (first_exception == nullptr)
+                                             first_exception = std::current_exception();
+                                     }
+                                 } });
+    }
+    for (auto &driver : drivers)
+    {
+        driver.join();
+    }
+
+    if (first_exception != nullptr)
+    {
+        std::rethrow_exception(first_exception);
+    }
+}
+//=================================================================================================//
+void SPHEnsemble::runMember(const MemberCaseFunction &member_case, size_t member, size_t driver)
+{
+    size_t number_of_threads = SMAX(size_t(std::thread::hardware_concurrency()), size_t(1));
+    size_t threads_per_member = SMAX(number_of_threads / number_of_concurrent_members_, size_t(1));
+    StdVec<int> member_cpu_list;
+    if (!cpu_list_.empty())
+    {
+        size_t cpus_per_member = SMAX(cpu_list_.size() / number_of_concurrent_members_, size_t(1));
+        for (size_t i = 0; i != cpus_per_member; ++i)
+        {
+            member_cpu_list.push_back(cpu_list_[(driver * cpus_per_member + i) % cpu_list_.size()]);
+        }
+        threads_per_member = member_cpu_list.size();
+    }
+
+    // the system is created on the driver thread so that its arena is the active one of the thread,
+    // without a process-wide thread limit, which would be changed by every member starting or finishing
+    SPHSystem sph_system(system_domain_bounds_, resolution_ref_, number_of_threads, false);
+    sph_system.setThreadArena(int(threads_per_member), member_cpu_list);
+    sph_system.setMemberName(memberName(member));
+    sph_system.setLevelSetCache(true);
+    sph_system.setReloadParticles(bool(preparation_));
+    member_case(sph_system, member);
+}
+//=================================================================================================//
+} // namespace SPH
@@ -0,0 +1,83 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file sph_ensemble.h
+ * @brief Runs many variants of a case, e.g. for parameter sweeps, concurrently in one process.
+ * @details The preparation, building the level sets and relaxing the particles,
+ * is run once. The members then start from the cached level sets and the reloaded particles,
+ * which are mapped from the same files, and each runs in its own system and thread arena
+ * with its own parameters.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef SPH_ENSEMBLE_H
+#define SPH_ENSEMBLE_H
+
+#include "sph_system.h"
+
+#include <functional>
+
+namespace SPH
+{
+/**
+ * @class SPHEnsemble
+ * @brief The members are run by a number of concurrent drivers,
+ * each of which owns an equal share of the threads and, if given, of the cores.
+ * @details An exception thrown by a member is rethrown by run() after all members are finished.
+ * However, an error reported by exit(), as most errors in the library are,
+ * terminates the process and with it all the other members.
+ * Cases which may fail this way are better checked with a single system before running the ensemble.
+ */
+class SPHEnsemble
+{
+  public:
+    using CaseFunction = std::function<void(SPHSystem &)>;
+    using MemberCaseFunction = std::function<void(SPHSystem &, size_t)>;
+
+    SPHEnsemble(BoundingBox system_domain_bounds, Real resolution_ref, size_t number_of_members,
+                size_t number_of_concurrent_members = 0);
+    virtual ~SPHEnsemble(){};
+
+    /** cores to share among the concurrent members, empty for no pinning */
+    SPHEnsemble *setCpuList(const StdVec<int> &cpu_list);
+    /** run once before the members, with particle relaxation on, to write the reload particles */
+    SPHEnsemble *setPreparation(const CaseFunction &preparation);
+    size_t NumberOfMembers() { return number_of_members_; };
+    size_t NumberOfConcurrentMembers() { return number_of_concurrent_members_; };
+    /** the member name gives its output and restart sub-folders */
+    static std::string memberName(size_t member);
+    /** the member case sets the parameters of the given member and runs it */
+    void run(const MemberCaseFunction &member_case);
+
+  protected:
+    BoundingBox system_domain_bounds_;
+    Real resolution_ref_;
+    size_t number_of_members_;
+    size_t number_of_concurrent_members_;
+    StdVec<int> cpu_list_;
+    CaseFunction preparation_;
+
+    void runMember(const MemberCaseFunction &member_case, size_t member, size_t driver);
+};
+} // namespace SPH
+#endif // SPH_ENSEMBLE_H
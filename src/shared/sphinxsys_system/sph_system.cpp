@@ -7,14 +7,43 @@
 namespace SPH
 {
 //=================================================================================================//
-SPHSystem::SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref, size_t number_of_threads)
+SPHSystem::SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref,
+                     size_t number_of_threads, bool is_global_control)
     : system_domain_bounds_(system_domain_bounds),
       resolution_ref_(resolution_ref),
-      tbb_global_control_(tbb::global_control::max_allowed_parallelism, number_of_threads),
-      io_environment_(nullptr), run_particle_relaxation_(false), reload_particles_(false),
-      restart_step_(0), generate_regression_data_(false), state_recording_(true)
+      tbb_global_control_(is_global_control
+                              ? makeUnique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, number_of_threads)
+                              : nullptr),
+      thread_arena_(int(number_of_threads)), io_environment_(nullptr), run_particle_relaxation_(false), reload_particles_(false),
+      restart_step_(0), generate_regression_data_(false), state_recording_(true),
+      async_io_(false), observation_buffer_size_(1), observation_binary_output_(false),
+      level_set_cache_(false), network_cache_(false), performance_tolerance_(0.1)
 {
     registerSystemVariable<Real>("PhysicalTime", 0.0);
+    thread_arena_.activate();
+}
+//=================================================================================================//
+SPHSystem::~SPHSystem()
+{
+    async_io_writer_.flush();
+    if (dynamics_profiler_.isEnabled())
+    {
+        dynamics_profiler_.writeReport(std::cout);
+        if (io_environment_ != nullptr)
+        {
+            dynamics_profiler_.writeToCSV(io_environment_->output_folder_ + "/dynamics_profile.csv");
+            dynamics_profiler_.writeToJSON(io_environment_->output_folder_ + "/dynamics_profile.json");
+        }
+    }
+    if (!performance_baseline_.empty())
+    {
+        comparePerformanceWithBaseline();
+    }
+    if (TimelineTracer::isEnabled() && io_environment_ != nullptr)
+    {
+        TimelineTracer::writeToChromeTrace(io_environment_->output_folder_ + "/timeline_trace.json");
+        TimelineTracer::clear();
+    }
 }
 //=================================================================================================//
 IOEnvironment &SPHSystem::getIOEnvironment()
@@ -28,26 +57,116 @@ IOEnvironment &SPHSystem::getIOEnvironment()
     return *io_environment_;
 }
 //=================================================================================================//
+void SPHSystem::setAsyncIO(bool is_async, size_t queue_capacity, AsyncIOQueuePolicy queue_policy)
+{
+    async_io_ = is_async;
+    async_io_writer_.setQueue(queue_capacity, queue_policy);
+    if (!async_io_)
+        async_io_writer_.flush();
+}
+//=================================================================================================//
 
 void SPHSystem::initializeSystemCellLinkedLists()
 {
+    // the cell linked lists used only by lazy relations are updated at their first use
+    std::set<SPHBody *> lazy_bodies;
+    std::set<SPHBody *> eager_bodies;
+    for (auto &body : sph_bodies_)
+    {
+        for (SPHRelation *body_relation : body->body_relations_)
+        {
+            std::set<SPHBody *> &involved = body_relation->isLazyConfiguration() ? lazy_bodies : eager_bodies;
+            for (SPHBody *involved_body : body_relation->getInvolvedBodies())
+                involved.insert(involved_body);
+        }
+    }
+
+    SPHBodyVector updated_bodies;
     for (auto &body : real_bodies_)
     {
-        DynamicCast<RealBody>(this, body)->updateCellLinkedList();
+        if (lazy_bodies.count(body) == 0 || eager_bodies.count(body) != 0)
+            updated_bodies.push_back(body);
     }
+    // the bodies are independent, and the cell linked list of each is itself built in parallel
+    arena_parallel_for(
+        IndexRange(0, updated_bodies.size(), 1),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+                DynamicCast<RealBody>(this, updated_bodies[k])->updateCellLinkedList();
+        });
 }
 //=================================================================================================//
 void SPHSystem::initializeSystemConfigurations()
+{
+    // a relation only writes the configuration of the body it belongs to,
+    // so that the bodies are updated concurrently and the relations of each in order
+    arena_parallel_for(
+        IndexRange(0, sph_bodies_.size(), 1),
+        [&](const IndexRange &r)
+        {
+            for (size_t k = r.begin(); k != r.end(); ++k)
+            {
+                SPHBody *body = sph_bodies_[k];
+                for (size_t i = 0; i < body->body_relations_.size(); i++)
+                {
+                    if (!body->body_relations_[i]->isLazyConfiguration())
+                        body->body_relations_[i]->updateConfiguration();
+                }
+            }
+        });
+}
+//=================================================================================================//
+void SPHSystem::releaseIdleConfigurations()
 {
     for (auto &body : sph_bodies_)
     {
         for (size_t i = 0; i < body->body_relations_.size(); i++)
         {
-            body->body_relations_[i]->updateConfiguration();
+            body->body_relations_[i]->countIdleStep();
         }
     }
 }
 //=================================================================================================//
+void SPHSystem::writeMemoryReport(std::ostream &output, const std::string &json_file_name)
+{
+    memory_report_.update(*this);
+    memory_report_.writeReport(output);
+    if (!json_file_name.empty())
+    {
+        memory_report_.writeToJSON(getIOEnvironment().output_folder_ + "/" + json_file_name);
+    }
+}
+//=================================================================================================//
+void SPHSystem::setPerformanceBaseline(const std::string &baseline_prefix, Real tolerance)
+{
+    performance_baseline_ = baseline_prefix;
+    performance_tolerance_ = tolerance;
+    dynamics_profiler_.setEnabled(true);
+}
+//=================================================================================================//
+void SPHSystem::comparePerformanceWithBaseline()
+{
+    performance_metrics_.collect(dynamics_profiler_);
+    if (io_environment_ != nullptr)
+    {
+        performance_metrics_.writeToFile(io_environment_->output_folder_ + "/performance_metrics.dat");
+    }
+
+    std::string baseline_file = PerformanceMetrics::BaselineFile(performance_baseline_);
+    if (!fs::exists(baseline_file))
+    {
+        performance_metrics_.writeToFile(baseline_file);
+        std::cout << "\n The performance baseline " << baseline_file << " is recorded." << std::endl;
+    }
+    else if (!performance_metrics_.compareWithBaseline(baseline_file, performance_tolerance_, std::cout))
+    {
+        std::cout << "\n Error: the performance is worse than the baseline " << baseline_file << "!" << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+}
+//=================================================================================================//
 Real SPHSystem::getSmallestTimeStepAmongSolidBodies(Real CFL)
 {
     Real dt = MaxReal;
@@ -74,6 +193,17 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
         desc.add_options()("regression", po::value<bool>(), "Regression test.");
         desc.add_options()("state_recording", po::value<bool>(), "State recording in output folder.");
         desc.add_options()("restart_step", po::value<int>(), "Run form a restart file.");
+        desc.add_options()("profiling", po::value<bool>(), "Profiling of dynamics.");
+        desc.add_options()("performance_baseline", po::value<std::string>(), "Prefix of the performance baseline files.");
+        desc.add_options()("performance_tolerance", po::value<double>(), "Relative tolerance of the performance metrics.");
+        desc.add_options()("timeline_trace", po::value<bool>(), "Timeline trace of the dynamics and output.");
+        desc.add_options()("async_io", po::value<bool>(), "Write output in the background.");
+        desc.add_options()("observation_buffer", po::value<int>(), "Samples buffered before writing observations.");
+        desc.add_options()("level_set_cache", po::value<bool>(), "Read and write level sets from and to the cache.");
+        desc.add_options()("network_cache", po::value<bool>(), "Read and write grown networks from and to the cache.");
+        desc.add_options()("threads", po::value<int>(), "Number of threads of the arena.");
+        desc.add_options()("cpu_list", po::value<std::string>(), "Cores to pin the threads to, e.g. 0-15,32-47.");
+        desc.add_options()("deterministic_reduce", po::value<bool>(), "Reproducible parallel reductions.");
 
         po::variables_map vm;
         po::store(po::parse_command_line(ac, av, desc), vm);
@@ -144,6 +274,74 @@ SPHSystem *SPHSystem::handleCommandlineOptions(int ac, char *av[])
             std::cout << "Restart inactivated, i.e. restart_step ("
                       << restart_step_ << ").\n";
         }
+
+        if (vm.count("profiling"))
+        {
+            dynamics_profiler_.setEnabled(vm["profiling"].as<bool>());
+            std::cout << "Profiling of dynamics was set to "
+                      << vm["profiling"].as<bool>() << ".\n";
+        }
+
+        if (vm.count("performance_baseline"))
+        {
+            Real tolerance = vm.count("performance_tolerance") ? vm["performance_tolerance"].as<double>() : 0.1;
+            setPerformanceBaseline(vm["performance_baseline"].as<std::string>(), tolerance);
+            std::cout << "Performance baseline was set to "
+                      << vm["performance_baseline"].as<std::string>() << " with tolerance " << tolerance << ".\n";
+        }
+
+        if (vm.count("timeline_trace"))
+        {
+            setTimelineTrace(vm["timeline_trace"].as<bool>());
+            std::cout << "Timeline trace was set to "
+                      << vm["timeline_trace"].as<bool>() << ".\n";
+        }
+
+        if (vm.count("async_io"))
+        {
+            async_io_ = vm["async_io"].as<bool>();
+            std::cout << "Asynchronous output was set to "
+                      << vm["async_io"].as<bool>() << ".\n";
+        }
+
+        if (vm.count("observation_buffer"))
+        {
+            observation_buffer_size_ = SMAX(vm["observation_buffer"].as<int>(), 1);
+            std::cout << "Observation buffer was set to "
+                      << observation_buffer_size_ << " samples.\n";
+        }
+
+        if (vm.count("level_set_cache"))
+        {
+            level_set_cache_ = vm["level_set_cache"].as<bool>();
+            std::cout << "Level set cache was set to "
+                      << vm["level_set_cache"].as<bool>() << ".\n";
+        }
+
+        if (vm.count("network_cache"))
+        {
+            network_cache_ = vm["network_cache"].as<bool>();
+            std::cout << "Network cache was set to "
+                      << vm["network_cache"].as<bool>() << ".\n";
+        }
+
+        if (vm.count("threads") || vm.count("cpu_list"))
+        {
+            int number_of_threads = vm.count("threads") ? vm["threads"].as<int>() : thread_arena_.NumberOfThreads();
+            StdVec<int> cpu_list = vm.count("cpu_list")
+                                       ? ThreadArena::parseCpuList(vm["cpu_list"].as<std::string>())
+                                       : StdVec<int>();
+            thread_arena_.configure(number_of_threads, cpu_list);
+            std::cout << "Thread arena was set to " << number_of_threads << " threads"
+                      << (cpu_list.empty() ? "" : " pinned to the given cores") << ".\n";
+        }
+
+        if (vm.count("deterministic_reduce"))
+        {
+            DeterministicReduction::setEnabled(vm["deterministic_reduce"].as<bool>());
+            std::cout << "Deterministic reduction was set to "
+                      << vm["deterministic_reduce"].as<bool>() << ".\n";
+        }
     }
     catch (std::exception &e)
     {
@@ -37,9 +37,14 @@
 namespace po = boost::program_options;
 #endif
 
+#include "async_io_writer.h"
 #include "base_data_package.h"
+#include "dynamics_profiler.h"
 #include "execution_policy.h"
 #include "io_environment.h"
+#include "memory_report.h"
+#include "performance_metrics.h"
+#include "timeline_tracer.h"
 #include "sphinxsys_containers.h"
 
 #include <filesystem>
@@ -66,14 +71,18 @@ class SPHSystem
   public:
     BoundingBox system_domain_bounds_;       /**< Lower and Upper domain bounds. */
     Real resolution_ref_;                    /**< reference resolution of the SPH system */
-    tbb::global_control tbb_global_control_; /**< global controlling on the total number parallel threads */
+    UniquePtr<tbb::global_control> tbb_global_control_; /**< global controlling on the total number parallel threads */
+    ThreadArena thread_arena_;               /**< the arena in which the parallel loops are executed */
     SPHBodyVector sph_bodies_;               /**< All sph bodies. */
     SPHBodyVector observation_bodies_;       /**< The bodies without inner particle configuration. */
     SolidBodyVector solid_bodies_;           /**< The bodies with inner particle configuration and acoustic time steps . */
 
+    /** The process-wide thread limit is not set if is_global_control is false,
+     *  e.g. for the members of an ensemble, which are limited by their arenas. */
     SPHSystem(BoundingBox system_domain_bounds, Real resolution_ref,
-              size_t number_of_threads = std::thread::hardware_concurrency());
-    virtual ~SPHSystem(){};
+              size_t number_of_threads = std::thread::hardware_concurrency(),
+              bool is_global_control = true);
+    virtual ~SPHSystem();
 
 #ifdef BOOST_AVAILABLE
     SPHSystem *handleCommandlineOptions(int ac, char *av[]);
@@ -90,10 +99,66 @@ class SPHSystem
     void setStateRecording(bool state_recording) { state_recording_ = state_recording; };
     void setRestartStep(size_t restart_step) { restart_step_ = restart_step; };
     size_t RestartStep() { return restart_step_; };
-    /** Initialize cell linked list for the SPH system. */
+    /** profiling of the dynamics created after enabling, reported when the system is destroyed */
+    void setDynamicsProfiling(bool is_enabled) { dynamics_profiler_.setEnabled(is_enabled); };
+    DynamicsProfiler &getDynamicsProfiler() { return dynamics_profiler_; };
+    /** timeline of the dynamics, output, device synchronization and task graphs,
+     *  written as timeline_trace.json (Chrome trace format) in the output folder when the system is destroyed */
+    void setTimelineTrace(bool is_enabled) { TimelineTracer::setEnabled(is_enabled); };
+    /** the memory held by the bodies, collected at each call and printable at any step */
+    MemoryReport &getMemoryReport() { return memory_report_; };
+    /** update the memory report, write it to the output and, if given, to a JSON file in the output folder */
+    void writeMemoryReport(std::ostream &output = std::cout, const std::string &json_file_name = "");
+    /** the performance metrics are compared with the baseline of this machine when the system is destroyed,
+     *  and the run fails if one is worse than the tolerance, a missing baseline is recorded instead */
+    void setPerformanceBaseline(const std::string &baseline_prefix, Real tolerance = 0.1);
+    /** the number of threads of the arena, at most that of the system, and the cores they are pinned to */
+    void setThreadArena(int number_of_threads, const StdVec<int> &cpu_list = StdVec<int>())
+    {
+        thread_arena_.configure(number_of_threads, cpu_list);
+    };
+    /** reproducible parallel reductions with fixed chunks, independent of the number of threads */
+    void setDeterministicReduction(bool is_enabled, size_t chunk_size = 1024)
+    {
+        DeterministicReduction::setEnabled(is_enabled, chunk_size);
+    };
+    /** NUMA-aware placement of the particle data, to be set before the bodies are created */
+    void setParticleMemoryPlacement(ParticleMemoryPlacement placement, bool use_huge_pages = false)
+    {
+        ParticleMemory::setPlacement(placement, use_huge_pages);
+    };
+    /** output is written by a background thread from snapshots taken at the output calls */
+    void setAsyncIO(bool is_async, size_t queue_capacity = 4,
+                    AsyncIOQueuePolicy queue_policy = AsyncIOQueuePolicy::wait);
+    bool AsyncIO() { return async_io_; };
+    AsyncIOWriter &getAsyncIOWriter() { return async_io_writer_; };
+    /** waits until all output submitted so far is written */
+    void flushAsyncIO() { async_io_writer_.flush(); };
+    /** observed and reduced quantities are written every given number of samples,
+     *  optionally also into binary columnar files */
+    void setObservationBuffer(size_t buffer_size, bool binary_output = false)
+    {
+        observation_buffer_size_ = buffer_size;
+        observation_binary_output_ = binary_output;
+    };
+    size_t ObservationBufferSize() { return observation_buffer_size_; };
+    bool ObservationBinaryOutput() { return observation_binary_output_; };
+    /** level sets built by a level set shape of a body are cached in the reload folder */
+    void setLevelSetCache(bool level_set_cache) { level_set_cache_ = level_set_cache; };
+    bool LevelSetCache() { return level_set_cache_; };
+    /** networks grown by the network particle generator are cached in the reload folder */
+    void setNetworkCache(bool network_cache) { network_cache_ = network_cache; };
+    bool NetworkCache() { return network_cache_; };
+    /** a member of an ensemble writes its output and restart files into a sub-folder of its name,
+     *  while the input and reload folders are shared */
+    void setMemberName(const std::string &member_name) { member_name_ = member_name; };
+    std::string MemberName() { return member_name_; };
+    /** Initialize cell linked list for the SPH system, except those only used by lazy relations. */
     void initializeSystemCellLinkedLists();
-    /** Initialize particle configuration for the SPH system. */
+    /** Initialize particle configuration for the SPH system, except the lazy ones. */
     void initializeSystemConfigurations();
+    /** Called once per step, releases the neighbor storage of lazy relations not updated for a while. */
+    void releaseIdleConfigurations();
     /** get the min time step from all bodies. */
     Real getSmallestTimeStepAmongSolidBodies(Real CFL = 0.6);
     Real ReferenceResolution() { return resolution_ref_; };
@@ -108,6 +173,7 @@ class SPHSystem
 
     template <typename DataType>
     DataType *getSystemVariableDataByName(const std::string &name);
+    SingularVariables &AllSystemVariables() { return all_system_variables_; };
 
   protected:
     friend class IOEnvironment;
@@ -118,7 +184,21 @@ class SPHSystem
     size_t restart_step_;           /**< restart step */
     bool generate_regression_data_; /**< run and generate or enhance the regression test data set. */
     bool state_recording_;          /**< Record state in output folder. */
+    DynamicsProfiler dynamics_profiler_;
+    MemoryReport memory_report_;
+    bool async_io_;                 /**< write output in the background. */
+    AsyncIOWriter async_io_writer_;
+    size_t observation_buffer_size_; /**< number of samples buffered by the quantity recorders. */
+    bool observation_binary_output_; /**< write the binary columnar files of the quantity recorders. */
+    bool level_set_cache_;           /**< read and write level sets from and to the cache. */
+    bool network_cache_;             /**< read and write grown networks from and to the cache. */
+    std::string member_name_;        /**< the name of the ensemble member, empty if not a member. */
+    PerformanceMetrics performance_metrics_;
+    std::string performance_baseline_; /**< the prefix of the baseline files, empty if not compared. */
+    Real performance_tolerance_;       /**< the relative tolerance of the performance metrics. */
     SingularVariables all_system_variables_;
+
+    void comparePerformanceWithBaseline();
 };
 } // namespace SPH
 #endif // SPH_SYSTEM_H
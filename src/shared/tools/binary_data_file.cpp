@@ -0,0 +1,484 @@
+#include "binary_data_file.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SPHINXSYS_HAS_MMAP 1
+#endif
+
+#if SPHINXSYS_USE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace SPH
+{
+namespace
+{
+/** the index entry layout of version 1 files, which had neither compression nor references */
+struct BinaryDataEntryVersion1
+{
+    uint32_t type_index_;
+    uint32_t type_size_;
+    uint64_t number_of_elements_;
+    uint64_t offset_;
+};
+
+std::string fileNameOf(const std::string &filefullpath)
+{
+    size_t separator = filefullpath.find_last_of("/\\");
+    return separator == std::string::npos ? filefullpath : filefullpath.substr(separator + 1);
+}
+
+std::string folderOf(const std::string &filefullpath)
+{
+    size_t separator = filefullpath.find_last_of("/\\");
+    return separator == std::string::npos ? std::string() : filefullpath.substr(0, separator + 1);
+}
+} // namespace
+//=================================================================================================//
+uint64_t hashBinaryData(const char *data, size_t size)
+{
+    const uint64_t prime_1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t prime_2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t hash = prime_2 ^ (uint64_t(size) * prime_1);
+
+    size_t number_of_words = size / sizeof(uint64_t);
+    for (size_t i = 0; i != number_of_words; ++i)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i * sizeof(uint64_t), sizeof(uint64_t));
+        word *= prime_2;
+        word = (word << 31) | (word >> 33);
+        hash ^= word * prime_1;
+        hash = ((hash << 27) | (hash >> 37)) * prime_1 + prime_2;
+    }
+    for (size_t i = number_of_words * sizeof(uint64_t); i != size; ++i)
+    {
+        hash ^= uint64_t(static_cast<unsigned char>(data[i])) * prime_1;
+        hash = ((hash << 11) | (hash >> 53)) * prime_2;
+    }
+
+    hash ^= hash >> 33;
+    hash *= prime_2;
+    hash ^= hash >> 29;
+    return hash;
+}
+//=================================================================================================//
+bool isBinaryDataCompressionAvailable()
+{
+#if SPHINXSYS_USE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+//=================================================================================================//
+BinaryDataWriter::BinaryDataWriter(const std::string &filefullpath, BinaryDataCompression compression)
+    : filefullpath_(filefullpath), folder_(folderOf(filefullpath)), file_name_(fileNameOf(filefullpath)),
+      compression_(isBinaryDataCompressionAvailable() ? compression : BinaryDataCompression::none),
+      out_file_(filefullpath.c_str(), std::ios::trunc | std::ios::binary),
+      written_bytes_(0), referenced_bytes_(0), is_finalized_(false)
+{
+    if (!out_file_)
+    {
+        std::cout << "\n Error: the file " << filefullpath_ << " can not be created." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    BinaryDataFileHeader header; // placeholder, rewritten on finalize
+    out_file_.write(reinterpret_cast<const char *>(&header), sizeof(BinaryDataFileHeader));
+    alignToPayloadBoundary();
+}
+//=================================================================================================//
+BinaryDataWriter::~BinaryDataWriter()
+{
+    finalize();
+}
+//=================================================================================================//
+bool BinaryDataWriter::isPreviousPayloadEqual(const std::string &name, const std::string &source_file,
+                                              const char *data, size_t data_size)
+{
+    auto result = source_readers_.find(source_file);
+    if (result == source_readers_.end())
+    {
+        std::unique_ptr<BinaryDataReader> source_reader;
+        std::string source_filefullpath = folder_ + source_file;
+        if (std::ifstream(source_filefullpath.c_str(), std::ios::binary).good())
+        {
+            source_reader = std::make_unique<BinaryDataReader>(source_filefullpath, false);
+            if (!source_reader->isValid())
+                source_reader.reset();
+        }
+        result = source_readers_.emplace(source_file, std::move(source_reader)).first;
+    }
+    return result->second != nullptr && result->second->isPayloadEqual(name, data, data_size);
+}
+//=================================================================================================//
+void BinaryDataWriter::writeRawVariable(const std::string &name, uint32_t type_index, uint32_t type_size,
+                                        const char *data, size_t number_of_elements)
+{
+    size_t data_size = number_of_elements * type_size;
+    uint64_t content_hash = hashBinaryData(data, data_size);
+
+    auto previous = previous_index_.find(name);
+    if (previous != previous_index_.end() && previous->second.source_file_ != file_name_)
+    {
+        BinaryDataEntry &previous_entry = previous->second.entry_;
+        if (previous_entry.type_index_ == type_index && previous_entry.type_size_ == type_size &&
+            previous_entry.number_of_elements_ == number_of_elements &&
+            previous_entry.content_hash_ == content_hash &&
+            isPreviousPayloadEqual(name, previous->second.source_file_, data, data_size))
+        {
+            records_.push_back(std::make_pair(name, previous->second));
+            referenced_bytes_ += data_size;
+            return;
+        }
+    }
+
+    BinaryDataEntry entry{type_index, type_size, uint64_t(number_of_elements), uint64_t(out_file_.tellp()),
+                          uint64_t(data_size), content_hash, BinaryDataCompression::none, 0};
+#if SPHINXSYS_USE_ZLIB
+    if (compression_ == BinaryDataCompression::zlib && data_size != 0)
+    {
+        uLongf compressed_size = compressBound(uLong(data_size));
+        StdVec<Bytef> compressed(compressed_size);
+        if (compress2(compressed.data(), &compressed_size, reinterpret_cast<const Bytef *>(data),
+                      uLong(data_size), Z_BEST_SPEED) == Z_OK &&
+            compressed_size < data_size)
+        {
+            entry.stored_size_ = uint64_t(compressed_size);
+            entry.compression_ = BinaryDataCompression::zlib;
+            out_file_.write(reinterpret_cast<const char *>(compressed.data()), compressed_size);
+        }
+    }
+#endif
+    if (entry.compression_ == BinaryDataCompression::none)
+    {
+        out_file_.write(data, data_size);
+    }
+    written_bytes_ += entry.stored_size_;
+    records_.push_back(std::make_pair(name, BinaryDataRecord{entry, std::string()}));
+    alignToPayloadBoundary();
+}
+//=================================================================================================//
+void BinaryDataWriter::alignToPayloadBoundary()
+{
+    static const char zeros[64] = {};
+    size_t position = size_t(out_file_.tellp());
+    size_t padding = (64 - position % 64) % 64;
+    out_file_.write(zeros, padding);
+}
+//=================================================================================================//
+void BinaryDataWriter::finalize()
+{
+    if (is_finalized_)
+        return;
+
+    BinaryDataFileHeader header;
+    header.index_offset_ = uint64_t(out_file_.tellp());
+    header.number_of_entries_ = records_.size();
+    for (auto &[name, record] : records_)
+    {
+        uint32_t name_length = uint32_t(name.size());
+        out_file_.write(reinterpret_cast<const char *>(&name_length), sizeof(uint32_t));
+        out_file_.write(name.data(), name_length);
+        out_file_.write(reinterpret_cast<const char *>(&record.entry_), sizeof(BinaryDataEntry));
+        uint32_t source_length = uint32_t(record.source_file_.size());
+        out_file_.write(reinterpret_cast<const char *>(&source_length), sizeof(uint32_t));
+        out_file_.write(record.source_file_.data(), source_length);
+    }
+    out_file_.seekp(0);
+    out_file_.write(reinterpret_cast<const char *>(&header), sizeof(BinaryDataFileHeader));
+    out_file_.close();
+    is_finalized_ = true;
+}
+//=================================================================================================//
+BinaryDataIndex BinaryDataWriter::getIndex()
+{
+    BinaryDataIndex index;
+    for (auto &[name, record] : records_)
+    {
+        BinaryDataRecord &indexed = index[name] = record;
+        if (indexed.source_file_.empty())
+        {
+            indexed.source_file_ = file_name_;
+        }
+    }
+    return index;
+}
+//=================================================================================================//
+BinaryDataReader::BinaryDataReader(const std::string &filefullpath, bool exit_if_invalid)
+    : filefullpath_(filefullpath), folder_(folderOf(filefullpath)),
+      data_(nullptr), file_size_(0), mapped_address_(nullptr), is_valid_(false)
+{
+#ifdef SPHINXSYS_HAS_MMAP
+    int file_descriptor = open(filefullpath.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor >= 0 && fstat(file_descriptor, &file_status) == 0 && file_status.st_size > 0)
+    {
+        file_size_ = size_t(file_status.st_size);
+        void *address = mmap(nullptr, file_size_, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+        if (address != MAP_FAILED)
+        {
+            mapped_address_ = address;
+            data_ = static_cast<const char *>(address);
+        }
+    }
+    if (file_descriptor >= 0)
+        close(file_descriptor);
+#endif
+    if (data_ == nullptr)
+    {
+        std::ifstream in_file(filefullpath.c_str(), std::ios::binary | std::ios::ate);
+        if (!in_file)
+        {
+            std::cout << "\n Error: the file " << filefullpath_ << " can not be opened." << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        file_size_ = size_t(in_file.tellg());
+        buffer_.resize(file_size_);
+        in_file.seekg(0);
+        in_file.read(buffer_.data(), file_size_);
+        data_ = buffer_.data();
+    }
+
+    std::string error_message;
+    is_valid_ = readIndex(error_message);
+    if (!is_valid_)
+    {
+        index_.clear();
+        if (exit_if_invalid)
+        {
+            std::cout << "\n Error: the file " << filefullpath_ << " " << error_message << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+}
+//=================================================================================================//
+BinaryDataReader::~BinaryDataReader()
+{
+#ifdef SPHINXSYS_HAS_MMAP
+    if (mapped_address_ != nullptr)
+        munmap(mapped_address_, file_size_);
+#endif
+}
+//=================================================================================================//
+bool BinaryDataReader::readIndex(std::string &error_message)
+{
+    BinaryDataFileHeader header, expected;
+    if (file_size_ < sizeof(BinaryDataFileHeader))
+    {
+        error_message = "is not a binary data file.";
+        return false;
+    }
+    std::memcpy(&header, data_, sizeof(BinaryDataFileHeader));
+    if (std::memcmp(header.magic_, expected.magic_, sizeof(header.magic_)) != 0 ||
+        header.version_ > expected.version_ || header.index_offset_ > file_size_)
+    {
+        error_message = "is not a supported binary data file.";
+        return false;
+    }
+
+    size_t position = header.index_offset_;
+    // the index is checked against the file size before anything is read, so that a truncated
+    // or corrupted file is reported instead of reading beyond the mapped data
+    auto is_within_file = [&](uint64_t size)
+    { return position <= file_size_ && size <= file_size_ - position; };
+    const size_t entry_size =
+        header.version_ == 1 ? sizeof(BinaryDataEntryVersion1) : sizeof(BinaryDataEntry) + sizeof(uint32_t);
+    if (header.number_of_entries_ > (file_size_ - position) / (sizeof(uint32_t) + entry_size))
+    {
+        error_message = "has more index entries than fit in the file.";
+        return false;
+    }
+
+    for (uint64_t i = 0; i != header.number_of_entries_; ++i)
+    {
+        uint32_t name_length;
+        if (!is_within_file(sizeof(uint32_t)))
+        {
+            error_message = "has a truncated index.";
+            return false;
+        }
+        std::memcpy(&name_length, data_ + position, sizeof(uint32_t));
+        position += sizeof(uint32_t);
+        if (!is_within_file(name_length))
+        {
+            error_message = "has a variable name beyond the end of the file.";
+            return false;
+        }
+        std::string name(data_ + position, name_length);
+        position += name_length;
+
+        BinaryDataRecord record;
+        if (!is_within_file(entry_size))
+        {
+            error_message = "has a truncated index entry of " + name + ".";
+            return false;
+        }
+        if (header.version_ == 1)
+        {
+            BinaryDataEntryVersion1 entry;
+            std::memcpy(&entry, data_ + position, sizeof(BinaryDataEntryVersion1));
+            position += sizeof(BinaryDataEntryVersion1);
+            record.entry_ = BinaryDataEntry{entry.type_index_, entry.type_size_, entry.number_of_elements_,
+                                            entry.offset_, entry.number_of_elements_ * entry.type_size_,
+                                            0, BinaryDataCompression::none, 0};
+        }
+        else
+        {
+            std::memcpy(&record.entry_, data_ + position, sizeof(BinaryDataEntry));
+            position += sizeof(BinaryDataEntry);
+            uint32_t source_length;
+            std::memcpy(&source_length, data_ + position, sizeof(uint32_t));
+            position += sizeof(uint32_t);
+            if (!is_within_file(source_length))
+            {
+                error_message = "has a source file name of " + name + " beyond the end of the file.";
+                return false;
+            }
+            record.source_file_.assign(data_ + position, source_length);
+            position += source_length;
+        }
+
+        // the payload of a variable referring to another file is checked when that file is read
+        if (record.source_file_.empty() &&
+            (record.entry_.offset_ > file_size_ || record.entry_.stored_size_ > file_size_ - record.entry_.offset_))
+        {
+            error_message = "has the data of " + name + " beyond the end of the file.";
+            return false;
+        }
+        index_[name] = record;
+    }
+    return true;
+}
+//=================================================================================================//
+bool BinaryDataReader::hasRawVariable(const std::string &name, uint32_t type_index, uint32_t type_size,
+                                      size_t number_of_elements)
+{
+    auto result = index_.find(name);
+    if (result == index_.end())
+        return false;
+
+    const BinaryDataEntry &entry = result->second.entry_;
+    return entry.type_index_ == type_index && entry.type_size_ == type_size &&
+           entry.number_of_elements_ == number_of_elements &&
+           (!result->second.source_file_.empty() || entry.offset_ + entry.stored_size_ <= file_size_);
+}
+//=================================================================================================//
+size_t BinaryDataReader::readRawVariable(const std::string &name, uint32_t type_index, uint32_t type_size,
+                                         char *data, size_t capacity)
+{
+    auto result = index_.find(name);
+    if (result == index_.end())
+    {
+        std::cout << "\n Error: the variable " << name << " is not found in " << filefullpath_ << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    BinaryDataRecord &record = result->second;
+    if (record.entry_.type_index_ != type_index || record.entry_.type_size_ != type_size)
+    {
+        std::cout << "\n Error: the type of variable " << name << " in " << filefullpath_
+                  << " does not match, e.g. written with a different precision." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    if (record.source_file_.empty())
+    {
+        copyPayload(name, record.entry_, data, capacity);
+    }
+    else
+    {
+        auto &source_reader = source_readers_[record.source_file_];
+        if (source_reader == nullptr)
+        {
+            source_reader = std::make_unique<BinaryDataReader>(folder_ + record.source_file_);
+        }
+        auto source = source_reader->index_.find(name);
+        if (source == source_reader->index_.end() || !source->second.source_file_.empty() ||
+            source->second.entry_.content_hash_ != record.entry_.content_hash_)
+        {
+            std::cout << "\n Error: the variable " << name << " referred by " << filefullpath_
+                      << " is not found, or has been changed, in " << record.source_file_ << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        source_reader->copyPayload(name, source->second.entry_, data, capacity);
+    }
+    return SMIN(size_t(record.entry_.number_of_elements_), capacity);
+}
+//=================================================================================================//
+bool BinaryDataReader::isPayloadEqual(const std::string &name, const char *data, size_t data_size)
+{
+    auto result = index_.find(name);
+    if (result == index_.end() || !result->second.source_file_.empty())
+        return false;
+
+    const BinaryDataEntry &entry = result->second.entry_;
+    if (entry.number_of_elements_ * entry.type_size_ != data_size ||
+        entry.offset_ > file_size_ || entry.stored_size_ > file_size_ - entry.offset_)
+        return false;
+
+    if (entry.compression_ == BinaryDataCompression::none)
+    {
+        return std::memcmp(data_ + entry.offset_, data, data_size) == 0;
+    }
+    if (entry.compression_ != BinaryDataCompression::zlib || !isBinaryDataCompressionAvailable())
+        return false;
+    StdVec<char> payload(data_size);
+    copyPayload(name, entry, payload.data(), size_t(entry.number_of_elements_));
+    return std::memcmp(payload.data(), data, data_size) == 0;
+}
+//=================================================================================================//
+void BinaryDataReader::copyPayload(const std::string &name, const BinaryDataEntry &entry,
+                                   char *data, size_t capacity)
+{
+    size_t copy_size = SMIN(size_t(entry.number_of_elements_), capacity) * entry.type_size_;
+    if (entry.offset_ + entry.stored_size_ > file_size_)
+    {
+        std::cout << "\n Error: the variable " << name << " in " << filefullpath_ << " is truncated." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    if (entry.compression_ == BinaryDataCompression::none)
+    {
+        std::memcpy(data, data_ + entry.offset_, copy_size);
+        return;
+    }
+#if SPHINXSYS_USE_ZLIB
+    if (entry.compression_ == BinaryDataCompression::zlib)
+    {
+        size_t data_size = entry.number_of_elements_ * entry.type_size_;
+        StdVec<char> uncompressed_buffer;
+        char *destination = data;
+        if (copy_size < data_size)
+        {
+            uncompressed_buffer.resize(data_size);
+            destination = uncompressed_buffer.data();
+        }
+        uLongf uncompressed_size = uLongf(data_size);
+        if (uncompress(reinterpret_cast<Bytef *>(destination), &uncompressed_size,
+                       reinterpret_cast<const Bytef *>(data_ + entry.offset_), uLong(entry.stored_size_)) == Z_OK &&
+            uncompressed_size == data_size)
+        {
+            if (destination != data)
+                std::memcpy(data, destination, copy_size);
+            return;
+        }
+    }
+#endif
+    std::cout << "\n Error: the variable " << name << " in " << filefullpath_
+              << " can not be decompressed, e.g. SPHinXsys is built without SPHINXSYS_USE_ZLIB." << std::endl;
+    std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+    exit(1);
+}
+//=================================================================================================//
+} // namespace SPH
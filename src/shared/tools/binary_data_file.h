@@ -0,0 +1,194 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    binary_data_file.h
+ * @brief   A versioned, self-describing binary container for particle variables.
+ * @details The file starts with a fixed header, followed by the contiguous
+ *          payloads (aligned to 64 bytes) and an index at the end. Each index entry
+ *          records the name, type index, type size, number of elements, the offset
+ *          and stored size of a payload, its compression and a content hash.
+ *          An entry may also refer to the payload of an earlier file in the same folder,
+ *          which is used for incremental checkpoints of unchanged variables.
+ *          The reader maps the file into memory so that reading an uncompressed
+ *          variable is a single memcpy.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef BINARY_DATA_FILE_H
+#define BINARY_DATA_FILE_H
+
+#include "base_data_package.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace SPH
+{
+struct BinaryDataFileHeader
+{
+    char magic_[8] = {'S', 'P', 'H', 'X', 'B', 'I', 'N', '\0'};
+    uint32_t version_ = 2;
+    uint32_t reserved_ = 0;
+    uint64_t index_offset_ = 0;
+    uint64_t number_of_entries_ = 0;
+};
+
+enum class BinaryDataCompression : uint32_t
+{
+    none = 0,
+    zlib = 1
+};
+
+struct BinaryDataEntry
+{
+    uint32_t type_index_;
+    uint32_t type_size_;
+    uint64_t number_of_elements_;
+    uint64_t offset_;
+    uint64_t stored_size_;  /**< bytes in the file, differs from the data size if compressed */
+    uint64_t content_hash_; /**< hash of the uncompressed data */
+    BinaryDataCompression compression_;
+    uint32_t reserved_;
+};
+
+/** index entry together with the file holding its payload, empty for the file itself */
+struct BinaryDataRecord
+{
+    BinaryDataEntry entry_;
+    std::string source_file_;
+};
+using BinaryDataIndex = std::map<std::string, BinaryDataRecord>;
+
+uint64_t hashBinaryData(const char *data, size_t size);
+bool isBinaryDataCompressionAvailable();
+
+/**
+ * @class BinaryDataWriter
+ * @brief Writes variables one by one, the index and header are written on finalize.
+ * @details With a previous index given, a variable whose type, size and content hash
+ *          are unchanged is not written again but refers to the file holding its payload.
+ *          The payload in that file is compared byte by byte before it is referred,
+ *          so that a hash collision or a changed file does not lose data.
+ */
+class BinaryDataReader;
+class BinaryDataWriter
+{
+  public:
+    explicit BinaryDataWriter(const std::string &filefullpath,
+                              BinaryDataCompression compression = BinaryDataCompression::none);
+    ~BinaryDataWriter();
+
+    void setPreviousIndex(const BinaryDataIndex &previous_index) { previous_index_ = previous_index; };
+    template <typename DataType>
+    void writeVariable(const std::string &name, const DataType *data, size_t number_of_elements)
+    {
+        writeRawVariable(name, uint32_t(DataTypeIndex<DataType>::value), uint32_t(sizeof(DataType)),
+                         reinterpret_cast<const char *>(data), number_of_elements);
+    };
+    void finalize();
+    /** the index of the written file, with the source files all given by name */
+    BinaryDataIndex getIndex();
+    size_t WrittenBytes() { return written_bytes_; };
+    size_t ReferencedBytes() { return referenced_bytes_; };
+
+  protected:
+    std::string filefullpath_;
+    std::string folder_;
+    std::string file_name_;
+    BinaryDataCompression compression_;
+    std::ofstream out_file_;
+    StdVec<std::pair<std::string, BinaryDataRecord>> records_;
+    BinaryDataIndex previous_index_;
+    size_t written_bytes_;
+    size_t referenced_bytes_;
+    bool is_finalized_;
+    /** readers of the files holding the previous payloads, nullptr if not readable */
+    std::map<std::string, std::unique_ptr<BinaryDataReader>> source_readers_;
+
+    bool isPreviousPayloadEqual(const std::string &name, const std::string &source_file,
+                                const char *data, size_t data_size);
+    void writeRawVariable(const std::string &name, uint32_t type_index, uint32_t type_size,
+                          const char *data, size_t number_of_elements);
+    void alignToPayloadBoundary();
+};
+
+/**
+ * @class BinaryDataReader
+ * @brief Maps a binary data file into memory and copies variables out by name.
+ * @details Payloads referred from other files are read from those files,
+ *          which are expected in the same folder.
+ */
+class BinaryDataReader
+{
+  public:
+    /** with exit_if_invalid false, an invalid file, e.g. a truncated cache file,
+     *  gives an empty index and isValid() returns false */
+    explicit BinaryDataReader(const std::string &filefullpath, bool exit_if_invalid = true);
+    ~BinaryDataReader();
+
+    bool isValid() { return is_valid_; };
+    bool hasVariable(const std::string &name) { return index_.find(name) != index_.end(); };
+    /** whether the variable is stored with the given type and number of elements
+     *  and, if stored in this file, its payload is complete */
+    template <typename DataType>
+    bool hasVariable(const std::string &name, size_t number_of_elements)
+    {
+        return hasRawVariable(name, uint32_t(DataTypeIndex<DataType>::value), uint32_t(sizeof(DataType)),
+                              number_of_elements);
+    };
+    /** copies at most capacity elements and returns the number of elements copied */
+    template <typename DataType>
+    size_t readVariable(const std::string &name, DataType *data, size_t capacity)
+    {
+        return readRawVariable(name, uint32_t(DataTypeIndex<DataType>::value), uint32_t(sizeof(DataType)),
+                               reinterpret_cast<char *>(data), capacity);
+    };
+    BinaryDataIndex &getIndex() { return index_; };
+    /** whether the variable is stored in this file, not referred, with exactly the given bytes */
+    bool isPayloadEqual(const std::string &name, const char *data, size_t data_size);
+
+  protected:
+    std::string filefullpath_;
+    std::string folder_;
+    const char *data_;
+    size_t file_size_;
+    void *mapped_address_; /**< nullptr if the file is read into the buffer instead */
+    StdVec<char> buffer_;
+    BinaryDataIndex index_;
+    bool is_valid_;
+    std::map<std::string, std::unique_ptr<BinaryDataReader>> source_readers_;
+
+    /** returns false with the error message if the file is not a valid binary data file */
+    bool readIndex(std::string &error_message);
+    bool hasRawVariable(const std::string &name, uint32_t type_index, uint32_t type_size,
+                        size_t number_of_elements);
+    size_t readRawVariable(const std::string &name, uint32_t type_index, uint32_t type_size,
+                           char *data, size_t capacity);
+    void copyPayload(const std::string &name, const BinaryDataEntry &entry, char *data, size_t capacity);
+};
+} // namespace SPH
+#endif // BINARY_DATA_FILE_H
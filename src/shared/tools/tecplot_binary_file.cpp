@@ -0,0 +1,133 @@
+#include "tecplot_binary_file.h"
+
+#include <algorithm>
+
+namespace SPH
+{
+//=================================================================================================//
+TecplotZone &TecplotBinaryWriter::addZone(const StdVec<std::string> &variable_names, const std::string &zone_name,
+                                          const Array3i &zone_size, double solution_time)
+{
+    if (zones_.empty())
+    {
+        variable_names_ = variable_names;
+    }
+    else if (variable_names != variable_names_)
+    {
+        std::cout << "\n Error: the variables of zone " << zone_name << " differ from those of the former zones." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+
+    zones_.push_back(TecplotZone{zone_name, zone_size, solution_time, StdVec<StdVec<Real>>()});
+    TecplotZone &zone = zones_.back();
+    zone.variables_.resize(variable_names_.size(), StdVec<Real>(zone.NumberOfPoints()));
+    return zone;
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeInt32(std::ostream &output_stream, int32_t value)
+{
+    output_stream.write(reinterpret_cast<const char *>(&value), sizeof(int32_t));
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeFloat32(std::ostream &output_stream, float value)
+{
+    output_stream.write(reinterpret_cast<const char *>(&value), sizeof(float));
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeFloat64(std::ostream &output_stream, double value)
+{
+    output_stream.write(reinterpret_cast<const char *>(&value), sizeof(double));
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeString(std::ostream &output_stream, const std::string &value)
+{
+    for (char character : value)
+    {
+        writeInt32(output_stream, int32_t(character));
+    }
+    writeInt32(output_stream, 0);
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeZoneHeader(std::ostream &output_stream, const TecplotZone &zone)
+{
+    writeFloat32(output_stream, 299.0f); // zone marker
+    writeString(output_stream, zone.name_);
+    writeInt32(output_stream, -1); // parent zone
+    writeInt32(output_stream, -1); // strand id, static zone
+    writeFloat64(output_stream, zone.solution_time_);
+    writeInt32(output_stream, -1); // zone color, not used
+    writeInt32(output_stream, 0);  // ordered zone
+    writeInt32(output_stream, 0);  // all data located at the nodes
+    writeInt32(output_stream, 0);  // no raw local face neighbors
+    writeInt32(output_stream, 0);  // no user-defined face neighbor connections
+    for (int n = 0; n != 3; ++n)
+    {
+        writeInt32(output_stream, zone.size_[n]);
+    }
+    writeInt32(output_stream, 0); // no auxiliary data
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeZoneData(std::ostream &output_stream, const TecplotZone &zone)
+{
+    constexpr int32_t data_format = sizeof(Real) == sizeof(double) ? 2 : 1; // 1 float and 2 double
+    writeFloat32(output_stream, 299.0f);                                    // zone marker
+    for (size_t i = 0; i != variable_names_.size(); ++i)
+    {
+        writeInt32(output_stream, data_format);
+    }
+    writeInt32(output_stream, 0);  // no passive variables
+    writeInt32(output_stream, 0);  // no variable sharing
+    writeInt32(output_stream, -1); // no connectivity sharing
+
+    for (const StdVec<Real> &variable : zone.variables_)
+    {
+        auto min_max = std::minmax_element(variable.begin(), variable.end());
+        writeFloat64(output_stream, variable.empty() ? 0.0 : double(*min_max.first));
+        writeFloat64(output_stream, variable.empty() ? 0.0 : double(*min_max.second));
+    }
+
+    for (const StdVec<Real> &variable : zone.variables_)
+    {
+        output_stream.write(reinterpret_cast<const char *>(variable.data()), variable.size() * sizeof(Real));
+    }
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeToStream(std::ostream &output_stream)
+{
+    output_stream.write("#!TDV112", 8);
+    writeInt32(output_stream, 1); // byte order
+    writeInt32(output_stream, 0); // full file type
+    writeString(output_stream, title_);
+    writeInt32(output_stream, int32_t(variable_names_.size()));
+    for (const std::string &variable_name : variable_names_)
+    {
+        writeString(output_stream, variable_name);
+    }
+
+    for (const TecplotZone &zone : zones_)
+    {
+        writeZoneHeader(output_stream, zone);
+    }
+    writeFloat32(output_stream, 357.0f); // end of header marker
+
+    for (const TecplotZone &zone : zones_)
+    {
+        writeZoneData(output_stream, zone);
+    }
+}
+//=================================================================================================//
+void TecplotBinaryWriter::writeToFile(const std::string &filefullpath)
+{
+    std::ofstream out_file(filefullpath.c_str(), std::ios::trunc | std::ios::binary);
+    if (!out_file)
+    {
+        std::cout << "\n Error: the file " << filefullpath << " can not be created." << std::endl;
+        std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+        exit(1);
+    }
+    writeToStream(out_file);
+    out_file.close();
+}
+//=================================================================================================//
+} // namespace SPH
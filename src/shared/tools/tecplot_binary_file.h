@@ -0,0 +1,101 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file    tecplot_binary_file.h
+ * @brief   Writer of ordered zones in the binary Tecplot data format (version 112).
+ * @details In this format, all zone headers precede the zone data,
+ *          and the data of each zone are always in block packing, i.e. variable by variable.
+ *          Therefore, the zones are kept in buffers, which are filled by the caller,
+ *          possibly in parallel, and the file is written at once with whole variable arrays.
+ * @author  Xiangyu Hu
+ */
+
+#ifndef TECPLOT_BINARY_FILE_H
+#define TECPLOT_BINARY_FILE_H
+
+#include "base_data_package.h"
+
+#include <fstream>
+#include <list>
+#include <string>
+
+namespace SPH
+{
+/**
+ * @struct TecplotZone
+ * @brief An ordered zone with the data of all variables.
+ * The data index varies fastest in i, then j and k directions.
+ */
+struct TecplotZone
+{
+    std::string name_;
+    Array3i size_;
+    double solution_time_;
+    StdVec<StdVec<Real>> variables_;
+
+    size_t NumberOfPoints() const { return size_t(size_[0]) * size_[1] * size_[2]; };
+    /** the index of a point in the data of a variable */
+    size_t PointIndex(const Array2i &index) const { return index[0] + size_t(size_[0]) * index[1]; };
+    size_t PointIndex(const Array3i &index) const
+    {
+        return index[0] + size_t(size_[0]) * (index[1] + size_t(size_[1]) * index[2]);
+    };
+    Real *VariableData(size_t variable_index) { return variables_[variable_index].data(); };
+};
+
+/**
+ * @class TecplotBinaryWriter
+ * @brief Collects ordered zones sharing the same variables and writes them into a binary plt file.
+ * The variables are given by the first zone so that, e.g. the levels of a multilevel mesh
+ * can be added one by one without knowing the variables in advance.
+ * The data are written in the precision of Real.
+ */
+class TecplotBinaryWriter
+{
+  public:
+    explicit TecplotBinaryWriter(const std::string &title) : title_(title){};
+    ~TecplotBinaryWriter(){};
+
+    const StdVec<std::string> &VariableNames() { return variable_names_; };
+    /** Returns the zone with allocated data to be filled by the caller.
+     *  The reference is stable while other zones are added. */
+    TecplotZone &addZone(const StdVec<std::string> &variable_names, const std::string &zone_name,
+                         const Array3i &zone_size, double solution_time = 0.0);
+    void writeToStream(std::ostream &output_stream);
+    void writeToFile(const std::string &filefullpath);
+
+  protected:
+    std::string title_;
+    StdVec<std::string> variable_names_;
+    std::list<TecplotZone> zones_; /**< list for stable addresses */
+
+    void writeInt32(std::ostream &output_stream, int32_t value);
+    void writeFloat32(std::ostream &output_stream, float value);
+    void writeFloat64(std::ostream &output_stream, double value);
+    /** string as null-terminated 32 bit integers, one for each character */
+    void writeString(std::ostream &output_stream, const std::string &value);
+    void writeZoneHeader(std::ostream &output_stream, const TecplotZone &zone);
+    void writeZoneData(std::ostream &output_stream, const TecplotZone &zone);
+};
+} // namespace SPH
+#endif // TECPLOT_BINARY_FILE_H
@@ -0,0 +1,79 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	particle_memory_sycl.h
+ * @brief 	Pinned host memory for the particle variables, with which the transfers to the device are faster.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef PARTICLE_MEMORY_SYCL_H
+#define PARTICLE_MEMORY_SYCL_H
+
+#include "execution_sycl.h"
+#include "particle_memory.h"
+
+namespace SPH
+{
+/**
+ * @class PinnedHostMemoryResource
+ * @brief The fields are allocated as page-locked host memory of the device queue.
+ *        To be used with ParticleMemory::setResourceFactory before the bodies are created.
+ */
+class PinnedHostMemoryResource : public ParticleMemoryResource
+{
+  public:
+    PinnedHostMemoryResource() : reserved_bytes_(0){};
+    virtual ~PinnedHostMemoryResource(){};
+
+    virtual void *allocate(size_t bytes) override
+    {
+        void *data = sycl::aligned_alloc_host(alignment, SMAX(bytes, size_t(1)),
+                                              execution::execution_instance.getQueue());
+        if (data == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        reserved_bytes_ += bytes;
+        return data;
+    };
+
+    virtual void deallocate(void *data, size_t bytes) override
+    {
+        sycl::free(data, execution::execution_instance.getQueue());
+        reserved_bytes_ -= bytes;
+    };
+
+    virtual size_t ReservedBytes() override { return reserved_bytes_; };
+
+    static void usePinnedHostMemory()
+    {
+        ParticleMemory::setResourceFactory(
+            []()
+            { return UniquePtr<ParticleMemoryResource>(makeUnique<PinnedHostMemoryResource>()); });
+    };
+
+  protected:
+    std::atomic<size_t> reserved_bytes_;
+};
+} // namespace SPH
+#endif // PARTICLE_MEMORY_SYCL_H
@@ -0,0 +1,13 @@
+#include "sphinxsys_variable_sycl.hpp"
+
+namespace SPH
+{
+//=================================================================================================//
+void waitForOutputTransfers(const ParallelDevicePolicy &par_device)
+{
+    static const std::string timeline_name = "waitForOutputTransfers";
+    TimelineTracer::Scope timeline_scope("device", timeline_name);
+    execution_instance.waitForPendingTransfers();
+}
+//=================================================================================================//
+} // namespace SPH
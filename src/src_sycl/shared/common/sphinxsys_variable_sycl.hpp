@@ -3,6 +3,7 @@
 
 #include "execution_sycl.h"
 #include "sphinxsys_variable.h"
+#include "timeline_tracer.h"
 
 namespace SPH
 {
@@ -26,9 +27,21 @@ DeviceSharedSingularVariable<DataType>::~DeviceSharedSingularVariable()
 template <typename DataType>
 void DiscreteVariable<DataType>::synchronizeWithDevice()
 {
-    if (existDeviceDataField())
+    if (existDeviceDataField() && synchronized_version_ != execution_instance.DeviceDataVersion())
     {
+        TimelineTracer::Scope timeline_scope("device", this->name_);
         copyFromDevice(data_field_, device_data_field_, data_size_);
+        synchronized_version_ = execution_instance.DeviceDataVersion();
+    }
+}
+//=================================================================================================//
+template <typename DataType>
+void DiscreteVariable<DataType>::enqueueSynchronizationWithDevice()
+{
+    if (existDeviceDataField() && synchronized_version_ != execution_instance.DeviceDataVersion())
+    {
+        copyFromDeviceAsync(data_field_, device_data_field_, data_size_);
+        synchronized_version_ = execution_instance.DeviceDataVersion();
     }
 }
 //=================================================================================================//
@@ -37,7 +50,9 @@ void DiscreteVariable<DataType>::synchronizeToDevice()
 {
     if (existDeviceDataField())
     {
+        TimelineTracer::Scope timeline_scope("device", this->name_);
         copyToDevice(data_field_, device_data_field_, data_size_);
+        synchronized_version_ = execution_instance.DeviceDataVersion();
     }
 }
 //=================================================================================================//
@@ -71,11 +86,13 @@ void DeviceOnlyDiscreteVariable<DataType>::
 template <typename DataType>
 DataType *DiscreteVariable<DataType>::DelegatedDataField(const ParallelDevicePolicy &par_device)
 {
+    recordDataTraffic();
     if (!existDeviceDataField())
     {
         device_only_variable_ =
             device_only_variable_keeper_
                 .createPtr<DeviceOnlyDiscreteVariable<DataType>>(this);
+        synchronized_version_ = execution_instance.DeviceDataVersion();
     }
     return device_data_field_;
 }
@@ -88,6 +105,7 @@ void DiscreteVariable<DataType>::reallocateDataField(
     {
         reallocateDataField(tentative_size);
         device_only_variable_->reallocateDataField(this);
+        synchronized_version_ = 0;
     }
 }
 //=================================================================================================//
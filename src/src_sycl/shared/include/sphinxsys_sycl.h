@@ -30,6 +30,7 @@
 
 #include "base_configuration_dynamics_sycl.h"
 #include "particle_iterators_sycl.h"
+#include "particle_memory_sycl.h"
 #include "particle_sort_sycl.h"
 #include "particle_sort_sycl.hpp"
 #include "sphinxsys_ck.h"
@@ -50,5 +50,15 @@ class RadixSort
     DiscreteVariable<UnsignedInt> *dv_sequence_;
     DiscreteVariable<UnsignedInt> *dv_index_permutation_;
 };
+
+/** On device, small blocks give one work-item per block and enough work-items to occupy the device. */
+template <>
+struct RadixSortBlocks<ParallelDevicePolicy>
+{
+    static UnsignedInt number(UnsignedInt data_size)
+    {
+        return SMAX(UnsignedInt(1), (data_size + 255) / 256);
+    };
+};
 } // namespace SPH
 #endif // PARTICLE_SORT_SYCL_H
@@ -34,6 +34,8 @@
 #include "execution_policy.h"
 
 #include "ownership.h"
+#include <cstdlib>
+#include <iostream>
 #include <sycl/sycl.hpp>
 
 namespace SPH
@@ -45,6 +47,13 @@ class ExecutionInstance
   public:
     ExecutionInstance(ExecutionInstance const &) = delete;
     void operator=(ExecutionInstance const &) = delete;
+    ~ExecutionInstance()
+    {
+        if (device_scratch_ != nullptr)
+        {
+            sycl::free(device_scratch_, *sycl_queue_);
+        }
+    };
 
     static ExecutionInstance &getInstance()
     {
@@ -55,10 +64,79 @@ class ExecutionInstance
     sycl::queue &getQueue()
     {
         if (!sycl_queue_)
-            sycl_queue_ = makeUnique<sycl::queue>(sycl::default_selector_v);
+        {
+            if (device_index_ < 0)
+            {
+                sycl_queue_ = makeUnique<sycl::queue>(sycl::default_selector_v);
+            }
+            else
+            {
+                sycl_queue_ = makeUnique<sycl::queue>(getDevices()[device_index_]);
+            }
+            if (is_hybrid_execution_ && !sycl_queue_->get_device().has(sycl::aspect::usm_shared_allocations))
+            {
+                std::cout << "\n Error: the hybrid execution requires a device with shared allocations!" << std::endl;
+                std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                exit(1);
+            }
+        }
         return *sycl_queue_;
     }
 
+    /** the GPU devices, or all devices if there is no GPU */
+    static std::vector<sycl::device> getDevices()
+    {
+        std::vector<sycl::device> devices = sycl::device::get_devices(sycl::info::device_type::gpu);
+        return devices.empty() ? sycl::device::get_devices() : devices;
+    }
+
+    /** selects the device by its index in getDevices(), must be called before the first use of the queue */
+    void setDevice(int device_index)
+    {
+        if (sycl_queue_)
+        {
+            std::cout << "\n Error: the device is selected after the SYCL queue is created!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        int number_of_devices = int(getDevices().size());
+        if (device_index < 0 || device_index >= number_of_devices)
+        {
+            std::cout << "\n Error: the device index " << device_index << " is not in the range of "
+                      << number_of_devices << " available devices!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        device_index_ = device_index;
+    }
+
+    /**
+     * Enables ParallelHybridPolicy loops to be split between the device and the host threads.
+     * The device data are then allocated as shared memory, which the host accesses directly.
+     * The device is expected to allow concurrent host and device access to shared allocations,
+     * e.g. an integrated GPU or a GPU with unified memory.
+     * A device fraction in (0, 1) fixes the share of the device, otherwise it is balanced
+     * for each loop from the measured throughput. Must be called before the first use of the queue.
+     */
+    void enableHybridExecution(Real device_fraction = 0.0)
+    {
+        if (sycl_queue_)
+        {
+            std::cout << "\n Error: the hybrid execution is enabled after the SYCL queue is created!" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+        is_hybrid_execution_ = true;
+        is_hybrid_fraction_fixed_ = device_fraction > 0.0 && device_fraction < 1.0;
+        if (is_hybrid_fraction_fixed_)
+        {
+            hybrid_device_fraction_ = device_fraction;
+        }
+    }
+    bool isHybridExecution() const { return is_hybrid_execution_; };
+    bool isHybridFractionFixed() const { return is_hybrid_fraction_fixed_; };
+    Real HybridDeviceFraction() const { return hybrid_device_fraction_; };
+
     auto getWorkGroupSize() const
     {
         return work_group_size_;
@@ -80,20 +158,111 @@ class ExecutionInstance
         return getUniformNdRange(global_size, work_group_size_);
     }
 
+    /** increased after each device kernel, as any variable delegated to the device may be changed */
+    void increaseDeviceDataVersion() { ++device_data_version_; };
+    size_t DeviceDataVersion() const { return device_data_version_; };
+
+    /** transfers enqueued without waiting, so that they overlap each other */
+    void addPendingTransfer(sycl::event &&transfer) { pending_transfers_.push_back(std::move(transfer)); };
+    void waitForPendingTransfers()
+    {
+        sycl::event::wait_and_throw(pending_transfers_);
+        pending_transfers_.clear();
+    };
+
+    /** grow-only device memory for temporary data of device algorithms, e.g. the chunk sums of a scan */
+    template <typename T>
+    T *getDeviceScratch(size_t size)
+    {
+        size_t scratch_bytes = size * sizeof(T);
+        if (scratch_bytes > device_scratch_bytes_)
+        {
+            if (device_scratch_ != nullptr)
+            {
+                sycl::free(device_scratch_, getQueue());
+            }
+            device_scratch_ = sycl::malloc_device<char>(scratch_bytes, getQueue());
+            device_scratch_bytes_ = scratch_bytes;
+        }
+        return reinterpret_cast<T *>(device_scratch_);
+    };
+
   private:
-    ExecutionInstance() : work_group_size_(128), sycl_queue_() {}
+    ExecutionInstance()
+        : work_group_size_(128), sycl_queue_(), device_data_version_(1), device_index_(-1),
+          device_scratch_(nullptr), device_scratch_bytes_(0),
+          is_hybrid_execution_(false), is_hybrid_fraction_fixed_(false), hybrid_device_fraction_(0.5)
+    {
+        if (const char *device_index = std::getenv("SPHINXSYS_SYCL_DEVICE"))
+        {
+            setDevice(std::atoi(device_index));
+        }
+        if (const char *device_fraction = std::getenv("SPHINXSYS_HYBRID_EXECUTION"))
+        {
+            enableHybridExecution(Real(std::atof(device_fraction)));
+        }
+    }
 
     size_t work_group_size_;
     UniquePtr<sycl::queue> sycl_queue_;
+    size_t device_data_version_; /**< starts from 1, version 0 means never synchronized */
+    std::vector<sycl::event> pending_transfers_;
+    int device_index_; /**< negative for the default device */
+    char *device_scratch_;
+    size_t device_scratch_bytes_;
+    bool is_hybrid_execution_;
+    bool is_hybrid_fraction_fixed_;
+    Real hybrid_device_fraction_; /**< the initial or fixed share of a hybrid loop on the device */
 
 } static &execution_instance = ExecutionInstance::getInstance();
 
+/**
+ * @class HybridLoadBalance
+ * @brief The device share of a hybrid loop, balanced so that the device and host parts finish together.
+ *        If the device is still running when the host part is done, the share follows the measured rates.
+ *        Otherwise, the device finished earlier than can be timed and the share is increased by a small step.
+ */
+class HybridLoadBalance
+{
+  public:
+    HybridLoadBalance() : device_fraction_(execution_instance.HybridDeviceFraction()){};
+    size_t DeviceSize(size_t loop_size) const { return size_t(device_fraction_ * Real(loop_size)); };
+
+    void update(size_t device_size, size_t host_size, double host_time, double device_time, bool is_device_waited)
+    {
+        if (execution_instance.isHybridFractionFixed())
+        {
+            return;
+        }
+
+        if (!is_device_waited)
+        {
+            device_fraction_ = SMIN(device_fraction_ + Real(0.02), Real(0.99));
+        }
+        else if (device_size != 0 && host_size != 0 && host_time > 0.0 && device_time > 0.0)
+        {
+            double device_rate = double(device_size) / device_time;
+            double host_rate = double(host_size) / host_time;
+            Real balanced_fraction = Real(device_rate / (device_rate + host_rate));
+            device_fraction_ = SMAX(Real(0.01), SMIN(Real(0.5) * (device_fraction_ + balanced_fraction), Real(0.99)));
+        }
+    };
+
+  private:
+    Real device_fraction_;
+};
+
 } // namespace execution
 
 /* SYCL memory transfer utilities */
+/** shared memory with hybrid execution, so that the host threads access the device data */
 template <class T>
 inline T *allocateDeviceOnly(std::size_t size)
 {
+    if (execution::execution_instance.isHybridExecution())
+    {
+        return sycl::malloc_shared<T>(size, execution::execution_instance.getQueue());
+    }
     return sycl::malloc_device<T>(size, execution::execution_instance.getQueue());
 }
 
@@ -127,6 +296,14 @@ inline void copyFromDevice(T *host, const T *device, std::size_t size)
     execution::execution_instance.getQueue().memcpy(host, device, size * sizeof(T)).wait_and_throw();
 }
 
+/** the transfer is completed only after waitForPendingTransfers() */
+template <class T>
+inline void copyFromDeviceAsync(T *host, const T *device, std::size_t size)
+{
+    execution::execution_instance.addPendingTransfer(
+        execution::execution_instance.getQueue().memcpy(host, device, size * sizeof(T)));
+}
+
 namespace execution
 {
 template <class LocalDynamicsType, class ComputingKernelType>
@@ -180,6 +357,16 @@ class Implementation<ParallelDevicePolicy, LocalDynamicsType, ComputingKernelTyp
     LocalDynamicsType &local_dynamics_;
     ComputingKernelType *computing_kernel_;
 };
+
+/** the kernels of a hybrid loop are those on the device, which are in shared memory with hybrid execution */
+template <class LocalDynamicsType, class ComputingKernelType>
+class Implementation<ParallelHybridPolicy, LocalDynamicsType, ComputingKernelType>
+    : public Implementation<ParallelDevicePolicy, LocalDynamicsType, ComputingKernelType>
+{
+  public:
+    explicit Implementation(LocalDynamicsType &local_dynamics)
+        : Implementation<ParallelDevicePolicy, LocalDynamicsType, ComputingKernelType>(local_dynamics) {}
+};
 } // namespace execution
 } // namespace SPH
 #endif // EXECUTION_SYCL_H
@@ -32,6 +32,8 @@
 #include "execution_sycl.h"
 #include "particle_iterators.h"
 
+#include <chrono>
+
 namespace SPH
 {
 template <class LocalDynamicsFunction>
@@ -40,11 +42,49 @@ inline void particle_for(const ParallelDevicePolicy &par_device,
 {
     auto &sycl_queue = execution_instance.getQueue();
     const size_t particles_size = particles_range.size();
+    const size_t first = particles_range.begin();
     sycl_queue.submit([&](sycl::handler &cgh)
                       { cgh.parallel_for(execution_instance.getUniformNdRange(particles_size), [=](sycl::nd_item<1> index)
                                          {
                                  if(index.get_global_id(0) < particles_size)
-                                     local_dynamics_function(index.get_global_id(0)); }); })
+                                     local_dynamics_function(first + index.get_global_id(0)); }); })
+        .wait_and_throw();
+    execution_instance.increaseDeviceDataVersion();
+}
+
+/**
+ * Deterministic device reduction: each work item reduces a fixed chunk sequentially
+ * and the chunk results are then reduced in order by a single task,
+ * so that the result does not depend on the device or the work-group scheduling.
+ */
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline void deterministic_device_reduce(size_t first, size_t size, ReturnType temp, Operation &&operation,
+                                        const LocalDynamicsFunction &local_dynamics_function, ReturnType *result)
+{
+    auto &sycl_queue = execution_instance.getQueue();
+    const size_t chunk_size = DeterministicReduction::ChunkSize();
+    const size_t number_of_chunks = (size + chunk_size - 1) / chunk_size;
+    ReturnType *chunk_results = execution_instance.getDeviceScratch<ReturnType>(SMAX(number_of_chunks, size_t(1)));
+    sycl_queue.submit([&](sycl::handler &cgh)
+                      { cgh.parallel_for(execution_instance.getUniformNdRange(number_of_chunks), [=](sycl::nd_item<1> item)
+                                         {
+                                             const size_t chunk = item.get_global_id(0);
+                                             if (chunk < number_of_chunks)
+                                             {
+                                                 ReturnType chunk_result = temp;
+                                                 const size_t end = sycl::min(size, (chunk + 1) * chunk_size);
+                                                 for (size_t i = chunk * chunk_size; i < end; ++i)
+                                                     chunk_result = operation(chunk_result, local_dynamics_function(first + i));
+                                                 chunk_results[chunk] = chunk_result;
+                                             } }); })
+        .wait_and_throw();
+    sycl_queue.submit([&](sycl::handler &cgh)
+                      { cgh.single_task([=]()
+                                        {
+                                            ReturnType reduced = temp;
+                                            for (size_t chunk = 0; chunk < number_of_chunks; ++chunk)
+                                                reduced = operation(reduced, chunk_results[chunk]);
+                                            *result = reduced; }); })
         .wait_and_throw();
 }
 
@@ -55,6 +95,17 @@ inline ReturnType particle_reduce(const ParallelDevicePolicy &par_device,
 {
     auto &sycl_queue = execution_instance.getQueue();
     const size_t particles_size = particles_range.size();
+    const size_t first = particles_range.begin();
+    if (DeterministicReduction::isEnabled())
+    {
+        ReturnType *device_result = allocateDeviceOnly<ReturnType>(1);
+        deterministic_device_reduce(first, particles_size, temp, operation,
+                                    local_dynamics_function, device_result);
+        copyFromDevice(&temp, device_result, 1);
+        freeDeviceData(device_result);
+        execution_instance.increaseDeviceDataVersion();
+        return temp;
+    }
     {
         sycl::buffer<ReturnType> buffer_result(&temp, 1);
         sycl_queue.submit([&](sycl::handler &cgh)
@@ -63,29 +114,236 @@ inline ReturnType particle_reduce(const ParallelDevicePolicy &par_device,
                               cgh.parallel_for(execution_instance.getUniformNdRange(particles_size), reduction_operator,
                                                [=](sycl::nd_item<1> item, auto& reduction) {
                                                    if(item.get_global_id() < particles_size)
-                                                       reduction.combine(local_dynamics_function(item.get_global_id(0)));
+                                                       reduction.combine(local_dynamics_function(first + item.get_global_id(0)));
                                                }); })
             .wait_and_throw();
     } // buffer_result goes out of scope, so the result (of temp) is updated
+    execution_instance.increaseDeviceDataVersion();
     return temp;
 }
 
+/** reduce into a device-shared value, so that no buffer and copy back to the host is needed */
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline void particle_reduce(const ParallelDevicePolicy &par_device,
+                            const IndexRange &particles_range, ReturnType temp, Operation &&operation,
+                            const LocalDynamicsFunction &local_dynamics_function, ReturnType *result)
+{
+    auto &sycl_queue = execution_instance.getQueue();
+    const size_t particles_size = particles_range.size();
+    const size_t first = particles_range.begin();
+    if (DeterministicReduction::isEnabled())
+    {
+        deterministic_device_reduce(first, particles_size, temp, operation,
+                                    local_dynamics_function, result);
+        execution_instance.increaseDeviceDataVersion();
+        return;
+    }
+    sycl_queue.submit([&](sycl::handler &cgh)
+                      {
+                          auto reduction_operator = sycl::reduction(
+                              result, temp, operation,
+                              sycl::property_list{sycl::property::reduction::initialize_to_identity()});
+                          cgh.parallel_for(execution_instance.getUniformNdRange(particles_size), reduction_operator,
+                                           [=](sycl::nd_item<1> item, auto& reduction) {
+                                               if(item.get_global_id() < particles_size)
+                                                   reduction.combine(local_dynamics_function(first + item.get_global_id(0)));
+                                           }); })
+        .wait_and_throw();
+    execution_instance.increaseDeviceDataVersion();
+}
+
+/**
+ * Hybrid iterators: the first part of the range is submitted to the device and the rest
+ * is run by the host threads meanwhile. As the particles are sorted by cell, the split is a spatial one,
+ * and the neighbors across the split are read directly from the shared memory, so that no halo is exchanged.
+ * The balance state is kept for each loop, i.e. each instantiation, since the cost ratio differs between loops.
+ * Without hybrid execution enabled, the whole range is run on the device,
+ * as are the reductions with deterministic reduction enabled, since the split changes with the balance.
+ */
+template <class LocalDynamicsFunction>
+inline void particle_for(const ParallelHybridPolicy &par_hybrid,
+                         const IndexRange &particles_range, const LocalDynamicsFunction &local_dynamics_function)
+{
+    if (!execution_instance.isHybridExecution())
+    {
+        particle_for(par_device, particles_range, local_dynamics_function);
+        return;
+    }
+
+    static HybridLoadBalance load_balance;
+    const size_t device_size = load_balance.DeviceSize(particles_range.size());
+    const size_t first = particles_range.begin();
+    const size_t split = first + device_size;
+
+    auto start = std::chrono::steady_clock::now();
+    sycl::event device_part;
+    if (device_size != 0)
+    {
+        device_part = execution_instance.getQueue().submit(
+            [&](sycl::handler &cgh)
+            { cgh.parallel_for(execution_instance.getUniformNdRange(device_size), [=](sycl::nd_item<1> index)
+                               {
+                                   if (index.get_global_id(0) < device_size)
+                                       local_dynamics_function(first + index.get_global_id(0)); }); });
+    }
+    particle_for(par, IndexRange(split, particles_range.end()), local_dynamics_function);
+    double host_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool is_device_waited = device_part.get_info<sycl::info::event::command_execution_status>() !=
+                            sycl::info::event_command_status::complete;
+    device_part.wait_and_throw();
+    double device_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    load_balance.update(device_size, particles_range.end() - split, host_time, device_time, is_device_waited);
+    execution_instance.increaseDeviceDataVersion();
+}
+
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline ReturnType particle_reduce(const ParallelHybridPolicy &par_hybrid,
+                                  const IndexRange &particles_range, ReturnType temp, Operation &&operation,
+                                  const LocalDynamicsFunction &local_dynamics_function)
+{
+    if (!execution_instance.isHybridExecution() || DeterministicReduction::isEnabled())
+    {
+        return particle_reduce(par_device, particles_range, temp, operation, local_dynamics_function);
+    }
+
+    static HybridLoadBalance load_balance;
+    const size_t device_size = load_balance.DeviceSize(particles_range.size());
+    const size_t first = particles_range.begin();
+    const size_t split = first + device_size;
+
+    ReturnType device_value = temp;
+    ReturnType host_value = temp;
+    auto start = std::chrono::steady_clock::now();
+    double host_time = 0.0;
+    bool is_device_waited = false;
+    {
+        sycl::buffer<ReturnType> buffer_result(&device_value, 1);
+        sycl::event device_part;
+        if (device_size != 0)
+        {
+            device_part = execution_instance.getQueue().submit(
+                [&](sycl::handler &cgh)
+                {
+                    auto reduction_operator = sycl::reduction(buffer_result, cgh, operation);
+                    cgh.parallel_for(execution_instance.getUniformNdRange(device_size), reduction_operator,
+                                     [=](sycl::nd_item<1> item, auto& reduction) {
+                                         if(item.get_global_id() < device_size)
+                                             reduction.combine(local_dynamics_function(first + item.get_global_id(0)));
+                                     }); });
+        }
+        host_value = particle_reduce(par, IndexRange(split, particles_range.end()), temp, operation,
+                                     local_dynamics_function);
+        host_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        is_device_waited = device_part.get_info<sycl::info::event::command_execution_status>() !=
+                           sycl::info::event_command_status::complete;
+        device_part.wait_and_throw();
+    } // buffer_result goes out of scope, so the result (of device_value) is updated
+    double device_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    load_balance.update(device_size, particles_range.end() - split, host_time, device_time, is_device_waited);
+    execution_instance.increaseDeviceDataVersion();
+    return operation(device_value, host_value);
+}
+
+/** the result is a device-shared value, into which the device and host parts are combined */
+template <class ReturnType, typename Operation, class LocalDynamicsFunction>
+inline void particle_reduce(const ParallelHybridPolicy &par_hybrid,
+                            const IndexRange &particles_range, ReturnType temp, Operation &&operation,
+                            const LocalDynamicsFunction &local_dynamics_function, ReturnType *result)
+{
+    if (!execution_instance.isHybridExecution() || DeterministicReduction::isEnabled())
+    {
+        particle_reduce(par_device, particles_range, temp, operation, local_dynamics_function, result);
+        return;
+    }
+
+    static HybridLoadBalance load_balance;
+    const size_t device_size = load_balance.DeviceSize(particles_range.size());
+    const size_t first = particles_range.begin();
+    const size_t split = first + device_size;
+
+    *result = temp;
+    auto start = std::chrono::steady_clock::now();
+    sycl::event device_part;
+    if (device_size != 0)
+    {
+        device_part = execution_instance.getQueue().submit(
+            [&](sycl::handler &cgh)
+            {
+                auto reduction_operator = sycl::reduction(
+                    result, temp, operation,
+                    sycl::property_list{sycl::property::reduction::initialize_to_identity()});
+                cgh.parallel_for(execution_instance.getUniformNdRange(device_size), reduction_operator,
+                                 [=](sycl::nd_item<1> item, auto& reduction) {
+                                     if(item.get_global_id() < device_size)
+                                         reduction.combine(local_dynamics_function(first + item.get_global_id(0)));
+                                 }); });
+    }
+    ReturnType host_value = particle_reduce(par, IndexRange(split, particles_range.end()), temp, operation,
+                                            local_dynamics_function);
+    double host_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bool is_device_waited = device_part.get_info<sycl::info::event::command_execution_status>() !=
+                            sycl::info::event_command_status::complete;
+    device_part.wait_and_throw();
+    double device_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    load_balance.update(device_size, particles_range.end() - split, host_time, device_time, is_device_waited);
+    *result = operation(*result, host_value);
+    execution_instance.increaseDeviceDataVersion();
+}
+
+/**
+ * Exclusive scan by all work-groups: each group reduces a contiguous chunk,
+ * the chunk sums are scanned by one group and each group then scans its chunk
+ * starting from the chunk offset, so that the scan is not limited to a single group.
+ */
 template <typename T, typename Op>
 T exclusive_scan(const ParallelDevicePolicy &par_policy, T *first, T *d_first, UnsignedInt d_size, Op op)
 {
-    execution_instance.getQueue()
-        .submit([=](sycl::handler &cgh)
-                { cgh.parallel_for(
-                      execution_instance.getUniformNdRange(execution_instance.getWorkGroupSize()),
-                      [=](sycl::nd_item<1> item)
-                      {
-                          if (item.get_group_linear_id() == 0)
-                          {
-                              sycl::joint_exclusive_scan(
-                                  item.get_group(), first, first + d_size, d_first, T{0}, op);
-                          }
-                      }); })
+    auto &sycl_queue = execution_instance.getQueue();
+    const size_t work_group_size = execution_instance.getWorkGroupSize();
+    const size_t data_size = d_size;
+    const size_t number_of_groups =
+        SMAX(size_t(1), SMIN((data_size + work_group_size - 1) / work_group_size, size_t(1024)));
+    const size_t chunk_size = (data_size + number_of_groups - 1) / number_of_groups;
+    T *chunk_sum = execution_instance.getDeviceScratch<T>(2 * number_of_groups);
+    T *chunk_offset = chunk_sum + number_of_groups;
+    const sycl::nd_range<1> all_groups(number_of_groups * work_group_size, work_group_size);
+
+    sycl::event reduce_chunks = sycl_queue.submit(
+        [=](sycl::handler &cgh)
+        { cgh.parallel_for(all_groups, [=](sycl::nd_item<1> item)
+                           {
+                               const size_t group_id = item.get_group_linear_id();
+                               const size_t begin = SMIN(group_id * chunk_size, data_size);
+                               const size_t end = SMIN(begin + chunk_size, data_size);
+                               T sum = sycl::joint_reduce(item.get_group(), first + begin, first + end, T{0}, op);
+                               if (item.get_local_linear_id() == 0)
+                                   chunk_sum[group_id] = sum; }); });
+
+    sycl::event scan_chunk_sums = sycl_queue.submit(
+        [=](sycl::handler &cgh)
+        {
+            cgh.depends_on(reduce_chunks);
+            cgh.parallel_for(sycl::nd_range<1>(work_group_size, work_group_size), [=](sycl::nd_item<1> item)
+                             { sycl::joint_exclusive_scan(item.get_group(), chunk_sum, chunk_sum + number_of_groups,
+                                                          chunk_offset, T{0}, op); });
+        });
+
+    sycl_queue.submit(
+                  [=](sycl::handler &cgh)
+                  {
+                      cgh.depends_on(scan_chunk_sums);
+                      cgh.parallel_for(all_groups, [=](sycl::nd_item<1> item)
+                                       {
+                                           const size_t group_id = item.get_group_linear_id();
+                                           const size_t begin = SMIN(group_id * chunk_size, data_size);
+                                           const size_t end = SMIN(begin + chunk_size, data_size);
+                                           sycl::joint_exclusive_scan(item.get_group(), first + begin, first + end,
+                                                                      d_first + begin, chunk_offset[group_id], op); });
+                  })
         .wait_and_throw();
+    execution_instance.increaseDeviceDataVersion();
 
     UnsignedInt scan_size = d_size - 1;
     T last_value;
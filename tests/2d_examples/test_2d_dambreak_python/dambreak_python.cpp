@@ -6,6 +6,7 @@
  * @author	Luhui Han, Chi Zhang and Xiangyu Hu
  */
 #include "sphinxsys.h"         //SPHinXsys Library.
+#include "io_python.h"         //NumPy views of particle variables.
 #include <pybind11/pybind11.h> //pybind11 Library.
 namespace py = pybind11;
 using namespace SPH; // Namespace cite here.
@@ -130,11 +131,13 @@ class Environment : public PreSettingCase
     //	and regression tests of the simulation.
     //----------------------------------------------------------------------
     BodyStatesRecordingToVtp body_states_recording;
+    BodyStatesRecordingToMemory body_states_export;
     RestartIO restart_io;
     RegressionTestDynamicTimeWarping<ReducedQuantityRecording<TotalMechanicalEnergy>>
         write_water_mechanical_energy;
     RegressionTestDynamicTimeWarping<ObservedQuantityRecording<Real>>
         write_recorded_water_pressure;
+    ParticleVariableViews water_block_views;
     //----------------------------------------------------------------------
     //	Setup for time-stepping control
     //----------------------------------------------------------------------
@@ -170,9 +173,11 @@ class Environment : public PreSettingCase
           fluid_acoustic_time_step(water_block),
           particle_sorting(water_block),
           body_states_recording(sph_system),
+          body_states_export(sph_system),
           restart_io(sph_system),
           write_water_mechanical_energy(water_block, gravity),
-          write_recorded_water_pressure("Pressure", fluid_observer_contact)
+          write_recorded_water_pressure("Pressure", fluid_observer_contact),
+          water_block_views(water_block.getBaseParticles())
     {
         //----------------------------------------------------------------------
         //	Prepare the simulation with cell linked list, configuration
@@ -193,6 +198,8 @@ class Environment : public PreSettingCase
     }
 
     virtual ~Environment(){};
+    ParticleVariableViews &getWaterBlockViews() { return water_block_views; };
+    BodyStatesRecordingToMemory &getBodyStatesExport() { return body_states_export; };
     //----------------------------------------------------------------------
     //	For ctest.
     //----------------------------------------------------------------------
@@ -300,8 +307,12 @@ class Environment : public PreSettingCase
 /** test_2d_dambreak_python should be same with the project name */
 PYBIND11_MODULE(test_2d_dambreak_python, m)
 {
+    ParticleVariableViews::bind(m, "ParticleVariableViews");
+    bindBodyStatesRecordingToMemory(m, "BodyStatesRecordingToMemory");
     py::class_<Environment>(m, "dambreak_from_sph_cpp")
         .def(py::init<const int &>())
         .def("CmakeTest", &Environment::cmakeTest)
-        .def("RunCase", &Environment::runCase);
+        .def("RunCase", &Environment::runCase)
+        .def("WaterBlockViews", &Environment::getWaterBlockViews, py::return_value_policy::reference_internal)
+        .def("BodyStatesExport", &Environment::getBodyStatesExport, py::return_value_policy::reference_internal);
 }
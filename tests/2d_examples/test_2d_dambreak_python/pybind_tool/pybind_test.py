@@ -34,6 +34,9 @@ def run_case():
     project = test_2d.dambreak_from_sph_cpp(case.restart_step)
     if project.CmakeTest() == 1:
         project.RunCase(case.end_time)
+        # field data viewed without copy, e.g. for post-processing
+        position = project.WaterBlockViews().view("Position", test_2d.ViewAccess.read_only)
+        print("Water block positions viewed with shape", position.shape)
     else:
         print("check path: ", path)
         
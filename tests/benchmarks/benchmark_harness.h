@@ -0,0 +1,162 @@
+/* ------------------------------------------------------------------------- *
+ *                                SPHinXsys                                  *
+ * ------------------------------------------------------------------------- *
+ * SPHinXsys (pronunciation: s'finksis) is an acronym from Smoothed Particle *
+ * Hydrodynamics for industrial compleX systems. It provides C++ APIs for    *
+ * physical accurate simulation and aims to model coupled industrial dynamic *
+ * systems including fluid, solid, multi-body dynamics and beyond with SPH   *
+ * (smoothed particle hydrodynamics), a meshless computational method using  *
+ * particle discretization.                                                  *
+ *                                                                           *
+ * SPHinXsys is partially funded by German Research Foundation               *
+ * (Deutsche Forschungsgemeinschaft) DFG HU1527/6-1, HU1527/10-1,            *
+ *  HU1527/12-1 and HU1527/12-4.                                             *
+ *                                                                           *
+ * Portions copyright (c) 2017-2023 Technical University of Munich and       *
+ * the authors' affiliations.                                                *
+ *                                                                           *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may   *
+ * not use this file except in compliance with the License. You may obtain a *
+ * copy of the License at http://www.apache.org/licenses/LICENSE-2.0.        *
+ *                                                                           *
+ * ------------------------------------------------------------------------- */
+/**
+ * @file 	benchmark_harness.h
+ * @brief 	A light-weight timing harness for the sphinxsys_benchmarks target.
+ * @details Each case is warmed up once and then repeated until both a minimum
+ *          number of repetitions and a minimum accumulated time are reached.
+ *          The mean and minimum time per repetition and the throughput in
+ *          items per second are reported on screen and, optionally, in JSON
+ *          so that results from different commits or back ends can be compared.
+ *          Command line options: --json=<file>, --filter=<substring>,
+ *          --min_time=<seconds>.
+ * @author	Xiangyu Hu
+ */
+
+#ifndef BENCHMARK_HARNESS_H
+#define BENCHMARK_HARNESS_H
+
+#include "base_data_type.h"
+
+#include <tbb/tick_count.h>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace SPH
+{
+namespace benchmark
+{
+/** Prevents the compiler from optimizing away a benchmarked result. */
+template <typename T>
+inline void doNotOptimize(T const &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T *sink = nullptr;
+    sink = &value;
+#endif
+}
+
+class BenchmarkHarness
+{
+    struct Result
+    {
+        std::string group_, name_, back_end_;
+        size_t items_, repetitions_;
+        double mean_time_, min_time_;
+    };
+
+  public:
+    BenchmarkHarness(int ac, char *av[])
+    {
+        for (int i = 1; i < ac; ++i)
+        {
+            std::string argument(av[i]);
+            if (argument.rfind("--json=", 0) == 0)
+                json_file_ = argument.substr(7);
+            else if (argument.rfind("--filter=", 0) == 0)
+                filter_ = argument.substr(9);
+            else if (argument.rfind("--min_time=", 0) == 0)
+                min_time_ = std::stod(argument.substr(11));
+            else
+            {
+                std::cout << "\n Usage: " << av[0] << " [--json=<file>] [--filter=<substring>] [--min_time=<seconds>]" << std::endl;
+                std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+                exit(1);
+            }
+        }
+    };
+    ~BenchmarkHarness() { writeToJSON(); };
+
+    bool isSelected(const std::string &group, const std::string &name) const
+    {
+        return filter_.empty() || (group + "/" + name).find(filter_) != std::string::npos;
+    };
+
+    /** items is the number of elementary operations (e.g. particles) processed by one call of function. */
+    void run(const std::string &group, const std::string &name, const std::string &back_end,
+             size_t items, const std::function<void()> &function)
+    {
+        if (!isSelected(group, name))
+            return;
+
+        function(); // warm up
+        size_t repetitions = 0;
+        double total_time = 0.0;
+        double min_time = std::numeric_limits<double>::max();
+        while (repetitions < min_repetitions_ || total_time < min_time_)
+        {
+            tbb::tick_count t0 = tbb::tick_count::now();
+            function();
+            double elapsed = (tbb::tick_count::now() - t0).seconds();
+            total_time += elapsed;
+            min_time = std::min(min_time, elapsed);
+            repetitions++;
+        }
+
+        Result result{group, name, back_end, items, repetitions, total_time / double(repetitions), min_time};
+        std::cout << std::left << std::setw(10) << group << std::setw(48) << name << std::setw(8) << back_end
+                  << std::right << std::scientific << std::setprecision(3)
+                  << " mean " << result.mean_time_ << " s, min " << result.min_time_ << " s, "
+                  << double(items) / result.min_time_ << " items/s (" << repetitions << " reps)" << std::endl;
+        results_.push_back(result);
+    };
+
+  protected:
+    std::string json_file_;
+    std::string filter_;
+    double min_time_ = 0.5;
+    size_t min_repetitions_ = 3;
+    std::vector<Result> results_;
+
+    void writeToJSON()
+    {
+        if (json_file_.empty())
+            return;
+
+        std::ofstream out_file(json_file_.c_str(), std::ios::trunc);
+        out_file << "{\n  \"benchmarks\": [";
+        for (size_t i = 0; i != results_.size(); ++i)
+        {
+            const Result &result = results_[i];
+            out_file << (i == 0 ? "\n" : ",\n") << std::scientific << std::setprecision(9)
+                     << "    {\"group\": \"" << result.group_ << "\", \"name\": \"" << result.name_
+                     << "\", \"back_end\": \"" << result.back_end_ << "\", \"items\": " << result.items_
+                     << ", \"repetitions\": " << result.repetitions_
+                     << ", \"mean_time\": " << result.mean_time_ << ", \"min_time\": " << result.min_time_
+                     << ", \"items_per_second\": " << double(result.items_) / result.min_time_ << "}";
+        }
+        out_file << "\n  ]\n}\n";
+    };
+};
+} // namespace benchmark
+} // namespace SPH
+#endif // BENCHMARK_HARNESS_H
@@ -0,0 +1,300 @@
+/**
+ * @file benchmarks_2d.cpp
+ * @brief Micro, mid-level and macro benchmarks of 2D computing kernels.
+ * @details The micro group times single kernel evaluations (including tabulated
+ * kernels of several table sizes with their accuracy) and Riemann solvers,
+ * the mid group times configuration updates (cell linked list, neighbor relation
+ * and particle sorting), also the compact configuration cache against the classic
+ * configuration, and the macro group times complete dambreak time steps
+ * at several resolutions. With SYCL, the mid and macro groups also run
+ * with the device execution policy.
+ * @author Xiangyu Hu
+ */
+#include "benchmark_harness.h"
+#if SPHINXSYS_USE_SYCL
+#include "sphinxsys_sycl.h"
+#else
+#include "sphinxsys_ck.h"
+#endif
+using namespace SPH;
+using namespace SPH::benchmark;
+//----------------------------------------------------------------------
+//	Dambreak geometry and material parameters (see test_2d_dambreak_ck).
+//----------------------------------------------------------------------
+Real DL = 5.366;
+Real DH = 5.366;
+Real LL = 2.0;
+Real LH = 1.0;
+Real rho0_f = 1.0;
+Real gravity_g = 1.0;
+Real U_ref = 2.0 * sqrt(gravity_g * LH);
+Real c_f = 10.0 * U_ref;
+//----------------------------------------------------------------------
+class WallBoundary : public ComplexShape
+{
+  public:
+    WallBoundary(const std::string &shape_name, Real BW) : ComplexShape(shape_name)
+    {
+        Vec2d outer_wall_halfsize = Vec2d(0.5 * DL + BW, 0.5 * DH + BW);
+        Vec2d outer_wall_translation = Vec2d(-BW, -BW) + outer_wall_halfsize;
+        Vec2d inner_wall_halfsize = Vec2d(0.5 * DL, 0.5 * DH);
+        add<TransformShape<GeometricShapeBox>>(Transform(outer_wall_translation), outer_wall_halfsize);
+        subtract<TransformShape<GeometricShapeBox>>(Transform(inner_wall_halfsize), inner_wall_halfsize);
+    }
+};
+//----------------------------------------------------------------------
+//	Accuracy and cost of a tabulated kernel against its exact counterpart.
+//----------------------------------------------------------------------
+template <class TabulatedKernelType, class ExactKernelType>
+void runTabulatedKernelBenchmark(BenchmarkHarness &harness, Kernel &kernel, const ExactKernelType &exact_ck,
+                                 const StdVec<Vec2d> &displacements, const std::string &name)
+{
+    TabulatedKernelType tabulated_ck(kernel);
+    Real max_error_W = 0.0;
+    Real max_error_dW = 0.0;
+    Real max_W = 0.0;
+    Real max_dW = 0.0;
+    for (const Vec2d &displacement : displacements)
+    {
+        max_error_W = SMAX(max_error_W, ABS(tabulated_ck.W(displacement) - exact_ck.W(displacement)));
+        max_error_dW = SMAX(max_error_dW, ABS(tabulated_ck.dW(displacement) - exact_ck.dW(displacement)));
+        max_W = SMAX(max_W, ABS(exact_ck.W(displacement)));
+        max_dW = SMAX(max_dW, ABS(exact_ck.dW(displacement)));
+    }
+    std::cout << name << ": max relative error W " << max_error_W / max_W
+              << ", dW " << max_error_dW / max_dW << std::endl;
+
+    size_t number_of_samples = displacements.size();
+    harness.run("micro", name + "::W", "cpu", number_of_samples, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples; ++i)
+                        sum += tabulated_ck.W(displacements[i]);
+                    doNotOptimize(sum);
+                });
+    harness.run("micro", name + "::dW", "cpu", number_of_samples, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples; ++i)
+                        sum += tabulated_ck.dW(displacements[i]);
+                    doNotOptimize(sum);
+                });
+}
+//----------------------------------------------------------------------
+//	Micro benchmarks.
+//----------------------------------------------------------------------
+void runMicroBenchmarks(BenchmarkHarness &harness)
+{
+    const size_t number_of_samples = 1000000;
+    const Real dp = 0.025;
+    KernelWendlandC2 kernel(1.3 * dp);
+    KernelWendlandC2CK kernel_ck(kernel);
+    StdVec<Vec2d> displacements(number_of_samples);
+    for (size_t i = 0; i != number_of_samples; ++i)
+    {
+        Real ratio = Real(i) / Real(number_of_samples);
+        displacements[i] = 2.6 * dp * ratio * Vec2d(cos(10.0 * ratio), sin(10.0 * ratio));
+    }
+
+    harness.run("micro", "KernelWendlandC2CK::W", "cpu", number_of_samples, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples; ++i)
+                        sum += kernel_ck.W(displacements[i]);
+                    doNotOptimize(sum);
+                });
+    harness.run("micro", "KernelWendlandC2CK::dW", "cpu", number_of_samples, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples; ++i)
+                        sum += kernel_ck.dW(displacements[i]);
+                    doNotOptimize(sum);
+                });
+
+    KernelLaguerreGauss laguerre_gauss_kernel(1.3 * dp);
+    KernelLaguerreGaussCK laguerre_gauss_ck(laguerre_gauss_kernel);
+    harness.run("micro", "KernelLaguerreGaussCK::dW", "cpu", number_of_samples, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples; ++i)
+                        sum += laguerre_gauss_ck.dW(displacements[i]);
+                    doNotOptimize(sum);
+                });
+    runTabulatedKernelBenchmark<KernelTabulatedCK<KernelLaguerreGaussFunction, 32, false>>(
+        harness, laguerre_gauss_kernel, laguerre_gauss_ck, displacements, "KernelTabulatedCK<LaguerreGauss,32,linear>");
+    runTabulatedKernelBenchmark<KernelTabulatedCK<KernelLaguerreGaussFunction, 128, false>>(
+        harness, laguerre_gauss_kernel, laguerre_gauss_ck, displacements, "KernelTabulatedCK<LaguerreGauss,128,linear>");
+    runTabulatedKernelBenchmark<KernelTabulatedCK<KernelLaguerreGaussFunction, 512, false>>(
+        harness, laguerre_gauss_kernel, laguerre_gauss_ck, displacements, "KernelTabulatedCK<LaguerreGauss,512,linear>");
+    runTabulatedKernelBenchmark<KernelTabulatedCK<KernelLaguerreGaussFunction, 32, true>>(
+        harness, laguerre_gauss_kernel, laguerre_gauss_ck, displacements, "KernelTabulatedCK<LaguerreGauss,32,cubic>");
+    runTabulatedKernelBenchmark<KernelTabulatedCK<KernelLaguerreGaussFunction, 128, true>>(
+        harness, laguerre_gauss_kernel, laguerre_gauss_ck, displacements, "KernelTabulatedCK<LaguerreGauss,128,cubic>");
+
+    WeaklyCompressibleFluid fluid(rho0_f, c_f);
+    AcousticRiemannSolver riemann_solver(fluid, fluid);
+    StdVec<Real> densities(number_of_samples), pressures(number_of_samples);
+    StdVec<Vec2d> velocities(number_of_samples);
+    for (size_t i = 0; i != number_of_samples; ++i)
+    {
+        Real ratio = Real(i) / Real(number_of_samples);
+        densities[i] = rho0_f * (1.0 + 0.01 * sin(7.0 * ratio));
+        pressures[i] = fluid.getPressure(densities[i]);
+        velocities[i] = U_ref * Vec2d(cos(3.0 * ratio), sin(5.0 * ratio));
+    }
+
+    harness.run("micro", "AcousticRiemannSolver::InterfaceState", "cpu", number_of_samples - 1, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples - 1; ++i)
+                    {
+                        FluidStateIn state_i(densities[i], velocities[i], pressures[i]);
+                        FluidStateIn state_j(densities[i + 1], velocities[i + 1], pressures[i + 1]);
+                        FluidStateOut interface_state = riemann_solver.InterfaceState(state_i, state_j, displacements[i].normalized());
+                        sum += interface_state.p_;
+                    }
+                    doNotOptimize(sum);
+                });
+    harness.run("micro", "AcousticRiemannSolver::DissipativeUJump", "cpu", number_of_samples - 1, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples - 1; ++i)
+                        sum += riemann_solver.DissipativeUJump(pressures[i] - pressures[i + 1]);
+                    doNotOptimize(sum);
+                });
+}
+//----------------------------------------------------------------------
+//	Mid-level benchmarks of the compact configuration cache.
+//	The cache pays off when the saving of the compact sweeps,
+//	times the sweeps between two builds, exceeds the cost of the copy.
+//----------------------------------------------------------------------
+void runCompactConfigurationBenchmarks(BenchmarkHarness &harness, Real particle_spacing)
+{
+    Vec2d water_block_halfsize = Vec2d(0.5 * LL, 0.5 * LH);
+    BoundingBox system_domain_bounds(Vec2d::Zero(), Vec2d(LL, LH));
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+
+    TransformShape<GeometricShapeBox> initial_water_block(Transform(water_block_halfsize), water_block_halfsize, "WaterBody");
+    FluidBody water_block(sph_system, initial_water_block);
+    water_block.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+
+    InnerRelation water_block_inner(water_block);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationInner> density_summation(water_block_inner);
+    water_block.updateCellLinkedList();
+    water_block_inner.updateConfiguration();
+
+    size_t particles = water_block.getBaseParticles().TotalRealParticles();
+    std::string resolution = "dp=" + std::to_string(particle_spacing);
+
+    harness.run("mid", "DensitySummationInner/classic/" + resolution, "cpu", particles, [&]()
+                { density_summation.exec(); });
+    water_block_inner.enableCompactConfiguration();
+    water_block_inner.updateConfiguration();
+    harness.run("mid", "DensitySummationInner/compact/" + resolution, "cpu", particles, [&]()
+                { density_summation.exec(); });
+    harness.run("mid", "CompactParticleConfiguration::compactFrom/" + resolution, "cpu", particles, [&]()
+                { water_block_inner.compact_inner_configuration_.compactFrom(
+                      water_block_inner.inner_configuration_, particles); });
+}
+//----------------------------------------------------------------------
+//	Mid-level and macro benchmarks on the dambreak case.
+//----------------------------------------------------------------------
+template <class ExecutionPolicy>
+void runDambreakBenchmarks(BenchmarkHarness &harness, Real particle_spacing, const std::string &back_end)
+{
+    Real BW = particle_spacing * 4;
+    Vec2d water_block_halfsize = Vec2d(0.5 * LL, 0.5 * LH);
+    BoundingBox system_domain_bounds(Vec2d(-BW, -BW), Vec2d(DL + BW, DH + BW));
+    SPHSystem sph_system(system_domain_bounds, particle_spacing);
+
+    TransformShape<GeometricShapeBox> initial_water_block(Transform(water_block_halfsize), water_block_halfsize, "WaterBody");
+    FluidBody water_block(sph_system, initial_water_block);
+    water_block.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary", BW));
+    wall_boundary.defineMaterial<Solid>();
+    wall_boundary.generateParticles<BaseParticles, Lattice>();
+
+    UpdateCellLinkedList<ExecutionPolicy, CellLinkedList> water_cell_linked_list(water_block);
+    UpdateCellLinkedList<ExecutionPolicy, CellLinkedList> wall_cell_linked_list(wall_boundary);
+    Relation<Inner<>> water_block_inner(water_block);
+    Relation<Contact<>> water_wall_contact(water_block, {&wall_boundary});
+    UpdateRelation<ExecutionPolicy, Inner<>, Contact<>>
+        water_block_update_complex_relation(water_block_inner, water_wall_contact);
+    ParticleSortCK<ExecutionPolicy, QuickSort> particle_sort(water_block);
+
+    Gravity gravity(Vecd(0.0, -gravity_g));
+    StateDynamics<ExecutionPolicy, GravityForceCK<Gravity>> constant_gravity(water_block, gravity);
+    StateDynamics<ExecutionPolicy, NormalFromBodyShapeCK> wall_boundary_normal_direction(wall_boundary);
+    StateDynamics<ExecutionPolicy, fluid_dynamics::AdvectionStepSetup> water_advection_step_setup(water_block);
+    StateDynamics<ExecutionPolicy, fluid_dynamics::AdvectionStepClose> water_advection_step_close(water_block);
+    InteractionDynamicsCK<ExecutionPolicy, LinearCorrectionMatrixComplex>
+        fluid_linear_correction_matrix(ConstructorArgs(water_block_inner, 0.5), water_wall_contact);
+    InteractionDynamicsCK<ExecutionPolicy, fluid_dynamics::AcousticStep1stHalfWithWallRiemannCorrectionCK>
+        fluid_acoustic_step_1st_half(water_block_inner, water_wall_contact);
+    InteractionDynamicsCK<ExecutionPolicy, fluid_dynamics::AcousticStep2ndHalfWithWallRiemannCorrectionCK>
+        fluid_acoustic_step_2nd_half(water_block_inner, water_wall_contact);
+    InteractionDynamicsCK<ExecutionPolicy, fluid_dynamics::DensityRegularizationComplexFreeSurface>
+        fluid_density_regularization(water_block_inner, water_wall_contact);
+    ReduceDynamicsCK<ExecutionPolicy, fluid_dynamics::AdvectionTimeStepCK> fluid_advection_time_step(water_block, U_ref);
+    ReduceDynamicsCK<ExecutionPolicy, fluid_dynamics::AcousticTimeStepCK> fluid_acoustic_time_step(water_block);
+
+    wall_boundary_normal_direction.exec();
+    constant_gravity.exec();
+    water_cell_linked_list.exec();
+    wall_cell_linked_list.exec();
+    water_block_update_complex_relation.exec();
+
+    size_t particles = water_block.getBaseParticles().TotalRealParticles();
+    std::string resolution = "dp=" + std::to_string(particle_spacing);
+
+    harness.run("mid", "UpdateCellLinkedList/" + resolution, back_end, particles, [&]()
+                { water_cell_linked_list.exec(); });
+    harness.run("mid", "UpdateRelation<Inner,Contact>/" + resolution, back_end, particles, [&]()
+                { water_block_update_complex_relation.exec(); });
+    harness.run("mid", "ParticleSortCK/" + resolution, back_end, particles, [&]()
+                { particle_sort.exec(); });
+    /** the configuration is updated for the sorted particles before the next benchmarks. */
+    water_cell_linked_list.exec();
+    water_block_update_complex_relation.exec();
+    /** one advection step with the acoustic sub-steps and the configuration update. */
+    harness.run("macro", "Dambreak2dAdvectionStep/" + resolution, back_end, particles, [&]()
+                {
+                    fluid_linear_correction_matrix.exec();
+                    fluid_density_regularization.exec();
+                    Real advection_dt = fluid_advection_time_step.exec();
+                    water_advection_step_setup.exec();
+                    Real relaxation_time = 0.0;
+                    while (relaxation_time < advection_dt)
+                    {
+                        Real acoustic_dt = fluid_acoustic_time_step.exec();
+                        fluid_acoustic_step_1st_half.exec(acoustic_dt);
+                        fluid_acoustic_step_2nd_half.exec(acoustic_dt);
+                        relaxation_time += acoustic_dt;
+                    }
+                    water_advection_step_close.exec();
+                    water_cell_linked_list.exec();
+                    water_block_update_complex_relation.exec();
+                });
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    BenchmarkHarness harness(ac, av);
+    runMicroBenchmarks(harness);
+
+    StdVec<Real> particle_spacings = {0.05, 0.025, 0.0125};
+    for (Real particle_spacing : particle_spacings)
+    {
+        runCompactConfigurationBenchmarks(harness, particle_spacing);
+        runDambreakBenchmarks<execution::ParallelPolicy>(harness, particle_spacing, "cpu");
+#if SPHINXSYS_USE_SYCL
+        runDambreakBenchmarks<execution::ParallelDevicePolicy>(harness, particle_spacing, "sycl");
+#endif
+    }
+    return 0;
+}
@@ -0,0 +1,178 @@
+/**
+ * @file benchmarks_3d.cpp
+ * @brief Micro, mid-level and macro benchmarks of 3D solvers.
+ * @details The micro group times the 3x3 polar decomposition, the mid group times
+ * signed-distance probing on a multilevel level set and the macro group times
+ * complete time steps of the passive cantilever at several resolutions.
+ * @author Xiangyu Hu
+ */
+#include "benchmark_harness.h"
+#include "polar_decomposition_3x3.h"
+#include "sphinxsys.h"
+using namespace SPH;
+using namespace SPH::benchmark;
+//----------------------------------------------------------------------
+//	Passive cantilever geometry and material (see test_3d_passive_cantilever).
+//----------------------------------------------------------------------
+Real PL = 6.0;
+Real PH = 1.0;
+Real PW = 1.0;
+Real SL = 0.5;
+Vecd halfsize_cantilever(0.5 * (PL + SL), 0.5 * PH, 0.5 * PW);
+Vecd translation_cantilever(0.5 * (PL - SL), 0.5 * PH, 0.5 * PW);
+Vecd halfsize_holder(0.5 * SL, 0.5 * PH, 0.5 * PW);
+Vecd translation_holder(-0.5 * SL, 0.5 * PH, 0.5 * PW);
+Real rho0_s = 1100.0;
+Real poisson = 0.45;
+Real Youngs_modulus = 1.7e7;
+Real a = Youngs_modulus / (2.0 * (1.0 + poisson));
+Real a0[4] = {a, 0.0, 0.0, 0.0};
+Real b0[4] = {1.0, 0.0, 0.0, 0.0};
+Vec3d fiber_direction(1.0, 0.0, 0.0);
+Vec3d sheet_direction(0.0, 1.0, 0.0);
+Real bulk_modulus = Youngs_modulus / 3.0 / (1.0 - 2.0 * poisson);
+//----------------------------------------------------------------------
+class Cantilever : public ComplexShape
+{
+  public:
+    explicit Cantilever(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        add<TransformShape<GeometricShapeBox>>(Transform(translation_cantilever), halfsize_cantilever);
+        add<TransformShape<GeometricShapeBox>>(Transform(translation_holder), halfsize_holder);
+    }
+};
+
+class CantileverInitialCondition : public solid_dynamics::ElasticDynamicsInitialCondition
+{
+  public:
+    explicit CantileverInitialCondition(SPHBody &sph_body)
+        : solid_dynamics::ElasticDynamicsInitialCondition(sph_body){};
+
+    void update(size_t index_i, Real dt)
+    {
+        if (pos_[index_i][0] > 0.0)
+        {
+            vel_[index_i][1] = 5.0 * sqrt(3.0);
+            vel_[index_i][2] = 5.0;
+        }
+    };
+};
+/** Exposes the signed-distance probe of the underlying multilevel level set. */
+class ProbingLevelSetShape : public LevelSetShape
+{
+  public:
+    ProbingLevelSetShape(SPHBody &sph_body, Shape &shape) : LevelSetShape(sph_body, shape){};
+    Real probeSignedDistance(const Vecd &probe_point) { return level_set_.probeSignedDistance(probe_point); };
+};
+//----------------------------------------------------------------------
+//	Micro benchmarks.
+//----------------------------------------------------------------------
+void runMicroBenchmarks(BenchmarkHarness &harness)
+{
+    const size_t number_of_samples = 100000;
+    StdVec<Mat3d> deformations(number_of_samples);
+    for (size_t i = 0; i != number_of_samples; ++i)
+    {
+        Real ratio = Real(i) / Real(number_of_samples);
+        Mat3d rotation = Eigen::AngleAxis<Real>(10.0 * ratio, Vec3d(1.0, ratio, 1.0 - ratio).normalized()).toRotationMatrix();
+        Mat3d stretch = Mat3d::Identity() + 0.1 * ratio * Mat3d::Ones();
+        deformations[i] = rotation * stretch;
+    }
+
+    harness.run("micro", "polar::polar_decomposition", "cpu", number_of_samples, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_samples; ++i)
+                    {
+                        Mat3d rotation, scale; // Eigen matrices are column major by default
+                        polar::polar_decomposition(rotation.data(), scale.data(), deformations[i].data());
+                        sum += rotation(0, 0) + scale(2, 2);
+                    }
+                    doNotOptimize(sum);
+                });
+}
+//----------------------------------------------------------------------
+//	Mid-level benchmarks.
+//----------------------------------------------------------------------
+void runLevelSetBenchmarks(BenchmarkHarness &harness, Real resolution)
+{
+    Real BW = resolution * 4;
+    BoundingBox system_domain_bounds(Vecd(-SL - BW, -BW, -BW), Vecd(PL + BW, PH + BW, PH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution);
+    Cantilever cantilever_shape("CantileverShape");
+    SolidBody cantilever_body(sph_system, makeShared<Cantilever>("CantileverBody"));
+    ProbingLevelSetShape level_set_shape(cantilever_body, cantilever_shape);
+
+    const size_t number_of_probes = 100000;
+    StdVec<Vecd> probe_points(number_of_probes);
+    Vecd lower = system_domain_bounds.first_;
+    Vecd extent = system_domain_bounds.second_ - system_domain_bounds.first_;
+    for (size_t i = 0; i != number_of_probes; ++i)
+    {
+        Vecd ratio(Real(i % 47) / 47.0, Real(i % 53) / 53.0, Real(i % 59) / 59.0);
+        probe_points[i] = lower + extent.cwiseProduct(ratio);
+    }
+
+    std::string name = "MultilevelLevelSet::probeSignedDistance/dp=" + std::to_string(resolution);
+    harness.run("mid", name, "cpu", number_of_probes, [&]()
+                {
+                    Real sum = 0.0;
+                    for (size_t i = 0; i != number_of_probes; ++i)
+                        sum += level_set_shape.probeSignedDistance(probe_points[i]);
+                    doNotOptimize(sum);
+                });
+}
+//----------------------------------------------------------------------
+//	Macro benchmarks.
+//----------------------------------------------------------------------
+void runPassiveCantileverBenchmarks(BenchmarkHarness &harness, Real resolution)
+{
+    Real BW = resolution * 4;
+    BoundingBox system_domain_bounds(Vecd(-SL - BW, -BW, -BW), Vecd(PL + BW, PH + BW, PH + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution);
+    SolidBody cantilever_body(sph_system, makeShared<Cantilever>("CantileverBody"));
+    cantilever_body.defineMaterial<Muscle>(rho0_s, bulk_modulus, fiber_direction, sheet_direction, a0, b0);
+    cantilever_body.generateParticles<BaseParticles, Lattice>();
+
+    InnerRelation cantilever_body_inner(cantilever_body);
+    InteractionWithUpdate<LinearGradientCorrectionMatrixInner> corrected_configuration(cantilever_body_inner);
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> stress_relaxation_first_half(cantilever_body_inner);
+    Dynamics1Level<solid_dynamics::Integration2ndHalf> stress_relaxation_second_half(cantilever_body_inner);
+    SimpleDynamics<CantileverInitialCondition> initialization(cantilever_body);
+    ReduceDynamics<solid_dynamics::AcousticTimeStep> computing_time_step_size(cantilever_body);
+    TransformShape<GeometricShapeBox> holder_shape(Transform(translation_holder), halfsize_holder, "Holder");
+    BodyRegionByParticle holder(cantilever_body, holder_shape);
+    SimpleDynamics<FixBodyPartConstraint> constraint_holder(holder);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    initialization.exec();
+    corrected_configuration.exec();
+    Real dt = computing_time_step_size.exec();
+
+    size_t particles = cantilever_body.getBaseParticles().TotalRealParticles();
+    std::string name = "PassiveCantileverStep/dp=" + std::to_string(resolution);
+    harness.run("macro", name, "cpu", particles, [&]()
+                {
+                    stress_relaxation_first_half.exec(dt);
+                    constraint_holder.exec(dt);
+                    stress_relaxation_second_half.exec(dt);
+                    dt = computing_time_step_size.exec();
+                });
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    BenchmarkHarness harness(ac, av);
+    runMicroBenchmarks(harness);
+
+    StdVec<Real> resolutions = {PH / 6.0, PH / 12.0, PH / 24.0};
+    for (Real resolution : resolutions)
+    {
+        runLevelSetBenchmarks(harness, resolution);
+        runPassiveCantileverBenchmarks(harness, resolution);
+    }
+    return 0;
+}
@@ -0,0 +1,298 @@
+/**
+ * @file scaling_3d.cpp
+ * @brief Strong and weak scaling of a 3D dam break (see test_3d_dambreak).
+ * @details Each configuration runs a fixed number of steps in a new system
+ * whose thread arena has the given number of threads. For strong scaling the resolution is fixed,
+ * for weak scaling it is refined so that the number of particles grows with the threads.
+ * The parallel efficiency of each dynamics is the particles updated per second and thread
+ * relative to that of the first thread count, so that losses are attributed to single loops.
+ * The cell linked list, configuration updates and output are timed as additional records.
+ * Command line options: --threads=<n1,n2,...>, --resolution=<dp>, --steps=<n>,
+ * --mode=<strong|weak|both>, --json=<file>.
+ * @author Xiangyu Hu
+ */
+#include "sphinxsys.h"
+using namespace SPH;
+//----------------------------------------------------------------------
+//	Dam break geometry and material.
+//----------------------------------------------------------------------
+Real DL = 5.366; // tank length
+Real DH = 2.0;   // tank height
+Real DW = 0.5;   // tank width
+Real LL = 2.0;   // liquid length
+Real LH = 1.0;   // liquid height
+Real LW = 0.5;   // liquid width
+Real rho0_f = 1.0;
+Real gravity_g = 1.0;
+Real U_f = 2.0 * sqrt(gravity_g * LH);
+Real c_f = 10.0 * U_f;
+
+class WaterBlock : public ComplexShape
+{
+  public:
+    explicit WaterBlock(const std::string &shape_name) : ComplexShape(shape_name)
+    {
+        Vecd halfsize_water(0.5 * LL, 0.5 * LH, 0.5 * LW);
+        Transform translation_water(halfsize_water);
+        add<TransformShape<GeometricShapeBox>>(Transform(translation_water), halfsize_water);
+    }
+};
+
+class WallBoundary : public ComplexShape
+{
+  public:
+    WallBoundary(const std::string &shape_name, Real boundary_width) : ComplexShape(shape_name)
+    {
+        Vecd halfsize_outer(0.5 * DL + boundary_width, 0.5 * DH + boundary_width, 0.5 * DW + boundary_width);
+        Vecd halfsize_inner(0.5 * DL, 0.5 * DH, 0.5 * DW);
+        Transform translation_wall(halfsize_inner);
+        add<TransformShape<GeometricShapeBox>>(Transform(translation_wall), halfsize_outer);
+        subtract<TransformShape<GeometricShapeBox>>(Transform(translation_wall), halfsize_inner);
+    }
+};
+//----------------------------------------------------------------------
+//	The timing of one configuration.
+//----------------------------------------------------------------------
+struct ScalingResult
+{
+    int threads_;
+    Real resolution_;
+    size_t particles_;
+    Real wall_time_;
+    std::map<std::string, Real> dynamics_time_; /**< total time of each profiled dynamics */
+};
+
+ScalingResult runDamBreak(int number_of_threads, Real resolution, size_t number_of_steps)
+{
+    Real BW = resolution * 4;
+    BoundingBox system_domain_bounds(Vecd(-BW, -BW, -BW), Vecd(DL + BW, DH + BW, DW + BW));
+    SPHSystem sph_system(system_domain_bounds, resolution, number_of_threads);
+    sph_system.setIOEnvironment();
+    sph_system.setDynamicsProfiling(true);
+    DynamicsProfiler &dynamics_profiler = sph_system.getDynamicsProfiler();
+
+    FluidBody water_block(sph_system, makeShared<WaterBlock>("WaterBody"));
+    water_block.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+
+    SolidBody wall_boundary(sph_system, makeShared<WallBoundary>("WallBoundary", BW));
+    wall_boundary.defineMaterial<Solid>();
+    wall_boundary.generateParticles<BaseParticles, Lattice>();
+
+    InnerRelation water_block_inner(water_block);
+    ContactRelation water_wall_contact(water_block, {&wall_boundary});
+    ComplexRelation water_block_complex(water_block_inner, water_wall_contact);
+
+    Gravity gravity(Vec3d(0.0, -gravity_g, 0.0));
+    SimpleDynamics<GravityForce<Gravity>> constant_gravity(water_block, gravity);
+    SimpleDynamics<NormalDirectionFromBodyShape> wall_boundary_normal_direction(wall_boundary);
+    Dynamics1Level<fluid_dynamics::Integration1stHalfWithWallRiemann> pressure_relaxation(water_block_inner, water_wall_contact);
+    Dynamics1Level<fluid_dynamics::Integration2ndHalfWithWallRiemann> density_relaxation(water_block_inner, water_wall_contact);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationComplexFreeSurface> update_density_by_summation(water_block_inner, water_wall_contact);
+    ReduceDynamics<fluid_dynamics::AdvectionViscousTimeStep> get_fluid_advection_time_step_size(water_block, U_f);
+    ReduceDynamics<fluid_dynamics::AcousticTimeStep> get_fluid_time_step_size(water_block);
+    ParticleSorting particle_sorting(water_block);
+    BodyStatesRecordingToVtp write_water_block_states(sph_system);
+
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    wall_boundary_normal_direction.exec();
+    constant_gravity.exec();
+
+    /** the work not done by particle dynamics is timed with records of its own */
+    DynamicsProfiler::Record *cell_linked_list_record = dynamics_profiler.registerDynamics("WaterBody: updateCellLinkedList");
+    DynamicsProfiler::Record *configuration_record = dynamics_profiler.registerDynamics("WaterBody: updateConfiguration");
+    DynamicsProfiler::Record *output_record = dynamics_profiler.registerDynamics("output: BodyStatesRecordingToVtp");
+    size_t particles = water_block.getBaseParticles().TotalRealParticles();
+
+    Real dt = get_fluid_time_step_size.exec();
+    TickCount t1 = TickCount::now();
+    for (size_t step = 1; step <= number_of_steps; ++step)
+    {
+        Real Dt = get_fluid_advection_time_step_size.exec();
+        update_density_by_summation.exec();
+        Real relaxation_time = 0.0;
+        while (relaxation_time < Dt)
+        {
+            pressure_relaxation.exec(dt);
+            density_relaxation.exec(dt);
+            dt = get_fluid_time_step_size.exec();
+            relaxation_time += dt;
+        }
+
+        if (step % 100 == 0)
+        {
+            particle_sorting.exec();
+        }
+        {
+            DynamicsProfiler::Scope scope(cell_linked_list_record, particles);
+            water_block.updateCellLinkedList();
+        }
+        {
+            DynamicsProfiler::Scope scope(configuration_record, particles);
+            water_block_complex.updateConfiguration();
+        }
+        if (step % 50 == 0)
+        {
+            DynamicsProfiler::Scope scope(output_record, particles);
+            write_water_block_states.writeToFile(step);
+        }
+    }
+    sph_system.flushAsyncIO();
+
+    ScalingResult result{number_of_threads, resolution, particles, (TickCount::now() - t1).seconds(), {}};
+    for (DynamicsProfiler::Record *record : dynamics_profiler.Records())
+        result.dynamics_time_[record->name_] += record->total_time_;
+    dynamics_profiler.setEnabled(false); // no report for each configuration
+    return result;
+}
+//----------------------------------------------------------------------
+//	Parallel efficiency relative to the first configuration.
+//----------------------------------------------------------------------
+Real parallelEfficiency(const ScalingResult &base, Real base_time, const ScalingResult &result, Real time)
+{
+    if (base_time <= 0.0 || time <= 0.0)
+        return 0.0;
+    Real base_rate = Real(base.particles_) / (base_time * Real(base.threads_));
+    Real rate = Real(result.particles_) / (time * Real(result.threads_));
+    return rate / base_rate;
+}
+
+void writeEfficiencyReport(const std::string &mode, const StdVec<ScalingResult> &results, std::ostream &output)
+{
+    const ScalingResult &base = results.front();
+    StdVec<std::pair<std::string, Real>> sorted_dynamics(base.dynamics_time_.begin(), base.dynamics_time_.end());
+    std::stable_sort(sorted_dynamics.begin(), sorted_dynamics.end(),
+                     [](const std::pair<std::string, Real> &a, const std::pair<std::string, Real> &b)
+                     { return a.second > b.second; });
+
+    output << "\n " << mode << " scaling, parallel efficiency relative to " << base.threads_ << " thread(s):\n";
+    output << std::setw(12) << "threads";
+    for (const ScalingResult &result : results)
+        output << std::setw(10) << result.threads_;
+    output << "\n" << std::setw(12) << "particles";
+    for (const ScalingResult &result : results)
+        output << std::setw(10) << result.particles_;
+    output << "\n" << std::setw(12) << "wall[s]";
+    for (const ScalingResult &result : results)
+        output << std::setw(10) << std::fixed << std::setprecision(3) << result.wall_time_;
+    output << "\n" << std::setw(12) << "total";
+    for (const ScalingResult &result : results)
+        output << std::setw(10) << std::setprecision(3) << parallelEfficiency(base, base.wall_time_, result, result.wall_time_);
+    output << "\n";
+    for (auto &dynamics : sorted_dynamics)
+    {
+        output << std::setw(12) << "";
+        for (const ScalingResult &result : results)
+        {
+            auto found = result.dynamics_time_.find(dynamics.first);
+            Real time = found != result.dynamics_time_.end() ? found->second : 0.0;
+            output << std::setw(10) << std::setprecision(3) << parallelEfficiency(base, dynamics.second, result, time);
+        }
+        output << "  " << dynamics.first << "\n";
+    }
+    output << std::defaultfloat;
+}
+
+void writeToJSON(std::ofstream &out_file, const std::string &mode, const StdVec<ScalingResult> &results)
+{
+    out_file << "  \"" << mode << "\": [";
+    for (size_t i = 0; i != results.size(); ++i)
+    {
+        const ScalingResult &result = results[i];
+        out_file << (i == 0 ? "\n" : ",\n") << std::scientific << std::setprecision(9)
+                 << "    {\"threads\": " << result.threads_ << ", \"resolution\": " << result.resolution_
+                 << ", \"particles\": " << result.particles_ << ", \"wall_time\": " << result.wall_time_
+                 << ", \"dynamics\": {";
+        size_t j = 0;
+        for (auto &dynamics : result.dynamics_time_)
+            out_file << (j++ == 0 ? "" : ", ") << "\"" << dynamics.first << "\": " << dynamics.second;
+        out_file << "}}";
+    }
+    out_file << "\n  ]";
+}
+//----------------------------------------------------------------------
+//	Main program starts here.
+//----------------------------------------------------------------------
+int main(int ac, char *av[])
+{
+    StdVec<int> thread_counts;
+    Real resolution = 0.05;
+    size_t number_of_steps = 200;
+    std::string mode = "both";
+    std::string json_file;
+    for (int i = 1; i < ac; ++i)
+    {
+        std::string argument(av[i]);
+        if (argument.rfind("--threads=", 0) == 0)
+        {
+            std::stringstream list(argument.substr(10));
+            std::string item;
+            while (std::getline(list, item, ','))
+                thread_counts.push_back(std::stoi(item));
+        }
+        else if (argument.rfind("--resolution=", 0) == 0)
+            resolution = std::stod(argument.substr(13));
+        else if (argument.rfind("--steps=", 0) == 0)
+            number_of_steps = std::stoul(argument.substr(8));
+        else if (argument.rfind("--mode=", 0) == 0)
+            mode = argument.substr(7);
+        else if (argument.rfind("--json=", 0) == 0)
+            json_file = argument.substr(7);
+        else
+        {
+            std::cout << "\n Usage: " << av[0] << " [--threads=<n1,n2,...>] [--resolution=<dp>] [--steps=<n>]"
+                      << " [--mode=<strong|weak|both>] [--json=<file>]" << std::endl;
+            std::cout << __FILE__ << ':' << __LINE__ << std::endl;
+            exit(1);
+        }
+    }
+    if (thread_counts.empty())
+    {
+        int hardware_threads = SMAX(int(std::thread::hardware_concurrency()), 1);
+        for (int threads = 1; threads < hardware_threads; threads *= 2)
+            thread_counts.push_back(threads);
+        thread_counts.push_back(hardware_threads);
+    }
+
+    std::ofstream out_file;
+    if (!json_file.empty())
+    {
+        out_file.open(json_file.c_str(), std::ios::trunc);
+        out_file << "{\n";
+    }
+
+    if (mode == "strong" || mode == "both")
+    {
+        StdVec<ScalingResult> results;
+        for (int threads : thread_counts)
+            results.push_back(runDamBreak(threads, resolution, number_of_steps));
+        writeEfficiencyReport("strong", results, std::cout);
+        if (out_file.is_open())
+            writeToJSON(out_file, "strong", results);
+    }
+
+    if (mode == "weak" || mode == "both")
+    {
+        StdVec<ScalingResult> results;
+        for (int threads : thread_counts)
+        {
+            /** the number of particles grows with the threads, as the resolution is refined in all directions */
+            Real weak_resolution = resolution * pow(Real(thread_counts.front()) / Real(threads), 1.0 / 3.0);
+            results.push_back(runDamBreak(threads, weak_resolution, number_of_steps));
+        }
+        writeEfficiencyReport("weak", results, std::cout);
+        if (out_file.is_open())
+        {
+            out_file << (mode == "both" ? ",\n" : "");
+            writeToJSON(out_file, "weak", results);
+        }
+    }
+
+    if (out_file.is_open())
+    {
+        out_file << "\n}\n";
+        out_file.close();
+    }
+    return 0;
+}
@@ -47,19 +47,8 @@ class OWSCEnv(gym.Env):
         # Start the simulation with the given action time and damping coefficient
         self.owsc.run_case(self.action_time, self.damping_coefficient)
         
-        # Initialize observation array with zero values
-        self.observation = np.zeros(self.obs_numbers)
-        # Fill the observation array with values from the OWSC simulation
-        for i in range(0, 2):  
-            self.observation[i] = self.owsc.get_wave_height(i)
-            self.observation[i + 2] = self.owsc.get_wave_velocity(i, 0)
-            self.observation[i + 4] = self.owsc.get_wave_velocity(i, 1)
-            self.observation[i + 6] = self.owsc.get_wave_velocity_on_flap(i, 0)
-            self.observation[i + 8] = self.owsc.get_wave_velocity_on_flap(i, 1)
-            self.observation[i + 10] = self.owsc.get_flap_position(i, 0)
-            self.observation[i + 12] = self.owsc.get_flap_position(i, 1)
-        self.observation[14] = self.owsc.get_flap_angle()
-        self.observation[15] = self.owsc.get_flap_angle_rate()
+        # Observation array filled in memory by the OWSC simulation
+        self.observation = self.owsc.observe()
         
         self._get_obs = self.observation.astype(np.float32)
 
@@ -79,30 +68,21 @@ class OWSCEnv(gym.Env):
             self.damping_change = 100 - self.damping_coefficient
             penality_0 = - 1.0
 
-        reward_0 = 0.0
-        for i in range(self.update_per_action):
-            self.flap_angle_rate_previous = self.owsc.get_flap_angle_rate()
-            self.damping_coefficient += self.damping_change / self.update_per_action
-            self.action_time += self.time_per_action / self.update_per_action
-            self.owsc.run_case(self.action_time, self.damping_coefficient)
-            self.flap_angle_rate_now = self.owsc.get_flap_angle_rate()
-            # Calculate reward based on energy (flap angle rate)
-            reward_0 += self.damping_coefficient * math.pow(0.5 * (self.flap_angle_rate_now + self.flap_angle_rate_previous), 2) * self.time_per_action / self.update_per_action
+        # Advance all smaller iterations of the action in one call, the observations are returned in memory
+        flap_angle_rate_previous = self.observation[15]
+        damping_coefficients = self.damping_coefficient + self.damping_change / self.update_per_action * np.arange(1, self.update_per_action + 1)
+        observations = self.owsc.step(damping_coefficients, self.time_per_action / self.update_per_action)
+        self.damping_coefficient = damping_coefficients[-1]
+        self.action_time += self.time_per_action
+        # Calculate reward based on energy (flap angle rate)
+        flap_angle_rates = np.concatenate(([flap_angle_rate_previous], observations[:, 15]))
+        reward_0 = np.sum(damping_coefficients * np.power(0.5 * (flap_angle_rates[1:] + flap_angle_rates[:-1]), 2)) * self.time_per_action / self.update_per_action
         # Add any penalties to the reward
         reward = reward_0 + penality_0
         self.total_reward_per_episode += reward
 
-        # Update observations from the OWSC simulation
-        for i in range(0, 2):  
-            self.observation[i] = self.owsc.get_wave_height(i)
-            self.observation[i + 2] = self.owsc.get_wave_velocity(i, 0)
-            self.observation[i + 4] = self.owsc.get_wave_velocity(i, 1)
-            self.observation[i + 6] = self.owsc.get_wave_velocity_on_flap(i, 0)
-            self.observation[i + 8] = self.owsc.get_wave_velocity_on_flap(i, 1)
-            self.observation[i + 10] = self.owsc.get_flap_position(i, 0)
-            self.observation[i + 12] = self.owsc.get_flap_position(i, 1)
-        self.observation[14] = self.owsc.get_flap_angle()
-        self.observation[15] = self.owsc.get_flap_angle_rate()
+        # Update observations from the last smaller iteration
+        self.observation = observations[-1]
 
         self._get_obs = self.observation.astype(np.float32)
 
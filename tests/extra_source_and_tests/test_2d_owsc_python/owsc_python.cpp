@@ -8,7 +8,10 @@
 #include "custom_io_observation.h"
 #include "custom_io_simbody.h"
 #include "sphinxsys.h"
+#include "io_python.h"
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 using namespace SPH;
 namespace py = pybind11;
@@ -151,6 +154,10 @@ class SphOWSC : public SimbodyEnvironment
     /** WaveProbes. */
     BodyRegionByCell wave_probe_buffer_no_0, wave_probe_buffer_no_1;
     ExtendedReducedQuantityRecording<UpperFrontInAxisDirection<BodyPartByCell>> wave_probe_0, wave_probe_1;
+    /** NumPy views of the particle variables. */
+    ParticleVariableViews water_block_views, flap_views;
+    /** In-memory snapshots for fast resets. */
+    StateSnapshotIO state_snapshot_io;
     //----------------------------------------------------------------------
     //	    Basic control parameters for time stepping.
     //----------------------------------------------------------------------
@@ -161,6 +168,7 @@ class SphOWSC : public SimbodyEnvironment
     Real total_time = 0.0;
     Real relax_time = 1.0;
     Real output_interval = 0.1;
+    Real pause_time = 0.0;
     /** statistics for computing time. */
     TickCount t1 = TickCount::now();
     TimeInterval interval;
@@ -213,9 +221,13 @@ class SphOWSC : public SimbodyEnvironment
           wave_probe_buffer_no_0(water_block, makeShared<MultiPolygonShape>(createWaveProbeShape(3.0), "WaveProbe_03")),
           wave_probe_buffer_no_1(water_block, makeShared<MultiPolygonShape>(createWaveProbeShape(5.0), "WaveProbe_05")),
           wave_probe_0(wave_probe_buffer_no_0, "FreeSurfaceHeight"),
-          wave_probe_1(wave_probe_buffer_no_1, "FreeSurfaceHeight")
+          wave_probe_1(wave_probe_buffer_no_1, "FreeSurfaceHeight"),
+          water_block_views(water_block.getBaseParticles()),
+          flap_views(flap.getBaseParticles()),
+          state_snapshot_io(sph_system)
     {
         physical_time = 0.0;
+        state_snapshot_io.addSimbodyIntegrator(integ);
         //----------------------------------------------------------------------
         //	Prepare the simulation with cell linked list, configuration
         //	and case specified initial condition if necessary.
@@ -240,6 +252,8 @@ class SphOWSC : public SimbodyEnvironment
     }
 
     virtual ~SphOWSC(){};
+    ParticleVariableViews &getWaterBlockViews() { return water_block_views; };
+    ParticleVariableViews &getFlapViews() { return flap_views; };
     //----------------------------------------------------------------------
     //	    For ctest.
     //----------------------------------------------------------------------
@@ -296,10 +310,116 @@ class SphOWSC : public SimbodyEnvironment
         return flap_position_probe.getObservedQuantity()[number][direction];
     };
     //----------------------------------------------------------------------
+    //	    Observation vector in the order used by the DRL environment:
+    //	    wave heights, wave velocities in x and y, velocities on the flap in x and y,
+    //	    flap positions in x and y, flap angle and flap angle rate.
+    //----------------------------------------------------------------------
+    static constexpr size_t number_of_observations = 16;
+
+    void observe(Real *observation)
+    {
+        wave_velocity_probe.exec();
+        wave_velocity_on_flap_probe.exec();
+        flap_position_probe.exec();
+        for (int i = 0; i != 2; ++i)
+        {
+            observation[i] = getWaveHeight(i);
+            observation[i + 2] = getWaveVelocity(i, 0);
+            observation[i + 4] = getWaveVelocity(i, 1);
+            observation[i + 6] = getWaveVelocityOnFlap(i, 0);
+            observation[i + 8] = getWaveVelocityOnFlap(i, 1);
+            observation[i + 10] = getFlapPositon(i, 0);
+            observation[i + 12] = getFlapPositon(i, 1);
+        }
+        observation[14] = getFlapAngle();
+        observation[15] = getFlapAngleRate();
+    };
+
+    py::array_t<Real> getObservation()
+    {
+        py::array_t<Real> observation(number_of_observations);
+        observe(observation.mutable_data());
+        return observation;
+    };
+    //----------------------------------------------------------------------
+    //	    Advance the case by one action time per damping coefficient and record
+    //	    the observation after each of them, without writing any file.
+    //	    The python interpreter lock is not held here.
+    //----------------------------------------------------------------------
+    void advanceSteps(const Real *damping_coefficients, size_t number_of_steps,
+                      Real time_per_step, Real *observations)
+    {
+        for (size_t n = 0; n != number_of_steps; ++n)
+        {
+            advanceTo(pause_time + time_per_step, damping_coefficients[n], false);
+            observe(observations + n * number_of_observations);
+        }
+    };
+
+    py::array_t<Real> step(py::array_t<Real, py::array::c_style | py::array::forcecast> damping_coefficients,
+                           Real time_per_step)
+    {
+        size_t number_of_steps = damping_coefficients.size();
+        py::array_t<Real> observations({number_of_steps, number_of_observations});
+        const Real *damping_data = damping_coefficients.data();
+        Real *observation_data = observations.mutable_data();
+        {
+            py::gil_scoped_release release;
+            advanceSteps(damping_data, number_of_steps, time_per_step, observation_data);
+        }
+        return observations;
+    };
+    //----------------------------------------------------------------------
+    //	    Snapshot of the case in memory, restored for resetting an episode
+    //	    without reconstructing the case.
+    //----------------------------------------------------------------------
+    struct Snapshot
+    {
+        StateSnapshot state;
+        int number_of_iterations;
+        Real dt, total_time, pause_time;
+    };
+
+    Snapshot takeSnapshot()
+    {
+        return {state_snapshot_io.takeSnapshot(), number_of_iterations, dt, total_time, pause_time};
+    };
+
+    void restoreSnapshot(const Snapshot &snapshot)
+    {
+        state_snapshot_io.restoreSnapshot(snapshot.state);
+        number_of_iterations = snapshot.number_of_iterations;
+        dt = snapshot.dt;
+        total_time = snapshot.total_time;
+        pause_time = snapshot.pause_time;
+    };
+    //----------------------------------------------------------------------
     //	    Main loop of time stepping starts here. && For changing damping coefficient.
     //----------------------------------------------------------------------
     void runCase(Real pause_time_from_python, Real dampling_coefficient_from_python)
     {
+        advanceTo(pause_time_from_python, dampling_coefficient_from_python, true);
+        TickCount t4 = TickCount::now();
+
+        TimeInterval tt;
+        tt = t4 - t1 - interval;
+
+        // This section is used for CMake testing (cmake test).
+        // During reinforcement learning training, this part can be commented out.
+        if (sph_system.GenerateRegressionData())
+        {
+            write_total_viscous_force_from_fluid.generateDataBase(1.0e-3);
+        }
+        else
+        {
+            write_total_viscous_force_from_fluid.testResult();
+        }
+    };
+
+  protected:
+    void advanceTo(Real pause_time_from_python, Real dampling_coefficient_from_python, bool write_output)
+    {
+        pause_time = pause_time_from_python;
         while (physical_time < pause_time_from_python)
         {
             Real integral_time = 0.0;
@@ -358,7 +478,7 @@ class SphOWSC : public SimbodyEnvironment
                 flap_contact.updateConfiguration();
                 flap_observer_contact_with_water.updateConfiguration();
                 wave_velocity_observer_contact_with_water.updateConfiguration();
-                if (total_time >= relax_time)
+                if (write_output && total_time >= relax_time)
                 {
                     write_total_viscous_force_from_fluid.writeToFile(number_of_iterations);
                     wave_velocity_probe.writeToFile(number_of_iterations);
@@ -371,31 +491,49 @@ class SphOWSC : public SimbodyEnvironment
             }
 
             TickCount t2 = TickCount::now();
-            if (total_time >= relax_time)
+            if (write_output && total_time >= relax_time)
                 write_real_body_states.writeToFile();
             TickCount t3 = TickCount::now();
             interval += t3 - t2;
         }
-        TickCount t4 = TickCount::now();
-
-        TimeInterval tt;
-        tt = t4 - t1 - interval;
-
-        // This section is used for CMake testing (cmake test).
-        // During reinforcement learning training, this part can be commented out.
-        if (sph_system.GenerateRegressionData())
-        {
-            write_total_viscous_force_from_fluid.generateDataBase(1.0e-3);
-        }
-        else
-        {
-            write_total_viscous_force_from_fluid.testResult();
-        }
     };
 };
+//----------------------------------------------------------------------
+//	    Step vectorized environments, each with its own row of damping coefficients.
+//	    The environments run concurrently on the shared thread pool.
+//	    Returns the observations as an array of (environments, steps, observations).
+//----------------------------------------------------------------------
+py::array_t<Real> stepAll(const StdVec<SphOWSC *> &environments,
+                          py::array_t<Real, py::array::c_style | py::array::forcecast> damping_coefficients,
+                          Real time_per_step)
+{
+    size_t number_of_environments = environments.size();
+    if (damping_coefficients.ndim() != 2 || size_t(damping_coefficients.shape(0)) != number_of_environments)
+    {
+        throw py::value_error("damping coefficients should be an array of (environments, steps).");
+    }
+    size_t number_of_steps = damping_coefficients.shape(1);
+    size_t observations_per_environment = number_of_steps * SphOWSC::number_of_observations;
+    py::array_t<Real> observations({number_of_environments, number_of_steps, SphOWSC::number_of_observations});
+    const Real *damping_data = damping_coefficients.data();
+    Real *observation_data = observations.mutable_data();
+    {
+        py::gil_scoped_release release;
+        tbb::parallel_for(
+            size_t(0), number_of_environments,
+            [&](size_t i)
+            {
+                environments[i]->advanceSteps(damping_data + i * number_of_steps, number_of_steps, time_per_step,
+                                              observation_data + i * observations_per_environment);
+            });
+    }
+    return observations;
+}
 
 PYBIND11_MODULE(test_2d_owsc_python, m)
 {
+    ParticleVariableViews::bind(m, "ParticleVariableViews");
+    py::class_<SphOWSC::Snapshot>(m, "Snapshot");
     py::class_<SphOWSC>(m, "owsc_from_sph_cpp")
         .def(py::init<const int &, const int &>())
         .def("cmake_test", &SphOWSC::cmakeTest)
@@ -405,5 +543,12 @@ PYBIND11_MODULE(test_2d_owsc_python, m)
         .def("get_wave_velocity", &SphOWSC::getWaveVelocity)
         .def("get_wave_velocity_on_flap", &SphOWSC::getWaveVelocityOnFlap)
         .def("get_flap_position", &SphOWSC::getFlapPositon)
+        .def("water_block_views", &SphOWSC::getWaterBlockViews, py::return_value_policy::reference_internal)
+        .def("flap_views", &SphOWSC::getFlapViews, py::return_value_policy::reference_internal)
+        .def("observe", &SphOWSC::getObservation)
+        .def("step", &SphOWSC::step, py::arg("damping_coefficients"), py::arg("time_per_step"))
+        .def("snapshot", &SphOWSC::takeSnapshot)
+        .def("restore", &SphOWSC::restoreSnapshot)
         .def("run_case", &SphOWSC::runCase);
+    m.def("step_all", &stepAll, py::arg("environments"), py::arg("damping_coefficients"), py::arg("time_per_step"));
 }
@@ -0,0 +1,80 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real plate_half_size = 1.0;
+Real resolution_ref = 0.05;
+
+/** a square plate with a hole, the bounds do not depend on the hole radius */
+SharedPtr<MultiPolygonShape> createPlate(Real hole_radius)
+{
+    MultiPolygon plate;
+    plate.addABox(Transform(Vecd::Zero()), plate_half_size * Vecd::Ones(), ShapeBooleanOps::add);
+    plate.addACircle(Vecd::Zero(), hole_radius, 100, ShapeBooleanOps::sub);
+    return makeShared<MultiPolygonShape>(plate, "Plate");
+}
+
+StdVec<fs::path> listCacheFiles(const std::string &cache_folder)
+{
+    StdVec<fs::path> cache_files;
+    for (const auto &entry : fs::directory_iterator(cache_folder))
+        cache_files.push_back(entry.path());
+    return cache_files;
+}
+
+StdVec<Real> probeSignedDistances(LevelSetShape &level_set_shape)
+{
+    StdVec<Real> signed_distances;
+    Real probe_spacing = 0.5 * resolution_ref;
+    int number_of_probes = int(2.0 * plate_half_size / probe_spacing);
+    for (int i = 0; i != number_of_probes; ++i)
+        for (int j = 0; j != number_of_probes; ++j)
+        {
+            Vecd probe_point = -plate_half_size * Vecd::Ones() + probe_spacing * Vecd(Real(i) + 0.5, Real(j) + 0.5);
+            signed_distances.push_back(level_set_shape.findSignedDistance(probe_point));
+        }
+    return signed_distances;
+}
+
+TEST(test_level_set_cache, hit_miss_and_rebuild)
+{
+    auto plate_shape = createPlate(0.5);
+    BoundingBox system_bounds(-1.5 * plate_half_size * Vecd::Ones(), 1.5 * plate_half_size * Vecd::Ones());
+    SPHSystem sph_system(system_bounds, resolution_ref);
+    sph_system.setLevelSetCache(true);
+    SolidBody plate_body(sph_system, plate_shape);
+
+    std::string cache_folder = sph_system.getIOEnvironment().reload_folder_ + "/level_set_cache";
+    fs::remove_all(cache_folder);
+
+    // a miss builds the level set and writes a single cache file
+    LevelSetShape level_set_shape(plate_body, *plate_shape);
+    StdVec<fs::path> cache_files = listCacheFiles(cache_folder);
+    ASSERT_EQ(cache_files.size(), 1u);
+    fs::path cache_file = cache_files[0];
+    EXPECT_EQ(cache_file.extension(), ".bin");
+    auto write_time = fs::last_write_time(cache_file);
+    auto file_size = fs::file_size(cache_file);
+    StdVec<Real> signed_distances = probeSignedDistances(level_set_shape);
+
+    // a hit reads the cache file without rewriting it
+    LevelSetShape cached_level_set_shape(plate_body, *plate_shape);
+    cache_files = listCacheFiles(cache_folder);
+    ASSERT_EQ(cache_files.size(), 1u);
+    EXPECT_EQ(fs::last_write_time(cache_file), write_time);
+    EXPECT_EQ(probeSignedDistances(cached_level_set_shape), signed_distances);
+
+    // a geometry with the same name and bounds but different content is a miss
+    auto other_plate_shape = createPlate(0.3);
+    LevelSetShape other_level_set_shape(plate_body, *other_plate_shape);
+    EXPECT_EQ(listCacheFiles(cache_folder).size(), 2u);
+    EXPECT_NE(probeSignedDistances(other_level_set_shape), signed_distances);
+
+    // an incomplete cache file is rebuilt
+    fs::resize_file(cache_file, file_size / 2);
+    LevelSetShape rebuilt_level_set_shape(plate_body, *plate_shape);
+    EXPECT_EQ(listCacheFiles(cache_folder).size(), 2u);
+    EXPECT_EQ(fs::file_size(cache_file), file_size);
+    EXPECT_EQ(probeSignedDistances(rebuilt_level_set_shape), signed_distances);
+}
@@ -0,0 +1,50 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real outer_radius = 1.0;
+Real inner_radius = 0.5;
+Real resolution_ref = 0.05;
+
+/** signed distance to the annulus, negative inside */
+Real exactSignedDistance(const Vecd &position)
+{
+    Real radius = position.norm();
+    return SMAX(radius - outer_radius, inner_radius - radius);
+}
+
+TEST(test_level_set, sign_correction_is_deterministic_and_consistent)
+{
+    MultiPolygon annulus;
+    annulus.addACircle(Vecd::Zero(), outer_radius, 200, ShapeBooleanOps::add);
+    annulus.addACircle(Vecd::Zero(), inner_radius, 200, ShapeBooleanOps::sub);
+    auto annulus_shape = makeShared<MultiPolygonShape>(annulus, "Annulus");
+
+    BoundingBox system_bounds(-1.5 * outer_radius * Vecd::Ones(), 1.5 * outer_radius * Vecd::Ones());
+    SPHSystem sph_system(system_bounds, resolution_ref);
+    SolidBody annulus_body(sph_system, annulus_shape);
+
+    LevelSetShape level_set_shape(annulus_body, *annulus_shape);
+    level_set_shape.correctLevelSetSign();
+    LevelSetShape level_set_shape_again(annulus_body, *annulus_shape);
+    level_set_shape_again.correctLevelSetSign();
+
+    // the sign is checked away from the interface, where the polygon approximation does not matter
+    Real probe_spacing = 0.5 * resolution_ref;
+    int number_of_probes = int(2.4 * outer_radius / probe_spacing);
+    for (int i = 0; i != number_of_probes; ++i)
+        for (int j = 0; j != number_of_probes; ++j)
+        {
+            Vecd probe_point = -1.2 * outer_radius * Vecd::Ones() + probe_spacing * Vecd(Real(i) + 0.5, Real(j) + 0.5);
+            Real phi = level_set_shape.findSignedDistance(probe_point);
+            EXPECT_EQ(phi, level_set_shape_again.findSignedDistance(probe_point))
+                << "probe at " << probe_point.transpose();
+
+            Real exact_phi = exactSignedDistance(probe_point);
+            if (fabs(exact_phi) > 2.0 * resolution_ref)
+            {
+                EXPECT_GT(phi * exact_phi, 0.0) << "probe at " << probe_point.transpose();
+            }
+        }
+}
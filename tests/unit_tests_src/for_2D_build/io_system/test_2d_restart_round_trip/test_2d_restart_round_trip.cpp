@@ -0,0 +1,135 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real block_length = 1.0;
+Real particle_spacing = 0.05;
+
+SharedPtr<MultiPolygonShape> createBlock(const std::string &name)
+{
+    MultiPolygon block;
+    block.addABox(Transform(0.5 * block_length * Vec2d::Ones()), 0.5 * block_length * Vec2d::Ones(),
+                  ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(block, name);
+}
+
+void setVelocity(BaseParticles &particles, Real amplitude)
+{
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+        vel[i] = amplitude * Vecd(sin(Real(i)), cos(Real(i)));
+}
+
+void scrambleState(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        pos[i] = Vecd::Zero();
+        vel[i] = Vecd::Zero();
+    }
+}
+
+void expectState(BaseParticles &particles, const StdVec<Vecd> &expected_pos, const StdVec<Vecd> &expected_vel)
+{
+    Vecd *pos = particles.ParticlePositions();
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        EXPECT_EQ(pos[i], expected_pos[i]) << "particle " << i;
+        EXPECT_EQ(vel[i], expected_vel[i]) << "particle " << i;
+    }
+}
+
+std::string restartFileFullPath(SPHSystem &sph_system, size_t iteration_step)
+{
+    std::ostringstream step_string;
+    step_string << std::setw(10) << std::setfill('0') << iteration_step;
+    return sph_system.getIOEnvironment().restart_folder_ + "/RestartBody_rst_" + step_string.str() + ".bin";
+}
+
+TEST(test_restart, binary_round_trip)
+{
+    SPHSystem sph_system(createBlock("Domain")->getBounds(), particle_spacing);
+    FluidBody body(sph_system, createBlock("RestartBody"));
+    body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = body.getBaseParticles();
+    particles.registerStateVariable<Vecd>("Velocity");
+    particles.addVariableToRestart<Vecd>("Position");
+    particles.addVariableToRestart<Vecd>("Velocity");
+    size_t total_real_particles = particles.TotalRealParticles();
+    Vecd *pos = particles.ParticlePositions();
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    Real &physical_time = *sph_system.getSystemVariableDataByName<Real>("PhysicalTime");
+
+    RestartIO restart_io(sph_system);
+    restart_io.setCompression(isBinaryDataCompressionAvailable());
+    restart_io.setIncremental(true);
+
+    physical_time = 0.5;
+    setVelocity(particles, 1.0);
+    restart_io.writeToFile(100);
+    StdVec<Vecd> pos_at_100(pos, pos + total_real_particles);
+    StdVec<Vecd> vel_at_100(vel, vel + total_real_particles);
+
+    // only the velocity is changed, so that the positions refer to the earlier file
+    physical_time = 1.0;
+    setVelocity(particles, 2.0);
+    restart_io.writeToFile(200);
+    StdVec<Vecd> vel_at_200(vel, vel + total_real_particles);
+
+    BinaryDataReader binary_reader(restartFileFullPath(sph_system, 200));
+    ASSERT_TRUE(binary_reader.hasVariable("Position"));
+    EXPECT_FALSE(binary_reader.getIndex()["Position"].source_file_.empty());
+    EXPECT_TRUE(binary_reader.getIndex()["Velocity"].source_file_.empty());
+
+    scrambleState(particles);
+    EXPECT_NEAR(restart_io.readRestartFiles(200), 1.0, 1.0e-9);
+    expectState(particles, pos_at_100, vel_at_200);
+
+    scrambleState(particles);
+    EXPECT_NEAR(restart_io.readRestartFiles(100), 0.5, 1.0e-9);
+    expectState(particles, pos_at_100, vel_at_100);
+
+    // a restarted run refers to the files written before the restart
+    RestartIO restarted_io(sph_system);
+    restarted_io.setIncremental(true);
+    restarted_io.readRestartFiles(200);
+    restarted_io.writeToFile(300);
+    BinaryDataReader restarted_reader(restartFileFullPath(sph_system, 300));
+    EXPECT_EQ(restarted_reader.getIndex()["Position"].source_file_,
+              binary_reader.getIndex()["Position"].source_file_);
+    EXPECT_EQ(restarted_reader.getIndex()["Velocity"].source_file_,
+              fs::path(restartFileFullPath(sph_system, 200)).filename().string());
+}
+
+TEST(test_restart, truncated_binary_file_is_rejected)
+{
+    std::string filefullpath = "./truncated_binary_data.bin";
+    StdVec<Real> data(1000);
+    for (size_t i = 0; i != data.size(); ++i)
+        data[i] = Real(i);
+    {
+        BinaryDataWriter binary_writer(filefullpath);
+        binary_writer.writeVariable("Data", data.data(), data.size());
+        binary_writer.finalize();
+    }
+
+    {
+        BinaryDataReader binary_reader(filefullpath, false);
+        ASSERT_TRUE(binary_reader.isValid());
+        ASSERT_TRUE(binary_reader.hasVariable<Real>("Data", data.size()));
+        StdVec<Real> read_data(data.size());
+        EXPECT_EQ(binary_reader.readVariable("Data", read_data.data(), read_data.size()), data.size());
+        EXPECT_EQ(read_data, data);
+    }
+
+    // the index is written at the end, so that a truncated file has no valid index
+    fs::resize_file(filefullpath, fs::file_size(filefullpath) / 2);
+    BinaryDataReader binary_reader(filefullpath, false);
+    EXPECT_FALSE(binary_reader.isValid());
+    EXPECT_FALSE(binary_reader.hasVariable("Data"));
+}
@@ -0,0 +1,58 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+TEST(test_meshes, doubly_periodic_cell_linked_list)
+{
+    Real length = 1.0;
+    Real dp = 0.05;
+
+    MultiPolygon shape;
+    shape.addABox(Transform(0.5 * length * Vec2d::Ones()), 0.5 * length * Vec2d::Ones(), ShapeBooleanOps::add);
+    auto polygon_shape = makeShared<MultiPolygonShape>(shape, "PolygonShape");
+
+    BoundingBox bb_system = polygon_shape->getBounds();
+    SPHSystem system(bb_system, dp);
+
+    FluidBody body(system, polygon_shape);
+    body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    body.generateParticles<BaseParticles, Lattice>();
+    auto &particles = body.getBaseParticles();
+    Vecd *pos = particles.ParticlePositions();
+
+    InnerRelation inner(body);
+    PeriodicAlongAxis periodic_along_x(body.getSPHBodyBounds(), xAxis);
+    PeriodicAlongAxis periodic_along_y(body.getSPHBodyBounds(), yAxis);
+    PeriodicConditionUsingCellLinkedList periodic_condition_x(body, periodic_along_x);
+    PeriodicConditionUsingCellLinkedList periodic_condition_y(body, periodic_along_y);
+
+    body.updateCellLinkedList();
+    periodic_condition_x.update_cell_linked_list_.exec();
+    periodic_condition_y.update_cell_linked_list_.exec();
+    inner.updateConfiguration();
+
+    // on a uniform lattice with both directions periodic, every particle,
+    // including those at the corners, sees the same neighborhood
+    size_t total_real_particles = particles.TotalRealParticles();
+    const Neighborhood &center_neighborhood = inner.inner_configuration_[0];
+    Real center_sum_w = 0.0;
+    for (size_t n = 0; n != center_neighborhood.current_size_; ++n)
+        center_sum_w += center_neighborhood.W_ij_[n];
+
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        const Neighborhood &neighborhood = inner.inner_configuration_[i];
+        ASSERT_EQ(neighborhood.current_size_, center_neighborhood.current_size_) << "particle at " << pos[i].transpose();
+
+        Real sum_w = 0.0;
+        Vecd sum_e = Vecd::Zero();
+        for (size_t n = 0; n != neighborhood.current_size_; ++n)
+        {
+            sum_w += neighborhood.W_ij_[n];
+            sum_e += neighborhood.dW_ij_[n] * neighborhood.e_ij_[n];
+        }
+        EXPECT_NEAR(sum_w, center_sum_w, 1.0e-4 * center_sum_w);
+        EXPECT_NEAR(sum_e.norm(), 0.0, 1.0e-4 * center_sum_w / dp);
+    }
+}
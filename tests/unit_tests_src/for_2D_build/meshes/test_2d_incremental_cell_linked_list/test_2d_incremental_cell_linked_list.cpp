@@ -0,0 +1,70 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real domain_length = 1.0;
+Real dp = 0.05;
+
+SharedPtr<MultiPolygonShape> createSquare(const std::string &name)
+{
+    MultiPolygon shape;
+    shape.addABox(Transform(0.5 * domain_length * Vec2d::Ones()), 0.5 * domain_length * Vec2d::Ones(), ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(shape, name);
+}
+
+void movePositions(BaseParticles &particles, Real amplitude, size_t step)
+{
+    Vecd *pos = particles.ParticlePositions();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+        pos[i] += amplitude * dp * Vecd(sin(Real(i + 7 * step)), cos(Real(3 * i + step)));
+}
+
+/** the neighbor lists may be ordered differently, so that sorted neighbor indexes are compared */
+StdVec<size_t> sortedNeighbors(const Neighborhood &neighborhood)
+{
+    StdVec<size_t> neighbors(neighborhood.j_.begin(), neighborhood.j_.begin() + neighborhood.current_size_);
+    std::sort(neighbors.begin(), neighbors.end());
+    return neighbors;
+}
+
+TEST(test_meshes, incremental_cell_linked_list_matches_full_rebuild)
+{
+    SPHSystem system(createSquare("Domain")->getBounds(), dp);
+
+    FluidBody full_body(system, createSquare("FullBody"));
+    full_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    full_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &full_particles = full_body.getBaseParticles();
+
+    FluidBody incremental_body(system, createSquare("IncrementalBody"));
+    incremental_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    incremental_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &incremental_particles = incremental_body.getBaseParticles();
+    DynamicCast<CellLinkedList>(&incremental_body, incremental_body.getCellLinkedList()).setIncrementalUpdate(0.5);
+
+    ASSERT_EQ(full_particles.TotalRealParticles(), incremental_particles.TotalRealParticles());
+    InnerRelation full_inner(full_body);
+    InnerRelation incremental_inner(incremental_body);
+
+    // small moves update the lists incrementally, the large move at the last step rebuilds them
+    const size_t number_of_steps = 6;
+    for (size_t step = 0; step != number_of_steps; ++step)
+    {
+        Real amplitude = step + 1 == number_of_steps ? 2.0 : 0.2;
+        movePositions(full_particles, amplitude, step);
+        movePositions(incremental_particles, amplitude, step);
+
+        full_body.updateCellLinkedList();
+        full_inner.updateConfiguration();
+        incremental_body.updateCellLinkedList();
+        incremental_inner.updateConfiguration();
+
+        for (size_t i = 0; i != full_particles.TotalRealParticles(); ++i)
+        {
+            ASSERT_EQ(sortedNeighbors(incremental_inner.inner_configuration_[i]),
+                      sortedNeighbors(full_inner.inner_configuration_[i]))
+                << "particle " << i << " at step " << step;
+        }
+    }
+}
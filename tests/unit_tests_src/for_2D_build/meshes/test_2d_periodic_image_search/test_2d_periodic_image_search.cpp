@@ -0,0 +1,88 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real domain_length = 1.0;
+Real dp = 0.05;
+
+SharedPtr<MultiPolygonShape> createSquare(const std::string &name)
+{
+    MultiPolygon shape;
+    shape.addABox(Transform(0.5 * domain_length * Vec2d::Ones()), 0.5 * domain_length * Vec2d::Ones(), ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(shape, name);
+}
+
+/** perturbs the lattice so that the neighborhoods across the periodic bounds differ from particle to particle */
+void perturbPositions(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+        pos[i] += 0.3 * dp * Vecd(sin(Real(i)), cos(Real(3 * i)));
+}
+
+TEST(test_meshes, periodic_image_search_matches_ghost_entries)
+{
+    SPHSystem system(createSquare("Domain")->getBounds(), dp);
+
+    FluidBody ghost_body(system, createSquare("GhostBody"));
+    ghost_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    ghost_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &ghost_particles = ghost_body.getBaseParticles();
+
+    FluidBody image_body(system, createSquare("ImageBody"));
+    image_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    image_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &image_particles = image_body.getBaseParticles();
+
+    ASSERT_EQ(ghost_particles.TotalRealParticles(), image_particles.TotalRealParticles());
+    perturbPositions(ghost_particles);
+    perturbPositions(image_particles);
+
+    InnerRelation ghost_inner(ghost_body);
+    InnerRelation image_inner(image_body);
+    PeriodicAlongAxis periodic_along_x(ghost_body.getSPHBodyBounds(), xAxis);
+    PeriodicAlongAxis periodic_along_y(ghost_body.getSPHBodyBounds(), yAxis);
+    PeriodicConditionUsingCellLinkedList ghost_periodic_x(ghost_body, periodic_along_x);
+    PeriodicConditionUsingCellLinkedList ghost_periodic_y(ghost_body, periodic_along_y);
+    PeriodicConditionUsingImageSearch image_periodic_x(image_body, periodic_along_x);
+    PeriodicConditionUsingImageSearch image_periodic_y(image_body, periodic_along_y);
+
+    ghost_periodic_x.bounding_.exec();
+    ghost_periodic_y.bounding_.exec();
+    ghost_body.updateCellLinkedList();
+    ghost_periodic_x.update_cell_linked_list_.exec();
+    ghost_periodic_y.update_cell_linked_list_.exec();
+    ghost_inner.updateConfiguration();
+
+    image_periodic_x.bounding_.exec();
+    image_periodic_y.bounding_.exec();
+    image_body.updateCellLinkedList();
+    image_inner.updateConfiguration();
+
+    // the neighbor lists may be ordered differently, so that the sums over the neighbors are compared
+    Vecd *pos = image_particles.ParticlePositions();
+    for (size_t i = 0; i != image_particles.TotalRealParticles(); ++i)
+    {
+        const Neighborhood &ghost_neighborhood = ghost_inner.inner_configuration_[i];
+        const Neighborhood &image_neighborhood = image_inner.inner_configuration_[i];
+        ASSERT_EQ(image_neighborhood.current_size_, ghost_neighborhood.current_size_)
+            << "particle at " << pos[i].transpose();
+
+        size_t ghost_sum_j = 0, image_sum_j = 0;
+        Real ghost_sum_w = 0.0, image_sum_w = 0.0;
+        Vecd ghost_sum_e = Vecd::Zero(), image_sum_e = Vecd::Zero();
+        for (size_t n = 0; n != ghost_neighborhood.current_size_; ++n)
+        {
+            ghost_sum_j += ghost_neighborhood.j_[n];
+            ghost_sum_w += ghost_neighborhood.W_ij_[n];
+            ghost_sum_e += ghost_neighborhood.dW_ij_[n] * ghost_neighborhood.e_ij_[n];
+            image_sum_j += image_neighborhood.j_[n];
+            image_sum_w += image_neighborhood.W_ij_[n];
+            image_sum_e += image_neighborhood.dW_ij_[n] * image_neighborhood.e_ij_[n];
+        }
+        EXPECT_EQ(image_sum_j, ghost_sum_j);
+        EXPECT_NEAR(image_sum_w, ghost_sum_w, 1.0e-6 * ghost_sum_w);
+        EXPECT_NEAR((image_sum_e - ghost_sum_e).norm(), 0.0, 1.0e-6 * ghost_sum_w / dp);
+    }
+}
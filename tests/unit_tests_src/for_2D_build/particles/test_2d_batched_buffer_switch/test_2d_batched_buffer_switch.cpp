@@ -0,0 +1,96 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real domain_length = 1.0;
+Real dp = 0.05;
+
+SharedPtr<MultiPolygonShape> createSquare(const std::string &name)
+{
+    MultiPolygon shape;
+    shape.addABox(Transform(0.5 * domain_length * Vec2d::Ones()), 0.5 * domain_length * Vec2d::Ones(), ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(shape, name);
+}
+
+/** the states of the real particles, the order of which may differ between the two switches */
+StdVec<std::pair<UnsignedInt, Vecd>> sortedRealParticles(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    UnsignedInt *original_id = particles.ParticleOriginalIds();
+    StdVec<std::pair<UnsignedInt, Vecd>> real_particles;
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+        real_particles.push_back(std::make_pair(original_id[i], pos[i]));
+    std::sort(real_particles.begin(), real_particles.end(),
+              [](const std::pair<UnsignedInt, Vecd> &a, const std::pair<UnsignedInt, Vecd> &b)
+              { return a.first < b.first; });
+    return real_particles;
+}
+
+void expectConsistentSortedIds(BaseParticles &particles)
+{
+    UnsignedInt *original_id = particles.ParticleOriginalIds();
+    UnsignedInt *sorted_id = particles.ParticleSortedIds();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+        EXPECT_EQ(sorted_id[original_id[i]], i) << "particle " << i;
+}
+
+TEST(test_particles, batched_buffer_switch_matches_per_particle_switch)
+{
+    SPHSystem system(createSquare("Domain")->getBounds(), dp);
+
+    FluidBody batched_body(system, createSquare("BatchedBody"));
+    batched_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    ParticleBuffer<ReserveSizeFactor> batched_buffer(0.5);
+    batched_body.generateParticlesWithReserve<BaseParticles, Lattice>(batched_buffer);
+    BaseParticles &batched_particles = batched_body.getBaseParticles();
+
+    FluidBody single_body(system, createSquare("SingleBody"));
+    single_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    ParticleBuffer<ReserveSizeFactor> single_buffer(0.5);
+    single_body.generateParticlesWithReserve<BaseParticles, Lattice>(single_buffer);
+    BaseParticles &single_particles = single_body.getBaseParticles();
+
+    size_t total_real_particles = batched_particles.TotalRealParticles();
+    ASSERT_EQ(single_particles.TotalRealParticles(), total_real_particles);
+
+    // removed particles both in the middle and at the end of the real particles
+    IndexVector removed_indices;
+    for (size_t i = 0; i < total_real_particles; i += 7)
+        removed_indices.push_back(i);
+    for (size_t i = total_real_particles - 5; i != total_real_particles; ++i)
+        if (i % 7 != 0)
+            removed_indices.push_back(i);
+    std::sort(removed_indices.begin(), removed_indices.end());
+
+    batched_particles.switchToBufferParticles(removed_indices);
+    for (auto it = removed_indices.rbegin(); it != removed_indices.rend(); ++it)
+        single_particles.switchToBufferParticle(*it);
+
+    ASSERT_EQ(batched_particles.TotalRealParticles(), total_real_particles - removed_indices.size());
+    ASSERT_EQ(single_particles.TotalRealParticles(), batched_particles.TotalRealParticles());
+    EXPECT_EQ(sortedRealParticles(batched_particles), sortedRealParticles(single_particles));
+    expectConsistentSortedIds(batched_particles);
+
+    // the created particles are appended in the order of the given indices
+    IndexVector copied_indices = {3, 0, 11, 3};
+    size_t remaining_particles = batched_particles.TotalRealParticles();
+    UnsignedInt first_new_index = batched_particles.createRealParticlesFrom(copied_indices);
+    EXPECT_EQ(first_new_index, remaining_particles);
+    for (size_t index : copied_indices)
+        single_particles.createRealParticleFrom(index);
+
+    ASSERT_EQ(batched_particles.TotalRealParticles(), remaining_particles + copied_indices.size());
+    Vecd *batched_pos = batched_particles.ParticlePositions();
+    Vecd *single_pos = single_particles.ParticlePositions();
+    UnsignedInt *batched_original_id = batched_particles.ParticleOriginalIds();
+    UnsignedInt *single_original_id = single_particles.ParticleOriginalIds();
+    for (size_t k = 0; k != copied_indices.size(); ++k)
+    {
+        size_t new_index = first_new_index + k;
+        EXPECT_EQ(batched_pos[new_index], batched_pos[copied_indices[k]]);
+        EXPECT_EQ(batched_original_id[new_index], new_index);
+        EXPECT_EQ(single_pos[new_index], single_pos[copied_indices[k]]);
+        EXPECT_EQ(single_original_id[new_index], batched_original_id[new_index]);
+    }
+}
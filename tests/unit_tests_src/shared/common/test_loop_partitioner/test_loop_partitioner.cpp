@@ -0,0 +1,49 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+using namespace SPH::execution;
+
+TEST(test_loop_partitioner, autotuning_serial_candidate_and_retuning)
+{
+    LoopPartitioner loop_partitioner;
+    loop_partitioner.enableAutoTuning(1, 100);
+
+    StdVec<Real> data(10000, 1.0);
+    auto range_body = [&](const IndexRange &r)
+    {
+        for (size_t i = r.begin(); i != r.end(); ++i)
+            data[i] = 1.0 + 1.0e-3 * data[i];
+    };
+
+    // a large loop is tuned among the parallel candidates only
+    loop_partitioner.parallelFor(IndexRange(0, data.size()), range_body);
+    EXPECT_TRUE(loop_partitioner.isAutoTuning());
+    for (size_t k = 0; k != 100 && loop_partitioner.isAutoTuning(); ++k)
+        loop_partitioner.parallelFor(IndexRange(0, data.size()), range_body);
+    EXPECT_FALSE(loop_partitioner.isAutoTuning());
+    EXPECT_NE(loop_partitioner.getPartitionerType(), PartitionerType::Serial);
+
+    // a small change of the loop size keeps the tuned partitioner
+    loop_partitioner.parallelFor(IndexRange(0, 8000), range_body);
+    EXPECT_FALSE(loop_partitioner.isAutoTuning());
+
+    // a substantial change of the loop size starts a new tuning
+    loop_partitioner.parallelFor(IndexRange(0, 50), range_body);
+    EXPECT_TRUE(loop_partitioner.isAutoTuning());
+    for (size_t k = 0; k != 100 && loop_partitioner.isAutoTuning(); ++k)
+        loop_partitioner.parallelFor(IndexRange(0, 50), range_body);
+    EXPECT_FALSE(loop_partitioner.isAutoTuning());
+
+    // an explicitly given partitioner is never retuned
+    loop_partitioner.setPartitioner(PartitionerType::Static, 32);
+    loop_partitioner.parallelFor(IndexRange(0, data.size()), range_body);
+    EXPECT_FALSE(loop_partitioner.isAutoTuning());
+    EXPECT_EQ(loop_partitioner.getPartitionerType(), PartitionerType::Static);
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+#include "my_memory_pool.h"
+#include "tbb/parallel_for.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+
+struct alignas(16) TestPackage
+{
+    double data_[6];
+    size_t id_;
+    TestPackage() : id_(0) {};
+};
+
+TEST(test_memory_pool, concurrent_allocation_is_contiguous_and_unique)
+{
+    const size_t chunk_size = 64;
+    const size_t number_of_nodes = 10 * chunk_size + 7;
+    MyMemoryPool<TestPackage> memory_pool(chunk_size);
+
+    std::vector<TestPackage *> nodes(number_of_nodes, nullptr);
+    tbb::parallel_for(size_t(0), number_of_nodes,
+                      [&](size_t i)
+                      {
+                          nodes[i] = memory_pool.malloc();
+                          nodes[i]->id_ = i;
+                      });
+    EXPECT_EQ(size_t(memory_pool.capacity()), number_of_nodes);
+
+    // unique nodes, packed chunk by chunk in aligned chunks
+    std::vector<TestPackage *> sorted_nodes(nodes);
+    std::sort(sorted_nodes.begin(), sorted_nodes.end());
+    EXPECT_TRUE(std::adjacent_find(sorted_nodes.begin(), sorted_nodes.end()) == sorted_nodes.end());
+    size_t number_of_chunks = 0;
+    for (size_t i = 0; i != number_of_nodes; ++i)
+    {
+        EXPECT_EQ(nodes[i]->id_, i);
+        if (i == 0 || sorted_nodes[i] != sorted_nodes[i - 1] + 1)
+        {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(sorted_nodes[i]) % 64, 0u);
+            ++number_of_chunks;
+        }
+    }
+    EXPECT_LE(number_of_chunks, number_of_nodes / chunk_size + 1);
+}
+
+TEST(test_memory_pool, freed_nodes_are_reused_and_released_together)
+{
+    MyMemoryPool<TestPackage> memory_pool(16);
+    std::vector<TestPackage *> nodes;
+    for (size_t i = 0; i != 40; ++i)
+        nodes.push_back(memory_pool.malloc());
+
+    for (size_t i = 0; i != 10; ++i)
+        memory_pool.free(nodes[i]);
+    EXPECT_EQ(memory_pool.available_node(), 10);
+
+    TestPackage *reused_node = memory_pool.malloc();
+    EXPECT_TRUE(std::find(nodes.begin(), nodes.begin() + 10, reused_node) != nodes.begin() + 10);
+    EXPECT_EQ(memory_pool.available_node(), 9);
+    EXPECT_EQ(memory_pool.capacity(), 40);
+
+    memory_pool.releaseAll();
+    EXPECT_EQ(memory_pool.capacity(), 0);
+    EXPECT_EQ(memory_pool.available_node(), 0);
+
+    // the pool is usable again after the release
+    TestPackage *new_node = memory_pool.malloc();
+    EXPECT_EQ(new_node->id_, 0u);
+    EXPECT_EQ(memory_pool.capacity(), 1);
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,93 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real domain_length = 1.0;
+Real dp = 0.05;
+Real rho0 = 1.0;
+Real youngs_modulus = 1.0;
+Real poisson_ratio = 0.3;
+Real yield_stress = 0.05;
+Real hardening_modulus = 0.1;
+
+SharedPtr<MultiPolygonShape> createSquare(const std::string &name)
+{
+    MultiPolygon shape;
+    shape.addABox(Transform(0.5 * domain_length * Vec2d::Ones()), 0.5 * domain_length * Vec2d::Ones(), ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(shape, name);
+}
+
+/** simple shear, small for every third particle so that elastic and plastic lanes are mixed in a batch */
+Matd deformationGradient(size_t index_i, size_t step)
+{
+    Real shear = index_i % 3 == 0 ? 1.0e-3 : 0.2 + 0.01 * Real(index_i % 5);
+    Matd F = Matd::Identity();
+    F(0, 1) = Real(step + 1) * shear;
+    return F;
+}
+
+TEST(test_materials, hardening_plastic_batch_matches_per_particle)
+{
+    SPHSystem system(createSquare("Domain")->getBounds(), dp);
+
+    SolidBody batched_body(system, createSquare("BatchedBody"));
+    HardeningPlasticSolid *batched_material = batched_body.defineMaterial<HardeningPlasticSolid>(
+        rho0, youngs_modulus, poisson_ratio, yield_stress, hardening_modulus);
+    batched_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &batched_particles = batched_body.getBaseParticles();
+
+    SolidBody single_body(system, createSquare("SingleBody"));
+    HardeningPlasticSolid *single_material = single_body.defineMaterial<HardeningPlasticSolid>(
+        rho0, youngs_modulus, poisson_ratio, yield_stress, hardening_modulus);
+    single_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &single_particles = single_body.getBaseParticles();
+
+    size_t total_real_particles = batched_particles.TotalRealParticles();
+    ASSERT_EQ(single_particles.TotalRealParticles(), total_real_particles);
+
+    Real tolerance = 1.0e-12;
+    StdVec<Matd> deformation(total_real_particles);
+    StdVec<Matd> batched_be(total_real_particles);
+    for (size_t step = 0; step != 3; ++step)
+    {
+        for (size_t i = 0; i != total_real_particles; ++i)
+            deformation[i] = deformationGradient(i, step);
+
+        // a short first batch so that partial batches are also checked
+        size_t lanes = 3;
+        for (size_t i = 0; i < total_real_particles; i += lanes)
+        {
+            lanes = SMIN(i == 0 ? lanes : PlasticBatchSize, total_real_particles - i);
+            batched_material->ElasticLeftCauchyBatch(&deformation[i], i, lanes, &batched_be[i]);
+        }
+
+        for (size_t i = 0; i != total_real_particles; ++i)
+        {
+            Matd single_be = single_material->ElasticLeftCauchy(deformation[i], i);
+            EXPECT_TRUE((batched_be[i] - single_be).norm() < tolerance) << "step " << step << " particle " << i;
+        }
+    }
+
+    Real *batched_hardening = batched_particles.getVariableDataByName<Real>("HardeningParameter");
+    Real *single_hardening = single_particles.getVariableDataByName<Real>("HardeningParameter");
+    Matd *batched_plastic_strain = batched_particles.getVariableDataByName<Matd>("InversePlasticRightCauchyStrain");
+    Matd *single_plastic_strain = single_particles.getVariableDataByName<Matd>("InversePlasticRightCauchyStrain");
+    size_t elastic_particles = 0;
+    size_t plastic_particles = 0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_NEAR(batched_hardening[i], single_hardening[i], tolerance) << "particle " << i;
+        EXPECT_TRUE((batched_plastic_strain[i] - single_plastic_strain[i]).norm() < tolerance) << "particle " << i;
+        batched_hardening[i] > 0.0 ? ++plastic_particles : ++elastic_particles;
+    }
+    // both the elastic and the plastic paths have been taken
+    EXPECT_GT(elastic_particles, 0u);
+    EXPECT_GT(plastic_particles, 0u);
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace SPH;
+
+Real block_length = 1.0;
+Real particle_spacing = 0.025;
+
+SharedPtr<MultiPolygonShape> createBlock(const std::string &name)
+{
+    MultiPolygon block;
+    block.addABox(Transform(0.5 * block_length * Vec2d::Ones()), 0.5 * block_length * Vec2d::Ones(),
+                  ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(block, name);
+}
+
+TEST(test_sorting_scheduler, sorts_once_the_locality_loss_exceeds_the_cost)
+{
+    SortingScheduler sorting_scheduler(1.0);
+
+    // the first check gives the reference
+    EXPECT_FALSE(sorting_scheduler.decideSorting(0.1));
+    EXPECT_EQ(sorting_scheduler.getStatistics().reference_disorder_, 0.1);
+
+    // no loss without disorder growth
+    for (size_t k = 0; k != 10; ++k)
+        EXPECT_FALSE(sorting_scheduler.decideSorting(0.1));
+    EXPECT_EQ(sorting_scheduler.getStatistics().locality_loss_, 0.0);
+
+    // the excess is accumulated until it exceeds the sort cost
+    EXPECT_FALSE(sorting_scheduler.decideSorting(0.5));
+    EXPECT_FALSE(sorting_scheduler.decideSorting(0.6));
+    EXPECT_TRUE(sorting_scheduler.decideSorting(0.7));
+    EXPECT_EQ(sorting_scheduler.getStatistics().sorts_, 1u);
+
+    // a new reference is taken at the first check after the sort
+    EXPECT_FALSE(sorting_scheduler.decideSorting(0.2));
+    EXPECT_EQ(sorting_scheduler.getStatistics().reference_disorder_, 0.2);
+    EXPECT_EQ(sorting_scheduler.getStatistics().locality_loss_, 0.0);
+    EXPECT_EQ(sorting_scheduler.getStatistics().checks_, 15u);
+}
+
+TEST(test_sorting_scheduler, shuffled_particles_are_sorted_and_ordered_ones_are_not)
+{
+    SPHSystem sph_system(createBlock("Domain")->getBounds(), particle_spacing);
+    FluidBody body(sph_system, createBlock("Block"));
+    body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = body.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    // more particles than sampled, so that a check does not visit all of them
+    ASSERT_GT(total_real_particles, size_t(SortingScheduler::sample_size_));
+
+    InnerRelation inner_relation(body);
+    ParticleSorting<execution::ParallelPolicy> particle_sorting(body);
+    particle_sorting.setAutoSorting(inner_relation, 0.5);
+    auto updateRelation = [&]()
+    {
+        body.updateCellLinkedList();
+        inner_relation.updateConfiguration();
+    };
+
+    // lattice particles are ordered row by row, most neighbors are within the cache window
+    updateRelation();
+    particle_sorting.exec();
+    updateRelation();
+    particle_sorting.exec();
+    const SortingScheduler::Statistics &statistics = particle_sorting.getSortingStatistics();
+    EXPECT_LT(statistics.disorder_, 0.5);
+    EXPECT_FALSE(statistics.is_sorting_);
+    EXPECT_EQ(statistics.sorts_, 0u);
+
+    // shuffling the positions destroys the locality and triggers a sort
+    Vecd *pos = particles.ParticlePositions();
+    std::mt19937 random_engine(1);
+    std::shuffle(pos, pos + total_real_particles, random_engine);
+    updateRelation();
+    particle_sorting.exec();
+    EXPECT_GT(statistics.disorder_, 0.8);
+    EXPECT_TRUE(statistics.is_sorting_);
+    EXPECT_EQ(statistics.sorts_, 1u);
+
+    // after the sort, the new reference shows the locality restored
+    updateRelation();
+    particle_sorting.exec();
+    EXPECT_LT(statistics.disorder_, 0.5);
+    EXPECT_FALSE(statistics.is_sorting_);
+    EXPECT_EQ(statistics.sorts_, 1u);
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,85 @@
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real block_length = 1.0;
+Real particle_spacing = 0.01;
+
+SharedPtr<MultiPolygonShape> createBlock(const std::string &name)
+{
+    MultiPolygon block;
+    block.addABox(Transform(0.5 * block_length * Vec2d::Ones()), 0.5 * block_length * Vec2d::Ones(),
+                  ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(block, name);
+}
+
+/** the lattice is scrambled so that the sort has to move nearly all particles */
+void scrambleParticles(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    size_t total_real_particles = particles.TotalRealParticles();
+    for (size_t i = 0; i != total_real_particles; ++i)
+        std::swap(pos[i], pos[(i * 7919) % total_real_particles]);
+}
+
+template <class ExecutionPolicy, class SortMethodType, class CurveType>
+void testSpaceFillingCurveSort(const std::string &body_name)
+{
+    SPHSystem sph_system(createBlock("Domain")->getBounds(), particle_spacing);
+    FluidBody body(sph_system, createBlock(body_name));
+    body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = body.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    scrambleParticles(particles);
+
+    Vecd *pos = particles.ParticlePositions();
+    StdVec<Vecd> scrambled_pos(pos, pos + total_real_particles);
+    ParticleSortCK<ExecutionPolicy, SortMethodType> particle_sort(body);
+    particle_sort.exec();
+
+    // the same normalization as the sort, the bounds do not change with the order of particles
+    Vecd lower_bound = pos[0];
+    Vecd upper_bound = pos[0];
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        lower_bound = lower_bound.cwiseMin(pos[i]);
+        upper_bound = upper_bound.cwiseMax(pos[i]);
+    }
+    Vecd inv_extent = (upper_bound - lower_bound + TinyReal * Vecd::Ones()).cwiseInverse();
+
+    CurveType curve;
+    UnsignedInt *original_id = particles.getVariableDataByName<UnsignedInt>("OriginalID");
+    UnsignedInt *sorted_id = particles.getVariableDataByName<UnsignedInt>("SortedID");
+    StdVec<bool> is_found(total_real_particles, false);
+    uint64_t previous_key = 0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        uint64_t key = curve(Vecd((pos[i] - lower_bound).cwiseProduct(inv_extent)));
+        EXPECT_LE(previous_key, key) << "particle " << i;
+        previous_key = key;
+
+        // the sort is a permutation carrying the positions with the original ids
+        ASSERT_LT(original_id[i], total_real_particles);
+        EXPECT_FALSE(is_found[original_id[i]]);
+        is_found[original_id[i]] = true;
+        EXPECT_EQ(pos[i], scrambled_pos[original_id[i]]);
+        EXPECT_EQ(sorted_id[original_id[i]], i);
+    }
+}
+
+TEST(test_particle_sort, morton_radix_sort)
+{
+    testSpaceFillingCurveSort<execution::ParallelPolicy, MortonRadixSort, MortonCurve>("MortonBody");
+}
+
+TEST(test_particle_sort, hilbert_radix_sort)
+{
+    testSpaceFillingCurveSort<execution::ParallelPolicy, HilbertRadixSort, HilbertCurve>("HilbertBody");
+}
+
+TEST(test_particle_sort, sequenced_radix_sort)
+{
+    testSpaceFillingCurveSort<execution::SequencedPolicy, HilbertRadixSort, HilbertCurve>("SequencedBody");
+}
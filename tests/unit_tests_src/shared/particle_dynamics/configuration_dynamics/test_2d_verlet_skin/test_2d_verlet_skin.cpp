@@ -0,0 +1,75 @@
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real block_length = 1.0;
+Real particle_spacing = 0.05;
+
+SharedPtr<MultiPolygonShape> createBlock(const std::string &name)
+{
+    MultiPolygon block;
+    block.addABox(Transform(0.5 * block_length * Vec2d::Ones()), 0.5 * block_length * Vec2d::Ones(),
+                  ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(block, name);
+}
+
+/** the same deterministic motion for both bodies, the step is the largest displacement of a particle */
+void moveParticles(BaseParticles &particles, Real step)
+{
+    Vecd *pos = particles.ParticlePositions();
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+        pos[i] += step * Vecd(sin(Real(i)), cos(Real(3 * i))) / sqrt(2.0);
+}
+
+TEST(test_verlet_skin, reused_lists_match_rebuilt_lists)
+{
+    SPHSystem sph_system(createBlock("Domain")->getBounds(), particle_spacing);
+
+    FluidBody skin_free_body(sph_system, createBlock("SkinFreeBody"));
+    skin_free_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    skin_free_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &skin_free_particles = skin_free_body.getBaseParticles();
+
+    FluidBody skin_body(sph_system, createBlock("SkinBody"));
+    skin_body.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    skin_body.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &skin_particles = skin_body.getBaseParticles();
+    ASSERT_EQ(skin_free_particles.TotalRealParticles(), skin_particles.TotalRealParticles());
+
+    UpdateCellLinkedList<execution::ParallelPolicy, CellLinkedList> skin_free_cell_linked_list(skin_free_body);
+    UpdateCellLinkedList<execution::ParallelPolicy, CellLinkedList> skin_cell_linked_list(skin_body);
+    Relation<Inner<>> skin_free_inner(skin_free_body);
+    Relation<Inner<>> skin_inner(skin_body);
+    UpdateRelation<execution::ParallelPolicy, Inner<>> skin_free_update_relation(skin_free_inner);
+    UpdateRelation<execution::ParallelPolicy, Inner<>> skin_update_relation(skin_inner);
+    Real verlet_skin = 0.4 * particle_spacing;
+    skin_update_relation.setVerletSkin(verlet_skin);
+    InteractionDynamicsCK<execution::ParallelPolicy, LinearCorrectionMatrixInner> skin_free_correction(skin_free_inner);
+    InteractionDynamicsCK<execution::ParallelPolicy, LinearCorrectionMatrixInner> skin_correction(skin_inner);
+
+    Matd *skin_free_B = skin_free_particles.getVariableDataByName<Matd>("LinearCorrectionMatrix");
+    Matd *skin_B = skin_particles.getVariableDataByName<Matd>("LinearCorrectionMatrix");
+
+    // the first motion is within half of the skin so that the lists are reused,
+    // the second one exceeds it so that the lists are built again
+    StdVec<Real> steps = {0.0, 0.15 * particle_spacing, 0.15 * particle_spacing};
+    for (Real step : steps)
+    {
+        moveParticles(skin_free_particles, step);
+        moveParticles(skin_particles, step);
+        skin_free_cell_linked_list.exec();
+        skin_cell_linked_list.exec();
+        skin_free_update_relation.exec();
+        skin_update_relation.exec();
+        skin_free_correction.exec();
+        skin_correction.exec();
+
+        // the neighbors within the skin only add zero kernel values and gradients
+        for (size_t i = 0; i != skin_particles.TotalRealParticles(); ++i)
+        {
+            EXPECT_NEAR((skin_B[i] - skin_free_B[i]).norm(), 0.0, 1.0e-8 * skin_free_B[i].norm())
+                << "particle " << i << " after the step " << step;
+        }
+    }
+}
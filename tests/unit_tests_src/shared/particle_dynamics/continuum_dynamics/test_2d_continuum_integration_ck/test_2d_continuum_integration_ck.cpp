@@ -0,0 +1,174 @@
+/**
+ * @file 	test_2d_continuum_integration_ck.cpp
+ * @brief 	test the computing-kernel continuum dynamics against the classic ones on a small soil block:
+ *          one step of the stress diffusion and the plastic integration,
+ *          followed by one step of the shear stress relaxation with hourglass control.
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real block_length = 1.0;
+Real particle_spacing = 0.05;
+Real rho0_s = 2040.0;
+Real gravity_g = 9.8;
+Real Youngs_modulus = 5.84e6;
+Real poisson = 0.3;
+Real friction_angle = 21.9 * Pi / 180;
+Real c_s = sqrt(Youngs_modulus / (rho0_s * 3.0 * (1.0 - 2.0 * poisson)));
+Real U_ref = 0.1;
+
+SharedPtr<MultiPolygonShape> createBlock(const std::string &name)
+{
+    MultiPolygon block;
+    block.addABox(Transform(0.5 * block_length * Vec2d::Ones()), 0.5 * block_length * Vec2d::Ones(),
+                  ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(block, name);
+}
+
+/** the same smooth velocity, geostatic stress with a shear perturbation and gravity for both bodies */
+void setInitialCondition(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    Real *mass = particles.getVariableDataByName<Real>("Mass");
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    Vecd *force_prior = particles.getVariableDataByName<Vecd>("ForcePrior");
+    Mat3d *stress_tensor_3D = particles.getVariableDataByName<Mat3d>("StressTensor3D");
+    Matd *shear_stress = particles.getVariableDataByName<Matd>("ShearStress");
+    Real lateral_coefficient = 1.0 - sin(friction_angle);
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        Real x = pos[i][0] / block_length;
+        Real y = pos[i][1] / block_length;
+        vel[i] = U_ref * Vecd(sin(2.0 * Pi * y), 0.5 * sin(2.0 * Pi * x));
+        force_prior[i] = mass[i] * Vecd(0.0, -gravity_g);
+
+        Real vertical_stress = -rho0_s * gravity_g * (block_length - pos[i][1]);
+        stress_tensor_3D[i] = Mat3d::Zero();
+        stress_tensor_3D[i](0, 0) = lateral_coefficient * vertical_stress;
+        stress_tensor_3D[i](1, 1) = vertical_stress;
+        stress_tensor_3D[i](2, 2) = lateral_coefficient * vertical_stress;
+        stress_tensor_3D[i](0, 1) = 0.2 * rho0_s * gravity_g * block_length * sin(2.0 * Pi * x);
+        stress_tensor_3D[i](1, 0) = stress_tensor_3D[i](0, 1);
+
+        shear_stress[i] << sin(2.0 * Pi * x), cos(2.0 * Pi * y),
+            cos(2.0 * Pi * y), -sin(2.0 * Pi * x);
+        shear_stress[i] *= 1.0e3;
+    }
+}
+
+template <typename DataType>
+void expectSameVariable(BaseParticles &classic_particles, BaseParticles &ck_particles, const std::string &name)
+{
+    DataType *classic_data = classic_particles.getVariableDataByName<DataType>(name);
+    DataType *ck_data = ck_particles.getVariableDataByName<DataType>(name);
+    Real squared_scale = TinyReal;
+    for (size_t i = 0; i != classic_particles.TotalRealParticles(); ++i)
+        squared_scale = SMAX(squared_scale, getSquaredNorm(classic_data[i]));
+    for (size_t i = 0; i != classic_particles.TotalRealParticles(); ++i)
+    {
+        DataType difference = ck_data[i] - classic_data[i];
+        EXPECT_LE(getSquaredNorm(difference), 1.0e-20 * squared_scale) << name << " of particle " << i;
+    }
+}
+
+TEST(test_continuum_integration_ck, one_step_matches_classic_continuum_integration)
+{
+    using MyExecutionPolicy = execution::ParallelPolicy;
+    SPHSystem sph_system(createBlock("Domain")->getBounds(), particle_spacing);
+
+    RealBody classic_block(sph_system, createBlock("ClassicBlock"));
+    classic_block.defineMaterial<PlasticContinuum>(rho0_s, c_s, Youngs_modulus, poisson, friction_angle);
+    classic_block.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &classic_particles = classic_block.getBaseParticles();
+
+    RealBody ck_block(sph_system, createBlock("CKBlock"));
+    ck_block.defineMaterial<PlasticContinuum>(rho0_s, c_s, Youngs_modulus, poisson, friction_angle);
+    ck_block.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &ck_particles = ck_block.getBaseParticles();
+    size_t total_real_particles = classic_particles.TotalRealParticles();
+    ASSERT_EQ(ck_particles.TotalRealParticles(), total_real_particles);
+
+    // the correction matrix of the computing kernels is copied to the classic body
+    Matd *classic_B = classic_particles.registerStateVariable<Matd>("LinearGradientCorrectionMatrix", IdentityMatrix<Matd>::value);
+    InnerRelation classic_inner(classic_block);
+    InteractionDynamics<continuum_dynamics::StressDiffusion> classic_stress_diffusion(classic_inner);
+    Dynamics1Level<continuum_dynamics::PlasticIntegration1stHalfInnerRiemann> classic_plastic_1st_half(classic_inner);
+    Dynamics1Level<continuum_dynamics::PlasticIntegration2ndHalfInnerRiemann> classic_plastic_2nd_half(classic_inner);
+    InteractionWithUpdate<continuum_dynamics::ShearStressRelaxationHourglassControl1stHalf> classic_shear_stress(classic_inner);
+    InteractionDynamics<continuum_dynamics::ShearStressRelaxationHourglassControl2ndHalf> classic_shear_acceleration(classic_inner);
+
+    UpdateCellLinkedList<MyExecutionPolicy, CellLinkedList> ck_cell_linked_list(ck_block);
+    Relation<Inner<>> ck_inner(ck_block);
+    UpdateRelation<MyExecutionPolicy, Inner<>> ck_update_relation(ck_inner);
+    StateDynamics<MyExecutionPolicy, fluid_dynamics::AdvectionStepSetup> ck_advection_step_setup(ck_block);
+    InteractionDynamicsCK<MyExecutionPolicy, LinearCorrectionMatrixInner> ck_correction_matrix(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, continuum_dynamics::StressDiffusionCK<Inner<>>> ck_stress_diffusion(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, continuum_dynamics::PlasticIntegration1stHalfCK<Inner<OneLevel, AcousticRiemannSolver>>>
+        ck_plastic_1st_half(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, continuum_dynamics::PlasticIntegration2ndHalfCK<Inner<OneLevel, AcousticRiemannSolver>>>
+        ck_plastic_2nd_half(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, continuum_dynamics::ShearStressRelaxationHourglassControl1stHalfCK<
+                                                 Inner<WithUpdate, PlasticContinuum, LinearCorrectionCK>>>
+        ck_shear_stress(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, continuum_dynamics::ShearStressRelaxationHourglassControl2ndHalfCK<Inner<>>>
+        ck_shear_acceleration(ck_inner);
+
+    setInitialCondition(classic_particles);
+    setInitialCondition(ck_particles);
+    StdVec<Vecd> initial_pos(classic_particles.ParticlePositions(), classic_particles.ParticlePositions() + total_real_particles);
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    ck_cell_linked_list.exec();
+    ck_update_relation.exec();
+    ck_advection_step_setup.exec();
+    ck_correction_matrix.exec();
+    Matd *ck_B = ck_particles.getVariableDataByName<Matd>("LinearCorrectionMatrix");
+    std::copy(ck_B, ck_B + total_real_particles, classic_B);
+
+    Real dt = 0.2 * particle_spacing / (c_s + U_ref);
+    classic_stress_diffusion.exec();
+    ck_stress_diffusion.exec();
+    expectSameVariable<Mat3d>(classic_particles, ck_particles, "StressRate3D");
+
+    classic_plastic_1st_half.exec(dt);
+    ck_plastic_1st_half.exec(dt);
+    expectSameVariable<Real>(classic_particles, ck_particles, "Pressure");
+    expectSameVariable<Real>(classic_particles, ck_particles, "DensityChangeRate");
+    expectSameVariable<Vecd>(classic_particles, ck_particles, "Force");
+    expectSameVariable<Vecd>(classic_particles, ck_particles, "Velocity");
+
+    classic_plastic_2nd_half.exec(dt);
+    ck_plastic_2nd_half.exec(dt);
+    expectSameVariable<Real>(classic_particles, ck_particles, "Density");
+    expectSameVariable<Real>(classic_particles, ck_particles, "VolumetricMeasure");
+    expectSameVariable<Vecd>(classic_particles, ck_particles, "Force");
+    expectSameVariable<Matd>(classic_particles, ck_particles, "VelocityGradient");
+    expectSameVariable<Mat3d>(classic_particles, ck_particles, "StressTensor3D");
+    expectSameVariable<Mat3d>(classic_particles, ck_particles, "StrainTensor3D");
+
+    // the classic steps move the particles, the computing kernels accumulate the displacement
+    Vecd *classic_pos = classic_particles.ParticlePositions();
+    Vecd *ck_dpos = ck_particles.getVariableDataByName<Vecd>("Displacement");
+    for (size_t i = 0; i != total_real_particles; ++i)
+        EXPECT_LE((ck_dpos[i] - (classic_pos[i] - initial_pos[i])).norm(), 1.0e-9 * U_ref * dt) << "particle " << i;
+
+    classic_shear_stress.exec(dt);
+    ck_shear_stress.exec(dt);
+    expectSameVariable<Matd>(classic_particles, ck_particles, "VelocityGradient");
+    expectSameVariable<Matd>(classic_particles, ck_particles, "ShearStress");
+    expectSameVariable<Matd>(classic_particles, ck_particles, "StrainTensor");
+    expectSameVariable<Real>(classic_particles, ck_particles, "ScalePenaltyForce");
+
+    classic_shear_acceleration.exec(dt);
+    ck_shear_acceleration.exec(dt);
+    expectSameVariable<Vecd>(classic_particles, ck_particles, "AccelerationHourglass");
+    expectSameVariable<Vecd>(classic_particles, ck_particles, "AccelerationByShear");
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
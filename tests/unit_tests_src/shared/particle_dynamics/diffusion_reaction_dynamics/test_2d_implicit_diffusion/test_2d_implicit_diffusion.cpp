@@ -0,0 +1,143 @@
+/**
+ * @file 	test_2d_implicit_diffusion.cpp
+ * @brief 	test the implicit diffusion on a unit square with zero Dirichlet walls:
+ *          the symmetry of the assembled matrix, the agreement with explicit relaxation
+ *          for a small time step and the decay of the lowest mode against the analytic solution.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real L = 1.0;
+Real H = 1.0;
+Real particle_spacing = 1.0 / 40.0;
+Real BW = particle_spacing * 4.0;
+Real diffusion_coeff = 1.0;
+
+class DiffusionBlock : public MultiPolygonShape
+{
+  public:
+    explicit DiffusionBlock(const std::string &shape_name) : MultiPolygonShape(shape_name)
+    {
+        multi_polygon_.addABox(Transform(0.5 * Vec2d(L, H)), 0.5 * Vec2d(L, H), ShapeBooleanOps::add);
+    }
+};
+
+class DirichletWall : public MultiPolygonShape
+{
+  public:
+    explicit DirichletWall(const std::string &shape_name) : MultiPolygonShape(shape_name)
+    {
+        multi_polygon_.addABox(Transform(0.5 * Vec2d(L, H)), 0.5 * Vec2d(L + 2.0 * BW, H + 2.0 * BW), ShapeBooleanOps::add);
+        multi_polygon_.addABox(Transform(0.5 * Vec2d(L, H)), 0.5 * Vec2d(L, H), ShapeBooleanOps::sub);
+    }
+};
+
+/** exposes the assembled matrix for the symmetry check */
+class ImplicitDiffusionWithMatrix : public ImplicitDiffusionInner<IsotropicDiffusion>
+{
+    using BaseImplicitDiffusion = ImplicitDiffusionInner<IsotropicDiffusion>;
+
+  public:
+    using BaseImplicitDiffusion::BaseImplicitDiffusion;
+    size_t RowSize(size_t index_i) { return row_sizes_[index_i]; };
+    size_t Column(size_t index_i, size_t n) { return columns_[row_offsets_[index_i] + n]; };
+    Real Coefficient(size_t index_i, size_t n) { return coefficients_[0][row_offsets_[index_i] + n]; };
+};
+
+using ExplicitDiffusion = Dynamics1Level<ComplexInteraction<
+    DiffusionRelaxation<Inner<KernelGradientInner>, Dirichlet<KernelGradientContact>>, IsotropicDiffusion>>;
+
+TEST(test_implicit_diffusion, dirichlet_walls_on_unit_square)
+{
+    SPHSystem sph_system(BoundingBox(Vec2d(-BW, -BW), Vec2d(L + BW, H + BW)), particle_spacing);
+    SolidBody diffusion_block(sph_system, makeShared<DiffusionBlock>("DiffusionBlock"));
+    IsotropicDiffusion *diffusion = diffusion_block.defineMaterial<IsotropicDiffusion>("Phi", "Phi", diffusion_coeff);
+    diffusion_block.generateParticles<BaseParticles, Lattice>();
+    SolidBody wall(sph_system, makeShared<DirichletWall>("DirichletWall"));
+    wall.defineMaterial<Solid>();
+    wall.generateParticles<BaseParticles, Lattice>();
+
+    InnerRelation diffusion_block_inner(diffusion_block);
+    ContactRelation diffusion_block_contact(diffusion_block, {&wall});
+    ExplicitDiffusion explicit_diffusion(ConstructorArgs(diffusion_block_inner, diffusion),
+                                         ConstructorArgs(diffusion_block_contact, diffusion));
+    ImplicitDiffusionWithMatrix backward_euler(diffusion_block_inner, diffusion, 1.0, 1.0e-12);
+    backward_euler.addDirichletBoundary(diffusion_block_contact);
+    ImplicitDiffusionWithMatrix crank_nicolson(diffusion_block_inner, diffusion, 0.5, 1.0e-10);
+    crank_nicolson.addDirichletBoundary(diffusion_block_contact);
+
+    // the lowest mode with zero wall values
+    BaseParticles &particles = diffusion_block.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    Vecd *pos = particles.ParticlePositions();
+    Real *phi = particles.getVariableDataByName<Real>("Phi");
+    Real *phi_change_rate = particles.getVariableDataByName<Real>("PhiChangeRate");
+    StdVec<Real> initial_phi(total_real_particles);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        initial_phi[i] = sin(Pi * pos[i][0] / L) * sin(Pi * pos[i][1] / H);
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    // explicit relaxation and backward Euler agree to the order of dt times the largest eigenvalue
+    Real dt = 1.0e-6;
+    std::copy(initial_phi.begin(), initial_phi.end(), phi);
+    explicit_diffusion.exec(dt);
+    StdVec<Real> explicit_change_rate(phi_change_rate, phi_change_rate + total_real_particles);
+    std::copy(initial_phi.begin(), initial_phi.end(), phi);
+    backward_euler.exec(dt);
+    EXPECT_GT(backward_euler.Iterations(), 0u);
+    EXPECT_LT(backward_euler.RelativeResidual(), 1.0e-12);
+
+    Real max_change_rate = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        max_change_rate = SMAX(max_change_rate, ABS(explicit_change_rate[i]));
+    EXPECT_NEAR(max_change_rate, 2.0 * Pi * Pi * diffusion_coeff, 0.05 * 2.0 * Pi * Pi * diffusion_coeff);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_NEAR(phi_change_rate[i], explicit_change_rate[i], 1.0e-2 * max_change_rate) << "particle " << i;
+        EXPECT_NEAR((phi[i] - initial_phi[i]) / dt, phi_change_rate[i], 1.0e-6 * max_change_rate);
+    }
+
+    // the Laplacian matrix is symmetric with positive off-diagonal coefficients
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        ASSERT_GT(backward_euler.RowSize(i), 0u);
+        for (size_t n = 0; n != backward_euler.RowSize(i); ++n)
+        {
+            size_t j = backward_euler.Column(i, n);
+            Real coefficient_ij = backward_euler.Coefficient(i, n);
+            EXPECT_GE(coefficient_ij, 0.0);
+            size_t n_ji = 0;
+            while (n_ji != backward_euler.RowSize(j) && backward_euler.Column(j, n_ji) != i)
+                ++n_ji;
+            ASSERT_NE(n_ji, backward_euler.RowSize(j)) << "particle " << i << " missing in the row of " << j;
+            EXPECT_NEAR(backward_euler.Coefficient(j, n_ji), coefficient_ij, 1.0e-12 * coefficient_ij);
+        }
+    }
+
+    // phi = exp(-D pi^2 (1 / L^2 + 1 / H^2) t) sin(pi x / L) sin(pi y / H)
+    std::copy(initial_phi.begin(), initial_phi.end(), phi);
+    dt = 2.0e-3;
+    Real end_time = 0.05;
+    Real physical_time = 0.0;
+    while (physical_time < end_time - 0.5 * dt)
+    {
+        crank_nicolson.exec(dt);
+        physical_time += dt;
+    }
+    EXPECT_EQ(crank_nicolson.StructureRebuilds(), 1u);
+
+    Real amplitude = exp(-diffusion_coeff * Pi * Pi * (1.0 / (L * L) + 1.0 / (H * H)) * physical_time);
+    Real max_error = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        max_error = SMAX(max_error, ABS(phi[i] - amplitude * initial_phi[i]));
+    EXPECT_LT(max_error, 0.05 * amplitude);
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
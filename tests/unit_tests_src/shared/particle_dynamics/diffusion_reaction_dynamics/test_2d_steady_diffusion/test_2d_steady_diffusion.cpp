@@ -0,0 +1,102 @@
+/**
+ * @file 	test_2d_steady_diffusion.cpp
+ * @brief 	test the multigrid preconditioned steady diffusion on a unit square with linear Dirichlet wall values:
+ *          the aggregation hierarchy, the number of cycles, the warm start and the agreement with
+ *          the steady limit of the Jacobi preconditioned implicit diffusion.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real L = 1.0;
+Real H = 1.0;
+Real particle_spacing = 1.0 / 40.0;
+Real BW = particle_spacing * 4.0;
+Real diffusion_coeff = 1.0;
+
+class DiffusionBlock : public MultiPolygonShape
+{
+  public:
+    explicit DiffusionBlock(const std::string &shape_name) : MultiPolygonShape(shape_name)
+    {
+        multi_polygon_.addABox(Transform(0.5 * Vec2d(L, H)), 0.5 * Vec2d(L, H), ShapeBooleanOps::add);
+    }
+};
+
+class DirichletWall : public MultiPolygonShape
+{
+  public:
+    explicit DirichletWall(const std::string &shape_name) : MultiPolygonShape(shape_name)
+    {
+        multi_polygon_.addABox(Transform(0.5 * Vec2d(L, H)), 0.5 * Vec2d(L + 2.0 * BW, H + 2.0 * BW), ShapeBooleanOps::add);
+        multi_polygon_.addABox(Transform(0.5 * Vec2d(L, H)), 0.5 * Vec2d(L, H), ShapeBooleanOps::sub);
+    }
+};
+
+TEST(test_steady_diffusion, linear_dirichlet_walls_on_unit_square)
+{
+    SPHSystem sph_system(BoundingBox(Vec2d(-BW, -BW), Vec2d(L + BW, H + BW)), particle_spacing);
+    SolidBody diffusion_block(sph_system, makeShared<DiffusionBlock>("DiffusionBlock"));
+    IsotropicDiffusion *diffusion = diffusion_block.defineMaterial<IsotropicDiffusion>("Phi", "Phi", diffusion_coeff);
+    diffusion_block.generateParticles<BaseParticles, Lattice>();
+    SolidBody wall(sph_system, makeShared<DirichletWall>("DirichletWall"));
+    wall.defineMaterial<Solid>();
+    wall.generateParticles<BaseParticles, Lattice>();
+
+    InnerRelation diffusion_block_inner(diffusion_block);
+    ContactRelation diffusion_block_contact(diffusion_block, {&wall});
+    SteadyDiffusionInner<IsotropicDiffusion> steady_diffusion(diffusion_block_inner, diffusion, 1.0e-10);
+    steady_diffusion.addDirichletBoundary(diffusion_block_contact);
+    // backward Euler with a time step far beyond the diffusion time gives the steady solution
+    ImplicitDiffusionInner<IsotropicDiffusion> steady_limit(diffusion_block_inner, diffusion, 1.0, 1.0e-12, 2000);
+    steady_limit.addDirichletBoundary(diffusion_block_contact);
+
+    // phi = x + y on the walls, zero in the block
+    BaseParticles &wall_particles = wall.getBaseParticles();
+    Vecd *wall_pos = wall_particles.ParticlePositions();
+    Real *wall_phi = wall_particles.getVariableDataByName<Real>("Phi");
+    for (size_t i = 0; i != wall_particles.TotalRealParticles(); ++i)
+        wall_phi[i] = wall_pos[i][0] + wall_pos[i][1];
+    BaseParticles &particles = diffusion_block.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+    Vecd *pos = particles.ParticlePositions();
+    Real *phi = particles.getVariableDataByName<Real>("Phi");
+    std::fill(phi, phi + total_real_particles, 0.0);
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+
+    steady_limit.exec(1.0e8);
+    EXPECT_LT(steady_limit.RelativeResidual(), 1.0e-12);
+    StdVec<Real> reference_phi(phi, phi + total_real_particles);
+
+    // 40 x 40 particles are aggregated to 400, 100 and 25 coarse unknowns
+    std::fill(phi, phi + total_real_particles, 0.0);
+    steady_diffusion.exec();
+    EXPECT_GT(steady_diffusion.NumberOfLevels(), 2u);
+    EXPECT_GT(steady_diffusion.Cycles(), 0u);
+    EXPECT_LE(steady_diffusion.Cycles(), 20u);
+    EXPECT_LT(steady_diffusion.Cycles(), steady_limit.Iterations());
+    EXPECT_LT(steady_diffusion.RelativeResidual(), 1.0e-10);
+
+    // the discrete solution is close to the harmonic field x + y, apart from the boundary layer
+    Real max_error = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        EXPECT_NEAR(phi[i], reference_phi[i], 1.0e-8) << "particle " << i;
+        max_error = SMAX(max_error, ABS(phi[i] - pos[i][0] - pos[i][1]));
+    }
+    EXPECT_LT(max_error, 0.05);
+
+    // warm started from the converged solution, no cycle is needed
+    steady_diffusion.exec();
+    EXPECT_EQ(steady_diffusion.Cycles(), 0u);
+    for (size_t i = 0; i != total_real_particles; ++i)
+        EXPECT_NEAR(phi[i], reference_phi[i], 1.0e-8) << "particle " << i;
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
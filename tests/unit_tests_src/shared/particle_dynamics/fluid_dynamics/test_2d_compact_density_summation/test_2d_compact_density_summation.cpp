@@ -0,0 +1,57 @@
+/**
+ * @file 	test_2d_compact_density_summation.cpp
+ * @brief 	test the density summation reading the compact configuration against the classic one.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real block_length = 1.0;
+Real block_height = 0.5;
+Real particle_spacing = 0.02;
+
+TEST(test_compact_configuration, density_summation)
+{
+    MultiPolygon block;
+    block.addABox(Transform(0.5 * Vec2d(block_length, block_height)), 0.5 * Vec2d(block_length, block_height),
+                  ShapeBooleanOps::add);
+    auto block_shape = makeShared<MultiPolygonShape>(block, "WaterBlock");
+
+    SPHSystem sph_system(block_shape->getBounds(), particle_spacing);
+    FluidBody water_block(sph_system, block_shape);
+    water_block.defineMaterial<WeaklyCompressibleFluid>(1.0, 10.0);
+    water_block.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = water_block.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+
+    InnerRelation water_block_inner(water_block);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationInner> density_summation(water_block_inner);
+    Real *rho_sum = particles.getVariableDataByName<Real>("DensitySummation");
+
+    water_block.updateCellLinkedList();
+    water_block_inner.updateConfiguration();
+    density_summation.exec();
+    StdVec<Real> classic_rho_sum(rho_sum, rho_sum + total_real_particles);
+
+    water_block_inner.enableCompactConfiguration();
+    water_block_inner.updateConfiguration();
+    CompactParticleConfiguration &compact_configuration = water_block_inner.compact_inner_configuration_;
+    ASSERT_EQ(compact_configuration.TotalParticles(), total_real_particles);
+    density_summation.exec();
+
+    // the compact kernel values are in single precision
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        ASSERT_EQ(compact_configuration.NeighborSize(i), water_block_inner.inner_configuration_[i].current_size_);
+        EXPECT_NEAR(rho_sum[i], classic_rho_sum[i], 1.0e-5 * classic_rho_sum[i]);
+    }
+
+    // compacting fewer particles afterwards counts only their neighbors
+    size_t half_particles = total_real_particles / 2;
+    size_t half_neighbors = 0;
+    for (size_t i = 0; i != half_particles; ++i)
+        half_neighbors += water_block_inner.inner_configuration_[i].current_size_;
+    compact_configuration.compactFrom(water_block_inner.inner_configuration_, half_particles);
+    EXPECT_EQ(compact_configuration.TotalNeighbors(), half_neighbors);
+}
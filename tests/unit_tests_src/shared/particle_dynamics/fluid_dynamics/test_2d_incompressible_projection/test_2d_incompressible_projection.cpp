@@ -0,0 +1,123 @@
+/**
+ * @file 	test_2d_incompressible_projection.cpp
+ * @brief 	test that one pressure projection step removes the divergence of
+ *          a divergent velocity field in a doubly periodic box.
+ */
+#include "sphinxsys.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real DL = 1.0;
+Real DH = 1.0;
+Real particle_spacing = 1.0 / 40.0;
+Real rho0_f = 1.0;
+Real U_f = 1.0;
+Real c_f = 10.0 * U_f;
+
+/** velocity divergence from the current configuration */
+StdVec<Real> velocityDivergence(InnerRelation &inner_relation, Vecd *vel, Real *Vol)
+{
+    size_t total_real_particles = inner_relation.getSPHBody().getBaseParticles().TotalRealParticles();
+    StdVec<Real> divergence(total_real_particles, 0.0);
+    for (size_t i = 0; i != total_real_particles; ++i)
+    {
+        const Neighborhood &inner_neighborhood = inner_relation.inner_configuration_[i];
+        for (size_t n = 0; n != inner_neighborhood.current_size_; ++n)
+        {
+            size_t index_j = inner_neighborhood.j_[n];
+            divergence[i] -= (vel[i] - vel[index_j]).dot(inner_neighborhood.e_ij_[n]) *
+                             inner_neighborhood.dW_ij_[n] * Vol[index_j];
+        }
+    }
+    return divergence;
+}
+
+Real rootMeanSquare(const StdVec<Real> &data)
+{
+    Real sum = 0.0;
+    for (const Real &value : data)
+        sum += value * value;
+    return sqrt(sum / Real(data.size()));
+}
+
+Real maximumDensityError(Real *rho, size_t total_real_particles)
+{
+    Real error = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        error = SMAX(error, ABS(rho[i] - rho0_f) / rho0_f);
+    return error;
+}
+
+TEST(test_incompressible_projection, divergence_after_projection)
+{
+    MultiPolygon water_block_shape;
+    water_block_shape.addABox(Transform(0.5 * Vec2d(DL, DH)), 0.5 * Vec2d(DL, DH), ShapeBooleanOps::add);
+    SPHSystem sph_system(BoundingBox(Vec2d::Zero(), Vec2d(DL, DH)), particle_spacing);
+    FluidBody water_block(sph_system, makeShared<MultiPolygonShape>(water_block_shape, "WaterBody"));
+    water_block.defineMaterial<WeaklyCompressibleFluid>(rho0_f, c_f);
+    water_block.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &particles = water_block.getBaseParticles();
+    size_t total_real_particles = particles.TotalRealParticles();
+
+    Vecd *pos = particles.ParticlePositions();
+    Vecd *vel = particles.registerStateVariable<Vecd>("Velocity");
+    particles.registerStateVariable<Vecd>("ForcePrior");
+    particles.registerStateVariable<Real>("Pressure");
+    Real *rho = particles.getVariableDataByName<Real>("Density");
+    Real *Vol = particles.getVariableDataByName<Real>("VolumetricMeasure");
+
+    InnerRelation water_block_inner(water_block);
+    SimpleDynamics<fluid_dynamics::ProjectionPredictor> projection_predictor(water_block);
+    InteractionWithUpdate<fluid_dynamics::DensitySummationInner> update_density_by_summation(water_block_inner);
+    fluid_dynamics::PressurePoissonSolver<> pressure_poisson_solver(water_block_inner);
+    InteractionWithUpdate<fluid_dynamics::ProjectionCorrection<Inner<>>> projection_correction(water_block_inner);
+    PeriodicAlongAxis periodic_along_x(water_block.getSPHBodyBounds(), xAxis);
+    PeriodicAlongAxis periodic_along_y(water_block.getSPHBodyBounds(), yAxis);
+    PeriodicConditionUsingCellLinkedList periodic_condition_x(water_block, periodic_along_x);
+    PeriodicConditionUsingCellLinkedList periodic_condition_y(water_block, periodic_along_y);
+    auto updateConfiguration = [&]()
+    {
+        periodic_condition_x.bounding_.exec();
+        periodic_condition_y.bounding_.exec();
+        water_block.updateCellLinkedList();
+        periodic_condition_x.update_cell_linked_list_.exec();
+        periodic_condition_y.update_cell_linked_list_.exec();
+        water_block_inner.updateConfiguration();
+    };
+
+    // a periodic velocity field with the divergence 2 pi U (cos(2 pi x) + cos(2 pi y))
+    for (size_t i = 0; i != total_real_particles; ++i)
+        vel[i] = U_f * Vecd(sin(2.0 * Pi * pos[i][0]), sin(2.0 * Pi * pos[i][1]));
+
+    // the predicted positions compress and expand the lattice
+    Real dt = 1.0e-3;
+    updateConfiguration();
+    projection_predictor.exec(dt);
+    updateConfiguration();
+    update_density_by_summation.exec();
+    Real predicted_density_error = maximumDensityError(rho, total_real_particles);
+    EXPECT_GT(predicted_density_error, 5.0e-3);
+    Real predicted_divergence = rootMeanSquare(velocityDivergence(water_block_inner, vel, Vol));
+    EXPECT_NEAR(predicted_divergence, 2.0 * Pi * U_f, 0.1 * 2.0 * Pi * U_f);
+
+    pressure_poisson_solver.exec(dt);
+    EXPECT_LT(pressure_poisson_solver.RelativeResidual(), 1.0e-6);
+    EXPECT_LT(pressure_poisson_solver.Iterations(), 500u);
+    projection_correction.exec(dt);
+
+    // the corrected velocity is nearly divergence free on the same configuration
+    Real corrected_divergence = rootMeanSquare(velocityDivergence(water_block_inner, vel, Vol));
+    EXPECT_LT(corrected_divergence, 0.05 * predicted_divergence);
+
+    // and the corrected positions give nearly the reference density
+    updateConfiguration();
+    update_density_by_summation.exec();
+    EXPECT_LT(maximumDensityError(rho, total_real_particles), 0.1 * predicted_density_error);
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+/**
+ * @file 	test_2d_elastic_dynamics_ck.cpp
+ * @brief 	test the computing-kernel elastic dynamics against the classic ones on a small beam
+ *          with a bending velocity: two steps of the stress relaxation, so that the second
+ *          first half step starts from the deformation rate of the first one.
+ */
+#include "sphinxsys_ck.h"
+#include <gtest/gtest.h>
+
+using namespace SPH;
+
+Real beam_length = 1.0;
+Real beam_height = 0.2;
+Real particle_spacing = beam_height / 8.0;
+Real rho0_s = 1000.0;
+Real Youngs_modulus = 2.0e6;
+Real poisson = 0.45;
+Real gravity_g = 9.8;
+Real U_ref = 0.1;
+
+SharedPtr<MultiPolygonShape> createBeam(const std::string &name)
+{
+    MultiPolygon beam;
+    beam.addABox(Transform(0.5 * Vec2d(beam_length, beam_height)), 0.5 * Vec2d(beam_length, beam_height),
+                 ShapeBooleanOps::add);
+    return makeShared<MultiPolygonShape>(beam, name);
+}
+
+/** the same bending velocity and gravity for both bodies */
+void setInitialCondition(BaseParticles &particles)
+{
+    Vecd *pos = particles.ParticlePositions();
+    Real *mass = particles.getVariableDataByName<Real>("Mass");
+    Vecd *vel = particles.getVariableDataByName<Vecd>("Velocity");
+    Vecd *force_prior = particles.getVariableDataByName<Vecd>("ForcePrior");
+    for (size_t i = 0; i != particles.TotalRealParticles(); ++i)
+    {
+        Real x = pos[i][0] / beam_length;
+        Real y = (pos[i][1] - 0.5 * beam_height) / beam_length;
+        vel[i] = U_ref * Vecd(-Pi * y * cos(Pi * x), sin(Pi * x));
+        force_prior[i] = mass[i] * Vecd(0.0, -gravity_g);
+    }
+}
+
+template <typename DataType>
+void expectSameVariable(BaseParticles &classic_particles, BaseParticles &ck_particles, const std::string &name)
+{
+    DataType *classic_data = classic_particles.getVariableDataByName<DataType>(name);
+    DataType *ck_data = ck_particles.getVariableDataByName<DataType>(name);
+    Real squared_scale = TinyReal;
+    for (size_t i = 0; i != classic_particles.TotalRealParticles(); ++i)
+        squared_scale = SMAX(squared_scale, getSquaredNorm(classic_data[i]));
+    for (size_t i = 0; i != classic_particles.TotalRealParticles(); ++i)
+    {
+        DataType difference = ck_data[i] - classic_data[i];
+        EXPECT_LE(getSquaredNorm(difference), 1.0e-20 * squared_scale) << name << " of particle " << i;
+    }
+}
+
+TEST(test_elastic_dynamics_ck, two_steps_match_classic_elastic_integration)
+{
+    using MyExecutionPolicy = execution::ParallelPolicy;
+    SPHSystem sph_system(createBeam("Domain")->getBounds(), particle_spacing);
+
+    SolidBody classic_beam(sph_system, createBeam("ClassicBeam"));
+    classic_beam.defineMaterial<SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    classic_beam.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &classic_particles = classic_beam.getBaseParticles();
+
+    SolidBody ck_beam(sph_system, createBeam("CKBeam"));
+    SaintVenantKirchhoffSolid &ck_material =
+        *ck_beam.defineMaterial<SaintVenantKirchhoffSolid>(rho0_s, Youngs_modulus, poisson);
+    ck_beam.generateParticles<BaseParticles, Lattice>();
+    BaseParticles &ck_particles = ck_beam.getBaseParticles();
+    size_t total_real_particles = classic_particles.TotalRealParticles();
+    ASSERT_EQ(ck_particles.TotalRealParticles(), total_real_particles);
+
+    // the correction matrix of the computing kernels is copied to the classic body
+    Matd *classic_B = classic_particles.registerStateVariable<Matd>("LinearGradientCorrectionMatrix", IdentityMatrix<Matd>::value);
+    InnerRelation classic_inner(classic_beam);
+    Dynamics1Level<solid_dynamics::Integration1stHalfPK2> classic_stress_relaxation_1st_half(classic_inner);
+    Dynamics1Level<solid_dynamics::Integration2ndHalf> classic_stress_relaxation_2nd_half(classic_inner);
+
+    UpdateCellLinkedList<MyExecutionPolicy, CellLinkedList> ck_cell_linked_list(ck_beam);
+    Relation<Inner<>> ck_inner(ck_beam);
+    UpdateRelation<MyExecutionPolicy, Inner<>> ck_update_relation(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, LinearCorrectionMatrixInner> ck_correction_matrix(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, solid_dynamics::Integration1stHalfSaintVenantKirchhoffCK>
+        ck_stress_relaxation_1st_half(ck_inner);
+    InteractionDynamicsCK<MyExecutionPolicy, solid_dynamics::Integration2ndHalfInnerCK>
+        ck_stress_relaxation_2nd_half(ck_inner);
+
+    setInitialCondition(classic_particles);
+    setInitialCondition(ck_particles);
+    sph_system.initializeSystemCellLinkedLists();
+    sph_system.initializeSystemConfigurations();
+    ck_cell_linked_list.exec();
+    ck_update_relation.exec();
+    ck_correction_matrix.exec();
+    Matd *ck_B = ck_particles.getVariableDataByName<Matd>("LinearCorrectionMatrix");
+    std::copy(ck_B, ck_B + total_real_particles, classic_B);
+
+    Real dt = 0.2 * particle_spacing / (ck_material.ReferenceSoundSpeed() + U_ref);
+    for (size_t step = 0; step != 2; ++step)
+    {
+        classic_stress_relaxation_1st_half.exec(dt);
+        ck_stress_relaxation_1st_half.exec(dt);
+        expectSameVariable<Real>(classic_particles, ck_particles, "Density");
+        expectSameVariable<Matd>(classic_particles, ck_particles, "StressPK1OnParticle");
+        expectSameVariable<Vecd>(classic_particles, ck_particles, "Force");
+        expectSameVariable<Vecd>(classic_particles, ck_particles, "Velocity");
+
+        classic_stress_relaxation_2nd_half.exec(dt);
+        ck_stress_relaxation_2nd_half.exec(dt);
+        expectSameVariable<Vecd>(classic_particles, ck_particles, "Position");
+        expectSameVariable<Matd>(classic_particles, ck_particles, "DeformationRate");
+        expectSameVariable<Matd>(classic_particles, ck_particles, "DeformationGradient");
+    }
+
+    // the beam is deformed by the bending velocity
+    Matd *ck_F = ck_particles.getVariableDataByName<Matd>("DeformationGradient");
+    Real max_deformation = 0.0;
+    for (size_t i = 0; i != total_real_particles; ++i)
+        max_deformation = SMAX(max_deformation, (ck_F[i] - Matd::Identity()).norm());
+    EXPECT_GT(max_deformation, 0.0);
+}
+//=================================================================================================//
+int main(int argc, char *argv[])
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -43,6 +43,9 @@ EMSCRIPTEN_BINDINGS(SPHINXSYS)
         .constructor<BernoulliBeamInput>()
         .function("runSimulation", &BernoulliBeamJS::runSimulation)
         .function("onError", &BernoulliBeamJS::onError)
+        .function("getParticleVariable", &BernoulliBeamJS::getParticleVariable)
+        .function("getNumberOfParticles", &BernoulliBeamJS::getNumberOfParticles)
+        .function("getBodyStates", &BernoulliBeamJS::getBodyStates)
         .property("vtuData", &BernoulliBeamJS::getVtuData);
 }
 
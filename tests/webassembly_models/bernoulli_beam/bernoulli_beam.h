@@ -98,6 +98,32 @@ class BernoulliBeamJS
 
     VtuStringData getVtuData() const { return sim_js_->getVtuData(); }
 
+    /** a typed array view of a particle variable, to be fetched again after each run
+     *  as the view is invalidated when the memory grows */
+    emscripten::val getParticleVariable(size_t body_index, const std::string &variable_name) const
+    {
+        size_t number_of_reals = 0;
+        Real *data = sim_js_->getParticleVariableData(body_index, variable_name, number_of_reals);
+        return emscripten::val(emscripten::typed_memory_view(number_of_reals, data));
+    }
+
+    size_t getNumberOfParticles(size_t body_index) const { return sim_js_->getNumberOfParticles(body_index); }
+
+    /** an object of typed array views of the positions, original ids and variables to write of a body,
+     *  keyed by the variable names, to be fetched again after each run */
+    emscripten::val getBodyStates(size_t body_index) const
+    {
+        const BodyStatesBuffers &body_states = sim_js_->getBodyStatesBuffers(body_index);
+        emscripten::val states = emscripten::val::object();
+        for (const StateBuffer &buffer : body_states.buffers_)
+        {
+            size_t number_of_scalars = body_states.number_of_particles_ * buffer.number_of_components_;
+            visitStateBufferData(buffer, [&](const auto *data)
+                                 { states.set(buffer.name_, emscripten::val(emscripten::typed_memory_view(number_of_scalars, data))); });
+        }
+        return states;
+    }
+
     void onError(emscripten::val on_error)
     {
         on_error_ = [on_error](const std::string &error_message)